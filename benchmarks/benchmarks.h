@@ -0,0 +1,227 @@
+#include <fiddle/base/exceptions.h>
+#include <fiddle/base/samrai_utilities.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi.h>
+
+#include <ibtk/CartSideDoubleSpecializedLinearRefine.h>
+
+#include <BergerRigoutsos.h>
+#include <CartesianCellDoubleLinearRefine.h>
+#include <CartesianGridGeometry.h>
+#include <CellVariable.h>
+#include <GriddingAlgorithm.h>
+#include <LoadBalancer.h>
+#include <PatchHierarchy.h>
+#include <StandardTagAndInitialize.h>
+#include <VariableDatabase.h>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+// Eulerian data used by the benchmarks. Everything is stored since SAMRAI
+// objects are reference counted and some are only referenced here.
+template <int spacedim>
+struct BenchmarkHierarchy
+{
+  SAMRAI::tbox::Pointer<SAMRAI::hier::PatchHierarchy<spacedim>> patch_hierarchy;
+
+  SAMRAI::tbox::Pointer<SAMRAI::mesh::StandardTagAndInitialize<spacedim>>
+    error_detector;
+
+  SAMRAI::tbox::Pointer<SAMRAI::mesh::BergerRigoutsos<spacedim>> box_generator;
+
+  SAMRAI::tbox::Pointer<SAMRAI::mesh::LoadBalancer<spacedim>> load_balancer;
+
+  SAMRAI::tbox::Pointer<SAMRAI::mesh::GriddingAlgorithm<spacedim>>
+    gridding_algorithm;
+
+  // Cell-centered data with @p n_f_components components for interpolation
+  // and spreading.
+  int f_idx;
+
+  // Scalar cell-centered data for counting quadrature points.
+  int qp_idx;
+};
+
+// Set up a patch hierarchy from the usual SAMRAI input databases. Like the
+// equivalent function in the test suite, but without any plotting or
+// initial conditions: f is set to a constant value everywhere (including the
+// ghost regions) since the benchmarks only measure how fast data is moved.
+template <int spacedim>
+BenchmarkHierarchy<spacedim>
+setup_hierarchy(SAMRAI::tbox::Pointer<SAMRAI::tbox::Database> input_db,
+                const int                                     n_f_components)
+{
+  using namespace SAMRAI;
+
+  BenchmarkHierarchy<spacedim> result;
+
+  tbox::Pointer<geom::CartesianGridGeometry<spacedim>> grid_geometry =
+    new geom::CartesianGridGeometry<spacedim>(
+      "CartesianGeometry", input_db->getDatabase("CartesianGeometry"));
+  grid_geometry->addSpatialRefineOperator(
+    new geom::CartesianCellDoubleLinearRefine<spacedim>());
+  grid_geometry->addSpatialRefineOperator(
+    new IBTK::CartSideDoubleSpecializedLinearRefine());
+
+  result.patch_hierarchy =
+    new hier::PatchHierarchy<spacedim>("PatchHierarchy", grid_geometry);
+  result.error_detector = new mesh::StandardTagAndInitialize<spacedim>(
+    "StandardTagAndInitialize",
+    nullptr,
+    input_db->getDatabase("StandardTagAndInitialize"));
+  result.box_generator = new mesh::BergerRigoutsos<spacedim>();
+  result.load_balancer =
+    new mesh::LoadBalancer<spacedim>("LoadBalancer",
+                                     input_db->getDatabase("LoadBalancer"));
+  result.gridding_algorithm =
+    new mesh::GriddingAlgorithm<spacedim>("GriddingAlgorithm",
+                                          input_db->getDatabase(
+                                            "GriddingAlgorithm"),
+                                          result.error_detector,
+                                          result.box_generator,
+                                          result.load_balancer);
+
+  // As usual, variables have to be registered before we make any levels.
+  auto *var_db = hier::VariableDatabase<spacedim>::getDatabase();
+  tbox::Pointer<hier::VariableContext> ctx = var_db->getContext("benchmark");
+  // BSPLINE_3 needs 3 ghost cells
+  const hier::IntVector<spacedim>         ghost_width(3);
+  tbox::Pointer<hier::Variable<spacedim>> f_var =
+    new pdat::CellVariable<spacedim, double>("f_cc", n_f_components);
+  result.f_idx = var_db->registerVariableAndContext(f_var, ctx, ghost_width);
+  tbox::Pointer<hier::Variable<spacedim>> qp_var =
+    new pdat::CellVariable<spacedim, double>("qp_cc", 1);
+  result.qp_idx = var_db->registerVariableAndContext(
+    qp_var, ctx, hier::IntVector<spacedim>(0));
+
+  result.gridding_algorithm->makeCoarsestLevel(result.patch_hierarchy, 0.0);
+  int       level_number = 0;
+  const int tag_buffer   = 1;
+  while (result.gridding_algorithm->levelCanBeRefined(level_number))
+    {
+      result.gridding_algorithm->makeFinerLevel(result.patch_hierarchy,
+                                                0.0,
+                                                0.0,
+                                                tag_buffer);
+      ++level_number;
+    }
+
+  for (int ln = 0; ln <= result.patch_hierarchy->getFinestLevelNumber(); ++ln)
+    {
+      tbox::Pointer<hier::PatchLevel<spacedim>> level =
+        result.patch_hierarchy->getPatchLevel(ln);
+      level->allocatePatchData(result.f_idx, 0.0);
+      level->allocatePatchData(result.qp_idx, 0.0);
+      for (auto &patch : fdl::extract_patches(level))
+        {
+          fdl::fill_all(patch->getPatchData(result.f_idx), 1.0);
+          fdl::fill_all(patch->getPatchData(result.qp_idx), 0.0);
+        }
+    }
+
+  return result;
+}
+
+// Read an array of strings from @p db, or return @p default_value if the key
+// does not exist.
+std::vector<std::string>
+get_strings_with_default(SAMRAI::tbox::Pointer<SAMRAI::tbox::Database> db,
+                         const std::string                            &key,
+                         const std::vector<std::string> &default_value)
+{
+  if (!db->keyExists(key))
+    return default_value;
+  const int                n_values = db->getArraySize(key);
+  std::vector<std::string> values(n_values);
+  db->getStringArray(key, values.data(), n_values);
+  return values;
+}
+
+// Same as get_strings_with_default(), but for integers.
+std::vector<int>
+get_integers_with_default(SAMRAI::tbox::Pointer<SAMRAI::tbox::Database> db,
+                          const std::string                            &key,
+                          const std::vector<int> &default_value)
+{
+  if (!db->keyExists(key))
+    return default_value;
+  const int        n_values = db->getArraySize(key);
+  std::vector<int> values(n_values);
+  db->getIntegerArray(key, values.data(), n_values);
+  return values;
+}
+
+// Run @p function once to warm up caches (and to set up any lazily
+// initialized data structures) and then @p n_repetitions more times. Return
+// the fastest of these runs, where the time of each run is the time taken by
+// the slowest processor.
+template <typename F>
+double
+time_kernel(const unsigned int n_repetitions, MPI_Comm comm, F &&function)
+{
+  using namespace dealii;
+  AssertThrow(n_repetitions > 0,
+              ExcMessage("At least one repetition is required."));
+
+  function();
+  double best_time = std::numeric_limits<double>::max();
+  for (unsigned int i = 0; i < n_repetitions; ++i)
+    {
+      const int ierr = MPI_Barrier(comm);
+      AssertThrowMPI(ierr);
+      const double start = MPI_Wtime();
+      function();
+      const double elapsed = Utilities::MPI::max(MPI_Wtime() - start, comm);
+      best_time            = std::min(best_time, elapsed);
+    }
+
+  return best_time;
+}
+
+// Print the column names of the table written by print_result().
+void
+print_header(MPI_Comm comm, std::ostream &out = std::cout)
+{
+  if (dealii::Utilities::MPI::this_mpi_process(comm) == 0)
+    out << std::left << std::setw(34) << "benchmark" << std::setw(8)
+        << "degree" << std::setw(16) << "variant" << std::right
+        << std::setw(14) << "points" << std::setw(14) << "time (s)"
+        << std::setw(14) << "points/s" << std::setw(10) << "GB/s"
+        << std::endl;
+}
+
+// Print one row of the benchmark table. @p variant describes anything else
+// which distinguishes this run (e.g., the IB kernel). @p n_points is the total
+// number of points (quadrature points, nodes, or DoFs) processed in @p time
+// seconds. If @p n_bytes is positive then the bandwidth is also printed.
+void
+print_result(MPI_Comm           comm,
+             const std::string &name,
+             const int          degree,
+             const std::string &variant,
+             const double       n_points,
+             const double       time,
+             const double       n_bytes = 0.0,
+             std::ostream      &out     = std::cout)
+{
+  if (dealii::Utilities::MPI::this_mpi_process(comm) == 0)
+    {
+      out << std::left << std::setw(34) << name << std::setw(8) << degree
+          << std::setw(16) << variant << std::right << std::setw(14)
+          << std::setprecision(6) << n_points << std::setw(14) << time
+          << std::setw(14) << n_points / time << std::setw(10);
+      if (n_bytes > 0.0)
+        out << n_bytes / time / 1e9;
+      else
+        out << "-";
+      out << std::endl;
+    }
+}
@@ -0,0 +1,273 @@
+#include <fiddle/grid/box_utilities.h>
+#include <fiddle/grid/intersection_predicate_lib.h>
+#include <fiddle/grid/nodal_patch_map.h>
+#include <fiddle/grid/overlap_tria.h>
+#include <fiddle/grid/patch_map.h>
+
+#include <fiddle/interaction/interaction_utilities.h>
+
+#include <fiddle/transfer/overlap_partitioning_tools.h>
+#include <fiddle/transfer/scatter.h>
+
+#include <deal.II/base/bounding_box.h>
+#include <deal.II/base/function.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include "benchmarks.h"
+
+// Measure the throughput of the interaction kernels (and the Scatter used to
+// move data between the native and overlap partitionings) for a ball in the
+// middle of the computational domain.
+
+using namespace SAMRAI;
+using namespace dealii;
+
+template <int spacedim>
+void
+run(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  constexpr int dim      = spacedim;
+  auto          input_db = app_initializer->getInputDatabase();
+  auto          bench_db = input_db->getDatabase("benchmark");
+  const auto    mpi_comm = MPI_COMM_WORLD;
+
+  const unsigned int n_repetitions =
+    bench_db->getIntegerWithDefault("n_repetitions", 10);
+  const unsigned int n_threads =
+    bench_db->getIntegerWithDefault("n_threads", 1);
+  const std::vector<int> degrees =
+    get_integers_with_default(bench_db, "degrees", {1, 2, 3});
+  const std::vector<std::string> kernels =
+    get_strings_with_default(bench_db,
+                             "kernels",
+                             {"IB_3", "IB_4", "BSPLINE_3"});
+
+  // Interpolate and spread vector-valued fields, as we do with velocities and
+  // forces.
+  const BenchmarkHierarchy<spacedim> hierarchy =
+    setup_hierarchy<spacedim>(input_db, spacedim);
+  const auto patches =
+    fdl::extract_patches(hierarchy.patch_hierarchy->getPatchLevel(
+      hierarchy.patch_hierarchy->getFinestLevelNumber()));
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  Point<spacedim> center;
+  for (unsigned int d = 0; d < spacedim; ++d)
+    center[d] = 0.5;
+  GridGenerator::hyper_ball(native_tria,
+                            center,
+                            bench_db->getDoubleWithDefault("radius", 0.25));
+  native_tria.refine_global(
+    bench_db->getIntegerWithDefault("n_global_refinements", 4));
+
+  // Now set up fiddle things:
+  const std::vector<BoundingBox<spacedim>> patch_bboxes =
+    fdl::compute_patch_bboxes(patches, 1.0);
+  fdl::TriaIntersectionPredicate<dim, spacedim> tria_pred(patch_bboxes);
+  fdl::OverlapTriangulation<dim, spacedim> overlap_tria(native_tria, tria_pred);
+  std::vector<BoundingBox<spacedim, float>> cell_bboxes;
+  for (const auto &cell : overlap_tria.active_cell_iterators())
+    {
+      BoundingBox<spacedim, float> fbbox;
+      fbbox.get_boundary_points() = cell->bounding_box().get_boundary_points();
+      cell_bboxes.push_back(fbbox);
+    }
+  fdl::PatchMap<dim, spacedim> patch_map(patches,
+                                         1.0,
+                                         overlap_tria,
+                                         cell_bboxes);
+  std::vector<std::vector<BoundingBox<spacedim>>> nodal_bboxes;
+  for (const auto &bbox : patch_bboxes)
+    nodal_bboxes.emplace_back(1, bbox);
+
+  // The structure is not deformed, so the position mapping is the identity.
+  const MappingQ<dim, spacedim>    mapping(1);
+  const std::vector<unsigned char> quadrature_indices(
+    overlap_tria.n_active_cells());
+
+  print_header(mpi_comm);
+  for (const int degree : degrees)
+    {
+      const FESystem<dim, spacedim> fe(FE_Q<dim, spacedim>(degree), spacedim);
+      const std::vector<Quadrature<dim>> quadratures(
+        {QGauss<dim>(degree + 1)});
+      DoFHandler<dim, spacedim> overlap_dof_handler(overlap_tria);
+      overlap_dof_handler.distribute_dofs(fe);
+      Vector<double> rhs(overlap_dof_handler.n_dofs());
+      Vector<double> F(overlap_dof_handler.n_dofs());
+      F = 1.0;
+
+      // elemental coupling:
+      const double n_qps =
+        Utilities::MPI::sum(fdl::count_quadrature_points(hierarchy.qp_idx,
+                                                         patch_map,
+                                                         mapping,
+                                                         quadrature_indices,
+                                                         quadratures),
+                            mpi_comm);
+      print_result(mpi_comm,
+                   "count_quadrature_points",
+                   degree,
+                   "-",
+                   n_qps,
+                   time_kernel(n_repetitions, mpi_comm, [&]() {
+                     fdl::count_quadrature_points(hierarchy.qp_idx,
+                                                  patch_map,
+                                                  mapping,
+                                                  quadrature_indices,
+                                                  quadratures);
+                   }));
+      for (const std::string &kernel : kernels)
+        {
+          print_result(mpi_comm,
+                       "compute_projection_rhs",
+                       degree,
+                       kernel,
+                       n_qps,
+                       time_kernel(n_repetitions, mpi_comm, [&]() {
+                         rhs = 0.0;
+                         fdl::compute_projection_rhs(kernel,
+                                                     hierarchy.f_idx,
+                                                     patch_map,
+                                                     mapping,
+                                                     quadrature_indices,
+                                                     quadratures,
+                                                     overlap_dof_handler,
+                                                     mapping,
+                                                     rhs,
+                                                     nullptr,
+                                                     n_threads);
+                       }));
+          print_result(mpi_comm,
+                       "compute_spread",
+                       degree,
+                       kernel,
+                       n_qps,
+                       time_kernel(n_repetitions, mpi_comm, [&]() {
+                         fdl::compute_spread(kernel,
+                                             hierarchy.f_idx,
+                                             patch_map,
+                                             mapping,
+                                             quadrature_indices,
+                                             quadratures,
+                                             overlap_dof_handler,
+                                             mapping,
+                                             F,
+                                             nullptr,
+                                             n_threads);
+                       }));
+        }
+
+      // nodal coupling, in which the nodes are the support points of the
+      // finite element:
+      Vector<double> position(overlap_dof_handler.n_dofs());
+      VectorTools::interpolate(mapping,
+                               overlap_dof_handler,
+                               Functions::IdentityFunction<spacedim>(),
+                               position);
+      fdl::NodalPatchMap<dim, spacedim> nodal_patch_map(patches,
+                                                        nodal_bboxes,
+                                                        position);
+      Vector<double> nodal_values(position.size());
+      const double   n_nodes =
+        Utilities::MPI::sum(double(position.size() / spacedim), mpi_comm);
+      for (const std::string &kernel : kernels)
+        {
+          print_result(mpi_comm,
+                       "compute_nodal_interpolation",
+                       degree,
+                       kernel,
+                       n_nodes,
+                       time_kernel(n_repetitions, mpi_comm, [&]() {
+                         nodal_values = 0.0;
+                         fdl::compute_nodal_interpolation(kernel,
+                                                          hierarchy.f_idx,
+                                                          nodal_patch_map,
+                                                          position,
+                                                          nodal_values,
+                                                          n_threads);
+                       }));
+          print_result(mpi_comm,
+                       "compute_nodal_spread",
+                       degree,
+                       kernel,
+                       n_nodes,
+                       time_kernel(n_repetitions, mpi_comm, [&]() {
+                         fdl::compute_nodal_spread(kernel,
+                                                   hierarchy.f_idx,
+                                                   nodal_patch_map,
+                                                   position,
+                                                   F,
+                                                   n_threads);
+                       }));
+        }
+
+      // moving data from the native partitioning to the overlap partitioning
+      // and back again:
+      DoFHandler<dim, spacedim> native_dof_handler(native_tria);
+      native_dof_handler.distribute_dofs(fe);
+      fdl::Scatter<double> scatter(
+        fdl::compute_overlap_to_native_dof_translation(overlap_tria,
+                                                       overlap_dof_handler,
+                                                       native_dof_handler),
+        native_dof_handler.locally_owned_dofs(),
+        mpi_comm);
+      LinearAlgebra::distributed::Vector<double> native_vector(
+        native_dof_handler.locally_owned_dofs(), mpi_comm);
+      Vector<double> overlap_vector(overlap_dof_handler.n_dofs());
+      print_result(mpi_comm,
+                   "Scatter round trip",
+                   degree,
+                   "-",
+                   n_nodes,
+                   time_kernel(n_repetitions, mpi_comm, [&]() {
+                     scatter.global_to_overlap_start(native_vector,
+                                                     0,
+                                                     overlap_vector);
+                     scatter.global_to_overlap_finish(native_vector,
+                                                      overlap_vector);
+                     scatter.overlap_to_global_start(overlap_vector,
+                                                     VectorOperation::add,
+                                                     0,
+                                                     native_vector);
+                     scatter.overlap_to_global_finish(overlap_vector,
+                                                      VectorOperation::add,
+                                                      native_vector);
+                   }));
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "interaction.log");
+
+  run<NDIM>(app_initializer);
+}
@@ -0,0 +1,338 @@
+#include <fiddle/mechanics/fiber_network.h>
+#include <fiddle/mechanics/force_contribution.h>
+#include <fiddle/mechanics/force_contribution_lib.h>
+#include <fiddle/mechanics/mechanics_utilities.h>
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_simplex_p.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_fe.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <memory>
+
+#include "benchmarks.h"
+
+// Measure the throughput of compute_load_vector() with each force
+// contribution in force_contribution_lib.h, both alone and all at once, on
+// hypercube and simplex meshes of increasing size.
+
+using namespace SAMRAI;
+using namespace dealii;
+
+// A smooth deformation which does not vanish on the boundary.
+template <int spacedim>
+class Position : public Function<spacedim>
+{
+public:
+  Position()
+    : Function<spacedim>(spacedim)
+  {}
+
+  virtual double
+  value(const Point<spacedim> &p, const unsigned int component) const override
+  {
+    return p[component] + 0.1 * std::sin(p[(component + 1) % spacedim]);
+  }
+};
+
+template <int dim, int spacedim>
+std::unique_ptr<fdl::ForceContribution<dim, spacedim>>
+make_force(
+  const std::string                                             &name,
+  const Quadrature<dim>                                         &quadrature,
+  const Quadrature<dim - 1>                                     &face_quad,
+  const DoFHandler<dim, spacedim>                               &dof_handler,
+  const Mapping<dim, spacedim>                                  &mapping,
+  const std::shared_ptr<const fdl::FiberNetwork<dim, spacedim>> &fibers)
+{
+  const Functions::IdentityFunction<spacedim> identity;
+  if (name == "ModifiedNeoHookeanStress")
+    return std::make_unique<fdl::ModifiedNeoHookeanStress<dim, spacedim>>(
+      quadrature, 1.0);
+  else if (name == "ModifiedMooneyRivlinStress")
+    return std::make_unique<fdl::ModifiedMooneyRivlinStress<dim, spacedim>>(
+      quadrature, 1.0, 1.0);
+  else if (name == "HolzapfelOgdenStress")
+    return std::make_unique<fdl::HolzapfelOgdenStress<dim, spacedim>>(
+      quadrature,
+      1.0, // a
+      1.0, // b
+      1.0, // a_f
+      1.0, // b_f
+      0.0, // kappa_f
+      0,   // index_f
+      1.0, // a_s
+      1.0, // b_s
+      0.0, // kappa_s
+      1,   // index_s
+      1.0, // a_fs
+      1.0, // b_fs
+      fibers);
+  else if (name == "JLogJVolumetricEnergyStress")
+    return std::make_unique<fdl::JLogJVolumetricEnergyStress<dim, spacedim>>(
+      quadrature, 1.0);
+  else if (name == "LogarithmicVolumetricEnergyStress")
+    return std::make_unique<
+      fdl::LogarithmicVolumetricEnergyStress<dim, spacedim>>(quadrature, 1.0);
+  else if (name == "SpringForce")
+    return std::make_unique<fdl::SpringForce<dim, spacedim>>(
+      quadrature, 1.0, dof_handler, mapping, identity);
+  else if (name == "DampingForce")
+    return std::make_unique<fdl::DampingForce<dim, spacedim>>(quadrature, 1.0);
+  else if (name == "BoundarySpringForce")
+    return std::make_unique<fdl::BoundarySpringForce<dim, spacedim>>(
+      face_quad, 1.0, dof_handler, mapping, identity);
+  else if (name == "OrthogonalLinearLoadForce")
+    return std::make_unique<fdl::OrthogonalLinearLoadForce<dim, spacedim>>(
+      face_quad, 1.0, 1.0);
+  else if (name == "OrthogonalSpringDashpotForce")
+    return std::make_unique<fdl::OrthogonalSpringDashpotForce<dim, spacedim>>(
+      face_quad, 1.0, 1.0, dof_handler, mapping, identity);
+
+  AssertThrow(false, ExcMessage("Unknown force contribution " + name));
+  return nullptr;
+}
+
+template <int spacedim>
+void
+run(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  constexpr int dim      = spacedim;
+  auto          input_db = app_initializer->getInputDatabase();
+  auto          bench_db = input_db->getDatabase("benchmark");
+  const auto    mpi_comm = MPI_COMM_WORLD;
+
+  const unsigned int n_repetitions =
+    bench_db->getIntegerWithDefault("n_repetitions", 10);
+  const std::vector<int> degrees =
+    get_integers_with_default(bench_db, "degrees", {1, 2});
+  const std::vector<int> refinements =
+    get_integers_with_default(bench_db, "n_global_refinements", {2, 3, 4});
+  const std::vector<std::string> mesh_types =
+    get_strings_with_default(bench_db, "mesh_types", {"hex", "simplex"});
+  const std::vector<std::string> force_names = get_strings_with_default(
+    bench_db,
+    "forces",
+    {"ModifiedNeoHookeanStress",
+     "ModifiedMooneyRivlinStress",
+     "HolzapfelOgdenStress",
+     "JLogJVolumetricEnergyStress",
+     "LogarithmicVolumetricEnergyStress",
+     "SpringForce",
+     "DampingForce",
+     "BoundarySpringForce",
+     "OrthogonalLinearLoadForce",
+     "OrthogonalSpringDashpotForce"});
+
+  print_header(mpi_comm);
+  for (const std::string &mesh_type : mesh_types)
+    for (const int n_refinements : refinements)
+      {
+        AssertThrow(mesh_type == "hex" || mesh_type == "simplex",
+                    ExcMessage("Unknown mesh type " + mesh_type));
+        const bool use_simplex = mesh_type == "simplex";
+
+        const auto partitioner =
+          parallel::shared::Triangulation<dim,
+                                          spacedim>::Settings::partition_zorder;
+        parallel::shared::Triangulation<dim, spacedim> tria(mpi_comm,
+                                                            {},
+                                                            false,
+                                                            partitioner);
+        if (use_simplex)
+          {
+            Triangulation<dim, spacedim> hypercube_tria;
+            GridGenerator::hyper_cube(hypercube_tria);
+            GridGenerator::convert_hypercube_to_simplex_mesh(hypercube_tria,
+                                                             tria);
+          }
+        else
+          GridGenerator::hyper_cube(tria);
+        tria.refine_global(n_refinements);
+        const std::string variant =
+          mesh_type + "-" + std::to_string(tria.n_global_active_cells());
+
+        unsigned int n_boundary_faces = 0;
+        unsigned int n_boundary_cells = 0;
+        for (const auto &cell : tria.active_cell_iterators())
+          if (cell->is_locally_owned() && cell->at_boundary())
+            {
+              ++n_boundary_cells;
+              for (const auto &face : cell->face_iterators())
+                if (face->at_boundary())
+                  ++n_boundary_faces;
+            }
+        const unsigned int n_cells = tria.n_locally_owned_active_cells();
+
+        // Fibers are piecewise constant, so the fiber network stores one
+        // tensor per cell and fiber:
+        std::vector<std::vector<Tensor<1, spacedim>>> fibers(
+          2, std::vector<Tensor<1, spacedim>>(n_cells));
+        for (unsigned int i = 0; i < n_cells; ++i)
+          {
+            fibers[0][i][0] = 1.0;
+            fibers[1][i][1] = 1.0;
+          }
+        const auto fiber_network =
+          std::make_shared<fdl::FiberNetwork<dim, spacedim>>(tria, fibers);
+
+        for (const int degree : degrees)
+          {
+            std::unique_ptr<FiniteElement<dim, spacedim>> base_fe;
+            std::unique_ptr<Quadrature<dim>>              quadrature;
+            std::unique_ptr<Quadrature<dim - 1>>          face_quadrature;
+            std::unique_ptr<Mapping<dim, spacedim>>       mapping;
+            if (use_simplex)
+              {
+                base_fe = std::make_unique<FE_SimplexP<dim, spacedim>>(degree);
+                quadrature = std::make_unique<QGaussSimplex<dim>>(degree + 1);
+                face_quadrature =
+                  std::make_unique<QGaussSimplex<dim - 1>>(degree + 1);
+                mapping = std::make_unique<MappingFE<dim, spacedim>>(
+                  FE_SimplexP<dim, spacedim>(1));
+              }
+            else
+              {
+                base_fe    = std::make_unique<FE_Q<dim, spacedim>>(degree);
+                quadrature = std::make_unique<QGauss<dim>>(degree + 1);
+                face_quadrature =
+                  std::make_unique<QGauss<dim - 1>>(degree + 1);
+                mapping = std::make_unique<MappingQ<dim, spacedim>>(1);
+              }
+            const FESystem<dim, spacedim> fe(*base_fe, spacedim);
+            DoFHandler<dim, spacedim>     dof_handler(tria);
+            dof_handler.distribute_dofs(fe);
+
+            IndexSet locally_relevant_dofs;
+            DoFTools::extract_locally_relevant_dofs(dof_handler,
+                                                    locally_relevant_dofs);
+            auto vector_partitioner =
+              std::make_shared<Utilities::MPI::Partitioner>(
+                dof_handler.locally_owned_dofs(),
+                locally_relevant_dofs,
+                mpi_comm);
+            LinearAlgebra::distributed::Vector<double> position(
+              vector_partitioner);
+            LinearAlgebra::distributed::Vector<double> velocity(
+              vector_partitioner);
+            LinearAlgebra::distributed::Vector<double> force_rhs(
+              vector_partitioner);
+            VectorTools::interpolate(*mapping,
+                                     dof_handler,
+                                     Position<spacedim>(),
+                                     position);
+            position.update_ghost_values();
+            velocity = 1.0;
+            velocity.update_ghost_values();
+
+            // The bandwidth is the least amount of data assembly has to move:
+            // every value of the position and velocity is read and every
+            // value of the load vector is written once per cell. The fibers
+            // are also read once per cell by HolzapfelOgdenStress.
+            const double bytes_per_cell =
+              3.0 * fe.n_dofs_per_cell() * sizeof(double);
+            const double fiber_bytes_per_cell =
+              fibers.size() * spacedim * sizeof(double);
+
+            const auto time_load_vector =
+              [&](const std::vector<fdl::ForceContribution<dim, spacedim> *>
+                    &force_ptrs) {
+                return time_kernel(n_repetitions, mpi_comm, [&]() {
+                  force_rhs = 0.0;
+                  fdl::compute_load_vector(dof_handler,
+                                           *mapping,
+                                           force_ptrs,
+                                           {},
+                                           0.0,
+                                           position,
+                                           velocity,
+                                           force_rhs);
+                  force_rhs.compress(VectorOperation::add);
+                });
+              };
+
+            const double n_local_cell_qps =
+              double(n_cells) * quadrature->size();
+            const double n_local_face_qps =
+              double(n_boundary_faces) * face_quadrature->size();
+
+            std::vector<std::unique_ptr<fdl::ForceContribution<dim, spacedim>>>
+              forces;
+
+            double all_n_qps   = 0.0;
+            bool   uses_fibers = false;
+            for (const std::string &name : force_names)
+              {
+                forces.push_back(make_force(name,
+                                            *quadrature,
+                                            *face_quadrature,
+                                            dof_handler,
+                                            *mapping,
+                                            fiber_network));
+                const bool   boundary = forces.back()->is_boundary_force();
+                const bool   reads_fibers = name == "HolzapfelOgdenStress";
+                const double n_qps        = Utilities::MPI::sum(
+                  boundary ? n_local_face_qps : n_local_cell_qps, mpi_comm);
+                const double n_bytes = Utilities::MPI::sum(
+                  (boundary ? n_boundary_cells : n_cells) * bytes_per_cell +
+                    (reads_fibers ? n_cells * fiber_bytes_per_cell : 0.0),
+                  mpi_comm);
+                all_n_qps += n_qps;
+                uses_fibers = uses_fibers || reads_fibers;
+
+                print_result(mpi_comm,
+                             name,
+                             degree,
+                             variant,
+                             n_qps,
+                             time_load_vector({forces.back().get()}),
+                             n_bytes);
+              }
+
+            // and everything at once:
+            std::vector<fdl::ForceContribution<dim, spacedim> *> force_ptrs;
+            for (const auto &force : forces)
+              force_ptrs.push_back(force.get());
+            const double n_bytes = Utilities::MPI::sum(
+              n_cells *
+                (bytes_per_cell + (uses_fibers ? fiber_bytes_per_cell : 0.0)),
+              mpi_comm);
+            print_result(mpi_comm,
+                         "all",
+                         degree,
+                         variant,
+                         all_n_qps,
+                         time_load_vector(force_ptrs),
+                         n_bytes);
+          }
+      }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "mechanics.log");
+
+  run<NDIM>(app_initializer);
+}
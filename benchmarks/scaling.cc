@@ -0,0 +1,394 @@
+#include <fiddle/base/config.h>
+#include <fiddle/base/phase_timings.h>
+
+#include <fiddle/interaction/ifed_method.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+
+#include <ibamr/IBExplicitHierarchyIntegrator.h>
+#include <ibamr/INSStaggeredHierarchyIntegrator.h>
+#include <ibamr/StaggeredStokesSolver.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+#include <ibtk/muParserRobinBcCoefs.h>
+
+#include <BergerRigoutsos.h>
+#include <CartesianGridGeometry.h>
+#include <CellData.h>
+#include <CellIterator.h>
+#include <LoadBalancer.h>
+#include <StandardTagAndInitialize.h>
+
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "benchmarks.h"
+
+// Scaling driver: run fdl::IFEDMethod on the IBFE/explicit/ex4 problem (an
+// elastic ball in a lid-driven cavity) and write the timings of each phase of
+// the timestep, the number of Stokes solver iterations, and the load balance
+// of the Eulerian and Lagrangian data as a single JSON object. The Eulerian
+// resolution (N), the Lagrangian resolution (MFAC) and the number of
+// processors are swept by scaling-sweep, which runs this program once per
+// configuration.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim, int spacedim = dim>
+class DeviatoricStress : public fdl::ForceContribution<dim, spacedim>
+{
+public:
+  DeviatoricStress(const Quadrature<dim> &quadrature, const double c1)
+    : fdl::ForceContribution<dim, spacedim>(quadrature)
+    , c1(c1)
+  {}
+
+  virtual bool
+  is_stress() const override
+  {
+    return true;
+  }
+
+  virtual UpdateFlags
+  get_update_flags() const override
+  {
+    return UpdateFlags::update_default;
+  }
+
+  virtual fdl::MechanicsUpdateFlags
+  get_mechanics_update_flags() const override
+  {
+    return fdl::MechanicsUpdateFlags::update_FF;
+  }
+
+  virtual void
+  compute_stress(
+    const double /*time*/,
+    const fdl::MechanicsValues<dim, spacedim> &me_values,
+    const typename Triangulation<dim, spacedim>::active_cell_iterator
+      & /*cell*/,
+    ArrayView<Tensor<2, spacedim, double>> &stresses) const override
+  {
+    const std::vector<Tensor<2, spacedim>> &FF = me_values.get_FF();
+    for (unsigned int qp_n = 0; qp_n < FF.size(); ++qp_n)
+      stresses[qp_n] = 2.0 * c1 * FF[qp_n];
+  }
+
+private:
+  double c1;
+};
+
+template <int dim, int spacedim = dim>
+class DilationalStress : public fdl::ForceContribution<dim, spacedim>
+{
+public:
+  DilationalStress(const Quadrature<dim> &quadrature,
+                   const double           p0,
+                   const double           beta)
+    : fdl::ForceContribution<dim, spacedim>(quadrature)
+    , p0(p0)
+    , beta(beta)
+  {}
+
+  virtual UpdateFlags
+  get_update_flags() const override
+  {
+    return UpdateFlags::update_default;
+  }
+
+  virtual fdl::MechanicsUpdateFlags
+  get_mechanics_update_flags() const override
+  {
+    return fdl::MechanicsUpdateFlags::update_FF_inv_T |
+           fdl::MechanicsUpdateFlags::update_det_FF;
+  }
+
+  virtual bool
+  is_stress() const override
+  {
+    return true;
+  }
+
+  virtual void
+  compute_stress(
+    const double /*time*/,
+    const fdl::MechanicsValues<dim, spacedim> &me_values,
+    const typename Triangulation<dim, spacedim>::active_cell_iterator
+      & /*cell*/,
+    ArrayView<Tensor<2, spacedim, double>> &stresses) const override
+  {
+    const std::vector<double>              &det_FF   = me_values.get_det_FF();
+    const std::vector<Tensor<2, spacedim>> &FF_inv_T = me_values.get_FF_inv_T();
+    for (unsigned int qp_n = 0; qp_n < det_FF.size(); ++qp_n)
+      stresses[qp_n] =
+        2.0 * (-p0 + beta * std::log(det_FF[qp_n])) * FF_inv_T[qp_n];
+  }
+
+private:
+  double p0;
+  double beta;
+};
+
+// Write the minimum, mean, and maximum of a value computed on each processor
+// as a JSON object. The imbalance is the ratio of the maximum to the mean.
+void
+write_statistics(std::ostream &out, const double value, MPI_Comm comm)
+{
+  const Utilities::MPI::MinMaxAvg stats =
+    Utilities::MPI::min_max_avg(value, comm);
+  out << "{\"min\": " << stats.min << ", \"mean\": " << stats.avg
+      << ", \"max\": " << stats.max << ", \"imbalance\": "
+      << (stats.avg > 0.0 ? stats.max / stats.avg : 1.0) << "}";
+}
+
+template <int dim, int spacedim = dim>
+void
+run(tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  // suppress warnings caused by using a refinement ratio of 4 and not
+  // setting up coarsening correctly
+  SAMRAI::tbox::Logger::getInstance()->setWarning(false);
+
+  auto       input_db = app_initializer->getInputDatabase();
+  auto       bench_db = input_db->getDatabase("benchmark");
+  const auto mpi_comm = MPI_COMM_WORLD;
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+
+  Point<dim> center;
+  center[0]       = 0.6;
+  center[1]       = 0.5;
+  center[dim - 1] = 0.5; // works in 2D and 3D
+  GridGenerator::hyper_ball(native_tria, center, 0.2);
+
+  // Multiply by 2.0 at the end to match what libMesh/IBFE/explicit/ex4 does
+  const double target_element_size =
+    input_db->getDouble("MFAC") * input_db->getDouble("DX") * 2.0;
+  while (GridTools::maximal_cell_diameter(native_tria) > target_element_size)
+    native_tria.refine_global(1);
+
+  // fiddle stuff:
+  FESystem<dim> fe(FE_Q<dim>(input_db->getInteger("fe_degree")), dim);
+  std::vector<fdl::Part<dim>> parts;
+
+  QGauss<dim> dev_quad(
+    input_db->getIntegerWithDefault("pk1_dev_n_points_1d", 2));
+  QGauss<dim> dil_quad(
+    input_db->getIntegerWithDefault("pk1_dil_n_points_1d", 1));
+  std::vector<std::unique_ptr<fdl::ForceContribution<dim, spacedim>>> forces;
+  forces.emplace_back(new DeviatoricStress<dim, spacedim>(
+    dev_quad, input_db->getDoubleWithDefault("c1", 0.05)));
+  forces.emplace_back(new DilationalStress<dim, spacedim>(
+    dil_quad,
+    input_db->getDoubleWithDefault("p0", 0.0),
+    input_db->getDoubleWithDefault("beta", 0.0)));
+
+  parts.emplace_back(native_tria, fe, std::move(forces));
+  tbox::Pointer<fdl::IFEDMethod<spacedim>> ib_method_ops =
+    new fdl::IFEDMethod<dim>("ifed_method",
+                             input_db->getDatabase("IFEDMethod"),
+                             std::move(parts));
+
+  tbox::Pointer<geom::CartesianGridGeometry<spacedim>> grid_geometry =
+    new geom::CartesianGridGeometry<spacedim>(
+      "CartesianGeometry",
+      app_initializer->getComponentDatabase("CartesianGeometry"));
+  tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy =
+    new hier::PatchHierarchy<spacedim>("PatchHierarchy", grid_geometry);
+  tbox::Pointer<mesh::LoadBalancer<spacedim>> load_balancer =
+    new mesh::LoadBalancer<spacedim>(
+      "LoadBalancer", app_initializer->getComponentDatabase("LoadBalancer"));
+  tbox::Pointer<mesh::BergerRigoutsos<spacedim>> box_generator =
+    new mesh::BergerRigoutsos<spacedim>();
+
+  tbox::Pointer<IBAMR::INSStaggeredHierarchyIntegrator>
+    navier_stokes_integrator = new IBAMR::INSStaggeredHierarchyIntegrator(
+      "INSStaggeredHierarchyIntegrator",
+      app_initializer->getComponentDatabase("INSStaggeredHierarchyIntegrator"));
+
+  tbox::Pointer<IBAMR::IBHierarchyIntegrator> time_integrator =
+    new IBAMR::IBExplicitHierarchyIntegrator(
+      "IBHierarchyIntegrator",
+      app_initializer->getComponentDatabase("IBHierarchyIntegrator"),
+      ib_method_ops,
+      navier_stokes_integrator);
+  time_integrator->registerLoadBalancer(load_balancer);
+
+  tbox::Pointer<mesh::StandardTagAndInitialize<spacedim>> error_detector =
+    new mesh::StandardTagAndInitialize<spacedim>(
+      "StandardTagAndInitialize",
+      time_integrator,
+      app_initializer->getComponentDatabase("StandardTagAndInitialize"));
+  tbox::Pointer<mesh::GriddingAlgorithm<spacedim>> gridding_algorithm =
+    new mesh::GriddingAlgorithm<spacedim>("GriddingAlgorithm",
+                                          app_initializer->getComponentDatabase(
+                                            "GriddingAlgorithm"),
+                                          error_detector,
+                                          box_generator,
+                                          load_balancer);
+
+  std::vector<solv::RobinBcCoefStrategy<spacedim> *> u_bc_coefs(spacedim);
+  for (int d = 0; d < spacedim; ++d)
+    u_bc_coefs[d] = new IBTK::muParserRobinBcCoefs(
+      "u_bc_coefs_" + std::to_string(d),
+      app_initializer->getComponentDatabase("VelocityBcCoefs_" +
+                                            std::to_string(d)),
+      grid_geometry);
+  navier_stokes_integrator->registerPhysicalBoundaryConditions(u_bc_coefs);
+
+  time_integrator->initializePatchHierarchy(patch_hierarchy,
+                                            gridding_algorithm);
+
+  // Main time step loop. The first few steps (which set up data structures
+  // and caches) are not timed.
+  const int n_warmup_steps =
+    bench_db->getIntegerWithDefault("n_warmup_steps", 1);
+  int    n_steps             = 0;
+  int    n_regrids           = 0;
+  int    n_stokes_iterations = 0;
+  double loop_time           = time_integrator->getIntegratorTime();
+  double start_time          = MPI_Wtime();
+  const double loop_time_end = time_integrator->getEndTime();
+  while (!tbox::MathUtilities<double>::equalEps(loop_time, loop_time_end) &&
+         time_integrator->stepsRemaining())
+    {
+      if (n_steps == n_warmup_steps)
+        {
+          tbox::TimerManager::getManager()->resetAllTimers();
+          fdl::PhaseTimings::get().reset();
+          n_regrids           = 0;
+          n_stokes_iterations = 0;
+          start_time          = MPI_Wtime();
+        }
+      if (time_integrator->atRegridPoint())
+        ++n_regrids;
+
+      const double dt = time_integrator->getMaximumTimeStepSize();
+      time_integrator->advanceHierarchy(dt);
+      loop_time += dt;
+      n_stokes_iterations +=
+        navier_stokes_integrator->getStokesSolver()->getNumIterations();
+      ++n_steps;
+    }
+  const double wall_time =
+    Utilities::MPI::max(MPI_Wtime() - start_time, mpi_comm);
+  const int n_timed_steps = std::max(n_steps - n_warmup_steps, 0);
+
+  // Compute the load on each processor:
+  double    n_eulerian_cells    = 0.0;
+  double    lagrangian_workload = 0.0;
+  const int workload_idx =
+    ib_method_ops->get_lagrangian_workload_current_index();
+  for (int ln = 0; ln <= patch_hierarchy->getFinestLevelNumber(); ++ln)
+    for (const auto &patch :
+         fdl::extract_patches(patch_hierarchy->getPatchLevel(ln)))
+      {
+        n_eulerian_cells += patch->getBox().size();
+        tbox::Pointer<pdat::CellData<spacedim, double>> workload_data =
+          patch->getPatchData(workload_idx);
+        for (pdat::CellIterator<spacedim> ci(patch->getBox()); ci; ci++)
+          lagrangian_workload += (*workload_data)(ci(), 0);
+      }
+  const auto &dof_handler = ib_method_ops->get_part(0).get_dof_handler();
+  const double n_lagrangian_dofs =
+    dof_handler.locally_owned_dofs().n_elements();
+
+  // Write everything. Timers are local to each processor, so their
+  // distribution over the processors shows the load imbalance of each phase.
+  const std::vector<std::pair<std::string, std::string>> phases{
+    {"interpolate", "fdl::IFEDMethod::interpolateVelocity()"},
+    {"spread", "fdl::IFEDMethod::spreadForce()"},
+    {"force", "fdl::IFEDMethod::computeLagrangianForce()"},
+    {"solve", "IBAMR::INSStaggeredHierarchyIntegrator::integrateHierarchy()"},
+    {"regrid", "IBAMR::HierarchyIntegrator::regridHierarchy()"}};
+
+  std::ostringstream out;
+  out << std::setprecision(8);
+  out << "{\"fiddle_version\": \"" << FDL_VERSION_MAJOR << '.'
+      << FDL_VERSION_MINOR << '.' << FDL_VERSION_PATCH << "\", ";
+  out << "\"spacedim\": " << spacedim << ", ";
+  out << "\"n_processes\": " << Utilities::MPI::n_mpi_processes(mpi_comm)
+      << ", ";
+  out << "\"N\": " << input_db->getInteger("N") << ", ";
+  out << "\"MFAC\": " << input_db->getDouble("MFAC") << ", ";
+  out << "\"fe_degree\": " << fe.degree << ", ";
+  out << "\"n_elements\": " << native_tria.n_global_active_cells() << ", ";
+  out << "\"n_dofs\": " << dof_handler.n_dofs() << ", ";
+  out << "\"n_levels\": " << patch_hierarchy->getNumberOfLevels() << ", ";
+  out << "\"n_steps\": " << n_timed_steps << ", ";
+  out << "\"n_regrids\": " << n_regrids << ", ";
+  out << "\"wall_time\": " << wall_time << ", ";
+  out << "\"stokes_iterations\": {\"total\": " << n_stokes_iterations
+      << ", \"mean\": "
+      << (n_timed_steps > 0 ? double(n_stokes_iterations) / n_timed_steps :
+                              0.0)
+      << "}, ";
+  out << "\"phases\": {";
+  for (unsigned int i = 0; i < phases.size(); ++i)
+    {
+      const double time = tbox::TimerManager::getManager()
+                            ->getTimer(phases[i].second)
+                            ->getTotalWallclockTime();
+      out << (i == 0 ? "" : ", ") << '"' << phases[i].first << "\": ";
+      write_statistics(out, time, mpi_comm);
+    }
+  out << "}, ";
+  out << "\"load\": {\"eulerian_cells\": ";
+  write_statistics(out, n_eulerian_cells, mpi_comm);
+  out << ", \"lagrangian_workload\": ";
+  write_statistics(out, lagrangian_workload, mpi_comm);
+  out << ", \"lagrangian_dofs\": ";
+  write_statistics(out, n_lagrangian_dofs, mpi_comm);
+  out << "}}";
+
+  if (Utilities::MPI::this_mpi_process(mpi_comm) == 0)
+    {
+      std::ofstream output(
+        bench_db->getStringWithDefault("output_file", "scaling.json"));
+      output << out.str() << std::endl;
+    }
+
+  // Also write every phase timed by fiddle, which does not require barriers.
+  std::ofstream phase_output;
+  if (Utilities::MPI::this_mpi_process(mpi_comm) == 0)
+    phase_output.open(bench_db->getStringWithDefault("phase_timings_file",
+                                                     "phase_timings.csv"));
+  fdl::PhaseTimings::get().write(phase_output,
+                                 mpi_comm,
+                                 fdl::PhaseTimings::Format::CSV);
+
+  // Memory usage of each rank, which is mostly determined by replicated data.
+  ib_method_ops->write_memory_report(tbox::plog);
+
+  for (auto ptr : u_bc_coefs)
+    delete ptr;
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit                      ibtk_init(argc, argv, MPI_COMM_WORLD);
+  tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "scaling.log");
+
+  run<NDIM>(app_initializer);
+}
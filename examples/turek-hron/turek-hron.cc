@@ -5,6 +5,8 @@
 #include <fiddle/mechanics/force_contribution.h>
 #include <fiddle/mechanics/force_contribution_lib.h>
 
+#include <fiddle/postprocess/background_writer.h>
+
 #include <deal.II/distributed/shared_tria.h>
 
 #include <deal.II/dofs/dof_handler.h>
@@ -12,15 +14,12 @@
 
 #include <deal.II/fe/fe_q.h>
 #include <deal.II/fe/fe_system.h>
-#include <deal.II/fe/mapping_fe_field.h>
 
 #include <deal.II/grid/grid_generator.h>
 #include <deal.II/grid/grid_tools.h>
 #include <deal.II/grid/manifold_lib.h>
 #include <deal.II/grid/tria.h>
 
-#include <deal.II/numerics/data_out.h>
-
 #include <ibamr/IBExplicitHierarchyIntegrator.h>
 #include <ibamr/INSStaggeredHierarchyIntegrator.h>
 
@@ -372,7 +371,12 @@ main(int argc, char *argv[])
   tbox::plog << "Input database:\n";
   input_db->printClassData(tbox::plog);
 
-  // Write out initial visualization data.
+  // Write out initial visualization data. Parts are written in the
+  // background while the next time steps are computed.
+  fdl::BackgroundWriter<1, 2> surface_part_writer(
+    app_initializer->getVizDumpDirectory(), IBTK::IBTK_MPI::getCommunicator());
+  fdl::BackgroundWriter<2, 2> part_writer(
+    app_initializer->getVizDumpDirectory(), IBTK::IBTK_MPI::getCommunicator());
   int    iteration_num = time_integrator->getIntegratorStep();
   double loop_time     = time_integrator->getIntegratorTime();
   if (dump_viz_data)
@@ -388,36 +392,11 @@ main(int argc, char *argv[])
 
       if (ib_method_ops->n_surface_parts() > 0)
         {
-          const auto   &part = ib_method_ops->get_surface_part(0);
-          DataOut<1, 2> data_out;
-          data_out.attach_dof_handler(part.get_dof_handler());
-          data_out.add_data_vector(part.get_velocity(), "U");
-
-          MappingFEField<1, 2, LinearAlgebra::distributed::Vector<double>>
-            position_mapping(part.get_dof_handler(), part.get_position());
-          data_out.build_patches(position_mapping);
-          data_out.write_vtu_with_pvtu_record(
-            app_initializer->getVizDumpDirectory() + "/",
-            "penalty",
-            iteration_num,
-            IBTK::IBTK_MPI::getCommunicator(),
-            8);
+          surface_part_writer.write_part(
+            ib_method_ops->get_surface_part(0), "penalty", iteration_num);
         }
 
-      const auto &part = ib_method_ops->get_part(0);
-      DataOut<2>  data_out;
-      data_out.attach_dof_handler(part.get_dof_handler());
-      data_out.add_data_vector(part.get_velocity(), "U");
-
-      MappingFEField<2, 2, LinearAlgebra::distributed::Vector<double>>
-        position_mapping(part.get_dof_handler(), part.get_position());
-      data_out.build_patches(position_mapping);
-      data_out.write_vtu_with_pvtu_record(
-        app_initializer->getVizDumpDirectory() + "/",
-        "part",
-        iteration_num,
-        IBTK::IBTK_MPI::getCommunicator(),
-        8);
+      part_writer.write_part(ib_method_ops->get_part(0), "part", iteration_num);
     }
 
   // Open streams to save lift and drag coefficients.
@@ -475,36 +454,13 @@ main(int argc, char *argv[])
 
           if (ib_method_ops->n_surface_parts() > 0)
             {
-              const auto   &part = ib_method_ops->get_surface_part(0);
-              DataOut<1, 2> data_out;
-              data_out.attach_dof_handler(part.get_dof_handler());
-              data_out.add_data_vector(part.get_velocity(), "U");
-
-              MappingFEField<1, 2, LinearAlgebra::distributed::Vector<double>>
-                position_mapping(part.get_dof_handler(), part.get_position());
-              data_out.build_patches(position_mapping);
-              data_out.write_vtu_with_pvtu_record(
-                app_initializer->getVizDumpDirectory() + "/",
-                "penalty",
-                iteration_num,
-                IBTK::IBTK_MPI::getCommunicator(),
-                8);
+              surface_part_writer.write_part(
+                ib_method_ops->get_surface_part(0), "penalty", iteration_num);
             }
 
-          const auto &part = ib_method_ops->get_part(0);
-          DataOut<2>  data_out;
-          data_out.attach_dof_handler(part.get_dof_handler());
-          data_out.add_data_vector(part.get_velocity(), "U");
-
-          MappingFEField<2, 2, LinearAlgebra::distributed::Vector<double>>
-            position_mapping(part.get_dof_handler(), part.get_position());
-          data_out.build_patches(position_mapping);
-          data_out.write_vtu_with_pvtu_record(
-            app_initializer->getVizDumpDirectory() + "/",
-            "part",
-            iteration_num,
-            IBTK::IBTK_MPI::getCommunicator(),
-            8);
+          part_writer.write_part(ib_method_ops->get_part(0),
+                                 "part",
+                                 iteration_num);
         }
       if (dump_restart_data &&
           (iteration_num % restart_dump_interval == 0 || last_step))
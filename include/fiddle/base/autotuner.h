@@ -0,0 +1,101 @@
+#ifndef included_fiddle_base_autotuner_h
+#define included_fiddle_base_autotuner_h
+
+#include <fiddle/base/config.h>
+
+#include <mpi.h>
+
+#include <vector>
+
+namespace fdl
+{
+  /**
+   * Class which picks the fastest of several candidate values of a
+   * performance parameter (e.g., a number of preconditioner corrections or
+   * threads) by timing each one on the first few uses.
+   *
+   * Candidates are tried in order: each one is used for @p n_trials calls to
+   * add_time(), after which the next one is used. Since the first use of a
+   * candidate may include one-time setup (e.g., estimating eigenvalues), it
+   * is not counted when there is more than one trial. Once every candidate
+   * has been timed, the slowest processor's time of each candidate is
+   * compared and the fastest candidate is used from then on.
+   *
+   * Every processor must call add_time() the same number of times.
+   */
+  class Autotuner
+  {
+  public:
+    /**
+     * Constructor.
+     */
+    Autotuner(const std::vector<int> &candidates, const unsigned int n_trials);
+
+    /**
+     * Return whether or not a candidate has been chosen.
+     */
+    bool
+    is_tuned() const;
+
+    /**
+     * Return the candidate which should be used next, i.e., either the one
+     * currently being timed or the chosen one.
+     */
+    int
+    get_value() const;
+
+    /**
+     * Record the wall time, in seconds, of one use of get_value(). Return
+     * true if this was the last trial, i.e., if a candidate was just chosen.
+     *
+     * @note The last call before tuning finishes is collective over @p comm.
+     */
+    bool
+    add_time(const double time, const MPI_Comm comm);
+
+    /**
+     * Skip tuning and use @p value from now on, e.g., a value chosen in a
+     * previous run.
+     */
+    void
+    set_value(const int value);
+
+  protected:
+    std::vector<int> candidates;
+
+    unsigned int n_trials;
+
+    /**
+     * Number of calls to add_time() so far.
+     */
+    unsigned int n_times;
+
+    /**
+     * Total time of each candidate.
+     */
+    std::vector<double> times;
+
+    /**
+     * Chosen value, if is_tuned() is true.
+     */
+    int value;
+
+    bool tuned;
+  };
+
+  // --------------------------- inline functions --------------------------- //
+
+  inline bool
+  Autotuner::is_tuned() const
+  {
+    return tuned;
+  }
+
+  inline int
+  Autotuner::get_value() const
+  {
+    return tuned ? value : candidates[n_times / n_trials];
+  }
+} // namespace fdl
+
+#endif
@@ -0,0 +1,198 @@
+#ifndef included_fiddle_base_execution_policy_h
+#define included_fiddle_base_execution_policy_h
+
+#include <fiddle/base/config.h>
+
+#include <fiddle/base/exceptions.h>
+
+#include <deal.II/base/parallel.h>
+
+#include <algorithm>
+#include <string>
+
+namespace SAMRAI
+{
+  namespace tbox
+  {
+    class Database;
+
+    template <class TYPE>
+    class Pointer;
+  } // namespace tbox
+} // namespace SAMRAI
+
+namespace fdl
+{
+  using namespace dealii;
+  using namespace SAMRAI;
+
+  /**
+   * Possible ways in which work is split between threads.
+   */
+  enum class ThreadPartitioning
+  {
+    /**
+     * Split the work into ranges a few times smaller than the amount of work
+     * per thread, so that the scheduler can balance uneven work (e.g.,
+     * patches with very different numbers of points) by giving more ranges
+     * to threads which finish early.
+     */
+    Dynamic,
+    /**
+     * Split the work into one contiguous range per thread. This keeps
+     * neighboring patches (and the data they share) on the same thread but
+     * only works well if the work is evenly distributed.
+     */
+    Static
+  };
+
+  /**
+   * Convert a name used in an input database ("DYNAMIC" or "STATIC") to the
+   * equivalent ThreadPartitioning.
+   */
+  inline ThreadPartitioning
+  to_thread_partitioning(const std::string &partitioning_name)
+  {
+    if (partitioning_name == "DYNAMIC")
+      return ThreadPartitioning::Dynamic;
+    else if (partitioning_name == "STATIC")
+      return ThreadPartitioning::Static;
+    AssertThrow(false,
+                ExcMessage("Unknown thread partitioning " + partitioning_name +
+                           ": valid names are DYNAMIC and STATIC."));
+    return ThreadPartitioning::Dynamic;
+  }
+
+  /**
+   * Description of how the computational (i.e., not communication) parts of
+   * fiddle use threads on each MPI process: the maximum number of threads and
+   * how work is split between them. Every function and class which can use
+   * threads (e.g., compute_projection_rhs(), compute_spread(), and the
+   * interaction classes) takes one of these objects.
+   *
+   * The actual number of threads is also limited by
+   * MultithreadInfo::n_threads(), which IFEDMethodBase sets to one since
+   * IBAMR does not use threads: IFEDMethod raises it to the number of
+   * threads requested in its input database.
+   *
+   * <h3>Thread safety</h3>
+   * fiddle uses a hybrid MPI+threads model in which all MPI communication,
+   * timing, and tracing is done by the thread which called MPI_Init() (the
+   * main thread) and threads are only used inside individual functions. In
+   * particular:
+   * <ul>
+   *   <li>Distinct objects may be used concurrently from different threads,
+   *     but a single InteractionBase, Scatter, PatchMap, or Part object may
+   *     not (e.g., they contain caches which are updated by const member
+   *     functions).</li>
+   *   <li>Scatter objects (and, therefore, the interaction classes) must only
+   *     communicate on the main thread since fiddle does not require
+   *     MPI_THREAD_MULTIPLE.</li>
+   *   <li>ScopedTimer, PhaseTimings, Tracer, and TraceScope ignore calls made
+   *     on other threads, since SAMRAI's timers are not thread-safe.</li>
+   *   <li>Timers set up with FDL_SETUP_TIMER and the other function-local
+   *     static data in fiddle are initialized and updated in a thread-safe
+   *     way.</li>
+   * </ul>
+   */
+  class ExecutionPolicy
+  {
+  public:
+    /**
+     * Constructor. This is intentionally not explicit, so that a number of
+     * threads may be passed wherever an ExecutionPolicy is expected.
+     */
+    ExecutionPolicy(
+      const unsigned int       n_threads    = 1,
+      const ThreadPartitioning partitioning = ThreadPartitioning::Dynamic);
+
+    /**
+     * Constructor. Reads the integer <code>n_threads</code> (default 1) and
+     * the string <code>thread_partitioning</code> (either DYNAMIC, the
+     * default, or STATIC) from @p input_db.
+     */
+    ExecutionPolicy(const tbox::Pointer<tbox::Database> &input_db);
+
+    /**
+     * Write the values read by the constructor to @p output_db, e.g., to set
+     * up an object which reads its parameters from a database.
+     */
+    void
+    put_to_database(const tbox::Pointer<tbox::Database> &output_db) const;
+
+    /**
+     * Return the maximum number of threads.
+     */
+    unsigned int
+    get_n_threads() const
+    {
+      return n_threads;
+    }
+
+    /**
+     * Return the way work is split between threads.
+     */
+    ThreadPartitioning
+    get_partitioning() const
+    {
+      return partitioning;
+    }
+
+    /**
+     * Return whether or not work is done on the calling thread alone.
+     */
+    bool
+    is_serial() const
+    {
+      return n_threads <= 1;
+    }
+
+    /**
+     * Return the number of items of work (e.g., patches or nodes) which
+     * should be processed together by one thread when there are
+     * @p n_items in total. The result is at least @p min_grain_size, which
+     * should be large enough that the cost of scheduling a range does not
+     * dominate.
+     */
+    std::size_t
+    get_grain_size(const std::size_t n_items,
+                   const std::size_t min_grain_size = 1) const;
+
+    /**
+     * Call @p f on contiguous ranges [begin, end) covering [0, n_items),
+     * with sizes determined by get_grain_size(). If this policy is not
+     * serial then ranges are processed concurrently, so @p f should allocate
+     * its own scratch data.
+     */
+    template <typename F>
+    void
+    apply_to_ranges(const std::size_t n_items,
+                    const F          &f,
+                    const std::size_t min_grain_size = 1) const
+    {
+      if (is_serial() || n_items <= 1)
+        f(std::size_t(0), n_items);
+      else
+        parallel::apply_to_subranges(std::size_t(0),
+                                     n_items,
+                                     f,
+                                     static_cast<unsigned int>(
+                                       get_grain_size(n_items,
+                                                      min_grain_size)));
+    }
+
+  protected:
+    unsigned int n_threads;
+
+    ThreadPartitioning partitioning;
+  };
+
+  /**
+   * Return whether or not the calling thread is the main thread, i.e., the
+   * thread which loaded fiddle (and, in practice, called MPI_Init()).
+   */
+  bool
+  is_main_thread();
+} // namespace fdl
+
+#endif
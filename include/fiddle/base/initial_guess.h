@@ -3,46 +3,158 @@
 
 #include <fiddle/base/config.h>
 
+#include <fiddle/base/exceptions.h>
+
 #include <ibtk/config.h>
 
 IBTK_DISABLE_EXTRA_WARNINGS
 #include <Eigen/Core>
 IBTK_ENABLE_EXTRA_WARNINGS
 
-#include <deque>
+#include <array>
+#include <limits>
+#include <string>
+#include <vector>
 
 namespace fdl
 {
+  /**
+   * Ways in which InitialGuess can compute initial guesses.
+   */
+  enum class InitialGuessMethod
+  {
+    /**
+     * Project the right-hand side onto the span of the previous right-hand
+     * sides and use the same linear combination of the previous solutions.
+     */
+    Projection,
+    /**
+     * Extrapolate, with a polynomial of degree at most two, from the last
+     * three solutions. This is cheaper than projecting and is typically more
+     * accurate when the solutions come from a smooth time series. Since
+     * extrapolation assumes that solutions are submitted at roughly equal
+     * time intervals, InitialGuess falls back to projection whenever
+     * projection required fewer iterations the last time it was used.
+     */
+    Extrapolation
+  };
+
+  /**
+   * Convert a string (either "PROJECTION" or "EXTRAPOLATION") to the equivalent
+   * InitialGuessMethod.
+   */
+  inline InitialGuessMethod
+  to_initial_guess_method(const std::string &method_name)
+  {
+    if (method_name == "PROJECTION")
+      return InitialGuessMethod::Projection;
+    else if (method_name == "EXTRAPOLATION")
+      return InitialGuessMethod::Extrapolation;
+    AssertThrow(false,
+                ExcMessage("unsupported initial guess method " + method_name +
+                           "."));
+    return InitialGuessMethod::Projection;
+  }
+
   /**
    * Class for computing initial guesses - essentially the same as
    * IBTK::InitialGuess. Uses the 'Fischer-3' algorithm (same as PETSc) to
    * compute guesses via projection.
+   *
+   * Alternatively, guesses may be computed by extrapolation (see
+   * InitialGuessMethod). In that case the number of iterations required by
+   * the linear solver should be passed to submit() so that this class can
+   * use whichever method is currently working best.
+   *
+   * Vectors are stored in a ring buffer so that, once it is full, submitting
+   * a new vector overwrites the oldest one without allocating memory. Each
+   * call to submit() or guess() computes at most one set of inner products,
+   * which, for parallel vectors, requires a single global reduction.
    */
   template <typename VectorType>
   class InitialGuess
   {
   public:
-    explicit InitialGuess(const unsigned int n_vectors = 5);
+    explicit InitialGuess(
+      const unsigned int       n_vectors = 5,
+      const InitialGuessMethod method    = InitialGuessMethod::Projection);
 
+    /**
+     * Store a solution and right-hand side. If the solution was computed with
+     * a linear solver then @p n_iterations should be the number of iterations
+     * that solver required.
+     */
     void
-    submit(const VectorType &solution, const VectorType &rhs);
+    submit(const VectorType  &solution,
+           const VectorType  &rhs,
+           const unsigned int n_iterations =
+             std::numeric_limits<unsigned int>::max());
 
     void
     guess(VectorType &solution, const VectorType &rhs);
 
+    /**
+     * Return the l2 norm of the difference between @p rhs and the most
+     * recently submitted right-hand side, or a negative number if no
+     * right-hand sides have been submitted. This may be used to decide how
+     * accurately a solution needs to be computed: e.g., IFEDMethod can scale
+     * its solver tolerances by this quantity.
+     */
+    double
+    compute_rhs_change(const VectorType &rhs) const;
+
   protected:
+    /**
+     * Compute a guess by extrapolating from the previous solutions.
+     */
+    void
+    extrapolate(VectorType &solution);
+
+    /**
+     * Compute a guess by projecting onto the previous solutions.
+     */
+    void
+    project(VectorType &solution, const VectorType &rhs);
+
+    /**
+     * Number of guesses between attempts at using the method which is
+     * currently not the fastest, so that its iteration count stays current.
+     */
+    static constexpr unsigned int retry_interval = 10;
+
     unsigned int n_max_vectors;
     unsigned int n_stored_vectors;
 
-    // IBAMR always has Eigen, deal.II only optionally has LAPACK
+    // Index of the oldest vector in the ring buffer.
+    unsigned int first_index;
+
+    InitialGuessMethod method;
+
+    // Method used by the last call to guess().
+    InitialGuessMethod last_method;
+
+    // Number of calls to guess().
+    unsigned int n_guesses;
+
+    // Number of solver iterations required the last time each method was
+    // used, indexed by InitialGuessMethod.
+    std::array<unsigned int, 2> last_n_iterations;
+
+    // IBAMR always has Eigen, deal.II only optionally has LAPACK. Indexed by
+    // position in the ring buffer.
     Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> correlation_matrix;
 
+    // Inner products of last_rhs with the stored right-hand sides (indexed by
+    // position in the ring buffer) and, in the last entry, with itself.
     Eigen::VectorXd projection_coefficients;
 
     const VectorType *last_rhs;
 
-    std::deque<VectorType> solutions;
-    std::deque<VectorType> right_hand_sides;
+    std::vector<VectorType> solutions;
+    std::vector<VectorType> right_hand_sides;
+
+    // Work vector for compute_rhs_change().
+    mutable VectorType rhs_difference;
   };
 } // namespace fdl
 #endif
@@ -0,0 +1,70 @@
+#ifndef included_fiddle_base_markers_h
+#define included_fiddle_base_markers_h
+
+#include <fiddle/base/config.h>
+
+namespace fdl
+{
+  /**
+   * Region of code measured with LIKWID's marker API, e.g., to count flops,
+   * cache misses, and memory traffic with
+   * <code>likwid-perfctr -m -g MEM_DP ./executable</code>. The region starts
+   * when this object is created and stops when it is destroyed. The wall
+   * time of the region is also recorded in PhaseTimings::get() under the
+   * name <code>marker::name</code> so that the hardware counters can be
+   * matched with the structured timing report.
+   *
+   * Markers are only available if fiddle was configured with
+   * <code>-DFDL_ENABLE_LIKWID=ON</code>. Otherwise this class does nothing
+   * and FDL_MARKER_SCOPE does not even create an object, so markers may be
+   * placed inside hot loops. The marker API is initialized by the first
+   * marker (and, for each thread, by the first marker on that thread) and the
+   * counters are written when the program exits.
+   *
+   * @note LIKWID requires that region names not contain spaces.
+   *
+   * @note Regions may run on multiple threads but, since PhaseTimings is not
+   * thread-safe, only the time spent on the main thread (see
+   * is_main_thread()) is added to PhaseTimings.
+   */
+  class ScopedMarker
+  {
+  public:
+    /**
+     * Constructor. Starts the region @p name, which should have static
+     * storage duration since only the pointer is stored.
+     */
+    ScopedMarker(const char *name);
+
+    /**
+     * Destructor. Stops the region.
+     */
+    ~ScopedMarker();
+
+  protected:
+    const char *name;
+
+    /**
+     * Wall time at which the region started, or a negative number if it
+     * should not be recorded in PhaseTimings.
+     */
+    double start;
+  };
+} // namespace fdl
+
+/**
+ * Convenience macro which starts the marker region @p region_name until the
+ * end of the current scope. Expands to nothing unless fiddle was configured
+ * with LIKWID.
+ */
+#ifdef FDL_ENABLE_LIKWID
+#  define FDL_MARKER_SCOPE(variable_name, region_name) \
+    ::fdl::ScopedMarker variable_name(region_name)
+#else
+#  define FDL_MARKER_SCOPE(variable_name, region_name) \
+    do                                                 \
+      {                                                \
+    } while (false)
+#endif
+
+#endif
@@ -0,0 +1,170 @@
+#ifndef included_fiddle_base_phase_timings_h
+#define included_fiddle_base_phase_timings_h
+
+#include <fiddle/base/config.h>
+
+#include <mpi.h>
+
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace SAMRAI
+{
+  namespace tbox
+  {
+    class Timer;
+  }
+} // namespace SAMRAI
+
+namespace fdl
+{
+  using namespace SAMRAI;
+
+  /**
+   * Statistics, over all processors, of the wall time spent in one phase.
+   */
+  struct PhaseStatistics
+  {
+    /**
+     * Name of the timer used for the phase.
+     */
+    std::string name;
+
+    /**
+     * Maximum number of times, over all processors, the phase was run.
+     */
+    unsigned long n_calls;
+
+    /**
+     * Minimum, mean, and maximum total wall time, in seconds, spent in the
+     * phase by a processor (or, for quantities which are not times, the
+     * minimum, mean, and maximum totals).
+     */
+    double min;
+    double mean;
+    double max;
+
+    /**
+     * Ratio of the maximum to the mean (i.e., 1 when the phase is perfectly
+     * balanced).
+     */
+    double imbalance;
+  };
+
+  /**
+   * Process-local record of the wall time spent in each phase timed by a
+   * ScopedTimer (and, therefore, by FDL_SETUP_TIMER_AND_SCOPE).
+   *
+   * Unlike SAMRAI's timers, which are typically made comparable between
+   * processors by adding barriers before each phase (see
+   * FDL_ENABLE_TIMER_BARRIERS), recording a time only touches a local buffer:
+   * all communication is deferred to compute_statistics(), which should be
+   * called at the end of a simulation or every few time steps. The imbalance
+   * of each phase is then available without perturbing the overlap of
+   * communication and computation we are trying to measure.
+   *
+   * Times are inclusive: if one timed phase runs another then the time of
+   * the inner phase is also counted in the outer one.
+   *
+   * @note Like SAMRAI's timers, this class is not thread-safe: phases should
+   * only be timed by the thread which called MPI_Init(). Times added on any
+   * other thread are ignored (see is_main_thread()).
+   */
+  class PhaseTimings
+  {
+  public:
+    /**
+     * Output format used by write().
+     */
+    enum class Format
+    {
+      CSV,
+      JSON
+    };
+
+    /**
+     * Get the global instance used by ScopedTimer.
+     */
+    static PhaseTimings &
+    get();
+
+    /**
+     * Enable or disable recording (enabled by default).
+     */
+    void
+    set_enabled(const bool enable);
+
+    /**
+     * Return whether or not times are being recorded.
+     */
+    bool
+    is_enabled() const;
+
+    /**
+     * Add @p elapsed seconds to the total for the phase timed by @p timer.
+     */
+    void
+    add(const tbox::Timer *timer, const double elapsed);
+
+    /**
+     * Same as the other add() function, but for a phase not associated with
+     * a SAMRAI timer. Since only sums are stored, this may also be used to
+     * report other additive quantities, like the number of bytes sent by
+     * each Scatter.
+     */
+    void
+    add(const std::string &name, const double elapsed);
+
+    /**
+     * Discard all recorded times, e.g., after writing a report for the last
+     * few time steps.
+     */
+    void
+    reset();
+
+    /**
+     * Compute the statistics of every phase run by at least one processor
+     * in @p comm. The result is sorted by name.
+     *
+     * @note This function is collective over @p comm.
+     */
+    std::vector<PhaseStatistics>
+    compute_statistics(const MPI_Comm comm) const;
+
+    /**
+     * Compute statistics with compute_statistics() and write them to @p out
+     * on the first processor of @p comm in the given format.
+     *
+     * @note This function is collective over @p comm.
+     */
+    void
+    write(std::ostream &out, const MPI_Comm comm, const Format format) const;
+
+  protected:
+    /**
+     * Total time and number of calls of a single phase.
+     */
+    struct Entry
+    {
+      std::string   name;
+      double        time    = 0.0;
+      unsigned long n_calls = 0;
+    };
+
+    bool enabled = true;
+
+    /**
+     * Entries keyed by timer (which is cheaper than looking up names).
+     */
+    std::unordered_map<const tbox::Timer *, Entry> timer_entries;
+
+    /**
+     * Entries of phases without a timer.
+     */
+    std::unordered_map<std::string, Entry> named_entries;
+  };
+} // namespace fdl
+
+#endif
@@ -8,6 +8,7 @@
 #include <deal.II/base/quadrature.h>
 
 #include <deque>
+#include <vector>
 
 namespace fdl
 {
@@ -216,6 +217,119 @@ namespace fdl
     mutable std::vector<double> mean_point_distances;
   };
 
+  /**
+   * Family of equispaced quadrature rules on hypercubes: the rule with index
+   * @p n_points_1D is the iterated midpoint rule with
+   * <code>max(1, min_points_1D, n_points_1D)</code> points in each coordinate
+   * direction, so the points form a uniform lattice and all weights are
+   * equal.
+   *
+   * These rules only integrate linear functions exactly. However, for a given
+   * number of points, they have the smallest possible maximum distance
+   * between neighboring points and, unlike QGaussFamily, may use a single
+   * point on cells which are much smaller than the Eulerian cells. Hence they
+   * are useful when the quadrature rule is only needed to place IB points
+   * with a specified density.
+   */
+  template <int dim>
+  class QEquispacedFamily : public QuadratureFamily<dim>
+  {
+  public:
+    /**
+     * Constructor. Here @p min_points_1D is the minimum number of points in
+     * each coordinate direction.
+     */
+    QEquispacedFamily(const unsigned int min_points_1D,
+                      const double       point_density = 1.0,
+                      const DensityKind  density_kind  = DensityKind::Minimum);
+
+    virtual const Quadrature<dim> &
+    operator[](const unsigned char n_points_1D) const override;
+
+    virtual unsigned char
+    get_index(const double eulerian_length,
+              const double lagrangian_length) const override;
+
+    /**
+     * Get the vector of maximum point distances.
+     */
+    const std::vector<double> &
+    get_max_point_distances() const;
+
+  protected:
+    unsigned int min_points_1D;
+
+    double point_density;
+
+    double density_factor;
+
+    /**
+     * Quadratures. Uses a deque so that references are not invalidated.
+     */
+    mutable std::deque<Quadrature<dim>> quadratures;
+
+    /**
+     * Maximum distance between nearest neighbors of quadrature points - i.e.,
+     * the lattice spacing.
+     */
+    mutable std::vector<double> max_point_distances;
+  };
+
+  /**
+   * Family of equispaced quadrature rules on simplices: the rule with index
+   * @p n_points_1D places one point at the centroid of each child of the
+   * reference simplex after it is uniformly subdivided into the smallest
+   * power of two of at least <code>max(1, min_points_1D, n_points_1D)</code>
+   * parts along each edge. All weights are equal.
+   *
+   * Like QEquispacedFamily, these rules only integrate linear functions
+   * exactly and are intended for placing IB points.
+   */
+  template <int dim>
+  class QEquispacedSimplexFamily : public QuadratureFamily<dim>
+  {
+  public:
+    /**
+     * Constructor. Here @p min_points_1D is the minimum number of
+     * subdivisions of each edge.
+     */
+    QEquispacedSimplexFamily(
+      const unsigned int min_points_1D,
+      const double       point_density = 1.0,
+      const DensityKind  density_kind  = DensityKind::Minimum);
+
+    virtual const Quadrature<dim> &
+    operator[](const unsigned char n_points_1D) const override;
+
+    virtual unsigned char
+    get_index(const double eulerian_length,
+              const double lagrangian_length) const override;
+
+    /**
+     * Get the vector of maximum point distances.
+     */
+    const std::vector<double> &
+    get_max_point_distances() const;
+
+  protected:
+    unsigned int min_points_1D;
+
+    double point_density;
+
+    double density_factor;
+
+    /**
+     * Quadratures. Uses a deque so that references are not invalidated.
+     */
+    mutable std::deque<Quadrature<dim>> quadratures;
+
+    /**
+     * Maximum distance between nearest neighbors of quadrature points,
+     * measured (conservatively) as the edge length of the children.
+     */
+    mutable std::vector<double> max_point_distances;
+  };
+
 
   // Inline functions
   template <int dim>
@@ -231,6 +345,20 @@ namespace fdl
   {
     return max_point_distances;
   }
+
+  template <int dim>
+  const std::vector<double> &
+  QEquispacedFamily<dim>::get_max_point_distances() const
+  {
+    return max_point_distances;
+  }
+
+  template <int dim>
+  const std::vector<double> &
+  QEquispacedSimplexFamily<dim>::get_max_point_distances() const
+  {
+    return max_point_distances;
+  }
 } // namespace fdl
 
 #endif
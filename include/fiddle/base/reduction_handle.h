@@ -0,0 +1,199 @@
+#ifndef included_fiddle_base_reduction_handle_h
+#define included_fiddle_base_reduction_handle_h
+
+#include <fiddle/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+
+#include <mpi.h>
+
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * Class encapsulating a nonblocking sum, over all processors, of a vector
+   * of doubles (i.e., MPI_Iallreduce() with MPI_SUM) followed by some
+   * computation on the sums which produces the final result. This is similar
+   * to std::future: the result is only available after calling get().
+   *
+   * This is useful for diagnostics (e.g., fluxes through meters) whose values
+   * are not needed right away: the reduction can then complete while other
+   * work (e.g., the fluid solve) is done and get() only needs to be called
+   * when the value is actually logged.
+   *
+   * @note Like any other collective operation, every processor must start
+   * reductions on a given communicator in the same order. Reductions may
+   * complete in any order.
+   */
+  template <typename T>
+  class ReductionHandle
+  {
+  public:
+    /**
+     * Default constructor. Creates an invalid object.
+     */
+    ReductionHandle() = default;
+
+    /**
+     * Constructor. Starts summing @p local_values over @p comm. When the sum
+     * is complete, get() returns the result of calling @p finish on the sums.
+     */
+    ReductionHandle(
+      std::vector<double>                           local_values,
+      const MPI_Comm                                comm,
+      std::function<T(const std::vector<double> &)> finish);
+
+    /**
+     * Move constructor.
+     */
+    ReductionHandle(ReductionHandle<T> &&) = default;
+
+    /**
+     * Move assignment. Waits for the current reduction, if there is one, to
+     * finish first.
+     */
+    ReductionHandle<T> &
+    operator=(ReductionHandle<T> &&other);
+
+    /**
+     * Destructor. Waits for the reduction, if there is one, to finish since
+     * MPI may still be using the buffers of this object.
+     */
+    ~ReductionHandle();
+
+    /**
+     * Return whether or not this object has a result which has not yet been
+     * retrieved with get().
+     */
+    bool
+    valid() const;
+
+    /**
+     * Return whether or not the reduction has finished, i.e., whether or not
+     * get() will return without waiting.
+     */
+    bool
+    is_ready();
+
+    /**
+     * Wait for the reduction to finish and then return the result. After
+     * calling this function this object is no longer valid.
+     */
+    T
+    get();
+
+  protected:
+    /**
+     * Wait for the reduction to finish. Does nothing if there is no
+     * reduction.
+     */
+    void
+    wait();
+
+    /**
+     * Everything needed by the reduction. This is stored separately so that
+     * the buffers given to MPI do not move when this object is moved.
+     */
+    struct State
+    {
+      std::vector<double> local_values;
+
+      std::vector<double> sums;
+
+      MPI_Request request = MPI_REQUEST_NULL;
+
+      std::function<T(const std::vector<double> &)> finish;
+    };
+
+    std::unique_ptr<State> state;
+  };
+
+
+  // --------------------------- inline functions --------------------------- //
+
+
+  template <typename T>
+  ReductionHandle<T>::ReductionHandle(
+    std::vector<double>                           local_values,
+    const MPI_Comm                                comm,
+    std::function<T(const std::vector<double> &)> finish)
+    : state(std::make_unique<State>())
+  {
+    state->local_values = std::move(local_values);
+    state->sums.resize(state->local_values.size());
+    state->finish  = std::move(finish);
+    const int ierr = MPI_Iallreduce(state->local_values.data(),
+                                    state->sums.data(),
+                                    static_cast<int>(state->sums.size()),
+                                    MPI_DOUBLE,
+                                    MPI_SUM,
+                                    comm,
+                                    &state->request);
+    AssertThrowMPI(ierr);
+  }
+
+  template <typename T>
+  ReductionHandle<T> &
+  ReductionHandle<T>::operator=(ReductionHandle<T> &&other)
+  {
+    if (this != &other)
+      {
+        wait();
+        state = std::move(other.state);
+      }
+    return *this;
+  }
+
+  template <typename T>
+  ReductionHandle<T>::~ReductionHandle()
+  {
+    wait();
+  }
+
+  template <typename T>
+  bool
+  ReductionHandle<T>::valid() const
+  {
+    return bool(state);
+  }
+
+  template <typename T>
+  bool
+  ReductionHandle<T>::is_ready()
+  {
+    AssertThrow(state, ExcMessage("This object has no result."));
+    int       flag = 0;
+    const int ierr = MPI_Test(&state->request, &flag, MPI_STATUS_IGNORE);
+    AssertThrowMPI(ierr);
+    return flag != 0;
+  }
+
+  template <typename T>
+  T
+  ReductionHandle<T>::get()
+  {
+    AssertThrow(state, ExcMessage("This object has no result."));
+    wait();
+    const std::unique_ptr<State> finished_state = std::move(state);
+    return finished_state->finish(finished_state->sums);
+  }
+
+  template <typename T>
+  void
+  ReductionHandle<T>::wait()
+  {
+    if (state && state->request != MPI_REQUEST_NULL)
+      {
+        const int ierr = MPI_Wait(&state->request, MPI_STATUS_IGNORE);
+        AssertThrowMPI(ierr);
+      }
+  }
+} // namespace fdl
+
+#endif
@@ -5,6 +5,8 @@
 
 #include <tbox/TimerManager.h>
 
+#include <functional>
+#include <iosfwd>
 #include <string>
 #include <utility>
 #include <vector>
@@ -168,8 +170,9 @@ namespace fdl
   /**
    * Save the binary representation of an object in a database.
    *
-   * @note This function does an additional translation to base64 to avoid a bug
-   * in SAMRAI.
+   * @note The bytes are stored, without any encoding, in an integer array
+   * whose first entry is the number of bytes. SAMRAI's string and character
+   * array routines cannot store arbitrary bytes with every backend.
    */
   void
   save_binary(const std::string             &key,
@@ -177,17 +180,37 @@ namespace fdl
               const char                    *end,
               tbox::Pointer<tbox::Database> &database);
 
+  /**
+   * Same as above, but write the binary representation with @p write
+   * directly into the array stored in the database, e.g., with a
+   * boost::archive::binary_oarchive. This avoids creating any intermediate
+   * strings.
+   */
+  void
+  save_binary(const std::string                         &key,
+              const std::function<void(std::ostream &)> &write,
+              tbox::Pointer<tbox::Database>             &database);
+
   /**
    * Load the binary representation of an object from a database. This is the
    * inverse of save_binary.
    *
-   * @note This function does an additional translation from base64 to avoid a
-   * bug in SAMRAI.
+   * @note Restart databases written by older versions of this library, which
+   * stored base64-encoded strings, are also supported.
    */
   std::string
   load_binary(const std::string                   &key,
               const tbox::Pointer<tbox::Database> &database);
 
+  /**
+   * Same as above, but read the binary representation with @p read from a
+   * stream over the array stored in the database.
+   */
+  void
+  load_binary(const std::string                         &key,
+              const tbox::Pointer<tbox::Database>       &database,
+              const std::function<void(std::istream &)> &read);
+
   /**
    * Determine whether or not SAMRAI is initialized.
    */
@@ -211,7 +234,10 @@ namespace fdl
   stop_timer(const std::string &timer_name);
 
   /**
-   * Simple scoped SAMRAI timer.
+   * Simple scoped SAMRAI timer. The elapsed wall time is also recorded in
+   * PhaseTimings::get(). Since SAMRAI's timers are not thread-safe, this
+   * class does nothing when it is used on any thread other than the main
+   * thread (see is_main_thread()).
    */
   class ScopedTimer
   {
@@ -230,6 +256,11 @@ namespace fdl
 
   protected:
     tbox::Timer *timer;
+
+    /**
+     * Wall time at which the timer was started.
+     */
+    double start_time;
   };
 
   /**
@@ -242,20 +273,12 @@ namespace fdl
    * to find a timer, it must perform possibly hundreds of string comparisons.
    * This is a performance problem for short functions which we still want to
    * time. Hence, this macro sets up the timer as a static pointer and only
-   * defines it once.
+   * defines it once. Since the pointer is initialized like any other
+   * function-local static variable this is thread-safe.
    */
-#define FDL_SETUP_TIMER(timer_name, timer_str)                               \
-  static ::SAMRAI::tbox::Timer *timer_name = nullptr;                        \
-  do                                                                         \
-    {                                                                        \
-      static bool timer_is_setup = false;                                    \
-      if (!timer_is_setup)                                                   \
-        {                                                                    \
-          timer_name =                                                       \
-            ::SAMRAI::tbox::TimerManager::getManager()->getTimer(timer_str); \
-          timer_is_setup = true;                                             \
-        }                                                                    \
-  } while (false)
+#define FDL_SETUP_TIMER(timer_name, timer_str) \
+  static ::SAMRAI::tbox::Timer *timer_name =   \
+    ::SAMRAI::tbox::TimerManager::getManager()->getTimer(timer_str)
 
   /**
    * Convenience macro which sets up a ScopedTimer for the given timer.
@@ -0,0 +1,156 @@
+#ifndef included_fiddle_base_trace_h
+#define included_fiddle_base_trace_h
+
+#include <fiddle/base/config.h>
+
+#include <mpi.h>
+
+#include <string>
+#include <vector>
+
+namespace fdl
+{
+  /**
+   * Class recording a timeline of events on each processor (e.g., the start
+   * and finish of each Scatter and each state of an interaction Transaction)
+   * in the Chrome trace event format, which can be viewed with Perfetto
+   * (https://ui.perfetto.dev) or chrome://tracing. This shows whether or not
+   * communication actually overlaps with computation, which aggregate timers
+   * cannot.
+   *
+   * Recording is disabled by default and, when disabled, a TraceScope only
+   * checks a flag. When enabled, events are appended to a process-local
+   * buffer and nothing is written until write() is called.
+   *
+   * @note Like SAMRAI's timers, this class is not thread-safe: events should
+   * only be recorded by the thread which called MPI_Init(). Events added on
+   * any other thread are ignored (see is_main_thread()).
+   */
+  class Tracer
+  {
+  public:
+    /**
+     * Get the global instance.
+     */
+    static Tracer &
+    get();
+
+    /**
+     * Start recording events. The timestamps of all processors in @p comm
+     * are measured from a common origin, set after a barrier.
+     *
+     * @note This function is collective over @p comm.
+     */
+    void
+    enable(const MPI_Comm comm);
+
+    /**
+     * Stop recording events. Previously recorded events are kept.
+     */
+    void
+    disable();
+
+    /**
+     * Return whether or not events are being recorded.
+     */
+    bool
+    is_enabled() const
+    {
+      return enabled;
+    }
+
+    /**
+     * Record an event with name @p name and category @p category which ran
+     * from @p start to @p end (both as returned by MPI_Wtime()). If @p id is
+     * not negative then it is also stored with the event (e.g., to tell
+     * different parts apart). Both strings should have static storage
+     * duration since only the pointers are stored.
+     */
+    void
+    add_event(const char  *name,
+              const char  *category,
+              const double start,
+              const double end,
+              const int    id = -1);
+
+    /**
+     * Discard all recorded events.
+     */
+    void
+    clear();
+
+    /**
+     * Write all recorded events to @p file_name as a JSON trace. Each
+     * processor writes its own events to the file
+     * <code>file_name.rank.json</code>. Each processor is shown as a
+     * separate process in the trace viewer: to view all of them together
+     * concatenate the event arrays, e.g., with
+     * <code>jq -s '{traceEvents: map(.traceEvents) | add}' file_name.*.json
+     * </code>.
+     */
+    void
+    write(const std::string &file_name) const;
+
+  protected:
+    /**
+     * A single complete event.
+     */
+    struct Event
+    {
+      const char *name;
+      const char *category;
+      double      start;
+      double      end;
+      int         id;
+    };
+
+    bool enabled = false;
+
+    /**
+     * Rank of this processor in the communicator provided to enable().
+     */
+    int rank = 0;
+
+    /**
+     * Time, as returned by MPI_Wtime(), corresponding to zero in the trace.
+     */
+    double origin = 0.0;
+
+    std::vector<Event> events;
+  };
+
+  /**
+   * Record, with the global Tracer, an event lasting from the construction to
+   * the destruction of this object. Does nothing if the Tracer is not
+   * enabled.
+   */
+  class TraceScope
+  {
+  public:
+    /**
+     * Constructor. See Tracer::add_event() for a description of the
+     * arguments.
+     */
+    TraceScope(const char *name, const char *category, const int id = -1);
+
+    /**
+     * Destructor. Records the event.
+     */
+    ~TraceScope();
+
+  protected:
+    const char *name;
+
+    const char *category;
+
+    int id;
+
+    /**
+     * Start time of the event, or a negative number if the Tracer was not
+     * enabled when this object was created.
+     */
+    double start;
+  };
+} // namespace fdl
+
+#endif
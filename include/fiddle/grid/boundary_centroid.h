@@ -0,0 +1,117 @@
+#ifndef included_fiddle_grid_boundary_centroid_h
+#define included_fiddle_grid_boundary_centroid_h
+
+#include <fiddle/base/config.h>
+
+#include <deal.II/base/point.h>
+#include <deal.II/base/quadrature.h>
+#include <deal.II/base/tensor.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <mpi.h>
+
+#include <vector>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * Class for repeatedly computing the centroid of the surface defined by
+   * some boundary ids of a Part (i.e., the same value as compute_centroid()
+   * with a MappingFEField defined by the position) as the position changes.
+   *
+   * The constructor finds the boundary faces and evaluates the shape
+   * functions and their reference gradients at the quadrature points of each
+   * type of face once. compute() then only gathers each face's position
+   * values and does a single reduction, so it is cheap enough to call at
+   * every time step.
+   *
+   * The finite element must be primitive and have @p dim components (e.g.,
+   * FESystem(FE_Q(k), dim)). Objects of this class must be recreated if the
+   * Triangulation or the DoF numbering changes.
+   */
+  template <int dim>
+  class BoundaryCentroid
+  {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param[in] dof_handler DoFHandler of the position.
+     *
+     * @param[in] boundary_ids Boundary ids of the faces which define the
+     * surface. May be unsorted and contain duplicates.
+     *
+     * @param[in] face_quadrature Quadrature rule on the reference face.
+     */
+    BoundaryCentroid(const DoFHandler<dim>                 &dof_handler,
+                     const std::vector<types::boundary_id> &boundary_ids,
+                     const Quadrature<dim - 1>             &face_quadrature);
+
+    /**
+     * Compute the centroid of the surface for the given position, which must
+     * have up-to-date ghost values. This call is collective over the
+     * Triangulation's communicator.
+     */
+    Point<dim>
+    compute(const LinearAlgebra::distributed::Vector<double> &position) const;
+
+    /**
+     * Return an estimate of the memory used by this object, in bytes.
+     */
+    std::size_t
+    memory_consumption() const;
+
+  protected:
+    /**
+     * Values of the shape functions which do not vanish on one face of the
+     * reference cell.
+     */
+    struct FaceData
+    {
+      /**
+       * Cell-local indices and components of the shape functions.
+       */
+      std::vector<unsigned int> dofs;
+
+      std::vector<unsigned int> components;
+
+      /**
+       * Values and reference gradients, indexed by quadrature point and then
+       * by shape function.
+       */
+      std::vector<double> values;
+
+      std::vector<Tensor<1, dim>> gradients;
+
+      /**
+       * Reference cell vectors tangent to the face, scaled so that the
+       * quadrature weights integrate over the reference face.
+       */
+      std::vector<Tensor<1, dim>> tangents;
+    };
+
+    MPI_Comm communicator;
+
+    std::vector<double> weights;
+
+    std::vector<FaceData> face_data;
+
+    /**
+     * Face number of each locally owned boundary face.
+     */
+    std::vector<unsigned char> face_numbers;
+
+    /**
+     * Global DoF indices of the shape functions in FaceData::dofs of each
+     * face, stored contiguously.
+     */
+    std::vector<types::global_dof_index> face_dofs;
+  };
+} // namespace fdl
+
+#endif
@@ -0,0 +1,126 @@
+#ifndef included_fiddle_grid_boundary_faces_h
+#define included_fiddle_grid_boundary_faces_h
+
+#include <fiddle/base/config.h>
+
+#include <fiddle/base/exceptions.h>
+
+#include <deal.II/base/smartpointer.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <boost/signals2/connection.hpp>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * Compact list of the physical boundary faces (i.e., boundary faces which
+   * are not periodic) of the locally owned cells of a DoFHandler.
+   *
+   * Finding boundary faces requires a loop over every active cell, which is
+   * much more expensive than the work done on the boundary faces themselves
+   * when a mesh has many more cells than boundary faces. This class does that
+   * loop once and then stores the faces, both sorted by boundary id and as a
+   * list of cells. The lists are recomputed the next time they are accessed
+   * after the Triangulation changes.
+   *
+   * @note Since the lists are updated lazily the accessors of this class should
+   * not be called concurrently after the Triangulation changes.
+   */
+  template <int dim, int spacedim = dim>
+  class BoundaryFaces
+  {
+  public:
+    using active_cell_iterator =
+      typename DoFHandler<dim, spacedim>::active_cell_iterator;
+
+    /**
+     * Constructor.
+     */
+    BoundaryFaces(const DoFHandler<dim, spacedim> &dof_handler);
+
+    /**
+     * This class stores a callback to itself in the Triangulation so it
+     * cannot be copied.
+     */
+    BoundaryFaces(const BoundaryFaces<dim, spacedim> &) = delete;
+
+    BoundaryFaces<dim, spacedim> &
+    operator=(const BoundaryFaces<dim, spacedim> &) = delete;
+
+    /**
+     * Destructor.
+     */
+    ~BoundaryFaces();
+
+    /**
+     * Get the DoFHandler used to set up the present object.
+     */
+    const DoFHandler<dim, spacedim> &
+    get_dof_handler() const;
+
+    /**
+     * Get the locally owned cells which have at least one physical boundary
+     * face, in the same order as DoFHandler::active_cell_iterators().
+     */
+    const std::vector<active_cell_iterator> &
+    get_cells() const;
+
+    /**
+     * Get the sorted boundary ids of the locally owned physical boundary
+     * faces.
+     */
+    std::vector<types::boundary_id>
+    get_boundary_ids() const;
+
+    /**
+     * Get the (cell, face number) pairs of all locally owned physical boundary
+     * faces with boundary id @p boundary_id, in the same order as
+     * DoFHandler::active_cell_iterators().
+     */
+    const std::vector<std::pair<active_cell_iterator, unsigned int>> &
+    get_faces(const types::boundary_id boundary_id) const;
+
+  protected:
+    /**
+     * Recompute the lists if the Triangulation has changed.
+     */
+    void
+    update() const;
+
+    SmartPointer<const DoFHandler<dim, spacedim>> dof_handler;
+
+    boost::signals2::connection tria_listener;
+
+    mutable bool needs_update;
+
+    mutable std::vector<active_cell_iterator> cells;
+
+    mutable std::map<types::boundary_id,
+                     std::vector<std::pair<active_cell_iterator, unsigned int>>>
+      faces;
+
+    /**
+     * Returned by get_faces() for boundary ids which do not appear on this
+     * processor.
+     */
+    const std::vector<std::pair<active_cell_iterator, unsigned int>> no_faces;
+  };
+
+  // --------------------------- inline functions --------------------------- //
+
+  template <int dim, int spacedim>
+  inline const DoFHandler<dim, spacedim> &
+  BoundaryFaces<dim, spacedim>::get_dof_handler() const
+  {
+    return *dof_handler;
+  }
+} // namespace fdl
+
+#endif
@@ -7,6 +7,8 @@ FDL_DISABLE_EXTRA_DIAGNOSTICS
 #include <deal.II/base/bounding_box.h>
 FDL_ENABLE_EXTRA_DIAGNOSTICS
 
+#include <deal.II/base/types.h>
+
 #include <vector>
 
 // forward declarations
@@ -37,6 +39,8 @@ namespace SAMRAI
     class Box;
     template <int>
     class Patch;
+    template <int>
+    class PatchHierarchy;
   } // namespace hier
 
   namespace tbox
@@ -92,6 +96,34 @@ namespace fdl
   compute_cell_bboxes(const DoFHandler<dim, spacedim> &dof_handler,
                       const Mapping<dim, spacedim>    &mapping);
 
+  /**
+   * Same as the other compute_cell_bboxes(), but reuse previously computed
+   * bounding boxes when the cells have not moved very far.
+   *
+   * @p bboxes and @p inflations contain, for each locally owned active cell,
+   * a cached bounding box and the amount by which it has already been
+   * enlarged. If their sizes do not match the number of locally owned active
+   * cells then every box is recomputed. @p displacements should either contain
+   * one entry for each locally owned active cell or a single entry used by
+   * every cell: each entry bounds the distance (in each coordinate direction)
+   * that any support point of the cell moved since @p bboxes was last updated.
+   *
+   * If the total inflation of a box would not exceed @p tolerance then the box
+   * is enlarged by the displacement bound. Otherwise it is recomputed exactly
+   * (on up to @p n_threads threads) and its inflation is reset to zero.
+   *
+   * @return The number of bounding boxes which were recomputed.
+   */
+  template <int dim, int spacedim = dim, typename Number = double>
+  std::size_t
+  compute_cell_bboxes(const DoFHandler<dim, spacedim>            &dof_handler,
+                      const Mapping<dim, spacedim>               &mapping,
+                      const std::vector<double>                  &displacements,
+                      const double                                tolerance,
+                      std::vector<BoundingBox<spacedim, Number>> &bboxes,
+                      std::vector<double>                        &inflations,
+                      const unsigned int                          n_threads);
+
   /**
    * Collect all bounding boxes on all processors.
    */
@@ -101,6 +133,87 @@ namespace fdl
     const parallel::shared::Triangulation<dim, spacedim> &tria,
     const std::vector<BoundingBox<spacedim, Number>> &local_active_cell_bboxes);
 
+  /**
+   * Like collect_all_active_cell_bboxes(), but only communicate the bounding
+   * boxes which may be needed on each processor: i.e., each processor
+   * receives the bounding boxes of its own cells and of the cells which
+   * intersect the union of its @p local_patch_bboxes. The bounding boxes of
+   * all other cells are set to an empty (inverted) box which does not
+   * intersect anything.
+   *
+   * Like collect_all_active_cell_bboxes() the result is indexed by active cell
+   * index, but the amount of data sent by each processor is proportional to
+   * the number of cells it owns (times the number of processors those cells
+   * intersect) instead of the total number of cells times the number of
+   * processors.
+   */
+  template <int dim, int spacedim = dim, typename Number = double>
+  std::vector<BoundingBox<spacedim, Number>>
+  collect_intersecting_active_cell_bboxes(
+    const parallel::shared::Triangulation<dim, spacedim> &tria,
+    const std::vector<BoundingBox<spacedim, Number>> &local_active_cell_bboxes,
+    const std::vector<BoundingBox<spacedim, Number>> &local_patch_bboxes);
+
+  /**
+   * Same as the other collect_intersecting_active_cell_bboxes(), but also
+   * send, along with each bounding box, one length per cell (e.g., from
+   * compute_longest_edge_lengths()). On output @p active_cell_lengths is
+   * indexed by active cell index and is zero for cells whose bounding boxes
+   * were not received. This avoids needing collect_longest_edge_lengths().
+   */
+  template <int dim, int spacedim = dim, typename Number = double>
+  std::vector<BoundingBox<spacedim, Number>>
+  collect_intersecting_active_cell_bboxes(
+    const parallel::shared::Triangulation<dim, spacedim> &tria,
+    const std::vector<BoundingBox<spacedim, Number>> &local_active_cell_bboxes,
+    const std::vector<BoundingBox<spacedim, Number>> &local_patch_bboxes,
+    const std::vector<float> &local_active_cell_lengths,
+    std::vector<float>       &active_cell_lengths);
+
+  /**
+   * Compute a partitioning of the active cells of @p tria which matches the
+   * distribution of the patches in @p patch_hierarchy: each cell is assigned
+   * to the processor which owns the patch, on the finest level with such a
+   * patch, containing the center of that cell. Cells outside of the
+   * computational domain are assigned to processors in contiguous blocks.
+   *
+   * Since interaction with the Eulerian grid happens on the processors which
+   * own the patches, partitioning a part's Triangulation in this way makes
+   * most of the DoFs of each overlap partition locally owned, so most of the
+   * data moved by Scatter objects does not leave the processor. This comes at
+   * the cost of the load balancing of the structural mechanics, which now
+   * follows the load balancing of the patches.
+   *
+   * Since all processors store all cells and boxes this function does not
+   * communicate. The result can be used with a
+   * parallel::shared::Triangulation created with
+   * Settings::partition_custom_signal by connecting a function which sets
+   * the subdomain ids of all active cells to both the @p create and @p
+   * post_refinement signals of the Triangulation, e.g.,
+   *
+   * @code
+   * const auto partition = [&]()
+   * {
+   *   const auto subdomain_ids =
+   *     fdl::compute_patch_aligned_subdomain_ids(tria, patch_hierarchy);
+   *   for (const auto &cell : tria.active_cell_iterators())
+   *     cell->set_subdomain_id(subdomain_ids[cell->active_cell_index()]);
+   * };
+   * tria.signals.create.connect(partition);
+   * tria.signals.post_refinement.connect(partition);
+   * @endcode
+   *
+   * @note This partitioning is only as good as the match between the cells
+   * and the patches at the time it is computed: since the Part objects set up
+   * on a Triangulation depend on its partitioning it is not recomputed when
+   * the patches change.
+   */
+  template <int dim, int spacedim = dim>
+  std::vector<types::subdomain_id>
+  compute_patch_aligned_subdomain_ids(
+    const parallel::shared::Triangulation<dim, spacedim> &tria,
+    const tbox::Pointer<hier::PatchHierarchy<spacedim>>  &patch_hierarchy);
+
   /**
    * Convert a Box (in SAMRAI's index space) to a BoundingBox (in real space).
    */
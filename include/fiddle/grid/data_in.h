@@ -3,7 +3,10 @@
 
 #include <fiddle/base/config.h>
 
+#include <deal.II/fe/component_mask.h>
+
 #include <string>
+#include <vector>
 
 // forward declarations
 namespace dealii
@@ -24,7 +27,13 @@ namespace fdl
    * This function loads data stored in the ExodusII file @p filename at
    * timestep @p time_step and variable @p var_index corresponding to the active
    * cells of the Triangulation provided as an argument. @p cell_vector can be
-   * ghosted or unghosted.
+   * ghosted or unghosted. Only the values on locally owned cells are set:
+   * each processor only reads the (smallest contiguous) range of each element
+   * block which contains its locally owned cells.
+   *
+   * The Triangulation may have been refined (or coarsened) after it was
+   * read: each element corresponds to a coarse cell and its value is copied
+   * to all of that cell's locally owned active descendants.
    *
    * This function is only available if deal.II is configured with Trilinos
    * with SEACAS.
@@ -41,13 +50,22 @@ namespace fdl
    * @brief Read DoF data from an ExodusII file. At this time higher-order 3D
    * elements are not yet implemented.
    *
-   * This function does not support ComponentMask yet - you must load one
-   * variable for each component of the DoFHandler.
-   *
    * This function loads data stored in the ExodusII file @p filename at
    * timestep @p time_step and variable @p var_index corresponding to the
    * DoFHandler provided as an argument. @p cell_vector can be ghosted or
-   * unghosted.
+   * unghosted. Like read_elemental_data(), each processor only reads the
+   * ranges of elements and nodes which contain its locally owned cells. All
+   * variables are read at once and then copied into @p dof_vector in a
+   * single pass over the locally owned cells.
+   *
+   * @p variable_names must contain one variable for each component selected
+   * by @p component_mask (by default, all components), in order. Entries of
+   * @p dof_vector corresponding to other components are not modified.
+   *
+   * If the Triangulation was refined (or coarsened) after it was read then
+   * the data is interpolated from the coarse cells, which match the elements
+   * in the file, to their active descendants with the finite element's
+   * prolongation matrices. The finite element must therefore provide them.
    *
    * This function is only available if deal.II is configured with Trilinos
    * with SEACAS.
@@ -58,7 +76,8 @@ namespace fdl
                 const DoFHandler<dim, spacedim> &dof_handler,
                 const int                        time_step_n,
                 const std::vector<std::string>  &variable_names,
-                VectorType                      &dof_vector);
+                VectorType                      &dof_vector,
+                const ComponentMask             &component_mask = {});
 } // namespace fdl
 
 #endif
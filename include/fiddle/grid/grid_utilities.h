@@ -5,6 +5,9 @@
 
 #include <deal.II/base/point.h>
 
+#include <mpi.h>
+
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -42,6 +45,24 @@ namespace fdl
                                const Mapping<dim, spacedim>       &mapping,
                                const Quadrature<1> &line_quadrature);
 
+  /**
+   * Compute, for each locally owned active cell, the length of the edges of
+   * the reference cell scaled to have the same measure as the cell (subject to
+   * the provided mapping), i.e., $(|K| / |\hat{K}|)^{1/dim}$. This is much
+   * cheaper to compute than the longest edge length and, unlike that length,
+   * decreases when a cell is compressed in only one direction. Like
+   * compute_longest_edge_lengths(), it can be used to select quadrature rules
+   * for interaction, but since it underestimates the size of strongly
+   * anisotropic cells this may place IB points too far apart in the
+   * elongated direction.
+   */
+  template <int dim, int spacedim>
+  std::vector<float>
+  compute_equivalent_edge_lengths(
+    const Triangulation<dim, spacedim> &tria,
+    const Mapping<dim, spacedim>       &mapping,
+    const Quadrature<dim>              &quadrature);
+
   /**
    * Collect the edge lengths per element onto each processor.
    */
@@ -63,6 +84,27 @@ namespace fdl
   std::pair<std::vector<unsigned int>, std::vector<Point<spacedim>>>
   extract_nodeset(const std::string &filename, const int nodeset_id);
 
+  /**
+   * Extract several nodesets from an ExodusII file at once.
+   *
+   * Like extract_nodeset(), but the file is only opened once and only the
+   * coordinates of nodes in the range spanned by the nodesets are read. The
+   * file is read by one processor on each shared-memory node of @p comm, which
+   * then broadcasts the nodesets to the other processors on that node.
+   *
+   * The node numbers of each nodeset are sorted (with duplicates removed) and
+   * the coordinates are in the same order, so the node numbers can be
+   * directly used to set up subsets of nodes (e.g., for spring forces).
+   *
+   * This function is collective over @p comm.
+   */
+  template <int spacedim>
+  std::vector<
+    std::pair<std::vector<unsigned int>, std::vector<Point<spacedim>>>>
+  extract_nodesets(const std::string      &filename,
+                   const std::vector<int> &nodeset_ids,
+                   const MPI_Comm          comm);
+
   /**
    * Compute the centroid of a surface defined by the boundary ids in @p
    * boundary_ids.
@@ -3,8 +3,12 @@
 
 #include <fiddle/base/config.h>
 
+#include <deal.II/base/array_view.h>
+
 #include <deal.II/grid/tria.h>
 
+#include <vector>
+
 namespace fdl
 {
   using namespace dealii;
@@ -22,6 +26,8 @@ namespace fdl
   class IntersectionPredicate
   {
   public:
+    using cell_iterator = typename Triangulation<dim, spacedim>::cell_iterator;
+
     /**
      * See if a given cell intersects whatever geometric object this object
      * refers to.
@@ -30,8 +36,38 @@ namespace fdl
     operator()(const typename Triangulation<dim, spacedim>::cell_iterator &cell)
       const = 0;
 
+    /**
+     * Batched version of operator(): on output, <code>mask[i]</code> is 1 if
+     * <code>cells[i]</code> intersects the geometric object and 0 otherwise.
+     *
+     * The default implementation calls operator() once per cell. Since the
+     * callers of this function (e.g., OverlapTriangulation) typically check
+     * every cell on a level, derived classes should override this function
+     * when they can test many cells more efficiently than one at a time.
+     * OverlapTriangulation may call this function concurrently (with
+     * different arguments) from several threads.
+     */
+    virtual void
+    evaluate(const ArrayView<const cell_iterator> &cells,
+             std::vector<unsigned char>           &mask) const;
+
     virtual ~IntersectionPredicate() = default;
   };
+
+
+  // --------------------------- inline functions --------------------------- //
+
+
+  template <int dim, int spacedim>
+  inline void
+  IntersectionPredicate<dim, spacedim>::evaluate(
+    const ArrayView<const cell_iterator> &cells,
+    std::vector<unsigned char>           &mask) const
+  {
+    mask.resize(cells.size());
+    for (std::size_t i = 0; i < cells.size(); ++i)
+      mask[i] = (*this)(cells[i]);
+  }
 } // namespace fdl
 
 #endif
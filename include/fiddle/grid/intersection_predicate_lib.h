@@ -18,19 +18,30 @@ namespace fdl
   using namespace dealii;
   /**
    * Intersection predicate that determines intersections based on the locations
-   * of cells in the Triangulation and nothing else.
+   * of cells in the Triangulation and nothing else. The patch bounding boxes
+   * are stored in an RTree so that each query is logarithmic in the number of
+   * patches. Queries stop at the first intersecting patch.
    */
   template <int dim, int spacedim = dim>
   class TriaIntersectionPredicate : public IntersectionPredicate<dim, spacedim>
   {
   public:
+    using cell_iterator =
+      typename IntersectionPredicate<dim, spacedim>::cell_iterator;
+
     TriaIntersectionPredicate(const std::vector<BoundingBox<spacedim>> &bboxes);
 
     virtual bool
     operator()(const typename Triangulation<dim, spacedim>::cell_iterator &cell)
       const override;
 
+    virtual void
+    evaluate(const ArrayView<const cell_iterator> &cells,
+             std::vector<unsigned char>           &mask) const override;
+
     const std::vector<BoundingBox<spacedim>> patch_boxes;
+
+    RTree<BoundingBox<spacedim>> patch_bbox_rtree;
   };
 
   /**
@@ -41,11 +52,21 @@ namespace fdl
    * present on all processors. This is useful for creating an
    * OverlapTriangulation on each processor with bounding boxes intersecting an
    * arbitrary part of the Triangulation.
+   *
+   * Inactive cells intersect a patch if any of their descendants do. To avoid
+   * visiting every descendant of every inactive cell, this class precomputes
+   * the union of the bounding boxes of each cell's active descendants and
+   * only looks at the children of cells whose union intersects some patch.
+   * evaluate() does this one level at a time for all of the input cells
+   * together instead of recursing into each cell separately.
    */
   template <int dim, int spacedim = dim>
   class BoxIntersectionPredicate : public IntersectionPredicate<dim, spacedim>
   {
   public:
+    using cell_iterator =
+      typename IntersectionPredicate<dim, spacedim>::cell_iterator;
+
     BoxIntersectionPredicate(
       const std::vector<BoundingBox<spacedim, float>>      &a_cell_bboxes,
       const std::vector<BoundingBox<spacedim, float>>      &patch_bboxes,
@@ -55,10 +76,23 @@ namespace fdl
     operator()(const typename Triangulation<dim, spacedim>::cell_iterator &cell)
       const override;
 
+    virtual void
+    evaluate(const ArrayView<const cell_iterator> &cells,
+             std::vector<unsigned char>           &mask) const override;
+
     const SmartPointer<const Triangulation<dim, spacedim>> tria;
-    const std::vector<BoundingBox<spacedim, float>>        active_cell_bboxes;
 
     RTree<BoundingBox<spacedim, float>> patch_bbox_rtree;
+
+    /**
+     * Union of the bounding boxes of the active descendants of each cell,
+     * indexed by level and then by cell index. For active cells this is the
+     * cell's own bounding box, so the bounding boxes provided to the
+     * constructor are not stored separately: they are replicated on every
+     * processor and, for large meshes, are one of the largest per-processor
+     * arrays.
+     */
+    std::vector<std::vector<BoundingBox<spacedim, float>>> level_cell_bboxes;
   };
 } // namespace fdl
 
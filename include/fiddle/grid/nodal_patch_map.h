@@ -5,6 +5,7 @@
 
 #include <fiddle/base/exceptions.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/bounding_box.h>
 #include <deal.II/base/index_set.h>
 #include <deal.II/base/point.h>
@@ -30,6 +31,11 @@ namespace fdl
    * representation available in DoFRenumbering::compute_support_point_wise(),
    * i.e., position (or velocity) DoFs at a single support point have adjacent
    * DoF indices and are sorted by vector component.
+   *
+   * Nodes of different cells may still coincide, e.g., for discontinuous
+   * elements. In that case this class also stores a table of unique points
+   * with, for each point, the nodes located at it, so that IB kernels only
+   * need to be evaluated once per point: see has_coincident_nodes().
    */
   template <int dim, int spacedim = dim>
   class NodalPatchMap
@@ -72,12 +78,72 @@ namespace fdl
            const std::vector<std::vector<BoundingBox<spacedim>>> &patch_bboxes,
            const Vector<double> &nodal_coordinates);
 
+    /**
+     * Update the mapping after the nodes move from @p old_nodal_coordinates
+     * (i.e., the coordinates given to the last call to reinit() or update())
+     * to @p nodal_coordinates.
+     *
+     * If the patch bounding boxes are the same as the ones given to reinit()
+     * then only nodes whose coordinates changed are checked again and only
+     * the DoFs of nodes which moved into or out of some box are added to or
+     * removed from the IndexSet objects. Otherwise this function calls
+     * reinit(). In either case the result is the same as calling reinit()
+     * with @p nodal_coordinates.
+     *
+     * @return The number of nodes which were assigned to different patches.
+     */
+    std::size_t
+    update(const std::vector<tbox::Pointer<hier::Patch<spacedim>>> &patches,
+           const std::vector<std::vector<BoundingBox<spacedim>>> &patch_bboxes,
+           const Vector<double> &old_nodal_coordinates,
+           const Vector<double> &nodal_coordinates);
+
     /**
      * Return the number of patches.
      */
     std::size_t
     size() const;
 
+    /**
+     * Return whether or not some of the nodes given to the last call to
+     * reinit() or update() coincide and, if so, whether or not every node
+     * still coincides with the first node at its point in @p
+     * nodal_coordinates. Nodes coincide if their coordinates are equal up to
+     * roundoff.
+     *
+     * If this function returns false then the unique point table is not
+     * valid for @p nodal_coordinates and each node should be treated
+     * separately.
+     */
+    bool
+    has_coincident_nodes(const Vector<double> &nodal_coordinates) const;
+
+    /**
+     * Return the number of unique points. Only valid if some nodes coincide.
+     */
+    std::size_t
+    n_points() const;
+
+    /**
+     * Return an IndexSet containing the unique points (rather than the DoFs)
+     * intersecting the ith patch. Only valid if some nodes coincide.
+     */
+    const IndexSet &
+    get_point_indices(const std::size_t i) const;
+
+    /**
+     * Return the nodes located at the point @p point_n in ascending order.
+     * Only valid if some nodes coincide.
+     */
+    ArrayView<const types::global_dof_index>
+    get_point_nodes(const types::global_dof_index point_n) const;
+
+    /**
+     * Return an estimate of the memory used by this object, in bytes.
+     */
+    std::size_t
+    memory_consumption() const;
+
     /**
      * Access operator - returns an IndexSet containing the DoFs intersecting
      * either the patch or the patch's ghost area (as of the last regridding).
@@ -95,9 +161,32 @@ namespace fdl
     // Patches.
     std::vector<tbox::Pointer<hier::Patch<spacedim>>> patches;
 
+    // Bounding boxes of each patch given to reinit().
+    std::vector<std::vector<BoundingBox<spacedim>>> patch_bboxes;
+
     // For each patch, store the DoF indices which intersect (including the
     // extra ghost cell fraction) that patch.
     std::vector<IndexSet> patch_dof_indices;
+
+    // Two nodes coincide if all of their coordinates differ by at most this
+    // much.
+    double coincidence_tolerance = 0.0;
+
+    // If some nodes coincide: offsets into point_nodes for each unique point,
+    // the nodes at each point, and, for each patch, the points which
+    // intersect that patch. Otherwise these are all empty.
+    std::vector<types::global_dof_index> point_node_offsets;
+
+    std::vector<types::global_dof_index> point_nodes;
+
+    std::vector<IndexSet> patch_point_indices;
+
+    /**
+     * Set up the unique point table from @p nodal_coordinates and the present
+     * values of patch_dof_indices.
+     */
+    void
+    setup_points(const Vector<double> &nodal_coordinates);
   };
 
 
@@ -111,6 +200,34 @@ namespace fdl
     return patches.size();
   }
 
+  template <int dim, int spacedim>
+  std::size_t
+  NodalPatchMap<dim, spacedim>::n_points() const
+  {
+    Assert(point_node_offsets.size() > 0,
+           ExcMessage("There are no coincident nodes."));
+    return point_node_offsets.size() - 1;
+  }
+
+  template <int dim, int spacedim>
+  const IndexSet &
+  NodalPatchMap<dim, spacedim>::get_point_indices(const std::size_t i) const
+  {
+    AssertIndexRange(i, patch_point_indices.size());
+    return patch_point_indices[i];
+  }
+
+  template <int dim, int spacedim>
+  ArrayView<const types::global_dof_index>
+  NodalPatchMap<dim, spacedim>::get_point_nodes(
+    const types::global_dof_index point_n) const
+  {
+    AssertIndexRange(point_n + 1, point_node_offsets.size());
+    return make_array_view(point_nodes.data() + point_node_offsets[point_n],
+                           point_nodes.data() +
+                             point_node_offsets[point_n + 1]);
+  }
+
   template <int dim, int spacedim>
   std::pair<const IndexSet &, tbox::Pointer<hier::Patch<spacedim>>>
   NodalPatchMap<dim, spacedim>::operator[](const std::size_t i)
@@ -4,6 +4,7 @@
 #include <fiddle/base/config.h>
 
 #include <fiddle/base/exceptions.h>
+#include <fiddle/base/execution_policy.h>
 
 #include <fiddle/grid/intersection_predicate.h>
 
@@ -55,14 +56,42 @@ namespace fdl
 
     OverlapTriangulation(
       const parallel::shared::Triangulation<dim, spacedim> &shared_tria,
-      const IntersectionPredicate<dim, spacedim>           &predicate);
+      const IntersectionPredicate<dim, spacedim>           &predicate,
+      const ExecutionPolicy &execution_policy = {});
 
     virtual types::subdomain_id
     locally_owned_subdomain() const override;
 
-    void
+    /**
+     * Reinitialize the Triangulation.
+     *
+     * If @p shared_tria is the same Triangulation used previously and
+     * @p predicate selects exactly the same native cells then the current
+     * cells (and, therefore, their indices, user indices, and any DoFHandlers
+     * using this Triangulation) are kept.
+     *
+     * The predicate is evaluated concurrently on disjoint ranges of cells
+     * (e.g., the subtrees of different coarse cells) according to
+     * @p execution_policy, so IntersectionPredicate::evaluate() must be safe
+     * to call from several threads at once. The policy is stored and also
+     * used by has_same_native_cells().
+     *
+     * @return true if the cells changed (i.e., the Triangulation was rebuilt
+     * and its dependents need to be reinitialized) and false otherwise.
+     */
+    bool
     reinit(const parallel::shared::Triangulation<dim, spacedim> &shared_tria,
-           const IntersectionPredicate<dim, spacedim>           &predicate);
+           const IntersectionPredicate<dim, spacedim>           &predicate,
+           const ExecutionPolicy &execution_policy = {});
+
+    /**
+     * Return whether or not @p predicate selects exactly the same native
+     * cells as the ones presently stored. Unlike reinit(), this does not
+     * check whether or not the native vertices have moved.
+     */
+    bool
+    has_same_native_cells(
+      const IntersectionPredicate<dim, spacedim> &predicate) const;
 
     const parallel::shared::Triangulation<dim, spacedim> &
     get_native_triangulation() const;
@@ -75,16 +104,32 @@ namespace fdl
 
     /**
      * Get the CellId for the corresponding cell on the native Triangulation.
+     * CellIds are not stored, so this is computed from the native cell.
      */
     CellId
     get_native_cell_id(const cell_iterator &cell) const;
 
     /**
-     * Get the rank of the corresponding cell on the native Triangulation.
+     * Get the rank of the corresponding cell on the native Triangulation. This
+     * is numbers::invalid_subdomain_id if the native cell is not active.
      */
     types::subdomain_id
     get_native_cell_subdomain_id(const cell_iterator &cell) const;
 
+    /**
+     * Return an estimate of the memory used by this object, in bytes,
+     * including the Triangulation itself.
+     */
+    virtual std::size_t
+    memory_consumption() const override;
+
+    /**
+     * Return an estimate of the memory used, in bytes, to store the
+     * correspondence between cells on this Triangulation and native cells.
+     */
+    std::size_t
+    native_cell_memory_consumption() const;
+
   protected:
     /**
      * Utility function that stores a native cell and returns its array index
@@ -98,34 +143,42 @@ namespace fdl
       const IntersectionPredicate<dim, spacedim> &predicate);
 
     /**
-     * Pointer to the Triangulation which describes the whole domain.
+     * Compute the level and index pairs of the native cells which
+     * reinit_overlapping_tria() would add for @p predicate, in no particular
+     * order.
      */
-    SmartPointer<const parallel::shared::Triangulation<dim, spacedim>,
-                 OverlapTriangulation<dim, spacedim>>
-      native_tria;
+    std::vector<std::pair<int, int>>
+    compute_native_cells(
+      const IntersectionPredicate<dim, spacedim> &predicate) const;
 
     /**
-     * Level and index pairs (i.e., enough to create an iterator) of native
-     * cells which have an equivalent cell on this triangulation.
+     * Evaluate @p predicate on @p cells, splitting the cells into ranges
+     * processed concurrently according to the stored ExecutionPolicy.
      */
-    std::vector<std::pair<int, int>> native_cells;
+    void
+    evaluate_predicate(const IntersectionPredicate<dim, spacedim> &predicate,
+                       const std::vector<cell_iterator>           &cells,
+                       std::vector<unsigned char> &mask) const;
 
     /**
-     * CellIds for native cells.
+     * Pointer to the Triangulation which describes the whole domain.
      */
-    std::vector<CellId> native_cell_ids;
+    SmartPointer<const parallel::shared::Triangulation<dim, spacedim>,
+                 OverlapTriangulation<dim, spacedim>>
+      native_tria;
 
     /**
-     * Subdomain ids of native cells, indexed by the corresponding overlapping
-     * cells' active cell index.
+     * Level and index pairs (i.e., enough to create an iterator) of native
+     * cells which have an equivalent cell on this triangulation. This is the
+     * only per-cell information we store: CellIds and subdomain ids are
+     * computed from the native cells when needed.
      */
-    std::vector<types::subdomain_id> native_cell_subdomain_ids;
+    std::vector<std::pair<int, int>> native_cells;
 
     /**
-     * Active cell iterators sorted by the active cell index of the
-     * corresponding native cell. Useful for doing data transfer.
+     * Policy used to evaluate predicates.
      */
-    std::vector<active_cell_iterator> cell_iterators_in_active_native_order;
+    ExecutionPolicy execution_policy;
   };
 
 
@@ -162,7 +215,8 @@ namespace fdl
     const cell_iterator &cell) const
   {
     AssertIndexRange(cell->user_index(), native_cells.size());
-    return native_cell_ids[cell->user_index()];
+    const auto pair = native_cells[cell->user_index()];
+    return cell_iterator(native_tria, pair.first, pair.second)->id();
   }
 
 
@@ -173,7 +227,13 @@ namespace fdl
     const cell_iterator &cell) const
   {
     AssertIndexRange(cell->user_index(), native_cells.size());
-    return native_cell_subdomain_ids[cell->user_index()];
+    const auto          pair = native_cells[cell->user_index()];
+    const cell_iterator native_cell(native_tria, pair.first, pair.second);
+    // Nonactive cells aren't owned by any process
+    if (!native_cell->is_active())
+      return numbers::invalid_subdomain_id;
+    return native_tria
+      ->get_true_subdomain_ids_of_cells()[native_cell->active_cell_index()];
   }
 
 
@@ -186,15 +246,6 @@ namespace fdl
     Assert(&cell->get_triangulation() == native_tria,
            ExcMessage("should be a native cell"));
     native_cells.emplace_back(cell->level(), cell->index());
-    native_cell_ids.emplace_back(cell->id());
-    // During construction its useful to add nonactive cells, which aren't owned
-    // by any process - permit that here too
-    if (cell->is_active())
-      native_cell_subdomain_ids.emplace_back(
-        native_tria
-          ->get_true_subdomain_ids_of_cells()[cell->active_cell_index()]);
-    else
-      native_cell_subdomain_ids.emplace_back(numbers::invalid_subdomain_id);
     return native_cells.size() - 1;
   }
 } // namespace fdl
@@ -7,18 +7,27 @@
 
 #include <fiddle/grid/patch_map.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/linear_index_iterator.h>
 #include <deal.II/base/point.h>
+#include <deal.II/base/tensor.h>
 
 #include <deal.II/dofs/dof_handler.h>
 
+#include <deal.II/fe/mapping.h>
+
+#include <deal.II/grid/reference_cell.h>
+
 FDL_DISABLE_EXTRA_DIAGNOSTICS
 #include <CellIndex.h>
 #include <Patch.h>
 #include <SideIndex.h>
 FDL_ENABLE_EXTRA_DIAGNOSTICS
 
+#include <array>
 #include <iterator>
+#include <utility>
+#include <vector>
 
 namespace fdl
 {
@@ -82,6 +91,43 @@ namespace fdl
       // deal.II cell index.
       std::vector<int> cell_index;
     };
+
+    /**
+     * Split a cell, given the Eulerian positions of its vertices, into the
+     * simplices used to compute intersections: lines and triangles are
+     * already simplices and quadrilaterals are split into two triangles. In
+     * addition, @p unit_simplices contains the vertices of each simplex on the
+     * reference cell.
+     */
+    template <int dim, int spacedim>
+    void
+    split_cell_into_simplices(
+      const ReferenceCell                               &reference_cell,
+      const ArrayView<const Point<spacedim>>            &vertices,
+      std::vector<std::array<Point<spacedim>, dim + 1>> &simplices,
+      std::vector<std::array<Point<dim>, dim + 1>>      &unit_simplices);
+
+    /**
+     * Given the simplices of a cell (see split_cell_into_simplices()) and the
+     * location of an intersection along a stencil parallel to @p axis,
+     * compute the intersection's position on the reference cell and its
+     * quadrature weight. Here @p dx is the grid spacing.
+     *
+     * Each intersection along a stencil parallel to axis @p a stands for a
+     * face of area <code>prod_{d != a} dx[d]</code>, which approximates how
+     * much of the surface, weighted by <code>|n[a]|</code>, lies in that face.
+     * Hence the weight of each intersection is that area divided by the
+     * one-norm of the unit normal vector: with this, summing over the
+     * intersections along all axes approximates surface integrals.
+     */
+    template <int dim, int spacedim>
+    std::pair<Point<dim>, double>
+    locate_intersection(
+      const std::vector<std::array<Point<spacedim>, dim + 1>> &simplices,
+      const std::vector<std::array<Point<dim>, dim + 1>>      &unit_simplices,
+      const Point<spacedim>                                   &point,
+      const unsigned int                                       axis,
+      const Tensor<1, spacedim>                               &dx);
   } // namespace internal
 
   /**
@@ -105,6 +151,47 @@ namespace fdl
      */
     PatchIntersectionMap() = default;
 
+    /**
+     * Constructor. Computes the intersections between the elements of the
+     * Triangulation of @p position_dof_handler (displaced by
+     * @p position_mapping) and the stencils of each patch: i.e., for each
+     * coordinate axis, the line segments connecting the centers of adjacent
+     * cells. A stencil belongs to a patch if its lower cell is in the patch
+     * box, so the upper cell may be a ghost cell.
+     *
+     * Elements are approximated by their vertices: line elements are
+     * intersected as straight edges and quadrilaterals are split into two
+     * flat triangles (see intersect_stencils_with_simplex()). Like the rest of
+     * this class this assumes that each stencil intersects the mesh at most
+     * once: if a stencil appears to intersect more than one element (e.g.,
+     * because it passes through a vertex) then only the first intersection is
+     * kept.
+     *
+     * @param[in] cell_bboxes Bounding boxes of the active cells, used to set up
+     * the underlying PatchMap.
+     *
+     * @param[in] n_threads Patches are independent so, if this is larger than
+     * one, their intersections are computed concurrently.
+     */
+    template <typename Number>
+    PatchIntersectionMap(
+      const std::vector<tbox::Pointer<hier::Patch<spacedim>>> &patches,
+      const std::vector<BoundingBox<spacedim, Number>>        &cell_bboxes,
+      const DoFHandler<dim, spacedim> &position_dof_handler,
+      const Mapping<dim, spacedim>    &position_mapping,
+      const unsigned int               n_threads = 1);
+
+    /**
+     * Same as the constructor.
+     */
+    template <typename Number>
+    void
+    reinit(const std::vector<tbox::Pointer<hier::Patch<spacedim>>> &patches,
+           const std::vector<BoundingBox<spacedim, Number>>        &cell_bboxes,
+           const DoFHandler<dim, spacedim> &position_dof_handler,
+           const Mapping<dim, spacedim>    &position_mapping,
+           const unsigned int               n_threads = 1);
+
     /**
      * Proxy class granting access to an intersection.
      *
@@ -189,6 +276,18 @@ namespace fdl
       Point<spacedim>
       get_point() const;
 
+      /**
+       * Return the level of the (deal.II) cell containing the intersection.
+       */
+      int
+      get_cell_level() const;
+
+      /**
+       * Return the index of the (deal.II) cell containing the intersection.
+       */
+      int
+      get_cell_index() const;
+
     protected:
       void
       assert_valid() const;
@@ -207,8 +306,52 @@ namespace fdl
                const std::ptrdiff_t                                index);
     };
 
+    /**
+     * Return the number of patches.
+     */
+    std::size_t
+    size() const;
+
+    /**
+     * Return the number of intersections on a patch.
+     */
+    std::size_t
+    n_intersections(const std::size_t patch_n) const;
+
+    /**
+     * Return an iterator to the first intersection on a patch.
+     * Intersections in the same element are contiguous.
+     */
+    Iterator
+    begin(const std::size_t patch_n) const;
+
+    /**
+     * Return an iterator past the last intersection on a patch.
+     */
+    Iterator
+    end(const std::size_t patch_n) const;
+
+    /**
+     * Get a patch. Like PatchMap, patch numbers are local to each processor.
+     */
+    const tbox::Pointer<hier::Patch<spacedim>> &
+    get_patch(const std::size_t patch_n) const;
+
+    /**
+     * Return a constant reference to the PatchMap used to find the elements
+     * near each patch.
+     */
+    const PatchMap<dim, spacedim> &
+    get_patch_map() const;
+
   protected:
     PatchMap<dim, spacedim> patch_map;
+
+    /**
+     * Intersections of each patch.
+     */
+    std::vector<internal::PatchSingleIntersections<spacedim>>
+      patch_intersections;
   };
 
 
@@ -384,6 +527,28 @@ namespace fdl
 
 
 
+  template <int dim, int spacedim>
+  int
+  PatchIntersectionMap<dim, spacedim>::Accessor::get_cell_level() const
+  {
+    assert_valid();
+
+    return container->cell_level[linear_index];
+  }
+
+
+
+  template <int dim, int spacedim>
+  int
+  PatchIntersectionMap<dim, spacedim>::Accessor::get_cell_index() const
+  {
+    assert_valid();
+
+    return container->cell_index[linear_index];
+  }
+
+
+
   template <int dim, int spacedim>
   PatchIntersectionMap<dim, spacedim>::Iterator::Iterator(
     const internal::PatchSingleIntersections<spacedim> *container,
@@ -391,6 +556,83 @@ namespace fdl
     : LinearIndexIterator<Iterator, Accessor>(
         PatchIntersectionMap<dim, spacedim>::Accessor(container, index))
   {}
+
+
+
+  template <int dim, int spacedim>
+  template <typename Number>
+  PatchIntersectionMap<dim, spacedim>::PatchIntersectionMap(
+    const std::vector<tbox::Pointer<hier::Patch<spacedim>>> &patches,
+    const std::vector<BoundingBox<spacedim, Number>>        &cell_bboxes,
+    const DoFHandler<dim, spacedim> &position_dof_handler,
+    const Mapping<dim, spacedim>    &position_mapping,
+    const unsigned int               n_threads)
+  {
+    reinit(patches,
+           cell_bboxes,
+           position_dof_handler,
+           position_mapping,
+           n_threads);
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  PatchIntersectionMap<dim, spacedim>::size() const
+  {
+    return patch_intersections.size();
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  PatchIntersectionMap<dim, spacedim>::n_intersections(
+    const std::size_t patch_n) const
+  {
+    AssertIndexRange(patch_n, size());
+    return patch_intersections[patch_n].lower_indices.size();
+  }
+
+
+
+  template <int dim, int spacedim>
+  typename PatchIntersectionMap<dim, spacedim>::Iterator
+  PatchIntersectionMap<dim, spacedim>::begin(const std::size_t patch_n) const
+  {
+    AssertIndexRange(patch_n, size());
+    return Iterator(&patch_intersections[patch_n], 0);
+  }
+
+
+
+  template <int dim, int spacedim>
+  typename PatchIntersectionMap<dim, spacedim>::Iterator
+  PatchIntersectionMap<dim, spacedim>::end(const std::size_t patch_n) const
+  {
+    AssertIndexRange(patch_n, size());
+    return Iterator(&patch_intersections[patch_n], n_intersections(patch_n));
+  }
+
+
+
+  template <int dim, int spacedim>
+  const tbox::Pointer<hier::Patch<spacedim>> &
+  PatchIntersectionMap<dim, spacedim>::get_patch(
+    const std::size_t patch_n) const
+  {
+    return patch_map.get_patch(patch_n);
+  }
+
+
+
+  template <int dim, int spacedim>
+  const PatchMap<dim, spacedim> &
+  PatchIntersectionMap<dim, spacedim>::get_patch_map() const
+  {
+    return patch_map;
+  }
 } // namespace fdl
 
 #endif
@@ -5,13 +5,19 @@
 
 #include <fiddle/base/exceptions.h>
 
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/bounding_box.h>
+
 #include <deal.II/dofs/dof_handler.h>
 
 FDL_DISABLE_EXTRA_DIAGNOSTICS
 #include <Patch.h>
 FDL_ENABLE_EXTRA_DIAGNOSTICS
 
+#include <algorithm>
 #include <iterator>
+#include <utility>
+#include <vector>
 
 namespace fdl
 {
@@ -34,12 +40,20 @@ namespace fdl
 
     /**
      * Constructor. Associates cells to patches from provided bounding boxes.
+     *
+     * By default the cells of each patch are sorted by level and then by
+     * index. If @p morton_order_cells is true then they are instead sorted
+     * along a Morton (Z-order) curve through the Eulerian cells containing
+     * the centers of their bounding boxes. Consecutive cells are then close
+     * to each other in the Eulerian grid, which improves the reuse of patch
+     * data in the cache while interpolating and spreading.
      */
     template <typename Number>
     PatchMap(const std::vector<tbox::Pointer<hier::Patch<spacedim>>> &patches,
              const double                        extra_ghost_cell_fraction,
              const Triangulation<dim, spacedim> &tria,
-             const std::vector<BoundingBox<spacedim, Number>> &cell_bboxes);
+             const std::vector<BoundingBox<spacedim, Number>> &cell_bboxes,
+             const bool morton_order_cells = false);
 
     /**
      * Same as the constructor.
@@ -49,8 +63,100 @@ namespace fdl
     reinit(const std::vector<tbox::Pointer<hier::Patch<spacedim>>> &patches,
            const double                        extra_ghost_cell_fraction,
            const Triangulation<dim, spacedim> &tria,
+           const std::vector<BoundingBox<spacedim, Number>> &cell_bboxes,
+           const bool morton_order_cells = false);
+
+    /**
+     * Update the PatchMap after the cells have moved. Here @p cell_bboxes
+     * are the new bounding boxes of the cells of the same Triangulation which
+     * was previously given to reinit() and @p patches are the current
+     * patches.
+     *
+     * The PatchMap stores the bounding box which was used to assign each cell
+     * to patches. Cells whose new bounding boxes are inside those are not
+     * checked again, so the cost of this function is proportional to the
+     * number of cells which moved instead of the total number of cells. As a
+     * consequence a cell may be associated with some patches it no longer
+     * intersects (which is harmless, but makes interaction a little more
+     * expensive). If the patches' bounding boxes have changed then this
+     * function instead calls reinit().
+     *
+     * @return The number of cells whose patches were recomputed.
+     */
+    template <typename Number>
+    std::size_t
+    update(const std::vector<tbox::Pointer<hier::Patch<spacedim>>> &patches,
            const std::vector<BoundingBox<spacedim, Number>> &cell_bboxes);
 
+    /**
+     * Replace the stored patches with @p patches, which must have the same
+     * boxes in the same order: e.g., the patches of a level which was
+     * regridded without changing. Every cell stays associated with the same
+     * patches.
+     */
+    void
+    replace_patches(
+      const std::vector<tbox::Pointer<hier::Patch<spacedim>>> &patches);
+
+    /**
+     * Store the level and index of every cell of every patch in iteration
+     * order. By default cells are stored compactly as one IndexSet per level,
+     * so dereferencing an iterator requires finding the cell's level and then
+     * looking up its index in that IndexSet. Afterwards dereferencing an
+     * iterator is a single load. This uses two integers per cell and patch,
+     * so it may be skipped when memory is tight.
+     *
+     * Unlike cache_dof_indices(), this setting persists: reinit() and
+     * update() recompute the expanded cells.
+     */
+    void
+    expand_cells();
+
+    /**
+     * Return whether or not expand_cells() has been called.
+     */
+    bool
+    has_expanded_cells() const;
+
+    /**
+     * Precompute, for each patch, the active cell indices and the DoF indices
+     * of the cells of @p dof_handler in the order in which the iterators visit
+     * them. Afterwards get_active_cell_indices() and get_dof_indices() return
+     * contiguous arrays, so loops over the cells of a patch do not need to
+     * look up DoF indices through DoFHandler iterators. These arrays are
+     * updated by update() and cleared by reinit().
+     *
+     * @note @p dof_handler must use the stored Triangulation, must have a
+     * single FiniteElement, and must not distribute its DoFs again while the
+     * PatchMap uses it.
+     */
+    void
+    cache_dof_indices(const DoFHandler<dim, spacedim> &dof_handler);
+
+    /**
+     * Return whether or not cache_dof_indices() was called with
+     * @p dof_handler since the last call to reinit().
+     */
+    bool
+    has_cached_dof_indices(const DoFHandler<dim, spacedim> &dof_handler) const;
+
+    /**
+     * Return the active cell indices of the cells of a patch in iteration
+     * order. Only available after cache_dof_indices() has been called.
+     */
+    ArrayView<const unsigned int>
+    get_active_cell_indices(const std::size_t patch_n) const;
+
+    /**
+     * Return the DoF indices of the cells of a patch in iteration order, i.e.,
+     * the DoF indices of the nth cell start at <code>n * dofs_per_cell</code>.
+     * Only available after cache_dof_indices() has been called with
+     * @p dof_handler.
+     */
+    ArrayView<const types::global_dof_index>
+    get_dof_indices(const std::size_t                patch_n,
+                    const DoFHandler<dim, spacedim> &dof_handler) const;
+
     /**
      * Return the number of patches.
      */
@@ -63,6 +169,12 @@ namespace fdl
     const Triangulation<dim, spacedim> &
     get_triangulation() const;
 
+    /**
+     * Return an estimate of the memory used by this object, in bytes.
+     */
+    std::size_t
+    memory_consumption() const;
+
     /**
      * Iterator class for looping over cells of a DoFHandler corresponding to
      * the stored triangulation.
@@ -126,15 +238,22 @@ namespace fdl
 
     protected:
       // only let a PatchMap construct these iterators directly
-      iterator(const std::ptrdiff_t             index,
-               const DoFHandler<dim, spacedim> &dof_handler,
-               const std::vector<IndexSet>     &patch_level_cells,
-               const std::vector<std::size_t>  &patch_cummulative_n_cells);
+      iterator(
+        const std::ptrdiff_t                   index,
+        const DoFHandler<dim, spacedim>        &dof_handler,
+        const std::vector<IndexSet>            &patch_level_cells,
+        const std::vector<std::size_t>         &patch_cummulative_n_cells,
+        const std::vector<std::size_t>         &patch_cell_order,
+        const std::vector<std::pair<int, int>> *patch_expanded_cells);
 
       const DoFHandler<dim, spacedim> *dh;
 
       const std::vector<IndexSet>    *level_cells;
       const std::vector<std::size_t> *cummulative_n_cells;
+      const std::vector<std::size_t> *cell_order;
+
+      // nullptr unless the PatchMap has expanded cells.
+      const std::vector<std::pair<int, int>> *expanded_cells;
 
       std::ptrdiff_t index;
 
@@ -162,10 +281,46 @@ namespace fdl
     end(const std::size_t patch_n, const DoFHandler<dim, spacedim> &dh) const;
 
   protected:
+    /**
+     * Compute cummulative_n_cells[patch_n] from patch_level_cells[patch_n].
+     */
+    void
+    compute_cummulative_n_cells(const std::size_t patch_n);
+
+    /**
+     * Compute cell_order[patch_n] by sorting the cells on a Morton curve.
+     */
+    void
+    compute_cell_order(const std::size_t patch_n);
+
+    /**
+     * Compute expanded_cells[patch_n] from patch_level_cells[patch_n] and
+     * cell_order[patch_n].
+     */
+    void
+    compute_expanded_cells(const std::size_t patch_n);
+
+    /**
+     * Compute patch_active_cell_indices[patch_n] and
+     * patch_dof_indices[i][patch_n] for each cached DoFHandler.
+     */
+    void
+    compute_cached_indices(const std::size_t patch_n);
+
     SmartPointer<const Triangulation<dim, spacedim>> tria;
 
     std::vector<tbox::Pointer<hier::Patch<spacedim>>> patches;
 
+    // Settings used by the last call to reinit().
+    double extra_ghost_cell_fraction = 0.0;
+    bool   morton_order_cells        = false;
+
+    // Bounding boxes of the patches, including ghost regions.
+    std::vector<BoundingBox<spacedim>> patch_bboxes;
+
+    // Bounding boxes used to assign each active cell to patches.
+    std::vector<BoundingBox<spacedim>> reference_cell_bboxes;
+
     // Compressed representation of cells, indexed by patch and then level
     // number. The entries in the IndexSet are the cell indices.
     std::vector<std::vector<IndexSet>> patch_level_cells;
@@ -174,6 +329,31 @@ namespace fdl
     // number of cells on level 0, the second is the sum of level 0 and 1, etc.
     // The last entry is the total number of cells. Used by the iterators.
     std::vector<std::vector<std::size_t>> cummulative_n_cells;
+
+    // Permutation of the cells on each patch: i.e., the nth cell visited by an
+    // iterator is the cell_order[patch_n][n]th cell in level and index order.
+    // Empty if the cells are not reordered.
+    std::vector<std::vector<std::size_t>> cell_order;
+
+    // Whether or not expand_cells() has been called.
+    bool store_expanded_cells = false;
+
+    // Level and index of each cell on each patch, in iteration order. Empty
+    // unless store_expanded_cells is true.
+    std::vector<std::vector<std::pair<int, int>>> expanded_cells;
+
+    // DoFHandlers given to cache_dof_indices(). These are not SmartPointers
+    // since users typically destroy the DoFHandlers before calling reinit().
+    std::vector<const DoFHandler<dim, spacedim> *> cached_dof_handlers;
+
+    // Active cell indices of the cells on each patch, in iteration order. Empty
+    // unless at least one DoFHandler has cached DoF indices.
+    std::vector<std::vector<unsigned int>> patch_active_cell_indices;
+
+    // DoF indices of the cells on each patch, in iteration order, indexed by
+    // cached DoFHandler and then patch number.
+    std::vector<std::vector<std::vector<types::global_dof_index>>>
+      patch_dof_indices;
   };
 
 
@@ -198,15 +378,72 @@ namespace fdl
 
 
 
+  template <int dim, int spacedim>
+  bool
+  PatchMap<dim, spacedim>::has_cached_dof_indices(
+    const DoFHandler<dim, spacedim> &dof_handler) const
+  {
+    return std::find(cached_dof_handlers.begin(),
+                     cached_dof_handlers.end(),
+                     &dof_handler) != cached_dof_handlers.end();
+  }
+
+
+
+  template <int dim, int spacedim>
+  bool
+  PatchMap<dim, spacedim>::has_expanded_cells() const
+  {
+    return store_expanded_cells;
+  }
+
+
+
+  template <int dim, int spacedim>
+  ArrayView<const unsigned int>
+  PatchMap<dim, spacedim>::get_active_cell_indices(
+    const std::size_t patch_n) const
+  {
+    AssertIndexRange(patch_n, size());
+    Assert(cached_dof_handlers.size() > 0,
+           ExcMessage("cache_dof_indices() must be called first."));
+    return make_array_view(patch_active_cell_indices[patch_n]);
+  }
+
+
+
+  template <int dim, int spacedim>
+  ArrayView<const types::global_dof_index>
+  PatchMap<dim, spacedim>::get_dof_indices(
+    const std::size_t                patch_n,
+    const DoFHandler<dim, spacedim> &dof_handler) const
+  {
+    AssertIndexRange(patch_n, size());
+    const auto it = std::find(cached_dof_handlers.begin(),
+                              cached_dof_handlers.end(),
+                              &dof_handler);
+    Assert(it != cached_dof_handlers.end(),
+           ExcMessage("cache_dof_indices() must be called first with this "
+                      "DoFHandler."));
+    return make_array_view(
+      patch_dof_indices[it - cached_dof_handlers.begin()][patch_n]);
+  }
+
+
+
   template <int dim, int spacedim>
   PatchMap<dim, spacedim>::iterator::iterator(
-    const std::ptrdiff_t             index,
-    const DoFHandler<dim, spacedim> &dof_handler,
-    const std::vector<IndexSet>     &patch_level_cells,
-    const std::vector<std::size_t>  &patch_cummulative_n_cells)
+    const std::ptrdiff_t                   index,
+    const DoFHandler<dim, spacedim>        &dof_handler,
+    const std::vector<IndexSet>            &patch_level_cells,
+    const std::vector<std::size_t>         &patch_cummulative_n_cells,
+    const std::vector<std::size_t>         &patch_cell_order,
+    const std::vector<std::pair<int, int>> *patch_expanded_cells)
     : dh(&dof_handler)
     , level_cells(&patch_level_cells)
     , cummulative_n_cells(&patch_cummulative_n_cells)
+    , cell_order(&patch_cell_order)
+    , expanded_cells(patch_expanded_cells)
     , index(index)
   {}
 
@@ -243,7 +480,9 @@ namespace fdl
     return iterator(0,
                     dh,
                     patch_level_cells[patch_n],
-                    cummulative_n_cells[patch_n]);
+                    cummulative_n_cells[patch_n],
+                    cell_order[patch_n],
+                    store_expanded_cells ? &expanded_cells[patch_n] : nullptr);
   }
 
 
@@ -259,7 +498,9 @@ namespace fdl
     return iterator(cummulative_n_cells[patch_n].back(),
                     dh,
                     patch_level_cells[patch_n],
-                    cummulative_n_cells[patch_n]);
+                    cummulative_n_cells[patch_n],
+                    cell_order[patch_n],
+                    store_expanded_cells ? &expanded_cells[patch_n] : nullptr);
   }
 
 
@@ -269,18 +510,30 @@ namespace fdl
   PatchMap<dim, spacedim>::iterator::operator*() const
   {
     Assert(0 <= index, ExcMessage("invalid iterator"));
+    if (expanded_cells)
+      {
+        if (index == std::ptrdiff_t(expanded_cells->size()))
+          return dh->end();
+        AssertIndexRange(index, expanded_cells->size());
+        const std::pair<int, int> &cell = (*expanded_cells)[index];
+        return typename DoFHandler<dim, spacedim>::active_cell_iterator(
+          &dh->get_triangulation(), cell.first, cell.second, dh);
+      }
+    const std::ptrdiff_t position =
+      index < std::ptrdiff_t(cell_order->size()) ? (*cell_order)[index] : index;
     const auto it = std::upper_bound(cummulative_n_cells->begin(),
                                      cummulative_n_cells->end(),
-                                     index);
+                                     position);
     if (it == cummulative_n_cells->end())
       {
-        Assert(index <= std::ptrdiff_t(cummulative_n_cells->back()),
+        Assert(position <= std::ptrdiff_t(cummulative_n_cells->back()),
                ExcMessage("invalid iterator"));
         return dh->end();
       }
     const unsigned int cell_level = it - cummulative_n_cells->begin();
     const unsigned int cell_index = (*level_cells)[cell_level].nth_index_in_set(
-      index - (cell_level == 0 ? 0 : (*cummulative_n_cells)[cell_level - 1]));
+      position -
+      (cell_level == 0 ? 0 : (*cummulative_n_cells)[cell_level - 1]));
     return typename DoFHandler<dim, spacedim>::active_cell_iterator(
       &dh->get_triangulation(), cell_level, cell_index, dh);
   }
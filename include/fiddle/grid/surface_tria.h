@@ -122,6 +122,57 @@ namespace fdl
   fit_boundary_vertices(const std::vector<Point<spacedim>> &new_vertices,
                         Triangulation<dim, spacedim>       &tria);
 
+  /**
+   * Cache for planar triangulations. Calling Triangle is relatively expensive,
+   * so if the boundary points have the same topology as on the last call
+   * (i.e., the same number of points, which are assumed to be in the same
+   * order, and the same parameters for Triangle) we avoid creating a new
+   * Triangulation and instead move the vertices of the previous one with
+   * fit_boundary_vertices(). The Triangulation is only recreated when the
+   * topology changes or when moving the vertices inverts a cell.
+   */
+  class PlanarTriangulationCache
+  {
+  public:
+    /**
+     * Set up a planar mesh which best fits the three dimensional points and
+     * whose boundary vertices are exactly @p points. This is equivalent to
+     * calling create_planar_triangulation() and then fit_boundary_vertices()
+     * but will reuse, if possible, the Triangulation created on the previous
+     * call.
+     *
+     * @return Whether or not a new Triangulation was created.
+     */
+    bool
+    create_triangulation(const std::vector<Point<3>>    &points,
+                         Triangulation<2, 3>            &tria,
+                         const Triangle::AdditionalData &additional_data = {});
+
+    /**
+     * Delete the cached Triangulation so that the next call to
+     * create_triangulation() always creates a new one.
+     */
+    void
+    clear();
+
+  protected:
+    /**
+     * Cached Triangulation, whose boundary vertices are the points from the
+     * last call to create_triangulation().
+     */
+    Triangulation<2, 3> cached_tria;
+
+    /**
+     * Normal vector of the plane used to create @p cached_tria, which
+     * determines the orientation of each cell.
+     */
+    Tensor<1, 3> normal;
+
+    /**
+     * Parameters used to create @p cached_tria.
+     */
+    Triangle::AdditionalData cached_additional_data;
+  };
 } // namespace fdl
 
 #endif
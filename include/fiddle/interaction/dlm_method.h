@@ -10,6 +10,10 @@
 
 #include <deal.II/lac/la_parallel_vector.h>
 
+#include <cstdint>
+#include <utility>
+#include <vector>
+
 namespace fdl
 {
   using namespace dealii;
@@ -17,6 +21,11 @@ namespace fdl
   /**
    * Abstract class implementing an interface for the distributed Lagrange
    * multiplier method.
+   *
+   * Since the same position is typically requested several times in each time
+   * step (e.g., by several DLMForce objects or by several evaluations at the
+   * same time), this class caches the results of get_mechanics_position() by
+   * time: see get_cached_mechanics_position().
    */
   template <int dim, int spacedim = dim>
   class DLMMethodBase : public Subscriptor
@@ -39,6 +48,49 @@ namespace fdl
      */
     virtual const LinearAlgebra::distributed::Vector<double> &
     get_current_mechanics_position() const = 0;
+
+    /**
+     * Get the position at @p time, which is computed with
+     * get_mechanics_position() the first time it is requested after the last
+     * call to invalidate_mechanics_position_cache(). The returned reference
+     * (which has up-to-date ghost values) is valid until the next call to this
+     * function.
+     */
+    const LinearAlgebra::distributed::Vector<double> &
+    get_cached_mechanics_position(const double time) const;
+
+    /**
+     * Discard all cached positions. Inheriting classes must call this function
+     * whenever the result of get_mechanics_position() at a time which may
+     * have already been requested changes, e.g., when the mechanics solver
+     * advances.
+     */
+    void
+    invalidate_mechanics_position_cache();
+
+    /**
+     * Get the number of times invalidate_mechanics_position_cache() has been
+     * called. Together with the time, this uniquely identifies a position.
+     */
+    std::uint64_t
+    get_mechanics_position_version() const;
+
+  private:
+    /**
+     * Maximum number of cached positions: enough for the current, half, and
+     * new times.
+     */
+    static constexpr std::size_t max_cached_positions = 3;
+
+    std::uint64_t mechanics_position_version = 0;
+
+    /**
+     * Cached positions and the times at which they were computed, ordered
+     * from least to most recently used.
+     */
+    mutable std::vector<
+      std::pair<double, LinearAlgebra::distributed::Vector<double>>>
+      cached_positions;
   };
 
   /**
@@ -66,6 +118,14 @@ namespace fdl
 
   protected:
     SmartPointer<DLMMethodBase<dim, spacedim>> dlm;
+
+    /**
+     * Time and DLMMethodBase::get_mechanics_position_version() of the current
+     * reference position, so that it is only copied when it changes.
+     */
+    double reference_time;
+
+    std::uint64_t reference_version;
   };
 } // namespace fdl
 
@@ -8,6 +8,7 @@
 #include <fiddle/grid/patch_map.h>
 
 #include <fiddle/interaction/interaction_base.h>
+#include <fiddle/interaction/interaction_utilities.h>
 
 #include <deal.II/base/bounding_box.h>
 #include <deal.II/base/quadrature.h>
@@ -51,6 +52,60 @@ namespace fdl
   using namespace dealii;
   using namespace SAMRAI;
 
+  /**
+   * Interaction based on quadrature rules defined on each element.
+   *
+   * In addition to the parameters read by InteractionBase, this class reads
+   * the boolean <code>cache_kernel_weights</code> (default false) from the
+   * input database. If true, IB kernel weights computed during interpolation
+   * are reused when spreading at the same position (and vice-versa), which is
+   * common when using midpoint time stepping. It also reads the boolean
+   * <code>mixed_precision</code> (default false): if true, IB kernel weights
+   * are computed in single precision (see compute_projection_rhs()). Finally,
+   * it reads the boolean <code>estimate_workload</code> (default false): if
+   * true, the workload is computed with estimate_quadrature_points() instead
+   * of count_quadrature_points(), which avoids evaluating the position at
+   * every quadrature point. The boolean <code>morton_order_cells</code>
+   * (default false) is passed to PatchMap::reinit(). If the boolean
+   * <code>expand_cells</code> (default false) is true then the PatchMap
+   * stores the level and index of each cell (see PatchMap::expand_cells()),
+   * which makes looking up cells cheaper at the cost of some memory. The
+   * boolean <code>cache_dof_indices</code> (default false) determines
+   * whether or not the DoF indices of each added DoFHandler are stored by
+   * the PatchMap (see PatchMap::cache_dof_indices()) instead of being looked
+   * up on every cell during interaction. The double
+   * <code>quadrature_hysteresis</code> (default 0) is a relative margin on the
+   * cell lengths: if it is positive then, when the object is reinitialized, a
+   * cell keeps its previous quadrature rule unless that rule would not be
+   * selected for any length within that margin of the current length. This
+   * avoids cells switching back and forth between rules (and the corresponding
+   * changes in the workload) when their lengths fluctuate around a threshold.
+   * If the boolean <code>equispaced_quadratures</code> (default false) is true
+   * then IB points are placed with QEquispacedFamily (or
+   * QEquispacedSimplexFamily) instead of QGaussFamily (or
+   * QWitherdenVincentSimplexFamily), which typically requires fewer points for
+   * the same point density. If the boolean
+   * <code>skip_zero_spread_cells</code> (default false) is true then
+   * spreading skips cells whose force DoFs are all zero (see
+   * compute_spread()) and the number of skipped cells is added to the timing
+   * report as <code>fdl::ElementalInteraction[skipped_spread_cells]</code>.
+   * If the double <code>frozen_displacement_tolerance</code> (default 0) is
+   * positive then the quadrature points and IB kernel weights (see
+   * QuadraturePointCache and KernelWeightCache, which are then always used)
+   * are computed at a reference position and reused, as fixed interpolation
+   * and spreading operators, until some position DoF moves further than this
+   * distance from the reference position. This is intended for structures
+   * which barely move, for which it removes nearly all evaluation of the
+   * position and the kernel, and should be a small fraction of the grid
+   * spacing. The number of times the reference position is replaced is added
+   * to the timing report as
+   * <code>fdl::ElementalInteraction[frozen_position_updates]</code>.
+   *
+   * The quadrature rule on each cell is selected from the grid spacing of
+   * the finest level, among the levels this object interacts with, which has
+   * a patch intersecting the bounding box of that cell. Hence cells which
+   * only interact with coarse patches use fewer points.
+   */
   template <int dim, int spacedim = dim>
   class ElementalInteraction : public InteractionBase<dim, spacedim>
   {
@@ -88,6 +143,24 @@ namespace fdl
            tbox::Pointer<hier::PatchHierarchy<spacedim>>    patch_hierarchy,
            const std::pair<int, int> &level_numbers) override;
 
+    /**
+     * Same as InteractionBase::update_patch_hierarchy(), but also switches
+     * the PatchMap to the new patches.
+     */
+    virtual bool
+    update_patch_hierarchy(
+      tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy,
+      const std::pair<int, int>                    &level_numbers) override;
+
+    /**
+     * Same as InteractionBase::add_dof_handler(), but also caches the DoF
+     * indices of the overlap DoFHandler in the PatchMap if requested (in
+     * which case the overlap DoFHandler is set up immediately).
+     */
+    virtual void
+    add_dof_handler(
+      const DoFHandler<dim, spacedim> &native_dof_handler) override;
+
     /**
      * Projection really is projection for this method so this always returns
      * false.
@@ -117,6 +190,31 @@ namespace fdl
     virtual std::unique_ptr<TransactionBase>
     add_workload_intermediate(std::unique_ptr<TransactionBase> t_ptr) override;
 
+    /**
+     * Return an estimate of the memory used by this object, in bytes. In
+     * addition to the data stored by InteractionBase this includes the patch
+     * map, the quadrature indices, and the kernel weight and quadrature point
+     * caches.
+     */
+    virtual std::size_t
+    memory_consumption() const override;
+
+    /**
+     * Return the number of quadrature points, at the position used by the
+     * last operation, which lie outside the physical domain. These points are
+     * skipped by interpolation and spreading.
+     */
+    std::size_t
+    n_exterior_quadrature_points() const;
+
+    /**
+     * Return the total number of cells skipped by spreading, since this
+     * object was created, because their forces were zero. Always zero
+     * unless <code>skip_zero_spread_cells</code> is true.
+     */
+    std::size_t
+    n_skipped_zero_cells() const;
+
   protected:
     virtual VectorOperation::values
     get_rhs_scatter_type() const override;
@@ -147,6 +245,18 @@ namespace fdl
      */
     std::vector<unsigned char> quadrature_indices;
 
+    /**
+     * Relative margin used when selecting quadrature rules.
+     */
+    double quadrature_hysteresis;
+
+    /**
+     * Indices of the quadrature rules selected for each active cell of the
+     * native Triangulation at the last reinitialization. Only used when
+     * quadrature_hysteresis is positive.
+     */
+    std::vector<unsigned char> native_quadrature_indices;
+
     /**
      * Collection of quadrature rules which are suitable for the given
      * triangulation.
@@ -157,6 +267,89 @@ namespace fdl
      * Vector of quadratures we will actually use for interaction.
      */
     std::vector<Quadrature<dim>> quadratures;
+
+    /**
+     * Whether or not we should cache kernel weights.
+     */
+    bool cache_kernel_weights;
+
+    /**
+     * Whether or not we should compute kernel weights in single precision.
+     */
+    bool mixed_precision;
+
+    /**
+     * Whether or not we should estimate the workload from cell bounding
+     * boxes instead of counting quadrature points exactly.
+     */
+    bool estimate_workload;
+
+    /**
+     * Whether or not the PatchMap should store the DoF indices of each
+     * DoFHandler.
+     */
+    bool cache_dof_indices;
+
+    /**
+     * Whether or not spreading should skip cells with zero force.
+     */
+    bool skip_zero_spread_cells;
+
+    /**
+     * Number of cells skipped by spreading.
+     */
+    std::size_t n_skipped_spread_cells;
+
+    /**
+     * Largest displacement from frozen_position for which the caches computed
+     * at that position are reused. Not used if it is not positive.
+     */
+    double frozen_displacement_tolerance;
+
+    /**
+     * Overlap position at which the cached quadrature points and kernel
+     * weights were computed, and its key.
+     */
+    mutable Vector<double> frozen_position;
+
+    mutable std::size_t frozen_position_key;
+
+    /**
+     * Kernel weights shared between interpolation and spreading.
+     */
+    mutable KernelWeightCache<spacedim> kernel_weight_cache;
+
+    /**
+     * Quadrature points shared by all operations at the same position.
+     */
+    mutable QuadraturePointCache<spacedim> quadrature_point_cache;
+
+    /**
+     * Return a pointer to the reinitialized kernel weight cache appropriate
+     * for the current transaction or nullptr if caching is disabled.
+     *
+     * @param[in] position_key A value identifying the position of the
+     * structure, e.g., a hash of the position vector.
+     */
+    KernelWeightCache<spacedim> *
+    get_kernel_weight_cache(const Transaction<dim, spacedim> &transaction,
+                            const std::size_t position_key) const;
+
+    /**
+     * Return a value identifying @p overlap_position for use with the caches.
+     * This is a hash of the position unless frozen_displacement_tolerance is
+     * positive and @p overlap_position is within that distance of
+     * frozen_position, in which case it is the key of frozen_position.
+     */
+    std::size_t
+    get_position_key(const Vector<double> &overlap_position) const;
+
+    /**
+     * Return a pointer to the quadrature point cache, reinitialized for the
+     * given position.
+     */
+    QuadraturePointCache<spacedim> *
+    get_quadrature_point_cache(const std::size_t position_key) const;
   };
 } // namespace fdl
 #endif
@@ -0,0 +1,210 @@
+#ifndef included_fiddle_interaction_hybrid_interaction_h
+#define included_fiddle_interaction_hybrid_interaction_h
+
+#include <fiddle/base/config.h>
+
+#include <fiddle/grid/nodal_patch_map.h>
+
+#include <fiddle/interaction/elemental_interaction.h>
+
+#include <deal.II/base/bounding_box.h>
+#include <deal.II/base/types.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <utility>
+#include <vector>
+
+// forward declarations
+namespace dealii
+{
+  namespace parallel
+  {
+    namespace shared
+    {
+      template <int, int>
+      class Triangulation;
+    }
+  } // namespace parallel
+} // namespace dealii
+
+namespace SAMRAI
+{
+  namespace hier
+  {
+    template <int>
+    class Patch;
+
+    template <int>
+    class PatchHierarchy;
+  } // namespace hier
+
+  namespace tbox
+  {
+    template <typename>
+    class Pointer;
+    class Database;
+  } // namespace tbox
+} // namespace SAMRAI
+
+namespace fdl
+{
+  using namespace dealii;
+  using namespace SAMRAI;
+
+  /**
+   * Interaction which interpolates at the nodes, like NodalInteraction, and
+   * spreads at quadrature points, like ElementalInteraction.
+   *
+   * Since interpolation directly computes nodal values,
+   * projection_is_interpolation() is true and no mass solve is needed to
+   * compute the velocity. Forces are still spread from the force density at
+   * the quadrature points of each element, so spreading_is_nodal() is false:
+   * this avoids the gaps between IB points, and the resulting leaks, which
+   * can occur with nodal spreading on coarse structural meshes. Hence each
+   * time step requires one mass solve per part instead of two.
+   *
+   * Every field which is interpolated must use the same base element as the
+   * position (e.g., FESystem(FE_Q(k), spacedim) for both). Unlike
+   * NodalInteraction, the overlap DoFs are numbered in the same way as
+   * ElementalInteraction and the assignment of nodes to patches is updated
+   * when the position changes, so reinit() does not need the position.
+   *
+   * This class reads the same input database values as
+   * ElementalInteraction.
+   */
+  template <int dim, int spacedim = dim>
+  class HybridInteraction : public ElementalInteraction<dim, spacedim>
+  {
+  public:
+    /**
+     * Constructor. Sets up an empty object.
+     */
+    HybridInteraction(const unsigned int min_n_points_1D,
+                      const double       point_density,
+                      const DensityKind  density_kind);
+
+    /**
+     * Constructor.
+     */
+    HybridInteraction(
+      const tbox::Pointer<tbox::Database>                  &input_db,
+      const parallel::shared::Triangulation<dim, spacedim> &native_tria,
+      const std::vector<BoundingBox<spacedim, float>>      &active_cell_bboxes,
+      const std::vector<float>                             &active_cell_lengths,
+      tbox::Pointer<hier::PatchHierarchy<spacedim>>         patch_hierarchy,
+      const std::pair<int, int>                            &level_numbers,
+      const unsigned int                                    min_n_points_1D,
+      const double                                          point_density,
+      const DensityKind                                     density_kind);
+
+    /**
+     * Reinitialize the object. Same as ElementalInteraction::reinit(), but
+     * also sets up the patch boxes used to assign nodes to patches.
+     */
+    virtual void
+    reinit(const tbox::Pointer<tbox::Database>                  &input_db,
+           const parallel::shared::Triangulation<dim, spacedim> &native_tria,
+           const std::vector<BoundingBox<spacedim, float>> &active_cell_bboxes,
+           const std::vector<float>                        &active_cell_lengths,
+           tbox::Pointer<hier::PatchHierarchy<spacedim>>    patch_hierarchy,
+           const std::pair<int, int> &level_numbers) override;
+
+    /**
+     * Same as ElementalInteraction::update_patch_hierarchy(), but also
+     * switches the NodalPatchMap to the new patches.
+     */
+    virtual bool
+    update_patch_hierarchy(
+      tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy,
+      const std::pair<int, int>                    &level_numbers) override;
+
+    /**
+     * Same as ElementalInteraction::add_dof_handler(), but also computes the
+     * permutation from the overlap DoFs to nodal (i.e., support point-wise)
+     * order. Hence the overlap DoFHandler is set up immediately.
+     */
+    virtual void
+    add_dof_handler(
+      const DoFHandler<dim, spacedim> &native_dof_handler) override;
+
+    /**
+     * This method always interpolates so this always returns true.
+     */
+    virtual bool
+    projection_is_interpolation() const override;
+
+    /**
+     * Forces are spread at quadrature points, so this always returns false.
+     */
+    virtual bool
+    spreading_is_nodal() const override;
+
+    /**
+     * Update the NodalPatchMap to the current position and then interpolate
+     * at the nodes with compute_nodal_interpolation().
+     */
+    virtual std::unique_ptr<TransactionBase>
+    compute_projection_rhs_intermediate(
+      std::unique_ptr<TransactionBase> transaction) const override;
+
+    /**
+     * Finish nodal interpolation. Like NodalInteraction, this sets the
+     * velocities of nodes outside the domain to zero.
+     */
+    virtual void
+    compute_projection_rhs_accumulate_finish(
+      std::unique_ptr<TransactionBase> transaction) override;
+
+    /**
+     * Return an estimate of the memory used by this object, in bytes. In
+     * addition to the data stored by ElementalInteraction this includes the
+     * NodalPatchMap and the nodal permutations.
+     */
+    virtual std::size_t
+    memory_consumption() const override;
+
+  protected:
+    virtual VectorOperation::values
+    get_rhs_scatter_type() const override;
+
+    /**
+     * Return the permutation from overlap DoFs to nodal order of the
+     * corresponding native DoFHandler.
+     */
+    const std::vector<types::global_dof_index> &
+    get_nodal_renumbering(
+      const DoFHandler<dim, spacedim> &native_dof_handler) const;
+
+    /**
+     * Patches used for nodal interpolation.
+     */
+    std::vector<tbox::Pointer<hier::Patch<spacedim>>> nodal_patches;
+
+    /**
+     * Bounding boxes, including ghost regions, of each patch.
+     */
+    std::vector<std::vector<BoundingBox<spacedim>>> nodal_bboxes;
+
+    /**
+     * For each DoFHandler, the index of each overlap DoF in nodal order,
+     * i.e., the result of DoFRenumbering::compute_support_point_wise().
+     */
+    std::vector<std::vector<types::global_dof_index>> nodal_renumberings;
+
+    /**
+     * Overlap position, in nodal order, used by the last update of
+     * @p nodal_patch_map. Empty if that map has not been set up since the
+     * last call to reinit().
+     *
+     * @note These are updated at each interpolation, so they are mutable.
+     */
+    mutable Vector<double> nodal_position;
+
+    /**
+     * Mapping between nodes and patches.
+     */
+    mutable NodalPatchMap<dim, spacedim> nodal_patch_map;
+  };
+} // namespace fdl
+#endif
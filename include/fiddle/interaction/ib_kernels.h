@@ -0,0 +1,232 @@
+#ifndef included_fiddle_interaction_ib_kernels_h
+#define included_fiddle_interaction_ib_kernels_h
+
+#include <fiddle/base/config.h>
+
+#include <fiddle/base/exceptions.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/vectorization.h>
+
+#include <array>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * Regularized delta functions which fiddle can evaluate natively (i.e.,
+   * without calling IBTK::LEInteractor). The names match those used by IBAMR.
+   */
+  enum class IBKernel
+  {
+    PiecewiseLinear,
+    IB3,
+    IB4,
+    BSpline3,
+    /**
+     * Any other kernel supported by IBAMR - i.e., we should fall back to
+     * IBTK::LEInteractor.
+     */
+    Other
+  };
+
+  /**
+   * Convert an IBAMR kernel name (e.g., "IB_4") to the equivalent IBKernel.
+   */
+  inline IBKernel
+  to_ib_kernel(const std::string &kernel_name)
+  {
+    if (kernel_name == "PIECEWISE_LINEAR")
+      return IBKernel::PiecewiseLinear;
+    else if (kernel_name == "IB_3")
+      return IBKernel::IB3;
+    else if (kernel_name == "IB_4")
+      return IBKernel::IB4;
+    else if (kernel_name == "BSPLINE_3")
+      return IBKernel::BSpline3;
+    return IBKernel::Other;
+  }
+
+  /**
+   * One-dimensional kernels. Each kernel provides its stencil width (in cells)
+   * and a value() function which may be evaluated either with scalars or with
+   * VectorizedArray objects, in which case the kernel is evaluated for several
+   * points simultaneously. Distances are measured in units of the grid spacing.
+   *
+   * Kernels are written without branches (we compute every piece and then
+   * select the correct one with a mask) so that the vectorized versions are
+   * genuinely SIMD.
+   */
+  struct PiecewiseLinearKernel
+  {
+    static constexpr int width = 2;
+
+    template <typename Number>
+    static Number
+    value(const Number &r)
+    {
+      const Number a = std::abs(r);
+      return compare_and_apply_mask<SIMDComparison::less_than>(a,
+                                                               Number(1.0),
+                                                               Number(1.0) - a,
+                                                               Number(0.0));
+    }
+  };
+
+  struct IB3Kernel
+  {
+    static constexpr int width = 3;
+
+    template <typename Number>
+    static Number
+    value(const Number &r)
+    {
+      const Number a     = std::abs(r);
+      const Number inner = (Number(1.0) + std::sqrt(std::max(
+                                            Number(1.0) - Number(3.0) * a * a,
+                                            Number(0.0)))) /
+                           Number(3.0);
+      const Number b     = Number(1.0) - a;
+      const Number outer =
+        (Number(5.0) - Number(3.0) * a -
+         std::sqrt(std::max(Number(1.0) - Number(3.0) * b * b, Number(0.0)))) /
+        Number(6.0);
+      return compare_and_apply_mask<SIMDComparison::less_than>(
+        a,
+        Number(0.5),
+        inner,
+        compare_and_apply_mask<SIMDComparison::less_than>(a,
+                                                          Number(1.5),
+                                                          outer,
+                                                          Number(0.0)));
+    }
+  };
+
+  struct IB4Kernel
+  {
+    static constexpr int width = 4;
+
+    template <typename Number>
+    static Number
+    value(const Number &r)
+    {
+      const Number a     = std::abs(r);
+      const Number inner = (Number(3.0) - Number(2.0) * a +
+                            std::sqrt(std::max(Number(1.0) + Number(4.0) * a -
+                                                 Number(4.0) * a * a,
+                                               Number(0.0)))) /
+                           Number(8.0);
+      const Number outer = (Number(5.0) - Number(2.0) * a -
+                            std::sqrt(std::max(Number(-7.0) + Number(12.0) * a -
+                                                 Number(4.0) * a * a,
+                                               Number(0.0)))) /
+                           Number(8.0);
+      return compare_and_apply_mask<SIMDComparison::less_than>(
+        a,
+        Number(1.0),
+        inner,
+        compare_and_apply_mask<SIMDComparison::less_than>(a,
+                                                          Number(2.0),
+                                                          outer,
+                                                          Number(0.0)));
+    }
+  };
+
+  struct BSpline3Kernel
+  {
+    static constexpr int width = 3;
+
+    template <typename Number>
+    static Number
+    value(const Number &r)
+    {
+      const Number a     = std::abs(r);
+      const Number inner = Number(0.75) - a * a;
+      const Number b     = Number(1.5) - a;
+      const Number outer = Number(0.5) * b * b;
+      return compare_and_apply_mask<SIMDComparison::less_than>(
+        a,
+        Number(0.5),
+        inner,
+        compare_and_apply_mask<SIMDComparison::less_than>(a,
+                                                          Number(1.5),
+                                                          outer,
+                                                          Number(0.0)));
+    }
+  };
+
+  /**
+   * Compute the tensor-product stencils of a set of points.
+   *
+   * Here the grid is described by its lower corner @p x_lower, the grid
+   * spacing @p dx, and the index of the first cell @p i_lower. The data is
+   * assumed to be cell-centered, i.e., the first cell center is at
+   * <code>x_lower + dx/2</code>.
+   *
+   * On output, @p stencil_lower contains, for each point, the index of the
+   * first cell in its stencil and @p weights contains, for each point and
+   * coordinate direction, Kernel::width one-dimensional weights. Hence the
+   * weight of cell <code>stencil_lower[p] + (i, j)</code> for point p in 2D is
+   * <code>weights[(p * spacedim + 0) * width + i] * weights[(p * spacedim +
+   * 1) * width + j]</code>.
+   *
+   * Kernels are evaluated VectorizedArray<Number>::size() points at a time.
+   * Stencil positions are always computed in double precision, so the choice
+   * of @p Number (either double or float) only affects the precision of the
+   * weights themselves.
+   */
+  template <typename Kernel, int spacedim, typename Number = double>
+  void
+  compute_kernel_weights(const ArrayView<const Point<spacedim>> &points,
+                         const std::array<double, spacedim>     &x_lower,
+                         const std::array<double, spacedim>     &dx,
+                         const std::array<int, spacedim>        &i_lower,
+                         std::vector<std::array<int, spacedim>> &stencil_lower,
+                         std::vector<Number>                    &weights)
+  {
+    constexpr int          width     = Kernel::width;
+    constexpr unsigned int n_lanes   = VectorizedArray<Number>::size();
+    const std::size_t      n_points  = points.size();
+    const std::size_t      n_batches = (n_points + n_lanes - 1) / n_lanes;
+    stencil_lower.resize(n_points);
+    weights.resize(n_points * spacedim * width);
+
+    VectorizedArray<Number> r;
+    for (std::size_t batch_n = 0; batch_n < n_batches; ++batch_n)
+      {
+        const std::size_t  first_point = batch_n * n_lanes;
+        const unsigned int n_filled =
+          std::min<std::size_t>(n_lanes, n_points - first_point);
+        for (unsigned int d = 0; d < spacedim; ++d)
+          {
+            // Distance, in cells, between the point and the center of the
+            // first cell in its stencil
+            r = 0.0;
+            for (unsigned int lane = 0; lane < n_filled; ++lane)
+              {
+                const std::size_t point_n = first_point + lane;
+                const double      s =
+                  (points[point_n][d] - x_lower[d]) / dx[d] - 0.5;
+                const int first = int(std::floor(s - 0.5 * width)) + 1;
+                stencil_lower[point_n][d] = i_lower[d] + first;
+                r[lane]                   = s - first;
+              }
+
+            for (int k = 0; k < width; ++k)
+              {
+                const VectorizedArray<Number> w = Kernel::value(r - Number(k));
+                for (unsigned int lane = 0; lane < n_filled; ++lane)
+                  weights[((first_point + lane) * spacedim + d) * width + k] =
+                    w[lane];
+              }
+          }
+      }
+  }
+} // namespace fdl
+
+#endif
@@ -3,15 +3,30 @@
 
 #include <fiddle/base/config.h>
 
+#include <fiddle/base/autotuner.h>
 #include <fiddle/base/exceptions.h>
+#include <fiddle/base/execution_policy.h>
 #include <fiddle/base/initial_guess.h>
 
 #include <fiddle/interaction/ifed_method_base.h>
 #include <fiddle/interaction/interaction_base.h>
 
+#include <fiddle/mechanics/boundary_trace.h>
+#include <fiddle/mechanics/implicit_structure_solver.h>
+#include <fiddle/mechanics/rigid_body_projection.h>
+
+#include <deal.II/base/bounding_box.h>
+
 #include <ibtk/SAMRAIGhostDataAccumulator.h>
 #include <ibtk/SecondaryHierarchy.h>
 
+#include <HierarchyDataOpsReal.h>
+
+#include <deque>
+#include <limits>
+#include <map>
+#include <memory>
+#include <ostream>
 #include <vector>
 
 namespace fdl
@@ -33,6 +48,18 @@ namespace fdl
    *   <li>solver_relative_tolerance: Relative tolerance (i.e., the solver
    *     tolerance will be set to this times the L2 norm of the RHS vector) to
    *     use in linear solvers.</li>
+   *   <li>solver_adaptive_tolerance_factor: if positive, the relative
+   *     tolerance of each mass solve is increased to this factor times the
+   *     relative change in the right-hand side since the previous solve
+   *     with the same part, i.e., the solve is only as accurate as that
+   *     change (which bounds the error of using the previous solution)
+   *     warrants. The tolerance is never smaller than
+   *     solver_relative_tolerance and, since the initial guess is checked
+   *     first, no iterations are done when the guess is already accurate
+   *     enough. Defaults to 0, i.e., always use solver_relative_tolerance.
+   *     In either case the total number of mass solver iterations is
+   *     recorded in PhaseTimings as
+   *     fdl::IFEDMethod[mass_solver_iterations].</li>
    *   <li>enable_logging: whether or not to log things like the workload.
    *     Defaults to FALSE.</li>
    *   <li>log_solver_iterations: whether or not to log number of iterations
@@ -40,6 +67,263 @@ namespace fdl
    *   <li>skip_initial_workload: whether to skip printing the initial workload,
    *     to work around an issue with SAMRAI. This is typically not necessary to
    *     set inside user codes. Defaults to FALSE.</li>
+   *   <li>interaction: how the structure interacts with the Eulerian grid.
+   *     Either ELEMENTAL (see ElementalInteraction), NODAL (see
+   *     NodalInteraction), or HYBRID (see HybridInteraction), which
+   *     interpolates at nodes and spreads at quadrature points and so only
+   *     requires a mass solve for the force. Options for elemental
+   *     interaction also apply to hybrid interaction. Defaults to
+   *     ELEMENTAL.</li>
+   *   <li>cache_kernel_weights: whether or not to reuse IB kernel weights
+   *     between interpolation and spreading at the same structure position.
+   *     Only used with elemental interaction. Defaults to FALSE.</li>
+   *   <li>mixed_precision_interaction: whether or not to compute IB kernel
+   *     weights in single precision (see compute_projection_rhs()). Only used
+   *     with elemental interaction. Defaults to FALSE.</li>
+   *   <li>estimate_interaction_workload: whether or not to estimate the
+   *     Lagrangian workload from element bounding boxes (see
+   *     estimate_quadrature_points()) instead of counting quadrature points
+   *     exactly. Only used with elemental interaction. Defaults to
+   *     FALSE.</li>
+   *   <li>elemental_workload_weight and nodal_workload_weight: cost of a
+   *     single quadrature point (with elemental interaction) or node (with
+   *     nodal interaction) in the Lagrangian workload. Defaults to 1.</li>
+   *   <li>interaction_workload_cost_model: whether or not to also scale the
+   *     cost of each point by the number of Eulerian cells in the support of
+   *     that part's IB kernel, relative to a four-point kernel (e.g., IB_4).
+   *     Defaults to FALSE, i.e., every point costs the same.</li>
+   *   <li>calibrate_interaction_workload: whether or not to calibrate the
+   *     cost of the points of each part from the time spent in
+   *     compute_projection_rhs() and compute_spread() since the last regrid
+   *     (see calibrate_workload_weights()). Defaults to FALSE.</li>
+   *   <li>workload_diagnostics: whether or not to log, at each regrid, how
+   *     well the Lagrangian interaction was balanced over the processors
+   *     since the last regrid (see log_workload_diagnostics()). This
+   *     measures the time spent in interaction, like
+   *     calibrate_interaction_workload, and always recomputes the Lagrangian
+   *     workload. Defaults to FALSE.</li>
+   *   <li>morton_order_interaction_cells: whether or not to visit the
+   *     elements on each patch along a Morton curve (see PatchMap::PatchMap())
+   *     during interaction, which improves cache reuse of patch data. Only
+   *     used with elemental interaction. Defaults to FALSE.</li>
+   *   <li>expand_interaction_cells: whether or not to store the level and
+   *     index of each element on each patch (see PatchMap::expand_cells())
+   *     instead of looking them up in a compressed representation during
+   *     interaction. This uses more memory. Only used with elemental
+   *     interaction. Defaults to FALSE.</li>
+   *   <li>cache_interaction_dof_indices: whether or not to store the DoF
+   *     indices of the elements on each patch (see
+   *     PatchMap::cache_dof_indices()) instead of looking them up during
+   *     interaction. Only used with elemental interaction. Defaults to
+   *     FALSE.</li>
+   *   <li>prefetch_spread_positions: whether or not computeLagrangianForce()
+   *     starts scattering the positions used by the following call to
+   *     spreadForce() (see
+   *     InteractionBase::compute_spread_position_scatter_start()), so that
+   *     this communication overlaps with the force computation. The positions
+   *     and forces are then sent separately. Defaults to FALSE.</li>
+   *   <li>cache_overlap_positions: whether or not the interaction objects
+   *     reuse the overlap representation of a position which has not changed
+   *     since it was last scattered (see
+   *     InteractionBase::set_position_version()): e.g., when interpolating
+   *     and spreading at the same time level. Higher-degree positions also
+   *     reuse the position mapping set up from it (see
+   *     InteractionBase::get_overlap_position_mapping()). The results are the
+   *     same either way, up to roundoff. Defaults to TRUE.</li>
+   *   <li>n_interaction_threads: maximum number of threads used to interpolate
+   *     and spread (see compute_projection_rhs() and compute_spread()) and to
+   *     assemble the force load vectors of different parts concurrently in
+   *     computeLagrangianForce(). Since IBAMR does not use threads, values
+   *     larger than one also raise the thread limit set by IFEDMethodBase.
+   *     Defaults to 1.</li>
+   *   <li>interaction_thread_partitioning: how interaction work is split
+   *     between threads (see ThreadPartitioning): either DYNAMIC or STATIC.
+   *     Defaults to DYNAMIC.</li>
+   *   <li>share_part_interactions: whether or not parts with the same
+   *     PartGeometry (see Part::get_geometry()) and IB kernel share one
+   *     interaction object. This sets up one overlap triangulation and one set
+   *     of scatters for all such parts, and sends one message to each
+   *     neighboring processor for all of them instead of one per part, which
+   *     is much faster for models with many small parts. The interaction
+   *     object contains every cell which intersects its patches in any of its
+   *     parts, so this is less efficient for parts far apart from each other.
+   *     Only used with elemental interaction and cannot be combined with
+   *     calibrate_interaction_workload. Defaults to FALSE.</li>
+   *   <li>cell_bbox_reuse_tolerance: if positive, reuse the element bounding
+   *     boxes computed at the previous regrid by enlarging each one by how
+   *     far its nodes moved, until a box has been enlarged by more than this
+   *     many (finest level) grid cells (see compute_cell_bboxes()).
+   *     Defaults to 0, i.e., bounding boxes are always recomputed.</li>
+   *   <li>interaction_cell_length: the length of each element used to
+   *     select its quadrature rule with elemental interaction. Either
+   *     LONGEST_EDGE, the longest edge of the deformed element (see
+   *     compute_longest_edge_lengths()), or VOLUME, the edge length of a
+   *     reference element with the same measure as the deformed element (see
+   *     compute_equivalent_edge_lengths()). VOLUME is cheaper to compute and
+   *     uses fewer points on compressed elements, but may place points too
+   *     far apart on strongly anisotropic elements. Defaults to
+   *     LONGEST_EDGE.</li>
+   *   <li>scatter_backend: how data is moved between the native and overlap
+   *     partitionings (see ScatterBackend). One of POINT_TO_POINT,
+   *     NEIGHBOR_COLLECTIVE, or SHARED_MEMORY. Defaults to
+   *     POINT_TO_POINT.</li>
+   *   <li>reduced_precision_scatters: whether or not velocity and force data
+   *     is sent between the native and overlap partitionings in single
+   *     precision (see Scatter::set_reduced_precision()). Positions are
+   *     always sent in double precision. Defaults to FALSE.</li>
+   *   <li>initial_guess_method: how initial guesses for the linear solvers
+   *     of each part are computed (see InitialGuessMethod). Either
+   *     PROJECTION or EXTRAPOLATION. Either one value for all parts or one
+   *     value per part. Only used with elemental interaction. Defaults to
+   *     PROJECTION.</li>
+   *   <li>mass_projection: how the L2 projections of each part (i.e., the
+   *     velocity interpolation and the force computation) are done. Either
+   *     CONSISTENT, which solves with the mass matrix to
+   *     solver_relative_tolerance, or LUMPED, which scales by the inverse of
+   *     the diagonal of the mass matrix instead (see
+   *     Part::apply_approximate_mass_inverse()). Either one value for all
+   *     parts or one value per part. Defaults to CONSISTENT.</li>
+   *   <li>mass_projection_corrections: number of Chebyshev corrections to
+   *     apply after the diagonal scaling for parts with LUMPED mass
+   *     projections. Defaults to 0.</li>
+   *   <li>mass_preconditioner_corrections: number of Chebyshev corrections
+   *     used to precondition the conjugate gradient solves for parts with
+   *     CONSISTENT mass projections (see
+   *     Part::set_mass_preconditioner_corrections()). Defaults to 0, i.e.,
+   *     Jacobi preconditioning. Parts with discontinuous finite elements
+   *     always use the exact inverse of their block diagonal mass
+   *     matrices.</li>
+   *   <li>autotune_trials: if positive, the number of preconditioner
+   *     corrections of each part's consistent mass solves is chosen by timing
+   *     each value in autotune_mass_preconditioner_corrections on this many
+   *     solves at the start of the computation (see Autotuner) and using the
+   *     fastest one from then on. Parts which are solved together are tuned
+   *     together. The chosen values are stored in restart files so that
+   *     restarted computations do not tune again. Defaults to 0, i.e.,
+   *     mass_preconditioner_corrections is always used.</li>
+   *   <li>autotune_mass_preconditioner_corrections: candidate values for
+   *     autotune_trials. Defaults to 0, 1, 2.</li>
+   *   <li>pipelined_mass_solver_parts and
+   *     pipelined_mass_solver_surface_parts: arrays of part and surface part
+   *     numbers whose consistent mass systems are solved with pipelined CG,
+   *     which hides the latency of its single reduction per iteration behind
+   *     the preconditioner and the mass operator (see
+   *     Part::set_pipelined_mass_solver()). Defaults to no parts.</li>
+   *   <li>use_device_mass_solver: whether or not the consistent mass systems
+   *     of the (volumetric) parts are solved on the device (see
+   *     PartGeometry::setup_device_mass_solver()). The device solver always
+   *     uses Jacobi preconditioning. Requires that fiddle be configured with
+   *     FDL_ENABLE_DEVICE_MATRIX_FREE. Defaults to FALSE.</li>
+   *   <li>implicit_parts: array of (volumetric) part numbers whose stresses
+   *     are evaluated implicitly. For these parts computeLagrangianForce()
+   *     evaluates the stresses at the position X which solves
+   *     <code>implicit_damping / dt M (X - X_0) = L(X)</code>, in which X_0 is
+   *     the explicit position, with a matrix-free Newton-Krylov method (see
+   *     ImplicitStructureSolver). This removes the time step restriction
+   *     caused by very stiff stresses. The other force contributions of
+   *     these parts are treated explicitly but, like the stresses, are
+   *     evaluated at X. Defaults to no parts.</li>
+   *   <li>implicit_damping: the damping coefficient used by parts in
+   *     implicit_parts. Larger values are closer to the explicit update.
+   *     Defaults to 1.</li>
+   *   <li>implicit_substeps: number of structural substeps which parts in
+   *     implicit_parts take in each fluid time step. Substep k solves
+   *     <code>implicit_damping / (dt / implicit_substeps) M (X_k - X_{k - 1})
+   *     = L(X_k)</code>, in which X_0 is the explicit position (i.e., the
+   *     interpolated velocity is held fixed), and the stresses are evaluated
+   *     at the last X_k. This resolves the relaxation of very stiff parts in
+   *     time without reducing the fluid time step size. Force contributions
+   *     are set up once, at the time at which the force is evaluated.
+   *     Defaults to 1.</li>
+   *   <li>implicit_newton_iterations and implicit_newton_tolerance: maximum
+   *     number of Newton steps and the relative tolerance used by parts in
+   *     implicit_parts. The linear solves use at most solver_iterations
+   *     GMRES iterations. Default to 10 and 1e-8.</li>
+   *   <li>rigid_parts: array of (volumetric) part numbers which move
+   *     rigidly. For these parts interpolateVelocity() computes the rigid
+   *     velocity closest to the fluid velocity from the projection
+   *     right-hand side without a mass solve, and computeLagrangianForce()
+   *     does not assemble the part's force contributions: the force is
+   *     instead rigid_constraint_density / dt times the difference between
+   *     the rigid and the interpolated velocities (see RigidBodyProjection).
+   *     Rigid parts cannot be implicit parts, cannot have boundary traces,
+   *     and require elemental or hybrid interaction. Defaults to no
+   *     parts.</li>
+   *   <li>rigid_constraint_density: the density used to compute the
+   *     constraint forces of rigid_parts. Defaults to 1.</li>
+   *   <li>surface_part_traces: array with one entry per surface part. If
+   *     entry i is a (volumetric) part number then surface part i is on the
+   *     boundary of that part and uses the trace of its finite element (see
+   *     BoundaryTrace): its position and velocity are restricted from that
+   *     part's vectors and its load vector is added into that part's load
+   *     vector. These surface parts hence need no mass solves and are not
+   *     interpolated to or spread from. Negative entries denote independent
+   *     surface parts. Defaults to all surface parts being independent.</li>
+   *   <li>skip_zero_force_parts and skip_zero_force_surface_parts: arrays of
+   *     part (respectively, surface part) numbers whose force spreading skips
+   *     cells on which every force DoF is zero (see compute_spread()). This
+   *     is worthwhile for parts whose forces are only nonzero on a small part
+   *     of the structure, e.g., tethers on nodesets. Only applies to
+   *     elemental and hybrid interaction. Parts which share an interaction
+   *     object (see share_part_interactions) skip zero cells if any of them
+   *     do. Defaults to no parts.</li>
+   *   <li>stationary_parts and stationary_surface_parts: arrays of part
+   *     (respectively, surface part) numbers which barely move, e.g.,
+   *     tethered housings. Their interaction objects compute the quadrature
+   *     points and IB kernel weights once and reuse them until some position
+   *     DoF has moved further than stationary_displacement_tolerance (in
+   *     finest level grid cells, defaults to 0.05) from where they were
+   *     computed (see the frozen_displacement_tolerance parameter of
+   *     ElementalInteraction). Only applies to elemental and hybrid
+   *     interaction. Parts which share an interaction object are only
+   *     treated this way if all of them are stationary. Defaults to no
+   *     parts.</li>
+   *   <li>interaction_reinit_displacement: if positive, then before each
+   *     time step reinitialize the interaction objects of each part whose
+   *     nodes have moved more than this many (finest level) grid cells since
+   *     that part's interaction objects were last set up (see
+   *     reinit_displaced_interactions()). This should be smaller than the
+   *     regrid CFL interval used by IBAMR. Defaults to 0, i.e., interaction
+   *     objects are only set up after regrids. Regrids which do not change
+   *     the finest level's patches only set up the interaction objects of
+   *     parts which moved more than this (see
+   *     reinit_changed_interactions()).</li>
+   *   <li>ghost_cell_fraction: number of (finest level) grid cells by which
+   *     patches are padded when finding the elements (or nodes) which
+   *     interact with them. Elements which move into a patch from outside
+   *     of this padding before the interaction objects are set up again are
+   *     missed, but a larger padding increases the size of the overlap
+   *     triangulations and of the scatters. Defaults to 1.</li>
+   *   <li>automatic_ghost_cell_fraction: whether or not to compute the
+   *     padding of each part from how far it can move before its interaction
+   *     objects are set up again instead: i.e., the smaller of
+   *     regrid_structure_cfl_interval and interaction_reinit_displacement,
+   *     plus the average displacement of that part in one time step since
+   *     the last time its interaction objects were set up. Parts without
+   *     such a measurement (e.g., at the first regrid) use the larger of
+   *     ghost_cell_fraction and the displacement bound. Defaults to
+   *     FALSE.</li>
+   *   <li>regrid_structure_cfl_interval: the value of the same option given
+   *     to IBAMR's hierarchy integrator. Only used (and then required) by
+   *     automatic_ghost_cell_fraction.</li>
+   *   <li>workload_reuse_displacement: if positive, then at each regrid
+   *     reuse the Lagrangian workload computed at the previous regrid unless
+   *     some part has moved more than this many (finest level) grid cells
+   *     since the workload was last computed. Not used when
+   *     calibrate_interaction_workload is true. Defaults to 0, i.e., the
+   *     workload is always recomputed.</li>
+   *   <li>secondary_hierarchy_bypass_imbalance: if positive, then after
+   *     each regrid compare the largest Lagrangian workload on any processor
+   *     to the mean workload, both computed on IBAMR's patch hierarchy. If
+   *     that ratio is smaller than this value then interaction is done
+   *     directly on IBAMR's patch hierarchy. This skips the copies to and
+   *     from the secondary hierarchy. Defaults to 0, i.e., the secondary
+   *     hierarchy is always used.</li>
+   *   <li>trace_file: if present, record the start and finish of every
+   *     Scatter and every state of every interaction Transaction with the
+   *     global Tracer and write them, when this object is destroyed, to
+   *     files named <code>trace_file.rank.json</code> which can be viewed
+   *     with Perfetto or chrome://tracing. Defaults to no tracing.</li>
    *   <li>GriddingAlgorithm: Database for setting up the internal
    *     GriddingAlgorithm object.</li>
    *   <li>LoadBalancer: Database for setting up the internal LoadBalancer
@@ -103,6 +387,11 @@ namespace fdl
                std::vector<Part<dim, spacedim>>     &&input_parts,
                const bool register_for_restart = true);
 
+    /**
+     * Destructor. Writes the trace, if one was requested with trace_file.
+     */
+    virtual ~IFEDMethod();
+
     /**
      * @}
      */
@@ -136,6 +425,18 @@ namespace fdl
      * @name fluid-structure interaction.
      * @{
      */
+
+    /**
+     * Same as IFEDMethodBase::getMaxPointDisplacement(). If
+     * interaction_reinit_displacement is positive then this also computes,
+     * in the same reduction, the displacements which the next call to
+     * reinit_displaced_interactions() needs: IBAMR checks whether or not to
+     * regrid immediately before preprocessIntegrateData(), when the parts
+     * have not yet moved.
+     */
+    virtual double
+    getMaxPointDisplacement() const override;
+
     virtual void
     interpolateVelocity(
       int u_data_index,
@@ -154,6 +455,40 @@ namespace fdl
 
     virtual void
     computeLagrangianForce(double data_time) override;
+
+    /**
+     * Reinitialize the interaction objects of the parts (and surface parts)
+     * whose nodes have moved more than @p max_displacement (in units of the
+     * finest level's grid spacing) since their interaction objects were last
+     * set up. The interaction objects of all other parts are left alone.
+     *
+     * This is cheaper than a full regrid when only a few parts move quickly,
+     * but it is only valid when the Eulerian patch hierarchy has not changed
+     * since the last regrid: it does not redistribute data or recompute the
+     * Lagrangian workload.
+     *
+     * @return The number of parts and surface parts whose interaction objects
+     * were reinitialized.
+     */
+    std::size_t
+    reinit_displaced_interactions(const double max_displacement);
+    /**
+     * @}
+     */
+
+    /**
+     * @name timestepping.
+     * @{
+     */
+    virtual void
+    preprocessIntegrateData(double current_time,
+                            double new_time,
+                            int    num_cycles) override;
+
+    virtual void
+    postprocessIntegrateData(double current_time,
+                             double new_time,
+                             int    num_cycles) override;
     /**
      * @}
      */
@@ -182,11 +517,51 @@ namespace fdl
     virtual const hier::IntVector<spacedim> &
     getMinimumGhostCellWidth() const override;
 
+    /**
+     * Same as IFEDMethodBase::putToDatabase(), but also stores the mass
+     * solver parameters chosen by autotuning (see autotune_trials).
+     */
+    virtual void
+    putToDatabase(tbox::Pointer<tbox::Database> db) override;
+
     void
     registerEulerianVariables() override;
 
     int
     get_lagrangian_workload_current_index() const;
+
+    /**
+     * Return estimates of the memory, in bytes, used on this processor by
+     * each category of data owned by this object. The categories are:
+     * <ul>
+     *   <li>parts: the positions and velocities of all parts.</li>
+     *   <li>part_geometries: the Triangulations, DoFHandlers, and MatrixFree
+     *     objects of all parts (each shared PartGeometry is only counted
+     *     once). Since parallel::shared::Triangulation is replicated on every
+     *     processor this is typically the largest category.</li>
+     *   <li>part_vectors: temporary vectors stored during each time
+     *     step.</li>
+     *   <li>interactions: the interaction objects (see
+     *     InteractionBase::memory_consumption()).</li>
+     *   <li>bookkeeping: cell bounding boxes and positions saved to decide
+     *     when interaction objects or workloads need to be recomputed and
+     *     the DoF maps of boundary traces.</li>
+     * </ul>
+     */
+    std::map<std::string, std::size_t>
+    compute_memory_consumption() const;
+
+    /**
+     * Write the minimum, mean, and maximum over all processors of each
+     * category returned by compute_memory_consumption(), their total, and
+     * the resident set size and its high-water mark (as reported by the
+     * operating system) to @p out on processor 0. All values are in
+     * megabytes.
+     *
+     * @note This function is collective.
+     */
+    void
+    write_memory_report(std::ostream &out) const;
     /**
      * @}
      */
@@ -200,16 +575,180 @@ namespace fdl
     virtual void
     reinit_interactions();
 
+    /**
+     * Return the patch hierarchy on which interaction is done: either the
+     * secondary hierarchy or, if it is being bypassed, IBAMR's patch
+     * hierarchy.
+     */
+    tbox::Pointer<hier::PatchHierarchy<spacedim>>
+    get_interaction_hierarchy();
+
+    /**
+     * Same as reinit_interactions(), but only set up the interaction objects
+     * of the parts @p i for which <code>reinit_parts[i]</code> (or,
+     * equivalently, <code>reinit_surface_parts[i]</code>) is true.
+     */
+    void
+    reinit_part_interactions(const std::vector<bool> &reinit_parts,
+                             const std::vector<bool> &reinit_surface_parts);
+
+    /**
+     * Start the position scatters used by spreadForce() at @p data_time (see
+     * prefetch_spread_positions).
+     */
+    void
+    start_spread_position_scatters(const double data_time);
+
+    /**
+     * Finish and discard the scatters started by
+     * start_spread_position_scatters(), if any.
+     */
+    void
+    cancel_spread_position_scatters();
+
+    /**
+     * Set up the interaction objects after a regrid. Interaction objects
+     * whose patches kept the same boxes on every processor (e.g., since IBAMR
+     * only regridded coarser levels) are switched to the new patches with
+     * InteractionBase::update_patch_hierarchy() and are only reinitialized if
+     * their parts moved more than interaction_reinit_displacement (or, if
+     * that is zero, at all) since they were last set up. All other
+     * interaction objects are reinitialized.
+     *
+     * @return The number of parts and surface parts whose interaction objects
+     * were reinitialized.
+     */
+    std::size_t
+    reinit_changed_interactions();
+
+    /**
+     * Compute the cost of a single quadrature point or node of each part
+     * from the time spent in the intermediate steps of interaction since the
+     * last call to this function. Each part's cost is proportional to its
+     * measured time per point while the total Lagrangian workload is kept
+     * the same, so the Lagrangian workload stays comparable to the Eulerian
+     * one. Parts without measurements keep their current cost. This call is
+     * collective.
+     */
+    void
+    calibrate_workload_weights();
+
+    /**
+     * Log, on processor 0, how well the Lagrangian interaction was balanced
+     * over the processors since the last regrid. For each of
+     * <ul>
+     *   <li>the measured wall time spent in the intermediate steps of
+     *     interaction (i.e., @p local_interaction_time on each
+     *     processor),</li>
+     *   <li>the Lagrangian workload assigned to the processor at the last
+     *     regrid (i.e., the estimated cost),</li>
+     *   <li>the number of active cells of the overlap triangulations,
+     *     and</li>
+     *   <li>the number of quadrature points or nodes counted by the latest
+     *     workload calculation</li>
+     * </ul>
+     * this logs the minimum, mean, and maximum over all processors and the
+     * imbalance (the ratio of the maximum to the mean). It also logs the
+     * correlation, over all processors, between the estimated and measured
+     * costs: values much smaller than one mean that the cost model does not
+     * describe the actual cost well while large time imbalances with well
+     * balanced estimates mean that the secondary hierarchy is not partitioned
+     * well. This call is collective.
+     */
+    void
+    log_workload_diagnostics(const double local_interaction_time) const;
+
+    /**
+     * Return whether or not the Lagrangian workload saved at the last regrid
+     * no longer describes the current configuration. This is the case if
+     * workload_reuse_displacement is not positive, if workload calibration is
+     * enabled, or if any part has moved further than
+     * workload_reuse_displacement since the workload was last computed. This
+     * call is collective.
+     */
+    bool
+    lagrangian_workload_is_stale() const;
+
+    /**
+     * Compute the Lagrangian workload and store it in
+     * lagrangian_workload_current_index on the primary hierarchy.
+     */
+    void
+    compute_lagrangian_workload();
+
     /**
      * Book-keeping
      * @{
      */
     tbox::Pointer<tbox::Database> input_db;
 
+    /**
+     * Threads used by interaction and by computeLagrangianForce().
+     */
+    ExecutionPolicy interaction_execution_policy;
+
     std::vector<std::string> ib_kernels;
 
     std::vector<std::string> surface_ib_kernels;
 
+    /**
+     * Number of ghost cells required by the IB kernel of each part and
+     * surface part.
+     */
+    std::vector<int> ib_kernel_ghost_widths;
+
+    std::vector<int> surface_ib_kernel_ghost_widths;
+
+    /**
+     * Whether or not each part uses the lumped mass matrix in L2 projections.
+     */
+    std::vector<bool> lumped_mass_projection;
+
+    std::vector<bool> surface_lumped_mass_projection;
+
+    /**
+     * Number of Chebyshev corrections used with the lumped mass matrix.
+     */
+    unsigned int n_mass_projection_corrections;
+
+    /**
+     * Autotuners of the number of preconditioner corrections of each part's
+     * mass solves if autotune_trials is positive and empty otherwise.
+     */
+    std::vector<Autotuner> mass_solver_autotuners;
+
+    /**
+     * Solvers for the parts whose stresses are evaluated implicitly. Entries
+     * for the other parts are nullptr.
+     */
+    std::vector<std::unique_ptr<ImplicitStructureSolver<dim>>> implicit_solvers;
+
+    /**
+     * Damping coefficient used by the implicit solvers.
+     */
+    double implicit_damping;
+
+    /**
+     * Number of implicit solves per time step.
+     */
+    unsigned int n_implicit_substeps;
+
+    /**
+     * Rigid body projections of the rigid parts. Entries for the other parts
+     * are nullptr.
+     */
+    std::vector<std::unique_ptr<RigidBodyProjection<dim>>> rigid_projections;
+
+    /**
+     * Whether or not each part is rigid.
+     */
+    std::vector<bool> is_rigid_part;
+
+    /**
+     * Density used to compute the constraint forces of the rigid parts.
+     */
+    double rigid_constraint_density;
+
     /**
      * @}
      */
@@ -227,6 +766,39 @@ namespace fdl
       surface_force_guesses;
     std::vector<InitialGuess<LinearAlgebra::distributed::Vector<double>>>
       surface_velocity_guesses;
+
+    /**
+     * For each surface part, the number of the part whose boundary trace it
+     * is, or -1 for independent surface parts.
+     */
+    std::vector<int> surface_trace_parts;
+
+    /**
+     * Whether or not each surface part is a boundary trace.
+     */
+    std::vector<bool> surface_part_is_trace;
+
+    /**
+     * Whether or not spreading skips cells with zero force, for each part
+     * and surface part.
+     */
+    std::vector<bool> skip_zero_force_cells;
+
+    std::vector<bool> surface_skip_zero_force_cells;
+
+    /**
+     * Whether or not each part and surface part is stationary, i.e., reuses
+     * its interpolation and spreading operators.
+     */
+    std::vector<bool> is_stationary_part;
+
+    std::vector<bool> is_stationary_surface_part;
+
+    /**
+     * Boundary traces of the surface parts. Entries for independent surface
+     * parts are nullptr.
+     */
+    std::vector<std::unique_ptr<BoundaryTrace<dim, spacedim>>> surface_traces;
     /**
      * @}
      */
@@ -235,10 +807,27 @@ namespace fdl
      * Finite difference data structures
      * @{
      */
+    /**
+     * Largest number of ghost cells required by the kernel of any part or
+     * surface part which interacts with the fluid (i.e., boundary traces are
+     * skipped). Force accumulation is restricted to this width even if the
+     * Eulerian data has more ghost cells.
+     */
     SAMRAI::hier::IntVector<spacedim> ghosts;
 
     IBTK::SecondaryHierarchy secondary_hierarchy;
 
+    /**
+     * Whether or not interaction is done on the primary hierarchy (i.e., the
+     * one owned by IBAMR) instead of secondary_hierarchy.
+     */
+    bool bypass_secondary_hierarchy = false;
+
+    /**
+     * Name of the trace file, or the empty string if tracing is disabled.
+     */
+    std::string trace_file_name;
+
     int lagrangian_workload_plot_index = IBTK::invalid_index;
 
     int lagrangian_workload_current_index = IBTK::invalid_index;
@@ -248,6 +837,19 @@ namespace fdl
     tbox::Pointer<hier::Variable<spacedim>> lagrangian_workload_var;
 
     std::unique_ptr<IBTK::SAMRAIGhostDataAccumulator> ghost_data_accumulator;
+
+    /**
+     * Scratch data of spreadForce(), on the interaction and primary
+     * hierarchies, and the data operations on the primary hierarchy. These
+     * are set up by the first call to spreadForce() after a regrid and are
+     * reused until the next one.
+     */
+    int f_spread_data_index          = IBTK::invalid_index;
+    int f_scratch_data_index         = IBTK::invalid_index;
+    int f_primary_scratch_data_index = IBTK::invalid_index;
+
+    tbox::Pointer<math::HierarchyDataOpsReal<spacedim, double>>
+      f_primary_data_ops;
     /**
      * @}
      */
@@ -256,10 +858,105 @@ namespace fdl
      * Interaction data structures
      * @{
      */
-    std::vector<std::unique_ptr<InteractionBase<dim, spacedim>>> interactions;
+    /**
+     * Interaction object of each part. Parts in the same entry of
+     * interaction_groups point to the same object.
+     */
+    std::vector<std::shared_ptr<InteractionBase<dim, spacedim>>> interactions;
 
-    std::vector<std::unique_ptr<InteractionBase<dim - 1, spacedim>>>
+    std::vector<std::shared_ptr<InteractionBase<dim - 1, spacedim>>>
       surface_interactions;
+
+    /**
+     * Parts which share an interaction object (see share_part_interactions),
+     * sorted by their first part. Every part is in exactly one group. The
+     * data of all parts in a group is interpolated and spread by a single
+     * transaction.
+     */
+    std::vector<std::vector<unsigned int>> interaction_groups;
+
+    std::vector<std::vector<unsigned int>> surface_interaction_groups;
+
+    /**
+     * Position scatters started by start_spread_position_scatters(), indexed
+     * like interaction_groups (and, for surface parts, like the groups which
+     * are spread), and the time at which the positions were evaluated.
+     */
+    std::vector<std::unique_ptr<TransactionBase>> spread_position_transactions;
+
+    std::vector<std::unique_ptr<TransactionBase>>
+      surface_spread_position_transactions;
+
+    double spread_position_time = std::numeric_limits<double>::quiet_NaN();
+
+    /**
+     * Bounding boxes of the locally owned cells of each part, and how much
+     * each box has been enlarged since it was last computed exactly. Only
+     * used when cell_bbox_reuse_tolerance is positive.
+     */
+    std::vector<std::vector<BoundingBox<spacedim, float>>> cell_bboxes;
+
+    std::vector<std::vector<double>> cell_bbox_inflations;
+
+    std::vector<std::vector<BoundingBox<spacedim, float>>> surface_cell_bboxes;
+
+    std::vector<std::vector<double>> surface_cell_bbox_inflations;
+
+    /**
+     * Position of each part when its interaction objects were last set up.
+     */
+    std::deque<LinearAlgebra::distributed::Vector<double>>
+      positions_at_last_interaction_reinit;
+
+    std::deque<LinearAlgebra::distributed::Vector<double>>
+      surface_positions_at_last_interaction_reinit;
+
+    /**
+     * Displacements of each part and then of each surface part relative to
+     * the positions above, computed by getMaxPointDisplacement(). Empty if
+     * the parts or the positions above may have changed since then.
+     */
+    mutable std::vector<double> interaction_reinit_displacements;
+
+    /**
+     * Number of time steps each part and then each surface part has taken
+     * since its interaction objects were last set up. Used to estimate how
+     * far the parts move in each time step by automatic_ghost_cell_fraction.
+     */
+    std::vector<unsigned int> n_steps_since_interaction_reinit;
+
+    /**
+     * Wall time spent by this processor in the intermediate steps of
+     * interaction of each part since the last workload calibration. Only
+     * measured when calibrate_interaction_workload or workload_diagnostics is
+     * true.
+     */
+    std::vector<double> interaction_times;
+
+    std::vector<double> surface_interaction_times;
+
+    /**
+     * Calibrated cost of a single quadrature point or node of each part. Empty
+     * until the first calibration.
+     */
+    std::vector<double> workload_weights;
+
+    std::vector<double> surface_workload_weights;
+
+    /**
+     * Lagrangian workload assigned to this processor at the last regrid.
+     * Only computed when workload_diagnostics is true.
+     */
+    double local_estimated_workload = 0.0;
+
+    /**
+     * Position of each part when the Lagrangian workload was last computed.
+     */
+    std::deque<LinearAlgebra::distributed::Vector<double>>
+      positions_at_last_workload_count;
+
+    std::deque<LinearAlgebra::distributed::Vector<double>>
+      surface_positions_at_last_workload_count;
     /**
      * @}
      */
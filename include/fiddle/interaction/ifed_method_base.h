@@ -13,6 +13,9 @@
 #include <BasePatchHierarchy.h>
 #include <tbox/Pointer.h>
 
+#include <deque>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace fdl
@@ -45,6 +48,15 @@ namespace fdl
     virtual double
     getMaxPointDisplacement() const override;
 
+    /**
+     * Return, for each part and then for each surface part, the largest
+     * distance (in units of the finest level's grid spacing) that any node
+     * of that part has moved since the last regrid. getMaxPointDisplacement()
+     * is the maximum of these values.
+     */
+    std::vector<double>
+    get_max_point_displacements() const;
+
     /**
      * Tag cells in @p hierarchy that intersect with the structure.
      */
@@ -125,6 +137,12 @@ namespace fdl
     virtual void
     midpointStep(double current_time, double new_time) override;
 
+    /**
+     * Update the positions with the trapezoidal rule, i.e., Heun's method
+     * (the two stage strong stability preserving Runge-Kutta method). Like
+     * midpointStep(), IBAMR calls this after forwardEulerStep() and after
+     * interpolating the velocity at @p new_time.
+     */
     virtual void
     trapezoidalStep(double current_time, double new_time) override;
     /**
@@ -142,6 +160,17 @@ namespace fdl
     virtual void
     putToDatabase(tbox::Pointer<tbox::Database> db) override;
 
+    /**
+     * Write the states of the parts into a single file in @p directory, with
+     * PartCheckpoint, instead of into the restart database. The restart
+     * database then only contains the name of that file. Unlike the default
+     * format, these files can be read with a different number of processors.
+     *
+     * @note @p directory must already exist.
+     */
+    void
+    set_checkpoint_directory(const std::string &directory);
+
     std::size_t
     n_parts() const;
 
@@ -158,6 +187,50 @@ namespace fdl
      */
 
   protected:
+    /**
+     * Same as get_max_point_displacements(), but measure displacements
+     * relative to @p reference_positions and @p surface_reference_positions
+     * instead of the positions at the last regrid.
+     */
+    std::vector<double>
+    compute_max_point_displacements(
+      const std::deque<LinearAlgebra::distributed::Vector<double>>
+        &reference_positions,
+      const std::deque<LinearAlgebra::distributed::Vector<double>>
+        &surface_reference_positions) const;
+
+    /**
+     * Reference positions of every part and of every surface part.
+     */
+    using ReferencePositions = std::pair<
+      const std::deque<LinearAlgebra::distributed::Vector<double>> *,
+      const std::deque<LinearAlgebra::distributed::Vector<double>> *>;
+
+    /**
+     * Same as compute_max_point_displacements(), but for several sets of
+     * reference positions at once: each position vector is only read once
+     * and all displacements are combined in a single reduction. Entry k of
+     * the returned vector corresponds to @p references[k].
+     */
+    std::vector<std::vector<double>>
+    compute_max_point_displacements(
+      const std::vector<ReferencePositions> &references) const;
+
+    /**
+     * Set the position of each part at the new time to
+     * <code>X + a V_1 + b V_2</code> and at the half time to the average of
+     * the current and new positions. Both are computed in one pass over each
+     * position vector. @p get_velocities(part, vectors, i) returns pointers
+     * to V_1 and V_2 of part i.
+     */
+    template <typename GetVelocities>
+    void
+    explicit_step(const double         current_time,
+                  const double         new_time,
+                  const double         a,
+                  const double         b,
+                  const GetVelocities &get_velocities);
+
     /**
      * Book-keeping
      * @{
@@ -166,6 +239,30 @@ namespace fdl
 
     bool register_for_restart;
 
+    /**
+     * Directory into which PartCheckpoint files are written. If empty, parts
+     * are serialized into the restart database instead.
+     */
+    std::string checkpoint_directory;
+
+    /**
+     * Number of checkpoint files written so far.
+     */
+    unsigned int checkpoint_counter;
+
+    /**
+     * Canonical DoF indices (see compute_canonical_dof_indices()) of each part
+     * and surface part. These do not change between checkpoints so they are
+     * computed when the first checkpoint is written.
+     */
+    std::vector<std::vector<
+      std::pair<types::global_dof_index, types::global_dof_index>>>
+      canonical_dofs;
+
+    std::vector<std::vector<
+      std::pair<types::global_dof_index, types::global_dof_index>>>
+      surface_canonical_dofs;
+
     bool started_time_integration;
 
     double current_time;
@@ -3,6 +3,8 @@
 
 #include <fiddle/base/config.h>
 
+#include <fiddle/base/execution_policy.h>
+
 #include <fiddle/grid/overlap_tria.h>
 
 #include <fiddle/transfer/scatter.h>
@@ -19,6 +21,7 @@
 
 #include <tbox/Pointer.h>
 
+#include <cstdint>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -27,6 +30,8 @@ namespace SAMRAI
 {
   namespace hier
   {
+    template <int>
+    class Patch;
     template <int>
     class PatchHierarchy;
   }
@@ -96,12 +101,34 @@ namespace fdl
     /// Overlap-partitioned position.
     Vector<double> overlap_position;
 
+    /**
+     * Versions of the native positions (see
+     * InteractionBase::set_position_version()) when the transaction started:
+     * the first entry corresponds to native_position and the rest to
+     * additional_parts.
+     */
+    std::vector<std::uint64_t> position_versions;
+
+    /**
+     * Whether or not the overlap positions were copied from the cache of the
+     * InteractionBase object, in which case position_scatter does not
+     * communicate them.
+     */
+    bool reuse_overlap_position = false;
+
     /// Native DoFHandler.
     SmartPointer<const DoFHandler<dim, spacedim>> native_dof_handler;
 
     /// The other scatter (used for spreading).
     Scatter<double> solution_scatter;
 
+    /**
+     * Whether or not the solution is scattered along with the position by
+     * position_scatter (which is possible when both use the same DoFHandler),
+     * in which case solution_scatter is not used.
+     */
+    bool batch_solution_scatter = false;
+
     /// The other scatter (used for assembly).
     Scatter<double> rhs_scatter;
 
@@ -124,6 +151,73 @@ namespace fdl
     /// Overlap-partitioned vector used for spreading.
     Vector<double> overlap_solution;
 
+    /**
+     * Data for a field, in addition to the one described by current_data_idx,
+     * native_dof_handler, mapping, and native_rhs, interpolated by the same
+     * transaction. Additional fields share the position data (and its
+     * communication) with the first field.
+     */
+    struct AdditionalField
+    {
+      /// Patch index.
+      int data_idx;
+
+      /// Native DoFHandler.
+      SmartPointer<const DoFHandler<dim, spacedim>> native_dof_handler;
+
+      /// Mapping to use for the provided finite element field.
+      SmartPointer<const Mapping<dim, spacedim>> mapping;
+
+      /// Native-partitioned vector used for assembly.
+      SmartPointer<LinearAlgebra::distributed::Vector<double>> native_rhs;
+
+      /// Scatter used for assembly.
+      Scatter<double> rhs_scatter;
+
+      /// Overlap-partitioned vector used for assembly.
+      Vector<double> overlap_rhs;
+    };
+
+    /// Additional fields - only used for interpolation.
+    std::vector<AdditionalField> additional_fields;
+
+    /**
+     * Data for a part, in addition to the one described by native_position,
+     * native_rhs, and native_solution, handled by the same transaction. All
+     * parts use the same DoFHandlers, Mapping, and IB kernel (e.g., since
+     * they share a PartGeometry) so the global to overlap scatters of every
+     * part are combined: each processor sends one message to each of its
+     * neighbors for all parts.
+     */
+    struct AdditionalPart
+    {
+      /// Native-partitioned position.
+      SmartPointer<const LinearAlgebra::distributed::Vector<double>>
+        native_position;
+
+      /// Overlap-partitioned position.
+      Vector<double> overlap_position;
+
+      /// Native-partitioned vector used for assembly.
+      SmartPointer<LinearAlgebra::distributed::Vector<double>> native_rhs;
+
+      /// Scatter used for assembly.
+      Scatter<double> rhs_scatter;
+
+      /// Overlap-partitioned vector used for assembly.
+      Vector<double> overlap_rhs;
+
+      /// Native-partitioned vector used for spreading.
+      SmartPointer<const LinearAlgebra::distributed::Vector<double>>
+        native_solution;
+
+      /// Overlap-partitioned vector used for spreading.
+      Vector<double> overlap_solution;
+    };
+
+    /// Additional parts.
+    std::vector<AdditionalPart> additional_parts;
+
     /// Possible states for a transaction.
     enum class State
     {
@@ -178,6 +272,12 @@ namespace fdl
     /// Overlap-partitioned position.
     Vector<double> overlap_position;
 
+    /// Version of the native position when the transaction started.
+    std::uint64_t position_version;
+
+    /// Whether or not the overlap position was copied from the cache.
+    bool reuse_overlap_position = false;
+
     /// Possible states for a transaction.
     enum class State
     {
@@ -218,6 +318,18 @@ namespace fdl
    * interpolation and four for spreading. This complexity is handled by
    * IFEDMethod: for the most part, inheriting classes should only need to
    * modify the 'intermediate' functions which do the actual computations.
+   *
+   * All computations are done on the host since IBAMR's patch data is host
+   * resident. The intermediate functions are the only ones which access both
+   * SAMRAI and deal.II data, so they are also the only ones which would need
+   * to change to perform interaction on another device: e.g., by copying each
+   * patch's data to and from that device once per call. At the present time
+   * the way to use more of a node is to set <code>n_threads</code> (see
+   * reinit() and ExecutionPolicy).
+   *
+   * Like the other classes in fiddle, a single object of this class should
+   * not be used concurrently by different threads: see ExecutionPolicy for a
+   * description of fiddle's threading model.
    */
   template <int dim, int spacedim = dim>
   class InteractionBase
@@ -231,12 +343,26 @@ namespace fdl
     /**
      * Constructor. This call is collective.
      *
-     * @param[in] input_db Input database. The only value read from the database
-     *            is ghost_cell_fraction, which controls the fraction of ghost
+     * @param[in] input_db Input database. The values read from the database
+     *            are ghost_cell_fraction, which controls the fraction of ghost
      *            cells added to each patch boundary box for the purposes of
-     *            associating nodes or elements with a given patch. The default
+     *            associating nodes or elements with a given patch (the default
      *            value is 1.0, which is typically the correct value for
-     *            problems with moving meshes.
+     *            problems with moving meshes) and n_threads and
+     *            thread_partitioning, which set up the ExecutionPolicy used
+     *            in the intermediate (i.e., not communication) steps of
+     *            interaction. By default these steps run on a single
+     *            thread. The database may also contain scatter_backend,
+     *            which selects how Scatter objects communicate:
+     *            POINT_TO_POINT (the default), NEIGHBOR_COLLECTIVE, or
+     *            SHARED_MEMORY (see ScatterBackend),
+     *            reduced_precision_scatters, which (if true) communicates
+     *            force and velocity data, but not positions, in single
+     *            precision (see Scatter::set_reduced_precision(); the
+     *            default is false), and workload_weight,
+     *            the cost of a single quadrature point or node used by
+     *            add_workload_intermediate() (the default is 1.0, i.e., the
+     *            workload is a count).
      *
      * @param[in] native_tria The Triangulation used to define the finite
      *            element fields. This class will use the same MPI communicator
@@ -280,16 +406,44 @@ namespace fdl
            tbox::Pointer<hier::PatchHierarchy<spacedim>>    patch_hierarchy,
            const std::pair<int, int>                       &level_number);
 
+    /**
+     * Switch to the patches of @p patch_hierarchy without otherwise
+     * reinitializing the object. This is only valid if the patches on
+     * @p level_numbers have the same boxes, on every processor, as those used
+     * by the last call to reinit(): e.g., after a regrid which only changed
+     * other levels. Since the overlap triangulation, the DoFHandlers, and the
+     * Scatter objects only depend on the boxes they are all kept.
+     *
+     * This call is collective.
+     *
+     * @return true if the object was updated. If some processor's patch boxes
+     * changed then this function does nothing and returns false: the caller
+     * must then call reinit() instead.
+     */
+    virtual bool
+    update_patch_hierarchy(
+      tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy,
+      const std::pair<int, int>                    &level_numbers);
+
     /**
      * Destructor.
      */
     virtual ~InteractionBase();
 
     /**
-     * Store a pointer to @p native_dof_handler and also compute the
-     * equivalent DoFHandler on the overlapping partitioning.
+     * Store a pointer to @p native_dof_handler. The equivalent DoFHandler on
+     * the overlapping partitioning and the translation between their dofs
+     * are set up the first time they are needed after each call to reinit()
+     * (e.g., by the first transaction which uses @p native_dof_handler), so
+     * DoFHandlers which are rarely used do not make reinit() more expensive.
+     * If the corresponding DoFHandler (i.e., the one added in the same order)
+     * before the last call to reinit() has the same overlap dofs on every
+     * processor then its Scatter objects are reused.
      *
-     * This call is collective over the communicator used by this class.
+     * Setting up the overlap data is collective over the communicator used by
+     * this class: hence, like transactions, this function must be called in
+     * the same order on every processor. Inheriting classes may set up the
+     * overlap data immediately.
      */
     virtual void
     add_dof_handler(const DoFHandler<dim, spacedim> &native_dof_handler);
@@ -302,6 +456,45 @@ namespace fdl
     virtual bool
     projection_is_interpolation() const;
 
+    /**
+     * For some interactions, forces are spread directly from the load vector
+     * (i.e., the right-hand side of the force projection) at the nodes. In
+     * that case no mass solve is needed to compute the force. Defaults to
+     * returning false.
+     */
+    virtual bool
+    spreading_is_nodal() const;
+
+    /**
+     * Return whether or not no cells of the native triangulation intersect
+     * the patches on this processor. In that case this processor only
+     * participates in the scatters (since it may still own some dofs) and
+     * does no interaction work.
+     */
+    bool
+    has_empty_overlap() const;
+
+    /**
+     * Set the version of @p position, i.e., a number which changes whenever
+     * the values of @p position change (see, e.g.,
+     * PartVectors::get_position_version()).
+     *
+     * This object caches the overlap representation of every position with a
+     * version. Transactions started with positions whose versions have not
+     * changed since they were last scattered copy the cached overlap
+     * positions and skip their communication: e.g., interpolation, spreading,
+     * and workload calculations at the same time level only scatter the
+     * position once. Positions without a version are always scattered. The
+     * cache is cleared by reinit().
+     *
+     * Since skipping a scatter changes the communication pattern, this
+     * function must be called with the same versions on every processor.
+     */
+    void
+    set_position_version(
+      const LinearAlgebra::distributed::Vector<double> &position,
+      const std::uint64_t                               version);
+
     /**
      * Start the computation of the RHS vector corresponding to projecting @p
      * data_idx onto the finite element space specified by @p dof_handler. Since
@@ -327,6 +520,53 @@ namespace fdl
       const Mapping<dim, spacedim>                     &mapping,
       LinearAlgebra::distributed::Vector<double>       &rhs);
 
+    /**
+     * Like the other compute_projection_rhs_scatter_start(), but set up a
+     * single transaction which computes the RHS vectors of several fields.
+     * The position is only communicated once and inheriting classes may share
+     * work between fields in compute_projection_rhs_intermediate() (e.g.,
+     * ElementalInteraction only computes quadrature points and IB kernel
+     * weights once).
+     *
+     * The ith field is described by <code>data_indices[i]</code>,
+     * <code>dof_handlers[i]</code>, <code>mappings[i]</code>, and
+     * <code>rhs[i]</code>.
+     */
+    std::unique_ptr<TransactionBase>
+    compute_projection_rhs_scatter_start(
+      const std::string                                    &kernel_name,
+      const std::vector<int>                               &data_indices,
+      const DoFHandler<dim, spacedim> &position_dof_handler,
+      const LinearAlgebra::distributed::Vector<double>     &position,
+      const std::vector<const DoFHandler<dim, spacedim> *> &dof_handlers,
+      const std::vector<const Mapping<dim, spacedim> *>    &mappings,
+      const std::vector<LinearAlgebra::distributed::Vector<double> *> &rhs);
+
+    /**
+     * Like the other compute_projection_rhs_scatter_start(), but set up a
+     * single transaction which computes the RHS vectors of several parts
+     * which all use @p position_dof_handler, @p dof_handler, and @p mapping
+     * (e.g., Parts sharing a PartGeometry). The ith part is described by
+     * <code>positions[i]</code> and <code>rhs[i]</code>. The positions of all
+     * parts are scattered together, so each processor sends one message to
+     * each of its neighbors instead of one per part, and all parts share the
+     * overlap triangulation and DoF translations of this object.
+     *
+     * @note Every part must be on the overlap triangulation, so the bounding
+     * boxes given to reinit() should contain the cell bounding boxes of every
+     * part (see IFEDMethod).
+     */
+    std::unique_ptr<TransactionBase>
+    compute_projection_rhs_scatter_start(
+      const std::string               &kernel_name,
+      const int                        data_idx,
+      const DoFHandler<dim, spacedim> &position_dof_handler,
+      const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+                                      &positions,
+      const DoFHandler<dim, spacedim> &dof_handler,
+      const Mapping<dim, spacedim>    &mapping,
+      const std::vector<LinearAlgebra::distributed::Vector<double> *> &rhs);
+
     /**
      * Finish the scatter to the overlap representation for computing the RHS.
      */
@@ -386,6 +626,72 @@ namespace fdl
       const DoFHandler<dim, spacedim>                  &dof_handler,
       const LinearAlgebra::distributed::Vector<double> &solution);
 
+    /**
+     * Like the other compute_spread_scatter_start(), but spread the forces of
+     * several parts which all use @p position_dof_handler, @p dof_handler,
+     * and @p mapping. The ith part is described by <code>positions[i]</code>
+     * and <code>solutions[i]</code>. As in the equivalent
+     * compute_projection_rhs_scatter_start(), the data of all parts is
+     * scattered together.
+     */
+    std::unique_ptr<TransactionBase>
+    compute_spread_scatter_start(
+      const std::string &kernel_name,
+      const int          data_idx,
+      const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+                                      &positions,
+      const DoFHandler<dim, spacedim> &position_dof_handler,
+      const Mapping<dim, spacedim>    &mapping,
+      const DoFHandler<dim, spacedim> &dof_handler,
+      const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+        &solutions);
+
+    /**
+     * Start scattering @p positions to the overlap representation ahead of
+     * spreading. Positions are typically known well before the forces which
+     * are spread (e.g., IFEDMethod starts this scatter before assembling the
+     * forces), so this hides the communication of the positions behind other
+     * work. The returned transaction must be passed to the
+     * compute_spread_scatter_start() overload which takes a transaction or
+     * to cancel_spread_position_scatter().
+     *
+     * @warning The vectors in @p positions must not be modified until the
+     * transaction is finished.
+     */
+    std::unique_ptr<TransactionBase>
+    compute_spread_position_scatter_start(
+      const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+                                      &positions,
+      const DoFHandler<dim, spacedim> &position_dof_handler);
+
+    /**
+     * Like the other compute_spread_scatter_start() functions, but use the
+     * positions scattered by @p position_transaction, which must have been
+     * returned by compute_spread_position_scatter_start(). The ith entry of
+     * @p solutions belongs to the part with the ith position. Only the
+     * solutions are scattered by this function, so the positions and
+     * solutions are not sent together even if they use the same DoFHandler.
+     */
+    std::unique_ptr<TransactionBase>
+    compute_spread_scatter_start(
+      std::unique_ptr<TransactionBase> position_transaction,
+      const std::string               &kernel_name,
+      const int                        data_idx,
+      const Mapping<dim, spacedim>    &mapping,
+      const DoFHandler<dim, spacedim> &dof_handler,
+      const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+        &solutions);
+
+    /**
+     * Finish and discard a position scatter started by
+     * compute_spread_position_scatter_start() which will not be used for
+     * spreading (e.g., since the positions changed). This waits for the
+     * messages of the scatter to arrive.
+     */
+    void
+    cancel_spread_position_scatter(
+      std::unique_ptr<TransactionBase> position_transaction);
+
     /**
      * Finish the scatter to the overlap representation for spreading.
      */
@@ -432,6 +738,58 @@ namespace fdl
     virtual void
     add_workload_finish(std::unique_ptr<TransactionBase> t_ptr);
 
+    /**
+     * Set the cost of a single quadrature point or node used by the next
+     * workload calculation. This is typically calibrated from measured
+     * interaction times - see IFEDMethod.
+     */
+    void
+    set_workload_weight(const double weight);
+
+    /**
+     * Return the cost of a single quadrature point or node.
+     */
+    double
+    get_workload_weight() const;
+
+    /**
+     * Return the unweighted workload (i.e., the number of quadrature points or
+     * nodes) added by the last workload calculation on this processor.
+     */
+    double
+    get_local_unweighted_workload() const;
+
+    /**
+     * Return a constant reference to the overlap triangulation.
+     */
+    const OverlapTriangulation<dim, spacedim> &
+    get_overlap_triangulation() const;
+
+    /**
+     * Return the communication done on this processor by all Scatter objects
+     * of this object (i.e., for every part and field which uses it) since it
+     * was created or since the last call to reset_scatter_statistics(). The
+     * counters of each Scatter are added when its transaction finishes.
+     */
+    const ScatterStatistics &
+    get_scatter_statistics() const;
+
+    /**
+     * Reset the counters returned by get_scatter_statistics() to zero.
+     */
+    void
+    reset_scatter_statistics();
+
+    /**
+     * Return an estimate of the memory used by this object, in bytes. This
+     * includes the overlap triangulation, the overlap DoFHandlers, the DoF
+     * translations, all cached Scatter objects, and the cached overlap
+     * positions. Inheriting classes should add the memory used by their own
+     * data (e.g., patch maps).
+     */
+    virtual std::size_t
+    memory_consumption() const;
+
   protected:
     /**
      * One difficulty with the way communication is implemented in deal.II is
@@ -452,19 +810,31 @@ namespace fdl
 
     /**
      * Return a reference to the overlap dof handler corresponding to the
-     * provided native dof handler.
+     * provided native dof handler. The overlap dof handler is set up, which
+     * is collective, if this is its first use since the last call to
+     * reinit().
      */
     DoFHandler<dim, spacedim> &
     get_overlap_dof_handler(
       const DoFHandler<dim, spacedim> &native_dof_handler);
 
     /**
-     * Return a constant reference to the corresponding overlap dof handler.
+     * Return a constant reference to the corresponding overlap dof handler,
+     * which must already be set up (i.e., by the non-const version of this
+     * function).
      */
     const DoFHandler<dim, spacedim> &
     get_overlap_dof_handler(
       const DoFHandler<dim, spacedim> &native_dof_handler) const;
 
+    /**
+     * Set up the overlap DoFHandler, the DoF translation, and the Scatter
+     * objects (which may be reused from before the last call to reinit()) of
+     * native_dof_handlers[index]. This call is collective.
+     */
+    void
+    setup_overlap_dof_handler(const std::size_t index);
+
     /**
      * Get the RHS scatter back operation when setting up the transactions. For
      * nodal 'projection' (equivalent to interpolation) this is the max
@@ -478,9 +848,13 @@ namespace fdl
 
     /**
      * Return a scatter corresponding to the provided native dof handler.
+     * If @p reduced_precision is true and reduced_precision_scatters is set
+     * then the scatter sends single precision values (see
+     * Scatter::set_reduced_precision()).
      */
     Scatter<double>
-    get_scatter(const DoFHandler<dim, spacedim> &native_dof_handler);
+    get_scatter(const DoFHandler<dim, spacedim> &native_dof_handler,
+                const bool                       reduced_precision = false);
 
     /**
      * Re-cache a Scatter object.
@@ -489,6 +863,104 @@ namespace fdl
     return_scatter(const DoFHandler<dim, spacedim> &native_dof_handler,
                    Scatter<double>                &&scatter);
 
+    /**
+     * Return a zeroed vector with @p size entries for storing overlap data.
+     * Like get_scatter(), this reuses the storage of vectors given back by
+     * return_overlap_vector() when possible, so that repeated interaction
+     * (e.g., once per time step) does not allocate new memory.
+     */
+    Vector<double>
+    get_overlap_vector(const std::size_t size);
+
+    /**
+     * Keep the storage of @p vector for later use by get_overlap_vector().
+     */
+    void
+    return_overlap_vector(Vector<double> &&vector);
+
+    /**
+     * Give back all overlap vectors owned by @p transaction with
+     * return_overlap_vector(). Intended to be called when a transaction is
+     * done.
+     */
+    void
+    return_overlap_vectors(Transaction<dim, spacedim> &transaction);
+
+    /**
+     * Set @p overlap_position to the cached overlap representation of
+     * @p native_position, if it has one which is valid for @p version.
+     *
+     * @return true if the cache was used.
+     */
+    bool
+    find_cached_overlap_position(
+      const DoFHandler<dim, spacedim>                  &native_dof_handler,
+      const LinearAlgebra::distributed::Vector<double> &native_position,
+      const std::uint64_t                               version,
+      Vector<double>                                   &overlap_position) const;
+
+    /**
+     * Store @p overlap_position as the overlap representation of
+     * @p native_position at @p version. Does nothing if @p version is not the
+     * current version of @p native_position (e.g., because it was changed
+     * while it was scattered).
+     */
+    void
+    cache_overlap_position(
+      const DoFHandler<dim, spacedim>                  &native_dof_handler,
+      const LinearAlgebra::distributed::Vector<double> &native_position,
+      const std::uint64_t                               version,
+      const Vector<double>                             &overlap_position) const;
+
+    /**
+     * Return a mapping describing @p overlap_position, the overlap
+     * representation (using the overlap DoFHandler equivalent to
+     * @p native_dof_handler) of @p native_position at @p version.
+     *
+     * Evaluating a MappingFEField on a cell gathers the position DoFs and
+     * evaluates every shape function of the position element at every point,
+     * which is expensive for higher-degree elements. Hence, if the position
+     * element is FE_Q with degree at least two on quadrilaterals or hexahedra
+     * and @p overlap_position is cached (see cache_overlap_position()), this
+     * function instead returns a MappingQCache of the same degree. It
+     * represents exactly the same position, but its support points are
+     * computed once for each version of the position and then shared by every
+     * operation (e.g., interpolation, spreading, and workload estimation)
+     * until the position changes. Otherwise a new MappingFEField is returned.
+     */
+    std::shared_ptr<const Mapping<dim, spacedim>>
+    get_overlap_position_mapping(
+      const DoFHandler<dim, spacedim>                  &native_dof_handler,
+      const LinearAlgebra::distributed::Vector<double> &native_position,
+      const std::uint64_t                               version,
+      const Vector<double>                             &overlap_position) const;
+
+    /**
+     * Return the version of @p position set by set_position_version(), or
+     * the largest value of std::uint64_t (which is never cached) if there is
+     * none.
+     */
+    std::uint64_t
+    get_position_version(
+      const LinearAlgebra::distributed::Vector<double> &position) const;
+
+    /**
+     * Record the versions of the positions of @p transaction and, if all of
+     * them are cached, copy the cached overlap positions and set
+     * Transaction::reuse_overlap_position. Intended to be called by functions
+     * setting up transactions before starting their scatters.
+     */
+    void
+    find_cached_overlap_positions(Transaction<dim, spacedim> &transaction);
+
+    /**
+     * Cache the overlap positions of @p transaction if they were scattered.
+     * Intended to be called after the position scatter finishes.
+     */
+    void
+    cache_overlap_positions(
+      const Transaction<dim, spacedim> &transaction) const;
+
     /**
      * @name Geometric data.
      * @{
@@ -516,6 +988,20 @@ namespace fdl
      */
     std::pair<int, int> level_numbers;
 
+    /**
+     * Bounding boxes, without ghost regions, of the patches on
+     * @p level_numbers at the last call to reinit().
+     */
+    std::vector<BoundingBox<spacedim, float>> patch_bboxes;
+
+    /**
+     * Return the patches of @p hierarchy on @p level_numbers, ordered by
+     * level.
+     */
+    std::vector<tbox::Pointer<hier::Patch<spacedim>>>
+    get_patches(
+      const tbox::Pointer<hier::PatchHierarchy<spacedim>> &hierarchy) const;
+
     /**
      * @}
      */
@@ -534,7 +1020,9 @@ namespace fdl
 
     /**
      * DoFHandlers defined on the overlap tria, which are equivalent to those
-     * stored by @p native_dof_handlers.
+     * stored by @p native_dof_handlers. Entries are nullptr (and the
+     * corresponding translations are empty) until they are set up by
+     * setup_overlap_dof_handler().
      */
     std::vector<std::unique_ptr<DoFHandler<dim, spacedim>>>
       overlap_dof_handlers;
@@ -550,9 +1038,86 @@ namespace fdl
      * representations. Indexed first by the number of the dof handler.
      */
     std::vector<std::vector<Scatter<double>>> scatters;
+
+    /**
+     * Scatter objects from before the last call to reinit(), indexed in the
+     * same way. add_dof_handler() reuses them when the communication pattern
+     * is unchanged on every processor.
+     */
+    std::vector<std::vector<Scatter<double>>> scatter_cache;
+
+    /**
+     * Overlap vectors available for reuse by get_overlap_vector(). These are
+     * kept between calls to reinit() since only their storage is reused.
+     */
+    std::vector<Vector<double>> overlap_vector_pool;
+
+    /**
+     * Overlap representation of a position with a version (see
+     * set_position_version()).
+     */
+    struct CachedOverlapPosition
+    {
+      const LinearAlgebra::distributed::Vector<double> *native_position;
+
+      std::uint64_t version;
+
+      /**
+       * DoFHandler of the cached overlap position, or nullptr if the position
+       * has not been scattered at the present version.
+       */
+      const DoFHandler<dim, spacedim> *native_dof_handler;
+
+      Vector<double> overlap_position;
+
+      /**
+       * Mapping set up from overlap_position by get_overlap_position_mapping(),
+       * if any.
+       */
+      std::shared_ptr<const Mapping<dim, spacedim>> position_mapping;
+    };
+
+    /**
+     * Cached overlap positions. This is modified by functions which finish
+     * scatters, some of which are const, since it does not change the
+     * results of any computation.
+     */
+    mutable std::vector<CachedOverlapPosition> overlap_position_cache;
+
+    /**
+     * Communication backend used by new Scatter objects.
+     */
+    ScatterBackend scatter_backend;
+
+    /**
+     * Whether or not force and velocity data (i.e., everything except
+     * positions) is communicated in single precision.
+     */
+    bool reduced_precision_scatters;
     /**
      * @}
      */
+
+    /**
+     * Threads used by the intermediate steps of interaction.
+     */
+    ExecutionPolicy execution_policy;
+
+    /**
+     * Cost of a single quadrature point or node.
+     */
+    double workload_weight;
+
+    /**
+     * Unweighted workload added by the last workload calculation. Set by
+     * inheriting classes in add_workload_intermediate().
+     */
+    double local_unweighted_workload;
+
+    /**
+     * Communication done by the Scatter objects of finished transactions.
+     */
+    ScatterStatistics scatter_statistics;
   };
 } // namespace fdl
 #endif
@@ -3,11 +3,17 @@
 
 #include <fiddle/base/config.h>
 
+#include <fiddle/base/execution_policy.h>
+
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/bounding_box.h>
+#include <deal.II/base/point.h>
 #include <deal.II/base/quadrature.h>
 
+#include <array>
 #include <memory>
 #include <optional>
+#include <string>
 #include <vector>
 
 // forward declarations
@@ -16,6 +22,8 @@ namespace fdl
   template <int, int>
   class NodalPatchMap;
   template <int, int>
+  class PatchIntersectionMap;
+  template <int, int>
   class PatchMap;
 } // namespace fdl
 
@@ -53,6 +61,156 @@ namespace fdl
   using namespace dealii;
   using namespace SAMRAI;
 
+  /**
+   * Cache of IB kernel stencils and weights, stored per patch. Since the
+   * quadrature points used by compute_projection_rhs() and compute_spread()
+   * are the same when both are called with the same PatchMap, position, and
+   * quadratures, this cache lets the second operation skip kernel
+   * evaluation.
+   *
+   * The cache is presently only used for cell-centered data and
+   * side-centered data with depth one with the kernels implemented natively
+   * by fiddle (see ib_kernels.h). Side-centered data stores two stencils per
+   * point (one cell-centered and one face-centered), so the weights are
+   * recomputed when one cache is used with both kinds of data.
+   */
+  template <int spacedim>
+  struct KernelWeightCache
+  {
+    /**
+     * Prepare the cache for an operation with the given kernel and position.
+     * If either differs from the stored value then all cached data is
+     * invalidated.
+     *
+     * @param[in] position_key A value uniquely identifying the current
+     * position of the structure, e.g., a hash of the position vector.
+     *
+     * @param[in] mixed_precision Whether or not the cache will be used by
+     * operations running in mixed-precision mode (see
+     * compute_projection_rhs()), in which case weights are stored in
+     * float_weights instead of weights. Changing this value also invalidates
+     * all cached data.
+     */
+    void
+    reinit(const std::string &kernel_name,
+           const std::size_t  position_key,
+           const std::size_t  n_patches,
+           const bool         mixed_precision = false);
+
+    /**
+     * Invalidate all cached data.
+     */
+    void
+    clear();
+
+    /**
+     * Return an estimate of the memory used by this object, in bytes.
+     */
+    std::size_t
+    memory_consumption() const;
+
+    std::string kernel_name;
+
+    std::size_t position_key = 0;
+
+    bool mixed_precision = false;
+
+    /**
+     * Whether or not the stencils and weights for each patch are current.
+     * This is not a std::vector<bool> since different threads may update the
+     * entries of different patches concurrently.
+     */
+    std::vector<unsigned char> is_current;
+
+    std::vector<std::vector<std::array<int, spacedim>>> stencil_lower;
+
+    std::vector<std::vector<double>> weights;
+
+    std::vector<std::vector<float>> float_weights;
+  };
+
+  /**
+   * Cache of the quadrature points, in the current configuration, of the cells
+   * associated with each patch of a PatchMap. Computing quadrature points
+   * requires evaluating the position mapping (typically a MappingFEField),
+   * which is expensive. Since count_quadrature_points(),
+   * compute_projection_rhs(), and compute_spread() all use the same points
+   * when called with the same PatchMap, position, and quadratures, this cache
+   * lets every operation after the first skip that work.
+   *
+   * Points are stored in the order in which PatchMap iterates over the cells
+   * of each patch.
+   *
+   * Points outside the physical domain (i.e., past a non-periodic boundary
+   * touched by their patch) are in no patch box, so they are neither
+   * interpolated nor spread. The cache classifies them once per position so
+   * that every operation can skip them without evaluating the kernel there.
+   */
+  template <int spacedim>
+  struct QuadraturePointCache
+  {
+    /**
+     * Prepare the cache for an operation at the given position. If it differs
+     * from the stored position then all cached data is invalidated.
+     *
+     * @param[in] position_key A value uniquely identifying the current
+     * position of the structure, e.g., a hash of the position vector.
+     */
+    void
+    reinit(const std::size_t position_key, const std::size_t n_patches);
+
+    /**
+     * Invalidate all cached data.
+     */
+    void
+    clear();
+
+    /**
+     * Return an estimate of the memory used by this object, in bytes.
+     */
+    std::size_t
+    memory_consumption() const;
+
+    /**
+     * Return the number of cached points, summed over all patches, which lie
+     * outside the physical domain.
+     */
+    std::size_t
+    n_exterior_points() const;
+
+    std::size_t position_key = 0;
+
+    /**
+     * Whether or not the quadrature points of each patch are current. Like
+     * KernelWeightCache::is_current, this is not a std::vector<bool>.
+     */
+    std::vector<unsigned char> is_current;
+
+    /**
+     * Quadrature points of all cells on each patch.
+     */
+    std::vector<std::vector<Point<spacedim>>> q_points;
+
+    /**
+     * For each patch, the index into q_points of the first quadrature point of
+     * each cell followed by the total number of quadrature points.
+     */
+    std::vector<std::vector<std::size_t>> cell_q_point_offsets;
+
+    /**
+     * For each patch, whether or not each quadrature point lies outside the
+     * physical domain. Empty if no point on the patch does.
+     */
+    std::vector<std::vector<unsigned char>> is_exterior;
+
+    /**
+     * For each patch with at least one exterior point, the quadrature points
+     * which are not exterior (in the same order as q_points). Empty
+     * otherwise.
+     */
+    std::vector<std::vector<Point<spacedim>>> interior_q_points;
+  };
+
   /**
    * Tag cells in the patch hierarchy that intersect the provided bounding
    * boxes.
@@ -85,16 +243,53 @@ namespace fdl
    *
    * @param[in] quadratures The vector of quadratures we use for interaction.
    *
+   * @param[inout] quadrature_point_cache Optional cache of quadrature points.
+   * If provided, the caller should have already called
+   * QuadraturePointCache::reinit().
+   *
+   * @param[in] weight Cost of a single quadrature point: each point adds this
+   * value, rather than one, to its cell. Weights other than one require
+   * float or double data.
+   *
+   * @return The unweighted number of quadrature points added on this
+   * processor.
+   *
    * @note This is a purely local operation since we always assume a PatchMap
    * stores every element that intersects with the interior of a patch.
    */
   template <int dim, int spacedim = dim>
-  void
-  count_quadrature_points(const int                         qp_data_index,
-                          PatchMap<dim, spacedim>          &patch_map,
-                          const Mapping<dim, spacedim>     &position_mapping,
-                          const std::vector<unsigned char> &quadrature_indices,
-                          const std::vector<Quadrature<dim>> &quadratures);
+  double
+  count_quadrature_points(
+    const int                           qp_data_index,
+    PatchMap<dim, spacedim>            &patch_map,
+    const Mapping<dim, spacedim>       &position_mapping,
+    const std::vector<unsigned char>   &quadrature_indices,
+    const std::vector<Quadrature<dim>> &quadratures,
+    QuadraturePointCache<spacedim>     *quadrature_point_cache = nullptr,
+    const double                        weight                 = 1.0);
+
+  /**
+   * Add an estimate of the number of quadrature points. This is a cheaper
+   * alternative to count_quadrature_points() intended for load balancing:
+   * rather than mapping each quadrature point, the quadrature points of each
+   * element are distributed evenly over the Eulerian cells intersecting the
+   * bounding box of that element's vertices. Hence the sum of the estimate
+   * over all cells is still the total number of quadrature points (for
+   * integral data the remainder is assigned to the first cells, in
+   * lexicographic order, of the bounding box).
+   *
+   * The parameters and return value have the same meaning as in
+   * count_quadrature_points().
+   */
+  template <int dim, int spacedim = dim>
+  double
+  estimate_quadrature_points(
+    const int                           qp_data_index,
+    PatchMap<dim, spacedim>            &patch_map,
+    const Mapping<dim, spacedim>       &position_mapping,
+    const std::vector<unsigned char>   &quadrature_indices,
+    const std::vector<Quadrature<dim>> &quadratures,
+    const double                        weight = 1.0);
 
   /**
    * Count the number of nodes in each patch.
@@ -105,12 +300,17 @@ namespace fdl
    * @param[in] nodal_patch_map Mapping between patches and DoFs.
    *
    * @param[in] position Nodal coordinates in node-first ordering.
+   *
+   * @param[in] weight Cost of a single node, as in count_quadrature_points().
+   *
+   * @return The unweighted number of nodes added on this processor.
    */
   template <int dim, int spacedim>
-  void
+  double
   count_nodes(const int                     node_count_data_index,
               NodalPatchMap<dim, spacedim> &nodal_patch_map,
-              const Vector<double>         &position);
+              const Vector<double>         &position,
+              const double                  weight = 1.0);
 
   /**
    * Compute the right-hand side used to project the velocity from Eulerian to
@@ -140,6 +340,27 @@ namespace fdl
    *
    * @param[out] rhs The load vector populated by this operation.
    *
+   * @param[inout] kernel_weight_cache Optional cache of kernel weights. If
+   * provided, the caller should have already called
+   * KernelWeightCache::reinit().
+   *
+   * @param[in] execution_policy Threads to use - see compute_spread(). Since
+   * cells may be shared between patches, each patch's contributions to
+   * @p rhs are staged and then added in the same order as they would be with
+   * one thread.
+   *
+   * @param[in] mixed_precision If true, compute IB kernel weights and the
+   * innermost sums over the kernel stencil in single precision. The
+   * accumulation into @p rhs is still done in double precision. This halves
+   * the size of the kernel weights and doubles the SIMD width used when
+   * evaluating kernels, at the cost of a relative error of about 1e-6 in
+   * interpolated values. Like threading, this is only presently used for
+   * cell-centered data with kernels implemented by fiddle.
+   *
+   * @param[inout] quadrature_point_cache Optional cache of quadrature points.
+   * If provided, the caller should have already called
+   * QuadraturePointCache::reinit().
+   *
    * @note In general, an OverlappingTriangulation has no knowledge of whether
    * or not DoFs on its boundaries should be constrained. Hence information must
    * first be communicated between processes and then constraints should be
@@ -147,15 +368,55 @@ namespace fdl
    */
   template <int dim, int spacedim = dim>
   void
-  compute_projection_rhs(const std::string                  &kernel_name,
-                         const int                           data_index,
-                         const PatchMap<dim, spacedim>      &patch_map,
-                         const Mapping<dim, spacedim>       &position_mapping,
-                         const std::vector<unsigned char>   &quadrature_indices,
-                         const std::vector<Quadrature<dim>> &quadratures,
-                         const DoFHandler<dim, spacedim>    &dof_handler,
-                         const Mapping<dim, spacedim>       &mapping,
-                         Vector<double>                     &rhs);
+  compute_projection_rhs(
+    const std::string                  &kernel_name,
+    const int                           data_index,
+    const PatchMap<dim, spacedim>      &patch_map,
+    const Mapping<dim, spacedim>       &position_mapping,
+    const std::vector<unsigned char>   &quadrature_indices,
+    const std::vector<Quadrature<dim>> &quadratures,
+    const DoFHandler<dim, spacedim>    &dof_handler,
+    const Mapping<dim, spacedim>       &mapping,
+    Vector<double>                     &rhs,
+    KernelWeightCache<spacedim>        *kernel_weight_cache    = nullptr,
+    const ExecutionPolicy              &execution_policy       = {},
+    const bool                          mixed_precision        = false,
+    QuadraturePointCache<spacedim>     *quadrature_point_cache = nullptr);
+
+  /**
+   * Compute the right-hand sides of several projections at once. This is
+   * equivalent to calling compute_projection_rhs() once for each entry of
+   * @p data_indices but the work which only depends on the position of the
+   * structure (computing quadrature points and, for cell-centered data, IB
+   * kernel weights) is only done once per patch. All DoFHandlers must be
+   * defined on the same Triangulation.
+   *
+   * @param[in] data_indices The SAMRAI patch data indices to interpolate.
+   *
+   * @param[in] dof_handlers DoFHandlers, one per data index.
+   *
+   * @param[in] mappings Mappings, one per data index.
+   *
+   * @param[out] rhs Load vectors, one per data index.
+   *
+   * The remaining arguments are the same as those of compute_projection_rhs().
+   */
+  template <int dim, int spacedim = dim>
+  void
+  compute_projection_rhs(
+    const std::string                                    &kernel_name,
+    const std::vector<int>                               &data_indices,
+    const PatchMap<dim, spacedim>                        &patch_map,
+    const Mapping<dim, spacedim>                         &position_mapping,
+    const std::vector<unsigned char>                     &quadrature_indices,
+    const std::vector<Quadrature<dim>>                   &quadratures,
+    const std::vector<const DoFHandler<dim, spacedim> *> &dof_handlers,
+    const std::vector<const Mapping<dim, spacedim> *>    &mappings,
+    const std::vector<Vector<double> *>                  &rhs,
+    KernelWeightCache<spacedim>    *kernel_weight_cache    = nullptr,
+    const ExecutionPolicy          &execution_policy       = {},
+    const bool                      mixed_precision        = false,
+    QuadraturePointCache<spacedim> *quadrature_point_cache = nullptr);
 
   /**
    * Interpolate Eulerian data at specified Lagrangian points.
@@ -174,6 +435,15 @@ namespace fdl
    *
    * @param[out] interpolated_values Vector of values interpolated at each node.
    *
+   * @param[in] execution_policy Threads to use - see compute_spread(). Since
+   * each node is only interpolated on one patch, the nodes are split into
+   * chunks of roughly equal size (which may divide the nodes of a single
+   * patch between several threads).
+   *
+   * If several nodes coincide (see NodalPatchMap::has_coincident_nodes()) then
+   * the kernel is only evaluated once at each point and the values are copied
+   * to every node at that point.
+   *
    * @note While this function does not directly use any finite element data
    * structures (such as a DoFHandler or FiniteElement), it does assume that we
    * use a FE-like numbering of the DoFs: i.e., each component of the position
@@ -186,7 +456,8 @@ namespace fdl
                               const int                           data_index,
                               const NodalPatchMap<dim, spacedim> &patch_map,
                               const Vector<double>               &position,
-                              Vector<double> &interpolated_values);
+                              Vector<double>        &interpolated_values,
+                              const ExecutionPolicy &execution_policy = {});
 
   /**
    * Compute (by adding into the patch index @p data_index) the forces on the
@@ -217,18 +488,55 @@ namespace fdl
    * field on the reference configuration.
    *
    * @param[in] solution The finite element field we are spreading from.
+   *
+   * @param[inout] kernel_weight_cache Optional cache of kernel weights. If
+   * provided, the caller should have already called
+   * KernelWeightCache::reinit().
+   *
+   * @param[in] execution_policy Threads to use. Ranges of patches (see
+   * ExecutionPolicy::apply_to_ranges()) are distributed among threads so
+   * that each patch is only modified by one thread, so the result does not
+   * depend on the number of threads. At the
+   * present time threads are only used for cell-centered data with kernels
+   * implemented by fiddle (see ib_kernels.h). The number of threads is also
+   * limited by MultithreadInfo::n_threads().
+   *
+   * @param[in] mixed_precision If true, compute IB kernel weights in single
+   * precision. Values are still accumulated into the patch data in double
+   * precision - see compute_projection_rhs().
+   *
+   * @param[inout] quadrature_point_cache Optional cache of quadrature points.
+   * If provided, the caller should have already called
+   * QuadraturePointCache::reinit().
+   *
+   * @param[in] skip_zero_cells If true, cells whose DoF values in @p solution
+   * are all zero are skipped: their values are not evaluated and, unless @p
+   * kernel_weight_cache is provided (whose weights correspond to every
+   * point on a patch), their points are not spread. Patches on which every
+   * cell is skipped are not touched at all. This is useful for forces which
+   * are only nonzero on a small part of the structure (e.g., tethers on
+   * nodesets or boundary forces).
+   *
+   * @return The number of skipped cells (always zero when @p skip_zero_cells
+   * is false).
    */
   template <int dim, int spacedim>
-  void
-  compute_spread(const std::string                  &kernel_name,
-                 const int                           data_index,
-                 PatchMap<dim, spacedim>            &patch_map,
-                 const Mapping<dim, spacedim>       &position_mapping,
-                 const std::vector<unsigned char>   &quadrature_indices,
-                 const std::vector<Quadrature<dim>> &quadratures,
-                 const DoFHandler<dim, spacedim>    &dof_handler,
-                 const Mapping<dim, spacedim>       &mapping,
-                 const Vector<double>               &solution);
+  std::size_t
+  compute_spread(
+    const std::string                  &kernel_name,
+    const int                           data_index,
+    PatchMap<dim, spacedim>            &patch_map,
+    const Mapping<dim, spacedim>       &position_mapping,
+    const std::vector<unsigned char>   &quadrature_indices,
+    const std::vector<Quadrature<dim>> &quadratures,
+    const DoFHandler<dim, spacedim>    &dof_handler,
+    const Mapping<dim, spacedim>       &mapping,
+    const Vector<double>               &solution,
+    KernelWeightCache<spacedim>        *kernel_weight_cache    = nullptr,
+    const ExecutionPolicy              &execution_policy       = {},
+    const bool                          mixed_precision        = false,
+    QuadraturePointCache<spacedim>     *quadrature_point_cache = nullptr,
+    const bool                          skip_zero_cells        = false);
 
   /**
    * Spread Lagrangian data at specified Lagrangian points.
@@ -247,6 +555,13 @@ namespace fdl
    *
    * @param[in] spread_values Vector of values we spread.
    *
+   * @param[in] execution_policy Threads to use - see compute_spread().
+   * Patches with more nodes are started first to balance the work between
+   * threads.
+   *
+   * If several nodes coincide (see NodalPatchMap::has_coincident_nodes()) then
+   * their values are summed and spread once at each point.
+   *
    * @note While this function does not directly use any finite element data
    * structures (such as a DoFHandler or FiniteElement), it does assume that we
    * use a FE-like numbering of the DoFs: i.e., each component of the position
@@ -259,7 +574,75 @@ namespace fdl
                        const int                     data_index,
                        NodalPatchMap<dim, spacedim> &patch_map,
                        const Vector<double>         &position,
-                       const Vector<double>         &spread_values);
+                       const Vector<double>         &spread_values,
+                       const ExecutionPolicy        &execution_policy = {});
+
+  /**
+   * Compute the right-hand side used to project Eulerian data onto a
+   * codimension one finite element space by evaluating the Eulerian field at
+   * the points where finite difference stencils intersect the structure (see
+   * PatchIntersectionMap) instead of by IB kernel interpolation. The
+   * Eulerian value at each intersection is the linear interpolant between the
+   * two cells of the stencil, so the only Eulerian values used are those of
+   * the cells adjacent to the surface.
+   *
+   * Each intersection is a quadrature point whose weight is computed by
+   * internal::locate_intersection(). These weights approximate surface
+   * integrals in the current (i.e., displaced by @p position_mapping)
+   * configuration.
+   *
+   * @param[in] data_index The SAMRAI patch data index we are interpolating.
+   * Only cell-centered data is presently supported. The ghost regions must
+   * have width at least one and be up to date.
+   *
+   * @param[in] intersection_map The intersections, computed with
+   * @p position_dof_handler and @p position_mapping.
+   *
+   * @param[in] dof_handler DoFHandler for the finite element space we are
+   * projecting onto.
+   *
+   * @param[in] mapping Mapping used to evaluate shape functions of
+   * @p dof_handler.
+   *
+   * @param[out] rhs The load vector. Like compute_projection_rhs(), values
+   * are added into this vector and no constraints are applied.
+   */
+  template <int dim, int spacedim>
+  void
+  compute_intersection_projection_rhs(
+    const int                                  data_index,
+    const PatchIntersectionMap<dim, spacedim> &intersection_map,
+    const DoFHandler<dim, spacedim>           &position_dof_handler,
+    const Mapping<dim, spacedim>              &position_mapping,
+    const DoFHandler<dim, spacedim>           &dof_handler,
+    const Mapping<dim, spacedim>              &mapping,
+    Vector<double>                            &rhs);
+
+  /**
+   * Spread a codimension one finite element field to the Eulerian grid at
+   * the points where finite difference stencils intersect the structure. This
+   * is the adjoint of compute_intersection_projection_rhs(): the value at
+   * each intersection, times its quadrature weight divided by the volume of
+   * an Eulerian cell, is divided between the two cells of the stencil with
+   * the convex combination coefficient.
+   *
+   * Values are added into the patch data. Since the upper cell of a stencil
+   * may be a ghost cell the caller is responsible for accumulating values
+   * spread into ghost regions, just like compute_spread().
+   *
+   * The arguments are the same as those of
+   * compute_intersection_projection_rhs().
+   */
+  template <int dim, int spacedim>
+  void
+  compute_intersection_spread(
+    const int                                  data_index,
+    const PatchIntersectionMap<dim, spacedim> &intersection_map,
+    const DoFHandler<dim, spacedim>           &position_dof_handler,
+    const Mapping<dim, spacedim>              &position_mapping,
+    const DoFHandler<dim, spacedim>           &dof_handler,
+    const Mapping<dim, spacedim>              &mapping,
+    const Vector<double>                      &solution);
 
   /**
    * Compute intersection the point of a line with an edge.
@@ -364,5 +747,165 @@ namespace fdl
     const double                                        &stencil_width,
     const unsigned int                                   stencil_axis);
 
+  /**
+   * Batched version of intersect_stencil_with_simplex(): intersect many
+   * stencils, all with the same width and axis, with one simplex.
+   *
+   * The stencil starts are given in structure-of-arrays format, i.e.,
+   * <code>stencil_starts[d][i]</code> is coordinate @p d of the start of
+   * stencil @p i. Lines are processed VectorizedArray<double>::size() at a
+   * time and quantities which only depend on the simplex (e.g., the edges and
+   * the determinant in the Moller-Trumbore algorithm) are only computed once.
+   *
+   * @param[out] hits On output, <code>hits[i]</code> is 1 if stencil @p i
+   * intersects the simplex and 0 otherwise.
+   *
+   * @param[out] convex_coefs On output, the convex combination coefficient of
+   * each intersection, or zero for stencils which do not intersect the
+   * simplex.
+   *
+   * Up to roundoff, the results are the same as calling
+   * intersect_stencil_with_simplex() for each stencil.
+   */
+  template <int spacedim>
+  void
+  intersect_stencils_with_simplex(
+    const std::array<Point<spacedim + 1>, spacedim + 1>     &simplex,
+    const std::array<ArrayView<const double>, spacedim + 1> &stencil_starts,
+    const double                                            &stencil_width,
+    const unsigned int                                       stencil_axis,
+    std::vector<unsigned char>                              &hits,
+    std::vector<double>                                     &convex_coefs);
+
+
+  // --------------------------- inline functions --------------------------- //
+
+
+  template <int spacedim>
+  inline void
+  KernelWeightCache<spacedim>::reinit(const std::string &new_kernel_name,
+                                      const std::size_t  new_position_key,
+                                      const std::size_t  n_patches,
+                                      const bool         new_mixed_precision)
+  {
+    if (new_kernel_name != kernel_name || new_position_key != position_key ||
+        n_patches != is_current.size() ||
+        new_mixed_precision != mixed_precision)
+      {
+        clear();
+        kernel_name     = new_kernel_name;
+        position_key    = new_position_key;
+        mixed_precision = new_mixed_precision;
+        is_current.resize(n_patches, false);
+        stencil_lower.resize(n_patches);
+        if (mixed_precision)
+          float_weights.resize(n_patches);
+        else
+          weights.resize(n_patches);
+      }
+  }
+
+
+
+  template <int spacedim>
+  inline void
+  KernelWeightCache<spacedim>::clear()
+  {
+    kernel_name.clear();
+    position_key    = 0;
+    mixed_precision = false;
+    is_current.clear();
+    stencil_lower.clear();
+    weights.clear();
+    float_weights.clear();
+  }
+
+
+
+  template <int spacedim>
+  inline std::size_t
+  KernelWeightCache<spacedim>::memory_consumption() const
+  {
+    std::size_t result = is_current.capacity() +
+                         stencil_lower.capacity() * sizeof(stencil_lower[0]) +
+                         weights.capacity() * sizeof(weights[0]) +
+                         float_weights.capacity() * sizeof(float_weights[0]);
+    for (const auto &patch_stencil_lower : stencil_lower)
+      result +=
+        patch_stencil_lower.capacity() * sizeof(std::array<int, spacedim>);
+    for (const auto &patch_weights : weights)
+      result += patch_weights.capacity() * sizeof(double);
+    for (const auto &patch_weights : float_weights)
+      result += patch_weights.capacity() * sizeof(float);
+    return result;
+  }
+
+
+
+  template <int spacedim>
+  inline void
+  QuadraturePointCache<spacedim>::reinit(const std::size_t new_position_key,
+                                         const std::size_t n_patches)
+  {
+    if (new_position_key != position_key || n_patches != is_current.size())
+      {
+        clear();
+        position_key = new_position_key;
+        is_current.resize(n_patches, false);
+        q_points.resize(n_patches);
+        cell_q_point_offsets.resize(n_patches);
+        is_exterior.resize(n_patches);
+        interior_q_points.resize(n_patches);
+      }
+  }
+
+
+
+  template <int spacedim>
+  inline void
+  QuadraturePointCache<spacedim>::clear()
+  {
+    position_key = 0;
+    is_current.clear();
+    q_points.clear();
+    cell_q_point_offsets.clear();
+    is_exterior.clear();
+    interior_q_points.clear();
+  }
+
+
+
+  template <int spacedim>
+  inline std::size_t
+  QuadraturePointCache<spacedim>::memory_consumption() const
+  {
+    std::size_t result =
+      is_current.capacity() + q_points.capacity() * sizeof(q_points[0]) +
+      cell_q_point_offsets.capacity() * sizeof(cell_q_point_offsets[0]) +
+      is_exterior.capacity() * sizeof(is_exterior[0]) +
+      interior_q_points.capacity() * sizeof(interior_q_points[0]);
+    for (const auto &patch_q_points : q_points)
+      result += patch_q_points.capacity() * sizeof(Point<spacedim>);
+    for (const auto &patch_offsets : cell_q_point_offsets)
+      result += patch_offsets.capacity() * sizeof(std::size_t);
+    for (const auto &patch_is_exterior : is_exterior)
+      result += patch_is_exterior.capacity();
+    for (const auto &patch_q_points : interior_q_points)
+      result += patch_q_points.capacity() * sizeof(Point<spacedim>);
+    return result;
+  }
+
+
+
+  template <int spacedim>
+  inline std::size_t
+  QuadraturePointCache<spacedim>::n_exterior_points() const
+  {
+    std::size_t result = 0;
+    for (std::size_t patch_n = 0; patch_n < is_exterior.size(); ++patch_n)
+      if (is_current[patch_n] && is_exterior[patch_n].size() > 0)
+        result += q_points[patch_n].size() - interior_q_points[patch_n].size();
+    return result;
+  }
 } // namespace fdl
 #endif
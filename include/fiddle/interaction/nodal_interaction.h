@@ -99,6 +99,39 @@ namespace fdl
            const DoFHandler<dim, spacedim> &position_dof_handler,
            const LinearAlgebra::distributed::Vector<double> &position);
 
+    /**
+     * Update the object after the nodes moved to @p position without
+     * changing the topology of the native triangulation (i.e., only its
+     * vertices moved). @p active_cell_bboxes are the new cell bounding boxes.
+     *
+     * If the same native cells intersect the patches of each processor as
+     * before, then the overlap triangulation, the DoFHandlers, and the
+     * Scatter objects are all kept and only the assignment of nodes to
+     * patches is updated with NodalPatchMap::update(), which only checks the
+     * nodes which moved. This is much cheaper than reinit().
+     *
+     * This call is collective.
+     *
+     * @return true if the object was updated. If some processor's overlap
+     * triangulation would change, or the patch hierarchy was regridded since
+     * the last call to reinit(), this function does nothing and returns
+     * false: the caller must then call reinit() instead.
+     */
+    bool
+    update_position(
+      const std::vector<BoundingBox<spacedim, float>>  &active_cell_bboxes,
+      const DoFHandler<dim, spacedim>                  &position_dof_handler,
+      const LinearAlgebra::distributed::Vector<double> &position);
+
+    /**
+     * Same as InteractionBase::update_patch_hierarchy(), but also switches
+     * the NodalPatchMaps to the new patches.
+     */
+    virtual bool
+    update_patch_hierarchy(
+      tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy,
+      const std::pair<int, int>                    &level_numbers) override;
+
     /**
      * Same as base class but also sets up some necessary internal data
      * structures used by this class
@@ -113,6 +146,12 @@ namespace fdl
     virtual bool
     projection_is_interpolation() const override;
 
+    /**
+     * Forces are spread from the nodes, so this always returns true.
+     */
+    virtual bool
+    spreading_is_nodal() const override;
+
     /**
      * Do the actual work associated with nodal interpolation by, if necessary,
      * computing nodes and then calling compute_nodal_interpolation().
@@ -156,6 +195,15 @@ namespace fdl
     virtual std::unique_ptr<TransactionBase>
     add_workload_intermediate(std::unique_ptr<TransactionBase> t_ptr) override;
 
+    /**
+     * Return an estimate of the memory used by this object, in bytes. In
+     * addition to the data stored by InteractionBase this includes the
+     * overlap position, the patch bounding boxes, and the NodalPatchMap
+     * objects.
+     */
+    virtual std::size_t
+    memory_consumption() const override;
+
   protected:
     virtual VectorOperation::values
     get_rhs_scatter_type() const override;
@@ -176,6 +224,11 @@ namespace fdl
      */
     Vector<double> overlap_position;
 
+    /**
+     * Fraction of a cell by which each patch box is extended.
+     */
+    double ghost_cell_fraction;
+
     /**
      * Patches used for interaction.
      */
@@ -0,0 +1,166 @@
+#ifndef included_fiddle_interaction_transaction_scheduler_h
+#define included_fiddle_interaction_transaction_scheduler_h
+
+#include <fiddle/base/config.h>
+
+#include <fiddle/interaction/interaction_base.h>
+
+#include <mpi.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace fdl
+{
+  /**
+   * Class which runs the remaining steps of several transactions
+   * concurrently, so that the computations of each transaction overlap with
+   * the communication of the others.
+   *
+   * Each InteractionBase operation (e.g., computing a projection right-hand
+   * side) is split into a sequence of steps, where each step takes ownership
+   * of a transaction and returns it. Between steps a transaction may be
+   * waiting on MPI requests. Instead of calling each step by hand, an
+   * application can start several operations, give the resulting
+   * transactions to this class, and call run(). This class then runs a
+   * transaction's next step as soon as all of the MPI requests it is waiting
+   * on (see TransactionBase::delegate_outstanding_requests()) complete, which
+   * is the same strategy IFEDMethod uses to overlap communication between
+   * parts:
+   *
+   * @code
+   * TransactionScheduler scheduler;
+   * auto t1 = interaction_1.compute_projection_rhs_scatter_start(...);
+   * scheduler.add_projection_rhs(interaction_1, std::move(t1));
+   * auto t2 = interaction_2.compute_spread_scatter_start(...);
+   * scheduler.add_spread(interaction_2, std::move(t2));
+   * scheduler.run();
+   * @endcode
+   *
+   * Arbitrary sequences of steps (e.g., ones which also do some other work
+   * after a transaction's data arrives) can be set up with add().
+   *
+   * Steps are run in the order in which communication finishes, which may
+   * differ between processors and between runs. Hence:
+   * <ul>
+   *   <li>Pending transactions must use different interaction objects, since
+   *     each interaction object communicates over a single communicator and
+   *     messages of different transactions would otherwise be mixed.</li>
+   *   <li>Transactions which add into the same data (e.g., spreading into the
+   *     same patch index) may produce results which differ between runs by
+   *     roundoff.</li>
+   * </ul>
+   * All steps are run on the calling thread, which must be the main thread
+   * (see ExecutionPolicy).
+   *
+   * This class is the C++17 equivalent of writing each operation as a
+   * coroutine: each step is one resumption of the coroutine and run() is the
+   * event loop.
+   */
+  class TransactionScheduler
+  {
+  public:
+    /**
+     * A single step of an operation. If this is the last step then the
+     * returned pointer should be null.
+     */
+    using Step = std::function<std::unique_ptr<TransactionBase>(
+      std::unique_ptr<TransactionBase>)>;
+
+    /**
+     * Add a transaction and the steps which remain to be run on it. The steps
+     * are run in order once run() is called.
+     */
+    void
+    add(std::unique_ptr<TransactionBase> transaction, std::vector<Step> steps);
+
+    /**
+     * Same as add(), but also check that no pending transaction was added
+     * with the same @p owner (e.g., interaction object).
+     */
+    void
+    add(const void                      *owner,
+        std::unique_ptr<TransactionBase> transaction,
+        std::vector<Step>                steps);
+
+    /**
+     * Add a transaction created by
+     * InteractionBase::compute_projection_rhs_scatter_start(). The remaining
+     * steps, up to and including
+     * InteractionBase::compute_projection_rhs_accumulate_finish(), are run by
+     * run(). @p interaction must not be destroyed before then and must not
+     * be used by another pending transaction.
+     */
+    template <int dim, int spacedim>
+    void
+    add_projection_rhs(InteractionBase<dim, spacedim>  &interaction,
+                       std::unique_ptr<TransactionBase> transaction);
+
+    /**
+     * Same as add_projection_rhs(), but for a transaction created by
+     * InteractionBase::compute_spread_scatter_start().
+     */
+    template <int dim, int spacedim>
+    void
+    add_spread(InteractionBase<dim, spacedim>  &interaction,
+               std::unique_ptr<TransactionBase> transaction);
+
+    /**
+     * Same as add_projection_rhs(), but for a transaction created by
+     * InteractionBase::add_workload_start().
+     */
+    template <int dim, int spacedim>
+    void
+    add_workload(InteractionBase<dim, spacedim>  &interaction,
+                 std::unique_ptr<TransactionBase> transaction);
+
+    /**
+     * Run all remaining steps of every transaction. This call is collective
+     * over the communicators used by the transactions' interaction objects.
+     */
+    void
+    run();
+
+    /**
+     * Return the number of transactions which have not yet finished.
+     */
+    std::size_t
+    n_pending_transactions() const;
+
+  protected:
+    struct Task
+    {
+      /**
+       * Object which created the transaction, if known.
+       */
+      const void *owner = nullptr;
+
+      std::unique_ptr<TransactionBase> transaction;
+
+      std::vector<Step> steps;
+
+      /**
+       * Index of the next step to run.
+       */
+      std::size_t next_step = 0;
+
+      /**
+       * Requests which must complete before the next step is run. Completed
+       * requests are set to MPI_REQUEST_NULL.
+       */
+      std::vector<MPI_Request> requests;
+    };
+
+    /**
+     * Run steps of @p task until it either finishes or is waiting on
+     * communication.
+     */
+    void
+    advance(Task &task);
+
+    std::vector<Task> tasks;
+  };
+} // namespace fdl
+
+#endif
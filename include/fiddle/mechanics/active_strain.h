@@ -7,6 +7,7 @@
 
 #include <deal.II/base/array_view.h>
 #include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
 
 #include <deal.II/grid/tria.h>
 
@@ -84,6 +85,53 @@ namespace fdl
       const ArrayView<Tensor<2, spacedim, Number>> &push_forward_stress,
       ArrayView<Tensor<2, spacedim, Number>>       &stress) const = 0;
 
+    /**
+     * Whether or not this active strain implements
+     * push_vectorized_deformation_gradient_forward() and
+     * pull_vectorized_stress_back(). Defaults to false.
+     */
+    virtual bool
+    supports_vectorized_strain() const
+    {
+      return false;
+    }
+
+    /**
+     * Vectorized version of push_deformation_gradient_forward(). Each entry
+     * of @p FF and @p push_forward_FF contains VectorizedArray<double>::size()
+     * quadrature points on @p cell.
+     */
+    virtual void
+    push_vectorized_deformation_gradient_forward(
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      const ArrayView<Tensor<2, spacedim, VectorizedArray<double>>>     &FF,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>>
+        &push_forward_FF) const
+    {
+      (void)cell;
+      (void)FF;
+      (void)push_forward_FF;
+      Assert(false, ExcFDLNotImplemented());
+    }
+
+    /**
+     * Vectorized version of pull_stress_back(). Each entry of @p
+     * push_forward_stress and @p stress contains
+     * VectorizedArray<double>::size() quadrature points on @p cell.
+     */
+    virtual void
+    pull_vectorized_stress_back(
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      const ArrayView<Tensor<2, spacedim, VectorizedArray<double>>>
+        &push_forward_stress,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &stress) const
+    {
+      (void)cell;
+      (void)push_forward_stress;
+      (void)stress;
+      Assert(false, ExcFDLNotImplemented());
+    }
+
     /**
      * Return the material ids over which the present object is defined.
      */
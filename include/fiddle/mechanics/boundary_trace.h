@@ -0,0 +1,114 @@
+#ifndef included_fiddle_mechanics_boundary_trace_h
+#define included_fiddle_mechanics_boundary_trace_h
+
+#include <fiddle/base/config.h>
+
+#include <fiddle/mechanics/part.h>
+
+#include <fiddle/transfer/scatter.h>
+
+#include <deal.II/base/types.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include <vector>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * Class relating the degrees of freedom of a surface part to those of a
+   * volume part whose boundary contains the surface, e.g., an endocardial
+   * surface extracted from a heart model with
+   * GridGenerator::extract_boundary_mesh().
+   *
+   * If the surface's finite element is the trace of the volume part's (e.g.,
+   * FE_Q(k)^spacedim for the volume and FE_Q(k)^spacedim on the surface) then
+   * every surface DoF is also a volume DoF. Hence the surface position and
+   * velocity are just restrictions of the volume vectors, and, since the
+   * volume shape functions restricted to the boundary are the surface shape
+   * functions, a load vector assembled on the surface may be added directly
+   * into the volume part's load vector. This lets a surface part contribute
+   * forces without its own mass solve or interaction.
+   *
+   * DoFs are matched by their support points in the reference configuration
+   * (i.e., on the Triangulations), so both finite elements must have support
+   * points and the surface Triangulation's vertices must be vertices of the
+   * volume Triangulation. Both parts must use the same communicator.
+   */
+  template <int dim, int spacedim = dim>
+  class BoundaryTrace
+  {
+  public:
+    /**
+     * Constructor. This call is collective over the parts' communicator.
+     */
+    BoundaryTrace(const Part<dim, spacedim>     &volume_part,
+                  const Part<dim - 1, spacedim> &surface_part);
+
+    /**
+     * Set the locally owned values of @p surface_vector (which uses the
+     * surface part's partitioning) to the corresponding values of
+     * @p volume_vector. Ghost values are not updated.
+     */
+    void
+    restrict_to_surface(
+      const LinearAlgebra::distributed::Vector<double> &volume_vector,
+      LinearAlgebra::distributed::Vector<double>       &surface_vector);
+
+    /**
+     * Add the locally owned values of @p surface_vector to the corresponding
+     * locally owned values of @p volume_vector, e.g., to add a surface load
+     * vector (after compression) into a volume load vector.
+     */
+    void
+    add_to_volume(
+      const LinearAlgebra::distributed::Vector<double> &surface_vector,
+      LinearAlgebra::distributed::Vector<double>       &volume_vector);
+
+    /**
+     * Return the volume DoF equal to each locally owned surface DoF.
+     */
+    const std::vector<types::global_dof_index> &
+    get_volume_dofs() const;
+
+    /**
+     * Return an estimate of the memory used by this object, in bytes.
+     */
+    std::size_t
+    memory_consumption() const;
+
+  protected:
+    /**
+     * Volume DoF of each locally owned surface DoF.
+     */
+    std::vector<types::global_dof_index> volume_dofs;
+
+    /**
+     * Scatter between the volume partitioning and the locally owned surface
+     * DoFs.
+     */
+    Scatter<double> scatter;
+
+    /**
+     * Values of the locally owned surface DoFs, in the order used by
+     * @p scatter.
+     */
+    Vector<double> buffer;
+  };
+
+
+  // --------------------------- inline functions --------------------------- //
+
+
+  template <int dim, int spacedim>
+  inline const std::vector<types::global_dof_index> &
+  BoundaryTrace<dim, spacedim>::get_volume_dofs() const
+  {
+    return volume_dofs;
+  }
+} // namespace fdl
+
+#endif
@@ -0,0 +1,333 @@
+#ifndef included_fiddle_mechanics_composite_stress_h
+#define included_fiddle_mechanics_composite_stress_h
+
+#include <fiddle/base/config.h>
+
+#include <fiddle/mechanics/force_contribution.h>
+#include <fiddle/mechanics/material_laws.h>
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * Sum of several PK1 stresses, each given by a law in MaterialLaws, which
+   * are all evaluated in a single loop over quadrature points.
+   *
+   * Adding, e.g., ModifiedNeoHookeanStress and JLogJVolumetricEnergyStress to
+   * a Part as two separate ForceContribution objects requires evaluating two
+   * sets of MechanicsValues and looping over the quadrature points (and
+   * writing the stresses) twice. This class computes the union of the update
+   * flags of all laws, so invariants needed by more than one law (e.g., FF or
+   * FF^-T) are computed once, and sums the stresses at each quadrature point
+   * without any intermediate storage.
+   *
+   * For example,
+   * @code
+   * using namespace MaterialLaws;
+   * CompositeStress<dim, dim, ModifiedNeoHookean<dim>, JLogJVolumetricEnergy<dim>>
+   *   stress(quadrature,
+   *          ModifiedNeoHookean<dim>(shear_modulus),
+   *          JLogJVolumetricEnergy<dim>(bulk_modulus));
+   * @endcode
+   * computes the same stresses as ModifiedNeoHookeanStress and
+   * JLogJVolumetricEnergyStress combined.
+   */
+  template <int dim, int spacedim, typename... Laws>
+  class CompositeStress : public ForceContribution<dim, spacedim, double>
+  {
+    static_assert(sizeof...(Laws) > 0, "At least one law is required.");
+
+  public:
+    /**
+     * Constructor. The stress will be applied on every cell.
+     */
+    CompositeStress(const Quadrature<dim> &quad, const Laws &...laws);
+
+    /**
+     * Constructor.
+     *
+     * @note if @p material_ids is empty then the force will be applied on
+     * every cell.
+     */
+    CompositeStress(const Quadrature<dim>                 &quad,
+                    const std::vector<types::material_id> &material_ids,
+                    const Laws &...laws);
+
+    /**
+     * Get the update flags this force contribution requires for MechanicsValues
+     * objects, i.e., the union of the flags required by each law.
+     */
+    virtual MechanicsUpdateFlags
+    get_mechanics_update_flags() const override;
+
+    /**
+     * Define this force as a PK1 stress.
+     */
+    virtual bool
+    is_stress() const override;
+
+    virtual void
+    compute_stress(
+      const double                          time,
+      const MechanicsValues<dim, spacedim> &me_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      ArrayView<Tensor<2, spacedim, double>> &stresses) const override;
+
+    /**
+     * All laws in MaterialLaws only depend on FF so this stress can be
+     * vectorized.
+     */
+    virtual bool
+    supports_vectorized_stress() const override;
+
+    virtual void
+    compute_vectorized_stress(
+      const double                                    time,
+      const VectorizedMechanicsValues<dim, spacedim> &me_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &stresses)
+      const override;
+
+    /**
+     * All laws in MaterialLaws implement their consistent tangents.
+     */
+    virtual bool
+    supports_stress_linearization() const override;
+
+    virtual void
+    compute_vectorized_linearized_stress(
+      const double                                    time,
+      const VectorizedMechanicsValues<dim, spacedim> &me_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      const ArrayView<const Tensor<2, spacedim, VectorizedArray<double>>> &dFF,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &dstresses)
+      const override;
+
+  protected:
+    /**
+     * Implementation of both compute_stress() and compute_vectorized_stress().
+     */
+    template <typename MechanicsValuesType, typename StressNumber>
+    void
+    do_compute_stress(
+      const MechanicsValuesType &m_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      ArrayView<Tensor<2, spacedim, StressNumber>> &stresses) const;
+
+    /**
+     * Loop over quadrature points and sum the stresses of all laws.
+     */
+    template <typename MechanicsValuesType,
+              typename StressNumber,
+              std::size_t... Is>
+    void
+    do_compute_stress(
+      const MechanicsValuesType &m_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      ArrayView<Tensor<2, spacedim, StressNumber>> &stresses,
+      std::index_sequence<Is...>) const;
+
+    /**
+     * Loop over quadrature points and sum the stress derivatives of all laws.
+     */
+    template <std::size_t... Is>
+    void
+    do_compute_linearized_stress(
+      const VectorizedMechanicsValues<dim, spacedim> &m_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      const ArrayView<const Tensor<2, spacedim, VectorizedArray<double>>> &dFF,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &dstresses,
+      std::index_sequence<Is...>) const;
+
+    /**
+     * Return whether or not this stress is applied on @p cell.
+     */
+    bool
+    is_active_on(
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+      const;
+
+    std::tuple<Laws...> laws;
+
+    std::vector<types::material_id> material_ids;
+  };
+
+  // --------------------------- inline functions --------------------------- //
+
+  template <int dim, int spacedim, typename... Laws>
+  CompositeStress<dim, spacedim, Laws...>::CompositeStress(
+    const Quadrature<dim> &quad,
+    const Laws &...laws)
+    : CompositeStress(quad, std::vector<types::material_id>(), laws...)
+  {}
+
+  template <int dim, int spacedim, typename... Laws>
+  CompositeStress<dim, spacedim, Laws...>::CompositeStress(
+    const Quadrature<dim>                 &quad,
+    const std::vector<types::material_id> &material_ids,
+    const Laws &...laws)
+    : ForceContribution<dim, spacedim, double>(quad)
+    , laws(laws...)
+    , material_ids(material_ids)
+  {
+    // permit duplicates in the input array
+    std::sort(this->material_ids.begin(), this->material_ids.end());
+    this->material_ids.erase(std::unique(this->material_ids.begin(),
+                                         this->material_ids.end()),
+                             this->material_ids.end());
+  }
+
+  template <int dim, int spacedim, typename... Laws>
+  inline MechanicsUpdateFlags
+  CompositeStress<dim, spacedim, Laws...>::get_mechanics_update_flags() const
+  {
+    return (MechanicsUpdateFlags::update_nothing | ... |
+            Laws::get_mechanics_update_flags());
+  }
+
+  template <int dim, int spacedim, typename... Laws>
+  inline bool
+  CompositeStress<dim, spacedim, Laws...>::is_stress() const
+  {
+    return true;
+  }
+
+  template <int dim, int spacedim, typename... Laws>
+  inline void
+  CompositeStress<dim, spacedim, Laws...>::compute_stress(
+    const double /*time*/,
+    const MechanicsValues<dim, spacedim>                              &m_values,
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    ArrayView<Tensor<2, spacedim, double>> &stresses) const
+  {
+    do_compute_stress(m_values, cell, stresses);
+  }
+
+  template <int dim, int spacedim, typename... Laws>
+  inline bool
+  CompositeStress<dim, spacedim, Laws...>::supports_vectorized_stress() const
+  {
+    return true;
+  }
+
+  template <int dim, int spacedim, typename... Laws>
+  inline void
+  CompositeStress<dim, spacedim, Laws...>::compute_vectorized_stress(
+    const double /*time*/,
+    const VectorizedMechanicsValues<dim, spacedim>                    &m_values,
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &stresses) const
+  {
+    do_compute_stress(m_values, cell, stresses);
+  }
+
+  template <int dim, int spacedim, typename... Laws>
+  inline bool
+  CompositeStress<dim, spacedim, Laws...>::supports_stress_linearization() const
+  {
+    return true;
+  }
+
+  template <int dim, int spacedim, typename... Laws>
+  inline void
+  CompositeStress<dim, spacedim, Laws...>::compute_vectorized_linearized_stress(
+    const double /*time*/,
+    const VectorizedMechanicsValues<dim, spacedim>                    &m_values,
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    const ArrayView<const Tensor<2, spacedim, VectorizedArray<double>>> &dFF,
+    ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &dstresses) const
+  {
+    if (!is_active_on(cell))
+      {
+        for (auto &dstress : dstresses)
+          dstress = Tensor<2, spacedim, VectorizedArray<double>>();
+      }
+    else
+      do_compute_linearized_stress(m_values,
+                                   cell,
+                                   dFF,
+                                   dstresses,
+                                   std::index_sequence_for<Laws...>());
+  }
+
+  template <int dim, int spacedim, typename... Laws>
+  inline bool
+  CompositeStress<dim, spacedim, Laws...>::is_active_on(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+    const
+  {
+    return material_ids.size() == 0 ||
+           std::binary_search(material_ids.begin(),
+                              material_ids.end(),
+                              cell->material_id());
+  }
+
+  template <int dim, int spacedim, typename... Laws>
+  template <typename MechanicsValuesType, typename StressNumber>
+  inline void
+  CompositeStress<dim, spacedim, Laws...>::do_compute_stress(
+    const MechanicsValuesType                                         &m_values,
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    ArrayView<Tensor<2, spacedim, StressNumber>> &stresses) const
+  {
+    if (!is_active_on(cell))
+      {
+        // the user specified a subset of material ids and we currently don't
+        // match - fill with zeros
+        for (auto &stress : stresses)
+          stress = Tensor<2, spacedim, StressNumber>();
+      }
+    else
+      do_compute_stress(m_values,
+                        cell,
+                        stresses,
+                        std::index_sequence_for<Laws...>());
+  }
+
+  template <int dim, int spacedim, typename... Laws>
+  template <typename MechanicsValuesType,
+            typename StressNumber,
+            std::size_t... Is>
+  inline void
+  CompositeStress<dim, spacedim, Laws...>::do_compute_stress(
+    const MechanicsValuesType                                         &m_values,
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    ArrayView<Tensor<2, spacedim, StressNumber>> &stresses,
+    std::index_sequence<Is...>) const
+  {
+    const auto cell_data = std::make_tuple(
+      std::get<Is>(laws).template get_cell_data<StressNumber>(cell)...);
+    for (unsigned int qp_n = 0; qp_n < stresses.size(); ++qp_n)
+      stresses[qp_n] = (std::get<Is>(laws).template get_stress<StressNumber>(
+                          m_values, std::get<Is>(cell_data), qp_n) +
+                        ...);
+  }
+
+  template <int dim, int spacedim, typename... Laws>
+  template <std::size_t... Is>
+  inline void
+  CompositeStress<dim, spacedim, Laws...>::do_compute_linearized_stress(
+    const VectorizedMechanicsValues<dim, spacedim>                    &m_values,
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    const ArrayView<const Tensor<2, spacedim, VectorizedArray<double>>> &dFF,
+    ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &dstresses,
+    std::index_sequence<Is...>) const
+  {
+    using VA             = VectorizedArray<double>;
+    const auto cell_data = std::make_tuple(
+      std::get<Is>(laws).template get_cell_data<VA>(cell)...);
+    for (unsigned int qp_n = 0; qp_n < dstresses.size(); ++qp_n)
+      dstresses[qp_n] =
+        (std::get<Is>(laws).template get_stress_derivative<VA>(
+           m_values, std::get<Is>(cell_data), qp_n, dFF[qp_n]) +
+         ...);
+  }
+} // namespace fdl
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef included_fiddle_mechanics_device_mass_solver_h
+#define included_fiddle_mechanics_device_mass_solver_h
+
+#include <fiddle/base/config.h>
+
+#include <deal.II/base/quadrature.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/mapping.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <memory>
+#include <vector>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * Class which solves mass systems on the device (i.e., a GPU) with deal.II's
+   * CUDAWrappers::MatrixFree.
+   *
+   * The mass matrix of an FESystem whose base elements are all the same
+   * scalar element is block diagonal: this class hence sets up a second,
+   * scalar, DoFHandler and solves one scalar system per vector component with
+   * the Jacobi-preconditioned conjugate gradient method. The right-hand sides
+   * are copied to the device once per component and the solutions are copied
+   * back once the solves converge, so all CG iterations happen on the device.
+   *
+   * Only FE_Q elements of degree one through five on hypercube cells without
+   * constraints are supported. This class is only available when fiddle is
+   * configured with FDL_ENABLE_DEVICE_MATRIX_FREE and deal.II is configured
+   * with a Kokkos device backend. PartGeometry::setup_device_mass_solver()
+   * sets up one of these objects, after which PartGeometry uses it to solve
+   * its consistent mass systems.
+   */
+  template <int dim>
+  class DeviceMassSolver
+  {
+  public:
+    /**
+     * Constructor. @p dof_handler must use an FESystem with dim copies of the
+     * same FE_Q element and @p quadrature must be a tensor product of the
+     * one-dimensional Gauss rule with one more point than that element's
+     * degree.
+     */
+    DeviceMassSolver(const Mapping<dim>    &mapping,
+                     const DoFHandler<dim> &dof_handler,
+                     const Quadrature<dim> &quadrature);
+
+    /**
+     * Destructor.
+     */
+    ~DeviceMassSolver();
+
+    /**
+     * Solve the mass systems M solutions[k] = right_hand_sides[k] for each k.
+     * Both vectors must use the vector partitioning of the DoFHandler
+     * provided to the constructor. Returns the largest number of CG
+     * iterations required by any component of each system.
+     */
+    std::vector<unsigned int>
+    solve(
+      const std::vector<LinearAlgebra::distributed::Vector<double> *>
+        &solutions,
+      const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+                        &right_hand_sides,
+      const unsigned int max_iterations,
+      const double       relative_tolerance) const;
+
+    /**
+     * Return an estimate of the host memory used by this object, in bytes.
+     */
+    std::size_t
+    memory_consumption() const;
+
+  protected:
+    /**
+     * Device data structures (which may only be included when the device
+     * backend is available).
+     */
+    struct Implementation;
+
+    std::unique_ptr<Implementation> implementation;
+  };
+} // namespace fdl
+
+#endif
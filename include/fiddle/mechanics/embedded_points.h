@@ -0,0 +1,130 @@
+#ifndef included_fiddle_mechanics_embedded_points_h
+#define included_fiddle_mechanics_embedded_points_h
+
+#include <fiddle/base/config.h>
+
+#include <deal.II/base/point.h>
+#include <deal.II/base/tensor.h>
+#include <deal.II/base/types.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/mapping.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <vector>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * Class describing a cloud of points (e.g., discrete fibers or sensors)
+   * embedded in a part, i.e., points which move with the part instead of
+   * being a separate structure.
+   *
+   * Each point is located once, in the reference configuration, and its host
+   * cell's DoF indices and the values of the host cell's shape functions at
+   * the point's reference coordinates are stored. Evaluating a finite element
+   * field (e.g., the position or velocity) at the points then only requires
+   * one small dot product per point and component, and forces applied at the
+   * points are added directly to the part's load vector: they are hence
+   * spread with the rest of the part's force by the part's own interaction
+   * instead of requiring a separate nodal structure with its own interaction,
+   * patch map, and scatter.
+   *
+   * Each point belongs to the processor which owns its host cell, so every
+   * point is stored on exactly one processor.
+   */
+  template <int dim, int spacedim = dim>
+  class EmbeddedPoints
+  {
+  public:
+    /**
+     * Constructor. @p dof_handler and @p mapping are the DoFHandler and
+     * reference configuration mapping of a part (i.e., Part::get_dof_handler()
+     * and Part::get_mapping()), which must use a
+     * parallel::shared::Triangulation, and @p reference_points are the
+     * positions of the points in the reference configuration. These must be
+     * the same on every processor and every point must be inside (or, for
+     * codimension one parts, on) some cell.
+     */
+    EmbeddedPoints(const DoFHandler<dim, spacedim>    &dof_handler,
+                   const Mapping<dim, spacedim>       &mapping,
+                   const std::vector<Point<spacedim>> &reference_points);
+
+    /**
+     * Return the number of points stored on this processor.
+     */
+    std::size_t
+    n_locally_owned_points() const;
+
+    /**
+     * Return the indices, in the array given to the constructor, of the
+     * points stored on this processor. Every other function uses the same
+     * order.
+     */
+    const std::vector<unsigned int> &
+    get_point_indices() const;
+
+    /**
+     * Evaluate the vector-valued finite element field @p dof_values (e.g.,
+     * the velocity of the part), which must have up-to-date ghost values, at
+     * the locally owned points.
+     */
+    std::vector<Tensor<1, spacedim>>
+    compute_values(
+      const LinearAlgebra::distributed::Vector<double> &dof_values) const;
+
+    /**
+     * Same as compute_values(), but for a position.
+     */
+    std::vector<Point<spacedim>>
+    compute_positions(
+      const LinearAlgebra::distributed::Vector<double> &position) const;
+
+    /**
+     * Add the load vector of the point forces @p forces (i.e., of a sum of
+     * Dirac distributions), one per locally owned point, to @p force_rhs.
+     * Like compute_load_vector(), this may modify ghost entries of
+     * @p force_rhs, so it must be compressed afterwards.
+     */
+    void
+    add_load_vector(
+      const std::vector<Tensor<1, spacedim>>     &forces,
+      LinearAlgebra::distributed::Vector<double> &force_rhs) const;
+
+    /**
+     * Return an estimate of the memory used by this object, in bytes.
+     */
+    std::size_t
+    memory_consumption() const;
+
+  protected:
+    /**
+     * Number of DoFs on each cell.
+     */
+    unsigned int n_dofs_per_cell;
+
+    /**
+     * Vector component of each DoF on a cell.
+     */
+    std::vector<unsigned int> components;
+
+    std::vector<unsigned int> point_indices;
+
+    /**
+     * DoF indices of the host cell of each point, stored contiguously.
+     */
+    std::vector<types::global_dof_index> dof_indices;
+
+    /**
+     * Values of the (nonzero components of the) host cell's shape functions
+     * at each point, stored in the same way as dof_indices.
+     */
+    std::vector<double> shape_values;
+  };
+} // namespace fdl
+
+#endif
@@ -3,11 +3,26 @@
 
 #include <fiddle/base/config.h>
 
+#include <fiddle/base/exceptions.h>
+
 #include <deal.II/base/array_view.h>
+#include <deal.II/base/symmetric_tensor.h>
 #include <deal.II/base/table.h>
+#include <deal.II/base/thread_local_storage.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping.h>
 
 #include <deal.II/grid/tria.h>
 
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <array>
+#include <limits>
+#include <memory>
+
 namespace fdl
 {
   using namespace dealii;
@@ -15,6 +30,26 @@ namespace fdl
   /**
    * Reads cell-centered fiber field(s) stored in a vector
    * and stores the data in a Table.
+   *
+   * The fibers of each cell are stored contiguously since every consumer of
+   * this class (e.g., HolzapfelOgdenStress) reads all the fibers of one cell
+   * at a time. To save memory the fibers may optionally be stored in single
+   * precision: this halves the memory used by the fibers (e.g., from 72 to 36
+   * bytes per cell for three fiber families in 3D) at the cost of about seven
+   * significant digits of accuracy, which is typically much more than the
+   * accuracy of the input fiber data.
+   *
+   * Many material models depend on the fibers only through the structural
+   * tensors $sym(f_i \otimes f_j)$. These can be computed on the fly by
+   * get_structural_tensor() or, at the cost of more memory, precomputed once
+   * by setup_structural_tensors().
+   *
+   * Alternatively, the fibers may be defined by a rule (e.g., myofibers whose
+   * angle varies linearly through the wall of a ventricle) applied to a
+   * scalar transmural coordinate, which is typically the solution of a
+   * Laplace problem. In that case this class stores only that coordinate
+   * (i.e., one value per DoF of a scalar finite element) and generates the
+   * fibers of each cell when they are requested: see the second constructor.
    */
   template <int dim, int spacedim = dim>
   class FiberNetwork
@@ -28,6 +63,9 @@ namespace fdl
      * vector in @p fibers must equal the number of locally owned cells of @p
      * on the current processor, and values in these vectors are indexed by
      * the global active cell index (minus the current processor's offset).
+     * @param use_single_precision Whether or not the fibers should be stored
+     * as floats instead of doubles. If this is true then get_fibers() cannot
+     * be used and get_fiber() should be used instead.
      *
      * @note It is probably easiest to load this data from a set of scalar
      * cell data vectors by setting up an FESystem<dim>(FE_SimplexP<dim>,
@@ -35,36 +73,296 @@ namespace fdl
      * data vector into a vector of tensors.
      */
     FiberNetwork(const Triangulation<dim, spacedim>                  &tria,
-                 const std::vector<std::vector<Tensor<1, spacedim>>> &fibers);
+                 const std::vector<std::vector<Tensor<1, spacedim>>> &fibers,
+                 const bool use_single_precision = false);
+
+    /**
+     * Constructor for rule-based fibers. Let t be the transmural coordinate
+     * (zero on the endocardium and one on the epicardium), e_t the
+     * normalized gradient of t, e_l the normalized projection of @p
+     * longitudinal_axis onto the plane orthogonal to e_t, and e_c = e_l x e_t.
+     * With the helix angle
+     *
+     *     alpha(t) = (1 - t) endocardial_angle + t epicardial_angle
+     *
+     * (in radians), the fibers are, in this order,
+     *
+     *     f = cos(alpha) e_c + sin(alpha) e_l,
+     *     s = e_t,
+     *     n = f x s,
+     *
+     * i.e., the myofiber, sheet, and sheet-normal directions. If spacedim is
+     * two there is no longitudinal direction and the fibers are instead e_t
+     * rotated by alpha + pi/2 and by alpha, so that n_fibers() is spacedim.
+     *
+     * The fibers of a cell are evaluated at its center and are recomputed
+     * each time they are requested, except that each thread reuses the
+     * fibers of the last cell it evaluated. This uses much less memory than
+     * storing the fibers (one value per DoF instead of spacedim^2 values per
+     * cell) at the cost of one FEValues evaluation per cell.
+     *
+     * @param mapping Mapping of the reference configuration.
+     * @param dof_handler DoFHandler of a scalar finite element.
+     * @param transmural_coordinate The transmural coordinate. This object
+     * stores a copy of this vector with ghost values. Both @p mapping and @p
+     * dof_handler must outlive this object.
+     */
+    FiberNetwork(
+      const Mapping<dim, spacedim>                     &mapping,
+      const DoFHandler<dim, spacedim>                  &dof_handler,
+      const LinearAlgebra::distributed::Vector<double> &transmural_coordinate,
+      const Tensor<1, spacedim>                        &longitudinal_axis,
+      const double                                      endocardial_angle,
+      const double                                      epicardial_angle);
+
+    /**
+     * Whether or not the fibers are generated by a rule (i.e., whether or not
+     * this object was set up with the second constructor).
+     */
+    bool
+    is_rule_based() const;
+
+    /**
+     * Number of fiber fields.
+     */
+    unsigned int
+    n_fibers() const;
+
+    /**
+     * Whether or not the fibers are stored in single precision.
+     */
+    bool
+    uses_single_precision() const;
 
     /**
      * Get a view into the stored fibers on a given cell.
+     *
+     * @note This function is only available when the fibers are stored in
+     * double precision (and are hence not rule-based).
      */
     ArrayView<const Tensor<1, spacedim>>
     get_fibers(const typename Triangulation<dim, spacedim>::active_cell_iterator
                  &cell) const;
 
+    /**
+     * Get fiber @p fiber_n on a given cell.
+     */
+    Tensor<1, spacedim>
+    get_fiber(
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      const unsigned int fiber_n) const;
+
+    /**
+     * Precompute and store the structural tensors of all pairs of fibers on
+     * every locally owned cell.
+     */
+    void
+    setup_structural_tensors();
+
+    /**
+     * Whether or not setup_structural_tensors() has been called.
+     */
+    bool
+    has_structural_tensors() const;
+
+    /**
+     * Get the structural tensor
+     *
+     *     sym(f_i (x) f_j) = (f_i (x) f_j + f_j (x) f_i) / 2
+     *
+     * of fibers @p fiber_i and @p fiber_j on a given cell. The returned value
+     * is the stored one if setup_structural_tensors() has been called and is
+     * otherwise computed from the fibers.
+     */
+    SymmetricTensor<2, spacedim>
+    get_structural_tensor(
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      const unsigned int fiber_i,
+      const unsigned int fiber_j) const;
+
+    /**
+     * Return the amount of memory used by the present object, in bytes.
+     */
+    std::size_t
+    memory_consumption() const;
+
   private:
+    /**
+     * Set up local_processor_min_cell_index and return the number of locally
+     * owned cells.
+     */
+    unsigned int
+    setup_cell_indices();
+
+    /**
+     * Get the rule-based fibers of @p cell.
+     */
+    const std::array<Tensor<1, spacedim>, spacedim> &
+    get_rule_based_fibers(
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+      const;
+
+    /**
+     * Get the row index into the tables for @p cell.
+     */
+    types::global_cell_index
+    get_cell_index(
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+      const;
+
+    /**
+     * Get the column index into the table of structural tensors for the pair
+     * of fibers (@p fiber_i, @p fiber_j).
+     */
+    static unsigned int
+    get_pair_index(const unsigned int fiber_i, const unsigned int fiber_j);
+
     const SmartPointer<const Triangulation<dim, spacedim>> tria;
-    Table<2, Tensor<1, spacedim>>                          fibers;
+    unsigned int                                           n_fiber_fields;
+    bool                                                   single_precision;
     types::global_cell_index local_processor_min_cell_index;
+
+    /**
+     * Fibers, indexed by (cell index, fiber number). Only one of these two
+     * tables is nonempty.
+     */
+    Table<2, Tensor<1, spacedim>>        fibers;
+    Table<2, Tensor<1, spacedim, float>> single_precision_fibers;
+
+    /**
+     * Structural tensors, indexed by (cell index, pair index). Empty unless
+     * setup_structural_tensors() has been called.
+     */
+    Table<2, SymmetricTensor<2, spacedim>> structural_tensors;
+
+    /**
+     * Data for rule-based fibers. dof_handler is nullptr unless the fibers
+     * are rule-based.
+     */
+    SmartPointer<const Mapping<dim, spacedim>>    mapping;
+    SmartPointer<const DoFHandler<dim, spacedim>> dof_handler;
+    LinearAlgebra::distributed::Vector<double>    transmural_coordinate;
+    Tensor<1, spacedim>                           longitudinal_axis;
+    double                                        endocardial_angle;
+    double                                        epicardial_angle;
+
+    /**
+     * Per-thread scratch data for rule-based fibers, including the fibers of
+     * the last cell.
+     */
+    struct RuleScratchData
+    {
+      std::shared_ptr<FEValues<dim, spacedim>> fe_values;
+      std::vector<double>                      values;
+      std::vector<Tensor<1, spacedim>>         gradients;
+      types::global_cell_index                 cell_index =
+        std::numeric_limits<types::global_cell_index>::max();
+      std::array<Tensor<1, spacedim>, spacedim> fibers;
+    };
+
+    mutable Threads::ThreadLocalStorage<RuleScratchData> rule_scratch_data;
   };
 
 
   // --------------------------- inline functions --------------------------- //
 
 
+  template <int dim, int spacedim>
+  inline unsigned int
+  FiberNetwork<dim, spacedim>::n_fibers() const
+  {
+    return n_fiber_fields;
+  }
+
+  template <int dim, int spacedim>
+  inline bool
+  FiberNetwork<dim, spacedim>::is_rule_based() const
+  {
+    return dof_handler != nullptr;
+  }
+
+  template <int dim, int spacedim>
+  inline bool
+  FiberNetwork<dim, spacedim>::uses_single_precision() const
+  {
+    return single_precision;
+  }
+
+  template <int dim, int spacedim>
+  inline bool
+  FiberNetwork<dim, spacedim>::has_structural_tensors() const
+  {
+    return structural_tensors.n_elements() > 0;
+  }
+
+  template <int dim, int spacedim>
+  inline types::global_cell_index
+  FiberNetwork<dim, spacedim>::get_cell_index(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+    const
+  {
+    Assert(cell->is_locally_owned(),
+           ExcMessage("Fibers are only available on locally owned cells."));
+    return cell->global_active_cell_index() - local_processor_min_cell_index;
+  }
+
+  template <int dim, int spacedim>
+  inline unsigned int
+  FiberNetwork<dim, spacedim>::get_pair_index(const unsigned int fiber_i,
+                                              const unsigned int fiber_j)
+  {
+    const unsigned int min = std::min(fiber_i, fiber_j);
+    const unsigned int max = std::max(fiber_i, fiber_j);
+    return max * (max + 1) / 2 + min;
+  }
+
   template <int dim, int spacedim>
   inline ArrayView<const Tensor<1, spacedim>>
   FiberNetwork<dim, spacedim>::get_fibers(
     const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
     const
   {
-    auto cell_index =
-      cell->global_active_cell_index() - local_processor_min_cell_index;
+    Assert(!single_precision && !is_rule_based(),
+           ExcMessage("This function cannot be called when the fibers are "
+                      "stored in single precision or are rule-based."));
+    const auto cell_index = get_cell_index(cell);
 
     return make_array_view(fibers, cell_index, 0, fibers.size(1));
   }
+
+  template <int dim, int spacedim>
+  inline Tensor<1, spacedim>
+  FiberNetwork<dim, spacedim>::get_fiber(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    const unsigned int fiber_n) const
+  {
+    AssertIndexRange(fiber_n, n_fiber_fields);
+    if (is_rule_based())
+      return get_rule_based_fibers(cell)[fiber_n];
+    const auto cell_index = get_cell_index(cell);
+    if (single_precision)
+      return Tensor<1, spacedim>(single_precision_fibers(cell_index, fiber_n));
+    else
+      return fibers(cell_index, fiber_n);
+  }
+
+  template <int dim, int spacedim>
+  inline SymmetricTensor<2, spacedim>
+  FiberNetwork<dim, spacedim>::get_structural_tensor(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    const unsigned int fiber_i,
+    const unsigned int fiber_j) const
+  {
+    AssertIndexRange(fiber_i, n_fiber_fields);
+    AssertIndexRange(fiber_j, n_fiber_fields);
+    if (has_structural_tensors())
+      return structural_tensors(get_cell_index(cell),
+                                get_pair_index(fiber_i, fiber_j));
+
+    const Tensor<1, spacedim> f_i = get_fiber(cell, fiber_i);
+    const Tensor<1, spacedim> f_j = get_fiber(cell, fiber_j);
+    return symmetrize(outer_product(f_i, f_j));
+  }
 } // namespace fdl
 
 #endif
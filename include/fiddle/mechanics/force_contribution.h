@@ -13,12 +13,20 @@
 
 #include <deal.II/lac/la_parallel_vector.h>
 
+#include <utility>
+#include <vector>
+
 namespace fdl
 {
   using namespace dealii;
 
   /**
    * Interface class for force contributions from various sources to Parts.
+   *
+   * @note The cell and face loops in compute_load_vector() and related
+   * functions are run in parallel with WorkStream, so compute_force(),
+   * compute_boundary_force(), compute_volume_force(), and compute_stress() may
+   * be called concurrently on different cells and must be thread-safe.
    */
   template <int dim, int spacedim = dim, typename Number = double>
   class ForceContribution
@@ -106,6 +114,20 @@ namespace fdl
       return false;
     }
 
+    /**
+     * Get the sorted boundary ids of the faces on which this boundary force
+     * may be nonzero. An empty vector (the default) means that the force may
+     * be nonzero on every boundary face.
+     *
+     * compute_load_vector() and compute_boundary_force_load_vector() use this
+     * to skip faces on which every boundary force is zero.
+     */
+    virtual std::vector<types::boundary_id>
+    get_boundary_ids() const
+    {
+      return {};
+    }
+
     /**
      * Some forces that are not defined in a straightforward way (e.g., pressure
      * fields) require additional setup before their force contribution is
@@ -199,6 +221,149 @@ namespace fdl
       Assert(false, ExcFDLInternalError());
     }
 
+    /**
+     * Some volume forces are finite element fields, i.e., F = sum_i F_i phi_i
+     * for a vector of DoF values F_i defined on the same DoFHandler used to
+     * assemble the load vector. Such forces may return a pointer to those DoF
+     * values (with up-to-date ghost values) here, which permits assembling
+     * them as a mass matrix-vector product with MatrixFree instead of
+     * evaluating compute_volume_force() at quadrature points. The returned
+     * values are only valid between calls to setup_force() and
+     * finish_force(). Defaults to nullptr.
+     */
+    virtual const LinearAlgebra::distributed::Vector<double> *
+    get_volume_force_dof_values() const
+    {
+      return nullptr;
+    }
+
+    /**
+     * Whether or not this volume force is mass-proportional, i.e., whether it
+     * is, on every cell,
+     *
+     *     F = a X + b U
+     *
+     * in which X and U are the position and velocity and a and b are the
+     * constants returned by get_mass_proportional_coefficients(). The load
+     * vector of such a force is the mass matrix applied to a X + b U, which
+     * compute_load_vector() computes with MatrixFree instead of evaluating
+     * compute_volume_force() at quadrature points. Defaults to false.
+     */
+    virtual bool
+    is_mass_proportional() const
+    {
+      return false;
+    }
+
+    /**
+     * Get the coefficients a and b (in that order) of a mass-proportional
+     * force at time @p time.
+     */
+    virtual std::pair<double, double>
+    get_mass_proportional_coefficients(const double time) const
+    {
+      (void)time;
+      Assert(false, ExcFDLNotImplemented());
+      return {0.0, 0.0};
+    }
+
+    /**
+     * Whether or not this volume force is a set of point loads applied
+     * directly to a (typically small) set of DoFs. compute_load_vector()
+     * calls add_nodal_load_vector() for such forces instead of evaluating
+     * compute_volume_force() at quadrature points. Defaults to false.
+     */
+    virtual bool
+    is_nodal_force() const
+    {
+      return false;
+    }
+
+    /**
+     * Add the load vector of a nodal force to the locally owned entries of @p
+     * force_rhs. Like the other functions which compute forces, this is only
+     * called between calls to setup_force() and finish_force().
+     */
+    virtual void
+    add_nodal_load_vector(
+      const double                                      time,
+      const LinearAlgebra::distributed::Vector<double> &position,
+      const LinearAlgebra::distributed::Vector<double> &velocity,
+      LinearAlgebra::distributed::Vector<double>       &force_rhs) const
+    {
+      (void)time;
+      (void)position;
+      (void)velocity;
+      (void)force_rhs;
+      Assert(false, ExcFDLNotImplemented());
+    }
+
+    /**
+     * Whether or not this stress implements compute_vectorized_stress().
+     * Defaults to false.
+     */
+    virtual bool
+    supports_vectorized_stress() const
+    {
+      return false;
+    }
+
+    /**
+     * Vectorized version of compute_stress(). Each entry of @p me_values and
+     * @p stresses contains VectorizedArray<double>::size() quadrature points
+     * on @p cell. Since @p me_values is set up from precomputed values of FF,
+     * only stresses which do not need positions, velocities, normal vectors,
+     * or anything else from an FEValues object may implement this function.
+     */
+    virtual void
+    compute_vectorized_stress(
+      const double                                    time,
+      const VectorizedMechanicsValues<dim, spacedim> &me_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &stresses) const
+    {
+      (void)time;
+      (void)me_values;
+      (void)cell;
+      (void)stresses;
+      Assert(false, ExcFDLNotImplemented());
+    }
+
+    /**
+     * Whether or not this stress implements
+     * compute_vectorized_linearized_stress(). Defaults to false.
+     */
+    virtual bool
+    supports_stress_linearization() const
+    {
+      return false;
+    }
+
+    /**
+     * Compute the directional derivative of the stress, with respect to FF,
+     * in the directions @p dFF - i.e., the consistent tangent of the material
+     * model applied to @p dFF. @p me_values is set up in the same way as in
+     * compute_vectorized_stress() and each entry of @p dFF and @p dstresses
+     * corresponds to the same quadrature points as the matching entry of @p
+     * me_values. This is used by implicit structural solvers (see
+     * ImplicitStructureSolver).
+     */
+    virtual void
+    compute_vectorized_linearized_stress(
+      const double                                    time,
+      const VectorizedMechanicsValues<dim, spacedim> &me_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      const ArrayView<const Tensor<2, spacedim, VectorizedArray<double>>> &dFF,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &dstresses) const
+    {
+      (void)time;
+      (void)me_values;
+      (void)cell;
+      (void)dFF;
+      (void)dstresses;
+      Assert(false, ExcFDLNotImplemented());
+    }
+
   private:
     bool is_volumetric;
 
@@ -5,10 +5,12 @@
 
 #include <fiddle/base/exceptions.h>
 
+#include <fiddle/mechanics/embedded_points.h>
 #include <fiddle/mechanics/fiber_network.h>
 #include <fiddle/mechanics/force_contribution.h>
 
 #include <deal.II/base/function.h>
+#include <deal.II/base/thread_local_storage.h>
 
 #include <deal.II/dofs/dof_handler.h>
 
@@ -91,9 +93,25 @@ namespace fdl
                                                current_position;
     LinearAlgebra::distributed::Vector<double> reference_position;
 
-    mutable std::vector<types::global_dof_index> scratch_cell_dofs;
-    mutable std::vector<double>                  scratch_dof_values;
-    mutable std::vector<Tensor<1, spacedim>>     scratch_qp_values;
+    /**
+     * The DoF values of the force k (X_ref - X). Only used when there is a
+     * DoFHandler and computed once per call to setup_force() so that the force
+     * at quadrature points is a plain interpolation.
+     */
+    LinearAlgebra::distributed::Vector<double> scaled_displacement;
+
+    /**
+     * Compute scaled_displacement from reference_position and @p position.
+     */
+    void
+    setup_scaled_displacement(
+      const LinearAlgebra::distributed::Vector<double> &position);
+
+    mutable Threads::ThreadLocalStorage<std::vector<types::global_dof_index>>
+      scratch_cell_dofs;
+    mutable Threads::ThreadLocalStorage<std::vector<double>> scratch_dof_values;
+    mutable Threads::ThreadLocalStorage<std::vector<Tensor<1, spacedim>>>
+      scratch_qp_values;
   };
 
   /**
@@ -154,6 +172,13 @@ namespace fdl
         & /*cell*/,
       ArrayView<Tensor<1, spacedim, Number>> &forces) const override;
 
+    /**
+     * Return the DoF values of the force when it is defined by a DoFHandler
+     * and applied on every cell, and nullptr otherwise.
+     */
+    virtual const LinearAlgebra::distributed::Vector<double> *
+    get_volume_force_dof_values() const override;
+
   protected:
     std::vector<types::material_id> material_ids;
   };
@@ -210,6 +235,9 @@ namespace fdl
     virtual bool
     is_boundary_force() const override;
 
+    virtual std::vector<types::boundary_id>
+    get_boundary_ids() const override;
+
     virtual void
     compute_boundary_force(
       const double                          time,
@@ -221,6 +249,179 @@ namespace fdl
     std::vector<types::boundary_id> boundary_ids;
   };
 
+  /**
+   * Spring forces applied to a set of nodes (e.g., a nodeset read by
+   * extract_nodeset()). This force is
+   *
+   * F_i = k m_i (X_ref_i - X_i)
+   *
+   * at each DoF i of each node, in which m_i is the corresponding diagonal
+   * entry of the lumped mass matrix (i.e., the integral of the ith basis
+   * function over the reference configuration) and X_ref_i is the reference
+   * position of that DoF. This is the lumped-mass version of a SpringForce
+   * restricted to the given nodes.
+   *
+   * Unlike SpringForce, this class only stores the locally owned DoFs of the
+   * nodes, their reference positions, and their lumped masses, and adds the
+   * force directly to the load vector (see
+   * ForceContribution::add_nodal_load_vector()). Hence computing the force
+   * is proportional to the number of nodes and does not require a loop over
+   * the cells.
+   *
+   * @note The lumped masses are computed once, by the constructor. They must
+   * all be positive, which is the case for linear elements and for tensor
+   * product elements but not, e.g., for quadratic simplex elements (whose
+   * basis functions at vertices have zero integrals).
+   */
+  template <int dim, int spacedim = dim, typename Number = double>
+  class NodalSpringForce : public ForceContribution<dim, spacedim, double>
+  {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param[in] quad Quadrature rule used to compute the lumped masses.
+     *
+     * @param[in] dof_handler DoFHandler of the Part. Its finite element must
+     * be an FESystem with spacedim components and DoFs at vertices.
+     *
+     * @param[in] mapping Mapping of the reference configuration.
+     *
+     * @param[in] nodes Node (i.e., vertex) numbers of the constrained nodes.
+     *
+     * @param[in] reference_points Reference positions of the nodes. If empty
+     * then the vertices of the Triangulation are used instead.
+     */
+    NodalSpringForce(const Quadrature<dim>              &quad,
+                     const double                        spring_constant,
+                     const DoFHandler<dim, spacedim>    &dof_handler,
+                     const Mapping<dim, spacedim>       &mapping,
+                     const std::vector<unsigned int>    &nodes,
+                     const std::vector<Point<spacedim>> &reference_points = {});
+
+    /**
+     * Get the update flags this force contribution requires for MechanicsValues
+     * objects. Since this force is never evaluated at quadrature points, this
+     * is MechanicsUpdateFlags::update_nothing.
+     */
+    virtual MechanicsUpdateFlags
+    get_mechanics_update_flags() const override;
+
+    virtual bool
+    is_volume_force() const override;
+
+    virtual bool
+    is_nodal_force() const override;
+
+    virtual void
+    add_nodal_load_vector(
+      const double                                      time,
+      const LinearAlgebra::distributed::Vector<double> &position,
+      const LinearAlgebra::distributed::Vector<double> &velocity,
+      LinearAlgebra::distributed::Vector<double> &force_rhs) const override;
+
+    /**
+     * Return the locally owned DoFs to which this force is applied, in
+     * ascending order.
+     */
+    const std::vector<types::global_dof_index> &
+    get_dofs() const;
+
+  protected:
+    double spring_constant;
+
+    /**
+     * Locally owned DoFs of the nodes, their reference positions, and
+     * spring_constant times their lumped masses.
+     */
+    std::vector<types::global_dof_index> dofs;
+
+    std::vector<double> reference_values;
+
+    std::vector<double> scaled_masses;
+  };
+
+  /**
+   * Spring force tethering points embedded in the part (e.g., sensors or the
+   * attachment points of discrete fibers; see EmbeddedPoints) to target
+   * positions: each point p, with current position X_p, is subject to the
+   * point force
+   *
+   * F_p = k (X_target_p - X_p)
+   *
+   * which is added directly to the load vector (see
+   * EmbeddedPoints::add_load_vector()) and is hence spread by the part's own
+   * interaction. Unlike NodalSpringForce the points need not be nodes and
+   * the spring constant is not scaled by a mass, i.e., it is a force per
+   * unit displacement for each point.
+   */
+  template <int dim, int spacedim = dim, typename Number = double>
+  class EmbeddedPointSpringForce
+    : public ForceContribution<dim, spacedim, double>
+  {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param[in] quad Quadrature rule. Since this force is never evaluated at
+     * quadrature points this is only used to classify the force.
+     *
+     * @param[in] dof_handler DoFHandler of the Part.
+     *
+     * @param[in] mapping Mapping of the reference configuration.
+     *
+     * @param[in] reference_points Reference positions of the points, which
+     * must be the same on every processor.
+     *
+     * @param[in] target_points Target positions of the points. If empty then
+     * @p reference_points are used instead.
+     */
+    EmbeddedPointSpringForce(
+      const Quadrature<dim>              &quad,
+      const double                        spring_constant,
+      const DoFHandler<dim, spacedim>    &dof_handler,
+      const Mapping<dim, spacedim>       &mapping,
+      const std::vector<Point<spacedim>> &reference_points,
+      const std::vector<Point<spacedim>> &target_points = {});
+
+    /**
+     * Get the update flags this force contribution requires for MechanicsValues
+     * objects. Since this force is never evaluated at quadrature points, this
+     * is MechanicsUpdateFlags::update_nothing.
+     */
+    virtual MechanicsUpdateFlags
+    get_mechanics_update_flags() const override;
+
+    virtual bool
+    is_volume_force() const override;
+
+    virtual bool
+    is_nodal_force() const override;
+
+    virtual void
+    add_nodal_load_vector(
+      const double                                      time,
+      const LinearAlgebra::distributed::Vector<double> &position,
+      const LinearAlgebra::distributed::Vector<double> &velocity,
+      LinearAlgebra::distributed::Vector<double> &force_rhs) const override;
+
+    /**
+     * Return the embedded points.
+     */
+    const EmbeddedPoints<dim, spacedim> &
+    get_embedded_points() const;
+
+  protected:
+    double spring_constant;
+
+    EmbeddedPoints<dim, spacedim> embedded_points;
+
+    /**
+     * Target positions of the locally owned points.
+     */
+    std::vector<Point<spacedim>> target_points;
+  };
+
   /**
    * Velocity damping force: applies a drag force directly proportional to the
    * present velocity field to enforce zero movement:
@@ -255,6 +456,18 @@ namespace fdl
       const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
       ArrayView<Tensor<1, spacedim, Number>> &forces) const override;
 
+    /**
+     * This force is mass-proportional if it is applied on every cell (i.e.,
+     * if no material ids were provided to the constructor).
+     */
+    virtual bool
+    is_mass_proportional() const override;
+
+    /**
+     * Return (0, -damping_constant).
+     */
+    virtual std::pair<double, double>
+    get_mass_proportional_coefficients(const double time) const override;
 
   protected:
     double damping_constant;
@@ -302,6 +515,12 @@ namespace fdl
     virtual bool
     is_boundary_force() const override;
 
+    /**
+     * Get the boundary ids on which this force is applied.
+     */
+    virtual std::vector<types::boundary_id>
+    get_boundary_ids() const override;
+
     /**
      * Compute the boundary force.
      */
@@ -382,6 +601,12 @@ namespace fdl
     virtual bool
     is_boundary_force() const override;
 
+    /**
+     * Get the boundary ids on which this force is applied.
+     */
+    virtual std::vector<types::boundary_id>
+    get_boundary_ids() const override;
+
     virtual void
     compute_boundary_force(
       const double                          time,
@@ -443,7 +668,46 @@ namespace fdl
       const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
       ArrayView<Tensor<2, spacedim, Number>> &stresses) const override;
 
+    /**
+     * This stress only depends on FF so it can be vectorized.
+     */
+    virtual bool
+    supports_vectorized_stress() const override;
+
+    virtual void
+    compute_vectorized_stress(
+      const double                                    time,
+      const VectorizedMechanicsValues<dim, spacedim> &me_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &stresses)
+      const override;
+
+    /**
+     * This stress implements its consistent tangent.
+     */
+    virtual bool
+    supports_stress_linearization() const override;
+
+    virtual void
+    compute_vectorized_linearized_stress(
+      const double                                    time,
+      const VectorizedMechanicsValues<dim, spacedim> &me_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      const ArrayView<const Tensor<2, spacedim, VectorizedArray<double>>> &dFF,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &dstresses)
+      const override;
+
   protected:
+    /**
+     * Implementation of both compute_stress() and compute_vectorized_stress().
+     */
+    template <typename MechanicsValuesType, typename StressNumber>
+    void
+    do_compute_stress(
+      const MechanicsValuesType &m_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      ArrayView<Tensor<2, spacedim, StressNumber>> &stresses) const;
+
     double shear_modulus;
 
     std::vector<types::material_id> material_ids;
@@ -500,7 +764,46 @@ namespace fdl
       const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
       ArrayView<Tensor<2, spacedim, Number>> &stresses) const override;
 
+    /**
+     * This stress only depends on FF so it can be vectorized.
+     */
+    virtual bool
+    supports_vectorized_stress() const override;
+
+    virtual void
+    compute_vectorized_stress(
+      const double                                    time,
+      const VectorizedMechanicsValues<dim, spacedim> &me_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &stresses)
+      const override;
+
+    /**
+     * This stress implements its consistent tangent.
+     */
+    virtual bool
+    supports_stress_linearization() const override;
+
+    virtual void
+    compute_vectorized_linearized_stress(
+      const double                                    time,
+      const VectorizedMechanicsValues<dim, spacedim> &me_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      const ArrayView<const Tensor<2, spacedim, VectorizedArray<double>>> &dFF,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &dstresses)
+      const override;
+
   protected:
+    /**
+     * Implementation of both compute_stress() and compute_vectorized_stress().
+     */
+    template <typename MechanicsValuesType, typename StressNumber>
+    void
+    do_compute_stress(
+      const MechanicsValuesType &m_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      ArrayView<Tensor<2, spacedim, StressNumber>> &stresses) const;
+
     double material_constant_1;
 
     double material_constant_2;
@@ -556,7 +859,46 @@ namespace fdl
       const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
       ArrayView<Tensor<2, spacedim, Number>> &stresses) const override;
 
+    /**
+     * This stress only depends on FF so it can be vectorized.
+     */
+    virtual bool
+    supports_vectorized_stress() const override;
+
+    virtual void
+    compute_vectorized_stress(
+      const double                                    time,
+      const VectorizedMechanicsValues<dim, spacedim> &me_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &stresses)
+      const override;
+
+    /**
+     * This stress implements its consistent tangent.
+     */
+    virtual bool
+    supports_stress_linearization() const override;
+
+    virtual void
+    compute_vectorized_linearized_stress(
+      const double                                    time,
+      const VectorizedMechanicsValues<dim, spacedim> &me_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      const ArrayView<const Tensor<2, spacedim, VectorizedArray<double>>> &dFF,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &dstresses)
+      const override;
+
   protected:
+    /**
+     * Implementation of both compute_stress() and compute_vectorized_stress().
+     */
+    template <typename MechanicsValuesType, typename StressNumber>
+    void
+    do_compute_stress(
+      const MechanicsValuesType &m_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      ArrayView<Tensor<2, spacedim, StressNumber>> &stresses) const;
+
     double bulk_modulus;
 
     std::vector<types::material_id> material_ids;
@@ -610,7 +952,46 @@ namespace fdl
       const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
       ArrayView<Tensor<2, spacedim, Number>> &stresses) const override;
 
+    /**
+     * This stress only depends on FF so it can be vectorized.
+     */
+    virtual bool
+    supports_vectorized_stress() const override;
+
+    virtual void
+    compute_vectorized_stress(
+      const double                                    time,
+      const VectorizedMechanicsValues<dim, spacedim> &me_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &stresses)
+      const override;
+
+    /**
+     * This stress implements its consistent tangent.
+     */
+    virtual bool
+    supports_stress_linearization() const override;
+
+    virtual void
+    compute_vectorized_linearized_stress(
+      const double                                    time,
+      const VectorizedMechanicsValues<dim, spacedim> &me_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      const ArrayView<const Tensor<2, spacedim, VectorizedArray<double>>> &dFF,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &dstresses)
+      const override;
+
   protected:
+    /**
+     * Implementation of both compute_stress() and compute_vectorized_stress().
+     */
+    template <typename MechanicsValuesType, typename StressNumber>
+    void
+    do_compute_stress(
+      const MechanicsValuesType &m_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      ArrayView<Tensor<2, spacedim, StressNumber>> &stresses) const;
+
     double bulk_modulus;
 
     std::vector<types::material_id> material_ids;
@@ -620,7 +1001,7 @@ namespace fdl
    * I4_i for one quadrature point
    */
   template <int spacedim, typename Number = double>
-  double
+  Number
   I4_i(const SymmetricTensor<2, spacedim, Number> CC,
        const Tensor<1, spacedim, Number>          fiber_i);
 
@@ -636,7 +1017,7 @@ namespace fdl
    * I8_ij for one quadrature point
    */
   template <int spacedim, typename Number = double>
-  double
+  Number
   I8_ij(const SymmetricTensor<2, spacedim, Number> CC,
         const Tensor<1, spacedim, Number>          fiber_i,
         const Tensor<1, spacedim, Number>          fiber_j);
@@ -705,7 +1086,46 @@ namespace fdl
       const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
       ArrayView<Tensor<2, spacedim, Number>> &stresses) const override;
 
+    /**
+     * This stress only depends on FF so it can be vectorized.
+     */
+    virtual bool
+    supports_vectorized_stress() const override;
+
+    virtual void
+    compute_vectorized_stress(
+      const double                                    time,
+      const VectorizedMechanicsValues<dim, spacedim> &me_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &stresses)
+      const override;
+
+    /**
+     * This stress implements its consistent tangent.
+     */
+    virtual bool
+    supports_stress_linearization() const override;
+
+    virtual void
+    compute_vectorized_linearized_stress(
+      const double                                    time,
+      const VectorizedMechanicsValues<dim, spacedim> &me_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      const ArrayView<const Tensor<2, spacedim, VectorizedArray<double>>> &dFF,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &dstresses)
+      const override;
+
   protected:
+    /**
+     * Implementation of both compute_stress() and compute_vectorized_stress().
+     */
+    template <typename MechanicsValuesType, typename StressNumber>
+    void
+    do_compute_stress(
+      const MechanicsValuesType &m_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      ArrayView<Tensor<2, spacedim, StressNumber>> &stresses) const;
+
     double       a;       // I1_bar parameter
     double       b;       // I1_bar parameter
     double       a_f;     // I4_f parameter
@@ -726,7 +1146,7 @@ namespace fdl
   // --------------------------- inline functions --------------------------- //
 
   template <int spacedim, typename Number>
-  inline double
+  inline Number
   I4_i(const SymmetricTensor<2, spacedim, Number> CC,
        const Tensor<1, spacedim, Number>          fiber_i)
   {
@@ -742,7 +1162,7 @@ namespace fdl
   }
 
   template <int spacedim, typename Number>
-  inline double
+  inline Number
   I8_ij(const SymmetricTensor<2, spacedim, Number> CC,
         const Tensor<1, spacedim, Number>          fiber_i,
         const Tensor<1, spacedim, Number>          fiber_j)
@@ -0,0 +1,165 @@
+#ifndef included_fiddle_mechanics_implicit_structure_solver_h
+#define included_fiddle_mechanics_implicit_structure_solver_h
+
+#include <fiddle/base/config.h>
+
+#include <fiddle/mechanics/force_contribution.h>
+#include <fiddle/mechanics/part.h>
+
+#include <deal.II/base/smartpointer.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <vector>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * Matrix-free Newton-Krylov solver for implicitly updating the position of
+   * a stiff Part.
+   *
+   * Explicitly evaluating the elastic force of a very stiff material (e.g.,
+   * one with a large JLogJVolumetricEnergyStress penalty) restricts the time
+   * step size of the whole simulation. This class instead computes the
+   * position X which solves the backward Euler problem
+   *
+   *     c M (X - X_0) = L(X)
+   *
+   * in which M is the mass matrix, L(X) is the load vector of the Part's
+   * stresses (see compute_volumetric_pk1_load_vector()), X_0 is the explicitly
+   * updated position, and c is a (typically large) coefficient with units of
+   * a damping coefficient per unit time, i.e., c = eta / dt. The structure is
+   * hence relaxed towards equilibrium with a drag coefficient eta. Since the
+   * force L(X) = c M (X - X_0) is bounded by the size of the correction, it
+   * remains stable for any stiffness. As c goes to infinity X approaches X_0,
+   * i.e., the explicit update.
+   *
+   * Each Newton step solves the linear system
+   *
+   *     (c M + K(X)) dX = L(X) - c M (X - X_0)
+   *
+   * with GMRES, in which K(X) is the tangent stiffness matrix computed from
+   * the consistent tangents of the material models (see
+   * compute_linearized_pk1_load_vector()). Neither M nor K(X) are assembled:
+   * both are applied with the Part's MatrixFree object. The linear systems are
+   * preconditioned with the inverse diagonal of c M.
+   *
+   * Only the stresses of the Part are treated implicitly, so all of them must
+   * implement ForceContribution::compute_vectorized_linearized_stress() and
+   * use the Part's quadrature rule. Other force contributions are ignored
+   * (i.e., they should be evaluated explicitly by the caller) and active
+   * strains are not supported - see is_supported().
+   */
+  template <int dim>
+  class ImplicitStructureSolver
+  {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param[in] part The Part whose position should be updated.
+     *
+     * @param[in] max_newton_iterations Maximum number of Newton steps.
+     *
+     * @param[in] newton_tolerance Newton's method converges when the norm of
+     * the residual is smaller than this value times the norm of the initial
+     * residual.
+     *
+     * @param[in] max_linear_iterations Maximum number of GMRES iterations
+     * per Newton step.
+     *
+     * @param[in] linear_tolerance Relative tolerance for the linear solves.
+     * Since this is an inexact Newton method, linear solves which do not
+     * converge to this tolerance are not treated as errors.
+     */
+    ImplicitStructureSolver(const Part<dim>   &part,
+                            const unsigned int max_newton_iterations = 10,
+                            const double       newton_tolerance      = 1e-8,
+                            const unsigned int max_linear_iterations = 100,
+                            const double       linear_tolerance      = 1e-2);
+
+    /**
+     * Return whether or not the force contributions of @p part can be
+     * treated implicitly by this class.
+     */
+    static bool
+    is_supported(const Part<dim> &part);
+
+    /**
+     * Solve the nonlinear system described in the class documentation.
+     *
+     * @param[in] time Time at which the stresses are evaluated.
+     *
+     * @param[in] mass_coefficient The coefficient c.
+     *
+     * @param[in] explicit_position The position X_0.
+     *
+     * @param[inout] position On input, the initial guess for Newton's method
+     * (typically X_0). On output, the solution.
+     *
+     * @return The number of Newton steps.
+     *
+     * @note Like the rest of fiddle, this function assumes that the force
+     * contributions have already been set up (see
+     * ForceContribution::setup_force()) at @p time.
+     */
+    unsigned int
+    solve(const double                                      time,
+          const double                                      mass_coefficient,
+          const LinearAlgebra::distributed::Vector<double> &explicit_position,
+          LinearAlgebra::distributed::Vector<double>       &position);
+
+    /**
+     * Compute <code>dst = (c M + K(X)) src</code> at the current Newton
+     * iterate. Used by the linear solver.
+     */
+    void
+    vmult(LinearAlgebra::distributed::Vector<double>       &dst,
+          const LinearAlgebra::distributed::Vector<double> &src) const;
+
+  protected:
+    /**
+     * Compute <code>residual = c M (X - X_0) - L(X)</code> at the current
+     * Newton iterate.
+     */
+    void
+    compute_residual(
+      const LinearAlgebra::distributed::Vector<double> &explicit_position,
+      LinearAlgebra::distributed::Vector<double>       &residual) const;
+
+    SmartPointer<const Part<dim>> part;
+
+    std::vector<ForceContribution<dim> *> stresses;
+
+    unsigned int max_newton_iterations;
+
+    double newton_tolerance;
+
+    unsigned int max_linear_iterations;
+
+    double linear_tolerance;
+
+    /**
+     * Data for the current solve.
+     */
+    double time;
+
+    double mass_coefficient;
+
+    /**
+     * Current Newton iterate, with ghost values.
+     */
+    LinearAlgebra::distributed::Vector<double> current_position;
+
+    /**
+     * Temporary vectors used by vmult().
+     */
+    mutable LinearAlgebra::distributed::Vector<double> ghosted_direction;
+
+    mutable LinearAlgebra::distributed::Vector<double> mass_direction;
+  };
+} // namespace fdl
+
+#endif
@@ -0,0 +1,575 @@
+#ifndef included_fiddle_mechanics_material_laws_h
+#define included_fiddle_mechanics_material_laws_h
+
+#include <fiddle/base/config.h>
+
+#include <fiddle/mechanics/fiber_network.h>
+#include <fiddle/mechanics/mechanics_values.h>
+
+#include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/grid/tria.h>
+
+#include <cmath>
+#include <memory>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * Pointwise versions of the material models implemented by the stress
+   * classes in force_contribution_lib.h. These are the building blocks of
+   * CompositeStress and are also used by the corresponding ForceContribution
+   * classes, so both always compute the same stresses.
+   *
+   * Every law provides
+   *
+   * - a static get_mechanics_update_flags() function returning the flags
+   *   required to evaluate the law,
+   * - a member template CellData<Number> and a function get_cell_data<Number>()
+   *   which sets up any data which is constant on a cell (e.g., fibers), and
+   * - a function get_stress<Number>() which evaluates the PK1 stress at one
+   *   quadrature point, and
+   * - a function get_stress_derivative<Number>() which evaluates the
+   *   directional derivative of the PK1 stress with respect to FF (i.e., the
+   *   consistent tangent applied to a perturbation of FF) at one quadrature
+   *   point, using the same MechanicsValues as get_stress().
+   *
+   * Number is either double or VectorizedArray<double>.
+   */
+  namespace MaterialLaws
+  {
+    /**
+     * Cell data for laws which do not need any.
+     */
+    struct NoCellData
+    {};
+
+    namespace internal
+    {
+      /**
+       * Fibers in the Holzapfel-Ogden model are turned off in compression
+       * (i.e., when I4 <= 1) unless fiber dispersion is used. Return @p
+       * coefficient where the fiber is active and zero otherwise.
+       */
+      inline double
+      fiber_tension_mask(const double kappa,
+                         const double I4,
+                         const double coefficient)
+      {
+        return (kappa != 0.0 || I4 > 1.0) ? coefficient : 0.0;
+      }
+
+      inline VectorizedArray<double>
+      fiber_tension_mask(const double                   kappa,
+                         const VectorizedArray<double> &I4,
+                         const VectorizedArray<double> &coefficient)
+      {
+        if (kappa != 0.0)
+          return coefficient;
+        return compare_and_apply_mask<SIMDComparison::greater_than>(
+          I4,
+          VectorizedArray<double>(1.0),
+          coefficient,
+          VectorizedArray<double>(0.0));
+      }
+
+      /**
+       * Directional derivative of J^{-2/3} (FF - I1 / 3 FF^-T), i.e., of the
+       * isochoric part of the neo-Hookean stress, in the direction @p dFF.
+       */
+      template <int spacedim, typename Number>
+      inline Tensor<2, spacedim, Number>
+      isochoric_derivative(const Number                      &J_n23,
+                           const Tensor<2, spacedim, Number> &FF,
+                           const Tensor<2, spacedim, Number> &FF_inv_T,
+                           const Number                      &I1,
+                           const Tensor<2, spacedim, Number> &dFF)
+      {
+        // dJ^{-2/3} = -2/3 J^{-2/3} FF^-T : dFF, dI1 = 2 FF : dFF, and
+        // dFF^-T = -FF^-T dFF^T FF^-T
+        const Number dlog_J = scalar_product(FF_inv_T, dFF);
+        const Number dI1    = 2.0 * scalar_product(FF, dFF);
+        return J_n23 * (-2.0 / 3.0 * dlog_J * (FF - I1 / 3.0 * FF_inv_T) +
+                        dFF - dI1 / 3.0 * FF_inv_T +
+                        I1 / 3.0 * (FF_inv_T * transpose(dFF) * FF_inv_T));
+      }
+    } // namespace internal
+
+    /**
+     * Modified Neo-Hookean material model - see ModifiedNeoHookeanStress.
+     */
+    template <int dim, int spacedim = dim>
+    class ModifiedNeoHookean
+    {
+    public:
+      template <typename Number>
+      using CellData = NoCellData;
+
+      ModifiedNeoHookean(const double shear_modulus)
+        : shear_modulus(shear_modulus)
+      {}
+
+      static MechanicsUpdateFlags
+      get_mechanics_update_flags()
+      {
+        return MechanicsUpdateFlags::update_n23_det_FF |
+               MechanicsUpdateFlags::update_FF |
+               MechanicsUpdateFlags::update_FF_inv_T |
+               MechanicsUpdateFlags::update_first_invariant;
+      }
+
+      template <typename Number>
+      CellData<Number>
+      get_cell_data(
+        const typename Triangulation<dim, spacedim>::active_cell_iterator &)
+        const
+      {
+        return {};
+      }
+
+      template <typename Number, typename MechanicsValuesType>
+      Tensor<2, spacedim, Number>
+      get_stress(const MechanicsValuesType &m_values,
+                 const CellData<Number> &,
+                 const unsigned int qp_n) const
+      {
+        return shear_modulus * m_values.get_n23_det_FF()[qp_n] *
+               (m_values.get_FF()[qp_n] - m_values.get_first_invariant()[qp_n] /
+                                            3.0 * m_values.get_FF_inv_T()[qp_n]);
+      }
+
+      template <typename Number, typename MechanicsValuesType>
+      Tensor<2, spacedim, Number>
+      get_stress_derivative(const MechanicsValuesType &m_values,
+                            const CellData<Number> &,
+                            const unsigned int                 qp_n,
+                            const Tensor<2, spacedim, Number> &dFF) const
+      {
+        const auto J_n23    = m_values.get_n23_det_FF()[qp_n];
+        const auto FF       = m_values.get_FF()[qp_n];
+        const auto FF_inv_T = m_values.get_FF_inv_T()[qp_n];
+        const auto I1       = m_values.get_first_invariant()[qp_n];
+
+        return shear_modulus *
+               internal::isochoric_derivative(J_n23, FF, FF_inv_T, I1, dFF);
+      }
+
+    private:
+      double shear_modulus;
+    };
+
+    /**
+     * Modified Mooney-Rivlin material model - see ModifiedMooneyRivlinStress.
+     */
+    template <int dim, int spacedim = dim>
+    class ModifiedMooneyRivlin
+    {
+    public:
+      template <typename Number>
+      using CellData = NoCellData;
+
+      ModifiedMooneyRivlin(const double material_constant_1,
+                           const double material_constant_2)
+        : material_constant_1(material_constant_1)
+        , material_constant_2(material_constant_2)
+      {}
+
+      static MechanicsUpdateFlags
+      get_mechanics_update_flags()
+      {
+        return MechanicsUpdateFlags::update_n23_det_FF |
+               MechanicsUpdateFlags::update_FF |
+               MechanicsUpdateFlags::update_FF_inv_T |
+               MechanicsUpdateFlags::update_first_invariant |
+               MechanicsUpdateFlags::update_second_invariant |
+               MechanicsUpdateFlags::update_right_cauchy_green;
+      }
+
+      template <typename Number>
+      CellData<Number>
+      get_cell_data(
+        const typename Triangulation<dim, spacedim>::active_cell_iterator &)
+        const
+      {
+        return {};
+      }
+
+      template <typename Number, typename MechanicsValuesType>
+      Tensor<2, spacedim, Number>
+      get_stress(const MechanicsValuesType &m_values,
+                 const CellData<Number> &,
+                 const unsigned int qp_n) const
+      {
+        const auto J_n23    = m_values.get_n23_det_FF()[qp_n];
+        const auto FF       = m_values.get_FF()[qp_n];
+        const auto FF_inv_T = m_values.get_FF_inv_T()[qp_n];
+        const auto CC       = m_values.get_right_cauchy_green()[qp_n];
+        const auto I1       = m_values.get_first_invariant()[qp_n];
+        const auto I2       = m_values.get_second_invariant()[qp_n];
+
+        return 2.0 * material_constant_1 * J_n23 * (FF - I1 / 3.0 * FF_inv_T) +
+               2.0 * material_constant_2 * J_n23 * J_n23 *
+                 (I1 * FF - FF * CC - 2.0 * I2 / 3.0 * FF_inv_T);
+      }
+
+      template <typename Number, typename MechanicsValuesType>
+      Tensor<2, spacedim, Number>
+      get_stress_derivative(const MechanicsValuesType &m_values,
+                            const CellData<Number> &,
+                            const unsigned int                 qp_n,
+                            const Tensor<2, spacedim, Number> &dFF) const
+      {
+        const auto J_n23    = m_values.get_n23_det_FF()[qp_n];
+        const auto FF       = m_values.get_FF()[qp_n];
+        const auto FF_inv_T = m_values.get_FF_inv_T()[qp_n];
+        const auto CC       = m_values.get_right_cauchy_green()[qp_n];
+        const auto I1       = m_values.get_first_invariant()[qp_n];
+        const auto I2       = m_values.get_second_invariant()[qp_n];
+
+        // dJ^{-4/3} = -4/3 J^{-4/3} FF^-T : dFF, dI2 = I1 dI1 - 2 FF CC : dFF
+        const Number dlog_J = scalar_product(FF_inv_T, dFF);
+        const Number dI1    = 2.0 * scalar_product(FF, dFF);
+        const Number dI2    = I1 * dI1 - 2.0 * scalar_product(FF * CC, dFF);
+        const Tensor<2, spacedim, Number> dCC =
+          transpose(dFF) * FF + transpose(FF) * dFF;
+        const Tensor<2, spacedim, Number> dFF_inv_T =
+          -(FF_inv_T * transpose(dFF) * FF_inv_T);
+
+        return 2.0 * material_constant_1 *
+                 internal::isochoric_derivative(J_n23, FF, FF_inv_T, I1, dFF) +
+               2.0 * material_constant_2 * J_n23 * J_n23 *
+                 (-4.0 / 3.0 * dlog_J *
+                    (I1 * FF - FF * CC - 2.0 * I2 / 3.0 * FF_inv_T) +
+                  dI1 * FF + I1 * dFF - dFF * CC - FF * dCC -
+                  2.0 * dI2 / 3.0 * FF_inv_T - 2.0 * I2 / 3.0 * dFF_inv_T);
+      }
+
+    private:
+      double material_constant_1;
+      double material_constant_2;
+    };
+
+    /**
+     * Linear times logarithmic volumetric stabilization - see
+     * JLogJVolumetricEnergyStress.
+     */
+    template <int dim, int spacedim = dim>
+    class JLogJVolumetricEnergy
+    {
+    public:
+      template <typename Number>
+      using CellData = NoCellData;
+
+      JLogJVolumetricEnergy(const double bulk_modulus)
+        : bulk_modulus(bulk_modulus)
+      {}
+
+      static MechanicsUpdateFlags
+      get_mechanics_update_flags()
+      {
+        return MechanicsUpdateFlags::update_det_FF |
+               MechanicsUpdateFlags::update_log_det_FF |
+               MechanicsUpdateFlags::update_FF_inv_T;
+      }
+
+      template <typename Number>
+      CellData<Number>
+      get_cell_data(
+        const typename Triangulation<dim, spacedim>::active_cell_iterator &)
+        const
+      {
+        return {};
+      }
+
+      template <typename Number, typename MechanicsValuesType>
+      Tensor<2, spacedim, Number>
+      get_stress(const MechanicsValuesType &m_values,
+                 const CellData<Number> &,
+                 const unsigned int qp_n) const
+      {
+        return bulk_modulus * m_values.get_det_FF()[qp_n] *
+               m_values.get_log_det_FF()[qp_n] * m_values.get_FF_inv_T()[qp_n];
+      }
+
+      template <typename Number, typename MechanicsValuesType>
+      Tensor<2, spacedim, Number>
+      get_stress_derivative(const MechanicsValuesType &m_values,
+                            const CellData<Number> &,
+                            const unsigned int                 qp_n,
+                            const Tensor<2, spacedim, Number> &dFF) const
+      {
+        const auto J        = m_values.get_det_FF()[qp_n];
+        const auto log_J    = m_values.get_log_det_FF()[qp_n];
+        const auto FF_inv_T = m_values.get_FF_inv_T()[qp_n];
+
+        // dJ = J FF^-T : dFF and dFF^-T = -FF^-T dFF^T FF^-T
+        return bulk_modulus * J *
+               ((log_J + 1.0) * scalar_product(FF_inv_T, dFF) * FF_inv_T -
+                log_J * (FF_inv_T * transpose(dFF) * FF_inv_T));
+      }
+
+    private:
+      double bulk_modulus;
+    };
+
+    /**
+     * Logarithmic volumetric stabilization - see
+     * LogarithmicVolumetricEnergyStress.
+     */
+    template <int dim, int spacedim = dim>
+    class LogarithmicVolumetricEnergy
+    {
+    public:
+      template <typename Number>
+      using CellData = NoCellData;
+
+      LogarithmicVolumetricEnergy(const double bulk_modulus)
+        : bulk_modulus(bulk_modulus)
+      {}
+
+      static MechanicsUpdateFlags
+      get_mechanics_update_flags()
+      {
+        return MechanicsUpdateFlags::update_log_det_FF |
+               MechanicsUpdateFlags::update_FF_inv_T;
+      }
+
+      template <typename Number>
+      CellData<Number>
+      get_cell_data(
+        const typename Triangulation<dim, spacedim>::active_cell_iterator &)
+        const
+      {
+        return {};
+      }
+
+      template <typename Number, typename MechanicsValuesType>
+      Tensor<2, spacedim, Number>
+      get_stress(const MechanicsValuesType &m_values,
+                 const CellData<Number> &,
+                 const unsigned int qp_n) const
+      {
+        return bulk_modulus * m_values.get_log_det_FF()[qp_n] *
+               m_values.get_FF_inv_T()[qp_n];
+      }
+
+      template <typename Number, typename MechanicsValuesType>
+      Tensor<2, spacedim, Number>
+      get_stress_derivative(const MechanicsValuesType &m_values,
+                            const CellData<Number> &,
+                            const unsigned int                 qp_n,
+                            const Tensor<2, spacedim, Number> &dFF) const
+      {
+        const auto log_J    = m_values.get_log_det_FF()[qp_n];
+        const auto FF_inv_T = m_values.get_FF_inv_T()[qp_n];
+
+        return bulk_modulus *
+               (scalar_product(FF_inv_T, dFF) * FF_inv_T -
+                log_J * (FF_inv_T * transpose(dFF) * FF_inv_T));
+      }
+
+    private:
+      double bulk_modulus;
+    };
+
+
+    /**
+     * Modified Holzapfel-Ogden material model - see HolzapfelOgdenStress.
+     */
+    template <int dim, int spacedim = dim>
+    class HolzapfelOgden
+    {
+    public:
+      /**
+       * The fibers only appear through the structural tensors sym(f (x) f),
+       * sym(s (x) s), and sym(f (x) s) since, e.g., I4_f = CC : (f (x) f) and
+       * dI4_f/dFF = 2 FF (f (x) f). These are set up once per cell so that
+       * get_stress() only does tensor-tensor products.
+       */
+      template <typename Number>
+      struct CellData
+      {
+        Tensor<2, spacedim, Number> M_ff;
+        Tensor<2, spacedim, Number> M_ss;
+        Tensor<2, spacedim, Number> M_fs;
+      };
+
+      HolzapfelOgden(
+        const double                                       a,
+        const double                                       b,
+        const double                                       a_f,
+        const double                                       b_f,
+        const double                                       kappa_f,
+        const unsigned int                                 index_f,
+        const double                                       a_s,
+        const double                                       b_s,
+        const double                                       kappa_s,
+        const unsigned int                                 index_s,
+        const double                                       a_fs,
+        const double                                       b_fs,
+        std::shared_ptr<const FiberNetwork<dim, spacedim>> fiber_network)
+        : a(a)
+        , b(b)
+        , a_f(a_f)
+        , b_f(b_f)
+        , kappa_f(kappa_f)
+        , index_f(index_f)
+        , a_s(a_s)
+        , b_s(b_s)
+        , kappa_s(kappa_s)
+        , index_s(index_s)
+        , a_fs(a_fs)
+        , b_fs(b_fs)
+        , fiber_network(fiber_network)
+      {}
+
+      static MechanicsUpdateFlags
+      get_mechanics_update_flags()
+      {
+        return MechanicsUpdateFlags::update_FF |
+               MechanicsUpdateFlags::update_modified_first_invariant |
+               MechanicsUpdateFlags::update_modified_first_invariant_dFF |
+               MechanicsUpdateFlags::update_right_cauchy_green;
+      }
+
+      template <typename Number>
+      CellData<Number>
+      get_cell_data(
+        const typename Triangulation<dim, spacedim>::active_cell_iterator
+          &cell) const
+      {
+        const auto get_structural_tensor =
+          [&](const unsigned int i, const unsigned int j)
+        {
+          return Tensor<2, spacedim, Number>(Tensor<2, spacedim>(
+            fiber_network->get_structural_tensor(cell, i, j)));
+        };
+        return {get_structural_tensor(index_f, index_f),
+                get_structural_tensor(index_s, index_s),
+                get_structural_tensor(index_f, index_s)};
+      }
+
+      template <typename Number, typename MechanicsValuesType>
+      Tensor<2, spacedim, Number>
+      get_stress(const MechanicsValuesType &m_values,
+                 const CellData<Number>    &cell_data,
+                 const unsigned int         qp_n) const
+      {
+        // convenience definitions
+        const auto I1_bar = m_values.get_modified_first_invariant()[qp_n];
+        const auto FF     = m_values.get_FF()[qp_n];
+        const auto CC     = m_values.get_right_cauchy_green()[qp_n];
+        const auto I1_bar_dFF =
+          m_values.get_modified_first_invariant_dFF()[qp_n];
+
+        // stress contribution, isotropic term
+        Tensor<2, spacedim, Number> stress =
+          (0.5 * a * std::exp(b * (I1_bar - 3.0))) * I1_bar_dFF;
+        // stress contribution, transversely isotropic term, fiber f
+        const Number I4_f = scalar_product(CC, cell_data.M_ff);
+        const Number E_f =
+          kappa_f * I1_bar + (1.0 - 3.0 * kappa_f) * I4_f - 1.0;
+        stress += internal::fiber_tension_mask(
+                    kappa_f, I4_f, a_f * std::exp(b_f * E_f * E_f) * E_f) *
+                  (kappa_f * I1_bar_dFF +
+                   (2.0 - 6.0 * kappa_f) * (FF * cell_data.M_ff));
+        // stress contribution, transversely isotropic term, fiber s
+        const Number I4_s = scalar_product(CC, cell_data.M_ss);
+        const Number E_s =
+          kappa_s * I1_bar + (1.0 - 3.0 * kappa_s) * I4_s - 1.0;
+        stress += internal::fiber_tension_mask(
+                    kappa_s, I4_s, a_s * std::exp(b_s * E_s * E_s) * E_s) *
+                  (kappa_s * I1_bar_dFF +
+                   (2.0 - 6.0 * kappa_s) * (FF * cell_data.M_ss));
+        // stress contribution, orthotropic term, fibers f and s
+        const Number I8_fs = scalar_product(CC, cell_data.M_fs);
+        stress += (2.0 * a_fs * I8_fs * std::exp(b_fs * I8_fs * I8_fs)) *
+                  (FF * cell_data.M_fs);
+
+        return stress;
+      }
+
+      template <typename Number, typename MechanicsValuesType>
+      Tensor<2, spacedim, Number>
+      get_stress_derivative(const MechanicsValuesType         &m_values,
+                            const CellData<Number>            &cell_data,
+                            const unsigned int                 qp_n,
+                            const Tensor<2, spacedim, Number> &dFF) const
+      {
+        // convenience definitions
+        const auto I1_bar = m_values.get_modified_first_invariant()[qp_n];
+        const auto FF     = m_values.get_FF()[qp_n];
+        const auto CC     = m_values.get_right_cauchy_green()[qp_n];
+        const auto I1_bar_dFF =
+          m_values.get_modified_first_invariant_dFF()[qp_n];
+
+        // The stress only needs the first derivative of I1_bar, so compute
+        // what we need for the second one here rather than requesting it
+        // (and paying for it in get_stress()) from MechanicsValues
+        const Tensor<2, spacedim, Number> FF_inv_T = transpose(invert(FF));
+        const Number J_n23 = std::pow(determinant(FF), -2.0 / 3.0);
+        const Tensor<2, spacedim, Number> dI1_bar_dFF =
+          2.0 *
+          internal::isochoric_derivative(J_n23, FF, FF_inv_T, trace(CC), dFF);
+        const Number dI1_bar = scalar_product(I1_bar_dFF, dFF);
+
+        // stress contribution, isotropic term
+        const Number c_iso = 0.5 * a * std::exp(b * (I1_bar - 3.0));
+        Tensor<2, spacedim, Number> dstress =
+          (b * c_iso * dI1_bar) * I1_bar_dFF + c_iso * dI1_bar_dFF;
+        // stress contributions, transversely isotropic terms: with
+        // E = kappa I1_bar + (1 - 3 kappa) I4 - 1 the stress is
+        // c(E) (kappa dI1_bar/dFF + (2 - 6 kappa) FF M)
+        const auto add_fiber = [&](const double                       a_k,
+                                   const double                       b_k,
+                                   const double                       kappa,
+                                   const Tensor<2, spacedim, Number> &M)
+        {
+          const Number I4  = scalar_product(CC, M);
+          const Number dI4 = 2.0 * scalar_product(FF * M, dFF);
+          const Number E   = kappa * I1_bar + (1.0 - 3.0 * kappa) * I4 - 1.0;
+          const Number dE  = kappa * dI1_bar + (1.0 - 3.0 * kappa) * dI4;
+          const Number exp_E = std::exp(b_k * E * E);
+          const Number c     = a_k * exp_E * E;
+          const Number dc    = a_k * exp_E * (1.0 + 2.0 * b_k * E * E) * dE;
+          dstress += internal::fiber_tension_mask(kappa, I4, dc) *
+                       (kappa * I1_bar_dFF + (2.0 - 6.0 * kappa) * (FF * M)) +
+                     internal::fiber_tension_mask(kappa, I4, c) *
+                       (kappa * dI1_bar_dFF + (2.0 - 6.0 * kappa) * (dFF * M));
+        };
+        add_fiber(a_f, b_f, kappa_f, cell_data.M_ff);
+        add_fiber(a_s, b_s, kappa_s, cell_data.M_ss);
+        // stress contribution, orthotropic term, fibers f and s
+        const Number I8_fs  = scalar_product(CC, cell_data.M_fs);
+        const Number dI8_fs = 2.0 * scalar_product(FF * cell_data.M_fs, dFF);
+        const Number exp_I8 = std::exp(b_fs * I8_fs * I8_fs);
+        dstress +=
+          (2.0 * a_fs * exp_I8 * (1.0 + 2.0 * b_fs * I8_fs * I8_fs) * dI8_fs) *
+            (FF * cell_data.M_fs) +
+          (2.0 * a_fs * I8_fs * exp_I8) * (dFF * cell_data.M_fs);
+
+        return dstress;
+      }
+
+    private:
+      double       a;       // I1_bar parameter
+      double       b;       // I1_bar parameter
+      double       a_f;     // I4_f parameter
+      double       b_f;     // I4_f parameter
+      double       kappa_f; // I4_f fiber dispersion
+      unsigned int index_f; // f index in the fiber network
+      double       a_s;     // I4_s parameter
+      double       b_s;     // I4_s parameter
+      double       kappa_s; // I4_s fiber dispersion
+      unsigned int index_s; // s index in the fiber network
+      double       a_fs;    // I8_fs parameter
+      double       b_fs;    // I8_fs parameter
+      std::shared_ptr<const FiberNetwork<dim, spacedim>> fiber_network;
+    };
+  } // namespace MaterialLaws
+} // namespace fdl
+
+#endif
@@ -0,0 +1,242 @@
+#ifndef included_fiddle_mechanics_mechanics_diagnostics_h
+#define included_fiddle_mechanics_mechanics_diagnostics_h
+
+#include <fiddle/base/config.h>
+
+#include <fiddle/mechanics/mechanics_values.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/quadrature.h>
+
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <mpi.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * Sink for scalar quantities (e.g., J, strain energy densities, fiber
+   * stretches, or active tensions) which should be monitored while a
+   * structure moves. When passed to compute_load_vector() the quantities
+   * are evaluated with the same MechanicsValues objects used to compute the
+   * forces, i.e., during force assembly instead of in a separate loop over
+   * the cells.
+   *
+   * Each quantity is a function which fills in its values at the quadrature
+   * points of one cell. For each quantity this class computes its integral,
+   * minimum, and maximum over the locally owned cells and, optionally, its
+   * average on each cell.
+   *
+   * Quantities are evaluated with the quadrature rule given to the
+   * constructor. compute_load_vector() evaluates them with the
+   * MechanicsValues object of the group of forces which use the same
+   * quadrature rule, if there is one, and with a separate MechanicsValues
+   * object in the same cell loop otherwise. Like the forces, the quantities
+   * see the elastic part of the deformation gradient on cells with an active
+   * strain.
+   */
+  template <int dim, int spacedim = dim>
+  class MechanicsDiagnostics
+  {
+  public:
+    /**
+     * Function computing the values of a quantity at the quadrature points of
+     * a cell.
+     */
+    using QuantityFunction = std::function<void(
+      const MechanicsValues<dim, spacedim> &,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &,
+      ArrayView<double> &)>;
+
+    /**
+     * Global statistics of one quantity.
+     */
+    struct Statistics
+    {
+      /**
+       * Integral of the quantity over the reference configuration.
+       */
+      double integral;
+
+      /**
+       * Minimum value at any quadrature point.
+       */
+      double min;
+
+      /**
+       * Maximum value at any quadrature point.
+       */
+      double max;
+
+      /**
+       * Measure of the reference configuration: integral / measure is the
+       * average value of the quantity.
+       */
+      double measure;
+    };
+
+    /**
+     * Constructor.
+     */
+    MechanicsDiagnostics(const Quadrature<dim> &quadrature);
+
+    /**
+     * Add a quantity and return its index. @p me_flags are the flags needed
+     * by @p function, which are added to those of the forces. If
+     * @p store_cell_values is true then the average value on each cell is
+     * also stored - see get_cell_values().
+     */
+    unsigned int
+    add_quantity(const std::string         &name,
+                 const MechanicsUpdateFlags me_flags,
+                 const QuantityFunction    &function,
+                 const bool                 store_cell_values = false);
+
+    /**
+     * Add det(FF), i.e., the ratio of the deformed and reference volumes, as
+     * a quantity named "J". Only valid when dim == spacedim.
+     */
+    unsigned int
+    add_det_FF(const bool store_cell_values = false);
+
+    /**
+     * Return the number of quantities.
+     */
+    unsigned int
+    n_quantities() const;
+
+    /**
+     * Return the name of a quantity.
+     */
+    const std::string &
+    get_name(const unsigned int quantity) const;
+
+    /**
+     * Return the quadrature rule used to evaluate the quantities.
+     */
+    const Quadrature<dim> &
+    get_quadrature() const;
+
+    /**
+     * Return the union of the flags of every quantity.
+     */
+    MechanicsUpdateFlags
+    get_mechanics_update_flags() const;
+
+    /**
+     * Clear the stored values and set up the per-cell vectors for
+     * @p tria. compute_load_vector() calls this function, so the stored
+     * values always correspond to the last call to that function.
+     */
+    void
+    reinit(const Triangulation<dim, spacedim> &tria);
+
+    /**
+     * Compute the values of every quantity on @p cell, where @p me_values has
+     * already been reinitialized on that cell, and write the cell's
+     * integrals, minima, and maxima to @p cell_results. This function is
+     * thread-safe: @p values is scratch space for the quadrature point
+     * values.
+     */
+    void
+    compute_cell_results(
+      const MechanicsValues<dim, spacedim> &me_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      std::vector<double> &values,
+      std::vector<double> &cell_results) const;
+
+    /**
+     * Add the results computed by compute_cell_results() on the cell with
+     * active cell index @p cell_index to the stored values.
+     */
+    void
+    add_cell_results(const unsigned int         cell_index,
+                     const std::vector<double> &cell_results);
+
+    /**
+     * Return the statistics of every quantity over the whole
+     * triangulation.
+     *
+     * @note This function is collective over the communicator of the
+     * triangulation.
+     */
+    std::vector<Statistics>
+    compute_statistics() const;
+
+    /**
+     * Return the average value of a quantity on each cell, indexed by active
+     * cell index, if it was added with store_cell_values = true. Entries
+     * which do not correspond to locally owned cells are zero.
+     */
+    const Vector<double> &
+    get_cell_values(const unsigned int quantity) const;
+
+  protected:
+    Quadrature<dim> quadrature;
+
+    MPI_Comm communicator;
+
+    std::vector<std::string> names;
+
+    MechanicsUpdateFlags me_flags;
+
+    std::vector<QuantityFunction> functions;
+
+    std::vector<bool> store_cell_values;
+
+    /**
+     * Measure of the locally owned cells.
+     */
+    double local_measure;
+
+    std::vector<double> local_integrals;
+
+    std::vector<double> local_mins;
+
+    std::vector<double> local_maxes;
+
+    std::vector<Vector<double>> cell_values;
+  };
+
+  // --------------------------- inline functions --------------------------- //
+
+  template <int dim, int spacedim>
+  inline unsigned int
+  MechanicsDiagnostics<dim, spacedim>::n_quantities() const
+  {
+    return functions.size();
+  }
+
+  template <int dim, int spacedim>
+  inline const std::string &
+  MechanicsDiagnostics<dim, spacedim>::get_name(
+    const unsigned int quantity) const
+  {
+    AssertIndexRange(quantity, n_quantities());
+    return names[quantity];
+  }
+
+  template <int dim, int spacedim>
+  inline const Quadrature<dim> &
+  MechanicsDiagnostics<dim, spacedim>::get_quadrature() const
+  {
+    return quadrature;
+  }
+
+  template <int dim, int spacedim>
+  inline MechanicsUpdateFlags
+  MechanicsDiagnostics<dim, spacedim>::get_mechanics_update_flags() const
+  {
+    return me_flags;
+  }
+} // namespace fdl
+
+#endif
@@ -3,11 +3,17 @@
 
 #include <fiddle/base/config.h>
 
+#include <fiddle/grid/boundary_faces.h>
+
 #include <fiddle/mechanics/active_strain.h>
 #include <fiddle/mechanics/force_contribution.h>
+#include <fiddle/mechanics/mechanics_diagnostics.h>
+#include <fiddle/mechanics/reference_shape_gradients.h>
 
 #include <deal.II/lac/la_parallel_vector.h>
 
+#include <deal.II/matrix_free/matrix_free.h>
+
 #include <vector>
 
 // forward declarations
@@ -26,6 +32,23 @@ namespace fdl
   /**
    * Compute the volumetric component of the PK1 stress and add it into the
    * given load vector.
+   *
+   * If @p matrix_free is not nullptr then stresses which only depend on the
+   * deformation gradient are evaluated with FEEvaluation and integrated with
+   * sum factorization instead of FEValues. This requires that @p matrix_free
+   * was set up with @p dof_handler, with a mapping equivalent to @p mapping,
+   * with the same quadrature rule as the stresses, and with a vector
+   * partitioner compatible with @p current_position and @p force_rhs. Groups
+   * of stresses which do not satisfy these requirements fall back to FEValues.
+   * If every stress in a group supports
+   * ForceContribution::compute_vectorized_stress() and every active strain
+   * supports ActiveStrain::supports_vectorized_strain() then the stresses and
+   * strains are evaluated at several quadrature points at once.
+   *
+   * Similarly, groups of stresses which only depend on the deformation
+   * gradient, are not used with active strains, and use the quadrature rule of
+   * one of the entries of @p reference_shape_gradients are evaluated with
+   * those precomputed values instead of FEValues.
    */
   template <int dim, int spacedim = dim>
   void
@@ -37,7 +60,36 @@ namespace fdl
     const double                                           time,
     const LinearAlgebra::distributed::Vector<double>      &current_position,
     const LinearAlgebra::distributed::Vector<double>      &current_velocity,
-    LinearAlgebra::distributed::Vector<double>            &force_rhs);
+    LinearAlgebra::distributed::Vector<double>            &force_rhs,
+    const MatrixFree<dim, double>                         *matrix_free =
+      nullptr,
+    const std::vector<const ReferenceShapeGradients<dim, spacedim> *>
+      &reference_shape_gradients = {});
+
+  /**
+   * Compute the derivative of the volumetric PK1 load vector (i.e., of the
+   * vector computed by compute_volumetric_pk1_load_vector()) with respect to
+   * the position at @p position, in the direction @p direction, and add it
+   * to @p dst. This is the negated action of the tangent stiffness matrix
+   *
+   *     \int dPP(FF; grad direction) : \nabla phi_i dx
+   *
+   * and is evaluated with sum factorization. Every entry of @p
+   * stress_contributions must be a stress which only depends on FF and
+   * implements ForceContribution::compute_vectorized_linearized_stress(), and
+   * @p matrix_free must use the quadrature rule of every stress and have a
+   * vector partitioner compatible with the given vectors. Active strains are
+   * not supported.
+   */
+  template <int dim>
+  void
+  compute_linearized_pk1_load_vector(
+    const MatrixFree<dim, double>                    &matrix_free,
+    const std::vector<ForceContribution<dim, dim> *> &stress_contributions,
+    const double                                      time,
+    const LinearAlgebra::distributed::Vector<double> &position,
+    const LinearAlgebra::distributed::Vector<double> &direction,
+    LinearAlgebra::distributed::Vector<double>       &dst);
 
   /**
    * Compute the contribution of volumetric forces and add them to the given
@@ -57,6 +109,11 @@ namespace fdl
   /**
    * Compute the contribution of boundary forces and add them to the given load
    * vector.
+   *
+   * Faces whose boundary ids are not returned by
+   * ForceContribution::get_boundary_ids() for any force are skipped. If @p
+   * boundary_faces is not nullptr then only the cells it stores are visited,
+   * rather than every active cell.
    */
   template <int dim, int spacedim = dim>
   void
@@ -67,10 +124,38 @@ namespace fdl
     const double                                           time,
     const LinearAlgebra::distributed::Vector<double>      &current_position,
     const LinearAlgebra::distributed::Vector<double>      &current_velocity,
-    LinearAlgebra::distributed::Vector<double>            &force_rhs);
+    LinearAlgebra::distributed::Vector<double>            &force_rhs,
+    const BoundaryFaces<dim, spacedim>                    *boundary_faces =
+      nullptr);
 
   /**
-   * Combined function that calls all of the previous functions.
+   * Combined function that computes all of the contributions of the previous
+   * functions. @p matrix_free and @p reference_shape_gradients have the same
+   * meaning as in compute_volumetric_pk1_load_vector() and @p boundary_faces
+   * has the same meaning as in compute_boundary_force_load_vector().
+   *
+   * Volume forces which are finite element fields (i.e., which implement
+   * ForceContribution::get_volume_force_dof_values()) or are linear
+   * combinations of the position and velocity (i.e., for which
+   * ForceContribution::is_mass_proportional() is true) are summed and
+   * assembled as a single mass matrix-vector product with @p matrix_free when
+   * it is compatible with their quadrature rule and DoF values. Nodal forces
+   * (i.e., volume forces for which ForceContribution::is_nodal_force() is
+   * true) are added directly to the load vector.
+   *
+   * Contributions which are not computed with @p matrix_free are computed in
+   * a single pass over the cells: on each cell, all contributions sharing a
+   * quadrature rule are evaluated with one MechanicsValues object (whose
+   * flags are the union of the flags of those contributions), stresses and
+   * forces are summed at quadrature points before being tested, and the
+   * volumetric and boundary contributions are added to the load vector
+   * together.
+   *
+   * If @p diagnostics is not nullptr then its quantities are computed in the
+   * same cell loop, from the MechanicsValues of the group of forces with the
+   * same quadrature rule (if there is one), and its previous values are
+   * overwritten. That group is always evaluated with FEValues, i.e., it does
+   * not use @p matrix_free or @p reference_shape_gradients.
    */
   template <int dim, int spacedim = dim>
   void
@@ -82,7 +167,15 @@ namespace fdl
     const double                                           time,
     const LinearAlgebra::distributed::Vector<double>      &current_position,
     const LinearAlgebra::distributed::Vector<double>      &current_velocity,
-    LinearAlgebra::distributed::Vector<double>            &force_rhs);
+    LinearAlgebra::distributed::Vector<double>            &force_rhs,
+    const MatrixFree<dim, double>                         *matrix_free =
+      nullptr,
+    const std::vector<const ReferenceShapeGradients<dim, spacedim> *>
+      &reference_shape_gradients = {},
+    const BoundaryFaces<dim, spacedim>                    *boundary_faces =
+      nullptr,
+    MechanicsDiagnostics<dim, spacedim>                   *diagnostics =
+      nullptr);
 } // namespace fdl
 
 #endif
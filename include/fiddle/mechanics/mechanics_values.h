@@ -8,6 +8,7 @@
 #include <deal.II/base/subscriptor.h>
 #include <deal.II/base/symmetric_tensor.h>
 #include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
 
 #include <deal.II/fe/fe_values.h>
 
@@ -183,10 +184,17 @@ namespace fdl
    * values computed in the reference configuration (e.g., locations of
    * quadrature points on an element in the reference cell), then use the
    * FEValuesBase object.
+   *
+   * @p Number is the type used to store values at quadrature points. The
+   * default, double, supports every feature of this class. Setting it to
+   * VectorizedArray<double> stores several quadrature points in each entry:
+   * this is only supported by the constructor and reinit() function which use
+   * precomputed values of FF. See VectorizedMechanicsValues.
    */
   template <int dim,
             int spacedim        = dim,
-            typename VectorType = LinearAlgebra::distributed::Vector<double>>
+            typename VectorType = LinearAlgebra::distributed::Vector<double>,
+            typename Number     = double>
   class MechanicsValues
   {
   public:
@@ -234,60 +242,60 @@ namespace fdl
      * set up to compute displacements, velocities, or deformed normal vectors.
      */
     void
-    reinit(const std::vector<Tensor<2, spacedim>> &provided_FF);
+    reinit(const std::vector<Tensor<2, spacedim, Number>> &provided_FF);
 
     const FEValuesBase<dim, spacedim> &
     get_fe_values() const;
 
-    const std::vector<Tensor<2, spacedim>> &
+    const std::vector<Tensor<2, spacedim, Number>> &
     get_FF() const;
 
-    const std::vector<Tensor<2, spacedim>> &
+    const std::vector<Tensor<2, spacedim, Number>> &
     get_FF_inv_T() const;
 
-    const std::vector<double> &
+    const std::vector<Number> &
     get_det_FF() const;
 
-    const std::vector<double> &
+    const std::vector<Number> &
     get_n23_det_FF() const;
 
-    const std::vector<double> &
+    const std::vector<Number> &
     get_log_det_FF() const;
 
-    const std::vector<Tensor<1, spacedim>> &
+    const std::vector<Tensor<1, spacedim, Number>> &
     get_deformed_normal_vectors() const;
 
-    const std::vector<Tensor<1, spacedim>> &
+    const std::vector<Tensor<1, spacedim, Number>> &
     get_position_values() const;
 
-    const std::vector<Tensor<1, spacedim>> &
+    const std::vector<Tensor<1, spacedim, Number>> &
     get_velocity_values() const;
 
-    const std::vector<SymmetricTensor<2, spacedim>> &
+    const std::vector<SymmetricTensor<2, spacedim, Number>> &
     get_right_cauchy_green() const;
 
-    const std::vector<SymmetricTensor<2, spacedim>> &
+    const std::vector<SymmetricTensor<2, spacedim, Number>> &
     get_green() const;
 
-    const std::vector<double> &
+    const std::vector<Number> &
     get_first_invariant() const;
 
-    const std::vector<double> &
+    const std::vector<Number> &
     get_modified_first_invariant() const;
 
-    const std::vector<double> &
+    const std::vector<Number> &
     get_second_invariant() const;
 
-    const std::vector<double> &
+    const std::vector<Number> &
     get_modified_second_invariant() const;
 
-    const std::vector<double> &
+    const std::vector<Number> &
     get_third_invariant() const;
 
-    const std::vector<Tensor<2, spacedim>> &
+    const std::vector<Tensor<2, spacedim, Number>> &
     get_first_invariant_dFF() const;
 
-    const std::vector<Tensor<2, spacedim>> &
+    const std::vector<Tensor<2, spacedim, Number>> &
     get_modified_first_invariant_dFF() const;
 
   protected:
@@ -311,41 +319,41 @@ namespace fdl
 
     MechanicsUpdateFlags update_flags;
 
-    std::vector<Tensor<2, spacedim>> FF;
+    std::vector<Tensor<2, spacedim, Number>> FF;
 
-    std::vector<Tensor<2, spacedim>> FF_inv_T;
+    std::vector<Tensor<2, spacedim, Number>> FF_inv_T;
 
-    std::vector<double> det_FF;
+    std::vector<Number> det_FF;
 
-    std::vector<double> n23_det_FF;
+    std::vector<Number> n23_det_FF;
 
-    std::vector<double> log_det_FF;
+    std::vector<Number> log_det_FF;
 
-    std::vector<Tensor<1, spacedim>> deformed_normal_vectors;
+    std::vector<Tensor<1, spacedim, Number>> deformed_normal_vectors;
 
-    std::vector<Tensor<1, spacedim>> position_values;
+    std::vector<Tensor<1, spacedim, Number>> position_values;
 
-    std::vector<Tensor<1, spacedim>> velocity_values;
+    std::vector<Tensor<1, spacedim, Number>> velocity_values;
 
-    std::vector<SymmetricTensor<2, spacedim>> right_cauchy_green;
+    std::vector<SymmetricTensor<2, spacedim, Number>> right_cauchy_green;
 
-    std::vector<SymmetricTensor<2, spacedim>> green;
+    std::vector<SymmetricTensor<2, spacedim, Number>> green;
 
-    std::vector<double> first_invariant;
+    std::vector<Number> first_invariant;
 
-    std::vector<double> modified_first_invariant;
+    std::vector<Number> modified_first_invariant;
 
-    std::vector<double> second_invariant;
+    std::vector<Number> second_invariant;
 
-    std::vector<double> modified_second_invariant;
+    std::vector<Number> modified_second_invariant;
 
-    std::vector<double> third_invariant;
+    std::vector<Number> third_invariant;
 
-    std::vector<Tensor<2, spacedim>> first_invariant_dFF;
+    std::vector<Tensor<2, spacedim, Number>> first_invariant_dFF;
 
-    std::vector<Tensor<2, spacedim>> modified_first_invariant_dFF;
+    std::vector<Tensor<2, spacedim, Number>> modified_first_invariant_dFF;
 
-    std::vector<Tensor<2, spacedim>> scratch_FF;
+    std::vector<Tensor<2, spacedim, Number>> scratch_FF;
 
     std::vector<types::global_dof_index> scratch_dof_indices;
 
@@ -354,166 +362,185 @@ namespace fdl
     std::vector<double> scratch_velocity_values;
   };
 
+  /**
+   * MechanicsValues which stores VectorizedArray<double>::size() quadrature
+   * points in each entry. Used by
+   * ForceContribution::compute_vectorized_stress().
+   */
+  template <int dim, int spacedim = dim>
+  using VectorizedMechanicsValues =
+    MechanicsValues<dim,
+                    spacedim,
+                    LinearAlgebra::distributed::Vector<double>,
+                    VectorizedArray<double>>;
+
 
   // --------------------------- inline functions --------------------------- //
 
 
-  template <int dim, int spacedim, typename VectorType>
+  template <int dim, int spacedim, typename VectorType, typename Number>
   inline const FEValuesBase<dim, spacedim> &
-  MechanicsValues<dim, spacedim, VectorType>::get_fe_values() const
+  MechanicsValues<dim, spacedim, VectorType, Number>::get_fe_values() const
   {
     return *fe_values;
   }
 
   // Access functions
 
-  template <int dim, int spacedim, typename VectorType>
-  inline const std::vector<Tensor<2, spacedim>> &
-  MechanicsValues<dim, spacedim, VectorType>::get_FF() const
+  template <int dim, int spacedim, typename VectorType, typename Number>
+  inline const std::vector<Tensor<2, spacedim, Number>> &
+  MechanicsValues<dim, spacedim, VectorType, Number>::get_FF() const
   {
     Assert(update_flags & update_FF, ExcMessage("Needs update_FF"));
     return FF;
   }
 
-  template <int dim, int spacedim, typename VectorType>
-  inline const std::vector<Tensor<2, spacedim>> &
-  MechanicsValues<dim, spacedim, VectorType>::get_FF_inv_T() const
+  template <int dim, int spacedim, typename VectorType, typename Number>
+  inline const std::vector<Tensor<2, spacedim, Number>> &
+  MechanicsValues<dim, spacedim, VectorType, Number>::get_FF_inv_T() const
   {
     Assert(update_flags & update_FF_inv_T, ExcMessage("Needs update_FF_inv_T"));
     return FF_inv_T;
   }
 
-  template <int dim, int spacedim, typename VectorType>
-  inline const std::vector<double> &
-  MechanicsValues<dim, spacedim, VectorType>::get_det_FF() const
+  template <int dim, int spacedim, typename VectorType, typename Number>
+  inline const std::vector<Number> &
+  MechanicsValues<dim, spacedim, VectorType, Number>::get_det_FF() const
   {
     Assert(update_flags & update_det_FF, ExcMessage("Needs update_det_FF"));
     return det_FF;
   }
 
-  template <int dim, int spacedim, typename VectorType>
-  inline const std::vector<double> &
-  MechanicsValues<dim, spacedim, VectorType>::get_n23_det_FF() const
+  template <int dim, int spacedim, typename VectorType, typename Number>
+  inline const std::vector<Number> &
+  MechanicsValues<dim, spacedim, VectorType, Number>::get_n23_det_FF() const
   {
     Assert(update_flags & update_n23_det_FF,
            ExcMessage("Needs update_n23_det_FF"));
     return n23_det_FF;
   }
 
-  template <int dim, int spacedim, typename VectorType>
-  inline const std::vector<double> &
-  MechanicsValues<dim, spacedim, VectorType>::get_log_det_FF() const
+  template <int dim, int spacedim, typename VectorType, typename Number>
+  inline const std::vector<Number> &
+  MechanicsValues<dim, spacedim, VectorType, Number>::get_log_det_FF() const
   {
     Assert(update_flags & update_log_det_FF,
            ExcMessage("Needs update_log_det_FF"));
     return log_det_FF;
   }
 
-  template <int dim, int spacedim, typename VectorType>
-  inline const std::vector<Tensor<1, spacedim>> &
-  MechanicsValues<dim, spacedim, VectorType>::get_deformed_normal_vectors()
-    const
+  template <int dim, int spacedim, typename VectorType, typename Number>
+  inline const std::vector<Tensor<1, spacedim, Number>> &
+  MechanicsValues<dim, spacedim, VectorType, Number>::
+    get_deformed_normal_vectors() const
   {
     Assert(update_flags & update_deformed_normal_vectors,
            ExcMessage("Needs update_deformed_normal_vectors"));
     return deformed_normal_vectors;
   }
 
-  template <int dim, int spacedim, typename VectorType>
-  inline const std::vector<Tensor<1, spacedim>> &
-  MechanicsValues<dim, spacedim, VectorType>::get_position_values() const
+  template <int dim, int spacedim, typename VectorType, typename Number>
+  inline const std::vector<Tensor<1, spacedim, Number>> &
+  MechanicsValues<dim, spacedim, VectorType, Number>::
+    get_position_values() const
   {
     Assert(update_flags & update_position_values,
            ExcMessage("Needs update_position_values"));
     return position_values;
   }
 
-  template <int dim, int spacedim, typename VectorType>
-  inline const std::vector<Tensor<1, spacedim>> &
-  MechanicsValues<dim, spacedim, VectorType>::get_velocity_values() const
+  template <int dim, int spacedim, typename VectorType, typename Number>
+  inline const std::vector<Tensor<1, spacedim, Number>> &
+  MechanicsValues<dim, spacedim, VectorType, Number>::
+    get_velocity_values() const
   {
     Assert(update_flags & update_velocity_values,
            ExcMessage("Needs update_velocity_values"));
     return velocity_values;
   }
 
-  template <int dim, int spacedim, typename VectorType>
-  inline const std::vector<SymmetricTensor<2, spacedim>> &
-  MechanicsValues<dim, spacedim, VectorType>::get_right_cauchy_green() const
+  template <int dim, int spacedim, typename VectorType, typename Number>
+  inline const std::vector<SymmetricTensor<2, spacedim, Number>> &
+  MechanicsValues<dim, spacedim, VectorType, Number>::
+    get_right_cauchy_green() const
   {
     Assert(update_flags & update_right_cauchy_green,
            ExcMessage("Needs update_right_cauchy_green"));
     return right_cauchy_green;
   }
 
-  template <int dim, int spacedim, typename VectorType>
-  inline const std::vector<SymmetricTensor<2, spacedim>> &
-  MechanicsValues<dim, spacedim, VectorType>::get_green() const
+  template <int dim, int spacedim, typename VectorType, typename Number>
+  inline const std::vector<SymmetricTensor<2, spacedim, Number>> &
+  MechanicsValues<dim, spacedim, VectorType, Number>::get_green() const
   {
     Assert(update_flags & update_green, ExcMessage("Needs update_green"));
     return green;
   }
 
-  template <int dim, int spacedim, typename VectorType>
-  inline const std::vector<double> &
-  MechanicsValues<dim, spacedim, VectorType>::get_first_invariant() const
+  template <int dim, int spacedim, typename VectorType, typename Number>
+  inline const std::vector<Number> &
+  MechanicsValues<dim, spacedim, VectorType, Number>::
+    get_first_invariant() const
   {
     Assert(update_flags & update_first_invariant,
            ExcMessage("Needs update_first_invariant"));
     return first_invariant;
   }
 
-  template <int dim, int spacedim, typename VectorType>
-  inline const std::vector<double> &
-  MechanicsValues<dim, spacedim, VectorType>::get_modified_first_invariant()
-    const
+  template <int dim, int spacedim, typename VectorType, typename Number>
+  inline const std::vector<Number> &
+  MechanicsValues<dim, spacedim, VectorType, Number>::
+    get_modified_first_invariant() const
   {
     Assert(update_flags & update_modified_first_invariant,
            ExcMessage("Needs update_modified_first_invariant"));
     return modified_first_invariant;
   }
 
-  template <int dim, int spacedim, typename VectorType>
-  inline const std::vector<double> &
-  MechanicsValues<dim, spacedim, VectorType>::get_second_invariant() const
+  template <int dim, int spacedim, typename VectorType, typename Number>
+  inline const std::vector<Number> &
+  MechanicsValues<dim, spacedim, VectorType, Number>::
+    get_second_invariant() const
   {
     Assert(update_flags & update_second_invariant,
            ExcMessage("Needs update_second_invariant"));
     return second_invariant;
   }
 
-  template <int dim, int spacedim, typename VectorType>
-  inline const std::vector<double> &
-  MechanicsValues<dim, spacedim, VectorType>::get_modified_second_invariant()
-    const
+  template <int dim, int spacedim, typename VectorType, typename Number>
+  inline const std::vector<Number> &
+  MechanicsValues<dim, spacedim, VectorType, Number>::
+    get_modified_second_invariant() const
   {
     Assert(update_flags & update_modified_second_invariant,
            ExcMessage("Needs update_modified_second_invariant"));
     return modified_second_invariant;
   }
 
-  template <int dim, int spacedim, typename VectorType>
-  inline const std::vector<double> &
-  MechanicsValues<dim, spacedim, VectorType>::get_third_invariant() const
+  template <int dim, int spacedim, typename VectorType, typename Number>
+  inline const std::vector<Number> &
+  MechanicsValues<dim, spacedim, VectorType, Number>::
+    get_third_invariant() const
   {
     Assert(update_flags & update_third_invariant,
            ExcMessage("Needs update_third_invariant"));
     return third_invariant;
   }
 
-  template <int dim, int spacedim, typename VectorType>
-  inline const std::vector<Tensor<2, spacedim>> &
-  MechanicsValues<dim, spacedim, VectorType>::get_first_invariant_dFF() const
+  template <int dim, int spacedim, typename VectorType, typename Number>
+  inline const std::vector<Tensor<2, spacedim, Number>> &
+  MechanicsValues<dim, spacedim, VectorType, Number>::
+    get_first_invariant_dFF() const
   {
     Assert(update_flags & update_first_invariant_dFF,
            ExcMessage("Needs update_first_invariant_dFF"));
     return first_invariant_dFF;
   }
 
-  template <int dim, int spacedim, typename VectorType>
-  inline const std::vector<Tensor<2, spacedim>> &
-  MechanicsValues<dim, spacedim, VectorType>::get_modified_first_invariant_dFF()
-    const
+  template <int dim, int spacedim, typename VectorType, typename Number>
+  inline const std::vector<Tensor<2, spacedim, Number>> &
+  MechanicsValues<dim, spacedim, VectorType, Number>::
+    get_modified_first_invariant_dFF() const
   {
     Assert(update_flags & update_modified_first_invariant_dFF,
            ExcMessage("Needs update_modified_first_invariant_dFF"));
@@ -5,9 +5,13 @@
 
 #include <fiddle/base/exceptions.h>
 
+#include <fiddle/grid/boundary_faces.h>
+
 #include <fiddle/mechanics/active_strain.h>
 #include <fiddle/mechanics/force_contribution.h>
 #include <fiddle/mechanics/mechanics_values.h>
+#include <fiddle/mechanics/part_geometry.h>
+#include <fiddle/mechanics/reference_shape_gradients.h>
 
 #include <deal.II/base/bounding_box.h>
 #include <deal.II/base/function.h>
@@ -17,6 +21,7 @@
 
 #include <deal.II/grid/tria.h>
 
+#include <deal.II/lac/diagonal_matrix.h>
 #include <deal.II/lac/la_parallel_vector.h>
 #include <deal.II/lac/precondition.h>
 
@@ -30,6 +35,8 @@ FDL_ENABLE_EXTRA_DIAGNOSTICS
 
 #include <mpi.h>
 
+#include <cstdint>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -75,14 +82,28 @@ namespace fdl
    * The primary intent of this class it to encapsulate the state of the finite
    * element discretization in a single place. This class is responsible for
    * managing the current position and velocity of a structure, as well as all
-   * the finite element book-keeping (e.g., the mass operator).
+   * the finite element book-keeping (e.g., the mass operator). The
+   * book-keeping which does not depend on the state of the structure is
+   * stored in a PartGeometry object, which may be shared by several parts.
+   *
+   * This class only uses locally owned and ghost cells, so it works with any
+   * parallel Triangulation. However, the interaction code (i.e.,
+   * InteractionBase, OverlapTriangulation, and functions like
+   * collect_all_active_cell_bboxes()) requires that every processor store the
+   * entire mesh, so parts used with IFEDMethodBase and its derived classes
+   * must use a parallel::shared::Triangulation.
+   *
+   * The Triangulation may be locally refined (see, e.g.,
+   * refine_and_coarsen_part()). In that case the position and velocity are
+   * kept continuous at hanging nodes and the mass solves condense the force
+   * and velocity right-hand sides with the hanging node constraints (see
+   * PartGeometry::get_constraints()).
    *
    * @todo In the future we should add an API that allows users to merge in
-   * their own constraints to the position, force, or displacement systems. This
-   * class also needs to learn how to set up hanging node constraints. This
-   * might not be trivial - if we constrain the position space then that implies
-   * constraints on the velocity space. This might also raise adjointness
-   * concerns.
+   * their own constraints to the position, force, or displacement systems.
+   * This might not be trivial - if we constrain the position space then that
+   * implies constraints on the velocity space. This might also raise
+   * adjointness concerns.
    */
   template <int dim, int spacedim = dim>
   class Part : public Subscriptor
@@ -149,6 +170,57 @@ namespace fdl
       const Function<spacedim> &initial_velocity =
         Functions::ZeroFunction<spacedim>(spacedim));
 
+    /**
+     * Constructor with a PartGeometry, which may be shared with other parts
+     * (see get_geometry()). Nothing besides the position and velocity is set
+     * up, so this is much cheaper than the other constructors.
+     */
+    Part(
+      std::shared_ptr<PartGeometry<dim, spacedim>> geometry,
+      std::vector<std::unique_ptr<ForceContribution<dim, spacedim>>>
+        force_contributions = {},
+      std::vector<std::unique_ptr<ActiveStrain<dim, spacedim>>>
+                                active_strains = {},
+      const Function<spacedim> &initial_position =
+        Functions::IdentityFunction<spacedim>(),
+      const Function<spacedim> &initial_velocity =
+        Functions::ZeroFunction<spacedim>(spacedim));
+
+    /**
+     * Constructor, which creates a parallel::shared::Triangulation from a
+     * mesh stored in memory. See the corresponding PartGeometry constructor
+     * for more information: in particular, the Triangulation is owned by the
+     * PartGeometry of this object.
+     */
+    Part(
+      const MPI_Comm                      communicator,
+      PartMeshData<dim, spacedim>       &&mesh_data,
+      const FiniteElement<dim, spacedim> &fe,
+      std::vector<std::unique_ptr<ForceContribution<dim, spacedim>>>
+        force_contributions = {},
+      std::vector<std::unique_ptr<ActiveStrain<dim, spacedim>>>
+                                active_strains = {},
+      const Function<spacedim> &initial_position =
+        Functions::IdentityFunction<spacedim>(),
+      const Function<spacedim> &initial_velocity =
+        Functions::ZeroFunction<spacedim>(spacedim));
+
+    /**
+     * Constructor for a member of an ensemble of parts which only differ in
+     * their force contributions and active strains (e.g., material
+     * parameters). The new part shares the PartGeometry of @p other (i.e.,
+     * the Triangulation, DoFHandler, MatrixFree object, and mass operator)
+     * and starts with copies of its current position and velocity.
+     *
+     * Since they share a mass operator, IFEDMethod solves the mass systems of
+     * ensemble members at once (see has_same_mass_operator()).
+     */
+    Part(const Part<dim, spacedim> &other,
+         std::vector<std::unique_ptr<ForceContribution<dim, spacedim>>>
+           force_contributions,
+         std::vector<std::unique_ptr<ActiveStrain<dim, spacedim>>>
+           active_strains = {});
+
 
     /**
      * Save the current state of the object to an archive.
@@ -178,6 +250,13 @@ namespace fdl
      */
     Part(Part<dim, spacedim> &&part) = default;
 
+    /**
+     * Get the PartGeometry, which may be used to set up other parts on the
+     * same Triangulation with the same FiniteElement.
+     */
+    std::shared_ptr<PartGeometry<dim, spacedim>>
+    get_geometry() const;
+
     /**
      * Get a constant reference to the Triangulation.
      */
@@ -212,6 +291,27 @@ namespace fdl
     add_force_contribution(
       std::unique_ptr<ForceContribution<dim, spacedim>> force);
 
+    /**
+     * Precompute the shape function gradients and JxW values on the reference
+     * configuration for @p quadrature. Since the Triangulation of a Part does
+     * not change these are valid for the entire simulation.
+     *
+     * compute_load_vector() evaluates groups of stresses which use @p
+     * quadrature, and only depend on the deformation gradient, with these
+     * values instead of FEValues. This trades memory (see
+     * ReferenceShapeGradients::memory_consumption()) for speed and is most
+     * useful for stresses whose quadrature rule differs from the one returned
+     * by get_quadrature(), since those cannot use get_matrix_free().
+     */
+    void
+    setup_reference_shape_gradients(const Quadrature<dim> &quadrature);
+
+    /**
+     * Get pointers to the objects set up by setup_reference_shape_gradients().
+     */
+    std::vector<const ReferenceShapeGradients<dim, spacedim> *>
+    get_reference_shape_gradients() const;
+
     /**
      * Get a constant reference to the DoFHandler used for the position,
      * velocity, and force.
@@ -227,6 +327,12 @@ namespace fdl
     std::shared_ptr<const Utilities::MPI::Partitioner>
     get_partitioner() const;
 
+    /**
+     * Get the list of physical boundary faces of the locally owned cells.
+     */
+    const BoundaryFaces<dim, spacedim> &
+    get_boundary_faces() const;
+
     /**
      * Get the MatrixFree object used to set up the matrix-free operators.
      * Useful if a second FE solver also needs to do matrix-free calculations.
@@ -258,6 +364,122 @@ namespace fdl
     const PreconditionJacobi<MatrixFreeOperators::Base<dim>> &
     get_mass_preconditioner() const;
 
+    /**
+     * Return whether or not this part and @p other have the same mass
+     * operator - i.e., since they share a PartGeometry or use the same
+     * Triangulation and the same FiniteElement. In that case vectors of
+     * either part may be used with apply_mass_operator() and
+     * solve_mass_systems().
+     */
+    bool
+    has_same_mass_operator(const Part<dim, spacedim> &other) const;
+
+    /**
+     * Compute <code>*dst[k] = M *src[k]</code> for each k, where M is the mass
+     * matrix, with a single matrix-free loop over the cells. This is cheaper
+     * than applying get_mass_operator() to each vector separately since the
+     * cell geometry only needs to be loaded once.
+     *
+     * In codimension one, where MatrixFree is not available, this uses a
+     * SurfaceMassOperator instead. That is not implemented for meshes with
+     * hanging nodes.
+     */
+    void
+    apply_mass_operator(
+      const std::vector<LinearAlgebra::distributed::Vector<double> *> &dst,
+      const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+        &src) const;
+
+    /**
+     * Approximately solve <code>M dst = src</code>, where M is the mass
+     * matrix, without an iterative solver. If @p n_corrections is zero then
+     * this is a pointwise scaling by the inverse of the diagonal of M (i.e.,
+     * the same as applying get_mass_preconditioner()). Otherwise this applies
+     * a Chebyshev polynomial of degree <code>1 + n_corrections</code> in the
+     * Jacobi-preconditioned mass matrix, which is closer to the consistent L2
+     * projection for each additional correction.
+     *
+     * The eigenvalues required by the Chebyshev polynomial are estimated the
+     * first time each number of corrections is used. Corrections are not
+     * implemented in codimension one.
+     */
+    void
+    apply_approximate_mass_inverse(
+      LinearAlgebra::distributed::Vector<double>       &dst,
+      const LinearAlgebra::distributed::Vector<double> &src,
+      const unsigned int                                n_corrections) const;
+
+    /**
+     * Set the number of Chebyshev corrections used to precondition
+     * solve_mass_systems(), i.e., the preconditioner is
+     * apply_approximate_mass_inverse() with @p n_corrections. Zero (the
+     * default) is Jacobi preconditioning. Each correction applies the mass
+     * operator once more but, since the number of CG iterations grows with the
+     * degree of the finite element, fewer iterations (and hence fewer global
+     * reductions) are typically needed for higher-degree elements.
+     */
+    void
+    set_mass_preconditioner_corrections(const unsigned int n_corrections);
+
+    /**
+     * Set whether or not solve_mass_systems() uses the pipelined conjugate
+     * gradient method of Ghysels and Vanroose instead of the standard one.
+     * The standard method does two global reductions per iteration, each of
+     * which must finish before the next step can start. The pipelined method
+     * does one, which is summed while the preconditioner and the mass
+     * operator are applied, at the cost of more vector updates and memory
+     * (nine vectors per system instead of four) and of somewhat less stable
+     * recurrences. This is only faster if the reductions, rather than the
+     * mass operator, dominate the solve time, e.g., for parts spread thinly
+     * over many processors. Defaults to false.
+     */
+    void
+    set_pipelined_mass_solver(const bool use_pipelined);
+
+    /**
+     * Return whether or not solve_mass_systems() uses the pipelined conjugate
+     * gradient method (see set_pipelined_mass_solver()).
+     */
+    bool
+    uses_pipelined_mass_solver() const;
+
+    /**
+     * Return whether or not the mass matrix is block diagonal (i.e., the
+     * finite element is discontinuous) and solve_mass_systems() hence
+     * applies its exact inverse cell-by-cell instead of using an iterative
+     * solver.
+     */
+    bool
+    has_cellwise_inverse_mass() const;
+
+    /**
+     * Solve <code>M *solutions[k] = *right_hand_sides[k]</code> for each k
+     * with the preconditioned conjugate gradient method (see
+     * set_mass_preconditioner_corrections()). Each system converges
+     * independently, but each iteration applies the mass operator to all
+     * unconverged systems with one call to apply_mass_operator() and computes
+     * all inner products with one reduction.
+     *
+     * If has_cellwise_inverse_mass() is true then each system is instead
+     * solved exactly with one loop over the cells and zero iterations are
+     * reported.
+     *
+     * On input @p solutions contains the initial guesses. Each system is
+     * solved to a residual of @p relative_tolerance times the norm of its
+     * right-hand side: if that is not possible in @p max_iterations steps then
+     * SolverControl::NoConvergence is thrown.
+     *
+     * @return The number of iterations required by each system.
+     */
+    std::vector<unsigned int>
+    solve_mass_systems(
+      const std::vector<LinearAlgebra::distributed::Vector<double> *>
+        &solutions,
+      const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+                        &right_hand_sides,
+      const unsigned int max_iterations,
+      const double       relative_tolerance) const;
+
     /**
      * Get the current position of the structure.
      */
@@ -276,6 +498,16 @@ namespace fdl
     void
     set_position(LinearAlgebra::distributed::Vector<double> &&position);
 
+    /**
+     * Get the number of times the position has been set (including by load()).
+     * Since the position can only be modified by those functions, objects
+     * which store data computed from the position (e.g., its overlap
+     * representation in InteractionBase) may use this to check if their data
+     * is still valid.
+     */
+    std::uint64_t
+    get_position_version() const;
+
     /**
      * Get the current velocity of the structure.
      */
@@ -294,6 +526,16 @@ namespace fdl
     void
     set_velocity(LinearAlgebra::distributed::Vector<double> &&position);
 
+    /**
+     * Return an estimate of the memory used by this object, in bytes. If @p
+     * include_geometry is true then this includes
+     * PartGeometry::memory_consumption(): since the geometry may be shared by
+     * several parts, it should be excluded when summing over parts which
+     * share one.
+     */
+    std::size_t
+    memory_consumption(const bool include_geometry = true) const;
+
   protected:
     /**
      * Actual archive function. Separate for now from load and save.
@@ -303,53 +545,24 @@ namespace fdl
     serialize(Archive &ar, const unsigned int version);
 
     /**
-     * Triangulation of the part.
+     * Finite element book-keeping: the DoFHandler, MatrixFree object, mass
+     * operator, etc. May be shared by several parts.
      */
-    SmartPointer<const Triangulation<dim, spacedim>> tria;
-
-    /**
-     * Finite element for the position, velocity and force. Since velocity is
-     * the time derivative of position we need to use the same FE for both
-     * spaces. Similarly, to maintain adjointness between force spreading and
-     * velocity interpolation, we need to use the same space for force and
-     * velocity.
-     */
-    std::unique_ptr<FiniteElement<dim, spacedim>> fe;
-
-    /**
-     * DoFHandler for the position, velocity, and force. May be shared by
-     * external applications.
-     */
-    std::shared_ptr<DoFHandler<dim, spacedim>> dof_handler;
-
-    /**
-     * Constraints on the position, velocity, and force. Presently empty.
-     */
-    AffineConstraints<double> constraints;
-
-    /**
-     * Partitioner for the position, velocity, and force vectors.
-     */
-    std::shared_ptr<const Utilities::MPI::Partitioner> partitioner;
-
-    // Quadrature used for the position, velocity, and force.
-    Quadrature<dim> quadrature;
-
-    // Mapping used for the position, velocity, and force.
-    std::unique_ptr<Mapping<dim, spacedim>> mapping;
-
-    // MatrixFree object.
-    std::shared_ptr<MatrixFree<dim, double>> matrix_free;
+    std::shared_ptr<PartGeometry<dim, spacedim>> geometry;
 
-    // Mass operator. Used for L2 projections.
-    std::unique_ptr<MatrixFreeOperators::Base<dim>> mass_operator;
+    // Number of Chebyshev corrections used to precondition
+    // solve_mass_systems().
+    unsigned int n_mass_preconditioner_corrections;
 
-    // Preconditioner.
-    PreconditionJacobi<MatrixFreeOperators::Base<dim>> mass_preconditioner;
+    // Whether or not solve_mass_systems() uses pipelined CG.
+    bool pipelined_mass_solver;
 
     // Position.
     LinearAlgebra::distributed::Vector<double> position;
 
+    // Number of times the position has been set.
+    std::uint64_t position_version = 0;
+
     // Velocity.
     LinearAlgebra::distributed::Vector<double> velocity;
 
@@ -367,71 +580,110 @@ namespace fdl
 
   // Functions for getting basic objects owned by the Part
 
+  template <int dim, int spacedim>
+  std::shared_ptr<PartGeometry<dim, spacedim>>
+  Part<dim, spacedim>::get_geometry() const
+  {
+    return geometry;
+  }
+
   template <int dim, int spacedim>
   const Triangulation<dim, spacedim> &
   Part<dim, spacedim>::get_triangulation() const
   {
-    Assert(tria, ExcFDLInternalError());
-    return *tria;
+    return geometry->get_triangulation();
   }
 
   template <int dim, int spacedim>
   MPI_Comm
   Part<dim, spacedim>::get_communicator() const
   {
-    Assert(tria, ExcFDLInternalError());
-    return tria->get_communicator();
+    return geometry->get_communicator();
   }
 
   template <int dim, int spacedim>
   const DoFHandler<dim, spacedim> &
   Part<dim, spacedim>::get_dof_handler() const
   {
-    return *dof_handler;
+    return geometry->get_dof_handler();
   }
 
   template <int dim, int spacedim>
   std::shared_ptr<const Utilities::MPI::Partitioner>
   Part<dim, spacedim>::get_partitioner() const
   {
-    return partitioner;
+    return geometry->get_partitioner();
+  }
+
+  template <int dim, int spacedim>
+  const BoundaryFaces<dim, spacedim> &
+  Part<dim, spacedim>::get_boundary_faces() const
+  {
+    return geometry->get_boundary_faces();
   }
 
   template <int dim, int spacedim>
   std::shared_ptr<const MatrixFree<dim, double>>
   Part<dim, spacedim>::get_matrix_free() const
   {
-    return matrix_free;
+    return geometry->get_matrix_free();
   }
 
   template <int dim, int spacedim>
   const Quadrature<dim> &
   Part<dim, spacedim>::get_quadrature() const
   {
-    return quadrature;
+    return geometry->get_quadrature();
   }
 
   template <int dim, int spacedim>
   const Mapping<dim, spacedim> &
   Part<dim, spacedim>::get_mapping() const
   {
-    return *mapping;
+    return geometry->get_mapping();
   }
 
   template <int dim, int spacedim>
   const MatrixFreeOperators::Base<dim> &
   Part<dim, spacedim>::get_mass_operator() const
   {
-    AssertThrow(dim == spacedim, ExcFDLNotImplemented());
-    return *mass_operator;
+    return geometry->get_mass_operator();
   }
 
   template <int dim, int spacedim>
   const PreconditionJacobi<MatrixFreeOperators::Base<dim>> &
   Part<dim, spacedim>::get_mass_preconditioner() const
   {
-    AssertThrow(dim == spacedim, ExcFDLNotImplemented());
-    return mass_preconditioner;
+    return geometry->get_mass_preconditioner();
+  }
+
+  template <int dim, int spacedim>
+  void
+  Part<dim, spacedim>::set_mass_preconditioner_corrections(
+    const unsigned int n_corrections)
+  {
+    n_mass_preconditioner_corrections = n_corrections;
+  }
+
+  template <int dim, int spacedim>
+  void
+  Part<dim, spacedim>::set_pipelined_mass_solver(const bool use_pipelined)
+  {
+    pipelined_mass_solver = use_pipelined;
+  }
+
+  template <int dim, int spacedim>
+  bool
+  Part<dim, spacedim>::uses_pipelined_mass_solver() const
+  {
+    return pipelined_mass_solver;
+  }
+
+  template <int dim, int spacedim>
+  bool
+  Part<dim, spacedim>::has_cellwise_inverse_mass() const
+  {
+    return geometry->has_cellwise_inverse_mass();
   }
 
   // Functions for getting and setting state vectors
@@ -448,9 +700,10 @@ namespace fdl
   Part<dim, spacedim>::set_position(
     const LinearAlgebra::distributed::Vector<double> &pos)
   {
-    Assert(partitioner->is_compatible(*pos.get_partitioner()),
+    Assert(get_partitioner()->is_compatible(*pos.get_partitioner()),
            ExcMessage("The partitioners must be compatible"));
     position = pos;
+    ++position_version;
   }
 
   template <int dim, int spacedim>
@@ -458,9 +711,17 @@ namespace fdl
   Part<dim, spacedim>::set_position(
     LinearAlgebra::distributed::Vector<double> &&pos)
   {
-    Assert(partitioner->is_compatible(*pos.get_partitioner()),
+    Assert(get_partitioner()->is_compatible(*pos.get_partitioner()),
            ExcMessage("The partitioners must be compatible"));
     position.swap(pos);
+    ++position_version;
+  }
+
+  template <int dim, int spacedim>
+  std::uint64_t
+  Part<dim, spacedim>::get_position_version() const
+  {
+    return position_version;
   }
 
   template <int dim, int spacedim>
@@ -475,7 +736,7 @@ namespace fdl
   Part<dim, spacedim>::set_velocity(
     const LinearAlgebra::distributed::Vector<double> &vel)
   {
-    Assert(partitioner->is_compatible(*vel.get_partitioner()),
+    Assert(get_partitioner()->is_compatible(*vel.get_partitioner()),
            ExcMessage("The partitioners must be compatible"));
     velocity = vel;
   }
@@ -485,7 +746,7 @@ namespace fdl
   Part<dim, spacedim>::set_velocity(
     LinearAlgebra::distributed::Vector<double> &&vel)
   {
-    Assert(partitioner->is_compatible(*vel.get_partitioner()),
+    Assert(get_partitioner()->is_compatible(*vel.get_partitioner()),
            ExcMessage("The partitioners must be compatible"));
     velocity.swap(vel);
   }
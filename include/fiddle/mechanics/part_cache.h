@@ -0,0 +1,189 @@
+#ifndef included_fiddle_mechanics_part_cache_h
+#define included_fiddle_mechanics_part_cache_h
+
+#include <fiddle/base/config.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <mpi.h>
+
+#include <string>
+#include <vector>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * Class which stores the expensive-to-compute inputs of a Part (the
+   * Triangulation, the DoF numbering, and fields like fibers read with
+   * read_dof_data()) in binary files so that subsequent runs with identical
+   * inputs can skip reading and processing the original mesh and data files.
+   *
+   * Cache files are keyed by a hash of the contents of the input files and the
+   * number of processors: if either changes then a different set of cache
+   * files is used. Typical usage is
+   *
+   * @code
+   * fdl::PartCache<3> cache("cache", {"heart.e"}, mpi_comm);
+   * if (cache.has_triangulation())
+   *   cache.load_triangulation(tria);
+   * else
+   *   {
+   *     GridIn<3> grid_in(tria);
+   *     grid_in.read_exodusii("heart.e");
+   *     cache.save_triangulation(tria);
+   *   }
+   * @endcode
+   *
+   * and similarly for DoF numberings and vectors. All files are written into
+   * an existing directory. Each file consists of a small header followed by
+   * flat arrays of fixed-width values, which are read with one call each.
+   * Files are written under a temporary name and then renamed, so an
+   * interrupted run never leaves behind a partial cache file.
+   *
+   * @note The matrix-free data structures (and hence the mass operator) of a
+   * PartGeometry depend on the memory layout of the current process and
+   * cannot be stored. These are always recomputed.
+   */
+  template <int dim, int spacedim = dim>
+  class PartCache
+  {
+  public:
+    /**
+     * Constructor. Computes the cache key from the contents of each file in
+     * @p input_files and the number of processors in @p comm. The files are
+     * only read by the first processor.
+     */
+    PartCache(const std::string              &directory,
+              const std::vector<std::string> &input_files,
+              const MPI_Comm                  comm);
+
+    /**
+     * Return the cache key.
+     */
+    const std::string &
+    get_key() const;
+
+    /**
+     * Return whether or not a cached Triangulation exists. This call is
+     * collective.
+     */
+    bool
+    has_triangulation() const;
+
+    /**
+     * Save the (unrefined) Triangulation @p tria, including its material,
+     * manifold, and boundary ids. Since every processor stores the whole
+     * coarse mesh only the first processor writes the file. This call is
+     * collective.
+     */
+    void
+    save_triangulation(const Triangulation<dim, spacedim> &tria) const;
+
+    /**
+     * Load a Triangulation saved by save_triangulation() into the empty
+     * Triangulation @p tria. Manifolds must be attached afterwards by the
+     * caller.
+     */
+    void
+    load_triangulation(Triangulation<dim, spacedim> &tria) const;
+
+    /**
+     * Return whether or not a cached DoF numbering exists on every processor.
+     * This call is collective.
+     */
+    bool
+    has_dof_numbering() const;
+
+    /**
+     * Save the numbering of the DoFs of @p dof_handler relative to the
+     * numbering set up by DoFHandler::distribute_dofs() (e.g., the numbering
+     * computed by PartGeometry with <code>renumber_dofs = true</code>). The
+     * renumbering must not change the set of DoFs owned by each processor.
+     * This call is collective.
+     */
+    void
+    save_dof_numbering(const DoFHandler<dim, spacedim> &dof_handler) const;
+
+    /**
+     * Apply a numbering saved by save_dof_numbering() to @p dof_handler,
+     * whose DoFs must have just been distributed with the same
+     * FiniteElement. Since PartGeometry keeps the numbering of an externally
+     * managed DoFHandler this may be used in place of renumbering the DoFs
+     * again. This call is collective.
+     */
+    void
+    load_dof_numbering(DoFHandler<dim, spacedim> &dof_handler) const;
+
+    /**
+     * Return whether or not a cached vector with name @p name exists on every
+     * processor. This call is collective.
+     */
+    bool
+    has_vector(const std::string &name) const;
+
+    /**
+     * Save the locally owned values of @p vector with name @p name.
+     */
+    void
+    save_vector(const std::string                                &name,
+                const LinearAlgebra::distributed::Vector<double> &vector) const;
+
+    /**
+     * Load the locally owned values of the vector with name @p name into
+     * @p vector, which must have the same parallel layout as the saved vector,
+     * and update its ghost values.
+     */
+    void
+    load_vector(const std::string                          &name,
+                LinearAlgebra::distributed::Vector<double> &vector) const;
+
+  protected:
+    /**
+     * Return the name of the cache file for the object @p name. If
+     * @p per_processor is true then each processor has its own file.
+     */
+    std::string
+    get_file_name(const std::string &name, const bool per_processor) const;
+
+    /**
+     * Return whether or not the file for the object @p name exists on every
+     * processor.
+     */
+    bool
+    file_exists(const std::string &name, const bool per_processor) const;
+
+    /**
+     * Communicator.
+     */
+    MPI_Comm communicator;
+
+    /**
+     * Directory containing the cache files.
+     */
+    std::string directory;
+
+    /**
+     * Hash of the input files and number of processors.
+     */
+    std::string key;
+  };
+
+
+  // --------------------------- inline functions --------------------------- //
+
+
+  template <int dim, int spacedim>
+  inline const std::string &
+  PartCache<dim, spacedim>::get_key() const
+  {
+    return key;
+  }
+} // namespace fdl
+
+#endif
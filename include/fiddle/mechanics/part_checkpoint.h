@@ -0,0 +1,174 @@
+#ifndef included_fiddle_mechanics_part_checkpoint_h
+#define included_fiddle_mechanics_part_checkpoint_h
+
+#include <fiddle/base/config.h>
+
+#include <deal.II/base/types.h>
+
+#include <mpi.h>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dealii
+{
+  template <int, int>
+  class DoFHandler;
+} // namespace dealii
+
+namespace fdl
+{
+  template <int, int>
+  class Part;
+}
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * Class which writes the state (i.e., the position and velocity) of several
+   * parts to, or reads it from, a single file with collective MPI-IO.
+   *
+   * Part::save() serializes the locally owned values of each processor
+   * separately, so a checkpoint consists of one record per processor and
+   * part and can only be loaded with the same number of processors. This
+   * class instead stores each vector in an order which only depends on the
+   * Triangulation and the FiniteElement (i.e., the order in which the DoFs
+   * are first encountered when looping over the active cells), so every
+   * processor can write (or read) its locally owned values with a single
+   * collective call and a checkpoint may be loaded with a different number
+   * of processors or a different DoF numbering.
+   *
+   * Only the state which evolves in time is stored: everything else (the
+   * Triangulation, the FiniteElement, the DoF numbering, and the force
+   * contributions) is set up again from the original inputs (or a PartCache)
+   * when restarting. Similarly, the canonical ordering of the DoFs of a part
+   * does not change between checkpoints, so it may be computed once with
+   * compute_canonical_dof_indices() and then reused for every checkpoint.
+   *
+   * Parts are stored in the order in which save() is called and must be
+   * loaded in the same order. Since the canonical ordering requires the DoF
+   * indices of every cell, the parts must use a
+   * parallel::shared::Triangulation without artificial cells.
+   *
+   * @note All functions of this class are collective over the communicator
+   * provided to the constructor.
+   */
+  class PartCheckpoint
+  {
+  public:
+    /**
+     * Whether the file is written or read.
+     */
+    enum class Mode
+    {
+      Write,
+      Read
+    };
+
+    /**
+     * Constructor. Opens (creating or truncating it, if necessary, when
+     * writing) the file @p file_name.
+     */
+    PartCheckpoint(const std::string &file_name,
+                   const Mode         mode,
+                   const MPI_Comm     comm);
+
+    /**
+     * Destructor. Closes the file.
+     */
+    ~PartCheckpoint();
+
+    /**
+     * Append the position and velocity of @p part to the file.
+     */
+    template <int dim, int spacedim>
+    void
+    save(const Part<dim, spacedim> &part);
+
+    /**
+     * Same as the other save() function, but use the previously computed
+     * result of compute_canonical_dof_indices() @p canonical_dofs.
+     */
+    template <int dim, int spacedim>
+    void
+    save(const Part<dim, spacedim> &part,
+         const std::vector<
+           std::pair<types::global_dof_index, types::global_dof_index>>
+           &canonical_dofs);
+
+    /**
+     * Read the next position and velocity from the file and set them in
+     * @p part.
+     */
+    template <int dim, int spacedim>
+    void
+    load(Part<dim, spacedim> &part);
+
+    /**
+     * Same as the other load() function, but use the previously computed
+     * result of compute_canonical_dof_indices() @p canonical_dofs.
+     */
+    template <int dim, int spacedim>
+    void
+    load(Part<dim, spacedim> &part,
+         const std::vector<
+           std::pair<types::global_dof_index, types::global_dof_index>>
+           &canonical_dofs);
+
+  protected:
+    /**
+     * Write (on the first processor) or read (on every processor) a single
+     * integer at the current offset and advance the offset.
+     */
+    std::uint64_t
+    write_or_read_size(const std::uint64_t size);
+
+    /**
+     * Write the values in @p values, whose canonical indices are @p indices,
+     * at the current offset. @p indices must be sorted. Since each array
+     * stores @p n_values values the offset is then advanced by that amount.
+     */
+    void
+    write_values(const std::vector<types::global_dof_index> &indices,
+                 const std::vector<double>                  &values,
+                 const types::global_dof_index               n_values);
+
+    /**
+     * Read the values at the given canonical indices into @p values at the
+     * current offset and then advance the offset.
+     */
+    void
+    read_values(const std::vector<types::global_dof_index> &indices,
+                std::vector<double>                        &values,
+                const types::global_dof_index               n_values);
+
+    Mode mode;
+
+    MPI_Comm communicator;
+
+    MPI_File file;
+
+    /**
+     * Current position, in bytes, in the file.
+     */
+    MPI_Offset offset;
+  };
+
+  /**
+   * Compute, for each locally owned DoF of @p dof_handler, its index in the
+   * order in which the DoFs are first encountered when looping over the
+   * active cells. This ordering does not depend on the number of processors
+   * or on any renumbering of the DoFs. The returned pairs consist of these
+   * canonical indices and the index of the DoF within the locally owned
+   * DoFs, and are sorted by canonical index.
+   */
+  template <int dim, int spacedim>
+  std::vector<std::pair<types::global_dof_index, types::global_dof_index>>
+  compute_canonical_dof_indices(const DoFHandler<dim, spacedim> &dof_handler);
+} // namespace fdl
+
+#endif
@@ -0,0 +1,593 @@
+#ifndef included_fiddle_mechanics_part_geometry_h
+#define included_fiddle_mechanics_part_geometry_h
+
+#include <fiddle/base/config.h>
+
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/grid/boundary_faces.h>
+
+#include <fiddle/mechanics/device_mass_solver.h>
+#include <fiddle/mechanics/reference_shape_gradients.h>
+#include <fiddle/mechanics/surface_mass_operator.h>
+
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/quadrature.h>
+#include <deal.II/base/subscriptor.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe.h>
+#include <deal.II/fe/mapping.h>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_description.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+
+#include <deal.II/matrix_free/matrix_free.h>
+FDL_DISABLE_EXTRA_DIAGNOSTICS
+#include <deal.II/matrix_free/operators.h>
+FDL_ENABLE_EXTRA_DIAGNOSTICS
+
+#include <mpi.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * A coarse mesh stored in memory (e.g., by a mesh generator) in the format
+   * used by Triangulation::create_triangulation().
+   */
+  template <int dim, int spacedim = dim>
+  struct PartMeshData
+  {
+    /**
+     * Vertices of the mesh.
+     */
+    std::vector<Point<spacedim>> vertices;
+
+    /**
+     * Cells, i.e., vertex indices and material ids. These must already be
+     * consistently oriented (see GridTools::consistently_order_cells()).
+     */
+    std::vector<CellData<dim>> cells;
+
+    /**
+     * Boundary and manifold ids of lines and faces.
+     */
+    SubCellData subcell_data;
+
+    /**
+     * Processor which owns each cell. If empty then the cells are
+     * partitioned along a z-order curve.
+     */
+    std::vector<types::subdomain_id> subdomain_ids;
+  };
+
+  /**
+   * Class storing the parts of the finite element discretization of a Part
+   * which do not depend on its state: the DoFHandler, Mapping, Quadrature,
+   * MatrixFree object, mass operator, and related objects.
+   *
+   * Several Part objects (e.g., several structures on identical meshes, or one
+   * mesh with different sets of forces) may share one PartGeometry, in which
+   * case all of these objects are set up once and stored once, and only the
+   * state vectors are stored by each Part. Since a PartGeometry only depends
+   * on the Triangulation and FiniteElement, everything here is valid for the
+   * entire simulation.
+   *
+   * By default DoFs are numbered in the order of the cells of the
+   * Triangulation, which, for meshes read from files, is the (often
+   * arbitrary) order of the elements in the file. The constructors can
+   * optionally renumber the locally owned DoFs along a Hilbert curve through
+   * the cell centers instead: this makes the DoFs of nearby cells (and hence
+   * the DoFs of each overlap partition) nearly contiguous in the native
+   * vectors. This does not change the order of the cells themselves, so
+   * functions like read_elemental_data() and read_dof_data() may still be
+   * used afterwards. For parallel::shared::Triangulation, the partitioning of
+   * the cells is not changed: use a spatially compact partitioner (e.g.,
+   * partition_zorder) to get the same benefit across processors.
+   */
+  template <int dim, int spacedim = dim>
+  class PartGeometry : public Subscriptor
+  {
+  public:
+    /**
+     * Constructor. If @p renumber_dofs is true then the DoFs are renumbered
+     * along a Hilbert curve.
+     */
+    PartGeometry(const Triangulation<dim, spacedim> &tria,
+                 const FiniteElement<dim, spacedim> &fe,
+                 const bool                          renumber_dofs = false);
+
+    /**
+     * Constructor, which uses an externally managed DoFHandler whose DoFs have
+     * already been distributed. If @p renumber_dofs is true then the DoFs of
+     * @p dof_handler are renumbered along a Hilbert curve: otherwise its
+     * current numbering is used.
+     */
+    PartGeometry(std::shared_ptr<DoFHandler<dim, spacedim>> dof_handler,
+                 const bool renumber_dofs = false);
+
+    /**
+     * Constructor, which creates a parallel::shared::Triangulation on @p
+     * communicator from @p mesh_data. This avoids writing a mesh generated
+     * in memory to a file and then reading it on every processor. The arrays
+     * in @p mesh_data are freed as soon as the Triangulation has been
+     * created, so the mesh is not stored twice.
+     *
+     * The Triangulation is owned by this object, so it (and hence the
+     * DoFHandler) is valid as long as this object exists.
+     */
+    PartGeometry(const MPI_Comm                      communicator,
+                 PartMeshData<dim, spacedim>       &&mesh_data,
+                 const FiniteElement<dim, spacedim> &fe,
+                 const bool                          renumber_dofs = false);
+
+    /**
+     * Same as the previous constructor, but the Triangulation shares
+     * ownership of @p communicator (e.g., a duplicated communicator created
+     * by create_part_geometries()), which is hence valid for as long as the
+     * Triangulation exists.
+     */
+    PartGeometry(std::shared_ptr<const MPI_Comm>     communicator,
+                 PartMeshData<dim, spacedim>       &&mesh_data,
+                 const FiniteElement<dim, spacedim> &fe,
+                 const bool                          renumber_dofs = false);
+
+    /**
+     * Get a constant reference to the Triangulation.
+     */
+    const Triangulation<dim, spacedim> &
+    get_triangulation() const;
+
+    /**
+     * Get a copy of the communicator.
+     */
+    MPI_Comm
+    get_communicator() const;
+
+    /**
+     * Get a constant reference to the FiniteElement.
+     */
+    const FiniteElement<dim, spacedim> &
+    get_fe() const;
+
+    /**
+     * Get a constant reference to the DoFHandler.
+     */
+    const DoFHandler<dim, spacedim> &
+    get_dof_handler() const;
+
+    /**
+     * Get the constraints on the position, velocity, and force, i.e., the
+     * hanging node constraints of a locally refined Triangulation. Vectors
+     * assembled without these constraints (e.g., the right-hand sides passed
+     * to solve_mass_systems()) are condensed by this class.
+     */
+    const AffineConstraints<double> &
+    get_constraints() const;
+
+    /**
+     * Return whether or not any processor has constraints. Unlike
+     * get_constraints().n_constraints() this is the same on every processor,
+     * so it may be used to decide whether or not to call collective
+     * functions like AffineConstraints::distribute().
+     */
+    bool
+    has_constraints() const;
+
+    /**
+     * Get the shared vector partitioner.
+     */
+    std::shared_ptr<const Utilities::MPI::Partitioner>
+    get_partitioner() const;
+
+    /**
+     * Get the list of physical boundary faces of the locally owned cells.
+     */
+    const BoundaryFaces<dim, spacedim> &
+    get_boundary_faces() const;
+
+    /**
+     * Get the MatrixFree object used to set up the matrix-free operators.
+     */
+    std::shared_ptr<const MatrixFree<dim, double>>
+    get_matrix_free() const;
+
+    /**
+     * Return a reference to the quadrature used to set up the mass operator.
+     */
+    const Quadrature<dim> &
+    get_quadrature() const;
+
+    /**
+     * Return a reference to the mapping used to set up the mass operator.
+     */
+    const Mapping<dim, spacedim> &
+    get_mapping() const;
+
+    /**
+     * Get the mass operator.
+     */
+    const MatrixFreeOperators::Base<dim> &
+    get_mass_operator() const;
+
+    /**
+     * Get the preconditioner associated with the mass operator.
+     */
+    const PreconditionJacobi<MatrixFreeOperators::Base<dim>> &
+    get_mass_preconditioner() const;
+
+    /**
+     * Return whether or not the mass matrix is block diagonal (i.e., the
+     * finite element is discontinuous).
+     */
+    bool
+    has_cellwise_inverse_mass() const;
+
+    /**
+     * Return whether or not this object and @p other have the same mass
+     * operator - i.e., since they use the same Triangulation and the same
+     * FiniteElement.
+     */
+    bool
+    has_same_mass_operator(const PartGeometry<dim, spacedim> &other) const;
+
+    /**
+     * Precompute the shape function gradients and JxW values on the reference
+     * configuration for @p quadrature. Does nothing if they have already been
+     * computed. See Part::setup_reference_shape_gradients().
+     */
+    void
+    setup_reference_shape_gradients(const Quadrature<dim> &quadrature);
+
+    /**
+     * Get pointers to the objects set up by setup_reference_shape_gradients().
+     */
+    std::vector<const ReferenceShapeGradients<dim, spacedim> *>
+    get_reference_shape_gradients() const;
+
+    /**
+     * Set up a DeviceMassSolver, which solve_mass_systems() uses from then on
+     * to solve consistent mass systems on the device. Does nothing if one has
+     * already been set up. Only available in codimension zero for continuous
+     * FE_Q elements on meshes without hanging nodes and when fiddle is
+     * configured with FDL_ENABLE_DEVICE_MATRIX_FREE.
+     */
+    void
+    setup_device_mass_solver();
+
+    /**
+     * Return whether or not setup_device_mass_solver() has been called.
+     */
+    bool
+    has_device_mass_solver() const;
+
+    /**
+     * Return an estimate of the memory used by this object, in bytes. This
+     * includes the Triangulation (even though it is usually not owned by this
+     * object), the DoFHandler, the MatrixFree object, and all precomputed
+     * ReferenceShapeGradients objects.
+     */
+    std::size_t
+    memory_consumption() const;
+
+    /**
+     * Same as Part::apply_mass_operator().
+     */
+    void
+    apply_mass_operator(
+      const std::vector<LinearAlgebra::distributed::Vector<double> *> &dst,
+      const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+        &src) const;
+
+    /**
+     * Same as Part::apply_approximate_mass_inverse().
+     */
+    void
+    apply_approximate_mass_inverse(
+      LinearAlgebra::distributed::Vector<double>       &dst,
+      const LinearAlgebra::distributed::Vector<double> &src,
+      const unsigned int                                n_corrections) const;
+
+    /**
+     * Same as Part::solve_mass_systems(), but with the number of Chebyshev
+     * corrections used by the preconditioner and whether or not the
+     * pipelined conjugate gradient method is used (see
+     * Part::set_pipelined_mass_solver()) given explicitly.
+     */
+    std::vector<unsigned int>
+    solve_mass_systems(
+      const std::vector<LinearAlgebra::distributed::Vector<double> *>
+        &solutions,
+      const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+                        &right_hand_sides,
+      const unsigned int max_iterations,
+      const double       relative_tolerance,
+      const unsigned int n_corrections,
+      const bool         pipelined = false) const;
+
+  protected:
+    /**
+     * Triangulation created by this object, if any. This is declared first
+     * so that it is destroyed last.
+     */
+    std::shared_ptr<const Triangulation<dim, spacedim>> owned_triangulation;
+
+    /**
+     * Add the values of the constrained DoFs of @p src to their masters and
+     * zero them, i.e., compute the right-hand side of the condensed system.
+     */
+    void
+    condense_right_hand_side(
+      const LinearAlgebra::distributed::Vector<double> &src,
+      LinearAlgebra::distributed::Vector<double>       &dst) const;
+
+    /**
+     * Apply the preconditioner to a condensed vector.
+     */
+    void
+    apply_condensed_approximate_mass_inverse(
+      LinearAlgebra::distributed::Vector<double>       &dst,
+      const LinearAlgebra::distributed::Vector<double> &src,
+      const unsigned int                                n_corrections) const;
+
+    /**
+     * Solve mass systems with condensed right-hand sides. The constrained
+     * entries of @p solutions must be zero and are not modified.
+     */
+    std::vector<unsigned int>
+    solve_condensed_mass_systems(
+      const std::vector<LinearAlgebra::distributed::Vector<double> *>
+        &solutions,
+      const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+                        &right_hand_sides,
+      const unsigned int max_iterations,
+      const double       relative_tolerance,
+      const unsigned int n_corrections) const;
+
+    /**
+     * Same as solve_condensed_mass_systems(), but with the pipelined
+     * conjugate gradient method, which does one nonblocking reduction per
+     * iteration while the preconditioner and the mass operator are applied.
+     */
+    std::vector<unsigned int>
+    solve_condensed_mass_systems_pipelined(
+      const std::vector<LinearAlgebra::distributed::Vector<double> *>
+        &solutions,
+      const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+                        &right_hand_sides,
+      const unsigned int max_iterations,
+      const double       relative_tolerance,
+      const unsigned int n_corrections) const;
+
+    /**
+     * Triangulation of the part.
+     */
+    SmartPointer<const Triangulation<dim, spacedim>> tria;
+
+    /**
+     * Finite element for the position, velocity and force.
+     */
+    std::unique_ptr<FiniteElement<dim, spacedim>> fe;
+
+    /**
+     * DoFHandler for the position, velocity, and force. May be shared by
+     * external applications.
+     */
+    std::shared_ptr<DoFHandler<dim, spacedim>> dof_handler;
+
+    /**
+     * Constraints on the position, velocity, and force: hanging node
+     * constraints, if the Triangulation is locally refined.
+     */
+    AffineConstraints<double> constraints;
+
+    /**
+     * Whether or not any processor has constraints.
+     */
+    bool any_constraints;
+
+    /**
+     * Partitioner for the position, velocity, and force vectors.
+     */
+    std::shared_ptr<const Utilities::MPI::Partitioner> partitioner;
+
+    // Quadrature used for the position, velocity, and force.
+    Quadrature<dim> quadrature;
+
+    // Mapping used for the position, velocity, and force.
+    std::unique_ptr<Mapping<dim, spacedim>> mapping;
+
+    // Physical boundary faces.
+    std::unique_ptr<BoundaryFaces<dim, spacedim>> boundary_faces;
+
+    // MatrixFree object.
+    std::shared_ptr<MatrixFree<dim, double>> matrix_free;
+
+    // Mass operator. Used for L2 projections.
+    std::unique_ptr<MatrixFreeOperators::Base<dim>> mass_operator;
+
+    // Preconditioner.
+    PreconditionJacobi<MatrixFreeOperators::Base<dim>> mass_preconditioner;
+
+    // Chebyshev approximations of the inverse mass matrix, indexed by number
+    // of corrections. Created when they are first used.
+    mutable std::map<
+      unsigned int,
+      std::unique_ptr<PreconditionChebyshev<
+        MatrixFreeOperators::Base<dim>,
+        LinearAlgebra::distributed::Vector<double>,
+        DiagonalMatrix<LinearAlgebra::distributed::Vector<double>>>>>
+      mass_chebyshevs;
+
+    // Mass operator used in codimension one, where MatrixFree is not
+    // available. Only set up if there are no constraints.
+    std::unique_ptr<SurfaceMassOperator<dim, spacedim>> surface_mass_operator;
+
+    // Whether or not the mass matrix is block diagonal.
+    bool cellwise_inverse_mass;
+
+    // Precomputed reference configuration values.
+    std::vector<std::unique_ptr<ReferenceShapeGradients<dim, spacedim>>>
+      reference_shape_gradients;
+
+    // Mass solver on the device, if set up.
+    std::unique_ptr<DeviceMassSolver<spacedim>> device_mass_solver;
+  };
+
+  /**
+   * Create one PartGeometry for each entry of @p mesh_data (see the
+   * corresponding PartGeometry constructor) concurrently. The finite
+   * elements are given by @p fes, which has either one entry for all meshes
+   * or one entry per mesh. This call is collective over @p communicator.
+   *
+   * Most of the setup time of a Part is spent in its PartGeometry, which
+   * distributes DoFs and sets up the MatrixFree object and the mass
+   * operator. Since these objects are independent, this function sets up
+   * up to @p max_concurrency of them at once, each on its own thread, so
+   * that the total setup time depends on the largest parts rather than the
+   * sum over all parts. Parts can then be created cheaply with the
+   * PartGeometry constructor of Part.
+   *
+   * Each Triangulation uses its own duplicate of @p communicator, so that
+   * the collective operations done while setting up different geometries do
+   * not interfere with each other. Since that requires MPI_THREAD_MULTIPLE,
+   * the geometries are set up one at a time if MPI was initialized with a
+   * lower thread support level. The result is the same in either case.
+   */
+  template <int dim, int spacedim = dim>
+  std::vector<std::shared_ptr<PartGeometry<dim, spacedim>>>
+  create_part_geometries(
+    const MPI_Comm                                           communicator,
+    std::vector<PartMeshData<dim, spacedim>>               &&mesh_data,
+    const std::vector<const FiniteElement<dim, spacedim> *> &fes,
+    const bool         renumber_dofs   = false,
+    const unsigned int max_concurrency = MultithreadInfo::n_threads());
+
+
+  // --------------------------- inline functions --------------------------- //
+
+
+  template <int dim, int spacedim>
+  const Triangulation<dim, spacedim> &
+  PartGeometry<dim, spacedim>::get_triangulation() const
+  {
+    Assert(tria, ExcFDLInternalError());
+    return *tria;
+  }
+
+  template <int dim, int spacedim>
+  MPI_Comm
+  PartGeometry<dim, spacedim>::get_communicator() const
+  {
+    Assert(tria, ExcFDLInternalError());
+    return tria->get_communicator();
+  }
+
+  template <int dim, int spacedim>
+  const FiniteElement<dim, spacedim> &
+  PartGeometry<dim, spacedim>::get_fe() const
+  {
+    return *fe;
+  }
+
+  template <int dim, int spacedim>
+  const DoFHandler<dim, spacedim> &
+  PartGeometry<dim, spacedim>::get_dof_handler() const
+  {
+    return *dof_handler;
+  }
+
+  template <int dim, int spacedim>
+  const AffineConstraints<double> &
+  PartGeometry<dim, spacedim>::get_constraints() const
+  {
+    return constraints;
+  }
+
+  template <int dim, int spacedim>
+  bool
+  PartGeometry<dim, spacedim>::has_constraints() const
+  {
+    return any_constraints;
+  }
+
+  template <int dim, int spacedim>
+  std::shared_ptr<const Utilities::MPI::Partitioner>
+  PartGeometry<dim, spacedim>::get_partitioner() const
+  {
+    return partitioner;
+  }
+
+  template <int dim, int spacedim>
+  const BoundaryFaces<dim, spacedim> &
+  PartGeometry<dim, spacedim>::get_boundary_faces() const
+  {
+    Assert(boundary_faces, ExcFDLInternalError());
+    return *boundary_faces;
+  }
+
+  template <int dim, int spacedim>
+  std::shared_ptr<const MatrixFree<dim, double>>
+  PartGeometry<dim, spacedim>::get_matrix_free() const
+  {
+    return matrix_free;
+  }
+
+  template <int dim, int spacedim>
+  const Quadrature<dim> &
+  PartGeometry<dim, spacedim>::get_quadrature() const
+  {
+    return quadrature;
+  }
+
+  template <int dim, int spacedim>
+  const Mapping<dim, spacedim> &
+  PartGeometry<dim, spacedim>::get_mapping() const
+  {
+    return *mapping;
+  }
+
+  template <int dim, int spacedim>
+  const MatrixFreeOperators::Base<dim> &
+  PartGeometry<dim, spacedim>::get_mass_operator() const
+  {
+    AssertThrow(dim == spacedim, ExcFDLNotImplemented());
+    return *mass_operator;
+  }
+
+  template <int dim, int spacedim>
+  const PreconditionJacobi<MatrixFreeOperators::Base<dim>> &
+  PartGeometry<dim, spacedim>::get_mass_preconditioner() const
+  {
+    AssertThrow(dim == spacedim, ExcFDLNotImplemented());
+    return mass_preconditioner;
+  }
+
+  template <int dim, int spacedim>
+  bool
+  PartGeometry<dim, spacedim>::has_cellwise_inverse_mass() const
+  {
+    return cellwise_inverse_mass;
+  }
+
+  template <int dim, int spacedim>
+  bool
+  PartGeometry<dim, spacedim>::has_device_mass_solver() const
+  {
+    return device_mass_solver != nullptr;
+  }
+} // namespace fdl
+
+#endif
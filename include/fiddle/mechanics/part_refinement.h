@@ -0,0 +1,98 @@
+#ifndef included_fiddle_mechanics_part_refinement_h
+#define included_fiddle_mechanics_part_refinement_h
+
+#include <fiddle/base/config.h>
+
+#include <fiddle/mechanics/part.h>
+#include <fiddle/mechanics/part_geometry.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include <memory>
+#include <vector>
+
+// forward declarations
+namespace dealii
+{
+  namespace parallel
+  {
+    namespace shared
+    {
+      template <int, int>
+      class Triangulation;
+    }
+  } // namespace parallel
+} // namespace dealii
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * Compute, for each active cell, the largest Frobenius norm of the
+   * Green-Lagrange strain (FF^T FF - I) / 2 at the quadrature points of
+   * Part::get_quadrature(). In codimension one the identity is replaced by
+   * the projection onto the tangent space of the reference configuration.
+   *
+   * Each processor computes the values on its locally owned cells and then
+   * the values are summed so that every processor has the complete vector.
+   * Hence the result may be passed directly to, e.g.,
+   * GridRefinement::refine_and_coarsen_fixed_fraction() to refine a
+   * parallel::shared::Triangulation in high-strain regions and coarsen it
+   * elsewhere: this function's output is the same on every processor, so the
+   * refinement flags are too.
+   */
+  template <int dim, int spacedim = dim>
+  Vector<float>
+  compute_strain_indicators(const Part<dim, spacedim> &part);
+
+  /**
+   * Refine and coarsen @p tria according to its refinement and coarsening
+   * flags and transfer the state of @p part to the new mesh.
+   *
+   * @param[inout] tria Triangulation of @p part.
+   *
+   * @param[in] part Part whose position and velocity are transferred. Since
+   * its Triangulation changes, @p part may not be used after this function
+   * is called and should be replaced by a new Part set up with the returned
+   * PartGeometry.
+   *
+   * @param[out] position Position on the new mesh, with up-to-date ghost
+   * values, which may be passed to Part::set_position().
+   *
+   * @param[out] velocity Velocity on the new mesh, with up-to-date ghost
+   * values, which may be passed to Part::set_velocity().
+   *
+   * @param[inout] cell_data Cellwise data (e.g., fibers read by
+   * read_elemental_data()) indexed by active cell index. Each vector must
+   * have one entry for every active cell on input and is replaced by a vector
+   * with one entry for each new active cell. Children inherit the value of
+   * their parent and a coarsened cell gets the mean value of its children:
+   * hence fibers should be renormalized after coarsening.
+   *
+   * @param[in] renumber_dofs Same as the argument to the PartGeometry
+   * constructor.
+   *
+   * @return A new PartGeometry on the adapted Triangulation. Since
+   * refinement typically creates hanging nodes, the returned object
+   * constrains the position, velocity, and force (see
+   * PartGeometry::get_constraints()).
+   *
+   * Fields are interpolated with the prolongation and restriction matrices
+   * of the finite element, which is exact under refinement. Like the
+   * interaction code, this function requires that every processor store the
+   * entire mesh, i.e., @p tria may not have artificial cells.
+   */
+  template <int dim, int spacedim = dim>
+  std::shared_ptr<PartGeometry<dim, spacedim>>
+  refine_and_coarsen_part(
+    parallel::shared::Triangulation<dim, spacedim> &tria,
+    const Part<dim, spacedim>                      &part,
+    LinearAlgebra::distributed::Vector<double>     &position,
+    LinearAlgebra::distributed::Vector<double>     &velocity,
+    std::vector<Vector<double>>                    &cell_data,
+    const bool                                      renumber_dofs = false);
+} // namespace fdl
+
+#endif
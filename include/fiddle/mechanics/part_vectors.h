@@ -9,6 +9,8 @@
 
 #include <deal.II/lac/la_parallel_vector.h>
 
+#include <array>
+#include <cstdint>
 #include <vector>
 
 namespace fdl
@@ -29,6 +31,13 @@ namespace fdl
    * set stored vectors to 'unghosted' to avoid extra communication. If you
    * need ghost values then you will need to call the relevant functions as
    * needed.
+   *
+   * Vectors are only allocated for the time levels (and quantities) which are
+   * actually set during a time step. Rather than deallocating them at the end
+   * of the time step this class keeps them as spare vectors, so that later
+   * time steps can reuse their storage via get_spare_vector(). Similarly,
+   * swap_new_state_into() swaps (instead of copying) the new positions and
+   * velocities into the Parts and keeps the Parts' previous vectors.
    */
   template <int dim, int spacedim = dim>
   class PartVectors
@@ -62,6 +71,11 @@ namespace fdl
     const LinearAlgebra::distributed::Vector<double> &
     get_position(const unsigned int part_n, const double time) const;
 
+    // Get a number identifying the current value of the position returned by
+    // get_position(): it changes whenever that vector is modified.
+    std::uint64_t
+    get_position_version(const unsigned int part_n, const double time) const;
+
     // same, but for velocity
     const LinearAlgebra::distributed::Vector<double> &
     get_velocity(const unsigned int part_n, const double time) const;
@@ -88,15 +102,22 @@ namespace fdl
               const double                               time,
               LinearAlgebra::distributed::Vector<double> force);
 
-    // Get all new position vectors by moving them out of this object. Intended
-    // to be called at the end of the time step.
-    std::vector<LinearAlgebra::distributed::Vector<double>>
-    get_all_new_positions();
+    // Get a zeroed, unghosted vector with the partitioner of part @p part_n.
+    // The storage of vectors retired at the end of previous time steps is
+    // reused when possible.
+    LinearAlgebra::distributed::Vector<double>
+    get_spare_vector(const unsigned int part_n) const;
+
+    // Swap the new positions and velocities with the ones stored by @p parts.
+    // The previous vectors of the parts are kept and retired by
+    // end_time_step(). Intended to be called at the end of the time step.
+    void
+    swap_new_state_into(std::vector<Part<dim, spacedim>> &parts);
 
-    // Get all new velocity vectors by moving them out of this object. Intended
-    // to be called at the end of the time step.
-    std::vector<LinearAlgebra::distributed::Vector<double>>
-    get_all_new_velocities();
+    // Return an estimate of the memory used by the stored and spare vectors,
+    // in bytes. The vectors owned by the Parts are not included.
+    std::size_t
+    memory_consumption() const;
 
     DeclExceptionMsg(ExcVectorNotAvailable,
                      "The requested vector is not available. This usually "
@@ -105,6 +126,8 @@ namespace fdl
                      "step at the beginning of a time step.");
 
   protected:
+    using VectorType = LinearAlgebra::distributed::Vector<double>;
+
     std::vector<SmartPointer<const Part<dim, spacedim>>> parts;
 
     enum class TimeStep
@@ -114,22 +137,52 @@ namespace fdl
       New
     };
 
+    enum class Quantity
+    {
+      Position,
+      Velocity,
+      Force
+    };
+
     TimeStep
     get_time_step(const double time) const;
 
+    // Get the stored vector (if it has been set) for a quantity at a time
+    // level.
+    const VectorType &
+    get_vector(const Quantity     quantity,
+               const TimeStep     time_step,
+               const unsigned int part_n) const;
+
+    // Store a vector for a quantity at a time level. Any previously stored
+    // vector is retired.
+    void
+    set_vector(const Quantity     quantity,
+               const TimeStep     time_step,
+               const unsigned int part_n,
+               VectorType       &&vector);
+
+    // Keep the storage of @p vector for later use by get_spare_vector().
+    void
+    retire_vector(const unsigned int part_n, VectorType &&vector) const;
+
     double current_time;
     double half_time;
     double new_time;
 
-    std::vector<LinearAlgebra::distributed::Vector<double>> current_forces;
-    std::vector<LinearAlgebra::distributed::Vector<double>> half_forces;
-    std::vector<LinearAlgebra::distributed::Vector<double>> new_forces;
+    // Stored vectors, indexed by quantity, time level, and then part. Empty
+    // vectors (i.e., vectors with no partitioner) have not been set.
+    std::array<std::array<std::vector<VectorType>, 3>, 3> vectors;
+
+    // Versions of the stored positions, indexed by time level and then part,
+    // taken from n_position_updates when they are set.
+    std::array<std::vector<std::uint64_t>, 3> position_versions;
 
-    std::vector<LinearAlgebra::distributed::Vector<double>> half_positions;
-    std::vector<LinearAlgebra::distributed::Vector<double>> new_positions;
+    // Number of calls to set_position().
+    std::uint64_t n_position_updates;
 
-    std::vector<LinearAlgebra::distributed::Vector<double>> half_velocities;
-    std::vector<LinearAlgebra::distributed::Vector<double>> new_velocities;
+    // Vectors available for reuse, indexed by part.
+    mutable std::vector<std::vector<VectorType>> spare_vectors;
   };
 } // namespace fdl
 
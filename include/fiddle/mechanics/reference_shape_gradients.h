@@ -0,0 +1,232 @@
+#ifndef included_fiddle_mechanics_reference_shape_gradients_h
+#define included_fiddle_mechanics_reference_shape_gradients_h
+
+#include <fiddle/base/config.h>
+
+#include <fiddle/base/exceptions.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/quadrature.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/tensor.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/mapping.h>
+
+#include <vector>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * Table of shape function gradients and JxW values, computed on the
+   * reference configuration, for every locally owned cell of a DoFHandler.
+   *
+   * The deformation gradient is the gradient of the position with respect to
+   * the reference configuration. Hence, for a Part whose Triangulation does
+   * not change, these values are the same at every time step and computing FF
+   * only requires a dot product between the cell's position DoFs and the
+   * stored gradients - i.e., no FEValues object needs to be reinitialized.
+   *
+   * Since the finite element is primitive and vector-valued (each component
+   * uses the same scalar element) only the gradient of the single nonzero
+   * component of each shape function is stored.
+   */
+  template <int dim, int spacedim = dim>
+  class ReferenceShapeGradients
+  {
+  public:
+    /**
+     * Constructor. Computes all values with an FEValues object set up with
+     * the given arguments.
+     */
+    ReferenceShapeGradients(const Mapping<dim, spacedim>    &mapping,
+                            const DoFHandler<dim, spacedim> &dof_handler,
+                            const Quadrature<dim>           &quadrature);
+
+    /**
+     * Get the DoFHandler used to set up the present object.
+     */
+    const DoFHandler<dim, spacedim> &
+    get_dof_handler() const;
+
+    /**
+     * Get the quadrature rule used to set up the present object.
+     */
+    const Quadrature<dim> &
+    get_quadrature() const;
+
+    /**
+     * Number of quadrature points per cell.
+     */
+    unsigned int
+    n_quadrature_points() const;
+
+    /**
+     * Number of DoFs per cell.
+     */
+    unsigned int
+    dofs_per_cell() const;
+
+    /**
+     * Return the index of the vector component in which shape function @p i
+     * is nonzero.
+     */
+    unsigned int
+    get_component(const unsigned int i) const;
+
+    /**
+     * Return the DoF indices of @p cell, which must be locally owned.
+     */
+    ArrayView<const types::global_dof_index>
+    get_dof_indices(
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+      const;
+
+    /**
+     * Return the gradients of the nonzero components of the shape functions
+     * on @p cell at quadrature point @p q.
+     */
+    ArrayView<const Tensor<1, spacedim>>
+    get_shape_gradients(
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      const unsigned int                                                 q)
+      const;
+
+    /**
+     * Return the JxW values on @p cell.
+     */
+    ArrayView<const double>
+    get_JxW_values(
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+      const;
+
+    /**
+     * Return the amount of memory used by the present object, in bytes.
+     */
+    std::size_t
+    memory_consumption() const;
+
+  protected:
+    /**
+     * Get the offset into the tables for @p cell.
+     */
+    std::size_t
+    get_cell_offset(
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+      const;
+
+    SmartPointer<const DoFHandler<dim, spacedim>> dof_handler;
+
+    Quadrature<dim> quadrature;
+
+    /**
+     * Nonzero component of each shape function.
+     */
+    std::vector<unsigned int> components;
+
+    /**
+     * Offset of each active cell's data: numbers::invalid_unsigned_int for
+     * cells which are not locally owned.
+     */
+    std::vector<unsigned int> cell_offsets;
+
+    std::vector<types::global_dof_index> dof_indices;
+
+    std::vector<Tensor<1, spacedim>> shape_gradients;
+
+    std::vector<double> JxW_values;
+  };
+
+  // --------------------------- inline functions --------------------------- //
+
+  template <int dim, int spacedim>
+  inline const DoFHandler<dim, spacedim> &
+  ReferenceShapeGradients<dim, spacedim>::get_dof_handler() const
+  {
+    return *dof_handler;
+  }
+
+  template <int dim, int spacedim>
+  inline const Quadrature<dim> &
+  ReferenceShapeGradients<dim, spacedim>::get_quadrature() const
+  {
+    return quadrature;
+  }
+
+  template <int dim, int spacedim>
+  inline unsigned int
+  ReferenceShapeGradients<dim, spacedim>::n_quadrature_points() const
+  {
+    return quadrature.size();
+  }
+
+  template <int dim, int spacedim>
+  inline unsigned int
+  ReferenceShapeGradients<dim, spacedim>::dofs_per_cell() const
+  {
+    return components.size();
+  }
+
+  template <int dim, int spacedim>
+  inline unsigned int
+  ReferenceShapeGradients<dim, spacedim>::get_component(
+    const unsigned int i) const
+  {
+    AssertIndexRange(i, components.size());
+    return components[i];
+  }
+
+  template <int dim, int spacedim>
+  inline std::size_t
+  ReferenceShapeGradients<dim, spacedim>::get_cell_offset(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+    const
+  {
+    AssertIndexRange(cell->active_cell_index(), cell_offsets.size());
+    const unsigned int offset = cell_offsets[cell->active_cell_index()];
+    Assert(offset != numbers::invalid_unsigned_int,
+           ExcMessage("Values are only available on locally owned cells."));
+    return offset;
+  }
+
+  template <int dim, int spacedim>
+  inline ArrayView<const types::global_dof_index>
+  ReferenceShapeGradients<dim, spacedim>::get_dof_indices(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+    const
+  {
+    return ArrayView<const types::global_dof_index>(
+      dof_indices.data() + get_cell_offset(cell) * dofs_per_cell(),
+      dofs_per_cell());
+  }
+
+  template <int dim, int spacedim>
+  inline ArrayView<const Tensor<1, spacedim>>
+  ReferenceShapeGradients<dim, spacedim>::get_shape_gradients(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    const unsigned int                                                 q) const
+  {
+    AssertIndexRange(q, n_quadrature_points());
+    return ArrayView<const Tensor<1, spacedim>>(
+      shape_gradients.data() +
+        (get_cell_offset(cell) * n_quadrature_points() + q) * dofs_per_cell(),
+      dofs_per_cell());
+  }
+
+  template <int dim, int spacedim>
+  inline ArrayView<const double>
+  ReferenceShapeGradients<dim, spacedim>::get_JxW_values(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+    const
+  {
+    return ArrayView<const double>(JxW_values.data() +
+                                     get_cell_offset(cell) *
+                                       n_quadrature_points(),
+                                   n_quadrature_points());
+  }
+} // namespace fdl
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef included_fiddle_mechanics_rigid_body_projection_h
+#define included_fiddle_mechanics_rigid_body_projection_h
+
+#include <fiddle/base/config.h>
+
+#include <fiddle/mechanics/part.h>
+
+#include <deal.II/base/point.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/tensor.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <array>
+#include <vector>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * Rigid body treatment of a Part.
+   *
+   * Some immersed structures are effectively rigid. Modeling them as very
+   * stiff elastic materials restricts the time step size and requires
+   * assembling load vectors and solving mass systems for both velocity
+   * interpolation and force spreading. This class instead replaces both with
+   * operations on the nodes of the Part's finite element:
+   *
+   * - project() computes the rigid velocity V + omega x (X - X_c) closest to
+   *   the Eulerian velocity u from the projection right-hand side b (i.e.,
+   *   b_i = (u, phi_i), the vector computed by interpolation before the mass
+   *   solve). The linear and angular momenta of u are exactly sum_i b_i and
+   *   sum_i (X_i - X_c) x b_i, and the mass, center of mass X_c, and inertia
+   *   tensor are computed from the lumped masses m_i = (1, phi_i). No mass
+   *   system is solved.
+   * - compute_constraint_force() computes the force c (U - u_h) which drives
+   *   the fluid inside the structure towards the rigid velocity U, in which
+   *   u_h = b / m is the lumped approximation of u and c is a density divided
+   *   by the time step size. No load vector is assembled.
+   *
+   * The finite element must be an FESystem with dim copies of a single scalar
+   * element whose lumped masses are positive (e.g., FE_Q).
+   */
+  template <int dim>
+  class RigidBodyProjection
+  {
+  public:
+    /**
+     * Constructor. Computes the lumped masses of @p part.
+     */
+    RigidBodyProjection(const Part<dim> &part);
+
+    /**
+     * Compute the rigid velocity closest to the Eulerian velocity whose
+     * projection right-hand side is @p rhs at the position @p position and
+     * store it in @p velocity.
+     */
+    void
+    project(const LinearAlgebra::distributed::Vector<double> &position,
+            const LinearAlgebra::distributed::Vector<double> &rhs,
+            LinearAlgebra::distributed::Vector<double>       &velocity);
+
+    /**
+     * Set @p force to <code>coefficient * (U - u_h)</code> where U and u_h
+     * are the rigid and lumped velocities computed by the last call to
+     * project(). If project() has not been called yet then @p force is zero.
+     */
+    void
+    compute_constraint_force(
+      const double                                coefficient,
+      LinearAlgebra::distributed::Vector<double> &force) const;
+
+    /**
+     * Return the total (lumped) mass of the structure.
+     */
+    double
+    get_mass() const;
+
+    /**
+     * Return the center of mass computed by the last call to project().
+     */
+    const Point<dim> &
+    get_center() const;
+
+    /**
+     * Return the translational velocity computed by the last call to
+     * project().
+     */
+    const Tensor<1, dim> &
+    get_translational_velocity() const;
+
+    /**
+     * Return the angular velocity computed by the last call to project(). In
+     * 2D only the third component is nonzero.
+     */
+    const Tensor<1, 3> &
+    get_angular_velocity() const;
+
+  protected:
+    SmartPointer<const Part<dim>> part;
+
+    /**
+     * DoFs of each component of each locally owned node.
+     */
+    std::vector<std::array<types::global_dof_index, dim>> node_dofs;
+
+    /**
+     * Lumped mass of each locally owned node.
+     */
+    std::vector<double> node_masses;
+
+    /**
+     * Total mass of the structure.
+     */
+    double mass;
+
+    /**
+     * Inverse lumped mass of each DoF.
+     */
+    LinearAlgebra::distributed::Vector<double> inverse_lumped_masses;
+
+    /**
+     * Results of the last call to project().
+     */
+    Point<dim> center;
+
+    Tensor<1, dim> translational_velocity;
+
+    Tensor<1, 3> angular_velocity;
+
+    LinearAlgebra::distributed::Vector<double> rigid_velocity;
+
+    LinearAlgebra::distributed::Vector<double> lumped_velocity;
+  };
+} // namespace fdl
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef included_fiddle_mechanics_simplex_mass_operator_h
+#define included_fiddle_mechanics_simplex_mass_operator_h
+
+#include <fiddle/base/config.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/matrix_free.h>
+FDL_DISABLE_EXTRA_DIAGNOSTICS
+#include <deal.II/matrix_free/operators.h>
+FDL_ENABLE_EXTRA_DIAGNOSTICS
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * Matrix-free mass operator for vector-valued simplex finite elements
+   * (i.e., FESystem objects with spacedim copies of FE_SimplexP).
+   *
+   * deal.II only supports simplex elements in MatrixFree with the generic
+   * runtime-degree FEEvaluation (<code>fe_degree = -1</code>), in which
+   * every loop over DoFs and quadrature points has a runtime bound. This
+   * class instead multiplies by a precomputed table of shape function values
+   * and, for FE_SimplexP of degree one through three, uses kernels in which
+   * the number of DoFs is a compile-time constant. The table is computed with
+   * the MatrixFree object's quadrature rule, so this works with any simplex
+   * quadrature (e.g., QGaussSimplex or QWitherdenVincentSimplex).
+   *
+   * Like MatrixFreeOperators::MassOperator, compute_diagonal() computes the
+   * row sums of the mass matrix (i.e., the lumped mass matrix).
+   */
+  template <int dim>
+  class SimplexMassOperator
+    : public MatrixFreeOperators::Base<
+        dim,
+        LinearAlgebra::distributed::Vector<double>>
+  {
+  public:
+    /**
+     * Set up the operator. This function hides the equivalent function in
+     * the base class since it also computes the table of shape function
+     * values.
+     */
+    void
+    initialize(std::shared_ptr<const MatrixFree<dim, double>> matrix_free);
+
+    virtual void
+    compute_diagonal() override;
+
+    /**
+     * Add the mass matrix times each vector in @p src to the corresponding
+     * vector in @p dst. Unlike vmult(), this function does not update ghost
+     * values, compress, or handle constraints: it only performs the loop over
+     * cells, so that several vectors can share their communication.
+     */
+    void
+    apply_add_to_cells(
+      const std::vector<LinearAlgebra::distributed::Vector<double> *> &dst,
+      const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+        &src) const;
+
+  protected:
+    virtual void
+    apply_add(
+      LinearAlgebra::distributed::Vector<double>       &dst,
+      const LinearAlgebra::distributed::Vector<double> &src) const override;
+
+    /**
+     * Apply the mass matrix to the cell batches in @p cell_range.
+     */
+    void
+    apply_add_to_cell_range(
+      const std::vector<LinearAlgebra::distributed::Vector<double> *> &dst,
+      const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+                                                &src,
+      const std::pair<unsigned int, unsigned int> &cell_range) const;
+
+    /**
+     * Number of DoFs per vector component.
+     */
+    unsigned int n_dofs_per_component;
+
+    /**
+     * Values of the scalar shape functions: entry <code>q *
+     * n_dofs_per_component + i</code> is the value of shape function i at
+     * quadrature point q.
+     */
+    std::vector<double> shape_values;
+  };
+} // namespace fdl
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef included_fiddle_mechanics_surface_mass_operator_h
+#define included_fiddle_mechanics_surface_mass_operator_h
+
+#include <fiddle/base/config.h>
+
+#include <deal.II/base/partitioner.h>
+#include <deal.II/base/quadrature.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/mapping.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <memory>
+#include <vector>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * Mass operator for vector-valued finite elements (i.e., FESystem objects
+   * with spacedim copies of a scalar element) on codimension one meshes,
+   * for which deal.II's MatrixFree is not available.
+   *
+   * The mass matrix of a surface only depends on the geometry through the
+   * JxW values (i.e., the surface area element) at the quadrature points, so
+   * this class precomputes those values and the DoF indices of each locally
+   * owned cell once. If the scalar element is FE_Q, the quadrature is a
+   * tensor product with <code>degree + 1</code> points in each direction
+   * (e.g., QGauss), and the degree is at most five then the reference shape
+   * function values are applied with sum factorization, i.e., as one
+   * dimensional contractions in each coordinate direction with compile-time
+   * sizes. Otherwise (e.g., for simplices) a table of the values of every
+   * shape function at every quadrature point is used instead.
+   *
+   * Hanging node constraints are not supported.
+   */
+  template <int dim, int spacedim>
+  class SurfaceMassOperator
+  {
+  public:
+    /**
+     * Constructor. Vectors used with this class must have the parallel
+     * layout given by @p partitioner.
+     */
+    SurfaceMassOperator(
+      const Mapping<dim, spacedim>                             &mapping,
+      const DoFHandler<dim, spacedim>                          &dof_handler,
+      const Quadrature<dim>                                    &quadrature,
+      const std::shared_ptr<const Utilities::MPI::Partitioner> &partitioner);
+
+    /**
+     * Add the mass matrix times each vector in @p src to the corresponding
+     * vector in @p dst. Like SimplexMassOperator::apply_add_to_cells(), this
+     * function only performs the loop over cells: the ghost values of each
+     * vector in @p src must be up to date and the vectors in @p dst must be
+     * compressed afterwards.
+     */
+    void
+    apply_add_to_cells(
+      const std::vector<LinearAlgebra::distributed::Vector<double> *> &dst,
+      const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+        &src) const;
+
+    /**
+     * Return the inverse of the lumped mass matrix (i.e., of the row sums of
+     * the mass matrix), which is used for Jacobi preconditioning.
+     */
+    const LinearAlgebra::distributed::Vector<double> &
+    get_inverse_lumped_masses() const;
+
+    /**
+     * Return an estimate of the memory used by this object, in bytes.
+     */
+    std::size_t
+    memory_consumption() const;
+
+  protected:
+    /**
+     * Number of DoFs per vector component on each cell.
+     */
+    unsigned int n_dofs_per_component;
+
+    /**
+     * Number of quadrature points on each cell.
+     */
+    unsigned int n_q_points;
+
+    /**
+     * Number of DoFs (and quadrature points) in each coordinate direction if
+     * sum factorization is used and zero otherwise.
+     */
+    unsigned int n_dofs_1d;
+
+    /**
+     * Values of the one-dimensional shape functions: entry <code>q *
+     * n_dofs_1d + i</code> is the value of shape function i at quadrature
+     * point q. Only used with sum factorization.
+     */
+    std::vector<double> shape_values_1d;
+
+    /**
+     * Values of the scalar shape functions: entry <code>q *
+     * n_dofs_per_component + i</code> is the value of shape function i at
+     * quadrature point q. Only used without sum factorization.
+     */
+    std::vector<double> shape_values;
+
+    /**
+     * Local (i.e., in the numbering of the partitioner) DoF indices of each
+     * locally owned cell, ordered by component and then, with sum
+     * factorization, lexicographically.
+     */
+    std::vector<unsigned int> dof_indices;
+
+    /**
+     * JxW values of each locally owned cell.
+     */
+    std::vector<double> JxW_values;
+
+    /**
+     * Inverse of the lumped mass matrix.
+     */
+    LinearAlgebra::distributed::Vector<double> inverse_lumped_masses;
+  };
+} // namespace fdl
+
+#endif
@@ -0,0 +1,131 @@
+#ifndef included_fiddle_postprocess_background_writer_h
+#define included_fiddle_postprocess_background_writer_h
+
+#include <fiddle/base/config.h>
+
+#include <deal.II/base/thread_management.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <mpi.h>
+
+#include <fstream>
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fdl
+{
+  template <int, int>
+  class Part;
+}
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * Class which writes Part data (positions, velocities, and other fields
+   * such as forces) and time series (e.g., values computed by meters) to
+   * files without blocking the caller.
+   *
+   * Each function takes a snapshot of the data it needs when it is called
+   * (e.g., write_part() builds the graphical output patches immediately, so
+   * the Part may be modified right after it returns) and then formats and
+   * writes the data to disk in a background task. Tasks run one at a time in
+   * the order in which they were created.
+   *
+   * Since the background tasks do not communicate, each processor writes its
+   * own piece of the graphical output and the first processor writes the
+   * .pvtu record file, in the same format as
+   * DataOutInterface::write_vtu_with_pvtu_record() (with zero groups).
+   *
+   * @note The destructor calls wait(), so all files are complete once this
+   * object is destroyed.
+   */
+  template <int dim, int spacedim = dim>
+  class BackgroundWriter
+  {
+  public:
+    /**
+     * Constructor. All files are written into @p directory.
+     */
+    BackgroundWriter(const std::string &directory, const MPI_Comm comm);
+
+    /**
+     * Destructor. Waits for all pending writes to finish.
+     */
+    ~BackgroundWriter();
+
+    /**
+     * Write the velocity of @p part, in the current position of @p part,
+     * and each vector in @p additional_vectors (which must be defined on the
+     * DoFHandler of @p part) with the given name to the file series @p name.
+     *
+     * This call is collective.
+     */
+    void
+    write_part(
+      const Part<dim, spacedim> &part,
+      const std::string         &name,
+      const unsigned int         counter,
+      const std::vector<
+        std::pair<const LinearAlgebra::distributed::Vector<double> *,
+                  std::string>> &additional_vectors = {});
+
+    /**
+     * Append a line containing @p time followed by @p values to the text
+     * file @p file_name. The file is truncated the first time it is written
+     * by this object. Only the first processor writes anything, so the other
+     * processors may call this function with any values.
+     */
+    void
+    write_time_series(const std::string         &file_name,
+                      const double               time,
+                      const std::vector<double> &values);
+
+    /**
+     * Wait for all pending writes to finish.
+     */
+    void
+    wait();
+
+  protected:
+    /**
+     * Add @p work to the end of the queue of background tasks.
+     */
+    void
+    enqueue(std::function<void()> work);
+
+    /**
+     * Output directory.
+     */
+    std::string directory;
+
+    /**
+     * Rank of the current processor.
+     */
+    unsigned int rank;
+
+    /**
+     * Number of processors.
+     */
+    unsigned int n_procs;
+
+    /**
+     * Most recently created background task. Each task joins the previous
+     * one before doing any work.
+     */
+    Threads::Task<> last_task;
+
+    /**
+     * Open time series files, indexed by name. Only accessed by the
+     * background tasks.
+     */
+    std::map<std::string, std::ofstream> time_series_streams;
+  };
+} // namespace fdl
+
+#endif
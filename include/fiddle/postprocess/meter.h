@@ -3,6 +3,9 @@
 
 #include <fiddle/base/config.h>
 
+#include <fiddle/base/reduction_handle.h>
+
+#include <deal.II/base/bounding_box.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/smartpointer.h>
 #include <deal.II/base/tensor.h>
@@ -16,9 +19,14 @@
 
 #include <deal.II/lac/la_parallel_vector.h>
 
+#include <deal.II/numerics/rtree.h>
+
 #include <tbox/Pointer.h>
 
 #include <memory>
+#include <optional>
+#include <string>
+#include <vector>
 
 namespace SAMRAI
 {
@@ -33,6 +41,9 @@ namespace fdl
 {
   template <int, int>
   class NodalInteraction;
+
+  template <int, int>
+  class MeterCollection;
 }
 
 namespace fdl
@@ -119,6 +130,18 @@ namespace fdl
     compute_centroid_value(const int          data_idx,
                            const std::string &kernel_name) const;
 
+    /**
+     * Like compute_centroid_value(), but do not wait for the final
+     * communication step to finish. The value is available from the returned
+     * object once ReductionHandle::get() is called.
+     *
+     * @note This function is collective - only the final reduction is
+     * nonblocking.
+     */
+    ReductionHandle<double>
+    compute_centroid_value_async(const int          data_idx,
+                                 const std::string &kernel_name) const;
+
     /**
      * Compute the mean value of some scalar-valued quantity.
      *
@@ -130,6 +153,34 @@ namespace fdl
     compute_mean_value(const int          data_idx,
                        const std::string &kernel_name) const;
 
+    /**
+     * Like compute_mean_value(), but do not wait for the final reduction to
+     * finish. This permits hiding the cost of the reduction behind other work
+     * when the value is not needed immediately (e.g., when it is only
+     * written to a log file).
+     */
+    ReductionHandle<double>
+    compute_mean_value_async(const int          data_idx,
+                             const std::string &kernel_name) const;
+
+    /**
+     * Compute the mean values of several scalar-valued quantities. All fields
+     * are interpolated in one transaction and then integrated in a single
+     * pass over the meter with a single reduction, so this is considerably
+     * cheaper than calling compute_mean_value() for each field.
+     */
+    std::vector<double>
+    compute_mean_values(const std::vector<int> &data_indices,
+                        const std::string      &kernel_name) const;
+
+    /**
+     * Like compute_mean_values(), but do not wait for the final reduction to
+     * finish.
+     */
+    ReductionHandle<std::vector<double>>
+    compute_mean_values_async(const std::vector<int> &data_indices,
+                              const std::string      &kernel_name) const;
+
     /**
      * Interpolate a scalar-valued quantity.
      */
@@ -147,19 +198,43 @@ namespace fdl
     /**
      * Return whether or not all vertices of the Triangulation are actually
      * inside the domain defined by the PatchHierarchy.
+     *
+     * The result is cached until the meter moves, so calling this function
+     * repeatedly (e.g., once per time step) is cheap.
      */
     bool
     compute_vertices_inside_domain() const;
 
     /** @} */
 
+    /**
+     * Return an estimate of the memory used by this object, in bytes. This
+     * includes the meter Triangulation, both DoFHandlers, and the interaction
+     * object.
+     */
+    virtual std::size_t
+    memory_consumption() const;
+
   protected:
+    /**
+     * MeterCollection needs access to the interaction object and FE data
+     * structures to batch interpolations.
+     */
+    friend class MeterCollection<dim, spacedim>;
+
     /**
      * Reinitialize all the FE data structures, including vectors and mappings.
      */
     void
     reinit_dofs();
 
+    /**
+     * Set identity_position to the current positions of the vertices of
+     * meter_tria. Called by reinit_dofs().
+     */
+    void
+    reinit_identity_position();
+
     /**
      * Reinitialize centroid data.
      */
@@ -174,6 +249,25 @@ namespace fdl
     void
     reinit_interaction();
 
+    /**
+     * Interpolate several scalar- or vector-valued fields with a single
+     * NodalInteraction transaction. The returned vectors have updated ghost
+     * values.
+     */
+    std::vector<LinearAlgebra::distributed::Vector<double>>
+    interpolate_fields(const std::vector<int> &data_indices,
+                       const std::string      &kernel_name,
+                       const bool              vector_valued) const;
+
+    /**
+     * Compute, on the locally owned cells, the integral of each scalar field
+     * followed by the measure of the meter. The sums of these values over
+     * all processors determine the mean values.
+     */
+    std::vector<double>
+    compute_local_integrals(const std::vector<int> &data_indices,
+                            const std::string      &kernel_name) const;
+
     /**
      * Helper function which calls the previous three functions in the correct
      * order (dofs, centroid, then interaction).
@@ -185,6 +279,34 @@ namespace fdl
     void
     internal_reinit();
 
+    /**
+     * Alternative to internal_reinit() for when only the vertices of
+     * meter_tria moved (i.e., its topology did not change since the last
+     * call to internal_reinit()). The DoFHandlers and partitioners are kept,
+     * and the interaction object is updated with
+     * NodalInteraction::update_position() when possible, so this is much
+     * cheaper than internal_reinit().
+     */
+    void
+    internal_reinit_vertices();
+
+    /**
+     * Alternative to internal_reinit_vertices() for when every vertex of
+     * meter_tria was shifted by @p translation. Since rigid translations do
+     * not change which cell contains the centroid (or where it is in that
+     * cell) the centroid is shifted instead of being searched for again.
+     */
+    void
+    internal_reinit_translation(const Tensor<1, spacedim> &translation);
+
+    /**
+     * Update the interaction object after the vertices of meter_tria moved,
+     * falling back to reinit_interaction() when
+     * NodalInteraction::update_position() cannot be used.
+     */
+    void
+    update_interaction_position();
+
     /**
      * Meter centroid.
      */
@@ -255,6 +377,19 @@ namespace fdl
      * Interaction object.
      */
     std::unique_ptr<NodalInteraction<dim, spacedim>> nodal_interaction;
+
+    /**
+     * Tree containing the boxes, in SAMRAI index space, which describe the
+     * physical domain. Since the physical domain never changes this is set up
+     * once, when compute_vertices_inside_domain() is first called.
+     */
+    mutable RTree<BoundingBox<spacedim>> domain_box_rtree;
+
+    /**
+     * Cached result of compute_vertices_inside_domain(). Reset whenever the
+     * vertices move.
+     */
+    mutable std::optional<bool> vertices_inside_domain;
   };
 
 
@@ -0,0 +1,96 @@
+#ifndef included_fiddle_postprocess_meter_collection_h
+#define included_fiddle_postprocess_meter_collection_h
+
+#include <fiddle/base/config.h>
+
+#include <fiddle/postprocess/meter.h>
+
+#include <deal.II/base/tensor.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * Class for evaluating many meters (e.g., a few dozen SurfaceMeter objects
+   * placed at valve planes and outflow cross sections) at once.
+   *
+   * Calling Meter::compute_mean_value() or SurfaceMeter::compute_flux() on
+   * each meter in turn runs one complete interpolation, with its own
+   * communication rounds, and at least one global reduction per meter. This
+   * class instead starts the interpolations of every meter before finishing
+   * any of them (so that their communication overlaps) and then computes the
+   * requested quantities for all meters with a single reduction.
+   *
+   * This class does not own the meters - they must remain valid (and their
+   * positions must not be changed) while they are part of the collection.
+   */
+  template <int dim, int spacedim = dim>
+  class MeterCollection
+  {
+  public:
+    /**
+     * Constructor. All meters must use the same communicator.
+     */
+    MeterCollection(const std::vector<const Meter<dim, spacedim> *> &meters);
+
+    /**
+     * Return the number of meters.
+     */
+    std::size_t
+    size() const;
+
+    /**
+     * Compute the mean values of some scalar-valued quantity on every meter.
+     * Equivalent to calling Meter::compute_mean_value() on each meter.
+     */
+    std::vector<double>
+    compute_mean_values(const int          data_idx,
+                        const std::string &kernel_name) const;
+
+    /**
+     * Compute the fluxes of some vector-valued quantity through every meter
+     * and their mean normal vectors. Equivalent to calling
+     * SurfaceMeter::compute_flux() on each meter.
+     *
+     * @note This function requires that the meters are codimension one
+     * meshes.
+     */
+    std::vector<std::pair<double, Tensor<1, spacedim>>>
+    compute_fluxes(const int data_idx, const std::string &kernel_name) const;
+
+  protected:
+    /**
+     * Interpolate a scalar- or vector-valued field onto every meter. The
+     * transactions of all meters are started before any are finished.
+     */
+    std::vector<LinearAlgebra::distributed::Vector<double>>
+    interpolate_fields(const int          data_idx,
+                       const std::string &kernel_name,
+                       const bool         vector_valued) const;
+
+    /**
+     * Pointers to the meters.
+     */
+    std::vector<const Meter<dim, spacedim> *> meters;
+  };
+
+
+  // --------------------------- inline functions --------------------------- //
+
+
+  template <int dim, int spacedim>
+  inline std::size_t
+  MeterCollection<dim, spacedim>::size() const
+  {
+    return meters.size();
+  }
+} // namespace fdl
+
+#endif
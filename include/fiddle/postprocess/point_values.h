@@ -26,6 +26,11 @@ namespace fdl
    * Convenience class for computing values of a finite element field at a set
    * of known points over time. Sets up some internal data structures that make
    * repeated calls to evaluate() much faster.
+   *
+   * In particular, the search for the cells containing the evaluation points
+   * is only done when this object is set up, when reinit() is called (e.g.,
+   * after the mapping changes), or when the Triangulation changes. Each call
+   * to evaluate() only computes values and communicates them.
    */
   template <int n_components, int dim, int spacedim = dim>
   class PointValues
@@ -42,6 +47,14 @@ namespace fdl
                 const DoFHandler<dim, spacedim>    &dof_handler,
                 const std::vector<Point<spacedim>> &evaluation_points);
 
+    /**
+     * Set up the internal data structures again with a new mapping (or the
+     * same mapping, if it depends on some vector which changed - e.g., a
+     * MappingFEField). This call is collective.
+     */
+    void
+    reinit(const Mapping<dim, spacedim> &mapping);
+
     /**
      * Evaluate the finite element field specified by @p vector at the stored
      * evaluation points. For example - to get the displacement of a point over
@@ -50,6 +63,16 @@ namespace fdl
     std::vector<Tensor<1, n_components>>
     evaluate(const LinearAlgebra::distributed::Vector<double> &vector) const;
 
+    /**
+     * Evaluate several finite element fields (e.g., the position and
+     * velocity) at the stored evaluation points. The ith entry of the result
+     * contains the values of <code>*vectors[i]</code>.
+     */
+    std::vector<std::vector<Tensor<1, n_components>>>
+    evaluate(
+      const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+        &vectors) const;
+
     /**
      * Return a reference to the evaluation points originally used to set up
      * this object.
@@ -76,8 +99,10 @@ namespace fdl
 
     /**
      * Internal data structure that manages both evaluation and communication.
+     * This object is invalidated when the Triangulation changes, in which
+     * case evaluate() sets it up again.
      */
-    Utilities::MPI::RemotePointEvaluation<dim, spacedim>
+    mutable Utilities::MPI::RemotePointEvaluation<dim, spacedim>
       remote_point_evaluation;
   };
 
@@ -0,0 +1,134 @@
+#ifndef included_fiddle_postprocess_stream_writer_h
+#define included_fiddle_postprocess_stream_writer_h
+
+#include <fiddle/base/config.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <mpi.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fdl
+{
+  template <int, int>
+  class Part;
+}
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * Class which publishes Part data (positions, velocities, and other fields
+   * such as forces) and time series (e.g., values computed by meters) once
+   * per step through an ADIOS2 engine, e.g., SST to stream the data to a
+   * concurrently running analysis job or BP5 to aggregate the data of all
+   * processors into a few files.
+   *
+   * Unlike BackgroundWriter, no graphical output is built: each field of a
+   * Part named <code>name</code> is written as the global array
+   * <code>name/field</code> containing the DoF values of that field, in the
+   * DoF order of the Part's DoFHandler (which must have contiguous locally
+   * owned DoFs, as is the case for parallel::shared::Triangulation). The
+   * position and velocity are written as <code>name/X</code> and
+   * <code>name/U</code> and the name of the finite element is written as the
+   * attribute <code>name/fe</code>. The time of each step is written as the
+   * single value <code>time</code>.
+   *
+   * All data is copied by the time each function returns, so the Part may be
+   * modified immediately afterwards.
+   *
+   * This class is only available when fiddle is configured with
+   * FDL_ENABLE_ADIOS2.
+   */
+  template <int dim, int spacedim = dim>
+  class StreamWriter
+  {
+  public:
+    /**
+     * Constructor. Opens the stream (or file) @p stream_name with the ADIOS2
+     * engine @p engine_type, e.g., "BP5" or "SST", configured with @p
+     * parameters (e.g., {{"NumAggregators", "4"}} for BP5).
+     *
+     * This call is collective.
+     */
+    StreamWriter(const std::string                        &stream_name,
+                 const MPI_Comm                            comm,
+                 const std::string                        &engine_type = "BP5",
+                 const std::map<std::string, std::string> &parameters = {});
+
+    /**
+     * Destructor. Closes the stream.
+     */
+    ~StreamWriter();
+
+    /**
+     * Start a new step at time @p time. All data written before the next
+     * call to end_step() belongs to this step.
+     *
+     * This call is collective.
+     */
+    void
+    begin_step(const double time);
+
+    /**
+     * Write the position and velocity of @p part and each vector in @p
+     * additional_vectors (which must be defined on the DoFHandler of @p part)
+     * with the given name.
+     *
+     * This call is collective.
+     */
+    void
+    write_part(
+      const Part<dim, spacedim> &part,
+      const std::string         &name,
+      const std::vector<
+        std::pair<const LinearAlgebra::distributed::Vector<double> *,
+                  std::string>> &additional_vectors = {});
+
+    /**
+     * Write @p values (e.g., the flux computed by a meter) as the array @p
+     * name. Only the first processor writes anything, so the other processors
+     * may call this function with any values.
+     */
+    void
+    write_values(const std::string &name, const std::vector<double> &values);
+
+    /**
+     * Finish the current step, which makes it available to readers.
+     *
+     * This call is collective.
+     */
+    void
+    end_step();
+
+  protected:
+    /**
+     * Write the locally owned entries of @p vector as the global array @p
+     * name.
+     */
+    void
+    write_vector(const std::string                                &name,
+                 const LinearAlgebra::distributed::Vector<double> &vector);
+
+    /**
+     * Rank of the current processor.
+     */
+    unsigned int rank;
+
+    /**
+     * ADIOS2 data structures (which may only be included when ADIOS2 is
+     * available).
+     */
+    struct Implementation;
+
+    std::unique_ptr<Implementation> implementation;
+  };
+} // namespace fdl
+
+#endif
@@ -3,6 +3,8 @@
 
 #include <fiddle/base/config.h>
 
+#include <fiddle/grid/surface_tria.h>
+
 #include <fiddle/postprocess/meter.h>
 
 #include <deal.II/base/point.h>
@@ -192,6 +194,35 @@ namespace fdl
     virtual std::pair<double, Tensor<1, spacedim>>
     compute_flux(const int data_idx, const std::string &kernel_name) const;
 
+    /**
+     * Compute the fluxes of several vector-valued quantities through the
+     * meter mesh, each paired with the mean normal vector of the mesh. All
+     * fields are interpolated in one transaction and then integrated in a
+     * single pass over the meter with a single reduction, so this is
+     * considerably cheaper than calling compute_flux() for each field.
+     */
+    /**
+     * Like compute_flux(), but do not wait for the final reduction to finish.
+     * This permits hiding the cost of the reduction behind other work (e.g.,
+     * the fluid solve) when the flux is only needed later, e.g., when it is
+     * written to a log file.
+     */
+    ReductionHandle<std::pair<double, Tensor<1, spacedim>>>
+    compute_flux_async(const int          data_idx,
+                       const std::string &kernel_name) const;
+
+    std::vector<std::pair<double, Tensor<1, spacedim>>>
+    compute_fluxes(const std::vector<int> &data_indices,
+                   const std::string      &kernel_name) const;
+
+    /**
+     * Like compute_fluxes(), but do not wait for the final reduction to
+     * finish.
+     */
+    ReductionHandle<std::vector<std::pair<double, Tensor<1, spacedim>>>>
+    compute_fluxes_async(const std::vector<int> &data_indices,
+                         const std::string      &kernel_name) const;
+
     /**
      * Compute the mean normal vector. This is useful for checking the
      * orientation of the mesh.
@@ -200,6 +231,15 @@ namespace fdl
     compute_mean_normal_vector() const;
 
   protected:
+    /**
+     * Compute, on the locally owned cells, the flux of each vector field
+     * followed by the integral of the normal vector. The sums of these values
+     * over all processors determine the fluxes and mean normal vector.
+     */
+    std::vector<double>
+    compute_local_fluxes(const std::vector<int> &data_indices,
+                         const std::string      &kernel_name) const;
+
     /**
      * Reinitialize the stored Triangulation.
      *
@@ -211,8 +251,14 @@ namespace fdl
      * mesh. In the second, if we are in 2D then we typically want to compute
      * flow through a surface: the best way to do this is to specify two
      * points and then add more.
+     *
+     * If the new mesh has the same topology (i.e., the same vertex and cell
+     * numbering) as the present one then only the vertices of the present
+     * mesh are moved.
+     *
+     * @return Whether or not the topology of the mesh changed.
      */
-    void
+    bool
     reinit_tria(const std::vector<Point<spacedim>> &boundary_points,
                 const bool place_additional_boundary_vertices);
 
@@ -231,7 +277,9 @@ namespace fdl
     /**
      * Internal reinitialization function which updates all data structures to
      * account for possible meter movement. Call the other protected reinit_*()
-     * functions in the right order.
+     * functions in the right order. If the topology of the mesh did not
+     * change then the FE data structures are kept (see
+     * Meter::internal_reinit_vertices()).
      */
     void
     internal_reinit(const bool                              reinit_tria,
@@ -258,6 +306,13 @@ namespace fdl
      * Mean meter velocity.
      */
     Tensor<1, spacedim> mean_velocity;
+
+    /**
+     * Cache of the planar Triangulation (only used in 3D), which lets
+     * reinit_tria() move the previous Triangulation instead of creating a
+     * new one when the boundary points have only moved.
+     */
+    PlanarTriangulationCache planar_tria_cache;
   };
 
 
@@ -39,7 +39,8 @@ namespace fdl
                 tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy);
 
     /**
-     * Reinitialize the volume meter to have a new center.
+     * Reinitialize the volume meter to have a new center. Since the meter is
+     * only translated, this is much cheaper than setting up a new meter.
      */
     void
     reinit(const Point<spacedim> &new_center);
@@ -23,6 +23,8 @@ namespace fdl
    * Hence we can compute the equivalent global dofs as an array, where the
    * overlap dofs are the array indices and the native dofs are the values.
    *
+   * The dofs on each cell are looked up on up to @p n_threads threads.
+   *
    * @note This function is collective over the communicator used by @p
    * native_dof_handler.
    */
@@ -31,7 +33,8 @@ namespace fdl
   compute_overlap_to_native_dof_translation(
     const fdl::OverlapTriangulation<dim, spacedim> &overlap_tria,
     const DoFHandler<dim, spacedim>                &overlap_dof_handler,
-    const DoFHandler<dim, spacedim>                &native_dof_handler);
+    const DoFHandler<dim, spacedim>                &native_dof_handler,
+    const unsigned int                              n_threads = 1);
 } // namespace fdl
 
 #endif
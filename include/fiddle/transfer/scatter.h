@@ -3,6 +3,8 @@
 
 #include <fiddle/base/config.h>
 
+#include <fiddle/base/exceptions.h>
+
 #include <deal.II/base/aligned_vector.h>
 #include <deal.II/base/index_set.h>
 
@@ -11,10 +13,109 @@
 
 #include <mpi.h>
 
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
 namespace fdl
 {
   using namespace dealii;
 
+  /**
+   * Possible ways in which Scatter communicates.
+   */
+  enum class ScatterBackend
+  {
+    /**
+     * Persistent point-to-point messages (one send and one receive per
+     * neighboring processor).
+     */
+    PointToPoint,
+    /**
+     * A distributed graph communicator (created with
+     * MPI_Dist_graph_create_adjacent()) with one MPI_Ineighbor_alltoallv() per
+     * scatter. Some MPI implementations can schedule these messages better
+     * than individual sends and receives.
+     */
+    NeighborCollective,
+    /**
+     * Same as PointToPoint, except that global to overlap scatters of single
+     * vectors read values owned by processors on the same node directly from
+     * an MPI-3 shared memory window: only values owned by processors on other
+     * nodes are sent as messages. Since the shared memory window is
+     * synchronized with barriers, global_to_overlap_start() is collective over
+     * the processors on each node in this case.
+     */
+    SharedMemory
+  };
+
+  /**
+   * Convert a name used in an input database ("POINT_TO_POINT",
+   * "NEIGHBOR_COLLECTIVE", or "SHARED_MEMORY") to the equivalent
+   * ScatterBackend.
+   */
+  inline ScatterBackend
+  to_scatter_backend(const std::string &backend_name)
+  {
+    if (backend_name == "POINT_TO_POINT")
+      return ScatterBackend::PointToPoint;
+    else if (backend_name == "NEIGHBOR_COLLECTIVE")
+      return ScatterBackend::NeighborCollective;
+    else if (backend_name == "SHARED_MEMORY")
+      return ScatterBackend::SharedMemory;
+    AssertThrow(false,
+                ExcMessage("Unknown scatter backend " + backend_name +
+                           ": valid names are POINT_TO_POINT, "
+                           "NEIGHBOR_COLLECTIVE, and SHARED_MEMORY."));
+    return ScatterBackend::PointToPoint;
+  }
+
+  /**
+   * Counters describing the communication done by one or more Scatter
+   * objects on this processor.
+   */
+  struct ScatterStatistics
+  {
+    /**
+     * Number of scatters started (in either direction).
+     */
+    unsigned long n_scatters = 0;
+
+    /**
+     * Number of messages sent and received. With
+     * ScatterBackend::SharedMemory, values read from the shared memory
+     * window are not counted.
+     */
+    unsigned long n_messages_sent     = 0;
+    unsigned long n_messages_received = 0;
+
+    /**
+     * Number of bytes sent and received.
+     */
+    std::size_t bytes_sent     = 0;
+    std::size_t bytes_received = 0;
+
+    /**
+     * Maximum number of processors with which this processor exchanges data.
+     */
+    unsigned int n_neighbors = 0;
+
+    /**
+     * Wall time spent in the finish functions (i.e., mostly waiting for
+     * messages). Requests completed by some other object after calling
+     * Scatter::delegate_outstanding_requests() are not counted.
+     */
+    double finish_time = 0.0;
+
+    /**
+     * Add the counters of @p other to this object.
+     */
+    ScatterStatistics &
+    operator+=(const ScatterStatistics &other);
+  };
+
   /**
    * dealii::MPI::Partitioner-based replacement for PETSc's VecScatter. Moves
    * data back-and-forth from the standard 'global' partitioning to the overlap
@@ -26,6 +127,14 @@ namespace fdl
    * at a time: i.e., after each start the corresponding finish function must be
    * called.
    *
+   * Since the communication pattern is fixed when the object is constructed,
+   * each scatter direction and channel uses persistent MPI requests (set up
+   * with MPI_Send_init() and MPI_Recv_init() on first use) which are
+   * restarted with MPI_Startall() by each subsequent scatter.
+   *
+   * Single vector scatters can optionally send values in single precision
+   * (see set_reduced_precision()).
+   *
    * @todo Add a constructor taking a dealii::MPI::Partitioner object to share
    * communication data between instances.
    */
@@ -50,11 +159,27 @@ namespace fdl
     operator=(Scatter<T> &&);
 
     /**
-     * Constructor.
+     * Constructor. This call is collective over @p communicator.
+     *
+     * If @p backend is ScatterBackend::NeighborCollective then this also
+     * creates a distributed graph communicator whose neighbors are the
+     * processors with which this processor exchanges ghost data. Since
+     * neighborhood collectives do not have tags the channel arguments of the
+     * start functions are not used in that case. Similarly, if @p backend is
+     * ScatterBackend::SharedMemory then this creates a communicator for each
+     * node and a shared memory window containing the locally owned values of
+     * each processor.
+     */
+    Scatter(
+      const std::vector<types::global_dof_index> &overlap_dofs,
+      const IndexSet                             &local,
+      const MPI_Comm                             &communicator,
+      const ScatterBackend backend = ScatterBackend::PointToPoint);
+
+    /**
+     * Destructor. Frees the persistent MPI requests and graph communicator.
      */
-    Scatter(const std::vector<types::global_dof_index> &overlap_dofs,
-            const IndexSet                             &local,
-            const MPI_Comm                             &communicator);
+    ~Scatter();
 
     /**
      * Scatter a sequential vector indexed by the specified overlap dofs into
@@ -95,6 +220,27 @@ namespace fdl
     global_to_overlap_finish(const LinearAlgebra::distributed::Vector<T> &input,
                              Vector<T> &output);
 
+    /**
+     * Same as the other global_to_overlap_start(), but scatter several
+     * vectors (which all use the same partitioning) at once. All values sent
+     * to a given processor are packed into a single message, so this is
+     * cheaper than several individual scatters when communication is
+     * dominated by latency (e.g., for small parts).
+     */
+    void
+    global_to_overlap_start(
+      const std::vector<const LinearAlgebra::distributed::Vector<T> *> &input,
+      const unsigned int                                                channel,
+      const std::vector<Vector<T> *>                                   &output);
+
+    /**
+     * Finish the global to overlap scatter of several vectors.
+     */
+    void
+    global_to_overlap_finish(
+      const std::vector<const LinearAlgebra::distributed::Vector<T> *> &input,
+      const std::vector<Vector<T> *>                                   &output);
+
     /**
      * Delegate responsibility for completing all outstanding MPI requests to
      * some other object (i.e., someone else will call MPI_Waitall() or an
@@ -108,7 +254,161 @@ namespace fdl
     std::vector<MPI_Request>
     delegate_outstanding_requests();
 
+    /**
+     * Return whether or not this object has the same communication pattern,
+     * on this processor, as one created by the constructor with the given
+     * arguments. If this is true on every processor then this object can be
+     * used instead of a new one, which avoids the (collective) setup of the
+     * underlying Partitioner.
+     */
+    bool
+    has_same_pattern(const std::vector<types::global_dof_index> &overlap_dofs,
+                     const IndexSet                             &local_dofs,
+                     const MPI_Comm                             &communicator,
+                     const ScatterBackend backend) const;
+
+    /**
+     * Set whether or not scatters of single vectors send their values as
+     * floats. Values are converted when they are packed into and unpacked
+     * from the communication buffers, so this halves the number of bytes
+     * sent by Scatter<double> at the cost of rounding every communicated
+     * value to single precision. Values which are not communicated (i.e.,
+     * locally owned values and, with ScatterBackend::SharedMemory, values
+     * read from shared memory) are not rounded. Scatters of several vectors
+     * always send values of type T. This has no effect on Scatter<float>.
+     *
+     * Since the rounding error is usually well below the discretization
+     * error of the interaction this is suitable for forces and velocities,
+     * but not for positions. Defaults to false. Must not be called while a
+     * scatter is in progress.
+     */
+    void
+    set_reduced_precision(const bool use_reduced_precision);
+
+    /**
+     * Return the communication done by this object since it was created or
+     * since the last call to reset_statistics().
+     */
+    const ScatterStatistics &
+    get_statistics() const;
+
+    /**
+     * Reset all counters returned by get_statistics() to zero.
+     */
+    void
+    reset_statistics();
+
+    /**
+     * Return an estimate of the memory used by this object, in bytes. Since
+     * the Partitioner may be shared with other objects it is not included.
+     */
+    std::size_t
+    memory_consumption() const;
+
   protected:
+    /**
+     * Add the messages sent and received by a scatter of @p n_vectors
+     * vectors in the given direction to the statistics.
+     */
+    void
+    record_scatter(const bool global_to_overlap, const unsigned int n_vectors);
+
+    /**
+     * Return the persistent requests for a scatter in the given direction and
+     * channel, setting them up first if necessary.
+     */
+    std::vector<MPI_Request> &
+    get_persistent_requests(const bool         global_to_overlap,
+                            const unsigned int channel);
+
+    /**
+     * Set up persistent requests for a scatter of @p n_vectors vectors in the
+     * given direction and channel. Only global to overlap scatters support
+     * more than one vector.
+     */
+    std::vector<MPI_Request>
+    create_persistent_requests(const bool         global_to_overlap,
+                               const unsigned int channel,
+                               const unsigned int n_vectors);
+
+    /**
+     * Buffers (and the corresponding communication data) for global to
+     * overlap scatters of several vectors. Values exchanged with each
+     * processor are stored contiguously: i.e., the segment of ghost_buffer or
+     * import_buffer corresponding to some processor is repeated once for each
+     * vector.
+     */
+    struct BatchData
+    {
+      AlignedVector<T> ghost_buffer;
+      AlignedVector<T> import_buffer;
+
+      /**
+       * Persistent requests, indexed by channel.
+       */
+      std::map<unsigned int, std::vector<MPI_Request>> requests;
+
+      /**
+       * Same as the corresponding Scatter members, multiplied by the number
+       * of vectors.
+       */
+      std::vector<int> neighbor_ghost_counts;
+      std::vector<int> neighbor_ghost_offsets;
+      std::vector<int> neighbor_import_counts;
+      std::vector<int> neighbor_import_offsets;
+    };
+
+    /**
+     * Return the batch data for scatters of @p n_vectors vectors, setting it
+     * up first if necessary.
+     */
+    BatchData &
+    get_batch_data(const unsigned int n_vectors);
+
+    /**
+     * Free all persistent requests.
+     */
+    void
+    free_persistent_requests();
+
+    /**
+     * Set up node_communicator, shared_window, and the list of ghost values
+     * which can be read directly from shared memory.
+     */
+    void
+    setup_shared_memory(const MPI_Comm &communicator);
+
+    /**
+     * Return whether or not processor @p rank (in the communicator given to
+     * the constructor) is on the same node as this processor. Always false
+     * unless the backend is ScatterBackend::SharedMemory.
+     */
+    bool
+    is_on_node(const unsigned int rank) const;
+
+    /**
+     * Copy locally owned values into shared_window and then read ghost values
+     * owned by processors on the same node from it.
+     */
+    void
+    exchange_shared_values(const LinearAlgebra::distributed::Vector<T> &input);
+
+    /**
+     * Convert the values received into wire_ghost_buffer (for a global to
+     * overlap scatter) or wire_import_buffer (for an overlap to global
+     * scatter) to T and store them in ghost_buffer or import_buffer.
+     */
+    void
+    unpack_wire_buffer(const bool global_to_overlap);
+
+    /**
+     * Start an MPI_Ineighbor_alltoallv() of @p n_vectors vectors on
+     * graph_communicator.
+     */
+    void
+    start_neighbor_exchange(const bool         global_to_overlap,
+                            const unsigned int n_vectors = 1);
+
     std::shared_ptr<Utilities::MPI::Partitioner> partitioner;
 
     /**
@@ -134,17 +434,132 @@ namespace fdl
      */
     std::vector<std::pair<unsigned int, unsigned int>> overlap_local_indices;
 
-    AlignedVector<T>         ghost_buffer;
-    AlignedVector<T>         import_buffer;
+    AlignedVector<T> ghost_buffer;
+    AlignedVector<T> import_buffer;
+
+    ScatterBackend backend;
+
+    /**
+     * Distributed graph communicator - only used with
+     * ScatterBackend::NeighborCollective. Processors which exchange data with
+     * no other processor are not part of the graph, so this is MPI_COMM_NULL
+     * on them.
+     */
+    MPI_Comm graph_communicator;
+
+    /**
+     * Number of ghost and import values (and their offsets into the
+     * corresponding buffers) for each neighbor of graph_communicator.
+     */
+    std::vector<int> neighbor_ghost_counts;
+    std::vector<int> neighbor_ghost_offsets;
+    std::vector<int> neighbor_import_counts;
+    std::vector<int> neighbor_import_offsets;
+
+    /**
+     * Communicator containing the processors on the same node as this one -
+     * only used with ScatterBackend::SharedMemory.
+     */
+    MPI_Comm node_communicator;
+
+    /**
+     * Sorted ranks (in the communicator given to the constructor) of the
+     * processors in node_communicator.
+     */
+    std::vector<unsigned int> node_ranks;
+
+    /**
+     * Shared memory window containing the locally owned values of each
+     * processor on the node, and the start of this processor's part of it.
+     */
+    MPI_Win shared_window;
+    T      *shared_values;
+
+    /**
+     * Ghost values owned by processors on the same node: each entry is the
+     * index of the value in ghost_buffer and its address in shared_window.
+     */
+    std::vector<std::pair<unsigned int, const T *>> shared_ghost_values;
+
+    /**
+     * Persistent requests for global to overlap scatters, indexed by
+     * channel. These send from import_buffer and receive into ghost_buffer.
+     */
+    std::map<unsigned int, std::vector<MPI_Request>> global_to_overlap_requests;
+
+    /**
+     * Persistent requests for overlap to global scatters, indexed by channel.
+     * These send from ghost_buffer and receive into import_buffer.
+     */
+    std::map<unsigned int, std::vector<MPI_Request>> overlap_to_global_requests;
+
+    /**
+     * Whether or not single vector scatters send floats - see
+     * set_reduced_precision().
+     */
+    bool reduced_precision;
+
+    /**
+     * Buffers of floats used instead of ghost_buffer and import_buffer for
+     * communication when reduced_precision is true.
+     */
+    AlignedVector<float> wire_ghost_buffer;
+    AlignedVector<float> wire_import_buffer;
+
+    /**
+     * Same as global_to_overlap_requests and overlap_to_global_requests, but
+     * for reduced precision scatters. Keeping both sets allows the same
+     * object to be used for both kinds of scatters without setting up new
+     * requests.
+     */
+    std::map<unsigned int, std::vector<MPI_Request>>
+      reduced_global_to_overlap_requests;
+    std::map<unsigned int, std::vector<MPI_Request>>
+      reduced_overlap_to_global_requests;
+
+    /**
+     * Data for scatters of several vectors, indexed by the number of vectors.
+     * Since this is a map the buffers never move once their requests are set
+     * up.
+     */
+    std::map<unsigned int, BatchData> batch_data;
+
+    /**
+     * Requests of the current scatter (i.e., copies of one set of persistent
+     * requests), or MPI_REQUEST_NULL after delegate_outstanding_requests().
+     */
     std::vector<MPI_Request> requests;
+
+    ScatterStatistics statistics;
   };
 
 
   // --------------------------- inline functions --------------------------- //
 
 
+  inline ScatterStatistics &
+  ScatterStatistics::operator+=(const ScatterStatistics &other)
+  {
+    n_scatters += other.n_scatters;
+    n_messages_sent += other.n_messages_sent;
+    n_messages_received += other.n_messages_received;
+    bytes_sent += other.bytes_sent;
+    bytes_received += other.bytes_received;
+    n_neighbors = std::max(n_neighbors, other.n_neighbors);
+    finish_time += other.finish_time;
+    return *this;
+  }
+
+
   template <typename T>
   inline Scatter<T>::Scatter(Scatter<T> &&t)
+    : n_overlap_dofs(0)
+    , backend(ScatterBackend::PointToPoint)
+    , graph_communicator(MPI_COMM_NULL)
+    , node_communicator(MPI_COMM_NULL)
+    , shared_window(MPI_WIN_NULL)
+    , shared_values(nullptr)
+    , reduced_precision(false)
   {
     partitioner.swap(t.partitioner);
     std::swap(n_overlap_dofs, t.n_overlap_dofs);
@@ -152,7 +567,29 @@ namespace fdl
     overlap_local_indices.swap(t.overlap_local_indices);
     ghost_buffer.swap(t.ghost_buffer);
     import_buffer.swap(t.import_buffer);
+    global_to_overlap_requests.swap(t.global_to_overlap_requests);
+    overlap_to_global_requests.swap(t.overlap_to_global_requests);
+    std::swap(reduced_precision, t.reduced_precision);
+    wire_ghost_buffer.swap(t.wire_ghost_buffer);
+    wire_import_buffer.swap(t.wire_import_buffer);
+    reduced_global_to_overlap_requests.swap(
+      t.reduced_global_to_overlap_requests);
+    reduced_overlap_to_global_requests.swap(
+      t.reduced_overlap_to_global_requests);
+    batch_data.swap(t.batch_data);
+    std::swap(backend, t.backend);
+    std::swap(graph_communicator, t.graph_communicator);
+    neighbor_ghost_counts.swap(t.neighbor_ghost_counts);
+    neighbor_ghost_offsets.swap(t.neighbor_ghost_offsets);
+    neighbor_import_counts.swap(t.neighbor_import_counts);
+    neighbor_import_offsets.swap(t.neighbor_import_offsets);
+    std::swap(node_communicator, t.node_communicator);
+    node_ranks.swap(t.node_ranks);
+    std::swap(shared_window, t.shared_window);
+    std::swap(shared_values, t.shared_values);
+    shared_ghost_values.swap(t.shared_ghost_values);
     requests.swap(t.requests);
+    std::swap(statistics, t.statistics);
   }
 
   template <typename T>
@@ -165,8 +602,44 @@ namespace fdl
     overlap_local_indices.swap(t.overlap_local_indices);
     ghost_buffer.swap(t.ghost_buffer);
     import_buffer.swap(t.import_buffer);
+    global_to_overlap_requests.swap(t.global_to_overlap_requests);
+    overlap_to_global_requests.swap(t.overlap_to_global_requests);
+    std::swap(reduced_precision, t.reduced_precision);
+    wire_ghost_buffer.swap(t.wire_ghost_buffer);
+    wire_import_buffer.swap(t.wire_import_buffer);
+    reduced_global_to_overlap_requests.swap(
+      t.reduced_global_to_overlap_requests);
+    reduced_overlap_to_global_requests.swap(
+      t.reduced_overlap_to_global_requests);
+    batch_data.swap(t.batch_data);
+    std::swap(backend, t.backend);
+    std::swap(graph_communicator, t.graph_communicator);
+    neighbor_ghost_counts.swap(t.neighbor_ghost_counts);
+    neighbor_ghost_offsets.swap(t.neighbor_ghost_offsets);
+    neighbor_import_counts.swap(t.neighbor_import_counts);
+    neighbor_import_offsets.swap(t.neighbor_import_offsets);
+    std::swap(node_communicator, t.node_communicator);
+    node_ranks.swap(t.node_ranks);
+    std::swap(shared_window, t.shared_window);
+    std::swap(shared_values, t.shared_values);
+    shared_ghost_values.swap(t.shared_ghost_values);
     requests.swap(t.requests);
+    std::swap(statistics, t.statistics);
     return *this;
   }
+
+  template <typename T>
+  inline const ScatterStatistics &
+  Scatter<T>::get_statistics() const
+  {
+    return statistics;
+  }
+
+  template <typename T>
+  inline void
+  Scatter<T>::reset_statistics()
+  {
+    statistics = ScatterStatistics();
+  }
 } // namespace fdl
 #endif
@@ -0,0 +1,54 @@
+#include <fiddle/base/autotuner.h>
+#include <fiddle/base/exceptions.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <algorithm>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  Autotuner::Autotuner(const std::vector<int> &candidates,
+                       const unsigned int      n_trials)
+    : candidates(candidates)
+    , n_trials(n_trials)
+    , n_times(0)
+    , times(candidates.size())
+    , value(0)
+    , tuned(false)
+  {
+    AssertThrow(candidates.size() > 0,
+                ExcMessage("There must be at least one candidate."));
+    AssertThrow(n_trials > 0,
+                ExcMessage("The number of trials must be positive."));
+    if (candidates.size() == 1)
+      set_value(candidates.front());
+  }
+
+  bool
+  Autotuner::add_time(const double time, const MPI_Comm comm)
+  {
+    if (tuned)
+      return false;
+
+    const unsigned int trial = n_times % n_trials;
+    if (trial > 0 || n_trials == 1)
+      times[n_times / n_trials] += time;
+    ++n_times;
+    if (n_times < candidates.size() * n_trials)
+      return false;
+
+    Utilities::MPI::max(times, comm, times);
+    const auto fastest = std::min_element(times.begin(), times.end());
+    set_value(candidates[fastest - times.begin()]);
+    return true;
+  }
+
+  void
+  Autotuner::set_value(const int new_value)
+  {
+    value = new_value;
+    tuned = true;
+  }
+} // namespace fdl
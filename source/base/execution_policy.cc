@@ -0,0 +1,74 @@
+#include <fiddle/base/execution_policy.h>
+
+FDL_DISABLE_EXTRA_DIAGNOSTICS
+#include <tbox/Database.h>
+#include <tbox/Pointer.h>
+FDL_ENABLE_EXTRA_DIAGNOSTICS
+
+#include <thread>
+
+namespace fdl
+{
+  namespace
+  {
+    // Namespace-scope statics are initialized when the library is loaded,
+    // i.e., on the main thread.
+    const std::thread::id main_thread_id = std::this_thread::get_id();
+  } // namespace
+
+  ExecutionPolicy::ExecutionPolicy(const unsigned int       n_threads,
+                                   const ThreadPartitioning partitioning)
+    : n_threads(n_threads)
+    , partitioning(partitioning)
+  {
+    AssertThrow(n_threads > 0,
+                ExcMessage("The number of threads should be positive"));
+  }
+
+  ExecutionPolicy::ExecutionPolicy(
+    const tbox::Pointer<tbox::Database> &input_db)
+  {
+    const int n = input_db->getIntegerWithDefault("n_threads", 1);
+    AssertThrow(n > 0,
+                ExcMessage("The number of threads should be positive"));
+    n_threads    = n;
+    partitioning = to_thread_partitioning(
+      input_db->getStringWithDefault("thread_partitioning", "DYNAMIC"));
+  }
+
+  void
+  ExecutionPolicy::put_to_database(
+    const tbox::Pointer<tbox::Database> &output_db) const
+  {
+    output_db->putInteger("n_threads", n_threads);
+    output_db->putString("thread_partitioning",
+                         partitioning == ThreadPartitioning::Static ?
+                           "STATIC" :
+                           "DYNAMIC");
+  }
+
+  std::size_t
+  ExecutionPolicy::get_grain_size(const std::size_t n_items,
+                                  const std::size_t min_grain_size) const
+  {
+    if (is_serial())
+      return std::max(n_items, min_grain_size);
+    switch (partitioning)
+      {
+        case ThreadPartitioning::Dynamic:
+          return std::max(min_grain_size, n_items / (4 * n_threads));
+        case ThreadPartitioning::Static:
+          return std::max(min_grain_size,
+                          (n_items + n_threads - 1) / n_threads);
+        default:
+          Assert(false, ExcFDLNotImplemented());
+      }
+    return n_items;
+  }
+
+  bool
+  is_main_thread()
+  {
+    return std::this_thread::get_id() == main_thread_id;
+  }
+} // namespace fdl
@@ -6,117 +6,134 @@
 
 #include <Eigen/Dense>
 
+#include <mpi.h>
+
+#include <numeric>
+
 namespace fdl
 {
   using namespace dealii;
 
+  namespace
+  {
+    // Compute the inner products of @p vector with the first @p n_others
+    // entries of @p others and then with itself: i.e., @p inner_products
+    // has length n_others + 1.
+    template <typename Number>
+    void
+    compute_inner_products(const Vector<Number>              &vector,
+                           const std::vector<Vector<Number>> &others,
+                           const unsigned int                 n_others,
+                           double                            *inner_products)
+    {
+      for (unsigned int i = 0; i < n_others; ++i)
+        inner_products[i] = others[i] * vector;
+      inner_products[n_others] = vector * vector;
+    }
+
+    // Same, but with a single global reduction.
+    template <typename Number>
+    void
+    compute_inner_products(
+      const LinearAlgebra::distributed::Vector<Number>              &vector,
+      const std::vector<LinearAlgebra::distributed::Vector<Number>> &others,
+      const unsigned int                                              n_others,
+      double *inner_products)
+    {
+      for (unsigned int i = 0; i < n_others; ++i)
+        inner_products[i] = std::inner_product(vector.begin(),
+                                               vector.end(),
+                                               others[i].begin(),
+                                               0.0);
+      inner_products[n_others] =
+        std::inner_product(vector.begin(), vector.end(), vector.begin(), 0.0);
+
+      const int ierr = MPI_Allreduce(MPI_IN_PLACE,
+                                     inner_products,
+                                     n_others + 1,
+                                     MPI_DOUBLE,
+                                     MPI_SUM,
+                                     vector.get_mpi_communicator());
+      AssertThrowMPI(ierr);
+    }
+  } // namespace
+
   template <typename VectorType>
-  InitialGuess<VectorType>::InitialGuess(const unsigned int n_vectors)
+  InitialGuess<VectorType>::InitialGuess(const unsigned int       n_vectors,
+                                         const InitialGuessMethod method)
     : n_max_vectors(n_vectors)
     , n_stored_vectors(0)
+    , first_index(0)
+    , method(method)
+    , last_method(method)
+    , n_guesses(0)
+    , correlation_matrix(n_vectors, n_vectors)
+    , projection_coefficients(n_vectors + 1)
     , last_rhs(nullptr)
-  {}
+    , solutions(n_vectors)
+    , right_hand_sides(n_vectors)
+  {
+    last_n_iterations.fill(std::numeric_limits<unsigned int>::max());
+  }
 
   template <typename VectorType>
   void
-  InitialGuess<VectorType>::submit(const VectorType &solution,
-                                   const VectorType &rhs)
+  InitialGuess<VectorType>::submit(const VectorType  &solution,
+                                   const VectorType  &rhs,
+                                   const unsigned int n_iterations)
   {
     if (n_max_vectors == 0)
       return;
-    // update our list of vectors:
+    if (n_iterations != std::numeric_limits<unsigned int>::max())
+      last_n_iterations[static_cast<unsigned int>(last_method)] = n_iterations;
+
+    // Either use the next unused slot or overwrite the oldest vector. Since
+    // all the vectors have the same parallel layout the copies do not
+    // allocate memory after the buffer has been filled once.
+    unsigned int slot = n_stored_vectors;
     if (n_stored_vectors == n_max_vectors)
       {
-        // oldest entry is first
-        solutions.erase(solutions.begin());
-        solutions.push_back(solution);
-        right_hand_sides.erase(right_hand_sides.begin());
-        right_hand_sides.push_back(rhs);
-
-        // shift the computed dot products up and to the left:
-        Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> mat_copy(
-          correlation_matrix);
-        for (unsigned int i = 1; i < n_max_vectors; ++i)
-          {
-            for (unsigned int j = 1; j < n_max_vectors; ++j)
-              {
-                correlation_matrix(i - 1, j - 1) = mat_copy(i, j);
-              }
-          }
+        slot        = first_index;
+        first_index = (first_index + 1) % n_max_vectors;
+      }
+    else
+      ++n_stored_vectors;
+    solutions[slot]        = solution;
+    right_hand_sides[slot] = rhs;
 
-        // Recycle dot products if we can. The indices are offset by one since
-        // we removed the oldest vector.
-        if (&rhs == last_rhs)
-          {
-            for (unsigned int i = 0; i < n_max_vectors - 1; ++i)
-              {
-                correlation_matrix(n_max_vectors - 1, i) =
-                  projection_coefficients[i + 1];
-                correlation_matrix(i, n_max_vectors - 1) =
-                  projection_coefficients[i + 1];
+    // Only the row and column of the new entry change. Recycle the inner
+    // products computed by guess() if we can.
+    if (&rhs == last_rhs)
+      {
+        for (unsigned int i = 0; i < n_stored_vectors; ++i)
+          if (i != slot)
+            {
 #ifdef DEBUG
-                const auto new_inner = right_hand_sides[i] * rhs;
-                Assert(std::abs(new_inner - projection_coefficients[i + 1]) <=
-                         1e-14 * std::abs(projection_coefficients[i + 1]),
-                       ExcMessage("This class assumes that the RHS vectors are "
-                                  "not modified between calls."));
+              const auto new_inner = right_hand_sides[i] * rhs;
+              Assert(std::abs(new_inner - projection_coefficients[i]) <=
+                       1e-14 * std::abs(projection_coefficients[i]),
+                     ExcMessage("This class assumes that the RHS vectors are "
+                                "not modified between calls."));
 #endif
-              }
-            correlation_matrix(n_max_vectors - 1, n_max_vectors - 1) =
-              rhs * rhs;
-            return;
-          }
+              correlation_matrix(slot, i) = projection_coefficients[i];
+              correlation_matrix(i, slot) = projection_coefficients[i];
+            }
+        correlation_matrix(slot, slot) =
+          projection_coefficients[n_max_vectors];
       }
     else
       {
-        ++n_stored_vectors;
-        solutions.push_back(solution);
-        right_hand_sides.push_back(rhs);
-
-        // Save the prior dot products in a different way:
-        Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> mat_copy;
-
-        mat_copy = correlation_matrix;
-        correlation_matrix.resize(n_stored_vectors, n_stored_vectors);
-        for (unsigned int i = 0; i < n_stored_vectors - 1; ++i)
-          {
-            for (unsigned int j = 0; j < n_stored_vectors - 1; ++j)
-              {
-                correlation_matrix(i, j) = mat_copy(i, j);
-              }
-          }
-
-        // We kept the oldest vector so there is no offset in the copy
-        if (&rhs == last_rhs)
+        compute_inner_products(right_hand_sides[slot],
+                               right_hand_sides,
+                               n_stored_vectors,
+                               projection_coefficients.data());
+        for (unsigned int i = 0; i < n_stored_vectors; ++i)
           {
-            for (unsigned int i = 0; i < n_stored_vectors - 1; ++i)
-              {
-                correlation_matrix(n_stored_vectors - 1, i) =
-                  projection_coefficients[i];
-                correlation_matrix(i, n_stored_vectors - 1) =
-                  projection_coefficients[i];
-#ifdef DEBUG
-                const auto new_inner = right_hand_sides[i] * rhs;
-                Assert(std::abs(new_inner - projection_coefficients[i]) <=
-                         1e-14 * std::abs(projection_coefficients[i]),
-                       ExcMessage("This class assumes that the RHS vectors are "
-                                  "not modified between calls."));
-#endif
-              }
-            correlation_matrix(n_stored_vectors - 1, n_stored_vectors - 1) =
-              rhs * rhs;
-            return;
+            correlation_matrix(slot, i) = projection_coefficients[i];
+            correlation_matrix(i, slot) = projection_coefficients[i];
           }
       }
-
-    Assert(last_rhs == nullptr, ExcFDLInternalError());
-    // Compute the last row and then copy it into the last column.
-    for (unsigned int j = 0; j < n_stored_vectors; ++j)
-      {
-        const double inner = right_hand_sides.back() * right_hand_sides[j];
-        correlation_matrix(n_stored_vectors - 1, j) = inner;
-        correlation_matrix(j, n_stored_vectors - 1) = inner;
-      }
+    last_rhs = nullptr;
   }
 
   template <typename VectorType>
@@ -128,35 +145,112 @@ namespace fdl
         return;
       }
 
-    projection_coefficients.resize(n_stored_vectors, 1);
-    for (unsigned int i = 0; i < n_stored_vectors; ++i)
+    last_method = InitialGuessMethod::Projection;
+    if (method == InitialGuessMethod::Extrapolation)
       {
-        projection_coefficients[i] = right_hand_sides[i] * rhs;
+        // Use whichever method required fewer iterations the last time it
+        // was used, but periodically try the other one. Prefer extrapolation
+        // until we know how well projection works.
+        const unsigned int projection_n_iterations    = last_n_iterations[0];
+        const unsigned int extrapolation_n_iterations = last_n_iterations[1];
+        const bool         retry = (++n_guesses % retry_interval) == 0;
+        const bool         projection_is_faster =
+          projection_n_iterations < extrapolation_n_iterations;
+        last_method = projection_is_faster != retry ?
+                        InitialGuessMethod::Projection :
+                        InitialGuessMethod::Extrapolation;
       }
-    last_rhs = &rhs;
 
-    Eigen::VectorXd coefs(n_stored_vectors);
+    if (last_method == InitialGuessMethod::Extrapolation)
+      extrapolate(solution);
+    else
+      project(solution, rhs);
+  }
+
+  template <typename VectorType>
+  double
+  InitialGuess<VectorType>::compute_rhs_change(const VectorType &rhs) const
+  {
+    if (n_stored_vectors == 0)
+      return -1.0;
+
+    // Like the stored vectors, this only allocates memory the first time
+    const unsigned int newest =
+      (first_index + n_stored_vectors - 1) % n_max_vectors;
+    rhs_difference = rhs;
+    rhs_difference.add(-1.0, right_hand_sides[newest]);
+    return rhs_difference.l2_norm();
+  }
+
+  template <typename VectorType>
+  void
+  InitialGuess<VectorType>::extrapolate(VectorType &solution)
+  {
+    // We didn't compute any inner products so submit() must compute them
+    // all
+    last_rhs = nullptr;
+
+    // Index, in the ring buffer, of the ith newest solution
+    auto newest = [&](const unsigned int i)
+    {
+      return (first_index + n_stored_vectors - 1 - i) % n_max_vectors;
+    };
+
+    const unsigned int n = n_stored_vectors;
+    solution             = solutions[newest(0)];
+    if (n >= 3)
+      {
+        // quadratic: 3 x_{n - 1} - 3 x_{n - 2} + x_{n - 3}
+        solution *= 3.0;
+        solution.add(-3.0, solutions[newest(1)], 1.0, solutions[newest(2)]);
+      }
+    else if (n == 2)
+      {
+        // linear: 2 x_{n - 1} - x_{n - 2}
+        solution *= 2.0;
+        solution.add(-1.0, solutions[newest(1)]);
+      }
+  }
+
+  template <typename VectorType>
+  void
+  InitialGuess<VectorType>::project(VectorType &solution, const VectorType &rhs)
+  {
+    const unsigned int n = n_stored_vectors;
+    // Also computes rhs * rhs, which submit() needs
+    compute_inner_products(rhs,
+                           right_hand_sides,
+                           n,
+                           projection_coefficients.data());
+    projection_coefficients[n_max_vectors] = projection_coefficients[n];
+    last_rhs                               = &rhs;
+
+    // Vectors are only in the first n slots of the ring buffer
+    const Eigen::MatrixXd gram_matrix = correlation_matrix.topLeftCorner(n, n);
+    const Eigen::VectorXd inner_products = projection_coefficients.head(n);
+    Eigen::VectorXd       coefs(n);
     // Should the SVD fail for any reason just use the last solution as a guess.
     try
       {
         // SVD doesn't make sense with invalid input - throw something and
         // immediately catch it
-        if (!correlation_matrix.allFinite())
+        if (!gram_matrix.allFinite())
           throw int();
-        if (!projection_coefficients.allFinite())
+        if (!inner_products.allFinite())
           throw int();
-        Eigen::JacobiSVD<decltype(correlation_matrix)> svd(
-          correlation_matrix, Eigen::ComputeThinU | Eigen::ComputeThinV);
-        coefs = svd.solve(projection_coefficients);
+        Eigen::JacobiSVD<Eigen::MatrixXd> svd(gram_matrix,
+                                              Eigen::ComputeThinU |
+                                                Eigen::ComputeThinV);
+        coefs = svd.solve(inner_products);
       }
     catch (...)
       {
         coefs.fill(0.0);
-        coefs(n_stored_vectors - 1) = 1.0;
+        coefs((first_index + n - 1) % n_max_vectors) = 1.0;
       }
 
     solution = 0.0;
-    for (unsigned int i = 0; i < n_stored_vectors; ++i)
+    for (unsigned int i = 0; i < n; ++i)
       {
         solution.add(coefs[i], solutions[i]);
       }
@@ -0,0 +1,69 @@
+#include <fiddle/base/execution_policy.h>
+#include <fiddle/base/markers.h>
+#include <fiddle/base/phase_timings.h>
+
+#include <mpi.h>
+
+#ifdef FDL_ENABLE_LIKWID
+#  include <likwid.h>
+#endif
+
+#include <string>
+
+namespace fdl
+{
+#ifdef FDL_ENABLE_LIKWID
+  namespace
+  {
+    // Initialize the marker API once per process and write the counters at
+    // exit.
+    struct MarkerSession
+    {
+      MarkerSession()
+      {
+        likwid_markerInit();
+      }
+
+      ~MarkerSession()
+      {
+        likwid_markerClose();
+      }
+    };
+
+    void
+    initialize_markers()
+    {
+      static MarkerSession session;
+      thread_local bool    thread_is_initialized = false;
+      if (!thread_is_initialized)
+        {
+          likwid_markerThreadInit();
+          thread_is_initialized = true;
+        }
+      (void)session;
+    }
+  } // namespace
+#endif
+
+  ScopedMarker::ScopedMarker(const char *name)
+    : name(name)
+    , start(-1.0)
+  {
+#ifdef FDL_ENABLE_LIKWID
+    initialize_markers();
+    if (is_main_thread())
+      start = MPI_Wtime();
+    likwid_markerStartRegion(name);
+#endif
+  }
+
+  ScopedMarker::~ScopedMarker()
+  {
+#ifdef FDL_ENABLE_LIKWID
+    likwid_markerStopRegion(name);
+    if (start >= 0.0)
+      PhaseTimings::get().add(std::string("marker::") + name,
+                              MPI_Wtime() - start);
+#endif
+  }
+} // namespace fdl
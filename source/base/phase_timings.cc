@@ -0,0 +1,167 @@
+#include <fiddle/base/exceptions.h>
+#include <fiddle/base/execution_policy.h>
+#include <fiddle/base/phase_timings.h>
+
+#include <deal.II/base/mpi.h>
+
+FDL_DISABLE_EXTRA_DIAGNOSTICS
+#include <tbox/Timer.h>
+FDL_ENABLE_EXTRA_DIAGNOSTICS
+
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <set>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  PhaseTimings &
+  PhaseTimings::get()
+  {
+    static PhaseTimings timings;
+    return timings;
+  }
+
+  void
+  PhaseTimings::set_enabled(const bool enable)
+  {
+    enabled = enable;
+  }
+
+  bool
+  PhaseTimings::is_enabled() const
+  {
+    return enabled;
+  }
+
+  void
+  PhaseTimings::add(const tbox::Timer *timer, const double elapsed)
+  {
+    if (!enabled || !is_main_thread())
+      return;
+    Assert(timer, ExcMessage("The timer should not be null."));
+    Entry &entry = timer_entries[timer];
+    // Only look up the name the first time we see a timer.
+    if (entry.n_calls == 0)
+      entry.name = timer->getName();
+    entry.time += elapsed;
+    ++entry.n_calls;
+  }
+
+  void
+  PhaseTimings::add(const std::string &name, const double elapsed)
+  {
+    if (!enabled || !is_main_thread())
+      return;
+    Entry &entry = named_entries[name];
+    entry.name   = name;
+    entry.time += elapsed;
+    ++entry.n_calls;
+  }
+
+  void
+  PhaseTimings::reset()
+  {
+    timer_entries.clear();
+    named_entries.clear();
+  }
+
+  std::vector<PhaseStatistics>
+  PhaseTimings::compute_statistics(const MPI_Comm comm) const
+  {
+    // Different timers may have the same name (e.g., SAMRAI creates a new
+    // object for each inactive timer) so combine entries by name first.
+    std::map<std::string, Entry> local_entries;
+    auto                         combine = [&](const auto &entries) {
+      for (const auto &pair : entries)
+        {
+          Entry &entry = local_entries[pair.second.name];
+          entry.time += pair.second.time;
+          entry.n_calls += pair.second.n_calls;
+        }
+    };
+    combine(timer_entries);
+    combine(named_entries);
+
+    // Not every processor necessarily runs every phase:
+    std::vector<std::string> local_names;
+    for (const auto &pair : local_entries)
+      local_names.push_back(pair.first);
+    std::set<std::string> names;
+    for (const auto &rank_names : Utilities::MPI::all_gather(comm, local_names))
+      names.insert(rank_names.begin(), rank_names.end());
+
+    std::vector<double> times;
+    std::vector<double> n_calls;
+    for (const std::string &name : names)
+      {
+        const auto it = local_entries.find(name);
+        times.push_back(it == local_entries.end() ? 0.0 : it->second.time);
+        n_calls.push_back(it == local_entries.end() ? 0.0 :
+                                                      it->second.n_calls);
+      }
+    const std::vector<Utilities::MPI::MinMaxAvg> time_stats =
+      Utilities::MPI::min_max_avg(times, comm);
+    const std::vector<double> max_n_calls = Utilities::MPI::max(n_calls, comm);
+
+    std::vector<PhaseStatistics> result;
+    unsigned int                 i = 0;
+    for (const std::string &name : names)
+      {
+        PhaseStatistics stats;
+        stats.name      = name;
+        stats.n_calls   = static_cast<unsigned long>(max_n_calls[i]);
+        stats.min       = time_stats[i].min;
+        stats.mean      = time_stats[i].avg;
+        stats.max       = time_stats[i].max;
+        stats.imbalance = stats.mean > 0.0 ? stats.max / stats.mean : 1.0;
+        result.push_back(stats);
+        ++i;
+      }
+
+    return result;
+  }
+
+  void
+  PhaseTimings::write(std::ostream &out,
+                      const MPI_Comm comm,
+                      const Format   format) const
+  {
+    const std::vector<PhaseStatistics> statistics = compute_statistics(comm);
+    if (Utilities::MPI::this_mpi_process(comm) != 0)
+      return;
+
+    const auto precision = out.precision(8);
+    switch (format)
+      {
+        case Format::CSV:
+          out << "name,n_calls,min,mean,max,imbalance\n";
+          for (const PhaseStatistics &stats : statistics)
+            out << std::quoted(stats.name) << ',' << stats.n_calls << ','
+                << stats.min << ',' << stats.mean << ',' << stats.max << ','
+                << stats.imbalance << '\n';
+          break;
+        case Format::JSON:
+          out << "{\"n_processes\": " << Utilities::MPI::n_mpi_processes(comm)
+              << ", \"phases\": [";
+          for (unsigned int i = 0; i < statistics.size(); ++i)
+            {
+              const PhaseStatistics &stats = statistics[i];
+              out << (i == 0 ? "" : ", ") << "{\"name\": "
+                  << std::quoted(stats.name)
+                  << ", \"n_calls\": " << stats.n_calls
+                  << ", \"min\": " << stats.min
+                  << ", \"mean\": " << stats.mean
+                  << ", \"max\": " << stats.max
+                  << ", \"imbalance\": " << stats.imbalance << "}";
+            }
+          out << "]}\n";
+          break;
+        default:
+          Assert(false, ExcNotImplemented());
+      }
+    out.precision(precision);
+  }
+} // namespace fdl
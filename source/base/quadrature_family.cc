@@ -3,6 +3,8 @@
 
 #include <deal.II/base/quadrature_lib.h>
 
+#include <algorithm>
+#include <limits>
 #include <utility>
 
 namespace fdl
@@ -459,6 +461,120 @@ namespace fdl
       }
   }
 
+  template <int dim>
+  QEquispacedFamily<dim>::QEquispacedFamily(const unsigned int min_points_1D,
+                                            const double       point_density,
+                                            const DensityKind  density_kind)
+    : min_points_1D(std::max(1u, min_points_1D))
+    , point_density(point_density)
+    , density_factor(density_kind == DensityKind::Minimum ? 1.0 : 1.5)
+  {}
+
+  template <int dim>
+  unsigned char
+  QEquispacedFamily<dim>::get_index(const double eulerian_length,
+                                    const double lagrangian_length) const
+  {
+    const double n_evenly_spaced_points =
+      point_density * lagrangian_length / eulerian_length;
+    const double min_point_distance = 1.0 / n_evenly_spaced_points;
+
+    unsigned char i = 0;
+    while (true)
+      {
+        this->operator[](i);
+        Assert(i < max_point_distances.size(), ExcFDLInternalError());
+        if (max_point_distances[i] / density_factor <= min_point_distance)
+          return i;
+
+        if (i == std::numeric_limits<unsigned char>::max())
+          break;
+        else
+          ++i;
+      }
+
+    Assert(false, ExcFDLInternalError());
+
+    return std::numeric_limits<unsigned char>::max();
+  }
+
+  template <int dim>
+  const Quadrature<dim> &
+  QEquispacedFamily<dim>::operator[](const unsigned char n_points_1D) const
+  {
+    for (unsigned int index = quadratures.size(); index <= n_points_1D;
+         ++index)
+      {
+        const unsigned int n = std::max(min_points_1D, index);
+        quadratures.emplace_back(QIterated<dim>(QMidpoint<1>(), n));
+        max_point_distances.emplace_back(1.0 / n);
+      }
+
+    return quadratures[n_points_1D];
+  }
+
+  template <int dim>
+  QEquispacedSimplexFamily<dim>::QEquispacedSimplexFamily(
+    const unsigned int min_points_1D,
+    const double       point_density,
+    const DensityKind  density_kind)
+    : min_points_1D(std::max(1u, min_points_1D))
+    , point_density(point_density)
+    , density_factor(density_kind == DensityKind::Minimum ? 1.0 : 1.5)
+  {}
+
+  template <int dim>
+  unsigned char
+  QEquispacedSimplexFamily<dim>::get_index(
+    const double eulerian_length,
+    const double lagrangian_length) const
+  {
+    const double n_evenly_spaced_points =
+      point_density * lagrangian_length / eulerian_length;
+    const double min_point_distance = 1.0 / n_evenly_spaced_points;
+
+    unsigned char i = 0;
+    while (true)
+      {
+        this->operator[](i);
+        Assert(i < max_point_distances.size(), ExcFDLInternalError());
+        if (max_point_distances[i] / density_factor <= min_point_distance)
+          return i;
+
+        if (i == std::numeric_limits<unsigned char>::max())
+          break;
+        else
+          ++i;
+      }
+
+    Assert(false, ExcFDLInternalError());
+
+    return std::numeric_limits<unsigned char>::max();
+  }
+
+  template <int dim>
+  const Quadrature<dim> &
+  QEquispacedSimplexFamily<dim>::operator[](
+    const unsigned char n_points_1D) const
+  {
+    for (unsigned int index = quadratures.size(); index <= n_points_1D;
+         ++index)
+      {
+        // QIteratedSimplex only supports powers of two
+        unsigned int n = 1;
+        while (n < std::max(min_points_1D, index))
+          n *= 2;
+        if (n == 1)
+          quadratures.emplace_back(QGaussSimplex<dim>(1));
+        else
+          quadratures.emplace_back(
+            QIteratedSimplex<dim>(QGaussSimplex<dim>(1), n));
+        max_point_distances.emplace_back(1.0 / n);
+      }
+
+    return quadratures[n_points_1D];
+  }
+
   template class SingleQuadrature<NDIM - 1>;
   template class SingleQuadrature<NDIM>;
 
@@ -467,4 +583,10 @@ namespace fdl
 
   template class QWitherdenVincentSimplexFamily<NDIM - 1>;
   template class QWitherdenVincentSimplexFamily<NDIM>;
+
+  template class QEquispacedFamily<NDIM - 1>;
+  template class QEquispacedFamily<NDIM>;
+
+  template class QEquispacedSimplexFamily<NDIM - 1>;
+  template class QEquispacedSimplexFamily<NDIM>;
 } // namespace fdl
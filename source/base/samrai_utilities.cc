@@ -1,4 +1,6 @@
 #include <fiddle/base/exceptions.h>
+#include <fiddle/base/execution_policy.h>
+#include <fiddle/base/phase_timings.h>
 #include <fiddle/base/samrai_utilities.h>
 #include <fiddle/base/utilities.h>
 
@@ -27,7 +29,12 @@ FDL_DISABLE_EXTRA_DIAGNOSTICS
 FDL_ENABLE_EXTRA_DIAGNOSTICS
 
 #include <cmath>
+#include <istream>
+#include <iterator>
 #include <limits>
+#include <ostream>
+#include <sstream>
+#include <streambuf>
 
 namespace fdl
 {
@@ -378,21 +385,163 @@ namespace fdl
     return output;
   }
 
+  namespace
+  {
+    /**
+     * Stream buffer which writes into an integer array. The first entry of
+     * the array is reserved for the number of bytes.
+     */
+    class IntegerArrayOutputBuffer : public std::streambuf
+    {
+    public:
+      IntegerArrayOutputBuffer()
+        : data(1024)
+      {
+        set_put_area(sizeof(int));
+      }
+
+      /**
+       * Shrink the array to the written bytes, set the first entry, and
+       * return the array.
+       */
+      std::vector<int> &
+      finish()
+      {
+        const std::size_t n_bytes = pptr() - bytes() - sizeof(int);
+        AssertThrow(n_bytes <= std::size_t(std::numeric_limits<int>::max()),
+                    ExcMessage("SAMRAI databases cannot store more than "
+                               "2^31 - 1 bytes under a single key."));
+        data.resize(1 + (n_bytes + sizeof(int) - 1) / sizeof(int));
+        data[0] = int(n_bytes);
+        return data;
+      }
+
+    protected:
+      virtual int_type
+      overflow(int_type c) override
+      {
+        if (traits_type::eq_int_type(c, traits_type::eof()))
+          return traits_type::not_eof(c);
+        const std::size_t offset = pptr() - bytes();
+        data.resize(2 * data.size());
+        set_put_area(offset);
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+        return c;
+      }
+
+      char *
+      bytes()
+      {
+        return reinterpret_cast<char *>(data.data());
+      }
+
+      void
+      set_put_area(const std::size_t offset)
+      {
+        setp(bytes() + offset, bytes() + data.size() * sizeof(int));
+      }
+
+      std::vector<int> data;
+    };
+
+    /**
+     * Stream buffer which reads from an existing array of bytes.
+     */
+    class ByteInputBuffer : public std::streambuf
+    {
+    public:
+      ByteInputBuffer(char *begin, char *end)
+      {
+        setg(begin, begin, end);
+      }
+    };
+
+    /**
+     * Read an array written by save_binary(). The first entry is the number
+     * of bytes.
+     */
+    std::vector<int>
+    get_binary_array(const std::string                   &key,
+                     const tbox::Pointer<tbox::Database> &database)
+    {
+      AssertThrow(database->isInteger(key),
+                  ExcMessage("The key " + key +
+                             " does not contain binary data."));
+      std::vector<int> data(database->getArraySize(key));
+      AssertThrow(data.size() > 0, ExcFDLInternalError());
+      database->getIntegerArray(key, data.data(), data.size());
+      AssertThrow(data[0] >= 0 &&
+                    std::size_t(data[0]) <= (data.size() - 1) * sizeof(int),
+                  ExcMessage("The binary data stored in " + key +
+                             " is corrupt."));
+      return data;
+    }
+  } // namespace
+
   void
   save_binary(const std::string             &key,
               const char                    *begin,
               const char                    *end,
               tbox::Pointer<tbox::Database> &database)
   {
-    database->putString(key, encode_base64(begin, end));
+    save_binary(
+      key,
+      [&](std::ostream &out) { out.write(begin, end - begin); },
+      database);
+  }
+
+  void
+  save_binary(const std::string                         &key,
+              const std::function<void(std::ostream &)> &write,
+              tbox::Pointer<tbox::Database>             &database)
+  {
+    IntegerArrayOutputBuffer buffer;
+    {
+      std::ostream out(&buffer);
+      write(out);
+      out.flush();
+      AssertThrow(out, ExcMessage("Unable to write binary data."));
+    }
+    const std::vector<int> &data = buffer.finish();
+    database->putIntegerArray(key, data.data(), data.size());
   }
 
   std::string
   load_binary(const std::string                   &key,
               const tbox::Pointer<tbox::Database> &database)
   {
-    const std::string base64 = database->getString(key);
-    return decode_base64(base64.c_str(), base64.c_str() + base64.size());
+    std::string result;
+    load_binary(key,
+                database,
+                [&](std::istream &in)
+                {
+                  result.assign(std::istreambuf_iterator<char>(in),
+                                std::istreambuf_iterator<char>());
+                });
+    return result;
+  }
+
+  void
+  load_binary(const std::string                         &key,
+              const tbox::Pointer<tbox::Database>       &database,
+              const std::function<void(std::istream &)> &read)
+  {
+    // Older restart files store base64-encoded strings
+    if (database->isString(key))
+      {
+        const std::string base64 = database->getString(key);
+        std::istringstream in(
+          decode_base64(base64.c_str(), base64.c_str() + base64.size()));
+        read(in);
+        return;
+      }
+
+    std::vector<int> data  = get_binary_array(key, database);
+    char            *begin = reinterpret_cast<char *>(data.data() + 1);
+    ByteInputBuffer  buffer(begin, begin + data[0]);
+    std::istream     in(&buffer);
+    read(in);
   }
 
   bool
@@ -412,19 +561,24 @@ namespace fdl
   }
 
   ScopedTimer::ScopedTimer(tbox::Timer *timer)
-    : timer(timer)
+    : timer(is_main_thread() ? timer : nullptr)
+    , start_time(0.0)
   {
-    if (samrai_is_initialized())
+    if (samrai_is_initialized() && is_main_thread())
       {
         AssertThrow(timer, ExcMessage("timer should not be null here"));
         timer->start();
+        start_time = MPI_Wtime();
       }
   }
 
   ScopedTimer::~ScopedTimer()
   {
     if (samrai_is_initialized() && timer)
-      timer->stop();
+      {
+        PhaseTimings::get().add(timer, MPI_Wtime() - start_time);
+        timer->stop();
+      }
   }
 
 
@@ -0,0 +1,90 @@
+#include <fiddle/base/exceptions.h>
+#include <fiddle/base/execution_policy.h>
+#include <fiddle/base/trace.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi.h>
+
+#include <fstream>
+#include <iomanip>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  Tracer &
+  Tracer::get()
+  {
+    static Tracer tracer;
+    return tracer;
+  }
+
+  void
+  Tracer::enable(const MPI_Comm comm)
+  {
+    rank           = Utilities::MPI::this_mpi_process(comm);
+    const int ierr = MPI_Barrier(comm);
+    AssertThrowMPI(ierr);
+    origin  = MPI_Wtime();
+    enabled = true;
+  }
+
+  void
+  Tracer::disable()
+  {
+    enabled = false;
+  }
+
+  void
+  Tracer::add_event(const char  *name,
+                    const char  *category,
+                    const double start,
+                    const double end,
+                    const int    id)
+  {
+    if (enabled && is_main_thread())
+      events.push_back({name, category, start, end, id});
+  }
+
+  void
+  Tracer::clear()
+  {
+    events.clear();
+  }
+
+  void
+  Tracer::write(const std::string &file_name) const
+  {
+    std::ofstream out(file_name + "." + std::to_string(rank) + ".json");
+    AssertThrow(out, ExcMessage("Unable to open the trace file."));
+    // Chrome uses microseconds:
+    out << std::fixed << std::setprecision(3) << "{\"traceEvents\": [\n";
+    for (std::size_t i = 0; i < events.size(); ++i)
+      {
+        const Event &event = events[i];
+        out << (i == 0 ? "" : ",\n") << "{\"name\": \"" << event.name
+            << "\", \"cat\": \"" << event.category
+            << "\", \"ph\": \"X\", \"pid\": " << rank
+            << ", \"tid\": 0, \"ts\": " << (event.start - origin) * 1e6
+            << ", \"dur\": " << (event.end - event.start) * 1e6;
+        if (event.id >= 0)
+          out << ", \"args\": {\"id\": " << event.id << "}";
+        out << "}";
+      }
+    out << "\n],\n\"displayTimeUnit\": \"ms\"}\n";
+  }
+
+  TraceScope::TraceScope(const char *name, const char *category, const int id)
+    : name(name)
+    , category(category)
+    , id(id)
+    , start(Tracer::get().is_enabled() && is_main_thread() ? MPI_Wtime() :
+                                                             -1.0)
+  {}
+
+  TraceScope::~TraceScope()
+  {
+    if (start >= 0.0)
+      Tracer::get().add_event(name, category, start, MPI_Wtime(), id);
+  }
+} // namespace fdl
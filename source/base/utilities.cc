@@ -1,6 +1,8 @@
 #include <fiddle/base/exceptions.h>
 #include <fiddle/base/utilities.h>
 
+#include <deal.II/numerics/rtree.h>
+
 #include <boost/archive/iterators/base64_from_binary.hpp>
 #include <boost/archive/iterators/binary_from_base64.hpp>
 #include <boost/archive/iterators/transform_width.hpp>
@@ -19,43 +21,21 @@ namespace fdl
     Point<spacedim> best_center;
     double          best_diameter = 0.0;
 
-    // Speed up the bounding check by only examining points whose x coordinate
-    // is near that of the sphere
-    auto x_less = [](const Point<spacedim> &a, const Point<spacedim> &b)
-    { return a[0] < b[0]; };
-
-    std::vector<Point<spacedim>> points_copy(points);
-    std::sort(points_copy.begin(), points_copy.end(), x_less);
-
-    // This is the brute-force version. We don't normally have more than a
-    // hundred quadrature points per cell, so N^2 algorithms aren't
-    // completely deadly yet.
-    auto sphere_contains_nontangent_point =
+    // A sphere contains a point if and only if it contains the point nearest
+    // to its center, so each check is a single O(log N) query. We still
+    // check O(N^2) candidate spheres but most are skipped since they are
+    // smaller than the best one found so far.
+    const auto rtree = pack_rtree(points);
+    auto       sphere_contains_nontangent_point =
       [&](const Point<spacedim> &center,
           const unsigned int    &tangent_point_n,
           const double           diameter) -> bool
     {
       const double magnitude =
         std::max(center.norm(), points[tangent_point_n].norm());
-
-      Point<spacedim> left  = center;
-      Point<spacedim> right = center;
-      left[0] -= diameter / 2.0;
-      right[0] += diameter / 2.0;
-
-      // Only check points that are in the correct x pencil.
-      auto upper_bound =
-        std::lower_bound(points_copy.begin(), points_copy.end(), right, x_less);
-      auto lower_bound =
-        std::lower_bound(points_copy.begin(), points_copy.end(), left, x_less);
-      if (lower_bound != points_copy.begin())
-        --lower_bound;
-
-      for (auto it = lower_bound; it < upper_bound; ++it)
-        if ((it->distance(center) - diameter / 2.0) < -magnitude * 1e-14)
-          return true;
-
-      return false;
+      const auto it = rtree.qbegin(bgi::nearest(center, 1));
+      Assert(it != rtree.qend(), ExcFDLInternalError());
+      return (it->distance(center) - diameter / 2.0) < -magnitude * 1e-14;
     };
 
     // points tend to be clustered at endpoints. Try to find one in the middle
@@ -0,0 +1,182 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/grid/boundary_centroid.h>
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/qprojector.h>
+
+#include <deal.II/fe/fe.h>
+
+#include <deal.II/grid/reference_cell.h>
+#include <deal.II/grid/tria.h>
+
+#include <algorithm>
+
+namespace fdl
+{
+  template <int dim>
+  BoundaryCentroid<dim>::BoundaryCentroid(
+    const DoFHandler<dim>                 &dof_handler,
+    const std::vector<types::boundary_id> &boundary_ids,
+    const Quadrature<dim - 1>             &face_quadrature)
+    : communicator(dof_handler.get_triangulation().get_communicator())
+    , weights(face_quadrature.get_weights())
+  {
+    const FiniteElement<dim> &fe = dof_handler.get_fe();
+    AssertThrow(fe.n_components() == dim && fe.is_primitive(),
+                ExcMessage("The finite element should be primitive and have "
+                           "dim components."));
+    AssertThrow(dof_handler.get_triangulation().get_reference_cells().size() ==
+                  1,
+                ExcFDLNotImplemented());
+    AssertThrow(boundary_ids.size() > 0,
+                ExcMessage("There should be at least one boundary id."));
+    const ReferenceCell reference_cell =
+      dof_handler.get_triangulation().get_reference_cells()[0];
+
+    // Corners of the reference face, used to compute its tangents
+    std::vector<Point<dim - 1>> corners(dim);
+    for (unsigned int d = 0; d < dim - 1; ++d)
+      corners[d + 1][d] = 1.0;
+    const Quadrature<dim - 1> corner_quadrature(corners);
+
+    face_data.resize(reference_cell.n_faces());
+    for (unsigned int face_no = 0; face_no < reference_cell.n_faces();
+         ++face_no)
+      {
+        FaceData &data = face_data[face_no];
+        for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
+          if (fe.has_support_on_face(i, face_no))
+            {
+              data.dofs.push_back(i);
+              data.components.push_back(fe.system_to_component_index(i).first);
+            }
+
+        // Shape functions without support on the face vanish on it, so their
+        // tangential derivatives vanish too and they can be skipped
+        const Quadrature<dim> cell_quadrature =
+          QProjector<dim>::project_to_face(reference_cell,
+                                           face_quadrature,
+                                           face_no);
+        for (const Point<dim> &point : cell_quadrature.get_points())
+          for (const unsigned int i : data.dofs)
+            {
+              data.values.push_back(fe.shape_value(i, point));
+              data.gradients.push_back(fe.shape_grad(i, point));
+            }
+
+        // The map from the reference face to the reference cell is affine
+        const Quadrature<dim> cell_corners =
+          QProjector<dim>::project_to_face(reference_cell,
+                                           corner_quadrature,
+                                           face_no);
+        for (unsigned int d = 0; d < dim - 1; ++d)
+          data.tangents.push_back(cell_corners.point(d + 1) -
+                                  cell_corners.point(0));
+      }
+
+    std::vector<types::boundary_id> sorted_boundary_ids = boundary_ids;
+    std::sort(sorted_boundary_ids.begin(), sorted_boundary_ids.end());
+    std::vector<types::global_dof_index> cell_dofs(fe.n_dofs_per_cell());
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      if (cell->is_locally_owned() && cell->at_boundary())
+        for (const unsigned int face_no : cell->face_indices())
+          if (cell->face(face_no)->at_boundary() &&
+              std::binary_search(sorted_boundary_ids.begin(),
+                                 sorted_boundary_ids.end(),
+                                 cell->face(face_no)->boundary_id()))
+            {
+              cell->get_dof_indices(cell_dofs);
+              face_numbers.push_back(face_no);
+              for (const unsigned int i : face_data[face_no].dofs)
+                face_dofs.push_back(cell_dofs[i]);
+            }
+  }
+
+
+
+  template <int dim>
+  Point<dim>
+  BoundaryCentroid<dim>::compute(
+    const LinearAlgebra::distributed::Vector<double> &position) const
+  {
+    Assert(position.has_ghost_elements(),
+           ExcMessage("The position should have up-to-date ghost values."));
+    // Reduce the number of faces, the area, and the weighted sum of points at
+    // once
+    std::vector<double> local_values(dim + 2);
+    std::vector<double> dof_values;
+    std::size_t         offset = 0;
+    for (const unsigned char face_no : face_numbers)
+      {
+        const FaceData    &data   = face_data[face_no];
+        const unsigned int n_dofs = data.dofs.size();
+        dof_values.resize(n_dofs);
+        for (unsigned int k = 0; k < n_dofs; ++k)
+          dof_values[k] = position(face_dofs[offset + k]);
+        offset += n_dofs;
+
+        for (unsigned int q = 0; q < weights.size(); ++q)
+          {
+            Point<dim>     point;
+            Tensor<2, dim> jacobian;
+            for (unsigned int k = 0; k < n_dofs; ++k)
+              {
+                const unsigned int c = data.components[k];
+                point[c] += data.values[q * n_dofs + k] * dof_values[k];
+                jacobian[c] += data.gradients[q * n_dofs + k] * dof_values[k];
+              }
+
+            const Tensor<1, dim> tangent_0 = jacobian * data.tangents[0];
+            double               measure   = 0.0;
+            if constexpr (dim == 2)
+              measure = tangent_0.norm();
+            else
+              measure =
+                cross_product_3d(tangent_0, jacobian * data.tangents[1])
+                  .norm();
+
+            const double JxW = weights[q] * measure;
+            for (unsigned int d = 0; d < dim; ++d)
+              local_values[d] += point[d] * JxW;
+            local_values[dim] += JxW;
+          }
+        local_values[dim + 1] += 1.0;
+      }
+    Assert(offset == face_dofs.size(), ExcFDLInternalError());
+
+    const std::vector<double> values =
+      Utilities::MPI::sum(local_values, communicator);
+    Assert(values[dim + 1] > 0.0,
+           ExcMessage("There should be at least one face with one of the "
+                      "boundary ids."));
+    Assert(values[dim] > 0, ExcFDLInternalError());
+    Point<dim> centroid;
+    for (unsigned int d = 0; d < dim; ++d)
+      centroid[d] = values[d] / values[dim];
+    return centroid;
+  }
+
+
+
+  template <int dim>
+  std::size_t
+  BoundaryCentroid<dim>::memory_consumption() const
+  {
+    std::size_t result = MemoryConsumption::memory_consumption(weights) +
+                         MemoryConsumption::memory_consumption(face_numbers) +
+                         MemoryConsumption::memory_consumption(face_dofs);
+    for (const FaceData &data : face_data)
+      result += MemoryConsumption::memory_consumption(data.dofs) +
+                MemoryConsumption::memory_consumption(data.components) +
+                MemoryConsumption::memory_consumption(data.values) +
+                MemoryConsumption::memory_consumption(data.gradients) +
+                MemoryConsumption::memory_consumption(data.tangents);
+    return result;
+  }
+
+
+
+  template class BoundaryCentroid<NDIM>;
+} // namespace fdl
@@ -0,0 +1,92 @@
+#include <fiddle/grid/boundary_faces.h>
+
+#include <deal.II/grid/tria.h>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  template <int dim, int spacedim>
+  BoundaryFaces<dim, spacedim>::BoundaryFaces(
+    const DoFHandler<dim, spacedim> &dof_handler)
+    : dof_handler(&dof_handler)
+    , needs_update(true)
+  {
+    tria_listener = dof_handler.get_triangulation().signals.any_change.connect(
+      [this]()
+      { needs_update = true; });
+  }
+
+  template <int dim, int spacedim>
+  BoundaryFaces<dim, spacedim>::~BoundaryFaces()
+  {
+    tria_listener.disconnect();
+  }
+
+  template <int dim, int spacedim>
+  const std::vector<
+    typename BoundaryFaces<dim, spacedim>::active_cell_iterator> &
+  BoundaryFaces<dim, spacedim>::get_cells() const
+  {
+    update();
+    return cells;
+  }
+
+  template <int dim, int spacedim>
+  std::vector<types::boundary_id>
+  BoundaryFaces<dim, spacedim>::get_boundary_ids() const
+  {
+    update();
+    std::vector<types::boundary_id> boundary_ids;
+    for (const auto &pair : faces)
+      boundary_ids.push_back(pair.first);
+
+    return boundary_ids;
+  }
+
+  template <int dim, int spacedim>
+  const std::vector<
+    std::pair<typename BoundaryFaces<dim, spacedim>::active_cell_iterator,
+              unsigned int>> &
+  BoundaryFaces<dim, spacedim>::get_faces(
+    const types::boundary_id boundary_id) const
+  {
+    update();
+    const auto it = faces.find(boundary_id);
+    if (it == faces.end())
+      return no_faces;
+    return it->second;
+  }
+
+  template <int dim, int spacedim>
+  void
+  BoundaryFaces<dim, spacedim>::update() const
+  {
+    if (!needs_update)
+      return;
+
+    cells.clear();
+    faces.clear();
+    for (const auto &cell : dof_handler->active_cell_iterators())
+      if (cell->is_locally_owned() && cell->at_boundary())
+        {
+          bool found_face = false;
+          for (const auto &face_n : cell->face_indices())
+            // only use physical boundaries
+            if (!cell->has_periodic_neighbor(face_n) &&
+                cell->face(face_n)->at_boundary())
+              {
+                found_face = true;
+                faces[cell->face(face_n)->boundary_id()].emplace_back(cell,
+                                                                      face_n);
+              }
+          if (found_face)
+            cells.push_back(cell);
+        }
+
+    needs_update = false;
+  }
+
+  template class BoundaryFaces<NDIM - 1, NDIM>;
+  template class BoundaryFaces<NDIM, NDIM>;
+} // namespace fdl
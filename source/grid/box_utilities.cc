@@ -3,19 +3,29 @@
 #include <fiddle/grid/box_utilities.h>
 
 #include <deal.II/base/bounding_box.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/quadrature.h>
 
 #include <deal.II/distributed/shared_tria.h>
 
 #include <deal.II/fe/fe_values.h>
 
+#include <deal.II/numerics/rtree.h>
+
 #include <CartesianGridGeometry.h>
 #include <CartesianPatchGeometry.h>
 #include <MultiblockPatchLevel.h>
 #include <Patch.h>
+#include <PatchHierarchy.h>
 #include <PatchLevel.h>
 #include <tbox/SAMRAI_MPI.h>
 
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <numeric>
 #include <vector>
 
 namespace fdl
@@ -75,6 +85,24 @@ namespace fdl
     return patch_bboxes;
   }
 
+  namespace
+  {
+    /**
+     * Everything that determines the output of
+     * compute_nonoverlapping_patch_boxes(), along with that output.
+     */
+    template <int spacedim>
+    struct NonoverlappingBoxesCache
+    {
+      std::vector<hier::Box<spacedim>> coarse_boxes;
+      std::vector<int>                 coarse_ranks;
+      std::vector<hier::Box<spacedim>> fine_boxes;
+      hier::IntVector<spacedim>        ratio;
+
+      std::vector<std::vector<hier::Box<spacedim>>> result;
+    };
+  } // namespace
+
   template <int spacedim>
   std::vector<std::vector<hier::Box<spacedim>>>
   compute_nonoverlapping_patch_boxes(
@@ -91,75 +119,267 @@ namespace fdl
     const hier::IntVector<spacedim> ratio =
       fine_level->getRatioToCoarserLevel();
 
+    // This is called at every regrid for every pair of levels (and by every
+    // part), so save the result for each pair of levels and reuse it if the
+    // boxes have not changed.
+    NonoverlappingBoxesCache<spacedim> key;
+    for (int i = 0; i < coarse_level->getNumberOfPatches(); ++i)
+      {
+        key.coarse_boxes.push_back(coarse_level->getBoxForPatch(i));
+        key.coarse_ranks.push_back(coarse_level->getMappingForPatch(i));
+      }
+    for (int i = 0; i < fine_level->getNumberOfPatches(); ++i)
+      key.fine_boxes.push_back(fine_level->getBoxForPatch(i));
+    key.ratio = ratio;
+
+    // Different threads may set up different parts concurrently, so guard
+    // the cache with a mutex (but compute new results without holding it).
+    static std::map<int, NonoverlappingBoxesCache<spacedim>> caches;
+    static std::mutex                                        caches_mutex;
+    {
+      std::lock_guard<std::mutex> lock(caches_mutex);
+      const auto &cache = caches[coarse_level->getLevelNumber()];
+      if (cache.coarse_boxes == key.coarse_boxes &&
+          cache.coarse_ranks == key.coarse_ranks &&
+          cache.fine_boxes == key.fine_boxes && cache.ratio == key.ratio)
+        return cache.result;
+    }
+
     // Get all (including those not on this processor) fine-level boxes:
     hier::BoxList<spacedim> finer_box_list;
-    long                    combined_size = 0;
-    for (int i = 0; i < fine_level->getNumberOfPatches(); ++i)
+    for (const hier::Box<spacedim> &box : key.fine_boxes)
       {
-        hier::Box<spacedim> patch_box = fine_level->getBoxForPatch(i);
+        hier::Box<spacedim> patch_box = box;
         patch_box.coarsen(ratio);
-        combined_size += patch_box.size();
         finer_box_list.addItem(patch_box);
       }
     finer_box_list.simplifyBoxes();
 
-    // Remove said boxes from each coarse-level patch:
+    // Subtracting every fine box from every coarse patch is quadratic in the
+    // number of patches, so use a tree to find the (few) fine boxes which
+    // intersect each coarse patch. Boxes are closed sets of cell indices, so
+    // their corners work as bounding boxes.
+    std::vector<hier::Box<spacedim>>   finer_boxes;
+    std::vector<BoundingBox<spacedim>> finer_bboxes;
+    typename tbox::List<hier::Box<spacedim>>::Iterator fine_it(finer_box_list);
+    while (fine_it)
+      {
+        const hier::Box<spacedim> &box = *fine_it;
+        Point<spacedim>            lower, upper;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          {
+            lower[d] = box.lower(d);
+            upper[d] = box.upper(d);
+          }
+        finer_boxes.push_back(box);
+        finer_bboxes.emplace_back(std::make_pair(lower, upper));
+        fine_it++;
+      }
+    const auto rtree = pack_rtree_of_indices(finer_bboxes);
+
+    // Remove said boxes from each local coarse-level patch:
     const auto rank = tbox::SAMRAI_MPI::getRank();
     std::vector<std::vector<hier::Box<spacedim>>> result;
-    long                                          coarse_size = 0;
-    for (int i = 0; i < coarse_level->getNumberOfPatches(); ++i)
-      {
-        hier::BoxList<spacedim> coarse_box_list;
-        coarse_box_list.addItem(coarse_level->getBoxForPatch(i));
-        coarse_size += coarse_box_list.getFirstItem().size();
-        coarse_box_list.removeIntersections(finer_box_list);
+    for (std::size_t i = 0; i < key.coarse_boxes.size(); ++i)
+      if (key.coarse_ranks[i] == rank)
+        {
+          const hier::Box<spacedim> &coarse_box = key.coarse_boxes[i];
+          Point<spacedim>            lower, upper;
+          for (unsigned int d = 0; d < spacedim; ++d)
+            {
+              lower[d] = coarse_box.lower(d);
+              upper[d] = coarse_box.upper(d);
+            }
+          const BoundingBox<spacedim> coarse_bbox(std::make_pair(lower, upper));
+
+          // Keep the original order so that the output does not depend on
+          // the tree
+          std::vector<std::size_t> intersecting_boxes;
+          namespace bgi = boost::geometry::index;
+          for (const std::size_t fine_n :
+               rtree | bgi::adaptors::queried(bgi::intersects(coarse_bbox)))
+            intersecting_boxes.push_back(fine_n);
+          std::sort(intersecting_boxes.begin(), intersecting_boxes.end());
+
+          hier::BoxList<spacedim> nearby_box_list;
+          long                    combined_size = 0;
+          for (const std::size_t fine_n : intersecting_boxes)
+            {
+              nearby_box_list.addItem(finer_boxes[fine_n]);
+              combined_size += (finer_boxes[fine_n] * coarse_box).size();
+            }
+
+          hier::BoxList<spacedim> coarse_box_list;
+          coarse_box_list.addItem(coarse_box);
+          coarse_box_list.removeIntersections(nearby_box_list);
 
-        const bool patch_is_local = rank == coarse_level->getMappingForPatch(i);
-        if (patch_is_local)
           result.emplace_back();
-        typename tbox::List<hier::Box<spacedim>>::Iterator it(coarse_box_list);
-        while (it)
-          {
-            if (patch_is_local)
+          typename tbox::List<hier::Box<spacedim>>::Iterator it(
+            coarse_box_list);
+          while (it)
+            {
               result.back().push_back(*it);
-            combined_size += (*it).size();
-            it++;
-          }
-      }
+              combined_size += (*it).size();
+              it++;
+            }
 
-    AssertThrow(coarse_size == combined_size, ExcFDLInternalError());
+          AssertThrow(coarse_box.size() == combined_size,
+                      ExcFDLInternalError());
+        }
+
+    key.result = result;
+    {
+      std::lock_guard<std::mutex> lock(caches_mutex);
+      caches[coarse_level->getLevelNumber()] = std::move(key);
+    }
 
     return result;
   }
 
+  namespace
+  {
+    /**
+     * Compute the bounding boxes of the cells @p cells[i] for each i in
+     * @p cell_indices and store them in @p bboxes[i]. If @p n_threads is
+     * larger than one then the cells are split into ranges which are
+     * processed concurrently.
+     */
+    template <int dim, int spacedim, typename Number>
+    void
+    compute_bboxes_of_cells(
+      const DoFHandler<dim, spacedim> &dof_handler,
+      const Mapping<dim, spacedim>    &mapping,
+      const std::vector<
+        typename DoFHandler<dim, spacedim>::active_cell_iterator> &cells,
+      const std::vector<std::size_t>             &cell_indices,
+      std::vector<BoundingBox<spacedim, Number>> &bboxes,
+      const unsigned int                          n_threads)
+    {
+      // TODO: support multiple FEs
+      const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
+      // TODO: also check bboxes by position of quadrature points instead of
+      // just nodes. Use QProjector to place points solely on cell boundaries.
+      const Quadrature<dim> nodal_quad(fe.get_unit_support_points());
+
+      auto compute_range = [&](const std::size_t begin, const std::size_t end)
+      {
+        // FEValues is not thread-safe so each range needs its own
+        FEValues<dim, spacedim> fe_values(mapping,
+                                          fe,
+                                          nodal_quad,
+                                          update_quadrature_points);
+        for (std::size_t i = begin; i < end; ++i)
+          {
+            const std::size_t cell_index = cell_indices[i];
+            fe_values.reinit(cells[cell_index]);
+            const BoundingBox<spacedim> dbox(fe_values.get_quadrature_points());
+            // we have to do a conversion if Number != double
+            bboxes[cell_index].get_boundary_points() =
+              dbox.get_boundary_points();
+          }
+      };
+
+      const std::size_t n_cells = cell_indices.size();
+      if (n_threads <= 1 || n_cells <= 1)
+        compute_range(std::size_t(0), n_cells);
+      else
+        parallel::apply_to_subranges(
+          std::size_t(0),
+          n_cells,
+          compute_range,
+          static_cast<unsigned int>(
+            std::max<std::size_t>(1, n_cells / (4 * n_threads))));
+    }
+
+    /**
+     * Get all locally owned active cells in the usual order.
+     */
+    template <int dim, int spacedim>
+    std::vector<typename DoFHandler<dim, spacedim>::active_cell_iterator>
+    get_locally_owned_active_cells(const DoFHandler<dim, spacedim> &dof_handler)
+    {
+      std::vector<typename DoFHandler<dim, spacedim>::active_cell_iterator>
+        cells;
+      for (const auto &cell : dof_handler.active_cell_iterators())
+        if (cell->is_locally_owned())
+          cells.push_back(cell);
+      return cells;
+    }
+  } // namespace
+
   template <int dim, int spacedim, typename Number>
   std::vector<BoundingBox<spacedim, Number>>
   compute_cell_bboxes(const DoFHandler<dim, spacedim> &dof_handler,
                       const Mapping<dim, spacedim>    &mapping)
   {
-    // TODO: support multiple FEs
-    const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
-    // TODO: also check bboxes by position of quadrature points instead of
-    // just nodes. Use QProjector to place points solely on cell boundaries.
-    const Quadrature<dim> nodal_quad(fe.get_unit_support_points());
+    const auto cells = get_locally_owned_active_cells(dof_handler);
+    std::vector<std::size_t> cell_indices(cells.size());
+    std::iota(cell_indices.begin(), cell_indices.end(), std::size_t(0));
 
-    FEValues<dim, spacedim> fe_values(mapping,
-                                      fe,
-                                      nodal_quad,
-                                      update_quadrature_points);
+    std::vector<BoundingBox<spacedim, Number>> bboxes(cells.size());
+    compute_bboxes_of_cells(
+      dof_handler, mapping, cells, cell_indices, bboxes, 1);
+    return bboxes;
+  }
 
-    std::vector<BoundingBox<spacedim, Number>> bboxes;
-    for (const auto &cell : dof_handler.active_cell_iterators())
-      if (cell->is_locally_owned())
+  template <int dim, int spacedim, typename Number>
+  std::size_t
+  compute_cell_bboxes(const DoFHandler<dim, spacedim>            &dof_handler,
+                      const Mapping<dim, spacedim>               &mapping,
+                      const std::vector<double>                  &displacements,
+                      const double                                tolerance,
+                      std::vector<BoundingBox<spacedim, Number>> &bboxes,
+                      std::vector<double>                        &inflations,
+                      const unsigned int                          n_threads)
+  {
+    const auto        cells   = get_locally_owned_active_cells(dof_handler);
+    const std::size_t n_cells = cells.size();
+    Assert(displacements.size() == 1 || displacements.size() == n_cells,
+           ExcMessage("There should either be one displacement bound or one "
+                      "bound per locally owned active cell"));
+    AssertThrow(tolerance >= 0.0,
+                ExcMessage("The tolerance should be nonnegative"));
+
+    // If the cached boxes don't match the current cells then we have to start
+    // from scratch
+    std::vector<std::size_t> recompute_indices;
+    if (bboxes.size() != n_cells || inflations.size() != n_cells)
+      {
+        bboxes.clear();
+        bboxes.resize(n_cells);
+        inflations.clear();
+        inflations.resize(n_cells, 0.0);
+        recompute_indices.resize(n_cells);
+        std::iota(recompute_indices.begin(),
+                  recompute_indices.end(),
+                  std::size_t(0));
+      }
+    else
+      for (std::size_t i = 0; i < n_cells; ++i)
         {
-          fe_values.reinit(cell);
-          const BoundingBox<spacedim> dbox(fe_values.get_quadrature_points());
-          // we have to do a conversion if Number != double
-          BoundingBox<spacedim, Number> fbox;
-          fbox.get_boundary_points() = dbox.get_boundary_points();
-          bboxes.push_back(fbox);
+          const double displacement =
+            displacements.size() == 1 ? displacements[0] : displacements[i];
+          Assert(displacement >= 0.0,
+                 ExcMessage("Displacement bounds should be nonnegative"));
+          if (inflations[i] + displacement <= tolerance)
+            {
+              // Bounding boxes are computed from the positions of support
+              // points, none of which moved further than the bound, so this
+              // box still contains the cell's support points
+              if (displacement > 0.0)
+                bboxes[i].extend(Number(displacement));
+              inflations[i] += displacement;
+            }
+          else
+            {
+              inflations[i] = 0.0;
+              recompute_indices.push_back(i);
+            }
         }
-    return bboxes;
+
+    compute_bboxes_of_cells(
+      dof_handler, mapping, cells, recompute_indices, bboxes, n_threads);
+    return recompute_indices.size();
   }
 
   template <int dim, int spacedim, typename Number>
@@ -267,6 +487,164 @@ namespace fdl
     return global_bboxes;
   }
 
+  namespace
+  {
+    /**
+     * Return an inverted box, which intersects nothing.
+     */
+    template <int spacedim, typename Number>
+    BoundingBox<spacedim, Number>
+    make_empty_bbox()
+    {
+      BoundingBox<spacedim, Number> result;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        {
+          result.get_boundary_points().first[d] =
+            std::numeric_limits<Number>::max();
+          result.get_boundary_points().second[d] =
+            std::numeric_limits<Number>::lowest();
+        }
+      return result;
+    }
+
+    /**
+     * Implementation of collect_intersecting_active_cell_bboxes(): send each
+     * local value in @p local_values (which correspond to the local cells
+     * bounded by @p local_active_cell_bboxes) to the processors whose patches
+     * may intersect that cell. Values of cells which are not received are set
+     * to @p empty_value.
+     */
+    template <int dim, int spacedim, typename Number, typename Value>
+    std::vector<Value>
+    collect_intersecting_active_cell_values(
+      const parallel::shared::Triangulation<dim, spacedim> &tria,
+      const std::vector<BoundingBox<spacedim, Number>>
+        &local_active_cell_bboxes,
+      const std::vector<BoundingBox<spacedim, Number>> &local_patch_bboxes,
+      const std::vector<Value>                         &local_values,
+      const Value                                      &empty_value)
+    {
+      Assert(
+        tria.n_locally_owned_active_cells() == local_active_cell_bboxes.size(),
+        ExcMessage("There should be a local bbox for each local active cell"));
+      AssertDimension(local_active_cell_bboxes.size(), local_values.size());
+
+      const MPI_Comm            comm = tria.get_communicator();
+      const types::subdomain_id rank = Utilities::MPI::this_mpi_process(comm);
+      std::vector<Value> global_values(tria.n_active_cells(), empty_value);
+
+      // Exchange one box (the union of all patch boxes) per processor. Start
+      // with an inverted box so that processors without patches intersect
+      // nothing.
+      BoundingBox<spacedim, Number> patch_union =
+        make_empty_bbox<spacedim, Number>();
+      for (const auto &bbox : local_patch_bboxes)
+        patch_union.merge_with(bbox);
+      const std::vector<BoundingBox<spacedim, Number>> all_patch_unions =
+        Utilities::MPI::all_gather(comm, patch_union);
+
+      std::vector<types::subdomain_id>           union_ranks;
+      std::vector<BoundingBox<spacedim, Number>> nonempty_patch_unions;
+      for (types::subdomain_id r = 0; r < all_patch_unions.size(); ++r)
+        if (r != rank && all_patch_unions[r].lower_bound(0) <=
+                           all_patch_unions[r].upper_bound(0))
+          {
+            union_ranks.push_back(r);
+            nonempty_patch_unions.push_back(all_patch_unions[r]);
+          }
+      const auto rtree = pack_rtree_of_indices(nonempty_patch_unions);
+
+      // Send each local value to the processors which might need it:
+      std::map<types::subdomain_id,
+               std::vector<std::pair<unsigned int, Value>>>
+                   values_to_send;
+      unsigned int local_cell_n = 0;
+      for (const auto &cell : tria.active_cell_iterators())
+        if (tria.get_true_subdomain_ids_of_cells()[cell->active_cell_index()] ==
+            rank)
+          {
+            AssertIndexRange(local_cell_n, local_active_cell_bboxes.size());
+            const auto &bbox  = local_active_cell_bboxes[local_cell_n];
+            const auto &value = local_values[local_cell_n];
+            global_values[cell->active_cell_index()] = value;
+
+            namespace bgi = boost::geometry::index;
+            for (const std::size_t union_n :
+                 rtree | bgi::adaptors::queried(bgi::intersects(bbox)))
+              {
+                AssertIndexRange(union_n, union_ranks.size());
+                values_to_send[union_ranks[union_n]].emplace_back(
+                  cell->active_cell_index(), value);
+              }
+            ++local_cell_n;
+          }
+
+      const auto received_values =
+        Utilities::MPI::some_to_some(comm, values_to_send);
+      for (const auto &pair : received_values)
+        for (const auto &index_and_value : pair.second)
+          {
+            AssertIndexRange(index_and_value.first, global_values.size());
+            global_values[index_and_value.first] = index_and_value.second;
+          }
+
+      return global_values;
+    }
+  } // namespace
+
+  template <int dim, int spacedim, typename Number>
+  std::vector<BoundingBox<spacedim, Number>>
+  collect_intersecting_active_cell_bboxes(
+    const parallel::shared::Triangulation<dim, spacedim> &tria,
+    const std::vector<BoundingBox<spacedim, Number>> &local_active_cell_bboxes,
+    const std::vector<BoundingBox<spacedim, Number>> &local_patch_bboxes)
+  {
+    return collect_intersecting_active_cell_values(
+      tria,
+      local_active_cell_bboxes,
+      local_patch_bboxes,
+      local_active_cell_bboxes,
+      make_empty_bbox<spacedim, Number>());
+  }
+
+  template <int dim, int spacedim, typename Number>
+  std::vector<BoundingBox<spacedim, Number>>
+  collect_intersecting_active_cell_bboxes(
+    const parallel::shared::Triangulation<dim, spacedim> &tria,
+    const std::vector<BoundingBox<spacedim, Number>> &local_active_cell_bboxes,
+    const std::vector<BoundingBox<spacedim, Number>> &local_patch_bboxes,
+    const std::vector<float> &local_active_cell_lengths,
+    std::vector<float>       &active_cell_lengths)
+  {
+    AssertDimension(local_active_cell_bboxes.size(),
+                    local_active_cell_lengths.size());
+    using BBoxAndLength = std::pair<BoundingBox<spacedim, Number>, float>;
+    std::vector<BBoxAndLength> local_values;
+    local_values.reserve(local_active_cell_bboxes.size());
+    for (std::size_t i = 0; i < local_active_cell_bboxes.size(); ++i)
+      local_values.emplace_back(local_active_cell_bboxes[i],
+                                local_active_cell_lengths[i]);
+
+    const std::vector<BBoxAndLength> values =
+      collect_intersecting_active_cell_values(
+        tria,
+        local_active_cell_bboxes,
+        local_patch_bboxes,
+        local_values,
+        BBoxAndLength(make_empty_bbox<spacedim, Number>(), 0.0f));
+
+    std::vector<BoundingBox<spacedim, Number>> bboxes;
+    bboxes.reserve(values.size());
+    active_cell_lengths.resize(0);
+    active_cell_lengths.reserve(values.size());
+    for (const auto &pair : values)
+      {
+        bboxes.push_back(pair.first);
+        active_cell_lengths.push_back(pair.second);
+      }
+    return bboxes;
+  }
+
   template <int spacedim>
   BoundingBox<spacedim>
   box_to_bbox(
@@ -294,6 +672,64 @@ namespace fdl
     return BoundingBox<spacedim>(result);
   }
 
+  template <int dim, int spacedim>
+  std::vector<types::subdomain_id>
+  compute_patch_aligned_subdomain_ids(
+    const parallel::shared::Triangulation<dim, spacedim> &tria,
+    const tbox::Pointer<hier::PatchHierarchy<spacedim>>  &patch_hierarchy)
+  {
+    const unsigned int n_procs =
+      Utilities::MPI::n_mpi_processes(tria.get_communicator());
+    std::vector<types::subdomain_id> subdomain_ids(
+      tria.n_active_cells(), numbers::invalid_subdomain_id);
+
+    // Cells not yet assigned to a processor
+    std::vector<std::pair<Point<spacedim>, unsigned int>> cells;
+    for (const auto &cell : tria.active_cell_iterators())
+      cells.emplace_back(cell->center(), cell->active_cell_index());
+
+    for (int ln = patch_hierarchy->getFinestLevelNumber();
+         ln >= 0 && cells.size() > 0;
+         --ln)
+      {
+        const tbox::Pointer<hier::PatchLevel<spacedim>> level =
+          patch_hierarchy->getPatchLevel(ln);
+        AssertThrow(level, ExcFDLNotImplemented());
+        // Every processor knows about every patch on the level
+        std::vector<BoundingBox<spacedim>> patch_bboxes;
+        std::vector<int>                   patch_ranks;
+        for (int patch_n = 0; patch_n < level->getNumberOfPatches(); ++patch_n)
+          {
+            patch_bboxes.push_back(
+              box_to_bbox<spacedim>(level->getBoxForPatch(patch_n), level));
+            patch_ranks.push_back(level->getMappingForPatch(patch_n));
+          }
+        const auto rtree = pack_rtree_of_indices(patch_bboxes);
+
+        std::vector<std::pair<Point<spacedim>, unsigned int>> remaining_cells;
+        for (const auto &pair : cells)
+          {
+            // Patches on the same level do not overlap, so (up to ties on
+            // patch boundaries) the first one is the only one
+            namespace bgi = boost::geometry::index;
+            const auto it = rtree.qbegin(bgi::intersects(pair.first));
+            if (it != rtree.qend())
+              {
+                AssertIndexRange(*it, patch_ranks.size());
+                subdomain_ids[pair.second] = patch_ranks[*it];
+              }
+            else
+              remaining_cells.push_back(pair);
+          }
+        cells.swap(remaining_cells);
+      }
+
+    for (std::size_t i = 0; i < cells.size(); ++i)
+      subdomain_ids[cells[i].second] = (i * n_procs) / cells.size();
+
+    return subdomain_ids;
+  }
+
   // these depend on SAMRAI types, and SAMRAI only has 2D and 3D libraries, so
   // use whatever IBTK is using
 
@@ -333,6 +769,42 @@ namespace fdl
   compute_cell_bboxes(const DoFHandler<NDIM, NDIM> &dof_handler,
                       const Mapping<NDIM, NDIM>    &mapping);
 
+  template std::size_t
+  compute_cell_bboxes(const DoFHandler<NDIM - 1, NDIM>      &dof_handler,
+                      const Mapping<NDIM - 1, NDIM>         &mapping,
+                      const std::vector<double>             &displacements,
+                      const double                           tolerance,
+                      std::vector<BoundingBox<NDIM, float>> &bboxes,
+                      std::vector<double>                   &inflations,
+                      const unsigned int                     n_threads);
+
+  template std::size_t
+  compute_cell_bboxes(const DoFHandler<NDIM, NDIM>          &dof_handler,
+                      const Mapping<NDIM, NDIM>             &mapping,
+                      const std::vector<double>             &displacements,
+                      const double                           tolerance,
+                      std::vector<BoundingBox<NDIM, float>> &bboxes,
+                      std::vector<double>                   &inflations,
+                      const unsigned int                     n_threads);
+
+  template std::size_t
+  compute_cell_bboxes(const DoFHandler<NDIM - 1, NDIM>       &dof_handler,
+                      const Mapping<NDIM - 1, NDIM>          &mapping,
+                      const std::vector<double>              &displacements,
+                      const double                            tolerance,
+                      std::vector<BoundingBox<NDIM, double>> &bboxes,
+                      std::vector<double>                    &inflations,
+                      const unsigned int                      n_threads);
+
+  template std::size_t
+  compute_cell_bboxes(const DoFHandler<NDIM, NDIM>           &dof_handler,
+                      const Mapping<NDIM, NDIM>              &mapping,
+                      const std::vector<double>              &displacements,
+                      const double                            tolerance,
+                      std::vector<BoundingBox<NDIM, double>> &bboxes,
+                      std::vector<double>                    &inflations,
+                      const unsigned int                      n_threads);
+
   // collect_all_active_cell_bboxes:
   template std::vector<BoundingBox<NDIM, float>>
   collect_all_active_cell_bboxes(
@@ -354,6 +826,73 @@ namespace fdl
     const parallel::shared::Triangulation<NDIM, NDIM> &tria,
     const std::vector<BoundingBox<NDIM, double>> &local_active_cell_bboxes);
 
+  // collect_intersecting_active_cell_bboxes:
+  template std::vector<BoundingBox<NDIM, float>>
+  collect_intersecting_active_cell_bboxes(
+    const parallel::shared::Triangulation<NDIM - 1, NDIM> &tria,
+    const std::vector<BoundingBox<NDIM, float>> &local_active_cell_bboxes,
+    const std::vector<BoundingBox<NDIM, float>> &local_patch_bboxes);
+
+  template std::vector<BoundingBox<NDIM, float>>
+  collect_intersecting_active_cell_bboxes(
+    const parallel::shared::Triangulation<NDIM, NDIM> &tria,
+    const std::vector<BoundingBox<NDIM, float>> &local_active_cell_bboxes,
+    const std::vector<BoundingBox<NDIM, float>> &local_patch_bboxes);
+
+  template std::vector<BoundingBox<NDIM, double>>
+  collect_intersecting_active_cell_bboxes(
+    const parallel::shared::Triangulation<NDIM - 1, NDIM> &tria,
+    const std::vector<BoundingBox<NDIM, double>> &local_active_cell_bboxes,
+    const std::vector<BoundingBox<NDIM, double>> &local_patch_bboxes);
+
+  template std::vector<BoundingBox<NDIM, double>>
+  collect_intersecting_active_cell_bboxes(
+    const parallel::shared::Triangulation<NDIM, NDIM> &tria,
+    const std::vector<BoundingBox<NDIM, double>> &local_active_cell_bboxes,
+    const std::vector<BoundingBox<NDIM, double>> &local_patch_bboxes);
+
+  template std::vector<BoundingBox<NDIM, float>>
+  collect_intersecting_active_cell_bboxes(
+    const parallel::shared::Triangulation<NDIM - 1, NDIM> &tria,
+    const std::vector<BoundingBox<NDIM, float>> &local_active_cell_bboxes,
+    const std::vector<BoundingBox<NDIM, float>> &local_patch_bboxes,
+    const std::vector<float> &local_active_cell_lengths,
+    std::vector<float>       &active_cell_lengths);
+
+  template std::vector<BoundingBox<NDIM, float>>
+  collect_intersecting_active_cell_bboxes(
+    const parallel::shared::Triangulation<NDIM, NDIM> &tria,
+    const std::vector<BoundingBox<NDIM, float>> &local_active_cell_bboxes,
+    const std::vector<BoundingBox<NDIM, float>> &local_patch_bboxes,
+    const std::vector<float> &local_active_cell_lengths,
+    std::vector<float>       &active_cell_lengths);
+
+  template std::vector<BoundingBox<NDIM, double>>
+  collect_intersecting_active_cell_bboxes(
+    const parallel::shared::Triangulation<NDIM - 1, NDIM> &tria,
+    const std::vector<BoundingBox<NDIM, double>> &local_active_cell_bboxes,
+    const std::vector<BoundingBox<NDIM, double>> &local_patch_bboxes,
+    const std::vector<float> &local_active_cell_lengths,
+    std::vector<float>       &active_cell_lengths);
+
+  template std::vector<BoundingBox<NDIM, double>>
+  collect_intersecting_active_cell_bboxes(
+    const parallel::shared::Triangulation<NDIM, NDIM> &tria,
+    const std::vector<BoundingBox<NDIM, double>> &local_active_cell_bboxes,
+    const std::vector<BoundingBox<NDIM, double>> &local_patch_bboxes,
+    const std::vector<float> &local_active_cell_lengths,
+    std::vector<float>       &active_cell_lengths);
+
+  template std::vector<types::subdomain_id>
+  compute_patch_aligned_subdomain_ids(
+    const parallel::shared::Triangulation<NDIM - 1, NDIM> &tria,
+    const tbox::Pointer<hier::PatchHierarchy<NDIM>>       &patch_hierarchy);
+
+  template std::vector<types::subdomain_id>
+  compute_patch_aligned_subdomain_ids(
+    const parallel::shared::Triangulation<NDIM, NDIM> &tria,
+    const tbox::Pointer<hier::PatchHierarchy<NDIM>>   &patch_hierarchy);
+
   template BoundingBox<NDIM>
   box_to_bbox(const hier::Box<NDIM>                           &box,
               const tbox::Pointer<hier::BasePatchLevel<NDIM>> &patch_level);
@@ -7,6 +7,8 @@
 
 #include <deal.II/dofs/dof_handler.h>
 
+#include <deal.II/fe/fe.h>
+
 #include <deal.II/grid/tria.h>
 
 #include <deal.II/lac/block_vector.h>
@@ -14,6 +16,10 @@
 #include <deal.II/lac/la_parallel_vector.h>
 #include <deal.II/lac/vector.h>
 
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 #ifdef DEAL_II_TRILINOS_WITH_SEACAS
 #  include <exodusII.h>
 #endif
@@ -70,15 +76,21 @@ namespace fdl
       return ReferenceCells::Invalid;
     }
 
+    /**
+     * Read the coordinates of @p n_nodes consecutive nodes, starting at the
+     * (zero-indexed) node @p first_node.
+     */
     template <int spacedim>
     std::vector<Point<spacedim>>
-    read_vertices(const int ex_id, const int n_nodes)
+    read_vertices(const int ex_id, const int first_node, const int n_nodes)
     {
       std::vector<double> xs(n_nodes);
       std::vector<double> ys(n_nodes);
       std::vector<double> zs(n_nodes);
 
-      const int ierr = ex_get_coord(ex_id, xs.data(), ys.data(), zs.data());
+      // ExodusII indexes from 1
+      const int ierr = ex_get_partial_coord(
+        ex_id, first_node + 1, n_nodes, xs.data(), ys.data(), zs.data());
       AssertThrowExodusII(ierr);
 
       std::vector<Point<spacedim>> vertices;
@@ -104,10 +116,14 @@ namespace fdl
       return vertices;
     }
 
-    int
-    get_variable_index(const int            ex_id,
-                       const ex_entity_type entity_type,
-                       const std::string   &variable_name)
+    /**
+     * Look up the (one-indexed) ExodusII indices of several variables. The
+     * names of all variables are only read once.
+     */
+    std::vector<int>
+    get_variable_indices(const int                       ex_id,
+                         const ex_entity_type            entity_type,
+                         const std::vector<std::string> &variable_names)
     {
       int n_variables = -1;
       int ierr        = ex_get_variable_param(ex_id, entity_type, &n_variables);
@@ -121,24 +137,395 @@ namespace fdl
         ex_get_variable_names(ex_id, entity_type, n_variables, names.data());
       AssertThrowExodusII(ierr);
 
-      int variable_index = -1;
-      for (int variable_n = 0; variable_n < n_variables; ++variable_n)
-        if (names[variable_n] == variable_name)
-          {
-            // ExodusII indexes from 1
-            variable_index = variable_n + 1;
-            break;
-          }
+      std::vector<int> variable_indices;
+      for (const std::string &variable_name : variable_names)
+        {
+          int variable_index = -1;
+          for (int variable_n = 0; variable_n < n_variables; ++variable_n)
+            if (names[variable_n] == variable_name)
+              {
+                // ExodusII indexes from 1
+                variable_index = variable_n + 1;
+                break;
+              }
 
-      AssertThrow(variable_index != -1,
-                  ExcMessage("The given variable name " + variable_name +
-                             " is not an element variable in the given "
-                             "ExodusII file."));
+          AssertThrow(variable_index != -1,
+                      ExcMessage("The given variable name " + variable_name +
+                                 " is not " +
+                                 (entity_type == EX_NODAL ? "a nodal" :
+                                                            "an element") +
+                                 " variable in the given ExodusII file."));
+          variable_indices.push_back(variable_index);
+        }
 
       for (char *&name : names)
         std::free(name);
 
-      return variable_index;
+      return variable_indices;
+    }
+
+    int
+    open_exodus_file(const std::string &filename)
+    {
+      // deal.II always uses double precision numbers for geometry. ExodusII
+      // converts from the stored word size if necessary.
+      int component_word_size = sizeof(double);
+      // setting to zero uses the stored word size
+      int   floating_point_word_size = 0;
+      float ex_version               = 0.0;
+
+      const int ex_id = ex_open(filename.c_str(),
+                                EX_READ,
+                                &component_word_size,
+                                &floating_point_word_size,
+                                &ex_version);
+      AssertThrow(ex_id > 0,
+                  ExcMessage(
+                    "ExodusII failed to open the specified input file."));
+      return ex_id;
+    }
+
+    /**
+     * The part of an ExodusII element block which is relevant to the current
+     * processor. Since the locally owned cells of a block need not be
+     * contiguous, we store the smallest range of elements containing all of
+     * them: reading that range (instead of the whole block) keeps the amount
+     * of data each processor reads proportional to the number of cells it
+     * owns.
+     */
+    template <int dim, int spacedim>
+    struct LocalElementBlock
+    {
+      int id;
+
+      ReferenceCell type;
+
+      int n_nodes_per_element;
+
+      /**
+       * Zero-indexed position, in the block, of the first element to read.
+       */
+      int first_element;
+
+      /**
+       * Number of elements to read.
+       */
+      int n_elements;
+
+      /**
+       * Coarse cells in this block with at least one locally owned active
+       * descendant (i.e., locally owned cells, if the Triangulation is not
+       * refined) and their positions relative to first_element.
+       */
+      std::vector<
+        std::pair<typename Triangulation<dim, spacedim>::cell_iterator, int>>
+        cells;
+    };
+
+    /**
+     * Call @p f(cell) for each locally owned active descendant of @p cell
+     * (including @p cell itself, if it is active).
+     */
+    template <typename CellIterator, typename Function>
+    void
+    for_each_locally_owned_active_descendant(const CellIterator &cell,
+                                             const Function     &f)
+    {
+      if (cell->is_active())
+        {
+          if (cell->is_locally_owned())
+            f(cell);
+        }
+      else
+        for (unsigned int child_n = 0; child_n < cell->n_children(); ++child_n)
+          for_each_locally_owned_active_descendant(cell->child(child_n), f);
+    }
+
+    template <typename CellIterator>
+    bool
+    has_locally_owned_active_descendant(const CellIterator &cell)
+    {
+      if (cell->is_active())
+        return cell->is_locally_owned();
+      for (unsigned int child_n = 0; child_n < cell->n_children(); ++child_n)
+        if (has_locally_owned_active_descendant(cell->child(child_n)))
+          return true;
+      return false;
+    }
+
+    /**
+     * Write the selected entries of @p cell_values, i.e., the values of the
+     * DoFs of @p cell (which need not be active), into @p dof_vector. If
+     * @p cell has children then the values are first prolongated to them
+     * (which is exact since the finite element spaces are nested), so this
+     * writes to all locally owned active descendants of @p cell. Like the
+     * rest of this file, this only writes to locally owned DoFs.
+     */
+    template <int dim, int spacedim, typename VectorType>
+    void
+    set_descendant_dof_values(
+      const typename DoFHandler<dim, spacedim>::cell_iterator &cell,
+      const Vector<double>                                    &cell_values,
+      const std::vector<bool>                                 &selected_dofs,
+      const IndexSet                                          &index_set,
+      std::vector<types::global_dof_index>                    &cell_dofs,
+      VectorType                                              &dof_vector)
+    {
+      if (cell->is_active())
+        {
+          if (!cell->is_locally_owned())
+            return;
+          cell->get_dof_indices(cell_dofs);
+          for (unsigned int i = 0; i < cell_dofs.size(); ++i)
+            if (selected_dofs[i] && index_set.is_element(cell_dofs[i]))
+              dof_vector[cell_dofs[i]] = cell_values[i];
+          return;
+        }
+
+      const FiniteElement<dim, spacedim> &fe = cell->get_fe();
+      Vector<double>                      child_values(fe.n_dofs_per_cell());
+      for (unsigned int child_n = 0; child_n < cell->n_children(); ++child_n)
+        if (has_locally_owned_active_descendant(cell->child(child_n)))
+          {
+            fe.get_prolongation_matrix(child_n, cell->refinement_case())
+              .vmult(child_values, cell_values);
+            set_descendant_dof_values<dim, spacedim>(cell->child(child_n),
+                                                     child_values,
+                                                     selected_dofs,
+                                                     index_set,
+                                                     cell_dofs,
+                                                     dof_vector);
+          }
+    }
+
+    /**
+     * Match the elements of each element block to the coarse cells of @p
+     * tria. According to circa line 2400 of tria.cc, the coarse cells of a
+     * Triangulation have the same order as the elements in the input file.
+     * Refinement does not change the coarse cells, so this also works for
+     * Triangulations which were refined (or refined and then coarsened)
+     * after being read.
+     */
+    template <int dim, int spacedim>
+    std::vector<LocalElementBlock<dim, spacedim>>
+    get_local_element_blocks(const int                           ex_id,
+                             const Triangulation<dim, spacedim> &tria)
+    {
+      // Read basic mesh information:
+      std::vector<char> cell_kind_name(MAX_LINE_LENGTH + 1, '\0');
+      int               mesh_dimension   = 0;
+      int               n_nodes          = 0;
+      int               n_elements       = 0;
+      int               n_element_blocks = 0;
+      int               n_node_sets      = 0;
+      int               n_side_sets      = 0;
+
+      int ierr = ex_get_init(ex_id,
+                             cell_kind_name.data(),
+                             &mesh_dimension,
+                             &n_nodes,
+                             &n_elements,
+                             &n_element_blocks,
+                             &n_node_sets,
+                             &n_side_sets);
+      AssertThrowExodusII(ierr);
+      AssertDimension(mesh_dimension, spacedim);
+      AssertDimension(n_elements, tria.n_cells(0));
+
+      std::vector<int> element_block_ids(n_element_blocks);
+      ierr = ex_get_ids(ex_id, EX_ELEM_BLOCK, element_block_ids.data());
+      AssertThrowExodusII(ierr);
+
+      std::vector<LocalElementBlock<dim, spacedim>> blocks;
+      auto cell = tria.begin(0);
+      for (const int element_block_id : element_block_ids)
+        {
+          std::fill(cell_kind_name.begin(), cell_kind_name.end(), '\0');
+          int n_block_elements         = 0;
+          int n_nodes_per_element      = 0;
+          int n_edges_per_element      = 0;
+          int n_faces_per_element      = 0;
+          int n_attributes_per_element = 0;
+
+          // Extract element data:
+          ierr = ex_get_block(ex_id,
+                              EX_ELEM_BLOCK,
+                              element_block_id,
+                              cell_kind_name.data(),
+                              &n_block_elements,
+                              &n_nodes_per_element,
+                              &n_edges_per_element,
+                              &n_faces_per_element,
+                              &n_attributes_per_element);
+          AssertThrowExodusII(ierr);
+
+          LocalElementBlock<dim, spacedim> block;
+          block.id   = element_block_id;
+          block.type = exodusii_name_to_type(cell_kind_name.data(),
+                                             n_nodes_per_element);
+          block.n_nodes_per_element = n_nodes_per_element;
+          block.first_element       = -1;
+          block.n_elements          = 0;
+          for (int element_n = 0; element_n < n_block_elements; ++element_n)
+            {
+              if (has_locally_owned_active_descendant(cell))
+                {
+                  if (block.first_element == -1)
+                    block.first_element = element_n;
+                  block.n_elements = element_n - block.first_element + 1;
+                  block.cells.emplace_back(cell,
+                                           element_n - block.first_element);
+                }
+              ++cell;
+            }
+
+          if (block.cells.size() > 0)
+            blocks.push_back(std::move(block));
+        }
+
+      return blocks;
+    }
+
+    /**
+     * Read the values of the elemental variable with index @p var_index on the
+     * elements of @p block read by the current processor.
+     */
+    template <int dim, int spacedim>
+    void
+    read_block_elemental_values(const int                               ex_id,
+                                const LocalElementBlock<dim, spacedim> &block,
+                                const int            time_step_n,
+                                const int            var_index,
+                                std::vector<double> &values)
+    {
+      // ExodusII indexes from 1.
+      values.resize(block.n_elements);
+      const int ierr = ex_get_partial_var(ex_id,
+                                          time_step_n,
+                                          EX_ELEM_BLOCK,
+                                          var_index,
+                                          block.id,
+                                          block.first_element + 1,
+                                          block.n_elements,
+                                          values.data());
+      AssertThrowExodusII(ierr);
+    }
+
+    template <int dim, int spacedim>
+    void
+    check_block_material_id(
+      const LocalElementBlock<dim, spacedim>                     &block,
+      const typename Triangulation<dim, spacedim>::cell_iterator &cell)
+    {
+      AssertThrow(long(cell->material_id()) == long(block.id),
+                  ExcMessage("This function requires that the elements are "
+                             "traversed in the same order as the ExodusII "
+                             "blocks."));
+    }
+
+    /**
+     * Read the values of the elemental variable @p variable_name on the
+     * coarse cells of each block and call @p store(cell, value) for each.
+     */
+    template <int dim, int spacedim, typename StoreFunction>
+    void
+    read_elemental_values(
+      const int                                            ex_id,
+      const std::vector<LocalElementBlock<dim, spacedim>> &blocks,
+      const int                                            time_step_n,
+      const std::string                                   &variable_name,
+      const StoreFunction                                 &store)
+    {
+      const int var_index =
+        get_variable_indices(ex_id, EX_ELEM_BLOCK, {variable_name})[0];
+      std::vector<double> block_element_values;
+      for (const LocalElementBlock<dim, spacedim> &block : blocks)
+        {
+          read_block_elemental_values(
+            ex_id, block, time_step_n, var_index, block_element_values);
+          for (const auto &pair : block.cells)
+            {
+              check_block_material_id(block, pair.first);
+              store(pair.first, block_element_values[pair.second]);
+            }
+        }
+    }
+
+    /**
+     * Read the connectivity of the elements of each block read by the current
+     * processor and determine the smallest range of nodes containing all the
+     * nodes of the locally owned cells. The returned node numbers are
+     * relative to @p first_node.
+     *
+     * TODO we can support 64-bit indices here - use
+     *
+     * k = ex_inquire_int(ex_id, EX_INQ_DB_MAX_USED_NAME_LENGTH); and
+     * ex_set_max_name_length(ex_id, k);
+     */
+    template <int dim, int spacedim>
+    std::vector<std::vector<int>>
+    read_local_connectivity(
+      const int                                            ex_id,
+      const std::vector<LocalElementBlock<dim, spacedim>> &blocks,
+      int                                                 &first_node,
+      int                                                 &n_local_nodes)
+    {
+      first_node    = std::numeric_limits<int>::max();
+      int last_node = std::numeric_limits<int>::min();
+
+      std::vector<std::vector<int>> connections;
+      for (const LocalElementBlock<dim, spacedim> &block : blocks)
+        {
+          connections.emplace_back(block.n_nodes_per_element *
+                                   block.n_elements);
+          const int ierr = ex_get_partial_conn(ex_id,
+                                               EX_ELEM_BLOCK,
+                                               block.id,
+                                               block.first_element + 1,
+                                               block.n_elements,
+                                               connections.back().data(),
+                                               nullptr,
+                                               nullptr);
+          AssertThrowExodusII(ierr);
+
+          for (const auto &pair : block.cells)
+            for (int i = 0; i < block.n_nodes_per_element; ++i)
+              {
+                // ExodusII indexes from 1
+                const int node_n =
+                  connections.back()[pair.second * block.n_nodes_per_element +
+                                     i] -
+                  1;
+                first_node = std::min(first_node, node_n);
+                last_node  = std::max(last_node, node_n);
+              }
+        }
+
+      n_local_nodes = last_node - first_node + 1;
+      for (std::vector<int> &block_connections : connections)
+        for (int &node_n : block_connections)
+          node_n -= first_node + 1;
+
+      return connections;
+    }
+
+    /**
+     * For each component of @p fe, the cell DoFs of that component and their
+     * indices within the component. Computing this once avoids calling
+     * FiniteElement::system_to_component_index() on every cell.
+     */
+    template <int dim, int spacedim>
+    std::vector<std::vector<std::pair<unsigned int, unsigned int>>>
+    compute_component_dofs(const FiniteElement<dim, spacedim> &fe)
+    {
+      std::vector<std::vector<std::pair<unsigned int, unsigned int>>>
+        component_dofs(fe.n_components());
+      for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
+        {
+          const auto pair = fe.system_to_component_index(i);
+          component_dofs[pair.first].emplace_back(i, pair.second);
+        }
+      return component_dofs;
     }
 
     /**
@@ -184,14 +571,19 @@ namespace fdl
       return line_n_to_dof_n[line_n];
     }
 
+    /**
+     * Given the permutation from ExodusII vertices to deal.II vertices,
+     * compute the permutation of the remaining (i.e., non-vertex) nodes. After
+     * calling this function, ExodusII node i corresponds to the deal.II DoF
+     * (within its component) permutation_to_deal_vertices[i].
+     */
     void
-    permute_values(const ReferenceCell        type,
-                   const int                  n_nodes_per_element,
-                   std::vector<unsigned int> &permutation_to_deal_vertices,
-                   std::vector<double>       &component_dof_values)
+    complete_permutation(
+      const ReferenceCell        type,
+      const int                  n_nodes_per_element,
+      std::vector<unsigned int> &permutation_to_deal_vertices)
     {
       AssertDimension(permutation_to_deal_vertices.size(), n_nodes_per_element);
-      AssertDimension(component_dof_values.size(), n_nodes_per_element);
       const unsigned int X = numbers::invalid_unsigned_int;
       switch (type)
         {
@@ -275,174 +667,6 @@ namespace fdl
             AssertThrow(n_nodes_per_element == int(type.n_vertices()),
                         fdl::ExcFDLNotImplemented());
         }
-
-      // It would be best to use boost::algorithm::apply_inverse_permutation()
-      // here but that's not in the bundled version of boost shipped with
-      // deal.II: - for compatibility, implement our own version.
-      for (std::size_t i = 0; i < permutation_to_deal_vertices.size(); ++i)
-        {
-          while (i != permutation_to_deal_vertices[i])
-            {
-              const auto next = permutation_to_deal_vertices[i];
-              std::swap(component_dof_values[i], component_dof_values[next]);
-              std::swap(permutation_to_deal_vertices[i],
-                        permutation_to_deal_vertices[next]);
-            }
-        }
-    }
-
-    template <int dim, int spacedim, typename VectorType>
-    void
-    read_nodal_components(const int                        ex_id,
-                          const std::vector<std::string>  &variable_names,
-                          const int                        time_step_n,
-                          const DoFHandler<dim, spacedim> &dof_handler,
-                          const std::vector<unsigned int> &components,
-                          VectorType                      &dof_vector)
-    {
-      FDL_SETUP_TIMER_AND_SCOPE(t_read_nodal_components,
-                                "fdl::read_nodal_components()");
-      // Read basic mesh information:
-      std::vector<char> cell_kind_name(MAX_LINE_LENGTH + 1, '\0');
-      int               mesh_dimension   = 0;
-      int               n_nodes          = 0;
-      int               n_elements       = 0;
-      int               n_element_blocks = 0;
-      int               n_node_sets      = 0;
-      int               n_side_sets      = 0;
-
-      int ierr = ex_get_init(ex_id,
-                             cell_kind_name.data(),
-                             &mesh_dimension,
-                             &n_nodes,
-                             &n_elements,
-                             &n_element_blocks,
-                             &n_node_sets,
-                             &n_side_sets);
-      AssertThrowExodusII(ierr);
-      AssertDimension(mesh_dimension, spacedim);
-
-      const auto       vertices = read_vertices<spacedim>(ex_id, n_nodes);
-      std::vector<int> element_block_ids(n_element_blocks);
-      ierr = ex_get_ids(ex_id, EX_ELEM_BLOCK, element_block_ids.data());
-      AssertThrowExodusII(ierr);
-
-
-      for (unsigned int component_n = 0; component_n < components.size();
-           ++component_n)
-        {
-          // Permit writing into unghosted vectors by doing a check first
-          const IndexSet index_set = dof_vector.locally_owned_elements();
-
-          const int var_index =
-            get_variable_index(ex_id, EX_NODAL, variable_names[component_n]);
-          // This array could potentially be massive. Try to minimize total
-          // memory usage by not loading each component nodal value array at
-          // once.
-          std::vector<double> nodal_values(n_nodes);
-          ierr = ex_get_var(ex_id,
-                            time_step_n,
-                            EX_NODAL,
-                            var_index,
-                            1,
-                            n_nodes,
-                            nodal_values.data());
-          AssertThrowExodusII(ierr);
-
-          auto cell = dof_handler.begin_active();
-          for (const int element_block_id : element_block_ids)
-            {
-              std::fill(cell_kind_name.begin(), cell_kind_name.end(), '\0');
-              int n_block_elements         = 0;
-              int n_nodes_per_element      = 0;
-              int n_edges_per_element      = 0;
-              int n_faces_per_element      = 0;
-              int n_attributes_per_element = 0;
-
-              // Extract element data:
-              ierr = ex_get_block(ex_id,
-                                  EX_ELEM_BLOCK,
-                                  element_block_id,
-                                  cell_kind_name.data(),
-                                  &n_block_elements,
-                                  &n_nodes_per_element,
-                                  &n_edges_per_element,
-                                  &n_faces_per_element,
-                                  &n_attributes_per_element);
-              AssertThrowExodusII(ierr);
-
-              const ReferenceCell type =
-                exodusii_name_to_type(cell_kind_name.data(),
-                                      n_nodes_per_element);
-              AssertThrowExodusII(ierr);
-
-              const std::size_t connection_size =
-                n_nodes_per_element * n_block_elements;
-              // TODO we can support 64-bit indices here - use
-              //
-              // k = ex_inquire_int(ex_id, EX_INQ_DB_MAX_USED_NAME_LENGTH); and
-              // ex_set_max_name_length(ex_id, k);
-              std::vector<int> connection(connection_size);
-              ierr = ex_get_conn(ex_id,
-                                 EX_ELEM_BLOCK,
-                                 element_block_id,
-                                 connection.data(),
-                                 nullptr,
-                                 nullptr);
-              AssertThrowExodusII(ierr);
-
-              std::vector<types::global_dof_index> cell_dofs;
-              std::vector<double>       cell_values(n_nodes_per_element);
-              std::vector<unsigned int> exodus_cell_node_ns(
-                n_nodes_per_element);
-              std::vector<unsigned int> local_exodus_to_deal(
-                n_nodes_per_element);
-              for (std::size_t node_n = 0; node_n < connection_size;
-                   node_n += n_nodes_per_element)
-                {
-                  if (cell->is_locally_owned())
-                    {
-                      const FiniteElement<dim, spacedim> &fe = cell->get_fe();
-                      cell_dofs.resize(fe.n_dofs_per_cell());
-                      cell->get_dof_indices(cell_dofs);
-                      std::copy_n(connection.begin() + node_n,
-                                  n_nodes_per_element,
-                                  exodus_cell_node_ns.begin());
-                      for (auto &node_n : exodus_cell_node_ns)
-                        node_n -= 1;
-                      std::fill(local_exodus_to_deal.begin(),
-                                local_exodus_to_deal.end(),
-                                numbers::invalid_unsigned_int);
-                      for (int i = 0; i < n_nodes_per_element; ++i)
-                        cell_values[i] = nodal_values[exodus_cell_node_ns[i]];
-
-                      // At this point (due to renumbering, reorientation, etc)
-                      // we are not guaranteed that the node numbers match the
-                      // vertex numbers. Hence we reestablish the numbering
-                      // based on vertex equality.
-                      for (const auto i : type.vertex_indices())
-                        for (const auto j : type.vertex_indices())
-                          if (vertices[exodus_cell_node_ns[i]] ==
-                              cell->vertex(j))
-                            local_exodus_to_deal[i] = j;
-
-                      permute_values(type,
-                                     n_nodes_per_element,
-                                     local_exodus_to_deal,
-                                     cell_values);
-
-                      for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
-                        {
-                          const auto pair = fe.system_to_component_index(i);
-                          if (pair.first == component_n &&
-                              index_set.is_element(cell_dofs[i]))
-                            dof_vector[cell_dofs[i]] = cell_values[pair.second];
-                        }
-                    }
-                  ++cell;
-                }
-            }
-        }
     }
   } // namespace
 #endif
@@ -458,107 +682,25 @@ namespace fdl
     FDL_SETUP_TIMER_AND_SCOPE(t_read_elemental_data,
                               "fdl::read_elemental_data()");
     AssertDimension(cell_vector.size(), tria.n_active_cells());
-    Assert(tria.n_levels() == 1,
-           ExcMessage("This function can only be called on unrefined grids."));
-    // According to circa line 2400 of tria.cc, the cells of a Triangulation
-    // have the same order of the input file - hence we can just load data
-    // into a serial vector and copy that straight over to a parallel deal.II
-    // vector.
 #ifdef DEAL_II_TRILINOS_WITH_SEACAS
-    // deal.II always uses double precision numbers for geometry
-    int component_word_size = sizeof(double);
-    // setting to zero uses the stored word size
-    int   floating_point_word_size = 0;
-    float ex_version               = 0.0;
-
-    const int ex_id = ex_open(filename.c_str(),
-                              EX_READ,
-                              &component_word_size,
-                              &floating_point_word_size,
-                              &ex_version);
-    AssertThrow(floating_point_word_size == component_word_size,
-                ExcFDLNotImplemented());
-    AssertThrow(ex_id > 0,
-                ExcMessage(
-                  "ExodusII failed to open the specified input file."));
-
-    // Read basic mesh information:
-    std::vector<char> cell_kind_name(MAX_LINE_LENGTH + 1, '\0');
-    int               mesh_dimension   = 0;
-    int               n_nodes          = 0;
-    int               n_elements       = 0;
-    int               n_element_blocks = 0;
-    int               n_node_sets      = 0;
-    int               n_side_sets      = 0;
-
-    int ierr = ex_get_init(ex_id,
-                           cell_kind_name.data(),
-                           &mesh_dimension,
-                           &n_nodes,
-                           &n_elements,
-                           &n_element_blocks,
-                           &n_node_sets,
-                           &n_side_sets);
-    AssertThrowExodusII(ierr);
-    AssertDimension(mesh_dimension, spacedim);
-
-    std::vector<int> element_block_ids(n_element_blocks);
-    ierr = ex_get_ids(ex_id, EX_ELEM_BLOCK, element_block_ids.data());
-    AssertThrowExodusII(ierr);
-
-    auto cell = tria.begin_active();
-    for (const int element_block_id : element_block_ids)
+    const int  ex_id  = open_exodus_file(filename);
+    const auto blocks = get_local_element_blocks(ex_id, tria);
+    read_elemental_values(
+      ex_id,
+      blocks,
+      time_step_n,
+      variable_name,
+      [&](const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+          const double value)
       {
-        std::fill(cell_kind_name.begin(), cell_kind_name.end(), '\0');
-        int n_block_elements         = 0;
-        int n_nodes_per_element      = 0;
-        int n_edges_per_element      = 0;
-        int n_faces_per_element      = 0;
-        int n_attributes_per_element = 0;
-
-        // Extract element data:
-        ierr = ex_get_block(ex_id,
-                            EX_ELEM_BLOCK,
-                            element_block_id,
-                            cell_kind_name.data(),
-                            &n_block_elements,
-                            &n_nodes_per_element,
-                            &n_edges_per_element,
-                            &n_faces_per_element,
-                            &n_attributes_per_element);
-        AssertThrowExodusII(ierr);
-
-        const int var_index =
-          get_variable_index(ex_id, EX_ELEM_BLOCK, variable_name);
-
-        // Extract elementwise data:
-        std::vector<double> block_element_values(n_block_elements);
-        ierr = ex_get_var(ex_id,
-                          time_step_n,
-                          EX_ELEM_BLOCK,
-                          var_index,
-                          element_block_id,
-                          n_block_elements,
-                          block_element_values.data());
-        AssertThrowExodusII(ierr);
-
-        for (int element_n = 0; element_n < n_block_elements; ++element_n)
-          {
-            if (cell->is_locally_owned())
-              {
-                AssertThrow(
-                  long(cell->material_id()) == long(element_block_id),
-                  ExcMessage(
-                    "This function requires that the elements are traversed in "
-                    "the same order as the ExodusII blocks."));
-                cell_vector[cell->active_cell_index()] =
-                  block_element_values[element_n];
-              }
-            ++cell;
-          }
-      }
-
-    ierr = ex_close(ex_id);
+        // Refinement does not change elemental data
+        for_each_locally_owned_active_descendant(
+          cell,
+          [&](const typename Triangulation<dim, spacedim>::cell_iterator &c)
+          { cell_vector[c->active_cell_index()] = value; });
+      });
+
+    const int ierr = ex_close(ex_id);
     AssertThrowExodusII(ierr);
 
 #else
@@ -579,97 +721,188 @@ namespace fdl
                 const DoFHandler<dim, spacedim> &dof_handler,
                 const int                        time_step_n,
                 const std::vector<std::string>  &variable_names,
-                VectorType                      &dof_vector)
-  // TODO - make this work with a ComponentMask
+                VectorType                      &dof_vector,
+                const ComponentMask             &component_mask)
   {
     FDL_SETUP_TIMER_AND_SCOPE(t_read_dof_data, "fdl::read_dof_data()");
 #ifdef DEAL_II_TRILINOS_WITH_SEACAS
-    Assert(dof_handler.get_triangulation().n_levels() == 1,
-           ExcMessage("This function can only be called on unrefined grids."));
+    Assert(!dof_handler.has_hp_capabilities(), ExcFDLNotImplemented());
     AssertDimension(dof_handler.n_dofs(), dof_vector.size());
     AssertDimension(dof_handler.n_locally_owned_dofs(),
                     dof_vector.locally_owned_size());
-
-    // Partition FEs into elemental and nodal parts. ExodusII does not support
-    // variables which have both elemental and nodal parts so we ignore that
-    // case. Hence we can examine just the first FE to set up the partitioning
-    // on all components.
-    std::vector<unsigned int>           elemental_components;
-    std::vector<unsigned int>           nodal_components;
     const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
+    AssertThrow(component_mask.represents_n_components(fe.n_components()),
+                ExcMessage("The ComponentMask must either be empty or have "
+                           "one entry for each component of the "
+                           "FiniteElement."));
+    AssertThrow(variable_names.size() ==
+                  component_mask.n_selected_components(fe.n_components()),
+                ExcMessage("There must be exactly one variable name for "
+                           "each selected component."));
+
+    // Partition the selected components into elemental and nodal parts.
+    // ExodusII does not support variables which have both elemental and nodal
+    // parts so we ignore that case. Hence we can examine just the first FE to
+    // set up the partitioning on all components.
+    std::vector<unsigned int> elemental_components;
+    std::vector<std::string>  elemental_names;
+    std::vector<unsigned int> nodal_components;
+    std::vector<std::string>  nodal_names;
+    auto                      variable_name = variable_names.begin();
     for (unsigned int component = 0; component < fe.n_components(); ++component)
+      if (component_mask[component])
+        {
+          const FiniteElement<dim, spacedim> &sub_fe =
+            fe.get_sub_fe(component, 1);
+          if (sub_fe.tensor_degree() == 0)
+            {
+              elemental_components.push_back(component);
+              elemental_names.push_back(*variable_name);
+            }
+          else
+            {
+              nodal_components.push_back(component);
+              nodal_names.push_back(*variable_name);
+            }
+          ++variable_name;
+        }
+
+    // Open the file and match cells to elements once for all components
+    const int  ex_id = open_exodus_file(filename);
+    const auto blocks =
+      get_local_element_blocks(ex_id, dof_handler.get_triangulation());
+    const std::vector<int> elemental_var_indices =
+      get_variable_indices(ex_id, EX_ELEM_BLOCK, elemental_names);
+
+    // Nodal data is stored for all elements at once, so read it (along with
+    // the connectivity and vertices it depends on) before looping over the
+    // blocks.
+    int                              first_node    = 0;
+    int                              n_local_nodes = 0;
+    std::vector<std::vector<int>>    connections;
+    std::vector<Point<spacedim>>     vertices;
+    std::vector<std::vector<double>> nodal_values(nodal_components.size());
+    if (nodal_components.size() > 0 && blocks.size() > 0)
       {
-        const FiniteElement<dim, spacedim> &sub_fe =
-          fe.get_sub_fe(component, 1);
-        if (sub_fe.tensor_degree() == 0)
-          elemental_components.push_back(component);
-        else
-          nodal_components.push_back(component);
+        connections =
+          read_local_connectivity(ex_id, blocks, first_node, n_local_nodes);
+        vertices = read_vertices<spacedim>(ex_id, first_node, n_local_nodes);
+        const std::vector<int> nodal_var_indices =
+          get_variable_indices(ex_id, EX_NODAL, nodal_names);
+        for (std::size_t k = 0; k < nodal_components.size(); ++k)
+          {
+            nodal_values[k].resize(n_local_nodes);
+            const int ierr = ex_get_partial_var(ex_id,
+                                                time_step_n,
+                                                EX_NODAL,
+                                                nodal_var_indices[k],
+                                                1,
+                                                first_node + 1,
+                                                n_local_nodes,
+                                                nodal_values[k].data());
+            AssertThrowExodusII(ierr);
+          }
       }
 
-    // elemental data:
-    for (const unsigned int component : elemental_components)
+    // Scatter all components in a single pass over the coarse cells: the
+    // values on each coarse cell are prolongated to its locally owned active
+    // descendants. Permit writing into unghosted vectors by doing a check
+    // first.
+    const IndexSet index_set      = dof_vector.locally_owned_elements();
+    const auto     component_dofs = compute_component_dofs(fe);
+    std::vector<std::vector<double>> element_values(
+      elemental_components.size());
+    std::vector<types::global_dof_index> cell_dofs(fe.n_dofs_per_cell());
+    std::vector<bool>                    selected_dofs(fe.n_dofs_per_cell());
+    for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
+      selected_dofs[i] = component_mask[fe.system_to_component_index(i).first];
+    Vector<double> cell_values(fe.n_dofs_per_cell());
+    std::vector<unsigned int>            exodus_to_deal;
+    std::vector<unsigned int>            deal_to_exodus;
+    for (std::size_t block_n = 0; block_n < blocks.size(); ++block_n)
       {
-        Vector<typename VectorType::value_type> component_values(
-          dof_handler.get_triangulation().n_active_cells());
-
-        read_elemental_data(filename,
-                            dof_handler.get_triangulation(),
-                            time_step_n,
-                            variable_names[component],
-                            component_values);
-
-        std::vector<types::global_dof_index> cell_dofs;
-        for (const auto &cell : dof_handler.active_cell_iterators())
-          if (cell->is_locally_owned())
-            {
-              cell_dofs.resize(cell->get_fe().n_dofs_per_cell());
-              cell->get_dof_indices(cell_dofs);
-              for (unsigned int i = 0; i < cell_dofs.size(); ++i)
+        const LocalElementBlock<dim, spacedim> &block = blocks[block_n];
+        const int n_nodes_per_element = block.n_nodes_per_element;
+        for (std::size_t k = 0; k < elemental_components.size(); ++k)
+          read_block_elemental_values(ex_id,
+                                      block,
+                                      time_step_n,
+                                      elemental_var_indices[k],
+                                      element_values[k]);
+
+        exodus_to_deal.resize(n_nodes_per_element);
+        deal_to_exodus.resize(n_nodes_per_element);
+        for (const auto &cell_pair : block.cells)
+          {
+            const typename DoFHandler<dim, spacedim>::cell_iterator cell(
+              &dof_handler.get_triangulation(),
+              cell_pair.first->level(),
+              cell_pair.first->index(),
+              &dof_handler);
+
+            // elemental data:
+            if (elemental_components.size() > 0)
+              check_block_material_id(block, cell_pair.first);
+            for (std::size_t k = 0; k < elemental_components.size(); ++k)
+              for (const auto &pair : component_dofs[elemental_components[k]])
+                cell_values[pair.first] = element_values[k][cell_pair.second];
+
+            // nodal data:
+            if (nodal_components.size() == 0)
+              {
+                set_descendant_dof_values<dim, spacedim>(cell,
+                                                         cell_values,
+                                                         selected_dofs,
+                                                         index_set,
+                                                         cell_dofs,
+                                                         dof_vector);
+                continue;
+              }
+            const int *const exodus_cell_node_ns =
+              connections[block_n].data() +
+              cell_pair.second * n_nodes_per_element;
+
+            // At this point (due to renumbering, reorientation, etc) we are
+            // not guaranteed that the node numbers match the vertex numbers.
+            // Hence we reestablish the numbering based on vertex equality.
+            std::fill(exodus_to_deal.begin(),
+                      exodus_to_deal.end(),
+                      numbers::invalid_unsigned_int);
+            for (const auto i : block.type.vertex_indices())
+              for (const auto j : block.type.vertex_indices())
+                if (vertices[exodus_cell_node_ns[i]] == cell->vertex(j))
+                  exodus_to_deal[i] = j;
+            complete_permutation(block.type,
+                                 n_nodes_per_element,
+                                 exodus_to_deal);
+            for (int i = 0; i < n_nodes_per_element; ++i)
+              deal_to_exodus[exodus_to_deal[i]] = i;
+
+            for (std::size_t k = 0; k < nodal_components.size(); ++k)
+              for (const auto &pair : component_dofs[nodal_components[k]])
                 {
-                  const auto pair = fe.system_to_component_index(i);
-                  if (pair.first == component)
-                    dof_vector[cell_dofs[i]] =
-                      component_values[cell->active_cell_index()];
+                  const int node_n =
+                    exodus_cell_node_ns[deal_to_exodus[pair.second]];
+                  cell_values[pair.first] = nodal_values[k][node_n];
                 }
-            }
+            set_descendant_dof_values<dim, spacedim>(cell,
+                                                     cell_values,
+                                                     selected_dofs,
+                                                     index_set,
+                                                     cell_dofs,
+                                                     dof_vector);
+          }
       }
 
-    // nodal data:
-    {
-      // deal.II always uses double precision numbers for geometry
-      int component_word_size = sizeof(double);
-      // setting to zero uses the stored word size
-      int   floating_point_word_size = 0;
-      float ex_version               = 0.0;
-
-      const int ex_id = ex_open(filename.c_str(),
-                                EX_READ,
-                                &component_word_size,
-                                &floating_point_word_size,
-                                &ex_version);
-      AssertThrow(ex_id > 0,
-                  ExcMessage(
-                    "ExodusII failed to open the specified input file."));
-
-      std::vector<unsigned int> components(dof_handler.get_fe().n_components());
-      std::iota(components.begin(), components.end(), 0u);
-      read_nodal_components(ex_id,
-                            variable_names,
-                            time_step_n,
-                            dof_handler,
-                            nodal_components,
-                            dof_vector);
-
-      const int ierr = ex_close(ex_id);
-      AssertThrowExodusII(ierr);
-    }
+    const int ierr = ex_close(ex_id);
+    AssertThrowExodusII(ierr);
 #else
     (void)filename;
     (void)dof_handler;
     (void)time_step_n;
     (void)variable_names;
     (void)dof_vector;
+    (void)component_mask;
     AssertThrow(false, ExcMessage("Only available with Trilinos + SEACAS"));
 #endif
   }
@@ -707,54 +940,62 @@ namespace fdl
                 const DoFHandler<NDIM - 1, NDIM> &dof_handler,
                 const int                         time_step_n,
                 const std::vector<std::string>   &var_names,
-                Vector<double>                   &dof_vector);
+                Vector<double>                   &dof_vector,
+                const ComponentMask              &mask);
 
   template void
   read_dof_data(const std::string              &filename,
                 const DoFHandler<NDIM, NDIM>   &dof_handler,
                 const int                       time_step_n,
                 const std::vector<std::string> &var_names,
-                Vector<double>                 &dof_vector);
+                Vector<double>                 &dof_vector,
+                const ComponentMask            &mask);
 
   template void
   read_dof_data(const std::string                          &filename,
                 const DoFHandler<NDIM - 1, NDIM>           &dof_handler,
                 const int                                   time_step_n,
                 const std::vector<std::string>             &var_names,
-                LinearAlgebra::distributed::Vector<double> &dof_vector);
+                LinearAlgebra::distributed::Vector<double> &dof_vector,
+                const ComponentMask                        &mask);
 
   template void
   read_dof_data(const std::string                          &filename,
                 const DoFHandler<NDIM, NDIM>               &dof_handler,
                 const int                                   time_step_n,
                 const std::vector<std::string>             &var_names,
-                LinearAlgebra::distributed::Vector<double> &dof_vector);
+                LinearAlgebra::distributed::Vector<double> &dof_vector,
+                const ComponentMask                        &mask);
 
   template void
   read_dof_data(const std::string                &filename,
                 const DoFHandler<NDIM - 1, NDIM> &dof_handler,
                 const int                         time_step_n,
                 const std::vector<std::string>   &var_names,
-                BlockVector<double>              &dof_vector);
+                BlockVector<double>              &dof_vector,
+                const ComponentMask              &mask);
 
   template void
   read_dof_data(const std::string              &filename,
                 const DoFHandler<NDIM, NDIM>   &dof_handler,
                 const int                       time_step_n,
                 const std::vector<std::string> &var_names,
-                BlockVector<double>            &dof_vector);
+                BlockVector<double>            &dof_vector,
+                const ComponentMask            &mask);
 
   template void
   read_dof_data(const std::string                               &filename,
                 const DoFHandler<NDIM - 1, NDIM>                &dof_handler,
                 const int                                        time_step_n,
                 const std::vector<std::string>                  &var_names,
-                LinearAlgebra::distributed::BlockVector<double> &dof_vector);
+                LinearAlgebra::distributed::BlockVector<double> &dof_vector,
+                const ComponentMask                             &mask);
 
   template void
   read_dof_data(const std::string                               &filename,
                 const DoFHandler<NDIM, NDIM>                    &dof_handler,
                 const int                                        time_step_n,
                 const std::vector<std::string>                  &var_names,
-                LinearAlgebra::distributed::BlockVector<double> &dof_vector);
+                LinearAlgebra::distributed::BlockVector<double> &dof_vector,
+                const ComponentMask                             &mask);
 } // namespace fdl
@@ -16,6 +16,12 @@
 #include <deal.II/lac/la_parallel_vector.h>
 #include <deal.II/lac/vector.h>
 
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
 #include <vector>
 
 #ifdef DEAL_II_TRILINOS_WITH_SEACAS
@@ -194,6 +200,39 @@ namespace fdl
 
 
 
+  template <int dim, int spacedim>
+  std::vector<float>
+  compute_equivalent_edge_lengths(
+    const Triangulation<dim, spacedim> &tria,
+    const Mapping<dim, spacedim>       &mapping,
+    const Quadrature<dim>              &quadrature)
+  {
+    Assert(tria.get_reference_cells().size() == 1, ExcNotImplemented());
+    const ReferenceCell reference_cell = tria.get_reference_cells().front();
+    const double        reference_measure = reference_cell.volume();
+
+    FE_Nothing<dim, spacedim> fe_nothing(reference_cell);
+    FEValues<dim, spacedim>   fe_values(mapping,
+                                      fe_nothing,
+                                      quadrature,
+                                      update_JxW_values);
+
+    std::vector<float> result;
+    for (const auto &cell : tria.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          fe_values.reinit(cell);
+          double measure = 0.0;
+          for (unsigned int q = 0; q < quadrature.size(); ++q)
+            measure += fe_values.JxW(q);
+          result.push_back(std::pow(measure / reference_measure, 1.0 / dim));
+        }
+
+    return result;
+  }
+
+
+
   template <int dim, int spacedim = dim>
   std::vector<float>
   collect_longest_edge_lengths(
@@ -265,94 +304,204 @@ namespace fdl
     return global_active_edge_lengths;
   }
 
+#ifdef DEAL_II_TRILINOS_WITH_SEACAS
+  namespace
+  {
+    // Read several nodesets (in the order they are stored in the file) and
+    // the coordinates of their nodes.
+    template <int spacedim>
+    std::vector<
+      std::pair<std::vector<unsigned int>, std::vector<Point<spacedim>>>>
+    read_nodesets(const std::string      &filename,
+                  const std::vector<int> &nodeset_ids)
+    {
+      // deal.II always uses double precision numbers for geometry
+      int component_word_size = sizeof(double);
+      // setting to zero uses the stored word size
+      int   floating_point_word_size = 0;
+      float ex_version               = 0.0;
+
+      const int ex_id = ex_open(filename.c_str(),
+                                EX_READ,
+                                &component_word_size,
+                                &floating_point_word_size,
+                                &ex_version);
+      AssertThrow(ex_id > 0,
+                  ExcMessage(
+                    "ExodusII failed to open the specified input file."));
+      std::vector<char> cell_kind_name(MAX_LINE_LENGTH + 1, '\0');
+      int               mesh_dimension   = 0;
+      int               n_nodes          = 0;
+      int               n_elements       = 0;
+      int               n_element_blocks = 0;
+      int               n_node_sets      = 0;
+      int               n_side_sets      = 0;
+
+      int ierr = ex_get_init(ex_id,
+                             cell_kind_name.data(),
+                             &mesh_dimension,
+                             &n_nodes,
+                             &n_elements,
+                             &n_element_blocks,
+                             &n_node_sets,
+                             &n_side_sets);
+      AssertThrowExodusII(ierr);
+      AssertDimension(mesh_dimension, spacedim);
+
+      // Read the node numbers of every nodeset first so that we only need to
+      // read the coordinates of the nodes between the first and last nodes
+      // in any nodeset
+      std::vector<std::vector<unsigned int>> vertex_indices;
+      int                                    first_node = n_nodes;
+      int                                    last_node  = -1;
+      for (const int nodeset_id : nodeset_ids)
+        {
+          int n_nodeset_nodes = 0;
+          int n_dist_fact     = 0; // not used
+          ierr                = ex_get_set_param(
+            ex_id, EX_NODE_SET, nodeset_id, &n_nodeset_nodes, &n_dist_fact);
+          AssertThrowExodusII(ierr);
+
+          std::vector<int> node_ids(n_nodeset_nodes);
+          ierr = ex_get_set(
+            ex_id, EX_NODE_SET, nodeset_id, node_ids.data(), nullptr);
+          AssertThrowExodusII(ierr);
+
+          vertex_indices.emplace_back();
+          vertex_indices.back().reserve(n_nodeset_nodes);
+          for (const int &node_id : node_ids)
+            {
+              const int vertex_n = node_id - 1;
+              Assert(vertex_n >= 0 && vertex_n < n_nodes,
+                     ExcFDLInternalError());
+              first_node = std::min(first_node, vertex_n);
+              last_node  = std::max(last_node, vertex_n);
+              vertex_indices.back().push_back(vertex_n);
+            }
+        }
+
+      const int n_read_nodes = std::max(last_node - first_node + 1, 0);
+
+      std::vector<double> xs(n_read_nodes);
+      std::vector<double> ys(n_read_nodes);
+      std::vector<double> zs(n_read_nodes);
+      if (n_read_nodes > 0)
+        {
+          ierr = ex_get_partial_coord(ex_id,
+                                      first_node + 1,
+                                      n_read_nodes,
+                                      xs.data(),
+                                      ys.data(),
+                                      zs.data());
+          AssertThrowExodusII(ierr);
+        }
+
+      ierr = ex_close(ex_id);
+      AssertThrowExodusII(ierr);
+
+      std::vector<
+        std::pair<std::vector<unsigned int>, std::vector<Point<spacedim>>>>
+        nodesets;
+      for (std::vector<unsigned int> &indices : vertex_indices)
+        {
+          std::vector<Point<spacedim>> vertices;
+          vertices.reserve(indices.size());
+          for (const unsigned int vertex_n : indices)
+            {
+              const unsigned int i = vertex_n - first_node;
+              switch (spacedim)
+                {
+                  case 1:
+                    vertices.emplace_back(xs[i]);
+                    break;
+                  case 2:
+                    vertices.emplace_back(xs[i], ys[i]);
+                    break;
+                  case 3:
+                    vertices.emplace_back(xs[i], ys[i], zs[i]);
+                    break;
+                  default:
+                    Assert(spacedim <= 3, ExcNotImplemented());
+                }
+            }
+          nodesets.emplace_back(std::move(indices), std::move(vertices));
+        }
+
+      return nodesets;
+    }
+  } // namespace
+#endif
+
   template <int spacedim>
   std::pair<std::vector<unsigned int>, std::vector<Point<spacedim>>>
   extract_nodeset(const std::string &filename, const int nodeset_id)
   {
 #ifdef DEAL_II_TRILINOS_WITH_SEACAS
-    // deal.II always uses double precision numbers for geometry
-    int component_word_size = sizeof(double);
-    // setting to zero uses the stored word size
-    int   floating_point_word_size = 0;
-    float ex_version               = 0.0;
-
-    const int ex_id = ex_open(filename.c_str(),
-                              EX_READ,
-                              &component_word_size,
-                              &floating_point_word_size,
-                              &ex_version);
-    AssertThrow(ex_id > 0,
-                ExcMessage(
-                  "ExodusII failed to open the specified input file."));
-    std::vector<char> cell_kind_name(MAX_LINE_LENGTH + 1, '\0');
-    int               mesh_dimension   = 0;
-    int               n_nodes          = 0;
-    int               n_elements       = 0;
-    int               n_element_blocks = 0;
-    int               n_node_sets      = 0;
-    int               n_side_sets      = 0;
-
-    int ierr = ex_get_init(ex_id,
-                           cell_kind_name.data(),
-                           &mesh_dimension,
-                           &n_nodes,
-                           &n_elements,
-                           &n_element_blocks,
-                           &n_node_sets,
-                           &n_side_sets);
-    AssertThrowExodusII(ierr);
-    AssertDimension(mesh_dimension, spacedim);
-
-    int n_nodeset_nodes = 0;
-    int n_dist_fact     = 0; // not used
-    ierr                = ex_get_set_param(
-      ex_id, EX_NODE_SET, nodeset_id, &n_nodeset_nodes, &n_dist_fact);
-    AssertThrowExodusII(ierr);
-
-    std::vector<int> node_ids(n_nodeset_nodes);
-    ierr = ex_get_set(ex_id, EX_NODE_SET, nodeset_id, node_ids.data(), nullptr);
-    AssertThrowExodusII(ierr);
-
-    // Perhaps there is a better way to do this than getting all nodes
-    std::vector<double> xs(n_nodes);
-    std::vector<double> ys(n_nodes);
-    std::vector<double> zs(n_nodes);
-
-    ierr = ex_get_coord(ex_id, xs.data(), ys.data(), zs.data());
-    AssertThrowExodusII(ierr);
-
-    std::vector<Point<spacedim>> vertices;
-    std::vector<unsigned int>    vertex_indices;
-    vertices.reserve(n_nodeset_nodes);
-    vertex_indices.reserve(n_nodeset_nodes);
-    for (const int &node_id : node_ids)
+    return std::move(read_nodesets<spacedim>(filename, {nodeset_id})[0]);
+#else
+    (void)filename;
+    (void)nodeset_id;
+    AssertThrow(false, ExcMessage("Only available with Trilinos + SEACAS"));
+
+    return {};
+#endif
+  }
+
+  template <int spacedim>
+  std::vector<
+    std::pair<std::vector<unsigned int>, std::vector<Point<spacedim>>>>
+  extract_nodesets(const std::string      &filename,
+                   const std::vector<int> &nodeset_ids,
+                   const MPI_Comm          comm)
+  {
+#ifdef DEAL_II_TRILINOS_WITH_SEACAS
+    // Read the file once per shared-memory node
+    MPI_Comm  node_comm = MPI_COMM_NULL;
+    const int rank      = Utilities::MPI::this_mpi_process(comm);
+    int       ierr      = MPI_Comm_split_type(
+      comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node_comm);
+    AssertThrowMPI(ierr);
+
+    std::vector<
+      std::pair<std::vector<unsigned int>, std::vector<Point<spacedim>>>>
+      nodesets;
+    if (Utilities::MPI::this_mpi_process(node_comm) == 0)
       {
-        auto vertex_n = node_id - 1;
-        Assert(vertex_n >= 0 && vertex_n < n_nodes, ExcFDLInternalError());
-        vertex_indices.push_back(vertex_n);
-        switch (spacedim)
+        nodesets = read_nodesets<spacedim>(filename, nodeset_ids);
+
+        // Sort each nodeset by node number and remove duplicates
+        for (auto &nodeset : nodesets)
           {
-            case 1:
-              vertices.emplace_back(xs[vertex_n]);
-              break;
-            case 2:
-              vertices.emplace_back(xs[vertex_n], ys[vertex_n]);
-              break;
-            case 3:
-              vertices.emplace_back(xs[vertex_n], ys[vertex_n], zs[vertex_n]);
-              break;
-            default:
-              Assert(spacedim <= 3, ExcNotImplemented());
+            const std::vector<unsigned int> &indices = nodeset.first;
+            std::vector<unsigned int> permutation(indices.size());
+            std::iota(permutation.begin(), permutation.end(), 0u);
+            std::sort(permutation.begin(),
+                      permutation.end(),
+                      [&](const unsigned int a, const unsigned int b)
+                      { return indices[a] < indices[b]; });
+
+            std::vector<unsigned int>    sorted_indices;
+            std::vector<Point<spacedim>> sorted_vertices;
+            for (const unsigned int i : permutation)
+              if (sorted_indices.empty() || sorted_indices.back() != indices[i])
+                {
+                  sorted_indices.push_back(indices[i]);
+                  sorted_vertices.push_back(nodeset.second[i]);
+                }
+            nodeset.first  = std::move(sorted_indices);
+            nodeset.second = std::move(sorted_vertices);
           }
       }
+    nodesets = Utilities::MPI::broadcast(node_comm, nodesets, 0);
 
-    ierr = ex_close(ex_id);
-    AssertThrowExodusII(ierr);
+    ierr = MPI_Comm_free(&node_comm);
+    AssertThrowMPI(ierr);
 
-    return std::make_pair(std::move(vertex_indices), std::move(vertices));
+    return nodesets;
 #else
     (void)filename;
-    (void)nodeset_id;
+    (void)nodeset_ids;
+    (void)comm;
     AssertThrow(false, ExcMessage("Only available with Trilinos + SEACAS"));
 
     return {};
@@ -403,11 +552,9 @@ namespace fdl
                                   quadrature,
                                   update_JxW_values | update_quadrature_points);
 
-    Tensor<1, dim> local_centroid;
-    double         local_volume = 0.0;
-#ifdef DEBUG
-    std::size_t local_n_faces = 0;
-#endif
+    // Reduce the number of faces, the area, and the weighted sum of points at
+    // once
+    std::vector<double> local_values(dim + 2);
     for (const auto &cell : tria.active_cell_iterators())
       if (cell->is_locally_owned())
         for (const auto &face : cell->face_iterators())
@@ -419,28 +566,23 @@ namespace fdl
               face_values.reinit(cell, face);
               for (unsigned int qp_n = 0; qp_n < quadrature.size(); ++qp_n)
                 {
-                  local_centroid +=
-                    face_values.quadrature_point(qp_n) * face_values.JxW(qp_n);
-                  local_volume += face_values.JxW(qp_n);
+                  const Point<dim> &point = face_values.quadrature_point(qp_n);
+                  for (unsigned int d = 0; d < dim; ++d)
+                    local_values[d] += point[d] * face_values.JxW(qp_n);
+                  local_values[dim] += face_values.JxW(qp_n);
                 }
-#ifdef DEBUG
-              ++local_n_faces;
-#endif
+              local_values[dim + 1] += 1.0;
             }
 
-#ifdef DEBUG
-    const auto n_faces =
-      Utilities::MPI::sum(local_n_faces, tria.get_communicator());
-    Assert(n_faces > 0,
+    const std::vector<double> values =
+      Utilities::MPI::sum(local_values, tria.get_communicator());
+    Assert(values[dim + 1] > 0.0,
            ExcMessage("There should be at least one face with one of the "
                       "boundary ids."));
-#endif
-    const double volume =
-      Utilities::MPI::sum(local_volume, tria.get_communicator());
-    Assert(volume > 0, ExcFDLInternalError());
-    auto centroid =
-      Point<dim>(Utilities::MPI::sum(local_centroid, tria.get_communicator()));
-    centroid /= volume;
+    Assert(values[dim] > 0, ExcFDLInternalError());
+    Point<dim> centroid;
+    for (unsigned int d = 0; d < dim; ++d)
+      centroid[d] = values[d] / values[dim];
     return centroid;
   }
 
@@ -453,6 +595,15 @@ namespace fdl
                                const Mapping<NDIM, NDIM> &,
                                const Quadrature<1> &);
 
+  template std::vector<float>
+  compute_equivalent_edge_lengths(const Triangulation<NDIM - 1, NDIM> &,
+                                  const Mapping<NDIM - 1, NDIM> &,
+                                  const Quadrature<NDIM - 1> &);
+  template std::vector<float>
+  compute_equivalent_edge_lengths(const Triangulation<NDIM, NDIM> &,
+                                  const Mapping<NDIM, NDIM> &,
+                                  const Quadrature<NDIM> &);
+
   template std::vector<float>
   collect_longest_edge_lengths(
     const parallel::shared::Triangulation<NDIM - 1, NDIM> &,
@@ -466,6 +617,12 @@ namespace fdl
   template std::pair<std::vector<unsigned int>, std::vector<Point<NDIM>>>
   extract_nodeset<NDIM>(const std::string &filename, const int nodeset_id);
 
+  template std::vector<
+    std::pair<std::vector<unsigned int>, std::vector<Point<NDIM>>>>
+  extract_nodesets<NDIM>(const std::string      &filename,
+                         const std::vector<int> &nodeset_ids,
+                         const MPI_Comm          comm);
+
   template Point<2>
   compute_centroid(const Mapping<2> &,
                    const Triangulation<2> &,
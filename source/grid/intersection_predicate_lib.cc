@@ -5,16 +5,30 @@
 
 #include <deal.II/distributed/shared_tria.h>
 
-#include <boost/iterator/function_output_iterator.hpp>
+#include <numeric>
+#include <vector>
 
 namespace fdl
 {
   using namespace dealii;
 
+  namespace
+  {
+    template <typename RTreeType, typename BBoxType>
+    bool
+    intersects_any(const RTreeType &rtree, const BBoxType &bbox)
+    {
+      // Query iterators are lazy, so this stops at the first intersection
+      namespace bgi = boost::geometry::index;
+      return rtree.qbegin(bgi::intersects(bbox)) != rtree.qend();
+    }
+  } // namespace
+
   template <int dim, int spacedim>
   TriaIntersectionPredicate<dim, spacedim>::TriaIntersectionPredicate(
     const std::vector<BoundingBox<spacedim>> &bboxes)
     : patch_boxes(bboxes)
+    , patch_bbox_rtree(pack_rtree(patch_boxes))
   {}
 
   template <int dim, int spacedim>
@@ -22,11 +36,18 @@ namespace fdl
   TriaIntersectionPredicate<dim, spacedim>::operator()(
     const typename Triangulation<dim, spacedim>::cell_iterator &cell) const
   {
-    const auto cell_bbox = cell->bounding_box();
-    for (const auto &bbox : patch_boxes)
-      if (intersects(cell_bbox, bbox))
-        return true;
-    return false;
+    return intersects_any(patch_bbox_rtree, cell->bounding_box());
+  }
+
+  template <int dim, int spacedim>
+  void
+  TriaIntersectionPredicate<dim, spacedim>::evaluate(
+    const ArrayView<const cell_iterator> &cells,
+    std::vector<unsigned char>           &mask) const
+  {
+    mask.resize(cells.size());
+    for (std::size_t i = 0; i < cells.size(); ++i)
+      mask[i] = intersects_any(patch_bbox_rtree, cells[i]->bounding_box());
   }
 
   template <int dim, int spacedim>
@@ -35,9 +56,32 @@ namespace fdl
     const std::vector<BoundingBox<spacedim, float>>      &patch_bboxes,
     const parallel::shared::Triangulation<dim, spacedim> &tria)
     : tria(&tria)
-    , active_cell_bboxes(a_cell_bboxes)
     , patch_bbox_rtree(pack_rtree(patch_bboxes))
-  {}
+  {
+    Assert(a_cell_bboxes.size() == tria.n_active_cells(),
+           ExcMessage("There should be a bbox for each active cell"));
+    // Work from the finest level up so that all children are done first
+    level_cell_bboxes.resize(tria.n_levels());
+    for (int level_n = int(tria.n_levels()) - 1; level_n >= 0; --level_n)
+      {
+        level_cell_bboxes[level_n].resize(tria.n_cells(level_n));
+        for (const auto &cell : tria.cell_iterators_on_level(level_n))
+          {
+            BoundingBox<spacedim, float> &bbox =
+              level_cell_bboxes[level_n][cell->index()];
+            if (cell->is_active())
+              bbox = a_cell_bboxes[cell->active_cell_index()];
+            else
+              {
+                bbox = level_cell_bboxes[level_n + 1][cell->child_index(0)];
+                for (unsigned int child_n = 1; child_n < cell->n_children();
+                     ++child_n)
+                  bbox.merge_with(
+                    level_cell_bboxes[level_n + 1][cell->child_index(child_n)]);
+              }
+          }
+      }
+  }
 
   template <int dim, int spacedim>
   bool
@@ -49,26 +93,22 @@ namespace fdl
                       "provided Triangulation"));
 
     auto intersects_any_patch = [&](const auto &bbox)
-    {
-      // avoid allocating by setting to true once we have an intersection.
-      // AFAICT there is no way to instruct boost to stop at one.
-      bool result   = false;
-      namespace bgi = boost::geometry::index;
-      patch_bbox_rtree.query(bgi::intersects(bbox),
-                             boost::make_function_output_iterator(
-                               [&](const auto &) { result = true; }));
-      return result;
-    };
+    { return intersects_any(patch_bbox_rtree, bbox); };
     // If the cell is active check its bbox:
     if (cell->is_active())
       {
-        AssertIndexRange(cell->active_cell_index(), active_cell_bboxes.size());
+        AssertIndexRange(cell->level(), level_cell_bboxes.size());
         return intersects_any_patch(
-          active_cell_bboxes[cell->active_cell_index()]);
+          level_cell_bboxes[cell->level()][cell->index()]);
       }
     // Otherwise see if it has a descendant that intersects:
     else if (cell->has_children())
       {
+        AssertIndexRange(cell->level(), level_cell_bboxes.size());
+        if (!intersects_any_patch(
+              level_cell_bboxes[cell->level()][cell->index()]))
+          return false;
+
         const auto n_children             = cell->n_children();
         bool       has_intersecting_child = false;
         for (unsigned int child_n = 0; child_n < n_children; ++child_n)
@@ -91,6 +131,59 @@ namespace fdl
     return false;
   }
 
+  template <int dim, int spacedim>
+  void
+  BoxIntersectionPredicate<dim, spacedim>::evaluate(
+    const ArrayView<const cell_iterator> &cells,
+    std::vector<unsigned char>           &mask) const
+  {
+    mask.clear();
+    mask.resize(cells.size(), 0);
+
+    // Like operator(), a cell intersects if it is active and its bbox
+    // intersects a patch or if any of its descendants intersect. Do this
+    // breadth-first for all cells together: each candidate is either an
+    // input cell or a descendant of one, whose index we store in owners.
+    std::vector<cell_iterator> candidates(cells.begin(), cells.end());
+    std::vector<std::size_t>   owners(cells.size());
+    std::iota(owners.begin(), owners.end(), std::size_t(0));
+    std::vector<cell_iterator> next_candidates;
+    std::vector<std::size_t>   next_owners;
+    while (candidates.size() > 0)
+      {
+        next_candidates.clear();
+        next_owners.clear();
+        for (std::size_t i = 0; i < candidates.size(); ++i)
+          {
+            // Stop as soon as one descendant intersects
+            if (mask[owners[i]])
+              continue;
+            const cell_iterator &cell = candidates[i];
+            Assert(&cell->get_triangulation() == tria,
+                   ExcMessage("only valid for inputs constructed from the "
+                              "originally provided Triangulation"));
+            AssertIndexRange(cell->level(), level_cell_bboxes.size());
+            // For active cells this is the cell's own bbox
+            const BoundingBox<spacedim, float> &bbox =
+              level_cell_bboxes[cell->level()][cell->index()];
+            if (!intersects_any(patch_bbox_rtree, bbox))
+              continue;
+
+            if (cell->is_active())
+              mask[owners[i]] = 1;
+            else
+              for (unsigned int child_n = 0; child_n < cell->n_children();
+                   ++child_n)
+                {
+                  next_candidates.push_back(cell->child(child_n));
+                  next_owners.push_back(owners[i]);
+                }
+          }
+        std::swap(candidates, next_candidates);
+        std::swap(owners, next_owners);
+      }
+  }
+
   template class TriaIntersectionPredicate<1, 2>;
   template class TriaIntersectionPredicate<1, 3>;
   template class TriaIntersectionPredicate<2, 2>;
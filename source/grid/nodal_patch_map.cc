@@ -1,9 +1,16 @@
 #include <fiddle/grid/box_utilities.h>
 #include <fiddle/grid/nodal_patch_map.h>
 
+#include <deal.II/base/memory_consumption.h>
+
 #include <deal.II/numerics/rtree.h>
 
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <numeric>
 
 namespace fdl
 {
@@ -37,7 +44,8 @@ namespace fdl
              "There should be N * spacedim entries in nodal_coordinates"));
     const std::size_t n_nodes = nodal_coordinates.size() / spacedim;
 
-    this->patches = patches;
+    this->patches      = patches;
+    this->patch_bboxes = patch_bboxes;
     patch_dof_indices.resize(0);
     for (std::size_t i = 0; i < patches.size(); ++i)
       patch_dof_indices.emplace_back(
@@ -89,6 +97,263 @@ namespace fdl
 
     for (IndexSet &index_set : patch_dof_indices)
       index_set.compress();
+    setup_points(nodal_coordinates);
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  NodalPatchMap<dim, spacedim>::update(
+    const std::vector<tbox::Pointer<hier::Patch<spacedim>>> &patches,
+    const std::vector<std::vector<BoundingBox<spacedim>>>   &patch_bboxes,
+    const Vector<double> &old_nodal_coordinates,
+    const Vector<double> &nodal_coordinates)
+  {
+    AssertDimension(patches.size(), patch_bboxes.size());
+    AssertDimension(old_nodal_coordinates.size(), nodal_coordinates.size());
+    Assert(nodal_coordinates.size() % spacedim == 0,
+           ExcMessage(
+             "There should be N * spacedim entries in nodal_coordinates"));
+    const std::size_t n_nodes = nodal_coordinates.size() / spacedim;
+
+    // We can only reuse the present assignment if the boxes are the same
+    bool same_boxes = patches.size() != 0 &&
+                      patches.size() == this->patches.size() &&
+                      patch_dof_indices.size() == patches.size() &&
+                      patch_dof_indices[0].size() == nodal_coordinates.size();
+    for (std::size_t i = 0; same_boxes && i < patches.size(); ++i)
+      {
+        same_boxes = patch_bboxes[i].size() == this->patch_bboxes[i].size();
+        for (std::size_t j = 0; same_boxes && j < patch_bboxes[i].size(); ++j)
+          same_boxes = patch_bboxes[i][j].get_boundary_points() ==
+                       this->patch_bboxes[i][j].get_boundary_points();
+      }
+    if (!same_boxes)
+      {
+        reinit(patches, patch_bboxes, nodal_coordinates);
+        return n_nodes;
+      }
+    this->patches = patches;
+
+    // reinit() adds each node to every patch with a box containing it, so
+    // levels do not matter here
+    std::vector<std::size_t>           box_patch_indices;
+    std::vector<BoundingBox<spacedim>> all_bboxes;
+    for (std::size_t i = 0; i < patches.size(); ++i)
+      for (const auto &bbox : patch_bboxes[i])
+        {
+          box_patch_indices.push_back(i);
+          all_bboxes.push_back(bbox);
+        }
+    const auto rtree = pack_rtree_of_indices(all_bboxes);
+    const auto find_patches = [&](const Vector<double>     &coordinates,
+                                  const std::size_t         node_n,
+                                  std::vector<std::size_t> &node_patches)
+    {
+      Point<spacedim> node;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        node[d] = coordinates[spacedim * node_n + d];
+
+      node_patches.clear();
+      namespace bgi = boost::geometry::index;
+      for (const std::size_t box_n :
+           rtree | bgi::adaptors::queried(bgi::intersects(node)))
+        {
+          AssertIndexRange(box_n, box_patch_indices.size());
+          node_patches.push_back(box_patch_indices[box_n]);
+        }
+      std::sort(node_patches.begin(), node_patches.end());
+      node_patches.erase(std::unique(node_patches.begin(), node_patches.end()),
+                         node_patches.end());
+    };
+
+    std::vector<IndexSet> removed_dofs(patches.size(),
+                                       IndexSet(nodal_coordinates.size()));
+    std::vector<IndexSet> added_dofs(patches.size(),
+                                     IndexSet(nodal_coordinates.size()));
+    std::vector<std::size_t> old_patches, new_patches, changed_patches;
+    std::size_t              n_moved_nodes = 0;
+    for (std::size_t node_n = 0; node_n < n_nodes; ++node_n)
+      {
+        bool moved = false;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          moved = moved || old_nodal_coordinates[spacedim * node_n + d] !=
+                             nodal_coordinates[spacedim * node_n + d];
+        if (!moved)
+          continue;
+
+        find_patches(old_nodal_coordinates, node_n, old_patches);
+        find_patches(nodal_coordinates, node_n, new_patches);
+        if (old_patches == new_patches)
+          continue;
+
+        ++n_moved_nodes;
+        const auto dof_begin = spacedim * node_n;
+        changed_patches.clear();
+        std::set_difference(old_patches.begin(),
+                            old_patches.end(),
+                            new_patches.begin(),
+                            new_patches.end(),
+                            std::back_inserter(changed_patches));
+        for (const std::size_t patch_n : changed_patches)
+          removed_dofs[patch_n].add_range(dof_begin, dof_begin + spacedim);
+        changed_patches.clear();
+        std::set_difference(new_patches.begin(),
+                            new_patches.end(),
+                            old_patches.begin(),
+                            old_patches.end(),
+                            std::back_inserter(changed_patches));
+        for (const std::size_t patch_n : changed_patches)
+          added_dofs[patch_n].add_range(dof_begin, dof_begin + spacedim);
+      }
+
+    for (std::size_t patch_n = 0; patch_n < patches.size(); ++patch_n)
+      {
+        if (removed_dofs[patch_n].n_elements() != 0)
+          patch_dof_indices[patch_n].subtract_set(removed_dofs[patch_n]);
+        if (added_dofs[patch_n].n_elements() != 0)
+          patch_dof_indices[patch_n].add_indices(added_dofs[patch_n]);
+        patch_dof_indices[patch_n].compress();
+      }
+    setup_points(nodal_coordinates);
+
+    return n_moved_nodes;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  NodalPatchMap<dim, spacedim>::setup_points(
+    const Vector<double> &nodal_coordinates)
+  {
+    point_node_offsets.clear();
+    point_nodes.clear();
+    patch_point_indices.clear();
+    const std::size_t n_nodes = nodal_coordinates.size() / spacedim;
+    if (n_nodes == 0)
+      return;
+
+    // Sort the nodes by their coordinates, rounded to the tolerance, so that
+    // coincident nodes are adjacent. This may miss a few pairs of nodes which
+    // are within the tolerance of each other but round differently, which is
+    // harmless.
+    coincidence_tolerance =
+      1e-12 * std::max(nodal_coordinates.linfty_norm(),
+                       std::numeric_limits<double>::min());
+    std::vector<std::array<double, spacedim>> keys(n_nodes);
+    for (std::size_t node_n = 0; node_n < n_nodes; ++node_n)
+      for (unsigned int d = 0; d < spacedim; ++d)
+        keys[node_n][d] = std::round(nodal_coordinates[spacedim * node_n + d] /
+                                     coincidence_tolerance);
+    std::vector<types::global_dof_index> order(n_nodes);
+    std::iota(order.begin(), order.end(), types::global_dof_index(0));
+    std::stable_sort(order.begin(),
+                     order.end(),
+                     [&](const types::global_dof_index a,
+                         const types::global_dof_index b)
+                     { return keys[a] < keys[b]; });
+
+    const auto invalid = numbers::invalid_dof_index;
+    std::vector<types::global_dof_index> node_to_group(n_nodes);
+    types::global_dof_index              n_groups = 0;
+    for (std::size_t i = 0; i < n_nodes; ++i)
+      {
+        if (i != 0 && keys[order[i]] != keys[order[i - 1]])
+          ++n_groups;
+        node_to_group[order[i]] = n_groups;
+      }
+    ++n_groups;
+    if (n_groups == n_nodes)
+      return;
+
+    // Number the points in the order of their first nodes so that points
+    // retain the locality of the nodes.
+    std::vector<types::global_dof_index> group_to_point(n_groups, invalid);
+    std::vector<types::global_dof_index> node_to_point(n_nodes);
+    point_node_offsets.resize(n_groups + 1, 0);
+    types::global_dof_index n_points = 0;
+    for (std::size_t node_n = 0; node_n < n_nodes; ++node_n)
+      {
+        auto &point_n = group_to_point[node_to_group[node_n]];
+        if (point_n == invalid)
+          point_n = n_points++;
+        node_to_point[node_n] = point_n;
+        ++point_node_offsets[point_n + 1];
+      }
+    std::partial_sum(point_node_offsets.begin(),
+                     point_node_offsets.end(),
+                     point_node_offsets.begin());
+    point_nodes.resize(n_nodes);
+    std::vector<types::global_dof_index> next(point_node_offsets.begin(),
+                                              point_node_offsets.end() - 1);
+    for (std::size_t node_n = 0; node_n < n_nodes; ++node_n)
+      point_nodes[next[node_to_point[node_n]]++] = node_n;
+
+    std::vector<types::global_dof_index> patch_points;
+    for (const IndexSet &dofs : patch_dof_indices)
+      {
+        patch_points.clear();
+        for (auto it = dofs.begin_intervals(); it != dofs.end_intervals(); ++it)
+          {
+            const auto nodes_begin = *it->begin() / spacedim;
+            const auto nodes_end =
+              nodes_begin + (it->end() - it->begin()) / spacedim;
+            for (auto node_n = nodes_begin; node_n < nodes_end; ++node_n)
+              patch_points.push_back(node_to_point[node_n]);
+          }
+        std::sort(patch_points.begin(), patch_points.end());
+        patch_point_indices.emplace_back(n_points);
+        patch_point_indices.back().add_indices(
+          patch_points.begin(),
+          std::unique(patch_points.begin(), patch_points.end()));
+        patch_point_indices.back().compress();
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  bool
+  NodalPatchMap<dim, spacedim>::has_coincident_nodes(
+    const Vector<double> &nodal_coordinates) const
+  {
+    if (point_node_offsets.size() == 0 ||
+        nodal_coordinates.size() != point_nodes.size() * spacedim)
+      return false;
+
+    for (std::size_t point_n = 0; point_n + 1 < point_node_offsets.size();
+         ++point_n)
+      {
+        const auto first = point_nodes[point_node_offsets[point_n]];
+        for (auto i = point_node_offsets[point_n] + 1;
+             i < point_node_offsets[point_n + 1];
+             ++i)
+          for (unsigned int d = 0; d < spacedim; ++d)
+            if (std::abs(nodal_coordinates[spacedim * point_nodes[i] + d] -
+                         nodal_coordinates[spacedim * first + d]) >
+                coincidence_tolerance)
+              return false;
+      }
+    return true;
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  NodalPatchMap<dim, spacedim>::memory_consumption() const
+  {
+    std::size_t result =
+      patches.capacity() * sizeof(patches[0]) +
+      MemoryConsumption::memory_consumption(patch_dof_indices) +
+      MemoryConsumption::memory_consumption(point_node_offsets) +
+      MemoryConsumption::memory_consumption(point_nodes) +
+      MemoryConsumption::memory_consumption(patch_point_indices);
+    for (const auto &bboxes : patch_bboxes)
+      result += bboxes.capacity() * sizeof(BoundingBox<spacedim>);
+    return result;
   }
 
 
@@ -1,5 +1,7 @@
 #include <fiddle/grid/overlap_tria.h>
 
+#include <deal.II/base/memory_consumption.h>
+
 #include <deal.II/grid/tria_description.h>
 
 #include <algorithm>
@@ -11,9 +13,10 @@ namespace fdl
   template <int dim, int spacedim>
   OverlapTriangulation<dim, spacedim>::OverlapTriangulation(
     const parallel::shared::Triangulation<dim, spacedim> &shared_tria,
-    const IntersectionPredicate<dim, spacedim>           &predicate)
+    const IntersectionPredicate<dim, spacedim>           &predicate,
+    const ExecutionPolicy                                &execution_policy)
   {
-    reinit(shared_tria, predicate);
+    reinit(shared_tria, predicate, execution_policy);
   }
 
 
@@ -28,15 +31,134 @@ namespace fdl
 
 
   template <int dim, int spacedim>
-  void
+  bool
   OverlapTriangulation<dim, spacedim>::reinit(
     const parallel::shared::Triangulation<dim, spacedim> &shared_tria,
-    const IntersectionPredicate<dim, spacedim>           &predicate)
+    const IntersectionPredicate<dim, spacedim>           &predicate,
+    const ExecutionPolicy                                &execution_policy)
   {
+    this->execution_policy = execution_policy;
+    // Keep the current cells if the predicate selects the same ones as before
+    if (native_tria == &shared_tria && this->n_active_cells() > 0)
+      {
+        bool same_cells = has_same_native_cells(predicate);
+        // Cell indices may be reused if the native Triangulation was coarsened
+        // and refined (and the native vertices may have moved), so make sure
+        // the cells themselves are the same too
+        for (auto cell = this->begin(); same_cells && cell != this->end();
+             ++cell)
+          {
+            const auto          pair = native_cells[cell->user_index()];
+            const cell_iterator native_cell(native_tria,
+                                            pair.first,
+                                            pair.second);
+            same_cells = cell->n_vertices() == native_cell->n_vertices();
+            for (const auto &index : cell->vertex_indices())
+              same_cells = same_cells &&
+                           cell->vertex(index) == native_cell->vertex(index);
+          }
+
+        if (same_cells)
+          return false;
+      }
+
     // todo - clear signals, etc. if there is a new shared tria
     native_tria = &shared_tria;
 
     reinit_overlapping_tria(predicate);
+    return true;
+  }
+
+
+
+  template <int dim, int spacedim>
+  bool
+  OverlapTriangulation<dim, spacedim>::has_same_native_cells(
+    const IntersectionPredicate<dim, spacedim> &predicate) const
+  {
+    std::vector<std::pair<int, int>> new_native_cells =
+      compute_native_cells(predicate);
+    std::vector<std::pair<int, int>> old_native_cells = native_cells;
+    std::sort(new_native_cells.begin(), new_native_cells.end());
+    std::sort(old_native_cells.begin(), old_native_cells.end());
+    return new_native_cells == old_native_cells;
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::vector<std::pair<int, int>>
+  OverlapTriangulation<dim, spacedim>::compute_native_cells(
+    const IntersectionPredicate<dim, spacedim> &predicate) const
+  {
+    // This follows the same steps as reinit_overlapping_tria(): find the
+    // coarsest level with an intersecting active cell, take the intersecting
+    // cells on that level, and then take all children of each intersecting
+    // cell.
+    std::vector<std::pair<int, int>> result;
+    std::vector<cell_iterator>       level_cells;
+    std::vector<cell_iterator>       candidates;
+    std::vector<unsigned char>       mask;
+    for (unsigned int level_n = 0; level_n < native_tria->n_levels(); ++level_n)
+      {
+        candidates.clear();
+        for (const auto &cell :
+             native_tria->active_cell_iterators_on_level(level_n))
+          candidates.push_back(cell);
+        evaluate_predicate(predicate, candidates, mask);
+        if (std::find(mask.begin(), mask.end(), 1) != mask.end())
+          {
+            // If every cell on the level is active then we already have the
+            // mask for all of them
+            if (candidates.size() != native_tria->n_cells(level_n))
+              {
+                candidates.clear();
+                for (const auto &cell :
+                     native_tria->cell_iterators_on_level(level_n))
+                  candidates.push_back(cell);
+                evaluate_predicate(predicate, candidates, mask);
+              }
+            for (std::size_t i = 0; i < candidates.size(); ++i)
+              if (mask[i])
+                level_cells.push_back(candidates[i]);
+            break;
+          }
+      }
+
+    if (level_cells.size() == 0)
+      {
+        // Same special case as reinit_overlapping_tria()
+        const auto cell =
+          native_tria->begin_active(native_tria->n_levels() - 1);
+        result.emplace_back(cell->level(), cell->index());
+        return result;
+      }
+
+    std::vector<cell_iterator> next_level_cells;
+    bool                       first_level = true;
+    while (level_cells.size() > 0)
+      {
+        next_level_cells.clear();
+        // The cells on the first level were all selected by the predicate
+        // above
+        if (first_level)
+          mask.assign(level_cells.size(), 1);
+        else
+          evaluate_predicate(predicate, level_cells, mask);
+        first_level = false;
+        for (std::size_t i = 0; i < level_cells.size(); ++i)
+          {
+            const cell_iterator &cell = level_cells[i];
+            result.emplace_back(cell->level(), cell->index());
+            if (cell->has_children() && mask[i])
+              for (unsigned int child_n = 0; child_n < cell->n_children();
+                   ++child_n)
+                next_level_cells.push_back(cell->child(child_n));
+          }
+        std::swap(level_cells, next_level_cells);
+      }
+
+    return result;
   }
 
 
@@ -47,38 +169,51 @@ namespace fdl
     const IntersectionPredicate<dim, spacedim> &predicate)
   {
     native_cells.clear();
-    native_cell_ids.clear();
-    native_cell_subdomain_ids.clear();
     this->clear();
 
     const auto native_manifold_ids = native_tria->get_manifold_ids();
 
     std::vector<CellData<dim>> cells;
     unsigned int               coarsest_level_n = numbers::invalid_unsigned_int;
+    // Predicates are evaluated for all cells in a level at once
+    std::vector<cell_iterator> candidates;
+    std::vector<unsigned char> mask;
     for (unsigned int level_n = 0; level_n < native_tria->n_levels(); ++level_n)
       {
         // We only need to start looking for intersections if the level
         // contains an active cell intersecting the patches.
+        candidates.clear();
         for (const auto &cell :
              native_tria->active_cell_iterators_on_level(level_n))
+          candidates.push_back(cell);
+        evaluate_predicate(predicate, candidates, mask);
+        if (std::find(mask.begin(), mask.end(), 1) != mask.end())
           {
-            if (predicate(cell))
-              {
-                coarsest_level_n = level_n;
-                // we need to break out of two loops so jump
-                goto found_coarsest_level;
-              }
+            coarsest_level_n = level_n;
+            break;
           }
       }
 
-  found_coarsest_level:
-    if (coarsest_level_n != numbers::invalid_unsigned_int)
+    const bool has_intersections =
+      coarsest_level_n != numbers::invalid_unsigned_int;
+    if (has_intersections)
       {
-        for (const auto &cell :
-             native_tria->cell_iterators_on_level(coarsest_level_n))
-          if (predicate(cell))
+        // If every cell on the level is active (e.g., if the native
+        // Triangulation is uniformly refined) then we already have the mask
+        // for all of them
+        if (candidates.size() != native_tria->n_cells(coarsest_level_n))
+          {
+            candidates.clear();
+            for (const auto &cell :
+                 native_tria->cell_iterators_on_level(coarsest_level_n))
+              candidates.push_back(cell);
+            evaluate_predicate(predicate, candidates, mask);
+          }
+        for (std::size_t i = 0; i < candidates.size(); ++i)
+          if (mask[i])
             {
-              CellData<dim> cell_data(cell->n_vertices());
+              const cell_iterator &cell = candidates[i];
+              CellData<dim>        cell_data(cell->n_vertices());
               cell_data.manifold_id = cell->manifold_id();
               // Temporarily refer to native cells with the material id
               cell_data.material_id = add_native_cell(cell);
@@ -185,10 +320,22 @@ namespace fdl
         // If a native cell is refined then mark the equivalent overlap cell
         // for refinement.
         bool do_refinement = false;
+        candidates.clear();
+        for (const auto &cell : this->cell_iterators_on_level(level_n))
+          candidates.push_back(get_native_cell(cell));
+        // The coarsest cells were selected by the predicate above, unless we
+        // added a placeholder cell which does not intersect anything. Hence,
+        // if no selected native cell has children, the Triangulation is
+        // complete without evaluating the predicate again.
+        if (level_n == 0)
+          mask.assign(candidates.size(), has_intersections);
+        else
+          evaluate_predicate(predicate, candidates, mask);
+        std::size_t cell_n = 0;
         for (auto &cell : this->cell_iterators_on_level(level_n))
           {
-            const auto native_cell = get_native_cell(cell);
-            if (predicate(native_cell))
+            const auto native_cell = candidates[cell_n];
+            if (mask[cell_n++])
               {
                 cell->set_subdomain_id(0);
                 if (native_cell->has_children())
@@ -242,6 +389,57 @@ namespace fdl
         if (level_n == this->n_levels() - 1)
           break;
       }
+
+    native_cells.shrink_to_fit();
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  OverlapTriangulation<dim, spacedim>::evaluate_predicate(
+    const IntersectionPredicate<dim, spacedim> &predicate,
+    const std::vector<cell_iterator>           &cells,
+    std::vector<unsigned char>                 &mask) const
+  {
+    if (execution_policy.is_serial())
+      {
+        predicate.evaluate(make_array_view(cells), mask);
+        return;
+      }
+
+    // Predicates typically check every descendant of a cell, so each range
+    // of cells (i.e., the subtrees below them) is evaluated independently.
+    // Testing a single cell is cheap so don't bother with small ranges.
+    mask.resize(cells.size());
+    execution_policy.apply_to_ranges(
+      cells.size(),
+      [&](const std::size_t begin, const std::size_t end)
+      {
+        std::vector<unsigned char> range_mask;
+        predicate.evaluate(make_array_view(cells, begin, end - begin),
+                           range_mask);
+        Assert(range_mask.size() == end - begin, ExcFDLInternalError());
+        std::copy(range_mask.begin(), range_mask.end(), mask.begin() + begin);
+      },
+      128);
+  }
+
+  template <int dim, int spacedim>
+  std::size_t
+  OverlapTriangulation<dim, spacedim>::memory_consumption() const
+  {
+    return dealii::Triangulation<dim, spacedim>::memory_consumption() +
+           native_cell_memory_consumption();
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  OverlapTriangulation<dim, spacedim>::native_cell_memory_consumption() const
+  {
+    return MemoryConsumption::memory_consumption(native_cells);
   }
 
   template class OverlapTriangulation<NDIM - 1, NDIM>;
@@ -0,0 +1,378 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/grid/patch_intersection_map.h>
+
+#include <fiddle/interaction/interaction_utilities.h>
+
+#include <deal.II/base/parallel.h>
+
+#include <CartesianPatchGeometry.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <set>
+#include <vector>
+
+namespace fdl
+{
+  using namespace dealii;
+  using namespace SAMRAI;
+
+  namespace internal
+  {
+    template <int dim, int spacedim>
+    void
+    split_cell_into_simplices(
+      const ReferenceCell                               &reference_cell,
+      const ArrayView<const Point<spacedim>>            &vertices,
+      std::vector<std::array<Point<spacedim>, dim + 1>> &simplices,
+      std::vector<std::array<Point<dim>, dim + 1>>      &unit_simplices)
+    {
+      simplices.clear();
+      unit_simplices.clear();
+      if (reference_cell == ReferenceCells::get_simplex<dim>())
+        {
+          AssertDimension(vertices.size(), dim + 1);
+          simplices.emplace_back();
+          unit_simplices.emplace_back();
+          for (unsigned int v = 0; v < dim + 1; ++v)
+            {
+              simplices.back()[v]      = vertices[v];
+              unit_simplices.back()[v] = reference_cell.template vertex<dim>(v);
+            }
+        }
+      else if constexpr (dim == 2)
+        {
+          AssertThrow(reference_cell == ReferenceCells::Quadrilateral,
+                      ExcFDLNotImplemented());
+          AssertDimension(vertices.size(), 4);
+          // Split along the diagonal between vertices 0 and 3
+          for (const std::array<unsigned int, 3> &triangle :
+               {std::array<unsigned int, 3>{{0, 1, 3}},
+                std::array<unsigned int, 3>{{0, 3, 2}}})
+            {
+              simplices.emplace_back();
+              unit_simplices.emplace_back();
+              for (unsigned int v = 0; v < 3; ++v)
+                {
+                  simplices.back()[v] = vertices[triangle[v]];
+                  unit_simplices.back()[v] =
+                    reference_cell.template vertex<dim>(triangle[v]);
+                }
+            }
+        }
+      else
+        AssertThrow(false, ExcFDLNotImplemented());
+    }
+
+
+
+    template <int dim, int spacedim>
+    std::pair<Point<dim>, double>
+    locate_intersection(
+      const std::vector<std::array<Point<spacedim>, dim + 1>> &simplices,
+      const std::vector<std::array<Point<dim>, dim + 1>>      &unit_simplices,
+      const Point<spacedim>                                   &point,
+      const unsigned int                                       axis,
+      const Tensor<1, spacedim>                               &dx)
+    {
+      static_assert(dim + 1 == spacedim, "Only implemented for codim = 1");
+      AssertDimension(simplices.size(), unit_simplices.size());
+      Assert(simplices.size() > 0, ExcMessage("There should be a simplex"));
+
+      // Find the simplex whose barycentric coordinates of the point are the
+      // least negative (they are all nonnegative, up to roundoff, for the
+      // simplex which was intersected)
+      double      best_min_coordinate = std::numeric_limits<double>::lowest();
+      std::size_t best_simplex        = 0;
+      std::array<double, dim + 1> best_coordinates{};
+      for (std::size_t simplex_n = 0; simplex_n < simplices.size();
+           ++simplex_n)
+        {
+          const auto &simplex = simplices[simplex_n];
+          // Solve the normal equations for point - v0 = sum_i c_i (v_i - v0)
+          Tensor<2, dim> gram;
+          Tensor<1, dim> rhs;
+          for (unsigned int i = 0; i < dim; ++i)
+            {
+              const Tensor<1, spacedim> e_i = simplex[i + 1] - simplex[0];
+              rhs[i]                        = e_i * (point - simplex[0]);
+              for (unsigned int j = 0; j < dim; ++j)
+                gram[i][j] = e_i * (simplex[j + 1] - simplex[0]);
+            }
+          const Tensor<1, dim> c = invert(gram) * rhs;
+
+          std::array<double, dim + 1> coordinates;
+          coordinates[0] = 1.0;
+          for (unsigned int i = 0; i < dim; ++i)
+            {
+              coordinates[i + 1] = c[i];
+              coordinates[0] -= c[i];
+            }
+          const double min_coordinate =
+            *std::min_element(coordinates.begin(), coordinates.end());
+          if (min_coordinate > best_min_coordinate)
+            {
+              best_min_coordinate = min_coordinate;
+              best_simplex        = simplex_n;
+              best_coordinates    = coordinates;
+            }
+        }
+
+      Point<dim> unit_point;
+      for (unsigned int v = 0; v < dim + 1; ++v)
+        unit_point += best_coordinates[v] * unit_simplices[best_simplex][v];
+
+      // Each intersection along an axis represents the area of a cell face
+      // orthogonal to that axis. Dividing by the one-norm of the unit normal
+      // makes the sum over all axes a consistent surface quadrature rule.
+      const auto         &simplex = simplices[best_simplex];
+      Tensor<1, spacedim> normal;
+      if constexpr (dim == 1)
+        {
+          normal[0] = simplex[0][1] - simplex[1][1];
+          normal[1] = simplex[1][0] - simplex[0][0];
+        }
+      else
+        normal =
+          cross_product_3d(simplex[1] - simplex[0], simplex[2] - simplex[0]);
+      normal /= normal.norm();
+
+      double weight = 1.0, normal_one_norm = 0.0;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        {
+          if (d != axis)
+            weight *= dx[d];
+          normal_one_norm += std::abs(normal[d]);
+        }
+
+      return std::make_pair(unit_point, weight / normal_one_norm);
+    }
+  } // namespace internal
+
+
+
+  template <int dim, int spacedim>
+  template <typename Number>
+  void
+  PatchIntersectionMap<dim, spacedim>::reinit(
+    const std::vector<tbox::Pointer<hier::Patch<spacedim>>> &patches,
+    const std::vector<BoundingBox<spacedim, Number>>        &cell_bboxes,
+    const DoFHandler<dim, spacedim> &position_dof_handler,
+    const Mapping<dim, spacedim>    &position_mapping,
+    const unsigned int               n_threads)
+  {
+    // Stencils may end one cell outside the patch box
+    patch_map.reinit(patches,
+                     1.0,
+                     position_dof_handler.get_triangulation(),
+                     cell_bboxes);
+    patch_intersections.clear();
+    patch_intersections.resize(patch_map.size());
+
+    auto compute_range = [&](const std::size_t begin, const std::size_t end)
+    {
+      // Scratch arrays used by all patches in this range
+      std::vector<std::array<Point<spacedim>, dim + 1>> simplices;
+      std::vector<std::array<Point<dim>, dim + 1>>      unit_simplices;
+      std::vector<Point<spacedim>>                      vertices;
+      std::vector<hier::Index<spacedim>>                candidates;
+      std::array<std::vector<double>, spacedim>         stencil_starts;
+      std::vector<unsigned char>                        hits;
+      std::vector<double>                               convex_coefficients;
+
+      for (std::size_t patch_n = begin; patch_n < end; ++patch_n)
+        {
+          auto       &intersections = patch_intersections[patch_n];
+          const auto &patch         = patch_map.get_patch(patch_n);
+          const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> pgeom =
+            patch->getPatchGeometry();
+          const hier::Box<spacedim> patch_box = patch->getBox();
+          for (unsigned int d = 0; d < spacedim; ++d)
+            {
+              intersections.dx[d] = pgeom->getDx()[d];
+              intersections.domain_x_lower[d] =
+                pgeom->getXLower()[d] - patch_box.lower(d) * pgeom->getDx()[d];
+            }
+          const Tensor<1, spacedim> &dx      = intersections.dx;
+          const Point<spacedim>     &x_lower = intersections.domain_x_lower;
+
+          // Keys (axis and then lower index) of the stencils which already
+          // have an intersection
+          std::set<std::array<int, spacedim + 1>> found_stencils;
+
+          const auto end_iter = patch_map.end(patch_n, position_dof_handler);
+          for (auto iter = patch_map.begin(patch_n, position_dof_handler);
+               iter != end_iter;
+               ++iter)
+            {
+              const auto cell            = *iter;
+              const auto mapped_vertices = position_mapping.get_vertices(cell);
+              vertices.assign(mapped_vertices.begin(), mapped_vertices.end());
+              internal::split_cell_into_simplices<dim, spacedim>(
+                cell->reference_cell(),
+                make_array_view(vertices),
+                simplices,
+                unit_simplices);
+
+              for (const auto &simplex : simplices)
+                {
+                  Point<spacedim> lower = simplex[0], upper = simplex[0];
+                  for (const Point<spacedim> &vertex : simplex)
+                    for (unsigned int d = 0; d < spacedim; ++d)
+                      {
+                        lower[d] = std::min(lower[d], vertex[d]);
+                        upper[d] = std::max(upper[d], vertex[d]);
+                      }
+
+                  for (unsigned int axis = 0; axis < spacedim; ++axis)
+                    {
+                      // Find the stencils in the patch which might intersect
+                      // the simplex. Stencils along the axis start at the
+                      // center of their lower cell and end at the center of
+                      // the upper cell.
+                      std::array<int, spacedim> i_lower, i_upper;
+                      std::size_t               n_candidates = 1;
+                      for (unsigned int d = 0; d < spacedim; ++d)
+                        {
+                          const double s_lower =
+                            (lower[d] - x_lower[d]) / dx[d] - 0.5;
+                          const double s_upper =
+                            (upper[d] - x_lower[d]) / dx[d] - 0.5;
+                          i_lower[d] = d == axis ?
+                                         int(std::ceil(s_lower - 1.0)) :
+                                         int(std::ceil(s_lower));
+                          i_upper[d] = int(std::floor(s_upper));
+                          i_lower[d] = std::max(i_lower[d], patch_box.lower(d));
+                          i_upper[d] = std::min(i_upper[d], patch_box.upper(d));
+                          if (i_upper[d] < i_lower[d])
+                            n_candidates = 0;
+                          else
+                            n_candidates *= i_upper[d] - i_lower[d] + 1;
+                        }
+                      if (n_candidates == 0)
+                        continue;
+
+                      candidates.resize(n_candidates);
+                      for (unsigned int d = 0; d < spacedim; ++d)
+                        stencil_starts[d].resize(n_candidates);
+                      for (std::size_t i = 0; i < n_candidates; ++i)
+                        {
+                          std::size_t flat_index = i;
+                          for (unsigned int d = 0; d < spacedim; ++d)
+                            {
+                              const int n_d = i_upper[d] - i_lower[d] + 1;
+                              candidates[i](d) =
+                                i_lower[d] + int(flat_index % n_d);
+                              flat_index /= n_d;
+                              stencil_starts[d][i] =
+                                x_lower[d] +
+                                (double(candidates[i](d)) + 0.5) * dx[d];
+                            }
+                        }
+
+                      std::array<ArrayView<const double>, spacedim> starts;
+                      for (unsigned int d = 0; d < spacedim; ++d)
+                        starts[d] = make_array_view(stencil_starts[d]);
+                      intersect_stencils_with_simplex<dim>(simplex,
+                                                           starts,
+                                                           dx[axis],
+                                                           axis,
+                                                           hits,
+                                                           convex_coefficients);
+
+                      for (std::size_t i = 0; i < n_candidates; ++i)
+                        {
+                          // The intersection functions also find
+                          // intersections behind the start of the stencil,
+                          // which belong to the next stencil down
+                          const double convex = convex_coefficients[i];
+                          if (!hits[i] || convex < 0.0 || convex >= 1.0)
+                            continue;
+
+                          std::array<int, spacedim + 1> key;
+                          key[0] = axis;
+                          for (unsigned int d = 0; d < spacedim; ++d)
+                            key[d + 1] = candidates[i](d);
+                          if (!found_stencils.insert(key).second)
+                            continue;
+
+                          intersections.lower_indices.emplace_back(
+                            candidates[i]);
+                          intersections.axes.push_back(axis);
+                          intersections.convex_coefficients.push_back(convex);
+                          intersections.cell_level.push_back(cell->level());
+                          intersections.cell_index.push_back(cell->index());
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    const std::size_t n_patches = patch_intersections.size();
+    if (n_threads <= 1 || n_patches <= 1)
+      compute_range(std::size_t(0), n_patches);
+    else
+      parallel::apply_to_subranges(
+        std::size_t(0),
+        n_patches,
+        compute_range,
+        static_cast<unsigned int>(
+          std::max<std::size_t>(1, n_patches / (4 * n_threads))));
+  }
+
+  // instantiations
+
+  template class PatchIntersectionMap<NDIM - 1, NDIM>;
+
+  template void
+  PatchIntersectionMap<NDIM - 1, NDIM>::reinit(
+    const std::vector<tbox::Pointer<hier::Patch<NDIM>>> &,
+    const std::vector<BoundingBox<NDIM, float>> &,
+    const DoFHandler<NDIM - 1, NDIM> &,
+    const Mapping<NDIM - 1, NDIM> &,
+    const unsigned int);
+
+  template void
+  PatchIntersectionMap<NDIM - 1, NDIM>::reinit(
+    const std::vector<tbox::Pointer<hier::Patch<NDIM>>> &,
+    const std::vector<BoundingBox<NDIM, double>> &,
+    const DoFHandler<NDIM - 1, NDIM> &,
+    const Mapping<NDIM - 1, NDIM> &,
+    const unsigned int);
+
+  template PatchIntersectionMap<NDIM - 1, NDIM>::PatchIntersectionMap(
+    const std::vector<tbox::Pointer<hier::Patch<NDIM>>> &,
+    const std::vector<BoundingBox<NDIM, float>> &,
+    const DoFHandler<NDIM - 1, NDIM> &,
+    const Mapping<NDIM - 1, NDIM> &,
+    const unsigned int);
+
+  template PatchIntersectionMap<NDIM - 1, NDIM>::PatchIntersectionMap(
+    const std::vector<tbox::Pointer<hier::Patch<NDIM>>> &,
+    const std::vector<BoundingBox<NDIM, double>> &,
+    const DoFHandler<NDIM - 1, NDIM> &,
+    const Mapping<NDIM - 1, NDIM> &,
+    const unsigned int);
+
+  namespace internal
+  {
+    template void
+    split_cell_into_simplices<NDIM - 1, NDIM>(
+      const ReferenceCell                            &reference_cell,
+      const ArrayView<const Point<NDIM>>             &vertices,
+      std::vector<std::array<Point<NDIM>, NDIM>>     &simplices,
+      std::vector<std::array<Point<NDIM - 1>, NDIM>> &unit_simplices);
+
+    template std::pair<Point<NDIM - 1>, double>
+    locate_intersection<NDIM - 1, NDIM>(
+      const std::vector<std::array<Point<NDIM>, NDIM>>     &simplices,
+      const std::vector<std::array<Point<NDIM - 1>, NDIM>> &unit_simplices,
+      const Point<NDIM>                                    &point,
+      const unsigned int                                    axis,
+      const Tensor<1, NDIM>                                &dx);
+  } // namespace internal
+} // namespace fdl
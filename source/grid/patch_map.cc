@@ -1,22 +1,62 @@
 #include <fiddle/grid/box_utilities.h>
 #include <fiddle/grid/patch_map.h>
 
+#include <deal.II/base/memory_consumption.h>
+
 #include <deal.II/numerics/rtree.h>
 
+#include <boost/iterator/function_output_iterator.hpp>
+
+#include <CartesianPatchGeometry.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+
 namespace fdl
 {
   using namespace dealii;
   using namespace SAMRAI;
 
+  namespace
+  {
+    /**
+     * Interleave the bits of the (nonnegative) cell indices in @p index to
+     * compute the position of that cell on a Morton curve. Indices are
+     * truncated to 64 / spacedim bits, which is far more than any patch
+     * needs.
+     */
+    template <int spacedim>
+    std::uint64_t
+    morton_code(const std::array<std::uint64_t, spacedim> &index)
+    {
+      constexpr unsigned int n_bits = 64 / spacedim;
+      std::uint64_t          code   = 0;
+      for (unsigned int bit = 0; bit < n_bits; ++bit)
+        for (unsigned int d = 0; d < spacedim; ++d)
+          code |= ((index[d] >> bit) & std::uint64_t(1))
+                  << (bit * spacedim + d);
+      return code;
+    }
+  } // namespace
+
   template <int dim, int spacedim>
   template <typename Number>
   PatchMap<dim, spacedim>::PatchMap(
     const std::vector<tbox::Pointer<hier::Patch<spacedim>>> &patches,
     const double                                      extra_ghost_cell_fraction,
     const Triangulation<dim, spacedim>               &tria,
-    const std::vector<BoundingBox<spacedim, Number>> &cell_bboxes)
+    const std::vector<BoundingBox<spacedim, Number>> &cell_bboxes,
+    const bool                                        morton_order_cells)
   {
-    reinit(patches, extra_ghost_cell_fraction, tria, cell_bboxes);
+    reinit(patches,
+           extra_ghost_cell_fraction,
+           tria,
+           cell_bboxes,
+           morton_order_cells);
   }
 
   template <int dim, int spacedim>
@@ -26,16 +66,24 @@ namespace fdl
     const std::vector<tbox::Pointer<hier::Patch<spacedim>>> &patches,
     const double                                      extra_ghost_cell_fraction,
     const Triangulation<dim, spacedim>               &tria,
-    const std::vector<BoundingBox<spacedim, Number>> &cell_bboxes)
+    const std::vector<BoundingBox<spacedim, Number>> &cell_bboxes,
+    const bool                                        morton_order_cells)
   {
-    this->tria    = &tria;
-    this->patches = patches;
+    this->tria                      = &tria;
+    this->patches                   = patches;
+    this->extra_ghost_cell_fraction = extra_ghost_cell_fraction;
+    this->morton_order_cells        = morton_order_cells;
     Assert(cell_bboxes.size() == tria.n_active_cells(),
            ExcMessage("each active cell should have a bounding box."));
 
-    const std::vector<BoundingBox<spacedim, Number>> patch_bboxes =
-      compute_patch_bboxes<spacedim, Number>(patches,
+    patch_bboxes =
+      compute_patch_bboxes<spacedim, double>(patches,
                                              extra_ghost_cell_fraction);
+    reference_cell_bboxes.resize(cell_bboxes.size());
+    for (std::size_t i = 0; i < cell_bboxes.size(); ++i)
+      reference_cell_bboxes[i].get_boundary_points() =
+        cell_bboxes[i].get_boundary_points();
+
     patch_level_cells.clear();
     patch_level_cells.resize(patches.size());
     for (unsigned int patch_n = 0; patch_n < patches.size(); ++patch_n)
@@ -49,8 +97,8 @@ namespace fdl
     const auto rtree = pack_rtree_of_indices(patch_bboxes);
     for (const auto &cell : tria.active_cell_iterators())
       {
-        const BoundingBox<spacedim, Number> &cell_bbox =
-          cell_bboxes[cell->active_cell_index()];
+        const BoundingBox<spacedim> &cell_bbox =
+          reference_cell_bboxes[cell->active_cell_index()];
 
         namespace bgi = boost::geometry::index;
         for (const std::size_t patch_n :
@@ -66,22 +114,350 @@ namespace fdl
       for (auto &cell_indices : level_cells)
         cell_indices.compress();
 
-    // update cummulative number of cells
+    cached_dof_handlers.clear();
+    patch_active_cell_indices.clear();
+    patch_dof_indices.clear();
+
     cummulative_n_cells.clear();
     cummulative_n_cells.resize(patches.size());
+    cell_order.clear();
+    cell_order.resize(patches.size());
+    expanded_cells.clear();
+    if (store_expanded_cells)
+      expanded_cells.resize(patches.size());
     for (unsigned int patch_n = 0; patch_n < patches.size(); ++patch_n)
       {
-        for (unsigned int level_n = 0; level_n < tria.n_levels(); ++level_n)
+        compute_cummulative_n_cells(patch_n);
+        if (morton_order_cells)
+          compute_cell_order(patch_n);
+        compute_expanded_cells(patch_n);
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  template <typename Number>
+  std::size_t
+  PatchMap<dim, spacedim>::update(
+    const std::vector<tbox::Pointer<hier::Patch<spacedim>>> &patches,
+    const std::vector<BoundingBox<spacedim, Number>>        &cell_bboxes)
+  {
+    Assert(tria, ExcMessage("The PatchMap must be initialized first."));
+    AssertThrow(cell_bboxes.size() == reference_cell_bboxes.size(),
+                ExcMessage("The number of cells should not change."));
+
+    // If the patches have moved then every cell needs to be checked again
+    const std::vector<BoundingBox<spacedim>> new_patch_bboxes =
+      compute_patch_bboxes<spacedim, double>(patches,
+                                             extra_ghost_cell_fraction);
+    bool same_patches = new_patch_bboxes.size() == patch_bboxes.size();
+    for (std::size_t patch_n = 0; same_patches && patch_n < patch_bboxes.size();
+         ++patch_n)
+      same_patches = new_patch_bboxes[patch_n].get_boundary_points() ==
+                     patch_bboxes[patch_n].get_boundary_points();
+    if (!same_patches)
+      {
+        const auto dof_handlers = cached_dof_handlers;
+        reinit(patches,
+               extra_ghost_cell_fraction,
+               *tria,
+               cell_bboxes,
+               morton_order_cells);
+        for (const DoFHandler<dim, spacedim> *dof_handler : dof_handlers)
+          cache_dof_indices(*dof_handler);
+        return cell_bboxes.size();
+      }
+    this->patches = patches;
+
+    // Cells whose new bounding box is inside the one we used to assign them
+    // to patches can only intersect fewer patches, so we keep them where they
+    // are. Hence this function may leave a cell on some extra patches, which
+    // is harmless since we still associate every cell with every patch its
+    // bounding box intersects.
+    const auto rtree = pack_rtree_of_indices(patch_bboxes);
+    // Cell indices, indexed by patch and then level number
+    using CellLists = std::vector<std::vector<std::vector<unsigned int>>>;
+    CellLists                removed_cells(patches.size());
+    CellLists                added_cells(patches.size());
+    std::vector<bool>        patch_changed(patches.size());
+    std::vector<std::size_t> old_patches, new_patches;
+    std::size_t              n_moved_cells = 0;
+    for (const auto &cell : tria->active_cell_iterators())
+      {
+        BoundingBox<spacedim> new_bbox;
+        new_bbox.get_boundary_points() =
+          cell_bboxes[cell->active_cell_index()].get_boundary_points();
+        BoundingBox<spacedim> &old_bbox =
+          reference_cell_bboxes[cell->active_cell_index()];
+        bool inside = true;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          inside = inside &&
+                   old_bbox.lower_bound(d) <= new_bbox.lower_bound(d) &&
+                   new_bbox.upper_bound(d) <= old_bbox.upper_bound(d);
+        if (inside)
+          continue;
+
+        ++n_moved_cells;
+        namespace bgi = boost::geometry::index;
+        old_patches.clear();
+        new_patches.clear();
+        rtree.query(bgi::intersects(old_bbox), std::back_inserter(old_patches));
+        rtree.query(bgi::intersects(new_bbox), std::back_inserter(new_patches));
+        std::sort(old_patches.begin(), old_patches.end());
+        std::sort(new_patches.begin(), new_patches.end());
+        // Record the patches in a but not in b
+        const auto record = [&](const std::vector<std::size_t> &a,
+                                const std::vector<std::size_t> &b,
+                                CellLists                      &cell_lists)
+        {
+          const auto add = [&](const std::size_t patch_n)
+          {
+            AssertIndexRange(patch_n, patches.size());
+            cell_lists[patch_n].resize(tria->n_levels());
+            cell_lists[patch_n][cell->level()].push_back(cell->index());
+            patch_changed[patch_n] = true;
+          };
+          std::set_difference(a.begin(),
+                              a.end(),
+                              b.begin(),
+                              b.end(),
+                              boost::make_function_output_iterator(add));
+        };
+        record(old_patches, new_patches, removed_cells);
+        record(new_patches, old_patches, added_cells);
+        old_bbox = new_bbox;
+      }
+
+    for (unsigned int patch_n = 0; patch_n < patches.size(); ++patch_n)
+      if (patch_changed[patch_n])
+        {
+          auto &level_cells = patch_level_cells[patch_n];
+          for (unsigned int level_n = 0;
+               level_n < removed_cells[patch_n].size();
+               ++level_n)
+            {
+              std::vector<unsigned int> &cells =
+                removed_cells[patch_n][level_n];
+              std::sort(cells.begin(), cells.end());
+              IndexSet removed(tria->n_cells(level_n));
+              removed.add_indices(cells.begin(), cells.end());
+              level_cells[level_n].subtract_set(removed);
+            }
+          for (unsigned int level_n = 0; level_n < added_cells[patch_n].size();
+               ++level_n)
+            {
+              std::vector<unsigned int> &cells = added_cells[patch_n][level_n];
+              std::sort(cells.begin(), cells.end());
+              level_cells[level_n].add_indices(cells.begin(), cells.end());
+              level_cells[level_n].compress();
+            }
+
+          compute_cummulative_n_cells(patch_n);
+          if (morton_order_cells)
+            compute_cell_order(patch_n);
+          compute_expanded_cells(patch_n);
+          compute_cached_indices(patch_n);
+        }
+
+    return n_moved_cells;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  PatchMap<dim, spacedim>::replace_patches(
+    const std::vector<tbox::Pointer<hier::Patch<spacedim>>> &patches)
+  {
+    const std::vector<BoundingBox<spacedim>> new_patch_bboxes =
+      compute_patch_bboxes<spacedim, double>(patches,
+                                             extra_ghost_cell_fraction);
+    AssertThrow(new_patch_bboxes.size() == patch_bboxes.size(),
+                ExcMessage("The number of patches should not change."));
+    for (std::size_t patch_n = 0; patch_n < patch_bboxes.size(); ++patch_n)
+      AssertThrow(new_patch_bboxes[patch_n].get_boundary_points() ==
+                    patch_bboxes[patch_n].get_boundary_points(),
+                  ExcMessage("The patches should have the same boxes."));
+    this->patches = patches;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  PatchMap<dim, spacedim>::compute_cummulative_n_cells(
+    const std::size_t patch_n)
+  {
+    cummulative_n_cells[patch_n].clear();
+    for (unsigned int level_n = 0; level_n < tria->n_levels(); ++level_n)
+      {
+        cummulative_n_cells[patch_n].push_back(
+          patch_level_cells[patch_n][level_n].n_elements());
+        if (level_n != 0)
+          cummulative_n_cells[patch_n].back() +=
+            cummulative_n_cells[patch_n][level_n - 1];
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  PatchMap<dim, spacedim>::compute_cell_order(const std::size_t patch_n)
+  {
+    const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> patch_geom =
+      patches[patch_n]->getPatchGeometry();
+    Assert(patch_geom, ExcMessage("Type mismatch"));
+    // Cells may be in the patch's ghost region so start counting at the lower
+    // corner of the patch's bounding box
+    const Point<spacedim> &lower =
+      patch_bboxes[patch_n].get_boundary_points().first;
+    const double *const dx = patch_geom->getDx();
+
+    std::vector<std::uint64_t> codes;
+    codes.reserve(cummulative_n_cells[patch_n].back());
+    for (unsigned int level_n = 0; level_n < tria->n_levels(); ++level_n)
+      for (const auto cell_index : patch_level_cells[patch_n][level_n])
+        {
+          const CellAccessor<dim, spacedim> cell(&*tria, level_n, cell_index);
+          const Point<spacedim> center =
+            reference_cell_bboxes[cell.active_cell_index()].center();
+          std::array<std::uint64_t, spacedim> index;
+          for (unsigned int d = 0; d < spacedim; ++d)
+            index[d] = std::uint64_t(
+              std::max(0.0, std::floor((center[d] - lower[d]) / dx[d])));
+          codes.push_back(morton_code<spacedim>(index));
+        }
+
+    cell_order[patch_n].resize(codes.size());
+    std::iota(cell_order[patch_n].begin(),
+              cell_order[patch_n].end(),
+              std::size_t(0));
+    std::stable_sort(cell_order[patch_n].begin(),
+                     cell_order[patch_n].end(),
+                     [&](const std::size_t a, const std::size_t b)
+                     { return codes[a] < codes[b]; });
+  }
+
+  template <int dim, int spacedim>
+  void
+  PatchMap<dim, spacedim>::expand_cells()
+  {
+    if (store_expanded_cells)
+      return;
+
+    store_expanded_cells = true;
+    expanded_cells.resize(patches.size());
+    for (std::size_t patch_n = 0; patch_n < patches.size(); ++patch_n)
+      compute_expanded_cells(patch_n);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  PatchMap<dim, spacedim>::compute_expanded_cells(const std::size_t patch_n)
+  {
+    if (!store_expanded_cells)
+      return;
+
+    AssertIndexRange(patch_n, expanded_cells.size());
+    std::vector<std::pair<int, int>> &cells = expanded_cells[patch_n];
+    cells.clear();
+    cells.reserve(cummulative_n_cells[patch_n].back());
+    for (unsigned int level_n = 0; level_n < patch_level_cells[patch_n].size();
+         ++level_n)
+      for (const auto cell_index : patch_level_cells[patch_n][level_n])
+        cells.emplace_back(level_n, cell_index);
+
+    if (cell_order[patch_n].size() > 0)
+      {
+        AssertDimension(cell_order[patch_n].size(), cells.size());
+        std::vector<std::pair<int, int>> ordered_cells(cells.size());
+        for (std::size_t i = 0; i < cells.size(); ++i)
+          ordered_cells[i] = cells[cell_order[patch_n][i]];
+        cells.swap(ordered_cells);
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  PatchMap<dim, spacedim>::cache_dof_indices(
+    const DoFHandler<dim, spacedim> &dof_handler)
+  {
+    Assert(tria, ExcMessage("The PatchMap must be initialized first."));
+    AssertThrow(&dof_handler.get_triangulation() == &*tria,
+                ExcMessage("must use same Triangulation"));
+    AssertThrow(dof_handler.get_fe_collection().size() == 1,
+                ExcFDLNotImplemented());
+    if (has_cached_dof_indices(dof_handler))
+      return;
+
+    cached_dof_handlers.push_back(&dof_handler);
+    patch_dof_indices.emplace_back(patches.size());
+    patch_active_cell_indices.resize(patches.size());
+    for (std::size_t patch_n = 0; patch_n < patches.size(); ++patch_n)
+      compute_cached_indices(patch_n);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  PatchMap<dim, spacedim>::compute_cached_indices(const std::size_t patch_n)
+  {
+    if (cached_dof_handlers.size() == 0)
+      return;
+
+    AssertIndexRange(patch_n, patch_active_cell_indices.size());
+    std::vector<unsigned int> &active_cell_indices =
+      patch_active_cell_indices[patch_n];
+    active_cell_indices.clear();
+    active_cell_indices.reserve(cummulative_n_cells[patch_n].back());
+    auto       iter     = begin(patch_n, *cached_dof_handlers[0]);
+    const auto end_iter = end(patch_n, *cached_dof_handlers[0]);
+    for (; iter != end_iter; ++iter)
+      active_cell_indices.push_back((*iter)->active_cell_index());
+
+    std::vector<types::global_dof_index> cell_dofs;
+    for (std::size_t i = 0; i < cached_dof_handlers.size(); ++i)
+      {
+        const DoFHandler<dim, spacedim> &dof_handler = *cached_dof_handlers[i];
+        const unsigned int dofs_per_cell = dof_handler.get_fe().dofs_per_cell;
+        std::vector<types::global_dof_index> &dofs =
+          patch_dof_indices[i][patch_n];
+        dofs.clear();
+        dofs.reserve(active_cell_indices.size() * dofs_per_cell);
+        cell_dofs.resize(dofs_per_cell);
+        auto       cell_iter = begin(patch_n, dof_handler);
+        const auto cell_end  = end(patch_n, dof_handler);
+        for (; cell_iter != cell_end; ++cell_iter)
           {
-            cummulative_n_cells[patch_n].push_back(
-              patch_level_cells[patch_n][level_n].n_elements());
-            if (level_n != 0)
-              cummulative_n_cells[patch_n].back() +=
-                cummulative_n_cells[patch_n][level_n - 1];
+            (*cell_iter)->get_dof_indices(cell_dofs);
+            dofs.insert(dofs.end(), cell_dofs.begin(), cell_dofs.end());
           }
       }
   }
 
+  template <int dim, int spacedim>
+  std::size_t
+  PatchMap<dim, spacedim>::memory_consumption() const
+  {
+    return patches.capacity() * sizeof(patches[0]) +
+           patch_bboxes.capacity() * sizeof(BoundingBox<spacedim>) +
+           reference_cell_bboxes.capacity() * sizeof(BoundingBox<spacedim>) +
+           MemoryConsumption::memory_consumption(patch_level_cells) +
+           MemoryConsumption::memory_consumption(cummulative_n_cells) +
+           MemoryConsumption::memory_consumption(cell_order) +
+           MemoryConsumption::memory_consumption(expanded_cells) +
+           MemoryConsumption::memory_consumption(cached_dof_handlers) +
+           MemoryConsumption::memory_consumption(patch_active_cell_indices) +
+           MemoryConsumption::memory_consumption(patch_dof_indices);
+  }
+
   // Since we depend on SAMRAI types (and SAMRAI uses 2D or 3D libraries) we
   // instantiate based on NDIM (provided by IBTK)
 
@@ -91,12 +467,24 @@ namespace fdl
     const std::vector<tbox::Pointer<hier::Patch<NDIM>>> &,
     const double,
     const Triangulation<NDIM - 1, NDIM> &,
+    const std::vector<BoundingBox<NDIM, float>> &cell_bboxes,
+    const bool);
+
+  template std::size_t
+  PatchMap<NDIM - 1, NDIM>::update(
+    const std::vector<tbox::Pointer<hier::Patch<NDIM>>> &,
     const std::vector<BoundingBox<NDIM, float>> &cell_bboxes);
 
   template PatchMap<NDIM - 1, NDIM>::PatchMap(
     const std::vector<tbox::Pointer<hier::Patch<NDIM>>> &,
     const double,
     const Triangulation<NDIM - 1, NDIM> &,
+    const std::vector<BoundingBox<NDIM, double>> &cell_bboxes,
+    const bool);
+
+  template std::size_t
+  PatchMap<NDIM - 1, NDIM>::update(
+    const std::vector<tbox::Pointer<hier::Patch<NDIM>>> &,
     const std::vector<BoundingBox<NDIM, double>> &cell_bboxes);
 
   template class PatchMap<NDIM, NDIM>;
@@ -105,12 +493,24 @@ namespace fdl
     const std::vector<tbox::Pointer<hier::Patch<NDIM>>> &,
     const double,
     const Triangulation<NDIM, NDIM> &,
+    const std::vector<BoundingBox<NDIM, float>> &cell_bboxes,
+    const bool);
+
+  template std::size_t
+  PatchMap<NDIM, NDIM>::update(
+    const std::vector<tbox::Pointer<hier::Patch<NDIM>>> &,
     const std::vector<BoundingBox<NDIM, float>> &cell_bboxes);
 
   template PatchMap<NDIM, NDIM>::PatchMap(
     const std::vector<tbox::Pointer<hier::Patch<NDIM>>> &,
     const double,
     const Triangulation<NDIM, NDIM> &,
+    const std::vector<BoundingBox<NDIM, double>> &cell_bboxes,
+    const bool);
+
+  template std::size_t
+  PatchMap<NDIM, NDIM>::update(
+    const std::vector<tbox::Pointer<hier::Patch<NDIM>>> &,
     const std::vector<BoundingBox<NDIM, double>> &cell_bboxes);
 
 } // namespace fdl
@@ -424,6 +424,98 @@ namespace fdl
     tria.signals.mesh_movement();
   }
 
+  namespace
+  {
+    bool
+    has_same_parameters(const Triangle::AdditionalData &a,
+                        const Triangle::AdditionalData &b)
+    {
+      return a.min_angle == b.min_angle &&
+             a.target_element_area == b.target_element_area &&
+             a.place_additional_boundary_vertices ==
+               b.place_additional_boundary_vertices &&
+             a.apply_fixup_routines == b.apply_fixup_routines &&
+             a.regularize_input == b.regularize_input;
+    }
+
+    // Check that no cell has been turned over, i.e., that all cells still
+    // have the orientation given by the normal vector used to create them.
+    bool
+    has_consistent_orientation(const Triangulation<2, 3> &tria,
+                               const Tensor<1, 3>        &normal)
+    {
+      for (const auto &cell : tria.active_cell_iterators())
+        {
+          AssertDimension(cell->n_vertices(), 3);
+          const Tensor<1, 3> cell_normal =
+            cross_product_3d(cell->vertex(1) - cell->vertex(0),
+                             cell->vertex(2) - cell->vertex(0));
+          if (cell_normal * normal <= 0.0)
+            return false;
+        }
+      return true;
+    }
+  } // namespace
+
+  bool
+  PlanarTriangulationCache::create_triangulation(
+    const std::vector<Point<3>>    &points,
+    Triangulation<2, 3>            &tria,
+    const Triangle::AdditionalData &additional_data)
+  {
+    FDL_SETUP_TIMER_AND_SCOPE(t_create_triangulation,
+                              "fdl::PlanarTriangulationCache::"
+                              "create_triangulation()");
+    // Triangle does not reorder the input vertices, so the topology is the
+    // same if the first points.size() vertices are exactly the boundary
+    // vertices
+    bool rebuild =
+      cached_tria.n_active_cells() == 0 ||
+      cached_tria.n_vertices() < points.size() ||
+      !has_same_parameters(additional_data, cached_additional_data);
+    if (!rebuild)
+      {
+        std::size_t       n_boundary_vertices = 0;
+        std::vector<bool> vertex_touched(cached_tria.n_vertices(), false);
+        for (const auto &face : cached_tria.active_face_iterators())
+          if (face->at_boundary())
+            for (const auto v : face->vertex_indices())
+              if (!vertex_touched[face->vertex_index(v)])
+                {
+                  vertex_touched[face->vertex_index(v)] = true;
+                  rebuild = rebuild || face->vertex_index(v) >= points.size();
+                  ++n_boundary_vertices;
+                }
+        rebuild = rebuild || n_boundary_vertices != points.size();
+      }
+    if (!rebuild)
+      {
+        fit_boundary_vertices(points, cached_tria);
+        rebuild = !has_consistent_orientation(cached_tria, normal);
+      }
+
+    if (rebuild)
+      {
+        cached_tria.clear();
+        normal =
+          create_planar_triangulation(points, cached_tria, additional_data);
+        fit_boundary_vertices(points, cached_tria);
+        cached_additional_data = additional_data;
+      }
+
+    tria.clear();
+    tria.copy_triangulation(cached_tria);
+    return rebuild;
+  }
+
+  void
+  PlanarTriangulationCache::clear()
+  {
+    cached_tria.clear();
+    normal                 = Tensor<1, 3>();
+    cached_additional_data = Triangle::AdditionalData();
+  }
+
   // instantiate all of them: why not?
 
   template void
@@ -1,7 +1,75 @@
 #include <fiddle/interaction/dlm_method.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace fdl
 {
+  //
+  // DLMMethodBase
+  //
+
+  template <int dim, int spacedim>
+  const LinearAlgebra::distributed::Vector<double> &
+  DLMMethodBase<dim, spacedim>::get_cached_mechanics_position(
+    const double time) const
+  {
+    // Like PartVectors, permit some roundoff in the times
+    auto it = std::find_if(cached_positions.begin(),
+                           cached_positions.end(),
+                           [&](const auto &entry)
+                           { return std::abs(entry.first - time) < 1e-12; });
+    if (it == cached_positions.end())
+      {
+        // Reuse the storage of the least recently used entry if we are full
+        if (cached_positions.size() < max_cached_positions)
+          cached_positions.emplace_back();
+        else
+          std::rotate(cached_positions.begin(),
+                      cached_positions.begin() + 1,
+                      cached_positions.end());
+        it        = cached_positions.end() - 1;
+        it->first = time;
+        it->second.zero_out_ghost_values();
+        get_mechanics_position(time, it->second);
+        it->second.update_ghost_values();
+      }
+    else
+      {
+        // move the entry to the end
+        std::rotate(it, it + 1, cached_positions.end());
+        it = cached_positions.end() - 1;
+      }
+
+    return it->second;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  DLMMethodBase<dim, spacedim>::invalidate_mechanics_position_cache()
+  {
+    ++mechanics_position_version;
+    // Keep the vectors around so that we don't need to allocate new ones
+    for (auto &entry : cached_positions)
+      entry.first = std::numeric_limits<double>::quiet_NaN();
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::uint64_t
+  DLMMethodBase<dim, spacedim>::get_mechanics_position_version() const
+  {
+    return mechanics_position_version;
+  }
+
+  //
+  // DLMForce
+  //
+
   template <int dim, int spacedim>
   DLMForce<dim, spacedim>::DLMForce(
     const Quadrature<dim>           &quad,
@@ -13,6 +81,8 @@ namespace fdl
                                  dof_handler,
                                  dlm.get_current_mechanics_position())
     , dlm(&dlm)
+    , reference_time(std::numeric_limits<double>::quiet_NaN())
+    , reference_version(0)
   {}
 
   template <int dim, int spacedim>
@@ -23,11 +93,22 @@ namespace fdl
     const LinearAlgebra::distributed::Vector<double> & /*velocity*/)
   {
     this->current_position = &position;
-    dlm->get_mechanics_position(time, this->reference_position);
+    // NaN never compares equal so we always get a position the first time
+    if (!(std::abs(time - reference_time) < 1e-12) ||
+        reference_version != dlm->get_mechanics_position_version())
+      {
+        this->reference_position = dlm->get_cached_mechanics_position(time);
+        reference_time           = time;
+        reference_version        = dlm->get_mechanics_position_version();
+      }
+    this->setup_scaled_displacement(position);
   }
 
 
 
+  template class DLMMethodBase<NDIM - 1, NDIM>;
+  template class DLMMethodBase<NDIM, NDIM>;
+
   template class DLMForce<NDIM - 1, NDIM>;
   template class DLMForce<NDIM, NDIM>;
 } // namespace fdl
@@ -1,21 +1,30 @@
+#include <fiddle/base/phase_timings.h>
 #include <fiddle/base/samrai_utilities.h>
 
+#include <fiddle/grid/box_utilities.h>
+
 #include <fiddle/interaction/elemental_interaction.h>
 #include <fiddle/interaction/interaction_utilities.h>
 
 FDL_DISABLE_EXTRA_DIAGNOSTICS
+#include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/utilities.h>
 FDL_ENABLE_EXTRA_DIAGNOSTICS
 
 #include <deal.II/fe/mapping_fe_field.h>
 
-#include <deal.II/grid/grid_tools.h>
+#include <deal.II/numerics/rtree.h>
+
+#include <boost/container_hash/hash.hpp>
 
-#include <CartesianPatchGeometry.h>
+#include <CartesianGridGeometry.h>
 #include <PatchHierarchy.h>
+#include <PatchLevel.h>
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <numeric>
 
 namespace fdl
@@ -23,6 +32,93 @@ namespace fdl
   using namespace dealii;
   using namespace SAMRAI;
 
+  namespace
+  {
+    /**
+     * Compute a value identifying the position of the structure for use with
+     * KernelWeightCache and QuadraturePointCache. Hashing the position is
+     * cheap relative to the cost of evaluating the position mapping or the
+     * kernel at every quadrature point.
+     */
+    std::size_t
+    hash_position(const Vector<double> &overlap_position)
+    {
+      return boost::hash_range(overlap_position.begin(),
+                               overlap_position.end());
+    }
+
+    /**
+     * Compute the Eulerian length (i.e., the minimum grid spacing) that
+     * should be used to select the quadrature rule on each cell with bounding
+     * box in @p cell_bboxes. Each cell is assigned to the finest level in
+     * @p level_numbers with a patch intersecting its bounding box (or, if
+     * there is no such patch, the coarsest level). Since every processor
+     * knows the boxes of all patches the result does not depend on the
+     * partitioning.
+     */
+    template <int spacedim>
+    std::vector<double>
+    compute_eulerian_lengths(
+      const tbox::Pointer<hier::PatchHierarchy<spacedim>> &patch_hierarchy,
+      const std::pair<int, int>                           &level_numbers,
+      const std::vector<BoundingBox<spacedim, float>>     &cell_bboxes)
+    {
+      std::vector<double>      eulerian_lengths(cell_bboxes.size());
+      std::vector<std::size_t> remaining_cells(cell_bboxes.size());
+      std::iota(remaining_cells.begin(), remaining_cells.end(), 0);
+      for (int ln = level_numbers.second;
+           ln >= level_numbers.first && remaining_cells.size() > 0;
+           --ln)
+        {
+          const tbox::Pointer<hier::PatchLevel<spacedim>> level =
+            patch_hierarchy->getPatchLevel(ln);
+          AssertThrow(level, ExcFDLNotImplemented());
+          const tbox::Pointer<geom::CartesianGridGeometry<spacedim>>
+            grid_geom = level->getGridGeometry();
+          AssertThrow(grid_geom, ExcFDLNotImplemented());
+          double dx = std::numeric_limits<double>::max();
+          for (unsigned int d = 0; d < spacedim; ++d)
+            dx = std::min(dx, grid_geom->getDx()[d] / level->getRatio()(d));
+
+          if (ln == level_numbers.first)
+            {
+              for (const std::size_t i : remaining_cells)
+                eulerian_lengths[i] = dx;
+              break;
+            }
+
+          std::vector<BoundingBox<spacedim>> patch_bboxes;
+          for (int patch_n = 0; patch_n < level->getNumberOfPatches();
+               ++patch_n)
+            patch_bboxes.push_back(
+              box_to_bbox<spacedim>(level->getBoxForPatch(patch_n), level));
+          const auto rtree = pack_rtree_of_indices(patch_bboxes);
+
+          std::vector<std::size_t> coarser_cells;
+          for (const std::size_t i : remaining_cells)
+            {
+              const auto &points = cell_bboxes[i].get_boundary_points();
+              Point<spacedim> lower;
+              Point<spacedim> upper;
+              for (unsigned int d = 0; d < spacedim; ++d)
+                {
+                  lower[d] = points.first[d];
+                  upper[d] = points.second[d];
+                }
+              namespace bgi = boost::geometry::index;
+              const BoundingBox<spacedim> bbox(std::make_pair(lower, upper));
+              if (rtree.qbegin(bgi::intersects(bbox)) != rtree.qend())
+                eulerian_lengths[i] = dx;
+              else
+                coarser_cells.push_back(i);
+            }
+          remaining_cells.swap(coarser_cells);
+        }
+
+      return eulerian_lengths;
+    }
+  } // namespace
+
   template <int dim, int spacedim>
   ElementalInteraction<dim, spacedim>::ElementalInteraction(
     const unsigned int min_n_points_1D,
@@ -32,6 +128,15 @@ namespace fdl
     , min_n_points_1D(min_n_points_1D)
     , point_density(point_density)
     , density_kind(density_kind)
+    , quadrature_hysteresis(0.0)
+    , cache_kernel_weights(false)
+    , mixed_precision(false)
+    , estimate_workload(false)
+    , cache_dof_indices(false)
+    , skip_zero_spread_cells(false)
+    , n_skipped_spread_cells(0)
+    , frozen_displacement_tolerance(0.0)
+    , frozen_position_key(0)
   {}
 
   template <int dim, int spacedim>
@@ -74,6 +179,24 @@ namespace fdl
                                            patch_hierarchy,
                                            level_numbers);
     Assert(level_numbers.first == level_numbers.second, ExcFDLNotImplemented());
+    cache_kernel_weights =
+      input_db->getBoolWithDefault("cache_kernel_weights", false);
+    mixed_precision = input_db->getBoolWithDefault("mixed_precision", false);
+    estimate_workload =
+      input_db->getBoolWithDefault("estimate_workload", false);
+    cache_dof_indices =
+      input_db->getBoolWithDefault("cache_dof_indices", false);
+    skip_zero_spread_cells =
+      input_db->getBoolWithDefault("skip_zero_spread_cells", false);
+    quadrature_hysteresis =
+      input_db->getDoubleWithDefault("quadrature_hysteresis", 0.0);
+    AssertThrow(0.0 <= quadrature_hysteresis && quadrature_hysteresis < 1.0,
+                ExcMessage("quadrature_hysteresis should be in [0, 1)."));
+    frozen_displacement_tolerance =
+      input_db->getDoubleWithDefault("frozen_displacement_tolerance", 0.0);
+    frozen_position.reinit(0);
+    kernel_weight_cache.clear();
+    quadrature_point_cache.clear();
 
     std::vector<tbox::Pointer<hier::Patch<spacedim>>> patches;
     for (int ln = level_numbers.first; ln <= level_numbers.second; ++ln)
@@ -85,113 +208,121 @@ namespace fdl
                        level_patches.end());
       }
 
-    // Set up the patch map:
-    {
-      // Yes, this is much more complex than necessary since
-      // global_active_cell_bboxes is an argument to this function, but we don't
-      // want to rely on that and p::s::T more than we have to since that
-      // approach ultimately needs to go.
-      //
-      // TODO - we should refactor this into a more general function so we can
-      // test it
-      std::vector<CellId> bbox_cellids;
-      for (const auto &cell : this->overlap_tria.active_cell_iterators())
-        bbox_cellids.push_back(this->overlap_tria.get_native_cell_id(cell));
-
-      // 1. Figure out who owns the bounding boxes we need:
-      std::vector<types::subdomain_id> ranks =
-        GridTools::get_subdomain_association(*this->native_tria, bbox_cellids);
-
-      // 2. Send each processor the list of bboxes we need:
-      std::map<types::subdomain_id,
-               std::vector<std::pair<unsigned int, CellId>>>
-        corresponding_requested_cellids;
-      // Keep the overlap active cell index along for the ride
-      for (unsigned int i = 0; i < ranks.size(); ++i)
-        corresponding_requested_cellids[ranks[i]].emplace_back(i,
-                                                               bbox_cellids[i]);
-
-      const std::map<types::subdomain_id,
-                     std::vector<std::pair<unsigned int, CellId>>>
-        corresponding_cellids_to_send =
-          Utilities::MPI::some_to_some(this->communicator,
-                                       corresponding_requested_cellids);
-
-      // 3. Send each processor the actual bboxes:
-      std::map<
-        types::subdomain_id,
-        std::vector<std::pair<unsigned int, BoundingBox<spacedim, float>>>>
-        requested_bboxes;
-      for (const auto &pair : corresponding_cellids_to_send)
-        {
-          const auto  rank                = pair.first;
-          const auto &indices_and_cellids = pair.second;
-
-          auto &bboxes = requested_bboxes[rank];
-          for (const auto &index_and_cellid : indices_and_cellids)
-            {
-              auto it = this->native_tria->create_cell_iterator(
-                index_and_cellid.second);
-              bboxes.emplace_back(
-                index_and_cellid.first,
-                global_active_cell_bboxes[it->active_cell_index()]);
-            }
-        }
-
-      const auto received_bboxes =
-        Utilities::MPI::some_to_some(this->communicator, requested_bboxes);
-
-      std::vector<BoundingBox<spacedim, float>> overlap_bboxes(
-        this->overlap_tria.n_active_cells());
-      for (const auto &pair : received_bboxes)
-        for (const auto &index_and_bbox : pair.second)
-          {
-            AssertIndexRange(index_and_bbox.first, overlap_bboxes.size());
-            overlap_bboxes[index_and_bbox.first] = index_and_bbox.second;
-          }
-
-      patch_map.reinit(patches,
-                       input_db->getDoubleWithDefault("ghost_cell_fraction",
-                                                      1.0),
-                       this->overlap_tria,
-                       overlap_bboxes);
-    }
+    // Set up the patch map. Every processor has the bounding boxes of all
+    // native cells, so we can look up the boxes of the overlap cells directly
+    // by active cell index instead of requesting them from the processors
+    // which own the native cells.
+    //
+    // TODO - if the bounding boxes are ever distributed then this needs a
+    // single exchange with the owners of the native cells.
+    std::vector<BoundingBox<spacedim, float>> overlap_bboxes(
+      this->overlap_tria.n_active_cells());
+    for (const auto &cell : this->overlap_tria.active_cell_iterators())
+      {
+        const auto native_cell = this->overlap_tria.get_native_cell(cell);
+        Assert(native_cell->is_active(), ExcFDLInternalError());
+        AssertIndexRange(native_cell->active_cell_index(),
+                         global_active_cell_bboxes.size());
+        overlap_bboxes[cell->active_cell_index()] =
+          global_active_cell_bboxes[native_cell->active_cell_index()];
+      }
+    patch_map.reinit(patches,
+                     input_db->getDoubleWithDefault("ghost_cell_fraction", 1.0),
+                     this->overlap_tria,
+                     overlap_bboxes,
+                     input_db->getBoolWithDefault("morton_order_cells", false));
+    if (input_db->getBoolWithDefault("expand_cells", false))
+      patch_map.expand_cells();
 
     // We need to implement some more quadrature families
     const auto reference_cells = native_tria.get_reference_cells();
     Assert(reference_cells.size() == 1, ExcFDLNotImplemented());
     if (!quadrature_family)
       {
+        const bool equispaced =
+          input_db->getBoolWithDefault("equispaced_quadratures", false);
         if (reference_cells.front() == ReferenceCells::get_hypercube<dim>())
-          quadrature_family.reset(
-            new QGaussFamily<dim>(min_n_points_1D, point_density));
+          {
+            if (equispaced)
+              quadrature_family.reset(new QEquispacedFamily<dim>(
+                min_n_points_1D, point_density, density_kind));
+            else
+              quadrature_family.reset(
+                new QGaussFamily<dim>(min_n_points_1D, point_density));
+          }
         else if (reference_cells.front() == ReferenceCells::get_simplex<dim>())
-          quadrature_family.reset(new QWitherdenVincentSimplexFamily<dim>(
-            min_n_points_1D, point_density, density_kind));
+          {
+            if (equispaced)
+              quadrature_family.reset(new QEquispacedSimplexFamily<dim>(
+                min_n_points_1D, point_density, density_kind));
+            else
+              quadrature_family.reset(new QWitherdenVincentSimplexFamily<dim>(
+                min_n_points_1D, point_density, density_kind));
+          }
         else
           Assert(false, ExcFDLNotImplemented());
       }
 
-    double patch_dx_min = std::numeric_limits<double>::max();
-    if (patches.size() > 0)
+    // Determine which quadrature rule we should use on each cell. When
+    // level_numbers spans several levels, each cell only needs the point
+    // density of the finest level it interacts with.
+    quadrature_indices.resize(0);
+    if (quadrature_hysteresis > 0.0)
       {
-        const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> geometry =
-          patches[0]->getPatchGeometry();
-        const double *const patch_dx = geometry->getDx();
-        patch_dx_min = *std::min_element(patch_dx, patch_dx + spacedim);
-      }
-    const double eulerian_length =
-      Utilities::MPI::min(patch_dx_min, this->communicator);
+        // Every processor knows the lengths of all cells, so select rules for
+        // the whole native Triangulation: this way all processors agree on
+        // the rule used on each cell, even if they did not previously share
+        // it.
+        const bool keep_previous =
+          native_quadrature_indices.size() == active_cell_lengths.size();
+        const std::vector<double> eulerian_lengths =
+          compute_eulerian_lengths(patch_hierarchy,
+                                   level_numbers,
+                                   global_active_cell_bboxes);
+        native_quadrature_indices.resize(active_cell_lengths.size());
+        for (std::size_t i = 0; i < active_cell_lengths.size(); ++i)
+          {
+            const double lagrangian_length = active_cell_lengths[i];
+            const double eulerian_length   = eulerian_lengths[i];
+            if (keep_previous)
+              {
+                const unsigned char previous_index =
+                  native_quadrature_indices[i];
+                const unsigned char min_index = quadrature_family->get_index(
+                  eulerian_length,
+                  (1.0 - quadrature_hysteresis) * lagrangian_length);
+                const unsigned char max_index = quadrature_family->get_index(
+                  eulerian_length,
+                  (1.0 + quadrature_hysteresis) * lagrangian_length);
+                if (min_index <= previous_index && previous_index <= max_index)
+                  continue;
+              }
+            native_quadrature_indices[i] =
+              quadrature_family->get_index(eulerian_length, lagrangian_length);
+          }
 
-    // Determine which quadrature rule we should use on each cell:
-    quadrature_indices.resize(0);
-    for (const auto &cell : this->overlap_tria.active_cell_iterators())
+        for (const auto &cell : this->overlap_tria.active_cell_iterators())
+          {
+            const auto native_cell = this->overlap_tria.get_native_cell(cell);
+            quadrature_indices.push_back(
+              native_quadrature_indices[native_cell->active_cell_index()]);
+          }
+      }
+    else
       {
-        const auto   native_cell = this->overlap_tria.get_native_cell(cell);
-        const double lagrangian_length =
-          active_cell_lengths[native_cell->active_cell_index()];
-        quadrature_indices.push_back(
-          quadrature_family->get_index(eulerian_length, lagrangian_length));
+        native_quadrature_indices.clear();
+        const std::vector<double> eulerian_lengths =
+          compute_eulerian_lengths(patch_hierarchy,
+                                   level_numbers,
+                                   overlap_bboxes);
+        for (const auto &cell : this->overlap_tria.active_cell_iterators())
+          {
+            const auto native_cell = this->overlap_tria.get_native_cell(cell);
+            const double lagrangian_length =
+              active_cell_lengths[native_cell->active_cell_index()];
+            quadrature_indices.push_back(quadrature_family->get_index(
+              eulerian_lengths[cell->active_cell_index()], lagrangian_length));
+          }
       }
 
     // Store quadratures in a vector:
@@ -204,6 +335,89 @@ namespace fdl
       quadratures.push_back((*quadrature_family)[i]);
   }
 
+  template <int dim, int spacedim>
+  bool
+  ElementalInteraction<dim, spacedim>::update_patch_hierarchy(
+    tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy,
+    const std::pair<int, int>                    &level_numbers)
+  {
+    if (!InteractionBase<dim, spacedim>::update_patch_hierarchy(
+          patch_hierarchy, level_numbers))
+      return false;
+
+    patch_map.replace_patches(this->get_patches(patch_hierarchy));
+    // The caches are indexed by patch, so start over to be safe
+    kernel_weight_cache.clear();
+    quadrature_point_cache.clear();
+    frozen_position.reinit(0);
+    return true;
+  }
+
+  template <int dim, int spacedim>
+  KernelWeightCache<spacedim> *
+  ElementalInteraction<dim, spacedim>::get_kernel_weight_cache(
+    const Transaction<dim, spacedim> &transaction,
+    const std::size_t                 position_key) const
+  {
+    if (!cache_kernel_weights && frozen_displacement_tolerance <= 0.0)
+      return nullptr;
+
+    kernel_weight_cache.reinit(transaction.kernel_name,
+                               position_key,
+                               patch_map.size(),
+                               mixed_precision);
+    return &kernel_weight_cache;
+  }
+
+  template <int dim, int spacedim>
+  std::size_t
+  ElementalInteraction<dim, spacedim>::get_position_key(
+    const Vector<double> &overlap_position) const
+  {
+    if (frozen_displacement_tolerance <= 0.0)
+      return hash_position(overlap_position);
+
+    // The caches only depend on the position through the quadrature points,
+    // which move at most as far as the position DoFs of nodal elements
+    if (frozen_position.size() == overlap_position.size())
+      {
+        bool within_tolerance = true;
+        for (std::size_t i = 0; within_tolerance && i < frozen_position.size();
+             ++i)
+          within_tolerance = std::abs(overlap_position[i] -
+                                      frozen_position[i]) <=
+                             frozen_displacement_tolerance;
+        if (within_tolerance)
+          return frozen_position_key;
+      }
+
+    frozen_position     = overlap_position;
+    frozen_position_key = hash_position(overlap_position);
+    PhaseTimings::get().add(
+      "fdl::ElementalInteraction[frozen_position_updates]", 1.0);
+    return frozen_position_key;
+  }
+
+  template <int dim, int spacedim>
+  QuadraturePointCache<spacedim> *
+  ElementalInteraction<dim, spacedim>::get_quadrature_point_cache(
+    const std::size_t position_key) const
+  {
+    quadrature_point_cache.reinit(position_key, patch_map.size());
+    return &quadrature_point_cache;
+  }
+
+  template <int dim, int spacedim>
+  void
+  ElementalInteraction<dim, spacedim>::add_dof_handler(
+    const DoFHandler<dim, spacedim> &native_dof_handler)
+  {
+    InteractionBase<dim, spacedim>::add_dof_handler(native_dof_handler);
+    if (cache_dof_indices)
+      patch_map.cache_dof_indices(
+        this->get_overlap_dof_handler(native_dof_handler));
+  }
+
   template <int dim, int spacedim>
   bool
   ElementalInteraction<dim, spacedim>::projection_is_interpolation() const
@@ -224,21 +438,77 @@ namespace fdl
             Transaction<dim, spacedim>::State::Intermediate),
            ExcMessage("Transaction state should be Intermediate"));
 
-    MappingFEField<dim, spacedim, Vector<double>> position_mapping(
-      this->get_overlap_dof_handler(*trans.native_position_dof_handler),
-      trans.overlap_position);
+    // With no cells there is nothing to interpolate (and the overlap right
+    // hand sides are empty)
+    if (this->has_empty_overlap())
+      {
+        trans.next_state = Transaction<dim, spacedim>::State::AccumulateStart;
+        return t_ptr;
+      }
 
-    // Actually do the interpolation:
+    const auto position_mapping = this->get_overlap_position_mapping(
+      *trans.native_position_dof_handler,
+      *trans.native_position,
+      trans.position_versions[0],
+      trans.overlap_position);
+    const std::size_t position_key = get_position_key(trans.overlap_position);
+
+    // Actually do the interpolation. All fields are interpolated in one pass
+    // over the patches:
+    std::vector<int> data_indices{trans.current_data_idx};
+    std::vector<const DoFHandler<dim, spacedim> *> dof_handlers{
+      &this->get_overlap_dof_handler(*trans.native_dof_handler)};
+    std::vector<const Mapping<dim, spacedim> *> mappings{&*trans.mapping};
+    std::vector<Vector<double> *>               rhs{&trans.overlap_rhs};
+    for (auto &field : trans.additional_fields)
+      {
+        data_indices.push_back(field.data_idx);
+        dof_handlers.push_back(
+          &this->get_overlap_dof_handler(*field.native_dof_handler));
+        mappings.push_back(&*field.mapping);
+        rhs.push_back(&field.overlap_rhs);
+      }
     compute_projection_rhs(trans.kernel_name,
-                           trans.current_data_idx,
+                           data_indices,
                            patch_map,
-                           position_mapping,
+                           *position_mapping,
                            quadrature_indices,
                            quadratures,
-                           this->get_overlap_dof_handler(
-                             *trans.native_dof_handler),
-                           *trans.mapping,
-                           trans.overlap_rhs);
+                           dof_handlers,
+                           mappings,
+                           rhs,
+                           get_kernel_weight_cache(trans, position_key),
+                           this->execution_policy,
+                           mixed_precision,
+                           get_quadrature_point_cache(position_key));
+
+    // Other parts share the patch map and DoFHandlers but have their own
+    // positions:
+    for (std::size_t i = 0; i < trans.additional_parts.size(); ++i)
+      {
+        auto      &part                  = trans.additional_parts[i];
+        const auto part_position_mapping = this->get_overlap_position_mapping(
+          *trans.native_position_dof_handler,
+          *part.native_position,
+          trans.position_versions[i + 1],
+          part.overlap_position);
+        const std::size_t part_position_key =
+          get_position_key(part.overlap_position);
+        compute_projection_rhs(trans.kernel_name,
+                               trans.current_data_idx,
+                               patch_map,
+                               *part_position_mapping,
+                               quadrature_indices,
+                               quadratures,
+                               *dof_handlers[0],
+                               *trans.mapping,
+                               part.overlap_rhs,
+                               get_kernel_weight_cache(trans,
+                                                       part_position_key),
+                               this->execution_policy,
+                               mixed_precision,
+                               get_quadrature_point_cache(part_position_key));
+      }
 
     trans.next_state = Transaction<dim, spacedim>::State::AccumulateStart;
 
@@ -258,20 +528,68 @@ namespace fdl
             Transaction<dim, spacedim>::State::Intermediate),
            ExcMessage("Transaction state should be Intermediate"));
 
-    MappingFEField<dim, spacedim, Vector<double>> position_mapping(
-      this->get_overlap_dof_handler(*trans.native_position_dof_handler),
+    if (this->has_empty_overlap())
+      {
+        trans.next_state = Transaction<dim, spacedim>::State::AccumulateFinish;
+        return t_ptr;
+      }
+
+    const auto position_mapping = this->get_overlap_position_mapping(
+      *trans.native_position_dof_handler,
+      *trans.native_position,
+      trans.position_versions[0],
       trans.overlap_position);
+    const std::size_t position_key = get_position_key(trans.overlap_position);
 
     // Actually do the spreading:
-    compute_spread(trans.kernel_name,
-                   trans.current_data_idx,
-                   patch_map,
-                   position_mapping,
-                   quadrature_indices,
-                   quadratures,
-                   this->get_overlap_dof_handler(*trans.native_dof_handler),
-                   *trans.mapping,
-                   trans.overlap_solution);
+    std::size_t n_skipped = compute_spread(
+      trans.kernel_name,
+      trans.current_data_idx,
+      patch_map,
+      *position_mapping,
+      quadrature_indices,
+      quadratures,
+      this->get_overlap_dof_handler(*trans.native_dof_handler),
+      *trans.mapping,
+      trans.overlap_solution,
+      get_kernel_weight_cache(trans, position_key),
+      this->execution_policy,
+      mixed_precision,
+      get_quadrature_point_cache(position_key),
+      skip_zero_spread_cells);
+
+    for (std::size_t i = 0; i < trans.additional_parts.size(); ++i)
+      {
+        auto      &part                  = trans.additional_parts[i];
+        const auto part_position_mapping = this->get_overlap_position_mapping(
+          *trans.native_position_dof_handler,
+          *part.native_position,
+          trans.position_versions[i + 1],
+          part.overlap_position);
+        const std::size_t part_position_key =
+          get_position_key(part.overlap_position);
+        n_skipped += compute_spread(
+          trans.kernel_name,
+          trans.current_data_idx,
+          patch_map,
+          *part_position_mapping,
+          quadrature_indices,
+          quadratures,
+          this->get_overlap_dof_handler(*trans.native_dof_handler),
+          *trans.mapping,
+          part.overlap_solution,
+          get_kernel_weight_cache(trans, part_position_key),
+          this->execution_policy,
+          mixed_precision,
+          get_quadrature_point_cache(part_position_key),
+          skip_zero_spread_cells);
+      }
+    if (skip_zero_spread_cells)
+      {
+        n_skipped_spread_cells += n_skipped;
+        PhaseTimings::get().add(
+          "fdl::ElementalInteraction[skipped_spread_cells]", n_skipped);
+      }
 
     trans.next_state = Transaction<dim, spacedim>::State::AccumulateFinish;
 
@@ -289,18 +607,47 @@ namespace fdl
            ExcMessage("Transaction state should be Intermediate"));
 
     // Finish communication:
-    trans.position_scatter.global_to_overlap_finish(*trans.native_position,
-                                                    trans.overlap_position);
+    if (!trans.reuse_overlap_position)
+      {
+        trans.position_scatter.global_to_overlap_finish(
+          *trans.native_position, trans.overlap_position);
+        this->cache_overlap_position(*trans.native_position_dof_handler,
+                                     *trans.native_position,
+                                     trans.position_version,
+                                     trans.overlap_position);
+      }
 
-    MappingFEField<dim, spacedim, Vector<double>> position_mapping(
-      this->get_overlap_dof_handler(*trans.native_position_dof_handler),
-      trans.overlap_position);
+    this->local_unweighted_workload = 0.0;
+    if (this->has_empty_overlap())
+      {
+        trans.next_state =
+          WorkloadTransaction<dim, spacedim>::State::AccumulateFinish;
+        return t_ptr;
+      }
 
-    count_quadrature_points(trans.workload_index,
-                            patch_map,
-                            position_mapping,
-                            quadrature_indices,
-                            quadratures);
+    const auto position_mapping =
+      this->get_overlap_position_mapping(*trans.native_position_dof_handler,
+                                         *trans.native_position,
+                                         trans.position_version,
+                                         trans.overlap_position);
+
+    if (estimate_workload)
+      this->local_unweighted_workload =
+        estimate_quadrature_points(trans.workload_index,
+                                   patch_map,
+                                   *position_mapping,
+                                   quadrature_indices,
+                                   quadratures,
+                                   this->workload_weight);
+    else
+      this->local_unweighted_workload = count_quadrature_points(
+        trans.workload_index,
+        patch_map,
+        *position_mapping,
+        quadrature_indices,
+        quadratures,
+        get_quadrature_point_cache(get_position_key(trans.overlap_position)),
+        this->workload_weight);
 
     trans.next_state =
       WorkloadTransaction<dim, spacedim>::State::AccumulateFinish;
@@ -319,6 +666,37 @@ namespace fdl
 
 
 
+  template <int dim, int spacedim>
+  std::size_t
+  ElementalInteraction<dim, spacedim>::memory_consumption() const
+  {
+    return InteractionBase<dim, spacedim>::memory_consumption() +
+           patch_map.memory_consumption() +
+           MemoryConsumption::memory_consumption(quadrature_indices) +
+           MemoryConsumption::memory_consumption(native_quadrature_indices) +
+           kernel_weight_cache.memory_consumption() +
+           quadrature_point_cache.memory_consumption() +
+           frozen_position.memory_consumption();
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  ElementalInteraction<dim, spacedim>::n_exterior_quadrature_points() const
+  {
+    return quadrature_point_cache.n_exterior_points();
+  }
+
+  template <int dim, int spacedim>
+  std::size_t
+  ElementalInteraction<dim, spacedim>::n_skipped_zero_cells() const
+  {
+    return n_skipped_spread_cells;
+  }
+
+
+
   // instantiations
   template class ElementalInteraction<NDIM - 1, NDIM>;
   template class ElementalInteraction<NDIM, NDIM>;
@@ -0,0 +1,287 @@
+#include <fiddle/grid/box_utilities.h>
+
+#include <fiddle/interaction/hybrid_interaction.h>
+#include <fiddle/interaction/interaction_utilities.h>
+
+#include <deal.II/base/memory_consumption.h>
+
+#include <deal.II/dofs/dof_renumbering.h>
+
+#include <PatchHierarchy.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace fdl
+{
+  using namespace dealii;
+  using namespace SAMRAI;
+
+  template <int dim, int spacedim>
+  HybridInteraction<dim, spacedim>::HybridInteraction(
+    const unsigned int min_n_points_1D,
+    const double       point_density,
+    const DensityKind  density_kind)
+    : ElementalInteraction<dim, spacedim>(min_n_points_1D,
+                                          point_density,
+                                          density_kind)
+  {}
+
+  template <int dim, int spacedim>
+  HybridInteraction<dim, spacedim>::HybridInteraction(
+    const tbox::Pointer<tbox::Database>                  &input_db,
+    const parallel::shared::Triangulation<dim, spacedim> &native_tria,
+    const std::vector<BoundingBox<spacedim, float>>      &active_cell_bboxes,
+    const std::vector<float>                             &active_cell_lengths,
+    tbox::Pointer<hier::PatchHierarchy<spacedim>>         patch_hierarchy,
+    const std::pair<int, int>                            &level_numbers,
+    const unsigned int                                    min_n_points_1D,
+    const double                                          point_density,
+    const DensityKind                                     density_kind)
+    : HybridInteraction<dim, spacedim>(min_n_points_1D,
+                                       point_density,
+                                       density_kind)
+  {
+    reinit(input_db,
+           native_tria,
+           active_cell_bboxes,
+           active_cell_lengths,
+           patch_hierarchy,
+           level_numbers);
+  }
+
+  template <int dim, int spacedim>
+  void
+  HybridInteraction<dim, spacedim>::reinit(
+    const tbox::Pointer<tbox::Database>                  &input_db,
+    const parallel::shared::Triangulation<dim, spacedim> &native_tria,
+    const std::vector<BoundingBox<spacedim, float>>      &active_cell_bboxes,
+    const std::vector<float>                             &active_cell_lengths,
+    tbox::Pointer<hier::PatchHierarchy<spacedim>>         patch_hierarchy,
+    const std::pair<int, int>                            &level_numbers)
+  {
+    ElementalInteraction<dim, spacedim>::reinit(input_db,
+                                                native_tria,
+                                                active_cell_bboxes,
+                                                active_cell_lengths,
+                                                patch_hierarchy,
+                                                level_numbers);
+    nodal_renumberings.clear();
+    nodal_position.reinit(0);
+
+    // ElementalInteraction only supports one level, so unlike
+    // NodalInteraction we do not need to remove the parts of patches covered
+    // by finer levels
+    const double ghost_cell_fraction =
+      input_db->getDoubleWithDefault("ghost_cell_fraction", 1.0);
+    AssertThrow(ghost_cell_fraction > 0.0, ExcFDLNotImplemented());
+    nodal_patches = this->get_patches(patch_hierarchy);
+    nodal_bboxes.clear();
+    for (const auto &bbox :
+         compute_patch_bboxes<spacedim>(nodal_patches, ghost_cell_fraction))
+      nodal_bboxes.push_back({bbox});
+  }
+
+  template <int dim, int spacedim>
+  bool
+  HybridInteraction<dim, spacedim>::update_patch_hierarchy(
+    tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy,
+    const std::pair<int, int>                    &level_numbers)
+  {
+    if (!ElementalInteraction<dim, spacedim>::update_patch_hierarchy(
+          patch_hierarchy, level_numbers))
+      return false;
+
+    // The boxes are the same and the nodes did not move, so this just
+    // replaces the patches
+    nodal_patches = this->get_patches(patch_hierarchy);
+    if (nodal_position.size() > 0)
+      nodal_patch_map.update(nodal_patches,
+                             nodal_bboxes,
+                             nodal_position,
+                             nodal_position);
+    return true;
+  }
+
+  template <int dim, int spacedim>
+  void
+  HybridInteraction<dim, spacedim>::add_dof_handler(
+    const DoFHandler<dim, spacedim> &native_dof_handler)
+  {
+    // As in NodalInteraction, nodes are only well-defined for vector-valued
+    // elements with exactly one base element
+    AssertThrow(native_dof_handler.get_fe().n_base_elements() == 1,
+                ExcFDLNotImplemented());
+    ElementalInteraction<dim, spacedim>::add_dof_handler(native_dof_handler);
+
+    // Unlike NodalInteraction, we do not renumber the overlap DoFs (which
+    // would invalidate the PatchMap's cached DoF indices and the reuse of
+    // DoF translations) and instead permute vectors during interpolation.
+    while (nodal_renumberings.size() < this->native_dof_handlers.size())
+      {
+        const DoFHandler<dim, spacedim> &overlap_dof_handler =
+          this->get_overlap_dof_handler(
+            *this->native_dof_handlers[nodal_renumberings.size()]);
+        std::vector<types::global_dof_index> renumbering(
+          overlap_dof_handler.n_dofs());
+        DoFRenumbering::compute_support_point_wise(renumbering,
+                                                   overlap_dof_handler);
+        // An empty result means that the DoFs are already in nodal order
+        if (renumbering.size() == 0)
+          {
+            renumbering.resize(overlap_dof_handler.n_dofs());
+            std::iota(renumbering.begin(), renumbering.end(), 0u);
+          }
+        nodal_renumberings.emplace_back(std::move(renumbering));
+      }
+  }
+
+  template <int dim, int spacedim>
+  bool
+  HybridInteraction<dim, spacedim>::projection_is_interpolation() const
+  {
+    return true;
+  }
+
+  template <int dim, int spacedim>
+  bool
+  HybridInteraction<dim, spacedim>::spreading_is_nodal() const
+  {
+    return false;
+  }
+
+  template <int dim, int spacedim>
+  std::unique_ptr<TransactionBase>
+  HybridInteraction<dim, spacedim>::compute_projection_rhs_intermediate(
+    std::unique_ptr<TransactionBase> t_ptr) const
+  {
+    auto &trans = dynamic_cast<Transaction<dim, spacedim> &>(*t_ptr);
+    Assert((trans.operation ==
+            Transaction<dim, spacedim>::Operation::Interpolation),
+           ExcMessage("Transaction operation should be Interpolation"));
+    Assert((trans.next_state ==
+            Transaction<dim, spacedim>::State::Intermediate),
+           ExcMessage("Transaction state should be Intermediate"));
+    // The NodalPatchMap depends on the position, so it cannot be shared by
+    // several parts
+    AssertThrow(trans.additional_parts.size() == 0, ExcFDLNotImplemented());
+
+    // Update the assignment of nodes to patches. Only nodes which moved since
+    // the last interpolation are checked again.
+    const std::vector<types::global_dof_index> &position_renumbering =
+      get_nodal_renumbering(*trans.native_position_dof_handler);
+    Vector<double> new_nodal_position(trans.overlap_position.size());
+    for (std::size_t i = 0; i < position_renumbering.size(); ++i)
+      new_nodal_position[position_renumbering[i]] = trans.overlap_position[i];
+    if (nodal_position.size() > 0)
+      nodal_patch_map.update(nodal_patches,
+                             nodal_bboxes,
+                             nodal_position,
+                             new_nodal_position);
+    else
+      nodal_patch_map.reinit(nodal_patches, nodal_bboxes, new_nodal_position);
+    nodal_position.swap(new_nodal_position);
+
+    const auto interpolate =
+      [&](const int                        data_idx,
+          const DoFHandler<dim, spacedim> &native_dof_handler,
+          Vector<double>                  &overlap_rhs)
+    {
+      AssertThrow(native_dof_handler.get_fe().base_element(0) ==
+                    trans.native_position_dof_handler->get_fe().base_element(0),
+                  ExcMessage("HybridInteraction requires interpolated fields "
+                             "to use the same base element as the position."));
+      const std::vector<types::global_dof_index> &renumbering =
+        get_nodal_renumbering(native_dof_handler);
+      Vector<double> nodal_values(overlap_rhs.size());
+      compute_nodal_interpolation(trans.kernel_name,
+                                  data_idx,
+                                  nodal_patch_map,
+                                  nodal_position,
+                                  nodal_values,
+                                  this->execution_policy);
+      for (std::size_t i = 0; i < renumbering.size(); ++i)
+        overlap_rhs[i] = nodal_values[renumbering[i]];
+    };
+
+    interpolate(trans.current_data_idx,
+                *trans.native_dof_handler,
+                trans.overlap_rhs);
+    for (auto &field : trans.additional_fields)
+      interpolate(field.data_idx, *field.native_dof_handler, field.overlap_rhs);
+
+    trans.next_state = Transaction<dim, spacedim>::State::AccumulateStart;
+    return t_ptr;
+  }
+
+  template <int dim, int spacedim>
+  void
+  HybridInteraction<dim, spacedim>::compute_projection_rhs_accumulate_finish(
+    std::unique_ptr<TransactionBase> t_ptr)
+  {
+    auto &trans = dynamic_cast<Transaction<dim, spacedim> &>(*t_ptr);
+    std::vector<LinearAlgebra::distributed::Vector<double> *> native_rhs{
+      &*trans.native_rhs};
+    for (auto &field : trans.additional_fields)
+      native_rhs.push_back(&*field.native_rhs);
+    ElementalInteraction<dim, spacedim>::
+      compute_projection_rhs_accumulate_finish(std::move(t_ptr));
+
+    // As in NodalInteraction, nodes outside the domain still have the value
+    // -DBL_MAX:
+    for (LinearAlgebra::distributed::Vector<double> *vec : native_rhs)
+      {
+        const auto size = vec->locally_owned_size();
+        DEAL_II_OPENMP_SIMD_PRAGMA
+        for (types::global_dof_index i = 0; i < size; ++i)
+          {
+            double &v = vec->local_element(i);
+            if (v == std::numeric_limits<double>::lowest())
+              v = 0.0;
+          }
+      }
+  }
+
+  template <int dim, int spacedim>
+  VectorOperation::values
+  HybridInteraction<dim, spacedim>::get_rhs_scatter_type() const
+  {
+    return VectorOperation::max;
+  }
+
+  template <int dim, int spacedim>
+  const std::vector<types::global_dof_index> &
+  HybridInteraction<dim, spacedim>::get_nodal_renumbering(
+    const DoFHandler<dim, spacedim> &native_dof_handler) const
+  {
+    const auto iter = std::find(this->native_dof_handlers.begin(),
+                                this->native_dof_handlers.end(),
+                                &native_dof_handler);
+    AssertThrow(iter != this->native_dof_handlers.end(),
+                ExcMessage("The provided dof handler must already be "
+                           "registered with this class."));
+    const std::size_t index = iter - this->native_dof_handlers.begin();
+    AssertIndexRange(index, nodal_renumberings.size());
+    return nodal_renumberings[index];
+  }
+
+  template <int dim, int spacedim>
+  std::size_t
+  HybridInteraction<dim, spacedim>::memory_consumption() const
+  {
+    std::size_t result =
+      ElementalInteraction<dim, spacedim>::memory_consumption() +
+      MemoryConsumption::memory_consumption(nodal_renumberings) +
+      nodal_position.memory_consumption() +
+      nodal_patch_map.memory_consumption() +
+      nodal_patches.capacity() * sizeof(nodal_patches[0]);
+    for (const auto &patch_bboxes : nodal_bboxes)
+      result += patch_bboxes.capacity() * sizeof(BoundingBox<spacedim>);
+    return result;
+  }
+
+  // instantiations
+  template class HybridInteraction<NDIM - 1, NDIM>;
+  template class HybridInteraction<NDIM, NDIM>;
+} // namespace fdl
@@ -1,10 +1,13 @@
+#include <fiddle/base/phase_timings.h>
 #include <fiddle/base/samrai_utilities.h>
+#include <fiddle/base/trace.h>
 #include <fiddle/base/utilities.h>
 
 #include <fiddle/grid/box_utilities.h>
 #include <fiddle/grid/grid_utilities.h>
 
 #include <fiddle/interaction/elemental_interaction.h>
+#include <fiddle/interaction/hybrid_interaction.h>
 #include <fiddle/interaction/ifed_method.h>
 #include <fiddle/interaction/interaction_utilities.h>
 #include <fiddle/interaction/nodal_interaction.h>
@@ -12,13 +15,15 @@
 #include <fiddle/mechanics/mechanics_utilities.h>
 
 #include <deal.II/base/mpi.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/thread_management.h>
 #include <deal.II/base/utilities.h>
 
 #include <deal.II/distributed/shared_tria.h>
 
 #include <deal.II/fe/mapping_fe_field.h>
 
-#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/vector.h>
 
 #include <ibamr/IBHierarchyIntegrator.h>
 #include <ibamr/ibamr_utilities.h>
@@ -32,16 +37,27 @@
 #include <HierarchyDataOpsManager.h>
 #include <IntVector.h>
 #include <VariableDatabase.h>
+#include <tbox/RestartManager.h>
 #include <tbox/TimerManager.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <deque>
+#include <iomanip>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <set>
 
 namespace
 {
   using namespace SAMRAI;
+  static tbox::Timer *t_max_point_displacement;
   static tbox::Timer *t_interpolate_velocity;
   static tbox::Timer *t_interpolate_velocity_start_barrier;
   static tbox::Timer *t_interpolate_velocity_rhs;
+  static tbox::Timer *t_interpolate_velocity_transfer;
   static tbox::Timer *t_interpolate_velocity_solve;
   static tbox::Timer *t_interpolate_velocity_solve_start_barrier;
   static tbox::Timer *t_compute_lagrangian_force;
@@ -49,9 +65,9 @@ namespace
   static tbox::Timer *t_compute_lagrangian_force_position_ghost_update;
   static tbox::Timer *t_compute_lagrangian_force_setup_force_and_strain;
   static tbox::Timer *t_compute_lagrangian_force_pk1;
-  static tbox::Timer *t_compute_lagrangian_force_pre_compress_barrier;
   static tbox::Timer *t_compute_lagrangian_force_compress_vector;
   static tbox::Timer *t_compute_lagrangian_force_solve;
+  static tbox::Timer *t_compute_lagrangian_force_implicit_solve;
   static tbox::Timer *t_spread_force;
   static tbox::Timer *t_spread_force_start_barrier;
   static tbox::Timer *t_compute_lagrangian_fluid_source;
@@ -69,6 +85,258 @@ namespace fdl
   using namespace dealii;
   using namespace SAMRAI;
 
+  namespace
+  {
+    /**
+     * Wait for several groups of MPI requests and call
+     * <code>process(i)</code> as soon as every request in group @p i has
+     * completed (i.e., groups are processed in the order in which their
+     * communication finishes, not in order). This lets us compute with one
+     * part's data while the other parts are still communicating.
+     */
+    template <typename F>
+    void
+    process_as_completed(const std::vector<std::vector<MPI_Request>> &groups,
+                         const F                                     &process)
+    {
+      std::vector<MPI_Request>  requests;
+      std::vector<std::size_t>  request_groups;
+      std::vector<unsigned int> n_remaining(groups.size());
+      for (std::size_t group_n = 0; group_n < groups.size(); ++group_n)
+        for (const MPI_Request &request : groups[group_n])
+          if (request != MPI_REQUEST_NULL)
+            {
+              requests.push_back(request);
+              request_groups.push_back(group_n);
+              ++n_remaining[group_n];
+            }
+
+      for (std::size_t group_n = 0; group_n < groups.size(); ++group_n)
+        if (n_remaining[group_n] == 0)
+          process(group_n);
+
+      std::vector<int> indices(requests.size());
+      std::size_t      n_completed = 0;
+      while (n_completed < requests.size())
+        {
+          int       n_done = 0;
+          const int ierr   = MPI_Waitsome(requests.size(),
+                                        requests.data(),
+                                        &n_done,
+                                        indices.data(),
+                                        MPI_STATUSES_IGNORE);
+          AssertThrowMPI(ierr);
+          // Inactive persistent requests are treated like MPI_REQUEST_NULL,
+          // so this should only happen if there is a bug in our bookkeeping
+          AssertThrow(n_done != MPI_UNDEFINED, ExcFDLInternalError());
+          for (int i = 0; i < n_done; ++i)
+            {
+              const std::size_t group_n = request_groups[indices[i]];
+              // Waitsome does not null out persistent requests, so make sure
+              // we do not count them twice
+              requests[indices[i]] = MPI_REQUEST_NULL;
+              if (--n_remaining[group_n] == 0)
+                process(group_n);
+            }
+          n_completed += n_done;
+        }
+    }
+
+
+
+    /**
+     * Return the number of the group containing each part, given the groups
+     * of parts sharing an interaction object.
+     */
+    std::vector<unsigned int>
+    get_group_numbers(const std::vector<std::vector<unsigned int>> &groups)
+    {
+      std::vector<unsigned int> group_numbers;
+      for (unsigned int group_n = 0; group_n < groups.size(); ++group_n)
+        for (const unsigned int i : groups[group_n])
+          {
+            if (i >= group_numbers.size())
+              group_numbers.resize(i + 1);
+            group_numbers[i] = group_n;
+          }
+      return group_numbers;
+    }
+
+
+
+    /**
+     * Group the parts in @p collection whose mass systems can be solved
+     * together, i.e., parts with the same mass operator which either all use
+     * or all do not use pipelined CG. Parts which do not need a solve (since
+     * their projection is interpolation or, if @p spreading is true, since
+     * they spread nodal forces, or since they use the lumped mass matrix) are
+     * always in their own group. Parts for which
+     * @p skip_parts is true are not in any group. Groups are sorted by their
+     * first part and the result is the same on every processor.
+     */
+    template <typename Collection, typename Interactions>
+    std::vector<std::vector<unsigned int>>
+    group_mass_solves(const Collection        &collection,
+                      const Interactions      &interactions,
+                      const bool               spreading,
+                      const std::vector<bool> &lumped_mass,
+                      const std::vector<bool> &skip_parts = {})
+    {
+      auto needs_solve = [&](const unsigned int i)
+      {
+        const bool is_direct =
+          spreading ? interactions[i]->spreading_is_nodal() :
+                      interactions[i]->projection_is_interpolation();
+        return !is_direct && !lumped_mass[i];
+      };
+
+      std::vector<std::vector<unsigned int>> groups;
+      for (unsigned int i = 0; i < collection.size(); ++i)
+        {
+          if (i < skip_parts.size() && skip_parts[i])
+            continue;
+          auto same_mass_operator = [&](const std::vector<unsigned int> &group)
+          {
+            const unsigned int j = group.front();
+            return needs_solve(j) &&
+                   collection[j].has_same_mass_operator(collection[i]) &&
+                   collection[j].uses_pipelined_mass_solver() ==
+                     collection[i].uses_pipelined_mass_solver();
+          };
+          const auto it =
+            !needs_solve(i) ?
+              groups.end() :
+              std::find_if(groups.begin(), groups.end(), same_mass_operator);
+          if (it == groups.end())
+            groups.push_back({i});
+          else
+            it->push_back(i);
+        }
+      return groups;
+    }
+
+
+
+    /**
+     * Return @p groups without the parts for which @p skip_parts is true.
+     * Groups which become empty are removed.
+     */
+    std::vector<std::vector<unsigned int>>
+    remove_parts(const std::vector<std::vector<unsigned int>> &groups,
+                 const std::vector<bool>                      &skip_parts)
+    {
+      std::vector<std::vector<unsigned int>> result;
+      for (const std::vector<unsigned int> &group : groups)
+        {
+          std::vector<unsigned int> new_group;
+          for (const unsigned int i : group)
+            if (!skip_parts[i])
+              new_group.push_back(i);
+          if (new_group.size() > 0)
+            result.push_back(std::move(new_group));
+        }
+      return result;
+    }
+
+
+
+    /**
+     * Solve the mass systems of all parts in @p group (as computed by
+     * group_mass_solves()) at once with Part::solve_mass_systems(). Solution
+     * vectors are indexed by position in the group while all other arguments
+     * are indexed by part. Each part's initial guess is used and then
+     * updated.
+     *
+     * If @p adaptive_tolerance_factor is positive then the relative tolerance
+     * of each system is increased to that factor times the relative change in
+     * its right-hand side since the last solve (see
+     * InitialGuess::compute_rhs_change()). Since all systems in the group are
+     * solved together, the smallest such tolerance is used.
+     *
+     * If @p autotuners is not nullptr and contains an entry for the first
+     * part of the group then the number of preconditioner corrections is
+     * given by that Autotuner, which is also given the time of the solve.
+     *
+     * The total number of iterations is added to PhaseTimings.
+     */
+    template <typename Collection, typename Guesses, typename Vectors>
+    std::vector<unsigned int>
+    solve_mass_group(
+      const Collection                &collection,
+      const std::vector<unsigned int> &group,
+      Guesses                         &guesses,
+      const std::vector<LinearAlgebra::distributed::Vector<double> *>
+                        &solutions,
+      const Vectors     &right_hand_sides,
+      const unsigned int max_iterations,
+      const double       relative_tolerance,
+      const double       adaptive_tolerance_factor,
+      std::vector<Autotuner> *autotuners)
+    {
+      std::vector<const LinearAlgebra::distributed::Vector<double> *>
+             group_right_hand_sides;
+      double group_tolerance = std::numeric_limits<double>::max();
+      for (std::size_t k = 0; k < group.size(); ++k)
+        {
+          const auto &rhs       = right_hand_sides[group[k]];
+          double      tolerance = relative_tolerance;
+          if (adaptive_tolerance_factor > 0.0)
+            {
+              // The solver checks the residual of the initial guess first,
+              // so no iterations are done when the guess is already
+              // accurate enough
+              const double rhs_change =
+                guesses[group[k]].compute_rhs_change(rhs);
+              const double rhs_norm = rhs.l2_norm();
+              if (rhs_change >= 0.0 && rhs_norm > 0.0)
+                tolerance =
+                  std::max(tolerance,
+                           adaptive_tolerance_factor * rhs_change / rhs_norm);
+            }
+          group_tolerance = std::min(group_tolerance, tolerance);
+          guesses[group[k]].guess(*solutions[k], rhs);
+          group_right_hand_sides.push_back(&rhs);
+        }
+      const auto               &part = collection[group.front()];
+      std::vector<unsigned int> iterations;
+      if (autotuners != nullptr && group.front() < autotuners->size())
+        {
+          const double start_time = MPI_Wtime();
+          iterations              = part.get_geometry()->solve_mass_systems(
+            solutions,
+            group_right_hand_sides,
+            max_iterations,
+            group_tolerance,
+            (*autotuners)[group.front()].get_value(),
+            part.uses_pipelined_mass_solver());
+          const double time = MPI_Wtime() - start_time;
+          // Parts which are solved together are always tuned together
+          bool just_tuned = false;
+          for (const unsigned int i : group)
+            just_tuned =
+              (*autotuners)[i].add_time(time, part.get_communicator());
+          if (just_tuned && IBTK::IBTK_MPI::getRank() == 0)
+            for (const unsigned int i : group)
+              tbox::plog << "IFEDMethod: part " << i << " uses "
+                         << (*autotuners)[i].get_value()
+                         << " mass preconditioner corrections." << std::endl;
+        }
+      else
+        iterations = part.solve_mass_systems(solutions,
+                                             group_right_hand_sides,
+                                             max_iterations,
+                                             group_tolerance);
+      for (std::size_t k = 0; k < group.size(); ++k)
+        guesses[group[k]].submit(*solutions[k],
+                                 right_hand_sides[group[k]],
+                                 iterations[k]);
+      PhaseTimings::get().add(
+        "fdl::IFEDMethod[mass_solver_iterations]",
+        std::accumulate(iterations.begin(), iterations.end(), 0.0));
+      return iterations;
+    }
+  } // namespace
+
   //
   // Initialization
   //
@@ -103,9 +371,27 @@ namespace fdl
                           input_db->getDatabase("GriddingAlgorithm"),
                           input_db->getDatabase("LoadBalancer"))
   {
+    // IFEDMethodBase disables threads since IBAMR does not use them - only
+    // turn them back on if they are explicitly requested for interaction.
+    const int n_interaction_threads =
+      input_db->getIntegerWithDefault("n_interaction_threads", 1);
+    AssertThrow(n_interaction_threads > 0,
+                ExcMessage("n_interaction_threads should be positive"));
+    interaction_execution_policy = ExecutionPolicy(
+      n_interaction_threads,
+      to_thread_partitioning(input_db->getStringWithDefault(
+        "interaction_thread_partitioning", "DYNAMIC")));
+    if (!interaction_execution_policy.is_serial())
+      MultithreadInfo::set_thread_limit(
+        interaction_execution_policy.get_n_threads());
+
+    trace_file_name = input_db->getStringWithDefault("trace_file", "");
+    if (!trace_file_name.empty())
+      Tracer::get().enable(IBTK::IBTK_MPI::getCommunicator());
+
     const std::string interaction =
       input_db->getStringWithDefault("interaction", "ELEMENTAL");
-    if (interaction == "ELEMENTAL")
+    if (interaction == "ELEMENTAL" || interaction == "HYBRID")
       {
         AssertThrow(this->n_surface_parts() == 0, ExcFDLNotImplemented());
         // IBFEMethod uses this value - lower values aren't guaranteed to work.
@@ -128,10 +414,35 @@ namespace fdl
         else
           AssertThrow(false, ExcFDLNotImplemented());
 
+        // Like the kernels, the initial guess method is either one value or
+        // one per part. Surface parts always use projection.
+        std::vector<InitialGuessMethod> guess_methods(
+          this->n_parts(), InitialGuessMethod::Projection);
+        if (input_db->keyExists("initial_guess_method"))
+          {
+            const int n_methods =
+              input_db->getArraySize("initial_guess_method");
+            AssertThrow(n_methods == 1 ||
+                          n_methods == static_cast<int>(this->n_parts()),
+                        ExcMessage("The number of specified initial guess "
+                                   "methods should either be 1 or equal the "
+                                   "number of parts."));
+            std::vector<std::string> method_names(n_methods);
+            input_db->getStringArray("initial_guess_method",
+                                     method_names.data(),
+                                     n_methods);
+            for (unsigned int i = 0; i < this->n_parts(); ++i)
+              guess_methods[i] =
+                to_initial_guess_method(method_names[n_methods == 1 ? 0 : i]);
+          }
+        const std::vector<InitialGuessMethod> surface_guess_methods(
+          this->n_surface_parts(), InitialGuessMethod::Projection);
+
         auto init_elemental = [&](auto       &inters,
                                   auto       &guess_1,
                                   auto       &guess_2,
-                                  const auto &collection)
+                                  const auto &collection,
+                                  const auto &methods)
         {
           constexpr int structdim =
             std::remove_reference_t<decltype(collection[0])>::dimension;
@@ -139,23 +450,34 @@ namespace fdl
             {
               const unsigned int n_points_1D =
                 collection[i].get_dof_handler().get_fe().tensor_degree() + 1;
-              inters.emplace_back(
-                std::make_unique<ElementalInteraction<structdim, spacedim>>(
-                  n_points_1D, density, density_kind));
+              // Hybrid interaction spreads like elemental interaction, so
+              // it needs the same quadrature parameters
+              if (interaction == "HYBRID")
+                inters.emplace_back(
+                  std::make_unique<HybridInteraction<structdim, spacedim>>(
+                    n_points_1D, density, density_kind));
+              else
+                inters.emplace_back(
+                  std::make_unique<ElementalInteraction<structdim, spacedim>>(
+                    n_points_1D, density, density_kind));
               guess_1.emplace_back(
-                input_db->getIntegerWithDefault("n_guess_vectors", 3));
+                input_db->getIntegerWithDefault("n_guess_vectors", 3),
+                methods[i]);
               guess_2.emplace_back(
-                input_db->getIntegerWithDefault("n_guess_vectors", 3));
+                input_db->getIntegerWithDefault("n_guess_vectors", 3),
+                methods[i]);
             }
         };
         init_elemental(interactions,
                        force_guesses,
                        velocity_guesses,
-                       this->parts);
+                       this->parts,
+                       guess_methods);
         init_elemental(surface_interactions,
                        surface_force_guesses,
                        surface_velocity_guesses,
-                       this->surface_parts);
+                       this->surface_parts,
+                       surface_guess_methods);
       }
     else if (interaction == "NODAL")
       {
@@ -179,7 +501,8 @@ namespace fdl
 
     auto do_kernel = [&](const std::string        &key,
                          const auto               &collection,
-                         std::vector<std::string> &kernels)
+                         std::vector<std::string> &kernels,
+                         std::vector<int>         &ghost_widths)
     {
       if (collection.size() > 0)
         {
@@ -205,28 +528,272 @@ namespace fdl
               std::fill(kernels.begin() + 1, kernels.end(), kernels.front());
             }
 
-          // now that we know that, we know the ghost requirements
+          // now that we know that, we know the ghost requirements. These
+          // are combined into ghosts once we know which surface parts are
+          // traces.
           for (const std::string &kernel : kernels)
+            ghost_widths.push_back(
+              IBTK::LEInteractor::getMinimumGhostWidth(kernel));
+        }
+    };
+    do_kernel("IB_kernel", this->parts, ib_kernels, ib_kernel_ghost_widths);
+    do_kernel("surface_IB_kernel",
+              this->surface_parts,
+              surface_ib_kernels,
+              surface_ib_kernel_ghost_widths);
+
+    // Parts with the same PartGeometry and IB kernel may share one interaction
+    // object (and hence one overlap triangulation and set of scatters).
+    const bool share_interactions =
+      input_db->getBoolWithDefault("share_part_interactions", false);
+    AssertThrow(!share_interactions || interaction == "ELEMENTAL",
+                ExcMessage("share_part_interactions requires elemental "
+                           "interaction."));
+    AssertThrow(!share_interactions ||
+                  !input_db->getBoolWithDefault(
+                    "calibrate_interaction_workload", false),
+                ExcMessage("Workload calibration measures each interaction "
+                           "object, so it cannot be used with "
+                           "share_part_interactions."));
+    auto do_groups = [&](const auto                     &collection,
+                         const std::vector<std::string> &kernels,
+                         auto                           &inters,
+                         auto                           &groups)
+    {
+      for (unsigned int i = 0; i < collection.size(); ++i)
+        {
+          auto same_interaction = [&](const std::vector<unsigned int> &group)
+          {
+            const unsigned int j = group.front();
+            return collection[j].get_geometry() ==
+                     collection[i].get_geometry() &&
+                   kernels[j] == kernels[i];
+          };
+          const auto it =
+            !share_interactions ?
+              groups.end() :
+              std::find_if(groups.begin(), groups.end(), same_interaction);
+          if (it == groups.end())
+            groups.push_back({i});
+          else
             {
-              const int ghost_width =
-                IBTK::LEInteractor::getMinimumGhostWidth(kernel);
-              for (int d = 0; d < spacedim; ++d)
-                ghosts[d] = std::max(ghosts[d], ghost_width);
+              it->push_back(i);
+              inters[i] = inters[it->front()];
             }
         }
     };
-    do_kernel("IB_kernel", this->parts, ib_kernels);
-    do_kernel("surface_IB_kernel", this->surface_parts, surface_ib_kernels);
+    do_groups(this->parts, ib_kernels, interactions, interaction_groups);
+    do_groups(this->surface_parts,
+              surface_ib_kernels,
+              surface_interactions,
+              surface_interaction_groups);
+
+    // Like the kernels, the mass projection is either one value or one per
+    // part. Surface parts always use the consistent mass matrix.
+    lumped_mass_projection.resize(this->n_parts(), false);
+    surface_lumped_mass_projection.resize(this->n_surface_parts(), false);
+    if (input_db->keyExists("mass_projection"))
+      {
+        const int n_projections = input_db->getArraySize("mass_projection");
+        AssertThrow(n_projections == 1 ||
+                      n_projections == static_cast<int>(this->n_parts()),
+                    ExcMessage("The number of specified mass projections "
+                               "should either be 1 or equal the number of "
+                               "parts."));
+        std::vector<std::string> projections(n_projections);
+        input_db->getStringArray("mass_projection",
+                                 projections.data(),
+                                 n_projections);
+        for (unsigned int i = 0; i < this->n_parts(); ++i)
+          {
+            const std::string &projection =
+              projections[n_projections == 1 ? 0 : i];
+            AssertThrow(projection == "CONSISTENT" || projection == "LUMPED",
+                        ExcMessage("unsupported mass projection " +
+                                   projection + "."));
+            lumped_mass_projection[i] = projection == "LUMPED";
+          }
+      }
+    const int n_corrections =
+      input_db->getIntegerWithDefault("mass_projection_corrections", 0);
+    AssertThrow(n_corrections >= 0,
+                ExcMessage("mass_projection_corrections should not be "
+                           "negative"));
+    n_mass_projection_corrections = n_corrections;
+
+    // Parts whose stresses are evaluated implicitly
+    implicit_solvers.resize(this->n_parts());
+    if (input_db->keyExists("implicit_parts"))
+      {
+        const int        n_implicit = input_db->getArraySize("implicit_parts");
+        std::vector<int> implicit_parts(n_implicit);
+        input_db->getIntegerArray("implicit_parts",
+                                  implicit_parts.data(),
+                                  n_implicit);
+        for (const int part_n : implicit_parts)
+          {
+            AssertThrow(0 <= part_n &&
+                          part_n < static_cast<int>(this->n_parts()),
+                        ExcMessage("implicit_parts contains an invalid part "
+                                   "number."));
+            implicit_solvers[part_n] =
+              std::make_unique<ImplicitStructureSolver<dim>>(
+                this->parts[part_n],
+                input_db->getIntegerWithDefault("implicit_newton_iterations",
+                                                10),
+                input_db->getDoubleWithDefault("implicit_newton_tolerance",
+                                               1e-8),
+                input_db->getIntegerWithDefault("solver_iterations", 100));
+          }
+      }
+    // Parts which move rigidly
+    rigid_projections.resize(this->n_parts());
+    is_rigid_part.resize(this->n_parts(), false);
+    if (input_db->keyExists("rigid_parts"))
+      {
+        AssertThrow(input_db->getStringWithDefault("interaction",
+                                                   "ELEMENTAL") != "NODAL",
+                    ExcMessage("Rigid parts require elemental or hybrid "
+                               "interaction."));
+        const int        n_rigid = input_db->getArraySize("rigid_parts");
+        std::vector<int> rigid_parts(n_rigid);
+        input_db->getIntegerArray("rigid_parts", rigid_parts.data(), n_rigid);
+        for (const int part_n : rigid_parts)
+          {
+            AssertThrow(0 <= part_n &&
+                          part_n < static_cast<int>(this->n_parts()),
+                        ExcMessage("rigid_parts contains an invalid part "
+                                   "number."));
+            AssertThrow(!implicit_solvers[part_n],
+                        ExcMessage("Rigid parts cannot also be implicit "
+                                   "parts."));
+            rigid_projections[part_n] =
+              std::make_unique<RigidBodyProjection<dim>>(this->parts[part_n]);
+            is_rigid_part[part_n] = true;
+          }
+      }
+    rigid_constraint_density =
+      input_db->getDoubleWithDefault("rigid_constraint_density", 1.0);
+    AssertThrow(rigid_constraint_density > 0.0,
+                ExcMessage("rigid_constraint_density should be positive"));
+    // Surface parts which are boundary traces of parts
+    surface_trace_parts.resize(this->n_surface_parts(), -1);
+    if (input_db->keyExists("surface_part_traces"))
+      {
+        const int n_traces = input_db->getArraySize("surface_part_traces");
+        AssertThrow(n_traces == static_cast<int>(this->n_surface_parts()),
+                    ExcMessage("surface_part_traces should have one entry "
+                               "per surface part."));
+        input_db->getIntegerArray("surface_part_traces",
+                                  surface_trace_parts.data(),
+                                  n_traces);
+      }
+    // Per-part flags, e.g., parts whose spreading skips cells with zero force
+    auto read_part_numbers = [&](const std::string  &key,
+                                 const unsigned int  n_parts,
+                                 std::vector<bool>  &flags)
+    {
+      flags.resize(n_parts, false);
+      if (input_db->keyExists(key))
+        {
+          const int        n_entries = input_db->getArraySize(key);
+          std::vector<int> part_numbers(n_entries);
+          input_db->getIntegerArray(key, part_numbers.data(), n_entries);
+          for (const int part_n : part_numbers)
+            {
+              AssertThrow(0 <= part_n && part_n < static_cast<int>(n_parts),
+                          ExcMessage(key +
+                                     " contains an invalid part number."));
+              flags[part_n] = true;
+            }
+        }
+    };
+    read_part_numbers("skip_zero_force_parts",
+                      this->n_parts(),
+                      skip_zero_force_cells);
+    read_part_numbers("skip_zero_force_surface_parts",
+                      this->n_surface_parts(),
+                      surface_skip_zero_force_cells);
+    read_part_numbers("stationary_parts",
+                      this->n_parts(),
+                      is_stationary_part);
+    read_part_numbers("stationary_surface_parts",
+                      this->n_surface_parts(),
+                      is_stationary_surface_part);
+    std::vector<bool> pipelined_mass_solver_parts,
+      pipelined_mass_solver_surface_parts;
+    read_part_numbers("pipelined_mass_solver_parts",
+                      this->n_parts(),
+                      pipelined_mass_solver_parts);
+    read_part_numbers("pipelined_mass_solver_surface_parts",
+                      this->n_surface_parts(),
+                      pipelined_mass_solver_surface_parts);
+    for (unsigned int i = 0; i < this->n_parts(); ++i)
+      this->parts[i].set_pipelined_mass_solver(pipelined_mass_solver_parts[i]);
+    for (unsigned int i = 0; i < this->n_surface_parts(); ++i)
+      this->surface_parts[i].set_pipelined_mass_solver(
+        pipelined_mass_solver_surface_parts[i]);
+    surface_part_is_trace.resize(this->n_surface_parts(), false);
+    surface_traces.resize(this->n_surface_parts());
+    for (unsigned int i = 0; i < this->n_surface_parts(); ++i)
+      if (surface_trace_parts[i] >= 0)
+        {
+          AssertThrow(surface_trace_parts[i] <
+                        static_cast<int>(this->n_parts()),
+                      ExcMessage("surface_part_traces contains an invalid "
+                                 "part number."));
+          AssertThrow(!is_rigid_part[surface_trace_parts[i]],
+                      ExcMessage("Surface parts cannot be traces of rigid "
+                                 "parts."));
+          surface_part_is_trace[i] = true;
+          surface_traces[i] = std::make_unique<BoundaryTrace<dim, spacedim>>(
+            this->parts[surface_trace_parts[i]], this->surface_parts[i]);
+        }
 
-    auto set_timer = [&](const char *name)
+    // Boundary traces never interpolate or spread so their kernels do not
+    // need any ghost cells.
+    for (const int ghost_width : ib_kernel_ghost_widths)
+      ghosts.max(hier::IntVector<spacedim>(ghost_width));
+    for (unsigned int i = 0; i < this->n_surface_parts(); ++i)
+      if (!surface_part_is_trace[i])
+        ghosts.max(
+          hier::IntVector<spacedim>(surface_ib_kernel_ghost_widths[i]));
+
+    const unsigned int n_preconditioner_corrections =
+      input_db->getIntegerWithDefault("mass_preconditioner_corrections", 0);
+    for (auto &part : this->parts)
+      part.set_mass_preconditioner_corrections(n_preconditioner_corrections);
+    if (input_db->getBoolWithDefault("use_device_mass_solver", false))
+      for (auto &part : this->parts)
+        if (!part.get_geometry()->has_cellwise_inverse_mass())
+          part.get_geometry()->setup_device_mass_solver();
+
+    implicit_damping = input_db->getDoubleWithDefault("implicit_damping", 1.0);
+    AssertThrow(implicit_damping > 0.0,
+                ExcMessage("implicit_damping should be positive"));
+    const int n_substeps =
+      input_db->getIntegerWithDefault("implicit_substeps", 1);
+    AssertThrow(n_substeps > 0,
+                ExcMessage("implicit_substeps should be positive"));
+    n_implicit_substeps = n_substeps;
+
+    // The timers are shared by all IFEDMethod objects, which may be set up
+    // concurrently.
+    static std::mutex           timers_mutex;
+    std::lock_guard<std::mutex> lock(timers_mutex);
+    auto                        set_timer = [&](const char *name)
     { return tbox::TimerManager::getManager()->getTimer(name); };
 
+    t_max_point_displacement =
+      set_timer("fdl::IFEDMethod::getMaxPointDisplacement()");
     t_interpolate_velocity =
       set_timer("fdl::IFEDMethod::interpolateVelocity()");
     t_interpolate_velocity_start_barrier =
       set_timer("fdl::IFEDMethod::interpolateVelocity()[start_barrier]");
     t_interpolate_velocity_rhs =
       set_timer("fdl::IFEDMethod::interpolateVelocity()[rhs]");
+    t_interpolate_velocity_transfer =
+      set_timer("fdl::IFEDMethod::interpolateVelocity()[transfer]");
     t_interpolate_velocity_solve =
       set_timer("fdl::IFEDMethod::interpolateVelocity()[solve]");
     t_interpolate_velocity_solve_start_barrier =
@@ -241,12 +808,12 @@ namespace fdl
       "fdl::IFEDMethod::computeLagrangianForce()[setup_force_and_strain]");
     t_compute_lagrangian_force_pk1 =
       set_timer("fdl::IFEDMethod::computeLagrangianForce()[pk1]");
-    t_compute_lagrangian_force_pre_compress_barrier = set_timer(
-      "fdl::IFEDMethod::computeLagrangianForce()[pre_compress_barrier]");
     t_compute_lagrangian_force_compress_vector =
       set_timer("fdl::IFEDMethod::computeLagrangianForce()[compress_vector]");
     t_compute_lagrangian_force_solve =
       set_timer("fdl::IFEDMethod::computeLagrangianForce()[solve]");
+    t_compute_lagrangian_force_implicit_solve =
+      set_timer("fdl::IFEDMethod::computeLagrangianForce()[implicit_solve]");
     t_spread_force = set_timer("fdl::IFEDMethod::spreadForce()");
     t_spread_force_start_barrier =
       set_timer("fdl::IFEDMethod::spreadForce()[start_barrier]");
@@ -267,6 +834,21 @@ namespace fdl
       set_timer("fdl::IFEDMethod::reinit_interactions()[objects]");
   }
 
+
+  template <int dim, int spacedim>
+  IFEDMethod<dim, spacedim>::~IFEDMethod()
+  {
+    // Complete any unused position scatters before the interaction objects
+    // are destroyed
+    cancel_spread_position_scatters();
+    if (!trace_file_name.empty())
+      {
+        Tracer::get().write(trace_file_name);
+        Tracer::get().disable();
+        Tracer::get().clear();
+      }
+  }
+
   template <int dim, int spacedim>
   void
   IFEDMethod<dim, spacedim>::initializePatchHierarchy(
@@ -290,10 +872,70 @@ namespace fdl
                                                             init_data_time,
                                                             initial_time);
 
+    // Make sure that boundary traces start at the same position as their
+    // parts (the position is afterwards updated with the restricted
+    // velocity)
+    for (unsigned int i = 0; i < this->n_surface_parts(); ++i)
+      if (surface_traces[i])
+        {
+          const auto &part         = this->parts[surface_trace_parts[i]];
+          auto       &surface_part = this->surface_parts[i];
+          LinearAlgebra::distributed::Vector<double> position(
+            surface_part.get_partitioner());
+          LinearAlgebra::distributed::Vector<double> velocity(
+            surface_part.get_partitioner());
+          surface_traces[i]->restrict_to_surface(part.get_position(), position);
+          surface_traces[i]->restrict_to_surface(part.get_velocity(), velocity);
+          position.update_ghost_values();
+          velocity.update_ghost_values();
+          surface_part.set_position(std::move(position));
+          surface_part.set_velocity(std::move(velocity));
+        }
+
     secondary_hierarchy.reinit(this->patch_hierarchy->getFinestLevelNumber(),
                                this->patch_hierarchy->getFinestLevelNumber(),
                                this->patch_hierarchy);
 
+    // Time the candidate mass solver parameters on the first solves, unless
+    // a previous run already chose them
+    const int n_autotune_trials =
+      input_db->getIntegerWithDefault("autotune_trials", 0);
+    if (n_autotune_trials > 0 && mass_solver_autotuners.size() == 0)
+      {
+        std::vector<int>  candidates{0, 1, 2};
+        const std::string key = "autotune_mass_preconditioner_corrections";
+        if (input_db->keyExists(key))
+          {
+            candidates.resize(input_db->getArraySize(key));
+            input_db->getIntegerArray(key,
+                                      candidates.data(),
+                                      static_cast<int>(candidates.size()));
+          }
+        for (unsigned int i = 0; i < this->n_parts(); ++i)
+          mass_solver_autotuners.emplace_back(candidates, n_autotune_trials);
+
+        auto *restart_manager = tbox::RestartManager::getManager();
+        if (this->register_for_restart && restart_manager->isFromRestart())
+          {
+            auto db = restart_manager->getRootDatabase()->getDatabase(
+              this->object_name);
+            const std::string key = "autotuned_mass_preconditioner_corrections";
+            if (db->keyExists(key))
+              {
+                std::vector<int> values(db->getArraySize(key));
+                db->getIntegerArray(key,
+                                    values.data(),
+                                    static_cast<int>(values.size()));
+                AssertThrow(values.size() == mass_solver_autotuners.size(),
+                            ExcMessage("The number of autotuned parts in the "
+                                       "restart database does not match the "
+                                       "number of parts."));
+                for (unsigned int i = 0; i < values.size(); ++i)
+                  mass_solver_autotuners[i].set_value(values[i]);
+              }
+          }
+      }
+
     reinit_interactions();
   }
 
@@ -301,6 +943,32 @@ namespace fdl
   // FSI
   //
 
+  template <int dim, int spacedim>
+  double
+  IFEDMethod<dim, spacedim>::getMaxPointDisplacement() const
+  {
+    const double max_displacement =
+      input_db->getDoubleWithDefault("interaction_reinit_displacement", 0.0);
+    if (max_displacement <= 0.0 ||
+        positions_at_last_interaction_reinit.size() != this->parts.size() ||
+        surface_positions_at_last_interaction_reinit.size() !=
+          this->surface_parts.size())
+      return IFEDMethodBase<dim, spacedim>::getMaxPointDisplacement();
+
+    ScopedTimer t0(t_max_point_displacement);
+    std::vector<std::vector<double>> displacements =
+      this->compute_max_point_displacements(
+        {std::make_pair(&this->positions_at_last_regrid,
+                        &this->surface_positions_at_last_regrid),
+         std::make_pair(&positions_at_last_interaction_reinit,
+                        &surface_positions_at_last_interaction_reinit)});
+    interaction_reinit_displacements = std::move(displacements[1]);
+    return displacements[0].empty() ?
+             0.0 :
+             *std::max_element(displacements[0].begin(),
+                               displacements[0].end());
+  }
+
   template <int dim, int spacedim>
   void
   IFEDMethod<dim, spacedim>::interpolateVelocity(
@@ -308,7 +976,7 @@ namespace fdl
     const std::vector<tbox::Pointer<xfer::CoarsenSchedule<spacedim>>>
       & /*u_synch_scheds*/,
     const std::vector<tbox::Pointer<xfer::RefineSchedule<spacedim>>>
-      & /*u_ghost_fill_scheds*/,
+          &u_ghost_fill_scheds,
     double data_time)
   {
 #ifdef FDL_ENABLE_TIMER_BARRIERS
@@ -319,19 +987,20 @@ namespace fdl
     }
 #endif
     ScopedTimer t1(t_interpolate_velocity);
-
-    // Update the secondary hierarchy:
-    secondary_hierarchy.transferPrimaryToSecondary(
-      this->patch_hierarchy->getFinestLevelNumber(),
-      u_data_index,
-      u_data_index,
-      data_time,
-      this->d_ib_solver->getVelocityPhysBdryOp());
+    // Boundary traces are not interpolated to: their velocities are
+    // restricted from their parts' velocities at the end
+    const std::vector<std::vector<unsigned int>> surface_groups =
+      remove_parts(surface_interaction_groups, surface_part_is_trace);
 
     IBAMR_TIMER_START(t_interpolate_velocity_rhs);
-    std::vector<MPI_Request> requests;
+    // Requests of each transaction's scatter (parts first, then surface
+    // parts). There is one transaction per interaction group.
+    std::vector<std::vector<MPI_Request>> scatter_requests;
+    const bool cache_positions =
+      input_db->getBoolWithDefault("cache_overlap_positions", true);
     // native to overlap:
     auto scatter_start = [&](const auto &collection,
+                             const auto &groups,
                              const auto &interactions,
                              const auto &kernels,
                              const auto &vectors,
@@ -340,146 +1009,300 @@ namespace fdl
     {
       for (unsigned int i = 0; i < collection.size(); ++i)
         {
-          const auto &part = collection[i];
-          AssertThrow(vectors.dimension == part.dimension,
+          AssertThrow(vectors.dimension == collection[i].dimension,
                       ExcFDLInternalError());
-          rhs_vectors.emplace_back(part.get_partitioner());
+          rhs_vectors.push_back(vectors.get_spare_vector(i));
+        }
+      for (const std::vector<unsigned int> &group : groups)
+        {
+          const unsigned int i    = group.front();
+          const auto        &part = collection[i];
+          std::vector<const LinearAlgebra::distributed::Vector<double> *>
+            positions;
+          std::vector<LinearAlgebra::distributed::Vector<double> *> rhs;
+          for (const unsigned int j : group)
+            {
+              positions.push_back(&vectors.get_position(j, data_time));
+              if (cache_positions)
+                interactions[i]->set_position_version(
+                  *positions.back(),
+                  vectors.get_position_version(j, data_time));
+              rhs.push_back(&rhs_vectors[j]);
+            }
+          TraceScope trace("compute_projection_rhs_scatter_start",
+                           "transaction",
+                           i);
           transactions.emplace_back(
             interactions[i]->compute_projection_rhs_scatter_start(
               kernels[i],
               u_data_index,
               part.get_dof_handler(),
-              vectors.get_position(i, data_time),
+              positions,
               part.get_dof_handler(),
               part.get_mapping(),
-              rhs_vectors[i]));
-          auto current_requests =
-            transactions[i]->delegate_outstanding_requests();
-          requests.insert(requests.end(),
-                          current_requests.begin(),
-                          current_requests.end());
+              rhs));
+          scatter_requests.emplace_back(
+            transactions.back()->delegate_outstanding_requests());
         }
     };
-    auto scatter_finish = [](const auto &interactions, auto &transactions)
-    {
-      for (unsigned int i = 0; i < interactions.size(); ++i)
-        transactions[i] =
-          interactions[i]->compute_projection_rhs_scatter_finish(
-            std::move(transactions[i]));
-    };
     // we emplace_back so use a deque to keep pointers valid
     std::vector<std::unique_ptr<TransactionBase>> transactions,
       surface_transactions;
     std::deque<LinearAlgebra::distributed::Vector<double>> rhs_vecs,
       surface_rhs_vecs;
     scatter_start(this->parts,
+                  interaction_groups,
                   interactions,
                   ib_kernels,
                   this->part_vectors,
                   transactions,
                   rhs_vecs);
     scatter_start(this->surface_parts,
+                  surface_groups,
                   surface_interactions,
                   surface_ib_kernels,
                   this->surface_part_vectors,
                   surface_transactions,
                   surface_rhs_vecs);
-    int ierr =
-      MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
-    AssertThrowMPI(ierr);
-    requests.resize(0);
-    scatter_finish(interactions, transactions);
-    scatter_finish(surface_interactions, surface_transactions);
-
-    // Compute:
-    auto compute_transaction = [](const auto &interactions, auto &transactions)
-    {
-      for (unsigned int i = 0; i < interactions.size(); ++i)
-        transactions[i] = interactions[i]->compute_projection_rhs_intermediate(
-          std::move(transactions[i]));
-    };
-    compute_transaction(interactions, transactions);
-    compute_transaction(surface_interactions, surface_transactions);
 
-    // Move back:
-    auto accumulate_start = [&](const auto &interactions, auto &transactions)
+    // The position scatters do not depend on Eulerian data, so update the
+    // interaction hierarchy while they are in flight:
     {
-      for (unsigned int i = 0; i < interactions.size(); ++i)
+      ScopedTimer t2(t_interpolate_velocity_transfer);
+      TraceScope  trace("interpolateVelocity()[transfer]", "eulerian");
+      const int   ln = this->patch_hierarchy->getFinestLevelNumber();
+      if (bypass_secondary_hierarchy)
         {
-          transactions[i] =
-            interactions[i]->compute_projection_rhs_accumulate_start(
-              std::move(transactions[i]));
-          auto current_requests =
-            transactions[i]->delegate_outstanding_requests();
-          requests.insert(requests.end(),
-                          current_requests.begin(),
-                          current_requests.end());
+          if (std::size_t(ln) < u_ghost_fill_scheds.size() &&
+              u_ghost_fill_scheds[ln])
+            u_ghost_fill_scheds[ln]->fillData(data_time);
         }
-    };
-    auto accumulate_finish = [](const auto &interactions, auto &transactions)
+      else
+        secondary_hierarchy.transferPrimaryToSecondary(
+          ln,
+          u_data_index,
+          u_data_index,
+          data_time,
+          this->d_ib_solver->getVelocityPhysBdryOp());
+    }
+
+    // As soon as a part's data arrives: finish its scatter, compute, and start
+    // moving the result back. This overlaps computations on parts whose data
+    // has arrived with communication for the others.
+    const bool time_interactions =
+      input_db->getBoolWithDefault("calibrate_interaction_workload", false) ||
+      input_db->getBoolWithDefault("workload_diagnostics", false);
+    interaction_times.resize(interactions.size());
+    surface_interaction_times.resize(surface_interactions.size());
+    auto compute_transaction = [&](const auto          &groups,
+                                   const auto          &interactions,
+                                   auto                &transactions,
+                                   std::vector<double> &times,
+                                   const unsigned int   group_n)
     {
-      for (unsigned int i = 0; i < interactions.size(); ++i)
-        interactions[i]->compute_projection_rhs_accumulate_finish(
-          std::move(transactions[i]));
+      // Workload calibration is not used with shared interactions, so each
+      // group has one part in that case
+      const unsigned int i           = groups[group_n].front();
+      auto              &transaction = transactions[group_n];
+      {
+        TraceScope trace("compute_projection_rhs_scatter_finish",
+                         "transaction",
+                         i);
+        transaction = interactions[i]->compute_projection_rhs_scatter_finish(
+          std::move(transaction));
+      }
+      const double start_time = time_interactions ? MPI_Wtime() : 0.0;
+      {
+        TraceScope trace("compute_projection_rhs_intermediate",
+                         "transaction",
+                         i);
+        transaction = interactions[i]->compute_projection_rhs_intermediate(
+          std::move(transaction));
+      }
+      if (time_interactions)
+        times[i] += MPI_Wtime() - start_time;
+      TraceScope trace("compute_projection_rhs_accumulate_start",
+                       "transaction",
+                       i);
+      transaction = interactions[i]->compute_projection_rhs_accumulate_start(
+        std::move(transaction));
+      return transaction->delegate_outstanding_requests();
     };
-    accumulate_start(interactions, transactions);
-    accumulate_start(surface_interactions, surface_transactions);
-    ierr = MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
-    AssertThrowMPI(ierr);
-    requests.resize(0);
-    accumulate_finish(interactions, transactions);
-    accumulate_finish(surface_interactions, surface_transactions);
-
+    // Requests of each transaction's accumulation, indexed like
+    // scatter_requests
+    std::vector<std::vector<MPI_Request>> accumulate_requests(
+      scatter_requests.size());
+    process_as_completed(scatter_requests,
+                         [&](const std::size_t k)
+                         {
+                           if (k < interaction_groups.size())
+                             accumulate_requests[k] =
+                               compute_transaction(interaction_groups,
+                                                   interactions,
+                                                   transactions,
+                                                   interaction_times,
+                                                   k);
+                           else
+                             accumulate_requests[k] = compute_transaction(
+                               surface_groups,
+                               surface_interactions,
+                               surface_transactions,
+                               surface_interaction_times,
+                               k - interaction_groups.size());
+                         });
     IBAMR_TIMER_STOP(t_interpolate_velocity_rhs);
-    // We cannot start the linear solve without first finishing this, so use a
-    // barrier to keep the timers accurate
+
 #ifdef FDL_ENABLE_TIMER_BARRIERS
     {
       ScopedTimer t2(t_interpolate_velocity_solve_start_barrier);
-      ierr = MPI_Barrier(IBTK::IBTK_MPI::getCommunicator());
+      const int   ierr = MPI_Barrier(IBTK::IBTK_MPI::getCommunicator());
       AssertThrowMPI(ierr);
     }
 #endif
 
     // Project:
     ScopedTimer t3(t_interpolate_velocity_solve);
-    auto        do_solve = [&](const auto &collection,
-                        const auto &interactions,
-                        auto       &vectors,
-                        auto       &guesses,
-                        auto       &rhs_vectors)
+    //
+    // Move each part's right-hand side back and solve as soon as its own
+    // accumulation is done, so that the remaining accumulations overlap with
+    // the solves. The solves use collective communication on each part's
+    // communicator so they must be done in the same order on every
+    // processor: hence we wait on each part in order instead of using
+    // process_as_completed(). Parts with the same mass operator are solved
+    // together.
+    auto        do_solve = [&](const auto              &collection,
+                        const auto              &interaction_groups,
+                        const auto              &interactions,
+                        auto                    &transactions,
+                        auto                    &vectors,
+                        auto                    &guesses,
+                        auto                    &rhs_vectors,
+                        const std::vector<bool> &lumped_mass,
+                        const std::vector<bool> &rigid,
+                        const std::vector<bool> &skip_parts,
+                        const std::size_t        request_offset,
+                        std::vector<Autotuner>  *autotuners)
     {
-      for (unsigned int i = 0; i < collection.size(); ++i)
+      const std::vector<unsigned int> group_numbers =
+        get_group_numbers(interaction_groups);
+      // Rigid parts do not need mass solves either
+      std::vector<bool> no_mass_solve = lumped_mass;
+      for (std::size_t i = 0; i < rigid.size(); ++i)
+        no_mass_solve[i] = no_mass_solve[i] || rigid[i];
+      for (const auto &group : group_mass_solves(collection,
+                                                 interactions,
+                                                 false,
+                                                 no_mass_solve,
+                                                 skip_parts))
         {
-          if (interactions[i]->projection_is_interpolation())
+          for (const unsigned int i : group)
+            {
+              // Transactions are shared by all parts in an interaction group,
+              // so this one may have already been finished
+              const unsigned int group_n = group_numbers[i];
+              if (!transactions[group_n])
+                continue;
+              auto &current_requests =
+                accumulate_requests[request_offset + group_n];
+              TraceScope trace("compute_projection_rhs_accumulate_finish",
+                               "transaction",
+                               i);
+              const int  ierr = MPI_Waitall(current_requests.size(),
+                                           current_requests.data(),
+                                           MPI_STATUSES_IGNORE);
+              AssertThrowMPI(ierr);
+              interactions[i]->compute_projection_rhs_accumulate_finish(
+                std::move(transactions[group_n]));
+            }
+
+          if (group.size() > 1)
+            {
+              std::vector<LinearAlgebra::distributed::Vector<double>>
+                velocities;
+              std::vector<LinearAlgebra::distributed::Vector<double> *>
+                solutions;
+              velocities.reserve(group.size());
+              for (const unsigned int i : group)
+                {
+                  velocities.push_back(vectors.get_spare_vector(i));
+                  solutions.push_back(&velocities.back());
+                }
+              const std::vector<unsigned int> iterations = solve_mass_group(
+                collection,
+                group,
+                guesses,
+                solutions,
+                rhs_vectors,
+                input_db->getIntegerWithDefault("solver_iterations", 100),
+                input_db->getDoubleWithDefault("solver_relative_tolerance",
+                                               1e-6),
+                input_db->getDoubleWithDefault(
+                  "solver_adaptive_tolerance_factor", 0.0),
+                autotuners);
+              for (std::size_t k = 0; k < group.size(); ++k)
+                {
+                  vectors.set_velocity(group[k],
+                                       data_time,
+                                       std::move(velocities[k]));
+                  if (input_db->getBoolWithDefault("log_solver_iterations",
+                                                   false))
+                    {
+                      tbox::plog << "IFEDMethod::interpolateVelocity(): "
+                                 << "batched CG converged in " << iterations[k]
+                                 << " steps." << std::endl;
+                    }
+                }
+              continue;
+            }
+
+          const unsigned int i = group.front();
+          if (i < rigid.size() && rigid[i])
+            {
+              // The velocity only depends on the momenta of the right-hand
+              // side
+              LinearAlgebra::distributed::Vector<double> velocity =
+                vectors.get_spare_vector(i);
+              rigid_projections[i]->project(vectors.get_position(i, data_time),
+                                            rhs_vectors[i],
+                                            velocity);
+              vectors.set_velocity(i, data_time, std::move(velocity));
+            }
+          else if (interactions[i]->projection_is_interpolation())
             {
               // If projection is actually interpolation we have a lot less to
-              // do
+              // do: only make the velocity continuous at hanging nodes
+              const auto &geometry = *collection[i].get_geometry();
+              if (geometry.has_constraints())
+                geometry.get_constraints().distribute(rhs_vectors[i]);
               vectors.set_velocity(i, data_time, std::move(rhs_vectors[i]));
             }
+          else if (lumped_mass[i])
+            {
+              LinearAlgebra::distributed::Vector<double> velocity =
+                vectors.get_spare_vector(i);
+              collection[i].apply_approximate_mass_inverse(
+                velocity, rhs_vectors[i], n_mass_projection_corrections);
+              vectors.set_velocity(i, data_time, std::move(velocity));
+            }
           else
             {
-              const auto   &part = collection[i];
-              SolverControl control(
+              const auto &part = collection[i];
+              LinearAlgebra::distributed::Vector<double> velocity =
+                vectors.get_spare_vector(i);
+              const unsigned int n_iterations = solve_mass_group(
+                collection,
+                group,
+                guesses,
+                {&velocity},
+                rhs_vectors,
                 input_db->getIntegerWithDefault("solver_iterations", 100),
                 input_db->getDoubleWithDefault("solver_relative_tolerance",
-                                               1e-6) *
-                  rhs_vectors[i].l2_norm());
-              SolverCG<LinearAlgebra::distributed::Vector<double>> cg(control);
-              LinearAlgebra::distributed::Vector<double>           velocity(
-                part.get_partitioner());
-
+                                               1e-6),
+                input_db->getDoubleWithDefault(
+                  "solver_adaptive_tolerance_factor", 0.0),
+                autotuners)[0];
               // If we mess up the matrix-free implementation will fix our
               // partitioner: make sure we catch that case here
-              Assert(velocity.get_partitioner() == part.get_partitioner(),
-                     ExcFDLInternalError());
-              guesses[i].guess(velocity, rhs_vectors[i]);
-              cg.solve(part.get_mass_operator(),
-                       velocity,
-                       rhs_vectors[i],
-                       part.get_mass_preconditioner());
-              guesses[i].submit(velocity, rhs_vectors[i]);
-              // Same
               Assert(velocity.get_partitioner() == part.get_partitioner(),
                      ExcFDLInternalError());
               vectors.set_velocity(i, data_time, std::move(velocity));
@@ -487,22 +1310,49 @@ namespace fdl
               if (input_db->getBoolWithDefault("log_solver_iterations", false))
                 {
                   tbox::plog << "IFEDMethod::interpolateVelocity(): "
-                             << "SolverCG<> converged in "
-                             << control.last_step() << " steps." << std::endl;
+                             << "CG converged in " << n_iterations
+                             << " steps." << std::endl;
                 }
             }
         }
     };
     do_solve(this->parts,
+             interaction_groups,
              interactions,
+             transactions,
              this->part_vectors,
              velocity_guesses,
-             rhs_vecs);
+             rhs_vecs,
+             lumped_mass_projection,
+             is_rigid_part,
+             {},
+             0,
+             &mass_solver_autotuners);
     do_solve(this->surface_parts,
+             surface_groups,
              surface_interactions,
+             surface_transactions,
              this->surface_part_vectors,
              surface_velocity_guesses,
-             surface_rhs_vecs);
+             surface_rhs_vecs,
+             surface_lumped_mass_projection,
+             {},
+             surface_part_is_trace,
+             interaction_groups.size(),
+             nullptr);
+
+    for (unsigned int i = 0; i < this->n_surface_parts(); ++i)
+      if (surface_traces[i])
+        {
+          LinearAlgebra::distributed::Vector<double> velocity =
+            this->surface_part_vectors.get_spare_vector(i);
+          surface_traces[i]->restrict_to_surface(
+            this->part_vectors.get_velocity(surface_trace_parts[i], data_time),
+            velocity);
+          this->surface_part_vectors.set_velocity(i,
+                                                  data_time,
+                                                  std::move(velocity));
+        }
   }
 
 
@@ -525,93 +1375,200 @@ namespace fdl
 #endif
     ScopedTimer t1(t_spread_force);
     const int   level_number = this->patch_hierarchy->getFinestLevelNumber();
+    // Forces of boundary traces were already added to their parts' forces
+    const std::vector<std::vector<unsigned int>> surface_groups =
+      remove_parts(surface_interaction_groups, surface_part_is_trace);
+
+    auto hierarchy = get_interaction_hierarchy();
+    // The scratch indices and the data operations only depend on the
+    // hierarchies, so set them up once per regrid and share them between
+    // calls and parts.
+    if (f_spread_data_index != f_data_index)
+      {
+        std::shared_ptr<IBTK::SAMRAIDataCache> data_cache =
+          bypass_secondary_hierarchy ?
+            this->eulerian_data_cache :
+            secondary_hierarchy.getSAMRAIDataCache();
+        f_spread_data_index = f_data_index;
+        f_scratch_data_index =
+          data_cache->getCachedPatchDataIndex(f_data_index);
+        f_primary_scratch_data_index =
+          this->eulerian_data_cache->getCachedPatchDataIndex(f_data_index);
+
+        tbox::Pointer<hier::Variable<spacedim>> f_var;
+        auto *var_db = hier::VariableDatabase<spacedim>::getDatabase();
+        var_db->mapIndexToVariable(f_data_index, f_var);
+        f_primary_data_ops =
+          extract_hierarchy_data_ops(f_var, this->patch_hierarchy);
+        f_primary_data_ops->resetLevels(level_number, level_number);
+        ghost_data_accumulator.reset();
+      }
 
-    std::shared_ptr<IBTK::SAMRAIDataCache> data_cache =
-      secondary_hierarchy.getSAMRAIDataCache();
-    auto       hierarchy = secondary_hierarchy.getSecondaryHierarchy();
-    const auto f_scratch_data_index =
-      data_cache->getCachedPatchDataIndex(f_data_index);
-    fill_all(hierarchy, f_scratch_data_index, level_number, level_number, 0.0);
+    // Use the position scatters started by computeLagrangianForce() if they
+    // are for the same positions
+    if (spread_position_time != data_time)
+      cancel_spread_position_scatters();
 
     std::vector<MPI_Request> requests;
+    // Requests of each transaction's scatter (parts first, then surface
+    // parts). There is one transaction per interaction group.
+    std::vector<std::vector<MPI_Request>> scatter_requests;
+    const bool cache_positions =
+      input_db->getBoolWithDefault("cache_overlap_positions", true);
     // native to overlap:
     auto scatter_start = [&](const auto &collection,
+                             const auto &groups,
                              const auto &interactions,
                              const auto &kernels,
                              const auto &vectors,
+                             auto       &position_transactions,
                              auto       &transactions)
     {
-      for (unsigned int i = 0; i < collection.size(); ++i)
+      for (unsigned int group_n = 0; group_n < groups.size(); ++group_n)
         {
-          const auto &part = collection[i];
+          const std::vector<unsigned int> &group = groups[group_n];
+          const unsigned int               i     = group.front();
+          const auto                      &part  = collection[i];
           AssertThrow(vectors.dimension == part.dimension,
                       ExcFDLInternalError());
-          transactions.emplace_back(
-            interactions[i]->compute_spread_scatter_start(
-              kernels[i],
-              f_scratch_data_index,
-              vectors.get_position(i, data_time),
-              part.get_dof_handler(),
-              part.get_mapping(),
-              part.get_dof_handler(),
-              vectors.get_force(i, data_time)));
-          auto current_requests =
-            transactions[i]->delegate_outstanding_requests();
-          requests.insert(requests.end(),
-                          current_requests.begin(),
-                          current_requests.end());
+          std::vector<const LinearAlgebra::distributed::Vector<double> *>
+            positions, forces;
+          for (const unsigned int j : group)
+            {
+              positions.push_back(&vectors.get_position(j, data_time));
+              if (cache_positions)
+                interactions[i]->set_position_version(
+                  *positions.back(),
+                  vectors.get_position_version(j, data_time));
+              forces.push_back(&vectors.get_force(j, data_time));
+            }
+          TraceScope trace("compute_spread_scatter_start", "transaction", i);
+          if (position_transactions.size() > 0)
+            transactions.emplace_back(
+              interactions[i]->compute_spread_scatter_start(
+                std::move(position_transactions[group_n]),
+                kernels[i],
+                f_scratch_data_index,
+                part.get_mapping(),
+                part.get_dof_handler(),
+                forces));
+          else
+            transactions.emplace_back(
+              interactions[i]->compute_spread_scatter_start(
+                kernels[i],
+                f_scratch_data_index,
+                positions,
+                part.get_dof_handler(),
+                part.get_mapping(),
+                part.get_dof_handler(),
+                forces));
+          scatter_requests.emplace_back(
+            transactions.back()->delegate_outstanding_requests());
         }
-    };
-    auto scatter_finish = [](const auto &interactions, auto &transactions)
-    {
-      for (unsigned int i = 0; i < interactions.size(); ++i)
-        transactions[i] = interactions[i]->compute_spread_scatter_finish(
-          std::move(transactions[i]));
+      position_transactions.clear();
     };
     std::vector<std::unique_ptr<TransactionBase>> transactions,
       surface_transactions;
-    scatter_start(
-      this->parts, interactions, ib_kernels, this->part_vectors, transactions);
+    scatter_start(this->parts,
+                  interaction_groups,
+                  interactions,
+                  ib_kernels,
+                  this->part_vectors,
+                  spread_position_transactions,
+                  transactions);
     scatter_start(this->surface_parts,
+                  surface_groups,
                   surface_interactions,
                   surface_ib_kernels,
                   this->surface_part_vectors,
+                  surface_spread_position_transactions,
                   surface_transactions);
-    int ierr =
-      MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
-    AssertThrowMPI(ierr);
-    requests.resize(0);
-    scatter_finish(interactions, transactions);
-    scatter_finish(surface_interactions, surface_transactions);
+    spread_position_time = std::numeric_limits<double>::quiet_NaN();
+    // Zero the scratch data while the positions and forces are in flight.
+    // Every part spreads into the same scratch index so that ghost values
+    // only need to be summed (and, if necessary, copied to the primary
+    // hierarchy) once.
+    fill_all(hierarchy, f_scratch_data_index, level_number, level_number, 0.0);
+    // the scratch to primary communication does not touch ghost cells, which
+    // may have junk
+    if (!bypass_secondary_hierarchy)
+      fill_all(this->patch_hierarchy,
+               f_primary_scratch_data_index,
+               level_number,
+               level_number,
+               0.0);
 
-    // Compute:
-    auto compute_transaction = [&](const auto &interactions, auto &transactions)
+    // Compute each part as soon as its data arrives, as in
+    // interpolateVelocity():
+    const bool time_interactions =
+      input_db->getBoolWithDefault("calibrate_interaction_workload", false) ||
+      input_db->getBoolWithDefault("workload_diagnostics", false);
+    interaction_times.resize(interactions.size());
+    surface_interaction_times.resize(surface_interactions.size());
+    auto compute_transaction = [&](const auto          &groups,
+                                   const auto          &interactions,
+                                   auto                &transactions,
+                                   std::vector<double> &times,
+                                   const unsigned int   group_n)
     {
-      for (unsigned int i = 0; i < interactions.size(); ++i)
-        {
-          transactions[i] = interactions[i]->compute_spread_intermediate(
-            std::move(transactions[i]));
-          auto current_requests =
-            transactions[i]->delegate_outstanding_requests();
-          requests.insert(requests.end(),
-                          current_requests.begin(),
-                          current_requests.end());
-        }
+      const unsigned int i           = groups[group_n].front();
+      auto              &transaction = transactions[group_n];
+      {
+        TraceScope trace("compute_spread_scatter_finish", "transaction", i);
+        transaction = interactions[i]->compute_spread_scatter_finish(
+          std::move(transaction));
+      }
+      const double start_time = time_interactions ? MPI_Wtime() : 0.0;
+      TraceScope   trace("compute_spread_intermediate", "transaction", i);
+      transaction =
+        interactions[i]->compute_spread_intermediate(std::move(transaction));
+      if (time_interactions)
+        times[i] += MPI_Wtime() - start_time;
+      auto current_requests = transaction->delegate_outstanding_requests();
+      requests.insert(requests.end(),
+                      current_requests.begin(),
+                      current_requests.end());
     };
-    compute_transaction(interactions, transactions);
-    compute_transaction(surface_interactions, surface_transactions);
-    ierr = MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
-    AssertThrowMPI(ierr);
+    process_as_completed(scatter_requests,
+                         [&](const std::size_t k)
+                         {
+                           if (k < interaction_groups.size())
+                             compute_transaction(interaction_groups,
+                                                 interactions,
+                                                 transactions,
+                                                 interaction_times,
+                                                 k);
+                           else
+                             compute_transaction(surface_groups,
+                                                 surface_interactions,
+                                                 surface_transactions,
+                                                 surface_interaction_times,
+                                                 k - interaction_groups.size());
+                         });
+    {
+      TraceScope trace("spreadForce()[wait]", "transaction");
+      const int  ierr =
+        MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+      AssertThrowMPI(ierr);
+    }
     requests.resize(0);
 
     // Collect:
-    auto collect_transaction = [](const auto &interactions, auto &transactions)
+    auto collect_transaction =
+      [](const auto &groups, const auto &interactions, auto &transactions)
     {
-      for (unsigned int i = 0; i < interactions.size(); ++i)
-        interactions[i]->compute_spread_finish(std::move(transactions[i]));
+      for (unsigned int group_n = 0; group_n < groups.size(); ++group_n)
+        {
+          const unsigned int i = groups[group_n].front();
+          TraceScope trace("compute_spread_finish", "transaction", i);
+          interactions[i]->compute_spread_finish(
+            std::move(transactions[group_n]));
+        }
     };
-    collect_transaction(interactions, transactions);
-    collect_transaction(surface_interactions, surface_transactions);
+    collect_transaction(interaction_groups, interactions, transactions);
+    collect_transaction(surface_groups,
+                        surface_interactions,
+                        surface_transactions);
 
     // Deal with force values spread outside the physical domain. Since these
     // are spread into ghost regions that don't correspond to actual degrees
@@ -633,23 +1590,24 @@ namespace fdl
           }
       }
 
-    tbox::Pointer<hier::Variable<spacedim>> f_var;
-    auto *var_db = hier::VariableDatabase<spacedim>::getDatabase();
-    var_db->mapIndexToVariable(f_data_index, f_var);
     // Accumulate forces spread into patch ghost regions.
     {
       if (!ghost_data_accumulator)
         {
-          // If we have multiple IBMethod objects we may end up with a wider
-          // ghost region than the one required by this class. Hence, set the
-          // ghost width by just picking whatever the data actually has at the
-          // moment.
+          tbox::Pointer<hier::Variable<spacedim>> f_var;
+          auto *var_db = hier::VariableDatabase<spacedim>::getDatabase();
+          var_db->mapIndexToVariable(f_data_index, f_var);
+          // If we have multiple IBMethod objects (or other ghost cell
+          // requirements) the data may have a wider ghost region than the
+          // one required by this class's kernels. Nothing is spread outside
+          // of the latter, so only accumulate that.
           const tbox::Pointer<hier::PatchLevel<spacedim>> level =
             hierarchy->getPatchLevel(level_number);
-          const hier::IntVector<spacedim> gcw =
+          hier::IntVector<spacedim> gcw =
             level->getPatchDescriptor()
               ->getPatchDataFactory(f_scratch_data_index)
               ->getGhostCellWidth();
+          gcw.min(ghosts);
 
           ghost_data_accumulator.reset(new IBTK::SAMRAIGhostDataAccumulator(
             hierarchy, f_var, gcw, level_number, level_number));
@@ -658,28 +1616,24 @@ namespace fdl
     }
 
     // Sum values back into the primary hierarchy.
-    {
-      auto f_primary_data_ops =
-        extract_hierarchy_data_ops(f_var, this->patch_hierarchy);
-      f_primary_data_ops->resetLevels(level_number, level_number);
-      const auto f_primary_scratch_data_index =
-        this->eulerian_data_cache->getCachedPatchDataIndex(f_data_index);
-      // we have to zero everything here since the scratch to primary
-      // communication does not touch ghost cells, which may have junk
-      fill_all(this->patch_hierarchy,
-               f_primary_scratch_data_index,
-               level_number,
-               level_number,
-               0.0);
-      secondary_hierarchy.transferSecondaryToPrimary(
-        level_number,
-        f_primary_scratch_data_index,
-        f_scratch_data_index,
-        data_time);
-      f_primary_data_ops->add(f_data_index,
-                              f_data_index,
-                              f_primary_scratch_data_index);
-    }
+    if (bypass_secondary_hierarchy)
+      {
+        // We spread directly into scratch data on the primary hierarchy
+        f_primary_data_ops->add(f_data_index,
+                                f_data_index,
+                                f_scratch_data_index);
+      }
+    else
+      {
+        secondary_hierarchy.transferSecondaryToPrimary(
+          level_number,
+          f_primary_scratch_data_index,
+          f_scratch_data_index,
+          data_time);
+        f_primary_data_ops->add(f_data_index,
+                                f_data_index,
+                                f_primary_scratch_data_index);
+      }
   }
 
   //
@@ -699,9 +1653,87 @@ namespace fdl
 #endif
     ScopedTimer t1(t_compute_lagrangian_force);
 
+    // The positions are known, so start moving them to the overlap
+    // partitioning for spreadForce() while the forces are computed
+    if (input_db->getBoolWithDefault("prefetch_spread_positions", false))
+      start_spread_position_scatters(data_time);
+
+    // Setting up forces and active strains may require communication (e.g.,
+    // computing a static pressure requires solving a linear system), so that
+    // is done on this thread in the same order on every processor. Assembly
+    // is purely local, so each part's load vector is assembled by its own
+    // task.
+    // Positions of the parts whose stresses are evaluated implicitly. These
+    // are read by the assembly tasks so they must outlive them.
+    std::deque<LinearAlgebra::distributed::Vector<double>> implicit_positions;
+    std::vector<Threads::Task<>>                              assembly_tasks;
+    std::vector<LinearAlgebra::distributed::Vector<double> *> assembled;
+    // Start compressing each vector (in order, since compression is
+    // collective) as soon as it is assembled so that its communication
+    // overlaps with the assembly of the remaining parts
+    std::size_t n_compressing  = 0;
+    auto        start_compress = [&]()
+    {
+      IBAMR_TIMER_START(t_compute_lagrangian_force_pk1);
+      assembly_tasks[n_compressing].join();
+      IBAMR_TIMER_STOP(t_compute_lagrangian_force_pk1);
+      ScopedTimer t3(t_compute_lagrangian_force_compress_vector);
+      assembled[n_compressing]->compress_start(n_compressing,
+                                               VectorOperation::add);
+      ++n_compressing;
+    };
     unsigned int channel = 0;
-    auto         do_load =
-      [&](auto &collection, auto &vectors, auto &forces, auto &right_hand_sides)
+    auto solve_implicitly =
+      [&](std::vector<const LinearAlgebra::distributed::Vector<double> *>
+            &positions)
+    {
+      // Outside of time integration (e.g., when computing forces for
+      // plotting) there is no time step size and we use the explicit position
+      const double dt = this->new_time - this->current_time;
+      if (!(dt > 0.0))
+        return;
+      for (unsigned int i = 0; i < this->n_parts(); ++i)
+        if (implicit_solvers[i])
+          {
+            ScopedTimer t2(t_compute_lagrangian_force_implicit_solve);
+            implicit_positions.emplace_back(*positions[i]);
+            auto &position = implicit_positions.back();
+            // Each substep relaxes the structure, with the fluid velocity
+            // held fixed, from where the last one stopped
+            const LinearAlgebra::distributed::Vector<double> *substep_start =
+              positions[i];
+            LinearAlgebra::distributed::Vector<double> previous_position;
+            unsigned int                               n_iterations = 0;
+            for (unsigned int k = 0; k < n_implicit_substeps; ++k)
+              {
+                if (k > 0)
+                  {
+                    previous_position = position;
+                    previous_position.update_ghost_values();
+                    substep_start = &previous_position;
+                  }
+                n_iterations += implicit_solvers[i]->solve(
+                  data_time,
+                  n_implicit_substeps * implicit_damping / dt,
+                  *substep_start,
+                  position);
+              }
+            position.update_ghost_values();
+            positions[i] = &position;
+            if (input_db->getBoolWithDefault("log_solver_iterations", false))
+              tbox::plog << "IFEDMethod::computeLagrangianForce(): "
+                         << "implicit Newton solve of part " << i
+                         << " converged in " << n_iterations << " steps"
+                         << " (" << n_implicit_substeps << " substeps)."
+                         << std::endl;
+          }
+    };
+    auto do_load = [&](auto       &collection,
+                       auto       &vectors,
+                       auto       &forces,
+                       auto       &right_hand_sides,
+                       const std::vector<bool> &rigid,
+                       const auto              &update_positions)
     {
       // Unlike velocity interpolation and force spreading we actually need
       // the ghost values in the native partitioning, so make sure they are
@@ -713,105 +1745,202 @@ namespace fdl
         vectors.get_position(i, data_time).update_ghost_values_finish();
       IBAMR_TIMER_STOP(t_compute_lagrangian_force_position_ghost_update);
 
+      IBAMR_TIMER_START(t_compute_lagrangian_force_setup_force_and_strain);
       for (unsigned int i = 0; i < collection.size(); ++i)
         {
           const auto &part = collection[i];
           AssertThrow(vectors.dimension == part.dimension,
                       ExcFDLInternalError());
-          forces.emplace_back(part.get_partitioner());
-          right_hand_sides.emplace_back(part.get_partitioner());
+          forces.push_back(vectors.get_spare_vector(i));
+          right_hand_sides.push_back(vectors.get_spare_vector(i));
+          // Rigid parts only have constraint forces
+          if (i < rigid.size() && rigid[i])
+            continue;
 
           const auto &position = vectors.get_position(i, data_time);
           // The velocity isn't available at data_time so use current_time -
           // IBFEMethod does this too. This is always equal to the part's
           // current velocity and, by convention, has up-to-date ghost values.
           const auto &velocity = part.get_velocity();
-          IBAMR_TIMER_START(t_compute_lagrangian_force_setup_force_and_strain);
           for (auto &force : part.get_force_contributions())
             force->setup_force(data_time, position, velocity);
           for (auto &active_strain : part.get_active_strains())
             active_strain->setup_strain(data_time, position, velocity);
-          IBAMR_TIMER_STOP(t_compute_lagrangian_force_setup_force_and_strain);
-
-          IBAMR_TIMER_START(t_compute_lagrangian_force_pk1);
-          compute_load_vector(part.get_dof_handler(),
-                              part.get_mapping(),
-                              part.get_force_contributions(),
-                              part.get_active_strains(),
-                              data_time,
-                              position,
-                              velocity,
-                              right_hand_sides[i]);
-          IBAMR_TIMER_STOP(t_compute_lagrangian_force_pk1);
         }
+      IBAMR_TIMER_STOP(t_compute_lagrangian_force_setup_force_and_strain);
+
+      std::vector<const LinearAlgebra::distributed::Vector<double> *>
+        positions;
+      for (unsigned int i = 0; i < collection.size(); ++i)
+        positions.push_back(&vectors.get_position(i, data_time));
+      update_positions(positions);
+
+      IBAMR_TIMER_START(t_compute_lagrangian_force_pk1);
+      for (unsigned int i = 0; i < collection.size(); ++i)
+        {
+          if (i < rigid.size() && rigid[i])
+            continue;
+          const auto &part     = collection[i];
+          const auto &position = *positions[i];
+          const auto &velocity = part.get_velocity();
+          auto       &rhs      = right_hand_sides[i];
+          assembly_tasks.push_back(Threads::new_task(
+            [&part, &position, &velocity, &rhs, data_time]()
+            {
+              compute_load_vector(part.get_dof_handler(),
+                                  part.get_mapping(),
+                                  part.get_force_contributions(),
+                                  part.get_active_strains(),
+                                  data_time,
+                                  position,
+                                  velocity,
+                                  rhs,
+                                  part.get_matrix_free().get(),
+                                  part.get_reference_shape_gradients(),
+                                  &part.get_boundary_faces());
+            }));
+          assembled.push_back(&rhs);
+          // Without threads the task has already run, so there is no reason
+          // to wait
+          if (MultithreadInfo::n_threads() == 1)
+            {
+              IBAMR_TIMER_STOP(t_compute_lagrangian_force_pk1);
+              start_compress();
+              IBAMR_TIMER_START(t_compute_lagrangian_force_pk1);
+            }
+        }
+      IBAMR_TIMER_STOP(t_compute_lagrangian_force_pk1);
     };
     std::deque<LinearAlgebra::distributed::Vector<double>> part_forces,
       part_right_hand_sides, surface_part_forces, surface_part_right_hand_sides;
     do_load(this->parts,
             this->part_vectors,
             part_forces,
-            part_right_hand_sides);
+            part_right_hand_sides,
+            is_rigid_part,
+            solve_implicitly);
     do_load(this->surface_parts,
             this->surface_part_vectors,
             surface_part_forces,
-            surface_part_right_hand_sides);
+            surface_part_right_hand_sides,
+            {},
+            [](auto &) {});
 
-#ifdef FDL_ENABLE_TIMER_BARRIERS
-    {
-      ScopedTimer t2(t_compute_lagrangian_force_pre_compress_barrier);
-      const int   ierr = MPI_Barrier(IBTK::IBTK_MPI::getCommunicator());
-      AssertThrowMPI(ierr);
-    }
-#endif
-    // Allow compression to overlap:
-    auto do_compress = [](auto &vectors)
+    while (n_compressing < assembly_tasks.size())
+      start_compress();
     {
       ScopedTimer t3(t_compute_lagrangian_force_compress_vector);
-      for (unsigned int i = 0; i < vectors.size(); ++i)
-        vectors[i].compress_start(i, VectorOperation::add);
-      for (unsigned int i = 0; i < vectors.size(); ++i)
-        vectors[i].compress_finish(VectorOperation::add);
-    };
-    do_compress(part_right_hand_sides);
-    do_compress(surface_part_right_hand_sides);
-
-    // And do the actual solve:
-    auto do_solve = [&](const auto &collection,
-                        const auto &interactions,
-                        auto       &force_guesses,
-                        auto       &vectors,
-                        auto       &forces,
-                        auto       &right_hand_sides)
+      for (auto *rhs : assembled)
+        rhs->compress_finish(VectorOperation::add);
+    }
+
+    // The load vectors of boundary traces are added to those of their parts,
+    // so they do not need their own solves
+    for (unsigned int i = 0; i < this->n_surface_parts(); ++i)
+      if (surface_traces[i])
+        {
+          surface_traces[i]->add_to_volume(
+            surface_part_right_hand_sides[i],
+            part_right_hand_sides[surface_trace_parts[i]]);
+          for (auto &force : this->surface_parts[i].get_force_contributions())
+            force->finish_force(data_time);
+          for (auto &active_strain :
+               this->surface_parts[i].get_active_strains())
+            active_strain->finish_strain(data_time);
+        }
+
+    // And do the actual solve. Parts with the same mass operator are solved
+    // together.
+    auto do_solve = [&](const auto              &collection,
+                        const auto              &interactions,
+                        auto                    &force_guesses,
+                        auto                    &vectors,
+                        auto                    &forces,
+                        auto                    &right_hand_sides,
+                        const std::vector<bool> &lumped_mass,
+                        const std::vector<bool> &skip_parts,
+                        std::vector<Autotuner>  *autotuners)
     {
-      for (unsigned int i = 0; i < collection.size(); ++i)
+      for (const auto &group : group_mass_solves(collection,
+                                                 interactions,
+                                                 true,
+                                                 lumped_mass,
+                                                 skip_parts))
         {
-          const auto &part = collection[i];
+          if (group.size() > 1)
+            {
+              ScopedTimer t4(t_compute_lagrangian_force_solve);
+              std::vector<LinearAlgebra::distributed::Vector<double> *>
+                solutions;
+              for (const unsigned int i : group)
+                solutions.push_back(&forces[i]);
+              const std::vector<unsigned int> iterations = solve_mass_group(
+                collection,
+                group,
+                force_guesses,
+                solutions,
+                right_hand_sides,
+                input_db->getIntegerWithDefault("solver_iterations", 100),
+                input_db->getDoubleWithDefault("solver_relative_tolerance",
+                                               1e-6),
+                input_db->getDoubleWithDefault(
+                  "solver_adaptive_tolerance_factor", 0.0),
+                autotuners);
+              for (std::size_t k = 0; k < group.size(); ++k)
+                {
+                  const unsigned int i = group[k];
+                  if (input_db->getBoolWithDefault("log_solver_iterations",
+                                                   false))
+                    {
+                      tbox::plog << "IFEDMethod::computeLagrangianForce(): "
+                                 << "batched CG converged in " << iterations[k]
+                                 << " steps." << std::endl;
+                    }
+                  vectors.set_force(i, data_time, std::move(forces[i]));
+                  for (auto &force : collection[i].get_force_contributions())
+                    force->finish_force(data_time);
+                  for (auto &active_strain :
+                       collection[i].get_active_strains())
+                    active_strain->finish_strain(data_time);
+                }
+              continue;
+            }
+
+          const unsigned int i    = group.front();
+          const auto        &part = collection[i];
           AssertThrow(vectors.dimension == part.dimension,
                       ExcFDLInternalError());
-          if (interactions[i]->projection_is_interpolation())
+          if (interactions[i]->spreading_is_nodal())
             {
               vectors.set_force(i, data_time, std::move(right_hand_sides[i]));
             }
+          else if (lumped_mass[i])
+            {
+              ScopedTimer t4(t_compute_lagrangian_force_solve);
+              part.apply_approximate_mass_inverse(
+                forces[i], right_hand_sides[i], n_mass_projection_corrections);
+              vectors.set_force(i, data_time, std::move(forces[i]));
+            }
           else
             {
-              ScopedTimer   t4(t_compute_lagrangian_force_solve);
-              SolverControl control(
+              ScopedTimer        t4(t_compute_lagrangian_force_solve);
+              const unsigned int n_iterations = solve_mass_group(
+                collection,
+                group,
+                force_guesses,
+                {&forces[i]},
+                right_hand_sides,
                 input_db->getIntegerWithDefault("solver_iterations", 100),
                 input_db->getDoubleWithDefault("solver_relative_tolerance",
-                                               1e-6) *
-                  right_hand_sides[i].l2_norm());
-              SolverCG<LinearAlgebra::distributed::Vector<double>> cg(control);
-              force_guesses[i].guess(forces[i], right_hand_sides[i]);
-              cg.solve(part.get_mass_operator(),
-                       forces[i],
-                       right_hand_sides[i],
-                       part.get_mass_preconditioner());
-              force_guesses[i].submit(forces[i], right_hand_sides[i]);
+                                               1e-6),
+                input_db->getDoubleWithDefault(
+                  "solver_adaptive_tolerance_factor", 0.0),
+                autotuners)[0];
               if (input_db->getBoolWithDefault("log_solver_iterations", false))
                 {
                   tbox::plog << "IFEDMethod::computeLagrangianForce(): "
-                             << "SolverCG<> converged in "
-                             << control.last_step() << " steps." << std::endl;
+                             << "CG converged in " << n_iterations
+                             << " steps." << std::endl;
                 }
               vectors.set_force(i, data_time, std::move(forces[i]));
             }
@@ -826,13 +1955,70 @@ namespace fdl
              force_guesses,
              this->part_vectors,
              part_forces,
-             part_right_hand_sides);
+             part_right_hand_sides,
+             lumped_mass_projection,
+             is_rigid_part,
+             &mass_solver_autotuners);
+    // Rigid parts do not assemble load vectors: their forces are computed
+    // directly from the last velocity projection.
+    {
+      const double dt = this->new_time - this->current_time;
+      for (unsigned int i = 0; i < this->n_parts(); ++i)
+        if (rigid_projections[i])
+          {
+            rigid_projections[i]->compute_constraint_force(
+              dt > 0.0 ? rigid_constraint_density / dt : 0.0, part_forces[i]);
+            this->part_vectors.set_force(i,
+                                         data_time,
+                                         std::move(part_forces[i]));
+          }
+    }
     do_solve(this->surface_parts,
              surface_interactions,
              surface_force_guesses,
              this->surface_part_vectors,
              surface_part_forces,
-             surface_part_right_hand_sides);
+             surface_part_right_hand_sides,
+             surface_lumped_mass_projection,
+             surface_part_is_trace,
+             nullptr);
+  }
+
+  //
+  // Time stepping
+  //
+
+  template <int dim, int spacedim>
+  void
+  IFEDMethod<dim, spacedim>::preprocessIntegrateData(double current_time,
+                                                     double new_time,
+                                                     int    num_cycles)
+  {
+    IFEDMethodBase<dim, spacedim>::preprocessIntegrateData(current_time,
+                                                           new_time,
+                                                           num_cycles);
+    // IBAMR regrids (if necessary) before calling this function, so the
+    // hierarchy is fixed until the end of the time step
+    const double max_displacement =
+      input_db->getDoubleWithDefault("interaction_reinit_displacement", 0.0);
+    if (max_displacement > 0.0)
+      reinit_displaced_interactions(max_displacement);
+    interaction_reinit_displacements.clear();
+  }
+
+  template <int dim, int spacedim>
+  void
+  IFEDMethod<dim, spacedim>::postprocessIntegrateData(double current_time,
+                                                      double new_time,
+                                                      int    num_cycles)
+  {
+    IFEDMethodBase<dim, spacedim>::postprocessIntegrateData(current_time,
+                                                            new_time,
+                                                            num_cycles);
+    // The parts moved during the time step
+    interaction_reinit_displacements.clear();
+    for (unsigned int &n_steps : n_steps_since_interaction_reinit)
+      ++n_steps;
   }
 
   //
@@ -843,52 +2029,401 @@ namespace fdl
   void
   IFEDMethod<dim, spacedim>::reinit_interactions()
   {
-    auto do_reinit = [&](const auto &collection, auto &interactions)
+    reinit_part_interactions(std::vector<bool>(this->parts.size(), true),
+                             std::vector<bool>(this->surface_parts.size(),
+                                               true));
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  IFEDMethod<dim, spacedim>::start_spread_position_scatters(
+    const double data_time)
+  {
+    cancel_spread_position_scatters();
+    // Same groups as spreadForce()
+    const std::vector<std::vector<unsigned int>> surface_groups =
+      remove_parts(surface_interaction_groups, surface_part_is_trace);
+    const bool cache_positions =
+      input_db->getBoolWithDefault("cache_overlap_positions", true);
+    auto scatter_start = [&](const auto &collection,
+                             const auto &groups,
+                             const auto &interactions,
+                             const auto &vectors,
+                             auto       &transactions)
     {
-      for (unsigned int i = 0; i < collection.size(); ++i)
+      for (const std::vector<unsigned int> &group : groups)
         {
+          const unsigned int i = group.front();
+          std::vector<const LinearAlgebra::distributed::Vector<double> *>
+            positions;
+          for (const unsigned int j : group)
+            {
+              positions.push_back(&vectors.get_position(j, data_time));
+              if (cache_positions)
+                interactions[i]->set_position_version(
+                  *positions.back(),
+                  vectors.get_position_version(j, data_time));
+            }
+          TraceScope trace("compute_spread_position_scatter_start",
+                           "transaction",
+                           i);
+          transactions.emplace_back(
+            interactions[i]->compute_spread_position_scatter_start(
+              positions, collection[i].get_dof_handler()));
+        }
+    };
+    scatter_start(this->parts,
+                  interaction_groups,
+                  interactions,
+                  this->part_vectors,
+                  spread_position_transactions);
+    scatter_start(this->surface_parts,
+                  surface_groups,
+                  surface_interactions,
+                  this->surface_part_vectors,
+                  surface_spread_position_transactions);
+    spread_position_time = data_time;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  IFEDMethod<dim, spacedim>::cancel_spread_position_scatters()
+  {
+    const std::vector<std::vector<unsigned int>> surface_groups =
+      remove_parts(surface_interaction_groups, surface_part_is_trace);
+    auto cancel = [](const auto &groups,
+                     const auto &interactions,
+                     auto       &transactions)
+    {
+      for (std::size_t group_n = 0; group_n < transactions.size(); ++group_n)
+        interactions[groups[group_n].front()]->cancel_spread_position_scatter(
+          std::move(transactions[group_n]));
+      transactions.clear();
+    };
+    cancel(interaction_groups, interactions, spread_position_transactions);
+    cancel(surface_groups,
+           surface_interactions,
+           surface_spread_position_transactions);
+    spread_position_time = std::numeric_limits<double>::quiet_NaN();
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  IFEDMethod<dim, spacedim>::reinit_part_interactions(
+    const std::vector<bool> &reinit_parts,
+    const std::vector<bool> &reinit_surface_parts)
+  {
+    AssertDimension(reinit_parts.size(), this->parts.size());
+    AssertDimension(reinit_surface_parts.size(), this->surface_parts.size());
+    // Scatters set up by the old interaction objects cannot be used
+    cancel_spread_position_scatters();
+
+    // Number of cells by which the patches are padded when looking for the
+    // elements of each part and then each surface part. Since points are
+    // assigned to the patches containing them (and the kernel only reads
+    // ghost data), elements only need to be found if they could move into a
+    // patch before the next reinitialization.
+    const std::size_t n_total = this->parts.size() + this->surface_parts.size();
+    const double      default_ghost_cell_fraction =
+      input_db->getDoubleWithDefault("ghost_cell_fraction", 1.0);
+    AssertThrow(default_ghost_cell_fraction > 0.0,
+                ExcMessage("ghost_cell_fraction should be positive"));
+    std::vector<double> ghost_cell_fractions(n_total,
+                                             default_ghost_cell_fraction);
+    n_steps_since_interaction_reinit.resize(n_total, 0);
+    if (input_db->getBoolWithDefault("automatic_ghost_cell_fraction", false))
+      {
+        AssertThrow(input_db->keyExists("regrid_structure_cfl_interval"),
+                    ExcMessage("automatic_ghost_cell_fraction requires "
+                               "regrid_structure_cfl_interval"));
+        // Parts move at most this far (plus one time step, since the
+        // displacement is checked before each step) between reinits
+        double displacement_bound =
+          input_db->getDouble("regrid_structure_cfl_interval");
+        const double max_displacement =
+          input_db->getDoubleWithDefault("interaction_reinit_displacement",
+                                         0.0);
+        if (max_displacement > 0.0)
+          displacement_bound = std::min(displacement_bound, max_displacement);
+        AssertThrow(displacement_bound > 0.0,
+                    ExcMessage("regrid_structure_cfl_interval should be "
+                               "positive"));
+
+        // Estimate the displacement in one time step from the displacement
+        // since the last reinit. Without a measurement, fall back to
+        // ghost_cell_fraction.
+        const bool have_reinit_positions =
+          positions_at_last_interaction_reinit.size() == this->parts.size() &&
+          surface_positions_at_last_interaction_reinit.size() ==
+            this->surface_parts.size();
+        std::vector<double> displacements;
+        if (have_reinit_positions)
+          displacements =
+            interaction_reinit_displacements.empty() ?
+              this->compute_max_point_displacements(
+                positions_at_last_interaction_reinit,
+                surface_positions_at_last_interaction_reinit) :
+              interaction_reinit_displacements;
+        for (std::size_t k = 0; k < n_total; ++k)
+          ghost_cell_fractions[k] =
+            have_reinit_positions && n_steps_since_interaction_reinit[k] > 0 ?
+              displacement_bound +
+                displacements[k] / n_steps_since_interaction_reinit[k] :
+              std::max(default_ghost_cell_fraction, displacement_bound);
+      }
+
+    // The reference positions of the reinitialized parts change
+    interaction_reinit_displacements.clear();
+    // Tolerance (in physical units) for reusing old bounding boxes
+    const double bbox_reuse_tolerance =
+      input_db->getDoubleWithDefault("cell_bbox_reuse_tolerance", 0.0) *
+      IBTK::get_min_patch_dx(dynamic_cast<const hier::PatchLevel<spacedim> &>(
+        *this->patch_hierarchy->getPatchLevel(
+          this->patch_hierarchy->getFinestLevelNumber())));
+    // Tolerance (in physical units) for reusing interaction operators
+    const double stationary_tolerance =
+      input_db->getDoubleWithDefault("stationary_displacement_tolerance",
+                                     0.05) *
+      IBTK::get_min_patch_dx(dynamic_cast<const hier::PatchLevel<spacedim> &>(
+        *this->patch_hierarchy->getPatchLevel(
+          this->patch_hierarchy->getFinestLevelNumber())));
+    const unsigned int n_threads = interaction_execution_policy.get_n_threads();
+
+    // We already check that this has a valid value earlier on
+    const std::string interaction =
+      input_db->getStringWithDefault("interaction", "ELEMENTAL");
+    const double point_weight = input_db->getDoubleWithDefault(
+      interaction == "NODAL" ? "nodal_workload_weight" :
+                               "elemental_workload_weight",
+      1.0);
+    const bool use_cost_model =
+      input_db->getBoolWithDefault("interaction_workload_cost_model", false);
+    const std::string cell_length =
+      input_db->getStringWithDefault("interaction_cell_length",
+                                     "LONGEST_EDGE");
+    AssertThrow(cell_length == "LONGEST_EDGE" || cell_length == "VOLUME",
+                ExcMessage("interaction_cell_length should be either "
+                           "LONGEST_EDGE or VOLUME"));
+
+    auto do_reinit = [&](const auto                     &collection,
+                         const std::vector<bool>        &reinit,
+                         const std::vector<std::string> &kernels,
+                         const std::vector<double>      &calibrated_weights,
+                         const std::vector<bool>        &skip_zero_cells,
+                         const std::vector<bool>        &stationary,
+                         const auto                     &groups,
+                         auto                           &interactions,
+                         auto                           &reinit_positions,
+                         auto                           &cached_bboxes,
+                         auto                           &cached_inflations,
+                         const std::size_t               offset)
+    {
+      const bool have_reinit_positions =
+        reinit_positions.size() == collection.size();
+      reinit_positions.resize(collection.size());
+      cached_bboxes.resize(collection.size());
+      cached_inflations.resize(collection.size());
+      for (const std::vector<unsigned int> &group : groups)
+        {
+          // All parts in a group share one interaction object, so if any of
+          // them moved then all of them need to be set up again
+          if (std::none_of(group.begin(),
+                           group.end(),
+                           [&](const unsigned int i) { return reinit[i]; }))
+            continue;
           constexpr int structdim =
             std::remove_reference_t<decltype(collection[0])>::dimension;
-          const auto &part = collection[i];
-          const auto &tria = dynamic_cast<
-            const parallel::shared::Triangulation<structdim, spacedim> &>(
-            part.get_triangulation());
-          const auto &dof_handler = part.get_dof_handler();
-          MappingFEField<structdim,
-                         spacedim,
-                         LinearAlgebra::distributed::Vector<double>>
-            mapping(dof_handler, part.get_position());
-          IBAMR_TIMER_START(t_reinit_interactions_bboxes);
-          const auto local_bboxes =
-            compute_cell_bboxes<structdim, spacedim, float>(dof_handler,
-                                                            mapping);
-          const auto global_bboxes =
-            collect_all_active_cell_bboxes(tria, local_bboxes);
-          IBAMR_TIMER_STOP(t_reinit_interactions_bboxes);
-
-          IBAMR_TIMER_START(t_reinit_interactions_edges);
-          const auto local_edge_lengths = compute_longest_edge_lengths(
-            tria, mapping, QGauss<1>(dof_handler.get_fe().tensor_degree()));
-          const auto global_edge_lengths =
-            collect_longest_edge_lengths(tria, local_edge_lengths);
-          IBAMR_TIMER_STOP(t_reinit_interactions_edges);
+          const int ln = this->patch_hierarchy->getFinestLevelNumber();
+          double    ghost_cell_fraction = 0.0;
+          for (const unsigned int i : group)
+            ghost_cell_fraction =
+              std::max(ghost_cell_fraction, ghost_cell_fractions[offset + i]);
+
+          // The interaction object needs every cell which intersects its
+          // patches in any part of the group, so merge the bounding boxes
+          // and keep the longest edge lengths of all parts
+          std::vector<BoundingBox<spacedim, float>> global_bboxes;
+          std::vector<float>                        global_edge_lengths;
+          for (const unsigned int i : group)
+            {
+              const auto &part = collection[i];
+              const auto &tria = dynamic_cast<
+                const parallel::shared::Triangulation<structdim, spacedim> &>(
+                part.get_triangulation());
+              const auto &dof_handler = part.get_dof_handler();
+              MappingFEField<structdim,
+                             spacedim,
+                             LinearAlgebra::distributed::Vector<double>>
+                mapping(dof_handler, part.get_position());
+
+              IBAMR_TIMER_START(t_reinit_interactions_edges);
+              const unsigned int degree = dof_handler.get_fe().tensor_degree();
+              std::vector<float> local_edge_lengths;
+              if (cell_length == "VOLUME")
+                {
+                  const ReferenceCell reference_cell =
+                    tria.get_reference_cells().front();
+                  local_edge_lengths = compute_equivalent_edge_lengths(
+                    tria,
+                    mapping,
+                    reference_cell.get_gauss_type_quadrature<structdim>(
+                      degree + 1));
+                }
+              else
+                local_edge_lengths = compute_longest_edge_lengths(
+                  tria, mapping, QGauss<1>(degree));
+              IBAMR_TIMER_STOP(t_reinit_interactions_edges);
+
+              IBAMR_TIMER_START(t_reinit_interactions_bboxes);
+              std::vector<BoundingBox<spacedim, float>> local_bboxes;
+              if (bbox_reuse_tolerance > 0.0 && have_reinit_positions)
+                {
+                  // The bounding boxes are computed from the nodes, so the
+                  // largest change in any nodal coordinate bounds how far
+                  // each box can move
+                  const auto &fe           = dof_handler.get_fe();
+                  const auto &position     = part.get_position();
+                  const auto &old_position = reinit_positions[i];
+                  Vector<double> cell_position(fe.dofs_per_cell);
+                  Vector<double> old_cell_position(fe.dofs_per_cell);
+
+                  std::vector<double> displacements;
+                  for (const auto &cell : dof_handler.active_cell_iterators())
+                    if (cell->is_locally_owned())
+                      {
+                        cell->get_dof_values(position, cell_position);
+                        cell->get_dof_values(old_position, old_cell_position);
+                        cell_position -= old_cell_position;
+                        displacements.push_back(cell_position.linfty_norm());
+                      }
+                  compute_cell_bboxes(dof_handler,
+                                      mapping,
+                                      displacements,
+                                      bbox_reuse_tolerance,
+                                      cached_bboxes[i],
+                                      cached_inflations[i],
+                                      n_threads);
+                  local_bboxes = cached_bboxes[i];
+                }
+              else
+                local_bboxes =
+                  compute_cell_bboxes<structdim, spacedim, float>(dof_handler,
+                                                                  mapping);
+              // Interactions only need the bboxes (and edge lengths) of cells
+              // which intersect their (padded) patches, so we send both in the
+              // same targeted exchange
+              const auto local_patch_bboxes =
+                compute_patch_bboxes<spacedim, float>(
+                  extract_patches(
+                    get_interaction_hierarchy()->getPatchLevel(ln)),
+                  ghost_cell_fraction);
+              std::vector<float> part_edge_lengths;
+              auto               part_bboxes =
+                collect_intersecting_active_cell_bboxes(tria,
+                                                        local_bboxes,
+                                                        local_patch_bboxes,
+                                                        local_edge_lengths,
+                                                        part_edge_lengths);
+              if (global_bboxes.size() == 0)
+                {
+                  global_bboxes       = std::move(part_bboxes);
+                  global_edge_lengths = std::move(part_edge_lengths);
+                }
+              else
+                {
+                  // Cells which were not received have inverted boxes, which
+                  // do not change the merged box
+                  AssertDimension(part_bboxes.size(), global_bboxes.size());
+                  for (std::size_t k = 0; k < global_bboxes.size(); ++k)
+                    {
+                      global_bboxes[k].merge_with(part_bboxes[k]);
+                      global_edge_lengths[k] =
+                        std::max(global_edge_lengths[k], part_edge_lengths[k]);
+                    }
+                }
+              IBAMR_TIMER_STOP(t_reinit_interactions_bboxes);
+              reinit_positions[i] = part.get_position();
+              // Start measuring the displacement rate again
+              n_steps_since_interaction_reinit[offset + i] = 0;
+            }
 
           IBAMR_TIMER_START(t_reinit_interactions_objects);
-          // We already check that this has a valid value earlier on
-          const std::string interaction =
-            input_db->getStringWithDefault("interaction", "ELEMENTAL");
-          const int ln = this->patch_hierarchy->getFinestLevelNumber();
+          const unsigned int i    = group.front();
+          const auto        &part = collection[i];
+          const auto        &tria = dynamic_cast<
+            const parallel::shared::Triangulation<structdim, spacedim> &>(
+            part.get_triangulation());
+          // Calibrated costs replace the model ones
+          double workload_weight = point_weight;
+          if (i < calibrated_weights.size())
+            workload_weight = calibrated_weights[i];
+          else if (use_cost_model)
+            workload_weight *=
+              std::pow(IBTK::LEInteractor::getStencilSize(kernels[i]) / 4.0,
+                       spacedim);
 
           tbox::Pointer<tbox::Database> interaction_db =
             new tbox::InputDatabase("interaction");
-          // default database values are OK
-
-          if (interaction == "ELEMENTAL")
+          // Aside from caching, threading, precision, workload estimation,
+          // cell ordering, communication, and the cost model, default
+          // database values are OK
+          interaction_db->putBool(
+            "cache_kernel_weights",
+            input_db->getBoolWithDefault("cache_kernel_weights", false));
+          interaction_db->putBool(
+            "mixed_precision",
+            input_db->getBoolWithDefault("mixed_precision_interaction", false));
+          interaction_db->putBool(
+            "estimate_workload",
+            input_db->getBoolWithDefault("estimate_interaction_workload",
+                                         false));
+          interaction_db->putBool(
+            "morton_order_cells",
+            input_db->getBoolWithDefault("morton_order_interaction_cells",
+                                         false));
+          interaction_db->putBool(
+            "expand_cells",
+            input_db->getBoolWithDefault("expand_interaction_cells", false));
+          interaction_db->putBool(
+            "cache_dof_indices",
+            input_db->getBoolWithDefault("cache_interaction_dof_indices",
+                                         false));
+          interaction_execution_policy.put_to_database(interaction_db);
+          interaction_db->putString(
+            "scatter_backend",
+            input_db->getStringWithDefault("scatter_backend",
+                                           "POINT_TO_POINT"));
+          interaction_db->putBool(
+            "reduced_precision_scatters",
+            input_db->getBoolWithDefault("reduced_precision_scatters", false));
+          interaction_db->putDouble("workload_weight", workload_weight);
+          interaction_db->putDouble("ghost_cell_fraction", ghost_cell_fraction);
+          interaction_db->putBool(
+            "skip_zero_spread_cells",
+            std::any_of(group.begin(),
+                        group.end(),
+                        [&](const unsigned int j)
+                        { return skip_zero_cells[j]; }));
+          interaction_db->putDouble(
+            "frozen_displacement_tolerance",
+            std::all_of(group.begin(),
+                        group.end(),
+                        [&](const unsigned int j) { return stationary[j]; }) ?
+              stationary_tolerance :
+              0.0);
+
+          if (interaction != "NODAL")
             interactions[i]->reinit(interaction_db,
                                     tria,
                                     global_bboxes,
                                     global_edge_lengths,
-                                    secondary_hierarchy.getSecondaryHierarchy(),
+                                    get_interaction_hierarchy(),
                                     std::make_pair(ln, ln));
           else
             {
@@ -897,7 +2432,7 @@ namespace fdl
                 .reinit(interaction_db,
                         tria,
                         global_bboxes,
-                        secondary_hierarchy.getSecondaryHierarchy(),
+                        get_interaction_hierarchy(),
                         std::make_pair(ln, ln),
                         part.get_dof_handler(),
                         part.get_position());
@@ -908,8 +2443,311 @@ namespace fdl
           IBAMR_TIMER_STOP(t_reinit_interactions_objects);
         }
     };
-    do_reinit(this->parts, interactions);
-    do_reinit(this->surface_parts, surface_interactions);
+    do_reinit(this->parts,
+              reinit_parts,
+              ib_kernels,
+              workload_weights,
+              skip_zero_force_cells,
+              is_stationary_part,
+              interaction_groups,
+              interactions,
+              positions_at_last_interaction_reinit,
+              cell_bboxes,
+              cell_bbox_inflations,
+              0);
+    do_reinit(this->surface_parts,
+              reinit_surface_parts,
+              surface_ib_kernels,
+              surface_workload_weights,
+              surface_skip_zero_force_cells,
+              is_stationary_surface_part,
+              surface_interaction_groups,
+              surface_interactions,
+              surface_positions_at_last_interaction_reinit,
+              surface_cell_bboxes,
+              surface_cell_bbox_inflations,
+              this->parts.size());
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  IFEDMethod<dim, spacedim>::reinit_displaced_interactions(
+    const double max_displacement)
+  {
+    // If nothing was set up yet then there is nothing to compare against
+    if (positions_at_last_interaction_reinit.size() != this->parts.size() ||
+        surface_positions_at_last_interaction_reinit.size() !=
+          this->surface_parts.size())
+      return 0;
+
+    // The displacements are reduced over all processes, so every process
+    // agrees on which parts need new interaction objects. Reuse the ones
+    // computed by getMaxPointDisplacement() if nothing moved since then.
+    const std::vector<double> displacements =
+      interaction_reinit_displacements.empty() ?
+        this->compute_max_point_displacements(
+          positions_at_last_interaction_reinit,
+          surface_positions_at_last_interaction_reinit) :
+        interaction_reinit_displacements;
+    AssertDimension(displacements.size(),
+                    this->parts.size() + this->surface_parts.size());
+    std::vector<bool> reinit_parts(this->parts.size());
+    std::vector<bool> reinit_surface_parts(this->surface_parts.size());
+    std::size_t       n_reinit = 0;
+    for (std::size_t i = 0; i < displacements.size(); ++i)
+      {
+        const bool reinit = displacements[i] > max_displacement;
+        if (i < this->parts.size())
+          reinit_parts[i] = reinit;
+        else
+          reinit_surface_parts[i - this->parts.size()] = reinit;
+        n_reinit += reinit;
+      }
+
+    if (n_reinit > 0)
+      {
+        reinit_part_interactions(reinit_parts, reinit_surface_parts);
+        if (input_db->getBoolWithDefault("enable_logging", true))
+          tbox::plog << "IFEDMethod::reinit_displaced_interactions(): "
+                     << "reinitialized the interactions of " << n_reinit
+                     << " of " << displacements.size() << " parts"
+                     << std::endl;
+      }
+
+    return n_reinit;
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  IFEDMethod<dim, spacedim>::reinit_changed_interactions()
+  {
+    const std::size_t n_total = this->parts.size() + this->surface_parts.size();
+    // If nothing was set up yet then there is nothing to keep
+    if (positions_at_last_interaction_reinit.size() != this->parts.size() ||
+        surface_positions_at_last_interaction_reinit.size() !=
+          this->surface_parts.size())
+      {
+        reinit_interactions();
+        return n_total;
+      }
+
+    // Interaction objects which keep their patch boxes only need to be set up
+    // again if their parts moved. Both decisions are collective, so every
+    // process makes the same ones.
+    const int    ln        = this->patch_hierarchy->getFinestLevelNumber();
+    const auto   hierarchy = get_interaction_hierarchy();
+    const double max_displacement =
+      input_db->getDoubleWithDefault("interaction_reinit_displacement", 0.0);
+    const std::vector<double> displacements =
+      this->compute_max_point_displacements(
+        positions_at_last_interaction_reinit,
+        surface_positions_at_last_interaction_reinit);
+    AssertDimension(displacements.size(), n_total);
+
+    auto check_groups = [&](const auto        &groups,
+                            auto              &interactions,
+                            const std::size_t  offset,
+                            std::vector<bool> &reinit)
+    {
+      reinit.resize(interactions.size());
+      for (const std::vector<unsigned int> &group : groups)
+        {
+          const bool moved = std::any_of(
+            group.begin(),
+            group.end(),
+            [&](const unsigned int i)
+            { return displacements[offset + i] > max_displacement; });
+          // reinit_part_interactions() sets up a whole group at once
+          const bool keep =
+            !moved && interactions[group.front()]->update_patch_hierarchy(
+                        hierarchy, std::make_pair(ln, ln));
+          for (const unsigned int i : group)
+            reinit[i] = !keep;
+        }
+    };
+    std::vector<bool> reinit_parts, reinit_surface_parts;
+    check_groups(interaction_groups, interactions, 0, reinit_parts);
+    check_groups(surface_interaction_groups,
+                 surface_interactions,
+                 this->parts.size(),
+                 reinit_surface_parts);
+
+    const std::size_t n_reinit =
+      std::count(reinit_parts.begin(), reinit_parts.end(), true) +
+      std::count(reinit_surface_parts.begin(),
+                 reinit_surface_parts.end(),
+                 true);
+    if (n_reinit > 0)
+      reinit_part_interactions(reinit_parts, reinit_surface_parts);
+    if (n_reinit < n_total &&
+        input_db->getBoolWithDefault("enable_logging", true))
+      tbox::plog << "IFEDMethod::reinit_changed_interactions(): "
+                 << "kept the interactions of " << n_total - n_reinit
+                 << " of " << n_total << " parts" << std::endl;
+
+    return n_reinit;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  IFEDMethod<dim, spacedim>::calibrate_workload_weights()
+  {
+    const std::size_t n_parts = interactions.size();
+    const std::size_t n_total = n_parts + surface_interactions.size();
+    interaction_times.resize(n_parts);
+    surface_interaction_times.resize(surface_interactions.size());
+
+    // Sum the times and the unweighted workloads (from the last workload
+    // calculation) of each part over all processors at once
+    std::vector<double> data(2 * n_total);
+    for (std::size_t i = 0; i < n_total; ++i)
+      {
+        if (i < n_parts)
+          {
+            data[i]           = interaction_times[i];
+            data[n_total + i] =
+              interactions[i]->get_local_unweighted_workload();
+          }
+        else
+          {
+            data[i]           = surface_interaction_times[i - n_parts];
+            data[n_total + i] =
+              surface_interactions[i - n_parts]
+                ->get_local_unweighted_workload();
+          }
+      }
+    const int ierr = MPI_Allreduce(MPI_IN_PLACE,
+                                   data.data(),
+                                   data.size(),
+                                   MPI_DOUBLE,
+                                   MPI_SUM,
+                                   IBTK::IBTK_MPI::getCommunicator());
+    AssertThrowMPI(ierr);
+    std::fill(interaction_times.begin(), interaction_times.end(), 0.0);
+    std::fill(surface_interaction_times.begin(),
+              surface_interaction_times.end(),
+              0.0);
+
+    // Scale the measured times so that the total workload of the parts we can
+    // calibrate stays the same
+    std::vector<double> weights(n_total);
+    double              total_time     = 0.0;
+    double              total_workload = 0.0;
+    for (std::size_t i = 0; i < n_total; ++i)
+      {
+        weights[i] = i < n_parts ?
+                       interactions[i]->get_workload_weight() :
+                       surface_interactions[i - n_parts]->get_workload_weight();
+        if (data[i] > 0.0 && data[n_total + i] > 0.0)
+          {
+            total_time += data[i];
+            total_workload += weights[i] * data[n_total + i];
+          }
+      }
+    if (total_time == 0.0)
+      return;
+
+    for (std::size_t i = 0; i < n_total; ++i)
+      if (data[i] > 0.0 && data[n_total + i] > 0.0)
+        weights[i] = data[i] / data[n_total + i] * total_workload / total_time;
+
+    workload_weights.assign(weights.begin(), weights.begin() + n_parts);
+    surface_workload_weights.assign(weights.begin() + n_parts, weights.end());
+    for (std::size_t i = 0; i < n_parts; ++i)
+      interactions[i]->set_workload_weight(workload_weights[i]);
+    for (std::size_t i = 0; i < surface_interactions.size(); ++i)
+      surface_interactions[i]->set_workload_weight(
+        surface_workload_weights[i]);
+
+    if (input_db->getBoolWithDefault("enable_logging", true) &&
+        IBTK::IBTK_MPI::getRank() == 0)
+      for (std::size_t i = 0; i < n_total; ++i)
+        tbox::plog << "IFEDMethod::calibrate_workload_weights(): "
+                   << "cost per point of part " << i << " = " << weights[i]
+                   << '\n';
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  IFEDMethod<dim, spacedim>::log_workload_diagnostics(
+    const double local_interaction_time) const
+  {
+    double n_overlap_cells  = 0.0;
+    double n_points         = 0.0;
+    auto   add_interactions = [&](const auto &groups, const auto &interactions)
+    {
+      for (const auto &group : groups)
+        {
+          const auto &interaction = *interactions[group.front()];
+          n_overlap_cells +=
+            interaction.get_overlap_triangulation().n_active_cells();
+          n_points += interaction.get_local_unweighted_workload();
+        }
+    };
+    add_interactions(interaction_groups, interactions);
+    add_interactions(surface_interaction_groups, surface_interactions);
+
+    const std::vector<double> local_data{local_interaction_time,
+                                         local_estimated_workload,
+                                         n_overlap_cells,
+                                         n_points};
+    const std::vector<std::vector<double>> data =
+      Utilities::MPI::gather(IBTK::IBTK_MPI::getCommunicator(), local_data);
+    if (IBTK::IBTK_MPI::getRank() != 0)
+      return;
+
+    const double          n_processes = data.size();
+    std::array<double, 4> means{};
+    for (const auto &rank_data : data)
+      for (unsigned int j = 0; j < means.size(); ++j)
+        means[j] += rank_data[j] / n_processes;
+
+    const std::array<std::string, 4> names{{"interaction time",
+                                            "estimated workload",
+                                            "overlap cells",
+                                            "quadrature points or nodes"}};
+    for (unsigned int j = 0; j < names.size(); ++j)
+      {
+        double min = std::numeric_limits<double>::max();
+        double max = std::numeric_limits<double>::lowest();
+        for (const auto &rank_data : data)
+          {
+            min = std::min(min, rank_data[j]);
+            max = std::max(max, rank_data[j]);
+          }
+        tbox::plog << "IFEDMethod::log_workload_diagnostics(): " << names[j]
+                   << ": min = " << min << ", mean = " << means[j]
+                   << ", max = " << max << ", imbalance = "
+                   << (means[j] > 0.0 ? max / means[j] : 1.0) << '\n';
+      }
+
+    // Pearson correlation between the estimated and measured costs:
+    double covariance    = 0.0;
+    double time_variance = 0.0;
+    double work_variance = 0.0;
+    for (const auto &rank_data : data)
+      {
+        const double time_deviation = rank_data[0] - means[0];
+        const double work_deviation = rank_data[1] - means[1];
+        covariance += time_deviation * work_deviation;
+        time_variance += time_deviation * time_deviation;
+        work_variance += work_deviation * work_deviation;
+      }
+    tbox::plog << "IFEDMethod::log_workload_diagnostics(): "
+               << "correlation between estimated workload and time = ";
+    if (time_variance > 0.0 && work_variance > 0.0)
+      tbox::plog << covariance / std::sqrt(time_variance * work_variance);
+    else
+      tbox::plog << "undefined";
+    tbox::plog << std::endl;
   }
 
 
@@ -927,57 +2765,147 @@ namespace fdl
     // naught to do
     if (this->patch_hierarchy)
       {
-        // Weird things happen when we coarsen and refine if some levels are
-        // not present, so fill them all in with zeros to start
-        const int max_ln = this->patch_hierarchy->getFinestLevelNumber();
-        fill_all(secondary_hierarchy.getSecondaryHierarchy(),
-                 lagrangian_workload_current_index,
-                 0,
-                 max_ln);
+        // calibrate_workload_weights() resets the interaction times, so add
+        // them up first
+        const bool diagnostics =
+          input_db->getBoolWithDefault("workload_diagnostics", false);
+        const double local_interaction_time =
+          std::accumulate(interaction_times.begin(),
+                          interaction_times.end(),
+                          std::accumulate(surface_interaction_times.begin(),
+                                          surface_interaction_times.end(),
+                                          0.0));
+
+        if (lagrangian_workload_is_stale())
+          compute_lagrangian_workload();
+        else
+          {
+            // endDataRedistribution() saved the last workload, on this
+            // hierarchy, for plotting
+            extract_hierarchy_data_ops(lagrangian_workload_var,
+                                       this->patch_hierarchy)
+              ->copyData(lagrangian_workload_current_index,
+                         lagrangian_workload_plot_index,
+                         false);
+            if (input_db->getBoolWithDefault("enable_logging", true))
+              tbox::plog << "IFEDMethod::beginDataRedistribution(): "
+                         << "reusing the previous Lagrangian workload"
+                         << std::endl;
+          }
 
-        // Start:
-        auto setup_transaction = [&](const auto &collection,
-                                     const auto &interactions,
-                                     auto       &transactions)
-        {
-          for (unsigned int i = 0; i < collection.size(); ++i)
-            {
-              const auto &part = collection[i];
-              transactions.emplace_back(interactions[i]->add_workload_start(
-                lagrangian_workload_current_index,
-                part.get_position(),
-                part.get_dof_handler()));
-            }
-        };
-        std::vector<std::unique_ptr<TransactionBase>> transactions,
-          surface_transactions;
-        setup_transaction(this->parts, interactions, transactions);
-        setup_transaction(this->surface_parts,
-                          surface_interactions,
-                          surface_transactions);
-
-        // Compute:
-        auto compute_transaction = [](auto &interactions, auto &transactions)
-        {
-          for (unsigned int i = 0; i < transactions.size(); ++i)
-            transactions[i] = interactions[i]->add_workload_intermediate(
-              std::move(transactions[i]));
-        };
-        compute_transaction(interactions, transactions);
-        compute_transaction(surface_interactions, surface_transactions);
+        if (diagnostics)
+          {
+            log_workload_diagnostics(local_interaction_time);
+            std::fill(interaction_times.begin(), interaction_times.end(), 0.0);
+            std::fill(surface_interaction_times.begin(),
+                      surface_interaction_times.end(),
+                      0.0);
+          }
+      }
+
+    // Clear a few things that depend on the current hierarchy:
+    ghost_data_accumulator.reset();
+    f_spread_data_index          = IBTK::invalid_index;
+    f_scratch_data_index         = IBTK::invalid_index;
+    f_primary_scratch_data_index = IBTK::invalid_index;
+    f_primary_data_ops.setNull();
+  }
+
+  template <int dim, int spacedim>
+  bool
+  IFEDMethod<dim, spacedim>::lagrangian_workload_is_stale() const
+  {
+    const double reuse_displacement =
+      input_db->getDoubleWithDefault("workload_reuse_displacement", 0.0);
+    if (reuse_displacement <= 0.0 ||
+        input_db->getBoolWithDefault("calibrate_interaction_workload", false) ||
+        input_db->getBoolWithDefault("workload_diagnostics", false))
+      return true;
+    if (positions_at_last_workload_count.size() != this->parts.size() ||
+        surface_positions_at_last_workload_count.size() !=
+          this->surface_parts.size())
+      return true;
+
+    // The displacements are reduced over all processes, so every process
+    // makes the same decision
+    const std::vector<double> displacements =
+      this->compute_max_point_displacements(
+        positions_at_last_workload_count,
+        surface_positions_at_last_workload_count);
+    return std::any_of(displacements.begin(),
+                       displacements.end(),
+                       [&](const double displacement)
+                       { return displacement > reuse_displacement; });
+  }
 
-        // Finish:
-        auto finish_transaction =
-          [](const auto &interactions, auto &transactions)
+  template <int dim, int spacedim>
+  void
+  IFEDMethod<dim, spacedim>::compute_lagrangian_workload()
+  {
+    // Weird things happen when we coarsen and refine if some levels are
+    // not present, so fill them all in with zeros to start
+    const int max_ln = this->patch_hierarchy->getFinestLevelNumber();
+    fill_all(get_interaction_hierarchy(),
+             lagrangian_workload_current_index,
+             0,
+             max_ln);
+
+    if (input_db->getBoolWithDefault("calibrate_interaction_workload",
+                                     false))
+      calibrate_workload_weights();
+
+    // Start. Parts which share an interaction object still get their own
+    // transactions (and Scatter objects) here: since the transactions are
+    // started in the same order on every processor, MPI's message ordering
+    // guarantees that their messages are not confused.
+    const bool cache_positions =
+      input_db->getBoolWithDefault("cache_overlap_positions", true);
+    auto setup_transaction = [&](const auto &collection,
+                                 const auto &interactions,
+                                 auto       &transactions)
+    {
+      for (unsigned int i = 0; i < collection.size(); ++i)
         {
-          for (unsigned int i = 0; i < transactions.size(); ++i)
-            interactions[i]->add_workload_finish(std::move(transactions[i]));
-        };
-        finish_transaction(interactions, transactions);
-        finish_transaction(surface_interactions, surface_transactions);
+          const auto &part = collection[i];
+          if (cache_positions)
+            interactions[i]->set_position_version(
+              part.get_position(), part.get_position_version());
+          transactions.emplace_back(interactions[i]->add_workload_start(
+            lagrangian_workload_current_index,
+            part.get_position(),
+            part.get_dof_handler()));
+        }
+    };
+    std::vector<std::unique_ptr<TransactionBase>> transactions,
+      surface_transactions;
+    setup_transaction(this->parts, interactions, transactions);
+    setup_transaction(this->surface_parts,
+                      surface_interactions,
+                      surface_transactions);
 
-        // Move to primary hierarchy (we will read it back in
-        // endDataRedistribution)
+    // Compute:
+    auto compute_transaction = [](auto &interactions, auto &transactions)
+    {
+      for (unsigned int i = 0; i < transactions.size(); ++i)
+        transactions[i] = interactions[i]->add_workload_intermediate(
+          std::move(transactions[i]));
+    };
+    compute_transaction(interactions, transactions);
+    compute_transaction(surface_interactions, surface_transactions);
+
+    // Finish:
+    auto finish_transaction = [](const auto &interactions, auto &transactions)
+    {
+      for (unsigned int i = 0; i < transactions.size(); ++i)
+        interactions[i]->add_workload_finish(std::move(transactions[i]));
+    };
+    finish_transaction(interactions, transactions);
+    finish_transaction(surface_interactions, surface_transactions);
+
+    // Move to primary hierarchy (we will read it back in
+    // endDataRedistribution)
+    if (!bypass_secondary_hierarchy)
+      {
         fill_all(this->patch_hierarchy,
                  lagrangian_workload_current_index,
                  0,
@@ -990,8 +2918,12 @@ namespace fdl
           0.0);
       }
 
-    // Clear a few things that depend on the current hierarchy:
-    ghost_data_accumulator.reset();
+    positions_at_last_workload_count.clear();
+    for (const auto &part : this->parts)
+      positions_at_last_workload_count.push_back(part.get_position());
+    surface_positions_at_last_workload_count.clear();
+    for (const auto &part : this->surface_parts)
+      surface_positions_at_last_workload_count.push_back(part.get_position());
   }
 
   template <int dim, int spacedim>
@@ -1004,28 +2936,64 @@ namespace fdl
     // same as beginDataRedistribution
     if (this->patch_hierarchy)
       {
-        secondary_hierarchy.reinit(
-          this->patch_hierarchy->getFinestLevelNumber(),
-          this->patch_hierarchy->getFinestLevelNumber(),
-          this->patch_hierarchy,
-          lagrangian_workload_current_index);
+        const int ln = this->patch_hierarchy->getFinestLevelNumber();
+        // If the primary hierarchy already distributes the Lagrangian
+        // workload well enough then there is no reason to copy data to and
+        // from a second one
+        const double bypass_imbalance = input_db->getDoubleWithDefault(
+          "secondary_hierarchy_bypass_imbalance", 0.0);
+        bypass_secondary_hierarchy = false;
+        if (bypass_imbalance > 0.0)
+          {
+            auto primary_ops =
+              extract_hierarchy_data_ops(lagrangian_workload_var,
+                                         this->patch_hierarchy);
+            primary_ops->resetLevels(ln, ln);
+            const double work =
+              primary_ops->L1Norm(lagrangian_workload_current_index,
+                                  IBTK::invalid_index,
+                                  true);
+            const MPI_Comm comm      = IBTK::IBTK_MPI::getCommunicator();
+            const double   max_work  = Utilities::MPI::max(work, comm);
+            const double   mean_work = Utilities::MPI::sum(work, comm) /
+                                       Utilities::MPI::n_mpi_processes(comm);
+            bypass_secondary_hierarchy =
+              mean_work == 0.0 || max_work / mean_work < bypass_imbalance;
+          }
 
-        reinit_interactions();
+        if (!bypass_secondary_hierarchy)
+          secondary_hierarchy.reinit(ln,
+                                     ln,
+                                     this->patch_hierarchy,
+                                     lagrangian_workload_current_index);
+
+        reinit_changed_interactions();
+
+        if (input_db->getBoolWithDefault("workload_diagnostics", false))
+          {
+            auto interaction_ops =
+              extract_hierarchy_data_ops(lagrangian_workload_var,
+                                         get_interaction_hierarchy());
+            interaction_ops->resetLevels(ln, ln);
+            local_estimated_workload =
+              interaction_ops->L1Norm(lagrangian_workload_current_index,
+                                      IBTK::invalid_index,
+                                      true);
+          }
 
         if (input_db->getBoolWithDefault("enable_logging", true) &&
             (this->started_time_integration ||
              (!this->started_time_integration &&
               !input_db->getBoolWithDefault("skip_initial_workload", false))))
           {
-            const int ln = this->patch_hierarchy->getFinestLevelNumber();
-            auto      secondary_ops = extract_hierarchy_data_ops(
-              lagrangian_workload_var,
-              secondary_hierarchy.getSecondaryHierarchy());
-            secondary_ops->resetLevels(ln, ln);
+            auto interaction_ops =
+              extract_hierarchy_data_ops(lagrangian_workload_var,
+                                         get_interaction_hierarchy());
+            interaction_ops->resetLevels(ln, ln);
             const double work =
-              secondary_ops->L1Norm(lagrangian_workload_current_index,
-                                    IBTK::invalid_index,
-                                    true);
+              interaction_ops->L1Norm(lagrangian_workload_current_index,
+                                      IBTK::invalid_index,
+                                      true);
             const std::vector<double> all_work =
               Utilities::MPI::all_gather(IBTK::IBTK_MPI::getCommunicator(),
                                          work);
@@ -1061,7 +3029,7 @@ namespace fdl
         fill_all(this->patch_hierarchy,
                  lagrangian_workload_plot_index,
                  0,
-                 this->patch_hierarchy->getFinestLevelNumber(),
+                 ln,
                  0);
         extract_hierarchy_data_ops(lagrangian_workload_var,
                                    this->patch_hierarchy)
@@ -1077,6 +3045,37 @@ namespace fdl
   // Book-keeping
   //
 
+  template <int dim, int spacedim>
+  void
+  IFEDMethod<dim, spacedim>::putToDatabase(tbox::Pointer<tbox::Database> db)
+  {
+    IFEDMethodBase<dim, spacedim>::putToDatabase(db);
+    if (mass_solver_autotuners.size() > 0 &&
+        std::all_of(mass_solver_autotuners.begin(),
+                    mass_solver_autotuners.end(),
+                    [](const Autotuner &autotuner)
+                    { return autotuner.is_tuned(); }))
+      {
+        std::vector<int> values;
+        for (const Autotuner &autotuner : mass_solver_autotuners)
+          values.push_back(autotuner.get_value());
+        db->putIntegerArray("autotuned_mass_preconditioner_corrections",
+                            values.data(),
+                            static_cast<int>(values.size()));
+      }
+  }
+
+  template <int dim, int spacedim>
+  tbox::Pointer<hier::PatchHierarchy<spacedim>>
+  IFEDMethod<dim, spacedim>::get_interaction_hierarchy()
+  {
+    return bypass_secondary_hierarchy ?
+             this->patch_hierarchy :
+             secondary_hierarchy.getSecondaryHierarchy();
+  }
+
+
+
   template <int dim, int spacedim>
   void
   IFEDMethod<dim, spacedim>::registerEulerianVariables()
@@ -1101,5 +3100,111 @@ namespace fdl
                                          ghosts);
   }
 
+
+
+  template <int dim, int spacedim>
+  std::map<std::string, std::size_t>
+  IFEDMethod<dim, spacedim>::compute_memory_consumption() const
+  {
+    std::map<std::string, std::size_t> result;
+
+    // Parts may share geometries and interaction objects so count each one
+    // once.
+    std::set<const void *> geometries;
+    auto                   add_part = [&](const auto &part) {
+      result["parts"] += part.memory_consumption(false);
+      if (geometries.insert(part.get_geometry().get()).second)
+        result["part_geometries"] +=
+          part.get_geometry()->memory_consumption();
+    };
+    for (const Part<dim, spacedim> &part : this->parts)
+      add_part(part);
+    for (const Part<dim - 1, spacedim> &part : this->surface_parts)
+      add_part(part);
+
+    result["part_vectors"] = this->part_vectors.memory_consumption() +
+                             this->surface_part_vectors.memory_consumption();
+
+    std::set<const void *> interaction_set;
+    result["interactions"] = 0;
+    auto add_interactions  = [&](const auto &interaction_ptrs) {
+      for (const auto &interaction : interaction_ptrs)
+        if (interaction && interaction_set.insert(interaction.get()).second)
+          result["interactions"] += interaction->memory_consumption();
+    };
+    add_interactions(interactions);
+    add_interactions(surface_interactions);
+
+    std::size_t bookkeeping = 0;
+    for (const auto &bboxes : {&cell_bboxes, &surface_cell_bboxes})
+      for (const auto &part_bboxes : *bboxes)
+        bookkeeping +=
+          part_bboxes.capacity() * sizeof(BoundingBox<spacedim, float>);
+    for (const auto &positions : {&positions_at_last_interaction_reinit,
+                                  &surface_positions_at_last_interaction_reinit,
+                                  &positions_at_last_workload_count,
+                                  &surface_positions_at_last_workload_count})
+      for (const auto &position : *positions)
+        bookkeeping += position.memory_consumption();
+    for (const auto &trace : surface_traces)
+      if (trace)
+        bookkeeping += trace->memory_consumption();
+    result["bookkeeping"] = bookkeeping;
+
+    return result;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  IFEDMethod<dim, spacedim>::write_memory_report(std::ostream &out) const
+  {
+    const MPI_Comm comm = IBTK::IBTK_MPI::getCommunicator();
+    const std::map<std::string, std::size_t> categories =
+      compute_memory_consumption();
+
+    // Every processor has the same categories, in the same order.
+    std::vector<std::string> names;
+    std::vector<double>      values;
+    double                   total = 0.0;
+    for (const auto &pair : categories)
+      {
+        names.push_back(pair.first);
+        values.push_back(pair.second / 1.0e6);
+        total += values.back();
+      }
+    names.emplace_back("total");
+    values.push_back(total);
+
+    Utilities::System::MemoryStats stats;
+    Utilities::System::get_memory_stats(stats);
+    // These values are in kB.
+    names.emplace_back("VmRSS");
+    values.push_back(stats.VmRSS / 1.0e3);
+    names.emplace_back("VmHWM");
+    values.push_back(stats.VmHWM / 1.0e3);
+
+    const std::vector<Utilities::MPI::MinMaxAvg> reduced =
+      Utilities::MPI::min_max_avg(values, comm);
+    if (Utilities::MPI::this_mpi_process(comm) != 0)
+      return;
+
+    const auto flags     = out.flags();
+    const auto precision = out.precision(2);
+    out << std::fixed << "memory usage (MB) on "
+        << Utilities::MPI::n_mpi_processes(comm) << " processors:\n"
+        << std::left << std::setw(16) << "category" << std::right
+        << std::setw(12) << "min" << std::setw(12) << "mean" << std::setw(12)
+        << "max" << std::setw(12) << "max rank" << '\n';
+    for (unsigned int i = 0; i < names.size(); ++i)
+      out << std::left << std::setw(16) << names[i] << std::right
+          << std::setw(12) << reduced[i].min << std::setw(12)
+          << reduced[i].avg << std::setw(12) << reduced[i].max
+          << std::setw(12) << reduced[i].max_index << '\n';
+    out.precision(precision);
+    out.flags(flags);
+  }
+
   template class IFEDMethod<NDIM, NDIM>;
 } // namespace fdl
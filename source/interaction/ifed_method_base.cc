@@ -5,7 +5,10 @@
 #include <fiddle/interaction/ifed_method_base.h>
 #include <fiddle/interaction/interaction_utilities.h>
 
+#include <fiddle/mechanics/part_checkpoint.h>
+
 #include <deal.II/base/multithread_info.h>
+#include <deal.II/base/vectorization.h>
 
 #include <deal.II/distributed/shared_tria.h>
 
@@ -17,7 +20,10 @@
 
 #include <tbox/RestartManager.h>
 
+#include <algorithm>
+#include <iomanip>
 #include <limits>
+#include <sstream>
 
 namespace
 {
@@ -47,6 +53,7 @@ namespace fdl
     const bool                             register_for_restart)
     : object_name(object_name)
     , register_for_restart(register_for_restart)
+    , checkpoint_counter(0)
     , started_time_integration(false)
     , current_time(std::numeric_limits<double>::signaling_NaN())
     , half_time(std::numeric_limits<double>::signaling_NaN())
@@ -99,14 +106,33 @@ namespace fdl
                       AssertThrow(db->keyExists(key),
                                   ExcMessage("Couldn't find key " + key +
                                              " in the restart database"));
-                      const std::string  serialization = load_binary(key, db);
-                      std::istringstream in_str(serialization);
-                      boost::archive::binary_iarchive iarchive(in_str);
-                      collection[i].load(iarchive, 0);
+                      load_binary(key,
+                                  db,
+                                  [&](std::istream &in)
+                                  {
+                                    boost::archive::binary_iarchive iarchive(
+                                      in);
+                                    collection[i].load(iarchive, 0);
+                                  });
                     }
                 };
-                do_load(this->parts, "part_");
-                do_load(this->surface_parts, "surface_part_");
+                if (db->keyExists("checkpoint_file"))
+                  {
+                    checkpoint_counter = db->getInteger("checkpoint_counter");
+                    PartCheckpoint checkpoint(
+                      db->getString("checkpoint_file"),
+                      PartCheckpoint::Mode::Read,
+                      IBTK::IBTK_MPI::getCommunicator());
+                    for (auto &part : this->parts)
+                      checkpoint.load(part);
+                    for (auto &surface_part : this->surface_parts)
+                      checkpoint.load(surface_part);
+                  }
+                else
+                  {
+                    do_load(this->parts, "part_");
+                    do_load(this->surface_parts, "surface_part_");
+                  }
               }
             else
               {
@@ -118,6 +144,28 @@ namespace fdl
           }
       }
 
+    // The interaction code requires that every processor store the entire
+    // Lagrangian mesh, so check that here instead of failing with a
+    // std::bad_cast later on
+    auto check_triangulations = [](const auto &collection)
+    {
+      for (const auto &part : collection)
+        {
+          constexpr int structdim =
+            std::remove_reference_t<decltype(part)>::dimension;
+          AssertThrow(
+            (dynamic_cast<
+               const parallel::shared::Triangulation<structdim, spacedim> *>(
+               &part.get_triangulation()) != nullptr),
+            ExcMessage("At the present time, parts must use a "
+                       "parallel::shared::Triangulation since the interaction "
+                       "code requires every processor to store the entire "
+                       "mesh."));
+        }
+    };
+    check_triangulations(parts);
+    check_triangulations(surface_parts);
+
     init_regrid_positions(positions_at_last_regrid, parts);
     init_regrid_positions(surface_positions_at_last_regrid, surface_parts);
   }
@@ -169,10 +217,13 @@ namespace fdl
   template <int dim, int spacedim>
   void
   IFEDMethodBase<dim, spacedim>::endDataRedistribution(
-    tbox::Pointer<hier::PatchHierarchy<spacedim>> /*hierarchy*/,
+    tbox::Pointer<hier::PatchHierarchy<spacedim>> hierarchy,
     tbox::Pointer<mesh::GriddingAlgorithm<spacedim>> /*gridding_alg*/)
   {
     ScopedTimer t0(t_end_data_redistribution);
+    // Keep the scratch indices but make them cover the new levels
+    if (eulerian_data_cache)
+      eulerian_data_cache->resetLevels(0, hierarchy->getFinestLevelNumber());
     auto        do_reset = [](auto &positions_regrid, const auto &collection)
     {
       positions_regrid.clear();
@@ -191,33 +242,109 @@ namespace fdl
   double
   IFEDMethodBase<dim, spacedim>::getMaxPointDisplacement() const
   {
-    ScopedTimer t0(t_max_point_displacement);
-    double      max_displacement = 0;
+    ScopedTimer               t0(t_max_point_displacement);
+    const std::vector<double> displacements = get_max_point_displacements();
+    return displacements.empty() ?
+             0.0 :
+             *std::max_element(displacements.begin(), displacements.end());
+  }
+
+  template <int dim, int spacedim>
+  std::vector<double>
+  IFEDMethodBase<dim, spacedim>::get_max_point_displacements() const
+  {
+    return compute_max_point_displacements(positions_at_last_regrid,
+                                           surface_positions_at_last_regrid);
+  }
 
-    auto max_op = [&](const auto &collection, const auto &regrid_positions)
+  template <int dim, int spacedim>
+  std::vector<double>
+  IFEDMethodBase<dim, spacedim>::compute_max_point_displacements(
+    const std::deque<LinearAlgebra::distributed::Vector<double>>
+      &reference_positions,
+    const std::deque<LinearAlgebra::distributed::Vector<double>>
+      &surface_reference_positions) const
+  {
+    return std::move(compute_max_point_displacements(
+      {std::make_pair(&reference_positions, &surface_reference_positions)})[0]);
+  }
+
+  namespace
+  {
+    // Largest absolute difference between the locally owned entries of two
+    // vectors.
+    double
+    max_abs_difference(const LinearAlgebra::distributed::Vector<double> &a,
+                       const LinearAlgebra::distributed::Vector<double> &b)
     {
-      for (unsigned int i = 0; i < collection.size(); ++i)
+      AssertDimension(a.locally_owned_size(), b.locally_owned_size());
+      constexpr unsigned int n_lanes = VectorizedArray<double>::size();
+      const unsigned int     n       = a.locally_owned_size();
+      const unsigned int     n_vectorized = n - n % n_lanes;
+      const double          *a_values     = a.begin();
+      const double          *b_values     = b.begin();
+
+      VectorizedArray<double> max_difference(0.0);
+      VectorizedArray<double> a_lanes;
+      VectorizedArray<double> b_lanes;
+      for (unsigned int j = 0; j < n_vectorized; j += n_lanes)
         {
-          AssertDimension(collection.size(), regrid_positions.size());
-          const auto &ref_position = regrid_positions[i];
-          const auto &position     = collection[i].get_position();
-          const auto  local_size   = position.locally_owned_size();
-          for (unsigned int j = 0; j < local_size; ++j)
-            max_displacement = std::max(max_displacement,
-                                        std::abs(ref_position.local_element(j) -
-                                                 position.local_element(j)));
+          a_lanes.load(a_values + j);
+          b_lanes.load(b_values + j);
+          max_difference =
+            std::max(max_difference, std::abs(a_lanes - b_lanes));
         }
-    };
-    max_op(this->parts, positions_at_last_regrid);
-    max_op(this->surface_parts, surface_positions_at_last_regrid);
-    max_displacement =
-      Utilities::MPI::max(max_displacement, IBTK::IBTK_MPI::getCommunicator());
-
-    return max_displacement /
-           IBTK::get_min_patch_dx(
-             dynamic_cast<const hier::PatchLevel<spacedim> &>(
-               *patch_hierarchy->getPatchLevel(
-                 patch_hierarchy->getFinestLevelNumber())));
+
+      double result = 0.0;
+      for (unsigned int lane = 0; lane < n_lanes; ++lane)
+        result = std::max(result, max_difference[lane]);
+      for (unsigned int j = n_vectorized; j < n; ++j)
+        result = std::max(result, std::abs(a_values[j] - b_values[j]));
+      return result;
+    }
+  } // namespace
+
+  template <int dim, int spacedim>
+  std::vector<std::vector<double>>
+  IFEDMethodBase<dim, spacedim>::compute_max_point_displacements(
+    const std::vector<ReferencePositions> &references) const
+  {
+    const std::size_t n_parts = this->parts.size() + this->surface_parts.size();
+    // Store all displacements contiguously so that they can be reduced at
+    // once
+    std::vector<double> max_displacements;
+    max_displacements.reserve(references.size() * n_parts);
+    for (const ReferencePositions &reference : references)
+      {
+        AssertDimension(reference.first->size(), this->parts.size());
+        AssertDimension(reference.second->size(), this->surface_parts.size());
+        for (unsigned int i = 0; i < this->parts.size(); ++i)
+          max_displacements.push_back(
+            max_abs_difference((*reference.first)[i],
+                               this->parts[i].get_position()));
+        for (unsigned int i = 0; i < this->surface_parts.size(); ++i)
+          max_displacements.push_back(
+            max_abs_difference((*reference.second)[i],
+                               this->surface_parts[i].get_position()));
+      }
+    const int ierr = MPI_Allreduce(MPI_IN_PLACE,
+                                   max_displacements.data(),
+                                   max_displacements.size(),
+                                   MPI_DOUBLE,
+                                   MPI_MAX,
+                                   IBTK::IBTK_MPI::getCommunicator());
+    AssertThrowMPI(ierr);
+
+    const double dx = IBTK::get_min_patch_dx(
+      dynamic_cast<const hier::PatchLevel<spacedim> &>(
+        *patch_hierarchy->getPatchLevel(
+          patch_hierarchy->getFinestLevelNumber())));
+    std::vector<std::vector<double>> result(references.size());
+    for (std::size_t k = 0; k < references.size(); ++k)
+      for (std::size_t i = 0; i < n_parts; ++i)
+        result[k].push_back(max_displacements[k * n_parts + i] / dx);
+
+    return result;
   }
 
   template <int dim, int spacedim>
@@ -252,11 +379,16 @@ namespace fdl
           const auto &tria = dynamic_cast<
             const parallel::shared::Triangulation<structdim, spacedim> &>(
             part.get_triangulation());
-          const auto global_bboxes =
-            collect_all_active_cell_bboxes(tria, local_bboxes);
           tbox::Pointer<hier::PatchLevel<spacedim>> patch_level =
             hierarchy->getPatchLevel(level_number);
           Assert(patch_level, ExcNotImplemented());
+          // We can only tag cells on our own patches, so we only need the
+          // bboxes which intersect them
+          const auto global_bboxes = collect_intersecting_active_cell_bboxes(
+            tria,
+            local_bboxes,
+            compute_patch_bboxes<spacedim, float>(extract_patches(patch_level),
+                                                  1.0));
           tag_cells(global_bboxes, tag_index, patch_level);
         }
     };
@@ -298,14 +430,13 @@ namespace fdl
 
     // update positions and velocities:
     unsigned int channel = 0;
-    auto do_set = [&](auto &collection, auto &positions, auto &velocities)
+    auto do_set = [&](auto &collection, auto &vectors)
     {
+      vectors.swap_new_state_into(collection);
       for (unsigned int i = 0; i < collection.size(); ++i)
         {
           auto &part = collection[i];
-          part.set_position(std::move(positions[i]));
           part.get_position().update_ghost_values_start(channel++);
-          part.set_velocity(std::move(velocities[i]));
           part.get_velocity().update_ghost_values_start(channel++);
         }
       for (unsigned int i = 0; i < collection.size(); ++i)
@@ -315,24 +446,59 @@ namespace fdl
           part.get_velocity().update_ghost_values_finish();
         }
     };
-    auto new_positions          = part_vectors.get_all_new_positions();
-    auto new_velocities         = part_vectors.get_all_new_velocities();
-    auto surface_new_positions  = surface_part_vectors.get_all_new_positions();
-    auto surface_new_velocities = surface_part_vectors.get_all_new_velocities();
-    do_set(parts, new_positions, new_velocities);
-    do_set(surface_parts, surface_new_positions, surface_new_velocities);
+    do_set(parts, part_vectors);
+    do_set(surface_parts, surface_part_vectors);
 
     part_vectors.end_time_step();
     surface_part_vectors.end_time_step();
   }
 
+  namespace
+  {
+    // Set new_position = position + a * velocity_1 + b * velocity_2 and
+    // half_position = (position + new_position) / 2 in a single pass over
+    // the locally owned entries.
+    void
+    update_positions(
+      const LinearAlgebra::distributed::Vector<double> &position,
+      const double                                      a,
+      const LinearAlgebra::distributed::Vector<double> &velocity_1,
+      const double                                      b,
+      const LinearAlgebra::distributed::Vector<double> &velocity_2,
+      LinearAlgebra::distributed::Vector<double>       &new_position,
+      LinearAlgebra::distributed::Vector<double>       &half_position)
+    {
+      const unsigned int n = position.locally_owned_size();
+      AssertDimension(velocity_1.locally_owned_size(), n);
+      AssertDimension(velocity_2.locally_owned_size(), n);
+      AssertDimension(new_position.locally_owned_size(), n);
+      AssertDimension(half_position.locally_owned_size(), n);
+      const double *x   = position.begin();
+      const double *v_1 = velocity_1.begin();
+      const double *v_2 = velocity_2.begin();
+      double       *x_1 = new_position.begin();
+      double       *x_h = half_position.begin();
+      for (unsigned int j = 0; j < n; ++j)
+        {
+          const double dx = a * v_1[j] + b * v_2[j];
+          x_1[j]          = x[j] + dx;
+          x_h[j]          = x[j] + 0.5 * dx;
+        }
+    }
+  } // namespace
+
   template <int dim, int spacedim>
+  template <typename GetVelocities>
   void
-  IFEDMethodBase<dim, spacedim>::forwardEulerStep(double current_time,
-                                                  double new_time)
+  IFEDMethodBase<dim, spacedim>::explicit_step(
+    const double         current_time,
+    const double         new_time,
+    const double         a,
+    const double         b,
+    const GetVelocities &get_velocities)
   {
-    const double dt = new_time - current_time;
     Assert(this->current_time == current_time, ExcFDLNotImplemented());
+    (void)current_time;
     auto do_step = [&](auto &collection, auto &vectors)
     {
       for (unsigned int i = 0; i < collection.size(); ++i)
@@ -340,21 +506,19 @@ namespace fdl
           auto &part = collection[i];
           AssertThrow(vectors.dimension == part.dimension,
                       ExcFDLInternalError());
-          // Set the position at the end time:
-          LinearAlgebra::distributed::Vector<double> new_position(
-            part.get_position());
-          new_position.set_ghost_state(false);
-          new_position.add(dt, part.get_velocity());
+          const auto velocities = get_velocities(part, vectors, i);
+          LinearAlgebra::distributed::Vector<double> new_position =
+            vectors.get_spare_vector(i);
+          LinearAlgebra::distributed::Vector<double> half_position =
+            vectors.get_spare_vector(i);
+          update_positions(part.get_position(),
+                           a,
+                           *velocities.first,
+                           b,
+                           *velocities.second,
+                           new_position,
+                           half_position);
           vectors.set_position(i, new_time, std::move(new_position));
-
-          // Set the position at the half time:
-          LinearAlgebra::distributed::Vector<double> half_position(
-            part.get_partitioner());
-          half_position.set_ghost_state(false);
-          half_position.add(0.5,
-                            vectors.get_position(i, current_time),
-                            0.5,
-                            vectors.get_position(i, new_time));
           vectors.set_position(i, half_time, std::move(half_position));
         }
     };
@@ -362,6 +526,23 @@ namespace fdl
     do_step(surface_parts, surface_part_vectors);
   }
 
+  template <int dim, int spacedim>
+  void
+  IFEDMethodBase<dim, spacedim>::forwardEulerStep(double current_time,
+                                                  double new_time)
+  {
+    const double dt = new_time - current_time;
+    explicit_step(current_time,
+                  new_time,
+                  dt,
+                  0.0,
+                  [](const auto &part, const auto &, const unsigned int)
+                  {
+                    return std::make_pair(&part.get_velocity(),
+                                          &part.get_velocity());
+                  });
+  }
+
   template <int dim, int spacedim>
   void
   IFEDMethodBase<dim, spacedim>::backwardEulerStep(double current_time,
@@ -378,34 +559,15 @@ namespace fdl
                                               double new_time)
   {
     const double dt = new_time - current_time;
-    Assert(this->current_time == current_time, ExcFDLNotImplemented());
-    auto do_step = [&](auto &collection, auto &vectors)
-    {
-      for (unsigned int i = 0; i < collection.size(); ++i)
-        {
-          auto &part = collection[i];
-          AssertThrow(vectors.dimension == part.dimension,
-                      ExcFDLInternalError());
-          // Set the position at the end time:
-          LinearAlgebra::distributed::Vector<double> new_position(
-            part.get_position());
-          new_position.set_ghost_state(false);
-          new_position.add(dt, vectors.get_velocity(i, half_time));
-          vectors.set_position(i, new_time, std::move(new_position));
-
-          // Set the position at the half time:
-          LinearAlgebra::distributed::Vector<double> half_position(
-            part.get_partitioner());
-          half_position.set_ghost_state(false);
-          half_position.add(0.5,
-                            vectors.get_position(i, current_time),
-                            0.5,
-                            vectors.get_position(i, new_time));
-          vectors.set_position(i, half_time, std::move(half_position));
-        }
-    };
-    do_step(parts, part_vectors);
-    do_step(surface_parts, surface_part_vectors);
+    explicit_step(current_time,
+                  new_time,
+                  dt,
+                  0.0,
+                  [&](const auto &, const auto &vectors, const unsigned int i)
+                  {
+                    return std::make_pair(&vectors.get_velocity(i, half_time),
+                                          &vectors.get_velocity(i, half_time));
+                  });
   }
 
   template <int dim, int spacedim>
@@ -413,9 +575,18 @@ namespace fdl
   IFEDMethodBase<dim, spacedim>::trapezoidalStep(double current_time,
                                                  double new_time)
   {
-    (void)current_time;
-    (void)new_time;
-    Assert(false, ExcFDLNotImplemented());
+    const double dt = new_time - current_time;
+    explicit_step(current_time,
+                  new_time,
+                  0.5 * dt,
+                  0.5 * dt,
+                  [&](const auto        &part,
+                      const auto        &vectors,
+                      const unsigned int i)
+                  {
+                    return std::make_pair(&part.get_velocity(),
+                                          &vectors.get_velocity(i, new_time));
+                  });
   }
 
   //
@@ -426,25 +597,64 @@ namespace fdl
   void
   IFEDMethodBase<dim, spacedim>::putToDatabase(tbox::Pointer<tbox::Database> db)
   {
+    if (!checkpoint_directory.empty())
+      {
+        std::ostringstream file_name;
+        file_name << checkpoint_directory << '/' << object_name << '.'
+                  << std::setw(6) << std::setfill('0') << checkpoint_counter
+                  << ".checkpoint";
+        if (canonical_dofs.size() != parts.size() ||
+            surface_canonical_dofs.size() != surface_parts.size())
+          {
+            canonical_dofs.clear();
+            for (const auto &part : parts)
+              canonical_dofs.push_back(
+                compute_canonical_dof_indices(part.get_dof_handler()));
+            surface_canonical_dofs.clear();
+            for (const auto &surface_part : surface_parts)
+              surface_canonical_dofs.push_back(
+                compute_canonical_dof_indices(surface_part.get_dof_handler()));
+          }
+
+        {
+          PartCheckpoint checkpoint(file_name.str(),
+                                    PartCheckpoint::Mode::Write,
+                                    IBTK::IBTK_MPI::getCommunicator());
+          for (unsigned int i = 0; i < parts.size(); ++i)
+            checkpoint.save(parts[i], canonical_dofs[i]);
+          for (unsigned int i = 0; i < surface_parts.size(); ++i)
+            checkpoint.save(surface_parts[i], surface_canonical_dofs[i]);
+        }
+        db->putString("checkpoint_file", file_name.str());
+        db->putInteger("checkpoint_counter", ++checkpoint_counter);
+        return;
+      }
+
     auto do_put = [&](auto &collection, const std::string &prefix)
     {
       for (unsigned int i = 0; i < collection.size(); ++i)
         {
-          std::ostringstream              out_str;
-          boost::archive::binary_oarchive oarchive(out_str);
-          collection[i].save(oarchive, 0);
-          // TODO - with C++20 we can use view() instead of str() and skip
-          // this copy
-          const std::string out = out_str.str();
-          save_binary(prefix + std::to_string(i),
-                      out.c_str(),
-                      out.c_str() + out.size(),
-                      db);
+          save_binary(
+            prefix + std::to_string(i),
+            [&](std::ostream &out)
+            {
+              boost::archive::binary_oarchive oarchive(out);
+              collection[i].save(oarchive, 0);
+            },
+            db);
         }
     };
     do_put(parts, "part_");
     do_put(surface_parts, "surface_part_");
   }
 
+  template <int dim, int spacedim>
+  void
+  IFEDMethodBase<dim, spacedim>::set_checkpoint_directory(
+    const std::string &directory)
+  {
+    checkpoint_directory = directory;
+  }
+
   template class IFEDMethodBase<NDIM, NDIM>;
 } // namespace fdl
@@ -1,3 +1,4 @@
+#include <fiddle/base/phase_timings.h>
 #include <fiddle/base/samrai_utilities.h>
 
 #include <fiddle/grid/box_utilities.h>
@@ -8,9 +9,14 @@
 #include <fiddle/transfer/overlap_partitioning_tools.h>
 
 #include <deal.II/base/array_view.h>
+#include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/mpi.h>
 
+#include <deal.II/fe/fe_q.h>
 #include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_fe_field.h>
+#include <deal.II/fe/mapping_q.h>
+#include <deal.II/fe/mapping_q_cache.h>
 
 #include <deal.II/numerics/rtree.h>
 
@@ -19,6 +25,8 @@
 #include <ibtk/IndexUtilities.h>
 #include <ibtk/LEInteractor.h>
 
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -27,6 +35,129 @@ namespace fdl
   using namespace dealii;
   using namespace SAMRAI;
 
+  namespace
+  {
+    // Return whether or not two DoFHandlers on the native triangulation use
+    // the same dof indices on the native cells corresponding to the locally
+    // owned cells of @p overlap_tria. We cannot check artificial cells, so
+    // return false if we encounter one.
+    template <int dim, int spacedim>
+    bool
+    have_same_overlap_dofs(
+      const OverlapTriangulation<dim, spacedim> &overlap_tria,
+      const DoFHandler<dim, spacedim>           &dof_handler_1,
+      const DoFHandler<dim, spacedim>           &dof_handler_2)
+    {
+      if (dof_handler_1.get_fe_collection() !=
+            dof_handler_2.get_fe_collection() ||
+          dof_handler_1.n_dofs() != dof_handler_2.n_dofs())
+        return false;
+
+      const auto &native_tria = overlap_tria.get_native_triangulation();
+      std::vector<types::global_dof_index> dofs_1(
+        dof_handler_1.get_fe().dofs_per_cell);
+      std::vector<types::global_dof_index> dofs_2(dofs_1.size());
+      for (const auto &cell : overlap_tria.active_cell_iterators())
+        if (cell->is_locally_owned())
+          {
+            const auto native_cell = overlap_tria.get_native_cell(cell);
+            if (native_cell->is_artificial())
+              return false;
+            typename DoFHandler<dim, spacedim>::active_cell_iterator(
+              &native_tria,
+              native_cell->level(),
+              native_cell->index(),
+              &dof_handler_1)
+              ->get_dof_indices(dofs_1);
+            typename DoFHandler<dim, spacedim>::active_cell_iterator(
+              &native_tria,
+              native_cell->level(),
+              native_cell->index(),
+              &dof_handler_2)
+              ->get_dof_indices(dofs_2);
+            if (dofs_1 != dofs_2)
+              return false;
+          }
+
+      return true;
+    }
+
+    // Get the native and overlap vectors of every part of a transaction
+    // which are scattered by position_scatter: i.e., the positions (unless
+    // they were copied from the cache) and, if the solutions use the same
+    // DoFHandler, the solutions. The result may be empty.
+    template <int dim, int spacedim>
+    void
+    get_position_scatter_vectors(
+      Transaction<dim, spacedim>                                      &trans,
+      std::vector<const LinearAlgebra::distributed::Vector<double> *> &native,
+      std::vector<Vector<double> *> &overlap)
+    {
+      native.clear();
+      overlap.clear();
+      if (!trans.reuse_overlap_position)
+        {
+          native.push_back(trans.native_position);
+          overlap.push_back(&trans.overlap_position);
+        }
+      if (trans.batch_solution_scatter)
+        {
+          native.push_back(trans.native_solution);
+          overlap.push_back(&trans.overlap_solution);
+        }
+      for (auto &part : trans.additional_parts)
+        {
+          if (!trans.reuse_overlap_position)
+            {
+              native.push_back(part.native_position);
+              overlap.push_back(&part.overlap_position);
+            }
+          if (trans.batch_solution_scatter)
+            {
+              native.push_back(part.native_solution);
+              overlap.push_back(&part.overlap_solution);
+            }
+        }
+    }
+
+    // Same as get_position_scatter_vectors(), but for the vectors scattered
+    // by solution_scatter.
+    template <int dim, int spacedim>
+    void
+    get_solution_scatter_vectors(
+      Transaction<dim, spacedim>                                      &trans,
+      std::vector<const LinearAlgebra::distributed::Vector<double> *> &native,
+      std::vector<Vector<double> *> &overlap)
+    {
+      Assert(!trans.batch_solution_scatter, ExcFDLInternalError());
+      native  = {trans.native_solution};
+      overlap = {&trans.overlap_solution};
+      for (auto &part : trans.additional_parts)
+        {
+          native.push_back(part.native_solution);
+          overlap.push_back(&part.overlap_solution);
+        }
+    }
+
+    // Finish the global to overlap scatters started by
+    // compute_spread_scatter_start().
+    template <int dim, int spacedim>
+    void
+    finish_spread_scatters(Transaction<dim, spacedim> &trans)
+    {
+      std::vector<const LinearAlgebra::distributed::Vector<double> *> native;
+      std::vector<Vector<double> *>                                   overlap;
+      get_position_scatter_vectors(trans, native, overlap);
+      if (native.size() > 0)
+        trans.position_scatter.global_to_overlap_finish(native, overlap);
+      if (!trans.batch_solution_scatter)
+        {
+          get_solution_scatter_vectors(trans, native, overlap);
+          trans.solution_scatter.global_to_overlap_finish(native, overlap);
+        }
+    }
+  } // namespace
+
   std::vector<MPI_Request>
   TransactionBase::delegate_outstanding_requests()
   {
@@ -45,6 +176,16 @@ namespace fdl
     result.insert(result.end(), copy1.begin(), copy1.end());
     result.insert(result.end(), copy2.begin(), copy2.end());
     result.insert(result.end(), copy3.begin(), copy3.end());
+    for (AdditionalField &field : additional_fields)
+      {
+        auto copy = field.rhs_scatter.delegate_outstanding_requests();
+        result.insert(result.end(), copy.begin(), copy.end());
+      }
+    for (AdditionalPart &part : additional_parts)
+      {
+        auto copy = part.rhs_scatter.delegate_outstanding_requests();
+        result.insert(result.end(), copy.begin(), copy.end());
+      }
     return result;
   }
 
@@ -60,6 +201,11 @@ namespace fdl
     : communicator(MPI_COMM_NULL)
     , level_numbers(
         {std::numeric_limits<int>::max(), std::numeric_limits<int>::max()})
+    , execution_policy(1)
+    , scatter_backend(ScatterBackend::PointToPoint)
+    , reduced_precision_scatters(false)
+    , workload_weight(1.0)
+    , local_unweighted_workload(0.0)
   {}
 
   template <int dim, int spacedim>
@@ -74,6 +220,11 @@ namespace fdl
     , native_tria(&n_tria)
     , patch_hierarchy(p_hierarchy)
     , level_numbers(l_numbers)
+    , execution_policy(1)
+    , scatter_backend(ScatterBackend::PointToPoint)
+    , reduced_precision_scatters(false)
+    , workload_weight(1.0)
+    , local_unweighted_workload(0.0)
   {
     reinit(input_db,
            n_tria,
@@ -116,9 +267,15 @@ namespace fdl
     }
 #endif
 
-    native_tria     = &n_tria;
-    patch_hierarchy = p_hierarchy;
-    level_numbers   = l_numbers;
+    native_tria      = &n_tria;
+    patch_hierarchy  = p_hierarchy;
+    level_numbers    = l_numbers;
+    execution_policy = ExecutionPolicy(input_db);
+    scatter_backend  = to_scatter_backend(
+      input_db->getStringWithDefault("scatter_backend", "POINT_TO_POINT"));
+    reduced_precision_scatters =
+      input_db->getBoolWithDefault("reduced_precision_scatters", false);
+    set_workload_weight(input_db->getDoubleWithDefault("workload_weight", 1.0));
 
     // Check inputs
     Assert(global_active_cell_bboxes.size() == native_tria->n_active_cells(),
@@ -134,24 +291,78 @@ namespace fdl
     native_dof_handlers.clear();
     overlap_dof_handlers.clear();
     overlap_to_native_dof_translations.clear();
+    // Setting up a Scatter requires global communication, so keep the old
+    // ones around in case their communication patterns are still valid.
+    // DoFHandlers which were not used since the last call keep the ones
+    // cached before it.
+    scatters.resize(std::max(scatters.size(), scatter_cache.size()));
+    for (std::size_t i = 0; i < scatter_cache.size(); ++i)
+      if (scatters[i].size() == 0)
+        scatters[i] = std::move(scatter_cache[i]);
+    scatter_cache = std::move(scatters);
     scatters.clear();
+    // Overlap positions depend on the overlap triangulation
+    overlap_position_cache.clear();
+
+    const std::vector<tbox::Pointer<hier::Patch<spacedim>>> patches =
+      get_patches(patch_hierarchy);
+    patch_bboxes = compute_patch_bboxes<spacedim, float>(patches, 0.0);
+    const std::vector<BoundingBox<spacedim, float>> ghost_patch_bboxes =
+      compute_patch_bboxes<spacedim, float>(
+        patches, input_db->getDoubleWithDefault("ghost_cell_fraction", 1.0));
+    BoxIntersectionPredicate<dim, spacedim> predicate(global_active_cell_bboxes,
+                                                      ghost_patch_bboxes,
+                                                      *native_tria);
+    overlap_tria.reinit(*native_tria, predicate, execution_policy);
+  }
+
+
+
+  template <int dim, int spacedim>
+  bool
+  InteractionBase<dim, spacedim>::update_patch_hierarchy(
+    tbox::Pointer<hier::PatchHierarchy<spacedim>> p_hierarchy,
+    const std::pair<int, int>                    &l_numbers)
+  {
+    Assert(native_tria, ExcMessage("reinit() should be called first."));
+    Assert(p_hierarchy,
+           ExcMessage("The provided pointer to a patch hierarchy should not be "
+                      "null."));
+    bool same_patches = l_numbers == level_numbers &&
+                        l_numbers.second < p_hierarchy->getNumberOfLevels();
+    if (same_patches)
+      {
+        const std::vector<BoundingBox<spacedim, float>> new_patch_bboxes =
+          compute_patch_bboxes<spacedim, float>(get_patches(p_hierarchy), 0.0);
+        same_patches = new_patch_bboxes.size() == patch_bboxes.size();
+        for (std::size_t i = 0; same_patches && i < patch_bboxes.size(); ++i)
+          same_patches = new_patch_bboxes[i].get_boundary_points() ==
+                         patch_bboxes[i].get_boundary_points();
+      }
+    if (Utilities::MPI::min(int(same_patches), communicator) == 0)
+      return false;
+
+    patch_hierarchy = p_hierarchy;
+    return true;
+  }
 
+
+
+  template <int dim, int spacedim>
+  std::vector<tbox::Pointer<hier::Patch<spacedim>>>
+  InteractionBase<dim, spacedim>::get_patches(
+    const tbox::Pointer<hier::PatchHierarchy<spacedim>> &hierarchy) const
+  {
     std::vector<tbox::Pointer<hier::Patch<spacedim>>> patches;
     for (int ln = level_numbers.first; ln <= level_numbers.second; ++ln)
       {
         const auto level_patches =
-          extract_patches(patch_hierarchy->getPatchLevel(ln));
+          extract_patches(hierarchy->getPatchLevel(ln));
         patches.insert(patches.end(),
                        level_patches.begin(),
                        level_patches.end());
       }
-    const std::vector<BoundingBox<spacedim, float>> patch_bboxes =
-      compute_patch_bboxes<spacedim, float>(
-        patches, input_db->getDoubleWithDefault("ghost_cell_fraction", 1.0));
-    BoxIntersectionPredicate<dim, spacedim> predicate(global_active_cell_bboxes,
-                                                      patch_bboxes,
-                                                      *native_tria);
-    overlap_tria.reinit(*native_tria, predicate);
+    return patches;
   }
 
 
@@ -177,7 +388,10 @@ namespace fdl
     AssertThrow(iter != native_dof_handlers.end(),
                 ExcMessage("The provided dof handler must already be "
                            "registered with this class."));
-    return *overlap_dof_handlers[iter - native_dof_handlers.begin()];
+    const std::size_t index = iter - native_dof_handlers.begin();
+    if (!overlap_dof_handlers[index])
+      setup_overlap_dof_handler(index);
+    return *overlap_dof_handlers[index];
   }
 
 
@@ -193,7 +407,13 @@ namespace fdl
     AssertThrow(iter != native_dof_handlers.end(),
                 ExcMessage("The provided dof handler must already be "
                            "registered with this class."));
-    return *overlap_dof_handlers[iter - native_dof_handlers.begin()];
+    const std::size_t index = iter - native_dof_handlers.begin();
+    AssertThrow(overlap_dof_handlers[index],
+                ExcMessage("The overlap DoFHandler has not been set up yet: "
+                           "this happens the first time it is used by a "
+                           "non-const function (e.g., when a transaction "
+                           "starts)."));
+    return *overlap_dof_handlers[index];
   }
 
 
@@ -210,7 +430,8 @@ namespace fdl
   template <int dim, int spacedim>
   Scatter<double>
   InteractionBase<dim, spacedim>::get_scatter(
-    const DoFHandler<dim, spacedim> &native_dof_handler)
+    const DoFHandler<dim, spacedim> &native_dof_handler,
+    const bool                       reduced_precision)
   {
     auto iter = std::find(native_dof_handlers.begin(),
                           native_dof_handlers.end(),
@@ -220,6 +441,8 @@ namespace fdl
                            "registered with this class."));
 
     const std::size_t index = iter - native_dof_handlers.begin();
+    if (!overlap_dof_handlers[index])
+      setup_overlap_dof_handler(index);
     if (index >= scatters.size())
       scatters.resize(index + 1);
 
@@ -228,6 +451,8 @@ namespace fdl
       {
         Scatter<double> scatter = std::move(this_dh_scatters.back());
         this_dh_scatters.pop_back();
+        scatter.set_reduced_precision(reduced_precision &&
+                                      reduced_precision_scatters);
         return scatter;
       }
 
@@ -235,7 +460,10 @@ namespace fdl
            ExcFDLInternalError());
     Scatter<double> scatter(overlap_to_native_dof_translations[index],
                             native_dof_handler.locally_owned_dofs(),
-                            communicator);
+                            communicator,
+                            scatter_backend);
+    scatter.set_reduced_precision(reduced_precision &&
+                                  reduced_precision_scatters);
     return scatter;
   }
 
@@ -260,11 +488,267 @@ namespace fdl
     if (index >= scatters.size())
       scatters.resize(index + 1);
     std::vector<Scatter<double>> &this_dh_scatters = scatters[index];
+
+    // Also add the communication to the structured timing report so that it
+    // can be compared between processors.
+    const ScatterStatistics &statistics = scatter.get_statistics();
+    scatter_statistics += statistics;
+    PhaseTimings &timings = PhaseTimings::get();
+    timings.add("fdl::Scatter[bytes_sent]", statistics.bytes_sent);
+    timings.add("fdl::Scatter[bytes_received]", statistics.bytes_received);
+    timings.add("fdl::Scatter[messages_sent]", statistics.n_messages_sent);
+    timings.add("fdl::Scatter[finish_time]", statistics.finish_time);
+    scatter.reset_statistics();
+
     this_dh_scatters.emplace_back(std::move(scatter));
   }
 
 
 
+  template <int dim, int spacedim>
+  Vector<double>
+  InteractionBase<dim, spacedim>::get_overlap_vector(const std::size_t size)
+  {
+    Vector<double> vector;
+    if (overlap_vector_pool.size() > 0)
+      {
+        // Vectors are typically requested with the same sizes at every time
+        // step, so prefer one which does not need to be resized
+        auto iter = std::find_if(overlap_vector_pool.begin(),
+                                 overlap_vector_pool.end(),
+                                 [&](const Vector<double> &v)
+                                 { return v.size() == size; });
+        if (iter == overlap_vector_pool.end())
+          iter = overlap_vector_pool.end() - 1;
+        vector.swap(*iter);
+        overlap_vector_pool.erase(iter);
+      }
+    // reinit() only allocates if the existing storage is too small
+    vector.reinit(size);
+    return vector;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  InteractionBase<dim, spacedim>::return_overlap_vector(
+    Vector<double> &&vector)
+  {
+    if (vector.size() > 0)
+      {
+        overlap_vector_pool.emplace_back();
+        overlap_vector_pool.back().swap(vector);
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  InteractionBase<dim, spacedim>::return_overlap_vectors(
+    Transaction<dim, spacedim> &transaction)
+  {
+    return_overlap_vector(std::move(transaction.overlap_position));
+    return_overlap_vector(std::move(transaction.overlap_rhs));
+    return_overlap_vector(std::move(transaction.overlap_solution));
+    for (auto &field : transaction.additional_fields)
+      return_overlap_vector(std::move(field.overlap_rhs));
+    for (auto &part : transaction.additional_parts)
+      {
+        return_overlap_vector(std::move(part.overlap_position));
+        return_overlap_vector(std::move(part.overlap_rhs));
+        return_overlap_vector(std::move(part.overlap_solution));
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  InteractionBase<dim, spacedim>::set_position_version(
+    const LinearAlgebra::distributed::Vector<double> &position,
+    const std::uint64_t                               version)
+  {
+    auto iter = std::find_if(overlap_position_cache.begin(),
+                             overlap_position_cache.end(),
+                             [&](const CachedOverlapPosition &entry)
+                             { return entry.native_position == &position; });
+    if (iter == overlap_position_cache.end())
+      {
+        overlap_position_cache.emplace_back();
+        iter                  = overlap_position_cache.end() - 1;
+        iter->native_position = &position;
+      }
+    else if (iter->version == version)
+      return;
+
+    // Keep the storage of the old overlap position
+    iter->version            = version;
+    iter->native_dof_handler = nullptr;
+    iter->position_mapping.reset();
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::uint64_t
+  InteractionBase<dim, spacedim>::get_position_version(
+    const LinearAlgebra::distributed::Vector<double> &position) const
+  {
+    for (const CachedOverlapPosition &entry : overlap_position_cache)
+      if (entry.native_position == &position)
+        return entry.version;
+    return std::numeric_limits<std::uint64_t>::max();
+  }
+
+
+
+  template <int dim, int spacedim>
+  bool
+  InteractionBase<dim, spacedim>::find_cached_overlap_position(
+    const DoFHandler<dim, spacedim>                  &native_dof_handler,
+    const LinearAlgebra::distributed::Vector<double> &native_position,
+    const std::uint64_t                               version,
+    Vector<double>                                   &overlap_position) const
+  {
+    for (const CachedOverlapPosition &entry : overlap_position_cache)
+      if (entry.native_position == &native_position &&
+          entry.version == version &&
+          entry.native_dof_handler == &native_dof_handler &&
+          entry.overlap_position.size() == overlap_position.size())
+        {
+          overlap_position = entry.overlap_position;
+          return true;
+        }
+    return false;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  InteractionBase<dim, spacedim>::cache_overlap_position(
+    const DoFHandler<dim, spacedim>                  &native_dof_handler,
+    const LinearAlgebra::distributed::Vector<double> &native_position,
+    const std::uint64_t                               version,
+    const Vector<double>                             &overlap_position) const
+  {
+    for (CachedOverlapPosition &entry : overlap_position_cache)
+      if (entry.native_position == &native_position &&
+          entry.version == version &&
+          version != std::numeric_limits<std::uint64_t>::max())
+        {
+          entry.native_dof_handler = &native_dof_handler;
+          entry.overlap_position   = overlap_position;
+          entry.position_mapping.reset();
+        }
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::shared_ptr<const Mapping<dim, spacedim>>
+  InteractionBase<dim, spacedim>::get_overlap_position_mapping(
+    const DoFHandler<dim, spacedim>                  &native_dof_handler,
+    const LinearAlgebra::distributed::Vector<double> &native_position,
+    const std::uint64_t                               version,
+    const Vector<double>                             &overlap_position) const
+  {
+    const DoFHandler<dim, spacedim> &overlap_dof_handler =
+      get_overlap_dof_handler(native_dof_handler);
+    const FiniteElement<dim, spacedim> &fe = overlap_dof_handler.get_fe();
+    // Linear positions are handled well by MappingFEField (and some
+    // functions in interaction_utilities.h detect them) so only cache
+    // higher-degree ones
+    const bool use_cache =
+      fe.degree > 1 && fe.n_base_elements() == 1 &&
+      fe.element_multiplicity(0) == spacedim &&
+      dynamic_cast<const FE_Q<dim, spacedim> *>(&fe.base_element(0)) !=
+        nullptr &&
+      overlap_tria.all_reference_cells_are_hyper_cube();
+    if (use_cache)
+      for (CachedOverlapPosition &entry : overlap_position_cache)
+        if (entry.native_position == &native_position &&
+            entry.version == version &&
+            entry.native_dof_handler == &native_dof_handler &&
+            entry.overlap_position.size() == overlap_position.size())
+          {
+            if (!entry.position_mapping)
+              {
+                auto mapping =
+                  std::make_shared<MappingQCache<dim, spacedim>>(fe.degree);
+                mapping->initialize(MappingQ<dim, spacedim>(fe.degree),
+                                    overlap_dof_handler,
+                                    entry.overlap_position,
+                                    false);
+                entry.position_mapping = std::move(mapping);
+              }
+            return entry.position_mapping;
+          }
+
+    return std::make_shared<MappingFEField<dim, spacedim, Vector<double>>>(
+      overlap_dof_handler, overlap_position);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  InteractionBase<dim, spacedim>::find_cached_overlap_positions(
+    Transaction<dim, spacedim> &transaction)
+  {
+    transaction.position_versions = {
+      get_position_version(*transaction.native_position)};
+    for (const auto &part : transaction.additional_parts)
+      transaction.position_versions.push_back(
+        get_position_version(*part.native_position));
+
+    // Either every position is scattered or none are: copying some cached
+    // positions is harmless since the scatter overwrites them
+    const DoFHandler<dim, spacedim> &dof_handler =
+      *transaction.native_position_dof_handler;
+    bool all_cached =
+      find_cached_overlap_position(dof_handler,
+                                   *transaction.native_position,
+                                   transaction.position_versions[0],
+                                   transaction.overlap_position);
+    for (std::size_t i = 0; i < transaction.additional_parts.size(); ++i)
+      all_cached = all_cached &&
+                   find_cached_overlap_position(
+                     dof_handler,
+                     *transaction.additional_parts[i].native_position,
+                     transaction.position_versions[i + 1],
+                     transaction.additional_parts[i].overlap_position);
+    transaction.reuse_overlap_position = all_cached;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  InteractionBase<dim, spacedim>::cache_overlap_positions(
+    const Transaction<dim, spacedim> &transaction) const
+  {
+    if (transaction.reuse_overlap_position)
+      return;
+    AssertDimension(transaction.position_versions.size(),
+                    transaction.additional_parts.size() + 1);
+    const DoFHandler<dim, spacedim> &dof_handler =
+      *transaction.native_position_dof_handler;
+    cache_overlap_position(dof_handler,
+                           *transaction.native_position,
+                           transaction.position_versions[0],
+                           transaction.overlap_position);
+    for (std::size_t i = 0; i < transaction.additional_parts.size(); ++i)
+      cache_overlap_position(dof_handler,
+                             *transaction.additional_parts[i].native_position,
+                             transaction.position_versions[i + 1],
+                             transaction.additional_parts[i].overlap_position);
+  }
+
+
+
   template <int dim, int spacedim>
   void
   InteractionBase<dim, spacedim>::add_dof_handler(
@@ -278,20 +762,75 @@ namespace fdl
                   native_dof_handlers.end(),
                   ptr) == native_dof_handlers.end())
       {
+        // The overlap data is set up the first time it is needed
         native_dof_handlers.emplace_back(ptr);
-        // TODO - implement a move ctor for DH in deal.II
-        overlap_dof_handlers.emplace_back(
-          std::make_unique<DoFHandler<dim, spacedim>>(overlap_tria));
-        auto &overlap_dof_handler = *overlap_dof_handlers.back();
-        overlap_dof_handler.distribute_dofs(
-          native_dof_handler.get_fe_collection());
-
-        std::vector<types::global_dof_index> overlap_to_native_dofs =
-          compute_overlap_to_native_dof_translation(overlap_tria,
-                                                    overlap_dof_handler,
-                                                    native_dof_handler);
-        overlap_to_native_dof_translations.emplace_back(
-          std::move(overlap_to_native_dofs));
+        overlap_dof_handlers.emplace_back();
+        overlap_to_native_dof_translations.emplace_back();
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  InteractionBase<dim, spacedim>::setup_overlap_dof_handler(
+    const std::size_t index)
+  {
+    AssertIndexRange(index, native_dof_handlers.size());
+    Assert(!overlap_dof_handlers[index], ExcFDLInternalError());
+    const DoFHandler<dim, spacedim> &native_dof_handler =
+      *native_dof_handlers[index];
+    // TODO - implement a move ctor for DH in deal.II
+    overlap_dof_handlers[index] =
+      std::make_unique<DoFHandler<dim, spacedim>>(overlap_tria);
+    auto &overlap_dof_handler = *overlap_dof_handlers[index];
+    overlap_dof_handler.distribute_dofs(native_dof_handler.get_fe_collection());
+
+    // If a DoFHandler which is already set up numbers the relevant dofs in
+    // the same way (e.g., it uses the same FiniteElement and has not been
+    // renumbered) then the translation is the same. This has to be checked
+    // collectively since computing a translation is collective.
+    std::vector<types::global_dof_index> overlap_to_native_dofs;
+    bool                                 found_translation = false;
+    for (std::size_t i = 0; i < native_dof_handlers.size(); ++i)
+      {
+        if (i == index || !overlap_dof_handlers[i])
+          continue;
+        const bool same_dofs = have_same_overlap_dofs(overlap_tria,
+                                                      *native_dof_handlers[i],
+                                                      native_dof_handler);
+        if (Utilities::MPI::min(int(same_dofs), communicator) == 1)
+          {
+            overlap_to_native_dofs = overlap_to_native_dof_translations[i];
+            found_translation      = true;
+            break;
+          }
+      }
+    if (!found_translation)
+      overlap_to_native_dofs = compute_overlap_to_native_dof_translation(
+        overlap_tria,
+        overlap_dof_handler,
+        native_dof_handler,
+        execution_policy.get_n_threads());
+    overlap_to_native_dof_translations[index] =
+      std::move(overlap_to_native_dofs);
+
+    // Every cached scatter for this index was set up with the same
+    // arguments, so it suffices to check one. Since the import data of
+    // each Partitioner depends on every processor's ghost dofs, we can
+    // only reuse scatters if nothing changed anywhere.
+    const bool same_pattern =
+      index < scatter_cache.size() && scatter_cache[index].size() > 0 &&
+      scatter_cache[index].front().has_same_pattern(
+        overlap_to_native_dof_translations[index],
+        native_dof_handler.locally_owned_dofs(),
+        communicator,
+        scatter_backend);
+    if (Utilities::MPI::min(int(same_pattern), communicator) == 1)
+      {
+        if (index >= scatters.size())
+          scatters.resize(index + 1);
+        scatters[index] = std::move(scatter_cache[index]);
       }
   }
 
@@ -306,6 +845,24 @@ namespace fdl
 
 
 
+  template <int dim, int spacedim>
+  bool
+  InteractionBase<dim, spacedim>::spreading_is_nodal() const
+  {
+    return false;
+  }
+
+
+
+  template <int dim, int spacedim>
+  bool
+  InteractionBase<dim, spacedim>::has_empty_overlap() const
+  {
+    return overlap_tria.n_active_cells() == 0;
+  }
+
+
+
   template <int dim, int spacedim>
   std::unique_ptr<TransactionBase>
   InteractionBase<dim, spacedim>::compute_projection_rhs_scatter_start(
@@ -317,24 +874,54 @@ namespace fdl
     const Mapping<dim, spacedim>                     &mapping,
     LinearAlgebra::distributed::Vector<double>       &rhs)
   {
+    return compute_projection_rhs_scatter_start(
+      kernel_name,
+      data_idx,
+      position_dof_handler,
+      std::vector<const LinearAlgebra::distributed::Vector<double> *>{
+        &position},
+      dof_handler,
+      mapping,
+      std::vector<LinearAlgebra::distributed::Vector<double> *>{&rhs});
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::unique_ptr<TransactionBase>
+  InteractionBase<dim, spacedim>::compute_projection_rhs_scatter_start(
+    const std::string               &kernel_name,
+    const int                        data_idx,
+    const DoFHandler<dim, spacedim> &position_dof_handler,
+    const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+                                    &positions,
+    const DoFHandler<dim, spacedim> &dof_handler,
+    const Mapping<dim, spacedim>    &mapping,
+    const std::vector<LinearAlgebra::distributed::Vector<double> *> &rhs)
+  {
+    AssertThrow(positions.size() > 0,
+                ExcMessage("At least one part should be provided"));
+    AssertDimension(rhs.size(), positions.size());
 #ifdef DEBUG
-    {
-      int result = 0;
-      int ierr   = MPI_Comm_compare(communicator,
-                                  position.get_mpi_communicator(),
-                                  &result);
-      AssertThrowMPI(ierr);
-      Assert(result == MPI_CONGRUENT,
-             ExcMessage(
-               "The same communicator should be used for position and the "
-               "input triangulation"));
-      ierr =
-        MPI_Comm_compare(communicator, rhs.get_mpi_communicator(), &result);
-      AssertThrowMPI(ierr);
-      Assert(result == MPI_CONGRUENT,
-             ExcMessage("The same communicator should be used for rhs and "
-                        "the input triangulation"));
-    }
+    for (std::size_t i = 0; i < positions.size(); ++i)
+      {
+        int result = 0;
+        int ierr   = MPI_Comm_compare(communicator,
+                                    positions[i]->get_mpi_communicator(),
+                                    &result);
+        AssertThrowMPI(ierr);
+        Assert(result == MPI_CONGRUENT,
+               ExcMessage(
+                 "The same communicator should be used for position and the "
+                 "input triangulation"));
+        ierr = MPI_Comm_compare(communicator,
+                                rhs[i]->get_mpi_communicator(),
+                                &result);
+        AssertThrowMPI(ierr);
+        Assert(result == MPI_CONGRUENT,
+               ExcMessage("The same communicator should be used for rhs and "
+                          "the input triangulation"));
+      }
 #endif
 
     auto t_ptr = std::make_unique<Transaction<dim, spacedim>>();
@@ -345,28 +932,95 @@ namespace fdl
     transaction.current_data_idx = data_idx;
 
     // Setup position info:
+    const std::size_t n_overlap_position_dofs =
+      get_overlap_dof_handler(position_dof_handler).n_dofs();
     transaction.native_position_dof_handler = &position_dof_handler;
-    transaction.native_position             = &position;
-    transaction.overlap_position.reinit(
-      get_overlap_dof_handler(position_dof_handler).n_dofs());
+    transaction.native_position             = positions[0];
+    transaction.overlap_position = get_overlap_vector(n_overlap_position_dofs);
     transaction.position_scatter = get_scatter(position_dof_handler);
 
     // Setup rhs info:
-    transaction.native_dof_handler = &dof_handler;
-    transaction.mapping            = &mapping;
-    transaction.native_rhs         = &rhs;
-    transaction.overlap_rhs.reinit(
-      get_overlap_dof_handler(dof_handler).n_dofs());
-    transaction.rhs_scatter         = get_scatter(dof_handler);
+    const std::size_t n_overlap_dofs =
+      get_overlap_dof_handler(dof_handler).n_dofs();
+    transaction.native_dof_handler  = &dof_handler;
+    transaction.mapping             = &mapping;
+    transaction.native_rhs          = rhs[0];
+    transaction.overlap_rhs         = get_overlap_vector(n_overlap_dofs);
+    transaction.rhs_scatter         = get_scatter(dof_handler, true);
     transaction.rhs_scatter_back_op = this->get_rhs_scatter_type();
 
+    // Setup the other parts, which share everything except their vectors:
+    transaction.additional_parts.resize(positions.size() - 1);
+    for (std::size_t i = 1; i < positions.size(); ++i)
+      {
+        typename Transaction<dim, spacedim>::AdditionalPart &part =
+          transaction.additional_parts[i - 1];
+        part.native_position  = positions[i];
+        part.overlap_position = get_overlap_vector(n_overlap_position_dofs);
+        part.native_rhs       = rhs[i];
+        part.overlap_rhs      = get_overlap_vector(n_overlap_dofs);
+        part.rhs_scatter      = get_scatter(dof_handler, true);
+      }
+
     // Setup state:
     transaction.next_state = Transaction<dim, spacedim>::State::ScatterFinish;
     transaction.operation =
       Transaction<dim, spacedim>::Operation::Interpolation;
 
-    transaction.position_scatter.global_to_overlap_start(
-      *transaction.native_position, 0, transaction.overlap_position);
+    find_cached_overlap_positions(transaction);
+    std::vector<const LinearAlgebra::distributed::Vector<double> *> native;
+    std::vector<Vector<double> *>                                   overlap;
+    get_position_scatter_vectors(transaction, native, overlap);
+    if (native.size() > 0)
+      transaction.position_scatter.global_to_overlap_start(native, 0, overlap);
+
+    return t_ptr;
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::unique_ptr<TransactionBase>
+  InteractionBase<dim, spacedim>::compute_projection_rhs_scatter_start(
+    const std::string                                    &kernel_name,
+    const std::vector<int>                               &data_indices,
+    const DoFHandler<dim, spacedim>                      &position_dof_handler,
+    const LinearAlgebra::distributed::Vector<double>     &position,
+    const std::vector<const DoFHandler<dim, spacedim> *> &dof_handlers,
+    const std::vector<const Mapping<dim, spacedim> *>    &mappings,
+    const std::vector<LinearAlgebra::distributed::Vector<double> *> &rhs)
+  {
+    AssertThrow(data_indices.size() > 0,
+                ExcMessage("At least one field should be provided"));
+    AssertDimension(dof_handlers.size(), data_indices.size());
+    AssertDimension(mappings.size(), data_indices.size());
+    AssertDimension(rhs.size(), data_indices.size());
+
+    auto t_ptr = compute_projection_rhs_scatter_start(kernel_name,
+                                                      data_indices[0],
+                                                      position_dof_handler,
+                                                      position,
+                                                      *dof_handlers[0],
+                                                      *mappings[0],
+                                                      *rhs[0]);
+
+    // Nothing is communicated for the additional fields until
+    // compute_projection_rhs_accumulate_start() so it is safe to set them up
+    // here
+    auto &transaction = dynamic_cast<Transaction<dim, spacedim> &>(*t_ptr);
+    transaction.additional_fields.resize(data_indices.size() - 1);
+    for (std::size_t i = 1; i < data_indices.size(); ++i)
+      {
+        typename Transaction<dim, spacedim>::AdditionalField &field =
+          transaction.additional_fields[i - 1];
+        field.data_idx           = data_indices[i];
+        field.native_dof_handler = dof_handlers[i];
+        field.mapping            = mappings[i];
+        field.native_rhs         = rhs[i];
+        field.overlap_rhs        = get_overlap_vector(
+          get_overlap_dof_handler(*dof_handlers[i]).n_dofs());
+        field.rhs_scatter        = get_scatter(*dof_handlers[i], true);
+      }
 
     return t_ptr;
   }
@@ -386,8 +1040,12 @@ namespace fdl
             Transaction<dim, spacedim>::State::ScatterFinish),
            ExcMessage("Transaction state should be ScatterFinish"));
 
-    trans.position_scatter.global_to_overlap_finish(*trans.native_position,
-                                                    trans.overlap_position);
+    std::vector<const LinearAlgebra::distributed::Vector<double> *> native;
+    std::vector<Vector<double> *>                                   overlap;
+    get_position_scatter_vectors(trans, native, overlap);
+    if (native.size() > 0)
+      trans.position_scatter.global_to_overlap_finish(native, overlap);
+    cache_overlap_positions(trans);
 
     trans.next_state = Transaction<dim, spacedim>::State::Intermediate;
 
@@ -437,6 +1095,25 @@ namespace fdl
                                               trans.rhs_scatter_back_op,
                                               0,
                                               *trans.native_rhs);
+    // Use different channels for each field so that traffic is not mingled
+    for (std::size_t i = 0; i < trans.additional_fields.size(); ++i)
+      {
+        auto &field = trans.additional_fields[i];
+        field.rhs_scatter.overlap_to_global_start(field.overlap_rhs,
+                                                  trans.rhs_scatter_back_op,
+                                                  i + 1,
+                                                  *field.native_rhs);
+      }
+    // and for each part
+    const std::size_t n_fields = trans.additional_fields.size();
+    for (std::size_t i = 0; i < trans.additional_parts.size(); ++i)
+      {
+        auto &part = trans.additional_parts[i];
+        part.rhs_scatter.overlap_to_global_start(part.overlap_rhs,
+                                                 trans.rhs_scatter_back_op,
+                                                 n_fields + i + 1,
+                                                 *part.native_rhs);
+      }
 
     trans.next_state = Transaction<dim, spacedim>::State::AccumulateFinish;
 
@@ -461,11 +1138,24 @@ namespace fdl
     trans.rhs_scatter.overlap_to_global_finish(trans.overlap_rhs,
                                                trans.rhs_scatter_back_op,
                                                *trans.native_rhs);
+    for (auto &field : trans.additional_fields)
+      field.rhs_scatter.overlap_to_global_finish(field.overlap_rhs,
+                                                 trans.rhs_scatter_back_op,
+                                                 *field.native_rhs);
+    for (auto &part : trans.additional_parts)
+      part.rhs_scatter.overlap_to_global_finish(part.overlap_rhs,
+                                                trans.rhs_scatter_back_op,
+                                                *part.native_rhs);
     trans.next_state = Transaction<dim, spacedim>::State::Done;
 
     return_scatter(*trans.native_position_dof_handler,
                    std::move(trans.position_scatter));
     return_scatter(*trans.native_dof_handler, std::move(trans.rhs_scatter));
+    for (auto &field : trans.additional_fields)
+      return_scatter(*field.native_dof_handler, std::move(field.rhs_scatter));
+    for (auto &part : trans.additional_parts)
+      return_scatter(*trans.native_dof_handler, std::move(part.rhs_scatter));
+    return_overlap_vectors(trans);
   }
 
 
@@ -481,26 +1171,57 @@ namespace fdl
     const DoFHandler<dim, spacedim>                  &dof_handler,
     const LinearAlgebra::distributed::Vector<double> &solution)
   {
+    return compute_spread_scatter_start(
+      kernel_name,
+      data_idx,
+      std::vector<const LinearAlgebra::distributed::Vector<double> *>{
+        &position},
+      position_dof_handler,
+      mapping,
+      dof_handler,
+      std::vector<const LinearAlgebra::distributed::Vector<double> *>{
+        &solution});
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::unique_ptr<TransactionBase>
+  InteractionBase<dim, spacedim>::compute_spread_scatter_start(
+    const std::string &kernel_name,
+    const int          data_idx,
+    const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+                                    &positions,
+    const DoFHandler<dim, spacedim> &position_dof_handler,
+    const Mapping<dim, spacedim>    &mapping,
+    const DoFHandler<dim, spacedim> &dof_handler,
+    const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+      &solutions)
+  {
+    AssertThrow(positions.size() > 0,
+                ExcMessage("At least one part should be provided"));
+    AssertDimension(solutions.size(), positions.size());
 #ifdef DEBUG
-    {
-      int result = 0;
-      int ierr   = MPI_Comm_compare(communicator,
-                                  position.get_mpi_communicator(),
-                                  &result);
-      AssertThrowMPI(ierr);
-      Assert(result == MPI_CONGRUENT,
-             ExcMessage(
-               "The same communicator should be used for position and the "
-               "input triangulation"));
-      ierr = MPI_Comm_compare(communicator,
-                              solution.get_mpi_communicator(),
-                              &result);
-      AssertThrowMPI(ierr);
-      Assert(result == MPI_CONGRUENT,
-             ExcMessage(
-               "The same communicator should be used for solution and the "
-               "input triangulation"));
-    }
+    for (std::size_t i = 0; i < positions.size(); ++i)
+      {
+        int result = 0;
+        int ierr   = MPI_Comm_compare(communicator,
+                                    positions[i]->get_mpi_communicator(),
+                                    &result);
+        AssertThrowMPI(ierr);
+        Assert(result == MPI_CONGRUENT,
+               ExcMessage(
+                 "The same communicator should be used for position and the "
+                 "input triangulation"));
+        ierr = MPI_Comm_compare(communicator,
+                                solutions[i]->get_mpi_communicator(),
+                                &result);
+        AssertThrowMPI(ierr);
+        Assert(result == MPI_CONGRUENT,
+               ExcMessage(
+                 "The same communicator should be used for solution and the "
+                 "input triangulation"));
+      }
 #endif
 
     auto t_ptr = std::make_unique<Transaction<dim, spacedim>>();
@@ -511,19 +1232,35 @@ namespace fdl
     transaction.current_data_idx = data_idx;
 
     // Setup position info:
+    const std::size_t n_overlap_position_dofs =
+      get_overlap_dof_handler(position_dof_handler).n_dofs();
     transaction.native_position_dof_handler = &position_dof_handler;
     transaction.position_scatter            = get_scatter(position_dof_handler);
-    transaction.native_position             = &position;
-    transaction.overlap_position.reinit(
-      get_overlap_dof_handler(position_dof_handler).n_dofs());
+    transaction.native_position             = positions[0];
+    transaction.overlap_position = get_overlap_vector(n_overlap_position_dofs);
 
     // Setup solution info:
-    transaction.native_dof_handler = &dof_handler;
-    transaction.solution_scatter   = get_scatter(dof_handler);
-    transaction.mapping            = &mapping;
-    transaction.native_solution    = &solution;
-    transaction.overlap_solution.reinit(
-      get_overlap_dof_handler(dof_handler).n_dofs());
+    const std::size_t n_overlap_dofs =
+      get_overlap_dof_handler(dof_handler).n_dofs();
+    transaction.native_dof_handler     = &dof_handler;
+    transaction.batch_solution_scatter = &dof_handler == &position_dof_handler;
+    if (!transaction.batch_solution_scatter)
+      transaction.solution_scatter = get_scatter(dof_handler, true);
+    transaction.mapping          = &mapping;
+    transaction.native_solution  = solutions[0];
+    transaction.overlap_solution = get_overlap_vector(n_overlap_dofs);
+
+    // Setup the other parts, which share everything except their vectors:
+    transaction.additional_parts.resize(positions.size() - 1);
+    for (std::size_t i = 1; i < positions.size(); ++i)
+      {
+        typename Transaction<dim, spacedim>::AdditionalPart &part =
+          transaction.additional_parts[i - 1];
+        part.native_position  = positions[i];
+        part.overlap_position = get_overlap_vector(n_overlap_position_dofs);
+        part.native_solution  = solutions[i];
+        part.overlap_solution = get_overlap_vector(n_overlap_dofs);
+      }
 
     // Setup state:
     transaction.next_state = Transaction<dim, spacedim>::State::ScatterFinish;
@@ -532,18 +1269,153 @@ namespace fdl
     // OK, now start scattering:
 
     // Since we set up our own communicator in this object we can fearlessly use
-    // channels 0 and 1 to guarantee traffic is not accidentally mingled
-    transaction.position_scatter.global_to_overlap_start(
-      *transaction.native_position, 0, transaction.overlap_position);
+    // channels 0 and 1 to guarantee traffic is not accidentally mingled. If
+    // both vectors use the same DoFHandler then everything is sent in one
+    // message per processor.
+    find_cached_overlap_positions(transaction);
+    std::vector<const LinearAlgebra::distributed::Vector<double> *> native;
+    std::vector<Vector<double> *>                                   overlap;
+    get_position_scatter_vectors(transaction, native, overlap);
+    if (native.size() > 0)
+      transaction.position_scatter.global_to_overlap_start(native, 0, overlap);
+    if (!transaction.batch_solution_scatter)
+      {
+        get_solution_scatter_vectors(transaction, native, overlap);
+        transaction.solution_scatter.global_to_overlap_start(native,
+                                                             1,
+                                                             overlap);
+      }
+
+    return t_ptr;
+  }
+
 
-    transaction.solution_scatter.global_to_overlap_start(
-      *transaction.native_solution, 1, transaction.overlap_solution);
+
+  template <int dim, int spacedim>
+  std::unique_ptr<TransactionBase>
+  InteractionBase<dim, spacedim>::compute_spread_position_scatter_start(
+    const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+                                    &positions,
+    const DoFHandler<dim, spacedim> &position_dof_handler)
+  {
+    AssertThrow(positions.size() > 0,
+                ExcMessage("At least one part should be provided"));
+
+    auto t_ptr = std::make_unique<Transaction<dim, spacedim>>();
+
+    Transaction<dim, spacedim> &transaction = *t_ptr;
+    // Setup position info. The solutions are set up (and scattered
+    // separately) later.
+    const std::size_t n_overlap_position_dofs =
+      get_overlap_dof_handler(position_dof_handler).n_dofs();
+    transaction.native_position_dof_handler = &position_dof_handler;
+    transaction.position_scatter            = get_scatter(position_dof_handler);
+    transaction.native_position             = positions[0];
+    transaction.overlap_position = get_overlap_vector(n_overlap_position_dofs);
+    transaction.batch_solution_scatter = false;
+    transaction.additional_parts.resize(positions.size() - 1);
+    for (std::size_t i = 1; i < positions.size(); ++i)
+      {
+        typename Transaction<dim, spacedim>::AdditionalPart &part =
+          transaction.additional_parts[i - 1];
+        part.native_position  = positions[i];
+        part.overlap_position = get_overlap_vector(n_overlap_position_dofs);
+      }
+
+    transaction.next_state = Transaction<dim, spacedim>::State::ScatterStart;
+    transaction.operation  = Transaction<dim, spacedim>::Operation::Spreading;
+
+    find_cached_overlap_positions(transaction);
+    std::vector<const LinearAlgebra::distributed::Vector<double> *> native;
+    std::vector<Vector<double> *>                                   overlap;
+    get_position_scatter_vectors(transaction, native, overlap);
+    if (native.size() > 0)
+      transaction.position_scatter.global_to_overlap_start(native, 0, overlap);
 
     return t_ptr;
   }
 
 
 
+  template <int dim, int spacedim>
+  std::unique_ptr<TransactionBase>
+  InteractionBase<dim, spacedim>::compute_spread_scatter_start(
+    std::unique_ptr<TransactionBase> position_transaction,
+    const std::string               &kernel_name,
+    const int                        data_idx,
+    const Mapping<dim, spacedim>    &mapping,
+    const DoFHandler<dim, spacedim> &dof_handler,
+    const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+      &solutions)
+  {
+    auto &transaction =
+      dynamic_cast<Transaction<dim, spacedim> &>(*position_transaction);
+    Assert((transaction.operation ==
+            Transaction<dim, spacedim>::Operation::Spreading),
+           ExcMessage("Transaction operation should be Spreading"));
+    Assert((transaction.next_state ==
+            Transaction<dim, spacedim>::State::ScatterStart),
+           ExcMessage("Transaction state should be ScatterStart"));
+    AssertDimension(solutions.size(), transaction.additional_parts.size() + 1);
+
+    transaction.kernel_name      = kernel_name;
+    transaction.current_data_idx = data_idx;
+
+    // Setup solution info:
+    const std::size_t n_overlap_dofs =
+      get_overlap_dof_handler(dof_handler).n_dofs();
+    transaction.native_dof_handler = &dof_handler;
+    transaction.solution_scatter   = get_scatter(dof_handler, true);
+    transaction.mapping            = &mapping;
+    transaction.native_solution    = solutions[0];
+    transaction.overlap_solution   = get_overlap_vector(n_overlap_dofs);
+    for (std::size_t i = 1; i < solutions.size(); ++i)
+      {
+        typename Transaction<dim, spacedim>::AdditionalPart &part =
+          transaction.additional_parts[i - 1];
+        part.native_solution  = solutions[i];
+        part.overlap_solution = get_overlap_vector(n_overlap_dofs);
+      }
+
+    transaction.next_state = Transaction<dim, spacedim>::State::ScatterFinish;
+
+    // The positions are already in flight on channel 0
+    std::vector<const LinearAlgebra::distributed::Vector<double> *> native;
+    std::vector<Vector<double> *>                                   overlap;
+    get_solution_scatter_vectors(transaction, native, overlap);
+    transaction.solution_scatter.global_to_overlap_start(native, 1, overlap);
+
+    return position_transaction;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  InteractionBase<dim, spacedim>::cancel_spread_position_scatter(
+    std::unique_ptr<TransactionBase> position_transaction)
+  {
+    auto &transaction =
+      dynamic_cast<Transaction<dim, spacedim> &>(*position_transaction);
+    Assert((transaction.next_state ==
+            Transaction<dim, spacedim>::State::ScatterStart),
+           ExcMessage("Transaction state should be ScatterStart"));
+
+    std::vector<const LinearAlgebra::distributed::Vector<double> *> native;
+    std::vector<Vector<double> *>                                   overlap;
+    get_position_scatter_vectors(transaction, native, overlap);
+    if (native.size() > 0)
+      transaction.position_scatter.global_to_overlap_finish(native, overlap);
+    cache_overlap_positions(transaction);
+    transaction.next_state = Transaction<dim, spacedim>::State::Done;
+
+    return_scatter(*transaction.native_position_dof_handler,
+                   std::move(transaction.position_scatter));
+    return_overlap_vectors(transaction);
+  }
+
+
+
   template <int dim, int spacedim>
   std::unique_ptr<TransactionBase>
   InteractionBase<dim, spacedim>::compute_spread_scatter_finish(
@@ -557,10 +1429,8 @@ namespace fdl
             Transaction<dim, spacedim>::State::ScatterFinish),
            ExcMessage("Transaction state should be Intermediate"));
 
-    trans.position_scatter.global_to_overlap_finish(*trans.native_position,
-                                                    trans.overlap_position);
-    trans.solution_scatter.global_to_overlap_finish(*trans.native_solution,
-                                                    trans.overlap_solution);
+    finish_spread_scatters(trans);
+    cache_overlap_positions(trans);
 
     trans.next_state = Transaction<dim, spacedim>::State::Intermediate;
 
@@ -582,10 +1452,7 @@ namespace fdl
             Transaction<dim, spacedim>::State::Intermediate),
            ExcMessage("Transaction state should be Intermediate"));
 
-    trans.position_scatter.global_to_overlap_finish(*trans.native_position,
-                                                    trans.overlap_position);
-    trans.solution_scatter.global_to_overlap_finish(*trans.native_solution,
-                                                    trans.overlap_solution);
+    finish_spread_scatters(trans);
 
     // this is the point at which a base class would normally do computations.
 
@@ -615,8 +1482,10 @@ namespace fdl
 
     return_scatter(*trans.native_position_dof_handler,
                    std::move(trans.position_scatter));
-    return_scatter(*trans.native_dof_handler,
-                   std::move(trans.solution_scatter));
+    if (!trans.batch_solution_scatter)
+      return_scatter(*trans.native_dof_handler,
+                     std::move(trans.solution_scatter));
+    return_overlap_vectors(trans);
   }
 
   template <int dim, int spacedim>
@@ -635,15 +1504,22 @@ namespace fdl
     transaction.native_position_dof_handler = &position_dof_handler;
     transaction.native_position             = &position;
     transaction.position_scatter = this->get_scatter(position_dof_handler);
-    transaction.overlap_position.reinit(
+    transaction.overlap_position = this->get_overlap_vector(
       this->get_overlap_dof_handler(position_dof_handler).n_dofs());
 
     // Setup state:
     transaction.next_state =
       WorkloadTransaction<dim, spacedim>::State::Intermediate;
 
-    transaction.position_scatter.global_to_overlap_start(
-      *transaction.native_position, 0, transaction.overlap_position);
+    transaction.position_version = get_position_version(position);
+    transaction.reuse_overlap_position =
+      find_cached_overlap_position(position_dof_handler,
+                                   position,
+                                   transaction.position_version,
+                                   transaction.overlap_position);
+    if (!transaction.reuse_overlap_position)
+      transaction.position_scatter.global_to_overlap_start(
+        *transaction.native_position, 0, transaction.overlap_position);
 
     return t_ptr;
   }
@@ -670,6 +1546,81 @@ namespace fdl
 
     this->return_scatter(*trans.native_position_dof_handler,
                          std::move(trans.position_scatter));
+    this->return_overlap_vector(std::move(trans.overlap_position));
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  InteractionBase<dim, spacedim>::set_workload_weight(const double weight)
+  {
+    AssertThrow(weight >= 0.0,
+                ExcMessage("The workload weight should not be negative"));
+    workload_weight = weight;
+  }
+
+
+
+  template <int dim, int spacedim>
+  double
+  InteractionBase<dim, spacedim>::get_workload_weight() const
+  {
+    return workload_weight;
+  }
+
+
+
+  template <int dim, int spacedim>
+  double
+  InteractionBase<dim, spacedim>::get_local_unweighted_workload() const
+  {
+    return local_unweighted_workload;
+  }
+
+  template <int dim, int spacedim>
+  const OverlapTriangulation<dim, spacedim> &
+  InteractionBase<dim, spacedim>::get_overlap_triangulation() const
+  {
+    return overlap_tria;
+  }
+
+  template <int dim, int spacedim>
+  const ScatterStatistics &
+  InteractionBase<dim, spacedim>::get_scatter_statistics() const
+  {
+    return scatter_statistics;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  InteractionBase<dim, spacedim>::reset_scatter_statistics()
+  {
+    scatter_statistics = ScatterStatistics();
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  InteractionBase<dim, spacedim>::memory_consumption() const
+  {
+    std::size_t result =
+      overlap_tria.memory_consumption() +
+      MemoryConsumption::memory_consumption(
+        overlap_to_native_dof_translations) +
+      MemoryConsumption::memory_consumption(scatters) +
+      MemoryConsumption::memory_consumption(scatter_cache) +
+      MemoryConsumption::memory_consumption(overlap_vector_pool) +
+      patch_bboxes.capacity() * sizeof(patch_bboxes[0]);
+    for (const auto &overlap_dof_handler : overlap_dof_handlers)
+      if (overlap_dof_handler)
+        result += overlap_dof_handler->memory_consumption();
+    for (const CachedOverlapPosition &entry : overlap_position_cache)
+      result += sizeof(entry) + entry.overlap_position.memory_consumption();
+    return result;
   }
 
   // instantiations
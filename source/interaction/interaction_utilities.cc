@@ -1,15 +1,28 @@
+#include <fiddle/base/markers.h>
 #include <fiddle/base/samrai_utilities.h>
 
 #include <fiddle/grid/box_utilities.h>
 #include <fiddle/grid/nodal_patch_map.h>
+#include <fiddle/grid/patch_intersection_map.h>
 #include <fiddle/grid/patch_map.h>
 
+#include <fiddle/interaction/ib_kernels.h>
 #include <fiddle/interaction/interaction_utilities.h>
 
 #include <fiddle/transfer/overlap_partitioning_tools.h>
 
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/vectorization.h>
+
 #include <deal.II/fe/fe_nothing.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_tools.h>
 #include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_fe_field.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/vector.h>
 
 #include <deal.II/numerics/rtree.h>
 
@@ -19,9 +32,20 @@
 #include <ibtk/IndexUtilities.h>
 #include <ibtk/LEInteractor.h>
 
+#include <CartesianPatchGeometry.h>
+#include <CellData.h>
+#include <CellIterator.h>
+#include <SideData.h>
+#include <SideGeometry.h>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
 #include <memory>
+#include <numeric>
 #include <optional>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace fdl
@@ -75,6 +99,1680 @@ namespace fdl
                  ExcMessage("Not enough quadrature rules"));
         }
     }
+
+    /**
+     * A collection of FEValues objects, one for each quadrature rule, which
+     * are only constructed when they are first used. Setting up an FEValues
+     * object (in particular, the internal data of a MappingFEField) is
+     * expensive and typically only a few of the quadrature rules are actually
+     * used by the cells on a given processor. Similarly, if all quadrature
+     * points are available from a QuadraturePointCache then the FEValues
+     * objects for the position are never constructed.
+     */
+    template <int dim, int spacedim>
+    class LazyFEValues
+    {
+    public:
+      LazyFEValues(const Mapping<dim, spacedim>       &mapping,
+                   const FiniteElement<dim, spacedim> &fe,
+                   const std::vector<Quadrature<dim>> &quadratures,
+                   const UpdateFlags                   update_flags)
+        : mapping(mapping)
+        , fe(fe)
+        , quadratures(quadratures)
+        , update_flags(quadratures.size(), update_flags)
+        , fe_values(quadratures.size())
+      {}
+
+      /**
+       * Set the update flags used for quadrature rule @p quad_index.
+       */
+      void
+      set_update_flags(const std::size_t quad_index, const UpdateFlags flags)
+      {
+        AssertIndexRange(quad_index, update_flags.size());
+        Assert(!fe_values[quad_index],
+               ExcMessage("The FEValues object was already constructed"));
+        update_flags[quad_index] = flags;
+      }
+
+      /**
+       * Return the FEValues object for quadrature rule @p quad_index,
+       * constructing it if necessary.
+       */
+      FEValues<dim, spacedim> &
+      operator[](const std::size_t quad_index)
+      {
+        AssertIndexRange(quad_index, fe_values.size());
+        if (!fe_values[quad_index])
+          fe_values[quad_index] =
+            std::make_unique<FEValues<dim, spacedim>>(mapping,
+                                                      fe,
+                                                      quadratures[quad_index],
+                                                      update_flags[quad_index]);
+        return *fe_values[quad_index];
+      }
+
+    private:
+      const Mapping<dim, spacedim>       &mapping;
+      const FiniteElement<dim, spacedim> &fe;
+      const std::vector<Quadrature<dim>> &quadratures;
+
+      // We probably don't need more than 16 quadrature rules
+      boost::container::small_vector<UpdateFlags, 16> update_flags;
+
+      boost::container::small_vector<std::unique_ptr<FEValues<dim, spacedim>>,
+                                     16>
+        fe_values;
+    };
+
+    /**
+     * Object computing the quadrature points of cells for each quadrature
+     * rule.
+     *
+     * Positions are almost always described by a MappingFEField over an
+     * isoparametric Q1 or P1 position field, in which case each quadrature
+     * point is a fixed linear combination of the cell's (mapped) vertices.
+     * This class detects that case and then computes the points directly
+     * from MappingFEField::get_vertices() and tabulated d-linear shape
+     * function values, which avoids setting up the MappingFEField's internal
+     * data (e.g., Jacobians, which are not needed here) on every cell. Other
+     * mappings fall back to FEValues. Both approaches compute the same points
+     * up to roundoff.
+     */
+    template <int dim, int spacedim>
+    class PositionQuadraturePoints
+    {
+    public:
+      PositionQuadraturePoints(const Mapping<dim, spacedim>       &mapping,
+                               const FiniteElement<dim, spacedim> &fe,
+                               const std::vector<Quadrature<dim>> &quadratures)
+        : mapping(mapping)
+        , quadratures(quadratures)
+        , fe_values(mapping, fe, quadratures, update_quadrature_points)
+        , vertex_weights(quadratures.size())
+      {
+        const auto *fe_field_mapping =
+          dynamic_cast<const MappingFEField<dim, spacedim, Vector<double>> *>(
+            &mapping);
+        uses_linear_mapping =
+          fe_field_mapping != nullptr && fe_field_mapping->get_degree() == 1;
+      }
+
+      /**
+       * Return the quadrature points of @p cell computed with quadrature
+       * rule @p quad_index.
+       */
+      const std::vector<Point<spacedim>> &
+      get_quadrature_points(
+        const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell,
+        const std::size_t quad_index)
+      {
+        if (!uses_linear_mapping)
+          {
+            FEValues<dim, spacedim> &position_fe_values =
+              fe_values[quad_index];
+            position_fe_values.reinit(cell);
+            return position_fe_values.get_quadrature_points();
+          }
+
+        AssertIndexRange(quad_index, vertex_weights.size());
+        const ReferenceCell reference_cell = cell->reference_cell();
+        const Quadrature<dim> &quadrature  = quadratures[quad_index];
+        FullMatrix<double>    &weights     = vertex_weights[quad_index];
+        if (weights.m() == 0)
+          {
+            weights.reinit(quadrature.size(), reference_cell.n_vertices());
+            for (unsigned int q = 0; q < quadrature.size(); ++q)
+              for (const unsigned int v : reference_cell.vertex_indices())
+                weights(q, v) = reference_cell.d_linear_shape_function(
+                  quadrature.point(q), v);
+          }
+
+        const auto vertices = mapping.get_vertices(cell);
+        AssertDimension(vertices.size(), weights.n());
+        q_points.resize(quadrature.size());
+        for (unsigned int q = 0; q < quadrature.size(); ++q)
+          {
+            Point<spacedim> &q_point = q_points[q];
+            q_point                  = Point<spacedim>();
+            for (unsigned int v = 0; v < vertices.size(); ++v)
+              q_point += weights(q, v) * vertices[v];
+          }
+        return q_points;
+      }
+
+    private:
+      const Mapping<dim, spacedim>       &mapping;
+      const std::vector<Quadrature<dim>> &quadratures;
+
+      /**
+       * Whether or not @p mapping is a MappingFEField with a linear position
+       * field.
+       */
+      bool uses_linear_mapping;
+
+      /**
+       * Fallback for other mappings.
+       */
+      LazyFEValues<dim, spacedim> fe_values;
+
+      /**
+       * Values of the d-linear shape functions at the quadrature points, one
+       * matrix per quadrature rule. Only computed when first used.
+       */
+      std::vector<FullMatrix<double>> vertex_weights;
+
+      std::vector<Point<spacedim>> q_points;
+    };
+
+    template <typename Scalar>
+    void
+    check_workload_weight(const double weight)
+    {
+      (void)weight;
+      Assert(weight >= 0.0,
+             ExcMessage("Workload weights should not be negative."));
+      Assert(!std::is_integral_v<Scalar> || weight == 1.0,
+             ExcMessage("Workload weights other than one require "
+                        "floating-point patch data."));
+    }
+
+    /**
+     * Compute the quadrature points of all cells associated with a patch in
+     * the order in which PatchMap iterates over them. On output,
+     * @p cell_q_point_offsets contains the index of the first quadrature point
+     * of each cell followed by the total number of quadrature points.
+     */
+    template <int dim, int spacedim>
+    void
+    compute_patch_quadrature_points(
+      const PatchMap<dim, spacedim>           &patch_map,
+      const std::size_t                        patch_n,
+      const DoFHandler<dim, spacedim>         &dof_handler,
+      const std::vector<unsigned char>        &quadrature_indices,
+      PositionQuadraturePoints<dim, spacedim> &position_q_points,
+      std::vector<Point<spacedim>>            &q_points,
+      std::vector<std::size_t>                &cell_q_point_offsets)
+    {
+      q_points.clear();
+      cell_q_point_offsets.assign(1, 0);
+      auto       iter = patch_map.begin(patch_n, dof_handler);
+      const auto end  = patch_map.end(patch_n, dof_handler);
+      for (; iter != end; ++iter)
+        {
+          const auto cell       = *iter;
+          const auto quad_index = quadrature_indices[cell->active_cell_index()];
+          const std::vector<Point<spacedim>> &cell_q_points =
+            position_q_points.get_quadrature_points(cell, quad_index);
+          q_points.insert(q_points.end(),
+                          cell_q_points.begin(),
+                          cell_q_points.end());
+          cell_q_point_offsets.push_back(q_points.size());
+        }
+    }
+
+    /**
+     * Object computing the indices of the Eulerian cells which contain points
+     * on a patch. Cell indices are computed in exactly the same way as
+     * IBTK::IndexUtilities::getCellIndex() (so points are assigned to the
+     * same patches as in IBAMR) but the patch geometry is only looked up once
+     * per patch instead of once per point.
+     *
+     * This is the only place where fiddle's interaction routines compute the
+     * cell indices of points: workload counting uses them directly and
+     * compute_cell_data_weights() stores whether or not each point is in the
+     * patch in its stencil so that the kernels (and the kernel weight cache)
+     * do not need to compute them again.
+     */
+    template <int spacedim>
+    class PatchCellIndexer
+    {
+    public:
+      PatchCellIndexer(const hier::Patch<spacedim> &patch)
+        : patch_geom(patch.getPatchGeometry())
+        , patch_box(patch.getBox())
+      {
+        Assert(patch_geom, ExcMessage("Type mismatch"));
+        x_lower = patch_geom->getXLower();
+        x_upper = patch_geom->getXUpper();
+        dx      = patch_geom->getDx();
+        for (unsigned int d = 0; d < spacedim; ++d)
+          {
+            touches_lower[d] = patch_geom->getTouchesRegularBoundary(d, 0);
+            touches_upper[d] = patch_geom->getTouchesRegularBoundary(d, 1);
+          }
+      }
+
+      hier::Index<spacedim>
+      get_cell_index(const Point<spacedim> &point) const
+      {
+        return IBTK::IndexUtilities::getCellIndex(point,
+                                                  x_lower,
+                                                  x_upper,
+                                                  dx,
+                                                  patch_box.lower(),
+                                                  patch_box.upper());
+      }
+
+      bool
+      is_in_patch(const Point<spacedim> &point) const
+      {
+        return patch_box.contains(get_cell_index(point));
+      }
+
+      /**
+       * Return whether or not a point lies outside the physical domain, i.e.,
+       * past a non-periodic boundary touched by the patch. Such points are not
+       * in any patch.
+       */
+      bool
+      is_exterior(const Point<spacedim> &point) const
+      {
+        const hier::Index<spacedim> index = get_cell_index(point);
+        for (unsigned int d = 0; d < spacedim; ++d)
+          if ((touches_lower[d] && index(d) < patch_box.lower(d)) ||
+              (touches_upper[d] && index(d) > patch_box.upper(d)))
+            return true;
+        return false;
+      }
+
+      /**
+       * Compute the cell indices of all @p points in @p cell_indices, which
+       * is resized (and may therefore be reused between patches to avoid
+       * allocations).
+       */
+      void
+      get_cell_indices(const ArrayView<const Point<spacedim>> &points,
+                       std::vector<hier::Index<spacedim>> &cell_indices) const
+      {
+        cell_indices.resize(points.size());
+        for (std::size_t point_n = 0; point_n < points.size(); ++point_n)
+          cell_indices[point_n] = get_cell_index(points[point_n]);
+      }
+
+      const hier::Box<spacedim> &
+      get_patch_box() const
+      {
+        return patch_box;
+      }
+
+    private:
+      tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> patch_geom;
+
+      const hier::Box<spacedim> &patch_box;
+
+      const double *x_lower;
+      const double *x_upper;
+      const double *dx;
+
+      std::array<bool, spacedim> touches_lower;
+      std::array<bool, spacedim> touches_upper;
+    };
+
+    /**
+     * Find the points on a patch which lie outside the physical domain. These
+     * points are never interpolated or spread, but we would otherwise still
+     * compute their values and kernel weights on every patch next to the
+     * boundary.
+     *
+     * If at least one point is exterior then @p is_exterior marks each
+     * exterior point and @p interior_points contains the other points, in
+     * order. Otherwise both vectors are empty.
+     */
+    template <int spacedim>
+    void
+    find_exterior_points(const hier::Patch<spacedim>        &patch,
+                         const std::vector<Point<spacedim>> &points,
+                         std::vector<unsigned char>         &is_exterior,
+                         std::vector<Point<spacedim>>       &interior_points)
+    {
+      is_exterior.clear();
+      interior_points.clear();
+      const PatchCellIndexer<spacedim> indexer(patch);
+      for (std::size_t point_n = 0; point_n < points.size(); ++point_n)
+        if (indexer.is_exterior(points[point_n]))
+          {
+            if (is_exterior.size() == 0)
+              {
+                is_exterior.resize(points.size(), false);
+                interior_points.assign(points.begin(),
+                                       points.begin() + point_n);
+              }
+            is_exterior[point_n] = true;
+          }
+        else if (is_exterior.size() > 0)
+          interior_points.push_back(points[point_n]);
+    }
+
+    /**
+     * Quadrature points of a patch, as returned by
+     * get_patch_quadrature_points().
+     */
+    template <int spacedim>
+    struct PatchQuadraturePointData
+    {
+      /**
+       * All quadrature points, in the order in which PatchMap iterates over
+       * cells.
+       */
+      const std::vector<Point<spacedim>> &q_points;
+
+      /**
+       * Index of the first quadrature point of each cell followed by the
+       * total number of quadrature points.
+       */
+      const std::vector<std::size_t> &cell_q_point_offsets;
+
+      /**
+       * Whether or not each point lies outside the physical domain (see
+       * find_exterior_points()). Empty if no point does.
+       */
+      const std::vector<unsigned char> &is_exterior;
+
+      /**
+       * Points which should actually be interpolated or spread: i.e., either
+       * q_points or, if some points are exterior, the remaining points.
+       */
+      const std::vector<Point<spacedim>> &interior_q_points;
+    };
+
+
+    /**
+     * Get the quadrature points of a patch (see
+     * compute_patch_quadrature_points()) and classify the exterior ones (see
+     * find_exterior_points()). If @p quadrature_point_cache is not nullptr
+     * then the cached data is returned, after being computed if necessary.
+     * Otherwise the data is computed in @p q_points, @p cell_q_point_offsets,
+     * @p is_exterior, and @p interior_q_points.
+     */
+    template <int dim, int spacedim>
+    PatchQuadraturePointData<spacedim>
+    get_patch_quadrature_points(
+      const PatchMap<dim, spacedim>           &patch_map,
+      const std::size_t                        patch_n,
+      const DoFHandler<dim, spacedim>         &dof_handler,
+      const std::vector<unsigned char>        &quadrature_indices,
+      PositionQuadraturePoints<dim, spacedim> &position_q_points,
+      QuadraturePointCache<spacedim>          *quadrature_point_cache,
+      std::vector<Point<spacedim>>            &q_points,
+      std::vector<std::size_t>                &cell_q_point_offsets,
+      std::vector<unsigned char>              &is_exterior,
+      std::vector<Point<spacedim>>            &interior_q_points)
+    {
+      const auto make_data =
+        [](const std::vector<Point<spacedim>> &points,
+           const std::vector<std::size_t>     &offsets,
+           const std::vector<unsigned char>   &exterior,
+           const std::vector<Point<spacedim>> &interior)
+      {
+        return PatchQuadraturePointData<spacedim>{
+          points, offsets, exterior, exterior.size() > 0 ? interior : points};
+      };
+      if (quadrature_point_cache == nullptr)
+        {
+          compute_patch_quadrature_points(patch_map,
+                                          patch_n,
+                                          dof_handler,
+                                          quadrature_indices,
+                                          position_q_points,
+                                          q_points,
+                                          cell_q_point_offsets);
+          find_exterior_points(*patch_map.get_patch(patch_n),
+                               q_points,
+                               is_exterior,
+                               interior_q_points);
+          return make_data(q_points,
+                           cell_q_point_offsets,
+                           is_exterior,
+                           interior_q_points);
+        }
+
+      Assert(patch_n < quadrature_point_cache->is_current.size(),
+             ExcMessage("The cache should be reinitialized first"));
+      if (!quadrature_point_cache->is_current[patch_n])
+        {
+          compute_patch_quadrature_points(
+            patch_map,
+            patch_n,
+            dof_handler,
+            quadrature_indices,
+            position_q_points,
+            quadrature_point_cache->q_points[patch_n],
+            quadrature_point_cache->cell_q_point_offsets[patch_n]);
+          find_exterior_points(*patch_map.get_patch(patch_n),
+                               quadrature_point_cache->q_points[patch_n],
+                               quadrature_point_cache->is_exterior[patch_n],
+                               quadrature_point_cache
+                                 ->interior_q_points[patch_n]);
+          quadrature_point_cache->is_current[patch_n] = true;
+        }
+      return make_data(quadrature_point_cache->q_points[patch_n],
+                       quadrature_point_cache->cell_q_point_offsets[patch_n],
+                       quadrature_point_cache->is_exterior[patch_n],
+                       quadrature_point_cache->interior_q_points[patch_n]);
+    }
+
+    /**
+     * Value stored in the first entry of a point's stencil by
+     * compute_cell_data_weights() if the point is not in the patch box.
+     */
+    constexpr int outside_patch_stencil = std::numeric_limits<int>::min();
+
+    /**
+     * Compute the stencils and kernel weights of a set of points for
+     * cell-centered data on a patch. The stencils of points outside the patch
+     * box (which are neither interpolated nor spread) are marked with
+     * outside_patch_stencil.
+     */
+    template <typename Kernel, int spacedim, typename Number>
+    void
+    compute_cell_data_weights(
+      const hier::Patch<spacedim>            &patch,
+      const ArrayView<const Point<spacedim>> &points,
+      std::vector<std::array<int, spacedim>> &stencil_lower,
+      std::vector<Number>                    &weights)
+    {
+      const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> patch_geom =
+        patch.getPatchGeometry();
+      Assert(patch_geom, ExcMessage("Type mismatch"));
+      const hier::Box<spacedim> &patch_box = patch.getBox();
+
+      std::array<double, spacedim> x_lower;
+      std::array<double, spacedim> dx;
+      std::array<int, spacedim>    i_lower;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        {
+          x_lower[d] = patch_geom->getXLower()[d];
+          dx[d]      = patch_geom->getDx()[d];
+          i_lower[d] = patch_box.lower()(d);
+        }
+      compute_kernel_weights<Kernel, spacedim, Number>(
+        points, x_lower, dx, i_lower, stencil_lower, weights);
+
+      const PatchCellIndexer<spacedim> indexer(patch);
+      for (std::size_t point_n = 0; point_n < points.size(); ++point_n)
+        if (!indexer.is_in_patch(points[point_n]))
+          stencil_lower[point_n][0] = outside_patch_stencil;
+    }
+
+    /**
+     * Compute the stencils and kernel weights of a set of points for
+     * side-centered data on a patch.
+     *
+     * The data of each axis is face-centered along that axis and
+     * cell-centered along the others. Hence, instead of computing spacedim
+     * sets of spacedim one-dimensional weights per point, we compute the
+     * cell-centered and face-centered weights in each direction once and
+     * combine them for each axis. The first points.size() entries of @p
+     * stencil_lower and the first points.size() * spacedim * Kernel::width
+     * entries of @p weights are the cell-centered stencils and weights (as
+     * computed by compute_cell_data_weights()) and the remaining entries are
+     * the face-centered ones, stored in the same way.
+     */
+    template <typename Kernel, int spacedim, typename Number>
+    void
+    compute_side_data_weights(
+      const hier::Patch<spacedim>            &patch,
+      const ArrayView<const Point<spacedim>> &points,
+      std::vector<std::array<int, spacedim>> &stencil_lower,
+      std::vector<Number>                    &weights)
+    {
+      const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> patch_geom =
+        patch.getPatchGeometry();
+      Assert(patch_geom, ExcMessage("Type mismatch"));
+      const hier::Box<spacedim> &patch_box = patch.getBox();
+
+      std::array<double, spacedim> x_lower;
+      std::array<double, spacedim> x_lower_face;
+      std::array<double, spacedim> dx;
+      std::array<int, spacedim>    i_lower;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        {
+          x_lower[d] = patch_geom->getXLower()[d];
+          dx[d]      = patch_geom->getDx()[d];
+          i_lower[d] = patch_box.lower()(d);
+          // Face i is at x_lower + i dx, i.e., at the center of cell i of a
+          // grid shifted by half a cell
+          x_lower_face[d] = x_lower[d] - 0.5 * dx[d];
+        }
+      std::vector<std::array<int, spacedim>> face_stencil_lower;
+      std::vector<Number>                    face_weights;
+      compute_kernel_weights<Kernel, spacedim, Number>(
+        points, x_lower, dx, i_lower, stencil_lower, weights);
+      compute_kernel_weights<Kernel, spacedim, Number>(
+        points, x_lower_face, dx, i_lower, face_stencil_lower, face_weights);
+      stencil_lower.insert(stencil_lower.end(),
+                           face_stencil_lower.begin(),
+                           face_stencil_lower.end());
+      weights.insert(weights.end(), face_weights.begin(), face_weights.end());
+
+      // As in IBTK::LEInteractor, points are assigned to patches by their cell
+      // index
+      const PatchCellIndexer<spacedim> indexer(patch);
+      for (std::size_t point_n = 0; point_n < points.size(); ++point_n)
+        if (!indexer.is_in_patch(points[point_n]))
+          stencil_lower[point_n][0] = outside_patch_stencil;
+    }
+
+    /**
+     * Compute the offset into SAMRAI's (column-major) array of the first
+     * entry in a stencil. Returns -1 if the point is not in the patch box
+     * (and should therefore be skipped).
+     */
+    template <int width, int spacedim>
+    std::ptrdiff_t
+    get_stencil_offset(
+      const std::array<int, spacedim>            &stencil_lower,
+      const hier::Box<spacedim>                  &ghost_box,
+      const std::array<std::ptrdiff_t, spacedim> &strides)
+    {
+      if (stencil_lower[0] == outside_patch_stencil)
+        return -1;
+
+      std::ptrdiff_t offset = 0;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        {
+          (void)ghost_box;
+          Assert(ghost_box.lower()(d) <= stencil_lower[d] &&
+                   stencil_lower[d] + width - 1 <= ghost_box.upper()(d),
+                 ExcMessage("The kernel stencil should be contained in the "
+                            "ghost region of the patch data."));
+          offset += (stencil_lower[d] - ghost_box.lower()(d)) * strides[d];
+        }
+      return offset;
+    }
+
+    template <int spacedim>
+    std::array<std::ptrdiff_t, spacedim>
+    get_strides(const hier::Box<spacedim> &ghost_box)
+    {
+      std::array<std::ptrdiff_t, spacedim> strides;
+      strides[0] = 1;
+      for (unsigned int d = 1; d < spacedim; ++d)
+        strides[d] = strides[d - 1] * ghost_box.numberCells(d - 1);
+      return strides;
+    }
+
+    /**
+     * Interpolate cell-centered data at a set of points with one of the
+     * kernels implemented by fiddle. Like IBTK::LEInteractor::interpolate(),
+     * values are only computed at points inside the patch box: entries of @p
+     * values corresponding to other points are not modified.
+     *
+     * @p stencil_lower and @p weights should have been computed by
+     * compute_cell_data_weights().
+     *
+     * If @p n_fixed_components is positive then it must equal @p n_components.
+     *
+     * If @p Number is float then the innermost (i.e., along the first
+     * coordinate axis) sums of the stencil are computed in single precision.
+     * All other sums are computed in double precision.
+     */
+    template <typename Kernel,
+              int n_fixed_components,
+              int spacedim,
+              typename Number>
+    void
+    interpolate_cell_data_native(
+      const pdat::CellData<spacedim, double>       &patch_data,
+      const hier::Patch<spacedim>                  &patch,
+      const ArrayView<const Point<spacedim>>       &points,
+      const unsigned int                            n_components,
+      const std::vector<std::array<int, spacedim>> &stencil_lower,
+      const std::vector<Number>                    &weights,
+      double                                       *values)
+    {
+      constexpr int width = Kernel::width;
+      // Use the compile-time number of components, if there is one, so that
+      // the component loops can be unrolled
+      const unsigned int n_comp =
+        n_fixed_components > 0 ? n_fixed_components : n_components;
+      const hier::Box<spacedim> &ghost_box = patch_data.getGhostBox();
+      const auto                 strides   = get_strides(ghost_box);
+      AssertDimension(stencil_lower.size(), points.size());
+      AssertDimension(weights.size(), points.size() * spacedim * width);
+      (void)patch;
+
+      for (std::size_t point_n = 0; point_n < points.size(); ++point_n)
+        {
+          const std::ptrdiff_t offset =
+            get_stencil_offset<width>(stencil_lower[point_n],
+                                      ghost_box,
+                                      strides);
+          if (offset < 0)
+            continue;
+
+          const Number *const w = weights.data() + point_n * spacedim * width;
+          for (unsigned int c = 0; c < n_comp; ++c)
+            {
+              const double *const data  = patch_data.getPointer(c) + offset;
+              double              value = 0.0;
+              if constexpr (spacedim == 2)
+                {
+                  for (int k1 = 0; k1 < width; ++k1)
+                    {
+                      Number row = 0.0;
+                      for (int k0 = 0; k0 < width; ++k0)
+                        row += Number(data[k0 + k1 * strides[1]]) * w[k0];
+                      value += double(row) * w[width + k1];
+                    }
+                }
+              else
+                {
+                  for (int k2 = 0; k2 < width; ++k2)
+                    for (int k1 = 0; k1 < width; ++k1)
+                      {
+                        Number row = 0.0;
+                        for (int k0 = 0; k0 < width; ++k0)
+                          row += Number(data[k0 + k1 * strides[1] +
+                                             k2 * strides[2]]) *
+                                 w[k0];
+                        value +=
+                          double(row) * w[width + k1] * w[2 * width + k2];
+                      }
+                }
+              values[point_n * n_comp + c] = value;
+            }
+        }
+    }
+
+    /**
+     * Spread values at a set of points to cell-centered data with one of the
+     * kernels implemented by fiddle. Like IBTK::LEInteractor::spread(), only
+     * points inside the patch box are spread (but their stencils may extend
+     * into the ghost region).
+     *
+     * @p stencil_lower and @p weights should have been computed by
+     * compute_cell_data_weights(). Regardless of @p Number, values are
+     * accumulated into @p patch_data in double precision.
+     */
+    template <typename Kernel,
+              int n_fixed_components,
+              int spacedim,
+              typename Number>
+    void
+    spread_cell_data_native(
+      pdat::CellData<spacedim, double>             &patch_data,
+      const hier::Patch<spacedim>                  &patch,
+      const ArrayView<const Point<spacedim>>       &points,
+      const unsigned int                            n_components,
+      const std::vector<std::array<int, spacedim>> &stencil_lower,
+      const std::vector<Number>                    &weights,
+      const double                                 *values)
+    {
+      constexpr int width = Kernel::width;
+      // Use the compile-time number of components, if there is one, so that
+      // the component loops can be unrolled
+      const unsigned int n_comp =
+        n_fixed_components > 0 ? n_fixed_components : n_components;
+      const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> patch_geom =
+        patch.getPatchGeometry();
+      const hier::Box<spacedim> &ghost_box = patch_data.getGhostBox();
+      const auto                 strides   = get_strides(ghost_box);
+      AssertDimension(stencil_lower.size(), points.size());
+      AssertDimension(weights.size(), points.size() * spacedim * width);
+
+      // The discrete delta function includes a factor of 1 / (cell volume)
+      double inverse_volume = 1.0;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        inverse_volume /= patch_geom->getDx()[d];
+
+      for (std::size_t point_n = 0; point_n < points.size(); ++point_n)
+        {
+          const std::ptrdiff_t offset =
+            get_stencil_offset<width>(stencil_lower[point_n],
+                                      ghost_box,
+                                      strides);
+          if (offset < 0)
+            continue;
+
+          const Number *const w = weights.data() + point_n * spacedim * width;
+          for (unsigned int c = 0; c < n_comp; ++c)
+            {
+              double *const data = patch_data.getPointer(c) + offset;
+              const double  value =
+                values[point_n * n_comp + c] * inverse_volume;
+              if constexpr (spacedim == 2)
+                {
+                  for (int k1 = 0; k1 < width; ++k1)
+                    {
+                      const double row = value * w[width + k1];
+                      for (int k0 = 0; k0 < width; ++k0)
+                        data[k0 + k1 * strides[1]] += row * w[k0];
+                    }
+                }
+              else
+                {
+                  for (int k2 = 0; k2 < width; ++k2)
+                    for (int k1 = 0; k1 < width; ++k1)
+                      {
+                        const double row =
+                          value * w[width + k1] * w[2 * width + k2];
+                        for (int k0 = 0; k0 < width; ++k0)
+                          data[k0 + k1 * strides[1] + k2 * strides[2]] +=
+                            row * w[k0];
+                      }
+                }
+            }
+        }
+    }
+
+    /**
+     * Get the stencil and one-dimensional weights of axis @p axis of
+     * side-centered data from the values computed by
+     * compute_side_data_weights().
+     */
+    template <int width, int spacedim, typename Number>
+    void
+    get_side_stencil(
+      const std::vector<std::array<int, spacedim>> &stencil_lower,
+      const std::vector<Number>                    &weights,
+      const std::size_t                             n_points,
+      const std::size_t                             point_n,
+      const unsigned int                            axis,
+      std::array<int, spacedim>                    &axis_stencil_lower,
+      std::array<const Number *, spacedim>         &axis_weights)
+    {
+      for (unsigned int d = 0; d < spacedim; ++d)
+        {
+          const std::size_t n = (d == axis ? n_points : 0) + point_n;
+          axis_stencil_lower[d] = stencil_lower[n][d];
+          axis_weights[d]       = weights.data() + (n * spacedim + d) * width;
+        }
+    }
+
+    /**
+     * Set up the ghost boxes and strides of each axis of side-centered data.
+     */
+    template <int spacedim>
+    void
+    get_side_boxes(
+      const pdat::SideData<spacedim, double>                     &patch_data,
+      std::array<hier::Box<spacedim>, spacedim>                  &side_boxes,
+      std::array<std::array<std::ptrdiff_t, spacedim>, spacedim> &strides)
+    {
+      AssertDimension(patch_data.getDepth(), 1);
+      for (unsigned int axis = 0; axis < spacedim; ++axis)
+        {
+          side_boxes[axis] =
+            pdat::SideGeometry<spacedim>::toSideBox(patch_data.getGhostBox(),
+                                                    axis);
+          strides[axis] = get_strides(side_boxes[axis]);
+        }
+    }
+
+    /**
+     * Interpolate side-centered data with depth one (i.e., a vector with
+     * spacedim components, such as the velocity of a staggered-grid solver)
+     * at a set of points with one of the kernels implemented by fiddle. Like
+     * interpolate_cell_data_native(), only points inside the patch box are
+     * interpolated. Unlike IBTK::LEInteractor, which interpolates each axis
+     * separately, all components of a point are computed at once from the
+     * weights computed by compute_side_data_weights().
+     *
+     * Precision is handled in the same way as in
+     * interpolate_cell_data_native().
+     */
+    template <typename Kernel, int spacedim, typename Number>
+    void
+    interpolate_side_data_native(
+      const pdat::SideData<spacedim, double>       &patch_data,
+      const hier::Patch<spacedim>                  &patch,
+      const ArrayView<const Point<spacedim>>       &points,
+      const std::vector<std::array<int, spacedim>> &stencil_lower,
+      const std::vector<Number>                    &weights,
+      double                                       *values)
+    {
+      constexpr int     width    = Kernel::width;
+      const std::size_t n_points = points.size();
+      AssertDimension(stencil_lower.size(), 2 * n_points);
+      AssertDimension(weights.size(), 2 * n_points * spacedim * width);
+      (void)patch;
+      std::array<hier::Box<spacedim>, spacedim>                  side_boxes;
+      std::array<std::array<std::ptrdiff_t, spacedim>, spacedim> strides;
+      get_side_boxes(patch_data, side_boxes, strides);
+
+      std::array<int, spacedim>            axis_stencil_lower;
+      std::array<const Number *, spacedim> w;
+      for (std::size_t point_n = 0; point_n < n_points; ++point_n)
+        {
+          if (stencil_lower[point_n][0] == outside_patch_stencil)
+            continue;
+
+          for (unsigned int axis = 0; axis < spacedim; ++axis)
+            {
+              get_side_stencil<width>(stencil_lower,
+                                      weights,
+                                      n_points,
+                                      point_n,
+                                      axis,
+                                      axis_stencil_lower,
+                                      w);
+              const std::ptrdiff_t offset =
+                get_stencil_offset<width>(axis_stencil_lower,
+                                          side_boxes[axis],
+                                          strides[axis]);
+              const auto         &st   = strides[axis];
+              const double *const data = patch_data.getPointer(axis) + offset;
+              double              value = 0.0;
+              if constexpr (spacedim == 2)
+                {
+                  for (int k1 = 0; k1 < width; ++k1)
+                    {
+                      Number row = 0.0;
+                      for (int k0 = 0; k0 < width; ++k0)
+                        row += Number(data[k0 + k1 * st[1]]) * w[0][k0];
+                      value += double(row) * w[1][k1];
+                    }
+                }
+              else
+                {
+                  for (int k2 = 0; k2 < width; ++k2)
+                    for (int k1 = 0; k1 < width; ++k1)
+                      {
+                        Number row = 0.0;
+                        for (int k0 = 0; k0 < width; ++k0)
+                          row +=
+                            Number(data[k0 + k1 * st[1] + k2 * st[2]]) *
+                            w[0][k0];
+                        value += double(row) * w[1][k1] * w[2][k2];
+                      }
+                }
+              values[point_n * spacedim + axis] = value;
+            }
+        }
+    }
+
+    /**
+     * Spread values at a set of points to side-centered data with depth one.
+     * Like interpolate_side_data_native(), all components of each point are
+     * spread at once. Regardless of @p Number, values are accumulated into @p
+     * patch_data in double precision.
+     */
+    template <typename Kernel, int spacedim, typename Number>
+    void
+    spread_side_data_native(
+      pdat::SideData<spacedim, double>             &patch_data,
+      const hier::Patch<spacedim>                  &patch,
+      const ArrayView<const Point<spacedim>>       &points,
+      const std::vector<std::array<int, spacedim>> &stencil_lower,
+      const std::vector<Number>                    &weights,
+      const double                                 *values)
+    {
+      constexpr int     width    = Kernel::width;
+      const std::size_t n_points = points.size();
+      AssertDimension(stencil_lower.size(), 2 * n_points);
+      AssertDimension(weights.size(), 2 * n_points * spacedim * width);
+      const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> patch_geom =
+        patch.getPatchGeometry();
+      std::array<hier::Box<spacedim>, spacedim>                  side_boxes;
+      std::array<std::array<std::ptrdiff_t, spacedim>, spacedim> strides;
+      get_side_boxes(patch_data, side_boxes, strides);
+
+      // The discrete delta function includes a factor of 1 / (cell volume)
+      double inverse_volume = 1.0;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        inverse_volume /= patch_geom->getDx()[d];
+
+      std::array<int, spacedim>            axis_stencil_lower;
+      std::array<const Number *, spacedim> w;
+      for (std::size_t point_n = 0; point_n < n_points; ++point_n)
+        {
+          if (stencil_lower[point_n][0] == outside_patch_stencil)
+            continue;
+
+          for (unsigned int axis = 0; axis < spacedim; ++axis)
+            {
+              get_side_stencil<width>(stencil_lower,
+                                      weights,
+                                      n_points,
+                                      point_n,
+                                      axis,
+                                      axis_stencil_lower,
+                                      w);
+              const std::ptrdiff_t offset =
+                get_stencil_offset<width>(axis_stencil_lower,
+                                          side_boxes[axis],
+                                          strides[axis]);
+              const auto   &st   = strides[axis];
+              double *const data = patch_data.getPointer(axis) + offset;
+              const double  value =
+                values[point_n * spacedim + axis] * inverse_volume;
+              if constexpr (spacedim == 2)
+                {
+                  for (int k1 = 0; k1 < width; ++k1)
+                    {
+                      const double row = value * w[1][k1];
+                      for (int k0 = 0; k0 < width; ++k0)
+                        data[k0 + k1 * st[1]] += row * w[0][k0];
+                    }
+                }
+              else
+                {
+                  for (int k2 = 0; k2 < width; ++k2)
+                    for (int k1 = 0; k1 < width; ++k1)
+                      {
+                        const double row = value * w[1][k1] * w[2][k2];
+                        for (int k0 = 0; k0 < width; ++k0)
+                          data[k0 + k1 * st[1] + k2 * st[2]] +=
+                            row * w[0][k0];
+                      }
+                }
+            }
+        }
+    }
+
+    /**
+     * Call @p f with a default-constructed kernel type corresponding to @p
+     * kernel. Returns false (and does not call @p f) if the kernel is not
+     * implemented by fiddle.
+     */
+    template <typename F>
+    bool
+    dispatch_ib_kernel(const IBKernel kernel, F &&f)
+    {
+      switch (kernel)
+        {
+          case IBKernel::PiecewiseLinear:
+            f(PiecewiseLinearKernel());
+            return true;
+          case IBKernel::IB3:
+            f(IB3Kernel());
+            return true;
+          case IBKernel::IB4:
+            f(IB4Kernel());
+            return true;
+          case IBKernel::BSpline3:
+            f(BSpline3Kernel());
+            return true;
+          case IBKernel::Other:
+            return false;
+        }
+      return false;
+    }
+
+    /**
+     * Call @p f with a std::integral_constant equal to @p n_components if
+     * that value is one or spacedim (the only values which appear in
+     * practice) and zero (i.e., the number of components is only known at
+     * run time) otherwise.
+     */
+    template <int spacedim, typename F>
+    void
+    dispatch_n_components(const unsigned int n_components, F &&f)
+    {
+      if (n_components == 1)
+        f(std::integral_constant<int, 1>());
+      else if (n_components == spacedim)
+        f(std::integral_constant<int, spacedim>());
+      else
+        f(std::integral_constant<int, 0>());
+    }
+
+    /**
+     * Whether or not fiddle's own kernels are used to interpolate or spread
+     * @p n_components components of patch data of type @p patch_type. This
+     * is the case for cell-centered data and for side-centered data with
+     * depth one.
+     */
+    template <int spacedim, typename patch_type>
+    bool
+    has_native_kernel(const IBKernel kernel, const unsigned int n_components)
+    {
+      if (kernel == IBKernel::Other)
+        return false;
+      if constexpr (std::is_same_v<patch_type,
+                                   pdat::CellData<spacedim, double>>)
+        return true;
+      else if constexpr (std::is_same_v<patch_type,
+                                        pdat::SideData<spacedim, double>>)
+        return n_components == spacedim;
+      else
+        return false;
+    }
+
+    /**
+     * Whether or not the interaction routines may process patches
+     * concurrently. This is only the case when fiddle's own kernels are used
+     * since IBTK::LEInteractor is not known to be thread-safe.
+     */
+    template <int spacedim, typename patch_type>
+    bool
+    can_use_threads(const IBKernel kernel, const unsigned int n_components)
+    {
+      return has_native_kernel<spacedim, patch_type>(kernel, n_components);
+    }
+
+    /**
+     * A contiguous range of nodes (or unique points), all associated with the
+     * same patch, which may be processed independently of the other ranges.
+     */
+    struct NodalChunk
+    {
+      std::size_t patch_n;
+      std::size_t nodes_begin;
+      std::size_t n_nodes;
+    };
+
+    /**
+     * Split the intervals of nodes associated with each patch in @p patch_map
+     * into chunks with roughly equal numbers of nodes. Since the number of
+     * nodes per patch (and per interval) varies wildly, this balances the
+     * work far better than splitting the patches themselves. With one thread
+     * each interval is its own chunk.
+     *
+     * If @p use_points is true then the chunks contain the unique points of
+     * @p patch_map (see NodalPatchMap::get_point_indices()) instead of nodes.
+     *
+     * Chunks are ordered first by patch and then by node, so the chunks of a
+     * patch are contiguous.
+     */
+    template <int dim, int spacedim>
+    std::vector<NodalChunk>
+    make_nodal_chunks(const NodalPatchMap<dim, spacedim> &patch_map,
+                      const ExecutionPolicy              &execution_policy,
+                      const bool                          use_points = false)
+    {
+      const auto get_indices = [&](const std::size_t patch_n) -> const auto &
+      {
+        return use_points ? patch_map.get_point_indices(patch_n) :
+                            patch_map[patch_n].first;
+      };
+      const unsigned int stride = use_points ? 1 : spacedim;
+
+      std::size_t n_total_nodes = 0;
+      for (std::size_t patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+        n_total_nodes += get_indices(patch_n).n_elements() / stride;
+      // Don't bother making chunks so small that the task overhead dominates.
+      const std::size_t max_chunk_size =
+        execution_policy.is_serial() ?
+          std::numeric_limits<std::size_t>::max() :
+          execution_policy.get_grain_size(n_total_nodes, 64);
+
+      std::vector<NodalChunk> chunks;
+      for (std::size_t patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+        {
+          const IndexSet &dofs = get_indices(patch_n);
+          for (auto it = dofs.begin_intervals(); it != dofs.end_intervals();
+               ++it)
+            {
+              const std::size_t nodes_begin = *it->begin() / stride;
+              const std::size_t nodes_end =
+                nodes_begin + (it->end() - it->begin()) / stride;
+              for (std::size_t begin = nodes_begin; begin < nodes_end;
+                   begin += max_chunk_size)
+                chunks.push_back(
+                  {patch_n,
+                   begin,
+                   std::min(max_chunk_size, nodes_end - begin)});
+            }
+        }
+
+      return chunks;
+    }
+
+    /**
+     * Interpolate patch data at points. Uses fiddle's own kernels for
+     * cell-centered data and side-centered data with depth one when possible
+     * and otherwise falls back to IBTK::LEInteractor.
+     *
+     * If @p weights_are_current is true then the stencils and weights in @p
+     * stencil_lower and @p weights are assumed to be correct for @p points and
+     * are not recomputed.
+     *
+     * @return Whether or not fiddle's kernels were used - i.e., if true, then
+     * @p stencil_lower and @p weights are now current.
+     *
+     * Weights may be stored in either double or single precision: in the
+     * latter case the stencil is also evaluated in single precision (see
+     * interpolate_cell_data_native()). IBTK::LEInteractor always uses double
+     * precision.
+     */
+    template <int spacedim, typename patch_type, typename Number>
+    bool
+    interpolate_at_points(
+      const std::string                          &kernel_name,
+      const IBKernel                              kernel,
+      const tbox::Pointer<patch_type>            &patch_data,
+      const tbox::Pointer<hier::Patch<spacedim>> &patch,
+      const ArrayView<const Point<spacedim>>     &points,
+      const unsigned int                          n_components,
+      std::vector<std::array<int, spacedim>>     &stencil_lower,
+      std::vector<Number>                        &weights,
+      const bool                                  weights_are_current,
+      double                                     *values)
+    {
+      if constexpr (std::is_same_v<patch_type,
+                                   pdat::CellData<spacedim, double>>)
+        {
+          const bool done = dispatch_ib_kernel(
+            kernel,
+            [&](const auto k)
+            {
+              using Kernel = std::decay_t<decltype(k)>;
+              // Side-centered data stores stencils in a different layout
+              if (!weights_are_current || stencil_lower.size() != points.size())
+                compute_cell_data_weights<Kernel>(*patch,
+                                                  points,
+                                                  stencil_lower,
+                                                  weights);
+              dispatch_n_components<spacedim>(
+                n_components,
+                [&](const auto n_fixed_components)
+                {
+                  using Components = decltype(n_fixed_components);
+                  interpolate_cell_data_native<Kernel, Components::value>(
+                    *patch_data,
+                    *patch,
+                    points,
+                    n_components,
+                    stencil_lower,
+                    weights,
+                    values);
+                });
+            });
+          if (done)
+            return true;
+        }
+      else if constexpr (std::is_same_v<patch_type,
+                                        pdat::SideData<spacedim, double>>)
+        {
+          const bool done =
+            has_native_kernel<spacedim, patch_type>(kernel, n_components) &&
+            dispatch_ib_kernel(
+              kernel,
+              [&](const auto k)
+              {
+                using Kernel = std::decay_t<decltype(k)>;
+                if (!weights_are_current ||
+                    stencil_lower.size() != 2 * points.size())
+                  compute_side_data_weights<Kernel>(*patch,
+                                                    points,
+                                                    stencil_lower,
+                                                    weights);
+                interpolate_side_data_native<Kernel>(*patch_data,
+                                                     *patch,
+                                                     points,
+                                                     stencil_lower,
+                                                     weights,
+                                                     values);
+              });
+          if (done)
+            return true;
+        }
+      (void)kernel;
+      (void)stencil_lower;
+      (void)weights;
+      (void)weights_are_current;
+
+      static_assert(sizeof(Point<spacedim>) == sizeof(double) * spacedim,
+                    "FORTRAN routines assume we are packed");
+      const auto position_data =
+        reinterpret_cast<const double *>(points.data());
+      IBTK::LEInteractor::interpolate(values,
+                                      points.size() * n_components,
+                                      n_components,
+                                      position_data,
+                                      points.size() * spacedim,
+                                      spacedim,
+                                      patch_data,
+                                      patch,
+                                      patch->getBox(),
+                                      kernel_name);
+      return false;
+    }
+
+    /**
+     * Spread values at points into patch data. Like interpolate_at_points(),
+     * uses fiddle's own kernels when possible.
+     */
+    template <int spacedim, typename patch_type, typename Number>
+    bool
+    spread_at_points(const std::string                          &kernel_name,
+                     const IBKernel                              kernel,
+                     tbox::Pointer<patch_type>                  &patch_data,
+                     const tbox::Pointer<hier::Patch<spacedim>> &patch,
+                     const ArrayView<const Point<spacedim>>     &points,
+                     const unsigned int                          n_components,
+                     std::vector<std::array<int, spacedim>>     &stencil_lower,
+                     std::vector<Number>                        &weights,
+                     const bool                          weights_are_current,
+                     const double                               *values)
+    {
+      if constexpr (std::is_same_v<patch_type,
+                                   pdat::CellData<spacedim, double>>)
+        {
+          const bool done = dispatch_ib_kernel(
+            kernel,
+            [&](const auto k)
+            {
+              using Kernel = std::decay_t<decltype(k)>;
+              if (!weights_are_current || stencil_lower.size() != points.size())
+                compute_cell_data_weights<Kernel>(*patch,
+                                                  points,
+                                                  stencil_lower,
+                                                  weights);
+              dispatch_n_components<spacedim>(
+                n_components,
+                [&](const auto n_fixed_components)
+                {
+                  using Components = decltype(n_fixed_components);
+                  spread_cell_data_native<Kernel, Components::value>(
+                    *patch_data,
+                    *patch,
+                    points,
+                    n_components,
+                    stencil_lower,
+                    weights,
+                    values);
+                });
+            });
+          if (done)
+            return true;
+        }
+      else if constexpr (std::is_same_v<patch_type,
+                                        pdat::SideData<spacedim, double>>)
+        {
+          const bool done =
+            has_native_kernel<spacedim, patch_type>(kernel, n_components) &&
+            dispatch_ib_kernel(
+              kernel,
+              [&](const auto k)
+              {
+                using Kernel = std::decay_t<decltype(k)>;
+                if (!weights_are_current ||
+                    stencil_lower.size() != 2 * points.size())
+                  compute_side_data_weights<Kernel>(*patch,
+                                                    points,
+                                                    stencil_lower,
+                                                    weights);
+                spread_side_data_native<Kernel>(*patch_data,
+                                                *patch,
+                                                points,
+                                                stencil_lower,
+                                                weights,
+                                                values);
+              });
+          if (done)
+            return true;
+        }
+      (void)kernel;
+      (void)stencil_lower;
+      (void)weights;
+      (void)weights_are_current;
+
+      static_assert(sizeof(Point<spacedim>) == sizeof(double) * spacedim,
+                    "FORTRAN routines assume we are packed");
+      const auto position_data =
+        reinterpret_cast<const double *>(points.data());
+      IBTK::LEInteractor::spread(patch_data,
+                                 values,
+                                 points.size() * n_components,
+                                 n_components,
+                                 position_data,
+                                 points.size() * spacedim,
+                                 spacedim,
+                                 patch,
+                                 patch->getBox(),
+                                 kernel_name);
+      return false;
+    }
+
+    /**
+     * Like interpolate_at_points(), but determine the type of the patch data
+     * at run time.
+     */
+    template <int spacedim, typename Number>
+    bool
+    interpolate_patch_data_at_points(
+      const std::string                          &kernel_name,
+      const IBKernel                              kernel,
+      const int                                   data_index,
+      const tbox::Pointer<hier::Patch<spacedim>> &patch,
+      const ArrayView<const Point<spacedim>>     &points,
+      const unsigned int                          n_components,
+      std::vector<std::array<int, spacedim>>     &stencil_lower,
+      std::vector<Number>                        &weights,
+      const bool                                  weights_are_current,
+      double                                     *values)
+    {
+      Assert(patch->checkAllocated(data_index),
+             ExcMessage("unallocated data patch index"));
+      const tbox::Pointer<hier::PatchData<spacedim>> data =
+        patch->getPatchData(data_index);
+      const auto pair = extract_types(data);
+      AssertThrow(pair.second == SAMRAIFieldType::Double, ExcNotImplemented());
+
+      const auto interpolate = [&](const auto &patch_data)
+      {
+        Assert(patch_data, ExcMessage("Type mismatch"));
+        check_depth<spacedim>(patch_data, n_components);
+        return interpolate_at_points(kernel_name,
+                                     kernel,
+                                     patch_data,
+                                     patch,
+                                     points,
+                                     n_components,
+                                     stencil_lower,
+                                     weights,
+                                     weights_are_current,
+                                     values);
+      };
+      switch (pair.first)
+        {
+          case SAMRAIPatchType::Edge:
+            return interpolate(
+              tbox::Pointer<pdat::EdgeData<spacedim, double>>(data));
+          case SAMRAIPatchType::Cell:
+            return interpolate(
+              tbox::Pointer<pdat::CellData<spacedim, double>>(data));
+          case SAMRAIPatchType::Side:
+            return interpolate(
+              tbox::Pointer<pdat::SideData<spacedim, double>>(data));
+          case SAMRAIPatchType::Node:
+            return interpolate(
+              tbox::Pointer<pdat::NodeData<spacedim, double>>(data));
+        }
+      return false;
+    }
+
+    /**
+     * Sum-factorized evaluation and integration for FE_Q elements (or
+     * FESystems whose components are all the same FE_Q) with tensor-product
+     * quadrature rules. This lowers the cost of integrating against every
+     * shape function from O(p^{2 dim}) to O(p^{dim + 1}).
+     *
+     * In both integrate() and evaluate() the values at quadrature points are
+     * stored with components varying fastest.
+     */
+    template <int dim, int spacedim>
+    class TensorProductShapes
+    {
+    public:
+      /**
+       * Check whether or not sum factorization can be used with this
+       * combination of element and quadrature.
+       */
+      static bool
+      is_applicable(const FiniteElement<dim, spacedim> &fe,
+                    const Quadrature<dim>              &quad)
+      {
+        if (fe.reference_cell() != ReferenceCells::get_hypercube<dim>() ||
+            fe.n_base_elements() != 1 ||
+            fe.element_multiplicity(0) != fe.n_components() ||
+            dynamic_cast<const FE_Q<dim, spacedim> *>(&fe.base_element(0)) ==
+              nullptr ||
+            !quad.is_tensor_product())
+          return false;
+
+        // We assume that the quadrature points are ordered lexicographically
+        // with x varying fastest and that the same 1D rule is used in each
+        // direction, which is true for QGauss.
+        const auto        &basis = quad.get_tensor_basis();
+        const unsigned int n_q_1d = basis[0].size();
+        for (unsigned int d = 1; d < dim; ++d)
+          if (basis[d].size() != n_q_1d ||
+              basis[d].get_points() != basis[0].get_points())
+            return false;
+        for (unsigned int q = 0; q < quad.size(); ++q)
+          {
+            unsigned int q_d = q;
+            for (unsigned int d = 0; d < dim; ++d)
+              {
+                if (std::abs(quad.point(q)[d] -
+                             basis[0].point(q_d % n_q_1d)[0]) > 1e-14)
+                  return false;
+                q_d /= n_q_1d;
+              }
+          }
+        return true;
+      }
+
+      TensorProductShapes(const FiniteElement<dim, spacedim> &fe,
+                          const Quadrature<dim>              &quad)
+        : n_components(fe.n_components())
+        , n_dofs_1d(fe.base_element(0).degree + 1)
+        , n_q_points_1d(quad.get_tensor_basis()[0].size())
+      {
+        Assert(is_applicable(fe, quad), ExcFDLInternalError());
+        const FiniteElement<dim, spacedim> &base = fe.base_element(0);
+        const std::vector<unsigned int>     lexicographic_to_hierarchic =
+          FETools::lexicographic_to_hierarchic_numbering<dim>(base.degree);
+
+        // Since FE_Q is a Lagrange element, 1D shape functions are the
+        // restrictions of the shape functions i + 0 * n + 0 * n^2 to the x
+        // axis
+        const Quadrature<1> &quad_1d = quad.get_tensor_basis()[0];
+        shape_values_1d.resize(n_dofs_1d * n_q_points_1d);
+        for (unsigned int i = 0; i < n_dofs_1d; ++i)
+          for (unsigned int q = 0; q < n_q_points_1d; ++q)
+            {
+              Point<dim> p;
+              p[0] = quad_1d.point(q)[0];
+              shape_values_1d[i * n_q_points_1d + q] =
+                base.shape_value(lexicographic_to_hierarchic[i], p);
+            }
+
+        lexicographic_to_system.resize(n_components *
+                                       lexicographic_to_hierarchic.size());
+        for (unsigned int c = 0; c < n_components; ++c)
+          for (unsigned int i = 0; i < lexicographic_to_hierarchic.size(); ++i)
+            lexicographic_to_system[c * lexicographic_to_hierarchic.size() +
+                                    i] =
+              fe.component_to_system_index(c, lexicographic_to_hierarchic[i]);
+
+        const std::size_t max_size =
+          Utilities::fixed_power<dim>(std::max(n_dofs_1d, n_q_points_1d));
+        scratch_0.resize(max_size);
+        scratch_1.resize(max_size);
+      }
+
+      /**
+       * Compute <code>cell_rhs[i] += sum_q phi_i(q) values(q)</code>.
+       */
+      void
+      integrate(const double *values, Vector<double> &cell_rhs)
+      {
+        const unsigned int n_dofs = Utilities::fixed_power<dim>(n_dofs_1d);
+        const unsigned int n_q_points =
+          Utilities::fixed_power<dim>(n_q_points_1d);
+        for (unsigned int c = 0; c < n_components; ++c)
+          {
+            for (unsigned int q = 0; q < n_q_points; ++q)
+              scratch_0[q] = values[q * n_components + c];
+            apply<false>();
+            for (unsigned int i = 0; i < n_dofs; ++i)
+              cell_rhs[lexicographic_to_system[c * n_dofs + i]] +=
+                scratch_0[i];
+          }
+      }
+
+      /**
+       * Compute <code>values(q) = sum_i phi_i(q) dof_values[i]</code>.
+       */
+      void
+      evaluate(const std::vector<double> &dof_values, double *values)
+      {
+        const unsigned int n_dofs = Utilities::fixed_power<dim>(n_dofs_1d);
+        const unsigned int n_q_points =
+          Utilities::fixed_power<dim>(n_q_points_1d);
+        for (unsigned int c = 0; c < n_components; ++c)
+          {
+            for (unsigned int i = 0; i < n_dofs; ++i)
+              scratch_0[i] =
+                dof_values[lexicographic_to_system[c * n_dofs + i]];
+            apply<true>();
+            for (unsigned int q = 0; q < n_q_points; ++q)
+              values[q * n_components + c] = scratch_0[q];
+          }
+      }
+
+    protected:
+      /**
+       * Contract scratch_0 with the 1D shape matrix in each coordinate
+       * direction. If @p evaluate is true then we go from DoFs to quadrature
+       * points - otherwise we go the other way. The result is stored in
+       * scratch_0.
+       */
+      template <bool evaluate>
+      void
+      apply()
+      {
+        const unsigned int n_in  = evaluate ? n_dofs_1d : n_q_points_1d;
+        const unsigned int n_out = evaluate ? n_q_points_1d : n_dofs_1d;
+        // Directions we have already processed have n_out entries and the rest
+        // have n_in entries.
+        unsigned int n_pre  = 1;
+        unsigned int n_post = Utilities::fixed_power<dim - 1>(n_in);
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            for (unsigned int post = 0; post < n_post; ++post)
+              for (unsigned int i = 0; i < n_out; ++i)
+                for (unsigned int pre = 0; pre < n_pre; ++pre)
+                  {
+                    double sum = 0.0;
+                    for (unsigned int k = 0; k < n_in; ++k)
+                      {
+                        const double shape =
+                          evaluate ? shape_values_1d[k * n_q_points_1d + i] :
+                                     shape_values_1d[i * n_q_points_1d + k];
+                        sum +=
+                          shape * scratch_0[pre + n_pre * (k + n_in * post)];
+                      }
+                    scratch_1[pre + n_pre * (i + n_out * post)] = sum;
+                  }
+            std::swap(scratch_0, scratch_1);
+            n_pre *= n_out;
+            if (d + 1 < dim)
+              n_post /= n_in;
+          }
+      }
+
+      unsigned int n_components;
+
+      unsigned int n_dofs_1d;
+
+      unsigned int n_q_points_1d;
+
+      // Values of 1D shape functions, indexed by (shape function, quadrature
+      // point).
+      std::vector<double> shape_values_1d;
+
+      // Map between lexicographic numbering (by component) and the system
+      // numbering of the FE.
+      std::vector<unsigned int> lexicographic_to_system;
+
+      std::vector<double> scratch_0;
+
+      std::vector<double> scratch_1;
+    };
+
+    /**
+     * Vectorized integration for FESystems consisting of several copies of a
+     * single scalar element (e.g., FESystem(FE_Q(p), spacedim)) for the cases
+     * in which TensorProductShapes cannot be used, e.g., simplices or
+     * quadrature rules which are not tensor products.
+     *
+     * Since every component uses the same scalar shape functions we only need
+     * the values of the shape functions of the base element. The system index
+     * of each (component, base shape function) pair is computed once, in the
+     * constructor, and sums over quadrature points are computed
+     * VectorizedArray<double>::size() points at a time.
+     */
+    template <int dim, int spacedim>
+    class PrimitiveSystemShapes
+    {
+    public:
+      /**
+       * Check whether or not this class can be used with the given element.
+       */
+      static bool
+      is_applicable(const FiniteElement<dim, spacedim> &fe)
+      {
+        return fe.n_components() > 1 && fe.n_base_elements() == 1 &&
+               fe.element_multiplicity(0) == fe.n_components() &&
+               fe.is_primitive();
+      }
+
+      PrimitiveSystemShapes(const FiniteElement<dim, spacedim> &fe)
+        : n_components(fe.n_components())
+        , n_base_dofs(fe.base_element(0).dofs_per_cell)
+      {
+        Assert(is_applicable(fe), ExcFDLInternalError());
+        base_to_system.resize(n_components * n_base_dofs);
+        for (unsigned int c = 0; c < n_components; ++c)
+          for (unsigned int i = 0; i < n_base_dofs; ++i)
+            base_to_system[c * n_base_dofs + i] =
+              fe.component_to_system_index(c, i);
+      }
+
+      /**
+       * Compute <code>cell_rhs[i] += sum_q phi_i(q) values(q) JxW(q)</code>,
+       * where the values at quadrature points are stored with components
+       * varying fastest. @p fe_values must be initialized on the current cell
+       * with both update_values and update_JxW_values.
+       */
+      void
+      integrate(const FEValues<dim, spacedim> &fe_values,
+                const double                  *values,
+                Vector<double>                &cell_rhs)
+      {
+        constexpr unsigned int n_lanes    = VectorizedArray<double>::size();
+        const unsigned int     n_q_points = fe_values.n_quadrature_points;
+        const unsigned int     n_batches =
+          (n_q_points + n_lanes - 1) / n_lanes;
+
+        // Store quadrature points contiguously and pad with zeros. Since all
+        // components use the same shape functions, those of the first
+        // component suffice.
+        shape_values.resize(n_base_dofs * n_batches);
+        weighted_values.resize(n_components * n_batches);
+        shape_values.fill(VectorizedArray<double>(0.0));
+        weighted_values.fill(VectorizedArray<double>(0.0));
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          {
+            const unsigned int batch = q / n_lanes;
+            const unsigned int lane  = q % n_lanes;
+            for (unsigned int i = 0; i < n_base_dofs; ++i)
+              shape_values[i * n_batches + batch][lane] =
+                fe_values.shape_value(base_to_system[i], q);
+            for (unsigned int c = 0; c < n_components; ++c)
+              weighted_values[c * n_batches + batch][lane] =
+                values[q * n_components + c] * fe_values.JxW(q);
+          }
+
+        for (unsigned int c = 0; c < n_components; ++c)
+          for (unsigned int i = 0; i < n_base_dofs; ++i)
+            {
+              VectorizedArray<double> sum(0.0);
+              for (unsigned int batch = 0; batch < n_batches; ++batch)
+                sum += shape_values[i * n_batches + batch] *
+                       weighted_values[c * n_batches + batch];
+              double total = 0.0;
+              for (unsigned int lane = 0; lane < n_lanes; ++lane)
+                total += sum[lane];
+              cell_rhs[base_to_system[c * n_base_dofs + i]] += total;
+            }
+      }
+
+    protected:
+      unsigned int n_components;
+
+      unsigned int n_base_dofs;
+
+      // Map between (component, base shape function) pairs and the system
+      // numbering of the FE.
+      std::vector<unsigned int> base_to_system;
+
+      // Values of the base shape functions, indexed by (shape function,
+      // batch of quadrature points).
+      AlignedVector<VectorizedArray<double>> shape_values;
+
+      // Values multiplied by JxW, indexed by (component, batch of quadrature
+      // points).
+      AlignedVector<VectorizedArray<double>> weighted_values;
+    };
   } // namespace
 
 
@@ -112,31 +1810,46 @@ namespace fdl
       compute_patch_bboxes<spacedim, float>(patches);
     const auto rtree = pack_rtree_of_indices(patch_bboxes);
 
-    // loop over element bboxes...
+    // Many elements are smaller than a grid cell, so consecutive elements
+    // frequently cover exactly the same cells: only tag each such box once.
+    // The default Box is empty and hence equal to no bounding box's box.
+    hier::Box<spacedim> previous_box;
     for (const auto &bbox : bboxes)
       {
-        // and determine which patches each intersects.
+        // Skip inverted boxes (e.g., those set by
+        // collect_intersecting_active_cell_bboxes()) since they intersect
+        // nothing.
+        bool is_empty = false;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          is_empty = is_empty || bbox.lower_bound(d) > bbox.upper_bound(d);
+        if (is_empty)
+          continue;
+
+        // The cells covered by the bbox do not depend on the patch, so only
+        // compute them once per bbox
+        const hier::Index<spacedim> i_lower =
+          IBTK::IndexUtilities::getCellIndex(bbox.get_boundary_points().first,
+                                             grid_geom->getXLower(),
+                                             grid_geom->getXUpper(),
+                                             dx.data(),
+                                             domain_box.lower(),
+                                             domain_box.upper());
+        const hier::Index<spacedim> i_upper =
+          IBTK::IndexUtilities::getCellIndex(bbox.get_boundary_points().second,
+                                             grid_geom->getXLower(),
+                                             grid_geom->getXUpper(),
+                                             dx.data(),
+                                             domain_box.lower(),
+                                             domain_box.upper());
+        const hier::Box<spacedim> box(i_lower, i_upper);
+        if (box == previous_box)
+          continue;
+        previous_box = box;
+
+        // determine which patches each intersects.
         auto tag_box = [&](const std::size_t &patch_n)
         {
           AssertIndexRange(patch_n, patches.size());
-
-          const hier::Index<spacedim> i_lower =
-            IBTK::IndexUtilities::getCellIndex(bbox.get_boundary_points().first,
-                                               grid_geom->getXLower(),
-                                               grid_geom->getXUpper(),
-                                               dx.data(),
-                                               domain_box.lower(),
-                                               domain_box.upper());
-          const hier::Index<spacedim> i_upper =
-            IBTK::IndexUtilities::getCellIndex(
-              bbox.get_boundary_points().second,
-              grid_geom->getXLower(),
-              grid_geom->getXUpper(),
-              dx.data(),
-              domain_box.lower(),
-              domain_box.upper());
-          const hier::Box<spacedim> box(i_lower, i_upper);
-
           tag_data[patch_n]->fillAll(Scalar(1), box);
         };
 
@@ -204,21 +1917,21 @@ namespace fdl
 
 
   template <int dim, int spacedim, typename Scalar>
-  void
+  double
   count_quadrature_points_internal(
     const int                           qp_data_index,
     PatchMap<dim, spacedim>            &patch_map,
     const Mapping<dim, spacedim>       &position_mapping,
     const std::vector<unsigned char>   &quadrature_indices,
-    const std::vector<Quadrature<dim>> &quadratures)
+    const std::vector<Quadrature<dim>> &quadratures,
+    QuadraturePointCache<spacedim>     *quadrature_point_cache,
+    const double                        weight)
   {
     check_quadratures(quadrature_indices,
                       quadratures,
                       patch_map.get_triangulation());
+    check_workload_weight<Scalar>(weight);
 
-    // We probably don't need more than 16 quadrature rules
-    boost::container::small_vector<std::unique_ptr<FEValues<dim, spacedim>>, 16>
-      all_position_fe_values;
     // PatchMap only supports looping over DoFHandler iterators, so we need to
     // make one and never use it explicitly
     const Triangulation<dim, spacedim> &tria = patch_map.get_triangulation();
@@ -228,13 +1941,147 @@ namespace fdl
     FE_Nothing<dim, spacedim> fe_nothing(reference_cell);
     DoFHandler<dim, spacedim> dof_handler(tria);
     dof_handler.distribute_dofs(fe_nothing);
-    for (const Quadrature<dim> &quad : quadratures)
+    PositionQuadraturePoints<dim, spacedim> position_q_points(position_mapping,
+                                                              fe_nothing,
+                                                              quadratures);
+
+    std::vector<Point<spacedim>>       q_points;
+    std::vector<std::size_t>           cell_q_point_offsets;
+    std::vector<unsigned char>         is_exterior;
+    std::vector<Point<spacedim>>       interior_q_points;
+    std::vector<hier::Index<spacedim>> cell_indices;
+    std::size_t                        n_counted = 0;
+    for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
       {
-        all_position_fe_values.emplace_back(
-          std::make_unique<FEValues<dim, spacedim>>(
-            position_mapping, fe_nothing, quad, update_quadrature_points));
+        auto patch = patch_map.get_patch(patch_n);
+        Assert(patch->checkAllocated(qp_data_index),
+               ExcMessage("unallocated tag patch index"));
+        tbox::Pointer<pdat::CellData<spacedim, Scalar>> qp_data =
+          patch->getPatchData(qp_data_index);
+        Assert(qp_data, ExcMessage("Type mismatch"));
+        Assert(qp_data->getDepth() == 1, ExcMessage("depth should be 1"));
+        const PatchCellIndexer<spacedim> indexer(*patch);
+        const hier::Box<spacedim>       &patch_box = indexer.get_patch_box();
+
+        // Exterior points are in no patch, so they never need to be counted
+        const std::vector<Point<spacedim>> &patch_q_points =
+          get_patch_quadrature_points(patch_map,
+                                      patch_n,
+                                      dof_handler,
+                                      quadrature_indices,
+                                      position_q_points,
+                                      quadrature_point_cache,
+                                      q_points,
+                                      cell_q_point_offsets,
+                                      is_exterior,
+                                      interior_q_points)
+            .interior_q_points;
+        indexer.get_cell_indices(make_array_view(patch_q_points),
+                                 cell_indices);
+        for (const hier::Index<spacedim> &i : cell_indices)
+          if (patch_box.contains(i))
+            {
+              (*qp_data)(i) += Scalar(weight);
+              ++n_counted;
+            }
       }
 
+    return double(n_counted);
+  }
+
+
+
+  template <int dim, int spacedim>
+  double
+  count_quadrature_points(
+    const int                           qp_data_index,
+    PatchMap<dim, spacedim>            &patch_map,
+    const Mapping<dim, spacedim>       &position_mapping,
+    const std::vector<unsigned char>   &quadrature_indices,
+    const std::vector<Quadrature<dim>> &quadratures,
+    QuadraturePointCache<spacedim>     *quadrature_point_cache,
+    const double                        weight)
+  {
+    // SAMRAI doesn't offer a way to dispatch on data type so we have to do it
+    // ourselves
+    if (patch_map.size() == 0)
+      {
+        return 0.0;
+      }
+    else
+      {
+        const tbox::Pointer<hier::Patch<spacedim>> patch =
+          patch_map.get_patch(0);
+
+        const tbox::Pointer<pdat::CellData<spacedim, int>> int_data =
+          patch->getPatchData(qp_data_index);
+        const tbox::Pointer<pdat::CellData<spacedim, float>> float_data =
+          patch->getPatchData(qp_data_index);
+        const tbox::Pointer<pdat::CellData<spacedim, double>> double_data =
+          patch->getPatchData(qp_data_index);
+
+        if (int_data)
+          return count_quadrature_points_internal<dim, spacedim, int>(
+            qp_data_index,
+            patch_map,
+            position_mapping,
+            quadrature_indices,
+            quadratures,
+            quadrature_point_cache,
+            weight);
+        else if (float_data)
+          return count_quadrature_points_internal<dim, spacedim, float>(
+            qp_data_index,
+            patch_map,
+            position_mapping,
+            quadrature_indices,
+            quadratures,
+            quadrature_point_cache,
+            weight);
+        else if (double_data)
+          return count_quadrature_points_internal<dim, spacedim, double>(
+            qp_data_index,
+            patch_map,
+            position_mapping,
+            quadrature_indices,
+            quadratures,
+            quadrature_point_cache,
+            weight);
+        else
+          Assert(false, ExcNotImplemented());
+      }
+
+    return 0.0;
+  }
+
+
+
+  template <int dim, int spacedim, typename Scalar>
+  double
+  estimate_quadrature_points_internal(
+    const int                           qp_data_index,
+    PatchMap<dim, spacedim>            &patch_map,
+    const Mapping<dim, spacedim>       &position_mapping,
+    const std::vector<unsigned char>   &quadrature_indices,
+    const std::vector<Quadrature<dim>> &quadratures,
+    const double                        weight)
+  {
+    check_quadratures(quadrature_indices,
+                      quadratures,
+                      patch_map.get_triangulation());
+    check_workload_weight<Scalar>(weight);
+
+    // PatchMap only supports looping over DoFHandler iterators, so we need to
+    // make one and never use it explicitly
+    const Triangulation<dim, spacedim> &tria = patch_map.get_triangulation();
+    // No mixed meshes yet
+    Assert(tria.get_reference_cells().size() == 1, ExcNotImplemented());
+    const ReferenceCell reference_cell = tria.get_reference_cells().front();
+    FE_Nothing<dim, spacedim> fe_nothing(reference_cell);
+    DoFHandler<dim, spacedim> dof_handler(tria);
+    dof_handler.distribute_dofs(fe_nothing);
+
+    double n_estimated = 0.0;
     for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
       {
         auto patch = patch_map.get_patch(patch_n);
@@ -244,51 +2091,80 @@ namespace fdl
           patch->getPatchData(qp_data_index);
         Assert(qp_data, ExcMessage("Type mismatch"));
         Assert(qp_data->getDepth() == 1, ExcMessage("depth should be 1"));
-        const hier::Box<spacedim> &patch_box = patch->getBox();
-        tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> patch_geom =
-          patch->getPatchGeometry();
-        Assert(patch_geom, ExcMessage("Type mismatch"));
+        const PatchCellIndexer<spacedim> indexer(*patch);
+        const hier::Box<spacedim>       &patch_box = indexer.get_patch_box();
 
         auto       iter = patch_map.begin(patch_n, dof_handler);
         const auto end  = patch_map.end(patch_n, dof_handler);
         for (; iter != end; ++iter)
           {
             const auto cell = *iter;
-            const auto quad_index =
-              quadrature_indices[cell->active_cell_index()];
-
-            FEValues<dim, spacedim> &position_fe_values =
-              *all_position_fe_values[quad_index];
-            position_fe_values.reinit(cell);
-            for (const Point<spacedim> &q_point :
-                 position_fe_values.get_quadrature_points())
+            const auto n_q_points =
+              quadratures[quadrature_indices[cell->active_cell_index()]]
+                .size();
+            // The bounding box only requires the positions of the vertices,
+            // but it may not contain every quadrature point of a curved
+            // element.
+            const BoundingBox<spacedim> bbox =
+              position_mapping.get_bounding_box(cell);
+            const hier::Box<spacedim> cell_box(
+              indexer.get_cell_index(bbox.get_boundary_points().first),
+              indexer.get_cell_index(bbox.get_boundary_points().second));
+            const hier::Box<spacedim> overlap = cell_box * patch_box;
+            if (overlap.empty())
+              continue;
+
+            // Every patch computes the same cell_box, so we can split the
+            // points between the Eulerian cells covered by the bounding box
+            // (and not just the ones in this patch) consistently. For integral
+            // data give the remainder to the first cells in lexicographic
+            // order so that the total is still n_q_points.
+            const std::size_t n_cells = cell_box.size();
+            for (pdat::CellIterator<spacedim> ci(overlap); ci; ci++)
               {
-                const hier::Index<spacedim> i =
-                  IBTK::IndexUtilities::getCellIndex(q_point,
-                                                     patch_geom,
-                                                     patch_box);
-                if (patch_box.contains(i))
-                  (*qp_data)(i) += Scalar(1);
+                const hier::Index<spacedim> &i = ci();
+                if constexpr (std::is_integral_v<Scalar>)
+                  {
+                    std::size_t lexicographic_n = 0;
+                    for (int d = spacedim - 1; d >= 0; --d)
+                      lexicographic_n =
+                        lexicographic_n * cell_box.numberCells(d) +
+                        (i(d) - cell_box.lower(d));
+                    const std::size_t extra =
+                      lexicographic_n < n_q_points % n_cells ? 1 : 0;
+                    (*qp_data)(i) += Scalar(n_q_points / n_cells + extra);
+                    n_estimated += double(n_q_points / n_cells + extra);
+                  }
+                else
+                  {
+                    const double estimate = double(n_q_points) / n_cells;
+                    (*qp_data)(i) += Scalar(weight * estimate);
+                    n_estimated += estimate;
+                  }
               }
           }
       }
+
+    return n_estimated;
   }
 
 
 
   template <int dim, int spacedim>
-  void
-  count_quadrature_points(const int                         qp_data_index,
-                          PatchMap<dim, spacedim>          &patch_map,
-                          const Mapping<dim, spacedim>     &position_mapping,
-                          const std::vector<unsigned char> &quadrature_indices,
-                          const std::vector<Quadrature<dim>> &quadratures)
+  double
+  estimate_quadrature_points(
+    const int                           qp_data_index,
+    PatchMap<dim, spacedim>            &patch_map,
+    const Mapping<dim, spacedim>       &position_mapping,
+    const std::vector<unsigned char>   &quadrature_indices,
+    const std::vector<Quadrature<dim>> &quadratures,
+    const double                        weight)
   {
     // SAMRAI doesn't offer a way to dispatch on data type so we have to do it
     // ourselves
     if (patch_map.size() == 0)
       {
-        return;
+        return 0.0;
       }
     else
       {
@@ -303,39 +2179,51 @@ namespace fdl
           patch->getPatchData(qp_data_index);
 
         if (int_data)
-          count_quadrature_points_internal<dim, spacedim, int>(
+          return estimate_quadrature_points_internal<dim, spacedim, int>(
             qp_data_index,
             patch_map,
             position_mapping,
             quadrature_indices,
-            quadratures);
+            quadratures,
+            weight);
         else if (float_data)
-          count_quadrature_points_internal<dim, spacedim, float>(
+          return estimate_quadrature_points_internal<dim, spacedim, float>(
             qp_data_index,
             patch_map,
             position_mapping,
             quadrature_indices,
-            quadratures);
+            quadratures,
+            weight);
         else if (double_data)
-          count_quadrature_points_internal<dim, spacedim, double>(
+          return estimate_quadrature_points_internal<dim, spacedim, double>(
             qp_data_index,
             patch_map,
             position_mapping,
             quadrature_indices,
-            quadratures);
+            quadratures,
+            weight);
         else
           Assert(false, ExcNotImplemented());
       }
+
+    return 0.0;
   }
 
 
 
   template <int dim, int spacedim, typename Scalar>
-  void
+  double
   count_nodes_internal(const int                     node_count_data_index,
                        NodalPatchMap<dim, spacedim> &nodal_patch_map,
-                       const Vector<double>         &position)
+                       const Vector<double>         &position,
+                       const double                  weight)
   {
+    check_workload_weight<Scalar>(weight);
+    static_assert(sizeof(Point<spacedim>) == sizeof(double) * spacedim,
+                  "Points should be packed");
+
+    std::vector<hier::Index<spacedim>> cell_indices;
+    std::size_t                        n_counted = 0;
     for (std::size_t patch_n = 0; patch_n < nodal_patch_map.size(); ++patch_n)
       {
         std::pair<const IndexSet &, tbox::Pointer<hier::Patch<spacedim>>> p =
@@ -348,49 +2236,44 @@ namespace fdl
           patch->getPatchData(node_count_data_index);
         Assert(node_count_data, ExcMessage("Type mismatch"));
         check_depth<spacedim>(node_count_data, 1);
-        const hier::Box<spacedim> &patch_box = patch->getBox();
-        tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> patch_geom =
-          patch->getPatchGeometry();
-        Assert(patch_geom, ExcMessage("Type mismatch"));
+        const PatchCellIndexer<spacedim> indexer(*patch);
+        const hier::Box<spacedim>       &patch_box = indexer.get_patch_box();
 
         for (auto it = dofs.begin_intervals(); it != dofs.end_intervals(); ++it)
           {
             const auto nodes_begin = *it->begin() / spacedim;
             const auto n_nodes     = (it->end() - it->begin()) / spacedim;
-            const auto position_view =
-              make_array_view(position.begin() + nodes_begin * spacedim,
-                              position.begin() +
-                                (nodes_begin + n_nodes) * spacedim);
-            for (std::ptrdiff_t node_n = 0; node_n < n_nodes; ++node_n)
-              {
-                Point<spacedim> node;
-                for (unsigned int d = 0; d < spacedim; ++d)
-                  node[d] = position_view[spacedim * node_n + d];
-
-                const hier::Index<spacedim> i =
-                  IBTK::IndexUtilities::getCellIndex(node,
-                                                     patch_geom,
-                                                     patch_box);
-                if (patch_box.contains(i))
-                  (*node_count_data)(i) += Scalar(1);
-              }
+            const auto nodes       = make_array_view(
+              reinterpret_cast<const Point<spacedim> *>(position.begin()) +
+                nodes_begin,
+              n_nodes);
+            indexer.get_cell_indices(nodes, cell_indices);
+            for (const hier::Index<spacedim> &i : cell_indices)
+              if (patch_box.contains(i))
+                {
+                  (*node_count_data)(i) += Scalar(weight);
+                  ++n_counted;
+                }
           }
       }
+
+    return double(n_counted);
   }
 
 
 
   template <int dim, int spacedim>
-  void
+  double
   count_nodes(const int                     node_count_data_index,
               NodalPatchMap<dim, spacedim> &nodal_patch_map,
-              const Vector<double>         &position)
+              const Vector<double>         &position,
+              const double                  weight)
   {
     // SAMRAI doesn't offer a way to dispatch on data type so we have to do it
     // ourselves
     if (nodal_patch_map.size() == 0)
       {
-        return;
+        return 0.0;
       }
     else
       {
@@ -405,230 +2288,455 @@ namespace fdl
           patch->getPatchData(node_count_data_index);
 
         if (int_data)
-          count_nodes_internal<dim, spacedim, int>(node_count_data_index,
-                                                   nodal_patch_map,
-                                                   position);
+          return count_nodes_internal<dim, spacedim, int>(
+            node_count_data_index, nodal_patch_map, position, weight);
         else if (float_data)
-          count_nodes_internal<dim, spacedim, float>(node_count_data_index,
-                                                     nodal_patch_map,
-                                                     position);
+          return count_nodes_internal<dim, spacedim, float>(
+            node_count_data_index, nodal_patch_map, position, weight);
         else if (double_data)
-          count_nodes_internal<dim, spacedim, double>(node_count_data_index,
-                                                      nodal_patch_map,
-                                                      position);
+          return count_nodes_internal<dim, spacedim, double>(
+            node_count_data_index, nodal_patch_map, position, weight);
         else
           Assert(false, ExcFDLNotImplemented());
       }
+
+    return 0.0;
   }
 
 
 
-  template <int dim, int spacedim, typename patch_type>
+  template <int dim, int spacedim>
   void
-  compute_projection_rhs_internal(
-    const std::string                  &kernel_name,
-    const int                           data_index,
-    const PatchMap<dim, spacedim>      &patch_map,
-    const Mapping<dim, spacedim>       &position_mapping,
-    const std::vector<unsigned char>   &quadrature_indices,
-    const std::vector<Quadrature<dim>> &quadratures,
-    const DoFHandler<dim, spacedim>    &dof_handler,
-    const Mapping<dim, spacedim>       &mapping,
-    Vector<double>                     &rhs)
+  compute_projection_rhs(
+    const std::string                                    &kernel_name,
+    const std::vector<int>                               &data_indices,
+    const PatchMap<dim, spacedim>                        &patch_map,
+    const Mapping<dim, spacedim>                         &position_mapping,
+    const std::vector<unsigned char>                     &quadrature_indices,
+    const std::vector<Quadrature<dim>>                   &quadratures,
+    const std::vector<const DoFHandler<dim, spacedim> *> &dof_handlers,
+    const std::vector<const Mapping<dim, spacedim> *>    &mappings,
+    const std::vector<Vector<double> *>                  &rhs,
+    KernelWeightCache<spacedim>                          *kernel_weight_cache,
+    const ExecutionPolicy                                &execution_policy,
+    const bool                                            mixed_precision,
+    QuadraturePointCache<spacedim> *quadrature_point_cache)
   {
-    check_quadratures(quadrature_indices,
-                      quadratures,
-                      dof_handler.get_triangulation());
-    const FiniteElement<dim, spacedim> &fe            = dof_handler.get_fe();
-    const unsigned int                  dofs_per_cell = fe.dofs_per_cell;
+    FDL_MARKER_SCOPE(marker, "fdl_projection_rhs");
+    const std::size_t n_fields = data_indices.size();
+    AssertDimension(dof_handlers.size(), n_fields);
+    AssertDimension(mappings.size(), n_fields);
+    AssertDimension(rhs.size(), n_fields);
+    if (n_fields == 0 || patch_map.size() == 0)
+      return;
+    for (std::size_t field_n = 0; field_n < n_fields; ++field_n)
+      {
+        check_quadratures(quadrature_indices,
+                          quadratures,
+                          dof_handlers[field_n]->get_triangulation());
+        Assert(&dof_handlers[field_n]->get_triangulation() ==
+                 &dof_handlers[0]->get_triangulation(),
+               ExcMessage("All fields must use the same Triangulation"));
+      }
     // TODO - do we need to assume something about the block structure of the
     // FE?
 
-    // We probably don't need more than 16 quadrature rules
-    //
-    // TODO - implement a move constructor for FEValues
-    // The FE for position is arbitrary - we just need quadrature points. The
-    // actual position FE is in position_mapping
-    boost::container::small_vector<std::unique_ptr<FEValues<dim, spacedim>>, 16>
-      all_position_fe_values;
-    boost::container::small_vector<std::unique_ptr<FEValues<dim, spacedim>>, 16>
-      all_rhs_fe_values;
-    for (const Quadrature<dim> &quad : quadratures)
+    // Only look up the kernel once
+    const IBKernel kernel = to_ib_kernel(kernel_name);
+    if (kernel_weight_cache)
       {
-        all_position_fe_values.emplace_back(
-          std::make_unique<FEValues<dim, spacedim>>(
-            position_mapping, fe, quad, update_quadrature_points));
-        all_rhs_fe_values.emplace_back(
-          std::make_unique<FEValues<dim, spacedim>>(
-            mapping, fe, quad, update_JxW_values | update_values));
+        Assert(kernel_weight_cache->kernel_name == kernel_name &&
+                 kernel_weight_cache->mixed_precision == mixed_precision,
+               ExcMessage("The cache should be reinitialized first"));
+        AssertDimension(kernel_weight_cache->is_current.size(),
+                        patch_map.size());
       }
 
-    Vector<double>      cell_rhs(dofs_per_cell);
-    std::vector<double> rhs_values;
-
-    std::vector<types::global_dof_index> dof_indices(fe.dofs_per_cell);
-    for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+    // Cells (and hence DoFs) may be shared between patches so, when using
+    // threads, we cannot add into rhs directly. Instead, each patch stages its
+    // cell contributions and we add them afterwards in exactly the same order
+    // as the serial version to get bitwise identical results.
+    bool all_native = true;
+    for (std::size_t field_n = 0; field_n < n_fields; ++field_n)
       {
-        auto patch = patch_map.get_patch(patch_n);
-        Assert(patch->checkAllocated(data_index),
-               ExcMessage("unallocated data patch index"));
-        tbox::Pointer<patch_type> patch_data = patch->getPatchData(data_index);
-        check_depth<spacedim>(patch_data, fe.n_components());
-
-        auto       iter = patch_map.begin(patch_n, dof_handler);
-        const auto end  = patch_map.end(patch_n, dof_handler);
-        for (; iter != end; ++iter)
+        const unsigned int n_components =
+          dof_handlers[field_n]->get_fe().n_components();
+        switch (extract_types(patch_map.get_patch(0)->getPatchData(
+                                data_indices[field_n]))
+                  .first)
           {
-            const auto cell = *iter;
-            const auto quad_index =
-              quadrature_indices[cell->active_cell_index()];
-
-            // Reinitialize:
-            FEValues<dim, spacedim> &rhs_fe_values =
-              *all_rhs_fe_values[quad_index];
-            FEValues<dim, spacedim> &position_fe_values =
-              *all_position_fe_values[quad_index];
-            rhs_fe_values.reinit(cell);
-            position_fe_values.reinit(cell);
-            rhs_values.resize(
-              position_fe_values.get_quadrature_points().size());
-            Assert(rhs_fe_values.get_quadrature() ==
-                     position_fe_values.get_quadrature(),
-                   ExcFDLInternalError());
+            case SAMRAIPatchType::Cell:
+              all_native = all_native &&
+                           has_native_kernel<spacedim,
+                                             pdat::CellData<spacedim, double>>(
+                             kernel, n_components);
+              break;
+            case SAMRAIPatchType::Side:
+              all_native = all_native &&
+                           has_native_kernel<spacedim,
+                                             pdat::SideData<spacedim, double>>(
+                             kernel, n_components);
+              break;
+            default:
+              all_native = false;
+          }
+      }
+    const ExecutionPolicy used_policy =
+      all_native ? execution_policy : ExecutionPolicy();
+    std::vector<std::vector<types::global_dof_index>> staged_dof_indices;
+    std::vector<std::vector<double>>                  staged_cell_rhs;
+    if (!used_policy.is_serial())
+      {
+        staged_dof_indices.resize(patch_map.size() * n_fields);
+        staged_cell_rhs.resize(patch_map.size() * n_fields);
+      }
 
-            cell_rhs = 0.0;
-            cell->get_dof_indices(dof_indices);
-            const std::vector<Point<spacedim>> &q_points =
-              position_fe_values.get_quadrature_points();
-            const unsigned int n_q_points = q_points.size();
-            rhs_values.resize(fe.n_components() * n_q_points);
-
-
-            // Interpolate at quadrature points:
-#if 1
-            // Interpolate values from the patch. This LEInteractor call could
-            // be improved - we don't need to look up certain things on each
-            // element
-            static_assert(sizeof(Point<spacedim>) == sizeof(double) * spacedim,
-                          "FORTRAN routines assume we are packed");
-            const auto position_data =
-              reinterpret_cast<const double *>(q_points.data());
-
-            std::fill(rhs_values.begin(), rhs_values.end(), 0.0);
-            IBTK::LEInteractor::interpolate(rhs_values.data(),
-                                            rhs_values.size(),
-                                            fe.n_components(),
-                                            position_data,
-                                            q_points.size() * spacedim,
-                                            spacedim,
-                                            patch_data,
-                                            patch,
-                                            patch->getBox(),
-                                            kernel_name);
-#else
-            std::fill(rhs_values.begin(), rhs_values.end(), 1.0);
-#endif
+    const auto project_patches =
+      [&](const std::size_t patches_begin, const std::size_t patches_end)
+    {
+      // The FE for position is arbitrary - we just need quadrature points. The
+      // actual position FE is in position_mapping
+      const FiniteElement<dim, spacedim> &position_fe =
+        dof_handlers[0]->get_fe();
+      PositionQuadraturePoints<dim, spacedim> position_q_points(
+        position_mapping, position_fe, quadratures);
+
+      std::vector<LazyFEValues<dim, spacedim>> all_rhs_fe_values;
+      all_rhs_fe_values.reserve(n_fields);
+      // If possible, use sum factorization instead of FEValues to integrate
+      std::vector<boost::container::small_vector<
+        std::unique_ptr<TensorProductShapes<dim, spacedim>>,
+        16>>
+        all_tensor_product_shapes(n_fields);
+      // Otherwise, for vector-valued elements, try to vectorize the integrals
+      std::vector<std::unique_ptr<PrimitiveSystemShapes<dim, spacedim>>>
+        all_primitive_system_shapes(n_fields);
+      for (std::size_t field_n = 0; field_n < n_fields; ++field_n)
+        {
+          const FiniteElement<dim, spacedim> &fe =
+            dof_handlers[field_n]->get_fe();
+          if (PrimitiveSystemShapes<dim, spacedim>::is_applicable(fe))
+            all_primitive_system_shapes[field_n] =
+              std::make_unique<PrimitiveSystemShapes<dim, spacedim>>(fe);
+          all_rhs_fe_values.emplace_back(*mappings[field_n],
+                                         fe,
+                                         quadratures,
+                                         update_JxW_values | update_values);
+          for (std::size_t quad_n = 0; quad_n < quadratures.size(); ++quad_n)
+            {
+              const Quadrature<dim> &quad = quadratures[quad_n];
+              if (TensorProductShapes<dim, spacedim>::is_applicable(fe, quad))
+                {
+                  all_tensor_product_shapes[field_n].emplace_back(
+                    std::make_unique<TensorProductShapes<dim, spacedim>>(fe,
+                                                                         quad));
+                  all_rhs_fe_values[field_n].set_update_flags(
+                    quad_n, update_JxW_values);
+                }
+              else
+                all_tensor_product_shapes[field_n].emplace_back(nullptr);
+            }
+        }
 
-            for (unsigned int qp_n = 0; qp_n < n_q_points; ++qp_n)
+      Vector<double> cell_rhs;
+
+      std::vector<std::array<int, spacedim>> stencil_lower;
+      std::vector<double>                    kernel_weights;
+      std::vector<float>                     float_kernel_weights;
+
+      // We work on one patch at a time in three phases: first we compute all
+      // quadrature points on the patch, then we interpolate every field at all
+      // of them at once, and finally we assemble. This keeps the Eulerian data
+      // in cache and amortizes the setup cost of the kernel over many more
+      // points than a single cell. Since the first phase (and, for
+      // cell-centered data, the kernel weights) does not depend on the field,
+      // it is shared by all fields.
+      std::vector<typename DoFHandler<dim, spacedim>::active_cell_iterator>
+                                   patch_cells;
+      std::vector<std::size_t>     q_point_offsets;
+      std::vector<Point<spacedim>> q_points;
+      std::vector<unsigned char>   is_exterior;
+      std::vector<Point<spacedim>> interior_q_points;
+      std::vector<double>          patch_values;
+      std::vector<double>          interior_values;
+      std::vector<double>          weighted_values;
+
+      std::vector<types::global_dof_index> dof_indices;
+      for (std::size_t patch_n = patches_begin; patch_n < patches_end;
+           ++patch_n)
+        {
+          const auto &patch = patch_map.get_patch(patch_n);
+
+          // Phase 1: compute (or look up) quadrature points:
+          patch_cells.clear();
+          auto       iter = patch_map.begin(patch_n, *dof_handlers[0]);
+          const auto end  = patch_map.end(patch_n, *dof_handlers[0]);
+          for (; iter != end; ++iter)
+            patch_cells.push_back(*iter);
+          const auto patch_q_point_data =
+            get_patch_quadrature_points(patch_map,
+                                        patch_n,
+                                        *dof_handlers[0],
+                                        quadrature_indices,
+                                        position_q_points,
+                                        quadrature_point_cache,
+                                        q_points,
+                                        q_point_offsets,
+                                        is_exterior,
+                                        interior_q_points);
+          const std::vector<Point<spacedim>> &patch_q_points =
+            patch_q_point_data.q_points;
+          const std::vector<std::size_t> &cell_q_point_offsets =
+            patch_q_point_data.cell_q_point_offsets;
+          const std::vector<unsigned char> &patch_is_exterior =
+            patch_q_point_data.is_exterior;
+          const std::vector<Point<spacedim>> &patch_interior_q_points =
+            patch_q_point_data.interior_q_points;
+          AssertDimension(cell_q_point_offsets.size(), patch_cells.size() + 1);
+          // Exterior points contribute nothing, so neither does a patch with
+          // only exterior points
+          if (patch_interior_q_points.size() == 0)
+            continue;
+
+          bool weights_are_current =
+            kernel_weight_cache ? kernel_weight_cache->is_current[patch_n] :
+                                  false;
+          auto &patch_stencil_lower =
+            kernel_weight_cache ? kernel_weight_cache->stencil_lower[patch_n] :
+                                  stencil_lower;
+          auto &patch_kernel_weights =
+            kernel_weight_cache && !mixed_precision ?
+              kernel_weight_cache->weights[patch_n] :
+              kernel_weights;
+          auto &patch_float_kernel_weights =
+            kernel_weight_cache && mixed_precision ?
+              kernel_weight_cache->float_weights[patch_n] :
+              float_kernel_weights;
+          for (std::size_t field_n = 0; field_n < n_fields; ++field_n)
+            {
+              const DoFHandler<dim, spacedim> &dof_handler =
+                *dof_handlers[field_n];
+              const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
+              const unsigned int dofs_per_cell      = fe.dofs_per_cell;
+              Vector<double>    &field_rhs          = *rhs[field_n];
+              cell_rhs.reinit(dofs_per_cell);
+              dof_indices.resize(dofs_per_cell);
+              const ArrayView<const types::global_dof_index>
+                cached_dof_indices =
+                  patch_map.has_cached_dof_indices(dof_handler) ?
+                    patch_map.get_dof_indices(patch_n, dof_handler) :
+                    ArrayView<const types::global_dof_index>();
+
+              // Phase 2: interpolate at quadrature points. Values at exterior
+              // points are zero:
+              const unsigned int n_components = fe.n_components();
+              std::vector<double> &point_values =
+                patch_is_exterior.size() > 0 ? interior_values : patch_values;
+              point_values.resize(n_components *
+                                  patch_interior_q_points.size());
+              std::fill(point_values.begin(), point_values.end(), 0.0);
+              const auto interpolate = [&](auto &weights)
               {
-                if (fe.n_components() == 1)
-                  {
-                    AssertIndexRange(qp_n, rhs_values.size());
-                    for (unsigned int i = 0; i < dofs_per_cell; ++i)
-                      {
-                        cell_rhs[i] += rhs_fe_values.shape_value(i, qp_n) *
-                                       rhs_values[qp_n] *
-                                       rhs_fe_values.JxW(qp_n);
-                      }
-                  }
-                else if (fe.n_components() == spacedim)
-                  {
-                    Tensor<1, spacedim> qp;
-                    for (unsigned int d = 0; d < spacedim; ++d)
-                      {
-                        AssertIndexRange(qp_n * spacedim + d,
-                                         rhs_values.size());
-                        qp[d] = rhs_values[qp_n * spacedim + d];
-                      }
-
-                    // TODO - this only works with primitive elements
-                    // TODO - perhaps its worth unrolling this loop?
-                    // dofs_per_cell is probably 12, 30, or 45.
-                    for (unsigned int i = 0; i < dofs_per_cell; ++i)
-                      {
-                        const unsigned int component =
-                          fe.system_to_component_index(i).first;
-                        cell_rhs[i] += rhs_fe_values.shape_value(i, qp_n) *
-                                       qp[component] * rhs_fe_values.JxW(qp_n);
-                      }
-                  }
-                else
-                  {
-                    Assert(false, ExcNotImplemented());
-                  }
+                return interpolate_patch_data_at_points(
+                  kernel_name,
+                  kernel,
+                  data_indices[field_n],
+                  patch,
+                  make_array_view(patch_interior_q_points),
+                  n_components,
+                  patch_stencil_lower,
+                  weights,
+                  weights_are_current,
+                  point_values.data());
+              };
+              {
+                FDL_MARKER_SCOPE(kernel_marker, "fdl_projection_rhs_kernel");
+                weights_are_current =
+                  (mixed_precision ? interpolate(patch_float_kernel_weights) :
+                                     interpolate(patch_kernel_weights)) ||
+                  weights_are_current;
               }
+              if (patch_is_exterior.size() > 0)
+                {
+                  patch_values.resize(n_components * patch_q_points.size());
+                  std::size_t interior_n = 0;
+                  for (std::size_t qp_n = 0; qp_n < patch_q_points.size();
+                       ++qp_n)
+                    for (unsigned int c = 0; c < n_components; ++c)
+                      patch_values[qp_n * n_components + c] =
+                        patch_is_exterior[qp_n] ?
+                          0.0 :
+                          interior_values[interior_n++];
+                  AssertDimension(interior_n, interior_values.size());
+                }
+
+              // Phase 3: assemble:
+              FDL_MARKER_SCOPE(assembly_marker, "fdl_projection_rhs_assembly");
+              const std::size_t stage_n = patch_n * n_fields + field_n;
+              if (!used_policy.is_serial())
+                {
+                  staged_dof_indices[stage_n].clear();
+                  staged_cell_rhs[stage_n].clear();
+                  staged_dof_indices[stage_n].reserve(patch_cells.size() *
+                                                      dofs_per_cell);
+                  staged_cell_rhs[stage_n].reserve(patch_cells.size() *
+                                                   dofs_per_cell);
+                }
+              for (std::size_t cell_n = 0; cell_n < patch_cells.size();
+                   ++cell_n)
+                {
+                  const auto quad_index =
+                    quadrature_indices[patch_cells[cell_n]
+                                         ->active_cell_index()];
+                  const typename DoFHandler<dim, spacedim>::active_cell_iterator
+                    cell(&dof_handler.get_triangulation(),
+                         patch_cells[cell_n]->level(),
+                         patch_cells[cell_n]->index(),
+                         &dof_handler);
+                  FEValues<dim, spacedim> &rhs_fe_values =
+                    all_rhs_fe_values[field_n][quad_index];
+                  rhs_fe_values.reinit(cell);
+
+                  const unsigned int n_q_points =
+                    cell_q_point_offsets[cell_n + 1] -
+                    cell_q_point_offsets[cell_n];
+                  Assert(n_q_points == rhs_fe_values.n_quadrature_points,
+                         ExcFDLInternalError());
+                  const double *const rhs_values =
+                    patch_values.data() +
+                    fe.n_components() * cell_q_point_offsets[cell_n];
+
+                  cell_rhs = 0.0;
+                  const types::global_dof_index *cell_dof_indices = nullptr;
+                  if (cached_dof_indices.size() > 0)
+                    cell_dof_indices =
+                      cached_dof_indices.data() + cell_n * dofs_per_cell;
+                  else
+                    {
+                      cell->get_dof_indices(dof_indices);
+                      cell_dof_indices = dof_indices.data();
+                    }
+                  if (all_tensor_product_shapes[field_n][quad_index])
+                    {
+                      weighted_values.resize(fe.n_components() * n_q_points);
+                      for (unsigned int qp_n = 0; qp_n < n_q_points; ++qp_n)
+                        for (unsigned int c = 0; c < fe.n_components(); ++c)
+                          weighted_values[qp_n * fe.n_components() + c] =
+                            rhs_values[qp_n * fe.n_components() + c] *
+                            rhs_fe_values.JxW(qp_n);
+                      all_tensor_product_shapes[field_n][quad_index]
+                        ->integrate(weighted_values.data(), cell_rhs);
+                    }
+                  else if (all_primitive_system_shapes[field_n])
+                    all_primitive_system_shapes[field_n]->integrate(
+                      rhs_fe_values, rhs_values, cell_rhs);
+                  else
+                    {
+                      for (unsigned int qp_n = 0; qp_n < n_q_points; ++qp_n)
+                        {
+                          if (fe.n_components() == 1)
+                            {
+                              for (unsigned int i = 0; i < dofs_per_cell; ++i)
+                                {
+                                  cell_rhs[i] +=
+                                    rhs_fe_values.shape_value(i, qp_n) *
+                                    rhs_values[qp_n] * rhs_fe_values.JxW(qp_n);
+                                }
+                            }
+                          else if (fe.n_components() == spacedim)
+                            {
+                              Tensor<1, spacedim> qp;
+                              for (unsigned int d = 0; d < spacedim; ++d)
+                                qp[d] = rhs_values[qp_n * spacedim + d];
+
+                              // TODO - this only works with primitive elements
+                              for (unsigned int i = 0; i < dofs_per_cell; ++i)
+                                {
+                                  const unsigned int component =
+                                    fe.system_to_component_index(i).first;
+                                  cell_rhs[i] +=
+                                    rhs_fe_values.shape_value(i, qp_n) *
+                                    qp[component] * rhs_fe_values.JxW(qp_n);
+                                }
+                            }
+                          else
+                            {
+                              Assert(false, ExcNotImplemented());
+                            }
+                        }
+                    }
+
+                  if (!used_policy.is_serial())
+                    {
+                      staged_dof_indices[stage_n].insert(
+                        staged_dof_indices[stage_n].end(),
+                        cell_dof_indices,
+                        cell_dof_indices + dofs_per_cell);
+                      staged_cell_rhs[stage_n].insert(
+                        staged_cell_rhs[stage_n].end(),
+                        cell_rhs.begin(),
+                        cell_rhs.end());
+                    }
+                  else
+                    field_rhs.add(dofs_per_cell,
+                                  cell_dof_indices,
+                                  cell_rhs.begin());
+                }
+            }
+          if (kernel_weight_cache)
+            kernel_weight_cache->is_current[patch_n] = weights_are_current;
+        }
+    };
+
+    used_policy.apply_to_ranges(patch_map.size(), project_patches);
 
-            rhs.add(dof_indices, cell_rhs);
+    // Reduce, in patch order, the staged contributions:
+    if (!used_policy.is_serial())
+      for (std::size_t patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+        for (std::size_t field_n = 0; field_n < n_fields; ++field_n)
+          {
+            const std::size_t stage_n = patch_n * n_fields + field_n;
+            AssertDimension(staged_dof_indices[stage_n].size(),
+                            staged_cell_rhs[stage_n].size());
+            Vector<double> &field_rhs = *rhs[field_n];
+            for (std::size_t i = 0; i < staged_dof_indices[stage_n].size(); ++i)
+              field_rhs[staged_dof_indices[stage_n][i]] +=
+                staged_cell_rhs[stage_n][i];
           }
-      }
   }
 
 
 
   template <int dim, int spacedim>
   void
-  compute_projection_rhs(const std::string                  &kernel_name,
-                         const int                           data_index,
-                         const PatchMap<dim, spacedim>      &patch_map,
-                         const Mapping<dim, spacedim>       &position_mapping,
-                         const std::vector<unsigned char>   &quadrature_indices,
-                         const std::vector<Quadrature<dim>> &quadratures,
-                         const DoFHandler<dim, spacedim>    &dof_handler,
-                         const Mapping<dim, spacedim>       &mapping,
-                         Vector<double>                     &rhs)
+  compute_projection_rhs(
+    const std::string                  &kernel_name,
+    const int                           data_index,
+    const PatchMap<dim, spacedim>      &patch_map,
+    const Mapping<dim, spacedim>       &position_mapping,
+    const std::vector<unsigned char>   &quadrature_indices,
+    const std::vector<Quadrature<dim>> &quadratures,
+    const DoFHandler<dim, spacedim>    &dof_handler,
+    const Mapping<dim, spacedim>       &mapping,
+    Vector<double>                     &rhs,
+    KernelWeightCache<spacedim>        *kernel_weight_cache,
+    const ExecutionPolicy              &execution_policy,
+    const bool                          mixed_precision,
+    QuadraturePointCache<spacedim>     *quadrature_point_cache)
   {
-#define ARGUMENTS                                                           \
-  kernel_name, data_index, patch_map, position_mapping, quadrature_indices, \
-    quadratures, dof_handler, mapping, rhs
-    if (patch_map.size() != 0)
-      {
-        auto patch_data = patch_map.get_patch(0)->getPatchData(data_index);
-        auto pair       = extract_types(patch_data);
-
-        AssertThrow(pair.second == SAMRAIFieldType::Double,
-                    ExcNotImplemented());
-        switch (pair.first)
-          {
-            case SAMRAIPatchType::Edge:
-              compute_projection_rhs_internal<dim,
-                                              spacedim,
-                                              pdat::EdgeData<spacedim, double>>(
-                ARGUMENTS);
-              break;
-
-            case SAMRAIPatchType::Cell:
-              compute_projection_rhs_internal<dim,
-                                              spacedim,
-                                              pdat::CellData<spacedim, double>>(
-                ARGUMENTS);
-              break;
-
-            case SAMRAIPatchType::Side:
-              compute_projection_rhs_internal<dim,
-                                              spacedim,
-                                              pdat::SideData<spacedim, double>>(
-                ARGUMENTS);
-              break;
-
-            case SAMRAIPatchType::Node:
-              compute_projection_rhs_internal<dim,
-                                              spacedim,
-                                              pdat::NodeData<spacedim, double>>(
-                ARGUMENTS);
-              break;
-          }
-      }
-#undef ARGUMENTS
+    compute_projection_rhs(kernel_name,
+                           std::vector<int>{data_index},
+                           patch_map,
+                           position_mapping,
+                           quadrature_indices,
+                           quadratures,
+                           {&dof_handler},
+                           {&mapping},
+                           {&rhs},
+                           kernel_weight_cache,
+                           execution_policy,
+                           mixed_precision,
+                           quadrature_point_cache);
   }
 
   template <int dim, int spacedim, typename patch_type>
@@ -638,7 +2746,8 @@ namespace fdl
     const int                           data_index,
     const NodalPatchMap<dim, spacedim> &patch_map,
     const Vector<double>               &position,
-    Vector<double>                     &interpolated_values)
+    Vector<double>                     &interpolated_values,
+    const ExecutionPolicy              &execution_policy)
   {
     // Early exit if there is nothing to do (otherwise the modulus operations
     // fail)
@@ -670,47 +2779,107 @@ namespace fdl
               interpolated_values.end(),
               std::numeric_limits<double>::lowest());
 
-    for (std::size_t patch_n = 0; patch_n < patch_map.size(); ++patch_n)
-      {
-        std::pair<const IndexSet &, tbox::Pointer<hier::Patch<spacedim>>> p =
-          patch_map[patch_n];
-        const IndexSet                       &dofs  = p.first;
-        tbox::Pointer<hier::Patch<spacedim>> &patch = p.second;
-        Assert(patch->checkAllocated(data_index),
-               ExcMessage("unallocated data patch index"));
-        tbox::Pointer<patch_type> patch_data = patch->getPatchData(data_index);
-        Assert(patch_data, ExcMessage("Type mismatch"));
-        check_depth<spacedim>(patch_data, n_components);
+    const IBKernel kernel = to_ib_kernel(kernel_name);
+    // We reinterpret the position vector as an array of points
+    static_assert(sizeof(Point<spacedim>) == sizeof(double) * spacedim,
+                  "Points should be packed");
+    // Each node is inside exactly one patch box so, even though nodes may be
+    // associated with several patches, each entry of interpolated_values is
+    // only written by one thread. Hence, unlike spreading, we can split the
+    // nodes of a single patch between threads.
+    const ExecutionPolicy used_policy =
+      can_use_threads<spacedim, patch_type>(kernel, n_components) ?
+        execution_policy :
+        ExecutionPolicy();
+    // If nodes coincide (e.g., for discontinuous elements) then only evaluate
+    // the kernel once per point and copy the values to the other nodes.
+    const bool use_points = patch_map.has_coincident_nodes(position);
+    const std::vector<NodalChunk> chunks =
+      make_nodal_chunks(patch_map, used_policy, use_points);
+    const auto nodes =
+      reinterpret_cast<const Point<spacedim> *>(position.begin());
+    const auto interpolate_chunks =
+      [&](const std::size_t chunks_begin, const std::size_t chunks_end)
+    {
+      std::vector<std::array<int, spacedim>> stencil_lower;
+      std::vector<double>                    kernel_weights;
+      std::vector<Point<spacedim>>           point_positions;
+      std::vector<double>                    point_values;
+      tbox::Pointer<hier::Patch<spacedim>>   patch;
+      tbox::Pointer<patch_type>              patch_data;
+      std::size_t current_patch_n = std::numeric_limits<std::size_t>::max();
+      for (std::size_t chunk_n = chunks_begin; chunk_n < chunks_end; ++chunk_n)
+        {
+          const NodalChunk &chunk = chunks[chunk_n];
+          if (chunk.patch_n != current_patch_n)
+            {
+              current_patch_n = chunk.patch_n;
+              patch           = patch_map[chunk.patch_n].second;
+              Assert(patch->checkAllocated(data_index),
+                     ExcMessage("unallocated data patch index"));
+              patch_data = patch->getPatchData(data_index);
+              Assert(patch_data, ExcMessage("Type mismatch"));
+              check_depth<spacedim>(patch_data, n_components);
+            }
+
+          if (use_points)
+            {
+              point_positions.resize(chunk.n_nodes);
+              for (std::size_t i = 0; i < chunk.n_nodes; ++i)
+                point_positions[i] =
+                  nodes[patch_map.get_point_nodes(chunk.nodes_begin + i)[0]];
+              point_values.assign(chunk.n_nodes * n_components,
+                                  std::numeric_limits<double>::lowest());
+              const ArrayView<const Point<spacedim>> points_view(
+                point_positions);
+              interpolate_at_points(kernel_name,
+                                    kernel,
+                                    patch_data,
+                                    patch,
+                                    points_view,
+                                    n_components,
+                                    stencil_lower,
+                                    kernel_weights,
+                                    false,
+                                    point_values.data());
+
+              // Points outside the patch box are not set and may be set by
+              // another chunk, so only copy values which were computed here
+              for (std::size_t i = 0; i < chunk.n_nodes; ++i)
+                for (const auto node_n :
+                     patch_map.get_point_nodes(chunk.nodes_begin + i))
+                  for (unsigned int c = 0; c < n_components; ++c)
+                    {
+                      const double value = point_values[i * n_components + c];
+                      if (value != std::numeric_limits<double>::lowest())
+                        interpolated_values[node_n * n_components + c] = value;
+                    }
+              continue;
+            }
+
+          const auto position_view =
+            make_array_view(nodes + chunk.nodes_begin, chunk.n_nodes);
+          auto values_view = make_array_view(
+            interpolated_values.begin() + chunk.nodes_begin * n_components,
+            interpolated_values.begin() +
+              (chunk.nodes_begin + chunk.n_nodes) * n_components);
+          Assert(values_view.size() % n_components == 0,
+                 ExcFDLInternalError());
+
+          interpolate_at_points(kernel_name,
+                                kernel,
+                                patch_data,
+                                patch,
+                                position_view,
+                                n_components,
+                                stencil_lower,
+                                kernel_weights,
+                                false,
+                                values_view.data());
+        }
+    };
 
-        for (auto it = dofs.begin_intervals(); it != dofs.end_intervals(); ++it)
-          {
-            const auto nodes_begin = *it->begin() / spacedim;
-            const auto n_nodes     = (it->end() - it->begin()) / spacedim;
-            const auto position_view =
-              make_array_view(position.begin() + nodes_begin * spacedim,
-                              position.begin() +
-                                (nodes_begin + n_nodes) * spacedim);
-            Assert(position_view.size() % spacedim == 0, ExcFDLInternalError());
-            auto values_view =
-              make_array_view(interpolated_values.begin() +
-                                nodes_begin * n_components,
-                              interpolated_values.begin() +
-                                (nodes_begin + n_nodes) * n_components);
-            Assert(values_view.size() % n_components == 0,
-                   ExcFDLInternalError());
-
-            IBTK::LEInteractor::interpolate(values_view.data(),
-                                            values_view.size(),
-                                            n_components,
-                                            position_view.data(),
-                                            position_view.size(),
-                                            spacedim,
-                                            patch_data,
-                                            patch,
-                                            patch->getBox(),
-                                            kernel_name);
-          }
-      }
+    used_policy.apply_to_ranges(chunks.size(), interpolate_chunks);
   }
 
   template <int dim, int spacedim>
@@ -719,10 +2888,12 @@ namespace fdl
                               const int                           data_index,
                               const NodalPatchMap<dim, spacedim> &patch_map,
                               const Vector<double>               &position,
-                              Vector<double> &interpolated_values)
+                              Vector<double>     &interpolated_values,
+                              const ExecutionPolicy &execution_policy)
   {
-#define ARGUMENTS \
-  kernel_name, data_index, patch_map, position, interpolated_values
+#define ARGUMENTS                                                  \
+  kernel_name, data_index, patch_map, position, interpolated_values, \
+    execution_policy
     if (patch_map.size() != 0)
       {
         auto patch_data = patch_map[0].second->getPatchData(data_index);
@@ -799,120 +2970,295 @@ namespace fdl
   }
 
   template <int dim, int spacedim, typename value_type, typename patch_type>
-  void
-  compute_spread_internal(const std::string                &kernel_name,
-                          const int                         data_index,
-                          PatchMap<dim, spacedim>          &patch_map,
-                          const Mapping<dim, spacedim>     &position_mapping,
-                          const std::vector<unsigned char> &quadrature_indices,
-                          const std::vector<Quadrature<dim>> &quadratures,
-                          const DoFHandler<dim, spacedim>    &dof_handler,
-                          const Mapping<dim, spacedim>       &mapping,
-                          const Vector<double>               &solution)
+  std::size_t
+  compute_spread_internal(
+    const std::string                  &kernel_name,
+    const int                           data_index,
+    PatchMap<dim, spacedim>            &patch_map,
+    const Mapping<dim, spacedim>       &position_mapping,
+    const std::vector<unsigned char>   &quadrature_indices,
+    const std::vector<Quadrature<dim>> &quadratures,
+    const DoFHandler<dim, spacedim>    &dof_handler,
+    const Mapping<dim, spacedim>       &mapping,
+    const Vector<double>               &solution,
+    KernelWeightCache<spacedim>        *kernel_weight_cache,
+    const ExecutionPolicy              &execution_policy,
+    const bool                          mixed_precision,
+    QuadraturePointCache<spacedim>     *quadrature_point_cache,
+    const bool                          skip_zero_cells)
   {
+    FDL_MARKER_SCOPE(marker, "fdl_spread");
     check_quadratures(quadrature_indices,
                       quadratures,
                       dof_handler.get_triangulation());
     const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
 
-    // We probably don't need more than 16 quadrature rules
-    boost::container::small_vector<std::unique_ptr<FEValues<dim, spacedim>>, 16>
-      all_position_fe_values;
-    boost::container::small_vector<std::unique_ptr<FEValues<dim, spacedim>>, 16>
-      all_solution_fe_values;
-    for (const Quadrature<dim> &quad : quadratures)
+    const IBKernel kernel = to_ib_kernel(kernel_name);
+    // the number of components is determined at run time so use a normal
+    // assertion
+    AssertThrow(sizeof(value_type) == sizeof(double) * fe.n_components(),
+                ExcMessage("FORTRAN routines assume we are packed"));
+    if (kernel_weight_cache)
       {
-        all_position_fe_values.emplace_back(
-          std::make_unique<FEValues<dim, spacedim>>(
-            position_mapping, fe, quad, update_quadrature_points));
-        all_solution_fe_values.emplace_back(
-          std::make_unique<FEValues<dim, spacedim>>(
-            mapping, fe, quad, update_JxW_values | update_values));
+        Assert(kernel_weight_cache->kernel_name == kernel_name &&
+                 kernel_weight_cache->mixed_precision == mixed_precision,
+               ExcMessage("The cache should be reinitialized first"));
+        AssertDimension(kernel_weight_cache->is_current.size(),
+                        patch_map.size());
       }
 
-    std::vector<value_type> cell_solution_values;
-    std::vector<double>     cell_solution(fe.dofs_per_cell);
-
-    for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
-      {
-        auto patch = patch_map.get_patch(patch_n);
-        Assert(patch->checkAllocated(data_index),
-               ExcMessage("unallocated data patch index"));
-        tbox::Pointer<patch_type> patch_data = patch->getPatchData(data_index);
-        Assert(patch_data, ExcMessage("Type mismatch"));
-        check_depth<spacedim>(patch_data, fe.n_components());
+    // Cached kernel weights correspond to every interior point of a patch, so
+    // in that case points of skipped cells are spread with zero values
+    // instead of being removed
+    const bool compact_points = skip_zero_cells && !kernel_weight_cache;
+    std::atomic<std::size_t> n_skipped_cells(0);
+
+    // Each patch is processed by exactly one thread. Since patches do not
+    // share data (values spread into ghost regions are accumulated later by
+    // the caller) no synchronization is necessary and the result is bitwise
+    // identical to the serial one.
+    const auto spread_patches =
+      [&](const std::size_t patches_begin, const std::size_t patches_end)
+    {
+      PositionQuadraturePoints<dim, spacedim> position_q_points(
+        position_mapping, fe, quadratures);
+      LazyFEValues<dim, spacedim> all_solution_fe_values(
+        mapping, fe, quadratures, update_JxW_values | update_values);
+      // If possible, use sum factorization instead of FEValues to evaluate
+      boost::container::
+        small_vector<std::unique_ptr<TensorProductShapes<dim, spacedim>>, 16>
+          all_tensor_product_shapes;
+      for (std::size_t quad_n = 0; quad_n < quadratures.size(); ++quad_n)
+        {
+          const Quadrature<dim> &quad = quadratures[quad_n];
+          if (TensorProductShapes<dim, spacedim>::is_applicable(fe, quad))
+            {
+              all_tensor_product_shapes.emplace_back(
+                std::make_unique<TensorProductShapes<dim, spacedim>>(fe, quad));
+              all_solution_fe_values.set_update_flags(quad_n,
+                                                      update_JxW_values);
+            }
+          else
+            all_tensor_product_shapes.emplace_back(nullptr);
+        }
 
-        auto       iter = patch_map.begin(patch_n, dof_handler);
-        const auto end  = patch_map.end(patch_n, dof_handler);
-        for (; iter != end; ++iter)
+      std::vector<value_type> cell_solution_values;
+      std::vector<double>     cell_solution(fe.dofs_per_cell);
+
+      // Like compute_projection_rhs(), we first compute all quadrature points
+      // and values on a patch and then spread everything at once.
+      std::vector<Point<spacedim>> q_points;
+      std::vector<std::size_t>     q_point_offsets;
+      std::vector<unsigned char>   is_exterior;
+      std::vector<Point<spacedim>> interior_q_points;
+      std::vector<value_type>      patch_values;
+      std::vector<Point<spacedim>> spread_q_points;
+      std::size_t                  n_local_skipped_cells = 0;
+
+      std::vector<std::array<int, spacedim>> stencil_lower;
+      std::vector<double>                    kernel_weights;
+      std::vector<float>                     float_kernel_weights;
+
+      for (std::size_t patch_n = patches_begin; patch_n < patches_end;
+           ++patch_n)
+        {
+          auto patch = patch_map.get_patch(patch_n);
+          Assert(patch->checkAllocated(data_index),
+                 ExcMessage("unallocated data patch index"));
+          tbox::Pointer<patch_type> patch_data =
+            patch->getPatchData(data_index);
+          Assert(patch_data, ExcMessage("Type mismatch"));
+          check_depth<spacedim>(patch_data, fe.n_components());
+
+          const auto patch_q_point_data =
+            get_patch_quadrature_points(patch_map,
+                                        patch_n,
+                                        dof_handler,
+                                        quadrature_indices,
+                                        position_q_points,
+                                        quadrature_point_cache,
+                                        q_points,
+                                        q_point_offsets,
+                                        is_exterior,
+                                        interior_q_points);
+          const std::vector<std::size_t> &cell_q_point_offsets =
+            patch_q_point_data.cell_q_point_offsets;
+          const std::vector<unsigned char> &patch_is_exterior =
+            patch_q_point_data.is_exterior;
+          const std::vector<Point<spacedim>> &patch_interior_q_points =
+            patch_q_point_data.interior_q_points;
+          if (patch_interior_q_points.size() == 0)
+            continue;
+
+          // Reading values through cached DoF indices avoids looking them
+          // up through the DoFHandler on every cell
+          const ArrayView<const types::global_dof_index> cached_dof_indices =
+            patch_map.has_cached_dof_indices(dof_handler) ?
+              patch_map.get_dof_indices(patch_n, dof_handler) :
+              ArrayView<const types::global_dof_index>();
+
+          // index of the first interior point of the current cell
+          std::size_t interior_n    = 0;
+          bool        patch_is_zero = true;
           {
-            const auto cell = *iter;
-            const auto quad_index =
-              quadrature_indices[cell->active_cell_index()];
+            FDL_MARKER_SCOPE(values_marker, "fdl_spread_values");
+            patch_values.clear();
+            patch_values.reserve(patch_interior_q_points.size());
+            spread_q_points.clear();
+            std::size_t cell_n = 0;
+            auto        iter   = patch_map.begin(patch_n, dof_handler);
+            const auto  end    = patch_map.end(patch_n, dof_handler);
+            for (; iter != end; ++iter, ++cell_n)
+              {
+                const unsigned int n_q_points =
+                  cell_q_point_offsets[cell_n + 1] -
+                  cell_q_point_offsets[cell_n];
+                const unsigned char *cell_is_exterior =
+                  patch_is_exterior.size() > 0 ?
+                    patch_is_exterior.data() + cell_q_point_offsets[cell_n] :
+                    nullptr;
+                const std::size_t n_interior_q_points =
+                  cell_is_exterior ?
+                    std::count(cell_is_exterior,
+                               cell_is_exterior + n_q_points,
+                               static_cast<unsigned char>(0)) :
+                    n_q_points;
+                // Skip cells whose points are all exterior:
+                if (n_interior_q_points == 0)
+                  continue;
+
+                // get forces:
+                const auto cell = *iter;
+                if (cached_dof_indices.size() > 0)
+                  for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+                    cell_solution[i] = solution
+                      [cached_dof_indices[cell_n * fe.dofs_per_cell + i]];
+                else
+                  cell->get_dof_values(solution,
+                                       cell_solution.begin(),
+                                       cell_solution.end());
+
+                // Cells whose force DoFs are all zero have zero force at
+                // every point so there is no reason to evaluate it:
+                if (skip_zero_cells &&
+                    std::all_of(cell_solution.begin(),
+                                cell_solution.end(),
+                                [](const double v) { return v == 0.0; }))
+                  {
+                    ++n_local_skipped_cells;
+                    if (!compact_points)
+                      patch_values.resize(patch_values.size() +
+                                            n_interior_q_points,
+                                          value_type());
+                    interior_n += n_interior_q_points;
+                    continue;
+                  }
+                patch_is_zero = false;
+                if (compact_points)
+                  spread_q_points.insert(spread_q_points.end(),
+                                         patch_interior_q_points.begin() +
+                                           interior_n,
+                                         patch_interior_q_points.begin() +
+                                           interior_n + n_interior_q_points);
+                interior_n += n_interior_q_points;
+
+                const auto quad_index =
+                  quadrature_indices[cell->active_cell_index()];
+
+                // Reinitialize:
+                FEValues<dim, spacedim> &solution_fe_values =
+                  all_solution_fe_values[quad_index];
+                solution_fe_values.reinit(cell);
+
+                Assert(n_q_points == solution_fe_values.n_quadrature_points,
+                       ExcFDLInternalError());
+                cell_solution_values.resize(n_q_points);
+                std::fill(cell_solution_values.begin(),
+                          cell_solution_values.end(),
+                          value_type());
+                if (all_tensor_product_shapes[quad_index])
+                  all_tensor_product_shapes[quad_index]->evaluate(
+                    cell_solution,
+                    reinterpret_cast<double *>(cell_solution_values.data()));
+                else
+                  compute_values_generic(solution_fe_values,
+                                         cell_solution,
+                                         cell_solution_values);
+                for (unsigned int qp = 0; qp < n_q_points; ++qp)
+                  cell_solution_values[qp] *= solution_fe_values.JxW(qp);
 
-            // Reinitialize:
-            FEValues<dim, spacedim> &solution_fe_values =
-              *all_solution_fe_values[quad_index];
-            FEValues<dim, spacedim> &position_fe_values =
-              *all_position_fe_values[quad_index];
-            solution_fe_values.reinit(cell);
-            position_fe_values.reinit(cell);
-            Assert(solution_fe_values.get_quadrature() ==
-                     position_fe_values.get_quadrature(),
-                   ExcFDLInternalError());
-
-            const std::vector<Point<spacedim>> &q_points =
-              position_fe_values.get_quadrature_points();
-            const unsigned int n_q_points = q_points.size();
-            cell_solution_values.resize(n_q_points);
-
-            // get forces:
-            std::fill(cell_solution_values.begin(),
-                      cell_solution_values.end(),
-                      value_type());
-            cell->get_dof_values(solution,
-                                 cell_solution.begin(),
-                                 cell_solution.end());
-            compute_values_generic(solution_fe_values,
-                                   cell_solution,
-                                   cell_solution_values);
-            for (unsigned int qp = 0; qp < n_q_points; ++qp)
-              cell_solution_values[qp] *= solution_fe_values.JxW(qp);
-
-            // TODO reimplement zeroExteriorValues here
-
-            // spread at quadrature points:
-            static_assert(sizeof(Point<spacedim>) == sizeof(double) * spacedim,
-                          "FORTRAN routines assume we are packed");
-            const auto position_data =
-              reinterpret_cast<const double *>(q_points.data());
-            // the number of components is determined at run time so use a
-            // normal assertion
-            AssertThrow(sizeof(value_type) ==
-                          sizeof(double) * fe.n_components(),
-                        ExcMessage("FORTRAN routines assume we are packed"));
-            const auto solution_data =
-              reinterpret_cast<const double *>(cell_solution_values.data());
-
-            IBTK::LEInteractor::spread(patch_data,
-                                       solution_data,
-                                       cell_solution_values.size() *
-                                         fe.n_components(),
-                                       fe.n_components(),
-                                       position_data,
-                                       n_q_points * spacedim,
-                                       spacedim,
-                                       patch,
-                                       patch->getBox(),
-                                       kernel_name);
+                if (cell_is_exterior)
+                  {
+                    for (unsigned int qp = 0; qp < n_q_points; ++qp)
+                      if (!cell_is_exterior[qp])
+                        patch_values.push_back(cell_solution_values[qp]);
+                  }
+                else
+                  patch_values.insert(patch_values.end(),
+                                      cell_solution_values.begin(),
+                                      cell_solution_values.end());
+              }
           }
-      }
+          AssertDimension(interior_n, patch_interior_q_points.size());
+          // There is nothing to spread if every cell was skipped
+          if (skip_zero_cells && patch_is_zero)
+            continue;
+          const ArrayView<const Point<spacedim>> spread_points(
+            compact_points ? spread_q_points : patch_interior_q_points);
+          AssertDimension(patch_values.size(), spread_points.size());
+
+          // spread at quadrature points:
+          FDL_MARKER_SCOPE(kernel_marker, "fdl_spread_kernel");
+          const auto solution_data =
+            reinterpret_cast<const double *>(patch_values.data());
+          const bool weights_are_current =
+            kernel_weight_cache ? kernel_weight_cache->is_current[patch_n] :
+                                  false;
+          auto &patch_stencil_lower =
+            kernel_weight_cache ? kernel_weight_cache->stencil_lower[patch_n] :
+                                  stencil_lower;
+          auto &patch_kernel_weights =
+            kernel_weight_cache && !mixed_precision ?
+              kernel_weight_cache->weights[patch_n] :
+              kernel_weights;
+          auto &patch_float_kernel_weights =
+            kernel_weight_cache && mixed_precision ?
+              kernel_weight_cache->float_weights[patch_n] :
+              float_kernel_weights;
+          const auto spread = [&](auto &weights)
+          {
+            return spread_at_points(kernel_name,
+                                    kernel,
+                                    patch_data,
+                                    patch,
+                                    spread_points,
+                                    fe.n_components(),
+                                    patch_stencil_lower,
+                                    weights,
+                                    weights_are_current,
+                                    solution_data);
+          };
+          const bool used_native_kernel =
+            mixed_precision ? spread(patch_float_kernel_weights) :
+                              spread(patch_kernel_weights);
+          if (kernel_weight_cache)
+            kernel_weight_cache->is_current[patch_n] = used_native_kernel;
+        }
+      n_skipped_cells += n_local_skipped_cells;
+    };
+
+    const ExecutionPolicy used_policy =
+      can_use_threads<spacedim, patch_type>(kernel, fe.n_components()) ?
+        execution_policy :
+        ExecutionPolicy();
+    used_policy.apply_to_ranges(patch_map.size(), spread_patches);
+    return n_skipped_cells;
   }
 
 
 
   template <int dim, int spacedim>
-  void
+  std::size_t
   compute_spread(const std::string                  &kernel_name,
                  const int                           data_index,
                  PatchMap<dim, spacedim>            &patch_map,
@@ -921,11 +3267,19 @@ namespace fdl
                  const std::vector<Quadrature<dim>> &quadratures,
                  const DoFHandler<dim, spacedim>    &dof_handler,
                  const Mapping<dim, spacedim>       &mapping,
-                 const Vector<double>               &solution)
+                 const Vector<double>               &solution,
+                 KernelWeightCache<spacedim>        *kernel_weight_cache,
+                 const ExecutionPolicy              &execution_policy,
+                 const bool                          mixed_precision,
+                 QuadraturePointCache<spacedim>     *quadrature_point_cache,
+                 const bool                          skip_zero_cells)
   {
 #define ARGUMENTS                                                           \
   kernel_name, data_index, patch_map, position_mapping, quadrature_indices, \
-    quadratures, dof_handler, mapping, solution
+    quadratures, dof_handler, mapping, solution, kernel_weight_cache,       \
+    execution_policy, mixed_precision, quadrature_point_cache,              \
+    skip_zero_cells
+    std::size_t n_skipped_cells = 0;
     if (patch_map.size() != 0)
       {
         auto patch_data = patch_map.get_patch(0)->getPatchData(data_index);
@@ -939,18 +3293,18 @@ namespace fdl
               switch (extract_depth(patch_data))
                 {
                   case 1:
-                    compute_spread_internal<dim,
-                                            spacedim,
-                                            double,
-                                            pdat::EdgeData<spacedim, double>>(
-                      ARGUMENTS);
+                    n_skipped_cells = compute_spread_internal<
+                      dim,
+                      spacedim,
+                      double,
+                      pdat::EdgeData<spacedim, double>>(ARGUMENTS);
                     break;
                   case spacedim:
-                    compute_spread_internal<dim,
-                                            spacedim,
-                                            Tensor<1, spacedim>,
-                                            pdat::EdgeData<spacedim, double>>(
-                      ARGUMENTS);
+                    n_skipped_cells = compute_spread_internal<
+                      dim,
+                      spacedim,
+                      Tensor<1, spacedim>,
+                      pdat::EdgeData<spacedim, double>>(ARGUMENTS);
                     break;
                   default:
                     AssertThrow(false, ExcNotImplemented());
@@ -961,18 +3315,18 @@ namespace fdl
               switch (extract_depth(patch_data))
                 {
                   case 1:
-                    compute_spread_internal<dim,
-                                            spacedim,
-                                            double,
-                                            pdat::CellData<spacedim, double>>(
-                      ARGUMENTS);
+                    n_skipped_cells = compute_spread_internal<
+                      dim,
+                      spacedim,
+                      double,
+                      pdat::CellData<spacedim, double>>(ARGUMENTS);
                     break;
                   case spacedim:
-                    compute_spread_internal<dim,
-                                            spacedim,
-                                            Tensor<1, spacedim>,
-                                            pdat::CellData<spacedim, double>>(
-                      ARGUMENTS);
+                    n_skipped_cells = compute_spread_internal<
+                      dim,
+                      spacedim,
+                      Tensor<1, spacedim>,
+                      pdat::CellData<spacedim, double>>(ARGUMENTS);
                     break;
                   default:
                     AssertThrow(false, ExcNotImplemented());
@@ -982,29 +3336,29 @@ namespace fdl
             case SAMRAIPatchType::Side:
               // We only support depth == 1 for side-centered
               Assert(extract_depth(patch_data) == 1, ExcFDLNotImplemented());
-              compute_spread_internal<dim,
-                                      spacedim,
-                                      Tensor<1, spacedim>,
-                                      pdat::SideData<spacedim, double>>(
-                ARGUMENTS);
+              n_skipped_cells = compute_spread_internal<
+                dim,
+                spacedim,
+                Tensor<1, spacedim>,
+                pdat::SideData<spacedim, double>>(ARGUMENTS);
               break;
 
             case SAMRAIPatchType::Node:
               switch (extract_depth(patch_data))
                 {
                   case 1:
-                    compute_spread_internal<dim,
-                                            spacedim,
-                                            double,
-                                            pdat::NodeData<spacedim, double>>(
-                      ARGUMENTS);
+                    n_skipped_cells = compute_spread_internal<
+                      dim,
+                      spacedim,
+                      double,
+                      pdat::NodeData<spacedim, double>>(ARGUMENTS);
                     break;
                   case spacedim:
-                    compute_spread_internal<dim,
-                                            spacedim,
-                                            Tensor<1, spacedim>,
-                                            pdat::NodeData<spacedim, double>>(
-                      ARGUMENTS);
+                    n_skipped_cells = compute_spread_internal<
+                      dim,
+                      spacedim,
+                      Tensor<1, spacedim>,
+                      pdat::NodeData<spacedim, double>>(ARGUMENTS);
                     break;
                   default:
                     AssertThrow(false, ExcNotImplemented());
@@ -1013,6 +3367,7 @@ namespace fdl
           }
       }
 #undef ARGUMENTS
+    return n_skipped_cells;
   }
 
   template <int dim, int spacedim, typename patch_type>
@@ -1021,7 +3376,8 @@ namespace fdl
                                 const int                     data_index,
                                 NodalPatchMap<dim, spacedim> &patch_map,
                                 const Vector<double>         &position,
-                                const Vector<double>         &spread_values)
+                                const Vector<double>         &spread_values,
+                                const ExecutionPolicy        &execution_policy)
   {
     // Early exit if there is nothing to do (otherwise the modulus operations
     // fail)
@@ -1042,45 +3398,125 @@ namespace fdl
     const auto n_components =
       spread_values.size() / (position.size() / spacedim);
 
-    for (std::size_t patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+    const IBKernel kernel = to_ib_kernel(kernel_name);
+    // We reinterpret the position vector as an array of points
+    static_assert(sizeof(Point<spacedim>) == sizeof(double) * spacedim,
+                  "Points should be packed");
+    // As in compute_spread(), threads work on disjoint sets of patches: since
+    // all nodes on a patch write into the same patch data we cannot split a
+    // patch between threads without conflicts. Instead, we balance the work by
+    // processing patches in order of decreasing numbers of nodes so that the
+    // most expensive patches are started first. This does not change the
+    // result since the order in which nodes are spread into each patch is the
+    // same.
+    const ExecutionPolicy used_policy =
+      can_use_threads<spacedim, patch_type>(kernel, n_components) ?
+        execution_policy :
+        ExecutionPolicy();
+    // Spreading is linear, so if nodes coincide (e.g., for discontinuous
+    // elements) we can sum their values and spread once per point.
+    const bool use_points = patch_map.has_coincident_nodes(position);
+    const auto nodes =
+      reinterpret_cast<const Point<spacedim> *>(position.begin());
+    std::vector<std::size_t> patch_order(patch_map.size());
+    std::iota(patch_order.begin(), patch_order.end(), std::size_t(0));
+    if (!used_policy.is_serial())
       {
-        std::pair<const IndexSet &, tbox::Pointer<hier::Patch<spacedim>>> p =
-          patch_map[patch_n];
-        const IndexSet                       &dofs  = p.first;
-        tbox::Pointer<hier::Patch<spacedim>> &patch = p.second;
-        Assert(patch->checkAllocated(data_index),
-               ExcMessage("unallocated data patch index"));
-        tbox::Pointer<patch_type> patch_data = patch->getPatchData(data_index);
-        Assert(patch_data, ExcMessage("Type mismatch"));
-        check_depth<spacedim>(patch_data, n_components);
-
-        for (auto it = dofs.begin_intervals(); it != dofs.end_intervals(); ++it)
-          {
-            const auto nodes_begin = *it->begin() / spacedim;
-            const auto n_nodes     = (it->end() - it->begin()) / spacedim;
-            const auto position_view =
-              make_array_view(position.begin() + nodes_begin * spacedim,
-                              position.begin() +
-                                (nodes_begin + n_nodes) * spacedim);
-            Assert(position_view.size() % spacedim == 0, ExcFDLInternalError());
-            auto values_view = make_array_view(
-              spread_values.begin() + nodes_begin * n_components,
-              spread_values.begin() + (nodes_begin + n_nodes) * n_components);
-            Assert(values_view.size() % n_components == 0,
-                   ExcFDLInternalError());
-
-            IBTK::LEInteractor::spread(patch_data,
-                                       values_view.data(),
-                                       values_view.size(),
-                                       n_components,
-                                       position_view.data(),
-                                       position_view.size(),
-                                       spacedim,
-                                       patch,
-                                       patch->getBox(),
-                                       kernel_name);
-          }
+        std::vector<std::size_t> patch_n_nodes(patch_map.size());
+        for (std::size_t patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+          patch_n_nodes[patch_n] = patch_map[patch_n].first.n_elements();
+        std::stable_sort(patch_order.begin(),
+                         patch_order.end(),
+                         [&](const std::size_t a, const std::size_t b)
+                         { return patch_n_nodes[a] > patch_n_nodes[b]; });
       }
+    const auto spread_patches =
+      [&](const std::size_t order_begin, const std::size_t order_end)
+    {
+      std::vector<std::array<int, spacedim>> stencil_lower;
+      std::vector<double>                    kernel_weights;
+      std::vector<Point<spacedim>>           point_positions;
+      std::vector<double>                    point_values;
+      for (std::size_t order_n = order_begin; order_n < order_end; ++order_n)
+        {
+          const std::size_t patch_n = patch_order[order_n];
+          std::pair<const IndexSet &, tbox::Pointer<hier::Patch<spacedim>>> p =
+            patch_map[patch_n];
+          const IndexSet                       &dofs  = p.first;
+          tbox::Pointer<hier::Patch<spacedim>> &patch = p.second;
+          Assert(patch->checkAllocated(data_index),
+                 ExcMessage("unallocated data patch index"));
+          tbox::Pointer<patch_type> patch_data =
+            patch->getPatchData(data_index);
+          Assert(patch_data, ExcMessage("Type mismatch"));
+          check_depth<spacedim>(patch_data, n_components);
+
+          if (use_points)
+            {
+              const IndexSet &points = patch_map.get_point_indices(patch_n);
+              for (auto it = points.begin_intervals();
+                   it != points.end_intervals();
+                   ++it)
+                {
+                  const auto points_begin = *it->begin();
+                  const auto n_points     = it->end() - it->begin();
+                  point_positions.resize(n_points);
+                  point_values.assign(n_points * n_components, 0.0);
+                  for (std::size_t i = 0; i < std::size_t(n_points); ++i)
+                    {
+                      const auto point_nodes =
+                        patch_map.get_point_nodes(points_begin + i);
+                      point_positions[i] = nodes[point_nodes[0]];
+                      for (const auto node_n : point_nodes)
+                        for (unsigned int c = 0; c < n_components; ++c)
+                          point_values[i * n_components + c] +=
+                            spread_values[node_n * n_components + c];
+                    }
+
+                  const ArrayView<const Point<spacedim>> points_view(
+                    point_positions);
+                  spread_at_points(kernel_name,
+                                   kernel,
+                                   patch_data,
+                                   patch,
+                                   points_view,
+                                   n_components,
+                                   stencil_lower,
+                                   kernel_weights,
+                                   false,
+                                   point_values.data());
+                }
+              continue;
+            }
+
+          for (auto it = dofs.begin_intervals(); it != dofs.end_intervals();
+               ++it)
+            {
+              const auto nodes_begin = *it->begin() / spacedim;
+              const auto n_nodes     = (it->end() - it->begin()) / spacedim;
+              const auto position_view =
+                make_array_view(nodes + nodes_begin, n_nodes);
+              const auto values_view = make_array_view(
+                spread_values.begin() + nodes_begin * n_components,
+                spread_values.begin() + (nodes_begin + n_nodes) * n_components);
+              Assert(values_view.size() % n_components == 0,
+                     ExcFDLInternalError());
+
+              spread_at_points(kernel_name,
+                               kernel,
+                               patch_data,
+                               patch,
+                               position_view,
+                               n_components,
+                               stencil_lower,
+                               kernel_weights,
+                               false,
+                               values_view.data());
+            }
+        }
+    };
+
+    used_policy.apply_to_ranges(patch_order.size(), spread_patches);
   }
 
 
@@ -1091,9 +3527,11 @@ namespace fdl
                        const int                     data_index,
                        NodalPatchMap<dim, spacedim> &patch_map,
                        const Vector<double>         &position,
-                       const Vector<double>         &spread_values)
+                       const Vector<double>         &spread_values,
+                       const ExecutionPolicy        &execution_policy)
   {
-#define ARGUMENTS kernel_name, data_index, patch_map, position, spread_values
+#define ARGUMENTS                                                            \
+  kernel_name, data_index, patch_map, position, spread_values, execution_policy
     if (patch_map.size() != 0)
       {
         auto patch_data = patch_map[0].second->getPatchData(data_index);
@@ -1135,6 +3573,276 @@ namespace fdl
 #undef ARGUMENTS
   }
 
+  namespace
+  {
+    // Call f(cell, unit_points, weights, intersections) for each cell which
+    // intersects a stencil on patch patch_n. Here cell is on dof_handler,
+    // unit_points and weights are the positions of the intersections on the
+    // reference cell and their quadrature weights, and intersections are
+    // the intersections themselves.
+    template <int dim, int spacedim, typename F>
+    void
+    for_each_intersected_cell(
+      const PatchIntersectionMap<dim, spacedim> &intersection_map,
+      const std::size_t                          patch_n,
+      const Mapping<dim, spacedim>              &position_mapping,
+      const DoFHandler<dim, spacedim>           &dof_handler,
+      const F                                   &f)
+    {
+      using Iterator = typename PatchIntersectionMap<dim, spacedim>::Iterator;
+      const Triangulation<dim, spacedim> &tria =
+        dof_handler.get_triangulation();
+
+      const auto &patch = intersection_map.get_patch(patch_n);
+      const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> pgeom =
+        patch->getPatchGeometry();
+      Tensor<1, spacedim> dx;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        dx[d] = pgeom->getDx()[d];
+
+      std::vector<Point<spacedim>>                      vertices;
+      std::vector<std::array<Point<spacedim>, dim + 1>> simplices;
+      std::vector<std::array<Point<dim>, dim + 1>>      unit_simplices;
+      std::vector<Point<dim>>                           unit_points;
+      std::vector<double>                               weights;
+      std::vector<Iterator>                             intersections;
+
+      auto       iter = intersection_map.begin(patch_n);
+      const auto end  = intersection_map.end(patch_n);
+      while (iter != end)
+        {
+          // Intersections in the same cell are contiguous
+          const int level = iter->get_cell_level();
+          const int index = iter->get_cell_index();
+          const typename Triangulation<dim, spacedim>::active_cell_iterator
+                     position_cell(&tria, level, index);
+          const auto mapped_vertices =
+            position_mapping.get_vertices(position_cell);
+          vertices.assign(mapped_vertices.begin(), mapped_vertices.end());
+          internal::split_cell_into_simplices<dim, spacedim>(
+            position_cell->reference_cell(),
+            make_array_view(vertices),
+            simplices,
+            unit_simplices);
+
+          unit_points.clear();
+          weights.clear();
+          intersections.clear();
+          for (; iter != end && iter->get_cell_level() == level &&
+                 iter->get_cell_index() == index;
+               ++iter)
+            {
+              const std::pair<Point<dim>, double> location =
+                internal::locate_intersection<dim, spacedim>(
+                  simplices,
+                  unit_simplices,
+                  iter->get_point(),
+                  iter->get_axis(),
+                  dx);
+              unit_points.push_back(location.first);
+              weights.push_back(location.second);
+              intersections.push_back(iter);
+            }
+
+          const typename DoFHandler<dim, spacedim>::active_cell_iterator cell(
+            &tria, level, index, &dof_handler);
+          f(cell, unit_points, weights, intersections);
+        }
+    }
+
+    template <int dim, int spacedim>
+    void
+    check_intersection_arguments(
+      const int                                  data_index,
+      const PatchIntersectionMap<dim, spacedim> &intersection_map,
+      const DoFHandler<dim, spacedim>           &position_dof_handler,
+      const DoFHandler<dim, spacedim>           &dof_handler)
+    {
+      (void)position_dof_handler;
+      (void)dof_handler;
+      Assert(&position_dof_handler.get_triangulation() ==
+               &dof_handler.get_triangulation(),
+             ExcMessage("The DoFHandlers should use the same Triangulation"));
+      if (intersection_map.size() != 0)
+        {
+          const auto pair = extract_types(
+            intersection_map.get_patch(0)->getPatchData(data_index));
+          AssertThrow(pair.first == SAMRAIPatchType::Cell &&
+                        pair.second == SAMRAIFieldType::Double,
+                      ExcFDLNotImplemented());
+        }
+    }
+  } // namespace
+
+  template <int dim, int spacedim>
+  void
+  compute_intersection_projection_rhs(
+    const int                                  data_index,
+    const PatchIntersectionMap<dim, spacedim> &intersection_map,
+    const DoFHandler<dim, spacedim>           &position_dof_handler,
+    const Mapping<dim, spacedim>              &position_mapping,
+    const DoFHandler<dim, spacedim>           &dof_handler,
+    const Mapping<dim, spacedim>              &mapping,
+    Vector<double>                            &rhs)
+  {
+    check_intersection_arguments(data_index,
+                                 intersection_map,
+                                 position_dof_handler,
+                                 dof_handler);
+    const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
+    const unsigned int                  n_components = fe.n_components();
+
+    std::vector<types::global_dof_index> dof_indices(fe.dofs_per_cell);
+    Vector<double>                       cell_rhs(fe.dofs_per_cell);
+    std::vector<double>                  values;
+    for (std::size_t patch_n = 0; patch_n < intersection_map.size();
+         ++patch_n)
+      {
+        const auto &patch = intersection_map.get_patch(patch_n);
+        Assert(patch->checkAllocated(data_index),
+               ExcMessage("unallocated data patch index"));
+        const tbox::Pointer<pdat::CellData<spacedim, double>> patch_data =
+          patch->getPatchData(data_index);
+        Assert(patch_data, ExcMessage("Type mismatch"));
+        check_depth<spacedim>(patch_data, n_components);
+
+        for_each_intersected_cell(
+          intersection_map,
+          patch_n,
+          position_mapping,
+          dof_handler,
+          [&](const auto &cell,
+              const auto &unit_points,
+              const auto &weights,
+              const auto &intersections)
+          {
+            // Linearly interpolate the Eulerian field along each stencil
+            const std::size_t n_points = unit_points.size();
+            values.resize(n_points * n_components);
+            for (std::size_t q = 0; q < n_points; ++q)
+              {
+                const double convex =
+                  intersections[q]->get_cell_convex_coefficient();
+                const pdat::CellIndex<spacedim> lower =
+                  intersections[q]->get_cell_lower();
+                const pdat::CellIndex<spacedim> upper =
+                  intersections[q]->get_cell_upper();
+                for (unsigned int c = 0; c < n_components; ++c)
+                  values[q * n_components + c] =
+                    weights[q] * ((1.0 - convex) * (*patch_data)(lower, c) +
+                                  convex * (*patch_data)(upper, c));
+              }
+
+            FEValues<dim, spacedim> fe_values(mapping,
+                                              fe,
+                                              Quadrature<dim>(unit_points),
+                                              update_values);
+            fe_values.reinit(cell);
+            cell_rhs = 0.0;
+            for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+              for (std::size_t q = 0; q < n_points; ++q)
+                for (unsigned int c = 0; c < n_components; ++c)
+                  cell_rhs[i] += fe_values.shape_value_component(i, q, c) *
+                                 values[q * n_components + c];
+
+            cell->get_dof_indices(dof_indices);
+            for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+              rhs[dof_indices[i]] += cell_rhs[i];
+          });
+      }
+  }
+
+  template <int dim, int spacedim>
+  void
+  compute_intersection_spread(
+    const int                                  data_index,
+    const PatchIntersectionMap<dim, spacedim> &intersection_map,
+    const DoFHandler<dim, spacedim>           &position_dof_handler,
+    const Mapping<dim, spacedim>              &position_mapping,
+    const DoFHandler<dim, spacedim>           &dof_handler,
+    const Mapping<dim, spacedim>              &mapping,
+    const Vector<double>                      &solution)
+  {
+    check_intersection_arguments(data_index,
+                                 intersection_map,
+                                 position_dof_handler,
+                                 dof_handler);
+    const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
+    const unsigned int                  n_components = fe.n_components();
+
+    std::vector<types::global_dof_index> dof_indices(fe.dofs_per_cell);
+    std::vector<double>                  values;
+    for (std::size_t patch_n = 0; patch_n < intersection_map.size();
+         ++patch_n)
+      {
+        const auto &patch = intersection_map.get_patch(patch_n);
+        Assert(patch->checkAllocated(data_index),
+               ExcMessage("unallocated data patch index"));
+        tbox::Pointer<pdat::CellData<spacedim, double>> patch_data =
+          patch->getPatchData(data_index);
+        Assert(patch_data, ExcMessage("Type mismatch"));
+        check_depth<spacedim>(patch_data, n_components);
+        const hier::Box<spacedim> ghost_box = patch_data->getGhostBox();
+
+        const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> pgeom =
+          patch->getPatchGeometry();
+        double cell_volume = 1.0;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          cell_volume *= pgeom->getDx()[d];
+
+        for_each_intersected_cell(
+          intersection_map,
+          patch_n,
+          position_mapping,
+          dof_handler,
+          [&](const auto &cell,
+              const auto &unit_points,
+              const auto &weights,
+              const auto &intersections)
+          {
+            const std::size_t       n_points = unit_points.size();
+            FEValues<dim, spacedim> fe_values(mapping,
+                                              fe,
+                                              Quadrature<dim>(unit_points),
+                                              update_values);
+            fe_values.reinit(cell);
+            cell->get_dof_indices(dof_indices);
+
+            values.clear();
+            values.resize(n_points * n_components);
+            for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+              {
+                const double dof_value = solution[dof_indices[i]];
+                for (std::size_t q = 0; q < n_points; ++q)
+                  for (unsigned int c = 0; c < n_components; ++c)
+                    values[q * n_components + c] +=
+                      dof_value * fe_values.shape_value_component(i, q, c);
+              }
+
+            for (std::size_t q = 0; q < n_points; ++q)
+              {
+                const double convex =
+                  intersections[q]->get_cell_convex_coefficient();
+                const double scale = weights[q] / cell_volume;
+                const pdat::CellIndex<spacedim> lower =
+                  intersections[q]->get_cell_lower();
+                const pdat::CellIndex<spacedim> upper =
+                  intersections[q]->get_cell_upper();
+                // The lower cell is always in the patch but the upper cell
+                // may be outside of the ghost region
+                const bool has_upper = ghost_box.contains(upper);
+                for (unsigned int c = 0; c < n_components; ++c)
+                  {
+                    const double value = scale * values[q * n_components + c];
+                    (*patch_data)(lower, c) += (1.0 - convex) * value;
+                    if (has_upper)
+                      (*patch_data)(upper, c) += convex * value;
+                  }
+              }
+          });
+      }
+  }
+
   std::optional<double>
   intersect_line_with_edge(const std::array<Point<2>, 2> &simplex,
                            const Point<2>                &stencil_start,
@@ -1274,6 +3982,175 @@ namespace fdl
   }
 
 
+  template <int spacedim>
+  void
+  intersect_stencils_with_simplex(
+    const std::array<Point<spacedim + 1>, spacedim + 1>     &simplex,
+    const std::array<ArrayView<const double>, spacedim + 1> &stencil_starts,
+    const double                                            &stencil_width,
+    const unsigned int                                       stencil_axis,
+    std::vector<unsigned char>                              &hits,
+    std::vector<double>                                     &convex_coefs)
+  {
+    constexpr int dim = spacedim + 1;
+    Assert(stencil_width > 0.0, ExcMessage("stencil width should be positive"));
+    AssertIndexRange(stencil_axis, dim);
+    const std::size_t n_points = stencil_starts[0].size();
+    for (unsigned int d = 0; d < dim; ++d)
+      AssertDimension(stencil_starts[d].size(), n_points);
+
+    using VA                       = VectorizedArray<double>;
+    constexpr unsigned int n_lanes = VA::size();
+    hits.resize(n_points);
+    convex_coefs.resize(n_points);
+    std::fill(hits.begin(), hits.end(), static_cast<unsigned char>(0));
+    std::fill(convex_coefs.begin(), convex_coefs.end(), 0.0);
+    if (n_points == 0)
+      return;
+
+    // Everything which only depends on the simplex is computed once, in
+    // scalar arithmetic, in the same way as the single-line functions. The
+    // per-line work is then done n_lanes lines at a time. Each test is
+    // converted into a mask of ones and zeros so that the loop has no
+    // branches.
+    const VA one(1.0), zero(0.0);
+
+    // Scalars used by either version
+    std::array<unsigned int, 2> plane_axis{{0, 0}};
+    double                      x_min = std::numeric_limits<double>::max();
+    double                      x_max = -std::numeric_limits<double>::max();
+    double                      y_min = std::numeric_limits<double>::max();
+    double                      y_max = -std::numeric_limits<double>::max();
+    double                      a     = 0.0;
+    double                      f     = 0.0;
+    Tensor<1, dim>              h;
+    Tensor<1, dim>              e1, e2;
+    if constexpr (dim == 3)
+      {
+        unsigned int i = 0;
+        for (unsigned int axis = 0; axis < 3; ++axis)
+          if (axis != stencil_axis)
+            plane_axis[i++] = axis;
+        for (unsigned int node = 0; node < simplex.size(); ++node)
+          {
+            x_min = std::min(simplex[node][plane_axis[0]], x_min);
+            x_max = std::max(simplex[node][plane_axis[0]], x_max);
+            y_min = std::min(simplex[node][plane_axis[1]], y_min);
+            y_max = std::max(simplex[node][plane_axis[1]], y_max);
+          }
+
+        Tensor<1, 3> q;
+        q[stencil_axis] = 1;
+        e1              = simplex[1] - simplex[0];
+        e2              = simplex[2] - simplex[0];
+        h               = cross_product_3d(q, e2);
+        a               = e1 * h;
+        // The line is parallel to the triangle
+        if (!(std::abs(a) > std::numeric_limits<double>::epsilon()))
+          return;
+        f = 1.0 / a;
+      }
+    else
+      {
+        static_assert(dim == 2, "only implemented for lines and triangles");
+        // Like intersect_line_with_edge(), the edge is parameterized by u in
+        // [-1, 1] along the axis orthogonal to the stencil.
+        plane_axis[0] = stencil_axis == 0 ? 1 : 0;
+        a = 0.5 * (simplex[1][plane_axis[0]] - simplex[0][plane_axis[0]]);
+        // The line is parallel to the edge (this would make u infinite or NaN
+        // in the single-line version)
+        if (a == 0.0)
+          return;
+      }
+
+    const std::size_t n_batches = (n_points + n_lanes - 1) / n_lanes;
+    std::array<VA, dim> start;
+    for (std::size_t batch_n = 0; batch_n < n_batches; ++batch_n)
+      {
+        const std::size_t  first_point = batch_n * n_lanes;
+        const unsigned int n_filled =
+          std::min<std::size_t>(n_lanes, n_points - first_point);
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            if (n_filled == n_lanes)
+              start[d].load(stencil_starts[d].data() + first_point);
+            else
+              {
+                // Pad with a valid line to avoid computing with garbage
+                start[d] = stencil_starts[d][first_point];
+                for (unsigned int lane = 0; lane < n_filled; ++lane)
+                  start[d][lane] = stencil_starts[d][first_point + lane];
+              }
+          }
+
+        VA hit = one;
+        VA t;
+        if constexpr (dim == 3)
+          {
+            constexpr double eps = std::numeric_limits<double>::epsilon();
+            const VA        &sx  = start[plane_axis[0]];
+            const VA        &sy  = start[plane_axis[1]];
+            hit = compare_and_apply_mask<SIMDComparison::greater_than_or_equal>(
+              sx, VA(x_min), hit, zero);
+            hit = compare_and_apply_mask<SIMDComparison::less_than_or_equal>(
+              sx, VA(x_max), hit, zero);
+            hit = compare_and_apply_mask<SIMDComparison::less_than_or_equal>(
+              sy, VA(y_max), hit, zero);
+            hit = compare_and_apply_mask<SIMDComparison::greater_than_or_equal>(
+              sy, VA(y_min), hit, zero);
+
+            std::array<VA, 3> s;
+            for (unsigned int d = 0; d < 3; ++d)
+              s[d] = start[d] - simplex[0][d];
+            const VA u = f * (s[0] * h[0] + s[1] * h[1] + s[2] * h[2]);
+            hit = compare_and_apply_mask<SIMDComparison::greater_than_or_equal>(
+              u, VA(0.0 - eps), hit, zero);
+            hit = compare_and_apply_mask<SIMDComparison::less_than_or_equal>(
+              u, VA(1.0 + eps), hit, zero);
+
+            // cr = s x e1
+            std::array<VA, 3> cr;
+            cr[0] = s[1] * e1[2] - s[2] * e1[1];
+            cr[1] = s[2] * e1[0] - s[0] * e1[2];
+            cr[2] = s[0] * e1[1] - s[1] * e1[0];
+            const VA v = f * cr[stencil_axis];
+            hit = compare_and_apply_mask<SIMDComparison::greater_than>(
+              v, VA(0.0 - eps), hit, zero);
+            hit = compare_and_apply_mask<SIMDComparison::less_than_or_equal>(
+              u + v, VA(1.0 + eps), hit, zero);
+
+            t = f * (e2[0] * cr[0] + e2[1] * cr[1] + e2[2] * cr[2]);
+          }
+        else
+          {
+            const unsigned int o   = plane_axis[0];
+            const double       tol = std::pow(10, -14);
+            const VA           b =
+              0.5 * (simplex[1][o] + simplex[0][o]) - start[o];
+            const VA u = -b / a;
+            hit = compare_and_apply_mask<SIMDComparison::greater_than_or_equal>(
+              u, VA(-1.0 - tol), hit, zero);
+            hit = compare_and_apply_mask<SIMDComparison::less_than_or_equal>(
+              u, VA(1.0 + tol), hit, zero);
+            const unsigned int ax = stencil_axis;
+            const VA           p  = simplex[0][ax] * 0.5 * (one - u) +
+                         simplex[1][ax] * 0.5 * (one + u);
+            t = p - start[ax];
+          }
+
+        const VA coef = t / stencil_width;
+        hit = compare_and_apply_mask<SIMDComparison::less_than_or_equal>(
+          std::abs(coef), one, hit, zero);
+        for (unsigned int lane = 0; lane < n_filled; ++lane)
+          if (hit[lane] != 0.0)
+            {
+              hits[first_point + lane]         = 1;
+              convex_coefs[first_point + lane] = coef[lane];
+            }
+      }
+  }
+
+
   // instantiations
 
   template void
@@ -1286,58 +4163,127 @@ namespace fdl
             const int                                              tag_index,
             SAMRAI::tbox::Pointer<SAMRAI::hier::PatchLevel<NDIM>> &patch_level);
 
-  template void
-  count_quadrature_points(const int                         qp_data_index,
-                          PatchMap<NDIM - 1, NDIM>         &patch_map,
-                          const Mapping<NDIM - 1, NDIM>    &position_mapping,
-                          const std::vector<unsigned char> &quadrature_indices,
-                          const std::vector<Quadrature<NDIM - 1>> &quadratures);
-
-  template void
-  count_quadrature_points(const int                         qp_data_index,
-                          PatchMap<NDIM, NDIM>             &patch_map,
-                          const Mapping<NDIM, NDIM>        &position_mapping,
-                          const std::vector<unsigned char> &quadrature_indices,
-                          const std::vector<Quadrature<NDIM>> &quadratures);
-
-  template void
+  template double
+  count_quadrature_points(
+    const int                                qp_data_index,
+    PatchMap<NDIM - 1, NDIM>                &patch_map,
+    const Mapping<NDIM - 1, NDIM>           &position_mapping,
+    const std::vector<unsigned char>        &quadrature_indices,
+    const std::vector<Quadrature<NDIM - 1>> &quadratures,
+    QuadraturePointCache<NDIM>              *quadrature_point_cache,
+    const double                             weight);
+
+  template double
+  count_quadrature_points(
+    const int                            qp_data_index,
+    PatchMap<NDIM, NDIM>                &patch_map,
+    const Mapping<NDIM, NDIM>           &position_mapping,
+    const std::vector<unsigned char>    &quadrature_indices,
+    const std::vector<Quadrature<NDIM>> &quadratures,
+    QuadraturePointCache<NDIM>          *quadrature_point_cache,
+    const double                         weight);
+
+  template double
+  estimate_quadrature_points(
+    const int                                qp_data_index,
+    PatchMap<NDIM - 1, NDIM>                &patch_map,
+    const Mapping<NDIM - 1, NDIM>           &position_mapping,
+    const std::vector<unsigned char>        &quadrature_indices,
+    const std::vector<Quadrature<NDIM - 1>> &quadratures,
+    const double                             weight);
+
+  template double
+  estimate_quadrature_points(
+    const int                            qp_data_index,
+    PatchMap<NDIM, NDIM>                &patch_map,
+    const Mapping<NDIM, NDIM>           &position_mapping,
+    const std::vector<unsigned char>    &quadrature_indices,
+    const std::vector<Quadrature<NDIM>> &quadratures,
+    const double                         weight);
+
+  template double
   count_nodes(const int                      node_count_data_index,
               NodalPatchMap<NDIM - 1, NDIM> &nodal_patch_map,
-              const Vector<double>          &position);
+              const Vector<double>          &position,
+              const double                   weight);
 
-  template void
+  template double
   count_nodes(const int                  node_count_data_index,
               NodalPatchMap<NDIM, NDIM> &nodal_patch_map,
-              const Vector<double>      &position);
+              const Vector<double>      &position,
+              const double               weight);
+
+  template void
+  compute_projection_rhs(
+    const std::string                       &kernel_name,
+    const int                                data_index,
+    const PatchMap<NDIM - 1, NDIM>          &patch_map,
+    const Mapping<NDIM - 1, NDIM>           &position_mapping,
+    const std::vector<unsigned char>        &quadrature_indices,
+    const std::vector<Quadrature<NDIM - 1>> &quadratures,
+    const DoFHandler<NDIM - 1, NDIM>        &dof_handler,
+    const Mapping<NDIM - 1, NDIM>           &mapping,
+    Vector<double>                          &rhs,
+    KernelWeightCache<NDIM>                 *kernel_weight_cache,
+    const ExecutionPolicy                   &execution_policy,
+    const bool                               mixed_precision,
+    QuadraturePointCache<NDIM>              *quadrature_point_cache);
 
   template void
-  compute_projection_rhs(const std::string                &kernel_name,
-                         const int                         data_index,
-                         const PatchMap<NDIM - 1, NDIM>   &patch_map,
-                         const Mapping<NDIM - 1, NDIM>    &position_mapping,
-                         const std::vector<unsigned char> &quadrature_indices,
-                         const std::vector<Quadrature<NDIM - 1>> &quadratures,
-                         const DoFHandler<NDIM - 1, NDIM>        &dof_handler,
-                         const Mapping<NDIM - 1, NDIM>           &mapping,
-                         Vector<double>                          &rhs);
+  compute_projection_rhs(
+    const std::string                   &kernel_name,
+    const int                            data_index,
+    const PatchMap<NDIM>                &patch_map,
+    const Mapping<NDIM>                 &position_mapping,
+    const std::vector<unsigned char>    &quadrature_indices,
+    const std::vector<Quadrature<NDIM>> &quadratures,
+    const DoFHandler<NDIM>              &dof_handler,
+    const Mapping<NDIM>                 &mapping,
+    Vector<double>                      &rhs,
+    KernelWeightCache<NDIM>             *kernel_weight_cache,
+    const ExecutionPolicy               &execution_policy,
+    const bool                           mixed_precision,
+    QuadraturePointCache<NDIM>          *quadrature_point_cache);
 
   template void
-  compute_projection_rhs(const std::string                &kernel_name,
-                         const int                         data_index,
-                         const PatchMap<NDIM>             &patch_map,
-                         const Mapping<NDIM>              &position_mapping,
-                         const std::vector<unsigned char> &quadrature_indices,
-                         const std::vector<Quadrature<NDIM>> &quadratures,
-                         const DoFHandler<NDIM>              &dof_handler,
-                         const Mapping<NDIM>                 &mapping,
-                         Vector<double>                      &rhs);
+  compute_projection_rhs(
+    const std::string                                     &kernel_name,
+    const std::vector<int>                                &data_indices,
+    const PatchMap<NDIM - 1, NDIM>                        &patch_map,
+    const Mapping<NDIM - 1, NDIM>                         &position_mapping,
+    const std::vector<unsigned char>                      &quadrature_indices,
+    const std::vector<Quadrature<NDIM - 1>>               &quadratures,
+    const std::vector<const DoFHandler<NDIM - 1, NDIM> *> &dof_handlers,
+    const std::vector<const Mapping<NDIM - 1, NDIM> *>    &mappings,
+    const std::vector<Vector<double> *>                   &rhs,
+    KernelWeightCache<NDIM>                               *kernel_weight_cache,
+    const ExecutionPolicy                                 &execution_policy,
+    const bool                                             mixed_precision,
+    QuadraturePointCache<NDIM> *quadrature_point_cache);
+
+  template void
+  compute_projection_rhs(
+    const std::string                           &kernel_name,
+    const std::vector<int>                      &data_indices,
+    const PatchMap<NDIM>                        &patch_map,
+    const Mapping<NDIM>                         &position_mapping,
+    const std::vector<unsigned char>            &quadrature_indices,
+    const std::vector<Quadrature<NDIM>>         &quadratures,
+    const std::vector<const DoFHandler<NDIM> *> &dof_handlers,
+    const std::vector<const Mapping<NDIM> *>    &mappings,
+    const std::vector<Vector<double> *>         &rhs,
+    KernelWeightCache<NDIM>                     *kernel_weight_cache,
+    const ExecutionPolicy                       &execution_policy,
+    const bool                                   mixed_precision,
+    QuadraturePointCache<NDIM>                  *quadrature_point_cache);
 
   template void
   compute_nodal_interpolation(const std::string                   &kernel_name,
                               const int                            data_index,
                               const NodalPatchMap<NDIM - 1, NDIM> &patch_map,
                               const Vector<double>                &position,
-                              Vector<double> &interpolated_values);
+                              Vector<double>     &interpolated_values,
+                              const ExecutionPolicy &execution_policy);
 
 
   template void
@@ -1345,36 +4291,50 @@ namespace fdl
                               const int                        data_index,
                               const NodalPatchMap<NDIM, NDIM> &patch_map,
                               const Vector<double>            &position,
-                              Vector<double> &interpolated_values);
-
-  template void
-  compute_spread(const std::string                       &kernel_name,
-                 const int                                data_index,
-                 PatchMap<NDIM - 1, NDIM>                &patch_map,
-                 const Mapping<NDIM - 1, NDIM>           &position_mapping,
-                 const std::vector<unsigned char>        &quadrature_indices,
-                 const std::vector<Quadrature<NDIM - 1>> &quadratures,
-                 const DoFHandler<NDIM - 1, NDIM>        &dof_handler,
-                 const Mapping<NDIM - 1, NDIM>           &mapping,
-                 const Vector<double>                    &solution);
-
-  template void
-  compute_spread(const std::string                   &kernel_name,
-                 const int                            data_index,
-                 PatchMap<NDIM, NDIM>                &patch_map,
-                 const Mapping<NDIM, NDIM>           &position_mapping,
-                 const std::vector<unsigned char>    &quadrature_indices,
-                 const std::vector<Quadrature<NDIM>> &quadratures,
-                 const DoFHandler<NDIM, NDIM>        &dof_handler,
-                 const Mapping<NDIM, NDIM>           &mapping,
-                 const Vector<double>                &solution);
+                              Vector<double>     &interpolated_values,
+                              const ExecutionPolicy &execution_policy);
+
+  template std::size_t
+  compute_spread(
+    const std::string                       &kernel_name,
+    const int                                data_index,
+    PatchMap<NDIM - 1, NDIM>                &patch_map,
+    const Mapping<NDIM - 1, NDIM>           &position_mapping,
+    const std::vector<unsigned char>        &quadrature_indices,
+    const std::vector<Quadrature<NDIM - 1>> &quadratures,
+    const DoFHandler<NDIM - 1, NDIM>        &dof_handler,
+    const Mapping<NDIM - 1, NDIM>           &mapping,
+    const Vector<double>                    &solution,
+    KernelWeightCache<NDIM>                 *kernel_weight_cache,
+    const ExecutionPolicy                   &execution_policy,
+    const bool                               mixed_precision,
+    QuadraturePointCache<NDIM>              *quadrature_point_cache,
+    const bool                               skip_zero_cells);
+
+  template std::size_t
+  compute_spread(
+    const std::string                   &kernel_name,
+    const int                            data_index,
+    PatchMap<NDIM, NDIM>                &patch_map,
+    const Mapping<NDIM, NDIM>           &position_mapping,
+    const std::vector<unsigned char>    &quadrature_indices,
+    const std::vector<Quadrature<NDIM>> &quadratures,
+    const DoFHandler<NDIM, NDIM>        &dof_handler,
+    const Mapping<NDIM, NDIM>           &mapping,
+    const Vector<double>                &solution,
+    KernelWeightCache<NDIM>             *kernel_weight_cache,
+    const ExecutionPolicy               &execution_policy,
+    const bool                           mixed_precision,
+    QuadraturePointCache<NDIM>          *quadrature_point_cache,
+    const bool                           skip_zero_cells);
 
   template void
   compute_nodal_spread(const std::string             &kernel_name,
                        const int                      data_index,
                        NodalPatchMap<NDIM - 1, NDIM> &patch_map,
                        const Vector<double>          &position,
-                       const Vector<double>          &spread_values);
+                       const Vector<double>          &spread_values,
+                       const ExecutionPolicy         &execution_policy);
 
 
   template void
@@ -1382,7 +4342,28 @@ namespace fdl
                        const int                  data_index,
                        NodalPatchMap<NDIM, NDIM> &patch_map,
                        const Vector<double>      &position,
-                       const Vector<double>      &spread_values);
+                       const Vector<double>      &spread_values,
+                       const ExecutionPolicy     &execution_policy);
+
+  template void
+  compute_intersection_projection_rhs(
+    const int                                   data_index,
+    const PatchIntersectionMap<NDIM - 1, NDIM> &intersection_map,
+    const DoFHandler<NDIM - 1, NDIM>           &position_dof_handler,
+    const Mapping<NDIM - 1, NDIM>              &position_mapping,
+    const DoFHandler<NDIM - 1, NDIM>           &dof_handler,
+    const Mapping<NDIM - 1, NDIM>              &mapping,
+    Vector<double>                             &rhs);
+
+  template void
+  compute_intersection_spread(
+    const int                                   data_index,
+    const PatchIntersectionMap<NDIM - 1, NDIM> &intersection_map,
+    const DoFHandler<NDIM - 1, NDIM>           &position_dof_handler,
+    const Mapping<NDIM - 1, NDIM>              &position_mapping,
+    const DoFHandler<NDIM - 1, NDIM>           &dof_handler,
+    const Mapping<NDIM - 1, NDIM>              &mapping,
+    const Vector<double>                       &solution);
 
   template std::optional<double>
   intersect_stencil_with_simplex<NDIM - 1>(
@@ -1390,4 +4371,13 @@ namespace fdl
     const Point<NDIM>                   &stencil_start,
     const double                        &stencil_width,
     const unsigned int                   stencil_axis);
+
+  template void
+  intersect_stencils_with_simplex<NDIM - 1>(
+    const std::array<Point<NDIM>, NDIM>             &simplex,
+    const std::array<ArrayView<const double>, NDIM> &stencil_starts,
+    const double                                    &stencil_width,
+    const unsigned int                               stencil_axis,
+    std::vector<unsigned char>                      &hits,
+    std::vector<double>                             &convex_coefs);
 } // namespace fdl
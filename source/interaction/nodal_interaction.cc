@@ -1,12 +1,16 @@
 #include <fiddle/base/samrai_utilities.h>
 
 #include <fiddle/grid/box_utilities.h>
+#include <fiddle/grid/intersection_predicate_lib.h>
 
 #include <fiddle/interaction/interaction_utilities.h>
 #include <fiddle/interaction/nodal_interaction.h>
 
 #include <fiddle/transfer/overlap_partitioning_tools.h>
 
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/mpi.h>
+
 #include <deal.II/dofs/dof_renumbering.h>
 #include <deal.II/dofs/dof_tools.h>
 
@@ -125,7 +129,7 @@ namespace fdl
       this->return_scatter(position_dof_handler, std::move(scatter));
     }
 
-    const double ghost_cell_fraction =
+    ghost_cell_fraction =
       input_db->getDoubleWithDefault("ghost_cell_fraction", 1.0);
 
     // This won't work correctly yet with no ghost cell fraction
@@ -197,6 +201,101 @@ namespace fdl
     }
   }
 
+  template <int dim, int spacedim>
+  bool
+  NodalInteraction<dim, spacedim>::update_position(
+    const std::vector<BoundingBox<spacedim, float>>  &active_cell_bboxes,
+    const DoFHandler<dim, spacedim>                  &position_dof_handler,
+    const LinearAlgebra::distributed::Vector<double> &position)
+  {
+    FDL_SETUP_TIMER_AND_SCOPE(t_update_position,
+                              "fdl::NodalInteraction::update_position()");
+    Assert(&position_dof_handler == &*native_position_dof_handler,
+           ExcMessage("The position DoFHandler should be the one given to "
+                      "reinit()."));
+    Assert(active_cell_bboxes.size() == this->native_tria->n_active_cells(),
+           ExcMessage("There should be a bounding box for each active cell"));
+
+    // reinit() stores the patches of each level in order, so if the
+    // hierarchy was regridded then at least one patch is different
+    std::vector<tbox::Pointer<hier::Patch<spacedim>>> current_patches;
+    for (int ln = this->level_numbers.first; ln <= this->level_numbers.second;
+         ++ln)
+      {
+        const auto level_patches =
+          extract_patches(this->patch_hierarchy->getPatchLevel(ln));
+        current_patches.insert(current_patches.end(),
+                               level_patches.begin(),
+                               level_patches.end());
+      }
+    bool can_update = current_patches.size() == patches.size() &&
+                      this->overlap_tria.n_active_cells() > 0;
+    for (std::size_t i = 0; can_update && i < patches.size(); ++i)
+      can_update = current_patches[i] == patches[i];
+
+    // Same predicate as the one used by InteractionBase::reinit()
+    if (can_update)
+      {
+        const std::vector<BoundingBox<spacedim, float>> patch_bboxes =
+          compute_patch_bboxes<spacedim, float>(current_patches,
+                                                ghost_cell_fraction);
+        BoxIntersectionPredicate<dim, spacedim> predicate(active_cell_bboxes,
+                                                          patch_bboxes,
+                                                          *this->native_tria);
+        can_update = this->overlap_tria.has_same_native_cells(predicate);
+      }
+    if (Utilities::MPI::min(int(can_update), this->communicator) == 0)
+      return false;
+
+    Vector<double> new_overlap_position(overlap_position.size());
+    {
+      Scatter<double> scatter = this->get_scatter(position_dof_handler);
+      scatter.global_to_overlap_start(position, 0, new_overlap_position);
+      scatter.global_to_overlap_finish(position, new_overlap_position);
+      this->return_scatter(position_dof_handler, std::move(scatter));
+    }
+
+    // Patch maps which are not shared with the position DoFHandler are
+    // recomputed at first use
+    Assert(nodal_patch_maps.size() > 0 && nodal_patch_maps[0],
+           ExcFDLInternalError());
+    nodal_patch_maps[0]->update(patches,
+                                bboxes,
+                                overlap_position,
+                                new_overlap_position);
+    for (std::size_t i = 1; i < nodal_patch_maps.size(); ++i)
+      if (nodal_patch_maps[i] != nodal_patch_maps[0])
+        nodal_patch_maps[i] = nullptr;
+    overlap_position = std::move(new_overlap_position);
+
+    return true;
+  }
+
+  template <int dim, int spacedim>
+  bool
+  NodalInteraction<dim, spacedim>::update_patch_hierarchy(
+    tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy,
+    const std::pair<int, int>                    &level_numbers)
+  {
+    if (!InteractionBase<dim, spacedim>::update_patch_hierarchy(
+          patch_hierarchy, level_numbers))
+      return false;
+
+    // The nodes did not move, so this just replaces the patches
+    patches = this->get_patches(patch_hierarchy);
+    Assert(nodal_patch_maps.size() > 0 && nodal_patch_maps[0],
+           ExcFDLInternalError());
+    nodal_patch_maps[0]->update(patches,
+                                bboxes,
+                                overlap_position,
+                                overlap_position);
+    for (std::size_t i = 1; i < nodal_patch_maps.size(); ++i)
+      if (nodal_patch_maps[i] != nodal_patch_maps[0])
+        nodal_patch_maps[i] = nullptr;
+
+    return true;
+  }
+
   template <int dim, int spacedim>
   void
   NodalInteraction<dim, spacedim>::add_dof_handler(
@@ -229,9 +328,11 @@ namespace fdl
         // to use the same numbering on each cell. Hence we have to call that
         // first and then combine it with the nodal renumbering.
         std::vector<types::global_dof_index> overlap_to_native_dofs =
-          compute_overlap_to_native_dof_translation(this->overlap_tria,
-                                                    overlap_dof_handler,
-                                                    native_dof_handler);
+          compute_overlap_to_native_dof_translation(
+            this->overlap_tria,
+            overlap_dof_handler,
+            native_dof_handler,
+            this->execution_policy.get_n_threads());
 
         std::vector<types::global_dof_index> nodal_renumbering(
           overlap_dof_handler.n_dofs());
@@ -275,6 +376,13 @@ namespace fdl
     return true;
   }
 
+  template <int dim, int spacedim>
+  bool
+  NodalInteraction<dim, spacedim>::spreading_is_nodal() const
+  {
+    return true;
+  }
+
 
   template <int dim, int spacedim>
   std::unique_ptr<TransactionBase>
@@ -288,28 +396,46 @@ namespace fdl
     Assert((trans.next_state ==
             Transaction<dim, spacedim>::State::Intermediate),
            ExcMessage("Transaction state should be Intermediate"));
+    // NodalPatchMaps depend on the position used by reinit(), so they cannot
+    // be shared by several parts
+    AssertThrow(trans.additional_parts.size() == 0, ExcFDLNotImplemented());
+
+    const auto interpolate =
+      [&](const int                        data_idx,
+          const DoFHandler<dim, spacedim> &native_dof_handler,
+          Vector<double>                  &overlap_rhs)
+    {
+      // If needed, convert the given position vector into the relevant nodal
+      // one
+      const bool reuse_nodes =
+        trans.native_position_dof_handler->get_fe().base_element(0) ==
+        native_dof_handler.get_fe().base_element(0);
+      Vector<double> nodal_coordinates;
+      if (!reuse_nodes)
+        {
+          nodal_coordinates = compute_nodes(
+            this->get_overlap_dof_handler(*trans.native_position_dof_handler),
+            trans.overlap_position,
+            this->get_overlap_dof_handler(native_dof_handler));
+        }
 
-    // If needed, convert the given position vector into the relevant nodal
-    // one
-    const bool reuse_nodes =
-      trans.native_position_dof_handler->get_fe().base_element(0) ==
-      trans.native_dof_handler->get_fe().base_element(0);
-    Vector<double> nodal_coordinates;
-    if (!reuse_nodes)
-      {
-        nodal_coordinates = compute_nodes(
-          this->get_overlap_dof_handler(*trans.native_position_dof_handler),
-          trans.overlap_position,
-          this->get_overlap_dof_handler(*trans.native_dof_handler));
-      }
-
-    // Actually do the work:
-    compute_nodal_interpolation(trans.kernel_name,
-                                trans.current_data_idx,
-                                get_nodal_patch_map(*trans.native_dof_handler),
-                                reuse_nodes ? trans.overlap_position :
-                                              nodal_coordinates,
-                                trans.overlap_rhs);
+      // Actually do the work:
+      compute_nodal_interpolation(trans.kernel_name,
+                                  data_idx,
+                                  get_nodal_patch_map(native_dof_handler),
+                                  reuse_nodes ? trans.overlap_position :
+                                                nodal_coordinates,
+                                  overlap_rhs,
+                                  this->execution_policy);
+    };
+
+    // Nodes generally differ between fields so there is no work to share
+    // other than the position scatter
+    interpolate(trans.current_data_idx,
+                *trans.native_dof_handler,
+                trans.overlap_rhs);
+    for (auto &field : trans.additional_fields)
+      interpolate(field.data_idx, *field.native_dof_handler, field.overlap_rhs);
 
     trans.next_state = Transaction<dim, spacedim>::State::AccumulateStart;
     return t_ptr;
@@ -332,6 +458,10 @@ namespace fdl
     trans.rhs_scatter.overlap_to_global_finish(trans.overlap_rhs,
                                                trans.rhs_scatter_back_op,
                                                *trans.native_rhs);
+    for (auto &field : trans.additional_fields)
+      field.rhs_scatter.overlap_to_global_finish(field.overlap_rhs,
+                                                 trans.rhs_scatter_back_op,
+                                                 *field.native_rhs);
     trans.next_state = Transaction<dim, spacedim>::State::Done;
 
     // If nodes are outside the domain then their value is still -DBL_MAX (in
@@ -341,20 +471,30 @@ namespace fdl
     // TODO: if this takes a measurable amount of time to execute then it
     // would be better to only check DoFs which are within 1 cell of the
     // boundary as of the last regrid.
-    auto      &vec  = *trans.native_rhs;
-    const auto size = vec.locally_owned_size();
-    DEAL_II_OPENMP_SIMD_PRAGMA
-    for (types::global_dof_index i = 0; i < size; ++i)
-      {
-        double &v = vec.local_element(i);
-        if (v == std::numeric_limits<double>::lowest())
-          v = 0.0;
-      }
+    const auto zero_unset_values =
+      [](LinearAlgebra::distributed::Vector<double> &vec)
+    {
+      const auto size = vec.locally_owned_size();
+      DEAL_II_OPENMP_SIMD_PRAGMA
+      for (types::global_dof_index i = 0; i < size; ++i)
+        {
+          double &v = vec.local_element(i);
+          if (v == std::numeric_limits<double>::lowest())
+            v = 0.0;
+        }
+    };
+    zero_unset_values(*trans.native_rhs);
+    for (auto &field : trans.additional_fields)
+      zero_unset_values(*field.native_rhs);
 
     this->return_scatter(*trans.native_position_dof_handler,
                          std::move(trans.position_scatter));
     this->return_scatter(*trans.native_dof_handler,
                          std::move(trans.rhs_scatter));
+    for (auto &field : trans.additional_fields)
+      this->return_scatter(*field.native_dof_handler,
+                           std::move(field.rhs_scatter));
+    this->return_overlap_vectors(trans);
   }
 
 
@@ -403,6 +543,7 @@ namespace fdl
     // grid levels
     AssertThrow(this->level_numbers.first == this->level_numbers.second,
                 ExcFDLNotImplemented());
+    AssertThrow(trans.additional_parts.size() == 0, ExcFDLNotImplemented());
 
     // Actually do the spreading:
     compute_nodal_spread(trans.kernel_name,
@@ -411,7 +552,8 @@ namespace fdl
                          const_cast<NodalPatchMap<dim, spacedim> &>(
                            get_nodal_patch_map(*trans.native_dof_handler)),
                          trans.overlap_position,
-                         trans.overlap_solution);
+                         trans.overlap_solution,
+                         this->execution_policy);
 
     trans.next_state = Transaction<dim, spacedim>::State::AccumulateFinish;
 
@@ -429,14 +571,23 @@ namespace fdl
            ExcMessage("Transaction state should be Intermediate"));
 
     // Finish communication:
-    trans.position_scatter.global_to_overlap_finish(*trans.native_position,
-                                                    trans.overlap_position);
+    if (!trans.reuse_overlap_position)
+      {
+        trans.position_scatter.global_to_overlap_finish(
+          *trans.native_position, trans.overlap_position);
+        this->cache_overlap_position(*trans.native_position_dof_handler,
+                                     *trans.native_position,
+                                     trans.position_version,
+                                     trans.overlap_position);
+      }
 
-    count_nodes(trans.workload_index,
-                // TODO: casting away const is bad
-                const_cast<NodalPatchMap<dim, spacedim> &>(
-                  get_nodal_patch_map(*trans.native_position_dof_handler)),
-                trans.overlap_position);
+    this->local_unweighted_workload =
+      count_nodes(trans.workload_index,
+                  // TODO: casting away const is bad
+                  const_cast<NodalPatchMap<dim, spacedim> &>(
+                    get_nodal_patch_map(*trans.native_position_dof_handler)),
+                  trans.overlap_position,
+                  this->workload_weight);
 
     trans.next_state =
       WorkloadTransaction<dim, spacedim>::State::AccumulateFinish;
@@ -454,6 +605,23 @@ namespace fdl
 
 
 
+  template <int dim, int spacedim>
+  std::size_t
+  NodalInteraction<dim, spacedim>::memory_consumption() const
+  {
+    std::size_t result = InteractionBase<dim, spacedim>::memory_consumption() +
+                         overlap_position.memory_consumption() +
+                         patches.capacity() * sizeof(patches[0]);
+    for (const auto &patch_bboxes : bboxes)
+      result += patch_bboxes.capacity() * sizeof(BoundingBox<spacedim>);
+    for (const auto &nodal_patch_map : nodal_patch_maps)
+      if (nodal_patch_map)
+        result += nodal_patch_map->memory_consumption();
+    return result;
+  }
+
+
+
   template <int dim, int spacedim>
   const NodalPatchMap<dim, spacedim> &
   NodalInteraction<dim, spacedim>::get_nodal_patch_map(
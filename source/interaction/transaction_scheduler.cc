@@ -0,0 +1,221 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/interaction/transaction_scheduler.h>
+
+#include <algorithm>
+
+namespace fdl
+{
+  void
+  TransactionScheduler::add(std::unique_ptr<TransactionBase> transaction,
+                            std::vector<Step>                steps)
+  {
+    Assert(transaction, ExcMessage("The transaction should not be null"));
+    Task task;
+    task.transaction = std::move(transaction);
+    task.steps       = std::move(steps);
+    task.requests    = task.transaction->delegate_outstanding_requests();
+    tasks.emplace_back(std::move(task));
+  }
+
+
+
+  void
+  TransactionScheduler::add(const void                      *owner,
+                            std::unique_ptr<TransactionBase> transaction,
+                            std::vector<Step>                steps)
+  {
+    const auto same_owner = [&](const Task &task)
+    { return task.transaction && task.owner == owner; };
+    AssertThrow(std::none_of(tasks.begin(), tasks.end(), same_owner),
+                ExcMessage("Each pending transaction should use a different "
+                           "interaction object."));
+    add(std::move(transaction), std::move(steps));
+    tasks.back().owner = owner;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  TransactionScheduler::add_projection_rhs(
+    InteractionBase<dim, spacedim>  &interaction,
+    std::unique_ptr<TransactionBase> transaction)
+  {
+    InteractionBase<dim, spacedim> *ptr = &interaction;
+    add(ptr,
+        std::move(transaction),
+        {[ptr](std::unique_ptr<TransactionBase> t)
+         { return ptr->compute_projection_rhs_scatter_finish(std::move(t)); },
+         [ptr](std::unique_ptr<TransactionBase> t)
+         { return ptr->compute_projection_rhs_intermediate(std::move(t)); },
+         [ptr](std::unique_ptr<TransactionBase> t)
+         { return ptr->compute_projection_rhs_accumulate_start(std::move(t)); },
+         [ptr](std::unique_ptr<TransactionBase> t)
+         {
+           ptr->compute_projection_rhs_accumulate_finish(std::move(t));
+           return std::unique_ptr<TransactionBase>();
+         }});
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  TransactionScheduler::add_spread(
+    InteractionBase<dim, spacedim>  &interaction,
+    std::unique_ptr<TransactionBase> transaction)
+  {
+    InteractionBase<dim, spacedim> *ptr = &interaction;
+    add(ptr,
+        std::move(transaction),
+        {[ptr](std::unique_ptr<TransactionBase> t)
+         { return ptr->compute_spread_scatter_finish(std::move(t)); },
+         [ptr](std::unique_ptr<TransactionBase> t)
+         { return ptr->compute_spread_intermediate(std::move(t)); },
+         [ptr](std::unique_ptr<TransactionBase> t)
+         {
+           ptr->compute_spread_finish(std::move(t));
+           return std::unique_ptr<TransactionBase>();
+         }});
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  TransactionScheduler::add_workload(
+    InteractionBase<dim, spacedim>  &interaction,
+    std::unique_ptr<TransactionBase> transaction)
+  {
+    InteractionBase<dim, spacedim> *ptr = &interaction;
+    add(ptr,
+        std::move(transaction),
+        {[ptr](std::unique_ptr<TransactionBase> t)
+         { return ptr->add_workload_intermediate(std::move(t)); },
+         [ptr](std::unique_ptr<TransactionBase> t)
+         {
+           ptr->add_workload_finish(std::move(t));
+           return std::unique_ptr<TransactionBase>();
+         }});
+  }
+
+
+
+  void
+  TransactionScheduler::advance(Task &task)
+  {
+    while (task.transaction && task.next_step < task.steps.size())
+      {
+        task.transaction =
+          task.steps[task.next_step++](std::move(task.transaction));
+        if (task.transaction)
+          {
+            task.requests = task.transaction->delegate_outstanding_requests();
+            if (std::any_of(task.requests.begin(),
+                            task.requests.end(),
+                            [](const MPI_Request &request)
+                            { return request != MPI_REQUEST_NULL; }))
+              return;
+          }
+      }
+    // Release the transaction's memory as soon as possible
+    task.transaction.reset();
+  }
+
+
+
+  void
+  TransactionScheduler::run()
+  {
+    const auto is_null = [](const MPI_Request &request)
+    { return request == MPI_REQUEST_NULL; };
+
+    std::vector<MPI_Request> requests;
+    std::vector<std::size_t> request_tasks;
+    std::vector<std::size_t> request_indices;
+    std::vector<int>         indices;
+    while (n_pending_transactions() > 0)
+      {
+        // Run every task which is not waiting on communication:
+        for (Task &task : tasks)
+          if (task.transaction &&
+              std::all_of(task.requests.begin(), task.requests.end(), is_null))
+            advance(task);
+
+        // Wait for at least one request to complete:
+        requests.clear();
+        request_tasks.clear();
+        request_indices.clear();
+        for (std::size_t task_n = 0; task_n < tasks.size(); ++task_n)
+          for (std::size_t i = 0; i < tasks[task_n].requests.size(); ++i)
+            if (tasks[task_n].requests[i] != MPI_REQUEST_NULL)
+              {
+                requests.push_back(tasks[task_n].requests[i]);
+                request_tasks.push_back(task_n);
+                request_indices.push_back(i);
+              }
+        if (requests.size() == 0)
+          continue;
+
+        indices.resize(requests.size());
+        int       n_done = 0;
+        const int ierr   = MPI_Waitsome(requests.size(),
+                                      requests.data(),
+                                      &n_done,
+                                      indices.data(),
+                                      MPI_STATUSES_IGNORE);
+        AssertThrowMPI(ierr);
+        AssertThrow(n_done != MPI_UNDEFINED, ExcFDLInternalError());
+        // Waitsome does not null out persistent requests, so do it ourselves
+        for (int i = 0; i < n_done; ++i)
+          tasks[request_tasks[indices[i]]]
+            .requests[request_indices[indices[i]]] = MPI_REQUEST_NULL;
+      }
+
+    tasks.clear();
+  }
+
+
+
+  std::size_t
+  TransactionScheduler::n_pending_transactions() const
+  {
+    return std::count_if(tasks.begin(),
+                         tasks.end(),
+                         [](const Task &task)
+                         { return bool(task.transaction); });
+  }
+
+
+
+  template void
+  TransactionScheduler::add_projection_rhs(
+    InteractionBase<NDIM - 1, NDIM> &interaction,
+    std::unique_ptr<TransactionBase> transaction);
+
+  template void
+  TransactionScheduler::add_projection_rhs(
+    InteractionBase<NDIM, NDIM>     &interaction,
+    std::unique_ptr<TransactionBase> transaction);
+
+  template void
+  TransactionScheduler::add_spread(
+    InteractionBase<NDIM - 1, NDIM> &interaction,
+    std::unique_ptr<TransactionBase> transaction);
+
+  template void
+  TransactionScheduler::add_spread(
+    InteractionBase<NDIM, NDIM>     &interaction,
+    std::unique_ptr<TransactionBase> transaction);
+
+  template void
+  TransactionScheduler::add_workload(
+    InteractionBase<NDIM - 1, NDIM> &interaction,
+    std::unique_ptr<TransactionBase> transaction);
+
+  template void
+  TransactionScheduler::add_workload(
+    InteractionBase<NDIM, NDIM>     &interaction,
+    std::unique_ptr<TransactionBase> transaction);
+} // namespace fdl
@@ -0,0 +1,194 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/boundary_trace.h>
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/quadrature.h>
+
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping.h>
+
+#include <deal.II/grid/reference_cell.h>
+
+#include <deal.II/numerics/rtree.h>
+
+#include <algorithm>
+
+namespace fdl
+{
+  template <int dim, int spacedim>
+  BoundaryTrace<dim, spacedim>::BoundaryTrace(
+    const Part<dim, spacedim>     &volume_part,
+    const Part<dim - 1, spacedim> &surface_part)
+  {
+    const DoFHandler<dim, spacedim> &volume_dof_handler =
+      volume_part.get_dof_handler();
+    const DoFHandler<dim - 1, spacedim> &surface_dof_handler =
+      surface_part.get_dof_handler();
+    const FiniteElement<dim, spacedim> &volume_fe =
+      volume_dof_handler.get_fe();
+    const FiniteElement<dim - 1, spacedim> &surface_fe =
+      surface_dof_handler.get_fe();
+    AssertThrow(volume_fe.has_support_points() &&
+                  surface_fe.has_support_points(),
+                ExcMessage("Both finite elements should have support points."));
+    AssertThrow(volume_fe.n_components() == surface_fe.n_components(),
+                ExcMessage("Both finite elements should have the same number "
+                           "of components."));
+    // No mixed meshes yet
+    AssertThrow(volume_dof_handler.get_triangulation()
+                    .get_reference_cells()
+                    .size() == 1 &&
+                  surface_dof_handler.get_triangulation()
+                      .get_reference_cells()
+                      .size() == 1,
+                ExcFDLNotImplemented());
+
+    // Support points of the DoFs on boundary faces of the volume, sorted by
+    // component:
+    const unsigned int n_components = volume_fe.n_components();
+    std::vector<std::vector<Point<spacedim>>> volume_points(n_components);
+    std::vector<std::vector<types::global_dof_index>> volume_point_dofs(
+      n_components);
+    {
+      const ReferenceCell reference_cell =
+        volume_dof_handler.get_triangulation().get_reference_cells().front();
+      FEValues<dim, spacedim> fe_values(
+        reference_cell.template get_default_linear_mapping<dim, spacedim>(),
+        volume_fe,
+        Quadrature<dim>(volume_fe.get_unit_support_points()),
+        update_quadrature_points);
+      std::vector<types::global_dof_index> dofs(volume_fe.n_dofs_per_cell());
+      std::vector<bool> is_boundary_dof(volume_fe.n_dofs_per_cell());
+      for (const auto &cell : volume_dof_handler.active_cell_iterators())
+        if (!cell->is_artificial() && cell->at_boundary())
+          {
+            std::fill(is_boundary_dof.begin(), is_boundary_dof.end(), false);
+            for (const unsigned int face_no : cell->face_indices())
+              if (cell->face(face_no)->at_boundary())
+                for (unsigned int i = 0; i < dofs.size(); ++i)
+                  if (volume_fe.has_support_on_face(i, face_no))
+                    is_boundary_dof[i] = true;
+
+            fe_values.reinit(cell);
+            cell->get_dof_indices(dofs);
+            for (unsigned int i = 0; i < dofs.size(); ++i)
+              if (is_boundary_dof[i])
+                {
+                  const unsigned int component =
+                    volume_fe.system_to_component_index(i).first;
+                  volume_points[component].push_back(
+                    fe_values.quadrature_point(i));
+                  volume_point_dofs[component].push_back(dofs[i]);
+                }
+          }
+    }
+    std::vector<decltype(pack_rtree_of_indices(volume_points[0]))> rtrees;
+    for (const std::vector<Point<spacedim>> &points : volume_points)
+      rtrees.emplace_back(pack_rtree_of_indices(points));
+
+    // Match each locally owned surface DoF with the nearest volume DoF of the
+    // same component:
+    const IndexSet &surface_owned =
+      surface_part.get_partitioner()->locally_owned_range();
+    volume_dofs.resize(surface_owned.n_elements(), numbers::invalid_dof_index);
+    {
+      const ReferenceCell reference_cell =
+        surface_dof_handler.get_triangulation().get_reference_cells().front();
+      FEValues<dim - 1, spacedim> fe_values(
+        reference_cell.template get_default_linear_mapping<dim - 1, spacedim>(),
+        surface_fe,
+        Quadrature<dim - 1>(surface_fe.get_unit_support_points()),
+        update_quadrature_points);
+      std::vector<types::global_dof_index> dofs(surface_fe.n_dofs_per_cell());
+      for (const auto &cell : surface_dof_handler.active_cell_iterators())
+        if (!cell->is_artificial())
+          {
+            fe_values.reinit(cell);
+            cell->get_dof_indices(dofs);
+            // Support points are distinct vertices or interpolation points, so
+            // a small multiple of the shortest edge is a safe tolerance
+            const double tolerance = 1e-6 * cell->minimum_vertex_distance();
+            for (unsigned int i = 0; i < dofs.size(); ++i)
+              {
+                if (!surface_owned.is_element(dofs[i]))
+                  continue;
+                const auto k = surface_owned.index_within_set(dofs[i]);
+                if (volume_dofs[k] != numbers::invalid_dof_index)
+                  continue;
+
+                const unsigned int component =
+                  surface_fe.system_to_component_index(i).first;
+                const Point<spacedim> &point = fe_values.quadrature_point(i);
+                const auto &rtree = rtrees[component];
+                const auto  it    = rtree.qbegin(bgi::nearest(point, 1));
+                AssertThrow(it != rtree.qend() &&
+                              volume_points[component][*it].distance(point) <=
+                                tolerance,
+                            ExcMessage("A surface DoF does not lie on the "
+                                       "boundary of the volume part."));
+                volume_dofs[k] = volume_point_dofs[component][*it];
+              }
+          }
+    }
+    AssertThrow(std::find(volume_dofs.begin(),
+                          volume_dofs.end(),
+                          numbers::invalid_dof_index) == volume_dofs.end(),
+                ExcFDLInternalError());
+
+    scatter = Scatter<double>(
+      volume_dofs,
+      volume_part.get_partitioner()->locally_owned_range(),
+      volume_part.get_communicator());
+    buffer.reinit(volume_dofs.size());
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  BoundaryTrace<dim, spacedim>::restrict_to_surface(
+    const LinearAlgebra::distributed::Vector<double> &volume_vector,
+    LinearAlgebra::distributed::Vector<double>       &surface_vector)
+  {
+    AssertDimension(surface_vector.locally_owned_size(), buffer.size());
+    scatter.global_to_overlap_start(volume_vector, 0, buffer);
+    scatter.global_to_overlap_finish(volume_vector, buffer);
+    for (unsigned int k = 0; k < buffer.size(); ++k)
+      surface_vector.local_element(k) = buffer[k];
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  BoundaryTrace<dim, spacedim>::add_to_volume(
+    const LinearAlgebra::distributed::Vector<double> &surface_vector,
+    LinearAlgebra::distributed::Vector<double>       &volume_vector)
+  {
+    AssertDimension(surface_vector.locally_owned_size(), buffer.size());
+    for (unsigned int k = 0; k < buffer.size(); ++k)
+      buffer[k] = surface_vector.local_element(k);
+    scatter.overlap_to_global_start(buffer,
+                                    VectorOperation::add,
+                                    0,
+                                    volume_vector);
+    scatter.overlap_to_global_finish(buffer,
+                                     VectorOperation::add,
+                                     volume_vector);
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  BoundaryTrace<dim, spacedim>::memory_consumption() const
+  {
+    return MemoryConsumption::memory_consumption(volume_dofs) +
+           scatter.memory_consumption() + buffer.memory_consumption();
+  }
+
+
+
+  template class BoundaryTrace<NDIM, NDIM>;
+} // namespace fdl
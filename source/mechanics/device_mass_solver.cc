@@ -0,0 +1,424 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/device_mass_solver.h>
+
+#ifdef FDL_ENABLE_DEVICE_MATRIX_FREE
+#  include <deal.II/base/index_set.h>
+#  include <deal.II/base/memory_consumption.h>
+#  include <deal.II/base/quadrature_lib.h>
+#  include <deal.II/base/utilities.h>
+
+#  include <deal.II/dofs/dof_tools.h>
+
+#  include <deal.II/fe/fe_q.h>
+#  include <deal.II/fe/fe_values.h>
+
+#  include <deal.II/lac/affine_constraints.h>
+#  include <deal.II/lac/read_write_vector.h>
+#  include <deal.II/lac/solver_cg.h>
+#  include <deal.II/lac/solver_control.h>
+
+#  include <deal.II/matrix_free/cuda_fe_evaluation.h>
+#  include <deal.II/matrix_free/cuda_matrix_free.h>
+
+#  include <algorithm>
+#  include <functional>
+#  include <utility>
+#endif
+
+namespace fdl
+{
+#ifdef FDL_ENABLE_DEVICE_MATRIX_FREE
+  namespace
+  {
+    using DeviceVector =
+      LinearAlgebra::distributed::Vector<double, MemorySpace::Default>;
+
+    /**
+     * Quadrature point operation of the mass operator.
+     */
+    template <int dim, int fe_degree>
+    class MassQuad
+    {
+    public:
+      static const unsigned int n_q_points =
+        Utilities::pow(fe_degree + 1, dim);
+
+      DEAL_II_HOST_DEVICE void
+      operator()(
+        CUDAWrappers::FEEvaluation<dim, fe_degree, fe_degree + 1, 1, double>
+                 *fe_eval,
+        const int q_point) const
+      {
+        fe_eval->submit_value(fe_eval->get_value(q_point), q_point);
+      }
+    };
+
+    /**
+     * Cell operation of the mass operator.
+     */
+    template <int dim, int fe_degree>
+    class LocalMassOperator
+    {
+    public:
+      static const unsigned int n_dofs_1d    = fe_degree + 1;
+      static const unsigned int n_local_dofs = Utilities::pow(fe_degree + 1,
+                                                              dim);
+      static const unsigned int n_q_points   = Utilities::pow(fe_degree + 1,
+                                                            dim);
+
+      DEAL_II_HOST_DEVICE void
+      operator()(
+        const unsigned int                                          cell,
+        const typename CUDAWrappers::MatrixFree<dim, double>::Data *gpu_data,
+        CUDAWrappers::SharedData<dim, double>                      *shared_data,
+        const double                                               *src,
+        double                                                     *dst) const
+      {
+        (void)cell;
+        CUDAWrappers::FEEvaluation<dim, fe_degree, fe_degree + 1, 1, double>
+          fe_eval(gpu_data, shared_data);
+        fe_eval.read_dof_values(src);
+        fe_eval.evaluate(true, false);
+        fe_eval.apply_for_each_quad_point(MassQuad<dim, fe_degree>());
+        fe_eval.integrate(true, false);
+        fe_eval.distribute_local_to_global(dst);
+      }
+    };
+
+    /**
+     * Set up @p matrix_free for an element of the given degree and return a
+     * function applying the mass operator with it.
+     */
+    template <int dim, int fe_degree>
+    std::function<void(DeviceVector &, const DeviceVector &)>
+    setup_mass_operator(const Mapping<dim>                    &mapping,
+                        const DoFHandler<dim>                 &dof_handler,
+                        const AffineConstraints<double>       &constraints,
+                        CUDAWrappers::MatrixFree<dim, double> &matrix_free)
+    {
+      typename CUDAWrappers::MatrixFree<dim, double>::AdditionalData
+        additional_data;
+      additional_data.mapping_update_flags = update_values | update_JxW_values;
+      matrix_free.reinit(mapping,
+                         dof_handler,
+                         constraints,
+                         QGauss<1>(fe_degree + 1),
+                         additional_data);
+
+      return [&matrix_free](DeviceVector &dst, const DeviceVector &src)
+      {
+        dst = 0.0;
+        matrix_free.cell_loop(LocalMassOperator<dim, fe_degree>(), src, dst);
+        matrix_free.copy_constrained_values(src, dst);
+      };
+    }
+  } // namespace
+
+  template <int dim>
+  struct DeviceMassSolver<dim>::Implementation
+  {
+    Implementation(const DoFHandler<dim> &dof_handler)
+      : scalar_dof_handler(dof_handler.get_triangulation())
+    {}
+
+    /**
+     * DoFHandler of the scalar base element.
+     */
+    DoFHandler<dim> scalar_dof_handler;
+
+    /**
+     * Locally owned DoFs of @p scalar_dof_handler.
+     */
+    IndexSet scalar_owned_dofs;
+
+    /**
+     * Empty constraints required by CUDAWrappers::MatrixFree.
+     */
+    AffineConstraints<double> constraints;
+
+    CUDAWrappers::MatrixFree<dim, double> matrix_free;
+
+    /**
+     * Function applying the mass operator.
+     */
+    std::function<void(DeviceVector &, const DeviceVector &)> apply_mass;
+
+    /**
+     * Inverse of the diagonal of the scalar mass matrix.
+     */
+    DeviceVector inverse_diagonal;
+
+    /**
+     * For each locally owned vector DoF, its component and the index of the
+     * corresponding scalar DoF in @p scalar_owned_dofs.
+     */
+    std::vector<std::pair<unsigned int, types::global_dof_index>>
+      vector_to_scalar;
+  };
+
+  template <int dim>
+  DeviceMassSolver<dim>::DeviceMassSolver(const Mapping<dim>    &mapping,
+                                          const DoFHandler<dim> &dof_handler,
+                                          const Quadrature<dim> &quadrature)
+    : implementation(std::make_unique<Implementation>(dof_handler))
+  {
+    const FiniteElement<dim> &fe = dof_handler.get_fe();
+    AssertThrow(fe.n_base_elements() == 1 && fe.element_multiplicity(0) == dim,
+                ExcFDLNotImplemented());
+    const auto *scalar_fe =
+      dynamic_cast<const FE_Q<dim> *>(&fe.base_element(0));
+    AssertThrow(scalar_fe, ExcFDLNotImplemented());
+    AssertThrow(
+      dof_handler.get_triangulation().all_reference_cells_are_hyper_cube(),
+      ExcFDLNotImplemented());
+    const unsigned int degree = scalar_fe->degree;
+    AssertThrow(quadrature == QGauss<dim>(degree + 1),
+                ExcMessage("The device mass operator only supports Gauss "
+                           "quadrature with degree + 1 points."));
+
+    Implementation &impl = *implementation;
+    impl.scalar_dof_handler.distribute_dofs(*scalar_fe);
+    impl.scalar_owned_dofs = impl.scalar_dof_handler.locally_owned_dofs();
+    impl.constraints.close();
+    switch (degree)
+      {
+        case 1:
+          impl.apply_mass =
+            setup_mass_operator<dim, 1>(mapping,
+                                        impl.scalar_dof_handler,
+                                        impl.constraints,
+                                        impl.matrix_free);
+          break;
+        case 2:
+          impl.apply_mass =
+            setup_mass_operator<dim, 2>(mapping,
+                                        impl.scalar_dof_handler,
+                                        impl.constraints,
+                                        impl.matrix_free);
+          break;
+        case 3:
+          impl.apply_mass =
+            setup_mass_operator<dim, 3>(mapping,
+                                        impl.scalar_dof_handler,
+                                        impl.constraints,
+                                        impl.matrix_free);
+          break;
+        case 4:
+          impl.apply_mass =
+            setup_mass_operator<dim, 4>(mapping,
+                                        impl.scalar_dof_handler,
+                                        impl.constraints,
+                                        impl.matrix_free);
+          break;
+        case 5:
+          impl.apply_mass =
+            setup_mass_operator<dim, 5>(mapping,
+                                        impl.scalar_dof_handler,
+                                        impl.constraints,
+                                        impl.matrix_free);
+          break;
+        default:
+          AssertThrow(false, ExcFDLNotImplemented());
+      }
+
+    // Both DoFHandlers assign the DoFs of each cell to the same processor,
+    // so every locally owned vector DoF corresponds to a locally owned scalar
+    // DoF.
+    const IndexSet &owned_dofs = dof_handler.locally_owned_dofs();
+    impl.vector_to_scalar.resize(owned_dofs.n_elements());
+    std::vector<types::global_dof_index> cell_dofs(fe.n_dofs_per_cell());
+    std::vector<types::global_dof_index> scalar_cell_dofs(
+      scalar_fe->n_dofs_per_cell());
+
+    // Assemble the diagonal on the host while we loop over cells:
+    IndexSet relevant_scalar_dofs;
+    DoFTools::extract_locally_relevant_dofs(impl.scalar_dof_handler,
+                                            relevant_scalar_dofs);
+    LinearAlgebra::distributed::Vector<double> diagonal(
+      impl.scalar_owned_dofs,
+      relevant_scalar_dofs,
+      dof_handler.get_communicator());
+    FEValues<dim>  fe_values(mapping,
+                            *scalar_fe,
+                            quadrature,
+                            update_values | update_JxW_values);
+    Vector<double> cell_diagonal(scalar_fe->n_dofs_per_cell());
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          const typename DoFHandler<dim>::active_cell_iterator scalar_cell(
+            &impl.scalar_dof_handler.get_triangulation(),
+            cell->level(),
+            cell->index(),
+            &impl.scalar_dof_handler);
+          cell->get_dof_indices(cell_dofs);
+          scalar_cell->get_dof_indices(scalar_cell_dofs);
+          for (unsigned int i = 0; i < cell_dofs.size(); ++i)
+            if (owned_dofs.is_element(cell_dofs[i]))
+              {
+                const auto pair = fe.system_to_component_index(i);
+                impl.vector_to_scalar[owned_dofs.index_within_set(
+                  cell_dofs[i])] = {pair.first,
+                                    impl.scalar_owned_dofs.index_within_set(
+                                      scalar_cell_dofs[pair.second])};
+              }
+
+          fe_values.reinit(scalar_cell);
+          cell_diagonal = 0.0;
+          for (unsigned int q = 0; q < quadrature.size(); ++q)
+            for (unsigned int i = 0; i < cell_diagonal.size(); ++i)
+              cell_diagonal[i] += fe_values.shape_value(i, q) *
+                                  fe_values.shape_value(i, q) *
+                                  fe_values.JxW(q);
+          for (unsigned int i = 0; i < cell_diagonal.size(); ++i)
+            diagonal(scalar_cell_dofs[i]) += cell_diagonal[i];
+        }
+    diagonal.compress(VectorOperation::add);
+
+    LinearAlgebra::ReadWriteVector<double> host_diagonal(
+      impl.scalar_owned_dofs);
+    for (unsigned int i = 0; i < diagonal.locally_owned_size(); ++i)
+      host_diagonal.local_element(i) = 1.0 / diagonal.local_element(i);
+    impl.matrix_free.initialize_dof_vector(impl.inverse_diagonal);
+    impl.inverse_diagonal.import_elements(host_diagonal,
+                                          VectorOperation::insert);
+  }
+
+  template <int dim>
+  DeviceMassSolver<dim>::~DeviceMassSolver() = default;
+
+  template <int dim>
+  std::vector<unsigned int>
+  DeviceMassSolver<dim>::solve(
+    const std::vector<LinearAlgebra::distributed::Vector<double> *> &solutions,
+    const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+                      &right_hand_sides,
+    const unsigned int max_iterations,
+    const double       relative_tolerance) const
+  {
+    const Implementation &impl = *implementation;
+    AssertDimension(solutions.size(), right_hand_sides.size());
+
+    // Wrappers with the interfaces expected by SolverCG:
+    struct MassOperator
+    {
+      void
+      vmult(DeviceVector &dst, const DeviceVector &src) const
+      {
+        impl.apply_mass(dst, src);
+      }
+
+      const Implementation &impl;
+    } mass_operator{impl};
+
+    struct JacobiPreconditioner
+    {
+      void
+      vmult(DeviceVector &dst, const DeviceVector &src) const
+      {
+        dst = src;
+        dst.scale(impl.inverse_diagonal);
+      }
+
+      const Implementation &impl;
+    } preconditioner{impl};
+
+    LinearAlgebra::ReadWriteVector<double> host_vector(impl.scalar_owned_dofs);
+    DeviceVector                           device_solution, device_rhs;
+    impl.matrix_free.initialize_dof_vector(device_solution);
+    impl.matrix_free.initialize_dof_vector(device_rhs);
+    // Copy component c of a host vector to the device and vice-versa:
+    auto copy_to_device = [&](const LinearAlgebra::distributed::Vector<double>
+                                              &src,
+                              const unsigned int c,
+                              DeviceVector      &dst)
+    {
+      for (std::size_t i = 0; i < impl.vector_to_scalar.size(); ++i)
+        if (impl.vector_to_scalar[i].first == c)
+          host_vector.local_element(impl.vector_to_scalar[i].second) =
+            src.local_element(i);
+      dst.import_elements(host_vector, VectorOperation::insert);
+    };
+    auto copy_to_host = [&](const DeviceVector                         &src,
+                            const unsigned int                          c,
+                            LinearAlgebra::distributed::Vector<double> &dst)
+    {
+      host_vector.import_elements(src, VectorOperation::insert);
+      for (std::size_t i = 0; i < impl.vector_to_scalar.size(); ++i)
+        if (impl.vector_to_scalar[i].first == c)
+          dst.local_element(i) =
+            host_vector.local_element(impl.vector_to_scalar[i].second);
+    };
+
+    std::vector<unsigned int> iterations(solutions.size());
+    for (std::size_t k = 0; k < solutions.size(); ++k)
+      for (unsigned int c = 0; c < dim; ++c)
+        {
+          copy_to_device(*right_hand_sides[k], c, device_rhs);
+          copy_to_device(*solutions[k], c, device_solution);
+          SolverControl control(max_iterations,
+                                relative_tolerance * device_rhs.l2_norm());
+          SolverCG<DeviceVector> solver(control);
+          solver.solve(mass_operator,
+                       device_solution,
+                       device_rhs,
+                       preconditioner);
+          iterations[k] = std::max(iterations[k], control.last_step());
+          copy_to_host(device_solution, c, *solutions[k]);
+        }
+
+    return iterations;
+  }
+
+  template <int dim>
+  std::size_t
+  DeviceMassSolver<dim>::memory_consumption() const
+  {
+    return implementation->scalar_dof_handler.memory_consumption() +
+           implementation->scalar_owned_dofs.memory_consumption() +
+           MemoryConsumption::memory_consumption(
+             implementation->vector_to_scalar);
+  }
+#else
+  template <int dim>
+  struct DeviceMassSolver<dim>::Implementation
+  {};
+
+  template <int dim>
+  DeviceMassSolver<dim>::DeviceMassSolver(const Mapping<dim> &,
+                                          const DoFHandler<dim> &,
+                                          const Quadrature<dim> &)
+  {
+    AssertThrow(false,
+                ExcMessage(
+                  "Only available with FDL_ENABLE_DEVICE_MATRIX_FREE"));
+  }
+
+  template <int dim>
+  DeviceMassSolver<dim>::~DeviceMassSolver() = default;
+
+  template <int dim>
+  std::vector<unsigned int>
+  DeviceMassSolver<dim>::solve(
+    const std::vector<LinearAlgebra::distributed::Vector<double> *> &,
+    const std::vector<const LinearAlgebra::distributed::Vector<double> *> &,
+    const unsigned int,
+    const double) const
+  {
+    AssertThrow(false,
+                ExcMessage(
+                  "Only available with FDL_ENABLE_DEVICE_MATRIX_FREE"));
+    return {};
+  }
+
+  template <int dim>
+  std::size_t
+  DeviceMassSolver<dim>::memory_consumption() const
+  {
+    return 0;
+  }
+#endif
+
+  template class DeviceMassSolver<NDIM>;
+} // namespace fdl
@@ -0,0 +1,136 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/embedded_points.h>
+
+#include <deal.II/base/memory_consumption.h>
+
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/grid_tools_cache.h>
+
+#include <string>
+
+namespace fdl
+{
+  template <int dim, int spacedim>
+  EmbeddedPoints<dim, spacedim>::EmbeddedPoints(
+    const DoFHandler<dim, spacedim>    &dof_handler,
+    const Mapping<dim, spacedim>       &mapping,
+    const std::vector<Point<spacedim>> &reference_points)
+  {
+    const Triangulation<dim, spacedim> &tria = dof_handler.get_triangulation();
+    const FiniteElement<dim, spacedim> &fe   = dof_handler.get_fe();
+    AssertThrow(fe.n_components() == spacedim,
+                ExcMessage("The finite element should have spacedim "
+                           "components."));
+    AssertThrow(fe.is_primitive(),
+                ExcMessage("The finite element should be primitive."));
+    n_dofs_per_cell = fe.n_dofs_per_cell();
+    for (unsigned int i = 0; i < n_dofs_per_cell; ++i)
+      components.push_back(fe.system_to_component_index(i).first);
+
+    // Since the Triangulation is shared every processor finds the same host
+    // cell for each point. Consecutive points are typically close (e.g.,
+    // along a fiber) so the previous host cell is used as a hint.
+    GridTools::Cache<dim, spacedim> cache(tria, mapping);
+    typename Triangulation<dim, spacedim>::active_cell_iterator cell_hint;
+    std::vector<types::global_dof_index> cell_dofs(n_dofs_per_cell);
+    for (unsigned int point_n = 0; point_n < reference_points.size();
+         ++point_n)
+      {
+        const auto cell_and_point =
+          GridTools::find_active_cell_around_point(cache,
+                                                   reference_points[point_n],
+                                                   cell_hint);
+        AssertThrow(cell_and_point.first.state() == IteratorState::valid,
+                    ExcMessage("Point " + std::to_string(point_n) +
+                               " is not inside the part."));
+        cell_hint = cell_and_point.first;
+        if (!cell_and_point.first->is_locally_owned())
+          continue;
+
+        const typename DoFHandler<dim, spacedim>::active_cell_iterator cell(
+          &tria,
+          cell_and_point.first->level(),
+          cell_and_point.first->index(),
+          &dof_handler);
+        cell->get_dof_indices(cell_dofs);
+        point_indices.push_back(point_n);
+        dof_indices.insert(dof_indices.end(),
+                           cell_dofs.begin(),
+                           cell_dofs.end());
+        for (unsigned int i = 0; i < n_dofs_per_cell; ++i)
+          shape_values.push_back(
+            fe.shape_value_component(i, cell_and_point.second, components[i]));
+      }
+  }
+
+  template <int dim, int spacedim>
+  std::size_t
+  EmbeddedPoints<dim, spacedim>::n_locally_owned_points() const
+  {
+    return point_indices.size();
+  }
+
+  template <int dim, int spacedim>
+  const std::vector<unsigned int> &
+  EmbeddedPoints<dim, spacedim>::get_point_indices() const
+  {
+    return point_indices;
+  }
+
+  template <int dim, int spacedim>
+  std::vector<Tensor<1, spacedim>>
+  EmbeddedPoints<dim, spacedim>::compute_values(
+    const LinearAlgebra::distributed::Vector<double> &dof_values) const
+  {
+    Assert(dof_values.has_ghost_elements(),
+           ExcMessage("The DoF values should have ghost values."));
+    std::vector<Tensor<1, spacedim>> values(n_locally_owned_points());
+    for (std::size_t point_n = 0; point_n < values.size(); ++point_n)
+      {
+        const std::size_t offset = point_n * n_dofs_per_cell;
+        for (unsigned int i = 0; i < n_dofs_per_cell; ++i)
+          values[point_n][components[i]] +=
+            shape_values[offset + i] * dof_values(dof_indices[offset + i]);
+      }
+    return values;
+  }
+
+  template <int dim, int spacedim>
+  std::vector<Point<spacedim>>
+  EmbeddedPoints<dim, spacedim>::compute_positions(
+    const LinearAlgebra::distributed::Vector<double> &position) const
+  {
+    const std::vector<Tensor<1, spacedim>> values = compute_values(position);
+    return std::vector<Point<spacedim>>(values.begin(), values.end());
+  }
+
+  template <int dim, int spacedim>
+  void
+  EmbeddedPoints<dim, spacedim>::add_load_vector(
+    const std::vector<Tensor<1, spacedim>>     &forces,
+    LinearAlgebra::distributed::Vector<double> &force_rhs) const
+  {
+    AssertDimension(forces.size(), n_locally_owned_points());
+    for (std::size_t point_n = 0; point_n < forces.size(); ++point_n)
+      {
+        const std::size_t offset = point_n * n_dofs_per_cell;
+        for (unsigned int i = 0; i < n_dofs_per_cell; ++i)
+          force_rhs(dof_indices[offset + i]) +=
+            shape_values[offset + i] * forces[point_n][components[i]];
+      }
+  }
+
+  template <int dim, int spacedim>
+  std::size_t
+  EmbeddedPoints<dim, spacedim>::memory_consumption() const
+  {
+    return MemoryConsumption::memory_consumption(components) +
+           MemoryConsumption::memory_consumption(point_indices) +
+           MemoryConsumption::memory_consumption(dof_indices) +
+           MemoryConsumption::memory_consumption(shape_values);
+  }
+
+  template class EmbeddedPoints<NDIM - 1, NDIM>;
+  template class EmbeddedPoints<NDIM, NDIM>;
+} // namespace fdl
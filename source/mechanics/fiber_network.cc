@@ -1,10 +1,15 @@
 #include <fiddle/mechanics/fiber_network.h>
 
 #include <deal.II/base/array_view.h>
+#include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/table.h>
 
+#include <deal.II/dofs/dof_tools.h>
+
 #include <deal.II/grid/tria.h>
 
+#include <cmath>
+
 namespace fdl
 {
   using namespace dealii;
@@ -12,14 +17,77 @@ namespace fdl
   template <int dim, int spacedim>
   FiberNetwork<dim, spacedim>::FiberNetwork(
     const Triangulation<dim, spacedim>                  &tria,
-    const std::vector<std::vector<Tensor<1, spacedim>>> &fibers)
+    const std::vector<std::vector<Tensor<1, spacedim>>> &fibers,
+    const bool                                           use_single_precision)
     : tria(&tria)
+    , n_fiber_fields(fibers.size())
+    , single_precision(use_single_precision)
+  {
+    const unsigned int n_locally_owned_cells = setup_cell_indices();
+    for (const auto &fiber_vec : fibers)
+      AssertThrow(n_locally_owned_cells == fiber_vec.size(),
+                  ExcMessage("Not enough tensors in this vector"));
+
+    if (single_precision)
+      {
+        single_precision_fibers.reinit(n_locally_owned_cells, n_fiber_fields);
+        for (unsigned int j = 0; j < n_fiber_fields; ++j)
+          for (unsigned int i = 0; i < n_locally_owned_cells; ++i)
+            single_precision_fibers(i, j) =
+              Tensor<1, spacedim, float>(fibers[j][i]);
+      }
+    else
+      {
+        this->fibers.reinit(n_locally_owned_cells, n_fiber_fields);
+        for (unsigned int j = 0; j < n_fiber_fields; ++j)
+          for (unsigned int i = 0; i < n_locally_owned_cells; ++i)
+            this->fibers(i, j) = fibers[j][i];
+      }
+  }
+
+  template <int dim, int spacedim>
+  FiberNetwork<dim, spacedim>::FiberNetwork(
+    const Mapping<dim, spacedim>                     &mapping,
+    const DoFHandler<dim, spacedim>                  &dof_handler,
+    const LinearAlgebra::distributed::Vector<double> &transmural_coordinate,
+    const Tensor<1, spacedim>                        &longitudinal_axis,
+    const double                                      endocardial_angle,
+    const double                                      epicardial_angle)
+    : tria(&dof_handler.get_triangulation())
+    , n_fiber_fields(spacedim)
+    , single_precision(false)
+    , mapping(&mapping)
+    , dof_handler(&dof_handler)
+    , longitudinal_axis(longitudinal_axis)
+    , endocardial_angle(endocardial_angle)
+    , epicardial_angle(epicardial_angle)
+  {
+    AssertThrow(dof_handler.get_fe().n_components() == 1,
+                ExcMessage("The transmural coordinate should be a scalar."));
+    AssertThrow(spacedim == 2 || longitudinal_axis.norm() > 0.0,
+                ExcMessage("The longitudinal axis should be nonzero."));
+    setup_cell_indices();
+
+    // We need the values on all DoFs of locally owned cells
+    IndexSet locally_relevant_dofs;
+    DoFTools::extract_locally_relevant_dofs(dof_handler, locally_relevant_dofs);
+    this->transmural_coordinate.reinit(dof_handler.locally_owned_dofs(),
+                                       locally_relevant_dofs,
+                                       tria->get_communicator());
+    this->transmural_coordinate.copy_locally_owned_data_from(
+      transmural_coordinate);
+    this->transmural_coordinate.update_ghost_values();
+  }
+
+  template <int dim, int spacedim>
+  unsigned int
+  FiberNetwork<dim, spacedim>::setup_cell_indices()
   {
     local_processor_min_cell_index =
       std::numeric_limits<types::global_cell_index>::max();
     unsigned int n_locally_owned_cells = 0;
 
-    for (const auto &cell : tria.active_cell_iterators())
+    for (const auto &cell : tria->active_cell_iterators())
       if (cell->is_locally_owned())
         {
           local_processor_min_cell_index =
@@ -28,15 +96,105 @@ namespace fdl
           ++n_locally_owned_cells;
         }
 
-    for (const auto &fiber_vec : fibers)
-      AssertThrow(n_locally_owned_cells == fiber_vec.size(),
-                  ExcMessage("Not enough tensors in this vector"));
+    return n_locally_owned_cells;
+  }
+
+  template <int dim, int spacedim>
+  const std::array<Tensor<1, spacedim>, spacedim> &
+  FiberNetwork<dim, spacedim>::get_rule_based_fibers(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
+    const
+  {
+    RuleScratchData               &scratch    = rule_scratch_data.get();
+    const types::global_cell_index cell_index = get_cell_index(cell);
+    // consumers typically request several fibers of the same cell in a row
+    if (scratch.cell_index == cell_index)
+      return scratch.fibers;
+
+    if (scratch.fe_values == nullptr)
+      {
+        const FiniteElement<dim, spacedim> &fe = dof_handler->get_fe();
+        scratch.fe_values = std::make_shared<FEValues<dim, spacedim>>(
+          *mapping,
+          fe,
+          Quadrature<dim>(fe.reference_cell().template barycenter<dim>()),
+          update_values | update_gradients);
+        scratch.values.resize(1);
+        scratch.gradients.resize(1);
+      }
+    const typename DoFHandler<dim, spacedim>::active_cell_iterator dof_cell(
+      &dof_handler->get_triangulation(),
+      cell->level(),
+      cell->index(),
+      &*dof_handler);
+    scratch.fe_values->reinit(dof_cell);
+    scratch.fe_values->get_function_values(transmural_coordinate,
+                                           scratch.values);
+    scratch.fe_values->get_function_gradients(transmural_coordinate,
+                                              scratch.gradients);
+
+    const double t     = scratch.values[0];
+    const double alpha = (1.0 - t) * endocardial_angle + t * epicardial_angle;
+    Assert(scratch.gradients[0].norm() > 0.0,
+           ExcMessage("The transmural coordinate should have a nonzero "
+                      "gradient at every cell center."));
+    const Tensor<1, spacedim> e_t =
+      scratch.gradients[0] / scratch.gradients[0].norm();
+    if constexpr (spacedim == 2)
+      {
+        Tensor<1, spacedim> e_c;
+        e_c[0]            = -e_t[1];
+        e_c[1]            = e_t[0];
+        scratch.fibers[0] = std::cos(alpha) * e_c - std::sin(alpha) * e_t;
+        scratch.fibers[1] = std::cos(alpha) * e_t + std::sin(alpha) * e_c;
+      }
+    else
+      {
+        Tensor<1, spacedim> e_l =
+          longitudinal_axis - (longitudinal_axis * e_t) * e_t;
+        Assert(e_l.norm() > 0.0,
+               ExcMessage("The longitudinal axis should not be parallel to "
+                          "the gradient of the transmural coordinate."));
+        e_l /= e_l.norm();
+        const Tensor<1, spacedim> e_c = cross_product_3d(e_l, e_t);
+        scratch.fibers[0] = std::cos(alpha) * e_c + std::sin(alpha) * e_l;
+        scratch.fibers[1] = e_t;
+        scratch.fibers[2] = cross_product_3d(scratch.fibers[0], e_t);
+      }
+    scratch.cell_index = cell_index;
+
+    return scratch.fibers;
+  }
 
-    const auto n_fiber_networks = fibers.size();
-    this->fibers.reinit(n_locally_owned_cells, n_fiber_networks);
-    for (unsigned int j = 0; j < n_fiber_networks; ++j)
-      for (unsigned int i = 0; i < n_locally_owned_cells; ++i)
-        this->fibers(i, j) = fibers[j][i];
+  template <int dim, int spacedim>
+  void
+  FiberNetwork<dim, spacedim>::setup_structural_tensors()
+  {
+    // clear the old values so that get_structural_tensor() computes the new
+    // ones from the fibers
+    structural_tensors.reinit(0, 0);
+
+    Table<2, SymmetricTensor<2, spacedim>> new_structural_tensors(
+      tria->n_locally_owned_active_cells(),
+      n_fiber_fields * (n_fiber_fields + 1) / 2);
+    for (const auto &cell : tria->active_cell_iterators())
+      if (cell->is_locally_owned())
+        for (unsigned int j = 0; j < n_fiber_fields; ++j)
+          for (unsigned int i = 0; i <= j; ++i)
+            new_structural_tensors(get_cell_index(cell), get_pair_index(i, j)) =
+              get_structural_tensor(cell, i, j);
+
+    structural_tensors.swap(new_structural_tensors);
+  }
+
+  template <int dim, int spacedim>
+  std::size_t
+  FiberNetwork<dim, spacedim>::memory_consumption() const
+  {
+    return MemoryConsumption::memory_consumption(fibers) +
+           MemoryConsumption::memory_consumption(single_precision_fibers) +
+           MemoryConsumption::memory_consumption(structural_tensors) +
+           transmural_coordinate.memory_consumption();
   }
 
   template class FiberNetwork<NDIM - 1, NDIM>;
@@ -2,14 +2,19 @@
 
 #include <fiddle/mechanics/fiber_network.h>
 #include <fiddle/mechanics/force_contribution_lib.h>
+#include <fiddle/mechanics/material_laws.h>
 
 #include <deal.II/dofs/dof_tools.h>
 
+#include <deal.II/fe/fe_values.h>
+
 #include <deal.II/lac/la_parallel_vector.h>
 
 #include <deal.II/numerics/vector_tools_interpolate.h>
 
 #include <algorithm>
+#include <map>
+#include <utility>
 
 namespace fdl
 {
@@ -54,6 +59,39 @@ namespace fdl
 
       return result;
     }
+
+    /**
+     * Shared implementation of compute_vectorized_linearized_stress() for the
+     * stresses which are defined by a law in MaterialLaws.
+     */
+    template <int dim, int spacedim, typename Law>
+    void
+    compute_law_linearized_stress(
+      const Law                                       &law,
+      const std::vector<types::material_id>           &material_ids,
+      const VectorizedMechanicsValues<dim, spacedim> &m_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      const ArrayView<const Tensor<2, spacedim, VectorizedArray<double>>> &dFF,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &dstresses)
+    {
+      if (material_ids.size() > 0 &&
+          !std::binary_search(material_ids.begin(),
+                              material_ids.end(),
+                              cell->material_id()))
+        {
+          for (auto &dstress : dstresses)
+            dstress = Tensor<2, spacedim, VectorizedArray<double>>();
+        }
+      else
+        {
+          const auto cell_data =
+            law.template get_cell_data<VectorizedArray<double>>(cell);
+          for (unsigned int qp_n = 0; qp_n < dstresses.size(); ++qp_n)
+            dstresses[qp_n] =
+              law.template get_stress_derivative<VectorizedArray<double>>(
+                m_values, cell_data, qp_n, dFF[qp_n]);
+        }
+    }
   } // namespace
 
   //
@@ -94,6 +132,8 @@ namespace fdl
                       "DoFHandler attached to the force object."));
     this->reference_position = reference_position;
     this->reference_position.update_ghost_values();
+    if (current_position != nullptr)
+      setup_scaled_displacement(*current_position);
   }
 
   template <int dim, int spacedim, typename Number>
@@ -127,6 +167,21 @@ namespace fdl
     const LinearAlgebra::distributed::Vector<double> & /*velocity*/)
   {
     current_position = &position;
+    if (dof_handler != nullptr)
+      setup_scaled_displacement(position);
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  SpringForceBase<dim, spacedim, Number>::setup_scaled_displacement(
+    const LinearAlgebra::distributed::Vector<double> &position)
+  {
+    if (!scaled_displacement.partitioners_are_compatible(
+          *reference_position.get_partitioner()))
+      scaled_displacement.reinit(reference_position.get_partitioner());
+    scaled_displacement.equ(spring_constant, reference_position);
+    scaled_displacement.add(-spring_constant, position);
+    scaled_displacement.update_ghost_values();
   }
 
   template <int dim, int spacedim, typename Number>
@@ -220,22 +275,22 @@ namespace fdl
                 cell->index(),
                 &*this->dof_handler);
 
-            this->scratch_cell_dofs.resize(fe_values.dofs_per_cell);
-            dof_cell->get_dof_indices(this->scratch_cell_dofs);
-            this->scratch_dof_values.resize(fe_values.dofs_per_cell);
-            this->scratch_qp_values.resize(fe_values.n_quadrature_points);
+            // compute_force() may be called concurrently on different cells
+            auto &cell_dofs  = this->scratch_cell_dofs.get();
+            auto &dof_values = this->scratch_dof_values.get();
+            auto &qp_values  = this->scratch_qp_values.get();
+
+            cell_dofs.resize(fe_values.dofs_per_cell);
+            dof_cell->get_dof_indices(cell_dofs);
+            dof_values.resize(fe_values.dofs_per_cell);
+            qp_values.resize(fe_values.n_quadrature_points);
 
             auto &extractor = fe_values[FEValuesExtractors::Vector(0)];
-            for (unsigned int i = 0; i < this->scratch_cell_dofs.size(); ++i)
-              this->scratch_dof_values[i] =
-                this->spring_constant *
-                (this->reference_position[this->scratch_cell_dofs[i]] -
-                 (*this->current_position)[this->scratch_cell_dofs[i]]);
+            for (unsigned int i = 0; i < cell_dofs.size(); ++i)
+              dof_values[i] = this->scaled_displacement[cell_dofs[i]];
             extractor.get_function_values_from_local_dof_values(
-              this->scratch_dof_values, this->scratch_qp_values);
-            std::copy(this->scratch_qp_values.begin(),
-                      this->scratch_qp_values.end(),
-                      forces.begin());
+              dof_values, qp_values);
+            std::copy(qp_values.begin(), qp_values.end(), forces.begin());
           }
       }
   }
@@ -247,6 +302,16 @@ namespace fdl
     return true;
   }
 
+  template <int dim, int spacedim, typename Number>
+  const LinearAlgebra::distributed::Vector<double> *
+  SpringForce<dim, spacedim, Number>::get_volume_force_dof_values() const
+  {
+    if (this->dof_handler == nullptr || this->current_position == nullptr ||
+        this->material_ids.size() > 0)
+      return nullptr;
+    return &this->scaled_displacement;
+  }
+
   //
   // BoundarySpringForce
   //
@@ -297,6 +362,13 @@ namespace fdl
     return true;
   }
 
+  template <int dim, int spacedim, typename Number>
+  std::vector<types::boundary_id>
+  BoundarySpringForce<dim, spacedim, Number>::get_boundary_ids() const
+  {
+    return boundary_ids;
+  }
+
   template <int dim, int spacedim, typename Number>
   void
   BoundarySpringForce<dim, spacedim, Number>::compute_boundary_force(
@@ -338,26 +410,231 @@ namespace fdl
                 cell->index(),
                 &*this->dof_handler);
 
-            this->scratch_cell_dofs.resize(fe_values.dofs_per_cell);
-            dof_cell->get_dof_indices(this->scratch_cell_dofs);
-            this->scratch_dof_values.resize(fe_values.dofs_per_cell);
-            this->scratch_qp_values.resize(fe_values.n_quadrature_points);
+            // compute_force() may be called concurrently on different cells
+            auto &cell_dofs  = this->scratch_cell_dofs.get();
+            auto &dof_values = this->scratch_dof_values.get();
+            auto &qp_values  = this->scratch_qp_values.get();
+
+            cell_dofs.resize(fe_values.dofs_per_cell);
+            dof_cell->get_dof_indices(cell_dofs);
+            dof_values.resize(fe_values.dofs_per_cell);
+            qp_values.resize(fe_values.n_quadrature_points);
 
             auto &extractor = fe_values[FEValuesExtractors::Vector(0)];
-            for (unsigned int i = 0; i < this->scratch_cell_dofs.size(); ++i)
-              this->scratch_dof_values[i] =
-                this->spring_constant *
-                (this->reference_position[this->scratch_cell_dofs[i]] -
-                 (*this->current_position)[this->scratch_cell_dofs[i]]);
+            for (unsigned int i = 0; i < cell_dofs.size(); ++i)
+              dof_values[i] = this->scaled_displacement[cell_dofs[i]];
             extractor.get_function_values_from_local_dof_values(
-              this->scratch_dof_values, this->scratch_qp_values);
-            std::copy(this->scratch_qp_values.begin(),
-                      this->scratch_qp_values.end(),
-                      forces.begin());
+              dof_values, qp_values);
+            std::copy(qp_values.begin(), qp_values.end(), forces.begin());
           }
       }
   }
 
+  //
+  // NodalSpringForce
+  //
+
+  template <int dim, int spacedim, typename Number>
+  NodalSpringForce<dim, spacedim, Number>::NodalSpringForce(
+    const Quadrature<dim>              &quad,
+    const double                        spring_constant,
+    const DoFHandler<dim, spacedim>    &dof_handler,
+    const Mapping<dim, spacedim>       &mapping,
+    const std::vector<unsigned int>    &nodes,
+    const std::vector<Point<spacedim>> &reference_points)
+    : ForceContribution<dim, spacedim, double>(quad)
+    , spring_constant(spring_constant)
+  {
+    const Triangulation<dim, spacedim> &tria = dof_handler.get_triangulation();
+    const FiniteElement<dim, spacedim> &fe   = dof_handler.get_fe();
+    AssertThrow(reference_points.size() == 0 ||
+                  reference_points.size() == nodes.size(),
+                ExcMessage("There should be one reference point per node."));
+    AssertThrow(fe.n_components() == spacedim &&
+                  fe.n_dofs_per_vertex() == spacedim,
+                ExcMessage("The finite element should have spacedim "
+                           "components and one DoF per component at each "
+                           "vertex."));
+
+    // Position of each vertex in nodes, if present
+    constexpr auto invalid_node = numbers::invalid_unsigned_int;
+    std::vector<unsigned int> node_n(tria.n_vertices(), invalid_node);
+    for (unsigned int n = 0; n < nodes.size(); ++n)
+      {
+        AssertIndexRange(nodes[n], tria.n_vertices());
+        node_n[nodes[n]] = n;
+      }
+
+    // Every cell adjacent to a locally owned DoF is either locally owned or
+    // a ghost, so this computes the complete lumped masses of those DoFs.
+    // Keys are DoFs and values are reference positions and lumped masses.
+    const IndexSet &locally_owned_dofs = dof_handler.locally_owned_dofs();
+    std::map<types::global_dof_index, std::pair<double, double>> dof_data;
+    FEValues<dim, spacedim> fe_values(mapping,
+                                      fe,
+                                      quad,
+                                      update_values | update_JxW_values);
+    std::vector<types::global_dof_index> cell_dofs(fe.n_dofs_per_cell());
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      {
+        if (cell->is_artificial())
+          continue;
+        bool fe_values_initialized = false;
+        for (const unsigned int v : cell->vertex_indices())
+          {
+            const unsigned int n = node_n[cell->vertex_index(v)];
+            if (n == invalid_node)
+              continue;
+            if (!fe_values_initialized)
+              {
+                fe_values.reinit(cell);
+                cell->get_dof_indices(cell_dofs);
+                fe_values_initialized = true;
+              }
+            // vertex DoFs are always numbered first
+            for (unsigned int i = v * spacedim; i < (v + 1) * spacedim; ++i)
+              {
+                if (!locally_owned_dofs.is_element(cell_dofs[i]))
+                  continue;
+                const unsigned int c = fe.system_to_component_index(i).first;
+                double             mass = 0.0;
+                for (unsigned int q = 0; q < quad.size(); ++q)
+                  mass += fe_values.shape_value_component(i, q, c) *
+                          fe_values.JxW(q);
+                auto &data = dof_data[cell_dofs[i]];
+                data.first = reference_points.size() > 0 ?
+                               reference_points[n][c] :
+                               tria.get_vertices()[nodes[n]][c];
+                data.second += mass;
+              }
+          }
+      }
+
+    dofs.reserve(dof_data.size());
+    reference_values.reserve(dof_data.size());
+    scaled_masses.reserve(dof_data.size());
+    for (const auto &pair : dof_data)
+      {
+        AssertThrow(pair.second.second > 0.0,
+                    ExcMessage("The lumped masses of the nodes should be "
+                               "positive."));
+        dofs.push_back(pair.first);
+        reference_values.push_back(pair.second.first);
+        scaled_masses.push_back(spring_constant * pair.second.second);
+      }
+  }
+
+  template <int dim, int spacedim, typename Number>
+  MechanicsUpdateFlags
+  NodalSpringForce<dim, spacedim, Number>::get_mechanics_update_flags() const
+  {
+    return MechanicsUpdateFlags::update_nothing;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  bool
+  NodalSpringForce<dim, spacedim, Number>::is_volume_force() const
+  {
+    return true;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  bool
+  NodalSpringForce<dim, spacedim, Number>::is_nodal_force() const
+  {
+    return true;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  NodalSpringForce<dim, spacedim, Number>::add_nodal_load_vector(
+    const double /*time*/,
+    const LinearAlgebra::distributed::Vector<double> &position,
+    const LinearAlgebra::distributed::Vector<double> & /*velocity*/,
+    LinearAlgebra::distributed::Vector<double> &force_rhs) const
+  {
+    for (std::size_t k = 0; k < dofs.size(); ++k)
+      force_rhs(dofs[k]) +=
+        scaled_masses[k] * (reference_values[k] - position(dofs[k]));
+  }
+
+  template <int dim, int spacedim, typename Number>
+  const std::vector<types::global_dof_index> &
+  NodalSpringForce<dim, spacedim, Number>::get_dofs() const
+  {
+    return dofs;
+  }
+
+  //
+  // EmbeddedPointSpringForce
+  //
+
+  template <int dim, int spacedim, typename Number>
+  EmbeddedPointSpringForce<dim, spacedim, Number>::EmbeddedPointSpringForce(
+    const Quadrature<dim>              &quad,
+    const double                        spring_constant,
+    const DoFHandler<dim, spacedim>    &dof_handler,
+    const Mapping<dim, spacedim>       &mapping,
+    const std::vector<Point<spacedim>> &reference_points,
+    const std::vector<Point<spacedim>> &target_points)
+    : ForceContribution<dim, spacedim, double>(quad)
+    , spring_constant(spring_constant)
+    , embedded_points(dof_handler, mapping, reference_points)
+  {
+    AssertThrow(target_points.size() == 0 ||
+                  target_points.size() == reference_points.size(),
+                ExcMessage("There should be one target point per point."));
+    const std::vector<Point<spacedim>> &targets =
+      target_points.size() == 0 ? reference_points : target_points;
+    for (const unsigned int point_n : embedded_points.get_point_indices())
+      this->target_points.push_back(targets[point_n]);
+  }
+
+  template <int dim, int spacedim, typename Number>
+  MechanicsUpdateFlags
+  EmbeddedPointSpringForce<dim, spacedim, Number>::get_mechanics_update_flags()
+    const
+  {
+    return MechanicsUpdateFlags::update_nothing;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  bool
+  EmbeddedPointSpringForce<dim, spacedim, Number>::is_volume_force() const
+  {
+    return true;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  bool
+  EmbeddedPointSpringForce<dim, spacedim, Number>::is_nodal_force() const
+  {
+    return true;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  EmbeddedPointSpringForce<dim, spacedim, Number>::add_nodal_load_vector(
+    const double /*time*/,
+    const LinearAlgebra::distributed::Vector<double> &position,
+    const LinearAlgebra::distributed::Vector<double> & /*velocity*/,
+    LinearAlgebra::distributed::Vector<double> &force_rhs) const
+  {
+    const std::vector<Point<spacedim>> positions =
+      embedded_points.compute_positions(position);
+    std::vector<Tensor<1, spacedim>> forces(positions.size());
+    for (std::size_t k = 0; k < forces.size(); ++k)
+      forces[k] = spring_constant * (target_points[k] - positions[k]);
+    embedded_points.add_load_vector(forces, force_rhs);
+  }
+
+  template <int dim, int spacedim, typename Number>
+  const EmbeddedPoints<dim, spacedim> &
+  EmbeddedPointSpringForce<dim, spacedim, Number>::get_embedded_points() const
+  {
+    return embedded_points;
+  }
+
   //
   // DampingForce
   //
@@ -416,6 +693,21 @@ namespace fdl
       }
   }
 
+  template <int dim, int spacedim, typename Number>
+  bool
+  DampingForce<dim, spacedim, Number>::is_mass_proportional() const
+  {
+    return material_ids.size() == 0;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  std::pair<double, double>
+  DampingForce<dim, spacedim, Number>::get_mass_proportional_coefficients(
+    const double /*time*/) const
+  {
+    return {0.0, -damping_constant};
+  }
+
   //
   // OrthogonalLinearLoadForce
   //
@@ -447,6 +739,13 @@ namespace fdl
     return true;
   }
 
+  template <int dim, int spacedim, typename Number>
+  std::vector<types::boundary_id>
+  OrthogonalLinearLoadForce<dim, spacedim, Number>::get_boundary_ids() const
+  {
+    return boundary_ids;
+  }
+
   template <int dim, int spacedim, typename Number>
   void
   OrthogonalLinearLoadForce<dim, spacedim, Number>::compute_boundary_force(
@@ -557,6 +856,13 @@ namespace fdl
     return true;
   }
 
+  template <int dim, int spacedim, typename Number>
+  std::vector<types::boundary_id>
+  OrthogonalSpringDashpotForce<dim, spacedim, Number>::get_boundary_ids() const
+  {
+    return boundary_ids;
+  }
+
   template <int dim, int spacedim, typename Number>
   void
   OrthogonalSpringDashpotForce<dim, spacedim, Number>::compute_boundary_force(
@@ -602,32 +908,32 @@ namespace fdl
                 cell->index(),
                 &*this->dof_handler);
 
-            this->scratch_cell_dofs.resize(fe_values.dofs_per_cell);
-            dof_cell->get_dof_indices(this->scratch_cell_dofs);
-            this->scratch_dof_values.resize(fe_values.dofs_per_cell);
-            this->scratch_qp_values.resize(fe_values.n_quadrature_points);
+            // compute_force() may be called concurrently on different cells
+            auto &cell_dofs  = this->scratch_cell_dofs.get();
+            auto &dof_values = this->scratch_dof_values.get();
+            auto &qp_values  = this->scratch_qp_values.get();
+
+            cell_dofs.resize(fe_values.dofs_per_cell);
+            dof_cell->get_dof_indices(cell_dofs);
+            dof_values.resize(fe_values.dofs_per_cell);
+            qp_values.resize(fe_values.n_quadrature_points);
 
             auto &extractor = fe_values[FEValuesExtractors::Vector(0)];
 
-            for (unsigned int i = 0; i < this->scratch_cell_dofs.size(); ++i)
-              this->scratch_dof_values[i] =
-                this->spring_constant *
-                (this->reference_position[this->scratch_cell_dofs[i]] -
-                 (*this->current_position)[this->scratch_cell_dofs[i]]);
+            for (unsigned int i = 0; i < cell_dofs.size(); ++i)
+              dof_values[i] = this->scaled_displacement[cell_dofs[i]];
 
             extractor.get_function_values_from_local_dof_values(
-              this->scratch_dof_values, this->scratch_qp_values);
+              dof_values, qp_values);
 
-            for (unsigned int i = 0; i < this->scratch_qp_values.size(); ++i)
-              this->scratch_qp_values[i] =
+            for (unsigned int i = 0; i < qp_values.size(); ++i)
+              qp_values[i] =
                 m_values.get_deformed_normal_vectors()[i] *
-                (this->scratch_qp_values[i] -
+                (qp_values[i] -
                  this->damping_constant * m_values.get_velocity_values()[i]) *
                 m_values.get_deformed_normal_vectors()[i];
 
-            std::copy(this->scratch_qp_values.begin(),
-                      this->scratch_qp_values.end(),
-                      forces.begin());
+            std::copy(qp_values.begin(), qp_values.end(), forces.begin());
           }
       }
   }
@@ -651,10 +957,8 @@ namespace fdl
   ModifiedNeoHookeanStress<dim, spacedim, Number>::get_mechanics_update_flags()
     const
   {
-    return MechanicsUpdateFlags::update_n23_det_FF |
-           MechanicsUpdateFlags::update_FF |
-           MechanicsUpdateFlags::update_FF_inv_T |
-           MechanicsUpdateFlags::update_first_invariant;
+    return MaterialLaws::ModifiedNeoHookean<dim, spacedim>::
+      get_mechanics_update_flags();
   }
 
   template <int dim, int spacedim, typename Number>
@@ -671,6 +975,60 @@ namespace fdl
     const MechanicsValues<dim, spacedim>                              &m_values,
     const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
     ArrayView<Tensor<2, spacedim, Number>> &stresses) const
+  {
+    do_compute_stress(m_values, cell, stresses);
+  }
+
+  template <int dim, int spacedim, typename Number>
+  bool
+  ModifiedNeoHookeanStress<dim, spacedim, Number>::supports_vectorized_stress()
+    const
+  {
+    return true;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  ModifiedNeoHookeanStress<dim, spacedim, Number>::compute_vectorized_stress(
+    const double /*time*/,
+    const VectorizedMechanicsValues<dim, spacedim>                    &m_values,
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &stresses) const
+  {
+    do_compute_stress(m_values, cell, stresses);
+  }
+
+  template <int dim, int spacedim, typename Number>
+  bool
+  ModifiedNeoHookeanStress<dim, spacedim, Number>::
+    supports_stress_linearization() const
+  {
+    return true;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  ModifiedNeoHookeanStress<dim, spacedim, Number>::
+    compute_vectorized_linearized_stress(
+      const double /*time*/,
+      const VectorizedMechanicsValues<dim, spacedim> &m_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      const ArrayView<const Tensor<2, spacedim, VectorizedArray<double>>> &dFF,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &dstresses)
+      const
+  {
+    const MaterialLaws::ModifiedNeoHookean<dim, spacedim> law(shear_modulus);
+    compute_law_linearized_stress(
+      law, material_ids, m_values, cell, dFF, dstresses);
+  }
+
+  template <int dim, int spacedim, typename Number>
+  template <typename MechanicsValuesType, typename StressNumber>
+  void
+  ModifiedNeoHookeanStress<dim, spacedim, Number>::do_compute_stress(
+    const MechanicsValuesType                                         &m_values,
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    ArrayView<Tensor<2, spacedim, StressNumber>> &stresses) const
   {
     if (this->material_ids.size() > 0 &&
         !std::binary_search(this->material_ids.begin(),
@@ -680,17 +1038,16 @@ namespace fdl
         // the user specified a subset of material ids and we currently don't
         // match - fill with zeros
         for (auto &stress : stresses)
-          stress = 0.0;
+          stress = Tensor<2, spacedim, StressNumber>();
       }
     else
       {
+        const MaterialLaws::ModifiedNeoHookean<dim, spacedim> law(
+          shear_modulus);
         for (unsigned int qp_n = 0; qp_n < stresses.size(); ++qp_n)
-          {
-            stresses[qp_n] =
-              shear_modulus * m_values.get_n23_det_FF()[qp_n] *
-              (m_values.get_FF()[qp_n] - m_values.get_first_invariant()[qp_n] /
-                                           3.0 * m_values.get_FF_inv_T()[qp_n]);
-          }
+          stresses[qp_n] = law.template get_stress<StressNumber>(m_values,
+                                                                 {},
+                                                                 qp_n);
       }
   }
 
@@ -715,12 +1072,8 @@ namespace fdl
   ModifiedMooneyRivlinStress<dim, spacedim, Number>::
     get_mechanics_update_flags() const
   {
-    return MechanicsUpdateFlags::update_n23_det_FF |
-           MechanicsUpdateFlags::update_FF |
-           MechanicsUpdateFlags::update_FF_inv_T |
-           MechanicsUpdateFlags::update_first_invariant |
-           MechanicsUpdateFlags::update_second_invariant |
-           MechanicsUpdateFlags::update_right_cauchy_green;
+    return MaterialLaws::ModifiedMooneyRivlin<dim, spacedim>::
+      get_mechanics_update_flags();
   }
 
   template <int dim, int spacedim, typename Number>
@@ -737,6 +1090,61 @@ namespace fdl
     const MechanicsValues<dim, spacedim>                              &m_values,
     const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
     ArrayView<Tensor<2, spacedim, Number>> &stresses) const
+  {
+    do_compute_stress(m_values, cell, stresses);
+  }
+
+  template <int dim, int spacedim, typename Number>
+  bool
+  ModifiedMooneyRivlinStress<dim, spacedim, Number>::
+    supports_vectorized_stress() const
+  {
+    return true;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  ModifiedMooneyRivlinStress<dim, spacedim, Number>::compute_vectorized_stress(
+    const double /*time*/,
+    const VectorizedMechanicsValues<dim, spacedim>                    &m_values,
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &stresses) const
+  {
+    do_compute_stress(m_values, cell, stresses);
+  }
+
+  template <int dim, int spacedim, typename Number>
+  bool
+  ModifiedMooneyRivlinStress<dim, spacedim, Number>::
+    supports_stress_linearization() const
+  {
+    return true;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  ModifiedMooneyRivlinStress<dim, spacedim, Number>::
+    compute_vectorized_linearized_stress(
+      const double /*time*/,
+      const VectorizedMechanicsValues<dim, spacedim> &m_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      const ArrayView<const Tensor<2, spacedim, VectorizedArray<double>>> &dFF,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &dstresses)
+      const
+  {
+    const MaterialLaws::ModifiedMooneyRivlin<dim, spacedim> law(
+      material_constant_1, material_constant_2);
+    compute_law_linearized_stress(
+      law, material_ids, m_values, cell, dFF, dstresses);
+  }
+
+  template <int dim, int spacedim, typename Number>
+  template <typename MechanicsValuesType, typename StressNumber>
+  void
+  ModifiedMooneyRivlinStress<dim, spacedim, Number>::do_compute_stress(
+    const MechanicsValuesType                                         &m_values,
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    ArrayView<Tensor<2, spacedim, StressNumber>> &stresses) const
   {
     if (this->material_ids.size() > 0 &&
         !std::binary_search(this->material_ids.begin(),
@@ -746,24 +1154,16 @@ namespace fdl
         // the user specified a subset of material ids and we currently don't
         // match - fill with zeros
         for (auto &stress : stresses)
-          stress = 0.0;
+          stress = Tensor<2, spacedim, StressNumber>();
       }
     else
       {
+        const MaterialLaws::ModifiedMooneyRivlin<dim, spacedim> law(
+          material_constant_1, material_constant_2);
         for (unsigned int qp_n = 0; qp_n < stresses.size(); ++qp_n)
-          {
-            const auto J_n23    = m_values.get_n23_det_FF()[qp_n];
-            const auto FF       = m_values.get_FF()[qp_n];
-            const auto FF_inv_T = m_values.get_FF_inv_T()[qp_n];
-            const auto CC       = m_values.get_right_cauchy_green()[qp_n];
-            const auto I1       = m_values.get_first_invariant()[qp_n];
-            const auto I2       = m_values.get_second_invariant()[qp_n];
-
-            stresses[qp_n] =
-              2.0 * material_constant_1 * J_n23 * (FF - I1 / 3.0 * FF_inv_T) +
-              2.0 * material_constant_2 * J_n23 * J_n23 *
-                (I1 * FF - FF * CC - 2.0 * I2 / 3.0 * FF_inv_T);
-          }
+          stresses[qp_n] = law.template get_stress<StressNumber>(m_values,
+                                                                 {},
+                                                                 qp_n);
       }
   }
 
@@ -787,9 +1187,8 @@ namespace fdl
   JLogJVolumetricEnergyStress<dim, spacedim, Number>::
     get_mechanics_update_flags() const
   {
-    return MechanicsUpdateFlags::update_det_FF |
-           MechanicsUpdateFlags::update_log_det_FF |
-           MechanicsUpdateFlags::update_FF_inv_T;
+    return MaterialLaws::JLogJVolumetricEnergy<dim, spacedim>::
+      get_mechanics_update_flags();
   }
 
   template <int dim, int spacedim, typename Number>
@@ -806,6 +1205,60 @@ namespace fdl
     const MechanicsValues<dim, spacedim>                              &m_values,
     const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
     ArrayView<Tensor<2, spacedim, Number>> &stresses) const
+  {
+    do_compute_stress(m_values, cell, stresses);
+  }
+
+  template <int dim, int spacedim, typename Number>
+  bool
+  JLogJVolumetricEnergyStress<dim, spacedim, Number>::
+    supports_vectorized_stress() const
+  {
+    return true;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  JLogJVolumetricEnergyStress<dim, spacedim, Number>::compute_vectorized_stress(
+    const double /*time*/,
+    const VectorizedMechanicsValues<dim, spacedim>                    &m_values,
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &stresses) const
+  {
+    do_compute_stress(m_values, cell, stresses);
+  }
+
+  template <int dim, int spacedim, typename Number>
+  bool
+  JLogJVolumetricEnergyStress<dim, spacedim, Number>::
+    supports_stress_linearization() const
+  {
+    return true;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  JLogJVolumetricEnergyStress<dim, spacedim, Number>::
+    compute_vectorized_linearized_stress(
+      const double /*time*/,
+      const VectorizedMechanicsValues<dim, spacedim> &m_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      const ArrayView<const Tensor<2, spacedim, VectorizedArray<double>>> &dFF,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &dstresses)
+      const
+  {
+    const MaterialLaws::JLogJVolumetricEnergy<dim, spacedim> law(bulk_modulus);
+    compute_law_linearized_stress(
+      law, material_ids, m_values, cell, dFF, dstresses);
+  }
+
+  template <int dim, int spacedim, typename Number>
+  template <typename MechanicsValuesType, typename StressNumber>
+  void
+  JLogJVolumetricEnergyStress<dim, spacedim, Number>::do_compute_stress(
+    const MechanicsValuesType                                         &m_values,
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    ArrayView<Tensor<2, spacedim, StressNumber>> &stresses) const
   {
     if (this->material_ids.size() > 0 &&
         !std::binary_search(this->material_ids.begin(),
@@ -815,14 +1268,16 @@ namespace fdl
         // the user specified a subset of material ids and we currently don't
         // match - fill with zeros
         for (auto &stress : stresses)
-          stress = 0.0;
+          stress = Tensor<2, spacedim, StressNumber>();
       }
     else
       {
+        const MaterialLaws::JLogJVolumetricEnergy<dim, spacedim> law(
+          bulk_modulus);
         for (unsigned int qp_n = 0; qp_n < stresses.size(); ++qp_n)
-          stresses[qp_n] = bulk_modulus * m_values.get_det_FF()[qp_n] *
-                           m_values.get_log_det_FF()[qp_n] *
-                           m_values.get_FF_inv_T()[qp_n];
+          stresses[qp_n] = law.template get_stress<StressNumber>(m_values,
+                                                                 {},
+                                                                 qp_n);
       }
   }
 
@@ -847,8 +1302,8 @@ namespace fdl
   LogarithmicVolumetricEnergyStress<dim, spacedim, Number>::
     get_mechanics_update_flags() const
   {
-    return MechanicsUpdateFlags::update_log_det_FF |
-           MechanicsUpdateFlags::update_FF_inv_T;
+    return MaterialLaws::LogarithmicVolumetricEnergy<dim, spacedim>::
+      get_mechanics_update_flags();
   }
 
   template <int dim, int spacedim, typename Number>
@@ -865,6 +1320,62 @@ namespace fdl
     const MechanicsValues<dim, spacedim>                              &m_values,
     const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
     ArrayView<Tensor<2, spacedim, Number>> &stresses) const
+  {
+    do_compute_stress(m_values, cell, stresses);
+  }
+
+  template <int dim, int spacedim, typename Number>
+  bool
+  LogarithmicVolumetricEnergyStress<dim, spacedim, Number>::
+    supports_vectorized_stress() const
+  {
+    return true;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  LogarithmicVolumetricEnergyStress<dim, spacedim, Number>::
+    compute_vectorized_stress(
+      const double /*time*/,
+      const VectorizedMechanicsValues<dim, spacedim> &m_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &stresses) const
+  {
+    do_compute_stress(m_values, cell, stresses);
+  }
+
+  template <int dim, int spacedim, typename Number>
+  bool
+  LogarithmicVolumetricEnergyStress<dim, spacedim, Number>::
+    supports_stress_linearization() const
+  {
+    return true;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  LogarithmicVolumetricEnergyStress<dim, spacedim, Number>::
+    compute_vectorized_linearized_stress(
+      const double /*time*/,
+      const VectorizedMechanicsValues<dim, spacedim> &m_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      const ArrayView<const Tensor<2, spacedim, VectorizedArray<double>>> &dFF,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &dstresses)
+      const
+  {
+    const MaterialLaws::LogarithmicVolumetricEnergy<dim, spacedim> law(
+      bulk_modulus);
+    compute_law_linearized_stress(
+      law, material_ids, m_values, cell, dFF, dstresses);
+  }
+
+  template <int dim, int spacedim, typename Number>
+  template <typename MechanicsValuesType, typename StressNumber>
+  void
+  LogarithmicVolumetricEnergyStress<dim, spacedim, Number>::do_compute_stress(
+    const MechanicsValuesType                                         &m_values,
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    ArrayView<Tensor<2, spacedim, StressNumber>> &stresses) const
   {
     if (this->material_ids.size() > 0 &&
         !std::binary_search(this->material_ids.begin(),
@@ -874,13 +1385,16 @@ namespace fdl
         // the user specified a subset of material ids and we currently don't
         // match - fill with zeros
         for (auto &stress : stresses)
-          stress = 0.0;
+          stress = Tensor<2, spacedim, StressNumber>();
       }
     else
       {
+        const MaterialLaws::LogarithmicVolumetricEnergy<dim, spacedim> law(
+          bulk_modulus);
         for (unsigned int qp_n = 0; qp_n < stresses.size(); ++qp_n)
-          stresses[qp_n] = bulk_modulus * m_values.get_log_det_FF()[qp_n] *
-                           m_values.get_FF_inv_T()[qp_n];
+          stresses[qp_n] = law.template get_stress<StressNumber>(m_values,
+                                                                 {},
+                                                                 qp_n);
       }
   }
 
@@ -927,10 +1441,8 @@ namespace fdl
   HolzapfelOgdenStress<dim, spacedim, Number>::get_mechanics_update_flags()
     const
   {
-    return MechanicsUpdateFlags::update_FF |
-           MechanicsUpdateFlags::update_modified_first_invariant |
-           MechanicsUpdateFlags::update_modified_first_invariant_dFF |
-           MechanicsUpdateFlags::update_right_cauchy_green;
+    return MaterialLaws::HolzapfelOgden<dim, spacedim>::
+      get_mechanics_update_flags();
   }
 
   template <int dim, int spacedim, typename Number>
@@ -947,6 +1459,72 @@ namespace fdl
     const MechanicsValues<dim, spacedim>                              &m_values,
     const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
     ArrayView<Tensor<2, spacedim, Number>> &stresses) const
+  {
+    do_compute_stress(m_values, cell, stresses);
+  }
+
+  template <int dim, int spacedim, typename Number>
+  bool
+  HolzapfelOgdenStress<dim, spacedim, Number>::supports_vectorized_stress()
+    const
+  {
+    return true;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  HolzapfelOgdenStress<dim, spacedim, Number>::compute_vectorized_stress(
+    const double /*time*/,
+    const VectorizedMechanicsValues<dim, spacedim>                    &m_values,
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &stresses) const
+  {
+    do_compute_stress(m_values, cell, stresses);
+  }
+
+  template <int dim, int spacedim, typename Number>
+  bool
+  HolzapfelOgdenStress<dim, spacedim, Number>::
+    supports_stress_linearization() const
+  {
+    return true;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  HolzapfelOgdenStress<dim, spacedim, Number>::
+    compute_vectorized_linearized_stress(
+      const double /*time*/,
+      const VectorizedMechanicsValues<dim, spacedim> &m_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      const ArrayView<const Tensor<2, spacedim, VectorizedArray<double>>> &dFF,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &dstresses)
+      const
+  {
+    const MaterialLaws::HolzapfelOgden<dim, spacedim> law(a,
+                                                          b,
+                                                          a_f,
+                                                          b_f,
+                                                          kappa_f,
+                                                          index_f,
+                                                          a_s,
+                                                          b_s,
+                                                          kappa_s,
+                                                          index_s,
+                                                          a_fs,
+                                                          b_fs,
+                                                          fiber_network);
+    compute_law_linearized_stress(
+      law, material_ids, m_values, cell, dFF, dstresses);
+  }
+
+  template <int dim, int spacedim, typename Number>
+  template <typename MechanicsValuesType, typename StressNumber>
+  void
+  HolzapfelOgdenStress<dim, spacedim, Number>::do_compute_stress(
+    const MechanicsValuesType                                         &m_values,
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    ArrayView<Tensor<2, spacedim, StressNumber>> &stresses) const
   {
     if (this->material_ids.size() > 0 &&
         !std::binary_search(this->material_ids.begin(),
@@ -956,57 +1534,28 @@ namespace fdl
         // the user specified a subset of material ids and we currently don't
         // match - fill with zeros
         for (auto &stress : stresses)
-          stress = 0.0;
+          stress = Tensor<2, spacedim, StressNumber>();
       }
     else
       {
-        const ArrayView<const Tensor<1, spacedim>> cell_fibers =
-          fiber_network->get_fibers(cell); // cell specific fiber fields
-        const auto fiber_f = cell_fibers[index_f];
-        const auto fiber_s = cell_fibers[index_s];
+        const MaterialLaws::HolzapfelOgden<dim, spacedim> law(a,
+                                                              b,
+                                                              a_f,
+                                                              b_f,
+                                                              kappa_f,
+                                                              index_f,
+                                                              a_s,
+                                                              b_s,
+                                                              kappa_s,
+                                                              index_s,
+                                                              a_fs,
+                                                              b_fs,
+                                                              fiber_network);
+        const auto cell_data =
+          law.template get_cell_data<StressNumber>(cell);
         for (unsigned int qp_n = 0; qp_n < stresses.size(); ++qp_n)
-          {
-            // convenience definitions
-            const auto I1_bar = m_values.get_modified_first_invariant()[qp_n];
-            const auto FF     = m_values.get_FF()[qp_n];
-            const auto CC     = m_values.get_right_cauchy_green()[qp_n];
-            const auto I1_bar_dFF =
-              m_values.get_modified_first_invariant_dFF()[qp_n];
-
-            // stress contribution, isotropic term
-            stresses[qp_n] =
-              (0.5 * a * std::exp(b * (I1_bar - 3.0))) * I1_bar_dFF;
-            // stress contribution, transversely isotropic term, fiber f
-            const double I4_f = I4_i(CC, fiber_f);
-            if (kappa_f != 0.0 || I4_f > 1.0)
-              {
-                stresses[qp_n] +=
-                  a_f *
-                  std::exp(b_f * std::pow(kappa_f * I1_bar +
-                                            (1.0 - 3.0 * kappa_f) * I4_f - 1.0,
-                                          2)) *
-                  (kappa_f * I1_bar + (1.0 - 3.0 * kappa_f) * I4_f - 1.0) *
-                  (kappa_f * I1_bar_dFF +
-                   (1.0 - 3.0 * kappa_f) * dI4_i_dFF(FF, fiber_f));
-              }
-            // stress contribution, transversely isotropic term, fiber s
-            const double I4_s = I4_i(CC, fiber_s);
-            if (kappa_s != 0.0 || I4_s > 1.0)
-              {
-                stresses[qp_n] +=
-                  a_s *
-                  std::exp(b_s * std::pow(kappa_s * I1_bar +
-                                            (1.0 - 3.0 * kappa_s) * I4_s - 1.0,
-                                          2)) *
-                  (kappa_s * I1_bar + (1.0 - 3.0 * kappa_s) * I4_s - 1.0) *
-                  (kappa_s * I1_bar_dFF +
-                   (1.0 - 3.0 * kappa_s) * dI4_i_dFF(FF, fiber_s));
-              }
-            // stress contribution, orthotropic term, fibers f and s
-            const double I8_fs = I8_ij(CC, fiber_f, fiber_s);
-            stresses[qp_n] += a_fs * I8_fs * std::exp(b_fs * I8_fs * I8_fs) *
-                              dI8_ij_dFF(FF, fiber_f, fiber_s);
-          }
+          stresses[qp_n] =
+            law.template get_stress<StressNumber>(m_values, cell_data, qp_n);
       }
   }
 
@@ -1017,6 +1566,10 @@ namespace fdl
   template class SpringForce<NDIM, NDIM, double>;
   template class BoundarySpringForce<NDIM - 1, NDIM, double>;
   template class BoundarySpringForce<NDIM, NDIM, double>;
+  template class NodalSpringForce<NDIM - 1, NDIM, double>;
+  template class NodalSpringForce<NDIM, NDIM, double>;
+  template class EmbeddedPointSpringForce<NDIM - 1, NDIM, double>;
+  template class EmbeddedPointSpringForce<NDIM, NDIM, double>;
   template class DampingForce<NDIM - 1, NDIM, double>;
   template class DampingForce<NDIM, NDIM, double>;
   template class OrthogonalLinearLoadForce<NDIM - 1, NDIM, double>;
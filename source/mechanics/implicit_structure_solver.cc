@@ -0,0 +1,200 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/implicit_structure_solver.h>
+#include <fiddle/mechanics/mechanics_utilities.h>
+
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_gmres.h>
+
+#include <limits>
+
+namespace fdl
+{
+  namespace
+  {
+    // Jacobi preconditioner for c M + K(X). Only the mass matrix is used, so
+    // this is most effective when c is large relative to the stiffness.
+    template <int dim>
+    class ScaledMassPreconditioner
+    {
+    public:
+      ScaledMassPreconditioner(const Part<dim> &part, const double factor)
+        : preconditioner(part.get_mass_preconditioner())
+        , factor(factor)
+      {}
+
+      void
+      vmult(LinearAlgebra::distributed::Vector<double>       &dst,
+            const LinearAlgebra::distributed::Vector<double> &src) const
+      {
+        preconditioner.vmult(dst, src);
+        dst *= factor;
+      }
+
+    private:
+      const PreconditionJacobi<MatrixFreeOperators::Base<dim>> &preconditioner;
+
+      double factor;
+    };
+  } // namespace
+
+  template <int dim>
+  ImplicitStructureSolver<dim>::ImplicitStructureSolver(
+    const Part<dim>   &part,
+    const unsigned int max_newton_iterations,
+    const double       newton_tolerance,
+    const unsigned int max_linear_iterations,
+    const double       linear_tolerance)
+    : part(&part)
+    , max_newton_iterations(max_newton_iterations)
+    , newton_tolerance(newton_tolerance)
+    , max_linear_iterations(max_linear_iterations)
+    , linear_tolerance(linear_tolerance)
+    , time(std::numeric_limits<double>::quiet_NaN())
+    , mass_coefficient(std::numeric_limits<double>::quiet_NaN())
+  {}
+
+  template <int dim>
+  bool
+  ImplicitStructureSolver<dim>::is_supported(const Part<dim> &part)
+  {
+    if (part.get_active_strains().size() > 0 || !part.get_matrix_free())
+      return false;
+
+    bool found_stress = false;
+    for (const ForceContribution<dim> *force : part.get_force_contributions())
+      if (force->is_stress())
+        {
+          found_stress = true;
+          if (!force->supports_stress_linearization() ||
+              !(force->get_cell_quadrature() == part.get_quadrature()))
+            return false;
+        }
+
+    return found_stress;
+  }
+
+  template <int dim>
+  unsigned int
+  ImplicitStructureSolver<dim>::solve(
+    const double                                      time,
+    const double                                      mass_coefficient,
+    const LinearAlgebra::distributed::Vector<double> &explicit_position,
+    LinearAlgebra::distributed::Vector<double>       &position)
+  {
+    Assert(mass_coefficient > 0.0,
+           ExcMessage("The mass coefficient should be positive."));
+    // Force contributions may be added to a Part at any time so look them up
+    // here
+    AssertThrow(is_supported(*part),
+                ExcMessage("This part cannot be updated implicitly: its "
+                           "stresses must implement "
+                           "compute_vectorized_linearized_stress() and use "
+                           "the part's quadrature rule, and it may not have "
+                           "active strains."));
+    stresses.clear();
+    for (ForceContribution<dim> *force : part->get_force_contributions())
+      if (force->is_stress())
+        stresses.push_back(force);
+    this->time             = time;
+    this->mass_coefficient = mass_coefficient;
+    current_position.reinit(part->get_partitioner());
+    ghosted_direction.reinit(part->get_partitioner());
+    mass_direction.reinit(part->get_partitioner());
+    current_position.copy_locally_owned_data_from(position);
+    current_position.update_ghost_values();
+
+    LinearAlgebra::distributed::Vector<double> residual(
+      part->get_partitioner());
+    LinearAlgebra::distributed::Vector<double> update(part->get_partitioner());
+    compute_residual(explicit_position, residual);
+    const double initial_residual_norm = residual.l2_norm();
+    double       residual_norm         = initial_residual_norm;
+
+    const ScaledMassPreconditioner<dim> preconditioner(*part,
+                                                       1.0 / mass_coefficient);
+    unsigned int n_iterations = 0;
+    while (residual_norm > newton_tolerance * initial_residual_norm)
+      {
+        AssertThrow(n_iterations < max_newton_iterations,
+                    SolverControl::NoConvergence(n_iterations, residual_norm));
+
+        // This is an inexact Newton method, so if GMRES does not converge
+        // then just use the last iterate
+        SolverControl control(max_linear_iterations,
+                              linear_tolerance * residual_norm);
+        SolverGMRES<LinearAlgebra::distributed::Vector<double>> gmres(control);
+        residual *= -1.0;
+        update = 0.0;
+        try
+          {
+            gmres.solve(*this, update, residual, preconditioner);
+          }
+        catch (const SolverControl::NoConvergence &)
+          {}
+
+        current_position.zero_out_ghost_values();
+        current_position += update;
+        current_position.update_ghost_values();
+        compute_residual(explicit_position, residual);
+        residual_norm = residual.l2_norm();
+        ++n_iterations;
+      }
+
+    position.copy_locally_owned_data_from(current_position);
+    return n_iterations;
+  }
+
+  template <int dim>
+  void
+  ImplicitStructureSolver<dim>::vmult(
+    LinearAlgebra::distributed::Vector<double>       &dst,
+    const LinearAlgebra::distributed::Vector<double> &src) const
+  {
+    ghosted_direction.copy_locally_owned_data_from(src);
+    ghosted_direction.update_ghost_values();
+
+    // The linearized load vector is -K(X) src
+    dst = 0.0;
+    compute_linearized_pk1_load_vector(*part->get_matrix_free(),
+                                       stresses,
+                                       time,
+                                       current_position,
+                                       ghosted_direction,
+                                       dst);
+    dst.compress(VectorOperation::add);
+    part->get_mass_operator().vmult(mass_direction, src);
+    dst.sadd(-1.0, mass_coefficient, mass_direction);
+  }
+
+  template <int dim>
+  void
+  ImplicitStructureSolver<dim>::compute_residual(
+    const LinearAlgebra::distributed::Vector<double> &explicit_position,
+    LinearAlgebra::distributed::Vector<double>       &residual) const
+  {
+    // c M (X - X_0)
+    LinearAlgebra::distributed::Vector<double> displacement(
+      part->get_partitioner());
+    displacement.copy_locally_owned_data_from(current_position);
+    displacement.add(-1.0, explicit_position);
+    part->get_mass_operator().vmult(residual, displacement);
+    residual *= mass_coefficient;
+
+    // - L(X)
+    LinearAlgebra::distributed::Vector<double> load(part->get_partitioner());
+    compute_volumetric_pk1_load_vector(part->get_dof_handler(),
+                                       part->get_mapping(),
+                                       stresses,
+                                       {},
+                                       time,
+                                       current_position,
+                                       part->get_velocity(),
+                                       load,
+                                       part->get_matrix_free().get());
+    load.compress(VectorOperation::add);
+    residual.add(-1.0, load);
+  }
+
+  template class ImplicitStructureSolver<NDIM>;
+} // namespace fdl
@@ -0,0 +1,183 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/mechanics_diagnostics.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/tria_base.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  template <int dim, int spacedim>
+  MechanicsDiagnostics<dim, spacedim>::MechanicsDiagnostics(
+    const Quadrature<dim> &quadrature)
+    : quadrature(quadrature)
+    , communicator(MPI_COMM_SELF)
+    , me_flags(MechanicsUpdateFlags::update_nothing)
+    , local_measure(0.0)
+  {}
+
+  template <int dim, int spacedim>
+  unsigned int
+  MechanicsDiagnostics<dim, spacedim>::add_quantity(
+    const std::string         &name,
+    const MechanicsUpdateFlags quantity_me_flags,
+    const QuantityFunction    &function,
+    const bool                 store_quantity_cell_values)
+  {
+    AssertThrow(function, ExcMessage("The function should not be empty."));
+    names.push_back(name);
+    me_flags |= quantity_me_flags;
+    functions.push_back(function);
+    store_cell_values.push_back(store_quantity_cell_values);
+    local_integrals.push_back(0.0);
+    local_mins.push_back(std::numeric_limits<double>::max());
+    local_maxes.push_back(std::numeric_limits<double>::lowest());
+    cell_values.emplace_back();
+    return functions.size() - 1;
+  }
+
+  template <int dim, int spacedim>
+  unsigned int
+  MechanicsDiagnostics<dim, spacedim>::add_det_FF(
+    const bool store_quantity_cell_values)
+  {
+    AssertThrow(dim == spacedim,
+                ExcMessage("det(FF) is only defined when dim == spacedim."));
+    return add_quantity(
+      "J",
+      MechanicsUpdateFlags::update_det_FF,
+      [](const MechanicsValues<dim, spacedim> &me_values,
+         const typename Triangulation<dim, spacedim>::active_cell_iterator &,
+         ArrayView<double> &values)
+      {
+        const std::vector<double> &det_FF = me_values.get_det_FF();
+        std::copy(det_FF.begin(), det_FF.end(), values.begin());
+      },
+      store_quantity_cell_values);
+  }
+
+  template <int dim, int spacedim>
+  void
+  MechanicsDiagnostics<dim, spacedim>::reinit(
+    const Triangulation<dim, spacedim> &tria)
+  {
+    // Serial Triangulations do not have a communicator
+    const auto *parallel_tria =
+      dynamic_cast<const parallel::TriangulationBase<dim, spacedim> *>(&tria);
+    communicator =
+      parallel_tria ? parallel_tria->get_communicator() : MPI_COMM_SELF;
+
+    local_measure = 0.0;
+    std::fill(local_integrals.begin(), local_integrals.end(), 0.0);
+    std::fill(local_mins.begin(),
+              local_mins.end(),
+              std::numeric_limits<double>::max());
+    std::fill(local_maxes.begin(),
+              local_maxes.end(),
+              std::numeric_limits<double>::lowest());
+    for (unsigned int i = 0; i < n_quantities(); ++i)
+      if (store_cell_values[i])
+        cell_values[i].reinit(tria.n_active_cells());
+  }
+
+  template <int dim, int spacedim>
+  void
+  MechanicsDiagnostics<dim, spacedim>::compute_cell_results(
+    const MechanicsValues<dim, spacedim> &me_values,
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    std::vector<double> &values,
+    std::vector<double> &cell_results) const
+  {
+    const FEValuesBase<dim, spacedim> &fe_values = me_values.get_fe_values();
+    const unsigned int n_quadrature_points = fe_values.n_quadrature_points;
+    AssertDimension(n_quadrature_points, quadrature.size());
+
+    // The results are stored as the measure of the cell followed by the
+    // integral, minimum, and maximum of each quantity.
+    cell_results.resize(1 + 3 * n_quantities());
+    cell_results[0] = 0.0;
+    for (unsigned int qp_n = 0; qp_n < n_quadrature_points; ++qp_n)
+      cell_results[0] += fe_values.JxW(qp_n);
+
+    values.resize(n_quadrature_points);
+    for (unsigned int i = 0; i < n_quantities(); ++i)
+      {
+        std::fill(values.begin(), values.end(), 0.0);
+        auto view = make_array_view(values.begin(), values.end());
+        functions[i](me_values, cell, view);
+
+        double integral = 0.0;
+        for (unsigned int qp_n = 0; qp_n < n_quadrature_points; ++qp_n)
+          integral += values[qp_n] * fe_values.JxW(qp_n);
+        cell_results[1 + 3 * i] = integral;
+        cell_results[2 + 3 * i] =
+          *std::min_element(values.begin(), values.end());
+        cell_results[3 + 3 * i] =
+          *std::max_element(values.begin(), values.end());
+      }
+  }
+
+  template <int dim, int spacedim>
+  void
+  MechanicsDiagnostics<dim, spacedim>::add_cell_results(
+    const unsigned int         cell_index,
+    const std::vector<double> &cell_results)
+  {
+    AssertDimension(cell_results.size(), 1 + 3 * n_quantities());
+    const double cell_measure = cell_results[0];
+    local_measure += cell_measure;
+    for (unsigned int i = 0; i < n_quantities(); ++i)
+      {
+        local_integrals[i] += cell_results[1 + 3 * i];
+        local_mins[i]  = std::min(local_mins[i], cell_results[2 + 3 * i]);
+        local_maxes[i] = std::max(local_maxes[i], cell_results[3 + 3 * i]);
+        if (store_cell_values[i])
+          cell_values[i][cell_index] = cell_results[1 + 3 * i] / cell_measure;
+      }
+  }
+
+  template <int dim, int spacedim>
+  std::vector<typename MechanicsDiagnostics<dim, spacedim>::Statistics>
+  MechanicsDiagnostics<dim, spacedim>::compute_statistics() const
+  {
+    // Do one reduction of each kind for all quantities at once
+    std::vector<double> sums(local_integrals);
+    sums.push_back(local_measure);
+    Utilities::MPI::sum(sums, communicator, sums);
+    std::vector<double> mins(local_mins);
+    Utilities::MPI::min(mins, communicator, mins);
+    std::vector<double> maxes(local_maxes);
+    Utilities::MPI::max(maxes, communicator, maxes);
+
+    std::vector<Statistics> statistics(n_quantities());
+    for (unsigned int i = 0; i < n_quantities(); ++i)
+      {
+        statistics[i].integral = sums[i];
+        statistics[i].min      = mins[i];
+        statistics[i].max      = maxes[i];
+        statistics[i].measure  = sums.back();
+      }
+    return statistics;
+  }
+
+  template <int dim, int spacedim>
+  const Vector<double> &
+  MechanicsDiagnostics<dim, spacedim>::get_cell_values(
+    const unsigned int quantity) const
+  {
+    AssertIndexRange(quantity, n_quantities());
+    AssertThrow(store_cell_values[quantity],
+                ExcMessage("Cell values were not requested for quantity " +
+                           names[quantity] + "."));
+    return cell_values[quantity];
+  }
+
+  template class MechanicsDiagnostics<NDIM - 1, NDIM>;
+  template class MechanicsDiagnostics<NDIM, NDIM>;
+} // namespace fdl
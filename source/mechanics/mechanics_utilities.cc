@@ -1,22 +1,1234 @@
+#include <fiddle/base/exceptions.h>
+#include <fiddle/base/markers.h>
+
 #include <fiddle/mechanics/mechanics_utilities.h>
 #include <fiddle/mechanics/mechanics_values.h>
 
 #include <deal.II/base/array_view.h>
 #include <deal.II/base/tensor.h>
+#include <deal.II/base/work_stream.h>
 
 #include <deal.II/fe/fe_update_flags.h>
 #include <deal.II/fe/fe_values.h>
 
+#include <deal.II/grid/filtered_iterator.h>
+#include <deal.II/grid/reference_cell.h>
+
 #include <deal.II/lac/la_parallel_vector.h>
 #include <deal.II/lac/vector.h>
 
+FDL_DISABLE_EXTRA_DIAGNOSTICS
+#include <deal.II/matrix_free/fe_evaluation.h>
+FDL_ENABLE_EXTRA_DIAGNOSTICS
+
 #include <algorithm>
+#include <map>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace fdl
 {
   using namespace dealii;
 
+  namespace
+  {
+    // Determine whether or not a group of forces consists only of stresses
+    // which are completely determined by FF, i.e., whether or not they can be
+    // evaluated without a full MechanicsValues object.
+    template <int dim, int spacedim>
+    bool
+    only_depends_on_FF(
+      const std::vector<ForceContribution<dim, spacedim> *> &forces)
+    {
+      const MechanicsUpdateFlags unsupported_flags =
+        update_position_values | update_velocity_values |
+        update_deformed_normal_vectors;
+      for (const ForceContribution<dim, spacedim> *fc : forces)
+        {
+          if (!fc->is_stress())
+            return false;
+          const MechanicsUpdateFlags me_flags =
+            resolve_flag_dependencies(fc->get_mechanics_update_flags());
+          if (me_flags & unsupported_flags)
+            return false;
+          // Stresses which need anything from FEValues besides FF (e.g.,
+          // quadrature points) have to go through the FEValues path.
+          const auto provided_flags =
+            static_cast<unsigned int>(compute_flag_dependencies(me_flags));
+          const auto requested_flags =
+            static_cast<unsigned int>(fc->get_update_flags());
+          if ((requested_flags & ~provided_flags) != 0u)
+            return false;
+        }
+
+      return true;
+    }
+
+    // Determine whether or not @p matrix_free was set up with @p dof_handler
+    // and @p quadrature and uses a vector partitioner compatible with those of
+    // @p vectors.
+    template <int dim>
+    bool
+    matrix_free_is_compatible(
+      const MatrixFree<dim, double> *matrix_free,
+      const DoFHandler<dim>         &dof_handler,
+      const Quadrature<dim>         &quadrature,
+      const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+        &vectors)
+    {
+      if (matrix_free == nullptr)
+        return false;
+      if (&matrix_free->get_dof_handler() != &dof_handler)
+        return false;
+      if (!(matrix_free->get_quadrature() == quadrature))
+        return false;
+      const auto &partitioner = *matrix_free->get_vector_partitioner();
+      for (const auto *vector : vectors)
+        if (!vector->get_partitioner()->is_compatible(partitioner))
+          return false;
+
+      return true;
+    }
+
+    // Determine whether or not a group of forces sharing a quadrature rule can
+    // be evaluated with @p matrix_free. We only support stresses which are
+    // completely determined by FF since FEEvaluation does not provide the
+    // rest of the values MechanicsValues can compute.
+    template <int dim>
+    bool
+    can_use_matrix_free(
+      const MatrixFree<dim, double>                    *matrix_free,
+      const DoFHandler<dim>                            &dof_handler,
+      const std::vector<ForceContribution<dim, dim> *> &forces,
+      const LinearAlgebra::distributed::Vector<double> &current_position,
+      const LinearAlgebra::distributed::Vector<double> &force_rhs)
+    {
+      if (forces.size() == 0)
+        return false;
+      if (!matrix_free_is_compatible(matrix_free,
+                                     dof_handler,
+                                     forces.front()->get_cell_quadrature(),
+                                     {&current_position, &force_rhs}))
+        return false;
+
+      return only_depends_on_FF(forces);
+    }
+
+    // Find a table of precomputed reference values which can be used to
+    // evaluate a group of forces sharing a quadrature rule. Returns nullptr if
+    // there is no such table.
+    template <int dim, int spacedim>
+    const ReferenceShapeGradients<dim, spacedim> *
+    find_reference_shape_gradients(
+      const std::vector<const ReferenceShapeGradients<dim, spacedim> *>
+                                                            &tables,
+      const DoFHandler<dim, spacedim>                       &dof_handler,
+      const std::vector<ForceContribution<dim, spacedim> *> &forces,
+      const std::vector<ActiveStrain<dim, spacedim> *>      &active_strains)
+    {
+      // Active strains modify FF so we cannot use the FF-only path
+      if (forces.size() == 0 || active_strains.size() > 0 ||
+          !only_depends_on_FF(forces))
+        return nullptr;
+      for (const ReferenceShapeGradients<dim, spacedim> *table : tables)
+        {
+          Assert(table, ExcMessage("tables should not be nullptr"));
+          if (&table->get_dof_handler() == &dof_handler &&
+              table->get_quadrature() == forces.front()->get_cell_quadrature())
+            return table;
+        }
+
+      return nullptr;
+    }
+
+
+
+    // Compute -PP : grad phi dx with sum factorization. FEEvaluation
+    // vectorizes over cells but stresses are evaluated one cell at a time (so
+    // that they can look up material ids, fibers, etc.). If every stress and
+    // active strain supports it we evaluate VectorizedArray<double>::size()
+    // quadrature points of that cell at once - otherwise we use the scalar
+    // compute_stress().
+    //
+    // Part sets up its MatrixFree object so that every cell batch contains
+    // cells with the same material id, and the batches are sorted by material
+    // id, so the active strain lookup usually only happens once per material.
+    template <int dim, int fe_degree, int n_q_points_1d>
+    void
+    compute_pk1_load_vector_matrix_free(
+      const MatrixFree<dim, double>                    &matrix_free,
+      const std::vector<ForceContribution<dim, dim> *> &stresses,
+      const std::map<types::material_id, ActiveStrain<dim, dim> *> &as_map,
+      const double                                                  time,
+      const LinearAlgebra::distributed::Vector<double> &current_position,
+      LinearAlgebra::distributed::Vector<double>       &force_rhs)
+    {
+      using VA = VectorizedArray<double>;
+
+      constexpr unsigned int width = VA::size();
+
+      MechanicsUpdateFlags me_flags = MechanicsUpdateFlags::update_nothing;
+      for (const auto *stress : stresses)
+        me_flags |= stress->get_mechanics_update_flags();
+      const bool use_vectorized_stresses =
+        std::all_of(stresses.begin(),
+                    stresses.end(),
+                    [](const ForceContribution<dim, dim> *fc)
+                    { return fc->supports_vectorized_stress(); }) &&
+        std::all_of(as_map.begin(),
+                    as_map.end(),
+                    [](const auto &pair)
+                    { return pair.second->supports_vectorized_strain(); });
+      MechanicsValues<dim, dim>           me_values(me_flags);
+      VectorizedMechanicsValues<dim, dim> vectorized_me_values(me_flags);
+
+      FEEvaluation<dim, fe_degree, n_q_points_1d, dim, double> phi(
+        matrix_free);
+      const unsigned int n_q_points        = phi.n_q_points;
+      const unsigned int n_q_point_batches = (n_q_points + width - 1) / width;
+
+      std::vector<Tensor<2, dim, VA>>     position_gradients(n_q_points);
+      std::vector<Tensor<2, dim, VA>>     batch_stresses(n_q_points);
+      std::vector<Tensor<2, dim, double>> FF(n_q_points);
+      std::vector<Tensor<2, dim, double>> push_forward_FF(n_q_points);
+      std::vector<Tensor<2, dim, double>> one_stress(n_q_points);
+      std::vector<Tensor<2, dim, double>> cell_stresses(n_q_points);
+      std::vector<Tensor<2, dim, double>> pulled_back_stresses(n_q_points);
+
+      // Pad the last batch of quadrature points with the identity so that
+      // the material models never see a singular FF
+      Tensor<2, dim, VA> identity;
+      for (unsigned int d = 0; d < dim; ++d)
+        identity[d][d] = 1.0;
+      std::vector<Tensor<2, dim, VA>> vectorized_FF(n_q_point_batches,
+                                                    identity);
+      std::vector<Tensor<2, dim, VA>> vectorized_push_forward_FF(
+        n_q_point_batches);
+      std::vector<Tensor<2, dim, VA>> one_vectorized_stress(n_q_point_batches);
+      std::vector<Tensor<2, dim, VA>> cell_vectorized_stresses(
+        n_q_point_batches);
+      std::vector<Tensor<2, dim, VA>> pulled_back_vectorized_stresses(
+        n_q_point_batches);
+
+      bool                    found_first_material = false;
+      types::material_id      current_material_id  = 0;
+      ActiveStrain<dim, dim> *current_as           = nullptr;
+      for (unsigned int batch = 0; batch < matrix_free.n_cell_batches();
+           ++batch)
+        {
+          phi.reinit(batch);
+          phi.gather_evaluate(current_position, EvaluationFlags::gradients);
+          for (unsigned int qp_n = 0; qp_n < n_q_points; ++qp_n)
+            {
+              position_gradients[qp_n] = phi.get_gradient(qp_n);
+              batch_stresses[qp_n]     = Tensor<2, dim, VA>();
+            }
+
+          const unsigned int n_lanes =
+            matrix_free.n_active_entries_per_cell_batch(batch);
+          for (unsigned int lane = 0; lane < n_lanes; ++lane)
+            {
+              const typename Triangulation<dim>::active_cell_iterator cell(
+                matrix_free.get_cell_iterator(batch, lane));
+              if (!found_first_material ||
+                  cell->material_id() != current_material_id)
+                {
+                  found_first_material = true;
+                  current_material_id  = cell->material_id();
+                  const auto it        = as_map.find(current_material_id);
+                  current_as = it == as_map.end() ? nullptr : it->second;
+                }
+
+              if (use_vectorized_stresses)
+                {
+                  for (unsigned int qp_n = 0; qp_n < n_q_points; ++qp_n)
+                    for (unsigned int i = 0; i < dim; ++i)
+                      for (unsigned int j = 0; j < dim; ++j)
+                        vectorized_FF[qp_n / width][i][j][qp_n % width] =
+                          position_gradients[qp_n][i][j][lane];
+                  if (current_as)
+                    {
+                      auto view = make_array_view(vectorized_push_forward_FF);
+                      current_as->push_vectorized_deformation_gradient_forward(
+                        cell, make_array_view(vectorized_FF), view);
+                      vectorized_me_values.reinit(vectorized_push_forward_FF);
+                    }
+                  else
+                    vectorized_me_values.reinit(vectorized_FF);
+
+                  std::fill(cell_vectorized_stresses.begin(),
+                            cell_vectorized_stresses.end(),
+                            Tensor<2, dim, VA>());
+                  for (const ForceContribution<dim, dim> *fc : stresses)
+                    {
+                      std::fill(one_vectorized_stress.begin(),
+                                one_vectorized_stress.end(),
+                                Tensor<2, dim, VA>());
+                      auto view = make_array_view(one_vectorized_stress);
+                      fc->compute_vectorized_stress(time,
+                                                    vectorized_me_values,
+                                                    cell,
+                                                    view);
+                      for (unsigned int qp_batch_n = 0;
+                           qp_batch_n < n_q_point_batches;
+                           ++qp_batch_n)
+                        cell_vectorized_stresses[qp_batch_n] +=
+                          one_vectorized_stress[qp_batch_n];
+                    }
+
+                  if (current_as)
+                    {
+                      auto view =
+                        make_array_view(pulled_back_vectorized_stresses);
+                      current_as->pull_vectorized_stress_back(
+                        cell, make_array_view(cell_vectorized_stresses), view);
+                      cell_vectorized_stresses.swap(
+                        pulled_back_vectorized_stresses);
+                    }
+
+                  for (unsigned int qp_n = 0; qp_n < n_q_points; ++qp_n)
+                    for (unsigned int i = 0; i < dim; ++i)
+                      for (unsigned int j = 0; j < dim; ++j)
+                        batch_stresses[qp_n][i][j][lane] =
+                          cell_vectorized_stresses[qp_n / width][i][j]
+                                                  [qp_n % width];
+                }
+              else
+                {
+                  for (unsigned int qp_n = 0; qp_n < n_q_points; ++qp_n)
+                    for (unsigned int i = 0; i < dim; ++i)
+                      for (unsigned int j = 0; j < dim; ++j)
+                        FF[qp_n][i][j] = position_gradients[qp_n][i][j][lane];
+                  if (current_as)
+                    {
+                      auto view = make_array_view(push_forward_FF);
+                      current_as->push_deformation_gradient_forward(
+                        cell, make_array_view(FF), view);
+                      me_values.reinit(push_forward_FF);
+                    }
+                  else
+                    me_values.reinit(FF);
+
+                  std::fill(cell_stresses.begin(),
+                            cell_stresses.end(),
+                            Tensor<2, dim, double>());
+                  for (const ForceContribution<dim, dim> *fc : stresses)
+                    {
+                      std::fill(one_stress.begin(),
+                                one_stress.end(),
+                                Tensor<2, dim, double>());
+                      auto view =
+                        make_array_view(one_stress.begin(), one_stress.end());
+                      fc->compute_stress(time, me_values, cell, view);
+                      for (unsigned int qp_n = 0; qp_n < n_q_points; ++qp_n)
+                        cell_stresses[qp_n] += one_stress[qp_n];
+                    }
+
+                  if (current_as)
+                    {
+                      auto view = make_array_view(pulled_back_stresses);
+                      current_as->pull_stress_back(
+                        cell, make_array_view(cell_stresses), view);
+                      cell_stresses.swap(pulled_back_stresses);
+                    }
+
+                  for (unsigned int qp_n = 0; qp_n < n_q_points; ++qp_n)
+                    for (unsigned int i = 0; i < dim; ++i)
+                      for (unsigned int j = 0; j < dim; ++j)
+                        batch_stresses[qp_n][i][j][lane] =
+                          cell_stresses[qp_n][i][j];
+                }
+            }
+
+          // -PP : grad phi dx
+          for (unsigned int qp_n = 0; qp_n < n_q_points; ++qp_n)
+            phi.submit_gradient(-batch_stresses[qp_n], qp_n);
+          phi.integrate_scatter(EvaluationFlags::gradients, force_rhs);
+        }
+    }
+
+
+
+    // Compute F . phi dx for volume forces which are linear combinations of
+    // finite element fields (see
+    // ForceContribution::get_volume_force_dof_values() and
+    // ForceContribution::is_mass_proportional()), i.e., apply the mass matrix
+    // to the sum of the scaled DoF values with sum factorization.
+    template <int dim, int fe_degree, int n_q_points_1d>
+    void
+    compute_volume_force_load_vector_matrix_free(
+      const MatrixFree<dim, double> &matrix_free,
+      const std::vector<
+        std::pair<double, const LinearAlgebra::distributed::Vector<double> *>>
+                                                 &force_dof_values,
+      LinearAlgebra::distributed::Vector<double> &force_rhs)
+    {
+      using VA = VectorizedArray<double>;
+
+      FEEvaluation<dim, fe_degree, n_q_points_1d, dim, double> phi(
+        matrix_free);
+      const unsigned int n_q_points = phi.n_q_points;
+
+      std::vector<Tensor<1, dim, VA>> batch_forces(n_q_points);
+      for (unsigned int batch = 0; batch < matrix_free.n_cell_batches();
+           ++batch)
+        {
+          phi.reinit(batch);
+          std::fill(batch_forces.begin(),
+                    batch_forces.end(),
+                    Tensor<1, dim, VA>());
+          for (const auto &[coefficient, dof_values] : force_dof_values)
+            {
+              phi.gather_evaluate(*dof_values, EvaluationFlags::values);
+              for (unsigned int qp_n = 0; qp_n < n_q_points; ++qp_n)
+                batch_forces[qp_n] += coefficient * phi.get_value(qp_n);
+            }
+
+          for (unsigned int qp_n = 0; qp_n < n_q_points; ++qp_n)
+            phi.submit_value(batch_forces[qp_n], qp_n);
+          phi.integrate_scatter(EvaluationFlags::values, force_rhs);
+        }
+    }
+
+
+
+    // Compute -dPP : grad phi dx, where dPP is the derivative of the stresses
+    // at @p position in the direction @p direction, with sum factorization.
+    // This is the same as compute_pk1_load_vector_matrix_free() except that
+    // there is no scalar path since every stress must implement
+    // ForceContribution::compute_vectorized_linearized_stress().
+    template <int dim, int fe_degree, int n_q_points_1d>
+    void
+    compute_linearized_pk1_load_vector_matrix_free(
+      const MatrixFree<dim, double>                    &matrix_free,
+      const std::vector<ForceContribution<dim, dim> *> &stresses,
+      const double                                      time,
+      const LinearAlgebra::distributed::Vector<double> &position,
+      const LinearAlgebra::distributed::Vector<double> &direction,
+      LinearAlgebra::distributed::Vector<double>       &dst)
+    {
+      using VA = VectorizedArray<double>;
+
+      constexpr unsigned int width = VA::size();
+
+      MechanicsUpdateFlags me_flags = MechanicsUpdateFlags::update_nothing;
+      for (const auto *stress : stresses)
+        me_flags |= stress->get_mechanics_update_flags();
+      VectorizedMechanicsValues<dim, dim> me_values(me_flags);
+
+      FEEvaluation<dim, fe_degree, n_q_points_1d, dim, double> phi(
+        matrix_free);
+      FEEvaluation<dim, fe_degree, n_q_points_1d, dim, double> dphi(
+        matrix_free);
+      const unsigned int n_q_points        = phi.n_q_points;
+      const unsigned int n_q_point_batches = (n_q_points + width - 1) / width;
+
+      std::vector<Tensor<2, dim, VA>> batch_dstresses(n_q_points);
+      // As in compute_pk1_load_vector_matrix_free(), pad with the identity.
+      // The padded directions are zero so they do not contribute.
+      Tensor<2, dim, VA> identity;
+      for (unsigned int d = 0; d < dim; ++d)
+        identity[d][d] = 1.0;
+      std::vector<Tensor<2, dim, VA>> FF(n_q_point_batches, identity);
+      std::vector<Tensor<2, dim, VA>> dFF(n_q_point_batches);
+      std::vector<Tensor<2, dim, VA>> one_dstress(n_q_point_batches);
+      std::vector<Tensor<2, dim, VA>> cell_dstresses(n_q_point_batches);
+
+      for (unsigned int batch = 0; batch < matrix_free.n_cell_batches();
+           ++batch)
+        {
+          phi.reinit(batch);
+          phi.gather_evaluate(position, EvaluationFlags::gradients);
+          dphi.reinit(batch);
+          dphi.gather_evaluate(direction, EvaluationFlags::gradients);
+
+          const unsigned int n_lanes =
+            matrix_free.n_active_entries_per_cell_batch(batch);
+          for (unsigned int qp_n = 0; qp_n < n_q_points; ++qp_n)
+            batch_dstresses[qp_n] = Tensor<2, dim, VA>();
+          for (unsigned int lane = 0; lane < n_lanes; ++lane)
+            {
+              const typename Triangulation<dim>::active_cell_iterator cell(
+                matrix_free.get_cell_iterator(batch, lane));
+              for (unsigned int qp_n = 0; qp_n < n_q_points; ++qp_n)
+                {
+                  const Tensor<2, dim, VA> grad  = phi.get_gradient(qp_n);
+                  const Tensor<2, dim, VA> dgrad = dphi.get_gradient(qp_n);
+                  for (unsigned int i = 0; i < dim; ++i)
+                    for (unsigned int j = 0; j < dim; ++j)
+                      {
+                        FF[qp_n / width][i][j][qp_n % width] =
+                          grad[i][j][lane];
+                        dFF[qp_n / width][i][j][qp_n % width] =
+                          dgrad[i][j][lane];
+                      }
+                }
+              me_values.reinit(FF);
+
+              std::fill(cell_dstresses.begin(),
+                        cell_dstresses.end(),
+                        Tensor<2, dim, VA>());
+              for (const ForceContribution<dim, dim> *fc : stresses)
+                {
+                  auto view = make_array_view(one_dstress);
+                  fc->compute_vectorized_linearized_stress(
+                    time,
+                    me_values,
+                    cell,
+                    make_array_view(std::as_const(dFF)),
+                    view);
+                  for (unsigned int qp_batch_n = 0;
+                       qp_batch_n < n_q_point_batches;
+                       ++qp_batch_n)
+                    cell_dstresses[qp_batch_n] += one_dstress[qp_batch_n];
+                }
+
+              for (unsigned int qp_n = 0; qp_n < n_q_points; ++qp_n)
+                for (unsigned int i = 0; i < dim; ++i)
+                  for (unsigned int j = 0; j < dim; ++j)
+                    batch_dstresses[qp_n][i][j][lane] =
+                      cell_dstresses[qp_n / width][i][j][qp_n % width];
+            }
+
+          // -dPP : grad phi dx
+          for (unsigned int qp_n = 0; qp_n < n_q_points; ++qp_n)
+            phi.submit_gradient(-batch_dstresses[qp_n], qp_n);
+          phi.integrate_scatter(EvaluationFlags::gradients, dst);
+        }
+    }
+
+
+
+    // Pick the FEEvaluation specialization. Tensor product elements of low
+    // degree with the standard (k + 1)-point Gauss rule get precompiled
+    // kernels - everything else uses the variable degree kernel. @p kernel is
+    // called with the degree and number of 1D quadrature points as
+    // std::integral_constant objects.
+    template <int dim, typename Kernel>
+    void
+    dispatch_matrix_free_kernel(const MatrixFree<dim, double> &matrix_free,
+                                const Kernel                  &kernel)
+    {
+      const FiniteElement<dim> &fe = matrix_free.get_dof_handler().get_fe();
+      const unsigned int        degree = fe.tensor_degree();
+      const bool                use_precompiled =
+        fe.reference_cell() == ReferenceCells::get_hypercube<dim>() &&
+        matrix_free.get_quadrature().size() ==
+          Utilities::fixed_power<dim>(degree + 1);
+
+      if (use_precompiled)
+        switch (degree)
+          {
+            case 1:
+              kernel(std::integral_constant<int, 1>(),
+                     std::integral_constant<int, 1 + 1>());
+              return;
+            case 2:
+              kernel(std::integral_constant<int, 2>(),
+                     std::integral_constant<int, 2 + 1>());
+              return;
+            case 3:
+              kernel(std::integral_constant<int, 3>(),
+                     std::integral_constant<int, 3 + 1>());
+              return;
+            case 4:
+              kernel(std::integral_constant<int, 4>(),
+                     std::integral_constant<int, 4 + 1>());
+              return;
+            case 5:
+              kernel(std::integral_constant<int, 5>(),
+                     std::integral_constant<int, 5 + 1>());
+              return;
+            default:
+              break;
+          }
+
+      kernel(std::integral_constant<int, -1>(), std::integral_constant<int, 0>());
+    }
+
+    template <int dim>
+    void
+    compute_pk1_load_vector_matrix_free(
+      const MatrixFree<dim, double>                    &matrix_free,
+      const std::vector<ForceContribution<dim, dim> *> &stresses,
+      const std::map<types::material_id, ActiveStrain<dim, dim> *> &as_map,
+      const double                                                  time,
+      const LinearAlgebra::distributed::Vector<double> &current_position,
+      LinearAlgebra::distributed::Vector<double>       &force_rhs)
+    {
+      dispatch_matrix_free_kernel(
+        matrix_free,
+        [&](const auto fe_degree, const auto n_q_points_1d)
+        {
+          compute_pk1_load_vector_matrix_free<dim,
+                                              decltype(fe_degree)::value,
+                                              decltype(n_q_points_1d)::value>(
+            matrix_free, stresses, as_map, time, current_position, force_rhs);
+        });
+    }
+
+    template <int dim>
+    void
+    compute_volume_force_load_vector_matrix_free(
+      const MatrixFree<dim, double> &matrix_free,
+      const std::vector<
+        std::pair<double, const LinearAlgebra::distributed::Vector<double> *>>
+                                                 &force_dof_values,
+      LinearAlgebra::distributed::Vector<double> &force_rhs)
+    {
+      dispatch_matrix_free_kernel(
+        matrix_free,
+        [&](const auto fe_degree, const auto n_q_points_1d)
+        {
+          compute_volume_force_load_vector_matrix_free<
+            dim,
+            decltype(fe_degree)::value,
+            decltype(n_q_points_1d)::value>(matrix_free,
+                                            force_dof_values,
+                                            force_rhs);
+        });
+    }
+
+    template <int dim>
+    void
+    compute_linearized_pk1_load_vector_matrix_free(
+      const MatrixFree<dim, double>                    &matrix_free,
+      const std::vector<ForceContribution<dim, dim> *> &stresses,
+      const double                                      time,
+      const LinearAlgebra::distributed::Vector<double> &position,
+      const LinearAlgebra::distributed::Vector<double> &direction,
+      LinearAlgebra::distributed::Vector<double>       &dst)
+    {
+      dispatch_matrix_free_kernel(
+        matrix_free,
+        [&](const auto fe_degree, const auto n_q_points_1d)
+        {
+          compute_linearized_pk1_load_vector_matrix_free<
+            dim,
+            decltype(fe_degree)::value,
+            decltype(n_q_points_1d)::value>(
+            matrix_free, stresses, time, position, direction, dst);
+        });
+    }
+
+    // Compute the MechanicsUpdateFlags required by a group of forces.
+    template <int dim, int spacedim>
+    MechanicsUpdateFlags
+    compute_mechanics_update_flags(
+      const std::vector<ForceContribution<dim, spacedim> *> &forces)
+    {
+      MechanicsUpdateFlags me_flags = MechanicsUpdateFlags::update_nothing;
+      for (const auto *force : forces)
+        me_flags |= force->get_mechanics_update_flags();
+      return me_flags;
+    }
+
+    // Compute the UpdateFlags required to evaluate and integrate a group of
+    // forces and to compute values with @p extra_me_flags.
+    template <int dim, int spacedim>
+    UpdateFlags
+    compute_update_flags(
+      const std::vector<ForceContribution<dim, spacedim> *> &forces,
+      const MechanicsUpdateFlags                             extra_me_flags)
+    {
+      UpdateFlags update_flags = UpdateFlags::update_default;
+      for (const auto *force : forces)
+        update_flags |= force->get_update_flags();
+      update_flags |= compute_flag_dependencies(
+        compute_mechanics_update_flags(forces) | extra_me_flags);
+      // Add the stuff we need here too:
+      update_flags |= update_JxW_values;
+      if (std::any_of(forces.begin(),
+                      forces.end(),
+                      [](const ForceContribution<dim, spacedim> *fc)
+                      { return !fc->is_stress(); }))
+        update_flags |= update_values;
+      if (std::any_of(forces.begin(),
+                      forces.end(),
+                      [](const ForceContribution<dim, spacedim> *fc)
+                      { return fc->is_stress(); }))
+        update_flags |= update_gradients;
+      return update_flags;
+    }
+
+    // Per-thread scratch data for a group of forces which share a quadrature
+    // rule and are evaluated with a single MechanicsValues object. Here
+    // FEValuesType is either FEValues or FEFaceValues. The MechanicsValues
+    // object also computes the values in @p extra_me_flags, which are needed
+    // by diagnostics.
+    template <int dim, int spacedim, typename FEValuesType>
+    struct LoadVectorScratchData
+    {
+      template <typename QuadratureType>
+      LoadVectorScratchData(
+        const Mapping<dim, spacedim>                          &mapping,
+        const FiniteElement<dim, spacedim>                    &fe,
+        const QuadratureType                                  &quadrature,
+        const std::vector<ForceContribution<dim, spacedim> *> &forces,
+        const LinearAlgebra::distributed::Vector<double> &current_position,
+        const LinearAlgebra::distributed::Vector<double> &current_velocity,
+        const MechanicsUpdateFlags                        extra_me_flags =
+          MechanicsUpdateFlags::update_nothing)
+        : forces(forces)
+        , extra_me_flags(extra_me_flags)
+        , fe_values(mapping,
+                    fe,
+                    quadrature,
+                    compute_update_flags(forces, extra_me_flags))
+        , me_values(fe_values,
+                    current_position,
+                    current_velocity,
+                    compute_mechanics_update_flags(forces) | extra_me_flags)
+        , current_position(&current_position)
+        , current_velocity(&current_velocity)
+        , one_stress(quadrature.size())
+        , accumulated_stresses(quadrature.size())
+        , pull_accumulated_stresses_back(quadrature.size())
+        , one_force(quadrature.size())
+        , accumulated_forces(quadrature.size())
+      {}
+
+      // WorkStream copies the sample scratch object for each thread. Since
+      // me_values refers to fe_values we have to set up both from scratch.
+      LoadVectorScratchData(const LoadVectorScratchData &other)
+        : LoadVectorScratchData(other.fe_values.get_mapping(),
+                                other.fe_values.get_fe(),
+                                other.fe_values.get_quadrature(),
+                                other.forces,
+                                *other.current_position,
+                                *other.current_velocity,
+                                other.extra_me_flags)
+      {}
+
+      std::vector<ForceContribution<dim, spacedim> *> forces;
+
+      MechanicsUpdateFlags extra_me_flags;
+
+      FEValuesType fe_values;
+
+      MechanicsValues<dim, spacedim, LinearAlgebra::distributed::Vector<double>>
+        me_values;
+
+      const LinearAlgebra::distributed::Vector<double> *current_position;
+      const LinearAlgebra::distributed::Vector<double> *current_velocity;
+
+      std::vector<Tensor<2, spacedim, double>> one_stress;
+      std::vector<Tensor<2, spacedim, double>> accumulated_stresses;
+      std::vector<Tensor<2, spacedim, double>> pull_accumulated_stresses_back;
+      std::vector<Tensor<1, spacedim, double>> one_force;
+      std::vector<Tensor<1, spacedim, double>> accumulated_forces;
+    };
+
+    // Per-thread scratch data for a group of stresses which only depend on FF
+    // and are evaluated with precomputed reference shape gradients.
+    template <int dim, int spacedim>
+    struct TableScratchData
+    {
+      TableScratchData(
+        const ReferenceShapeGradients<dim, spacedim>          &table,
+        const std::vector<ForceContribution<dim, spacedim> *> &forces,
+        const LinearAlgebra::distributed::Vector<double>      &current_position)
+        : table(&table)
+        , forces(forces)
+        , me_values(compute_mechanics_update_flags(forces))
+        , current_position(&current_position)
+        , local_positions(table.dofs_per_cell())
+        , FF(table.n_quadrature_points())
+        , one_stress(table.n_quadrature_points())
+        , accumulated_stresses(table.n_quadrature_points())
+      {}
+
+      const ReferenceShapeGradients<dim, spacedim> *table;
+
+      std::vector<ForceContribution<dim, spacedim> *> forces;
+
+      MechanicsValues<dim, spacedim, LinearAlgebra::distributed::Vector<double>>
+        me_values;
+
+      const LinearAlgebra::distributed::Vector<double> *current_position;
+
+      std::vector<double>                      local_positions;
+      std::vector<Tensor<2, spacedim, double>> FF;
+      std::vector<Tensor<2, spacedim, double>> one_stress;
+      std::vector<Tensor<2, spacedim, double>> accumulated_stresses;
+    };
+
+    // All of the per-thread scratch data needed to compute the load vector on
+    // one cell: one entry for each volumetric quadrature rule and one entry
+    // for each boundary quadrature rule. boundary_group_ids contains the
+    // sorted boundary ids on which at least one force in the corresponding
+    // boundary group is nonzero (or nothing, if that is every boundary id).
+    // If diagnostics is not nullptr then they are computed with the
+    // MechanicsValues of volume_groups[diagnostics_group].
+    template <int dim, int spacedim>
+    struct CellScratchData
+    {
+      std::vector<LoadVectorScratchData<dim, spacedim, FEValues<dim, spacedim>>>
+                                                       volume_groups;
+      std::vector<TableScratchData<dim, spacedim>> table_groups;
+      std::vector<
+        LoadVectorScratchData<dim, spacedim, FEFaceValues<dim, spacedim>>>
+                                                   boundary_groups;
+      std::vector<std::vector<types::boundary_id>> boundary_group_ids;
+
+      const MechanicsDiagnostics<dim, spacedim> *diagnostics = nullptr;
+      unsigned int                               diagnostics_group = 0;
+      std::vector<double>                        diagnostic_values;
+    };
+
+    // Per-cell contribution to the load vector. An empty set of DoFs means
+    // that the cell does not contribute anything. Similarly, an empty
+    // cell_diagnostics means that no diagnostics were computed.
+    struct LoadVectorCopyData
+    {
+      std::vector<types::global_dof_index> cell_dofs;
+      std::vector<double>                  cell_rhs;
+      unsigned int                         cell_index = 0;
+      std::vector<double>                  cell_diagnostics;
+    };
+
+    // Partition @p forces into groups that share a quadrature rule.
+    template <int dim, int spacedim, typename GetQuadrature>
+    std::vector<std::vector<ForceContribution<dim, spacedim> *>>
+    group_by_quadrature(std::vector<ForceContribution<dim, spacedim> *> forces,
+                        const GetQuadrature &get_quadrature)
+    {
+      std::vector<std::vector<ForceContribution<dim, spacedim> *>> groups;
+      while (forces.size() > 0)
+        {
+          const auto &exemplar_quadrature = get_quadrature(forces.front());
+          const auto  next_group_start =
+            std::partition(forces.begin(),
+                           forces.end(),
+                           [&](const ForceContribution<dim, spacedim> *p)
+                           {
+                             return get_quadrature(p) == exemplar_quadrature;
+                           });
+          groups.emplace_back(forces.begin(), next_group_start);
+          forces.erase(forces.begin(), next_group_start);
+        }
+
+      return groups;
+    }
+
+    // Add the contributions of the stresses and volume forces in one group to
+    // @p cell_rhs. The stresses and forces are summed at quadrature points so
+    // that we only contract with the test functions once. Returns whether or
+    // not anything was added.
+    template <int dim, int spacedim>
+    bool
+    add_volume_contributions(
+      const double time,
+      const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell,
+      ActiveStrain<dim, spacedim> *current_as,
+      LoadVectorScratchData<dim, spacedim, FEValues<dim, spacedim>>
+                          &scratch_data,
+      std::vector<double> &cell_rhs)
+    {
+      auto &fe_values            = scratch_data.fe_values;
+      auto &me_values            = scratch_data.me_values;
+      auto &one_stress           = scratch_data.one_stress;
+      auto &accumulated_stresses = scratch_data.accumulated_stresses;
+      auto &pull_accumulated_stresses_back =
+        scratch_data.pull_accumulated_stresses_back;
+      auto &one_force          = scratch_data.one_force;
+      auto &accumulated_forces = scratch_data.accumulated_forces;
+
+      const unsigned int n_quadrature_points = fe_values.n_quadrature_points;
+      const unsigned int dofs_per_cell       = fe_values.dofs_per_cell;
+
+      fe_values.reinit(cell);
+      if (current_as)
+        me_values.reinit(cell, *current_as);
+      else
+        me_values.reinit(cell);
+      std::fill(accumulated_stresses.begin(),
+                accumulated_stresses.end(),
+                Tensor<2, spacedim, double>());
+      std::fill(pull_accumulated_stresses_back.begin(),
+                pull_accumulated_stresses_back.end(),
+                Tensor<2, spacedim, double>());
+      std::fill(accumulated_forces.begin(),
+                accumulated_forces.end(),
+                Tensor<1, spacedim, double>());
+      auto &extractor = fe_values[FEValuesExtractors::Vector(0)];
+
+      bool touched_stress = false;
+      bool touched_force  = false;
+      for (const ForceContribution<dim, spacedim> *fc : scratch_data.forces)
+        {
+          if (fc->is_stress())
+            {
+              touched_stress = true;
+              std::fill(one_stress.begin(),
+                        one_stress.end(),
+                        Tensor<2, spacedim, double>());
+              auto view = make_array_view(one_stress.begin(), one_stress.end());
+              fc->compute_stress(time, me_values, cell, view);
+              for (unsigned int qp_n = 0; qp_n < n_quadrature_points; ++qp_n)
+                accumulated_stresses[qp_n] += one_stress[qp_n];
+            }
+          else if (fc->is_volume_force())
+            {
+              touched_force = true;
+              std::fill(one_force.begin(),
+                        one_force.end(),
+                        Tensor<1, spacedim, double>());
+              auto view = make_array_view(one_force.begin(), one_force.end());
+              fc->compute_volume_force(time, me_values, cell, view);
+              for (unsigned int qp_n = 0; qp_n < n_quadrature_points; ++qp_n)
+                accumulated_forces[qp_n] += one_force[qp_n];
+            }
+        }
+
+      if (touched_stress && current_as)
+        {
+          auto view = make_array_view(pull_accumulated_stresses_back);
+          current_as->pull_stress_back(cell,
+                                       make_array_view(accumulated_stresses),
+                                       view);
+        }
+      else
+        pull_accumulated_stresses_back.swap(accumulated_stresses);
+
+      // Assemble the RHS vector
+      //
+      // TODO - we could make this a lot faster by exploiting the
+      // fact that we have primitive FEs most of the time
+      for (unsigned int qp_n = 0; qp_n < n_quadrature_points; ++qp_n)
+        {
+          const double JxW = fe_values.JxW(qp_n);
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            {
+              double integrand = 0.0;
+              // -PP : grad phi dx
+              if (touched_stress)
+                integrand -=
+                  scalar_product(pull_accumulated_stresses_back[qp_n],
+                                 extractor.gradient(i, qp_n));
+              // F . phi dx
+              if (touched_force)
+                integrand += scalar_product(accumulated_forces[qp_n],
+                                            extractor.value(i, qp_n));
+              cell_rhs[i] += integrand * JxW;
+            }
+        }
+
+      return touched_stress || touched_force;
+    }
+
+    // Add the contributions of a group of stresses, evaluated with
+    // precomputed reference shape gradients, to @p cell_rhs. Since each shape
+    // function has exactly one nonzero component both FF and the test
+    // function contraction are dot products with the stored gradients.
+    template <int dim, int spacedim>
+    bool
+    add_table_contributions(
+      const double time,
+      const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell,
+      TableScratchData<dim, spacedim> &scratch_data,
+      std::vector<double>             &cell_rhs)
+    {
+      const ReferenceShapeGradients<dim, spacedim> &table = *scratch_data.table;
+      auto &local_positions      = scratch_data.local_positions;
+      auto &FF                   = scratch_data.FF;
+      auto &one_stress           = scratch_data.one_stress;
+      auto &accumulated_stresses = scratch_data.accumulated_stresses;
+
+      const unsigned int n_quadrature_points = table.n_quadrature_points();
+      const unsigned int dofs_per_cell       = table.dofs_per_cell();
+      const auto         dof_indices         = table.get_dof_indices(cell);
+      const auto         JxW_values          = table.get_JxW_values(cell);
+
+      for (unsigned int i = 0; i < dofs_per_cell; ++i)
+        local_positions[i] = (*scratch_data.current_position)[dof_indices[i]];
+
+      // FF = sum_i x_i e_{c(i)} (x) grad phi_i
+      for (unsigned int qp_n = 0; qp_n < n_quadrature_points; ++qp_n)
+        {
+          const auto shape_gradients = table.get_shape_gradients(cell, qp_n);
+          FF[qp_n]                   = Tensor<2, spacedim, double>();
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            FF[qp_n][table.get_component(i)] +=
+              local_positions[i] * shape_gradients[i];
+        }
+      scratch_data.me_values.reinit(FF);
+
+      std::fill(accumulated_stresses.begin(),
+                accumulated_stresses.end(),
+                Tensor<2, spacedim, double>());
+      for (const ForceContribution<dim, spacedim> *fc : scratch_data.forces)
+        {
+          std::fill(one_stress.begin(),
+                    one_stress.end(),
+                    Tensor<2, spacedim, double>());
+          auto view = make_array_view(one_stress.begin(), one_stress.end());
+          fc->compute_stress(time, scratch_data.me_values, cell, view);
+          for (unsigned int qp_n = 0; qp_n < n_quadrature_points; ++qp_n)
+            accumulated_stresses[qp_n] += one_stress[qp_n];
+        }
+
+      // -PP : grad phi dx
+      for (unsigned int qp_n = 0; qp_n < n_quadrature_points; ++qp_n)
+        {
+          const auto shape_gradients = table.get_shape_gradients(cell, qp_n);
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            cell_rhs[i] -= accumulated_stresses[qp_n][table.get_component(i)] *
+                           shape_gradients[i] * JxW_values[qp_n];
+        }
+
+      return true;
+    }
+
+    // Add the contributions of the boundary forces in one group on each
+    // physical boundary face of @p cell with a boundary id in @p boundary_ids
+    // (or every boundary id, if @p boundary_ids is empty) to @p cell_rhs.
+    // Returns whether or not anything was added.
+    template <int dim, int spacedim>
+    bool
+    add_boundary_contributions(
+      const double time,
+      const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell,
+      const std::vector<types::boundary_id> &boundary_ids,
+      LoadVectorScratchData<dim, spacedim, FEFaceValues<dim, spacedim>>
+                          &scratch_data,
+      std::vector<double> &cell_rhs)
+    {
+      auto &fe_values          = scratch_data.fe_values;
+      auto &me_values          = scratch_data.me_values;
+      auto &one_force          = scratch_data.one_force;
+      auto &accumulated_forces = scratch_data.accumulated_forces;
+
+      const unsigned int n_quadrature_points = fe_values.n_quadrature_points;
+      const unsigned int dofs_per_cell       = fe_values.dofs_per_cell;
+
+      bool touched_face = false;
+      for (const auto &face_n : cell->face_indices())
+        // only apply forces on physical boundaries
+        if (!cell->has_periodic_neighbor(face_n) &&
+            cell->face(face_n)->at_boundary() &&
+            (boundary_ids.size() == 0 ||
+             std::binary_search(boundary_ids.begin(),
+                                boundary_ids.end(),
+                                cell->face(face_n)->boundary_id())))
+          {
+            touched_face = true;
+            fe_values.reinit(cell, face_n);
+            me_values.reinit(cell);
+            std::fill(accumulated_forces.begin(),
+                      accumulated_forces.end(),
+                      Tensor<1, spacedim, double>());
+            auto &extractor = fe_values[FEValuesExtractors::Vector(0)];
+
+            // Compute forces at quadrature points
+            for (const ForceContribution<dim, spacedim> *fc :
+                 scratch_data.forces)
+              {
+                std::fill(one_force.begin(),
+                          one_force.end(),
+                          Tensor<1, spacedim, double>());
+                auto view = make_array_view(one_force.begin(), one_force.end());
+                fc->compute_boundary_force(time,
+                                           me_values,
+                                           cell->face(face_n),
+                                           view);
+                for (unsigned int qp_n = 0; qp_n < n_quadrature_points; ++qp_n)
+                  accumulated_forces[qp_n] += one_force[qp_n];
+              }
+
+            // Assemble the RHS vector
+            //
+            // TODO - we could make this a lot faster by exploiting the
+            // fact that we have primitive FEs most of the time
+            for (unsigned int qp_n = 0; qp_n < n_quadrature_points; ++qp_n)
+              for (unsigned int i = 0; i < dofs_per_cell; ++i)
+                // F . phi dx
+                cell_rhs[i] += scalar_product(accumulated_forces[qp_n],
+                                              extractor.value(i, qp_n)) *
+                               fe_values.JxW(qp_n);
+          }
+
+      return touched_face;
+    }
+
+    // Compute every contribution set up in @p sample_scratch_data in a single
+    // pass over the locally owned cells and add the result to @p force_rhs. If
+    // there are only boundary contributions and @p boundary_faces is not
+    // nullptr then we only loop over the cells stored by that object. The
+    // diagnostics set up in @p sample_scratch_data are added to
+    // @p diagnostics.
+    template <int dim, int spacedim>
+    void
+    assemble_load_vector(
+      const DoFHandler<dim, spacedim>      &dof_handler,
+      const CellScratchData<dim, spacedim> &sample_scratch_data,
+      const std::map<types::material_id, ActiveStrain<dim, spacedim> *>
+                                                 &as_map,
+      const BoundaryFaces<dim, spacedim>         *boundary_faces,
+      const double                                time,
+      LinearAlgebra::distributed::Vector<double> &force_rhs,
+      MechanicsDiagnostics<dim, spacedim>        *diagnostics = nullptr)
+    {
+      Assert(sample_scratch_data.diagnostics == diagnostics,
+             ExcFDLInternalError());
+      if (sample_scratch_data.volume_groups.size() == 0 &&
+          sample_scratch_data.table_groups.size() == 0 &&
+          sample_scratch_data.boundary_groups.size() == 0)
+        return;
+
+      using active_cell_iterator =
+        typename DoFHandler<dim, spacedim>::active_cell_iterator;
+      const unsigned int dofs_per_cell = dof_handler.get_fe().dofs_per_cell;
+      const auto         worker =
+        [&](const active_cell_iterator     &cell,
+            CellScratchData<dim, spacedim> &scratch_data,
+            LoadVectorCopyData             &copy_data)
+      {
+        copy_data.cell_dofs.clear();
+        copy_data.cell_diagnostics.clear();
+        copy_data.cell_rhs.resize(dofs_per_cell);
+        std::fill(copy_data.cell_rhs.begin(), copy_data.cell_rhs.end(), 0.0);
+
+        // Only look up the active strain once per cell
+        ActiveStrain<dim, spacedim> *current_as = nullptr;
+        const auto                   it = as_map.find(cell->material_id());
+        if (it != as_map.end())
+          current_as = it->second;
+
+        bool touched_cell = false;
+        for (auto &volume_data : scratch_data.volume_groups)
+          touched_cell |= add_volume_contributions(time,
+                                                   cell,
+                                                   current_as,
+                                                   volume_data,
+                                                   copy_data.cell_rhs);
+        // The MechanicsValues of the diagnostics group are still set up for
+        // this cell
+        if (scratch_data.diagnostics)
+          {
+            copy_data.cell_index = cell->active_cell_index();
+            scratch_data.diagnostics->compute_cell_results(
+              scratch_data.volume_groups[scratch_data.diagnostics_group]
+                .me_values,
+              cell,
+              scratch_data.diagnostic_values,
+              copy_data.cell_diagnostics);
+          }
+        for (auto &table_data : scratch_data.table_groups)
+          touched_cell |= add_table_contributions(time,
+                                                  cell,
+                                                  table_data,
+                                                  copy_data.cell_rhs);
+        if (cell->at_boundary())
+          for (unsigned int i = 0; i < scratch_data.boundary_groups.size(); ++i)
+            touched_cell |=
+              add_boundary_contributions(time,
+                                         cell,
+                                         scratch_data.boundary_group_ids[i],
+                                         scratch_data.boundary_groups[i],
+                                         copy_data.cell_rhs);
+
+        if (touched_cell)
+          {
+            copy_data.cell_dofs.resize(dofs_per_cell);
+            cell->get_dof_indices(copy_data.cell_dofs);
+          }
+      };
+
+      // WorkStream calls the copier in the same order as the cells, so the
+      // result does not depend on the number of threads.
+      const auto copier = [&](const LoadVectorCopyData &copy_data)
+      {
+        if (copy_data.cell_dofs.size() > 0)
+          force_rhs.add(copy_data.cell_dofs, copy_data.cell_rhs);
+        if (copy_data.cell_diagnostics.size() > 0)
+          diagnostics->add_cell_results(copy_data.cell_index,
+                                        copy_data.cell_diagnostics);
+      };
+
+      if (boundary_faces && sample_scratch_data.volume_groups.size() == 0 &&
+          sample_scratch_data.table_groups.size() == 0)
+        {
+          Assert(&boundary_faces->get_dof_handler() == &dof_handler,
+                 ExcMessage("The BoundaryFaces object must use the same "
+                            "DoFHandler."));
+          const std::vector<active_cell_iterator> &cells =
+            boundary_faces->get_cells();
+          WorkStream::run(
+            cells.begin(),
+            cells.end(),
+            [&](const typename std::vector<
+                  active_cell_iterator>::const_iterator &it,
+                CellScratchData<dim, spacedim>          &scratch_data,
+                LoadVectorCopyData                      &copy_data)
+            { worker(*it, scratch_data, copy_data); },
+            copier,
+            sample_scratch_data,
+            LoadVectorCopyData());
+        }
+      else
+        WorkStream::run(
+          filter_iterators(dof_handler.active_cell_iterators(),
+                           IteratorFilters::LocallyOwnedCell()),
+          [&](const FilteredIterator<active_cell_iterator> &filtered_cell,
+              CellScratchData<dim, spacedim>               &scratch_data,
+              LoadVectorCopyData                           &copy_data)
+          { worker(filtered_cell, scratch_data, copy_data); },
+          copier,
+          sample_scratch_data,
+          LoadVectorCopyData());
+    }
+
+    // Set up the scratch data for each group of boundary forces.
+    template <int dim, int spacedim>
+    void
+    setup_boundary_groups(
+      const DoFHandler<dim, spacedim>                       &dof_handler,
+      const Mapping<dim, spacedim>                          &mapping,
+      const std::vector<ForceContribution<dim, spacedim> *> &boundary_forces,
+      const LinearAlgebra::distributed::Vector<double>      &current_position,
+      const LinearAlgebra::distributed::Vector<double>      &current_velocity,
+      CellScratchData<dim, spacedim>                        &scratch_data)
+    {
+      const auto groups =
+        group_by_quadrature(boundary_forces,
+                            [](const ForceContribution<dim, spacedim> *p)
+                              -> const Quadrature<dim - 1> &
+                            { return p->get_face_quadrature(); });
+      // avoid copies when the vector grows
+      scratch_data.boundary_groups.reserve(groups.size());
+      for (const auto &group : groups)
+        {
+          scratch_data.boundary_groups.emplace_back(
+            mapping,
+            dof_handler.get_fe(),
+            group.front()->get_face_quadrature(),
+            group,
+            current_position,
+            current_velocity);
+
+          std::vector<types::boundary_id> group_ids;
+          for (const ForceContribution<dim, spacedim> *fc : group)
+            {
+              const std::vector<types::boundary_id> ids =
+                fc->get_boundary_ids();
+              // this force is applied everywhere so the group is too
+              if (ids.size() == 0)
+                {
+                  group_ids.clear();
+                  break;
+                }
+              group_ids.insert(group_ids.end(), ids.begin(), ids.end());
+            }
+          std::sort(group_ids.begin(), group_ids.end());
+          group_ids.erase(std::unique(group_ids.begin(), group_ids.end()),
+                          group_ids.end());
+          scratch_data.boundary_group_ids.push_back(std::move(group_ids));
+        }
+    }
+  } // namespace
+
   template <int dim, int spacedim>
   void
   compute_volumetric_pk1_load_vector(
@@ -27,7 +1239,10 @@ namespace fdl
     const double                                           time,
     const LinearAlgebra::distributed::Vector<double>      &current_position,
     const LinearAlgebra::distributed::Vector<double>      &current_velocity,
-    LinearAlgebra::distributed::Vector<double>            &force_rhs)
+    LinearAlgebra::distributed::Vector<double>            &force_rhs,
+    const MatrixFree<dim, double>                         *matrix_free,
+    const std::vector<const ReferenceShapeGradients<dim, spacedim> *>
+      &reference_shape_gradients)
   {
 #ifdef DEBUG
     for (const auto *p : stress_contributions)
@@ -44,7 +1259,42 @@ namespace fdl
                         time,
                         current_position,
                         current_velocity,
-                        force_rhs);
+                        force_rhs,
+                        matrix_free,
+                        reference_shape_gradients);
+  }
+
+
+
+  template <int dim>
+  void
+  compute_linearized_pk1_load_vector(
+    const MatrixFree<dim, double>                    &matrix_free,
+    const std::vector<ForceContribution<dim, dim> *> &stress_contributions,
+    const double                                      time,
+    const LinearAlgebra::distributed::Vector<double> &position,
+    const LinearAlgebra::distributed::Vector<double> &direction,
+    LinearAlgebra::distributed::Vector<double>       &dst)
+  {
+    for (const auto *p : stress_contributions)
+      {
+        Assert(p, ExcMessage("stresses should not be nullptr"));
+        AssertThrow(p->is_stress() && p->supports_stress_linearization(),
+                    ExcMessage("Every force must be a stress which implements "
+                               "compute_vectorized_linearized_stress()."));
+        AssertThrow(matrix_free_is_compatible(&matrix_free,
+                                              matrix_free.get_dof_handler(),
+                                              p->get_cell_quadrature(),
+                                              {&position, &direction, &dst}),
+                    ExcMessage("The MatrixFree object must use the quadrature "
+                               "rule of every stress and be compatible with "
+                               "the given vectors."));
+      }
+    Assert(only_depends_on_FF(stress_contributions),
+           ExcMessage("The stresses should only depend on FF."));
+
+    compute_linearized_pk1_load_vector_matrix_free(
+      matrix_free, stress_contributions, time, position, direction, dst);
   }
 
 
@@ -61,6 +1311,7 @@ namespace fdl
     const LinearAlgebra::distributed::Vector<double> &current_velocity,
     LinearAlgebra::distributed::Vector<double>       &force_rhs)
   {
+    FDL_MARKER_SCOPE(marker, "fdl_volumetric_force_load_vector");
 #ifdef DEBUG
     for (const auto *p : volume_force_contributions)
       {
@@ -92,7 +1343,8 @@ namespace fdl
     const double time,
     const LinearAlgebra::distributed::Vector<double> &current_position,
     const LinearAlgebra::distributed::Vector<double> &current_velocity,
-    LinearAlgebra::distributed::Vector<double>       &force_rhs)
+    LinearAlgebra::distributed::Vector<double>       &force_rhs,
+    const BoundaryFaces<dim, spacedim>               *boundary_faces)
   {
 #ifdef DEBUG
     for (const auto *p : boundary_force_contributions)
@@ -103,103 +1355,20 @@ namespace fdl
       }
 #endif
 
-    // Batch forces by the quadrature rules they use
-    std::vector<ForceContribution<dim, spacedim> *> remaining_forces =
-      boundary_force_contributions;
-    while (remaining_forces.size() > 0)
-      {
-        auto                       exemplar_force = remaining_forces.front();
-        const Quadrature<dim - 1> &exemplar_quadrature =
-          exemplar_force->get_face_quadrature();
-        const auto next_group_start =
-          std::partition(remaining_forces.begin(),
-                         remaining_forces.end(),
-                         [&](const ForceContribution<dim, spacedim> *p) {
-                           return p->get_face_quadrature() ==
-                                  exemplar_quadrature;
-                         });
-
-        std::vector<ForceContribution<dim, spacedim> *> current_forces(
-          remaining_forces.begin(), next_group_start);
-        remaining_forces.erase(remaining_forces.begin(), next_group_start);
-
-        // Collect common flags:
-        MechanicsUpdateFlags me_flags = MechanicsUpdateFlags::update_nothing;
-        UpdateFlags          update_flags = UpdateFlags::update_default;
-        for (const auto *force : current_forces)
-          {
-            me_flags |= force->get_mechanics_update_flags();
-            update_flags |= force->get_update_flags();
-          }
-        update_flags |= compute_flag_dependencies(me_flags);
-        // Add the stuff we need here too:
-        update_flags |= update_values | update_JxW_values;
-        const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
-
-        FEFaceValues<dim, spacedim> fe_values(mapping,
-                                              fe,
-                                              exemplar_quadrature,
-                                              update_flags);
-        MechanicsValues<dim,
-                        spacedim,
-                        LinearAlgebra::distributed::Vector<double>>
-          me_values(fe_values, current_position, current_velocity, me_flags);
-
-        const unsigned int n_quadrature_points = exemplar_quadrature.size();
-        std::vector<types::global_dof_index>     cell_dofs(fe.dofs_per_cell);
-        std::vector<double>                      cell_rhs(fe.dofs_per_cell);
-        std::vector<Tensor<1, spacedim, double>> one_force(n_quadrature_points);
-        std::vector<Tensor<1, spacedim, double>> accumulated_forces(
-          n_quadrature_points);
-        for (const auto &cell : dof_handler.active_cell_iterators())
-          if (cell->is_locally_owned() && cell->at_boundary())
-            for (const auto &face_n : cell->face_indices())
-              // only apply forces on physical boundaries
-              if (!cell->has_periodic_neighbor(face_n) &&
-                  cell->face(face_n)->at_boundary())
-                {
-                  cell->get_dof_indices(cell_dofs);
-                  fe_values.reinit(cell, face_n);
-                  me_values.reinit(cell);
-                  std::fill(accumulated_forces.begin(),
-                            accumulated_forces.end(),
-                            Tensor<1, spacedim, double>());
-                  std::fill(cell_rhs.begin(), cell_rhs.end(), 0.0);
-                  auto &extractor = fe_values[FEValuesExtractors::Vector(0)];
-
-                  // Compute forces at quadrature points
-                  for (const ForceContribution<dim, spacedim> *fc :
-                       current_forces)
-                    {
-                      std::fill(one_force.begin(),
-                                one_force.end(),
-                                Tensor<1, spacedim, double>());
-                      auto view =
-                        make_array_view(one_force.begin(), one_force.end());
-                      fc->compute_boundary_force(time,
-                                                 me_values,
-                                                 cell->face(face_n),
-                                                 view);
-                      for (unsigned int qp_n = 0; qp_n < n_quadrature_points;
-                           ++qp_n)
-                        accumulated_forces[qp_n] += one_force[qp_n];
-                    }
-
-                  // Assemble the RHS vector
-                  //
-                  // TODO - we could make this a lot faster by exploiting the
-                  // fact that we have primitive FEs most of the time
-                  for (unsigned int qp_n = 0; qp_n < n_quadrature_points;
-                       ++qp_n)
-                    for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
-                      // F . phi dx
-                      cell_rhs[i] += scalar_product(accumulated_forces[qp_n],
-                                                    extractor.value(i, qp_n)) *
-                                     fe_values.JxW(qp_n);
-
-                  force_rhs.add(cell_dofs, cell_rhs);
-                }
-      }
+    CellScratchData<dim, spacedim> sample_scratch_data;
+    setup_boundary_groups(dof_handler,
+                          mapping,
+                          boundary_force_contributions,
+                          current_position,
+                          current_velocity,
+                          sample_scratch_data);
+    assemble_load_vector(
+      dof_handler,
+      sample_scratch_data,
+      std::map<types::material_id, ActiveStrain<dim, spacedim> *>(),
+      boundary_faces,
+      time,
+      force_rhs);
   }
 
 
@@ -214,13 +1383,20 @@ namespace fdl
     const double                                           time,
     const LinearAlgebra::distributed::Vector<double>      &current_position,
     const LinearAlgebra::distributed::Vector<double>      &current_velocity,
-    LinearAlgebra::distributed::Vector<double>            &force_rhs)
+    LinearAlgebra::distributed::Vector<double>            &force_rhs,
+    const MatrixFree<dim, double>                         *matrix_free,
+    const std::vector<const ReferenceShapeGradients<dim, spacedim> *>
+      &reference_shape_gradients,
+    const BoundaryFaces<dim, spacedim>                    *boundary_faces,
+    MechanicsDiagnostics<dim, spacedim>                   *diagnostics)
   {
     for (const auto *p : force_contributions)
       {
         (void)p;
         Assert(p, ExcMessage("force contributions should not be nullptr"));
       }
+    if (diagnostics)
+      diagnostics->reinit(dof_handler.get_triangulation());
 
     std::vector<ForceContribution<dim, spacedim> *> stress_contributions;
     std::vector<ForceContribution<dim, spacedim> *> volume_force_contributions;
@@ -249,12 +1425,65 @@ namespace fdl
                   force_contributions.size(),
                 ExcMessage("The forces must be partitioned into three parts."));
 
-    // Batch stresses by the quadrature rules they use
+    // Volume forces which are finite element fields or are mass-proportional
+    // only need a mass matrix-vector product, which we do with MatrixFree
+    // when possible. Every such force is summed at quadrature points so the
+    // mass matrix is only applied once.
     std::vector<ForceContribution<dim, spacedim> *> remaining_forces =
       stress_contributions;
-    remaining_forces.insert(remaining_forces.end(),
-                            volume_force_contributions.begin(),
-                            volume_force_contributions.end());
+    std::vector<
+      std::pair<double, const LinearAlgebra::distributed::Vector<double> *>>
+      matrix_free_force_dof_values;
+    for (auto *fc : volume_force_contributions)
+      {
+        // Nodal forces only touch their own DoFs, so they never need a cell
+        // loop
+        if (fc->is_nodal_force())
+          {
+            fc->add_nodal_load_vector(time,
+                                      current_position,
+                                      current_velocity,
+                                      force_rhs);
+            continue;
+          }
+        const LinearAlgebra::distributed::Vector<double> *dof_values =
+          fc->get_volume_force_dof_values();
+        bool use_matrix_free = false;
+        if constexpr (dim == spacedim)
+          {
+            if (dof_values != nullptr)
+              use_matrix_free =
+                matrix_free_is_compatible(matrix_free,
+                                          dof_handler,
+                                          fc->get_cell_quadrature(),
+                                          {dof_values, &force_rhs});
+            else if (fc->is_mass_proportional())
+              use_matrix_free = matrix_free_is_compatible(
+                matrix_free,
+                dof_handler,
+                fc->get_cell_quadrature(),
+                {&current_position, &current_velocity, &force_rhs});
+          }
+        if (!use_matrix_free)
+          remaining_forces.push_back(fc);
+        else if (dof_values != nullptr)
+          matrix_free_force_dof_values.emplace_back(1.0, dof_values);
+        else
+          {
+            const auto [a, b] = fc->get_mass_proportional_coefficients(time);
+            if (a != 0.0)
+              matrix_free_force_dof_values.emplace_back(a, &current_position);
+            if (b != 0.0)
+              matrix_free_force_dof_values.emplace_back(b, &current_velocity);
+          }
+      }
+    if constexpr (dim == spacedim)
+      if (matrix_free_force_dof_values.size() > 0)
+        {
+          FDL_MARKER_SCOPE(marker, "fdl_load_vector_matrix_free");
+          compute_volume_force_load_vector_matrix_free(
+            *matrix_free, matrix_free_force_dof_values, force_rhs);
+        }
 
     // convert the active strains into a map for easier lookup
     std::map<types::material_id, ActiveStrain<dim, spacedim> *> as_map;
@@ -271,176 +1500,114 @@ namespace fdl
           }
       }
 
-    types::material_id           current_id = numbers::invalid_material_id;
-    ActiveStrain<dim, spacedim> *current_as = nullptr;
-    while (remaining_forces.size() > 0)
+    // Group the volumetric contributions by quadrature. Everything which
+    // cannot be done with MatrixFree is then computed in a single pass over
+    // the cells: each cell is visited once, its MechanicsValues are
+    // reinitialized once per quadrature rule, and the boundary contributions
+    // are added to the same cell vector.
+    const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
+    const auto                          groups =
+      group_by_quadrature(remaining_forces,
+                          [](const ForceContribution<dim, spacedim> *p)
+                            -> const Quadrature<dim> &
+                          { return p->get_cell_quadrature(); });
+    CellScratchData<dim, spacedim> sample_scratch_data;
+    sample_scratch_data.diagnostics = diagnostics;
+    // avoid copies when the vectors grow
+    sample_scratch_data.volume_groups.reserve(groups.size() + 1);
+    sample_scratch_data.table_groups.reserve(groups.size());
+    bool found_diagnostics_group = false;
+    for (const auto &group : groups)
       {
-        auto                   exemplar_force = remaining_forces.front();
-        const Quadrature<dim> &exemplar_quadrature =
-          exemplar_force->get_cell_quadrature();
-        const auto next_group_start =
-          std::partition(remaining_forces.begin(),
-                         remaining_forces.end(),
-                         [&](const ForceContribution<dim, spacedim> *p) {
-                           return p->get_cell_quadrature() ==
-                                  exemplar_quadrature;
-                         });
-
-        std::vector<ForceContribution<dim, spacedim> *> current_forces(
-          remaining_forces.begin(), next_group_start);
-        remaining_forces.erase(remaining_forces.begin(), next_group_start);
-
-        // Collect common flags:
-        MechanicsUpdateFlags me_flags = MechanicsUpdateFlags::update_nothing;
-        UpdateFlags          update_flags = UpdateFlags::update_default;
-        for (const auto *stress : current_forces)
+        // Diagnostics need MechanicsValues at each quadrature point, so the
+        // group which shares their quadrature rule always uses FEValues.
+        if (diagnostics && group.front()->get_cell_quadrature() ==
+                             diagnostics->get_quadrature())
           {
-            me_flags |= stress->get_mechanics_update_flags();
-            update_flags |= stress->get_update_flags();
+            found_diagnostics_group = true;
+            sample_scratch_data.diagnostics_group =
+              sample_scratch_data.volume_groups.size();
+            sample_scratch_data.volume_groups.emplace_back(
+              mapping,
+              fe,
+              group.front()->get_cell_quadrature(),
+              group,
+              current_position,
+              current_velocity,
+              diagnostics->get_mechanics_update_flags());
+            continue;
           }
-        update_flags |= compute_flag_dependencies(me_flags);
-        // Add the stuff we need here too:
-        update_flags |= update_JxW_values;
-        if (std::any_of(current_forces.begin(),
-                        current_forces.end(),
-                        [](const ForceContribution<dim, spacedim> *fc)
-                        { return fc->is_volume_force(); }))
-          update_flags |= update_values;
-        if (std::any_of(current_forces.begin(),
-                        current_forces.end(),
-                        [](const ForceContribution<dim, spacedim> *fc)
-                        { return fc->is_stress(); }))
-          update_flags |= update_gradients;
-
-        const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
-
-        FEValues<dim, spacedim> fe_values(mapping,
-                                          fe,
-                                          exemplar_quadrature,
-                                          update_flags);
-        MechanicsValues<dim,
-                        spacedim,
-                        LinearAlgebra::distributed::Vector<double>>
-          me_values(fe_values, current_position, current_velocity, me_flags);
-
-        const unsigned int n_quadrature_points = exemplar_quadrature.size();
-        std::vector<types::global_dof_index>     cell_dofs(fe.dofs_per_cell);
-        std::vector<Tensor<2, spacedim, double>> one_stress(
-          n_quadrature_points);
-        std::vector<Tensor<2, spacedim, double>> accumulated_stresses(
-          n_quadrature_points);
-        std::vector<Tensor<2, spacedim, double>> pull_accumulated_stresses_back(
-          n_quadrature_points);
-        std::vector<Tensor<1, spacedim, double>> one_force(n_quadrature_points);
-        std::vector<Tensor<1, spacedim, double>> accumulated_forces(
-          n_quadrature_points);
-        std::vector<double> cell_rhs(fe.dofs_per_cell);
-        for (const auto &cell : dof_handler.active_cell_iterators())
+
+        if constexpr (dim == spacedim)
           {
-            if (cell->is_locally_owned())
+            if (can_use_matrix_free(matrix_free,
+                                    dof_handler,
+                                    group,
+                                    current_position,
+                                    force_rhs))
               {
-                cell->get_dof_indices(cell_dofs);
-                fe_values.reinit(cell);
-                if (active_strains.size() > 0 &&
-                    cell->material_id() != current_id)
-                  {
-                    current_id = cell->material_id();
-                    current_as = as_map[current_id];
-                  }
-                if (current_as)
-                  me_values.reinit(cell, *current_as);
-                else
-                  me_values.reinit(cell);
-                std::fill(accumulated_stresses.begin(),
-                          accumulated_stresses.end(),
-                          Tensor<2, spacedim, double>());
-                std::fill(pull_accumulated_stresses_back.begin(),
-                          pull_accumulated_stresses_back.end(),
-                          Tensor<2, spacedim, double>());
-                std::fill(accumulated_forces.begin(),
-                          accumulated_forces.end(),
-                          Tensor<1, spacedim, double>());
-                std::fill(cell_rhs.begin(), cell_rhs.end(), 0.0);
-                auto &extractor = fe_values[FEValuesExtractors::Vector(0)];
-
-                bool touched_stress = false;
-                bool touched_force  = false;
-                for (const ForceContribution<dim, spacedim> *fc :
-                     current_forces)
-                  {
-                    if (fc->is_stress())
-                      {
-                        touched_stress = true;
-                        std::fill(one_stress.begin(),
-                                  one_stress.end(),
-                                  Tensor<2, spacedim, double>());
-                        auto view =
-                          make_array_view(one_stress.begin(), one_stress.end());
-                        fc->compute_stress(time, me_values, cell, view);
-                        for (unsigned int qp_n = 0; qp_n < n_quadrature_points;
-                             ++qp_n)
-                          accumulated_stresses[qp_n] += one_stress[qp_n];
-                      }
-                    else if (fc->is_volume_force())
-                      {
-                        touched_force = true;
-                        std::fill(one_force.begin(),
-                                  one_force.end(),
-                                  Tensor<1, spacedim, double>());
-                        auto view =
-                          make_array_view(one_force.begin(), one_force.end());
-                        fc->compute_volume_force(time, me_values, cell, view);
-                        for (unsigned int qp_n = 0; qp_n < n_quadrature_points;
-                             ++qp_n)
-                          accumulated_forces[qp_n] += one_force[qp_n];
-                      }
-                  }
-
-                if (touched_stress && current_as)
-                  {
-                    auto view = make_array_view(pull_accumulated_stresses_back);
-                    current_as->pull_stress_back(
-                      cell, make_array_view(accumulated_stresses), view);
-                  }
-                else
-                  pull_accumulated_stresses_back.swap(accumulated_stresses);
-
-                // Assemble the RHS vector
-                //
-                // TODO - we could make this a lot faster by exploiting the
-                // fact that we have primitive FEs most of the time
-                for (unsigned int qp_n = 0; qp_n < n_quadrature_points; ++qp_n)
-                  {
-                    if (touched_stress)
-                      for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
-                        // -PP : grad phi dx
-                        cell_rhs[i] +=
-                          -1. *
-                          scalar_product(pull_accumulated_stresses_back[qp_n],
-                                         extractor.gradient(i, qp_n)) *
-                          fe_values.JxW(qp_n);
-                    if (touched_force)
-                      for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
-                        // F . phi dx
-                        cell_rhs[i] +=
-                          scalar_product(accumulated_forces[qp_n],
-                                         extractor.value(i, qp_n)) *
-                          fe_values.JxW(qp_n);
-                  }
-
-                force_rhs.add(cell_dofs, cell_rhs);
+                compute_pk1_load_vector_matrix_free(*matrix_free,
+                                                    group,
+                                                    as_map,
+                                                    time,
+                                                    current_position,
+                                                    force_rhs);
+                continue;
               }
           }
+        else
+          (void)matrix_free;
+
+        if (const auto *table =
+              find_reference_shape_gradients(reference_shape_gradients,
+                                             dof_handler,
+                                             group,
+                                             active_strains))
+          {
+            sample_scratch_data.table_groups.emplace_back(*table,
+                                                          group,
+                                                          current_position);
+            continue;
+          }
+
+        sample_scratch_data.volume_groups.emplace_back(
+          mapping,
+          fe,
+          group.front()->get_cell_quadrature(),
+          group,
+          current_position,
+          current_velocity);
+      }
+    // Otherwise the diagnostics get their own MechanicsValues, which are still
+    // computed in the same cell loop.
+    if (diagnostics && !found_diagnostics_group)
+      {
+        sample_scratch_data.diagnostics_group =
+          sample_scratch_data.volume_groups.size();
+        sample_scratch_data.volume_groups.emplace_back(
+          mapping,
+          fe,
+          diagnostics->get_quadrature(),
+          std::vector<ForceContribution<dim, spacedim> *>(),
+          current_position,
+          current_velocity,
+          diagnostics->get_mechanics_update_flags());
       }
 
-    // the boundary stuff is totally different anyway
-    compute_boundary_force_load_vector(dof_handler,
-                                       mapping,
-                                       boundary_force_contributions,
-                                       time,
-                                       current_position,
-                                       current_velocity,
-                                       force_rhs);
+    setup_boundary_groups(dof_handler,
+                          mapping,
+                          boundary_force_contributions,
+                          current_position,
+                          current_velocity,
+                          sample_scratch_data);
+    FDL_MARKER_SCOPE(marker, "fdl_load_vector_assembly");
+    assemble_load_vector(dof_handler,
+                         sample_scratch_data,
+                         as_map,
+                         boundary_faces,
+                         time,
+                         force_rhs,
+                         diagnostics);
   }
 
   template void
@@ -452,7 +1619,9 @@ namespace fdl
     const double,
     const LinearAlgebra::distributed::Vector<double> &,
     const LinearAlgebra::distributed::Vector<double> &,
-    LinearAlgebra::distributed::Vector<double> &);
+    LinearAlgebra::distributed::Vector<double> &,
+    const MatrixFree<NDIM - 1, double> *,
+    const std::vector<const ReferenceShapeGradients<NDIM - 1, NDIM> *> &);
 
   template void
   compute_volumetric_pk1_load_vector<NDIM, NDIM>(
@@ -463,6 +1632,17 @@ namespace fdl
     const double,
     const LinearAlgebra::distributed::Vector<double> &,
     const LinearAlgebra::distributed::Vector<double> &,
+    LinearAlgebra::distributed::Vector<double> &,
+    const MatrixFree<NDIM, double> *,
+    const std::vector<const ReferenceShapeGradients<NDIM, NDIM> *> &);
+
+  template void
+  compute_linearized_pk1_load_vector<NDIM>(
+    const MatrixFree<NDIM, double> &,
+    const std::vector<ForceContribution<NDIM, NDIM> *> &,
+    const double,
+    const LinearAlgebra::distributed::Vector<double> &,
+    const LinearAlgebra::distributed::Vector<double> &,
     LinearAlgebra::distributed::Vector<double> &);
 
   template void
@@ -483,7 +1663,8 @@ namespace fdl
     const double,
     const LinearAlgebra::distributed::Vector<double> &,
     const LinearAlgebra::distributed::Vector<double> &,
-    LinearAlgebra::distributed::Vector<double> &);
+    LinearAlgebra::distributed::Vector<double> &,
+    const BoundaryFaces<NDIM, NDIM> *);
 
   template void
   compute_boundary_force_load_vector<NDIM - 1, NDIM>(
@@ -493,7 +1674,8 @@ namespace fdl
     const double,
     const LinearAlgebra::distributed::Vector<double> &,
     const LinearAlgebra::distributed::Vector<double> &,
-    LinearAlgebra::distributed::Vector<double> &);
+    LinearAlgebra::distributed::Vector<double> &,
+    const BoundaryFaces<NDIM - 1, NDIM> *);
 
   template void
   compute_volumetric_force_load_vector<NDIM, NDIM>(
@@ -514,7 +1696,11 @@ namespace fdl
     const double,
     const LinearAlgebra::distributed::Vector<double> &,
     const LinearAlgebra::distributed::Vector<double> &,
-    LinearAlgebra::distributed::Vector<double> &);
+    LinearAlgebra::distributed::Vector<double> &,
+    const MatrixFree<NDIM - 1, double> *,
+    const std::vector<const ReferenceShapeGradients<NDIM - 1, NDIM> *> &,
+    const BoundaryFaces<NDIM - 1, NDIM> *,
+    MechanicsDiagnostics<NDIM - 1, NDIM> *);
 
   template void
   compute_load_vector<NDIM, NDIM>(
@@ -525,5 +1711,9 @@ namespace fdl
     const double,
     const LinearAlgebra::distributed::Vector<double> &,
     const LinearAlgebra::distributed::Vector<double> &,
-    LinearAlgebra::distributed::Vector<double> &);
+    LinearAlgebra::distributed::Vector<double> &,
+    const MatrixFree<NDIM, double> *,
+    const std::vector<const ReferenceShapeGradients<NDIM, NDIM> *> &,
+    const BoundaryFaces<NDIM, NDIM> *,
+    MechanicsDiagnostics<NDIM, NDIM> *);
 } // namespace fdl
@@ -10,11 +10,32 @@
 #include <deal.II/lac/vector.h>
 
 #include <cmath>
+#include <type_traits>
 
 namespace fdl
 {
   using namespace dealii;
 
+  namespace
+  {
+    // std::cbrt() is not overloaded for VectorizedArray
+    inline double
+    cube_root(const double x)
+    {
+      return std::cbrt(x);
+    }
+
+    template <typename Number>
+    VectorizedArray<Number>
+    cube_root(const VectorizedArray<Number> &x)
+    {
+      VectorizedArray<Number> result;
+      for (unsigned int v = 0; v < VectorizedArray<Number>::size(); ++v)
+        result[v] = std::cbrt(x[v]);
+      return result;
+    }
+  } // namespace
+
   MechanicsUpdateFlags
   resolve_flag_dependencies(const MechanicsUpdateFlags me_flags)
   {
@@ -86,8 +107,8 @@ namespace fdl
 
   // Constructors and reinitialization
 
-  template <int dim, int spacedim, typename VectorType>
-  MechanicsValues<dim, spacedim, VectorType>::MechanicsValues(
+  template <int dim, int spacedim, typename VectorType, typename Number>
+  MechanicsValues<dim, spacedim, VectorType, Number>::MechanicsValues(
     const FEValuesBase<dim, spacedim> &fe_values,
     const VectorType                  &position,
     const VectorType                  &velocity,
@@ -148,8 +169,8 @@ namespace fdl
     resize(this->fe_values->n_quadrature_points);
   }
 
-  template <int dim, int spacedim, typename VectorType>
-  MechanicsValues<dim, spacedim, VectorType>::MechanicsValues(
+  template <int dim, int spacedim, typename VectorType, typename Number>
+  MechanicsValues<dim, spacedim, VectorType, Number>::MechanicsValues(
     const MechanicsUpdateFlags flags)
     : update_flags(resolve_flag_dependencies(flags))
   {
@@ -164,9 +185,10 @@ namespace fdl
   }
 
 
-  template <int dim, int spacedim, typename VectorType>
+  template <int dim, int spacedim, typename VectorType, typename Number>
   void
-  MechanicsValues<dim, spacedim, VectorType>::resize(const std::size_t size)
+  MechanicsValues<dim, spacedim, VectorType, Number>::resize(
+    const std::size_t size)
   {
     // basic terms dependent on the deformation gradient:
     if (update_flags & MechanicsUpdateFlags::update_FF)
@@ -215,10 +237,11 @@ namespace fdl
       modified_first_invariant_dFF.resize(size);
   }
 
-  template <int dim, int spacedim, typename VectorType>
+  template <int dim, int spacedim, typename VectorType, typename Number>
   template <typename Iterator>
   void
-  MechanicsValues<dim, spacedim, VectorType>::reinit(const Iterator &cell)
+  MechanicsValues<dim, spacedim, VectorType, Number>::reinit(
+    const Iterator &cell)
   {
     static_assert(
       std::is_same<
@@ -271,9 +294,9 @@ namespace fdl
         scratch_velocity_values, velocity_values);
   }
 
-  template <int dim, int spacedim, typename VectorType>
+  template <int dim, int spacedim, typename VectorType, typename Number>
   void
-  MechanicsValues<dim, spacedim, VectorType>::reinit(
+  MechanicsValues<dim, spacedim, VectorType, Number>::reinit(
     const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell,
     const ActiveStrain<dim, spacedim> &active_strain)
   {
@@ -326,10 +349,10 @@ namespace fdl
   }
 
 
-  template <int dim, int spacedim, typename VectorType>
+  template <int dim, int spacedim, typename VectorType, typename Number>
   void
-  MechanicsValues<dim, spacedim, VectorType>::reinit(
-    const std::vector<Tensor<2, spacedim>> &provided_FF)
+  MechanicsValues<dim, spacedim, VectorType, Number>::reinit(
+    const std::vector<Tensor<2, spacedim, Number>> &provided_FF)
   {
     Assert(!(update_flags & update_velocity_values),
            ExcMessage("This reinit() function cannot be used to compute "
@@ -351,9 +374,9 @@ namespace fdl
     reinit_from_FF();
   }
 
-  template <int dim, int spacedim, typename VectorType>
+  template <int dim, int spacedim, typename VectorType, typename Number>
   void
-  MechanicsValues<dim, spacedim, VectorType>::reinit_from_FF()
+  MechanicsValues<dim, spacedim, VectorType, Number>::reinit_from_FF()
   {
     for (unsigned int q = 0; q < FF.size(); ++q)
       {
@@ -365,25 +388,27 @@ namespace fdl
           {
             // It is slightly more accurate (according to herbie) to do
             // division, cbrt, and then multiply
-            const auto temp = std::cbrt(1.0 / det_FF[q]);
+            const auto temp = cube_root(1.0 / det_FF[q]);
             n23_det_FF[q]   = temp * temp;
           }
         if (update_flags & update_log_det_FF)
           {
             log_det_FF[q] = std::log(det_FF[q]);
           }
-        if (update_flags & update_deformed_normal_vectors)
-          {
-            Assert(fe_values, ExcFDLInternalError());
-            deformed_normal_vectors[q] =
-              FF_inv_T[q] * fe_values->normal_vector(q);
-            deformed_normal_vectors[q] /= deformed_normal_vectors[q].norm();
-          }
+        // Vectorized values are only computed from provided values of FF
+        if constexpr (std::is_same_v<Number, double>)
+          if (update_flags & update_deformed_normal_vectors)
+            {
+              Assert(fe_values, ExcFDLInternalError());
+              deformed_normal_vectors[q] =
+                FF_inv_T[q] * fe_values->normal_vector(q);
+              deformed_normal_vectors[q] /= deformed_normal_vectors[q].norm();
+            }
         if (update_flags & update_right_cauchy_green)
           // TODO - get rid of the call to symmetrize()
           {
             Assert(update_flags & update_FF, ExcFDLInternalError());
-            right_cauchy_green[q] = SymmetricTensor<2, spacedim>(
+            right_cauchy_green[q] = SymmetricTensor<2, spacedim, Number>(
               symmetrize(transpose(FF[q]) * FF[q]));
           }
         if (update_flags & update_green)
@@ -425,7 +450,7 @@ namespace fdl
           }
         if (update_flags & update_modified_second_invariant)
           modified_second_invariant[q] =
-            second_invariant[q] * std::pow(n23_det_FF[q], 2);
+            second_invariant[q] * n23_det_FF[q] * n23_det_FF[q];
         if (update_flags & update_third_invariant)
           {
             if (dim == spacedim)
@@ -464,6 +489,19 @@ namespace fdl
                                  NDIM,
                                  LinearAlgebra::distributed::Vector<double>>;
 
+  // Vectorized values only support the FF-based constructor and reinit()
+  template MechanicsValues<NDIM,
+                           NDIM,
+                           LinearAlgebra::distributed::Vector<double>,
+                           VectorizedArray<double>>::
+    MechanicsValues(const MechanicsUpdateFlags flags);
+  template void
+  MechanicsValues<NDIM,
+                  NDIM,
+                  LinearAlgebra::distributed::Vector<double>,
+                  VectorizedArray<double>>::
+    reinit(const std::vector<Tensor<2, NDIM, VectorizedArray<double>>> &);
+
   template void
   MechanicsValues<NDIM - 1, NDIM, Vector<double>>::reinit(
     const DoFHandler<NDIM - 1, NDIM>::active_cell_iterator &cell);
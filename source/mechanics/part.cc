@@ -1,42 +1,11 @@
 #include <fiddle/mechanics/part.h>
 
-#include <deal.II/dofs/dof_tools.h>
-
-#include <deal.II/grid/reference_cell.h>
-
 #include <deal.II/numerics/vector_tools_interpolate.h>
 
 #include <boost/serialization/array_wrapper.hpp>
 
 namespace fdl
 {
-  namespace internal
-  {
-    // matrix_free doesn't work with codim != 0 so we need a helper function
-    template <int dim>
-    void
-    reinit_matrix_free(const Mapping<dim>              &mapping,
-                       const DoFHandler<dim>           &dof_handler,
-                       const AffineConstraints<double> &constraints,
-                       const Quadrature<dim>           &quadrature,
-                       MatrixFree<dim, double>         &matrix_free)
-    {
-      matrix_free.reinit(mapping, dof_handler, constraints, quadrature);
-    }
-
-    template <int dim>
-    void
-    reinit_matrix_free(const Mapping<dim - 1, dim> &,
-                       const DoFHandler<dim - 1, dim> &,
-                       const AffineConstraints<double> &,
-                       const Quadrature<dim - 1> &,
-                       MatrixFree<dim - 1, double> &)
-    {
-      // We shouldn't get here
-      AssertThrow(false, ExcFDLInternalError());
-    }
-  } // namespace internal
-
   template <int dim, int spacedim>
   Part<dim, spacedim>::Part(
     std::shared_ptr<DoFHandler<dim, spacedim>> dh,
@@ -59,12 +28,30 @@ namespace fdl
     std::vector<std::unique_ptr<ActiveStrain<dim, spacedim>>> active_strains,
     const Function<spacedim>                                 &initial_position,
     const Function<spacedim>                                 &initial_velocity)
-    : tria(&dh->get_triangulation())
-    , fe(dh->get_fe().clone())
-    , dof_handler(dh)
+    : Part(std::make_shared<PartGeometry<dim, spacedim>>(dh),
+           std::move(force_contributions),
+           std::move(active_strains),
+           initial_position,
+           initial_velocity)
+  {}
+
+  template <int dim, int spacedim>
+  Part<dim, spacedim>::Part(
+    std::shared_ptr<PartGeometry<dim, spacedim>> geometry,
+    std::vector<std::unique_ptr<ForceContribution<dim, spacedim>>>
+      force_contributions,
+    std::vector<std::unique_ptr<ActiveStrain<dim, spacedim>>> active_strains,
+    const Function<spacedim>                                 &initial_position,
+    const Function<spacedim>                                 &initial_velocity)
+    : geometry(geometry)
+    , n_mass_preconditioner_corrections(0)
+    , pipelined_mass_solver(false)
     , force_contributions(std::move(force_contributions))
     , active_strains(std::move(active_strains))
   {
+    AssertThrow(this->geometry,
+                ExcMessage("The geometry must not be nullptr"));
+
     // Verify that the forces are valid:
     for (const auto &f : this->force_contributions)
       {
@@ -111,123 +98,45 @@ namespace fdl
                          "active strains."));
       }
 
-    const auto &reference_cells = this->tria->get_reference_cells();
-    AssertThrow(reference_cells.size() == 1, ExcFDLNotImplemented());
-    mapping = reference_cells.front()
-                .template get_default_linear_mapping<dim, spacedim>()
-                .clone();
-    quadrature =
-      reference_cells.front().template get_gauss_type_quadrature<dim>(
-        fe->tensor_degree() + 1);
-
-    AssertThrow(fe->n_components() == spacedim,
-                ExcMessage("The finite element should have spacedim components "
-                           "since it will represent the position, velocity and "
-                           "force of the part."));
-    // Set up DoFs and finite element fields:
-    dof_handler->distribute_dofs(*fe);
-    constraints.close();
-
-    // A MatrixFree object sets up the partitioning on its own - use that to
-    // avoid issues with p::s::T where there may not be artificial cells
-    //
-    // TODO - understand this issue well enough to file a bug report
-    matrix_free = std::make_shared<MatrixFree<dim, double>>();
-    if (dim == spacedim)
-      {
-        // matrix-free is only implemented in codim 0
-        internal::reinit_matrix_free(
-          *mapping, *dof_handler, constraints, quadrature, *matrix_free);
-        partitioner = matrix_free->get_vector_partitioner();
-      }
-    else
-      {
-        IndexSet locally_relevant_dofs;
-        DoFTools::extract_locally_relevant_dofs(*dof_handler,
-                                                locally_relevant_dofs);
-        partitioner = std::make_shared<Utilities::MPI::Partitioner>(
-          dof_handler->locally_owned_dofs(),
-          locally_relevant_dofs,
-          tria->get_communicator());
-      }
-
-    position.reinit(partitioner);
-    velocity.reinit(partitioner);
-
-    // Set up matrix free components:
-    if (dim == spacedim)
-      {
-        if (reference_cells.front() == ReferenceCells::get_hypercube<dim>())
-          {
-            using namespace MatrixFreeOperators;
-            switch (fe->tensor_degree())
-              {
-                case 1:
-                  mass_operator.reset(new MassOperator<dim, 1, 1 + 1, dim>());
-                  break;
-                case 2:
-                  mass_operator.reset(new MassOperator<dim, 2, 2 + 1, dim>());
-                  break;
-                case 3:
-                  mass_operator.reset(new MassOperator<dim, 3, 3 + 1, dim>());
-                  break;
-                case 4:
-                  mass_operator.reset(new MassOperator<dim, 4, 4 + 1, dim>());
-                  break;
-                case 5:
-                  mass_operator.reset(new MassOperator<dim, 5, 5 + 1, dim>());
-                  break;
-                default:
-                  AssertThrow(false, ExcFDLNotImplemented());
-              }
-          }
-        else
-          {
-            using namespace MatrixFreeOperators;
-            switch (fe->tensor_degree())
-              {
-                case 1:
-                  mass_operator.reset(new MassOperator<dim, -1, 0, dim>());
-                  break;
-                case 2:
-                  mass_operator.reset(new MassOperator<dim, -1, 0, dim>());
-                  break;
-                case 3:
-                  mass_operator.reset(new MassOperator<dim, -1, 0, dim>());
-                  break;
-                default:
-                  AssertThrow(false, ExcFDLNotImplemented());
-              }
-          }
-        mass_operator->initialize(matrix_free);
-        mass_operator->compute_diagonal();
-        mass_preconditioner.initialize(*mass_operator, 1.0);
-      }
+    position.reinit(get_partitioner());
+    velocity.reinit(get_partitioner());
 
     // finally, FE fields:
-    VectorTools::interpolate(*dof_handler, initial_position, position);
+    VectorTools::interpolate(get_dof_handler(), initial_position, position);
     // The initial velocity is probably zero:
     if (dynamic_cast<const Functions::ZeroFunction<dim> *>(&initial_velocity))
       velocity = 0.0;
     else
-      VectorTools::interpolate(*dof_handler, initial_velocity, velocity);
+      VectorTools::interpolate(get_dof_handler(), initial_velocity, velocity);
+    // Make the fields continuous at hanging nodes:
+    if (this->geometry->has_constraints())
+      {
+        this->geometry->get_constraints().distribute(position);
+        this->geometry->get_constraints().distribute(velocity);
+      }
 
     position.update_ghost_values();
     velocity.update_ghost_values();
   }
 
-  namespace
-  {
-    template <int dim, int spacedim>
-    std::shared_ptr<DoFHandler<dim, spacedim>>
-    setup_dof_handler(const Triangulation<dim, spacedim> &tria,
-                      const FiniteElement<dim, spacedim> &fe)
-    {
-      auto dof_handler = std::make_shared<DoFHandler<dim, spacedim>>(tria);
-      dof_handler->distribute_dofs(fe);
-      return dof_handler;
-    }
-  } // namespace
+  template <int dim, int spacedim>
+  Part<dim, spacedim>::Part(
+    const MPI_Comm                      communicator,
+    PartMeshData<dim, spacedim>       &&mesh_data,
+    const FiniteElement<dim, spacedim> &fe,
+    std::vector<std::unique_ptr<ForceContribution<dim, spacedim>>>
+      force_contributions,
+    std::vector<std::unique_ptr<ActiveStrain<dim, spacedim>>> active_strains,
+    const Function<spacedim>                                 &initial_position,
+    const Function<spacedim>                                 &initial_velocity)
+    : Part(std::make_shared<PartGeometry<dim, spacedim>>(communicator,
+                                                         std::move(mesh_data),
+                                                         fe),
+           std::move(force_contributions),
+           std::move(active_strains),
+           initial_position,
+           initial_velocity)
+  {}
 
   template <int dim, int spacedim>
   Part<dim, spacedim>::Part(
@@ -237,7 +146,7 @@ namespace fdl
                               force_contributions,
     const Function<spacedim> &initial_position,
     const Function<spacedim> &initial_velocity)
-    : Part(setup_dof_handler(tria, fe),
+    : Part(std::make_shared<PartGeometry<dim, spacedim>>(tria, fe),
            std::move(force_contributions),
            {},
            initial_position,
@@ -253,13 +162,31 @@ namespace fdl
     std::vector<std::unique_ptr<ActiveStrain<dim, spacedim>>> active_strains,
     const Function<spacedim>                                 &initial_position,
     const Function<spacedim>                                 &initial_velocity)
-    : Part(setup_dof_handler(tria, fe),
+    : Part(std::make_shared<PartGeometry<dim, spacedim>>(tria, fe),
            std::move(force_contributions),
            std::move(active_strains),
            initial_position,
            initial_velocity)
   {}
 
+  template <int dim, int spacedim>
+  Part<dim, spacedim>::Part(
+    const Part<dim, spacedim> &other,
+    std::vector<std::unique_ptr<ForceContribution<dim, spacedim>>>
+      force_contributions,
+    std::vector<std::unique_ptr<ActiveStrain<dim, spacedim>>> active_strains)
+    : Part(other.get_geometry(),
+           std::move(force_contributions),
+           std::move(active_strains),
+           Functions::ZeroFunction<spacedim>(spacedim),
+           Functions::ZeroFunction<spacedim>(spacedim))
+  {
+    position.copy_locally_owned_data_from(other.get_position());
+    velocity.copy_locally_owned_data_from(other.get_velocity());
+    position.update_ghost_values();
+    velocity.update_ghost_values();
+  }
+
   template <int dim, int spacedim>
   void
   Part<dim, spacedim>::save(boost::archive::binary_oarchive &archive,
@@ -275,6 +202,7 @@ namespace fdl
                             const unsigned int               version)
   {
     serialize(archive, version);
+    ++position_version;
 
     position.update_ghost_values();
     velocity.update_ghost_values();
@@ -326,6 +254,74 @@ namespace fdl
     force_contributions.push_back(std::move(force));
   }
 
+  template <int dim, int spacedim>
+  void
+  Part<dim, spacedim>::setup_reference_shape_gradients(
+    const Quadrature<dim> &quadrature)
+  {
+    geometry->setup_reference_shape_gradients(quadrature);
+  }
+
+  template <int dim, int spacedim>
+  std::vector<const ReferenceShapeGradients<dim, spacedim> *>
+  Part<dim, spacedim>::get_reference_shape_gradients() const
+  {
+    return geometry->get_reference_shape_gradients();
+  }
+
+  template <int dim, int spacedim>
+  bool
+  Part<dim, spacedim>::has_same_mass_operator(
+    const Part<dim, spacedim> &other) const
+  {
+    return geometry->has_same_mass_operator(*other.geometry);
+  }
+
+  template <int dim, int spacedim>
+  void
+  Part<dim, spacedim>::apply_mass_operator(
+    const std::vector<LinearAlgebra::distributed::Vector<double> *> &dst,
+    const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+      &src) const
+  {
+    geometry->apply_mass_operator(dst, src);
+  }
+
+  template <int dim, int spacedim>
+  void
+  Part<dim, spacedim>::apply_approximate_mass_inverse(
+    LinearAlgebra::distributed::Vector<double>       &dst,
+    const LinearAlgebra::distributed::Vector<double> &src,
+    const unsigned int                                n_corrections) const
+  {
+    geometry->apply_approximate_mass_inverse(dst, src, n_corrections);
+  }
+
+  template <int dim, int spacedim>
+  std::vector<unsigned int>
+  Part<dim, spacedim>::solve_mass_systems(
+    const std::vector<LinearAlgebra::distributed::Vector<double> *> &solutions,
+    const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+                      &right_hand_sides,
+    const unsigned int max_iterations,
+    const double       relative_tolerance) const
+  {
+    return geometry->solve_mass_systems(solutions,
+                                        right_hand_sides,
+                                        max_iterations,
+                                        relative_tolerance,
+                                        n_mass_preconditioner_corrections,
+                                        pipelined_mass_solver);
+  }
+
+  template <int dim, int spacedim>
+  std::size_t
+  Part<dim, spacedim>::memory_consumption(const bool include_geometry) const
+  {
+    return position.memory_consumption() + velocity.memory_consumption() +
+           (include_geometry ? geometry->memory_consumption() : 0);
+  }
+
   template class Part<NDIM - 1, NDIM>;
   template class Part<NDIM, NDIM>;
 } // namespace fdl
@@ -0,0 +1,438 @@
+#include <fiddle/base/exceptions.h>
+#include <fiddle/base/samrai_utilities.h>
+
+#include <fiddle/mechanics/part_cache.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/grid/tria_description.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <type_traits>
+
+namespace fdl
+{
+  namespace
+  {
+    constexpr char cache_magic[8] = {'F', 'D', 'L', 'C', 'A', 'C', 'H', 'E'};
+
+    constexpr std::uint64_t cache_format_version = 1;
+
+    // Update a 64-bit FNV-1a hash with the contents of a file.
+    std::uint64_t
+    hash_file(const std::string &file_name, std::uint64_t hash)
+    {
+      std::ifstream in(file_name, std::ios::binary);
+      AssertThrow(in, ExcMessage("Unable to open " + file_name));
+      std::vector<char> buffer(1 << 20);
+      while (in)
+        {
+          in.read(buffer.data(), buffer.size());
+          const std::streamsize n_read = in.gcount();
+          for (std::streamsize i = 0; i < n_read; ++i)
+            {
+              hash ^= static_cast<unsigned char>(buffer[i]);
+              hash *= 1099511628211ull;
+            }
+        }
+      return hash;
+    }
+
+    template <typename T>
+    void
+    write_array(std::ostream &out, const std::vector<T> &values)
+    {
+      static_assert(std::is_trivially_copyable<T>::value,
+                    "Only trivially copyable types can be cached");
+      const std::uint64_t size = values.size();
+      out.write(reinterpret_cast<const char *>(&size), sizeof(size));
+      out.write(reinterpret_cast<const char *>(values.data()),
+                sizeof(T) * size);
+    }
+
+    template <typename T>
+    std::vector<T>
+    read_array(std::istream &in)
+    {
+      static_assert(std::is_trivially_copyable<T>::value,
+                    "Only trivially copyable types can be cached");
+      std::uint64_t size = 0;
+      in.read(reinterpret_cast<char *>(&size), sizeof(size));
+      AssertThrow(in, ExcMessage("The cache file is truncated."));
+      std::vector<T> values(size);
+      in.read(reinterpret_cast<char *>(values.data()), sizeof(T) * size);
+      AssertThrow(in, ExcMessage("The cache file is truncated."));
+      return values;
+    }
+
+    // Write a file under a temporary name and then move it into place so
+    // that readers never see partially written files.
+    template <typename WriteFunction>
+    void
+    write_file(const std::string   &file_name,
+               const std::string   &key,
+               const int            dim,
+               const int            spacedim,
+               const WriteFunction &write)
+    {
+      const std::string temporary_file_name = file_name + ".tmp";
+      {
+        std::ofstream out(temporary_file_name, std::ios::binary);
+        AssertThrow(out,
+                    ExcMessage("Unable to open " + temporary_file_name +
+                               " for writing."));
+        out.write(cache_magic, sizeof(cache_magic));
+        write_array(out,
+                    std::vector<std::uint64_t>{
+                      cache_format_version,
+                      std::uint64_t(dim),
+                      std::uint64_t(spacedim),
+                      sizeof(types::global_dof_index)});
+        write_array(out, std::vector<char>(key.begin(), key.end()));
+        write(out);
+        AssertThrow(out,
+                    ExcMessage("Unable to write " + temporary_file_name));
+      }
+      const int ierr =
+        std::rename(temporary_file_name.c_str(), file_name.c_str());
+      AssertThrow(ierr == 0,
+                  ExcMessage("Unable to rename " + temporary_file_name +
+                             " to " + file_name));
+    }
+
+    // Open a cache file and check its header.
+    std::ifstream
+    open_file(const std::string &file_name,
+              const std::string &key,
+              const int          dim,
+              const int          spacedim)
+    {
+      std::ifstream in(file_name, std::ios::binary);
+      AssertThrow(in, ExcMessage("Unable to open " + file_name));
+
+      char magic[sizeof(cache_magic)] = {};
+      in.read(magic, sizeof(magic));
+      AssertThrow(in && std::equal(std::begin(magic),
+                                   std::end(magic),
+                                   std::begin(cache_magic)),
+                  ExcMessage(file_name + " is not a fiddle cache file."));
+      const auto header = read_array<std::uint64_t>(in);
+      AssertThrow(header.size() == 4 && header[0] == cache_format_version,
+                  ExcMessage(file_name + " has an unsupported format."));
+      AssertThrow(header[1] == std::uint64_t(dim) &&
+                    header[2] == std::uint64_t(spacedim) &&
+                    header[3] == sizeof(types::global_dof_index),
+                  ExcMessage(file_name + " was written by a different "
+                                         "configuration of fiddle."));
+      const auto file_key = read_array<char>(in);
+      AssertThrow(std::string(file_key.begin(), file_key.end()) == key,
+                  ExcMessage(file_name + " does not match the cache key."));
+      return in;
+    }
+  } // namespace
+
+  template <int dim, int spacedim>
+  PartCache<dim, spacedim>::PartCache(
+    const std::string              &directory,
+    const std::vector<std::string> &input_files,
+    const MPI_Comm                  comm)
+    : communicator(comm)
+    , directory(directory)
+  {
+    FDL_SETUP_TIMER_AND_SCOPE(t_part_cache, "fdl::PartCache::PartCache()");
+    if (!this->directory.empty() && this->directory.back() != '/')
+      this->directory += '/';
+
+    std::uint64_t hash = 14695981039346656037ull;
+    if (Utilities::MPI::this_mpi_process(comm) == 0)
+      for (const std::string &file_name : input_files)
+        hash = hash_file(file_name, hash);
+    hash = Utilities::MPI::broadcast(comm, hash, 0);
+
+    std::ostringstream key_stream;
+    key_stream << std::hex << std::setw(16) << std::setfill('0') << hash
+               << std::dec << '_' << Utilities::MPI::n_mpi_processes(comm);
+    key = key_stream.str();
+  }
+
+  template <int dim, int spacedim>
+  std::string
+  PartCache<dim, spacedim>::get_file_name(const std::string &name,
+                                          const bool per_processor) const
+  {
+    std::string file_name = directory + "part_cache_" + key + "_" + name;
+    if (per_processor)
+      file_name += "." + Utilities::int_to_string(
+                           Utilities::MPI::this_mpi_process(communicator), 4);
+    return file_name + ".bin";
+  }
+
+  template <int dim, int spacedim>
+  bool
+  PartCache<dim, spacedim>::file_exists(const std::string &name,
+                                        const bool per_processor) const
+  {
+    bool exists = true;
+    if (per_processor || Utilities::MPI::this_mpi_process(communicator) == 0)
+      exists = std::ifstream(get_file_name(name, per_processor)).good();
+    return Utilities::MPI::min(int(exists), communicator) == 1;
+  }
+
+  template <int dim, int spacedim>
+  bool
+  PartCache<dim, spacedim>::has_triangulation() const
+  {
+    return file_exists("triangulation", false);
+  }
+
+  template <int dim, int spacedim>
+  void
+  PartCache<dim, spacedim>::save_triangulation(
+    const Triangulation<dim, spacedim> &tria) const
+  {
+    FDL_SETUP_TIMER_AND_SCOPE(t_save_triangulation,
+                              "fdl::PartCache::save_triangulation()");
+    AssertThrow(tria.n_levels() == 1,
+                ExcMessage("Only unrefined Triangulations can be cached."));
+    AssertThrow(tria.get_reference_cells().size() == 1,
+                ExcFDLNotImplemented());
+    if (Utilities::MPI::this_mpi_process(communicator) == 0)
+      {
+        std::vector<double> vertices;
+        for (const Point<spacedim> &vertex : tria.get_vertices())
+          for (unsigned int d = 0; d < spacedim; ++d)
+            vertices.push_back(vertex[d]);
+
+        const ReferenceCell reference_cell = tria.get_reference_cells()[0];
+        std::vector<unsigned int>       cell_vertices;
+        std::vector<types::material_id> material_ids;
+        std::vector<types::manifold_id> manifold_ids;
+        std::vector<types::boundary_id> face_boundary_ids;
+        for (const auto &cell : tria.cell_iterators_on_level(0))
+          {
+            for (const unsigned int v : cell->vertex_indices())
+              cell_vertices.push_back(cell->vertex_index(v));
+            material_ids.push_back(cell->material_id());
+            manifold_ids.push_back(cell->manifold_id());
+            for (const unsigned int f : cell->face_indices())
+              face_boundary_ids.push_back(
+                cell->face(f)->at_boundary() ?
+                  cell->face(f)->boundary_id() :
+                  numbers::internal_face_boundary_id);
+          }
+
+        write_file(get_file_name("triangulation", false),
+                   key,
+                   dim,
+                   spacedim,
+                   [&](std::ostream &out)
+                   {
+                     write_array(out,
+                                 std::vector<std::uint64_t>{
+                                   reference_cell.n_vertices(),
+                                   reference_cell.n_faces()});
+                     write_array(out, vertices);
+                     write_array(out, cell_vertices);
+                     write_array(out, material_ids);
+                     write_array(out, manifold_ids);
+                     write_array(out, face_boundary_ids);
+                   });
+      }
+
+    // Make sure the file exists before anyone tries to read it
+    const int ierr = MPI_Barrier(communicator);
+    AssertThrowMPI(ierr);
+  }
+
+  template <int dim, int spacedim>
+  void
+  PartCache<dim, spacedim>::load_triangulation(
+    Triangulation<dim, spacedim> &tria) const
+  {
+    FDL_SETUP_TIMER_AND_SCOPE(t_load_triangulation,
+                              "fdl::PartCache::load_triangulation()");
+    AssertThrow(tria.n_cells() == 0,
+                ExcMessage("The Triangulation must be empty."));
+    std::ifstream in =
+      open_file(get_file_name("triangulation", false), key, dim, spacedim);
+
+    const auto sizes             = read_array<std::uint64_t>(in);
+    const auto vertex_values     = read_array<double>(in);
+    const auto cell_vertices     = read_array<unsigned int>(in);
+    const auto material_ids      = read_array<types::material_id>(in);
+    const auto manifold_ids      = read_array<types::manifold_id>(in);
+    const auto face_boundary_ids = read_array<types::boundary_id>(in);
+    AssertThrow(sizes.size() == 2, ExcMessage("The cache file is corrupt."));
+    const unsigned int n_vertices_per_cell = sizes[0];
+    const unsigned int n_faces_per_cell    = sizes[1];
+    const std::size_t  n_cells             = material_ids.size();
+    AssertThrow(vertex_values.size() % spacedim == 0 &&
+                  cell_vertices.size() == n_cells * n_vertices_per_cell &&
+                  manifold_ids.size() == n_cells &&
+                  face_boundary_ids.size() == n_cells * n_faces_per_cell,
+                ExcMessage("The cache file is corrupt."));
+
+    std::vector<Point<spacedim>> vertices(vertex_values.size() / spacedim);
+    for (std::size_t i = 0; i < vertices.size(); ++i)
+      for (unsigned int d = 0; d < spacedim; ++d)
+        vertices[i][d] = vertex_values[i * spacedim + d];
+
+    std::vector<CellData<dim>> cells(n_cells);
+    for (std::size_t i = 0; i < n_cells; ++i)
+      {
+        cells[i].vertices.assign(cell_vertices.begin() +
+                                   i * n_vertices_per_cell,
+                                 cell_vertices.begin() +
+                                   (i + 1) * n_vertices_per_cell);
+        cells[i].material_id = material_ids[i];
+        cells[i].manifold_id = manifold_ids[i];
+      }
+    tria.create_triangulation(vertices, cells, SubCellData());
+
+    // Coarse cells are created in the given order
+    std::size_t i = 0;
+    for (const auto &cell : tria.cell_iterators_on_level(0))
+      {
+        for (const unsigned int f : cell->face_indices())
+          if (cell->face(f)->at_boundary())
+            cell->face(f)->set_boundary_id(
+              face_boundary_ids[i * n_faces_per_cell + f]);
+        ++i;
+      }
+  }
+
+  template <int dim, int spacedim>
+  bool
+  PartCache<dim, spacedim>::has_dof_numbering() const
+  {
+    return file_exists("dofs", true);
+  }
+
+  template <int dim, int spacedim>
+  void
+  PartCache<dim, spacedim>::save_dof_numbering(
+    const DoFHandler<dim, spacedim> &dof_handler) const
+  {
+    FDL_SETUP_TIMER_AND_SCOPE(t_save_dof_numbering,
+                              "fdl::PartCache::save_dof_numbering()");
+    // Determine the current number of each DoF in the default numbering
+    DoFHandler<dim, spacedim> default_dof_handler(
+      dof_handler.get_triangulation());
+    default_dof_handler.distribute_dofs(dof_handler.get_fe());
+    const IndexSet &locally_owned_dofs =
+      default_dof_handler.locally_owned_dofs();
+    AssertThrow(locally_owned_dofs == dof_handler.locally_owned_dofs(),
+                ExcMessage("The renumbering must not change the DoFs owned "
+                           "by each processor."));
+
+    std::vector<types::global_dof_index> new_numbers(
+      locally_owned_dofs.n_elements(), numbers::invalid_dof_index);
+    std::vector<types::global_dof_index> default_dofs;
+    std::vector<types::global_dof_index> dofs;
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          const typename DoFHandler<dim, spacedim>::active_cell_iterator
+            default_cell(&dof_handler.get_triangulation(),
+                         cell->level(),
+                         cell->index(),
+                         &default_dof_handler);
+          dofs.resize(cell->get_fe().n_dofs_per_cell());
+          default_dofs.resize(dofs.size());
+          cell->get_dof_indices(dofs);
+          default_cell->get_dof_indices(default_dofs);
+          for (std::size_t i = 0; i < dofs.size(); ++i)
+            if (locally_owned_dofs.is_element(default_dofs[i]))
+              new_numbers[locally_owned_dofs.index_within_set(
+                default_dofs[i])] = dofs[i];
+        }
+
+    const std::string fe_name = dof_handler.get_fe().get_name();
+    write_file(get_file_name("dofs", true),
+               key,
+               dim,
+               spacedim,
+               [&](std::ostream &out)
+               {
+                 write_array(out,
+                             std::vector<char>(fe_name.begin(), fe_name.end()));
+                 write_array(out, new_numbers);
+               });
+  }
+
+  template <int dim, int spacedim>
+  void
+  PartCache<dim, spacedim>::load_dof_numbering(
+    DoFHandler<dim, spacedim> &dof_handler) const
+  {
+    FDL_SETUP_TIMER_AND_SCOPE(t_load_dof_numbering,
+                              "fdl::PartCache::load_dof_numbering()");
+    AssertThrow(dof_handler.has_active_dofs(),
+                ExcMessage("The DoFs must be distributed first."));
+    std::ifstream in =
+      open_file(get_file_name("dofs", true), key, dim, spacedim);
+    const auto fe_name     = read_array<char>(in);
+    const auto new_numbers = read_array<types::global_dof_index>(in);
+    AssertThrow(std::string(fe_name.begin(), fe_name.end()) ==
+                    dof_handler.get_fe().get_name() &&
+                  new_numbers.size() == dof_handler.n_locally_owned_dofs(),
+                ExcMessage("The cached DoF numbering was computed for a "
+                           "different FiniteElement."));
+    dof_handler.renumber_dofs(new_numbers);
+  }
+
+  template <int dim, int spacedim>
+  bool
+  PartCache<dim, spacedim>::has_vector(const std::string &name) const
+  {
+    return file_exists("vector_" + name, true);
+  }
+
+  template <int dim, int spacedim>
+  void
+  PartCache<dim, spacedim>::save_vector(
+    const std::string                                &name,
+    const LinearAlgebra::distributed::Vector<double> &vector) const
+  {
+    const std::vector<double> values(vector.begin(),
+                                     vector.begin() +
+                                       vector.locally_owned_size());
+    write_file(get_file_name("vector_" + name, true),
+               key,
+               dim,
+               spacedim,
+               [&](std::ostream &out)
+               {
+                 write_array(out,
+                             std::vector<std::uint64_t>{vector.size()});
+                 write_array(out, values);
+               });
+  }
+
+  template <int dim, int spacedim>
+  void
+  PartCache<dim, spacedim>::load_vector(
+    const std::string                          &name,
+    LinearAlgebra::distributed::Vector<double> &vector) const
+  {
+    std::ifstream in =
+      open_file(get_file_name("vector_" + name, true), key, dim, spacedim);
+    const auto size   = read_array<std::uint64_t>(in);
+    const auto values = read_array<double>(in);
+    AssertThrow(size.size() == 1 && size[0] == vector.size() &&
+                  values.size() == vector.locally_owned_size(),
+                ExcMessage("The cached vector " + name +
+                           " has a different parallel layout."));
+    std::copy(values.begin(), values.end(), vector.begin());
+    vector.update_ghost_values();
+  }
+
+  template class PartCache<NDIM - 1, NDIM>;
+  template class PartCache<NDIM, NDIM>;
+} // namespace fdl
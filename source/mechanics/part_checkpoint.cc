@@ -0,0 +1,322 @@
+#include <fiddle/base/exceptions.h>
+#include <fiddle/base/samrai_utilities.h>
+
+#include <fiddle/mechanics/part.h>
+#include <fiddle/mechanics/part_checkpoint.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <algorithm>
+#include <array>
+
+namespace fdl
+{
+  namespace
+  {
+    // "FDLCHKPT" as a little-endian integer
+    constexpr std::uint64_t checkpoint_magic = 0x54504B48434C4446ull;
+
+    constexpr std::uint64_t checkpoint_format_version = 1;
+  } // namespace
+
+  template <int dim, int spacedim>
+  std::vector<std::pair<types::global_dof_index, types::global_dof_index>>
+  compute_canonical_dof_indices(const DoFHandler<dim, spacedim> &dof_handler)
+  {
+    const IndexSet &locally_owned_dofs = dof_handler.locally_owned_dofs();
+    std::vector<bool> seen(dof_handler.n_dofs());
+    std::vector<types::global_dof_index> dofs;
+    std::vector<std::pair<types::global_dof_index, types::global_dof_index>>
+                            result;
+    types::global_dof_index n_seen = 0;
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      {
+        AssertThrow(!cell->is_artificial(),
+                    ExcMessage("Canonical DoF indices can only be computed "
+                               "when every cell is available on every "
+                               "processor."));
+        dofs.resize(cell->get_fe().n_dofs_per_cell());
+        cell->get_dof_indices(dofs);
+        for (const types::global_dof_index dof : dofs)
+          if (!seen[dof])
+            {
+              seen[dof] = true;
+              if (locally_owned_dofs.is_element(dof))
+                result.emplace_back(n_seen,
+                                    locally_owned_dofs.index_within_set(dof));
+              ++n_seen;
+            }
+      }
+    Assert(n_seen == dof_handler.n_dofs(), ExcFDLInternalError());
+    // entries are added in increasing canonical order so result is sorted
+
+    return result;
+  }
+
+  PartCheckpoint::PartCheckpoint(const std::string &file_name,
+                                 const Mode         mode,
+                                 const MPI_Comm     comm)
+    : mode(mode)
+    , communicator(comm)
+    , offset(0)
+  {
+    const int amode = mode == Mode::Write ?
+                        MPI_MODE_CREATE | MPI_MODE_WRONLY :
+                        MPI_MODE_RDONLY;
+    int ierr = MPI_File_open(
+      communicator, file_name.c_str(), amode, MPI_INFO_NULL, &file);
+    AssertThrowMPI(ierr);
+    if (mode == Mode::Write)
+      {
+        ierr = MPI_File_set_size(file, 0);
+        AssertThrowMPI(ierr);
+      }
+
+    const std::uint64_t magic = write_or_read_size(checkpoint_magic);
+    AssertThrow(magic == checkpoint_magic,
+                ExcMessage("The file " + file_name +
+                           " is not a part checkpoint file."));
+    const std::uint64_t version =
+      write_or_read_size(checkpoint_format_version);
+    AssertThrow(version == checkpoint_format_version,
+                ExcMessage("The part checkpoint file " + file_name +
+                           " was written with an unsupported format "
+                           "version."));
+  }
+
+  PartCheckpoint::~PartCheckpoint()
+  {
+    MPI_File_close(&file);
+  }
+
+  template <int dim, int spacedim>
+  void
+  PartCheckpoint::save(const Part<dim, spacedim> &part)
+  {
+    save(part, compute_canonical_dof_indices(part.get_dof_handler()));
+  }
+
+  template <int dim, int spacedim>
+  void
+  PartCheckpoint::save(
+    const Part<dim, spacedim> &part,
+    const std::vector<std::pair<types::global_dof_index,
+                                types::global_dof_index>> &canonical_dofs)
+  {
+    FDL_SETUP_TIMER_AND_SCOPE(t_save, "fdl::PartCheckpoint::save()");
+    AssertThrow(mode == Mode::Write,
+                ExcMessage("Cannot save a part to a checkpoint opened for "
+                           "reading."));
+    AssertThrow(canonical_dofs.size() ==
+                  part.get_dof_handler().locally_owned_dofs().n_elements(),
+                ExcMessage("The canonical DoF indices do not match the part."));
+    const std::uint64_t n_dofs =
+      write_or_read_size(part.get_dof_handler().n_dofs());
+
+    std::vector<types::global_dof_index> indices;
+    indices.reserve(canonical_dofs.size());
+    for (const auto &pair : canonical_dofs)
+      indices.push_back(pair.first);
+    std::vector<double> values(canonical_dofs.size());
+    for (const auto *vector : {&part.get_position(), &part.get_velocity()})
+      {
+        for (std::size_t i = 0; i < canonical_dofs.size(); ++i)
+          values[i] = vector->local_element(canonical_dofs[i].second);
+        write_values(indices, values, n_dofs);
+      }
+  }
+
+  template <int dim, int spacedim>
+  void
+  PartCheckpoint::load(Part<dim, spacedim> &part)
+  {
+    load(part, compute_canonical_dof_indices(part.get_dof_handler()));
+  }
+
+  template <int dim, int spacedim>
+  void
+  PartCheckpoint::load(
+    Part<dim, spacedim> &part,
+    const std::vector<std::pair<types::global_dof_index,
+                                types::global_dof_index>> &canonical_dofs)
+  {
+    FDL_SETUP_TIMER_AND_SCOPE(t_load, "fdl::PartCheckpoint::load()");
+    AssertThrow(mode == Mode::Read,
+                ExcMessage("Cannot load a part from a checkpoint opened for "
+                           "writing."));
+    AssertThrow(canonical_dofs.size() ==
+                  part.get_dof_handler().locally_owned_dofs().n_elements(),
+                ExcMessage("The canonical DoF indices do not match the part."));
+    const std::uint64_t n_dofs = write_or_read_size(0);
+    AssertThrow(n_dofs == part.get_dof_handler().n_dofs(),
+                ExcMessage("The number of DoFs in the checkpoint file does "
+                           "not match the number of DoFs of the part."));
+
+    std::vector<types::global_dof_index> indices;
+    indices.reserve(canonical_dofs.size());
+    for (const auto &pair : canonical_dofs)
+      indices.push_back(pair.first);
+    std::vector<double> values(canonical_dofs.size());
+    std::array<LinearAlgebra::distributed::Vector<double>, 2> vectors;
+    for (auto &vector : vectors)
+      {
+        read_values(indices, values, n_dofs);
+        vector.reinit(part.get_partitioner());
+        for (std::size_t i = 0; i < canonical_dofs.size(); ++i)
+          vector.local_element(canonical_dofs[i].second) = values[i];
+        vector.update_ghost_values();
+      }
+    part.set_position(std::move(vectors[0]));
+    part.set_velocity(std::move(vectors[1]));
+  }
+
+  std::uint64_t
+  PartCheckpoint::write_or_read_size(const std::uint64_t size)
+  {
+    std::uint64_t result = size;
+    int           ierr   = 0;
+    if (mode == Mode::Write)
+      {
+        if (Utilities::MPI::this_mpi_process(communicator) == 0)
+          ierr = MPI_File_write_at(
+            file, offset, &result, 1, MPI_UINT64_T, MPI_STATUS_IGNORE);
+      }
+    else
+      ierr = MPI_File_read_at_all(
+        file, offset, &result, 1, MPI_UINT64_T, MPI_STATUS_IGNORE);
+    AssertThrowMPI(ierr);
+    offset += sizeof(result);
+
+    return result;
+  }
+
+  namespace
+  {
+    // Set up a file view in which the calling processor accesses the doubles
+    // at the given indices, relative to the given offset.
+    void
+    set_value_view(MPI_File                                    file,
+                   const MPI_Offset                            offset,
+                   const std::vector<types::global_dof_index> &indices)
+    {
+      Assert(std::is_sorted(indices.begin(), indices.end()),
+             ExcMessage("MPI-IO requires monotonically increasing file "
+                        "displacements."));
+      std::vector<MPI_Aint> displacements(indices.size());
+      for (std::size_t i = 0; i < indices.size(); ++i)
+        displacements[i] = indices[i] * sizeof(double);
+
+      MPI_Datatype file_type;
+      int          ierr = MPI_Type_create_hindexed_block(
+        static_cast<int>(displacements.size()),
+        1,
+        displacements.data(),
+        MPI_DOUBLE,
+        &file_type);
+      AssertThrowMPI(ierr);
+      ierr = MPI_Type_commit(&file_type);
+      AssertThrowMPI(ierr);
+      ierr = MPI_File_set_view(
+        file, offset, MPI_DOUBLE, file_type, "native", MPI_INFO_NULL);
+      AssertThrowMPI(ierr);
+      ierr = MPI_Type_free(&file_type);
+      AssertThrowMPI(ierr);
+    }
+
+    // Reset the view to the whole file, in bytes, so that explicit offsets are
+    // again absolute.
+    void
+    reset_view(MPI_File file)
+    {
+      const int ierr = MPI_File_set_view(
+        file, 0, MPI_BYTE, MPI_BYTE, "native", MPI_INFO_NULL);
+      AssertThrowMPI(ierr);
+    }
+  } // namespace
+
+  void
+  PartCheckpoint::write_values(
+    const std::vector<types::global_dof_index> &indices,
+    const std::vector<double>                  &values,
+    const types::global_dof_index               n_values)
+  {
+    Assert(indices.size() == values.size(), ExcFDLInternalError());
+    set_value_view(file, offset, indices);
+    const int ierr = MPI_File_write_all(file,
+                                        values.data(),
+                                        static_cast<int>(values.size()),
+                                        MPI_DOUBLE,
+                                        MPI_STATUS_IGNORE);
+    AssertThrowMPI(ierr);
+    reset_view(file);
+    offset += n_values * sizeof(double);
+  }
+
+  void
+  PartCheckpoint::read_values(
+    const std::vector<types::global_dof_index> &indices,
+    std::vector<double>                        &values,
+    const types::global_dof_index               n_values)
+  {
+    values.resize(indices.size());
+    set_value_view(file, offset, indices);
+    const int ierr = MPI_File_read_all(file,
+                                       values.data(),
+                                       static_cast<int>(values.size()),
+                                       MPI_DOUBLE,
+                                       MPI_STATUS_IGNORE);
+    AssertThrowMPI(ierr);
+    reset_view(file);
+    offset += n_values * sizeof(double);
+  }
+
+  template std::vector<
+    std::pair<types::global_dof_index, types::global_dof_index>>
+  compute_canonical_dof_indices(const DoFHandler<NDIM - 1, NDIM> &);
+
+  template std::vector<
+    std::pair<types::global_dof_index, types::global_dof_index>>
+  compute_canonical_dof_indices(const DoFHandler<NDIM, NDIM> &);
+
+  template void
+  PartCheckpoint::save(const Part<NDIM - 1, NDIM> &);
+
+  template void
+  PartCheckpoint::save(const Part<NDIM, NDIM> &);
+
+  template void
+  PartCheckpoint::load(Part<NDIM - 1, NDIM> &);
+
+  template void
+  PartCheckpoint::load(Part<NDIM, NDIM> &);
+
+  template void
+  PartCheckpoint::save(
+    const Part<NDIM - 1, NDIM> &,
+    const std::vector<
+      std::pair<types::global_dof_index, types::global_dof_index>> &);
+
+  template void
+  PartCheckpoint::save(
+    const Part<NDIM, NDIM> &,
+    const std::vector<
+      std::pair<types::global_dof_index, types::global_dof_index>> &);
+
+  template void
+  PartCheckpoint::load(
+    Part<NDIM - 1, NDIM> &,
+    const std::vector<
+      std::pair<types::global_dof_index, types::global_dof_index>> &);
+
+  template void
+  PartCheckpoint::load(
+    Part<NDIM, NDIM> &,
+    const std::vector<
+      std::pair<types::global_dof_index, types::global_dof_index>> &);
+} // namespace fdl
@@ -0,0 +1,1155 @@
+#include <fiddle/base/reduction_handle.h>
+
+#include <fiddle/mechanics/part_geometry.h>
+#include <fiddle/mechanics/simplex_mass_operator.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/dofs/dof_renumbering.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/grid/reference_cell.h>
+
+#include <deal.II/lac/solver_control.h>
+
+FDL_DISABLE_EXTRA_DIAGNOSTICS
+#include <deal.II/matrix_free/fe_evaluation.h>
+FDL_ENABLE_EXTRA_DIAGNOSTICS
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <numeric>
+#include <thread>
+
+namespace fdl
+{
+  namespace internal
+  {
+    // matrix_free doesn't work with codim != 0 so we need a helper function
+    template <int dim>
+    void
+    reinit_matrix_free(const Mapping<dim>              &mapping,
+                       const DoFHandler<dim>           &dof_handler,
+                       const AffineConstraints<double> &constraints,
+                       const Quadrature<dim>           &quadrature,
+                       MatrixFree<dim, double>         &matrix_free)
+    {
+      // Put cells with different material ids into different cell batches
+      // (and sort the batches by material id) so that the load vector
+      // assembly only switches active strains between batches
+      typename MatrixFree<dim, double>::AdditionalData additional_data;
+      const Triangulation<dim> &tria = dof_handler.get_triangulation();
+      additional_data.cell_vectorization_category.resize(
+        tria.n_active_cells());
+      for (const auto &cell : tria.active_cell_iterators())
+        if (cell->is_locally_owned())
+          additional_data
+            .cell_vectorization_category[cell->active_cell_index()] =
+            cell->material_id();
+      additional_data.cell_vectorization_categories_strict = true;
+      matrix_free.reinit(
+        mapping, dof_handler, constraints, quadrature, additional_data);
+    }
+
+    template <int dim>
+    void
+    reinit_matrix_free(const Mapping<dim - 1, dim> &,
+                       const DoFHandler<dim - 1, dim> &,
+                       const AffineConstraints<double> &,
+                       const Quadrature<dim - 1> &,
+                       MatrixFree<dim - 1, double> &)
+    {
+      // We shouldn't get here
+      AssertThrow(false, ExcFDLInternalError());
+    }
+  } // namespace internal
+
+  namespace
+  {
+    template <int dim, int spacedim>
+    std::shared_ptr<DoFHandler<dim, spacedim>>
+    setup_dof_handler(const Triangulation<dim, spacedim> &tria,
+                      const FiniteElement<dim, spacedim> &fe)
+    {
+      auto dof_handler = std::make_shared<DoFHandler<dim, spacedim>>(tria);
+      dof_handler->distribute_dofs(fe);
+      return dof_handler;
+    }
+
+    // Triangulation and DoFHandler created together from in-memory mesh data.
+    // The DoFHandler is declared last so that it is destroyed first, and the
+    // communicator (if owned) is declared first so that it is freed last.
+    template <int dim, int spacedim>
+    struct OwnedMesh
+    {
+      OwnedMesh(
+        const MPI_Comm                  communicator,
+        std::shared_ptr<const MPI_Comm> owned_communicator,
+        const typename parallel::shared::Triangulation<dim, spacedim>::Settings
+          settings)
+        : owned_communicator(owned_communicator)
+        , tria(communicator,
+               Triangulation<dim, spacedim>::none,
+               false,
+               settings)
+      {}
+
+      std::shared_ptr<const MPI_Comm> owned_communicator;
+
+      parallel::shared::Triangulation<dim, spacedim> tria;
+
+      DoFHandler<dim, spacedim> dof_handler;
+    };
+
+    template <int dim, int spacedim>
+    std::shared_ptr<DoFHandler<dim, spacedim>>
+    setup_dof_handler(const MPI_Comm                      communicator,
+                      PartMeshData<dim, spacedim>       &&mesh_data,
+                      const FiniteElement<dim, spacedim> &fe,
+                      std::shared_ptr<const MPI_Comm>     owned_communicator)
+    {
+      using TriangulationType = parallel::shared::Triangulation<dim, spacedim>;
+      const std::vector<types::subdomain_id> subdomain_ids =
+        std::move(mesh_data.subdomain_ids);
+      AssertThrow(subdomain_ids.size() == 0 ||
+                    subdomain_ids.size() == mesh_data.cells.size(),
+                  ExcMessage("There should be either no subdomain ids or one "
+                             "for each cell."));
+      auto mesh = std::make_shared<OwnedMesh<dim, spacedim>>(
+        communicator,
+        owned_communicator,
+        subdomain_ids.size() == 0 ?
+          TriangulationType::partition_zorder :
+          TriangulationType::partition_custom_signal);
+
+      // With a custom partitioner, set the subdomain ids when the
+      // Triangulation is created. Coarse cells have the same order as the
+      // input cells.
+      boost::signals2::connection connection;
+      if (subdomain_ids.size() > 0)
+        connection = mesh->tria.signals.create.connect(
+          [&]()
+          {
+            for (const auto &cell : mesh->tria.active_cell_iterators())
+              cell->set_subdomain_id(subdomain_ids[cell->active_cell_index()]);
+          });
+      mesh->tria.create_triangulation(mesh_data.vertices,
+                                      mesh_data.cells,
+                                      mesh_data.subcell_data);
+      connection.disconnect();
+      mesh_data = PartMeshData<dim, spacedim>();
+
+      mesh->dof_handler.reinit(mesh->tria);
+      mesh->dof_handler.distribute_dofs(fe);
+      // Share ownership of the Triangulation with the DoFHandler
+      return std::shared_ptr<DoFHandler<dim, spacedim>>(mesh,
+                                                        &mesh->dof_handler);
+    }
+
+    // Renumber the locally owned DoFs by sorting the locally owned cells
+    // along a Hilbert curve through their centers.
+    template <int dim, int spacedim>
+    void
+    renumber_dofs_along_hilbert_curve(DoFHandler<dim, spacedim> &dof_handler)
+    {
+      using cell_iterator =
+        typename DoFHandler<dim, spacedim>::active_cell_iterator;
+      std::vector<cell_iterator>   cells;
+      std::vector<Point<spacedim>> centers;
+      for (const auto &cell : dof_handler.active_cell_iterators())
+        if (cell->is_locally_owned())
+          {
+            cells.push_back(cell);
+            centers.push_back(cell->center());
+          }
+
+      std::vector<cell_iterator> cell_order;
+      if (cells.size() > 0)
+        {
+          // Use as many bits as fit into a single 64-bit key
+          const int  bits_per_dim = 64 / spacedim;
+          const auto indices =
+            Utilities::inverse_Hilbert_space_filling_curve(centers,
+                                                           bits_per_dim);
+          std::vector<std::pair<std::uint64_t, unsigned int>> keys;
+          for (unsigned int i = 0; i < cells.size(); ++i)
+            keys.emplace_back(Utilities::pack_integers(indices[i],
+                                                       bits_per_dim),
+                              i);
+          std::sort(keys.begin(), keys.end());
+          for (const auto &key : keys)
+            cell_order.push_back(cells[key.second]);
+        }
+      // Renumbering is collective so we have to call this even if we own no
+      // cells
+      DoFRenumbering::cell_wise(dof_handler, cell_order);
+    }
+
+    // Mass operator applied to several vectors at once. Ghost values and
+    // compression are handled by the caller.
+    template <int dim, int fe_degree, int n_q_points_1d>
+    void
+    apply_mass_operator_to_cells(
+      const MatrixFree<dim, double> &matrix_free,
+      const std::vector<LinearAlgebra::distributed::Vector<double> *> &dst,
+      const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+        &src)
+    {
+      FEEvaluation<dim, fe_degree, n_q_points_1d, dim, double> phi(
+        matrix_free);
+      for (unsigned int cell = 0; cell < matrix_free.n_cell_batches(); ++cell)
+        {
+          phi.reinit(cell);
+          for (std::size_t k = 0; k < src.size(); ++k)
+            {
+              phi.read_dof_values(*src[k]);
+              phi.evaluate(EvaluationFlags::values);
+              for (unsigned int q = 0; q < phi.n_q_points; ++q)
+                phi.submit_value(phi.get_value(q), q);
+              phi.integrate(EvaluationFlags::values);
+              phi.distribute_local_to_global(*dst[k]);
+            }
+        }
+    }
+
+    // Apply the exact inverse of a block diagonal mass matrix. DoFs are not
+    // shared between cells so no ghost values are required.
+    template <int dim, int fe_degree>
+    void
+    apply_cellwise_inverse_mass_to_cells(
+      const MatrixFree<dim, double> &matrix_free,
+      const std::vector<LinearAlgebra::distributed::Vector<double> *> &dst,
+      const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+        &src)
+    {
+      FEEvaluation<dim, fe_degree, fe_degree + 1, dim, double> phi(
+        matrix_free);
+      MatrixFreeOperators::CellwiseInverseMassMatrix<dim, fe_degree, dim>
+                                             inverse_mass(phi);
+      AlignedVector<VectorizedArray<double>> inverse_JxW(phi.n_q_points);
+      for (unsigned int cell = 0; cell < matrix_free.n_cell_batches(); ++cell)
+        {
+          phi.reinit(cell);
+          inverse_mass.fill_inverse_JxW_values(inverse_JxW);
+          for (std::size_t k = 0; k < src.size(); ++k)
+            {
+              phi.read_dof_values(*src[k]);
+              inverse_mass.apply(inverse_JxW,
+                                 dim,
+                                 phi.begin_dof_values(),
+                                 phi.begin_dof_values());
+              phi.set_dof_values(*dst[k]);
+            }
+        }
+    }
+  } // namespace
+
+  template <int dim, int spacedim>
+  PartGeometry<dim, spacedim>::PartGeometry(
+    const Triangulation<dim, spacedim> &tria,
+    const FiniteElement<dim, spacedim> &fe,
+    const bool                          renumber_dofs)
+    : PartGeometry(setup_dof_handler(tria, fe), renumber_dofs)
+  {}
+
+  template <int dim, int spacedim>
+  PartGeometry<dim, spacedim>::PartGeometry(
+    const MPI_Comm                      communicator,
+    PartMeshData<dim, spacedim>       &&mesh_data,
+    const FiniteElement<dim, spacedim> &fe,
+    const bool                          renumber_dofs)
+    : PartGeometry(
+        setup_dof_handler(communicator, std::move(mesh_data), fe, nullptr),
+        renumber_dofs)
+  {
+    // The DoFHandler owns the Triangulation, so this keeps it alive until
+    // every object which references it has been destroyed
+    owned_triangulation = std::shared_ptr<const Triangulation<dim, spacedim>>(
+      dof_handler, &dof_handler->get_triangulation());
+  }
+
+  template <int dim, int spacedim>
+  PartGeometry<dim, spacedim>::PartGeometry(
+    std::shared_ptr<const MPI_Comm>     communicator,
+    PartMeshData<dim, spacedim>       &&mesh_data,
+    const FiniteElement<dim, spacedim> &fe,
+    const bool                          renumber_dofs)
+    : PartGeometry(setup_dof_handler(*communicator,
+                                     std::move(mesh_data),
+                                     fe,
+                                     communicator),
+                   renumber_dofs)
+  {
+    owned_triangulation = std::shared_ptr<const Triangulation<dim, spacedim>>(
+      dof_handler, &dof_handler->get_triangulation());
+  }
+
+  template <int dim, int spacedim>
+  PartGeometry<dim, spacedim>::PartGeometry(
+    std::shared_ptr<DoFHandler<dim, spacedim>> dh,
+    const bool                                 renumber_dofs)
+    : tria(&dh->get_triangulation())
+    , fe(dh->get_fe().clone())
+    , dof_handler(dh)
+    , any_constraints(false)
+    , cellwise_inverse_mass(false)
+  {
+    const auto &reference_cells = this->tria->get_reference_cells();
+    AssertThrow(reference_cells.size() == 1, ExcFDLNotImplemented());
+    mapping = reference_cells.front()
+                .template get_default_linear_mapping<dim, spacedim>()
+                .clone();
+    quadrature =
+      reference_cells.front().template get_gauss_type_quadrature<dim>(
+        fe->tensor_degree() + 1);
+
+    AssertThrow(fe->n_components() == spacedim,
+                ExcMessage("The finite element should have spacedim components "
+                           "since it will represent the position, velocity and "
+                           "force of the part."));
+    // Set up DoFs and finite element fields. The DoFs of dof_handler have
+    // already been distributed: keep any numbering set up by the caller (e.g.,
+    // one loaded by PartCache).
+    if (renumber_dofs)
+      renumber_dofs_along_hilbert_curve(*dof_handler);
+    // Locally refined Triangulations have hanging nodes:
+    IndexSet locally_relevant_dofs;
+    DoFTools::extract_locally_relevant_dofs(*dof_handler,
+                                            locally_relevant_dofs);
+    constraints.reinit(locally_relevant_dofs);
+    DoFTools::make_hanging_node_constraints(*dof_handler, constraints);
+    constraints.close();
+    any_constraints = Utilities::MPI::logical_or(
+      constraints.n_constraints() > 0, tria->get_communicator());
+    boundary_faces =
+      std::make_unique<BoundaryFaces<dim, spacedim>>(*dof_handler);
+
+    // A MatrixFree object sets up the partitioning on its own - use that to
+    // avoid issues with p::s::T where there may not be artificial cells
+    //
+    // TODO - understand this issue well enough to file a bug report
+    matrix_free = std::make_shared<MatrixFree<dim, double>>();
+    if (dim == spacedim)
+      {
+        // matrix-free is only implemented in codim 0
+        internal::reinit_matrix_free(
+          *mapping, *dof_handler, constraints, quadrature, *matrix_free);
+        partitioner = matrix_free->get_vector_partitioner();
+      }
+    else
+      {
+        partitioner = std::make_shared<Utilities::MPI::Partitioner>(
+          dof_handler->locally_owned_dofs(),
+          locally_relevant_dofs,
+          tria->get_communicator());
+      }
+
+    // Set up matrix free components:
+    if (dim == spacedim)
+      {
+        if (reference_cells.front() == ReferenceCells::get_hypercube<dim>())
+          {
+            using namespace MatrixFreeOperators;
+            switch (fe->tensor_degree())
+              {
+                case 1:
+                  mass_operator.reset(new MassOperator<dim, 1, 1 + 1, dim>());
+                  break;
+                case 2:
+                  mass_operator.reset(new MassOperator<dim, 2, 2 + 1, dim>());
+                  break;
+                case 3:
+                  mass_operator.reset(new MassOperator<dim, 3, 3 + 1, dim>());
+                  break;
+                case 4:
+                  mass_operator.reset(new MassOperator<dim, 4, 4 + 1, dim>());
+                  break;
+                case 5:
+                  mass_operator.reset(new MassOperator<dim, 5, 5 + 1, dim>());
+                  break;
+                default:
+                  AssertThrow(false, ExcFDLNotImplemented());
+              }
+            mass_operator->initialize(matrix_free);
+
+            // Discontinuous elements have a block diagonal mass matrix which
+            // we can invert exactly
+            cellwise_inverse_mass = fe->n_dofs_per_vertex() == 0 &&
+                                    fe->n_dofs_per_face() == 0 &&
+                                    constraints.n_constraints() == 0;
+          }
+        else
+          {
+            // deal.II's MassOperator only supports simplices with the
+            // generic runtime-degree kernel, so use our own
+            auto simplex_mass_operator =
+              std::make_unique<SimplexMassOperator<dim>>();
+            simplex_mass_operator->initialize(matrix_free);
+            mass_operator = std::move(simplex_mass_operator);
+          }
+        mass_operator->compute_diagonal();
+        mass_preconditioner.initialize(*mass_operator, 1.0);
+      }
+    else if (!any_constraints)
+      {
+        if constexpr (dim != spacedim)
+          surface_mass_operator =
+            std::make_unique<SurfaceMassOperator<dim, spacedim>>(*mapping,
+                                                                 *dof_handler,
+                                                                 quadrature,
+                                                                 partitioner);
+      }
+  }
+
+  template <int dim, int spacedim>
+  void
+  PartGeometry<dim, spacedim>::setup_reference_shape_gradients(
+    const Quadrature<dim> &quadrature)
+  {
+    for (const auto &gradients : reference_shape_gradients)
+      if (gradients->get_quadrature() == quadrature)
+        return;
+
+    reference_shape_gradients.push_back(
+      std::make_unique<ReferenceShapeGradients<dim, spacedim>>(*mapping,
+                                                               *dof_handler,
+                                                               quadrature));
+  }
+
+  template <int dim, int spacedim>
+  std::vector<const ReferenceShapeGradients<dim, spacedim> *>
+  PartGeometry<dim, spacedim>::get_reference_shape_gradients() const
+  {
+    std::vector<const ReferenceShapeGradients<dim, spacedim> *> gradients;
+
+    for (auto &g : reference_shape_gradients)
+      gradients.push_back(g.get());
+
+    return gradients;
+  }
+
+  template <int dim, int spacedim>
+  void
+  PartGeometry<dim, spacedim>::setup_device_mass_solver()
+  {
+    if (device_mass_solver)
+      return;
+    AssertThrow(!any_constraints && !cellwise_inverse_mass,
+                ExcFDLNotImplemented());
+    if constexpr (dim == spacedim)
+      device_mass_solver = std::make_unique<DeviceMassSolver<spacedim>>(
+        *mapping, *dof_handler, quadrature);
+    else
+      AssertThrow(false, ExcFDLNotImplemented());
+  }
+
+  template <int dim, int spacedim>
+  std::size_t
+  PartGeometry<dim, spacedim>::memory_consumption() const
+  {
+    std::size_t result = tria->memory_consumption() +
+                         dof_handler->memory_consumption() +
+                         constraints.memory_consumption() +
+                         partitioner->memory_consumption();
+    if (matrix_free)
+      result += matrix_free->memory_consumption();
+    for (const auto &gradients : reference_shape_gradients)
+      result += gradients->memory_consumption();
+    if (device_mass_solver)
+      result += device_mass_solver->memory_consumption();
+    if (surface_mass_operator)
+      result += surface_mass_operator->memory_consumption();
+    return result;
+  }
+
+  template <int dim, int spacedim>
+  bool
+  PartGeometry<dim, spacedim>::has_same_mass_operator(
+    const PartGeometry<dim, spacedim> &other) const
+  {
+    // Both objects set up their DoFs, quadratures, and mappings in the same
+    // way from these two objects, so this is sufficient. Since the
+    // Triangulation is shared this is also the same on every processor.
+    return this == &other || (&*tria == &*other.tria && *fe == *other.fe);
+  }
+
+  template <int dim, int spacedim>
+  void
+  PartGeometry<dim, spacedim>::apply_mass_operator(
+    const std::vector<LinearAlgebra::distributed::Vector<double> *> &dst,
+    const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+      &src) const
+  {
+    AssertThrow(dim == spacedim || surface_mass_operator,
+                ExcFDLNotImplemented());
+    AssertDimension(dst.size(), src.size());
+    for (std::size_t k = 0; k < src.size(); ++k)
+      {
+        Assert(src[k]->get_partitioner()->is_compatible(*partitioner),
+               ExcMessage("The partitioners must be compatible"));
+        Assert(dst[k]->get_partitioner()->is_compatible(*partitioner),
+               ExcMessage("The partitioners must be compatible"));
+      }
+
+    // Update all ghost values at once and restore the input vectors to their
+    // previous state afterwards:
+    std::vector<bool> had_ghost_values(src.size());
+    for (std::size_t k = 0; k < src.size(); ++k)
+      {
+        had_ghost_values[k] = src[k]->has_ghost_elements();
+        if (!had_ghost_values[k])
+          src[k]->update_ghost_values_start(k);
+      }
+    for (std::size_t k = 0; k < src.size(); ++k)
+      {
+        if (!had_ghost_values[k])
+          src[k]->update_ghost_values_finish();
+        *dst[k] = 0.0;
+      }
+
+    if (surface_mass_operator)
+      surface_mass_operator->apply_add_to_cells(dst, src);
+    else if (fe->reference_cell() == ReferenceCells::get_hypercube<dim>())
+      {
+        switch (fe->tensor_degree())
+          {
+            case 1:
+              apply_mass_operator_to_cells<dim, 1, 1 + 1>(*matrix_free,
+                                                          dst,
+                                                          src);
+              break;
+            case 2:
+              apply_mass_operator_to_cells<dim, 2, 2 + 1>(*matrix_free,
+                                                          dst,
+                                                          src);
+              break;
+            case 3:
+              apply_mass_operator_to_cells<dim, 3, 3 + 1>(*matrix_free,
+                                                          dst,
+                                                          src);
+              break;
+            case 4:
+              apply_mass_operator_to_cells<dim, 4, 4 + 1>(*matrix_free,
+                                                          dst,
+                                                          src);
+              break;
+            case 5:
+              apply_mass_operator_to_cells<dim, 5, 5 + 1>(*matrix_free,
+                                                          dst,
+                                                          src);
+              break;
+            default:
+              AssertThrow(false, ExcFDLNotImplemented());
+          }
+      }
+    else
+      {
+        const auto &simplex_mass_operator =
+          dynamic_cast<const SimplexMassOperator<dim> &>(*mass_operator);
+        simplex_mass_operator.apply_add_to_cells(dst, src);
+      }
+
+    for (std::size_t k = 0; k < dst.size(); ++k)
+      dst[k]->compress_start(k, VectorOperation::add);
+    for (std::size_t k = 0; k < dst.size(); ++k)
+      {
+        dst[k]->compress_finish(VectorOperation::add);
+        if (!had_ghost_values[k])
+          src[k]->zero_out_ghost_values();
+      }
+
+    // Like MatrixFreeOperators::Base, treat constrained DoFs as identity rows
+    // (the surface mass operator is only used without constraints)
+    if (!surface_mass_operator)
+      for (const unsigned int dof : matrix_free->get_constrained_dofs())
+        for (std::size_t k = 0; k < dst.size(); ++k)
+          dst[k]->local_element(dof) = src[k]->local_element(dof);
+  }
+
+  template <int dim, int spacedim>
+  void
+  PartGeometry<dim, spacedim>::apply_approximate_mass_inverse(
+    LinearAlgebra::distributed::Vector<double>       &dst,
+    const LinearAlgebra::distributed::Vector<double> &src,
+    const unsigned int                                n_corrections) const
+  {
+    AssertThrow(dim == spacedim || surface_mass_operator,
+                ExcFDLNotImplemented());
+    if (!any_constraints)
+      {
+        apply_condensed_approximate_mass_inverse(dst, src, n_corrections);
+        return;
+      }
+
+    LinearAlgebra::distributed::Vector<double> condensed_src;
+    condense_right_hand_side(src, condensed_src);
+    apply_condensed_approximate_mass_inverse(dst,
+                                             condensed_src,
+                                             n_corrections);
+    constraints.distribute(dst);
+  }
+
+  template <int dim, int spacedim>
+  void
+  PartGeometry<dim, spacedim>::condense_right_hand_side(
+    const LinearAlgebra::distributed::Vector<double> &src,
+    LinearAlgebra::distributed::Vector<double>       &dst) const
+  {
+    // Like AffineConstraints::condense(), but the masters of a locally owned
+    // constrained DoF may be owned by another processor
+    dst.reinit(partitioner);
+    dst.copy_locally_owned_data_from(src);
+    for (const auto &line : constraints.get_lines())
+      if (partitioner->in_local_range(line.index))
+        {
+          const double value = dst(line.index);
+          for (const auto &entry : line.entries)
+            dst(entry.first) += entry.second * value;
+          dst(line.index) = 0.0;
+        }
+    dst.compress(VectorOperation::add);
+  }
+
+  template <int dim, int spacedim>
+  void
+  PartGeometry<dim, spacedim>::apply_condensed_approximate_mass_inverse(
+    LinearAlgebra::distributed::Vector<double>       &dst,
+    const LinearAlgebra::distributed::Vector<double> &src,
+    const unsigned int                                n_corrections) const
+  {
+    if (surface_mass_operator)
+      {
+        AssertThrow(n_corrections == 0, ExcFDLNotImplemented());
+        const LinearAlgebra::distributed::Vector<double> &inverse_masses =
+          surface_mass_operator->get_inverse_lumped_masses();
+        for (unsigned int i = 0; i < dst.locally_owned_size(); ++i)
+          dst.local_element(i) =
+            inverse_masses.local_element(i) * src.local_element(i);
+        return;
+      }
+    if (n_corrections == 0)
+      {
+        mass_preconditioner.vmult(dst, src);
+        return;
+      }
+
+    auto &chebyshev = mass_chebyshevs[n_corrections];
+    if (!chebyshev)
+      {
+        using ChebyshevType =
+          typename decltype(mass_chebyshevs)::mapped_type::element_type;
+        typename ChebyshevType::AdditionalData additional_data;
+        additional_data.degree = 1 + n_corrections;
+        // We are using Chebyshev as a solver, not a smoother, so cover the
+        // whole spectrum:
+        additional_data.smoothing_range = 0.0;
+        additional_data.preconditioner =
+          mass_operator->get_matrix_diagonal_inverse();
+        chebyshev = std::make_unique<ChebyshevType>();
+        chebyshev->initialize(*mass_operator, additional_data);
+      }
+    chebyshev->vmult(dst, src);
+  }
+
+  template <int dim, int spacedim>
+  std::vector<unsigned int>
+  PartGeometry<dim, spacedim>::solve_mass_systems(
+    const std::vector<LinearAlgebra::distributed::Vector<double> *> &solutions,
+    const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+                      &right_hand_sides,
+    const unsigned int max_iterations,
+    const double       relative_tolerance,
+    const unsigned int n_corrections,
+    const bool         pipelined) const
+  {
+    using VectorType = LinearAlgebra::distributed::Vector<double>;
+    AssertThrow(dim == spacedim || surface_mass_operator,
+                ExcFDLNotImplemented());
+    const std::size_t n_systems = solutions.size();
+    AssertDimension(right_hand_sides.size(), n_systems);
+    if (cellwise_inverse_mass)
+      {
+        switch (fe->tensor_degree())
+          {
+            case 1:
+              apply_cellwise_inverse_mass_to_cells<dim, 1>(*matrix_free,
+                                                           solutions,
+                                                           right_hand_sides);
+              break;
+            case 2:
+              apply_cellwise_inverse_mass_to_cells<dim, 2>(*matrix_free,
+                                                           solutions,
+                                                           right_hand_sides);
+              break;
+            case 3:
+              apply_cellwise_inverse_mass_to_cells<dim, 3>(*matrix_free,
+                                                           solutions,
+                                                           right_hand_sides);
+              break;
+            case 4:
+              apply_cellwise_inverse_mass_to_cells<dim, 4>(*matrix_free,
+                                                           solutions,
+                                                           right_hand_sides);
+              break;
+            case 5:
+              apply_cellwise_inverse_mass_to_cells<dim, 5>(*matrix_free,
+                                                           solutions,
+                                                           right_hand_sides);
+              break;
+            default:
+              AssertThrow(false, ExcFDLNotImplemented());
+          }
+        return std::vector<unsigned int>(n_systems, 0);
+      }
+    if (device_mass_solver)
+      return device_mass_solver->solve(solutions,
+                                       right_hand_sides,
+                                       max_iterations,
+                                       relative_tolerance);
+    // With hanging nodes, solve the condensed systems (in which constrained
+    // DoFs have zero rows and right-hand sides and are hence never updated)
+    // and then set the constrained DoFs afterwards
+    std::vector<VectorType>         condensed_right_hand_sides;
+    std::vector<const VectorType *> rhs_ptrs(right_hand_sides);
+    if (any_constraints)
+      {
+        condensed_right_hand_sides.resize(n_systems);
+        for (std::size_t k = 0; k < n_systems; ++k)
+          {
+            condense_right_hand_side(*right_hand_sides[k],
+                                     condensed_right_hand_sides[k]);
+            rhs_ptrs[k] = &condensed_right_hand_sides[k];
+            for (const auto &line : constraints.get_lines())
+              if (partitioner->in_local_range(line.index))
+                (*solutions[k])(line.index) = 0.0;
+          }
+      }
+    const auto iterations =
+      pipelined ? solve_condensed_mass_systems_pipelined(solutions,
+                                                         rhs_ptrs,
+                                                         max_iterations,
+                                                         relative_tolerance,
+                                                         n_corrections) :
+                  solve_condensed_mass_systems(solutions,
+                                               rhs_ptrs,
+                                               max_iterations,
+                                               relative_tolerance,
+                                               n_corrections);
+    if (any_constraints)
+      for (VectorType *solution : solutions)
+        constraints.distribute(*solution);
+    return iterations;
+  }
+
+  template <int dim, int spacedim>
+  std::vector<unsigned int>
+  PartGeometry<dim, spacedim>::solve_condensed_mass_systems(
+    const std::vector<LinearAlgebra::distributed::Vector<double> *> &solutions,
+    const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+                      &right_hand_sides,
+    const unsigned int max_iterations,
+    const double       relative_tolerance,
+    const unsigned int n_corrections) const
+  {
+    using VectorType            = LinearAlgebra::distributed::Vector<double>;
+    const std::size_t n_systems = solutions.size();
+
+    const MPI_Comm communicator = partitioner->get_mpi_communicator();
+    auto           precondition = [&](VectorType &dst, const VectorType &src)
+    { apply_condensed_approximate_mass_inverse(dst, src, n_corrections); };
+
+    // All inner products of an iteration are summed at once
+    std::vector<double> sums;
+    auto                sum = [&]()
+    {
+      const int ierr = MPI_Allreduce(MPI_IN_PLACE,
+                                     sums.data(),
+                                     sums.size(),
+                                     MPI_DOUBLE,
+                                     MPI_SUM,
+                                     communicator);
+      AssertThrowMPI(ierr);
+    };
+    auto local_dot = [](const VectorType &a, const VectorType &b)
+    {
+      return std::inner_product(a.begin(), a.end(), b.begin(), 0.0);
+    };
+
+    std::vector<VectorType> residuals(n_systems), preconditioned(n_systems),
+      directions(n_systems), products(n_systems);
+    for (std::size_t k = 0; k < n_systems; ++k)
+      {
+        residuals[k].reinit(partitioner);
+        preconditioned[k].reinit(partitioner);
+        directions[k].reinit(partitioner);
+        products[k].reinit(partitioner);
+      }
+
+    // r = b - M x, z = P r, p = z:
+    std::vector<VectorType *>       product_ptrs;
+    std::vector<const VectorType *> solution_ptrs;
+    for (std::size_t k = 0; k < n_systems; ++k)
+      {
+        product_ptrs.push_back(&products[k]);
+        solution_ptrs.push_back(solutions[k]);
+      }
+    apply_mass_operator(product_ptrs, solution_ptrs);
+    sums.resize(3 * n_systems);
+    for (std::size_t k = 0; k < n_systems; ++k)
+      {
+        residuals[k] = *right_hand_sides[k];
+        residuals[k] -= products[k];
+        precondition(preconditioned[k], residuals[k]);
+        directions[k] = preconditioned[k];
+
+        sums[3 * k + 0] = local_dot(*right_hand_sides[k], *right_hand_sides[k]);
+        sums[3 * k + 1] = local_dot(residuals[k], residuals[k]);
+        sums[3 * k + 2] = local_dot(residuals[k], preconditioned[k]);
+      }
+    sum();
+
+    std::vector<double> tolerances(n_systems), residual_norms(n_systems),
+      rhos(n_systems);
+    std::vector<unsigned int> iterations(n_systems);
+    std::vector<std::size_t>  unconverged;
+    for (std::size_t k = 0; k < n_systems; ++k)
+      {
+        tolerances[k]     = relative_tolerance * std::sqrt(sums[3 * k + 0]);
+        residual_norms[k] = std::sqrt(sums[3 * k + 1]);
+        rhos[k]           = sums[3 * k + 2];
+        if (residual_norms[k] > tolerances[k])
+          unconverged.push_back(k);
+      }
+
+    unsigned int step = 0;
+    while (unconverged.size() > 0 && step < max_iterations)
+      {
+        ++step;
+        // q = M p:
+        product_ptrs.clear();
+        std::vector<const VectorType *> direction_ptrs;
+        for (const std::size_t k : unconverged)
+          {
+            product_ptrs.push_back(&products[k]);
+            direction_ptrs.push_back(&directions[k]);
+          }
+        apply_mass_operator(product_ptrs, direction_ptrs);
+
+        sums.resize(unconverged.size());
+        for (std::size_t i = 0; i < unconverged.size(); ++i)
+          sums[i] = local_dot(directions[unconverged[i]],
+                              products[unconverged[i]]);
+        sum();
+
+        // x += alpha p, r -= alpha q, z = P r:
+        const std::vector<double> curvatures(sums);
+        sums.resize(2 * unconverged.size());
+        for (std::size_t i = 0; i < unconverged.size(); ++i)
+          {
+            const std::size_t k     = unconverged[i];
+            const double      alpha = rhos[k] / curvatures[i];
+            solutions[k]->add(alpha, directions[k]);
+            residuals[k].add(-alpha, products[k]);
+            precondition(preconditioned[k], residuals[k]);
+
+            sums[2 * i + 0] = local_dot(residuals[k], residuals[k]);
+            sums[2 * i + 1] = local_dot(residuals[k], preconditioned[k]);
+          }
+        sum();
+
+        // p = z + beta p:
+        std::vector<std::size_t> still_unconverged;
+        for (std::size_t i = 0; i < unconverged.size(); ++i)
+          {
+            const std::size_t k    = unconverged[i];
+            const double      beta = sums[2 * i + 1] / rhos[k];
+            residual_norms[k]      = std::sqrt(sums[2 * i + 0]);
+            rhos[k]                = sums[2 * i + 1];
+            iterations[k]          = step;
+            if (residual_norms[k] > tolerances[k])
+              {
+                directions[k].sadd(beta, 1.0, preconditioned[k]);
+                still_unconverged.push_back(k);
+              }
+          }
+        unconverged = std::move(still_unconverged);
+      }
+
+    if (unconverged.size() > 0)
+      {
+        double largest_residual = 0.0;
+        for (const std::size_t k : unconverged)
+          largest_residual = std::max(largest_residual, residual_norms[k]);
+        AssertThrow(false,
+                    SolverControl::NoConvergence(step, largest_residual));
+      }
+
+    return iterations;
+  }
+
+  template <int dim, int spacedim>
+  std::vector<unsigned int>
+  PartGeometry<dim, spacedim>::solve_condensed_mass_systems_pipelined(
+    const std::vector<LinearAlgebra::distributed::Vector<double> *> &solutions,
+    const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+                      &right_hand_sides,
+    const unsigned int max_iterations,
+    const double       relative_tolerance,
+    const unsigned int n_corrections) const
+  {
+    // This is the preconditioned pipelined CG method of Ghysels and Vanroose
+    // (2014): with u = P r, w = M u, m = P w, and n = M m, the inner products
+    // (r, u) and (w, u) of an iteration only depend on vectors which are
+    // already known, so they are summed while m and n are computed and the
+    // recurrences for the other vectors are then updated with the sums.
+    using VectorType            = LinearAlgebra::distributed::Vector<double>;
+    const std::size_t n_systems = solutions.size();
+
+    const MPI_Comm communicator = partitioner->get_mpi_communicator();
+    auto           precondition = [&](VectorType &dst, const VectorType &src)
+    { apply_condensed_approximate_mass_inverse(dst, src, n_corrections); };
+    auto local_dot = [](const VectorType &a, const VectorType &b)
+    {
+      return std::inner_product(a.begin(), a.end(), b.begin(), 0.0);
+    };
+    auto apply = [&](std::vector<VectorType>        &dst,
+                     const std::vector<VectorType>  &src,
+                     const std::vector<std::size_t> &systems)
+    {
+      std::vector<VectorType *>       dst_ptrs;
+      std::vector<const VectorType *> src_ptrs;
+      for (const std::size_t k : systems)
+        {
+          dst_ptrs.push_back(&dst[k]);
+          src_ptrs.push_back(&src[k]);
+        }
+      apply_mass_operator(dst_ptrs, src_ptrs);
+    };
+
+    // Names follow the paper: p, s, q, and z are the search directions and
+    // their products with M, P M, and M P M.
+    std::vector<VectorType> r(n_systems), u(n_systems), w(n_systems),
+      m(n_systems), n(n_systems), p(n_systems), s(n_systems), q(n_systems),
+      z(n_systems);
+    for (std::size_t k = 0; k < n_systems; ++k)
+      for (VectorType *vector :
+           {&r[k], &u[k], &w[k], &m[k], &n[k], &p[k], &s[k], &q[k], &z[k]})
+        vector->reinit(partitioner);
+
+    // r = b - M x, u = P r, w = M u:
+    std::vector<std::size_t> unconverged(n_systems);
+    std::iota(unconverged.begin(), unconverged.end(), std::size_t(0));
+    {
+      std::vector<VectorType *>       product_ptrs;
+      std::vector<const VectorType *> solution_ptrs;
+      for (std::size_t k = 0; k < n_systems; ++k)
+        {
+          product_ptrs.push_back(&r[k]);
+          solution_ptrs.push_back(solutions[k]);
+        }
+      apply_mass_operator(product_ptrs, solution_ptrs);
+    }
+    for (std::size_t k = 0; k < n_systems; ++k)
+      {
+        r[k].sadd(-1.0, 1.0, *right_hand_sides[k]);
+        precondition(u[k], r[k]);
+      }
+    apply(w, u, unconverged);
+
+    std::vector<double> tolerances(n_systems), residual_norms(n_systems),
+      gammas(n_systems), alphas(n_systems);
+    std::vector<unsigned int> iterations(n_systems);
+    unsigned int              step = 0;
+    while (true)
+      {
+        // Start summing (r, r), (r, u), and (w, u) (and, in the first step,
+        // (b, b)) of every unconverged system:
+        std::vector<double> local_sums;
+        for (const std::size_t k : unconverged)
+          {
+            local_sums.push_back(local_dot(r[k], r[k]));
+            local_sums.push_back(local_dot(r[k], u[k]));
+            local_sums.push_back(local_dot(w[k], u[k]));
+          }
+        if (step == 0)
+          for (std::size_t k = 0; k < n_systems; ++k)
+            local_sums.push_back(
+              local_dot(*right_hand_sides[k], *right_hand_sides[k]));
+        ReductionHandle<std::vector<double>> reduction(
+          std::move(local_sums),
+          communicator,
+          [](const std::vector<double> &sums) { return sums; });
+
+        // m = P w, n = M m, overlapped with the reduction:
+        for (const std::size_t k : unconverged)
+          precondition(m[k], w[k]);
+        apply(n, m, unconverged);
+
+        const std::vector<double> sums = reduction.get();
+        if (step == 0)
+          for (std::size_t k = 0; k < n_systems; ++k)
+            tolerances[k] =
+              relative_tolerance * std::sqrt(sums[3 * n_systems + k]);
+
+        std::vector<std::size_t> still_unconverged;
+        std::vector<double>      new_gammas, deltas;
+        for (std::size_t i = 0; i < unconverged.size(); ++i)
+          {
+            const std::size_t k = unconverged[i];
+            residual_norms[k]   = std::sqrt(sums[3 * i + 0]);
+            iterations[k]       = step;
+            if (residual_norms[k] > tolerances[k])
+              {
+                still_unconverged.push_back(k);
+                new_gammas.push_back(sums[3 * i + 1]);
+                deltas.push_back(sums[3 * i + 2]);
+              }
+          }
+        unconverged = std::move(still_unconverged);
+        if (unconverged.size() == 0 || step == max_iterations)
+          break;
+
+        // z = n + beta z, q = m + beta q, s = w + beta s, p = u + beta p, and
+        // x += alpha p, r -= alpha s, u -= alpha q, w -= alpha z:
+        for (std::size_t i = 0; i < unconverged.size(); ++i)
+          {
+            const std::size_t k     = unconverged[i];
+            const double      gamma = new_gammas[i];
+            const double      beta  = step == 0 ? 0.0 : gamma / gammas[k];
+            const double      alpha =
+              step == 0 ? gamma / deltas[i] :
+                          gamma / (deltas[i] - beta * gamma / alphas[k]);
+            z[k].sadd(beta, 1.0, n[k]);
+            q[k].sadd(beta, 1.0, m[k]);
+            s[k].sadd(beta, 1.0, w[k]);
+            p[k].sadd(beta, 1.0, u[k]);
+            solutions[k]->add(alpha, p[k]);
+            r[k].add(-alpha, s[k]);
+            u[k].add(-alpha, q[k]);
+            w[k].add(-alpha, z[k]);
+            gammas[k] = gamma;
+            alphas[k] = alpha;
+          }
+        ++step;
+      }
+
+    if (unconverged.size() > 0)
+      {
+        double largest_residual = 0.0;
+        for (const std::size_t k : unconverged)
+          largest_residual = std::max(largest_residual, residual_norms[k]);
+        AssertThrow(false,
+                    SolverControl::NoConvergence(step, largest_residual));
+      }
+
+    return iterations;
+  }
+
+  template <int dim, int spacedim>
+  std::vector<std::shared_ptr<PartGeometry<dim, spacedim>>>
+  create_part_geometries(
+    const MPI_Comm                                           communicator,
+    std::vector<PartMeshData<dim, spacedim>>               &&mesh_data,
+    const std::vector<const FiniteElement<dim, spacedim> *> &fes,
+    const bool                                               renumber_dofs,
+    const unsigned int                                       max_concurrency)
+  {
+    const std::size_t n_geometries = mesh_data.size();
+    AssertThrow(fes.size() == 1 || fes.size() == n_geometries,
+                ExcMessage("There should be either one finite element or one "
+                           "for each mesh."));
+
+    // Duplicating is collective over communicator, so do it here (in the
+    // same order on every processor) rather than on the threads.
+    std::vector<std::shared_ptr<const MPI_Comm>> communicators;
+    for (std::size_t i = 0; i < n_geometries; ++i)
+      {
+        MPI_Comm  duplicate = MPI_COMM_NULL;
+        const int ierr      = MPI_Comm_dup(communicator, &duplicate);
+        AssertThrowMPI(ierr);
+        communicators.emplace_back(new MPI_Comm(duplicate),
+                                   [](const MPI_Comm *comm)
+                                   {
+                                     int finalized = 0;
+                                     MPI_Finalized(&finalized);
+                                     if (!finalized)
+                                       {
+                                         MPI_Comm copy = *comm;
+                                         MPI_Comm_free(&copy);
+                                       }
+                                     delete comm;
+                                   });
+      }
+
+    int       thread_support = MPI_THREAD_SINGLE;
+    const int ierr           = MPI_Query_thread(&thread_support);
+    AssertThrowMPI(ierr);
+    const unsigned int batch_size = std::max(
+      1u,
+      Utilities::MPI::min(thread_support == MPI_THREAD_MULTIPLE ?
+                            max_concurrency :
+                            1u,
+                          communicator));
+
+    // Every geometry in a batch gets its own thread: with a task pool,
+    // processors could start the geometries in different orders and then
+    // deadlock in blocking collective operations.
+    std::vector<std::shared_ptr<PartGeometry<dim, spacedim>>> geometries(
+      n_geometries);
+    std::vector<std::exception_ptr> exceptions(n_geometries);
+    auto                            create = [&](const std::size_t i)
+    {
+      try
+        {
+          geometries[i] = std::make_shared<PartGeometry<dim, spacedim>>(
+            communicators[i],
+            std::move(mesh_data[i]),
+            *fes[fes.size() == 1 ? 0 : i],
+            renumber_dofs);
+        }
+      catch (...)
+        {
+          exceptions[i] = std::current_exception();
+        }
+    };
+    for (std::size_t first = 0; first < n_geometries; first += batch_size)
+      {
+        const std::size_t        last = std::min<std::size_t>(n_geometries,
+                                                       first + batch_size);
+        std::vector<std::thread> threads;
+        for (std::size_t i = first + 1; i < last; ++i)
+          threads.emplace_back(create, i);
+        create(first);
+        for (std::thread &thread : threads)
+          thread.join();
+      }
+    for (const std::exception_ptr &exception : exceptions)
+      if (exception)
+        std::rethrow_exception(exception);
+
+    return geometries;
+  }
+
+  template class PartGeometry<NDIM - 1, NDIM>;
+  template class PartGeometry<NDIM, NDIM>;
+
+  template std::vector<std::shared_ptr<PartGeometry<NDIM - 1, NDIM>>>
+  create_part_geometries(
+    const MPI_Comm,
+    std::vector<PartMeshData<NDIM - 1, NDIM>> &&,
+    const std::vector<const FiniteElement<NDIM - 1, NDIM> *> &,
+    const bool,
+    const unsigned int);
+  template std::vector<std::shared_ptr<PartGeometry<NDIM, NDIM>>>
+  create_part_geometries(const MPI_Comm,
+                         std::vector<PartMeshData<NDIM, NDIM>> &&,
+                         const std::vector<const FiniteElement<NDIM, NDIM> *> &,
+                         const bool,
+                         const unsigned int);
+} // namespace fdl
@@ -0,0 +1,232 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/part_refinement.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/fe_values_extractors.h>
+
+#include <deal.II/numerics/adaptation_strategies.h>
+#include <deal.II/numerics/cell_data_transfer.h>
+#include <deal.II/numerics/solution_transfer.h>
+
+#include <algorithm>
+
+namespace fdl
+{
+  namespace
+  {
+    /**
+     * Copy the values of @p src, defined on the DoFs of @p src_dof_handler,
+     * into the locally owned entries of @p dst, defined on the DoFs of @p
+     * dst_dof_handler. Both DoFHandlers must use the same Triangulation and
+     * FiniteElement but may number DoFs differently. Only locally owned
+     * cells are visited, so @p src must contain the values of all of their
+     * DoFs.
+     */
+    template <int dim,
+              int spacedim,
+              typename SrcVectorType,
+              typename DstVectorType>
+    void
+    copy_dof_values(const DoFHandler<dim, spacedim> &src_dof_handler,
+                    const SrcVectorType             &src,
+                    const DoFHandler<dim, spacedim> &dst_dof_handler,
+                    const IndexSet                  &dst_owned_dofs,
+                    DstVectorType                   &dst)
+    {
+      const FiniteElement<dim, spacedim> &fe = src_dof_handler.get_fe();
+      Vector<double>                      cell_values(fe.n_dofs_per_cell());
+      std::vector<types::global_dof_index> cell_dofs(fe.n_dofs_per_cell());
+      for (const auto &dst_cell : dst_dof_handler.active_cell_iterators())
+        if (dst_cell->is_locally_owned())
+          {
+            const typename DoFHandler<dim, spacedim>::active_cell_iterator
+              src_cell(&src_dof_handler.get_triangulation(),
+                       dst_cell->level(),
+                       dst_cell->index(),
+                       &src_dof_handler);
+            src_cell->get_dof_values(src, cell_values);
+            dst_cell->get_dof_indices(cell_dofs);
+            for (unsigned int i = 0; i < cell_dofs.size(); ++i)
+              if (dst_owned_dofs.is_element(cell_dofs[i]))
+                dst(cell_dofs[i]) = cell_values[i];
+          }
+    }
+  } // namespace
+
+  template <int dim, int spacedim>
+  Vector<float>
+  compute_strain_indicators(const Part<dim, spacedim> &part)
+  {
+    const Triangulation<dim, spacedim> &tria = part.get_triangulation();
+    const LinearAlgebra::distributed::Vector<double> &position =
+      part.get_position();
+    Assert(position.has_ghost_elements(),
+           ExcMessage("The position should have up-to-date ghost values."));
+
+    UpdateFlags flags = update_gradients;
+    if (dim != spacedim)
+      flags |= update_normal_vectors;
+    FEValues<dim, spacedim> fe_values(part.get_mapping(),
+                                      part.get_dof_handler().get_fe(),
+                                      part.get_quadrature(),
+                                      flags);
+
+    const FEValuesExtractors::Vector positions(0);
+    std::vector<Tensor<2, spacedim>> gradients(part.get_quadrature().size());
+
+    Vector<float> indicators(tria.n_active_cells());
+    for (const auto &cell : part.get_dof_handler().active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          fe_values.reinit(cell);
+          fe_values[positions].get_function_gradients(position, gradients);
+          double max_strain = 0.0;
+          for (unsigned int q = 0; q < gradients.size(); ++q)
+            {
+              // Projection onto the tangent space of the reference
+              // configuration, i.e., the gradient of the identity map
+              Tensor<2, spacedim> projection =
+                unit_symmetric_tensor<spacedim>();
+              if (dim != spacedim)
+                projection -= outer_product(fe_values.normal_vector(q),
+                                            fe_values.normal_vector(q));
+              const Tensor<2, spacedim> strain =
+                0.5 * (transpose(gradients[q]) * gradients[q] - projection);
+              max_strain = std::max(max_strain, strain.norm());
+            }
+          indicators[cell->active_cell_index()] = max_strain;
+        }
+
+    Utilities::MPI::sum(make_array_view(indicators),
+                        tria.get_communicator(),
+                        make_array_view(indicators));
+    return indicators;
+  }
+
+  template <int dim, int spacedim>
+  std::shared_ptr<PartGeometry<dim, spacedim>>
+  refine_and_coarsen_part(
+    parallel::shared::Triangulation<dim, spacedim> &tria,
+    const Part<dim, spacedim>                      &part,
+    LinearAlgebra::distributed::Vector<double>     &position,
+    LinearAlgebra::distributed::Vector<double>     &velocity,
+    std::vector<Vector<double>>                    &cell_data,
+    const bool                                      renumber_dofs)
+  {
+    AssertThrow(&part.get_triangulation() == &tria,
+                ExcMessage("The part should use the provided Triangulation."));
+    AssertThrow(!tria.with_artificial_cells(), ExcFDLNotImplemented());
+    for (const Vector<double> &data : cell_data)
+      AssertDimension(data.size(), tria.n_active_cells());
+    const MPI_Comm communicator = tria.get_communicator();
+    const std::unique_ptr<FiniteElement<dim, spacedim>> fe =
+      part.get_dof_handler().get_fe().clone();
+
+    // The DoFHandler of the part may use a different numbering and cannot be
+    // modified, so transfer the fields with our own DoFHandler. Each
+    // processor copies the DoFs it owns and then the values are summed so
+    // that every processor has the complete fields, which the serial
+    // SolutionTransfer requires.
+    DoFHandler<dim, spacedim> transfer_dof_handler(tria);
+    transfer_dof_handler.distribute_dofs(*fe);
+    const IndexSet &owned_dofs = transfer_dof_handler.locally_owned_dofs();
+    std::vector<Vector<double>> old_fields(
+      2, Vector<double>(transfer_dof_handler.n_dofs()));
+    {
+      LinearAlgebra::distributed::Vector<double> field(part.get_partitioner());
+      const LinearAlgebra::distributed::Vector<double> *const part_fields[2] =
+        {&part.get_position(), &part.get_velocity()};
+      for (unsigned int k = 0; k < 2; ++k)
+        {
+          field = *part_fields[k];
+          field.update_ghost_values();
+          copy_dof_values(part.get_dof_handler(),
+                          field,
+                          transfer_dof_handler,
+                          owned_dofs,
+                          old_fields[k]);
+          Utilities::MPI::sum(make_array_view(old_fields[k]),
+                              communicator,
+                              make_array_view(old_fields[k]));
+        }
+    }
+
+    SolutionTransfer<dim, Vector<double>, spacedim> solution_transfer(
+      transfer_dof_handler);
+    CellDataTransfer<dim, spacedim, Vector<double>> cell_data_transfer(
+      tria,
+      &AdaptationStrategies::Refinement::preserve<dim, spacedim, double>,
+      &AdaptationStrategies::Coarsening::mean<dim, spacedim, double>);
+    tria.prepare_coarsening_and_refinement();
+    solution_transfer.prepare_for_coarsening_and_refinement(old_fields);
+    cell_data_transfer.prepare_for_coarsening_and_refinement();
+    tria.execute_coarsening_and_refinement();
+
+    // Cell data:
+    for (Vector<double> &data : cell_data)
+      {
+        Vector<double> new_data(tria.n_active_cells());
+        cell_data_transfer.unpack(data, new_data);
+        data.swap(new_data);
+      }
+
+    // FE fields:
+    transfer_dof_handler.distribute_dofs(*fe);
+    std::vector<Vector<double>> new_fields(
+      2, Vector<double>(transfer_dof_handler.n_dofs()));
+    solution_transfer.interpolate(old_fields, new_fields);
+
+    auto geometry =
+      std::make_shared<PartGeometry<dim, spacedim>>(tria, *fe, renumber_dofs);
+    const IndexSet &new_owned_dofs =
+      geometry->get_dof_handler().locally_owned_dofs();
+    LinearAlgebra::distributed::Vector<double> *const fields[2] = {&position,
+                                                                   &velocity};
+    for (unsigned int k = 0; k < 2; ++k)
+      {
+        LinearAlgebra::distributed::Vector<double> &field = *fields[k];
+        field.reinit(geometry->get_partitioner());
+        copy_dof_values(transfer_dof_handler,
+                        new_fields[k],
+                        geometry->get_dof_handler(),
+                        new_owned_dofs,
+                        field);
+        if (geometry->has_constraints())
+          geometry->get_constraints().distribute(field);
+        field.update_ghost_values();
+      }
+
+    return geometry;
+  }
+
+  template Vector<float>
+  compute_strain_indicators(const Part<NDIM - 1, NDIM> &part);
+
+  template Vector<float>
+  compute_strain_indicators(const Part<NDIM, NDIM> &part);
+
+  template std::shared_ptr<PartGeometry<NDIM - 1, NDIM>>
+  refine_and_coarsen_part(
+    parallel::shared::Triangulation<NDIM - 1, NDIM> &tria,
+    const Part<NDIM - 1, NDIM>                      &part,
+    LinearAlgebra::distributed::Vector<double>      &position,
+    LinearAlgebra::distributed::Vector<double>      &velocity,
+    std::vector<Vector<double>>                     &cell_data,
+    const bool                                       renumber_dofs);
+
+  template std::shared_ptr<PartGeometry<NDIM, NDIM>>
+  refine_and_coarsen_part(
+    parallel::shared::Triangulation<NDIM, NDIM> &tria,
+    const Part<NDIM, NDIM>                      &part,
+    LinearAlgebra::distributed::Vector<double>  &position,
+    LinearAlgebra::distributed::Vector<double>  &velocity,
+    std::vector<Vector<double>>                 &cell_data,
+    const bool                                   renumber_dofs);
+} // namespace fdl
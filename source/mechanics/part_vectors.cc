@@ -8,9 +8,19 @@ namespace fdl
   template <int dim, int spacedim>
   PartVectors<dim, spacedim>::PartVectors(
     const std::vector<Part<dim, spacedim>> &parts)
+    : n_position_updates(0)
   {
     for (const auto &part : parts)
       this->parts.push_back(&part);
+
+    // Only the vector objects are created here - storage is allocated when
+    // vectors are set
+    for (auto &quantity_vectors : vectors)
+      for (auto &level_vectors : quantity_vectors)
+        level_vectors.resize(parts.size());
+    for (auto &level_versions : position_versions)
+      level_versions.resize(parts.size());
+    spare_vectors.resize(parts.size());
   }
 
 
@@ -35,34 +45,85 @@ namespace fdl
     half_time    = std::numeric_limits<double>::signaling_NaN();
     new_time     = std::numeric_limits<double>::signaling_NaN();
 
-    half_positions.clear();
-    new_positions.clear();
-    half_velocities.clear();
-    new_velocities.clear();
+    for (auto &quantity_vectors : vectors)
+      for (auto &level_vectors : quantity_vectors)
+        for (unsigned int part_n = 0; part_n < level_vectors.size(); ++part_n)
+          if (level_vectors[part_n].size() > 0)
+            retire_vector(part_n, std::move(level_vectors[part_n]));
+  }
+
+
+
+  template <int dim, int spacedim>
+  LinearAlgebra::distributed::Vector<double>
+  PartVectors<dim, spacedim>::get_spare_vector(const unsigned int part_n) const
+  {
+    AssertIndexRange(part_n, parts.size());
+    const auto &partitioner = parts[part_n]->get_partitioner();
+    auto       &spares      = spare_vectors[part_n];
 
-    current_forces.clear();
-    half_forces.clear();
-    new_forces.clear();
+    VectorType vector;
+    // The part's partitioner changes if its Triangulation is redistributed,
+    // so discard spare vectors which are no longer compatible
+    while (spares.size() > 0 && vector.size() == 0)
+      {
+        if (spares.back().get_partitioner() == partitioner)
+          vector.swap(spares.back());
+        spares.pop_back();
+      }
+
+    if (vector.size() == 0)
+      vector.reinit(partitioner);
+    else
+      {
+        vector = 0.0;
+        vector.zero_out_ghost_values();
+      }
+    return vector;
   }
 
 
 
   template <int dim, int spacedim>
-  std::vector<LinearAlgebra::distributed::Vector<double>>
-  PartVectors<dim, spacedim>::get_all_new_positions()
+  void
+  PartVectors<dim, spacedim>::swap_new_state_into(
+    std::vector<Part<dim, spacedim>> &parts)
   {
-    Assert(parts.size() == new_positions.size(), ExcVectorNotAvailable());
-    return std::move(new_positions);
+    AssertDimension(parts.size(), this->parts.size());
+    for (unsigned int part_n = 0; part_n < parts.size(); ++part_n)
+      {
+        Assert(&parts[part_n] == this->parts[part_n], ExcFDLInternalError());
+        auto &position =
+          vectors[int(Quantity::Position)][int(TimeStep::New)][part_n];
+        auto &velocity =
+          vectors[int(Quantity::Velocity)][int(TimeStep::New)][part_n];
+        Assert(position.size() > 0, ExcVectorNotAvailable());
+        Assert(velocity.size() > 0, ExcVectorNotAvailable());
+
+        // Part swaps its vectors with the arguments, so we now own the old
+        // ones
+        parts[part_n].set_position(std::move(position));
+        parts[part_n].set_velocity(std::move(velocity));
+        retire_vector(part_n, std::move(position));
+        retire_vector(part_n, std::move(velocity));
+      }
   }
 
 
 
   template <int dim, int spacedim>
-  std::vector<LinearAlgebra::distributed::Vector<double>>
-  PartVectors<dim, spacedim>::get_all_new_velocities()
+  std::size_t
+  PartVectors<dim, spacedim>::memory_consumption() const
   {
-    Assert(parts.size() == new_velocities.size(), ExcVectorNotAvailable());
-    return std::move(new_velocities);
+    std::size_t result = 0;
+    for (const auto &quantity_vectors : vectors)
+      for (const auto &time_step_vectors : quantity_vectors)
+        for (const VectorType &vector : time_step_vectors)
+          result += vector.memory_consumption();
+    for (const auto &part_vectors : spare_vectors)
+      for (const VectorType &vector : part_vectors)
+        result += vector.memory_consumption();
+    return result;
   }
 
 
@@ -84,6 +145,59 @@ namespace fdl
 
 
 
+  template <int dim, int spacedim>
+  const LinearAlgebra::distributed::Vector<double> &
+  PartVectors<dim, spacedim>::get_vector(const Quantity     quantity,
+                                         const TimeStep     time_step,
+                                         const unsigned int part_n) const
+  {
+    AssertIndexRange(part_n, parts.size());
+    const VectorType &vector = vectors[int(quantity)][int(time_step)][part_n];
+    Assert(vector.size() > 0, ExcVectorNotAvailable());
+    return vector;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  PartVectors<dim, spacedim>::set_vector(const Quantity     quantity,
+                                         const TimeStep     time_step,
+                                         const unsigned int part_n,
+                                         VectorType       &&vector)
+  {
+    AssertIndexRange(part_n, parts.size());
+    vector.set_ghost_state(false);
+    VectorType &stored = vectors[int(quantity)][int(time_step)][part_n];
+    stored.swap(vector);
+    if (vector.size() > 0)
+      retire_vector(part_n, std::move(vector));
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  PartVectors<dim, spacedim>::retire_vector(const unsigned int part_n,
+                                            VectorType       &&vector) const
+  {
+    AssertIndexRange(part_n, spare_vectors.size());
+    // Each part uses at most one vector for each quantity and time level
+    // (counting the Part's own position and velocity as the current ones)
+    // during a time step, so keeping more spare vectors than that would only
+    // waste memory
+    auto &spares = spare_vectors[part_n];
+    if (spares.size() < vectors.size() * vectors.front().size())
+      {
+        spares.emplace_back();
+        spares.back().swap(vector);
+      }
+    else
+      VectorType().swap(vector);
+  }
+
+
+
   //
   // Vector access
   //
@@ -93,20 +207,10 @@ namespace fdl
                                            const double       time) const
   {
     AssertIndexRange(part_n, parts.size());
-    switch (get_time_step(time))
-      {
-        case TimeStep::Current:
-          return parts[part_n]->get_position();
-        case TimeStep::Half:
-          Assert(part_n < half_positions.size(), ExcVectorNotAvailable());
-          return half_positions[part_n];
-        case TimeStep::New:
-          Assert(part_n < new_positions.size(), ExcVectorNotAvailable());
-          return new_positions[part_n];
-      }
-
-    Assert(false, ExcFDLInternalError());
-    return parts[part_n]->get_position();
+    const TimeStep time_step = get_time_step(time);
+    if (time_step == TimeStep::Current)
+      return parts[part_n]->get_position();
+    return get_vector(Quantity::Position, time_step, part_n);
   }
 
 
@@ -118,25 +222,25 @@ namespace fdl
     const double                               time,
     LinearAlgebra::distributed::Vector<double> position)
   {
-    AssertIndexRange(part_n, parts.size());
-    position.set_ghost_state(false);
-    switch (get_time_step(time))
-      {
-        case TimeStep::Current:
-          Assert(false, ExcMessage("cannot set position at current time"));
-        case TimeStep::Half:
-          half_positions.resize(
-            std::max(std::size_t(part_n + 1), half_positions.size()));
-          half_positions[part_n].swap(position);
-          return;
-        case TimeStep::New:
-          new_positions.resize(
-            std::max(std::size_t(part_n + 1), new_positions.size()));
-          new_positions[part_n].swap(position);
-          return;
-      }
+    const TimeStep time_step = get_time_step(time);
+    Assert(time_step != TimeStep::Current,
+           ExcMessage("cannot set position at current time"));
+    set_vector(Quantity::Position, time_step, part_n, std::move(position));
+    position_versions[int(time_step)][part_n] = ++n_position_updates;
+  }
 
-    Assert(false, ExcFDLInternalError());
+
+
+  template <int dim, int spacedim>
+  std::uint64_t
+  PartVectors<dim, spacedim>::get_position_version(const unsigned int part_n,
+                                                   const double time) const
+  {
+    AssertIndexRange(part_n, parts.size());
+    const TimeStep time_step = get_time_step(time);
+    if (time_step == TimeStep::Current)
+      return parts[part_n]->get_position_version();
+    return position_versions[int(time_step)][part_n];
   }
 
 
@@ -147,20 +251,10 @@ namespace fdl
                                            const double       time) const
   {
     AssertIndexRange(part_n, parts.size());
-    switch (get_time_step(time))
-      {
-        case TimeStep::Current:
-          return parts[part_n]->get_velocity();
-        case TimeStep::Half:
-          Assert(part_n < half_velocities.size(), ExcVectorNotAvailable());
-          return half_velocities[part_n];
-        case TimeStep::New:
-          Assert(part_n < new_velocities.size(), ExcVectorNotAvailable());
-          return new_velocities[part_n];
-      }
-
-    Assert(false, ExcFDLInternalError());
-    return parts[part_n]->get_velocity();
+    const TimeStep time_step = get_time_step(time);
+    if (time_step == TimeStep::Current)
+      return parts[part_n]->get_velocity();
+    return get_vector(Quantity::Velocity, time_step, part_n);
   }
 
 
@@ -171,25 +265,10 @@ namespace fdl
     const double                               time,
     LinearAlgebra::distributed::Vector<double> velocity)
   {
-    AssertIndexRange(part_n, parts.size());
-    velocity.set_ghost_state(false);
-    switch (get_time_step(time))
-      {
-        case TimeStep::Current:
-          Assert(false, ExcMessage("cannot set velocity at current time"));
-        case TimeStep::Half:
-          half_velocities.resize(
-            std::max(std::size_t(part_n + 1), half_velocities.size()));
-          half_velocities[part_n].swap(velocity);
-          return;
-        case TimeStep::New:
-          new_velocities.resize(
-            std::max(std::size_t(part_n + 1), new_velocities.size()));
-          new_velocities[part_n].swap(velocity);
-          return;
-      }
-
-    Assert(false, ExcFDLInternalError());
+    const TimeStep time_step = get_time_step(time);
+    Assert(time_step != TimeStep::Current,
+           ExcMessage("cannot set velocity at current time"));
+    set_vector(Quantity::Velocity, time_step, part_n, std::move(velocity));
   }
 
 
@@ -199,22 +278,7 @@ namespace fdl
   PartVectors<dim, spacedim>::get_force(const unsigned int part_n,
                                         const double       time) const
   {
-    AssertIndexRange(part_n, parts.size());
-    switch (get_time_step(time))
-      {
-        case TimeStep::Current:
-          Assert(part_n < current_forces.size(), ExcVectorNotAvailable());
-          return current_forces[part_n];
-        case TimeStep::Half:
-          Assert(part_n < half_forces.size(), ExcVectorNotAvailable());
-          return half_forces[part_n];
-        case TimeStep::New:
-          Assert(part_n < new_forces.size(), ExcVectorNotAvailable());
-          return new_forces[part_n];
-      }
-
-    Assert(false, ExcFDLInternalError());
-    return parts[part_n]->get_position();
+    return get_vector(Quantity::Force, get_time_step(time), part_n);
   }
 
 
@@ -226,28 +290,7 @@ namespace fdl
     const double                               time,
     LinearAlgebra::distributed::Vector<double> force)
   {
-    AssertIndexRange(part_n, parts.size());
-    force.set_ghost_state(false);
-    switch (get_time_step(time))
-      {
-        case TimeStep::Current:
-          current_forces.resize(
-            std::max(std::size_t(part_n + 1), current_forces.size()));
-          current_forces[part_n].swap(force);
-          return;
-        case TimeStep::Half:
-          half_forces.resize(
-            std::max(std::size_t(part_n + 1), half_forces.size()));
-          half_forces[part_n].swap(force);
-          return;
-        case TimeStep::New:
-          new_forces.resize(
-            std::max(std::size_t(part_n + 1), new_forces.size()));
-          new_forces[part_n].swap(force);
-          return;
-      }
-
-    Assert(false, ExcFDLInternalError());
+    set_vector(Quantity::Force, get_time_step(time), part_n, std::move(force));
   }
 
   template class PartVectors<NDIM - 1, NDIM>;
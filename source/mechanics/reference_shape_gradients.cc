@@ -0,0 +1,86 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/reference_shape_gradients.h>
+
+#include <deal.II/base/memory_consumption.h>
+
+#include <deal.II/fe/fe_values.h>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  template <int dim, int spacedim>
+  ReferenceShapeGradients<dim, spacedim>::ReferenceShapeGradients(
+    const Mapping<dim, spacedim>    &mapping,
+    const DoFHandler<dim, spacedim> &dof_handler,
+    const Quadrature<dim>           &quadrature)
+    : dof_handler(&dof_handler)
+    , quadrature(quadrature)
+  {
+    const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
+    AssertThrow(fe.is_primitive(),
+                ExcMessage("The finite element must be primitive."));
+    AssertThrow(fe.n_components() == spacedim,
+                ExcMessage(
+                  "The finite element must have spacedim components."));
+    const unsigned int dofs_per_cell       = fe.dofs_per_cell;
+    const unsigned int n_quadrature_points = quadrature.size();
+
+    components.resize(dofs_per_cell);
+    for (unsigned int i = 0; i < dofs_per_cell; ++i)
+      components[i] = fe.system_to_component_index(i).first;
+
+    const auto &tria = dof_handler.get_triangulation();
+    cell_offsets.resize(tria.n_active_cells(), numbers::invalid_unsigned_int);
+    unsigned int n_locally_owned_cells = 0;
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      if (cell->is_locally_owned())
+        cell_offsets[cell->active_cell_index()] = n_locally_owned_cells++;
+
+    dof_indices.resize(n_locally_owned_cells * dofs_per_cell);
+    shape_gradients.resize(std::size_t(n_locally_owned_cells) *
+                           n_quadrature_points * dofs_per_cell);
+    JxW_values.resize(n_locally_owned_cells * n_quadrature_points);
+
+    FEValues<dim, spacedim> fe_values(mapping,
+                                      fe,
+                                      quadrature,
+                                      update_gradients | update_JxW_values);
+    std::vector<types::global_dof_index> cell_dofs(dofs_per_cell);
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          const std::size_t offset = cell_offsets[cell->active_cell_index()];
+          fe_values.reinit(cell);
+          cell->get_dof_indices(cell_dofs);
+          std::copy(cell_dofs.begin(),
+                    cell_dofs.end(),
+                    dof_indices.begin() + offset * dofs_per_cell);
+          for (unsigned int q = 0; q < n_quadrature_points; ++q)
+            {
+              JxW_values[offset * n_quadrature_points + q] = fe_values.JxW(q);
+              for (unsigned int i = 0; i < dofs_per_cell; ++i)
+                shape_gradients[(offset * n_quadrature_points + q) *
+                                  dofs_per_cell +
+                                i] =
+                  fe_values.shape_grad_component(i, q, components[i]);
+            }
+        }
+  }
+
+  template <int dim, int spacedim>
+  std::size_t
+  ReferenceShapeGradients<dim, spacedim>::memory_consumption() const
+  {
+    return MemoryConsumption::memory_consumption(quadrature) +
+           MemoryConsumption::memory_consumption(components) +
+           MemoryConsumption::memory_consumption(cell_offsets) +
+           MemoryConsumption::memory_consumption(dof_indices) +
+           MemoryConsumption::memory_consumption(shape_gradients) +
+           MemoryConsumption::memory_consumption(JxW_values);
+  }
+
+  template class ReferenceShapeGradients<NDIM - 1, NDIM>;
+  template class ReferenceShapeGradients<NDIM, NDIM>;
+} // namespace fdl
@@ -0,0 +1,230 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/rigid_body_projection.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/fe/fe.h>
+
+namespace fdl
+{
+  namespace
+  {
+    // Embed a dim-dimensional vector in 3D so that cross products can be
+    // computed in the same way in 2D and 3D.
+    template <int dim>
+    Tensor<1, 3>
+    to_3d(const Tensor<1, dim> &t)
+    {
+      Tensor<1, 3> result;
+      for (unsigned int d = 0; d < dim; ++d)
+        result[d] = t[d];
+      return result;
+    }
+  } // namespace
+
+  template <int dim>
+  RigidBodyProjection<dim>::RigidBodyProjection(const Part<dim> &part)
+    : part(&part)
+    , mass(0.0)
+  {
+    const DoFHandler<dim>    &dof_handler = part.get_dof_handler();
+    const FiniteElement<dim> &fe          = dof_handler.get_fe();
+    AssertThrow(fe.n_base_elements() == 1 && fe.element_multiplicity(0) == dim,
+                ExcMessage("Rigid parts require an FESystem with dim copies "
+                           "of a single scalar element."));
+    const Utilities::MPI::Partitioner &partitioner = *part.get_partitioner();
+
+    // Find the DoFs of each locally owned node. All DoFs at a node are owned
+    // by the same processor so it suffices to check the first one.
+    std::vector<bool> found_node(partitioner.locally_owned_size(), false);
+    std::vector<types::global_dof_index> cell_dofs(fe.dofs_per_cell);
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          cell->get_dof_indices(cell_dofs);
+          for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+            {
+              const std::pair<unsigned int, unsigned int> component_index =
+                fe.system_to_component_index(i);
+              if (component_index.first != 0 ||
+                  !partitioner.in_local_range(cell_dofs[i]))
+                continue;
+              const unsigned int local_index =
+                partitioner.global_to_local(cell_dofs[i]);
+              if (found_node[local_index])
+                continue;
+              found_node[local_index] = true;
+
+              std::array<types::global_dof_index, dim> node;
+              for (unsigned int c = 0; c < dim; ++c)
+                {
+                  node[c] = cell_dofs[fe.component_to_system_index(
+                    c, component_index.second)];
+                  Assert(partitioner.in_local_range(node[c]),
+                         ExcFDLInternalError());
+                }
+              node_dofs.push_back(node);
+            }
+        }
+
+    // The lumped masses are the row sums of the mass matrix.
+    LinearAlgebra::distributed::Vector<double> ones(part.get_partitioner());
+    ones = 1.0;
+    inverse_lumped_masses.reinit(part.get_partitioner());
+    part.apply_mass_operator({&inverse_lumped_masses}, {&ones});
+    for (const auto &node : node_dofs)
+      {
+        node_masses.push_back(inverse_lumped_masses(node[0]));
+        mass += node_masses.back();
+      }
+    mass = Utilities::MPI::sum(mass, part.get_communicator());
+    for (unsigned int i = 0; i < inverse_lumped_masses.locally_owned_size();
+         ++i)
+      {
+        double &value = inverse_lumped_masses.local_element(i);
+        AssertThrow(value > 0.0,
+                    ExcMessage("Rigid parts require positive lumped masses, "
+                               "i.e., elements like FE_Q without hanging "
+                               "nodes."));
+        value = 1.0 / value;
+      }
+
+    rigid_velocity.reinit(part.get_partitioner());
+    lumped_velocity.reinit(part.get_partitioner());
+  }
+
+  template <int dim>
+  void
+  RigidBodyProjection<dim>::project(
+    const LinearAlgebra::distributed::Vector<double> &position,
+    const LinearAlgebra::distributed::Vector<double> &rhs,
+    LinearAlgebra::distributed::Vector<double>       &velocity)
+  {
+    AssertDimension(rhs.locally_owned_size(),
+                    lumped_velocity.locally_owned_size());
+
+    // Compute all raw moments with a single reduction: sum_i m_i X_i, sum_i
+    // b_i, sum_i m_i X_i X_i^T, and sum_i X_i x b_i, in that order.
+    constexpr unsigned int moment_offset = 2 * dim;
+    constexpr unsigned int cross_offset  = moment_offset + dim * dim;
+    std::vector<double>    sums(cross_offset + 3, 0.0);
+    for (std::size_t n = 0; n < node_dofs.size(); ++n)
+      {
+        Tensor<1, dim> X, b;
+        for (unsigned int c = 0; c < dim; ++c)
+          {
+            X[c] = position(node_dofs[n][c]);
+            b[c] = rhs(node_dofs[n][c]);
+          }
+        for (unsigned int c = 0; c < dim; ++c)
+          {
+            sums[c] += node_masses[n] * X[c];
+            sums[dim + c] += b[c];
+            for (unsigned int d = 0; d < dim; ++d)
+              sums[moment_offset + c * dim + d] += node_masses[n] * X[c] * X[d];
+          }
+        const Tensor<1, 3> X_cross_b = cross_product_3d(to_3d(X), to_3d(b));
+        for (unsigned int d = 0; d < 3; ++d)
+          sums[cross_offset + d] += X_cross_b[d];
+      }
+    Utilities::MPI::sum(sums, part->get_communicator(), sums);
+
+    // Shift the moments to the center of mass:
+    Tensor<1, dim> momentum;
+    Tensor<2, dim> second_moment;
+    for (unsigned int c = 0; c < dim; ++c)
+      {
+        center[c]   = sums[c] / mass;
+        momentum[c] = sums[dim + c];
+      }
+    for (unsigned int c = 0; c < dim; ++c)
+      for (unsigned int d = 0; d < dim; ++d)
+        second_moment[c][d] =
+          sums[moment_offset + c * dim + d] - mass * center[c] * center[d];
+    Tensor<1, 3> angular_momentum;
+    for (unsigned int d = 0; d < 3; ++d)
+      angular_momentum[d] = sums[cross_offset + d];
+    angular_momentum -= cross_product_3d(to_3d(Tensor<1, dim>(center)),
+                                         to_3d(momentum));
+
+    translational_velocity = momentum / mass;
+    angular_velocity       = 0.0;
+    if (dim == 2)
+      angular_velocity[2] =
+        angular_momentum[2] / (second_moment[0][0] + second_moment[1][1]);
+    else
+      {
+        Tensor<2, 3> inertia;
+        for (unsigned int c = 0; c < dim; ++c)
+          {
+            inertia[c][c] = trace(second_moment);
+            for (unsigned int d = 0; d < dim; ++d)
+              inertia[c][d] -= second_moment[c][d];
+          }
+        angular_velocity = invert(inertia) * angular_momentum;
+      }
+
+    // Evaluate the rigid velocity at the nodes:
+    for (const auto &node : node_dofs)
+      {
+        Tensor<1, dim> r;
+        for (unsigned int c = 0; c < dim; ++c)
+          r[c] = position(node[c]) - center[c];
+        const Tensor<1, 3> rotation =
+          cross_product_3d(angular_velocity, to_3d(r));
+        for (unsigned int c = 0; c < dim; ++c)
+          rigid_velocity(node[c]) = translational_velocity[c] + rotation[c];
+      }
+    for (unsigned int i = 0; i < lumped_velocity.locally_owned_size(); ++i)
+      lumped_velocity.local_element(i) =
+        rhs.local_element(i) * inverse_lumped_masses.local_element(i);
+
+    if (velocity.get_partitioner() != part->get_partitioner())
+      velocity.reinit(part->get_partitioner());
+    velocity.copy_locally_owned_data_from(rigid_velocity);
+  }
+
+  template <int dim>
+  void
+  RigidBodyProjection<dim>::compute_constraint_force(
+    const double                                coefficient,
+    LinearAlgebra::distributed::Vector<double> &force) const
+  {
+    if (force.get_partitioner() != part->get_partitioner())
+      force.reinit(part->get_partitioner());
+    force.copy_locally_owned_data_from(rigid_velocity);
+    force -= lumped_velocity;
+    force *= coefficient;
+  }
+
+  template <int dim>
+  double
+  RigidBodyProjection<dim>::get_mass() const
+  {
+    return mass;
+  }
+
+  template <int dim>
+  const Point<dim> &
+  RigidBodyProjection<dim>::get_center() const
+  {
+    return center;
+  }
+
+  template <int dim>
+  const Tensor<1, dim> &
+  RigidBodyProjection<dim>::get_translational_velocity() const
+  {
+    return translational_velocity;
+  }
+
+  template <int dim>
+  const Tensor<1, 3> &
+  RigidBodyProjection<dim>::get_angular_velocity() const
+  {
+    return angular_velocity;
+  }
+
+  template class RigidBodyProjection<NDIM>;
+} // namespace fdl
@@ -0,0 +1,195 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/simplex_mass_operator.h>
+
+#include <deal.II/base/aligned_vector.h>
+
+#include <deal.II/grid/reference_cell.h>
+
+FDL_DISABLE_EXTRA_DIAGNOSTICS
+#include <deal.II/matrix_free/fe_evaluation.h>
+FDL_ENABLE_EXTRA_DIAGNOSTICS
+
+namespace fdl
+{
+  namespace
+  {
+    // Number of DoFs of FE_SimplexP<dim>(degree).
+    template <int dim>
+    constexpr int
+    n_simplex_dofs(const int degree)
+    {
+      return dim == 1 ? degree + 1 :
+             dim == 2 ? (degree + 1) * (degree + 2) / 2 :
+                        (degree + 1) * (degree + 2) * (degree + 3) / 6;
+    }
+
+    // Apply the mass matrix on each cell batch in cell_range. If n_dofs is
+    // positive then it is the number of DoFs per component, which lets the
+    // compiler unroll the inner loops.
+    template <int dim, int n_dofs>
+    void
+    apply_simplex_mass_operator(
+      const MatrixFree<dim, double> &data,
+      const std::vector<double>     &shape_values,
+      const unsigned int             n_dofs_per_component,
+      const std::vector<LinearAlgebra::distributed::Vector<double> *> &dst,
+      const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+                                                  &src,
+      const std::pair<unsigned int, unsigned int> &cell_range)
+    {
+      Assert(n_dofs <= 0 || n_dofs == int(n_dofs_per_component),
+             ExcFDLInternalError());
+      const unsigned int n = n_dofs > 0 ? n_dofs : n_dofs_per_component;
+
+      FEEvaluation<dim, -1, 0, dim, double>  phi(data);
+      const unsigned int                     n_q_points = phi.n_q_points;
+      AlignedVector<VectorizedArray<double>> values(n_q_points);
+      for (unsigned int cell = cell_range.first; cell < cell_range.second;
+           ++cell)
+        {
+          phi.reinit(cell);
+          for (std::size_t k = 0; k < src.size(); ++k)
+            {
+              phi.read_dof_values(*src[k]);
+              for (unsigned int c = 0; c < dim; ++c)
+                {
+                  // FEEvaluation stores the DoFs of each component
+                  // contiguously
+                  VectorizedArray<double> *dof_values =
+                    phi.begin_dof_values() + c * n;
+                  for (unsigned int q = 0; q < n_q_points; ++q)
+                    {
+                      const double *const     N = &shape_values[q * n];
+                      VectorizedArray<double> value = 0.0;
+                      for (unsigned int i = 0; i < n; ++i)
+                        value += N[i] * dof_values[i];
+                      values[q] = value * phi.JxW(q);
+                    }
+                  for (unsigned int i = 0; i < n; ++i)
+                    dof_values[i] = 0.0;
+                  for (unsigned int q = 0; q < n_q_points; ++q)
+                    {
+                      const double *const N = &shape_values[q * n];
+                      for (unsigned int i = 0; i < n; ++i)
+                        dof_values[i] += N[i] * values[q];
+                    }
+                }
+              phi.distribute_local_to_global(*dst[k]);
+            }
+        }
+    }
+  } // namespace
+
+  template <int dim>
+  void
+  SimplexMassOperator<dim>::initialize(
+    std::shared_ptr<const MatrixFree<dim, double>> matrix_free)
+  {
+    MatrixFreeOperators::Base<dim, LinearAlgebra::distributed::Vector<double>>::
+      initialize(matrix_free);
+
+    const FiniteElement<dim> &fe = matrix_free->get_dof_handler().get_fe();
+    AssertThrow(fe.reference_cell().is_simplex(),
+                ExcMessage("This class only supports simplex elements."));
+    AssertThrow(fe.n_base_elements() == 1 && fe.element_multiplicity(0) == dim,
+                ExcMessage("The finite element should consist of dim copies "
+                           "of a scalar element."));
+    const FiniteElement<dim> &scalar_fe  = fe.base_element(0);
+    const Quadrature<dim>    &quadrature = matrix_free->get_quadrature();
+
+    n_dofs_per_component = scalar_fe.n_dofs_per_cell();
+    shape_values.resize(quadrature.size() * n_dofs_per_component);
+    for (unsigned int q = 0; q < quadrature.size(); ++q)
+      for (unsigned int i = 0; i < n_dofs_per_component; ++i)
+        shape_values[q * n_dofs_per_component + i] =
+          scalar_fe.shape_value(i, quadrature.point(q));
+  }
+
+  template <int dim>
+  void
+  SimplexMassOperator<dim>::compute_diagonal()
+  {
+    // Same as MassOperator::compute_diagonal(): use row sums
+    using VectorType = LinearAlgebra::distributed::Vector<double>;
+    this->inverse_diagonal_entries.reset(new DiagonalMatrix<VectorType>());
+    this->diagonal_entries.reset(new DiagonalMatrix<VectorType>());
+    VectorType &inverse_diagonal_vector =
+      this->inverse_diagonal_entries->get_vector();
+    VectorType &diagonal_vector = this->diagonal_entries->get_vector();
+    this->initialize_dof_vector(inverse_diagonal_vector);
+    this->initialize_dof_vector(diagonal_vector);
+    inverse_diagonal_vector = 1.0;
+    apply_add(diagonal_vector, inverse_diagonal_vector);
+
+    this->set_constrained_entries_to_one(diagonal_vector);
+    inverse_diagonal_vector = diagonal_vector;
+    for (unsigned int i = 0; i < inverse_diagonal_vector.locally_owned_size();
+         ++i)
+      inverse_diagonal_vector.local_element(i) =
+        1.0 / inverse_diagonal_vector.local_element(i);
+
+    inverse_diagonal_vector.update_ghost_values();
+    diagonal_vector.update_ghost_values();
+  }
+
+  template <int dim>
+  void
+  SimplexMassOperator<dim>::apply_add_to_cells(
+    const std::vector<LinearAlgebra::distributed::Vector<double> *> &dst,
+    const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+      &src) const
+  {
+    AssertDimension(dst.size(), src.size());
+    apply_add_to_cell_range(dst, src, {0, this->data->n_cell_batches()});
+  }
+
+  template <int dim>
+  void
+  SimplexMassOperator<dim>::apply_add(
+    LinearAlgebra::distributed::Vector<double>       &dst,
+    const LinearAlgebra::distributed::Vector<double> &src) const
+  {
+    using VectorType = LinearAlgebra::distributed::Vector<double>;
+    this->data->cell_loop(
+      [&](const MatrixFree<dim, double> &,
+          VectorType                                  &cell_dst,
+          const VectorType                            &cell_src,
+          const std::pair<unsigned int, unsigned int> &cell_range)
+      { apply_add_to_cell_range({&cell_dst}, {&cell_src}, cell_range); },
+      dst,
+      src);
+  }
+
+  template <int dim>
+  void
+  SimplexMassOperator<dim>::apply_add_to_cell_range(
+    const std::vector<LinearAlgebra::distributed::Vector<double> *> &dst,
+    const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+                                                &src,
+    const std::pair<unsigned int, unsigned int> &cell_range) const
+  {
+    const auto &data = *this->data;
+    switch (n_dofs_per_component)
+      {
+        case n_simplex_dofs<dim>(1):
+          apply_simplex_mass_operator<dim, n_simplex_dofs<dim>(1)>(
+            data, shape_values, n_dofs_per_component, dst, src, cell_range);
+          break;
+        case n_simplex_dofs<dim>(2):
+          apply_simplex_mass_operator<dim, n_simplex_dofs<dim>(2)>(
+            data, shape_values, n_dofs_per_component, dst, src, cell_range);
+          break;
+        case n_simplex_dofs<dim>(3):
+          apply_simplex_mass_operator<dim, n_simplex_dofs<dim>(3)>(
+            data, shape_values, n_dofs_per_component, dst, src, cell_range);
+          break;
+        default:
+          apply_simplex_mass_operator<dim, -1>(
+            data, shape_values, n_dofs_per_component, dst, src, cell_range);
+      }
+  }
+
+  template class SimplexMassOperator<NDIM - 1>;
+  template class SimplexMassOperator<NDIM>;
+} // namespace fdl
@@ -0,0 +1,279 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/surface_mass_operator.h>
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_tools.h>
+#include <deal.II/fe/fe_values.h>
+
+#include <array>
+#include <numeric>
+#include <utility>
+
+namespace fdl
+{
+  namespace
+  {
+    // Contract lexicographically ordered values with the one-dimensional
+    // shape function values along one coordinate direction: stride is the
+    // number of values in the preceding directions and n_blocks that in the
+    // following ones. If transpose is true then the contraction is from
+    // quadrature points to DoFs.
+    template <int n_dofs_1d, bool transpose>
+    inline void
+    contract(const double      *shape_values_1d,
+             const unsigned int stride,
+             const unsigned int n_blocks,
+             const double      *in,
+             double            *out)
+    {
+      for (unsigned int b = 0; b < n_blocks; ++b)
+        for (unsigned int a = 0; a < stride; ++a)
+          {
+            const double *const in_values  = in + a + stride * n_dofs_1d * b;
+            double *const       out_values = out + a + stride * n_dofs_1d * b;
+            for (int o = 0; o < n_dofs_1d; ++o)
+              {
+                double sum = 0.0;
+                for (int j = 0; j < n_dofs_1d; ++j)
+                  sum += (transpose ? shape_values_1d[j * n_dofs_1d + o] :
+                                      shape_values_1d[o * n_dofs_1d + j]) *
+                         in_values[stride * j];
+                out_values[stride * o] = sum;
+              }
+          }
+    }
+
+    // Apply the mass matrix with sum factorization on each cell.
+    template <int dim, int spacedim, int n_dofs_1d>
+    void
+    apply_sum_factorization(
+      const std::vector<double>       &shape_values_1d,
+      const std::vector<unsigned int> &dof_indices,
+      const std::vector<double>       &JxW_values,
+      const std::vector<LinearAlgebra::distributed::Vector<double> *> &dst,
+      const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+        &src)
+    {
+      constexpr unsigned int n = Utilities::pow(n_dofs_1d, dim);
+      const std::size_t      n_cells = JxW_values.size() / n;
+      std::array<double, n>  values_0, values_1;
+      for (std::size_t cell = 0; cell < n_cells; ++cell)
+        {
+          const double *const JxW = &JxW_values[cell * n];
+          for (std::size_t k = 0; k < src.size(); ++k)
+            for (unsigned int c = 0; c < spacedim; ++c)
+              {
+                const unsigned int *const indices =
+                  &dof_indices[(cell * spacedim + c) * n];
+                for (unsigned int i = 0; i < n; ++i)
+                  values_0[i] = src[k]->local_element(indices[i]);
+                double *in  = values_0.data();
+                double *out = values_1.data();
+                for (int d = 0; d < dim; ++d)
+                  {
+                    contract<n_dofs_1d, false>(shape_values_1d.data(),
+                                               Utilities::pow(n_dofs_1d, d),
+                                               Utilities::pow(n_dofs_1d,
+                                                              dim - 1 - d),
+                                               in,
+                                               out);
+                    std::swap(in, out);
+                  }
+                for (unsigned int q = 0; q < n; ++q)
+                  in[q] *= JxW[q];
+                for (int d = dim - 1; d >= 0; --d)
+                  {
+                    contract<n_dofs_1d, true>(shape_values_1d.data(),
+                                              Utilities::pow(n_dofs_1d, d),
+                                              Utilities::pow(n_dofs_1d,
+                                                             dim - 1 - d),
+                                              in,
+                                              out);
+                    std::swap(in, out);
+                  }
+                for (unsigned int i = 0; i < n; ++i)
+                  dst[k]->local_element(indices[i]) += in[i];
+              }
+        }
+    }
+  } // namespace
+
+  template <int dim, int spacedim>
+  SurfaceMassOperator<dim, spacedim>::SurfaceMassOperator(
+    const Mapping<dim, spacedim>                             &mapping,
+    const DoFHandler<dim, spacedim>                          &dof_handler,
+    const Quadrature<dim>                                    &quadrature,
+    const std::shared_ptr<const Utilities::MPI::Partitioner> &partitioner)
+    : n_dofs_per_component(0)
+    , n_q_points(quadrature.size())
+    , n_dofs_1d(0)
+  {
+    const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
+    AssertThrow(fe.n_base_elements() == 1 &&
+                  fe.element_multiplicity(0) == spacedim,
+                ExcMessage("The finite element should consist of spacedim "
+                           "copies of a scalar element."));
+    const FiniteElement<dim, spacedim> &scalar_fe = fe.base_element(0);
+    n_dofs_per_component = scalar_fe.n_dofs_per_cell();
+
+    // Use sum factorization if the shape functions and the quadrature are
+    // both tensor products of the same one-dimensional rules:
+    std::vector<unsigned int> numbering(n_dofs_per_component);
+    std::iota(numbering.begin(), numbering.end(), 0u);
+    const unsigned int degree = scalar_fe.tensor_degree();
+    if (dynamic_cast<const FE_Q<dim, spacedim> *>(&scalar_fe) != nullptr &&
+        quadrature.is_tensor_product() && degree <= 5)
+      {
+        const auto &bases = quadrature.get_tensor_basis();
+        bool        same_bases = bases[0].size() == degree + 1;
+        for (int d = 1; d < dim; ++d)
+          same_bases = same_bases && bases[d] == bases[0];
+        if (same_bases)
+          {
+            n_dofs_1d = degree + 1;
+            numbering = FETools::lexicographic_to_hierarchic_numbering<dim>(
+              degree);
+            // Shape function i has the value l_i(x_0) l_0(x_1) ... at the
+            // support point of shape function 0 in the other directions,
+            // where l_0 is one:
+            const Point<dim> support_point =
+              scalar_fe.get_unit_support_points()[numbering[0]];
+            shape_values_1d.resize(n_dofs_1d * n_dofs_1d);
+            for (unsigned int q = 0; q < n_dofs_1d; ++q)
+              for (unsigned int i = 0; i < n_dofs_1d; ++i)
+                {
+                  Point<dim> point = support_point;
+                  point[0]         = bases[0].point(q)[0];
+                  shape_values_1d[q * n_dofs_1d + i] =
+                    scalar_fe.shape_value(numbering[i], point);
+                }
+          }
+      }
+    if (n_dofs_1d == 0)
+      {
+        shape_values.resize(n_q_points * n_dofs_per_component);
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          for (unsigned int i = 0; i < n_dofs_per_component; ++i)
+            shape_values[q * n_dofs_per_component + i] =
+              scalar_fe.shape_value(i, quadrature.point(q));
+      }
+
+    FEValues<dim, spacedim> fe_values(mapping,
+                                      fe,
+                                      quadrature,
+                                      update_JxW_values);
+    std::vector<types::global_dof_index> cell_dofs(fe.n_dofs_per_cell());
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          fe_values.reinit(cell);
+          cell->get_dof_indices(cell_dofs);
+          for (unsigned int c = 0; c < spacedim; ++c)
+            for (unsigned int i = 0; i < n_dofs_per_component; ++i)
+              dof_indices.push_back(partitioner->global_to_local(
+                cell_dofs[fe.component_to_system_index(c, numbering[i])]));
+          for (unsigned int q = 0; q < n_q_points; ++q)
+            JxW_values.push_back(fe_values.JxW(q));
+        }
+
+    // Same as MassOperator::compute_diagonal(): use row sums
+    LinearAlgebra::distributed::Vector<double> ones(partitioner);
+    ones = 1.0;
+    ones.update_ghost_values();
+    inverse_lumped_masses.reinit(partitioner);
+    apply_add_to_cells({&inverse_lumped_masses}, {&ones});
+    inverse_lumped_masses.compress(VectorOperation::add);
+    for (unsigned int i = 0; i < inverse_lumped_masses.locally_owned_size();
+         ++i)
+      inverse_lumped_masses.local_element(i) =
+        1.0 / inverse_lumped_masses.local_element(i);
+  }
+
+  template <int dim, int spacedim>
+  void
+  SurfaceMassOperator<dim, spacedim>::apply_add_to_cells(
+    const std::vector<LinearAlgebra::distributed::Vector<double> *> &dst,
+    const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+      &src) const
+  {
+    AssertDimension(dst.size(), src.size());
+    switch (n_dofs_1d)
+      {
+        case 2:
+          apply_sum_factorization<dim, spacedim, 2>(
+            shape_values_1d, dof_indices, JxW_values, dst, src);
+          return;
+        case 3:
+          apply_sum_factorization<dim, spacedim, 3>(
+            shape_values_1d, dof_indices, JxW_values, dst, src);
+          return;
+        case 4:
+          apply_sum_factorization<dim, spacedim, 4>(
+            shape_values_1d, dof_indices, JxW_values, dst, src);
+          return;
+        case 5:
+          apply_sum_factorization<dim, spacedim, 5>(
+            shape_values_1d, dof_indices, JxW_values, dst, src);
+          return;
+        case 6:
+          apply_sum_factorization<dim, spacedim, 6>(
+            shape_values_1d, dof_indices, JxW_values, dst, src);
+          return;
+        default:
+          Assert(n_dofs_1d == 0, ExcFDLInternalError());
+      }
+
+    const unsigned int  n       = n_dofs_per_component;
+    const std::size_t   n_cells = JxW_values.size() / n_q_points;
+    std::vector<double> values(n_q_points);
+    for (std::size_t cell = 0; cell < n_cells; ++cell)
+      {
+        const double *const JxW = &JxW_values[cell * n_q_points];
+        for (std::size_t k = 0; k < src.size(); ++k)
+          for (unsigned int c = 0; c < spacedim; ++c)
+            {
+              const unsigned int *const indices =
+                &dof_indices[(cell * spacedim + c) * n];
+              for (unsigned int q = 0; q < n_q_points; ++q)
+                {
+                  const double *const N     = &shape_values[q * n];
+                  double              value = 0.0;
+                  for (unsigned int i = 0; i < n; ++i)
+                    value += N[i] * src[k]->local_element(indices[i]);
+                  values[q] = value * JxW[q];
+                }
+              for (unsigned int i = 0; i < n; ++i)
+                {
+                  double value = 0.0;
+                  for (unsigned int q = 0; q < n_q_points; ++q)
+                    value += shape_values[q * n + i] * values[q];
+                  dst[k]->local_element(indices[i]) += value;
+                }
+            }
+      }
+  }
+
+  template <int dim, int spacedim>
+  const LinearAlgebra::distributed::Vector<double> &
+  SurfaceMassOperator<dim, spacedim>::get_inverse_lumped_masses() const
+  {
+    return inverse_lumped_masses;
+  }
+
+  template <int dim, int spacedim>
+  std::size_t
+  SurfaceMassOperator<dim, spacedim>::memory_consumption() const
+  {
+    return MemoryConsumption::memory_consumption(shape_values_1d) +
+           MemoryConsumption::memory_consumption(shape_values) +
+           MemoryConsumption::memory_consumption(dof_indices) +
+           MemoryConsumption::memory_consumption(JxW_values) +
+           inverse_lumped_masses.memory_consumption();
+  }
+
+  template class SurfaceMassOperator<NDIM - 1, NDIM>;
+} // namespace fdl
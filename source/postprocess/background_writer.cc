@@ -0,0 +1,168 @@
+#include <fiddle/base/exceptions.h>
+#include <fiddle/base/samrai_utilities.h>
+
+#include <fiddle/mechanics/part.h>
+
+#include <fiddle/postprocess/background_writer.h>
+
+#include <deal.II/base/data_out_base.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/fe/mapping_fe_field.h>
+
+#include <deal.II/numerics/data_out.h>
+
+#include <iomanip>
+#include <limits>
+
+namespace fdl
+{
+  namespace
+  {
+    // DataOut only permits accessing its patches (and the associated
+    // metadata) from inside its own output functions, so make them available
+    // here to copy them for later output.
+    template <int dim, int spacedim>
+    class SnapshotDataOut : public DataOut<dim, spacedim>
+    {
+    public:
+      using DataOut<dim, spacedim>::get_patches;
+      using DataOut<dim, spacedim>::get_dataset_names;
+      using DataOut<dim, spacedim>::get_nonscalar_data_ranges;
+    };
+  } // namespace
+
+  template <int dim, int spacedim>
+  BackgroundWriter<dim, spacedim>::BackgroundWriter(
+    const std::string &directory,
+    const MPI_Comm     comm)
+    : directory(directory)
+    , rank(Utilities::MPI::this_mpi_process(comm))
+    , n_procs(Utilities::MPI::n_mpi_processes(comm))
+  {
+    if (!this->directory.empty() && this->directory.back() != '/')
+      this->directory += '/';
+  }
+
+  template <int dim, int spacedim>
+  BackgroundWriter<dim, spacedim>::~BackgroundWriter()
+  {
+    wait();
+  }
+
+  template <int dim, int spacedim>
+  void
+  BackgroundWriter<dim, spacedim>::enqueue(std::function<void()> work)
+  {
+    // Tasks may run in any order, so make each one finish its predecessor
+    // first. Task objects are copies of the same shared handle so joining one
+    // inside another is safe.
+    Threads::Task<> previous_task = last_task;
+    last_task =
+      Threads::new_task([previous_task, work = std::move(work)]() {
+        if (previous_task.joinable())
+          previous_task.join();
+        work();
+      });
+  }
+
+  template <int dim, int spacedim>
+  void
+  BackgroundWriter<dim, spacedim>::wait()
+  {
+    if (last_task.joinable())
+      last_task.join();
+    last_task = Threads::Task<>();
+  }
+
+  template <int dim, int spacedim>
+  void
+  BackgroundWriter<dim, spacedim>::write_part(
+    const Part<dim, spacedim> &part,
+    const std::string         &name,
+    const unsigned int         counter,
+    const std::vector<
+      std::pair<const LinearAlgebra::distributed::Vector<double> *,
+                std::string>> &additional_vectors)
+  {
+    FDL_SETUP_TIMER_AND_SCOPE(t_write_part,
+                              "fdl::BackgroundWriter::write_part()");
+    // Building the patches requires the current state of the part so it
+    // cannot be deferred.
+    SnapshotDataOut<dim, spacedim> data_out;
+    data_out.attach_dof_handler(part.get_dof_handler());
+    data_out.add_data_vector(part.get_velocity(), "U");
+    for (const auto &pair : additional_vectors)
+      {
+        AssertThrow(pair.first, ExcMessage("Vectors must not be nullptr."));
+        data_out.add_data_vector(*pair.first, pair.second);
+      }
+
+    MappingFEField<dim, spacedim, LinearAlgebra::distributed::Vector<double>>
+      position_mapping(part.get_dof_handler(), part.get_position());
+    data_out.build_patches(position_mapping);
+
+    const std::string base_name =
+      name + "_" + Utilities::int_to_string(counter, 8);
+    DataOutBase::VtkFlags flags;
+    flags.compression_level = DataOutBase::CompressionLevel::best_speed;
+
+    enqueue([this,
+             base_name,
+             flags,
+             patches = data_out.get_patches(),
+             data_names = data_out.get_dataset_names(),
+             vector_ranges = data_out.get_nonscalar_data_ranges()]() {
+      std::ofstream out(directory + base_name + "." +
+                        Utilities::int_to_string(rank, 4) + ".vtu");
+      DataOutBase::write_vtu(patches, data_names, vector_ranges, flags, out);
+
+      if (rank == 0)
+        {
+          std::vector<std::string> piece_names;
+          for (unsigned int r = 0; r < n_procs; ++r)
+            piece_names.push_back(base_name + "." +
+                                  Utilities::int_to_string(r, 4) + ".vtu");
+          std::ofstream record(directory + base_name + ".pvtu");
+          DataOutBase::write_pvtu_record(
+            record, piece_names, data_names, vector_ranges, flags);
+        }
+    });
+  }
+
+  template <int dim, int spacedim>
+  void
+  BackgroundWriter<dim, spacedim>::write_time_series(
+    const std::string         &file_name,
+    const double               time,
+    const std::vector<double> &values)
+  {
+    if (rank != 0)
+      return;
+
+    enqueue([this, file_name, time, values]() {
+      auto it = time_series_streams.find(file_name);
+      if (it == time_series_streams.end())
+        {
+          it = time_series_streams
+                 .emplace(file_name,
+                          std::ofstream(directory + file_name,
+                                        std::ios_base::trunc))
+                 .first;
+          it->second << std::setprecision(
+            std::numeric_limits<double>::max_digits10);
+        }
+      std::ofstream &out = it->second;
+      AssertThrow(out, ExcMessage("Unable to write to " + file_name));
+      out << time;
+      for (const double value : values)
+        out << ' ' << value;
+      out << '\n';
+      out.flush();
+    });
+  }
+
+  template class BackgroundWriter<NDIM - 1, NDIM>;
+  template class BackgroundWriter<NDIM, NDIM>;
+} // namespace fdl
@@ -125,10 +125,18 @@ namespace fdl
         comm);
     }
     identity_position.reinit(vector_partitioner);
+    reinit_identity_position();
+  }
 
+  template <int dim, int spacedim>
+  void
+  Meter<dim, spacedim>::reinit_identity_position()
+  {
     // Directly calculate DoF locations. This is orders of magnitude faster than
     // VectorTools::interpolate().
     Assert(vector_fe->tensor_degree() == 1, ExcFDLNotImplemented());
+    vertices_inside_domain.reset();
+    identity_position.zero_out_ghost_values();
     for (const auto &cell : get_vector_dof_handler().active_cell_iterators() |
                               IteratorFilters::LocallyOwnedCell())
       for (unsigned int vertex_no : cell->vertex_indices())
@@ -281,6 +289,47 @@ namespace fdl
     reinit_interaction();
   }
 
+  template <int dim, int spacedim>
+  void
+  Meter<dim, spacedim>::internal_reinit_vertices()
+  {
+    FDL_SETUP_TIMER_AND_SCOPE(t_meter_reinit_vertices,
+                              "fdl::Meter::internal_reinit_vertices()");
+    Assert(nodal_interaction, ExcFDLInternalError());
+    reinit_identity_position();
+    reinit_centroid();
+    update_interaction_position();
+  }
+
+  template <int dim, int spacedim>
+  void
+  Meter<dim, spacedim>::internal_reinit_translation(
+    const Tensor<1, spacedim> &translation)
+  {
+    FDL_SETUP_TIMER_AND_SCOPE(t_meter_reinit_translation,
+                              "fdl::Meter::internal_reinit_translation()");
+    Assert(nodal_interaction, ExcFDLInternalError());
+    reinit_identity_position();
+    // centroid_cell and ref_centroid are unchanged
+    centroid += translation;
+    update_interaction_position();
+  }
+
+  template <int dim, int spacedim>
+  void
+  Meter<dim, spacedim>::update_interaction_position()
+  {
+    const auto local_bboxes =
+      compute_cell_bboxes<dim, spacedim, float>(get_vector_dof_handler(),
+                                                get_mapping());
+    const auto all_bboxes =
+      collect_all_active_cell_bboxes(meter_tria, local_bboxes);
+    if (!nodal_interaction->update_position(all_bboxes,
+                                            get_vector_dof_handler(),
+                                            identity_position))
+      reinit_interaction();
+  }
+
   template <int dim, int spacedim>
   double
   Meter<dim, spacedim>::compute_centroid_value(
@@ -289,6 +338,15 @@ namespace fdl
   {
     FDL_SETUP_TIMER_AND_SCOPE(t_meter_centroid_value,
                               "fdl::Meter::compute_centroid_value()");
+    return compute_centroid_value_async(data_idx, kernel_name).get();
+  }
+
+  template <int dim, int spacedim>
+  ReductionHandle<double>
+  Meter<dim, spacedim>::compute_centroid_value_async(
+    const int          data_idx,
+    const std::string &kernel_name) const
+  {
     // TODO: this is pretty wasteful but we don't have infrastructure set up to
     // do single point evaluations right now - ultimately this will be added to
     // IBAMR.
@@ -319,13 +377,12 @@ namespace fdl
             fe_values.shape_value(i, 0) * interpolated_data[cell_dofs[i]];
       }
 
-    const int owning_rank =
-      meter_tria
-        .get_true_subdomain_ids_of_cells()[centroid_cell->active_cell_index()];
-    value = Utilities::MPI::broadcast(meter_tria.get_communicator(),
-                                      value,
-                                      owning_rank);
-    return value;
+    // Only the owning processor computes a nonzero value so we can sum
+    // instead of broadcasting
+    return ReductionHandle<double>({value},
+                                   meter_tria.get_communicator(),
+                                   [](const std::vector<double> &sums)
+                                   { return sums[0]; });
   }
 
   template <int dim, int spacedim>
@@ -335,14 +392,133 @@ namespace fdl
   {
     FDL_SETUP_TIMER_AND_SCOPE(t_meter_mean_value,
                               "fdl::Meter::compute_mean_value()");
+    return compute_mean_value_async(data_idx, kernel_name).get();
+  }
+
+  template <int dim, int spacedim>
+  ReductionHandle<double>
+  Meter<dim, spacedim>::compute_mean_value_async(
+    const int          data_idx,
+    const std::string &kernel_name) const
+  {
+    return ReductionHandle<double>(
+      compute_local_integrals({data_idx}, kernel_name),
+      meter_tria.get_communicator(),
+      [](const std::vector<double> &sums) { return sums[0] / sums[1]; });
+  }
+
+  template <int dim, int spacedim>
+  std::vector<double>
+  Meter<dim, spacedim>::compute_mean_values(
+    const std::vector<int> &data_indices,
+    const std::string      &kernel_name) const
+  {
+    FDL_SETUP_TIMER_AND_SCOPE(t_meter_mean_values,
+                              "fdl::Meter::compute_mean_values()");
+    return compute_mean_values_async(data_indices, kernel_name).get();
+  }
+
+  template <int dim, int spacedim>
+  ReductionHandle<std::vector<double>>
+  Meter<dim, spacedim>::compute_mean_values_async(
+    const std::vector<int> &data_indices,
+    const std::string      &kernel_name) const
+  {
+    const std::size_t n_fields = data_indices.size();
+    return ReductionHandle<std::vector<double>>(
+      compute_local_integrals(data_indices, kernel_name),
+      meter_tria.get_communicator(),
+      [n_fields](const std::vector<double> &sums)
+      {
+        std::vector<double> mean_values(n_fields);
+        for (std::size_t i = 0; i < n_fields; ++i)
+          mean_values[i] = sums[i] / sums[n_fields];
+        return mean_values;
+      });
+  }
+
+  template <int dim, int spacedim>
+  std::vector<double>
+  Meter<dim, spacedim>::compute_local_integrals(
+    const std::vector<int> &data_indices,
+    const std::string      &kernel_name) const
+  {
+    FDL_SETUP_TIMER_AND_SCOPE(t_meter_local_integrals,
+                              "fdl::Meter::compute_local_integrals()");
+    const std::size_t n_fields = data_indices.size();
+    // Store the integrals of each field followed by the integral of 1
+    std::vector<double> integrals(n_fields + 1);
+    if (n_fields == 0)
+      return integrals;
     const auto interpolated_data =
-      interpolate_scalar_field(data_idx, kernel_name);
+      interpolate_fields(data_indices, kernel_name, false);
+
+    const auto             &fe = get_scalar_dof_handler().get_fe();
+    FEValues<dim, spacedim> fe_values(get_mapping(),
+                                      fe,
+                                      meter_quadrature,
+                                      update_values | update_JxW_values);
+
+    std::vector<double> cell_values(meter_quadrature.size());
+    for (const auto &cell : get_scalar_dof_handler().active_cell_iterators() |
+                              IteratorFilters::LocallyOwnedCell())
+      {
+        fe_values.reinit(cell);
+        for (unsigned int q = 0; q < meter_quadrature.size(); ++q)
+          integrals[n_fields] += fe_values.JxW(q);
+        for (std::size_t i = 0; i < n_fields; ++i)
+          {
+            fe_values.get_function_values(interpolated_data[i], cell_values);
+            for (unsigned int q = 0; q < meter_quadrature.size(); ++q)
+              integrals[i] += cell_values[q] * fe_values.JxW(q);
+          }
+      }
 
-    return VectorTools::compute_mean_value(get_mapping(),
-                                           get_scalar_dof_handler(),
-                                           meter_quadrature,
-                                           interpolated_data,
-                                           0);
+    return integrals;
+  }
+
+  template <int dim, int spacedim>
+  std::vector<LinearAlgebra::distributed::Vector<double>>
+  Meter<dim, spacedim>::interpolate_fields(
+    const std::vector<int> &data_indices,
+    const std::string      &kernel_name,
+    const bool              vector_valued) const
+  {
+    FDL_SETUP_TIMER_AND_SCOPE(t_meter_interpolate_fields,
+                              "fdl::Meter::interpolate_fields()");
+    if (data_indices.size() == 0)
+      return {};
+    const auto &dof_handler =
+      vector_valued ? get_vector_dof_handler() : get_scalar_dof_handler();
+    std::vector<LinearAlgebra::distributed::Vector<double>> interpolated_data(
+      data_indices.size());
+    std::vector<LinearAlgebra::distributed::Vector<double> *> rhs;
+    for (auto &vector : interpolated_data)
+      {
+        vector.reinit(vector_valued ? vector_partitioner : scalar_partitioner);
+        rhs.push_back(&vector);
+      }
+
+    auto &interaction = *nodal_interaction;
+    auto  trans       = interaction.compute_projection_rhs_scatter_start(
+      kernel_name,
+      data_indices,
+      get_vector_dof_handler(),
+      identity_position,
+      std::vector<const DoFHandler<dim, spacedim> *>(data_indices.size(),
+                                                     &dof_handler),
+      std::vector<const Mapping<dim, spacedim> *>(data_indices.size(),
+                                                  &get_mapping()),
+      rhs);
+    trans = interaction.compute_projection_rhs_scatter_finish(std::move(trans));
+    trans = interaction.compute_projection_rhs_intermediate(std::move(trans));
+    trans =
+      interaction.compute_projection_rhs_accumulate_start(std::move(trans));
+    interaction.compute_projection_rhs_accumulate_finish(std::move(trans));
+    for (auto &vector : interpolated_data)
+      vector.update_ghost_values();
+
+    return interpolated_data;
   }
 
   template <int dim, int spacedim>
@@ -395,26 +571,87 @@ namespace fdl
   {
     FDL_SETUP_TIMER_AND_SCOPE(t_meter_vertices_inside_domain,
                               "fdl::Meter::compute_vertices_inside_domain()");
+    if (vertices_inside_domain)
+      return *vertices_inside_domain;
+
     tbox::Pointer<geom::CartesianGridGeometry<spacedim>> geom =
       patch_hierarchy->getGridGeometry();
     Assert(geom, ExcFDLInternalError());
-    tbox::Pointer<hier::PatchLevel<spacedim>> patch_level =
-      patch_hierarchy->getPatchLevel(0);
-    Assert(patch_level, ExcFDLInternalError());
+    // Boxes are closed sets of cell indices, so their corners work as
+    // bounding boxes.
+    if (domain_box_rtree.empty())
+      {
+        tbox::Pointer<hier::PatchLevel<spacedim>> patch_level =
+          patch_hierarchy->getPatchLevel(0);
+        Assert(patch_level, ExcFDLInternalError());
+        std::vector<BoundingBox<spacedim>> domain_bboxes;
+        typename tbox::List<hier::Box<spacedim>>::Iterator it(
+          patch_level->getPhysicalDomain());
+        while (it)
+          {
+            const hier::Box<spacedim> &box = *it;
+            Point<spacedim>            lower, upper;
+            for (unsigned int d = 0; d < spacedim; ++d)
+              {
+                lower[d] = box.lower(d);
+                upper[d] = box.upper(d);
+              }
+            domain_bboxes.emplace_back(std::make_pair(lower, upper));
+            it++;
+          }
+        domain_box_rtree = pack_rtree(domain_bboxes);
+      }
 
-    bool vertices_inside_domain = true;
-    for (const auto &vertex : get_triangulation().get_vertices())
+    const auto get_index = [&](const Point<spacedim> &point)
+    {
+      const auto index =
+        IBTK::IndexUtilities::getCellIndex(point,
+                                           geom,
+                                           hier::IntVector<spacedim>(1));
+      Point<spacedim> result;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        result[d] = index(d);
+      return result;
+    };
+
+    // Most meters are not near the boundary: if one domain box contains the
+    // bounding box of the meter then we are done. Otherwise check each
+    // vertex.
+    namespace bgi = boost::geometry::index;
+    const auto &vertices = get_triangulation().get_vertices();
+    bool        all_inside = true;
+    if (vertices.size() > 0)
       {
-        const auto index =
-          IBTK::IndexUtilities::getCellIndex(vertex,
-                                             geom,
-                                             hier::IntVector<spacedim>(1));
-        vertices_inside_domain =
-          vertices_inside_domain &&
-          patch_level->getPhysicalDomain().contains(index);
+        const BoundingBox<spacedim> meter_bbox(vertices);
+        const BoundingBox<spacedim> meter_index_bbox(
+          std::make_pair(get_index(meter_bbox.get_boundary_points().first),
+                         get_index(meter_bbox.get_boundary_points().second)));
+        if (domain_box_rtree.qbegin(bgi::covers(meter_index_bbox)) ==
+            domain_box_rtree.qend())
+          for (const auto &vertex : vertices)
+            if (domain_box_rtree.qbegin(bgi::intersects(get_index(vertex))) ==
+                domain_box_rtree.qend())
+              {
+                all_inside = false;
+                break;
+              }
       }
 
-    return vertices_inside_domain;
+    vertices_inside_domain = all_inside;
+    return all_inside;
+  }
+
+  template <int dim, int spacedim>
+  std::size_t
+  Meter<dim, spacedim>::memory_consumption() const
+  {
+    std::size_t result = meter_tria.memory_consumption() +
+                         scalar_dof_handler.memory_consumption() +
+                         vector_dof_handler.memory_consumption() +
+                         identity_position.memory_consumption();
+    if (nodal_interaction)
+      result += nodal_interaction->memory_consumption();
+    return result;
   }
 
   template class Meter<NDIM - 1, NDIM>;
@@ -0,0 +1,206 @@
+#include <fiddle/base/exceptions.h>
+#include <fiddle/base/samrai_utilities.h>
+
+#include <fiddle/interaction/nodal_interaction.h>
+
+#include <fiddle/postprocess/meter_collection.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/fe/fe_values.h>
+
+#include <deal.II/grid/filtered_iterator.h>
+
+#include <memory>
+
+namespace fdl
+{
+  template <int dim, int spacedim>
+  MeterCollection<dim, spacedim>::MeterCollection(
+    const std::vector<const Meter<dim, spacedim> *> &meters)
+    : meters(meters)
+  {
+    for (const Meter<dim, spacedim> *meter : meters)
+      AssertThrow(meter, ExcMessage("The meters must not be nullptr."));
+    for (const Meter<dim, spacedim> *meter : meters)
+      {
+        int       result = 0;
+        const int ierr   = MPI_Comm_compare(
+          meter->get_triangulation().get_communicator(),
+          meters.front()->get_triangulation().get_communicator(),
+          &result);
+        AssertThrowMPI(ierr);
+        AssertThrow(result == MPI_IDENT || result == MPI_CONGRUENT,
+                    ExcMessage("All meters must use the same communicator."));
+      }
+  }
+
+  template <int dim, int spacedim>
+  std::vector<LinearAlgebra::distributed::Vector<double>>
+  MeterCollection<dim, spacedim>::interpolate_fields(
+    const int          data_idx,
+    const std::string &kernel_name,
+    const bool         vector_valued) const
+  {
+    FDL_SETUP_TIMER_AND_SCOPE(t_interpolate_fields,
+                              "fdl::MeterCollection::interpolate_fields()");
+    std::vector<LinearAlgebra::distributed::Vector<double>> interpolated_data(
+      meters.size());
+    std::vector<std::unique_ptr<TransactionBase>> transactions;
+    // Each NodalInteraction uses its own communicator so we can start all the
+    // scatters at once and then finish them in order.
+    for (unsigned int i = 0; i < meters.size(); ++i)
+      {
+        const Meter<dim, spacedim> &meter = *meters[i];
+        interpolated_data[i].reinit(vector_valued ? meter.vector_partitioner :
+                                                    meter.scalar_partitioner);
+        transactions.emplace_back(
+          meter.nodal_interaction->compute_projection_rhs_scatter_start(
+            kernel_name,
+            data_idx,
+            meter.get_vector_dof_handler(),
+            meter.identity_position,
+            vector_valued ? meter.get_vector_dof_handler() :
+                            meter.get_scalar_dof_handler(),
+            meter.get_mapping(),
+            interpolated_data[i]));
+      }
+    for (unsigned int i = 0; i < meters.size(); ++i)
+      {
+        const auto &interaction = *meters[i]->nodal_interaction;
+        transactions[i] = interaction.compute_projection_rhs_scatter_finish(
+          std::move(transactions[i]));
+        transactions[i] = interaction.compute_projection_rhs_intermediate(
+          std::move(transactions[i]));
+        transactions[i] = interaction.compute_projection_rhs_accumulate_start(
+          std::move(transactions[i]));
+      }
+    for (unsigned int i = 0; i < meters.size(); ++i)
+      {
+        meters[i]->nodal_interaction->compute_projection_rhs_accumulate_finish(
+          std::move(transactions[i]));
+        interpolated_data[i].update_ghost_values();
+      }
+
+    return interpolated_data;
+  }
+
+  template <int dim, int spacedim>
+  std::vector<double>
+  MeterCollection<dim, spacedim>::compute_mean_values(
+    const int          data_idx,
+    const std::string &kernel_name) const
+  {
+    FDL_SETUP_TIMER_AND_SCOPE(t_compute_mean_values,
+                              "fdl::MeterCollection::compute_mean_values()");
+    if (meters.size() == 0)
+      return {};
+    const auto interpolated_data =
+      interpolate_fields(data_idx, kernel_name, false);
+
+    // Store the integrals of the field and of 1 for each meter so that we
+    // only need one reduction
+    std::vector<double> integrals(2 * meters.size());
+    for (unsigned int i = 0; i < meters.size(); ++i)
+      {
+        const Meter<dim, spacedim> &meter = *meters[i];
+
+        const auto             &fe = meter.get_scalar_dof_handler().get_fe();
+        FEValues<dim, spacedim> fe_values(meter.get_mapping(),
+                                          fe,
+                                          meter.meter_quadrature,
+                                          update_values | update_JxW_values);
+
+        std::vector<double> cell_values(meter.meter_quadrature.size());
+        for (const auto &cell :
+             meter.get_scalar_dof_handler().active_cell_iterators() |
+               IteratorFilters::LocallyOwnedCell())
+          {
+            fe_values.reinit(cell);
+            fe_values.get_function_values(interpolated_data[i], cell_values);
+            for (unsigned int q = 0; q < meter.meter_quadrature.size(); ++q)
+              {
+                integrals[2 * i] += cell_values[q] * fe_values.JxW(q);
+                integrals[2 * i + 1] += fe_values.JxW(q);
+              }
+          }
+      }
+
+    integrals = Utilities::MPI::sum(
+      integrals, meters.front()->get_triangulation().get_communicator());
+    std::vector<double> mean_values(meters.size());
+    for (unsigned int i = 0; i < meters.size(); ++i)
+      mean_values[i] = integrals[2 * i] / integrals[2 * i + 1];
+
+    return mean_values;
+  }
+
+  template <int dim, int spacedim>
+  std::vector<std::pair<double, Tensor<1, spacedim>>>
+  MeterCollection<dim, spacedim>::compute_fluxes(
+    const int          data_idx,
+    const std::string &kernel_name) const
+  {
+    FDL_SETUP_TIMER_AND_SCOPE(t_compute_fluxes,
+                              "fdl::MeterCollection::compute_fluxes()");
+    AssertThrow(dim + 1 == spacedim,
+                ExcMessage("Fluxes can only be computed on codimension one "
+                           "meters."));
+    if (meters.size() == 0)
+      return {};
+    const auto interpolated_data =
+      interpolate_fields(data_idx, kernel_name, true);
+
+    // Store the flux and the integral of the normal vector for each meter so
+    // that we only need one reduction
+    constexpr unsigned int n_values = 1 + spacedim;
+    std::vector<double>    integrals(n_values * meters.size());
+    for (unsigned int i = 0; i < meters.size(); ++i)
+      {
+        const Meter<dim, spacedim> &meter = *meters[i];
+
+        const auto             &fe = meter.get_vector_dof_handler().get_fe();
+        FEValues<dim, spacedim> fe_values(meter.get_mapping(),
+                                          fe,
+                                          meter.meter_quadrature,
+                                          update_normal_vectors |
+                                            update_values | update_JxW_values);
+
+        std::vector<Tensor<1, spacedim>> cell_values(
+          meter.meter_quadrature.size());
+        for (const auto &cell :
+             meter.get_vector_dof_handler().active_cell_iterators() |
+               IteratorFilters::LocallyOwnedCell())
+          {
+            fe_values.reinit(cell);
+            fe_values[FEValuesExtractors::Vector(0)].get_function_values(
+              interpolated_data[i], cell_values);
+            for (unsigned int q = 0; q < meter.meter_quadrature.size(); ++q)
+              {
+                integrals[n_values * i] +=
+                  cell_values[q] * fe_values.normal_vector(q) *
+                  fe_values.JxW(q);
+                for (unsigned int d = 0; d < spacedim; ++d)
+                  integrals[n_values * i + 1 + d] +=
+                    fe_values.normal_vector(q)[d] * fe_values.JxW(q);
+              }
+          }
+      }
+
+    integrals = Utilities::MPI::sum(
+      integrals, meters.front()->get_triangulation().get_communicator());
+    std::vector<std::pair<double, Tensor<1, spacedim>>> fluxes(meters.size());
+    for (unsigned int i = 0; i < meters.size(); ++i)
+      {
+        fluxes[i].first = integrals[n_values * i];
+        for (unsigned int d = 0; d < spacedim; ++d)
+          fluxes[i].second[d] = integrals[n_values * i + 1 + d];
+        fluxes[i].second /= fluxes[i].second.norm();
+      }
+
+    return fluxes;
+  }
+
+  template class MeterCollection<NDIM - 1, NDIM>;
+  template class MeterCollection<NDIM, NDIM>;
+} // namespace fdl
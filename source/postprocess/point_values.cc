@@ -49,25 +49,58 @@ namespace fdl
                                    *this->mapping);
   }
 
+  template <int n_components, int dim, int spacedim>
+  void
+  PointValues<n_components, dim, spacedim>::reinit(
+    const Mapping<dim, spacedim> &mapping)
+  {
+    FDL_SETUP_TIMER_AND_SCOPE(t_pointvalues_reinit,
+                              "fdl::PointValues::reinit()");
+    this->mapping = &mapping;
+    remote_point_evaluation.reinit(evaluation_points,
+                                   dof_handler->get_triangulation(),
+                                   *this->mapping);
+  }
+
   template <int n_components, int dim, int spacedim>
   std::vector<Tensor<1, n_components>>
   PointValues<n_components, dim, spacedim>::evaluate(
     const LinearAlgebra::distributed::Vector<double> &vector) const
+  {
+    return std::move(evaluate({&vector})[0]);
+  }
+
+  template <int n_components, int dim, int spacedim>
+  std::vector<std::vector<Tensor<1, n_components>>>
+  PointValues<n_components, dim, spacedim>::evaluate(
+    const std::vector<const LinearAlgebra::distributed::Vector<double> *>
+      &vectors) const
   {
     FDL_SETUP_TIMER_AND_SCOPE(t_pointvalues_evaluate,
                               "fdl::PointValues::evaluate()");
-    auto result =
-      VectorTools::point_values<n_components>(remote_point_evaluation,
-                                              *dof_handler,
-                                              vector);
+    // RemotePointEvaluation is invalidated when the Triangulation changes
+    if (!remote_point_evaluation.is_ready())
+      remote_point_evaluation.reinit(evaluation_points,
+                                     dof_handler->get_triangulation(),
+                                     *mapping);
+
+    std::vector<std::vector<Tensor<1, n_components>>> results;
+    for (const LinearAlgebra::distributed::Vector<double> *vector : vectors)
+      {
+        Assert(vector, ExcMessage("The vectors must not be nullptr."));
+        auto result =
+          VectorTools::point_values<n_components>(remote_point_evaluation,
+                                                  *dof_handler,
+                                                  *vector);
+        results.emplace_back(convert(result));
+      }
 
-    return convert(result);
+    return results;
   }
 
 
-  // TODO - RemotePointEvaluation doesn't work with codim 1 yet
-  // template class PointValues<1, NDIM - 1, NDIM>;
-  // template class PointValues<NDIM, NDIM - 1, NDIM>;
+  template class PointValues<1, NDIM - 1, NDIM>;
+  template class PointValues<NDIM, NDIM - 1, NDIM>;
   template class PointValues<1, NDIM, NDIM>;
   template class PointValues<NDIM, NDIM, NDIM>;
 } // namespace fdl
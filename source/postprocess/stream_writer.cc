@@ -0,0 +1,223 @@
+#include <fiddle/base/exceptions.h>
+#include <fiddle/base/samrai_utilities.h>
+
+#include <fiddle/mechanics/part.h>
+
+#include <fiddle/postprocess/stream_writer.h>
+
+#include <deal.II/base/mpi.h>
+
+#ifdef FDL_ENABLE_ADIOS2
+#  include <deal.II/base/index_set.h>
+
+#  include <adios2.h>
+#endif
+
+namespace fdl
+{
+#ifdef FDL_ENABLE_ADIOS2
+  template <int dim, int spacedim>
+  struct StreamWriter<dim, spacedim>::Implementation
+  {
+    Implementation(const MPI_Comm comm)
+      : adios(comm)
+    {}
+
+    adios2::ADIOS adios;
+
+    adios2::IO io;
+
+    adios2::Engine engine;
+
+    /**
+     * Return the variable @p name, defining it first if necessary, with
+     * the given global shape and local selection.
+     */
+    adios2::Variable<double>
+    get_variable(const std::string &name,
+                 const std::size_t  n_global,
+                 const std::size_t  start,
+                 const std::size_t  count)
+    {
+      adios2::Variable<double> variable = io.InquireVariable<double>(name);
+      if (!variable)
+        return io.DefineVariable<double>(name, {n_global}, {start}, {count});
+      // The shape changes if the part is refined
+      variable.SetShape({n_global});
+      variable.SetSelection({{start}, {count}});
+      return variable;
+    }
+  };
+
+  template <int dim, int spacedim>
+  StreamWriter<dim, spacedim>::StreamWriter(
+    const std::string                        &stream_name,
+    const MPI_Comm                            comm,
+    const std::string                        &engine_type,
+    const std::map<std::string, std::string> &parameters)
+    : rank(Utilities::MPI::this_mpi_process(comm))
+    , implementation(std::make_unique<Implementation>(comm))
+  {
+    implementation->io = implementation->adios.DeclareIO(stream_name);
+    implementation->io.SetEngine(engine_type);
+    implementation->io.SetParameters(parameters);
+    implementation->engine =
+      implementation->io.Open(stream_name, adios2::Mode::Write);
+  }
+
+  template <int dim, int spacedim>
+  StreamWriter<dim, spacedim>::~StreamWriter()
+  {
+    if (implementation->engine)
+      implementation->engine.Close();
+  }
+
+  template <int dim, int spacedim>
+  void
+  StreamWriter<dim, spacedim>::begin_step(const double time)
+  {
+    implementation->engine.BeginStep();
+    adios2::Variable<double> variable =
+      implementation->io.InquireVariable<double>("time");
+    if (!variable)
+      variable = implementation->io.DefineVariable<double>("time");
+    if (rank == 0)
+      implementation->engine.Put(variable, time, adios2::Mode::Sync);
+  }
+
+  template <int dim, int spacedim>
+  void
+  StreamWriter<dim, spacedim>::write_part(
+    const Part<dim, spacedim> &part,
+    const std::string         &name,
+    const std::vector<
+      std::pair<const LinearAlgebra::distributed::Vector<double> *,
+                std::string>> &additional_vectors)
+  {
+    FDL_SETUP_TIMER_AND_SCOPE(t_write_part,
+                              "fdl::StreamWriter::write_part()");
+    const std::string fe_name = name + "/fe";
+    if (!implementation->io.InquireAttribute<std::string>(fe_name))
+      implementation->io.DefineAttribute<std::string>(
+        fe_name, part.get_dof_handler().get_fe().get_name());
+
+    write_vector(name + "/X", part.get_position());
+    write_vector(name + "/U", part.get_velocity());
+    for (const auto &pair : additional_vectors)
+      {
+        AssertThrow(pair.first, ExcMessage("Vectors must not be nullptr."));
+        AssertDimension(pair.first->size(), part.get_dof_handler().n_dofs());
+        write_vector(name + "/" + pair.second, *pair.first);
+      }
+  }
+
+  template <int dim, int spacedim>
+  void
+  StreamWriter<dim, spacedim>::write_values(const std::string         &name,
+                                            const std::vector<double> &values)
+  {
+    if (rank != 0)
+      return;
+
+    adios2::Variable<double> variable =
+      implementation->get_variable(name, values.size(), 0, values.size());
+    if (values.size() > 0)
+      implementation->engine.Put(variable,
+                                 values.data(),
+                                 adios2::Mode::Sync);
+  }
+
+  template <int dim, int spacedim>
+  void
+  StreamWriter<dim, spacedim>::end_step()
+  {
+    implementation->engine.EndStep();
+  }
+
+  template <int dim, int spacedim>
+  void
+  StreamWriter<dim, spacedim>::write_vector(
+    const std::string                                &name,
+    const LinearAlgebra::distributed::Vector<double> &vector)
+  {
+    const IndexSet owned = vector.locally_owned_elements();
+    AssertThrow(owned.is_contiguous(),
+                ExcMessage("StreamWriter requires contiguous locally owned "
+                           "DoFs."));
+    const std::size_t count = owned.n_elements();
+    const std::size_t start = count > 0 ? owned.nth_index_in_set(0) : 0;
+
+    adios2::Variable<double> variable =
+      implementation->get_variable(name, vector.size(), start, count);
+    // Locally owned entries are stored first
+    if (count > 0)
+      implementation->engine.Put(variable,
+                                 vector.begin(),
+                                 adios2::Mode::Sync);
+  }
+#else
+  template <int dim, int spacedim>
+  struct StreamWriter<dim, spacedim>::Implementation
+  {};
+
+  template <int dim, int spacedim>
+  StreamWriter<dim, spacedim>::StreamWriter(
+    const std::string &,
+    const MPI_Comm comm,
+    const std::string &,
+    const std::map<std::string, std::string> &)
+    : rank(Utilities::MPI::this_mpi_process(comm))
+  {
+    AssertThrow(false, ExcMessage("Only available with FDL_ENABLE_ADIOS2"));
+  }
+
+  template <int dim, int spacedim>
+  StreamWriter<dim, spacedim>::~StreamWriter() = default;
+
+  template <int dim, int spacedim>
+  void
+  StreamWriter<dim, spacedim>::begin_step(const double)
+  {
+    AssertThrow(false, ExcMessage("Only available with FDL_ENABLE_ADIOS2"));
+  }
+
+  template <int dim, int spacedim>
+  void
+  StreamWriter<dim, spacedim>::write_part(
+    const Part<dim, spacedim> &,
+    const std::string &,
+    const std::vector<
+      std::pair<const LinearAlgebra::distributed::Vector<double> *,
+                std::string>> &)
+  {
+    AssertThrow(false, ExcMessage("Only available with FDL_ENABLE_ADIOS2"));
+  }
+
+  template <int dim, int spacedim>
+  void
+  StreamWriter<dim, spacedim>::write_values(const std::string &,
+                                            const std::vector<double> &)
+  {
+    AssertThrow(false, ExcMessage("Only available with FDL_ENABLE_ADIOS2"));
+  }
+
+  template <int dim, int spacedim>
+  void
+  StreamWriter<dim, spacedim>::end_step()
+  {
+    AssertThrow(false, ExcMessage("Only available with FDL_ENABLE_ADIOS2"));
+  }
+
+  template <int dim, int spacedim>
+  void
+  StreamWriter<dim, spacedim>::write_vector(
+    const std::string &,
+    const LinearAlgebra::distributed::Vector<double> &)
+  {
+    AssertThrow(false, ExcMessage("Only available with FDL_ENABLE_ADIOS2"));
+  }
+#endif
+
+  template class StreamWriter<NDIM - 1, NDIM>;
+  template class StreamWriter<NDIM, NDIM>;
+} // namespace fdl
@@ -12,6 +12,7 @@
 #include <deal.II/fe/fe_values.h>
 
 #include <deal.II/grid/filtered_iterator.h>
+#include <deal.II/grid/grid_generator.h>
 #include <deal.II/grid/grid_tools.h>
 
 #include <PatchHierarchy.h>
@@ -30,7 +31,8 @@ namespace fdl
       void
       setup_meter_tria(const std::vector<Point<2>>    &boundary_points,
                        Triangulation<1, 2>            &tria,
-                       const Triangle::AdditionalData &additional_data)
+                       const Triangle::AdditionalData &additional_data,
+                       PlanarTriangulationCache & /*planar_tria_cache*/)
       {
         FDL_SETUP_TIMER_AND_SCOPE(t_setup_meter_tria,
                                   "fdl::internal::setup_meter_tria()");
@@ -80,20 +82,18 @@ namespace fdl
       void
       setup_meter_tria(const std::vector<Point<3>>    &boundary_points,
                        Triangulation<2, 3>            &tria,
-                       const Triangle::AdditionalData &additional_data)
+                       const Triangle::AdditionalData &additional_data,
+                       PlanarTriangulationCache       &planar_tria_cache)
       {
         FDL_SETUP_TIMER_AND_SCOPE(t_setup_meter_tria,
                                   "fdl::internal::setup_meter_tria()");
         Assert(boundary_points.size() > 2, ExcFDLInternalError());
 
-        // the input may be a parallel Triangulation, so copy back-and-forth
-        Triangulation<2, 3> serial_tria;
-        create_planar_triangulation(boundary_points,
-                                    serial_tria,
-                                    additional_data);
-        fit_boundary_vertices(boundary_points, serial_tria);
-        tria.clear();
-        tria.copy_triangulation(serial_tria);
+        // the input may be a parallel Triangulation, so the cache stores a
+        // serial one and copies it
+        planar_tria_cache.create_triangulation(boundary_points,
+                                               tria,
+                                               additional_data);
       }
 #endif
     } // namespace
@@ -169,12 +169,11 @@ namespace fdl
                       "set up without an underlying codimension zero "
                       "Triangulation."));
     // Reset the meter mesh according to the new position values:
-    const std::vector<Tensor<1, spacedim>> position_values =
-      point_values->evaluate(position);
-    const std::vector<Point<spacedim>> boundary_points(position_values.begin(),
-                                                       position_values.end());
-    const std::vector<Tensor<1, spacedim>> velocity_values =
-      point_values->evaluate(velocity);
+    const std::vector<std::vector<Tensor<1, spacedim>>> values =
+      point_values->evaluate({&position, &velocity});
+    const std::vector<Point<spacedim>> boundary_points(values[0].begin(),
+                                                       values[0].end());
+    const std::vector<Tensor<1, spacedim>> &velocity_values = values[1];
 
     internal_reinit(true, boundary_points, velocity_values, false);
   }
@@ -206,7 +205,7 @@ namespace fdl
 
 
   template <int dim, int spacedim>
-  void
+  bool
   SurfaceMeter<dim, spacedim>::reinit_tria(
     const std::vector<Point<spacedim>> &boundary_points,
     const bool                          place_additional_boundary_vertices)
@@ -214,14 +213,48 @@ namespace fdl
     const double dx = compute_min_cell_width(this->patch_hierarchy);
     const double target_element_area = std::pow(dx, dim - 1);
 
-    this->meter_tria.clear();
     Triangle::AdditionalData additional_data;
     additional_data.target_element_area = target_element_area;
     additional_data.place_additional_boundary_vertices =
       place_additional_boundary_vertices;
+    // Set up the new mesh in serial first: this is cheap compared to setting
+    // up the DoFHandlers and interaction object, which we can keep if only
+    // the vertices moved
+    Triangulation<dim - 1, spacedim> new_tria;
     internal::setup_meter_tria(boundary_points,
-                               this->meter_tria,
-                               additional_data);
+                               new_tria,
+                               additional_data,
+                               planar_tria_cache);
+
+    bool same_topology =
+      new_tria.n_vertices() == this->meter_tria.n_vertices() &&
+      new_tria.n_active_cells() == this->meter_tria.n_active_cells() &&
+      this->meter_tria.n_levels() == 1;
+    for (auto new_cell = new_tria.begin_active(),
+              cell     = this->meter_tria.begin_active();
+         same_topology && new_cell != new_tria.end();
+         ++new_cell, ++cell)
+      {
+        same_topology = new_cell->n_vertices() == cell->n_vertices();
+        for (const unsigned int v : cell->vertex_indices())
+          same_topology =
+            same_topology && new_cell->vertex_index(v) == cell->vertex_index(v);
+      }
+
+    if (same_topology)
+      {
+        const std::vector<Point<spacedim>> &new_vertices =
+          new_tria.get_vertices();
+        for (auto &cell : this->meter_tria.active_cell_iterators())
+          for (const unsigned int v : cell->vertex_indices())
+            cell->vertex(v) = new_vertices[cell->vertex_index(v)];
+        this->meter_tria.signals.mesh_movement();
+        return false;
+      }
+
+    this->meter_tria.clear();
+    GridGenerator::flatten_triangulation(new_tria, this->meter_tria);
+    return true;
   }
 
   template <int dim, int spacedim>
@@ -232,9 +265,14 @@ namespace fdl
     const std::vector<Tensor<1, spacedim>> &velocity_values,
     const bool                              place_additional_boundary_vertices)
   {
+    bool new_topology = true;
     if (reinit_tria)
-      this->reinit_tria(boundary_points, place_additional_boundary_vertices);
-    Meter<dim - 1, spacedim>::internal_reinit();
+      new_topology =
+        this->reinit_tria(boundary_points, place_additional_boundary_vertices);
+    if (new_topology)
+      Meter<dim - 1, spacedim>::internal_reinit();
+    else
+      Meter<dim - 1, spacedim>::internal_reinit_vertices();
     reinit_mean_velocity(velocity_values);
   }
 
@@ -310,8 +348,73 @@ namespace fdl
     const int          data_idx,
     const std::string &kernel_name) const
   {
-    const auto interpolated_data =
-      this->interpolate_vector_field(data_idx, kernel_name);
+    return compute_flux_async(data_idx, kernel_name).get();
+  }
+
+  template <int dim, int spacedim>
+  ReductionHandle<std::pair<double, Tensor<1, spacedim>>>
+  SurfaceMeter<dim, spacedim>::compute_flux_async(
+    const int          data_idx,
+    const std::string &kernel_name) const
+  {
+    return ReductionHandle<std::pair<double, Tensor<1, spacedim>>>(
+      compute_local_fluxes({data_idx}, kernel_name),
+      this->meter_tria.get_communicator(),
+      [](const std::vector<double> &sums)
+      {
+        Tensor<1, spacedim> mean_normal;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          mean_normal[d] = sums[1 + d];
+        mean_normal /= mean_normal.norm();
+        return std::make_pair(sums[0], mean_normal);
+      });
+  }
+
+  template <int dim, int spacedim>
+  std::vector<std::pair<double, Tensor<1, spacedim>>>
+  SurfaceMeter<dim, spacedim>::compute_fluxes(
+    const std::vector<int> &data_indices,
+    const std::string      &kernel_name) const
+  {
+    return compute_fluxes_async(data_indices, kernel_name).get();
+  }
+
+  template <int dim, int spacedim>
+  ReductionHandle<std::vector<std::pair<double, Tensor<1, spacedim>>>>
+  SurfaceMeter<dim, spacedim>::compute_fluxes_async(
+    const std::vector<int> &data_indices,
+    const std::string      &kernel_name) const
+  {
+    const std::size_t n_fields = data_indices.size();
+    return ReductionHandle<
+      std::vector<std::pair<double, Tensor<1, spacedim>>>>(
+      compute_local_fluxes(data_indices, kernel_name),
+      this->meter_tria.get_communicator(),
+      [n_fields](const std::vector<double> &sums)
+      {
+        Tensor<1, spacedim> mean_normal;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          mean_normal[d] = sums[n_fields + d];
+        mean_normal /= mean_normal.norm();
+
+        std::vector<std::pair<double, Tensor<1, spacedim>>> fluxes;
+        for (std::size_t i = 0; i < n_fields; ++i)
+          fluxes.emplace_back(sums[i], mean_normal);
+        return fluxes;
+      });
+  }
+
+  template <int dim, int spacedim>
+  std::vector<double>
+  SurfaceMeter<dim, spacedim>::compute_local_fluxes(
+    const std::vector<int> &data_indices,
+    const std::string      &kernel_name) const
+  {
+    FDL_SETUP_TIMER_AND_SCOPE(t_surface_meter_local_fluxes,
+                              "fdl::SurfaceMeter::compute_local_fluxes()");
+    const std::size_t n_fields = data_indices.size();
+    const auto        interpolated_data =
+      this->interpolate_fields(data_indices, kernel_name, true);
 
     const auto                 &fe = this->get_vector_dof_handler().get_fe();
     FEValues<dim - 1, spacedim> fe_values(this->get_mapping(),
@@ -320,31 +423,30 @@ namespace fdl
                                           update_normal_vectors |
                                             update_values | update_JxW_values);
 
-    std::vector<types::global_dof_index> cell_dofs(fe.dofs_per_cell);
+    // Store the flux of each field followed by the integral of the normal
+    // vector
+    std::vector<double>              integrals(n_fields + spacedim);
     std::vector<Tensor<1, spacedim>> cell_values(this->meter_quadrature.size());
-    double                           flux = 0.0;
-    Tensor<1, spacedim>              mean_normal;
     for (const auto &cell :
          this->get_vector_dof_handler().active_cell_iterators() |
            IteratorFilters::LocallyOwnedCell())
       {
-        cell->get_dof_indices(cell_dofs);
         fe_values.reinit(cell);
-        fe_values[FEValuesExtractors::Vector(0)].get_function_values(
-          interpolated_data, cell_values);
         for (unsigned int q = 0; q < this->meter_quadrature.size(); ++q)
+          for (unsigned int d = 0; d < spacedim; ++d)
+            integrals[n_fields + d] +=
+              fe_values.normal_vector(q)[d] * fe_values.JxW(q);
+        for (std::size_t i = 0; i < n_fields; ++i)
           {
-            flux +=
-              cell_values[q] * fe_values.normal_vector(q) * fe_values.JxW(q);
-            mean_normal += fe_values.normal_vector(q) * fe_values.JxW(q);
+            fe_values[FEValuesExtractors::Vector(0)].get_function_values(
+              interpolated_data[i], cell_values);
+            for (unsigned int q = 0; q < this->meter_quadrature.size(); ++q)
+              integrals[i] += cell_values[q] * fe_values.normal_vector(q) *
+                              fe_values.JxW(q);
           }
       }
 
-    flux = Utilities::MPI::sum(flux, this->meter_tria.get_communicator());
-    mean_normal =
-      Utilities::MPI::sum(mean_normal, this->meter_tria.get_communicator());
-    mean_normal /= mean_normal.norm();
-    return std::make_pair(flux, mean_normal);
+    return integrals;
   }
 
   template <int dim, int spacedim>
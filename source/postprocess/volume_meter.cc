@@ -39,8 +39,11 @@ namespace fdl
   {
     FDL_SETUP_TIMER_AND_SCOPE(t_volume_meter_reinit,
                               "fdl::VolumeMeter::reinit()");
-    GridTools::shift(new_center - this->get_centroid(), this->meter_tria);
-    Meter<spacedim, spacedim>::internal_reinit();
+    // Moving the meter is a rigid translation so we can keep the DoFHandlers,
+    // the centroid cell, and (if possible) the interaction object.
+    const Tensor<1, spacedim> translation = new_center - this->get_centroid();
+    GridTools::shift(translation, this->meter_tria);
+    Meter<spacedim, spacedim>::internal_reinit_translation(translation);
   }
 
   template <int spacedim>
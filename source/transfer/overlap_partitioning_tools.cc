@@ -3,10 +3,13 @@
 #include <fiddle/transfer/overlap_partitioning_tools.h>
 
 #include <deal.II/base/index_set.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/types.h>
 
 #include <deal.II/dofs/dof_handler.h>
 
+#include <algorithm>
+
 namespace fdl
 {
   using namespace dealii;
@@ -16,7 +19,8 @@ namespace fdl
   compute_overlap_to_native_dof_translation(
     const fdl::OverlapTriangulation<dim, spacedim> &overlap_tria,
     const DoFHandler<dim, spacedim>                &overlap_dof_handler,
-    const DoFHandler<dim, spacedim>                &native_dof_handler)
+    const DoFHandler<dim, spacedim>                &native_dof_handler,
+    const unsigned int                              n_threads)
   {
     const Triangulation<dim, spacedim> &native_tria =
       overlap_tria.get_native_triangulation();
@@ -39,10 +43,17 @@ namespace fdl
     //
     // 4. Loop over active cells to create the mapping between overlap dofs
     //    (purely local) and native dofs (distributed).
+    //
+    // Steps 3 and 4 (which look up dofs on each cell) are done on up to
+    // n_threads threads.
 
-    // 1: determine required active cell indices:
+    // 1: determine required active cell indices. Also record, for each
+    // locally owned overlap cell, which processor owns the native cell and
+    // its position in the list of cells requested from that processor.
     std::map<types::subdomain_id, std::vector<CellId>>
       native_cell_ids_on_overlap;
+    std::vector<std::pair<types::subdomain_id, std::size_t>>
+      overlap_cell_positions;
     for (const auto &cell : overlap_tria.active_cell_iterators())
       if (cell->is_locally_owned())
         {
@@ -51,8 +62,9 @@ namespace fdl
           // subdomain: that would mean that the corresponding native cell is
           // not active!
           Assert(rank != numbers::invalid_subdomain_id, ExcFDLInternalError());
-          native_cell_ids_on_overlap[rank].push_back(
-            overlap_tria.get_native_cell_id(cell));
+          std::vector<CellId> &cell_ids = native_cell_ids_on_overlap[rank];
+          overlap_cell_positions.emplace_back(rank, cell_ids.size());
+          cell_ids.push_back(overlap_tria.get_native_cell_id(cell));
         }
 
     // 2: send requested active cell indices:
@@ -60,103 +72,135 @@ namespace fdl
       requested_native_cell_ids =
         Utilities::MPI::some_to_some(mpi_comm, native_cell_ids_on_overlap);
 
-    // 3: pack dofs:
+    // 3: pack dofs. Since every cell has the same number of dofs each packed
+    // cell has the same size, so we can fill each processor's array in
+    // parallel:
     std::map<types::subdomain_id, std::vector<types::global_dof_index>>
                 dofs_on_native;
     const auto &fe = native_dof_handler.get_fe();
     Assert(fe.get_name() == overlap_dof_handler.get_fe().get_name(),
            ExcMessage("dof handlers should use the same FiniteElement"));
+    const std::size_t binary_id_size = CellId::binary_type().size();
+    const std::size_t packed_size    = binary_id_size + fe.dofs_per_cell + 2;
     for (const auto &pair : requested_native_cell_ids)
       {
         const types::subdomain_id             requested_rank = pair.first;
+        const std::vector<CellId>            &cell_ids       = pair.second;
         std::vector<types::global_dof_index> &requested_dofs =
           dofs_on_native[requested_rank];
-        const std::vector<CellId>           &cell_ids = pair.second;
-        std::vector<types::global_dof_index> cell_dofs(fe.dofs_per_cell);
-        for (const auto &id : cell_ids)
-          {
-            const auto native_cell = native_tria.create_cell_iterator(id);
-            const auto native_dh_cell =
-              typename DoFHandler<dim, spacedim>::active_cell_iterator(
-                &native_tria,
-                native_cell->level(),
-                native_cell->index(),
-                &native_dof_handler);
-
-            // TODO - we can compress this with 64-bit indices some more - might
-            // be worth doing
-            const auto binary_id = id.to_binary<dim>();
-            for (const auto &v : binary_id)
-              requested_dofs.push_back(v);
-
-            native_dh_cell->get_dof_indices(cell_dofs);
-            requested_dofs.push_back(cell_dofs.size());
-            for (const auto dof : cell_dofs)
-              requested_dofs.push_back(dof);
-
-            requested_dofs.push_back(numbers::invalid_dof_index);
-          }
+        requested_dofs.resize(cell_ids.size() * packed_size);
+
+        auto pack_range = [&](const std::size_t begin, const std::size_t end)
+        {
+          std::vector<types::global_dof_index> cell_dofs(fe.dofs_per_cell);
+          for (std::size_t i = begin; i < end; ++i)
+            {
+              const CellId &id          = cell_ids[i];
+              const auto    native_cell = native_tria.create_cell_iterator(id);
+              const auto    native_dh_cell =
+                typename DoFHandler<dim, spacedim>::active_cell_iterator(
+                  &native_tria,
+                  native_cell->level(),
+                  native_cell->index(),
+                  &native_dof_handler);
+
+              // TODO - we can compress this with 64-bit indices some more -
+              // might be worth doing
+              auto       out       = requested_dofs.begin() + i * packed_size;
+              const auto binary_id = id.to_binary<dim>();
+              out = std::copy(binary_id.begin(), binary_id.end(), out);
+
+              native_dh_cell->get_dof_indices(cell_dofs);
+              *out++ = cell_dofs.size();
+              out    = std::copy(cell_dofs.begin(), cell_dofs.end(), out);
+              *out   = numbers::invalid_dof_index;
+            }
+        };
+
+        if (n_threads <= 1 || cell_ids.size() <= 1)
+          pack_range(std::size_t(0), cell_ids.size());
+        else
+          parallel::apply_to_subranges(
+            std::size_t(0),
+            cell_ids.size(),
+            pack_range,
+            static_cast<unsigned int>(
+              std::max<std::size_t>(1, cell_ids.size() / (4 * n_threads))));
       }
 
     const std::map<types::subdomain_id, std::vector<types::global_dof_index>>
       native_dof_indices =
         Utilities::MPI::some_to_some(mpi_comm, dofs_on_native);
 
-    // we now have the native dofs on each cell in a packed format: active cell
-    // index, dofs, sentinel. Read dof data back in the order in which it was
-    // originally requested:
-    std::map<types::subdomain_id,
-             std::vector<types::global_dof_index>::const_iterator>
-      packed_ptrs;
-    for (const auto &pair : native_dof_indices)
-      packed_ptrs[pair.first] = pair.second.cbegin();
-
-    // 4:
-    std::vector<types::global_dof_index> overlap_cell_dofs(fe.dofs_per_cell);
-    std::vector<types::global_dof_index> native_indices(
-      overlap_dof_handler.n_dofs());
+    // 4: we now have the native dofs on each cell in a packed format: cell
+    // id, number of dofs, dofs, sentinel. The kth cell requested from a
+    // processor in step 1 is the kth packed cell received from it. Look up
+    // the packed data and the overlap dofs of each cell in parallel and then
+    // copy everything into native_indices (since cells share dofs, doing the
+    // last part in parallel would be a race condition).
+    std::vector<typename DoFHandler<dim, spacedim>::active_cell_iterator>
+      overlap_cells;
     for (const auto &cell : overlap_dof_handler.active_cell_iterators())
-      {
-        if (cell->is_locally_owned())
+      if (cell->is_locally_owned())
+        overlap_cells.push_back(cell);
+    AssertDimension(overlap_cells.size(), overlap_cell_positions.size());
+
+    std::vector<types::global_dof_index> overlap_dofs(overlap_cells.size() *
+                                                      fe.dofs_per_cell);
+    std::vector<const types::global_dof_index *> packed_dofs(
+      overlap_cells.size());
+    auto unpack_range = [&](const std::size_t begin, const std::size_t end)
+    {
+      std::vector<types::global_dof_index> overlap_cell_dofs(fe.dofs_per_cell);
+      for (std::size_t i = begin; i < end; ++i)
+        {
+          const auto &cell     = overlap_cells[i];
+          const auto &position = overlap_cell_positions[i];
+          const std::vector<types::global_dof_index> &packed =
+            native_dof_indices.at(position.first);
+          Assert((position.second + 1) * packed_size <= packed.size(),
+                 ExcFDLInternalError());
+          const types::global_dof_index *const packed_cell =
+            packed.data() + position.second * packed_size;
+#ifdef DEBUG
           {
-            const auto native_rank =
-              overlap_tria.get_native_cell_subdomain_id(cell);
-            Assert(native_rank != numbers::invalid_subdomain_id,
-                   ExcFDLInternalError());
-            auto &packed_ptr = packed_ptrs.at(native_rank);
-            Assert(packed_ptr < native_dof_indices.at(native_rank).cend(),
-                   ExcFDLInternalError());
-
             CellId::binary_type binary_id;
-            for (auto &v : binary_id)
-              {
-                v = *packed_ptr;
-                ++packed_ptr;
-              }
-#ifdef DEBUG
-            {
-              const CellId cell_id(binary_id);
-              Assert(overlap_tria.get_native_cell_id(cell) == cell_id,
-                     ExcFDLInternalError());
-            }
-#endif
-
-            const auto n_dofs = *packed_ptr;
-            ++packed_ptr;
-            AssertDimension(n_dofs, overlap_cell_dofs.size());
-
-            // Copy data between orderings.
-            cell->get_dof_indices(overlap_cell_dofs);
-            for (unsigned int i = 0; i < n_dofs; ++i)
-              {
-                native_indices[overlap_cell_dofs[i]] = *packed_ptr;
-                ++packed_ptr;
-              }
-            Assert(*packed_ptr == numbers::invalid_dof_index,
+            std::copy(packed_cell,
+                      packed_cell + binary_id_size,
+                      binary_id.begin());
+            const CellId cell_id(binary_id);
+            Assert(overlap_tria.get_native_cell_id(cell) == cell_id,
                    ExcFDLInternalError());
-            ++packed_ptr;
           }
-      }
+#endif
+          AssertDimension(packed_cell[binary_id_size], fe.dofs_per_cell);
+          Assert(packed_cell[packed_size - 1] == numbers::invalid_dof_index,
+                 ExcFDLInternalError());
+          packed_dofs[i] = packed_cell + binary_id_size + 1;
+
+          cell->get_dof_indices(overlap_cell_dofs);
+          std::copy(overlap_cell_dofs.begin(),
+                    overlap_cell_dofs.end(),
+                    overlap_dofs.begin() + i * fe.dofs_per_cell);
+        }
+    };
+
+    if (n_threads <= 1 || overlap_cells.size() <= 1)
+      unpack_range(std::size_t(0), overlap_cells.size());
+    else
+      parallel::apply_to_subranges(
+        std::size_t(0),
+        overlap_cells.size(),
+        unpack_range,
+        static_cast<unsigned int>(
+          std::max<std::size_t>(1, overlap_cells.size() / (4 * n_threads))));
+
+    std::vector<types::global_dof_index> native_indices(
+      overlap_dof_handler.n_dofs());
+    for (std::size_t i = 0; i < overlap_cells.size(); ++i)
+      for (unsigned int j = 0; j < fe.dofs_per_cell; ++j)
+        native_indices[overlap_dofs[i * fe.dofs_per_cell + j]] =
+          packed_dofs[i][j];
 
     // We finally have the contiguous array native_indices that gives us the
     // native dof for each overlap dof.
@@ -167,11 +211,13 @@ namespace fdl
   compute_overlap_to_native_dof_translation(
     const fdl::OverlapTriangulation<NDIM - 1, NDIM> &overlap_tria,
     const DoFHandler<NDIM - 1, NDIM>                &overlap_dof_handler,
-    const DoFHandler<NDIM - 1, NDIM>                &native_dof_handler);
+    const DoFHandler<NDIM - 1, NDIM>                &native_dof_handler,
+    const unsigned int                               n_threads);
 
   template std::vector<types::global_dof_index>
   compute_overlap_to_native_dof_translation(
     const fdl::OverlapTriangulation<NDIM, NDIM> &overlap_tria,
     const DoFHandler<NDIM, NDIM>                &overlap_dof_handler,
-    const DoFHandler<NDIM, NDIM>                &native_dof_handler);
+    const DoFHandler<NDIM, NDIM>                &native_dof_handler,
+    const unsigned int                           n_threads);
 } // namespace fdl
@@ -1,13 +1,21 @@
 #include <fiddle/base/exceptions.h>
+#include <fiddle/base/trace.h>
 
 #include <fiddle/transfer/scatter.h>
 
 #include <deal.II/base/index_set.h>
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/mpi_tags.h>
 
 #include <deal.II/lac/la_parallel_vector.h>
 
 #include <mpi.h>
 
+#include <algorithm>
+#include <map>
+#include <type_traits>
+
 namespace fdl
 {
   using namespace dealii;
@@ -30,12 +38,20 @@ namespace fdl
   Scatter<T>::Scatter()
     : partitioner(std::make_shared<Utilities::MPI::Partitioner>())
     , n_overlap_dofs(0)
+    , backend(ScatterBackend::PointToPoint)
+    , graph_communicator(MPI_COMM_NULL)
+    , node_communicator(MPI_COMM_NULL)
+    , shared_window(MPI_WIN_NULL)
+    , shared_values(nullptr)
+    , reduced_precision(false)
   {}
 
   template <typename T>
-  Scatter<T>::Scatter(const std::vector<types::global_dof_index> &overlap_dofs,
-                      const IndexSet                             &local_dofs,
-                      const MPI_Comm                             &communicator)
+  Scatter<T>::Scatter(
+    const std::vector<types::global_dof_index> &overlap_dofs,
+    const IndexSet                             &local_dofs,
+    const MPI_Comm                             &communicator,
+    const ScatterBackend                        scatter_backend)
     : partitioner(std::make_shared<Utilities::MPI::Partitioner>(
         local_dofs,
         setup_ghost_dofs(overlap_dofs, local_dofs),
@@ -43,6 +59,12 @@ namespace fdl
     , n_overlap_dofs(overlap_dofs.size())
     , ghost_buffer(partitioner->n_ghost_indices())
     , import_buffer(partitioner->n_import_indices())
+    , backend(scatter_backend)
+    , graph_communicator(MPI_COMM_NULL)
+    , node_communicator(MPI_COMM_NULL)
+    , shared_window(MPI_WIN_NULL)
+    , shared_values(nullptr)
+    , reduced_precision(false)
   {
     Assert(local_dofs.is_contiguous() == true,
            ExcMessage("The index set specified in local_dofs is not "
@@ -77,6 +99,577 @@ namespace fdl
       if (partitioner->in_local_range(overlap_dofs[i]))
         overlap_local_indices.emplace_back(
           i, partitioner->global_to_local(overlap_dofs[i]));
+
+    if (backend == ScatterBackend::NeighborCollective)
+      {
+        // Every neighbor is both a source and a destination (possibly with
+        // zero-length messages) so that the same graph works in both
+        // directions.
+        std::map<int, std::pair<int, int>> neighbor_counts;
+        for (const auto &target : partitioner->ghost_targets())
+          neighbor_counts[target.first].first = target.second;
+        for (const auto &target : partitioner->import_targets())
+          neighbor_counts[target.first].second = target.second;
+
+        std::vector<int> neighbors;
+        int              ghost_offset  = 0;
+        int              import_offset = 0;
+        for (const auto &pair : neighbor_counts)
+          {
+            neighbors.push_back(pair.first);
+            neighbor_ghost_counts.push_back(pair.second.first);
+            neighbor_ghost_offsets.push_back(ghost_offset);
+            ghost_offset += pair.second.first;
+            neighbor_import_counts.push_back(pair.second.second);
+            neighbor_import_offsets.push_back(import_offset);
+            import_offset += pair.second.second;
+          }
+        // Both sets of targets are sorted by rank, so the offsets match the
+        // layout used by the partitioner.
+        Assert(std::size_t(ghost_offset) == ghost_buffer.size(),
+               ExcFDLInternalError());
+        Assert(std::size_t(import_offset) == import_buffer.size(),
+               ExcFDLInternalError());
+
+        // Neighborhood collectives must be called by every processor in the
+        // graph, so leave out processors with no neighbors (e.g., ones
+        // whose patches do not intersect the structure and which own no
+        // dofs needed elsewhere): their graph_communicator is MPI_COMM_NULL
+        // and they never communicate.
+        MPI_Comm  active_communicator = MPI_COMM_NULL;
+        const int rank = Utilities::MPI::this_mpi_process(communicator);
+        int       ierr = MPI_Comm_split(communicator,
+                                  neighbors.empty() ? MPI_UNDEFINED : 0,
+                                  rank,
+                                  &active_communicator);
+        AssertThrowMPI(ierr);
+        if (active_communicator != MPI_COMM_NULL)
+          {
+            // Neighbors are ranks in communicator, not active_communicator
+            MPI_Group group, active_group;
+            ierr = MPI_Comm_group(communicator, &group);
+            AssertThrowMPI(ierr);
+            ierr = MPI_Comm_group(active_communicator, &active_group);
+            AssertThrowMPI(ierr);
+            std::vector<int> active_neighbors(neighbors.size());
+            ierr = MPI_Group_translate_ranks(group,
+                                             neighbors.size(),
+                                             neighbors.data(),
+                                             active_group,
+                                             active_neighbors.data());
+            AssertThrowMPI(ierr);
+            for (MPI_Group *g : {&group, &active_group})
+              {
+                ierr = MPI_Group_free(g);
+                AssertThrowMPI(ierr);
+              }
+
+            ierr = MPI_Dist_graph_create_adjacent(active_communicator,
+                                                  active_neighbors.size(),
+                                                  active_neighbors.data(),
+                                                  MPI_UNWEIGHTED,
+                                                  active_neighbors.size(),
+                                                  active_neighbors.data(),
+                                                  MPI_UNWEIGHTED,
+                                                  MPI_INFO_NULL,
+                                                  false,
+                                                  &graph_communicator);
+            AssertThrowMPI(ierr);
+            ierr = MPI_Comm_free(&active_communicator);
+            AssertThrowMPI(ierr);
+          }
+      }
+    else if (backend == ScatterBackend::SharedMemory)
+      setup_shared_memory(communicator);
+  }
+
+
+
+  template <typename T>
+  void
+  Scatter<T>::setup_shared_memory(const MPI_Comm &communicator)
+  {
+    const unsigned int rank = Utilities::MPI::this_mpi_process(communicator);
+    int                ierr = MPI_Comm_split_type(communicator,
+                                   MPI_COMM_TYPE_SHARED,
+                                   rank,
+                                   MPI_INFO_NULL,
+                                   &node_communicator);
+    AssertThrowMPI(ierr);
+
+    // Since we split with rank as the key, node ranks are sorted in the same
+    // order as ranks in communicator.
+    node_ranks = Utilities::MPI::all_gather(node_communicator, rank);
+    Assert(std::is_sorted(node_ranks.begin(), node_ranks.end()),
+           ExcFDLInternalError());
+    const std::vector<types::global_dof_index> node_first_dofs =
+      Utilities::MPI::all_gather(node_communicator,
+                                 partitioner->local_range().first);
+
+    const MPI_Aint window_size = partitioner->locally_owned_size() * sizeof(T);
+    void          *base        = nullptr;
+    ierr                       = MPI_Win_allocate_shared(window_size,
+                                   sizeof(T),
+                                   MPI_INFO_NULL,
+                                   node_communicator,
+                                   &base,
+                                   &shared_window);
+    AssertThrowMPI(ierr);
+    shared_values = static_cast<T *>(base);
+    // Use a single passive target epoch for the lifetime of the window:
+    // synchronization is done with MPI_Win_sync() and barriers.
+    ierr = MPI_Win_lock_all(MPI_MODE_NOCHECK, shared_window);
+    AssertThrowMPI(ierr);
+
+    const IndexSet &ghost_indices = partitioner->ghost_indices();
+    unsigned int    offset        = 0;
+    for (const auto &target : partitioner->ghost_targets())
+      {
+        if (is_on_node(target.first))
+          {
+            const int node_rank =
+              std::lower_bound(node_ranks.begin(),
+                               node_ranks.end(),
+                               target.first) -
+              node_ranks.begin();
+            MPI_Aint size       = 0;
+            int      disp_unit  = 0;
+            void    *owner_base = nullptr;
+            ierr                = MPI_Win_shared_query(
+              shared_window, node_rank, &size, &disp_unit, &owner_base);
+            AssertThrowMPI(ierr);
+            const T *const owner_values = static_cast<const T *>(owner_base);
+            for (unsigned int k = offset; k < offset + target.second; ++k)
+              shared_ghost_values.emplace_back(
+                k,
+                owner_values + (ghost_indices.nth_index_in_set(k) -
+                                node_first_dofs[node_rank]));
+          }
+        offset += target.second;
+      }
+  }
+
+
+
+  template <typename T>
+  bool
+  Scatter<T>::is_on_node(const unsigned int rank) const
+  {
+    return std::binary_search(node_ranks.begin(), node_ranks.end(), rank);
+  }
+
+
+
+  template <typename T>
+  void
+  Scatter<T>::set_reduced_precision(const bool use_reduced_precision)
+  {
+    // float is already the reduced type
+    reduced_precision =
+      use_reduced_precision && !std::is_same<T, float>::value;
+    if (reduced_precision && wire_ghost_buffer.size() != ghost_buffer.size())
+      {
+        // These buffers are never resized again, so requests set up with
+        // them stay valid.
+        wire_ghost_buffer.resize(ghost_buffer.size());
+        wire_import_buffer.resize(import_buffer.size());
+      }
+  }
+
+
+
+  template <typename T>
+  void
+  Scatter<T>::unpack_wire_buffer(const bool global_to_overlap)
+  {
+    if (!global_to_overlap)
+      {
+        std::copy(wire_import_buffer.begin(),
+                  wire_import_buffer.end(),
+                  import_buffer.begin());
+        return;
+      }
+
+    // Values read from shared memory are already in ghost_buffer and were
+    // never sent.
+    std::size_t offset = 0;
+    for (const auto &target : partitioner->ghost_targets())
+      {
+        if (!is_on_node(target.first))
+          std::copy(wire_ghost_buffer.begin() + offset,
+                    wire_ghost_buffer.begin() + offset + target.second,
+                    ghost_buffer.begin() + offset);
+        offset += target.second;
+      }
+  }
+
+
+
+  template <typename T>
+  void
+  Scatter<T>::exchange_shared_values(
+    const LinearAlgebra::distributed::Vector<T> &input)
+  {
+    Assert(shared_window != MPI_WIN_NULL, ExcFDLInternalError());
+    std::copy(input.get_values(),
+              input.get_values() + input.locally_owned_size(),
+              shared_values);
+
+    // Make our writes visible to the other processors and then wait for
+    // everyone else's. The second barrier guarantees that nobody overwrites
+    // their values in the next scatter while we are still reading them.
+    int ierr = MPI_Win_sync(shared_window);
+    AssertThrowMPI(ierr);
+    ierr = MPI_Barrier(node_communicator);
+    AssertThrowMPI(ierr);
+    ierr = MPI_Win_sync(shared_window);
+    AssertThrowMPI(ierr);
+
+    for (const auto &pair : shared_ghost_values)
+      ghost_buffer[pair.first] = *pair.second;
+
+    ierr = MPI_Barrier(node_communicator);
+    AssertThrowMPI(ierr);
+  }
+
+
+
+  template <typename T>
+  Scatter<T>::~Scatter()
+  {
+    free_persistent_requests();
+
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+    if (finalized)
+      return;
+
+    if (shared_window != MPI_WIN_NULL)
+      {
+        int ierr = MPI_Win_unlock_all(shared_window);
+        AssertNothrow(ierr == MPI_SUCCESS, ExcMPI(ierr));
+        ierr = MPI_Win_free(&shared_window);
+        AssertNothrow(ierr == MPI_SUCCESS, ExcMPI(ierr));
+      }
+    for (MPI_Comm *comm : {&graph_communicator, &node_communicator})
+      if (*comm != MPI_COMM_NULL)
+        {
+          const int ierr = MPI_Comm_free(comm);
+          AssertNothrow(ierr == MPI_SUCCESS, ExcMPI(ierr));
+        }
+  }
+
+
+
+  template <typename T>
+  std::vector<MPI_Request> &
+  Scatter<T>::get_persistent_requests(const bool         global_to_overlap,
+                                      const unsigned int channel)
+  {
+    auto &all_requests =
+      reduced_precision ?
+        (global_to_overlap ? reduced_global_to_overlap_requests :
+                             reduced_overlap_to_global_requests) :
+        (global_to_overlap ? global_to_overlap_requests :
+                             overlap_to_global_requests);
+    auto it = all_requests.find(channel);
+    if (it == all_requests.end())
+      it = all_requests
+             .emplace(channel,
+                      create_persistent_requests(global_to_overlap, channel, 1))
+             .first;
+    return it->second;
+  }
+
+
+
+  template <typename T>
+  std::vector<MPI_Request>
+  Scatter<T>::create_persistent_requests(const bool         global_to_overlap,
+                                         const unsigned int channel,
+                                         const unsigned int n_vectors)
+  {
+    Assert(n_vectors == 1 || global_to_overlap, ExcFDLNotImplemented());
+    // Reduced precision scatters send floats from the wire buffers instead.
+    const bool        reduced    = n_vectors == 1 && reduced_precision;
+    const std::size_t value_size = reduced ? sizeof(float) : sizeof(T);
+    char *ghost_data  = reinterpret_cast<char *>(ghost_buffer.data());
+    char *import_data = reinterpret_cast<char *>(import_buffer.data());
+    if (reduced)
+      {
+        ghost_data  = reinterpret_cast<char *>(wire_ghost_buffer.data());
+        import_data = reinterpret_cast<char *>(wire_import_buffer.data());
+      }
+    else if (n_vectors > 1)
+      {
+        BatchData &data = get_batch_data(n_vectors);
+        ghost_data      = reinterpret_cast<char *>(data.ghost_buffer.data());
+        import_data     = reinterpret_cast<char *>(data.import_buffer.data());
+      }
+
+    // Global to overlap scatters send owned values to the processors which
+    // ghost them and receive ghost values from their owners - overlap to global
+    // scatters go the other way. Like the partitioner we use contiguous
+    // segments of the buffers for each processor.
+    const MPI_Comm     comm = partitioner->get_mpi_communicator();
+    const MPI_Datatype type =
+      reduced ? MPI_FLOAT : Utilities::MPI::mpi_type_id_for_type<T>;
+    const int tag = channel + (global_to_overlap ?
+                                   Utilities::MPI::internal::Tags::
+                                     partitioner_export_start :
+                                   Utilities::MPI::internal::Tags::
+                                     partitioner_import_start);
+
+    // With shared memory, single vector global to overlap scatters only send
+    // messages between nodes.
+    const bool skip_on_node = global_to_overlap && n_vectors == 1 &&
+                              backend == ScatterBackend::SharedMemory;
+
+    std::vector<MPI_Request> new_requests;
+    std::size_t              offset = 0;
+    for (const auto &target : partitioner->ghost_targets())
+      {
+        const int count = n_vectors * target.second;
+        if (skip_on_node && is_on_node(target.first))
+          {
+            offset += count;
+            continue;
+          }
+        new_requests.push_back(MPI_REQUEST_NULL);
+        void *const buffer = ghost_data + offset * value_size;
+        const int ierr =
+          global_to_overlap ?
+            MPI_Recv_init(buffer,
+                          count,
+                          type,
+                          target.first,
+                          tag,
+                          comm,
+                          &new_requests.back()) :
+            MPI_Send_init(buffer,
+                          count,
+                          type,
+                          target.first,
+                          tag,
+                          comm,
+                          &new_requests.back());
+        AssertThrowMPI(ierr);
+        offset += count;
+      }
+    Assert(offset == n_vectors * ghost_buffer.size(), ExcFDLInternalError());
+
+    offset = 0;
+    for (const auto &target : partitioner->import_targets())
+      {
+        const int count = n_vectors * target.second;
+        if (skip_on_node && is_on_node(target.first))
+          {
+            offset += count;
+            continue;
+          }
+        new_requests.push_back(MPI_REQUEST_NULL);
+        void *const buffer = import_data + offset * value_size;
+        const int ierr =
+          global_to_overlap ?
+            MPI_Send_init(buffer,
+                          count,
+                          type,
+                          target.first,
+                          tag,
+                          comm,
+                          &new_requests.back()) :
+            MPI_Recv_init(buffer,
+                          count,
+                          type,
+                          target.first,
+                          tag,
+                          comm,
+                          &new_requests.back());
+        AssertThrowMPI(ierr);
+        offset += count;
+      }
+    Assert(offset == n_vectors * import_buffer.size(), ExcFDLInternalError());
+
+    return new_requests;
+  }
+
+
+
+  template <typename T>
+  typename Scatter<T>::BatchData &
+  Scatter<T>::get_batch_data(const unsigned int n_vectors)
+  {
+    Assert(n_vectors > 1, ExcFDLInternalError());
+    auto it = batch_data.find(n_vectors);
+    if (it != batch_data.end())
+      return it->second;
+
+    BatchData &data = batch_data[n_vectors];
+    data.ghost_buffer.resize(n_vectors * ghost_buffer.size());
+    data.import_buffer.resize(n_vectors * import_buffer.size());
+    for (std::size_t i = 0; i < neighbor_ghost_counts.size(); ++i)
+      {
+        data.neighbor_ghost_counts.push_back(n_vectors *
+                                             neighbor_ghost_counts[i]);
+        data.neighbor_ghost_offsets.push_back(n_vectors *
+                                              neighbor_ghost_offsets[i]);
+        data.neighbor_import_counts.push_back(n_vectors *
+                                              neighbor_import_counts[i]);
+        data.neighbor_import_offsets.push_back(n_vectors *
+                                               neighbor_import_offsets[i]);
+      }
+
+    return data;
+  }
+
+
+
+  template <typename T>
+  void
+  Scatter<T>::free_persistent_requests()
+  {
+    // Objects may be destroyed after MPI_Finalize() - in that case there is
+    // nothing left to free.
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+    if (finalized)
+      return;
+
+    std::vector<std::map<unsigned int, std::vector<MPI_Request>> *>
+      request_maps = {&global_to_overlap_requests,
+                      &overlap_to_global_requests,
+                      &reduced_global_to_overlap_requests,
+                      &reduced_overlap_to_global_requests};
+    for (auto &pair : batch_data)
+      request_maps.push_back(&pair.second.requests);
+    for (auto *all_requests : request_maps)
+      {
+        for (auto &pair : *all_requests)
+          for (MPI_Request &request : pair.second)
+            if (request != MPI_REQUEST_NULL)
+              {
+                const int ierr = MPI_Request_free(&request);
+                AssertNothrow(ierr == MPI_SUCCESS, ExcMPI(ierr));
+              }
+        all_requests->clear();
+      }
+  }
+
+
+
+  template <typename T>
+  void
+  Scatter<T>::start_neighbor_exchange(const bool         global_to_overlap,
+                                      const unsigned int n_vectors)
+  {
+    Assert(n_vectors == 1 || global_to_overlap, ExcFDLNotImplemented());
+    // Processors without neighbors are not part of the graph
+    if (graph_communicator == MPI_COMM_NULL)
+      {
+        Assert(neighbor_ghost_counts.empty(), ExcFDLInternalError());
+        requests.clear();
+        return;
+      }
+    const bool         reduced = n_vectors == 1 && reduced_precision;
+    const MPI_Datatype type =
+      reduced ? MPI_FLOAT : Utilities::MPI::mpi_type_id_for_type<T>;
+
+    void      *ghost_data     = ghost_buffer.data();
+    void      *import_data    = import_buffer.data();
+    const int *ghost_counts   = neighbor_ghost_counts.data();
+    const int *ghost_offsets  = neighbor_ghost_offsets.data();
+    const int *import_counts  = neighbor_import_counts.data();
+    const int *import_offsets = neighbor_import_offsets.data();
+    if (n_vectors > 1)
+      {
+        BatchData &data = get_batch_data(n_vectors);
+        ghost_data      = data.ghost_buffer.data();
+        import_data     = data.import_buffer.data();
+        ghost_counts    = data.neighbor_ghost_counts.data();
+        ghost_offsets   = data.neighbor_ghost_offsets.data();
+        import_counts   = data.neighbor_import_counts.data();
+        import_offsets  = data.neighbor_import_offsets.data();
+      }
+    else if (reduced)
+      {
+        ghost_data  = wire_ghost_buffer.data();
+        import_data = wire_import_buffer.data();
+      }
+
+    requests.resize(1);
+    const int ierr = global_to_overlap ?
+                       MPI_Ineighbor_alltoallv(import_data,
+                                               import_counts,
+                                               import_offsets,
+                                               type,
+                                               ghost_data,
+                                               ghost_counts,
+                                               ghost_offsets,
+                                               type,
+                                               graph_communicator,
+                                               &requests[0]) :
+                       MPI_Ineighbor_alltoallv(ghost_data,
+                                               ghost_counts,
+                                               ghost_offsets,
+                                               type,
+                                               import_data,
+                                               import_counts,
+                                               import_offsets,
+                                               type,
+                                               graph_communicator,
+                                               &requests[0]);
+    AssertThrowMPI(ierr);
+  }
+
+
+
+  template <typename T>
+  void
+  Scatter<T>::record_scatter(const bool         global_to_overlap,
+                             const unsigned int n_vectors)
+  {
+    // Same logic as create_persistent_requests(): ghost targets send overlap
+    // to global and receive global to overlap, and import targets do the
+    // opposite.
+    const bool skip_on_node = global_to_overlap && n_vectors == 1 &&
+                              backend == ScatterBackend::SharedMemory;
+    unsigned long n_ghost_messages  = 0;
+    unsigned long n_import_messages = 0;
+    std::size_t   n_ghost_values    = 0;
+    std::size_t   n_import_values   = 0;
+
+    std::vector<unsigned int> neighbors;
+    for (const auto &target : partitioner->ghost_targets())
+      if (!(skip_on_node && is_on_node(target.first)))
+        {
+          ++n_ghost_messages;
+          n_ghost_values += target.second;
+          neighbors.push_back(target.first);
+        }
+    for (const auto &target : partitioner->import_targets())
+      if (!(skip_on_node && is_on_node(target.first)))
+        {
+          ++n_import_messages;
+          n_import_values += target.second;
+          neighbors.push_back(target.first);
+        }
+    std::sort(neighbors.begin(), neighbors.end());
+    neighbors.erase(std::unique(neighbors.begin(), neighbors.end()),
+                    neighbors.end());
+
+    const std::size_t value_size =
+      n_vectors == 1 && reduced_precision ? sizeof(float) : sizeof(T);
+    const std::size_t ghost_bytes  = n_vectors * n_ghost_values * value_size;
+    const std::size_t import_bytes = n_vectors * n_import_values * value_size;
+    ++statistics.n_scatters;
+    statistics.n_messages_sent +=
+      global_to_overlap ? n_import_messages : n_ghost_messages;
+    statistics.n_messages_received +=
+      global_to_overlap ? n_ghost_messages : n_import_messages;
+    statistics.bytes_sent += global_to_overlap ? import_bytes : ghost_bytes;
+    statistics.bytes_received += global_to_overlap ? ghost_bytes : import_bytes;
+    statistics.n_neighbors =
+      std::max<unsigned int>(statistics.n_neighbors, neighbors.size());
   }
 
 
@@ -89,6 +682,7 @@ namespace fdl
     const unsigned int                     channel,
     LinearAlgebra::distributed::Vector<T> &output)
   {
+    TraceScope trace("Scatter::overlap_to_global_start", "scatter", channel);
     Assert(input.size() == n_overlap_dofs,
            ExcMessage("Input vector should be indexed by overlap dofs"));
     Assert(output.locally_owned_size() == partitioner->locally_owned_size(),
@@ -119,21 +713,32 @@ namespace fdl
         Assert(false, ExcFDLNotImplemented());
       }
 
-    for (unsigned int i = 0; i < overlap_ghost_indices.size(); ++i)
-      ghost_buffer[i] = input[overlap_ghost_indices[i]];
+    if (reduced_precision)
+      for (unsigned int i = 0; i < overlap_ghost_indices.size(); ++i)
+        wire_ghost_buffer[i] = input[overlap_ghost_indices[i]];
+    else
+      for (unsigned int i = 0; i < overlap_ghost_indices.size(); ++i)
+        ghost_buffer[i] = input[overlap_ghost_indices[i]];
 
     for (const auto &pair : overlap_local_indices)
       output.local_element(pair.second) = input[pair.first];
 
-    const VectorOperation::values actual_op =
-      operation == VectorOperation::insert ? VectorOperation::max : operation;
+    record_scatter(false, 1);
+    if (backend == ScatterBackend::NeighborCollective)
+      {
+        start_neighbor_exchange(false);
+        return;
+      }
 
-    partitioner->import_from_ghosted_array_start(
-      actual_op,
-      channel,
-      ArrayView<T>(ghost_buffer.data(), ghost_buffer.size()),
-      ArrayView<T>(import_buffer.data(), import_buffer.size()),
-      requests);
+    std::vector<MPI_Request> &persistent_requests =
+      get_persistent_requests(false, channel);
+    if (persistent_requests.size() > 0)
+      {
+        const int ierr = MPI_Startall(persistent_requests.size(),
+                                      persistent_requests.data());
+        AssertThrowMPI(ierr);
+      }
+    requests = persistent_requests;
   }
 
 
@@ -145,6 +750,8 @@ namespace fdl
     const VectorOperation::values          operation,
     LinearAlgebra::distributed::Vector<T> &output)
   {
+    TraceScope   trace("Scatter::overlap_to_global_finish", "scatter");
+    const double start_time = MPI_Wtime();
     (void)input;
     Assert(input.size() == n_overlap_dofs,
            ExcMessage("Input vector should be indexed by overlap dofs"));
@@ -152,15 +759,32 @@ namespace fdl
            ExcMessage("The output vector should have the same number of dofs "
                       "as were provided to the constructor in local"));
 
-    const VectorOperation::values actual_op =
-      operation == VectorOperation::insert ? VectorOperation::max : operation;
+    if (requests.size() > 0)
+      {
+        const int ierr =
+          MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+        AssertThrowMPI(ierr);
+      }
+    if (reduced_precision)
+      unpack_wire_buffer(false);
 
-    partitioner->import_from_ghosted_array_finish<T>(
-      actual_op,
-      ArrayView<const T>(import_buffer.data(), import_buffer.size()),
-      ArrayView<T>(output.get_values(), output.locally_owned_size()),
-      ArrayView<T>(ghost_buffer.data(), ghost_buffer.size()),
-      requests);
+    // See the note in overlap_to_global_start() - insert is really max.
+    std::size_t k = 0;
+    if (operation == VectorOperation::add)
+      {
+        for (const auto &range : partitioner->import_indices())
+          for (unsigned int i = range.first; i < range.second; ++i, ++k)
+            output.local_element(i) += import_buffer[k];
+      }
+    else
+      {
+        for (const auto &range : partitioner->import_indices())
+          for (unsigned int i = range.first; i < range.second; ++i, ++k)
+            output.local_element(i) =
+              std::max(output.local_element(i), import_buffer[k]);
+      }
+    Assert(k == import_buffer.size(), ExcFDLInternalError());
+    statistics.finish_time += MPI_Wtime() - start_time;
   }
 
 
@@ -172,6 +796,7 @@ namespace fdl
     const unsigned int                           channel,
     Vector<T>                                   &output)
   {
+    TraceScope trace("Scatter::global_to_overlap_start", "scatter", channel);
     (void)output;
     Assert(output.size() == n_overlap_dofs,
            ExcMessage("output vector should be indexed by overlap dofs"));
@@ -179,12 +804,36 @@ namespace fdl
            ExcMessage("The output vector should have the same number of dofs "
                       "as were provided to the constructor in local"));
 
-    partitioner->export_to_ghosted_array_start<T>(
-      channel,
-      ArrayView<const T>(input.get_values(), input.locally_owned_size()),
-      ArrayView<T>(import_buffer.data(), import_buffer.size()),
-      ArrayView<T>(ghost_buffer.data(), ghost_buffer.size()),
-      requests);
+    std::size_t k = 0;
+    if (reduced_precision)
+      for (const auto &range : partitioner->import_indices())
+        for (unsigned int i = range.first; i < range.second; ++i, ++k)
+          wire_import_buffer[k] = input.local_element(i);
+    else
+      for (const auto &range : partitioner->import_indices())
+        for (unsigned int i = range.first; i < range.second; ++i, ++k)
+          import_buffer[k] = input.local_element(i);
+    Assert(k == import_buffer.size(), ExcFDLInternalError());
+
+    record_scatter(true, 1);
+    if (backend == ScatterBackend::NeighborCollective)
+      {
+        start_neighbor_exchange(true);
+        return;
+      }
+
+    std::vector<MPI_Request> &persistent_requests =
+      get_persistent_requests(true, channel);
+    if (persistent_requests.size() > 0)
+      {
+        const int ierr = MPI_Startall(persistent_requests.size(),
+                                      persistent_requests.data());
+        AssertThrowMPI(ierr);
+      }
+    requests = persistent_requests;
+
+    if (backend == ScatterBackend::SharedMemory)
+      exchange_shared_values(input);
   }
 
 
@@ -195,31 +844,220 @@ namespace fdl
     const LinearAlgebra::distributed::Vector<T> &input,
     Vector<T>                                   &output)
   {
+    TraceScope   trace("Scatter::global_to_overlap_finish", "scatter");
+    const double start_time = MPI_Wtime();
     Assert(output.size() == n_overlap_dofs,
            ExcMessage("output vector should be indexed by overlap dofs"));
     Assert(input.locally_owned_size() == partitioner->locally_owned_size(),
            ExcMessage("The output vector should have the same number of dofs "
                       "as were provided to the constructor in local"));
 
-    partitioner->export_to_ghosted_array_finish(
-      ArrayView<T>(ghost_buffer.data(), ghost_buffer.size()), requests);
+    if (requests.size() > 0)
+      {
+        const int ierr =
+          MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+        AssertThrowMPI(ierr);
+      }
+    if (reduced_precision)
+      unpack_wire_buffer(true);
 
     for (unsigned int i = 0; i < overlap_ghost_indices.size(); ++i)
       output[overlap_ghost_indices[i]] = ghost_buffer[i];
 
     for (const auto &pair : overlap_local_indices)
       output[pair.first] = input.local_element(pair.second);
+    statistics.finish_time += MPI_Wtime() - start_time;
+  }
+
+  template <typename T>
+  void
+  Scatter<T>::global_to_overlap_start(
+    const std::vector<const LinearAlgebra::distributed::Vector<T> *> &input,
+    const unsigned int                                                channel,
+    const std::vector<Vector<T> *>                                   &output)
+  {
+    AssertDimension(input.size(), output.size());
+    Assert(input.size() > 0,
+           ExcMessage("At least one vector should be provided"));
+    const unsigned int n_vectors = input.size();
+    if (n_vectors == 1)
+      {
+        global_to_overlap_start(*input[0], channel, *output[0]);
+        return;
+      }
+    TraceScope trace("Scatter::global_to_overlap_start", "scatter", channel);
+#ifdef DEBUG
+    for (unsigned int v = 0; v < n_vectors; ++v)
+      {
+        Assert(output[v]->size() == n_overlap_dofs,
+               ExcMessage("output vectors should be indexed by overlap dofs"));
+        Assert(input[v]->locally_owned_size() ==
+                 partitioner->locally_owned_size(),
+               ExcMessage("The input vectors should have the same number of "
+                          "dofs as were provided to the constructor in "
+                          "local"));
+      }
+#endif
+
+    // Pack each vector into import_buffer (which is not otherwise used by
+    // this scatter) and then copy each processor's segment to its place in
+    // the batch buffer.
+    BatchData &data = get_batch_data(n_vectors);
+    for (unsigned int v = 0; v < n_vectors; ++v)
+      {
+        std::size_t k = 0;
+        for (const auto &range : partitioner->import_indices())
+          for (unsigned int i = range.first; i < range.second; ++i, ++k)
+            import_buffer[k] = input[v]->local_element(i);
+
+        std::size_t offset = 0;
+        for (const auto &target : partitioner->import_targets())
+          {
+            std::copy(import_buffer.begin() + offset,
+                      import_buffer.begin() + offset + target.second,
+                      data.import_buffer.begin() + n_vectors * offset +
+                        v * target.second);
+            offset += target.second;
+          }
+      }
+
+    record_scatter(true, n_vectors);
+    if (backend == ScatterBackend::NeighborCollective)
+      {
+        start_neighbor_exchange(true, n_vectors);
+        return;
+      }
+
+    auto it = data.requests.find(channel);
+    if (it == data.requests.end())
+      it = data.requests
+             .emplace(channel,
+                      create_persistent_requests(true, channel, n_vectors))
+             .first;
+    if (it->second.size() > 0)
+      {
+        const int ierr = MPI_Startall(it->second.size(), it->second.data());
+        AssertThrowMPI(ierr);
+      }
+    requests = it->second;
+  }
+
+
+
+  template <typename T>
+  void
+  Scatter<T>::global_to_overlap_finish(
+    const std::vector<const LinearAlgebra::distributed::Vector<T> *> &input,
+    const std::vector<Vector<T> *>                                   &output)
+  {
+    AssertDimension(input.size(), output.size());
+    const unsigned int n_vectors = input.size();
+    if (n_vectors == 1)
+      {
+        global_to_overlap_finish(*input[0], *output[0]);
+        return;
+      }
+    TraceScope   trace("Scatter::global_to_overlap_finish", "scatter");
+    const double start_time = MPI_Wtime();
+
+    if (requests.size() > 0)
+      {
+        const int ierr =
+          MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+        AssertThrowMPI(ierr);
+      }
+
+    const BatchData &data = get_batch_data(n_vectors);
+    for (unsigned int v = 0; v < n_vectors; ++v)
+      {
+        Vector<T>  &vector = *output[v];
+        std::size_t offset = 0;
+        for (const auto &target : partitioner->ghost_targets())
+          {
+            const T *const segment = data.ghost_buffer.data() +
+                                     n_vectors * offset + v * target.second;
+            for (unsigned int k = 0; k < target.second; ++k)
+              vector[overlap_ghost_indices[offset + k]] = segment[k];
+            offset += target.second;
+          }
+
+        for (const auto &pair : overlap_local_indices)
+          vector[pair.first] = input[v]->local_element(pair.second);
+      }
+    statistics.finish_time += MPI_Wtime() - start_time;
+  }
+
+
+
+  template <typename T>
+  std::size_t
+  Scatter<T>::memory_consumption() const
+  {
+    std::size_t result =
+      MemoryConsumption::memory_consumption(overlap_ghost_indices) +
+      MemoryConsumption::memory_consumption(overlap_local_indices) +
+      MemoryConsumption::memory_consumption(ghost_buffer) +
+      MemoryConsumption::memory_consumption(import_buffer) +
+      MemoryConsumption::memory_consumption(wire_ghost_buffer) +
+      MemoryConsumption::memory_consumption(wire_import_buffer) +
+      MemoryConsumption::memory_consumption(neighbor_ghost_counts) +
+      MemoryConsumption::memory_consumption(neighbor_ghost_offsets) +
+      MemoryConsumption::memory_consumption(neighbor_import_counts) +
+      MemoryConsumption::memory_consumption(neighbor_import_offsets) +
+      MemoryConsumption::memory_consumption(node_ranks) +
+      shared_ghost_values.capacity() * sizeof(shared_ghost_values[0]) +
+      MemoryConsumption::memory_consumption(requests);
+    for (const auto &pair : batch_data)
+      {
+        const BatchData &data = pair.second;
+        result += MemoryConsumption::memory_consumption(data.ghost_buffer) +
+                  MemoryConsumption::memory_consumption(data.import_buffer);
+      }
+    return result;
   }
 
+
+
   template <typename T>
   std::vector<MPI_Request>
   Scatter<T>::delegate_outstanding_requests()
   {
+    // The persistent requests are still owned by this object: the caller only
+    // gets copies of the handles to wait on.
     auto copy = requests;
     std::fill(requests.begin(), requests.end(), MPI_REQUEST_NULL);
     return copy;
   }
 
+  template <typename T>
+  bool
+  Scatter<T>::has_same_pattern(
+    const std::vector<types::global_dof_index> &overlap_dofs,
+    const IndexSet                             &local_dofs,
+    const MPI_Comm                             &communicator,
+    const ScatterBackend                        scatter_backend) const
+  {
+    if (scatter_backend != backend || overlap_dofs.size() != n_overlap_dofs ||
+        partitioner->get_mpi_communicator() != communicator ||
+        local_dofs != partitioner->locally_owned_range())
+      return false;
+
+    // Each overlap dof is either a ghost or locally owned, so this checks
+    // every entry of overlap_dofs.
+    auto ghost = partitioner->ghost_indices().begin();
+    for (const unsigned int overlap_index : overlap_ghost_indices)
+      {
+        if (overlap_dofs[overlap_index] != *ghost)
+          return false;
+        ++ghost;
+      }
+    for (const auto &pair : overlap_local_indices)
+      if (overlap_dofs[pair.first] != partitioner->local_to_global(pair.second))
+        return false;
+
+    return true;
+  }
+
   template class Scatter<float>;
   template class Scatter<double>;
 } // namespace fdl
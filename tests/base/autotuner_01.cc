@@ -0,0 +1,55 @@
+#include <fiddle/base/autotuner.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <fstream>
+
+// Test that Autotuner tries each candidate in order, ignores the first trial
+// of each candidate, and picks the candidate whose slowest processor is
+// fastest
+
+int
+main(int argc, char **argv)
+{
+  using namespace dealii;
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  const unsigned int rank = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+
+  std::ofstream out;
+  if (rank == 0)
+    out.open("output");
+
+  fdl::Autotuner autotuner({3, 5, 7}, 2);
+  // Candidate 5 is fastest on one processor, but is slower than candidate 7
+  // on the second processor
+  const std::vector<double> times{4.0 + rank, 2.0 + 3.0 * rank, 3.0};
+  for (unsigned int i = 0; i < 6; ++i)
+    {
+      const int    value = autotuner.get_value();
+      const double time  = i % 2 == 0 ? 100.0 : times[i / 2];
+      const bool   tuned = autotuner.add_time(time, MPI_COMM_WORLD);
+      if (rank == 0)
+        out << "trial " << i << " value = " << value
+            << " just tuned = " << tuned << std::endl;
+    }
+  if (rank == 0)
+    out << "tuned = " << autotuner.is_tuned()
+        << " value = " << autotuner.get_value() << std::endl;
+
+  // Further times are ignored:
+  const bool tuned_again = autotuner.add_time(0.0, MPI_COMM_WORLD);
+  if (rank == 0)
+    out << "tuned again = " << tuned_again
+        << " value = " << autotuner.get_value() << std::endl;
+
+  // A single candidate does not need tuning:
+  const fdl::Autotuner single({2}, 3);
+  // Values from previous runs skip tuning:
+  fdl::Autotuner previous({0, 1, 2}, 3);
+  previous.set_value(1);
+  if (rank == 0)
+    out << "single candidate tuned = " << single.is_tuned()
+        << " value = " << single.get_value() << std::endl
+        << "previous value tuned = " << previous.is_tuned()
+        << " value = " << previous.get_value() << std::endl;
+}
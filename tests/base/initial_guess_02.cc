@@ -0,0 +1,92 @@
+#include <fiddle/base/initial_guess.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <fstream>
+
+// Test initial guesses computed by extrapolation
+
+int
+main()
+{
+  std::ofstream out("output");
+
+  using namespace dealii;
+
+  // Solutions which depend quadratically on the step number should be
+  // extrapolated exactly
+  {
+    fdl::InitialGuess<Vector<double>> guess(
+      5, fdl::InitialGuessMethod::Extrapolation);
+    Vector<double> rhs(3);
+    rhs[0] = 1.0;
+
+    for (unsigned int n = 0; n < 4; ++n)
+      {
+        Vector<double> solution(3);
+        solution[0] = 1.0;
+        solution[1] = n;
+        solution[2] = n * n;
+        guess.submit(solution, rhs);
+      }
+
+    Vector<double> solution(3);
+    guess.guess(solution, rhs);
+    solution.print(out);
+  }
+
+  // With two solutions the extrapolation should be linear
+  {
+    fdl::InitialGuess<Vector<double>> guess(
+      5, fdl::InitialGuessMethod::Extrapolation);
+    Vector<double> rhs(3);
+    rhs[0] = 1.0;
+
+    for (unsigned int n = 0; n < 2; ++n)
+      {
+        Vector<double> solution(3);
+        solution[0] = 1.0;
+        solution[1] = n;
+        solution[2] = n * n;
+        guess.submit(solution, rhs);
+      }
+
+    Vector<double> solution(3);
+    guess.guess(solution, rhs);
+    solution.print(out);
+  }
+
+  // If projection requires fewer iterations then we should switch to it: use
+  // a problem where the projection is exact.
+  {
+    fdl::InitialGuess<Vector<double>> guess(
+      5, fdl::InitialGuessMethod::Extrapolation);
+
+    Vector<double> solution_1(3);
+    Vector<double> rhs_1(3);
+    solution_1[0] = 1.0;
+    rhs_1[0]      = 1.0;
+    Vector<double> solution_2(3);
+    Vector<double> rhs_2(3);
+    solution_2[1] = 1.0;
+    rhs_2[1]      = 1.0;
+
+    // Alternate between two solutions, which extrapolation cannot predict
+    for (unsigned int n = 0; n < 2 * 9; ++n)
+      {
+        const Vector<double> &rhs      = n % 2 == 0 ? rhs_1 : rhs_2;
+        const Vector<double> &solution = n % 2 == 0 ? solution_1 : solution_2;
+
+        Vector<double> current(3);
+        guess.guess(current, rhs);
+        current -= solution;
+        // Use the error as a proxy for the number of iterations
+        guess.submit(solution, rhs, current.l2_norm() < 1e-12 ? 0 : 10);
+      }
+
+    Vector<double> current(3);
+    guess.guess(current, rhs_2);
+    current -= solution_2;
+    out << "projection is used: " << (current.l2_norm() < 1e-12) << std::endl;
+  }
+}
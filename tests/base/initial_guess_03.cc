@@ -0,0 +1,67 @@
+#include <fiddle/base/initial_guess.h>
+
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <fstream>
+#include <vector>
+
+// Test that the ring buffer in InitialGuess keeps exactly the last few
+// vectors with parallel vectors
+
+int
+main(int argc, char **argv)
+{
+  using namespace dealii;
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  const unsigned int rank    = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  const unsigned int n_procs = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+
+  const unsigned int n_local = 8;
+  IndexSet           locally_owned(n_local * n_procs);
+  locally_owned.add_range(rank * n_local, (rank + 1) * n_local);
+  using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+  // The ith solution and right-hand side are both the ith unit vector, so a
+  // guess is exact if and only if the corresponding vector is still stored.
+  // InitialGuess identifies right-hand sides by address so keep them alive.
+  const unsigned int      n_vectors     = 3;
+  const unsigned int      n_submissions = 2 * n_vectors + 1;
+  std::vector<VectorType> unit_vectors;
+  for (unsigned int i = 0; i < n_submissions; ++i)
+    {
+      unit_vectors.emplace_back(locally_owned, MPI_COMM_WORLD);
+      if (locally_owned.is_element(i))
+        unit_vectors.back()[i] = 1.0;
+    }
+
+  fdl::InitialGuess<VectorType> guess(n_vectors);
+  std::ofstream                 out;
+  if (rank == 0)
+    out.open("output");
+  for (unsigned int n = 0; n < n_submissions; ++n)
+    {
+      // Alternate between using and not using guess() to test both ways of
+      // computing inner products in submit()
+      if (n % 2 == 0)
+        {
+          VectorType current(unit_vectors[n]);
+          guess.guess(current, unit_vectors[n]);
+        }
+      guess.submit(unit_vectors[n], unit_vectors[n]);
+
+      for (unsigned int i = 0; i <= n; ++i)
+        {
+          VectorType current(unit_vectors[i]);
+          current = 0.0;
+          guess.guess(current, unit_vectors[i]);
+          current -= unit_vectors[i];
+          const bool exact = current.l2_norm() < 1e-14;
+          if (rank == 0)
+            out << "after " << n + 1 << " submissions, vector " << i
+                << (exact ? " is stored" : " is not stored") << std::endl;
+        }
+    }
+}
@@ -0,0 +1,37 @@
+#include <fiddle/base/initial_guess.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <fstream>
+
+// Test InitialGuess::compute_rhs_change()
+
+int
+main()
+{
+  std::ofstream out("output");
+
+  using namespace dealii;
+
+  fdl::InitialGuess<Vector<double>> guess(2);
+  Vector<double>                    rhs(3);
+  Vector<double>                    solution(3);
+  out << "no stored vectors: " << (guess.compute_rhs_change(rhs) < 0.0)
+      << std::endl;
+
+  // Submit more vectors than the ring buffer holds: the change should always
+  // be relative to the newest one
+  for (unsigned int n = 0; n < 3; ++n)
+    {
+      rhs[0]      = n;
+      solution[0] = n;
+      guess.submit(solution, rhs);
+
+      Vector<double> new_rhs(rhs);
+      new_rhs[1] = 3.0;
+      new_rhs[2] = 4.0;
+      out << "change after " << n + 1
+          << " submissions: " << guess.compute_rhs_change(new_rhs)
+          << std::endl;
+    }
+}
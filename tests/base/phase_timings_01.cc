@@ -0,0 +1,39 @@
+#include <fiddle/base/phase_timings.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <fstream>
+
+// Test that PhaseTimings combines the times recorded by each processor,
+// including phases which only run on some processors
+
+int
+main(int argc, char **argv)
+{
+  using namespace dealii;
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  const unsigned int rank = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+
+  fdl::PhaseTimings &timings = fdl::PhaseTimings::get();
+  for (unsigned int i = 0; i < 2; ++i)
+    timings.add("a", rank + 1.0);
+  if (rank == 0)
+    timings.add("b", 3.0);
+  if (rank == 1)
+    for (unsigned int i = 0; i < 3; ++i)
+      timings.add("c", 1.0);
+
+  std::ofstream out;
+  if (rank == 0)
+    out.open("output");
+  timings.write(out, MPI_COMM_WORLD, fdl::PhaseTimings::Format::CSV);
+  timings.write(out, MPI_COMM_WORLD, fdl::PhaseTimings::Format::JSON);
+
+  // Nothing should be recorded after resetting and disabling.
+  timings.reset();
+  timings.set_enabled(false);
+  timings.add("a", 1.0);
+  const auto statistics = timings.compute_statistics(MPI_COMM_WORLD);
+  if (rank == 0)
+    out << "number of phases after reset: " << statistics.size() << std::endl;
+}
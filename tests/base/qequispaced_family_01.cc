@@ -0,0 +1,54 @@
+#include <fiddle/base/quadrature_family.h>
+
+#include <fstream>
+
+// Test the equispaced quadrature families
+
+template <int dim>
+void
+test_points(const fdl::QuadratureFamily<dim> &q_family, std::ofstream &out)
+{
+  for (unsigned char i = 0; i < 6; ++i)
+    {
+      const dealii::Quadrature<dim> &quad = q_family[i];
+      out << "quadrature " << int(i) << " size = " << quad.size() << '\n';
+      for (unsigned int i = 0; i < std::min<unsigned int>(5, quad.size()); ++i)
+        out << quad.get_points()[i] << '\n';
+    }
+}
+
+template <int dim>
+void
+test_sizes(const fdl::QuadratureFamily<dim> &q_family, std::ofstream &out)
+{
+  for (unsigned char i = 0; i < 6; ++i)
+    out << "quadrature " << int(i) << " size = " << q_family[i].size()
+        << '\n';
+}
+
+template <int dim>
+void
+test_indices(const fdl::QuadratureFamily<dim> &q_family, std::ofstream &out)
+{
+  for (const double lagrangian_length : {0.05, 0.1, 0.2, 0.4, 0.8})
+    out << "dx = " << 0.1 << " DX = " << lagrangian_length << " index = "
+        << int(q_family.get_index(0.1, lagrangian_length)) << '\n';
+}
+
+int
+main()
+{
+  std::ofstream out("output");
+  for (unsigned int min_points_1D = 1; min_points_1D < 3; ++min_points_1D)
+    {
+      out << "min points 1D " << min_points_1D << "\n";
+      fdl::QEquispacedFamily<2> q_family(min_points_1D);
+      test_points(q_family, out);
+      test_indices(q_family, out);
+
+      out << "simplex min points 1D " << min_points_1D << "\n";
+      fdl::QEquispacedSimplexFamily<2> q_simplex_family(min_points_1D);
+      test_sizes(q_simplex_family, out);
+      test_indices(q_simplex_family, out);
+    }
+}
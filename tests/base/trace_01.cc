@@ -0,0 +1,53 @@
+#include <fiddle/base/trace.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <fstream>
+#include <string>
+
+// Test that the Tracer only records events while it is enabled and writes
+// them in the Chrome trace event format
+
+int
+main(int argc, char **argv)
+{
+  using namespace dealii;
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  const unsigned int rank = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+
+  fdl::Tracer &tracer = fdl::Tracer::get();
+  {
+    fdl::TraceScope trace("ignored", "test");
+  }
+  tracer.enable(MPI_COMM_WORLD);
+  {
+    fdl::TraceScope outer("outer", "test");
+    for (unsigned int i = 0; i < 2; ++i)
+      fdl::TraceScope inner("inner", "test", i);
+  }
+  tracer.disable();
+  {
+    fdl::TraceScope trace("ignored", "test");
+  }
+  tracer.write("trace");
+
+  // Timings are not reproducible so remove them before printing the file.
+  std::ofstream out;
+  if (rank == 0)
+    out.open("output");
+  std::ifstream in("trace." + std::to_string(rank) + ".json");
+  std::string   line;
+  while (std::getline(in, line))
+    {
+      const auto ts = line.find(", \"ts\"");
+      if (ts != std::string::npos)
+        {
+          const auto args = line.find(", \"args\"");
+          line.erase(ts,
+                     (args == std::string::npos ? line.rfind('}') : args) -
+                       ts);
+        }
+      if (rank == 0)
+        out << line << '\n';
+    }
+}
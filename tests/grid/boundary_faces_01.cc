@@ -0,0 +1,142 @@
+#include <fiddle/grid/boundary_faces.h>
+
+#include <fiddle/mechanics/force_contribution_lib.h>
+#include <fiddle/mechanics/mechanics_utilities.h>
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <cmath>
+#include <fstream>
+
+#include "../tests.h"
+
+// Verify that BoundaryFaces finds the right faces, that it is updated when the
+// Triangulation changes, and that compute_boundary_force_load_vector()
+// computes the same load vector with it.
+
+using namespace dealii;
+
+template <int spacedim>
+class Position : public Function<spacedim>
+{
+public:
+  Position()
+    : Function<spacedim>(spacedim)
+  {}
+
+  double
+  value(const Point<spacedim> &p,
+        const unsigned int     component = 0) const override
+  {
+    const double tau = 2.0 * numbers::PI;
+    return p[component] + 0.05 * std::sin(tau * p[0]) * std::sin(tau * p[1]);
+  }
+};
+
+template <int dim>
+void
+print_faces(const fdl::BoundaryFaces<dim> &boundary_faces,
+            std::ostream                  &output)
+{
+  const MPI_Comm comm =
+    boundary_faces.get_dof_handler().get_triangulation().get_communicator();
+  output << "number of cells = "
+         << Utilities::MPI::sum(boundary_faces.get_cells().size(), comm)
+         << std::endl;
+  for (types::boundary_id id = 0; id < 2 * dim; ++id)
+    output << "boundary id = " << int(id) << " number of faces = "
+           << Utilities::MPI::sum(boundary_faces.get_faces(id).size(), comm)
+           << std::endl;
+}
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_init_finalize(argc, argv, 1);
+  const MPI_Comm                   comm = MPI_COMM_WORLD;
+  std::ofstream                    output;
+  if (Utilities::MPI::this_mpi_process(comm) == 0)
+    output.open("output");
+
+  constexpr int                        dim = 2;
+  parallel::shared::Triangulation<dim> tria(comm);
+  GridGenerator::hyper_cube(tria, 0.0, 1.0, true);
+  tria.refine_global(2);
+
+  FESystem<dim>   fe(FE_Q<dim>(1), dim);
+  MappingQ<dim>   mapping(1);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  fdl::BoundaryFaces<dim> boundary_faces(dof_handler);
+  print_faces(boundary_faces, output);
+
+  tria.refine_global(1);
+  dof_handler.distribute_dofs(fe);
+  print_faces(boundary_faces, output);
+
+  IndexSet locally_relevant_dofs;
+  DoFTools::extract_locally_relevant_dofs(dof_handler, locally_relevant_dofs);
+  const auto partitioner = std::make_shared<Utilities::MPI::Partitioner>(
+    dof_handler.locally_owned_dofs(), locally_relevant_dofs, comm);
+
+  fdl::BoundarySpringForce<dim> spring(QGauss<dim - 1>(2),
+                                       1.0,
+                                       dof_handler,
+                                       mapping,
+                                       Functions::IdentityFunction<dim>(),
+                                       {1, 3});
+  std::vector<fdl::ForceContribution<dim> *> forces{&spring};
+
+  LinearAlgebra::distributed::Vector<double> current_position(partitioner),
+    current_velocity(partitioner), rhs(partitioner),
+    boundary_faces_rhs(partitioner);
+  VectorTools::interpolate(mapping,
+                           dof_handler,
+                           Position<dim>(),
+                           current_position);
+  current_position.update_ghost_values();
+  spring.setup_force(0.0, current_position, current_velocity);
+
+  fdl::compute_boundary_force_load_vector(dof_handler,
+                                          mapping,
+                                          forces,
+                                          0.0,
+                                          current_position,
+                                          current_velocity,
+                                          rhs);
+  rhs.compress(VectorOperation::add);
+  fdl::compute_boundary_force_load_vector(dof_handler,
+                                          mapping,
+                                          forces,
+                                          0.0,
+                                          current_position,
+                                          current_velocity,
+                                          boundary_faces_rhs,
+                                          &boundary_faces);
+  boundary_faces_rhs.compress(VectorOperation::add);
+
+  const double norm = rhs.l2_norm();
+  boundary_faces_rhs -= rhs;
+  if (Utilities::MPI::this_mpi_process(comm) == 0)
+    output << "nonzero load vector: " << (norm > 0.0 ? "true" : "false")
+           << std::endl
+           << "load vectors match: "
+           << (boundary_faces_rhs.l2_norm() == 0.0 ? "true" : "false")
+           << std::endl;
+}
@@ -0,0 +1,117 @@
+#include <fiddle/grid/box_utilities.h>
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_fe_field.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include <fstream>
+
+// Test that compute_cell_bboxes() reuses bounding boxes when the cells only
+// move a little bit
+
+using namespace dealii;
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize   mpi_initialization(argc, argv, 1);
+  const auto                         mpi_comm = MPI_COMM_WORLD;
+  parallel::shared::Triangulation<2> tria(mpi_comm);
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(3);
+
+  FESystem<2>   position_fe(FE_Q<2>(2), 2);
+  DoFHandler<2> position_dh(tria);
+  position_dh.distribute_dofs(position_fe);
+
+  IndexSet locally_relevant_dofs;
+  DoFTools::extract_locally_relevant_dofs(position_dh, locally_relevant_dofs);
+  LinearAlgebra::distributed::Vector<double> position(
+    position_dh.locally_owned_dofs(), locally_relevant_dofs, mpi_comm);
+  VectorTools::interpolate(position_dh,
+                           Functions::IdentityFunction<2>(),
+                           position);
+  position.update_ghost_values();
+
+  MappingFEField<2, 2, decltype(position)> mapping(position_dh, position);
+
+  std::ofstream output("output");
+
+  // Move every node by the same amount
+  auto translate = [&](const double shift)
+  {
+    for (unsigned int i = 0; i < position.locally_owned_size(); ++i)
+      position.local_element(i) += shift;
+    position.update_ghost_values();
+  };
+
+  auto contains_exact = [&](const auto &bboxes)
+  {
+    const auto exact_bboxes =
+      fdl::compute_cell_bboxes<2, 2, float>(position_dh, mapping);
+    bool contains = bboxes.size() == exact_bboxes.size();
+    for (std::size_t i = 0; contains && i < bboxes.size(); ++i)
+      for (unsigned int d = 0; d < 2; ++d)
+        contains =
+          contains &&
+          bboxes[i].lower_bound(d) <= exact_bboxes[i].lower_bound(d) &&
+          exact_bboxes[i].upper_bound(d) <= bboxes[i].upper_bound(d);
+    return contains;
+  };
+
+  for (const unsigned int n_threads : {1u, 4u})
+    {
+      output << "n_threads = " << n_threads << '\n';
+      std::vector<BoundingBox<2, float>> bboxes;
+      std::vector<double>                inflations;
+      const double                       tolerance = 0.05;
+
+      // there are no cached boxes so everything is recomputed
+      std::size_t n_recomputed = fdl::compute_cell_bboxes(
+        position_dh, mapping, {0.0}, tolerance, bboxes, inflations, n_threads);
+      output << "recomputed all: " << (n_recomputed == tria.n_active_cells())
+             << '\n'
+             << "exact: "
+             << (bboxes == fdl::compute_cell_bboxes<2, 2, float>(position_dh,
+                                                                 mapping))
+             << '\n';
+
+      // small displacements only enlarge the boxes
+      translate(0.02);
+      n_recomputed = fdl::compute_cell_bboxes(
+        position_dh, mapping, {0.02}, tolerance, bboxes, inflations, n_threads);
+      output << "recomputed: " << n_recomputed << '\n'
+             << "contains exact: " << contains_exact(bboxes) << '\n';
+      translate(-0.02);
+      n_recomputed = fdl::compute_cell_bboxes(
+        position_dh, mapping, {0.02}, tolerance, bboxes, inflations, n_threads);
+      output << "recomputed: " << n_recomputed << '\n'
+             << "contains exact: " << contains_exact(bboxes) << '\n';
+
+      // but eventually we exceed the tolerance
+      translate(0.02);
+      n_recomputed = fdl::compute_cell_bboxes(
+        position_dh, mapping, {0.02}, tolerance, bboxes, inflations, n_threads);
+      output << "recomputed all: " << (n_recomputed == tria.n_active_cells())
+             << '\n'
+             << "exact: "
+             << (bboxes == fdl::compute_cell_bboxes<2, 2, float>(position_dh,
+                                                                 mapping))
+             << '\n';
+      translate(-0.02);
+    }
+}
@@ -0,0 +1,82 @@
+#include <fiddle/grid/boundary_centroid.h>
+#include <fiddle/grid/grid_utilities.h>
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_fe_field.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include <fstream>
+
+// Test that BoundaryCentroid computes the same centroids as
+// compute_centroid() as the position changes
+
+using namespace dealii;
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize   mpi_initialization(argc, argv, 1);
+  const auto                         mpi_comm = MPI_COMM_WORLD;
+  parallel::shared::Triangulation<2> tria(mpi_comm);
+  GridGenerator::hyper_cube(tria, 0, 1, true);
+  tria.refine_global(3);
+
+  FESystem<2>   position_fe(FE_Q<2>(2), 2);
+  DoFHandler<2> position_dh(tria);
+  position_dh.distribute_dofs(position_fe);
+
+  IndexSet locally_relevant_dofs;
+  DoFTools::extract_locally_relevant_dofs(position_dh, locally_relevant_dofs);
+  LinearAlgebra::distributed::Vector<double> position(
+    position_dh.locally_owned_dofs(), locally_relevant_dofs, mpi_comm);
+  VectorTools::interpolate(position_dh,
+                           Functions::IdentityFunction<2>(),
+                           position);
+  position.update_ghost_values();
+
+  MappingFEField<2, 2, decltype(position)> mapping(position_dh, position);
+
+  const std::vector<types::boundary_id> boundary_ids{2u, 0u};
+  const fdl::BoundaryCentroid<2>        boundary_centroid(position_dh,
+                                                          boundary_ids,
+                                                          QGauss<1>(3));
+
+  std::ofstream output;
+  if (Utilities::MPI::this_mpi_process(mpi_comm) == 0)
+    output.open("output");
+
+  for (unsigned int step = 0; step < 3; ++step)
+    {
+      const Point<2> expected =
+        fdl::compute_centroid(mapping, tria, boundary_ids);
+      const Point<2> centroid = boundary_centroid.compute(position);
+      if (Utilities::MPI::this_mpi_process(mpi_comm) == 0)
+        output << "step " << step
+               << " same centroid: " << (centroid.distance(expected) < 1e-12)
+               << '\n';
+
+      // Each coordinate moves by a different amount, so the boundary is
+      // stretched nonuniformly
+      for (unsigned int i = 0; i < position.locally_owned_size(); ++i)
+        {
+          const double x             = position.local_element(i);
+          position.local_element(i) = x + 0.1 * x * x;
+        }
+      position.update_ghost_values();
+    }
+}
@@ -0,0 +1,120 @@
+#include <fiddle/grid/box_utilities.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Test both versions of collect_intersecting_active_cell_bboxes in parallel
+
+template <int spacedim, typename Number>
+void
+test(std::ostream &output)
+{
+  using namespace dealii;
+
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+  const auto n_procs  = Utilities::MPI::n_mpi_processes(mpi_comm);
+
+  const auto partitioner =
+    parallel::shared::Triangulation<spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<spacedim> tria(mpi_comm,
+                                                 {},
+                                                 false,
+                                                 partitioner);
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(2);
+
+  const auto to_number = [](const BoundingBox<spacedim> &input)
+  {
+    BoundingBox<spacedim, Number> result;
+    result.get_boundary_points() = input.get_boundary_points();
+    return result;
+  };
+
+  std::vector<BoundingBox<spacedim, Number>> bboxes;
+  std::vector<float>                         lengths;
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->is_locally_owned())
+      {
+        bboxes.emplace_back(to_number(cell->bounding_box()));
+        lengths.push_back(float(cell->diameter()));
+      }
+
+  // Pretend that each processor owns a thin strip of the domain
+  std::vector<BoundingBox<spacedim, Number>> patch_bboxes;
+  {
+    Point<spacedim> lower, upper;
+    for (unsigned int d = 0; d < spacedim; ++d)
+      {
+        lower[d] = -1.0;
+        upper[d] = 1.0;
+      }
+    lower[0] = -1.0 + 2.0 * rank / n_procs;
+    upper[0] = lower[0] + 0.5 / n_procs;
+    patch_bboxes.emplace_back(
+      to_number(BoundingBox<spacedim>(std::make_pair(lower, upper))));
+  }
+
+  const auto some_bboxes =
+    fdl::collect_intersecting_active_cell_bboxes(tria, bboxes, patch_bboxes);
+
+  // The lengths should be sent alongside the same boxes
+  std::vector<float> some_lengths;
+  const auto         some_bboxes_2 =
+    fdl::collect_intersecting_active_cell_bboxes(
+      tria, bboxes, patch_bboxes, lengths, some_lengths);
+  bool same_bboxes  = some_bboxes == some_bboxes_2;
+  bool same_lengths = some_lengths.size() == tria.n_active_cells();
+
+  bool         correct     = some_bboxes.size() == tria.n_active_cells();
+  unsigned int n_collected = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      const auto bbox      = to_number(cell->bounding_box());
+      const auto some_bbox = some_bboxes[cell->active_cell_index()];
+      if (cell->is_locally_owned() || fdl::intersects(bbox, patch_bboxes[0]))
+        {
+          correct = correct && some_bbox == bbox;
+          same_lengths =
+            same_lengths && some_lengths[cell->active_cell_index()] ==
+                              float(cell->diameter());
+          ++n_collected;
+        }
+      else
+        correct = correct && (some_bbox == bbox ||
+                              !fdl::intersects(some_bbox, patch_bboxes[0]));
+    }
+
+  const auto all_bboxes = fdl::collect_all_active_cell_bboxes(tria, bboxes);
+  std::ostringstream this_proc_out;
+  this_proc_out << "Rank = " << rank << '\n'
+                << "correct: " << correct << '\n'
+                << "same bboxes with lengths: " << same_bboxes << '\n'
+                << "correct lengths: " << same_lengths << '\n'
+                << "collected fewer boxes: "
+                << (n_procs == 1 || n_collected < all_bboxes.size()) << '\n';
+
+  print_strings_on_0(this_proc_out.str(), mpi_comm, output);
+}
+
+int
+main(int argc, char **argv)
+{
+  using namespace dealii;
+
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  std::ofstream output;
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    output.open("output");
+
+  test<NDIM, float>(output);
+  test<NDIM, double>(output);
+}
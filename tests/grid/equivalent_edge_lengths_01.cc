@@ -0,0 +1,57 @@
+#include <fiddle/grid/grid_utilities.h>
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include "../tests.h"
+
+// Verify the output of the equivalent edge length computation on a mesh of
+// anisotropic cells.
+
+int
+main(int argc, char **argv)
+{
+  using namespace dealii;
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  const int                        rank =
+    Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  parallel::shared::Triangulation<2> tria(MPI_COMM_WORLD);
+  GridGenerator::subdivided_hyper_rectangle(tria,
+                                            {4u, 2u},
+                                            Point<2>(),
+                                            Point<2>(1.0, 0.25));
+
+  const std::vector<float> equivalent_lengths =
+    fdl::compute_equivalent_edge_lengths(tria, MappingQ1<2>(), QGauss<2>(2));
+  const std::vector<float> longest_lengths =
+    fdl::compute_longest_edge_lengths(tria, MappingQ1<2>(), QGauss<1>(2));
+  AssertDimension(equivalent_lengths.size(), longest_lengths.size());
+
+  unsigned int local_index = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->is_locally_owned())
+      {
+        const float length = std::sqrt(cell->measure());
+        AssertIndexRange(local_index, equivalent_lengths.size());
+        AssertThrow(std::abs(length - equivalent_lengths[local_index]) <
+                      length * 1e-6,
+                    ExcMessage("lengths should be close"));
+        ++local_index;
+      }
+
+  std::ostringstream out;
+  out << "rank = " << rank << '\n';
+  for (std::size_t i = 0; i < equivalent_lengths.size(); ++i)
+    out << equivalent_lengths[i] << ' ' << longest_lengths[i] << '\n';
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+
+  print_strings_on_0(out.str(), MPI_COMM_WORLD, output);
+}
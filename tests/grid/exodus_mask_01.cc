@@ -0,0 +1,63 @@
+#include <fiddle/grid/data_in.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_in.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <fstream>
+
+// Test that read_dof_data() with a ComponentMask reads the selected
+// components and leaves the others untouched.
+
+int
+main()
+{
+  using namespace dealii;
+
+  const std::string test_file = SOURCE_DIR + std::string("q2.ex2");
+  Triangulation<2>  tria;
+  GridIn<2>         grid_in(tria);
+  grid_in.read_exodusii(test_file);
+
+  FESystem<2>   fe(FE_Q<2>(2), 2, FE_DGQ<2>(0), 2);
+  DoFHandler<2> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  Vector<double> all_values(dof_handler.n_dofs());
+  fdl::read_dof_data(
+    test_file, dof_handler, 1, {"X_0", "X_1", "M", "FF_11"}, all_values);
+
+  const ComponentMask mask(std::vector<bool>{false, true, true, false});
+  Vector<double>      masked_values(dof_handler.n_dofs());
+  masked_values = -1.0;
+  fdl::read_dof_data(
+    test_file, dof_handler, 1, {"X_1", "M"}, masked_values, mask);
+
+  std::vector<types::global_dof_index> cell_dofs(fe.n_dofs_per_cell());
+  bool selected_match    = true;
+  bool others_unmodified = true;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      cell->get_dof_indices(cell_dofs);
+      for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
+        {
+          const types::global_dof_index dof = cell_dofs[i];
+          if (mask[fe.system_to_component_index(i).first])
+            selected_match =
+              selected_match && masked_values[dof] == all_values[dof];
+          else
+            others_unmodified = others_unmodified && masked_values[dof] == -1.0;
+        }
+    }
+
+  std::ofstream output("output");
+  output << "selected components match: " << selected_match << std::endl
+         << "other components unmodified: " << others_unmodified << std::endl;
+}
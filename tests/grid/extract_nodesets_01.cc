@@ -0,0 +1,52 @@
+#include <fiddle/grid/grid_utilities.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <ibtk/IBTKInit.h>
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+
+// Test that extract_nodesets() reads the same nodes as extract_nodeset(),
+// sorted and without duplicates.
+
+int
+main(int argc, char **argv)
+{
+  using namespace dealii;
+
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+
+  const std::string test_file = SOURCE_DIR "/two-nodesets.e";
+
+  const std::vector<int> nodeset_ids{42, 100};
+  const auto             nodesets =
+    fdl::extract_nodesets<3>(test_file, nodeset_ids, MPI_COMM_WORLD);
+
+  std::ofstream output;
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    output.open("output");
+
+  for (unsigned int i = 0; i < nodeset_ids.size(); ++i)
+    {
+      const auto nodeset = fdl::extract_nodeset<3>(test_file, nodeset_ids[i]);
+      std::map<unsigned int, Point<3>> expected;
+      for (unsigned int j = 0; j < nodeset.first.size(); ++j)
+        expected[nodeset.first[j]] = nodeset.second[j];
+
+      const auto &indices = nodesets[i].first;
+      const auto &points  = nodesets[i].second;
+      bool        matches = indices.size() == expected.size() &&
+                     points.size() == expected.size();
+      for (unsigned int j = 0; matches && j < indices.size(); ++j)
+        matches = expected.count(indices[j]) == 1 &&
+                  expected[indices[j]] == points[j];
+
+      if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+        output << "nodeset " << nodeset_ids[i] << ":" << std::endl
+               << "  sorted: "
+               << std::is_sorted(indices.begin(), indices.end()) << std::endl
+               << "  matches extract_nodeset(): " << matches << std::endl;
+    }
+}
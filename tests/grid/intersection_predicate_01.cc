@@ -0,0 +1,89 @@
+#include <fiddle/grid/intersection_predicate_lib.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <fstream>
+
+// Test that IntersectionPredicate::evaluate() gives the same results as
+// operator()
+
+using namespace dealii;
+
+template <typename Predicate>
+void
+check(const Predicate                          &predicate,
+      const parallel::shared::Triangulation<2> &tria,
+      std::ostream                             &output)
+{
+  std::vector<Triangulation<2>::cell_iterator> cells;
+  for (const auto &cell : tria.cell_iterators())
+    cells.push_back(cell);
+
+  std::vector<unsigned char> mask;
+  predicate.evaluate(make_array_view(cells), mask);
+
+  bool         same         = mask.size() == cells.size();
+  unsigned int n_intersects = 0;
+  for (std::size_t i = 0; same && i < cells.size(); ++i)
+    {
+      same = same && bool(mask[i]) == predicate(cells[i]);
+      n_intersects += mask[i];
+    }
+  output << "  some cells intersect: " << (n_intersects > 0) << '\n'
+         << "  not all cells intersect: " << (n_intersects < cells.size())
+         << '\n'
+         << "  same results: " << same << '\n';
+}
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  std::ofstream                    output("output");
+
+  parallel::shared::Triangulation<2> tria(MPI_COMM_WORLD);
+  GridGenerator::hyper_ball(tria);
+  for (unsigned int i = 0; i < 4; ++i)
+    {
+      for (const auto &cell : tria.active_cell_iterators())
+        if (cell->barycenter()[0] > 0.0)
+          cell->set_refine_flag();
+      tria.execute_coarsening_and_refinement();
+    }
+
+  std::vector<BoundingBox<2>> patch_bboxes;
+  patch_bboxes.emplace_back(
+    std::make_pair(Point<2>(0.25, 0.25), Point<2>(0.5, 0.75)));
+  patch_bboxes.emplace_back(
+    std::make_pair(Point<2>(-0.75, -0.5), Point<2>(-0.5, -0.25)));
+
+  output << "TriaIntersectionPredicate\n";
+  check(fdl::TriaIntersectionPredicate<2>(patch_bboxes), tria, output);
+
+  const auto to_float = [](const BoundingBox<2> &bbox)
+  {
+    Point<2, float> lower, upper;
+    for (unsigned int d = 0; d < 2; ++d)
+      {
+        lower[d] = bbox.lower_bound(d);
+        upper[d] = bbox.upper_bound(d);
+      }
+    return BoundingBox<2, float>(std::make_pair(lower, upper));
+  };
+  std::vector<BoundingBox<2, float>> float_patch_bboxes;
+  for (const auto &bbox : patch_bboxes)
+    float_patch_bboxes.push_back(to_float(bbox));
+  std::vector<BoundingBox<2, float>> cell_bboxes;
+  for (const auto &cell : tria.active_cell_iterators())
+    cell_bboxes.push_back(to_float(cell->bounding_box()));
+
+  output << "BoxIntersectionPredicate\n";
+  check(fdl::BoxIntersectionPredicate<2>(cell_bboxes, float_patch_bboxes, tria),
+        tria,
+        output);
+}
@@ -0,0 +1,208 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/grid/box_utilities.h>
+#include <fiddle/grid/nodal_patch_map.h>
+#include <fiddle/grid/overlap_tria.h>
+
+#include <fiddle/interaction/interaction_utilities.h>
+
+#include <fiddle/transfer/overlap_partitioning_tools.h>
+#include <fiddle/transfer/scatter.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_out.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/sparse_direct.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <BergerRigoutsos.h>
+#include <CartesianGridGeometry.h>
+#include <GriddingAlgorithm.h>
+#include <HierarchyCellDataOpsReal.h>
+#include <HierarchySideDataOpsReal.h>
+#include <LoadBalancer.h>
+#include <StandardTagAndInitialize.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Test the unique point table of NodalPatchMap
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto input_db = app_initializer->getInputDatabase();
+  auto test_db  = input_db->getDatabase("test");
+
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> tria(MPI_COMM_WORLD,
+                                                      {},
+                                                      false,
+                                                      partitioner);
+  // fudge the center a little so that things are not exactly on axes
+  Point<spacedim> center;
+  for (unsigned int d = 0; d < spacedim; ++d)
+    center[d] = 0.01;
+  GridGenerator::hyper_ball(tria, center);
+  tria.refine_global(2);
+
+  // setup SAMRAI stuff (its always the same):
+  auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+
+  // setup Lagrangian data: like a DG field, every cell gets its own copy of
+  // each of its vertices
+  std::vector<unsigned int> node_vertices;
+  for (const auto &cell : tria.active_cell_iterators())
+    for (const unsigned int v : cell->vertex_indices())
+      node_vertices.push_back(cell->vertex_index(v));
+  const std::size_t n_nodes = node_vertices.size();
+  Vector<double>    nodal_coordinates(n_nodes * spacedim);
+  for (std::size_t node_n = 0; node_n < n_nodes; ++node_n)
+    for (unsigned int d = 0; d < spacedim; ++d)
+      nodal_coordinates[node_n * spacedim + d] =
+        tria.get_vertices()[node_vertices[node_n]][d];
+
+  const std::size_t n_vertices = tria.n_vertices();
+  Vector<double>    vertex_coordinates(n_vertices * spacedim);
+  for (std::size_t vertex_n = 0; vertex_n < n_vertices; ++vertex_n)
+    for (unsigned int d = 0; d < spacedim; ++d)
+      vertex_coordinates[vertex_n * spacedim + d] =
+        tria.get_vertices()[vertex_n][d];
+
+  // Now set up fiddle things for the test:
+  std::ostringstream out;
+  out << "rank = " << rank << std::endl;
+  std::vector<tbox::Pointer<hier::Patch<spacedim>>> patches;
+  std::vector<std::vector<BoundingBox<spacedim>>>   bboxes;
+  for (int ln = 0; ln <= patch_hierarchy->getFinestLevelNumber(); ++ln)
+    {
+      const auto new_patches =
+        fdl::extract_patches(patch_hierarchy->getPatchLevel(ln));
+      patches.insert(patches.end(), new_patches.begin(), new_patches.end());
+
+      if (ln < patch_hierarchy->getFinestLevelNumber())
+        {
+          const auto nonoverlapping_boxes =
+            fdl::compute_nonoverlapping_patch_boxes(
+              patch_hierarchy->getPatchLevel(ln),
+              patch_hierarchy->getPatchLevel(ln + 1));
+          for (const auto &vec : nonoverlapping_boxes)
+            {
+              bboxes.emplace_back();
+              for (const auto &box : vec)
+                bboxes.back().push_back(
+                  fdl::box_to_bbox(box, patch_hierarchy->getPatchLevel(ln)));
+            }
+        }
+      else
+        {
+          for (const auto &patch : new_patches)
+            {
+              bboxes.emplace_back();
+              bboxes.back().push_back(
+                fdl::box_to_bbox(patch->getBox(),
+                                 patch_hierarchy->getPatchLevel(ln)));
+            }
+        }
+    }
+  // extend boxes slightly to avoid problems with roundoff - for some reason
+  // the center node is not consistently assigned to patches
+  for (auto &vec : bboxes)
+    for (auto &bbox : vec)
+      bbox.extend(1e-6);
+  fdl::NodalPatchMap<dim, spacedim> nodal_patch_map(patches,
+                                                    bboxes,
+                                                    nodal_coordinates);
+  const fdl::NodalPatchMap<dim, spacedim> reference(patches,
+                                                    bboxes,
+                                                    vertex_coordinates);
+
+  out << "coincident nodes: "
+      << nodal_patch_map.has_coincident_nodes(nodal_coordinates) << std::endl;
+  out << "one point per vertex: "
+      << (nodal_patch_map.n_points() == tria.n_used_vertices()) << std::endl;
+
+  // Every node at a point should be a copy of the same vertex and the points
+  // of each patch should be the vertices of that patch:
+  bool same_vertices = true;
+  for (std::size_t point_n = 0; point_n < nodal_patch_map.n_points();
+       ++point_n)
+    for (const auto node_n : nodal_patch_map.get_point_nodes(point_n))
+      same_vertices =
+        same_vertices &&
+        node_vertices[node_n] ==
+          node_vertices[nodal_patch_map.get_point_nodes(point_n)[0]];
+  out << "same vertices: " << same_vertices << std::endl;
+
+  bool same_points = nodal_patch_map.size() == reference.size();
+  for (std::size_t i = 0; same_points && i < reference.size(); ++i)
+    {
+      const IndexSet &points = nodal_patch_map.get_point_indices(i);
+      same_points =
+        points.n_elements() * spacedim == reference[i].first.n_elements();
+      for (const auto point_n : points)
+        same_points =
+          same_points &&
+          reference[i].first.is_element(
+            node_vertices[nodal_patch_map.get_point_nodes(point_n)[0]] *
+            spacedim);
+    }
+  out << "same points: " << same_points << std::endl;
+
+  // Moving one copy of a vertex invalidates the table:
+  Vector<double> new_nodal_coordinates = nodal_coordinates;
+  new_nodal_coordinates[0] += 1e-3;
+  out << "coincident nodes after moving one node: "
+      << nodal_patch_map.has_coincident_nodes(new_nodal_coordinates)
+      << std::endl;
+
+  // Moving all nodes in the same way does not:
+  new_nodal_coordinates = nodal_coordinates;
+  new_nodal_coordinates.add(0.1);
+  out << "coincident nodes after moving all nodes: "
+      << nodal_patch_map.has_coincident_nodes(new_nodal_coordinates)
+      << std::endl;
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+  print_strings_on_0(out.str(), tbox::SAMRAI_MPI::getCommunicator(), output);
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "nodal_patch_map_03.log");
+
+  test<2>(app_initializer);
+}
@@ -0,0 +1,138 @@
+#include <fiddle/grid/box_utilities.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <BergerRigoutsos.h>
+#include <CartesianGridGeometry.h>
+#include <GriddingAlgorithm.h>
+#include <LoadBalancer.h>
+#include <StandardTagAndInitialize.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Test compute_nonoverlapping_patch_boxes() on a deep hierarchy with many
+// small patches by comparing it to the brute-force algorithm (removing every
+// finer box from every coarse patch). This is also a reasonable benchmark.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int spacedim>
+std::vector<std::vector<hier::Box<spacedim>>>
+brute_force_nonoverlapping_patch_boxes(
+  const tbox::Pointer<hier::PatchLevel<spacedim>> &coarse_level,
+  const tbox::Pointer<hier::PatchLevel<spacedim>> &fine_level)
+{
+  const hier::IntVector<spacedim> ratio = fine_level->getRatioToCoarserLevel();
+  hier::BoxList<spacedim>         finer_box_list;
+  for (int i = 0; i < fine_level->getNumberOfPatches(); ++i)
+    {
+      hier::Box<spacedim> patch_box = fine_level->getBoxForPatch(i);
+      patch_box.coarsen(ratio);
+      finer_box_list.addItem(patch_box);
+    }
+  finer_box_list.simplifyBoxes();
+
+  const auto rank = tbox::SAMRAI_MPI::getRank();
+  std::vector<std::vector<hier::Box<spacedim>>> result;
+  for (int i = 0; i < coarse_level->getNumberOfPatches(); ++i)
+    if (rank == coarse_level->getMappingForPatch(i))
+      {
+        hier::BoxList<spacedim> coarse_box_list;
+        coarse_box_list.addItem(coarse_level->getBoxForPatch(i));
+        coarse_box_list.removeIntersections(finer_box_list);
+
+        result.emplace_back();
+        typename tbox::List<hier::Box<spacedim>>::Iterator it(coarse_box_list);
+        while (it)
+          {
+            result.back().push_back(*it);
+            it++;
+          }
+      }
+  return result;
+}
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  std::ostringstream output;
+
+  // Set up basic SAMRAI stuff:
+  tbox::Pointer<geom::CartesianGridGeometry<NDIM>> grid_geometry =
+    new geom::CartesianGridGeometry<NDIM>("CartesianGeometry",
+                                          app_initializer->getComponentDatabase(
+                                            "CartesianGeometry"));
+  tbox::Pointer<hier::PatchHierarchy<NDIM>> patch_hierarchy =
+    new hier::PatchHierarchy<NDIM>("PatchHierarchy", grid_geometry);
+  tbox::Pointer<mesh::StandardTagAndInitialize<NDIM>> error_detector =
+    new mesh::StandardTagAndInitialize<NDIM>(
+      "StandardTagAndInitialize",
+      nullptr,
+      app_initializer->getComponentDatabase("StandardTagAndInitialize"));
+
+  tbox::Pointer<mesh::BergerRigoutsos<NDIM>> box_generator =
+    new mesh::BergerRigoutsos<NDIM>();
+  tbox::Pointer<mesh::LoadBalancer<NDIM>> load_balancer =
+    new mesh::LoadBalancer<NDIM>(
+      "LoadBalancer", app_initializer->getComponentDatabase("LoadBalancer"));
+  tbox::Pointer<mesh::GriddingAlgorithm<NDIM>> gridding_algorithm =
+    new mesh::GriddingAlgorithm<NDIM>("GriddingAlgorithm",
+                                      app_initializer->getComponentDatabase(
+                                        "GriddingAlgorithm"),
+                                      error_detector,
+                                      box_generator,
+                                      load_balancer);
+
+  // set up the SAMRAI grid:
+  gridding_algorithm->makeCoarsestLevel(patch_hierarchy, 0.0);
+  int level_number = 0;
+  while (gridding_algorithm->levelCanBeRefined(level_number))
+    {
+      gridding_algorithm->makeFinerLevel(patch_hierarchy, 0.0, 0.0, 1);
+      ++level_number;
+    }
+
+  const int finest_level = patch_hierarchy->getFinestLevelNumber();
+  const int rank         = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  output << "rank = " << rank << '\n'
+         << "several levels: " << (finest_level >= 3) << '\n';
+
+  // Do everything twice so that we also check the cached values
+  for (unsigned int i = 0; i < 2; ++i)
+    {
+      bool same_boxes = true;
+      for (int ln = 0; ln < finest_level; ++ln)
+        {
+          tbox::Pointer<hier::PatchLevel<spacedim>> coarse_level =
+            patch_hierarchy->getPatchLevel(ln);
+          tbox::Pointer<hier::PatchLevel<spacedim>> fine_level =
+            patch_hierarchy->getPatchLevel(ln + 1);
+          const auto boxes =
+            fdl::compute_nonoverlapping_patch_boxes(coarse_level, fine_level);
+          const auto expected_boxes =
+            brute_force_nonoverlapping_patch_boxes(coarse_level, fine_level);
+          same_boxes = same_boxes && boxes == expected_boxes;
+        }
+      output << "same boxes: " << same_boxes << '\n';
+    }
+
+  std::ofstream file_output;
+  if (rank == 0)
+    file_output.open("output");
+  print_strings_on_0(output.str(), MPI_COMM_WORLD, file_output);
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "multilevel_fe_01.log");
+
+  test<2>(app_initializer);
+}
@@ -0,0 +1,92 @@
+#include <fiddle/grid/intersection_predicate.h>
+#include <fiddle/grid/overlap_tria.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <fstream>
+#include <vector>
+
+// Test that reinitializing an overlap tria with the same predicate keeps the
+// current cells
+
+class LeftOf : public fdl::IntersectionPredicate<2>
+{
+public:
+  LeftOf(const double x)
+    : x(x)
+  {}
+
+  virtual bool
+  operator()(const dealii::Triangulation<2>::cell_iterator &cell) const override
+  {
+    return cell->bounding_box().lower_bound(0) < x;
+  }
+
+  const double x;
+};
+
+int
+main(int argc, char **argv)
+{
+  using namespace dealii;
+
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  const auto                       partitioner =
+    parallel::shared::Triangulation<2>::Settings::partition_zorder;
+  parallel::shared::Triangulation<2> shared_tria(MPI_COMM_WORLD,
+                                                 {},
+                                                 false,
+                                                 partitioner);
+
+  GridGenerator::hyper_ball(shared_tria);
+  shared_tria.refine_global(2);
+
+  fdl::OverlapTriangulation<2> overlap_tria(shared_tria, LeftOf(-0.5));
+
+  std::ofstream out("output");
+
+  const auto get_native_cell_ids = [&]()
+  {
+    std::vector<CellId> ids;
+    for (const auto &cell : overlap_tria.active_cell_iterators())
+      ids.push_back(overlap_tria.get_native_cell_id(cell));
+    return ids;
+  };
+  std::vector<unsigned int> user_indices;
+  for (const auto &cell : overlap_tria.active_cell_iterators())
+    user_indices.push_back(cell->user_index());
+  const std::vector<CellId> native_cell_ids = get_native_cell_ids();
+
+  // Reinitializing with the same predicate should not change anything
+  out << "changed: " << overlap_tria.reinit(shared_tria, LeftOf(-0.5)) << '\n';
+  std::vector<unsigned int> new_user_indices;
+  for (const auto &cell : overlap_tria.active_cell_iterators())
+    new_user_indices.push_back(cell->user_index());
+  out << "same user indices: " << (user_indices == new_user_indices) << '\n';
+  out << "same native cells: " << (native_cell_ids == get_native_cell_ids())
+      << '\n';
+
+  // but a different one should
+  out << "changed: " << overlap_tria.reinit(shared_tria, LeftOf(0.25)) << '\n';
+  const fdl::OverlapTriangulation<2> new_overlap_tria(shared_tria,
+                                                      LeftOf(0.25));
+  out << "same number of active cells: "
+      << (new_overlap_tria.n_active_cells() == overlap_tria.n_active_cells())
+      << '\n';
+  out << "more active cells: "
+      << (native_cell_ids.size() < overlap_tria.n_active_cells()) << '\n';
+
+  // We only store a level and index for each cell
+  out << "native cell bytes per cell: "
+      << overlap_tria.native_cell_memory_consumption() /
+           overlap_tria.n_cells()
+      << '\n';
+  out << "less than the Triangulation: "
+      << (2 * overlap_tria.native_cell_memory_consumption() <
+          overlap_tria.memory_consumption())
+      << '\n';
+}
@@ -0,0 +1,89 @@
+#include <fiddle/base/execution_policy.h>
+
+#include <fiddle/grid/intersection_predicate.h>
+#include <fiddle/grid/overlap_tria.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <fstream>
+#include <vector>
+
+// Test that overlap trias set up with threads are the same as serial ones on
+// both uniformly and locally refined native Triangulations
+
+class LeftOf : public fdl::IntersectionPredicate<2>
+{
+public:
+  LeftOf(const double x)
+    : x(x)
+  {}
+
+  virtual bool
+  operator()(const dealii::Triangulation<2>::cell_iterator &cell) const override
+  {
+    return cell->bounding_box().lower_bound(0) < x;
+  }
+
+  const double x;
+};
+
+int
+main(int argc, char **argv)
+{
+  using namespace dealii;
+
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MultithreadInfo::set_thread_limit(4);
+  const auto partitioner =
+    parallel::shared::Triangulation<2>::Settings::partition_zorder;
+  parallel::shared::Triangulation<2> shared_tria(MPI_COMM_WORLD,
+                                                 {},
+                                                 false,
+                                                 partitioner);
+
+  GridGenerator::hyper_ball(shared_tria);
+  shared_tria.refine_global(4);
+
+  std::ofstream out("output");
+
+  const auto get_native_cell_ids =
+    [&](const fdl::OverlapTriangulation<2> &overlap_tria)
+  {
+    std::vector<CellId> ids;
+    for (const auto &cell : overlap_tria.cell_iterators())
+      ids.push_back(overlap_tria.get_native_cell_id(cell));
+    return ids;
+  };
+
+  const auto check = [&]()
+  {
+    const fdl::OverlapTriangulation<2> serial_tria(shared_tria, LeftOf(-0.5));
+    const fdl::OverlapTriangulation<2> threaded_tria(
+      shared_tria, LeftOf(-0.5), fdl::ExecutionPolicy(4));
+    out << "number of levels: " << serial_tria.n_levels() << '\n'
+        << "same number of active cells: "
+        << (serial_tria.n_active_cells() == threaded_tria.n_active_cells())
+        << '\n'
+        << "same native cells: "
+        << (get_native_cell_ids(serial_tria) ==
+            get_native_cell_ids(threaded_tria))
+        << '\n'
+        << "same native cells as predicate: "
+        << threaded_tria.has_same_native_cells(LeftOf(-0.5)) << '\n';
+  };
+
+  // Uniformly refined, so no refinement is necessary
+  check();
+
+  // Locally refined
+  for (const auto &cell : shared_tria.active_cell_iterators())
+    if (cell->center()[1] > 0.0)
+      cell->set_refine_flag();
+  shared_tria.execute_coarsening_and_refinement();
+  check();
+}
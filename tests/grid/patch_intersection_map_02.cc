@@ -0,0 +1,179 @@
+#include <fiddle/base/samrai_utilities.h>
+
+#include <fiddle/grid/patch_intersection_map.h>
+
+#include <fiddle/interaction/interaction_utilities.h>
+
+#include <deal.II/base/numbers.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <BergerRigoutsos.h>
+#include <CartesianGridGeometry.h>
+#include <CartesianPatchGeometry.h>
+#include <CellData.h>
+#include <CellIterator.h>
+#include <GriddingAlgorithm.h>
+#include <LoadBalancer.h>
+#include <StandardTagAndInitialize.h>
+
+#include <cmath>
+#include <fstream>
+
+// Test PatchIntersectionMap with a circle and use it to interpolate and spread
+
+int
+main(int argc, char **argv)
+{
+  const auto     mpi_comm = MPI_COMM_WORLD;
+  IBTK::IBTKInit ibtk_init(argc, argv, mpi_comm);
+
+  std::ofstream output("output");
+
+  using namespace SAMRAI;
+
+  // Input file:
+  tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "logfile");
+  tbox::Pointer<tbox::Database> input_db = app_initializer->getInputDatabase();
+
+  // Set up basic SAMRAI stuff:
+  tbox::Pointer<geom::CartesianGridGeometry<2>> grid_geometry =
+    new geom::CartesianGridGeometry<2>("CartesianGeometry",
+                                       app_initializer->getComponentDatabase(
+                                         "CartesianGeometry"));
+  tbox::Pointer<hier::PatchHierarchy<2>> patch_hierarchy =
+    new hier::PatchHierarchy<2>("PatchHierarchy", grid_geometry);
+  tbox::Pointer<mesh::StandardTagAndInitialize<2>> error_detector =
+    new mesh::StandardTagAndInitialize<2>(
+      "StandardTagAndInitialize",
+      NULL,
+      app_initializer->getComponentDatabase("StandardTagAndInitialize"));
+
+  tbox::Pointer<mesh::BergerRigoutsos<2>> box_generator =
+    new mesh::BergerRigoutsos<2>();
+  tbox::Pointer<mesh::LoadBalancer<2>> load_balancer =
+    new mesh::LoadBalancer<2>(
+      "LoadBalancer", app_initializer->getComponentDatabase("LoadBalancer"));
+  tbox::Pointer<mesh::GriddingAlgorithm<2>> gridding_algorithm =
+    new mesh::GriddingAlgorithm<2>("GriddingAlgorithm",
+                                   app_initializer->getComponentDatabase(
+                                     "GriddingAlgorithm"),
+                                   error_detector,
+                                   box_generator,
+                                   load_balancer);
+
+  auto *var_db = hier::VariableDatabase<2>::getDatabase();
+  tbox::Pointer<hier::VariableContext> ctx = var_db->getContext("context");
+  tbox::Pointer<pdat::CellVariable<2, double>> u_cc_var =
+    new pdat::CellVariable<2, double>("u_cc");
+  const int u_cc_idx =
+    var_db->registerVariableAndContext(u_cc_var, ctx, hier::IntVector<2>(1));
+
+  gridding_algorithm->makeCoarsestLevel(patch_hierarchy, 0.0);
+  tbox::Pointer<hier::PatchLevel<2>> level = patch_hierarchy->getPatchLevel(0);
+  level->allocatePatchData(u_cc_idx, 0.0);
+  const auto patches = fdl::extract_patches(level);
+
+  // Set up deal.II and fiddle stuff
+  using namespace dealii;
+
+  Triangulation<1, 2> tria;
+  GridGenerator::hyper_sphere(tria, Point<2>(), 1.0);
+  tria.refine_global(4);
+
+  std::vector<BoundingBox<2>> cell_bboxes;
+  for (const auto &cell : tria.active_cell_iterators())
+    cell_bboxes.push_back(cell->bounding_box());
+
+  FE_Q<1, 2>       fe(1);
+  DoFHandler<1, 2> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+  MappingQ<1, 2> mapping(1);
+
+  fdl::PatchIntersectionMap<1, 2> intersection_map(
+    patches, cell_bboxes, dof_handler, mapping);
+
+  // Every intersection is on the polygon approximating the circle
+  bool        convex_ok = true, points_ok = true;
+  std::size_t n_intersections = 0;
+  for (std::size_t patch_n = 0; patch_n < intersection_map.size(); ++patch_n)
+    {
+      n_intersections += intersection_map.n_intersections(patch_n);
+      for (auto it = intersection_map.begin(patch_n);
+           it != intersection_map.end(patch_n);
+           ++it)
+        {
+          const double convex = it->get_cell_convex_coefficient();
+          convex_ok = convex_ok && 0.0 <= convex && convex < 1.0;
+          points_ok =
+            points_ok && std::abs(it->get_point().norm() - 1.0) < 1e-2;
+        }
+    }
+  output << "found intersections: " << (n_intersections > 0) << '\n'
+         << "convex coefficients in [0, 1): " << convex_ok << '\n'
+         << "points near the circle: " << points_ok << '\n';
+
+  // Interpolating one and summing the load vector approximates the perimeter
+  for (const auto &patch : patches)
+    {
+      tbox::Pointer<pdat::CellData<2, double>> data =
+        patch->getPatchData(u_cc_idx);
+      data->fillAll(1.0);
+    }
+  Vector<double> rhs(dof_handler.n_dofs());
+  fdl::compute_intersection_projection_rhs(u_cc_idx,
+                                           intersection_map,
+                                           dof_handler,
+                                           mapping,
+                                           dof_handler,
+                                           mapping,
+                                           rhs);
+  double rhs_total = 0.0;
+  for (const double value : rhs)
+    rhs_total += value;
+  output << "interpolated perimeter is accurate: "
+         << (std::abs(rhs_total - 2.0 * numbers::PI) < 0.05 * 2.0 * numbers::PI)
+         << '\n';
+
+  // Spreading one conserves the total
+  for (const auto &patch : patches)
+    {
+      tbox::Pointer<pdat::CellData<2, double>> data =
+        patch->getPatchData(u_cc_idx);
+      data->fillAll(0.0);
+    }
+  Vector<double> ones(dof_handler.n_dofs());
+  ones = 1.0;
+  fdl::compute_intersection_spread(u_cc_idx,
+                                   intersection_map,
+                                   dof_handler,
+                                   mapping,
+                                   dof_handler,
+                                   mapping,
+                                   ones);
+  double spread_total = 0.0;
+  for (const auto &patch : patches)
+    {
+      tbox::Pointer<pdat::CellData<2, double>> data =
+        patch->getPatchData(u_cc_idx);
+      const tbox::Pointer<geom::CartesianPatchGeometry<2>> pgeom =
+        patch->getPatchGeometry();
+      const double cell_volume = pgeom->getDx()[0] * pgeom->getDx()[1];
+      for (pdat::CellIterator<2> i(data->getGhostBox()); i; i++)
+        spread_total += (*data)(i(), 0) * cell_volume;
+    }
+  output << "spread total matches: "
+         << (std::abs(spread_total - rhs_total) < 1e-10 * rhs_total) << '\n';
+}
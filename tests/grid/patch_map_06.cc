@@ -0,0 +1,164 @@
+#include <fiddle/base/samrai_utilities.h>
+
+#include <fiddle/grid/box_utilities.h>
+#include <fiddle/grid/overlap_tria.h>
+#include <fiddle/grid/patch_map.h>
+
+#include <fiddle/transfer/overlap_partitioning_tools.h>
+#include <fiddle/transfer/scatter.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <BergerRigoutsos.h>
+#include <CartesianGridGeometry.h>
+#include <GriddingAlgorithm.h>
+#include <LoadBalancer.h>
+#include <StandardTagAndInitialize.h>
+
+#include <fstream>
+
+// Test that iterators over expanded cells match the default iterators
+
+int
+main(int argc, char **argv)
+{
+  const auto     mpi_comm = MPI_COMM_WORLD;
+  IBTK::IBTKInit ibtk_init(argc, argv, mpi_comm);
+
+  std::ofstream output("output");
+
+  // Use a patch hierarchy
+  {
+    using namespace SAMRAI;
+
+    // Input file:
+    tbox::Pointer<IBTK::AppInitializer> app_initializer =
+      new IBTK::AppInitializer(argc, argv, "logfile");
+    tbox::Pointer<tbox::Database> input_db =
+      app_initializer->getInputDatabase();
+
+    // Set up basic SAMRAI stuff:
+    tbox::Pointer<geom::CartesianGridGeometry<2>> grid_geometry =
+      new geom::CartesianGridGeometry<2>("CartesianGeometry",
+                                         app_initializer->getComponentDatabase(
+                                           "CartesianGeometry"));
+    tbox::Pointer<hier::PatchHierarchy<2>> patch_hierarchy =
+      new hier::PatchHierarchy<2>("PatchHierarchy", grid_geometry);
+    tbox::Pointer<mesh::StandardTagAndInitialize<2>> error_detector =
+      new mesh::StandardTagAndInitialize<2>(
+        "StandardTagAndInitialize",
+        NULL,
+        app_initializer->getComponentDatabase("StandardTagAndInitialize"));
+
+    tbox::Pointer<mesh::BergerRigoutsos<2>> box_generator =
+      new mesh::BergerRigoutsos<2>();
+    tbox::Pointer<mesh::LoadBalancer<2>> load_balancer =
+      new mesh::LoadBalancer<2>(
+        "LoadBalancer", app_initializer->getComponentDatabase("LoadBalancer"));
+    tbox::Pointer<mesh::GriddingAlgorithm<2>> gridding_algorithm =
+      new mesh::GriddingAlgorithm<2>("GriddingAlgorithm",
+                                     app_initializer->getComponentDatabase(
+                                       "GriddingAlgorithm"),
+                                     error_detector,
+                                     box_generator,
+                                     load_balancer);
+
+    // Set up a variable so that the patches have some data:
+    auto *var_db = hier::VariableDatabase<2>::getDatabase();
+    tbox::Pointer<hier::VariableContext> ctx = var_db->getContext("context");
+    tbox::Pointer<pdat::CellVariable<2, double>> u_cc_var =
+      new pdat::CellVariable<2, double>("u_cc");
+    const int u_cc_idx =
+      var_db->registerVariableAndContext(u_cc_var, ctx, hier::IntVector<2>(1));
+
+    gridding_algorithm->makeCoarsestLevel(patch_hierarchy, 0.0);
+    const int tag_buffer   = std::numeric_limits<int>::max();
+    int       level_number = 0;
+    while ((gridding_algorithm->levelCanBeRefined(level_number)))
+      {
+        gridding_algorithm->makeFinerLevel(patch_hierarchy,
+                                           0.0,
+                                           0.0,
+                                           tag_buffer);
+        ++level_number;
+      }
+    const int finest_level = patch_hierarchy->getFinestLevelNumber();
+    for (int ln = 0; ln <= finest_level; ++ln)
+      {
+        tbox::Pointer<hier::PatchLevel<NDIM>> level =
+          patch_hierarchy->getPatchLevel(ln);
+        level->allocatePatchData(u_cc_idx, 0.0);
+      }
+
+    const auto patches =
+      fdl::extract_patches(patch_hierarchy->getPatchLevel(finest_level));
+
+    // Set up deal.II and fiddle stuff
+    {
+      using namespace dealii;
+
+      Triangulation<2> tria;
+      GridGenerator::hyper_ball(tria);
+      tria.refine_global(2);
+
+      std::vector<BoundingBox<2>> cell_bboxes;
+      for (const auto &cell : tria.active_cell_iterators())
+        cell_bboxes.push_back(cell->bounding_box());
+
+      FE_Q<2>       fe(2);
+      DoFHandler<2> dof_handler(tria);
+      dof_handler.distribute_dofs(fe);
+
+      fdl::PatchMap<2> patch_map(patches, 1.0, tria, cell_bboxes, true);
+      fdl::PatchMap<2> expanded_patch_map(
+        patches, 1.0, tria, cell_bboxes, true);
+      expanded_patch_map.expand_cells();
+      output << "has expanded cells: " << patch_map.has_expanded_cells()
+             << ' ' << expanded_patch_map.has_expanded_cells() << '\n';
+
+      const auto check = [&]()
+      {
+        for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+          {
+            bool       same          = true;
+            auto       iter          = patch_map.begin(patch_n, dof_handler);
+            const auto end           = patch_map.end(patch_n, dof_handler);
+            auto       expanded_iter =
+              expanded_patch_map.begin(patch_n, dof_handler);
+            const auto expanded_end =
+              expanded_patch_map.end(patch_n, dof_handler);
+            for (; iter != end && expanded_iter != expanded_end;
+                 ++iter, ++expanded_iter)
+              same = same && *iter == *expanded_iter;
+            same = same && iter == end && expanded_iter == expanded_end &&
+                   *expanded_iter == dof_handler.end();
+
+            output << "patch " << patch_n << " expanded cells match: " << same
+                   << '\n';
+          }
+      };
+      check();
+
+      // Move the cells and check that the expanded cells are updated:
+      for (auto &bbox : cell_bboxes)
+        {
+          auto &points = bbox.get_boundary_points();
+          points.first[0] += 0.25;
+          points.second[0] += 0.25;
+        }
+      patch_map.update(patches, cell_bboxes);
+      expanded_patch_map.update(patches, cell_bboxes);
+      check();
+    }
+  }
+}
@@ -0,0 +1,99 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/grid/box_utilities.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <PatchLevel.h>
+
+#include <algorithm>
+#include <fstream>
+
+#include "../tests.h"
+
+// Partition a shared Triangulation with compute_patch_aligned_subdomain_ids()
+// and verify that each processor owns the cells on its patches.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  // setup SAMRAI stuff (its always the same):
+  auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+
+  const auto partitioner = parallel::shared::Triangulation<
+    dim,
+    spacedim>::Settings::partition_custom_signal;
+  parallel::shared::Triangulation<dim, spacedim> tria(mpi_comm,
+                                                      {},
+                                                      false,
+                                                      partitioner);
+  const auto partition = [&]()
+  {
+    const auto subdomain_ids =
+      fdl::compute_patch_aligned_subdomain_ids(tria, patch_hierarchy);
+    for (const auto &cell : tria.active_cell_iterators())
+      cell->set_subdomain_id(subdomain_ids[cell->active_cell_index()]);
+  };
+  tria.signals.create.connect(partition);
+  tria.signals.post_refinement.connect(partition);
+  GridGenerator::hyper_ball(tria, Point<spacedim>(), 1.5);
+  tria.refine_global(3);
+
+  // Every locally owned cell should be on a local patch:
+  std::vector<BoundingBox<spacedim>> local_patch_bboxes;
+  for (int ln = 0; ln <= patch_hierarchy->getFinestLevelNumber(); ++ln)
+    {
+      tbox::Pointer<hier::PatchLevel<spacedim>> level =
+        patch_hierarchy->getPatchLevel(ln);
+      for (int i = 0; i < level->getNumberOfPatches(); ++i)
+        if (level->getMappingForPatch(i) == int(rank))
+          local_patch_bboxes.push_back(
+            fdl::box_to_bbox(level->getBoxForPatch(i),
+                             patch_hierarchy->getPatchLevel(ln)));
+    }
+
+  bool on_local_patches = true;
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->is_locally_owned())
+      on_local_patches =
+        on_local_patches &&
+        std::any_of(local_patch_bboxes.begin(),
+                    local_patch_bboxes.end(),
+                    [&](const BoundingBox<spacedim> &bbox)
+                    { return bbox.point_inside(cell->center()); });
+
+  std::ostringstream out;
+  out << "Rank = " << rank << '\n'
+      << "locally owned cells on local patches: " << on_local_patches << '\n'
+      << "owns cells: " << (tria.n_locally_owned_active_cells() > 0) << '\n';
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+  print_strings_on_0(out.str(), mpi_comm, output);
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "multilevel_fe_01.log");
+
+  test<2>(app_initializer);
+}
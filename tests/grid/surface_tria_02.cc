@@ -0,0 +1,79 @@
+#include <fiddle/grid/surface_tria.h>
+
+#include <deal.II/base/numbers.h>
+
+#include <cmath>
+#include <fstream>
+
+// Test that PlanarTriangulationCache only calls Triangle when it needs to.
+
+int
+main()
+{
+  using namespace dealii;
+
+  std::ofstream output("output");
+
+  const auto make_points = [](const unsigned int n_points,
+                              const double       amplitude,
+                              const Tensor<1, 3> shift)
+  {
+    std::vector<Point<3>> points;
+    for (unsigned int i = 0; i < n_points; ++i)
+      {
+        const double theta = 2.0 * numbers::PI * i / double(n_points);
+        points.emplace_back(std::cos(theta),
+                            std::sin(theta),
+                            amplitude * std::sin(2.0 * theta));
+        points.back() += shift;
+      }
+    return points;
+  };
+
+  // Check that the boundary vertices are where they should be
+  const auto check_vertices = [&](const Triangulation<2, 3>   &tria,
+                                  const std::vector<Point<3>> &points)
+  {
+    bool same = tria.n_vertices() >= points.size();
+    for (std::size_t i = 0; same && i < points.size(); ++i)
+      same = same && (tria.get_vertices()[i] - points[i]).norm() < 1e-10;
+    return same;
+  };
+
+  fdl::Triangle::AdditionalData additional_data;
+  additional_data.target_element_area = 0.02;
+
+  fdl::PlanarTriangulationCache cache;
+  Triangulation<2, 3>           tria;
+
+  auto points = make_points(20, 0.1, Tensor<1, 3>());
+  output << "first call rebuilt: "
+         << cache.create_triangulation(points, tria, additional_data) << '\n'
+         << "boundary vertices match: " << check_vertices(tria, points)
+         << '\n';
+  const unsigned int n_cells = tria.n_active_cells();
+
+  // Translating and slightly deforming the points does not change the topology
+  points = make_points(20, 0.15, Tensor<1, 3>{{0.1, 0.2, 0.3}});
+  output << "moved points rebuilt: "
+         << cache.create_triangulation(points, tria, additional_data) << '\n'
+         << "same number of cells: " << (tria.n_active_cells() == n_cells)
+         << '\n'
+         << "boundary vertices match: " << check_vertices(tria, points)
+         << '\n';
+
+  // Either more points or different parameters require a new Triangulation
+  points = make_points(24, 0.1, Tensor<1, 3>());
+  output << "more points rebuilt: "
+         << cache.create_triangulation(points, tria, additional_data) << '\n'
+         << "boundary vertices match: " << check_vertices(tria, points)
+         << '\n';
+
+  additional_data.target_element_area = 0.01;
+  output << "new parameters rebuilt: "
+         << cache.create_triangulation(points, tria, additional_data) << '\n';
+
+  cache.clear();
+  output << "cleared cache rebuilt: "
+         << cache.create_triangulation(points, tria, additional_data) << '\n';
+}
@@ -0,0 +1,149 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/grid/box_utilities.h>
+#include <fiddle/grid/nodal_patch_map.h>
+#include <fiddle/grid/overlap_tria.h>
+
+#include <fiddle/interaction/interaction_utilities.h>
+
+#include <fiddle/transfer/overlap_partitioning_tools.h>
+#include <fiddle/transfer/scatter.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_out.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/sparse_direct.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <BergerRigoutsos.h>
+#include <CartesianGridGeometry.h>
+#include <GriddingAlgorithm.h>
+#include <HierarchyCellDataOpsReal.h>
+#include <HierarchySideDataOpsReal.h>
+#include <LoadBalancer.h>
+#include <StandardTagAndInitialize.h>
+
+#include <fstream>
+#include <random>
+
+#include "../tests.h"
+
+// Test that count_nodes() adds the weight of each node and returns the
+// unweighted number of nodes
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto input_db = app_initializer->getInputDatabase();
+  auto test_db  = input_db->getDatabase("test");
+
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::hyper_ball(native_tria);
+  // Even though we are periodic in both directions we don't ever need to
+  // actually enforce this in the finite element code as far as spreading goes
+  native_tria.refine_global(std::log2(input_db->getInteger("N") / 2));
+
+  // setup SAMRAI stuff (its always the same):
+  auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+  auto f_idx           = std::get<5>(tuple);
+
+  // setup Lagrangian data:
+  const std::size_t n_nodes = test_db->getIntegerWithDefault("n_nodes", 10);
+  Vector<double>    nodal_coordinates(n_nodes * spacedim);
+  std::mt19937      std_seq(42u);
+  std::uniform_real_distribution<double> distribution(0.3, 0.7);
+  for (double &coordinate : nodal_coordinates)
+    coordinate = distribution(std_seq);
+
+  // Now set up fiddle things for the test:
+  const auto patches = fdl::extract_patches(
+    patch_hierarchy->getPatchLevel(patch_hierarchy->getFinestLevelNumber()));
+  for (auto &patch : patches)
+    fdl::fill_all(patch->getPatchData(f_idx), 0.0);
+
+  const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> geometry =
+    patches.back()->getPatchGeometry();
+  Assert(geometry, fdl::ExcFDLNotImplemented());
+  const double *const                             patch_dx = geometry->getDx();
+  std::vector<std::vector<BoundingBox<spacedim>>> bboxes;
+  for (const auto &patch : patches)
+    {
+      bboxes.emplace_back();
+      bboxes.back().push_back(
+        fdl::box_to_bbox(patch->getBox(),
+                         patch_hierarchy->getPatchLevel(
+                           patch_hierarchy->getFinestLevelNumber())));
+      bboxes.back().back().extend(1.0 * patch_dx[0]);
+    }
+
+  fdl::NodalPatchMap<dim, spacedim> nodal_patch_map(patches,
+                                                    bboxes,
+                                                    nodal_coordinates);
+
+  const double weight    = test_db->getDoubleWithDefault("weight", 0.5);
+  const double n_counted = Utilities::MPI::sum(
+    fdl::count_nodes(f_idx, nodal_patch_map, nodal_coordinates, weight),
+    mpi_comm);
+
+  // Every node is in the interior of exactly one patch:
+  double weighted_total = 0.0;
+  for (auto &patch : patches)
+    {
+      tbox::Pointer<pdat::CellData<spacedim, double>> f_data =
+        patch->getPatchData(f_idx);
+      for (pdat::CellIterator<spacedim> i(patch->getBox()); i; i++)
+        weighted_total += (*f_data)(i());
+    }
+  weighted_total = Utilities::MPI::sum(weighted_total, mpi_comm);
+
+  std::ofstream output;
+  if (rank == 0)
+    {
+      output.open("output");
+      output << "number of nodes: " << n_nodes << '\n'
+             << "counted nodes: " << n_counted << '\n'
+             << "weighted total / weight: " << weighted_total / weight
+             << '\n';
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "count_nodes_02.log");
+
+  test<2>(app_initializer);
+}
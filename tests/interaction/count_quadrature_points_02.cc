@@ -0,0 +1,151 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/grid/box_utilities.h>
+#include <fiddle/grid/intersection_predicate_lib.h>
+#include <fiddle/grid/overlap_tria.h>
+#include <fiddle/grid/patch_map.h>
+
+#include <fiddle/interaction/interaction_utilities.h>
+
+#include <fiddle/transfer/overlap_partitioning_tools.h>
+#include <fiddle/transfer/scatter.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_out.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/sparse_direct.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <BergerRigoutsos.h>
+#include <CartesianGridGeometry.h>
+#include <GriddingAlgorithm.h>
+#include <HierarchyCellDataOpsReal.h>
+#include <HierarchySideDataOpsReal.h>
+#include <LoadBalancer.h>
+#include <StandardTagAndInitialize.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Test that estimate_quadrature_points() distributes all quadrature points
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int spacedim>
+double
+sum_interior(tbox::Pointer<hier::PatchHierarchy<spacedim>> patch_hierarchy,
+             const int                                     data_index)
+{
+  const int ln  = patch_hierarchy->getFinestLevelNumber();
+  double    sum = 0.0;
+  for (auto &patch : fdl::extract_patches(patch_hierarchy->getPatchLevel(ln)))
+    {
+      tbox::Pointer<pdat::CellData<spacedim, double>> data =
+        patch->getPatchData(data_index);
+      for (pdat::CellIterator<spacedim> i(patch->getBox()); i; i++)
+        sum += (*data)(i());
+    }
+  return Utilities::MPI::sum(sum, MPI_COMM_WORLD);
+}
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto input_db = app_initializer->getInputDatabase();
+
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::hyper_ball(native_tria);
+  native_tria.refine_global(std::log2(input_db->getInteger("N") / 2));
+
+  // setup SAMRAI stuff (its always the same):
+  auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+  auto f_idx           = std::get<5>(tuple);
+
+  // Now set up fiddle things for the test:
+  auto patches = fdl::extract_patches(
+    patch_hierarchy->getPatchLevel(patch_hierarchy->getFinestLevelNumber()));
+
+  const std::vector<BoundingBox<spacedim>> patch_bboxes =
+    fdl::compute_patch_bboxes(patches, 1.0);
+  fdl::TriaIntersectionPredicate<spacedim> tria_pred(patch_bboxes);
+  fdl::OverlapTriangulation<spacedim>      overlap_tria(native_tria, tria_pred);
+  std::vector<BoundingBox<spacedim, float>> cell_bboxes;
+  for (const auto &cell : overlap_tria.active_cell_iterators())
+    {
+      BoundingBox<spacedim, float> fbbox;
+      fbbox.get_boundary_points() = cell->bounding_box().get_boundary_points();
+      cell_bboxes.push_back(fbbox);
+    }
+  fdl::PatchMap<dim, spacedim> patch_map(patches,
+                                         1.0,
+                                         overlap_tria,
+                                         cell_bboxes);
+
+  const MappingQ<dim>                position_map(2);
+  const std::vector<Quadrature<dim>> quadratures({QGauss<dim>(3)});
+  const std::vector<unsigned char>   quadrature_indices(
+    overlap_tria.n_active_cells());
+
+  for (auto &patch : patches)
+    fdl::fill_all(patch->getPatchData(f_idx), 0.0);
+  fdl::count_quadrature_points(
+    f_idx, patch_map, position_map, quadrature_indices, quadratures);
+  const double exact_total = sum_interior(patch_hierarchy, f_idx);
+
+  for (auto &patch : patches)
+    fdl::fill_all(patch->getPatchData(f_idx), 0.0);
+  fdl::estimate_quadrature_points(
+    f_idx, patch_map, position_map, quadrature_indices, quadratures);
+  const double estimated_total = sum_interior(patch_hierarchy, f_idx);
+
+  if (rank == 0)
+    {
+      std::ofstream output("output");
+      output << "number of quadrature points: "
+             << native_tria.n_active_cells() * quadratures[0].size() << '\n'
+             << "exact total: " << exact_total << '\n'
+             << "estimated total matches: "
+             << (std::abs(estimated_total - exact_total) < 1e-8 * exact_total)
+             << '\n';
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "count_quadrature_points_02.log");
+
+  test<2>(app_initializer);
+}
@@ -0,0 +1,112 @@
+#include <fiddle/interaction/dlm_method.h>
+
+#include <deal.II/base/function_lib.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <fstream>
+
+// Test that DLMMethodBase only computes each position once per version and
+// that DLMForce reuses its reference position.
+
+using namespace dealii;
+
+// Simple DLM class: a structure moving with velocity (offset, offset).
+template <int dim, int spacedim = dim>
+class DLMMethod : public fdl::DLMMethodBase<dim, spacedim>
+{
+public:
+  DLMMethod(const LinearAlgebra::distributed::Vector<double> &position)
+    : reference_position(position)
+  {}
+
+  virtual void
+  get_mechanics_position(
+    const double                                time,
+    LinearAlgebra::distributed::Vector<double> &position) const override
+  {
+    ++n_evaluations;
+    position = reference_position;
+    for (std::size_t i = 0; i < position.locally_owned_size(); ++i)
+      position.local_element(i) += offset * time;
+  }
+
+  virtual const LinearAlgebra::distributed::Vector<double> &
+  get_current_mechanics_position() const override
+  {
+    return reference_position;
+  }
+
+  void
+  set_offset(const double new_offset)
+  {
+    offset = new_offset;
+    this->invalidate_mechanics_position_cache();
+  }
+
+  mutable unsigned int n_evaluations = 0;
+
+protected:
+  double offset = 1.0;
+
+  LinearAlgebra::distributed::Vector<double> reference_position;
+};
+
+int
+main()
+{
+  Triangulation<2> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(1);
+  FESystem<2>   fe(FE_Q<2>(1), 2);
+  DoFHandler<2> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  const MPI_Comm comm = MPI_COMM_WORLD;
+
+  LinearAlgebra::distributed::Vector<double> reference(
+    dof_handler.locally_owned_dofs(), comm);
+  VectorTools::interpolate(dof_handler,
+                           Functions::IdentityFunction<2>(),
+                           reference);
+  DLMMethod<2> dlm_method(reference);
+
+  std::ofstream output("output");
+  output << "version = " << dlm_method.get_mechanics_position_version()
+         << std::endl;
+  for (const double time : {0.0, 0.5, 0.0, 1.0, 0.5, 0.5})
+    {
+      const auto &position = dlm_method.get_cached_mechanics_position(time);
+      output << "t = " << time << " position[0] = " << position[0]
+             << " evaluations = " << dlm_method.n_evaluations << std::endl;
+    }
+
+  // Several forces at the same time should only need one evaluation
+  QMidpoint<2>     quadrature;
+  fdl::DLMForce<2> dlm_force_1(quadrature, 1.0, dof_handler, dlm_method);
+  fdl::DLMForce<2> dlm_force_2(quadrature, 2.0, dof_handler, dlm_method);
+  dlm_method.set_offset(2.0);
+  output << "version = " << dlm_method.get_mechanics_position_version()
+         << std::endl;
+  for (unsigned int i = 0; i < 2; ++i)
+    {
+      dlm_force_1.setup_force(0.5, reference, reference);
+      dlm_force_2.setup_force(0.5, reference, reference);
+      const auto *force_values = dlm_force_2.get_volume_force_dof_values();
+      output << "t = 0.5 force[0] = " << (*force_values)[0]
+             << " evaluations = " << dlm_method.n_evaluations << std::endl;
+      dlm_force_1.finish_force(0.5);
+      dlm_force_2.finish_force(0.5);
+    }
+}
@@ -0,0 +1,216 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/grid/box_utilities.h>
+#include <fiddle/grid/grid_utilities.h>
+
+#include <fiddle/interaction/elemental_interaction.h>
+
+#include <deal.II/base/function_lib.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+#include <string>
+
+#include "../tests.h"
+
+// Test that interpolating with a position whose version is set (see
+// InteractionBase::set_position_version()) reuses the cached overlap position
+// until the version changes and gives the same results as scattering it.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto          input_db       = app_initializer->getInputDatabase();
+  const int     n_F_components = get_n_f_components(input_db);
+  constexpr int fe_degree      = 1;
+
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::concentric_hyper_shells(
+    native_tria, Point<spacedim>(), 0.125, 0.25, 2, 0.0);
+  native_tria.refine_global(4);
+
+  FESystem<dim> F_fe(FE_Q<dim>(fe_degree), n_F_components);
+  FESystem<dim> position_fe(FE_Q<dim>(fe_degree), dim);
+
+  DoFHandler<dim> position_dof_handler(native_tria);
+  position_dof_handler.distribute_dofs(position_fe);
+  DoFHandler<dim> F_dof_handler(native_tria);
+  F_dof_handler.distribute_dofs(F_fe);
+  IndexSet locally_relevant_position_dofs;
+  DoFTools::extract_locally_relevant_dofs(position_dof_handler,
+                                          locally_relevant_position_dofs);
+  IndexSet locally_relevant_F_dofs;
+  DoFTools::extract_locally_relevant_dofs(F_dof_handler,
+                                          locally_relevant_F_dofs);
+
+  auto position_partitioner = std::make_shared<Utilities::MPI::Partitioner>(
+    position_dof_handler.locally_owned_dofs(),
+    locally_relevant_position_dofs,
+    native_tria.get_communicator());
+  auto F_partitioner = std::make_shared<Utilities::MPI::Partitioner>(
+    F_dof_handler.locally_owned_dofs(),
+    locally_relevant_F_dofs,
+    native_tria.get_communicator());
+
+  MappingQ1<dim> F_mapping;
+
+  const double shift = 0.01;
+  LinearAlgebra::distributed::Vector<double> position(position_partitioner);
+  VectorTools::interpolate(position_dof_handler,
+                           Functions::IdentityFunction<dim>(),
+                           position);
+
+  // setup SAMRAI stuff (its always the same):
+  auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+  auto f_idx           = std::get<5>(tuple);
+
+  // Now set up fiddle things for the test. The position is shifted later so
+  // enlarge the bounding boxes:
+  std::vector<BoundingBox<spacedim, float>> bboxes;
+  for (const auto &cell : native_tria.active_cell_iterators())
+    if (cell->is_locally_owned())
+      {
+        const auto             bbox = cell->bounding_box();
+        Point<spacedim, float> p0, p1;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          {
+            p0[d] = bbox.get_boundary_points().first[d];
+            p1[d] = bbox.get_boundary_points().second[d] + shift;
+          }
+        bboxes.emplace_back(std::make_pair(p0, p1));
+      }
+  const auto all_bboxes =
+    fdl::collect_all_active_cell_bboxes(native_tria, bboxes);
+  const auto local_edge_lengths =
+    fdl::compute_longest_edge_lengths(native_tria, F_mapping, QGauss<1>(2));
+  const auto all_edge_lengths =
+    fdl::collect_longest_edge_lengths(native_tria, local_edge_lengths);
+
+  fdl::ElementalInteraction<dim, spacedim> interaction(
+    input_db,
+    native_tria,
+    all_bboxes,
+    all_edge_lengths,
+    patch_hierarchy,
+    std::make_pair(patch_hierarchy->getFinestLevelNumber(),
+                   patch_hierarchy->getFinestLevelNumber()),
+    fe_degree + 1,
+    1.0,
+    fdl::DensityKind::Minimum);
+  interaction.add_dof_handler(position_dof_handler);
+  interaction.add_dof_handler(F_dof_handler);
+
+  // Interpolate and return the number of scatters started by the
+  // transaction.
+  auto interpolate =
+    [&](const LinearAlgebra::distributed::Vector<double> &native_position,
+        LinearAlgebra::distributed::Vector<double>       &rhs)
+  {
+    rhs = 0.0;
+    interaction.reset_scatter_statistics();
+    auto transaction =
+      interaction.compute_projection_rhs_scatter_start("BSPLINE_3",
+                                                       f_idx,
+                                                       position_dof_handler,
+                                                       native_position,
+                                                       F_dof_handler,
+                                                       F_mapping,
+                                                       rhs);
+    transaction =
+      interaction.compute_projection_rhs_scatter_finish(std::move(transaction));
+    transaction =
+      interaction.compute_projection_rhs_intermediate(std::move(transaction));
+    transaction = interaction.compute_projection_rhs_accumulate_start(
+      std::move(transaction));
+    interaction.compute_projection_rhs_accumulate_finish(
+      std::move(transaction));
+    return interaction.get_scatter_statistics().n_scatters;
+  };
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+  auto check = [&](const std::string                                &label,
+                   const LinearAlgebra::distributed::Vector<double> &rhs,
+                   const LinearAlgebra::distributed::Vector<double> &expected)
+  {
+    LinearAlgebra::distributed::Vector<double> difference(rhs);
+    difference -= expected;
+    const double norm  = expected.l2_norm();
+    const double error = difference.l2_norm();
+    if (rank == 0)
+      output << label << " nonzero: " << (norm > 0.0)
+             << " matches: " << (error < 1e-14 * norm) << std::endl;
+  };
+
+  // Copies of the position are never cached since they have no version
+  LinearAlgebra::distributed::Vector<double> expected_rhs(F_partitioner);
+  LinearAlgebra::distributed::Vector<double> rhs(F_partitioner);
+  interaction.set_position_version(position, 1);
+  unsigned long n_scatters = interpolate(position, rhs);
+  if (rank == 0)
+    output << "scatters without cache: " << n_scatters << std::endl;
+  n_scatters = interpolate(position, rhs);
+  if (rank == 0)
+    output << "scatters with cache: " << n_scatters << std::endl;
+  interpolate(LinearAlgebra::distributed::Vector<double>(position),
+              expected_rhs);
+  check("cached", rhs, expected_rhs);
+
+  // Changing the version invalidates the cache
+  LinearAlgebra::distributed::Vector<double> displacement(
+    position_partitioner);
+  VectorTools::interpolate(position_dof_handler,
+                           Functions::ConstantFunction<dim>(shift, dim),
+                           displacement);
+  position += displacement;
+  interaction.set_position_version(position, 2);
+  n_scatters = interpolate(position, rhs);
+  if (rank == 0)
+    output << "scatters after update: " << n_scatters << std::endl;
+  interpolate(LinearAlgebra::distributed::Vector<double>(position),
+              expected_rhs);
+  check("updated", rhs, expected_rhs);
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "multilevel_fe_01.log");
+
+  test<NDIM>(app_initializer);
+}
@@ -0,0 +1,65 @@
+#include <fiddle/interaction/ib_kernels.h>
+
+#include <deal.II/base/point.h>
+
+#include <fstream>
+#include <iomanip>
+#include <vector>
+
+// Test fiddle's native IB kernels: check the stencils and verify that the
+// weights sum to one.
+
+using namespace dealii;
+
+template <typename Kernel>
+void
+test(const std::string &kernel_name, std::ofstream &out)
+{
+  out << "kernel: " << kernel_name << '\n';
+
+  // Use more points than the width of a VectorizedArray to check the
+  // remainder logic
+  std::vector<Point<2>> points;
+  for (unsigned int i = 0; i < 11; ++i)
+    points.emplace_back(1.0 + 0.125 * i, 2.0 - 0.0625 * i);
+
+  const std::array<double, 2>     x_lower{{0.0, 0.5}};
+  const std::array<double, 2>     dx{{0.5, 0.25}};
+  const std::array<int, 2>        i_lower{{4, -2}};
+  std::vector<std::array<int, 2>> stencil_lower;
+  std::vector<double>             weights;
+  fdl::compute_kernel_weights<Kernel, 2>(
+    make_array_view(points), x_lower, dx, i_lower, stencil_lower, weights);
+
+  for (unsigned int p = 0; p < points.size(); ++p)
+    {
+      out << "point: " << points[p] << " stencil lower: ("
+          << stencil_lower[p][0] << ", " << stencil_lower[p][1] << ")";
+      for (unsigned int d = 0; d < 2; ++d)
+        {
+          double sum = 0.0;
+          for (int k = 0; k < Kernel::width; ++k)
+            sum += weights[(p * 2 + d) * Kernel::width + k];
+          out << " sum[" << d << "]: " << sum;
+        }
+      out << '\n';
+    }
+}
+
+int
+main()
+{
+  std::ofstream out("output");
+  out << std::setprecision(12);
+  if (fdl::to_ib_kernel("PIECEWISE_LINEAR") ==
+      fdl::IBKernel::PiecewiseLinear)
+    test<fdl::PiecewiseLinearKernel>("PIECEWISE_LINEAR", out);
+  if (fdl::to_ib_kernel("IB_3") == fdl::IBKernel::IB3)
+    test<fdl::IB3Kernel>("IB_3", out);
+  if (fdl::to_ib_kernel("IB_4") == fdl::IBKernel::IB4)
+    test<fdl::IB4Kernel>("IB_4", out);
+  if (fdl::to_ib_kernel("BSPLINE_3") == fdl::IBKernel::BSpline3)
+    test<fdl::BSpline3Kernel>("BSPLINE_3", out);
+  if (fdl::to_ib_kernel("IB_6") == fdl::IBKernel::Other)
+    out << "IB_6 is not implemented natively\n";
+}
@@ -540,4 +540,6 @@ main(int argc, char **argv)
 
   tbox::TimerManager::createManager(nullptr);
   test<NDIM>(app_initializer);
+
+  write_phase_timings(argc, argv, MPI_COMM_WORLD);
 }
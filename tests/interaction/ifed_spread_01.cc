@@ -58,8 +58,13 @@ public:
   {}
 
   virtual void
-  computeLagrangianForce(const double /*time*/) override
+  computeLagrangianForce(const double time) override
   {
+    // Like IFEDMethod::computeLagrangianForce(), start scattering the
+    // positions for spreading first
+    if (this->input_db->getBoolWithDefault("prefetch_spread_positions", false))
+      this->start_spread_position_scatters(time);
+
     // everything else is at the current time so just roll with that
     const auto                                &part = this->parts[0];
     LinearAlgebra::distributed::Vector<double> current_force(
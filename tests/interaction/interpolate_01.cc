@@ -12,6 +12,7 @@
 
 #include <deal.II/base/function_parser.h>
 #include <deal.II/base/mpi.h>
+#include <deal.II/base/multithread_info.h>
 #include <deal.II/base/quadrature_lib.h>
 
 #include <deal.II/dofs/dof_handler.h>
@@ -131,6 +132,10 @@ test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
   const MappingQ<dim, spacedim> F_map(1);
   Vector<double>                F_rhs(F_dof_handler.n_dofs());
 
+  // Threaded interpolation should give exactly the same result as serial
+  // interpolation
+  const int n_threads = input_db->getIntegerWithDefault("n_threads", 1);
+  MultithreadInfo::set_thread_limit(n_threads);
   compute_projection_rhs("BSPLINE_3",
                          f_idx,
                          patch_map,
@@ -139,7 +144,9 @@ test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
                          quadratures,
                          F_dof_handler,
                          F_map,
-                         F_rhs);
+                         F_rhs,
+                         nullptr,
+                         n_threads);
 
   Vector<double> F_solution = F_rhs;
   // Do the projection locally (this is just a test)
@@ -0,0 +1,152 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/grid/box_utilities.h>
+#include <fiddle/grid/intersection_predicate_lib.h>
+#include <fiddle/grid/overlap_tria.h>
+#include <fiddle/grid/patch_map.h>
+
+#include <fiddle/interaction/interaction_utilities.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Test that interpolating several fields at once gives exactly the same result
+// as interpolating them one at a time
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto input_db = app_initializer->getInputDatabase();
+
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::concentric_hyper_shells(
+    native_tria, Point<spacedim>(), 0.125, 0.25, 2, 0.0);
+  native_tria.refine_global(4);
+
+  // setup SAMRAI stuff (its always the same):
+  auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+  auto f_idx           = std::get<5>(tuple);
+
+  // Now set up fiddle things for the test:
+  const auto patches = fdl::extract_patches(
+    patch_hierarchy->getPatchLevel(patch_hierarchy->getFinestLevelNumber()));
+  const std::vector<BoundingBox<spacedim>> patch_bboxes =
+    fdl::compute_patch_bboxes(patches, 1.0);
+  fdl::TriaIntersectionPredicate<spacedim> tria_pred(patch_bboxes);
+  fdl::OverlapTriangulation<spacedim>      overlap_tria(native_tria, tria_pred);
+  std::vector<BoundingBox<spacedim, float>> cell_bboxes;
+  for (const auto &cell : overlap_tria.active_cell_iterators())
+    {
+      BoundingBox<spacedim, float> fbbox;
+      fbbox.get_boundary_points() = cell->bounding_box().get_boundary_points();
+      cell_bboxes.push_back(fbbox);
+    }
+  fdl::PatchMap<dim, spacedim> patch_map(patches,
+                                         1.0,
+                                         overlap_tria,
+                                         cell_bboxes);
+
+  const MappingQ<dim>                position_map(1);
+  const std::vector<Quadrature<dim>> quadratures({QGauss<dim>(3)});
+  const std::vector<unsigned char>   quadrature_indices(
+    overlap_tria.n_active_cells());
+
+  // Interpolate the same Eulerian field onto two different finite element
+  // spaces
+  const int           n_F_components = get_n_f_components(input_db);
+  FESystem<dim>       fe_1(FE_Q<dim>(1), n_F_components);
+  FESystem<dim>       fe_2(FE_Q<dim>(2), n_F_components);
+  DoFHandler<dim>     dof_handler_1(overlap_tria);
+  DoFHandler<dim>     dof_handler_2(overlap_tria);
+  const MappingQ<dim> F_map(1);
+  dof_handler_1.distribute_dofs(fe_1);
+  dof_handler_2.distribute_dofs(fe_2);
+
+  Vector<double> rhs_1(dof_handler_1.n_dofs());
+  Vector<double> rhs_2(dof_handler_2.n_dofs());
+  fdl::compute_projection_rhs("BSPLINE_3",
+                              f_idx,
+                              patch_map,
+                              position_map,
+                              quadrature_indices,
+                              quadratures,
+                              dof_handler_1,
+                              F_map,
+                              rhs_1);
+  fdl::compute_projection_rhs("BSPLINE_3",
+                              f_idx,
+                              patch_map,
+                              position_map,
+                              quadrature_indices,
+                              quadratures,
+                              dof_handler_2,
+                              F_map,
+                              rhs_2);
+
+  Vector<double> fused_rhs_1(dof_handler_1.n_dofs());
+  Vector<double> fused_rhs_2(dof_handler_2.n_dofs());
+  fdl::compute_projection_rhs<dim, spacedim>("BSPLINE_3",
+                                             {f_idx, f_idx},
+                                             patch_map,
+                                             position_map,
+                                             quadrature_indices,
+                                             quadratures,
+                                             {&dof_handler_1, &dof_handler_2},
+                                             {&F_map, &F_map},
+                                             {&fused_rhs_1, &fused_rhs_2});
+
+  fused_rhs_1 -= rhs_1;
+  fused_rhs_2 -= rhs_2;
+  const double difference_1 =
+    Utilities::MPI::max(fused_rhs_1.linfty_norm(), mpi_comm);
+  const double difference_2 =
+    Utilities::MPI::max(fused_rhs_2.linfty_norm(), mpi_comm);
+  if (rank == 0)
+    {
+      std::ofstream output("output");
+      output << "field 1 difference = " << difference_1 << '\n'
+             << "field 2 difference = " << difference_2 << '\n';
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "multilevel_fe_01.log");
+
+  test<2>(app_initializer);
+}
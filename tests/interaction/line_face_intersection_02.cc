@@ -0,0 +1,110 @@
+#include <fiddle/interaction/interaction_utilities.h>
+
+#include <deal.II/base/array_view.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_nothing.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <cmath>
+#include <fstream>
+
+using namespace dealii;
+using namespace SAMRAI;
+
+// Test that the batched line face intersection code matches the single-line
+// version
+
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto                input_db = app_initializer->getInputDatabase();
+  auto                test_db  = input_db->getDatabase("test");
+  Triangulation<2, 3> tria;
+  GridGenerator::hyper_sphere(tria,
+                              Point<3>(),
+                              test_db->getDoubleWithDefault("sphere_radius",
+                                                            1.0));
+  tria.refine_global(3);
+  const double       stencil_width = test_db->getDouble("stencil_width");
+  const unsigned int stencil_axis  = test_db->getInteger("stencil_axis");
+  const int          n_starts_1d   = test_db->getInteger("n_starts_1d");
+
+  // Put the stencil starts on an irregularly spaced grid in the plane
+  // orthogonal to the stencil axis. Use an odd number of starts so that the
+  // number of starts is not a multiple of the SIMD width.
+  std::array<std::vector<double>, 3> starts;
+  for (int i = 0; i < n_starts_1d; ++i)
+    for (int j = 0; j < n_starts_1d; ++j)
+      {
+        Point<3> start;
+        start[(stencil_axis + 1) % 3] =
+          -1.2 + 2.4 * (i + 0.1 * std::sin(3.0 * j)) / n_starts_1d;
+        start[(stencil_axis + 2) % 3] =
+          -1.2 + 2.4 * (j + 0.1 * std::cos(2.0 * i)) / n_starts_1d;
+        start[stencil_axis] = 0.1 * std::sin(double(i + j));
+        for (unsigned int d = 0; d < 3; ++d)
+          starts[d].push_back(start[d]);
+      }
+  const std::array<ArrayView<const double>, 3> start_views{
+    {make_array_view(starts[0]),
+     make_array_view(starts[1]),
+     make_array_view(starts[2])}};
+
+  const MappingQ<2, 3> mapping(1);
+  FE_Nothing<2, 3>     fe;
+  DoFHandler<2, 3>     dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+  std::vector<unsigned char> hits;
+  std::vector<double>        convex_coefs;
+  std::size_t                n_hits         = 0;
+  bool                       hits_match     = true;
+  double                     max_coef_error = 0.0;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      const std::array<Point<3>, 3> simplex{
+        {mapping.transform_unit_to_real_cell(cell, Point<2>(0, 0)),
+         mapping.transform_unit_to_real_cell(cell, Point<2>(0, 1)),
+         mapping.transform_unit_to_real_cell(cell, Point<2>(1, 0))}};
+      fdl::intersect_stencils_with_simplex<2>(
+        simplex, start_views, stencil_width, stencil_axis, hits, convex_coefs);
+      for (std::size_t i = 0; i < starts[0].size(); ++i)
+        {
+          const Point<3> start(starts[0][i], starts[1][i], starts[2][i]);
+          const std::optional<double> convex_coef =
+            fdl::intersect_stencil_with_simplex<2>(simplex,
+                                                   start,
+                                                   stencil_width,
+                                                   stencil_axis);
+          hits_match = hits_match && (bool(convex_coef) == bool(hits[i]));
+          if (convex_coef && hits[i])
+            {
+              ++n_hits;
+              max_coef_error =
+                std::max(max_coef_error,
+                         std::abs(*convex_coef - convex_coefs[i]));
+            }
+        }
+    }
+
+  std::ofstream output("output");
+  output << "found intersections: " << (n_hits > 0) << '\n'
+         << "hits match: " << hits_match << '\n'
+         << "coefficients match: " << (max_coef_error < 1e-12) << '\n';
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "line_face_intersection_02.log");
+  test(app_initializer);
+}
@@ -12,6 +12,7 @@
 
 #include <deal.II/base/function_parser.h>
 #include <deal.II/base/mpi.h>
+#include <deal.II/base/multithread_info.h>
 #include <deal.II/base/quadrature_lib.h>
 
 #include <deal.II/dofs/dof_handler.h>
@@ -142,6 +143,10 @@ test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
   Vector<double> F(F_dof_handler.n_dofs());
   VectorTools::interpolate(F_map, F_dof_handler, fp, F);
 
+  // Threaded spreading should give exactly the same result as serial
+  // spreading
+  const int n_threads = input_db->getIntegerWithDefault("n_threads", 1);
+  MultithreadInfo::set_thread_limit(n_threads);
   fdl::compute_spread("BSPLINE_3",
                       f_idx,
                       patch_map,
@@ -150,7 +155,9 @@ test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
                       quadratures,
                       F_dof_handler,
                       F_map,
-                      F);
+                      F,
+                      nullptr,
+                      n_threads);
 
   // TODO - we need to accumulate data spread into ghost regions next
   SAMRAI::tbox::Pointer<SAMRAI::hier::Variable<spacedim>> f_var;
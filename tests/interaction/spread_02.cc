@@ -0,0 +1,201 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/grid/box_utilities.h>
+#include <fiddle/grid/intersection_predicate_lib.h>
+#include <fiddle/grid/overlap_tria.h>
+#include <fiddle/grid/patch_map.h>
+
+#include <fiddle/interaction/interaction_utilities.h>
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Test that spreading with skip_zero_cells = true gives the same result as
+// spreading every cell
+
+using namespace SAMRAI;
+using namespace dealii;
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto input_db = app_initializer->getInputDatabase();
+
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::hyper_cube(native_tria);
+  native_tria.refine_global(std::log2(input_db->getInteger("N")));
+
+  auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+  auto f_idx           = std::get<5>(tuple);
+
+  SAMRAI::tbox::Pointer<SAMRAI::hier::Variable<spacedim>> f_var;
+  auto *var_db = hier::VariableDatabase<spacedim>::getDatabase();
+  var_db->mapIndexToVariable(f_idx, f_var);
+  const int skip_idx  = var_db->registerClonedPatchDataIndex(f_var, f_idx);
+  const int cache_idx = var_db->registerClonedPatchDataIndex(f_var, f_idx);
+  const int ln        = patch_hierarchy->getFinestLevelNumber();
+  patch_hierarchy->getPatchLevel(ln)->allocatePatchData(skip_idx, 0.0);
+  patch_hierarchy->getPatchLevel(ln)->allocatePatchData(cache_idx, 0.0);
+
+  auto patches = fdl::extract_patches(patch_hierarchy->getPatchLevel(ln));
+  for (auto &patch : patches)
+    {
+      fdl::fill_all(patch->getPatchData(f_idx), 0.0);
+      fdl::fill_all(patch->getPatchData(skip_idx), 0.0);
+      fdl::fill_all(patch->getPatchData(cache_idx), 0.0);
+    }
+
+  const std::vector<BoundingBox<spacedim>> patch_bboxes =
+    fdl::compute_patch_bboxes(patches, 1.0);
+  fdl::TriaIntersectionPredicate<spacedim> tria_pred(patch_bboxes);
+  fdl::OverlapTriangulation<spacedim>      overlap_tria(native_tria, tria_pred);
+  std::vector<BoundingBox<spacedim, float>> cell_bboxes;
+  for (const auto &cell : overlap_tria.active_cell_iterators())
+    {
+      BoundingBox<spacedim, float> fbbox;
+      fbbox.get_boundary_points() = cell->bounding_box().get_boundary_points();
+      cell_bboxes.push_back(fbbox);
+    }
+  fdl::PatchMap<dim, spacedim> patch_map(patches,
+                                         1.0,
+                                         overlap_tria,
+                                         cell_bboxes);
+
+  const MappingQ<dim>                position_map(1);
+  const std::vector<Quadrature<dim>> quadratures({QGauss<dim>(2)});
+  const std::vector<unsigned char>   quadrature_indices(
+    overlap_tria.n_active_cells());
+
+  const int n_F_components = get_n_f_components(input_db);
+  std::unique_ptr<FiniteElement<dim>> fe;
+  if (n_F_components == 1)
+    fe = std::make_unique<FE_Q<dim>>(1);
+  else
+    fe = std::make_unique<FESystem<dim>>(FE_Q<dim>(1), n_F_components);
+
+  DoFHandler<dim, spacedim> F_dof_handler(overlap_tria);
+  F_dof_handler.distribute_dofs(*fe);
+  const MappingQ<dim, spacedim> F_map(1);
+
+  // Set up a force which is only nonzero on the left half of the domain
+  Vector<double>                       F(F_dof_handler.n_dofs());
+  std::vector<types::global_dof_index> cell_dofs(fe->dofs_per_cell);
+  for (const auto &cell : F_dof_handler.active_cell_iterators())
+    if (cell->center()[0] < 0.5)
+      {
+        cell->get_dof_indices(cell_dofs);
+        for (const auto dof : cell_dofs)
+          F[dof] = 1.0 + cell->center()[1];
+      }
+
+  // Count the cells we expect to skip
+  std::size_t    n_zero_cells = 0;
+  Vector<double> cell_F(fe->dofs_per_cell);
+  for (std::size_t patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+    for (auto iter = patch_map.begin(patch_n, F_dof_handler);
+         iter != patch_map.end(patch_n, F_dof_handler);
+         ++iter)
+      {
+        (*iter)->get_dof_values(F, cell_F);
+        n_zero_cells += cell_F.linfty_norm() == 0.0;
+      }
+
+  const std::size_t n_unskipped = fdl::compute_spread("BSPLINE_3",
+                                                      f_idx,
+                                                      patch_map,
+                                                      position_map,
+                                                      quadrature_indices,
+                                                      quadratures,
+                                                      F_dof_handler,
+                                                      F_map,
+                                                      F);
+  const std::size_t n_skipped = fdl::compute_spread("BSPLINE_3",
+                                                    skip_idx,
+                                                    patch_map,
+                                                    position_map,
+                                                    quadrature_indices,
+                                                    quadratures,
+                                                    F_dof_handler,
+                                                    F_map,
+                                                    F,
+                                                    nullptr,
+                                                    {},
+                                                    false,
+                                                    nullptr,
+                                                    true);
+  // With cached kernel weights zero cells are still spread
+  fdl::KernelWeightCache<spacedim> kernel_weight_cache;
+  kernel_weight_cache.reinit("BSPLINE_3", 0, patch_map.size());
+  const std::size_t n_cached_skipped = fdl::compute_spread("BSPLINE_3",
+                                                           cache_idx,
+                                                           patch_map,
+                                                           position_map,
+                                                           quadrature_indices,
+                                                           quadratures,
+                                                           F_dof_handler,
+                                                           F_map,
+                                                           F,
+                                                           &kernel_weight_cache,
+                                                           {},
+                                                           false,
+                                                           nullptr,
+                                                           true);
+
+  auto ops = fdl::extract_hierarchy_data_ops(f_var, patch_hierarchy);
+  ops->resetLevels(ln, ln);
+  ops->subtract(skip_idx, skip_idx, f_idx);
+  ops->subtract(cache_idx, cache_idx, f_idx);
+  const double skip_error  = ops->maxNorm(skip_idx);
+  const double cache_error = ops->maxNorm(cache_idx);
+  const double f_norm      = ops->maxNorm(f_idx);
+  if (rank == 0)
+    {
+      std::ofstream output("output");
+      output << "skipped cells without skipping: " << n_unskipped << '\n';
+      output << "skipped all zero cells: "
+             << (n_skipped == n_zero_cells && n_zero_cells > 0) << '\n';
+      output << "skipped all zero cells with cached weights: "
+             << (n_cached_skipped == n_zero_cells) << '\n';
+      output << "spread force is nonzero: " << (f_norm > 0.0) << '\n';
+      output << "max difference = " << skip_error << '\n';
+      output << "max difference with cached weights = " << cache_error
+             << '\n';
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "multilevel_fe_01.log");
+
+  test<2>(app_initializer);
+}
@@ -0,0 +1,222 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/grid/box_utilities.h>
+#include <fiddle/grid/grid_utilities.h>
+
+#include <fiddle/interaction/elemental_interaction.h>
+#include <fiddle/interaction/transaction_scheduler.h>
+
+#include <deal.II/base/function_lib.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+#include <memory>
+
+#include "../tests.h"
+
+// Test that computing the projection right-hand sides of several parts with
+// concurrent transactions run by a TransactionScheduler gives the same results
+// as computing them one at a time.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto          input_db       = app_initializer->getInputDatabase();
+  const int     n_F_components = get_n_f_components(input_db);
+  constexpr int fe_degree      = 1;
+
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::concentric_hyper_shells(
+    native_tria, Point<spacedim>(), 0.125, 0.25, 2, 0.0);
+  native_tria.refine_global(4);
+
+  FESystem<dim> F_fe(FE_Q<dim>(fe_degree), n_F_components);
+  FESystem<dim> position_fe(FE_Q<dim>(fe_degree), dim);
+
+  DoFHandler<dim> position_dof_handler(native_tria);
+  position_dof_handler.distribute_dofs(position_fe);
+  DoFHandler<dim> F_dof_handler(native_tria);
+  F_dof_handler.distribute_dofs(F_fe);
+  IndexSet locally_relevant_position_dofs;
+  DoFTools::extract_locally_relevant_dofs(position_dof_handler,
+                                          locally_relevant_position_dofs);
+  IndexSet locally_relevant_F_dofs;
+  DoFTools::extract_locally_relevant_dofs(F_dof_handler,
+                                          locally_relevant_F_dofs);
+
+  auto position_partitioner = std::make_shared<Utilities::MPI::Partitioner>(
+    position_dof_handler.locally_owned_dofs(),
+    locally_relevant_position_dofs,
+    native_tria.get_communicator());
+  auto F_partitioner = std::make_shared<Utilities::MPI::Partitioner>(
+    F_dof_handler.locally_owned_dofs(),
+    locally_relevant_F_dofs,
+    native_tria.get_communicator());
+
+  MappingQ1<dim> F_mapping;
+
+  // The second part is the first one shifted by a fraction of a grid cell
+  const double shift = 0.01;
+  std::vector<LinearAlgebra::distributed::Vector<double>> positions(
+    2, LinearAlgebra::distributed::Vector<double>(position_partitioner));
+  VectorTools::interpolate(position_dof_handler,
+                           Functions::IdentityFunction<dim>(),
+                           positions[0]);
+  VectorTools::interpolate(position_dof_handler,
+                           Functions::ConstantFunction<dim>(shift, dim),
+                           positions[1]);
+  positions[1] += positions[0];
+
+  // setup SAMRAI stuff (its always the same):
+  auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+  auto f_idx           = std::get<5>(tuple);
+
+  // Now set up fiddle things for the test. The interaction object needs the
+  // bounding boxes of both parts:
+  std::vector<BoundingBox<spacedim, float>> bboxes;
+  for (const auto &cell : native_tria.active_cell_iterators())
+    if (cell->is_locally_owned())
+      {
+        const auto             bbox = cell->bounding_box();
+        Point<spacedim, float> p0, p1;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          {
+            p0[d] = bbox.get_boundary_points().first[d];
+            p1[d] = bbox.get_boundary_points().second[d] + shift;
+          }
+        bboxes.emplace_back(std::make_pair(p0, p1));
+      }
+  const auto all_bboxes =
+    fdl::collect_all_active_cell_bboxes(native_tria, bboxes);
+  const auto local_edge_lengths =
+    fdl::compute_longest_edge_lengths(native_tria, F_mapping, QGauss<1>(2));
+  const auto all_edge_lengths =
+    fdl::collect_longest_edge_lengths(native_tria, local_edge_lengths);
+
+  // Concurrent transactions need their own interaction objects (and hence
+  // communicators), so set up one per part
+  std::vector<std::unique_ptr<fdl::ElementalInteraction<dim, spacedim>>>
+    interactions;
+  for (unsigned int i = 0; i < 2; ++i)
+    {
+      interactions.emplace_back(
+        std::make_unique<fdl::ElementalInteraction<dim, spacedim>>(
+          input_db,
+          native_tria,
+          all_bboxes,
+          all_edge_lengths,
+          patch_hierarchy,
+          std::make_pair(patch_hierarchy->getFinestLevelNumber(),
+                         patch_hierarchy->getFinestLevelNumber()),
+          fe_degree + 1,
+          1.0,
+          fdl::DensityKind::Minimum));
+      interactions.back()->add_dof_handler(position_dof_handler);
+      interactions.back()->add_dof_handler(F_dof_handler);
+    }
+  auto &interaction = *interactions[0];
+
+  auto finish = [&](std::unique_ptr<fdl::TransactionBase> transaction)
+  {
+    transaction =
+      interaction.compute_projection_rhs_scatter_finish(std::move(transaction));
+    transaction =
+      interaction.compute_projection_rhs_intermediate(std::move(transaction));
+    transaction = interaction.compute_projection_rhs_accumulate_start(
+      std::move(transaction));
+    interaction.compute_projection_rhs_accumulate_finish(
+      std::move(transaction));
+  };
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+
+  // Each part separately:
+  std::vector<LinearAlgebra::distributed::Vector<double>> separate_rhs(
+    2, LinearAlgebra::distributed::Vector<double>(F_partitioner));
+  for (unsigned int i = 0; i < 2; ++i)
+    finish(
+      interaction.compute_projection_rhs_scatter_start("BSPLINE_3",
+                                                       f_idx,
+                                                       position_dof_handler,
+                                                       positions[i],
+                                                       F_dof_handler,
+                                                       F_mapping,
+                                                       separate_rhs[i]));
+
+  // Both parts at once:
+  std::vector<LinearAlgebra::distributed::Vector<double>> combined_rhs(
+    2, LinearAlgebra::distributed::Vector<double>(F_partitioner));
+  fdl::TransactionScheduler scheduler;
+  for (unsigned int i = 0; i < 2; ++i)
+    scheduler.add_projection_rhs(
+      *interactions[i],
+      interactions[i]->compute_projection_rhs_scatter_start(
+        "BSPLINE_3",
+        f_idx,
+        position_dof_handler,
+        positions[i],
+        F_dof_handler,
+        F_mapping,
+        combined_rhs[i]));
+  if (rank == 0)
+    output << "pending transactions: " << scheduler.n_pending_transactions()
+           << std::endl;
+  scheduler.run();
+  if (rank == 0)
+    output << "pending transactions: " << scheduler.n_pending_transactions()
+           << std::endl;
+
+  for (unsigned int i = 0; i < 2; ++i)
+    {
+      const double norm = separate_rhs[i].l2_norm();
+      combined_rhs[i] -= separate_rhs[i];
+      const double error = combined_rhs[i].l2_norm();
+      if (rank == 0)
+        output << "part " << i << " nonzero: " << (norm > 0.0)
+               << " matches: " << (error < 1e-14 * norm) << std::endl;
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "transaction_scheduler_01.log");
+
+  test<NDIM>(app_initializer);
+}
@@ -0,0 +1,96 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/boundary_trace.h>
+#include <fiddle/mechanics/part.h>
+
+#include <deal.II/base/function_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Test that BoundaryTrace restricts volume vectors to the boundary and that
+// adding surface vectors into volume vectors is the transpose of that.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim>
+void
+test(std::ofstream &output)
+{
+  const auto partitioner =
+    parallel::shared::Triangulation<dim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim> tria(MPI_COMM_WORLD,
+                                            {},
+                                            false,
+                                            partitioner);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+  parallel::shared::Triangulation<dim - 1, dim> boundary_tria(MPI_COMM_WORLD,
+                                                              {},
+                                                              false,
+                                                              partitioner);
+  GridGenerator::extract_boundary_mesh(tria, boundary_tria);
+
+  FESystem<dim>          fe(FE_Q<dim>(2), dim);
+  FESystem<dim - 1, dim> boundary_fe(FE_Q<dim - 1, dim>(2), dim);
+
+  Functions::CosineFunction<dim> position(dim);
+  fdl::Part<dim>                 part(tria, fe, {}, position);
+  fdl::Part<dim - 1, dim>        surface_part(boundary_tria,
+                                       boundary_fe,
+                                       {},
+                                       position);
+
+  fdl::BoundaryTrace<dim> trace(part, surface_part);
+
+  // The restricted position should be the interpolated surface position:
+  LinearAlgebra::distributed::Vector<double> restricted(
+    surface_part.get_partitioner());
+  trace.restrict_to_surface(part.get_position(), restricted);
+  restricted -= surface_part.get_position();
+
+  // (R v, s) == (v, R^T s):
+  LinearAlgebra::distributed::Vector<double> v(part.get_partitioner());
+  LinearAlgebra::distributed::Vector<double> s(surface_part.get_partitioner());
+  for (const auto dof : v.locally_owned_elements())
+    v[dof] = std::sin(double(dof));
+  for (const auto dof : s.locally_owned_elements())
+    s[dof] = std::cos(double(dof));
+  LinearAlgebra::distributed::Vector<double> restricted_v(
+    surface_part.get_partitioner());
+  trace.restrict_to_surface(v, restricted_v);
+  LinearAlgebra::distributed::Vector<double> transpose_s(
+    part.get_partitioner());
+  trace.add_to_volume(s, transpose_s);
+  const double lhs = restricted_v * s;
+  const double rhs = v * transpose_s;
+
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    output << "restriction matches: "
+           << (restricted.linfty_norm() < 1e-14) << std::endl
+           << "transpose matches: "
+           << (std::abs(lhs - rhs) < 1e-12 * std::abs(lhs)) << std::endl;
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+
+  std::ofstream output;
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    output.open("output");
+
+  test<2>(output);
+}
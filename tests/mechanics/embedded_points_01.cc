@@ -0,0 +1,191 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/embedded_points.h>
+#include <fiddle/mechanics/force_contribution_lib.h>
+#include <fiddle/mechanics/mechanics_utilities.h>
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/fe_values_extractors.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <fstream>
+#include <vector>
+
+#include "../tests.h"
+
+// Test EmbeddedPoints and EmbeddedPointSpringForce: every point should be
+// owned by exactly one processor, positions evaluated at the points should
+// match an affine position field (which FE_Q(2) represents exactly), and
+// since the shape functions are a partition of unity the load vector of a
+// set of point forces should sum to the total force.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim>
+class Affine : public Function<dim>
+{
+public:
+  Affine()
+    : Function<dim>(dim)
+  {}
+
+  virtual double
+  value(const Point<dim> &p, const unsigned int component = 0) const override
+  {
+    AssertIndexRange(component, dim);
+    return 2.0 * p[component] + 0.5 * p[(component + 1) % dim] +
+           0.1 * (component + 1);
+  }
+};
+
+template <int dim>
+void
+test()
+{
+  const MPI_Comm comm = MPI_COMM_WORLD;
+  std::ofstream  output;
+  if (Utilities::MPI::this_mpi_process(comm) == 0)
+    output.open("output");
+
+  const auto mesh_partitioner =
+    parallel::shared::Triangulation<dim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim> tria(comm,
+                                            {},
+                                            false,
+                                            mesh_partitioner);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(3);
+  FESystem<dim>   fe(FE_Q<dim>(2), dim);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+  MappingQ<dim> mapping(1);
+
+  IndexSet locally_relevant_dofs;
+  DoFTools::extract_locally_relevant_dofs(dof_handler, locally_relevant_dofs);
+  auto partitioner = std::make_shared<Utilities::MPI::Partitioner>(
+    dof_handler.locally_owned_dofs(), locally_relevant_dofs, comm);
+
+  LinearAlgebra::distributed::Vector<double> reference(partitioner),
+    position(partitioner), velocity(partitioner);
+  VectorTools::interpolate(dof_handler,
+                           Functions::IdentityFunction<dim>(),
+                           reference);
+  VectorTools::interpolate(dof_handler, Affine<dim>(), position);
+  reference.update_ghost_values();
+  position.update_ghost_values();
+
+  std::vector<Point<dim>> points;
+  for (unsigned int i = 0; i < 10; ++i)
+    {
+      Point<dim> point;
+      for (unsigned int d = 0; d < dim; ++d)
+        point[d] = d % 2 == 0 ? 0.05 + 0.09 * i : 0.93 - 0.08 * i;
+      points.push_back(point);
+    }
+
+  fdl::EmbeddedPoints<dim> embedded_points(dof_handler, mapping, points);
+  const auto n_points =
+    Utilities::MPI::sum(embedded_points.n_locally_owned_points(), comm);
+
+  const std::vector<Point<dim>> positions =
+    embedded_points.compute_positions(position);
+  double      max_error = 0.0;
+  Affine<dim> affine;
+  for (std::size_t k = 0; k < positions.size(); ++k)
+    {
+      const Point<dim> &point = points[embedded_points.get_point_indices()[k]];
+      for (unsigned int d = 0; d < dim; ++d)
+        max_error = std::max(max_error,
+                             std::abs(positions[k][d] -
+                                      affine.value(point, d)));
+    }
+  max_error = Utilities::MPI::max(max_error, comm);
+
+  // The sum of the x-components of the load vector is the total x-force
+  const IndexSet x_dofs = DoFTools::extract_dofs(
+    dof_handler, fe.component_mask(FEValuesExtractors::Scalar(0)));
+  const auto sum_x_components =
+    [&](const LinearAlgebra::distributed::Vector<double> &force_rhs)
+  {
+    double x_sum = 0.0;
+    for (const auto dof : dof_handler.locally_owned_dofs())
+      if (x_dofs.is_element(dof))
+        x_sum += force_rhs[dof];
+    return Utilities::MPI::sum(x_sum, comm);
+  };
+
+  LinearAlgebra::distributed::Vector<double> force_rhs(partitioner);
+  Tensor<1, dim>                             force;
+  force[0] = 1.5;
+  embedded_points.add_load_vector(std::vector<Tensor<1, dim>>(
+                                    embedded_points.n_locally_owned_points(),
+                                    force),
+                                  force_rhs);
+  force_rhs.compress(VectorOperation::add);
+  const double total_force = sum_x_components(force_rhs);
+
+  // The spring force should vanish at the reference position
+  const double                       spring_constant = 10.0;
+  fdl::EmbeddedPointSpringForce<dim> spring_force(
+    QGauss<dim>(3), spring_constant, dof_handler, mapping, points);
+  const auto compute_load =
+    [&](const LinearAlgebra::distributed::Vector<double> &current_position)
+  {
+    LinearAlgebra::distributed::Vector<double> spring_rhs(partitioner);
+    spring_force.setup_force(0.0, current_position, velocity);
+    fdl::compute_load_vector(dof_handler,
+                             mapping,
+                             {&spring_force},
+                             {},
+                             0.0,
+                             current_position,
+                             velocity,
+                             spring_rhs);
+    spring_force.finish_force(0.0);
+    spring_rhs.compress(VectorOperation::add);
+    return spring_rhs;
+  };
+  const double reference_norm = compute_load(reference).linfty_norm();
+
+  // and with a uniform shift of 0.1 in x should pull back each point with
+  // force -k 0.1
+  LinearAlgebra::distributed::Vector<double> shifted(partitioner);
+  VectorTools::interpolate(dof_handler,
+                           Functions::IdentityFunction<dim>(),
+                           shifted);
+  for (const auto dof : dof_handler.locally_owned_dofs())
+    if (x_dofs.is_element(dof))
+      shifted[dof] += 0.1;
+  shifted.update_ghost_values();
+  const double shifted_sum = sum_x_components(compute_load(shifted));
+
+  if (Utilities::MPI::this_mpi_process(comm) == 0)
+    output << "number of points: " << n_points << std::endl
+           << "positions match: " << (max_error < 1e-12) << std::endl
+           << "load vector sums to the total force: "
+           << (std::abs(total_force - 1.5 * n_points) < 1e-12) << std::endl
+           << "reference spring force is zero: " << (reference_norm < 1e-12)
+           << std::endl
+           << "sum of x-components: " << shifted_sum << std::endl;
+}
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_init_finalize(argc, argv);
+  test<2>();
+}
@@ -0,0 +1,88 @@
+#include <fiddle/mechanics/fiber_network.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Test FiberNetwork with single precision storage and precomputed structural
+// tensors
+
+using namespace SAMRAI;
+using namespace dealii;
+
+template <int dim, int spacedim = dim>
+void
+test(tbox::Pointer<IBTK::AppInitializer> /*app_initializer*/)
+{
+  const MPI_Comm      mpi_comm = MPI_COMM_WORLD;
+  Triangulation<2, 2> tria;
+
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(1);
+
+  Tensor<1, spacedim> f1, f2;
+  f1[0] = 0.6;
+  f1[1] = 0.8;
+  f2[0] = -0.8;
+  f2[1] = 0.6;
+
+  std::vector<std::vector<Tensor<1, spacedim>>> fibers(2);
+  for (unsigned int i = 0; i < tria.n_active_cells(); i++)
+    {
+      fibers[0].push_back(f1);
+      fibers[1].push_back(f2);
+    }
+
+  fdl::FiberNetwork<dim, spacedim> double_network(tria, fibers);
+  fdl::FiberNetwork<dim, spacedim> float_network(tria, fibers, true);
+
+  std::ostringstream local_out;
+
+  local_out << "number of fibers: " << float_network.n_fibers() << '\n'
+            << "single precision: " << float_network.uses_single_precision()
+            << '\n'
+            << "uses less memory: "
+            << (float_network.memory_consumption() <
+                double_network.memory_consumption())
+            << '\n';
+
+  for (const auto &cell : tria.active_cell_iterators())
+    local_out << cell->active_cell_index() << " "
+              << float_network.get_fiber(cell, 0) << " "
+              << float_network.get_fiber(cell, 1) << '\n';
+
+  // computed on the fly and precomputed structural tensors should match
+  for (const auto &cell : tria.active_cell_iterators())
+    local_out << "on the fly " << cell->active_cell_index() << " "
+              << double_network.get_structural_tensor(cell, 0, 0) << " "
+              << double_network.get_structural_tensor(cell, 0, 1) << '\n';
+  double_network.setup_structural_tensors();
+  local_out << "has structural tensors: "
+            << double_network.has_structural_tensors() << '\n';
+  for (const auto &cell : tria.active_cell_iterators())
+    local_out << "stored " << cell->active_cell_index() << " "
+              << double_network.get_structural_tensor(cell, 0, 0) << " "
+              << double_network.get_structural_tensor(cell, 1, 0) << '\n';
+
+  std::ofstream output;
+  if (Utilities::MPI::this_mpi_process(mpi_comm) == 0)
+    output.open("output");
+
+  print_strings_on_0(local_out.str(), mpi_comm, output);
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit                      ibtk_init(argc, argv, MPI_COMM_WORLD);
+  tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "fiber_network_02.log");
+
+  test<2>(app_initializer);
+}
@@ -0,0 +1,102 @@
+#include <fiddle/mechanics/fiber_network.h>
+
+#include <deal.II/base/function_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Test rule-based fibers in FiberNetwork: the transmural coordinate is x, so
+// the helix angle varies from 0 at x = 0 to pi/2 at x = 1
+
+using namespace SAMRAI;
+using namespace dealii;
+
+template <int dim, int spacedim = dim>
+void
+test(tbox::Pointer<IBTK::AppInitializer> /*app_initializer*/)
+{
+  const MPI_Comm      mpi_comm = MPI_COMM_WORLD;
+  Triangulation<2, 2> tria;
+
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(1);
+
+  FE_Q<dim, spacedim>       fe(1);
+  DoFHandler<dim, spacedim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+  MappingQ<dim, spacedim> mapping(1);
+
+  LinearAlgebra::distributed::Vector<double> transmural_coordinate(
+    dof_handler.locally_owned_dofs(), tria.get_communicator());
+  VectorTools::interpolate(mapping,
+                           dof_handler,
+                           Functions::CoordinateFunction<spacedim>(0),
+                           transmural_coordinate);
+
+  fdl::FiberNetwork<dim, spacedim> network(mapping,
+                                           dof_handler,
+                                           transmural_coordinate,
+                                           Tensor<1, spacedim>(),
+                                           0.0,
+                                           0.5 * numbers::PI);
+
+  std::ostringstream local_out;
+  local_out << "number of fibers: " << network.n_fibers() << '\n'
+            << "rule based: " << network.is_rule_based() << '\n';
+
+  bool orthonormal = true;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      const Tensor<1, spacedim> f = network.get_fiber(cell, 0);
+      const Tensor<1, spacedim> s = network.get_fiber(cell, 1);
+      orthonormal = orthonormal && std::abs(f.norm() - 1.0) < 1e-12 &&
+                    std::abs(s.norm() - 1.0) < 1e-12 && std::abs(f * s) < 1e-12;
+      local_out << cell->active_cell_index() << " " << f << " " << s << '\n';
+    }
+  local_out << "orthonormal: " << orthonormal << '\n';
+
+  // computed on the fly and precomputed structural tensors should match
+  std::vector<SymmetricTensor<2, spacedim>> on_the_fly;
+  for (const auto &cell : tria.active_cell_iterators())
+    on_the_fly.push_back(network.get_structural_tensor(cell, 0, 1));
+  network.setup_structural_tensors();
+  bool matches = true;
+  for (const auto &cell : tria.active_cell_iterators())
+    matches =
+      matches && (on_the_fly[cell->active_cell_index()] -
+                  network.get_structural_tensor(cell, 1, 0))
+                     .norm() < 1e-12;
+  local_out << "stored structural tensors match: " << matches << '\n';
+
+  std::ofstream output;
+  if (Utilities::MPI::this_mpi_process(mpi_comm) == 0)
+    output.open("output");
+
+  print_strings_on_0(local_out.str(), mpi_comm, output);
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit                      ibtk_init(argc, argv, MPI_COMM_WORLD);
+  tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "fiber_network_03.log");
+
+  test<2>(app_initializer);
+}
@@ -0,0 +1,164 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/force_contribution_lib.h>
+#include <fiddle/mechanics/mechanics_utilities.h>
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <cmath>
+#include <fstream>
+
+#include "../tests.h"
+
+// Verify that damping forces, which are mass-proportional and are therefore
+// assembled as a mass matrix-vector product with MatrixFree (together with
+// spring forces), give the same load vector as the FEValues path.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int spacedim>
+class Position : public Function<spacedim>
+{
+public:
+  Position(const double amplitude)
+    : Function<spacedim>(spacedim)
+    , amplitude(amplitude)
+  {}
+
+  double
+  value(const Point<spacedim> &p,
+        const unsigned int     component = 0) const override
+  {
+    const double tau = 2.0 * numbers::PI;
+    return p[component] +
+           amplitude * std::sin(tau * p[0]) * std::sin(tau * p[1]) +
+           0.1 * p[(component + 1) % spacedim];
+  }
+
+  const double amplitude;
+};
+
+template <int dim, int spacedim = dim>
+void
+test(const unsigned int fe_degree, const unsigned int n_q_points_1d)
+{
+  const MPI_Comm comm = MPI_COMM_WORLD;
+  std::ofstream  output;
+  if (Utilities::MPI::this_mpi_process(comm) == 0)
+    output.open("output", std::ios::app);
+
+  parallel::shared::Triangulation<dim, spacedim> tria(comm);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(3);
+  for (auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] > 0.5)
+      cell->set_material_id(1);
+
+  FESystem<dim, spacedim>   fe(FE_Q<dim, spacedim>(fe_degree), spacedim);
+  MappingQ<dim, spacedim>   mapping(1);
+  QGauss<dim>               quadrature(n_q_points_1d);
+  DoFHandler<dim, spacedim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  constraints.close();
+  MatrixFree<dim, double> matrix_free;
+  matrix_free.reinit(mapping, dof_handler, constraints, quadrature);
+  const auto partitioner = matrix_free.get_vector_partitioner();
+
+  LinearAlgebra::distributed::Vector<double> reference_position(partitioner),
+    current_position(partitioner), current_velocity(partitioner),
+    fe_values_rhs(partitioner), matrix_free_rhs(partitioner);
+  VectorTools::interpolate(mapping,
+                           dof_handler,
+                           Position<spacedim>(0.0),
+                           reference_position);
+  VectorTools::interpolate(mapping,
+                           dof_handler,
+                           Position<spacedim>(0.05),
+                           current_position);
+  VectorTools::interpolate(mapping,
+                           dof_handler,
+                           Position<spacedim>(0.2),
+                           current_velocity);
+  current_position.update_ghost_values();
+  current_velocity.update_ghost_values();
+
+  // The second damping force is only applied on some cells so it always uses
+  // the FEValues path
+  fdl::DampingForce<dim, spacedim> f1(quadrature, 3.0);
+  fdl::DampingForce<dim, spacedim> f2(quadrature, 10.0, {1});
+  fdl::SpringForce<dim, spacedim>  f3(quadrature,
+                                     2.0,
+                                     dof_handler,
+                                     reference_position);
+  std::vector<fdl::ForceContribution<dim, spacedim> *> force_ptrs{&f1,
+                                                                  &f2,
+                                                                  &f3};
+  for (auto *force : force_ptrs)
+    force->setup_force(0.0, current_position, current_velocity);
+
+  fdl::compute_load_vector(dof_handler,
+                           mapping,
+                           force_ptrs,
+                           {},
+                           0.0,
+                           current_position,
+                           current_velocity,
+                           fe_values_rhs);
+  fe_values_rhs.compress(VectorOperation::add);
+  fdl::compute_load_vector(dof_handler,
+                           mapping,
+                           force_ptrs,
+                           {},
+                           0.0,
+                           current_position,
+                           current_velocity,
+                           matrix_free_rhs,
+                           &matrix_free);
+  matrix_free_rhs.compress(VectorOperation::add);
+
+  for (auto *force : force_ptrs)
+    force->finish_force(0.0);
+
+  const double norm = fe_values_rhs.l2_norm();
+  matrix_free_rhs -= fe_values_rhs;
+  const double relative_difference = matrix_free_rhs.l2_norm() / norm;
+
+  if (Utilities::MPI::this_mpi_process(comm) == 0)
+    output << "degree = " << fe_degree << " n_q_points_1d = " << n_q_points_1d
+           << " relative difference < 1e-12: "
+           << (relative_difference < 1e-12 ? "true" : "false") << std::endl;
+}
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_init_finalize(argc, argv);
+  // Best way to empty the file
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    std::ofstream("output");
+  // precompiled kernels:
+  for (unsigned int degree = 1; degree < 4; ++degree)
+    test<2>(degree, degree + 1);
+  // variable degree kernels:
+  test<2>(2, 4);
+}
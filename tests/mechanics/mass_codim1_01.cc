@@ -0,0 +1,119 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/part.h>
+
+#include <deal.II/base/function_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/fe_values.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/full_matrix.h>
+
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Verify that the mass operator Part uses in codimension one (i.e.,
+// SurfaceMassOperator) agrees with the mass matrix assembled with FEValues,
+// both with sum factorization (FE_Q) and without (FE_DGQ), and that mass
+// systems can be solved with it.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int spacedim>
+void
+test(std::ofstream                               &output,
+     const FiniteElement<spacedim - 1, spacedim> &scalar_fe)
+{
+  constexpr int dim = spacedim - 1;
+  const auto    mesh_partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> tria(MPI_COMM_WORLD,
+                                                      {},
+                                                      false,
+                                                      mesh_partitioner);
+  GridGenerator::hyper_sphere(tria);
+  tria.refine_global(3);
+  FESystem<dim, spacedim> fe(scalar_fe, spacedim);
+
+  Functions::CosineFunction<spacedim> position(spacedim);
+  fdl::Part<dim, spacedim>            part(tria, fe, {}, position);
+
+  // Assemble the expected product cell by cell:
+  LinearAlgebra::distributed::Vector<double> expected(part.get_partitioner());
+  {
+    LinearAlgebra::distributed::Vector<double> src(part.get_position());
+    src.update_ghost_values();
+    FEValues<dim, spacedim> fe_values(part.get_mapping(),
+                                      fe,
+                                      QGauss<dim>(fe.tensor_degree() + 1),
+                                      update_values | update_JxW_values);
+    FullMatrix<double>      cell_matrix(fe.dofs_per_cell);
+    std::vector<types::global_dof_index> cell_dofs(fe.dofs_per_cell);
+    for (const auto &cell : part.get_dof_handler().active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          fe_values.reinit(cell);
+          cell->get_dof_indices(cell_dofs);
+          cell_matrix = 0.0;
+          for (unsigned int q = 0; q < fe_values.n_quadrature_points; ++q)
+            for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+              for (unsigned int j = 0; j < fe.dofs_per_cell; ++j)
+                if (fe.system_to_component_index(i).first ==
+                    fe.system_to_component_index(j).first)
+                  cell_matrix(i, j) += fe_values.shape_value(i, q) *
+                                       fe_values.shape_value(j, q) *
+                                       fe_values.JxW(q);
+          for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+            for (unsigned int j = 0; j < fe.dofs_per_cell; ++j)
+              expected[cell_dofs[i]] += cell_matrix(i, j) * src[cell_dofs[j]];
+        }
+    expected.compress(VectorOperation::add);
+  }
+
+  LinearAlgebra::distributed::Vector<double> result(part.get_partitioner());
+  part.apply_mass_operator({&result}, {&part.get_position()});
+  const double tolerance = 1e-13 * expected.l2_norm();
+  result -= expected;
+  const double result_error = result.l2_norm();
+
+  // Solving with the product as the right-hand side should recover the
+  // position:
+  LinearAlgebra::distributed::Vector<double> solution(part.get_partitioner());
+  part.solve_mass_systems({&solution}, {&expected}, 100, 1e-12);
+  solution -= part.get_position();
+  const double solution_error =
+    solution.l2_norm() / part.get_position().l2_norm();
+
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    {
+      output << "fe = " << fe.get_name() << std::endl
+             << "  apply_mass_operator() matches: "
+             << (result_error < tolerance) << std::endl
+             << "  solve_mass_systems() matches: " << (solution_error < 1e-10)
+             << std::endl;
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+
+  std::ofstream output;
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    output.open("output");
+
+  for (const unsigned int fe_degree : {1u, 2u, 3u})
+    test<NDIM>(output, FE_Q<NDIM - 1, NDIM>(fe_degree));
+  test<NDIM>(output, FE_DGQ<NDIM - 1, NDIM>(2));
+}
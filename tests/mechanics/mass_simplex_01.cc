@@ -0,0 +1,104 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/part.h>
+
+#include <deal.II/base/function_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_simplex_p.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+
+#include <deal.II/matrix_free/matrix_free.h>
+FDL_DISABLE_EXTRA_DIAGNOSTICS
+#include <deal.II/matrix_free/operators.h>
+FDL_ENABLE_EXTRA_DIAGNOSTICS
+
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Verify that the mass operator Part uses for simplex elements (i.e.,
+// SimplexMassOperator) agrees with deal.II's generic MassOperator.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim>
+void
+test(std::ofstream &output, const unsigned int fe_degree)
+{
+  const auto mesh_partitioner =
+    parallel::shared::Triangulation<dim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim> tria(MPI_COMM_WORLD,
+                                            {},
+                                            false,
+                                            mesh_partitioner);
+  {
+    parallel::shared::Triangulation<dim> hypercube_tria(MPI_COMM_WORLD);
+    GridGenerator::subdivided_hyper_cube(hypercube_tria, 4);
+    GridTools::distort_random(0.25, hypercube_tria, true, 42);
+    GridGenerator::convert_hypercube_to_simplex_mesh(hypercube_tria, tria);
+  }
+  FESystem<dim> fe(FE_SimplexP<dim>(fe_degree), dim);
+
+  Functions::CosineFunction<dim> position(dim);
+  fdl::Part<dim>                 part(tria, fe, {}, position);
+
+  MatrixFreeOperators::MassOperator<dim,
+                                    -1,
+                                    0,
+                                    dim,
+                                    LinearAlgebra::distributed::Vector<double>>
+    reference_operator;
+  reference_operator.initialize(part.get_matrix_free());
+  reference_operator.compute_diagonal();
+
+  LinearAlgebra::distributed::Vector<double> expected(part.get_partitioner());
+  LinearAlgebra::distributed::Vector<double> result(part.get_partitioner());
+  LinearAlgebra::distributed::Vector<double> other(part.get_partitioner());
+  reference_operator.vmult(expected, part.get_position());
+  part.get_mass_operator().vmult(result, part.get_position());
+  part.apply_mass_operator({&other}, {&part.get_position()});
+  const double tolerance = 1e-14 * expected.l2_norm();
+
+  result -= expected;
+  other -= expected;
+  LinearAlgebra::distributed::Vector<double> diagonal(
+    part.get_mass_operator().get_matrix_diagonal()->get_vector());
+  diagonal -= reference_operator.get_matrix_diagonal()->get_vector();
+  const double diagonal_tolerance =
+    1e-14 * reference_operator.get_matrix_diagonal()->get_vector().l2_norm();
+
+  const double result_error   = result.l2_norm();
+  const double other_error    = other.l2_norm();
+  const double diagonal_error = diagonal.l2_norm();
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    {
+      output << "dim = " << dim << " degree = " << fe_degree << std::endl
+             << "  vmult() matches: " << (result_error < tolerance)
+             << std::endl
+             << "  apply_mass_operator() matches: "
+             << (other_error < tolerance) << std::endl
+             << "  lumped mass matches: "
+             << (diagonal_error < diagonal_tolerance) << std::endl;
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+
+  std::ofstream output;
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    output.open("output");
+
+  for (const unsigned int fe_degree : {1u, 2u, 3u})
+    test<2>(output, fe_degree);
+}
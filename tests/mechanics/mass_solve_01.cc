@@ -0,0 +1,129 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/part.h>
+
+#include <deal.II/base/function_parser.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Test that batched mass operator applications and solves match the
+// matrix-free mass operator
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto input_db = app_initializer->getInputDatabase();
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(MPI_COMM_WORLD,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::hyper_cube(native_tria);
+  native_tria.refine_global(3);
+  parallel::shared::Triangulation<dim, spacedim> other_tria(MPI_COMM_WORLD,
+                                                            {},
+                                                            false,
+                                                            partitioner);
+  GridGenerator::hyper_cube(other_tria);
+  other_tria.refine_global(3);
+  FESystem<dim, spacedim> fe(FE_Q<dim, spacedim>(2), spacedim);
+
+  FunctionParser<spacedim> position_0(
+    extract_fp_string(input_db->getDatabase("test")->getDatabase("position")),
+    "PI=" + std::to_string(numbers::PI),
+    "X_0,X_1");
+  FunctionParser<spacedim> position_1(
+    extract_fp_string(input_db->getDatabase("test")->getDatabase("velocity")),
+    "PI=" + std::to_string(numbers::PI),
+    "X_0,X_1");
+
+  // set up fiddle stuff for the test:
+  fdl::Part<dim, spacedim> part_0(native_tria, fe, {}, position_0);
+  fdl::Part<dim, spacedim> part_1(native_tria, fe, {}, position_1);
+  fdl::Part<dim, spacedim> part_2(other_tria, fe);
+
+  std::ofstream output;
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    output.open("output");
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    {
+      output << "part 0 and part 1 have the same mass operator: "
+             << part_0.has_same_mass_operator(part_1) << std::endl;
+      output << "part 0 and part 2 have the same mass operator: "
+             << part_0.has_same_mass_operator(part_2) << std::endl;
+    }
+
+  // Apply the mass operator to both positions at once and compare to the
+  // matrix-free operator:
+  LinearAlgebra::distributed::Vector<double> rhs_0(part_0.get_partitioner());
+  LinearAlgebra::distributed::Vector<double> rhs_1(part_1.get_partitioner());
+  part_0.apply_mass_operator({&rhs_0, &rhs_1},
+                             {&part_0.get_position(), &part_1.get_position()});
+
+  auto temp = rhs_0;
+  part_0.get_mass_operator().vmult(temp, part_0.get_position());
+  temp -= rhs_0;
+  const double apply_error_0 = temp.l2_norm() / rhs_0.l2_norm();
+  part_1.get_mass_operator().vmult(temp, part_1.get_position());
+  temp -= rhs_1;
+  const double apply_error_1 = temp.l2_norm() / rhs_1.l2_norm();
+
+  // Solve both systems at once and compare to the original positions:
+  LinearAlgebra::distributed::Vector<double> solution_0(
+    part_0.get_partitioner());
+  LinearAlgebra::distributed::Vector<double> solution_1(
+    part_1.get_partitioner());
+  const std::vector<unsigned int> iterations =
+    part_0.solve_mass_systems({&solution_0, &solution_1},
+                              {&rhs_0, &rhs_1},
+                              100,
+                              1e-12);
+  solution_0 -= part_0.get_position();
+  solution_1 -= part_1.get_position();
+  const double solve_error_0 =
+    solution_0.l2_norm() / part_0.get_position().l2_norm();
+  const double solve_error_1 =
+    solution_1.l2_norm() / part_1.get_position().l2_norm();
+
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    {
+      output << "apply errors are small: "
+             << (apply_error_0 < 1e-14 && apply_error_1 < 1e-14) << std::endl;
+      output << "solve errors are small: "
+             << (solve_error_0 < 1e-10 && solve_error_1 < 1e-10) << std::endl;
+      output << "both systems converged: "
+             << (iterations[0] > 0 && iterations[0] < 100 &&
+                 iterations[1] > 0 && iterations[1] < 100)
+             << std::endl;
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "multilevel_fe_01.log");
+
+  test<2>(app_initializer);
+}
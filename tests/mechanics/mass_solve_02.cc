@@ -0,0 +1,105 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/part.h>
+
+#include <deal.II/base/function_parser.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Test the approximate (lumped) inverse of the mass matrix
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto input_db = app_initializer->getInputDatabase();
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(MPI_COMM_WORLD,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::hyper_cube(native_tria);
+  native_tria.refine_global(3);
+  FESystem<dim, spacedim> fe(FE_Q<dim, spacedim>(2), spacedim);
+
+  FunctionParser<spacedim> position(
+    extract_fp_string(input_db->getDatabase("test")->getDatabase("position")),
+    "PI=" + std::to_string(numbers::PI),
+    "X_0,X_1");
+
+  // set up fiddle stuff for the test:
+  fdl::Part<dim, spacedim> part(native_tria, fe, {}, position);
+
+  LinearAlgebra::distributed::Vector<double> rhs(part.get_partitioner());
+  part.get_mass_operator().vmult(rhs, part.get_position());
+
+  // With no corrections we should just apply the Jacobi preconditioner:
+  LinearAlgebra::distributed::Vector<double> solution(part.get_partitioner());
+  LinearAlgebra::distributed::Vector<double> jacobi(part.get_partitioner());
+  part.apply_approximate_mass_inverse(solution, rhs, 0);
+  part.get_mass_preconditioner().vmult(jacobi, rhs);
+  jacobi -= solution;
+  const double jacobi_difference = jacobi.l2_norm();
+
+  std::ofstream output;
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    {
+      output.open("output");
+      output << "no corrections is the Jacobi preconditioner: "
+             << (jacobi_difference == 0.0) << std::endl;
+    }
+
+  // Errors should decrease as we add more corrections:
+  std::vector<double> errors;
+  for (const unsigned int n_corrections : {0u, 2u, 4u, 8u})
+    {
+      part.apply_approximate_mass_inverse(solution, rhs, n_corrections);
+      solution -= part.get_position();
+      errors.push_back(solution.l2_norm() / part.get_position().l2_norm());
+    }
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    {
+      for (std::size_t i = 1; i < errors.size(); ++i)
+        output << "error decreases with more corrections: "
+               << (errors[i] < errors[i - 1]) << std::endl;
+    }
+
+  // Two applications with the same number of corrections should agree:
+  LinearAlgebra::distributed::Vector<double> other(part.get_partitioner());
+  part.apply_approximate_mass_inverse(solution, rhs, 4);
+  part.apply_approximate_mass_inverse(other, rhs, 4);
+  other -= solution;
+  const double repeat_difference = other.l2_norm();
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    output << "repeated applications agree: " << (repeat_difference == 0.0)
+           << std::endl;
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "multilevel_fe_01.log");
+
+  test<2>(app_initializer);
+}
@@ -0,0 +1,110 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/part.h>
+
+#include <deal.II/base/function_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Test the preconditioners used by Part::solve_mass_systems(): Chebyshev
+// corrections should reduce the number of CG iterations and discontinuous
+// elements should be solved exactly without iterating.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim>
+double
+relative_residual(const fdl::Part<dim>                             &part,
+                  const LinearAlgebra::distributed::Vector<double> &solution,
+                  const LinearAlgebra::distributed::Vector<double> &rhs)
+{
+  LinearAlgebra::distributed::Vector<double> residual(part.get_partitioner());
+  part.get_mass_operator().vmult(residual, solution);
+  residual -= rhs;
+  return residual.l2_norm() / rhs.l2_norm();
+}
+
+template <int dim>
+void
+test(std::ofstream &output)
+{
+  const auto partitioner =
+    parallel::shared::Triangulation<dim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim> tria(MPI_COMM_WORLD,
+                                            {},
+                                            false,
+                                            partitioner);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(3);
+  Functions::CosineFunction<dim> position(dim);
+
+  // Continuous elements
+  {
+    FESystem<dim>                              fe(FE_Q<dim>(4), dim);
+    fdl::Part<dim>                             part(tria, fe, {}, position);
+    LinearAlgebra::distributed::Vector<double> rhs(part.get_partitioner());
+    part.get_mass_operator().vmult(rhs, part.get_position());
+
+    std::vector<unsigned int> iterations;
+    bool                      converged = true;
+    for (const unsigned int n_corrections : {0u, 2u})
+      {
+        part.set_mass_preconditioner_corrections(n_corrections);
+        LinearAlgebra::distributed::Vector<double> solution(
+          part.get_partitioner());
+        iterations.push_back(
+          part.solve_mass_systems({&solution}, {&rhs}, 100, 1e-10)[0]);
+        converged = converged && relative_residual(part, solution, rhs) < 1e-9;
+      }
+    if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+      output << "FE_Q: has cellwise inverse mass: "
+             << part.has_cellwise_inverse_mass() << std::endl
+             << "FE_Q: converged: " << converged << std::endl
+             << "FE_Q: Chebyshev needs fewer iterations: "
+             << (iterations[1] < iterations[0]) << std::endl;
+  }
+
+  // Discontinuous elements
+  {
+    FESystem<dim>                              fe(FE_DGQ<dim>(2), dim);
+    fdl::Part<dim>                             part(tria, fe, {}, position);
+    LinearAlgebra::distributed::Vector<double> rhs(part.get_partitioner());
+    part.get_mass_operator().vmult(rhs, part.get_position());
+
+    LinearAlgebra::distributed::Vector<double> solution(
+      part.get_partitioner());
+    const unsigned int n_iterations =
+      part.solve_mass_systems({&solution}, {&rhs}, 100, 1e-10)[0];
+    const double residual = relative_residual(part, solution, rhs);
+    if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+      output << "FE_DGQ: has cellwise inverse mass: "
+             << part.has_cellwise_inverse_mass() << std::endl
+             << "FE_DGQ: iterations: " << n_iterations << std::endl
+             << "FE_DGQ: exact: " << (residual < 1e-12) << std::endl;
+  }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+
+  std::ofstream output;
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    output.open("output");
+
+  test<2>(output);
+}
@@ -0,0 +1,106 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/part.h>
+
+#include <deal.II/base/function_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Verify that pipelined CG solves the same mass systems as standard CG in
+// about the same number of iterations, both with Jacobi and Chebyshev
+// preconditioning and with several systems at once.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim>
+void
+test(std::ofstream &output, const unsigned int n_corrections)
+{
+  const auto mesh_partitioner =
+    parallel::shared::Triangulation<dim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim> tria(MPI_COMM_WORLD,
+                                            {},
+                                            false,
+                                            mesh_partitioner);
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(3);
+  FESystem<dim> fe(FE_Q<dim>(3), dim);
+
+  Functions::CosineFunction<dim> position(dim);
+  fdl::Part<dim>                 part(tria, fe, {}, position);
+  part.set_mass_preconditioner_corrections(n_corrections);
+
+  // Solve for the position and for twice the position at once:
+  std::vector<LinearAlgebra::distributed::Vector<double>> right_hand_sides(2);
+  for (unsigned int k = 0; k < 2; ++k)
+    {
+      right_hand_sides[k].reinit(part.get_partitioner());
+      part.apply_mass_operator({&right_hand_sides[k]},
+                               {&part.get_position()});
+      right_hand_sides[k] *= k + 1.0;
+    }
+
+  std::vector<std::vector<LinearAlgebra::distributed::Vector<double>>>
+                                          solutions(2);
+  std::vector<std::vector<unsigned int>> iterations;
+  for (const bool pipelined : {false, true})
+    {
+      part.set_pipelined_mass_solver(pipelined);
+      auto &pipelined_solutions = solutions[pipelined];
+      pipelined_solutions.resize(2);
+      std::vector<LinearAlgebra::distributed::Vector<double> *> solution_ptrs;
+      for (auto &solution : pipelined_solutions)
+        {
+          solution.reinit(part.get_partitioner());
+          solution_ptrs.push_back(&solution);
+        }
+      iterations.push_back(
+        part.solve_mass_systems(solution_ptrs,
+                                {&right_hand_sides[0], &right_hand_sides[1]},
+                                100,
+                                1e-12));
+    }
+
+  bool solutions_match = true, iterations_match = true;
+  for (unsigned int k = 0; k < 2; ++k)
+    {
+      solutions[1][k] -= solutions[0][k];
+      solutions_match = solutions_match && solutions[1][k].l2_norm() <
+                                             1e-10 * solutions[0][k].l2_norm();
+      iterations_match =
+        iterations_match && std::abs(int(iterations[1][k]) -
+                                     int(iterations[0][k])) <= 1;
+    }
+
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    {
+      output << "n_corrections = " << n_corrections << std::endl
+             << "  solutions match: " << solutions_match << std::endl
+             << "  iterations match: " << iterations_match << std::endl;
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+
+  std::ofstream output;
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    output.open("output");
+
+  for (const unsigned int n_corrections : {0u, 2u})
+    test<NDIM>(output, n_corrections);
+}
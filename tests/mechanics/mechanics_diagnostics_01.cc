@@ -0,0 +1,200 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/force_contribution_lib.h>
+#include <fiddle/mechanics/mechanics_diagnostics.h>
+#include <fiddle/mechanics/mechanics_utilities.h>
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <vector>
+
+#include "../tests.h"
+
+// Test MechanicsDiagnostics: quantities computed during force assembly should
+// match the same quantities computed in a separate loop over the cells, and
+// computing them should not change the load vector. Since FE_Q(2) represents
+// the position exactly, J and the stretch along x are both 1 + x / 2 and
+// their integrals over the unit square are 5 / 4.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim>
+class Position : public Function<dim>
+{
+public:
+  Position()
+    : Function<dim>(dim)
+  {}
+
+  virtual double
+  value(const Point<dim> &p, const unsigned int component = 0) const override
+  {
+    AssertIndexRange(component, dim);
+    if (component == 0)
+      return p[0] + 0.25 * p[0] * p[0];
+    return p[component];
+  }
+};
+
+template <int dim>
+void
+test()
+{
+  const MPI_Comm comm = MPI_COMM_WORLD;
+  std::ofstream  output;
+  if (Utilities::MPI::this_mpi_process(comm) == 0)
+    output.open("output");
+
+  const auto mesh_partitioner =
+    parallel::shared::Triangulation<dim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim> tria(comm,
+                                            {},
+                                            false,
+                                            mesh_partitioner);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(3);
+  FESystem<dim>   fe(FE_Q<dim>(2), dim);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+  MappingQ<dim> mapping(1);
+
+  IndexSet locally_relevant_dofs;
+  DoFTools::extract_locally_relevant_dofs(dof_handler, locally_relevant_dofs);
+  auto partitioner = std::make_shared<Utilities::MPI::Partitioner>(
+    dof_handler.locally_owned_dofs(), locally_relevant_dofs, comm);
+
+  LinearAlgebra::distributed::Vector<double> position(partitioner),
+    velocity(partitioner);
+  VectorTools::interpolate(dof_handler, Position<dim>(), position);
+  position.update_ghost_values();
+
+  // Compute J in a separate loop for comparison
+  double J_min = std::numeric_limits<double>::max();
+  double J_max = std::numeric_limits<double>::lowest();
+  {
+    FEValues<dim> fe_values(mapping, fe, QGauss<dim>(3), update_gradients);
+    std::vector<Tensor<2, dim>> FF(fe_values.n_quadrature_points);
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          fe_values.reinit(cell);
+          fe_values[FEValuesExtractors::Vector(0)].get_function_gradients(
+            position, FF);
+          for (const Tensor<2, dim> &F : FF)
+            {
+              J_min = std::min(J_min, determinant(F));
+              J_max = std::max(J_max, determinant(F));
+            }
+        }
+    J_min = Utilities::MPI::min(J_min, comm);
+    J_max = Utilities::MPI::max(J_max, comm);
+  }
+
+  fdl::ModifiedNeoHookeanStress<dim> stress(QGauss<dim>(3), 1.0);
+  const auto compute_load = [&](fdl::MechanicsDiagnostics<dim> *diagnostics)
+  {
+    LinearAlgebra::distributed::Vector<double> force_rhs(partitioner);
+    fdl::compute_load_vector<dim, dim>(dof_handler,
+                                       mapping,
+                                       {&stress},
+                                       {},
+                                       0.0,
+                                       position,
+                                       velocity,
+                                       force_rhs,
+                                       nullptr,
+                                       {},
+                                       nullptr,
+                                       diagnostics);
+    force_rhs.compress(VectorOperation::add);
+    return force_rhs;
+  };
+  const LinearAlgebra::distributed::Vector<double> expected =
+    compute_load(nullptr);
+
+  // Check both a quadrature rule shared with the stress and one which is not
+  for (const unsigned int n_points : {3u, 4u})
+    {
+      fdl::MechanicsDiagnostics<dim> diagnostics((QGauss<dim>(n_points)));
+
+      const unsigned int J_index       = diagnostics.add_det_FF(true);
+      const unsigned int stretch_index = diagnostics.add_quantity(
+        "fiber stretch",
+        fdl::MechanicsUpdateFlags::update_right_cauchy_green,
+        [](const fdl::MechanicsValues<dim> &me_values,
+           const typename Triangulation<dim>::active_cell_iterator &,
+           ArrayView<double> &values)
+        {
+          const auto &C = me_values.get_right_cauchy_green();
+          for (unsigned int qp_n = 0; qp_n < values.size(); ++qp_n)
+            values[qp_n] = std::sqrt(C[qp_n][0][0]);
+        });
+
+      LinearAlgebra::distributed::Vector<double> force_rhs =
+        compute_load(&diagnostics);
+      force_rhs -= expected;
+      const double load_error = force_rhs.linfty_norm();
+
+      const auto  statistics = diagnostics.compute_statistics();
+      const auto &J          = statistics[J_index];
+      const auto &stretch    = statistics[stretch_index];
+
+      // The cell averages should add up to the integral
+      double cell_sum = 0.0;
+      for (const auto &cell : tria.active_cell_iterators())
+        if (cell->is_locally_owned())
+          cell_sum +=
+            diagnostics.get_cell_values(J_index)[cell->active_cell_index()] *
+            cell->measure();
+      cell_sum = Utilities::MPI::sum(cell_sum, comm);
+
+      if (Utilities::MPI::this_mpi_process(comm) == 0)
+        {
+          output << "quadrature points: " << n_points << std::endl
+                 << "  load vector unchanged: " << (load_error < 1e-14)
+                 << std::endl
+                 << "  measure: " << J.measure << std::endl
+                 << "  " << diagnostics.get_name(J_index)
+                 << " integral: " << J.integral << std::endl
+                 << "  " << diagnostics.get_name(stretch_index)
+                 << " integral: " << stretch.integral << std::endl
+                 << "  cell averages match: "
+                 << (std::abs(cell_sum - J.integral) < 1e-12) << std::endl;
+          if (n_points == 3)
+            output << "  J extrema match: "
+                   << (std::abs(J.min - J_min) < 1e-14 &&
+                       std::abs(J.max - J_max) < 1e-14)
+                   << std::endl;
+          output << "  stretch extrema match J: "
+                 << (std::abs(stretch.min - J.min) < 1e-14 &&
+                     std::abs(stretch.max - J.max) < 1e-14)
+                 << std::endl;
+        }
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_init_finalize(argc, argv);
+  test<2>();
+}
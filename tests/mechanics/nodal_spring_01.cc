@@ -0,0 +1,184 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/force_contribution_lib.h>
+#include <fiddle/mechanics/mechanics_utilities.h>
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/fe_values_extractors.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <fstream>
+#include <vector>
+
+#include "../tests.h"
+
+// Test NodalSpringForce: with every node it should match the consistent
+// SpringForce for a uniform displacement (since the row sums of the mass
+// matrix are the lumped masses) and with a nodeset it should only load the
+// DoFs of that nodeset.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim>
+class Shift : public Function<dim>
+{
+public:
+  Shift()
+    : Function<dim>(dim)
+  {}
+
+  virtual double
+  value(const Point<dim> &p, const unsigned int component = 0) const override
+  {
+    AssertIndexRange(component, dim);
+    return p[component] + 0.1 * (component + 1);
+  }
+};
+
+template <int dim>
+void
+test()
+{
+  const MPI_Comm comm = MPI_COMM_WORLD;
+  std::ofstream  output;
+  if (Utilities::MPI::this_mpi_process(comm) == 0)
+    output.open("output");
+
+  const auto mesh_partitioner =
+    parallel::shared::Triangulation<dim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim> tria(comm,
+                                            {},
+                                            false,
+                                            mesh_partitioner);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(3);
+  FESystem<dim>   fe(FE_Q<dim>(1), dim);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+  MappingQ<dim> mapping(1);
+  QGauss<dim>   quadrature(2);
+
+  IndexSet locally_relevant_dofs;
+  DoFTools::extract_locally_relevant_dofs(dof_handler, locally_relevant_dofs);
+  auto partitioner = std::make_shared<Utilities::MPI::Partitioner>(
+    dof_handler.locally_owned_dofs(), locally_relevant_dofs, comm);
+
+  LinearAlgebra::distributed::Vector<double> reference(partitioner),
+    position(partitioner), velocity(partitioner);
+  VectorTools::interpolate(dof_handler,
+                           Functions::IdentityFunction<dim>(),
+                           reference);
+  VectorTools::interpolate(dof_handler, Shift<dim>(), position);
+  reference.update_ghost_values();
+  position.update_ghost_values();
+
+  const double spring_constant = 10.0;
+  const auto   compute_load = [&](fdl::ForceContribution<dim> &force)
+  {
+    LinearAlgebra::distributed::Vector<double> force_rhs(partitioner);
+    force.setup_force(0.0, position, velocity);
+    fdl::compute_load_vector(dof_handler,
+                             mapping,
+                             {&force},
+                             {},
+                             0.0,
+                             position,
+                             velocity,
+                             force_rhs);
+    force.finish_force(0.0);
+    force_rhs.compress(VectorOperation::add);
+    return force_rhs;
+  };
+
+  // every node
+  {
+    std::vector<unsigned int> nodes(tria.n_vertices());
+    for (unsigned int i = 0; i < nodes.size(); ++i)
+      nodes[i] = i;
+    fdl::NodalSpringForce<dim> nodal_force(
+      quadrature, spring_constant, dof_handler, mapping, nodes);
+    fdl::SpringForce<dim> spring_force(quadrature,
+                                       spring_constant,
+                                       dof_handler,
+                                       reference);
+
+    LinearAlgebra::distributed::Vector<double> difference =
+      compute_load(nodal_force);
+    difference -= compute_load(spring_force);
+    const auto n_dofs = Utilities::MPI::sum(nodal_force.get_dofs().size(),
+                                            comm);
+    if (Utilities::MPI::this_mpi_process(comm) == 0)
+      output << "number of DoFs: " << dof_handler.n_dofs() << std::endl
+             << "number of loaded DoFs: " << n_dofs << std::endl
+             << "matches SpringForce: " << (difference.linfty_norm() < 1e-12)
+             << std::endl;
+  }
+
+  // the nodeset x = 0, with and without reference points
+  {
+    std::vector<unsigned int>      nodes;
+    std::vector<Point<dim>>        shifted_points;
+    const std::vector<Point<dim>> &vertices = tria.get_vertices();
+    for (unsigned int i = 0; i < vertices.size(); ++i)
+      if (vertices[i][0] == 0.0)
+        {
+          nodes.push_back(i);
+          shifted_points.push_back(vertices[i]);
+          for (unsigned int d = 0; d < dim; ++d)
+            shifted_points.back()[d] += 0.1 * (d + 1);
+        }
+
+    fdl::NodalSpringForce<dim> nodal_force(
+      quadrature, spring_constant, dof_handler, mapping, nodes);
+    const LinearAlgebra::distributed::Vector<double> force_rhs =
+      compute_load(nodal_force);
+    double       x_sum     = 0.0;
+    unsigned int n_nonzero = 0;
+    for (const auto dof : dof_handler.locally_owned_dofs())
+      if (force_rhs[dof] != 0.0)
+        ++n_nonzero;
+    // This should be -k 0.1 times the lumped mass of the boundary
+    const IndexSet x_dofs = DoFTools::extract_dofs(
+      dof_handler, fe.component_mask(FEValuesExtractors::Scalar(0)));
+    for (const auto dof : nodal_force.get_dofs())
+      if (x_dofs.is_element(dof))
+        x_sum += force_rhs[dof];
+    x_sum     = Utilities::MPI::sum(x_sum, comm);
+    n_nonzero = Utilities::MPI::sum(n_nonzero, comm);
+
+    fdl::NodalSpringForce<dim> shifted_force(quadrature,
+                                             spring_constant,
+                                             dof_handler,
+                                             mapping,
+                                             nodes,
+                                             shifted_points);
+    const double shifted_norm = compute_load(shifted_force).linfty_norm();
+    if (Utilities::MPI::this_mpi_process(comm) == 0)
+      output << "number of nodes: " << nodes.size() << std::endl
+             << "number of nonzero entries: " << n_nonzero << std::endl
+             << "sum of x-components: " << x_sum << std::endl
+             << "shifted reference force is zero: " << (shifted_norm < 1e-12)
+             << std::endl;
+  }
+}
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_init_finalize(argc, argv);
+  test<2>();
+}
@@ -0,0 +1,124 @@
+#include <fiddle/mechanics/part.h>
+#include <fiddle/mechanics/part_cache.h>
+
+#include <deal.II/base/function_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Test that a Triangulation, DoF numbering, and vector stored with PartCache
+// can be used to set up an identical part.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim>
+void
+test(std::ofstream &output)
+{
+  const MPI_Comm mpi_comm = MPI_COMM_WORLD;
+  const auto     partitioner =
+    parallel::shared::Triangulation<dim>::Settings::partition_zorder;
+  FESystem<dim>                  fe(FE_Q<dim>(2), dim);
+  Functions::CosineFunction<dim> position(dim);
+
+  // Use this file as the input so that the key does not change
+  const std::vector<std::string> input_files{SOURCE_DIR
+                                             "part_cache_01.cc"};
+
+  // Set up the part in the usual way and save everything:
+  parallel::shared::Triangulation<dim> tria_1(mpi_comm,
+                                              {},
+                                              false,
+                                              partitioner);
+  GridGenerator::hyper_ball(tria_1);
+  auto geometry_1 = std::make_shared<fdl::PartGeometry<dim>>(tria_1, fe, true);
+  fdl::Part<dim> part_1(geometry_1, {}, {}, position);
+  {
+    fdl::PartCache<dim> cache(".", input_files, mpi_comm);
+    cache.save_triangulation(tria_1);
+    cache.save_dof_numbering(part_1.get_dof_handler());
+    cache.save_vector("position", part_1.get_position());
+  }
+
+  // Load it again:
+  fdl::PartCache<dim> cache(".", input_files, mpi_comm);
+  const bool          has_all = cache.has_triangulation() &&
+                       cache.has_dof_numbering() &&
+                       cache.has_vector("position");
+
+  parallel::shared::Triangulation<dim> tria_2(mpi_comm,
+                                              {},
+                                              false,
+                                              partitioner);
+  cache.load_triangulation(tria_2);
+  auto dof_handler = std::make_shared<DoFHandler<dim>>(tria_2);
+  dof_handler->distribute_dofs(fe);
+  cache.load_dof_numbering(*dof_handler);
+  auto geometry_2 = std::make_shared<fdl::PartGeometry<dim>>(dof_handler);
+  fdl::Part<dim> part_2(geometry_2);
+  LinearAlgebra::distributed::Vector<double> position_2(
+    part_2.get_partitioner());
+  cache.load_vector("position", position_2);
+
+  bool same_cells = tria_1.n_active_cells() == tria_2.n_active_cells();
+  auto cell_2     = tria_2.begin_active();
+  for (const auto &cell_1 : tria_1.active_cell_iterators())
+    {
+      same_cells = same_cells && cell_1->center() == cell_2->center() &&
+                   cell_1->material_id() == cell_2->material_id() &&
+                   cell_1->subdomain_id() == cell_2->subdomain_id();
+      for (const unsigned int f : cell_1->face_indices())
+        if (cell_1->face(f)->at_boundary())
+          same_cells = same_cells && cell_1->face(f)->boundary_id() ==
+                                       cell_2->face(f)->boundary_id();
+      ++cell_2;
+    }
+
+  std::vector<types::global_dof_index> dofs_1(fe.n_dofs_per_cell());
+  std::vector<types::global_dof_index> dofs_2(fe.n_dofs_per_cell());
+  bool                                 same_dofs = true;
+  auto dof_cell_2 = dof_handler->begin_active();
+  for (const auto &cell_1 : part_1.get_dof_handler().active_cell_iterators())
+    {
+      if (cell_1->is_locally_owned())
+        {
+          cell_1->get_dof_indices(dofs_1);
+          dof_cell_2->get_dof_indices(dofs_2);
+          same_dofs = same_dofs && dofs_1 == dofs_2;
+        }
+      ++dof_cell_2;
+    }
+  same_dofs = Utilities::MPI::min(int(same_dofs), mpi_comm) == 1;
+
+  position_2 -= part_1.get_position();
+  const double position_difference = position_2.linfty_norm();
+
+  if (Utilities::MPI::this_mpi_process(mpi_comm) == 0)
+    output << "has all objects: " << has_all << std::endl
+           << "same cells: " << same_cells << std::endl
+           << "same DoFs: " << same_dofs << std::endl
+           << "same position: " << (position_difference == 0.0) << std::endl;
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+
+  std::ofstream output;
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    output.open("output");
+
+  test<2>(output);
+}
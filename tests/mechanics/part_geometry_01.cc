@@ -0,0 +1,96 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/force_contribution_lib.h>
+#include <fiddle/mechanics/part.h>
+
+#include <deal.II/base/function_lib.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Test that several Parts can share a PartGeometry: they should share their
+// finite element book-keeping but not their state.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim>
+void
+test(std::ofstream &output)
+{
+  const auto partitioner =
+    parallel::shared::Triangulation<dim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim> tria(MPI_COMM_WORLD,
+                                            {},
+                                            false,
+                                            partitioner);
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(2);
+  FESystem<dim> fe(FE_Q<dim>(2), dim);
+
+  Functions::CosineFunction<dim> position(dim);
+  fdl::Part<dim>                 part_1(tria, fe, {}, position);
+
+  std::vector<std::unique_ptr<fdl::ForceContribution<dim>>> forces;
+  forces.emplace_back(
+    std::make_unique<fdl::DampingForce<dim>>(QGauss<dim>(3), 1.0));
+  fdl::Part<dim> part_2(part_1.get_geometry(), std::move(forces));
+  // A separate geometry for comparison
+  fdl::Part<dim> part_3(tria, fe, {}, position);
+
+  // Shared objects:
+  const bool same_objects =
+    part_1.get_geometry() == part_2.get_geometry() &&
+    part_1.get_matrix_free() == part_2.get_matrix_free() &&
+    &part_1.get_dof_handler() == &part_2.get_dof_handler() &&
+    &part_1.get_mass_operator() == &part_2.get_mass_operator();
+  // Separate state:
+  const bool separate_state =
+    part_1.get_position().l2_norm() != part_2.get_position().l2_norm() &&
+    part_1.get_force_contributions().size() == 0 &&
+    part_2.get_force_contributions().size() == 1;
+
+  // Both parts should compute the same projection as an unshared part:
+  LinearAlgebra::distributed::Vector<double> rhs(part_3.get_partitioner());
+  part_3.get_mass_operator().vmult(rhs, part_3.get_position());
+  LinearAlgebra::distributed::Vector<double> solution_2(
+    part_2.get_partitioner());
+  LinearAlgebra::distributed::Vector<double> solution_3(
+    part_3.get_partitioner());
+  part_2.solve_mass_systems({&solution_2}, {&rhs}, 100, 1e-12);
+  part_3.solve_mass_systems({&solution_3}, {&rhs}, 100, 1e-12);
+  solution_2 -= solution_3;
+
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    output << "same objects: " << same_objects << std::endl
+           << "separate state: " << separate_state << std::endl
+           << "same mass operator: "
+           << part_1.has_same_mass_operator(part_2) << ' '
+           << part_1.has_same_mass_operator(part_3) << std::endl
+           << "same projection: "
+           << (solution_2.l2_norm() < 1e-12 * solution_3.l2_norm())
+           << std::endl;
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+
+  std::ofstream output;
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    output.open("output");
+
+  test<2>(output);
+}
@@ -0,0 +1,107 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/part.h>
+
+#include <deal.II/base/function_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Test that renumbering the DoFs of a PartGeometry along a Hilbert curve only
+// permutes them: cell-wise values and the mass operator should not change.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim>
+void
+test(std::ofstream &output)
+{
+  const auto partitioner =
+    parallel::shared::Triangulation<dim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim> tria(MPI_COMM_WORLD,
+                                            {},
+                                            false,
+                                            partitioner);
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(3);
+  FESystem<dim> fe(FE_Q<dim>(2), dim);
+
+  Functions::CosineFunction<dim> position(dim);
+  fdl::Part<dim>                 part_1(tria, fe, {}, position);
+
+  // The same part with renumbered DoFs:
+  auto geometry = std::make_shared<fdl::PartGeometry<dim>>(tria, fe, true);
+  fdl::Part<dim> part_2(geometry, {}, {}, position);
+
+  const bool same_owned_dofs = part_1.get_dof_handler().locally_owned_dofs() ==
+                               part_2.get_dof_handler().locally_owned_dofs();
+
+  // Renumbering does not change the order of the cells, so cell-wise data
+  // (e.g., as loaded by read_dof_data()) is unaffected
+  bool same_cell_values = true;
+  bool renumbered       = false;
+
+  Vector<double>                       values_1(fe.n_dofs_per_cell());
+  Vector<double>                       values_2(fe.n_dofs_per_cell());
+  std::vector<types::global_dof_index> dofs_1(fe.n_dofs_per_cell());
+  std::vector<types::global_dof_index> dofs_2(fe.n_dofs_per_cell());
+
+  auto cell_2 = part_2.get_dof_handler().begin_active();
+  for (const auto &cell_1 : part_1.get_dof_handler().active_cell_iterators())
+    {
+      if (cell_1->is_locally_owned())
+        {
+          cell_1->get_dof_values(part_1.get_position(), values_1);
+          cell_2->get_dof_values(part_2.get_position(), values_2);
+          values_1 -= values_2;
+          same_cell_values =
+            same_cell_values && values_1.linfty_norm() < 1e-14;
+          cell_1->get_dof_indices(dofs_1);
+          cell_2->get_dof_indices(dofs_2);
+          renumbered = renumbered || dofs_1 != dofs_2;
+        }
+      ++cell_2;
+    }
+  same_cell_values =
+    Utilities::MPI::min(int(same_cell_values), MPI_COMM_WORLD) == 1;
+  renumbered = Utilities::MPI::max(int(renumbered), MPI_COMM_WORLD) == 1;
+
+  LinearAlgebra::distributed::Vector<double> rhs_1(part_1.get_partitioner());
+  LinearAlgebra::distributed::Vector<double> rhs_2(part_2.get_partitioner());
+  part_1.get_mass_operator().vmult(rhs_1, part_1.get_position());
+  part_2.get_mass_operator().vmult(rhs_2, part_2.get_position());
+  const double norm_1 = rhs_1.l2_norm();
+  const double norm_2 = rhs_2.l2_norm();
+
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    output << "same locally owned DoFs: " << same_owned_dofs << std::endl
+           << "renumbered: " << renumbered << std::endl
+           << "same cell values: " << same_cell_values << std::endl
+           << "same mass operator norm: "
+           << (std::abs(norm_1 - norm_2) < 1e-12 * norm_1) << std::endl;
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+
+  std::ofstream output;
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    output.open("output");
+
+  test<2>(output);
+}
@@ -0,0 +1,90 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/part.h>
+#include <fiddle/mechanics/part_vectors.h>
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Test the memory accounting of Part, PartGeometry, and PartVectors.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim>
+void
+test(std::ofstream &output)
+{
+  parallel::shared::Triangulation<dim> tria(MPI_COMM_WORLD);
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(2);
+  FESystem<dim> fe(FE_Q<dim>(2), dim);
+
+  std::vector<fdl::Part<dim>> parts;
+  parts.emplace_back(tria, fe);
+  const fdl::Part<dim> &part = parts[0];
+  // Lower bound on the memory used by a single vector:
+  const std::size_t vector_memory =
+    part.get_position().locally_owned_size() * sizeof(double);
+
+  // The position and velocity are stored by the Part. The geometry contains
+  // the Triangulation, which is replicated, and the DoFHandler.
+  const std::size_t part_memory     = part.memory_consumption(false);
+  const std::size_t geometry_memory = part.get_geometry()->memory_consumption();
+  const bool        geometry_includes_tria =
+    geometry_memory > tria.memory_consumption() +
+                        part.get_dof_handler().memory_consumption();
+  const bool part_includes_geometry =
+    part.memory_consumption() == part_memory + geometry_memory;
+
+  // Precomputed values should be counted:
+  parts[0].setup_reference_shape_gradients(QGauss<dim>(3));
+  const bool geometry_includes_gradients =
+    part.get_geometry()->memory_consumption() >=
+    geometry_memory +
+      part.get_reference_shape_gradients()[0]->memory_consumption();
+
+  // PartVectors only counts its own vectors:
+  fdl::PartVectors<dim> part_vectors(parts);
+  const std::size_t     initial_vectors_memory =
+    part_vectors.memory_consumption();
+  part_vectors.begin_time_step(0.0, 1.0);
+  part_vectors.set_position(0, 1.0, part.get_position());
+  part_vectors.set_velocity(0, 0.5, part.get_velocity());
+  const bool part_vectors_grow = part_vectors.memory_consumption() >=
+                                 initial_vectors_memory + 2 * vector_memory;
+
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    output << "part: " << (part_memory >= 2 * vector_memory) << std::endl
+           << "part includes geometry: " << part_includes_geometry
+           << std::endl
+           << "geometry includes tria: " << geometry_includes_tria
+           << std::endl
+           << "geometry includes gradients: " << geometry_includes_gradients
+           << std::endl
+           << "part vectors: " << part_vectors_grow << std::endl;
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+
+  std::ofstream output;
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    output.open("output");
+
+  test<2>(output);
+}
@@ -0,0 +1,97 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/force_contribution_lib.h>
+#include <fiddle/mechanics/part.h>
+
+#include <deal.II/base/function_lib.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Test that ensemble members share the geometry and copy the state of the
+// original part.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim>
+void
+test(std::ofstream &output)
+{
+  parallel::shared::Triangulation<dim> tria(MPI_COMM_WORLD);
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(2);
+  FESystem<dim> fe(FE_Q<dim>(2), dim);
+  QGauss<dim>   quadrature(3);
+
+  const Functions::ConstantFunction<dim> velocity(2.0, dim);
+  std::vector<fdl::Part<dim>>            parts;
+  {
+    std::vector<std::unique_ptr<fdl::ForceContribution<dim>>> forces;
+    forces.emplace_back(
+      new fdl::ModifiedNeoHookeanStress<dim>(quadrature, 1.0));
+    parts.emplace_back(tria,
+                       fe,
+                       std::move(forces),
+                       Functions::IdentityFunction<dim>(),
+                       velocity);
+  }
+  // Members with different shear moduli:
+  for (unsigned int i = 1; i < 3; ++i)
+    {
+      std::vector<std::unique_ptr<fdl::ForceContribution<dim>>> forces;
+      forces.emplace_back(
+        new fdl::ModifiedNeoHookeanStress<dim>(quadrature, 1.0 + i));
+      parts.emplace_back(parts[0], std::move(forces));
+    }
+
+  bool same_geometry      = true;
+  bool same_mass_operator = true;
+  bool same_state         = true;
+  for (unsigned int i = 1; i < parts.size(); ++i)
+    {
+      same_geometry =
+        same_geometry && parts[i].get_geometry() == parts[0].get_geometry();
+      same_mass_operator =
+        same_mass_operator && parts[i].has_same_mass_operator(parts[0]);
+      auto difference = parts[i].get_position();
+      difference.zero_out_ghost_values();
+      difference.add(-1.0, parts[0].get_position());
+      same_state = same_state && difference.linfty_norm() == 0.0;
+      difference = parts[i].get_velocity();
+      difference.zero_out_ghost_values();
+      difference.add(-1.0, parts[0].get_velocity());
+      same_state = same_state && difference.linfty_norm() == 0.0;
+      same_state = same_state && parts[i].get_position().has_ghost_elements();
+    }
+
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    output << "same geometry: " << same_geometry << std::endl
+           << "same mass operator: " << same_mass_operator << std::endl
+           << "same state: " << same_state << std::endl
+           << "number of forces: "
+           << parts[2].get_force_contributions().size() << std::endl;
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+
+  std::ofstream output;
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    output.open("output");
+
+  test<2>(output);
+}
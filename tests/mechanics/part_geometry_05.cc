@@ -0,0 +1,97 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/part.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <ibtk/IBTKInit.h>
+
+#include <cmath>
+#include <fstream>
+
+#include "../tests.h"
+
+// Test that parts created from in-memory mesh data use the provided
+// partitioning and match parts created from an equivalent Triangulation.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim>
+void
+test(std::ofstream &output)
+{
+  static_assert(dim == 2, "only implemented in 2D");
+  const unsigned int n_subdivisions = 4;
+
+  const unsigned int n_procs = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+  const unsigned int rank    = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+
+  // Lexicographically ordered vertices and cells, partitioned in blocks of
+  // rows
+  fdl::PartMeshData<dim> mesh_data;
+  for (unsigned int j = 0; j <= n_subdivisions; ++j)
+    for (unsigned int i = 0; i <= n_subdivisions; ++i)
+      mesh_data.vertices.emplace_back(double(i) / n_subdivisions,
+                                      double(j) / n_subdivisions);
+  for (unsigned int j = 0; j < n_subdivisions; ++j)
+    for (unsigned int i = 0; i < n_subdivisions; ++i)
+      {
+        CellData<dim>      cell(4);
+        const unsigned int v = j * (n_subdivisions + 1) + i;
+        cell.vertices[0]     = v;
+        cell.vertices[1]     = v + 1;
+        cell.vertices[2]     = v + n_subdivisions + 1;
+        cell.vertices[3]     = v + n_subdivisions + 2;
+        mesh_data.cells.push_back(cell);
+        mesh_data.subdomain_ids.push_back(j * n_procs / n_subdivisions);
+      }
+  const std::vector<types::subdomain_id> subdomain_ids =
+    mesh_data.subdomain_ids;
+
+  FESystem<dim>  fe(FE_Q<dim>(1), dim);
+  fdl::Part<dim> part(MPI_COMM_WORLD, std::move(mesh_data), fe);
+
+  const Triangulation<dim> &tria        = part.get_triangulation();
+  bool                      partitioned = true;
+  for (const auto &cell : tria.active_cell_iterators())
+    partitioned =
+      partitioned && (cell->is_locally_owned() ==
+                      (subdomain_ids[cell->active_cell_index()] == rank));
+  partitioned = Utilities::MPI::min(int(partitioned), MPI_COMM_WORLD) == 1;
+
+  parallel::shared::Triangulation<dim> reference_tria(MPI_COMM_WORLD);
+  GridGenerator::subdivided_hyper_cube(reference_tria, n_subdivisions);
+  fdl::Part<dim> reference_part(reference_tria, fe);
+
+  const double position_norm  = part.get_position().l2_norm();
+  const double reference_norm = reference_part.get_position().l2_norm();
+
+  if (rank == 0)
+    output << "number of active cells: " << tria.n_active_cells() << std::endl
+           << "number of DoFs: " << part.get_dof_handler().n_dofs()
+           << std::endl
+           << "mesh data freed: " << mesh_data.vertices.empty() << std::endl
+           << "partitioned: " << partitioned << std::endl
+           << "same position: "
+           << (std::abs(position_norm - reference_norm) < 1e-12) << std::endl;
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+
+  std::ofstream output;
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    output.open("output");
+
+  test<2>(output);
+}
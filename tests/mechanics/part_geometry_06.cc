@@ -0,0 +1,122 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/part.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <ibtk/IBTKInit.h>
+
+#include <cmath>
+#include <fstream>
+
+#include "../tests.h"
+
+// Test that geometries created concurrently from in-memory mesh data use
+// their own communicators and match parts created from equivalent
+// Triangulations.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim>
+fdl::PartMeshData<dim>
+make_mesh_data(const unsigned int n_subdivisions)
+{
+  static_assert(dim == 2, "only implemented in 2D");
+  fdl::PartMeshData<dim> mesh_data;
+  for (unsigned int j = 0; j <= n_subdivisions; ++j)
+    for (unsigned int i = 0; i <= n_subdivisions; ++i)
+      mesh_data.vertices.emplace_back(double(i) / n_subdivisions,
+                                      double(j) / n_subdivisions);
+  for (unsigned int j = 0; j < n_subdivisions; ++j)
+    for (unsigned int i = 0; i < n_subdivisions; ++i)
+      {
+        CellData<dim>      cell(4);
+        const unsigned int v = j * (n_subdivisions + 1) + i;
+        cell.vertices[0]     = v;
+        cell.vertices[1]     = v + 1;
+        cell.vertices[2]     = v + n_subdivisions + 1;
+        cell.vertices[3]     = v + n_subdivisions + 2;
+        mesh_data.cells.push_back(cell);
+      }
+  return mesh_data;
+}
+
+template <int dim>
+void
+test(std::ofstream &output)
+{
+  const unsigned int rank = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+
+  const std::vector<unsigned int>     n_subdivisions = {2, 4, 3};
+  std::vector<fdl::PartMeshData<dim>> mesh_data;
+  for (const unsigned int n : n_subdivisions)
+    mesh_data.push_back(make_mesh_data<dim>(n));
+
+  FESystem<dim> fe(FE_Q<dim>(1), dim);
+  const auto    geometries = fdl::create_part_geometries(
+    MPI_COMM_WORLD, std::move(mesh_data), {&fe}, false, 3);
+
+  for (std::size_t i = 0; i < geometries.size(); ++i)
+    {
+      // Each geometry should use a different duplicate of MPI_COMM_WORLD:
+      const MPI_Comm comm =
+        geometries[i]->get_triangulation().get_communicator();
+      int result = MPI_UNEQUAL;
+      int ierr   = MPI_Comm_compare(comm, MPI_COMM_WORLD, &result);
+      AssertThrowMPI(ierr);
+      bool distinct = true;
+      for (std::size_t j = 0; j < i; ++j)
+        {
+          int other_result = MPI_UNEQUAL;
+          ierr             = MPI_Comm_compare(
+            comm,
+            geometries[j]->get_triangulation().get_communicator(),
+            &other_result);
+          AssertThrowMPI(ierr);
+          distinct = distinct && other_result == MPI_CONGRUENT;
+        }
+
+      fdl::Part<dim> part(geometries[i]);
+
+      parallel::shared::Triangulation<dim> reference_tria(MPI_COMM_WORLD);
+      GridGenerator::subdivided_hyper_cube(reference_tria, n_subdivisions[i]);
+      fdl::Part<dim> reference_part(reference_tria, fe);
+
+      const double position_norm  = part.get_position().l2_norm();
+      const double reference_norm = reference_part.get_position().l2_norm();
+
+      if (rank == 0)
+        output << "geometry " << i << std::endl
+               << "number of active cells: "
+               << geometries[i]->get_triangulation().n_active_cells()
+               << std::endl
+               << "number of DoFs: "
+               << geometries[i]->get_dof_handler().n_dofs() << std::endl
+               << "duplicated communicator: " << (result == MPI_CONGRUENT)
+               << std::endl
+               << "distinct from other geometries: " << distinct << std::endl
+               << "same position: "
+               << (std::abs(position_norm - reference_norm) < 1e-12)
+               << std::endl;
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+
+  std::ofstream output;
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    output.open("output");
+
+  test<2>(output);
+}
@@ -0,0 +1,131 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/part.h>
+#include <fiddle/mechanics/part_refinement.h>
+
+#include <deal.II/base/function.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <ibtk/IBTKInit.h>
+
+#include <cmath>
+#include <fstream>
+
+#include "../tests.h"
+
+// Test refine_and_coarsen_part(): strain indicators of a uniformly stretched
+// part, transfer of the position and cell data to a locally refined mesh, and
+// mass solves with hanging node constraints.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim>
+class Stretch : public Function<dim>
+{
+public:
+  Stretch()
+    : Function<dim>(dim)
+  {}
+
+  virtual double
+  value(const Point<dim> &p, const unsigned int component) const override
+  {
+    return 2.0 * p[component];
+  }
+};
+
+template <int dim>
+void
+test(std::ofstream &output)
+{
+  const auto partitioner =
+    parallel::shared::Triangulation<dim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim> tria(MPI_COMM_WORLD,
+                                            {},
+                                            false,
+                                            partitioner);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+  FESystem<dim>  fe(FE_Q<dim>(2), dim);
+  fdl::Part<dim> part(tria, fe, {}, Stretch<dim>());
+
+  // F = 2 I so E = 3/2 I
+  const Vector<float> indicators = fdl::compute_strain_indicators(part);
+  bool                indicators_correct = indicators.size() == 16;
+  for (const float indicator : indicators)
+    indicators_correct = indicators_correct &&
+                         std::abs(indicator - 1.5 * std::sqrt(2.0)) < 1e-6;
+
+  std::vector<Vector<double>> cell_data(1,
+                                        Vector<double>(tria.n_active_cells()));
+  for (const auto &cell : tria.active_cell_iterators())
+    cell_data[0][cell->active_cell_index()] = cell->center()[0];
+  tria.begin_active()->set_refine_flag();
+
+  LinearAlgebra::distributed::Vector<double> position, velocity;
+  const auto geometry =
+    fdl::refine_and_coarsen_part(tria, part, position, velocity, cell_data);
+
+  // Quadratic elements represent the stretch exactly
+  LinearAlgebra::distributed::Vector<double> exact(
+    geometry->get_partitioner());
+  VectorTools::interpolate(geometry->get_dof_handler(), Stretch<dim>(), exact);
+  geometry->get_constraints().distribute(exact);
+  exact -= position;
+  const double position_error = exact.linfty_norm();
+
+  bool cell_data_correct = cell_data[0].size() == tria.n_active_cells();
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      const double center =
+        cell->level() > 2 ? cell->parent()->center()[0] : cell->center()[0];
+      cell_data_correct =
+        cell_data_correct &&
+        std::abs(cell_data[0][cell->active_cell_index()] - center) < 1e-12;
+    }
+
+  // Solve with a right-hand side computed by the (constrained) mass operator
+  fdl::Part<dim> new_part(geometry);
+  new_part.set_position(std::move(position));
+  LinearAlgebra::distributed::Vector<double> rhs(new_part.get_partitioner());
+  new_part.get_mass_operator().vmult(rhs, new_part.get_position());
+  LinearAlgebra::distributed::Vector<double> solution(
+    new_part.get_partitioner());
+  new_part.solve_mass_systems({&solution}, {&rhs}, 100, 1e-12);
+  solution -= new_part.get_position();
+  const double solution_error = solution.linfty_norm();
+  const double velocity_norm  = velocity.linfty_norm();
+
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    output << "indicators correct: " << indicators_correct << std::endl
+           << "number of active cells: " << tria.n_active_cells() << std::endl
+           << "has hanging node constraints: " << geometry->has_constraints()
+           << std::endl
+           << "position transferred: " << (position_error < 1e-12)
+           << std::endl
+           << "velocity transferred: " << (velocity_norm == 0.0) << std::endl
+           << "cell data transferred: " << cell_data_correct << std::endl
+           << "mass solve recovers position: " << (solution_error < 1e-10)
+           << std::endl;
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+
+  std::ofstream output;
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    output.open("output");
+
+  test<2>(output);
+}
@@ -0,0 +1,198 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/composite_stress.h>
+#include <fiddle/mechanics/fiber_network.h>
+#include <fiddle/mechanics/force_contribution_lib.h>
+#include <fiddle/mechanics/mechanics_values.h>
+
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <cmath>
+#include <fstream>
+
+#include "../tests.h"
+
+// Verify that CompositeStress computes the sum of the corresponding library
+// stresses with both compute_stress() and compute_vectorized_stress().
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim>
+std::vector<Tensor<2, dim>>
+compute_stresses(const fdl::ForceContribution<dim>                       &stress,
+                 const std::vector<Tensor<2, dim>>                       &FF,
+                 const typename Triangulation<dim>::active_cell_iterator &cell)
+{
+  fdl::MechanicsValues<dim> me_values(stress.get_mechanics_update_flags());
+  me_values.reinit(FF);
+  std::vector<Tensor<2, dim>> stresses(FF.size());
+  auto view = make_array_view(stresses.begin(), stresses.end());
+  stress.compute_stress(0.0, me_values, cell, view);
+  return stresses;
+}
+
+template <int dim>
+std::vector<Tensor<2, dim>>
+compute_vectorized_stresses(
+  const fdl::ForceContribution<dim>                       &stress,
+  const std::vector<Tensor<2, dim>>                       &FF,
+  const typename Triangulation<dim>::active_cell_iterator &cell)
+{
+  using VA                         = VectorizedArray<double>;
+  constexpr unsigned int width     = VA::size();
+  const unsigned int     n_batches = (FF.size() + width - 1) / width;
+
+  // pad with the identity
+  std::vector<Tensor<2, dim, VA>> vectorized_FF(n_batches);
+  for (unsigned int b = 0; b < n_batches; ++b)
+    for (unsigned int d = 0; d < dim; ++d)
+      vectorized_FF[b][d][d] = 1.0;
+  for (unsigned int q = 0; q < FF.size(); ++q)
+    for (unsigned int i = 0; i < dim; ++i)
+      for (unsigned int j = 0; j < dim; ++j)
+        vectorized_FF[q / width][i][j][q % width] = FF[q][i][j];
+  fdl::VectorizedMechanicsValues<dim> me_values(
+    stress.get_mechanics_update_flags());
+  me_values.reinit(vectorized_FF);
+  std::vector<Tensor<2, dim, VA>> vectorized_stresses(n_batches);
+  auto view = make_array_view(vectorized_stresses);
+  stress.compute_vectorized_stress(0.0, me_values, cell, view);
+
+  std::vector<Tensor<2, dim>> stresses(FF.size());
+  for (unsigned int q = 0; q < FF.size(); ++q)
+    for (unsigned int i = 0; i < dim; ++i)
+      for (unsigned int j = 0; j < dim; ++j)
+        stresses[q][i][j] = vectorized_stresses[q / width][i][j][q % width];
+  return stresses;
+}
+
+template <int dim>
+bool
+stresses_match(const std::vector<Tensor<2, dim>> &s1,
+               const std::vector<Tensor<2, dim>> &s2)
+{
+  double max_difference = 0.0;
+  double max_norm       = 0.0;
+  for (unsigned int q = 0; q < s1.size(); ++q)
+    {
+      max_norm       = std::max(max_norm, s1[q].norm());
+      max_difference = std::max(max_difference, (s1[q] - s2[q]).norm());
+    }
+  return max_difference <= 1e-13 * std::max(1.0, max_norm);
+}
+
+int
+main()
+{
+  constexpr int dim = 2;
+
+  std::ofstream output("output");
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(1);
+  tria.begin_active()->set_material_id(1);
+
+  const QGauss<dim>           quadrature(3);
+  std::vector<Tensor<2, dim>> FF(quadrature.size());
+  for (unsigned int q = 0; q < FF.size(); ++q)
+    {
+      const double scale = q % 2 == 0 ? 0.9 : 1.1;
+      FF[q][0][0]        = scale + 0.05 * std::sin(double(q));
+      FF[q][0][1]        = 0.1 * std::cos(double(q));
+      FF[q][1][0]        = -0.05 * std::sin(2.0 * q);
+      FF[q][1][1]        = scale + 0.02 * std::cos(3.0 * q);
+    }
+
+  Tensor<1, dim> f1, f2;
+  f1[0] = 1;
+  f2[1] = 1;
+  std::vector<std::vector<Tensor<1, dim>>> fibers(2);
+  fibers[0].resize(tria.n_active_cells(), f1);
+  fibers[1].resize(tria.n_active_cells(), f2);
+  auto fiber_network = std::make_shared<fdl::FiberNetwork<dim>>(tria, fibers);
+
+  const std::vector<types::material_id> materials{1u};
+  fdl::ModifiedNeoHookeanStress<dim>    s1(quadrature, 2.0, materials);
+  fdl::JLogJVolumetricEnergyStress<dim> s2(quadrature, 10.0, materials);
+  fdl::HolzapfelOgdenStress<dim>        s3(quadrature,
+                                           1.0, // a
+                                           1.0, // b
+                                           1.0, // a_f
+                                           1.0, // b_f
+                                           0.0, // kappa_f
+                                           0,   // index_f
+                                           1.0, // a_s
+                                           1.0, // b_s
+                                           0.2, // kappa_s
+                                           1,   // index_s
+                                           1.0, // a_fs
+                                           1.0, // b_fs
+                                           fiber_network,
+                                           materials);
+
+  using namespace fdl::MaterialLaws;
+  fdl::CompositeStress<dim,
+                       dim,
+                       ModifiedNeoHookean<dim>,
+                       JLogJVolumetricEnergy<dim>,
+                       HolzapfelOgden<dim>>
+    composite(quadrature,
+              materials,
+              ModifiedNeoHookean<dim>(2.0),
+              JLogJVolumetricEnergy<dim>(10.0),
+              HolzapfelOgden<dim>(1.0,
+                                  1.0,
+                                  1.0,
+                                  1.0,
+                                  0.0,
+                                  0,
+                                  1.0,
+                                  1.0,
+                                  0.2,
+                                  1,
+                                  1.0,
+                                  1.0,
+                                  fiber_network));
+
+  AssertThrow(composite.get_mechanics_update_flags() ==
+                (s1.get_mechanics_update_flags() |
+                 s2.get_mechanics_update_flags() |
+                 s3.get_mechanics_update_flags()),
+              fdl::ExcFDLInternalError());
+
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      if (cell->active_cell_index() > 1)
+        break;
+      std::vector<Tensor<2, dim>> expected = compute_stresses(s1, FF, cell);
+      for (const fdl::ForceContribution<dim> *stress :
+           std::vector<const fdl::ForceContribution<dim> *>{&s2, &s3})
+        {
+          const auto stresses = compute_stresses(*stress, FF, cell);
+          for (unsigned int q = 0; q < FF.size(); ++q)
+            expected[q] += stresses[q];
+        }
+
+      output << "material id = " << int(cell->material_id())
+             << " composite stress matches: "
+             << (stresses_match(expected, compute_stresses(composite, FF, cell)) ?
+                   "true" :
+                   "false")
+             << std::endl
+             << "material id = " << int(cell->material_id())
+             << " vectorized composite stress matches: "
+             << (stresses_match(expected,
+                                compute_vectorized_stresses(composite,
+                                                            FF,
+                                                            cell)) ?
+                   "true" :
+                   "false")
+             << std::endl;
+    }
+}
@@ -0,0 +1,138 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/force_contribution_lib.h>
+#include <fiddle/mechanics/mechanics_utilities.h>
+#include <fiddle/mechanics/reference_shape_gradients.h>
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <cmath>
+#include <fstream>
+
+#include "../tests.h"
+
+// Verify that compute_volumetric_pk1_load_vector() computes the same load
+// vector with precomputed reference shape gradients as it does with FEValues.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int spacedim>
+class Position : public Function<spacedim>
+{
+public:
+  Position()
+    : Function<spacedim>(spacedim)
+  {}
+
+  double
+  value(const Point<spacedim> &p,
+        const unsigned int     component = 0) const override
+  {
+    const double tau = 2.0 * numbers::PI;
+    return p[component] + 0.05 * std::sin(tau * p[0]) * std::sin(tau * p[1]) +
+           0.1 * p[(component + 1) % spacedim];
+  }
+};
+
+template <int dim, int spacedim = dim>
+void
+test(const unsigned int fe_degree, const unsigned int n_q_points_1d)
+{
+  const MPI_Comm comm = MPI_COMM_WORLD;
+  std::ofstream  output;
+  if (Utilities::MPI::this_mpi_process(comm) == 0)
+    output.open("output", std::ios::app);
+
+  parallel::shared::Triangulation<dim, spacedim> tria(comm);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(3);
+  for (auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] > 0.5)
+      cell->set_material_id(1);
+
+  FESystem<dim, spacedim>   fe(FE_Q<dim, spacedim>(fe_degree), spacedim);
+  MappingQ<dim, spacedim>   mapping(1);
+  QGauss<dim>               quadrature(n_q_points_1d);
+  DoFHandler<dim, spacedim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  const IndexSet locally_relevant_dofs =
+    DoFTools::extract_locally_relevant_dofs(dof_handler);
+  const auto partitioner = std::make_shared<Utilities::MPI::Partitioner>(
+    dof_handler.locally_owned_dofs(), locally_relevant_dofs, comm);
+  const fdl::ReferenceShapeGradients<dim, spacedim> reference_shape_gradients(
+    mapping, dof_handler, quadrature);
+
+  // Use two stresses, one of which is only applied on some cells, so that we
+  // check that the tables are indexed correctly
+  fdl::ModifiedNeoHookeanStress<dim, spacedim>    s1(quadrature, 2.0);
+  fdl::JLogJVolumetricEnergyStress<dim, spacedim> s2(quadrature, 10.0, {1});
+  std::vector<fdl::ForceContribution<dim, spacedim> *> stress_ptrs{&s1, &s2};
+
+  LinearAlgebra::distributed::Vector<double> current_position(partitioner),
+    current_velocity(partitioner), fe_values_rhs(partitioner),
+    table_rhs(partitioner);
+  VectorTools::interpolate(mapping,
+                           dof_handler,
+                           Position<spacedim>(),
+                           current_position);
+  current_position.update_ghost_values();
+
+  fdl::compute_volumetric_pk1_load_vector(dof_handler,
+                                          mapping,
+                                          stress_ptrs,
+                                          {},
+                                          0.0,
+                                          current_position,
+                                          current_velocity,
+                                          fe_values_rhs);
+  fe_values_rhs.compress(VectorOperation::add);
+  fdl::compute_volumetric_pk1_load_vector(dof_handler,
+                                          mapping,
+                                          stress_ptrs,
+                                          {},
+                                          0.0,
+                                          current_position,
+                                          current_velocity,
+                                          table_rhs,
+                                          nullptr,
+                                          {&reference_shape_gradients});
+  table_rhs.compress(VectorOperation::add);
+
+  const double norm = fe_values_rhs.l2_norm();
+  table_rhs -= fe_values_rhs;
+  const double relative_difference = table_rhs.l2_norm() / norm;
+
+  if (Utilities::MPI::this_mpi_process(comm) == 0)
+    output << "degree = " << fe_degree << " n_q_points_1d = " << n_q_points_1d
+           << " relative difference < 1e-12: "
+           << (relative_difference < 1e-12 ? "true" : "false") << std::endl;
+}
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_init_finalize(argc, argv);
+  // Best way to empty the file
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    std::ofstream("output");
+  for (unsigned int degree = 1; degree < 4; ++degree)
+    test<2>(degree, degree + 1);
+  test<2>(2, 4);
+}
@@ -0,0 +1,152 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/fiber_network.h>
+#include <fiddle/mechanics/force_contribution_lib.h>
+#include <fiddle/mechanics/mechanics_values.h>
+
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <cmath>
+#include <fstream>
+
+#include "../tests.h"
+
+// Verify that compute_vectorized_stress() matches compute_stress() for the
+// material models in the library.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim>
+void
+test(const fdl::ForceContribution<dim>                       &stress,
+     const std::vector<Tensor<2, dim>>                       &FF,
+     const typename Triangulation<dim>::active_cell_iterator &cell,
+     const std::string                                       &name,
+     std::ofstream                                           &output)
+{
+  using VA                         = VectorizedArray<double>;
+  constexpr unsigned int width     = VA::size();
+  const unsigned int     n_batches = (FF.size() + width - 1) / width;
+
+  AssertThrow(stress.supports_vectorized_stress(), fdl::ExcFDLInternalError());
+
+  fdl::MechanicsValues<dim> me_values(stress.get_mechanics_update_flags());
+  me_values.reinit(FF);
+  std::vector<Tensor<2, dim>> stresses(FF.size());
+  auto view = make_array_view(stresses.begin(), stresses.end());
+  stress.compute_stress(0.0, me_values, cell, view);
+
+  // pad with the identity
+  std::vector<Tensor<2, dim, VA>> vectorized_FF(n_batches);
+  for (unsigned int b = 0; b < n_batches; ++b)
+    for (unsigned int d = 0; d < dim; ++d)
+      vectorized_FF[b][d][d] = 1.0;
+  for (unsigned int q = 0; q < FF.size(); ++q)
+    for (unsigned int i = 0; i < dim; ++i)
+      for (unsigned int j = 0; j < dim; ++j)
+        vectorized_FF[q / width][i][j][q % width] = FF[q][i][j];
+  fdl::VectorizedMechanicsValues<dim> vectorized_me_values(
+    stress.get_mechanics_update_flags());
+  vectorized_me_values.reinit(vectorized_FF);
+  std::vector<Tensor<2, dim, VA>> vectorized_stresses(n_batches);
+  auto vectorized_view = make_array_view(vectorized_stresses);
+  stress.compute_vectorized_stress(0.0,
+                                   vectorized_me_values,
+                                   cell,
+                                   vectorized_view);
+
+  double max_difference = 0.0;
+  double max_norm       = 0.0;
+  for (unsigned int q = 0; q < FF.size(); ++q)
+    for (unsigned int i = 0; i < dim; ++i)
+      for (unsigned int j = 0; j < dim; ++j)
+        {
+          max_norm       = std::max(max_norm, std::abs(stresses[q][i][j]));
+          max_difference = std::max(
+            max_difference,
+            std::abs(stresses[q][i][j] -
+                     vectorized_stresses[q / width][i][j][q % width]));
+        }
+
+  output << name << " material id = " << int(cell->material_id())
+         << " vectorized stress matches: "
+         << (max_difference <= 1e-14 * std::max(1.0, max_norm) ? "true" :
+                                                                 "false")
+         << std::endl;
+}
+
+int
+main()
+{
+  constexpr int dim = 2;
+
+  std::ofstream output("output");
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(1);
+  tria.begin_active()->set_material_id(1);
+
+  // Use a number of quadrature points which is not a multiple of the
+  // vectorization width so that the last batch is padded. Half of the
+  // deformation gradients are compressive so that the fibers are turned off
+  // in some lanes.
+  const QGauss<dim>           quadrature(3);
+  std::vector<Tensor<2, dim>> FF(quadrature.size());
+  for (unsigned int q = 0; q < FF.size(); ++q)
+    {
+      const double scale = q % 2 == 0 ? 0.9 : 1.1;
+      FF[q][0][0]        = scale + 0.05 * std::sin(double(q));
+      FF[q][0][1]        = 0.1 * std::cos(double(q));
+      FF[q][1][0]        = -0.05 * std::sin(2.0 * q);
+      FF[q][1][1]        = scale + 0.02 * std::cos(3.0 * q);
+    }
+
+  Tensor<1, dim> f1, f2;
+  f1[0] = 1;
+  f2[1] = 1;
+  std::vector<std::vector<Tensor<1, dim>>> fibers(2);
+  fibers[0].resize(tria.n_active_cells(), f1);
+  fibers[1].resize(tria.n_active_cells(), f2);
+  auto fiber_network = std::make_shared<fdl::FiberNetwork<dim>>(tria, fibers);
+
+  const std::vector<types::material_id> materials{1u};
+  fdl::ModifiedNeoHookeanStress<dim>          s1(quadrature, 2.0, materials);
+  fdl::ModifiedMooneyRivlinStress<dim>        s2(quadrature,
+                                                 1.0,
+                                                 0.5,
+                                                 materials);
+  fdl::JLogJVolumetricEnergyStress<dim>       s3(quadrature, 10.0, materials);
+  fdl::LogarithmicVolumetricEnergyStress<dim> s4(quadrature, 10.0, materials);
+  fdl::HolzapfelOgdenStress<dim>              s5(quadrature,
+                                                 1.0, // a
+                                                 1.0, // b
+                                                 1.0, // a_f
+                                                 1.0, // b_f
+                                                 0.0, // kappa_f
+                                                 0,   // index_f
+                                                 1.0, // a_s
+                                                 1.0, // b_s
+                                                 0.2, // kappa_s
+                                                 1,   // index_s
+                                                 1.0, // a_fs
+                                                 1.0, // b_fs
+                                                 fiber_network,
+                                                 materials);
+
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      if (cell->active_cell_index() > 1)
+        break;
+      test(s1, FF, cell, "ModifiedNeoHookeanStress", output);
+      test(s2, FF, cell, "ModifiedMooneyRivlinStress", output);
+      test(s3, FF, cell, "JLogJVolumetricEnergyStress", output);
+      test(s4, FF, cell, "LogarithmicVolumetricEnergyStress", output);
+      test(s5, FF, cell, "HolzapfelOgdenStress", output);
+    }
+}
@@ -0,0 +1,256 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/active_strain.h>
+#include <fiddle/mechanics/force_contribution_lib.h>
+#include <fiddle/mechanics/mechanics_utilities.h>
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <cmath>
+#include <fstream>
+
+#include "../tests.h"
+
+// Verify that the matrix-free path in compute_volumetric_pk1_load_vector()
+// computes the same load vector as the FEValues path when active strains are
+// present, both with and without the vectorized active strain interface.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int spacedim>
+class Position : public Function<spacedim>
+{
+public:
+  Position()
+    : Function<spacedim>(spacedim)
+  {}
+
+  double
+  value(const Point<spacedim> &p,
+        const unsigned int     component = 0) const override
+  {
+    const double tau = 2.0 * numbers::PI;
+    return p[component] + 0.05 * std::sin(tau * p[0]) * std::sin(tau * p[1]) +
+           0.1 * p[(component + 1) % spacedim];
+  }
+};
+
+// FF_A = diag(1 + m, 1, ...) where m is the material id
+template <int dim, int spacedim = dim>
+class DiagonalStrain : public fdl::ActiveStrain<dim, spacedim>
+{
+public:
+  DiagonalStrain(const types::material_id material_id,
+                 const bool               vectorize)
+    : fdl::ActiveStrain<dim, spacedim>({material_id})
+    , vectorize(vectorize)
+  {}
+
+  virtual bool
+  supports_vectorized_strain() const override
+  {
+    return vectorize;
+  }
+
+  virtual void
+  push_deformation_gradient_forward(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    const ArrayView<Tensor<2, spacedim>>                              &FF,
+    ArrayView<Tensor<2, spacedim>> &push_forward_FF) const override
+  {
+    do_push_forward(cell, FF, push_forward_FF);
+  }
+
+  virtual void
+  pull_stress_back(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    const ArrayView<Tensor<2, spacedim>> &push_forward_stress,
+    ArrayView<Tensor<2, spacedim>>       &stress) const override
+  {
+    do_pull_back(cell, push_forward_stress, stress);
+  }
+
+  virtual void
+  push_vectorized_deformation_gradient_forward(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    const ArrayView<Tensor<2, spacedim, VectorizedArray<double>>>     &FF,
+    ArrayView<Tensor<2, spacedim, VectorizedArray<double>>>
+      &push_forward_FF) const override
+  {
+    AssertThrow(vectorize, fdl::ExcFDLInternalError());
+    do_push_forward(cell, FF, push_forward_FF);
+  }
+
+  virtual void
+  pull_vectorized_stress_back(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    const ArrayView<Tensor<2, spacedim, VectorizedArray<double>>>
+      &push_forward_stress,
+    ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &stress)
+    const override
+  {
+    AssertThrow(vectorize, fdl::ExcFDLInternalError());
+    do_pull_back(cell, push_forward_stress, stress);
+  }
+
+private:
+  template <typename Number>
+  void
+  do_push_forward(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    const ArrayView<Tensor<2, spacedim, Number>>                      &FF,
+    ArrayView<Tensor<2, spacedim, Number>> &push_forward_FF) const
+  {
+    AssertThrow(cell->material_id() == this->get_material_ids()[0],
+                fdl::ExcFDLInternalError());
+    const double a = 1.0 + cell->material_id();
+    for (unsigned int qp_n = 0; qp_n < FF.size(); ++qp_n)
+      {
+        // FF FF_A^-1 scales the first column
+        push_forward_FF[qp_n] = FF[qp_n];
+        for (unsigned int i = 0; i < spacedim; ++i)
+          push_forward_FF[qp_n][i][0] *= Number(1.0 / a);
+      }
+  }
+
+  template <typename Number>
+  void
+  do_pull_back(
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    const ArrayView<Tensor<2, spacedim, Number>> &push_forward_stress,
+    ArrayView<Tensor<2, spacedim, Number>>       &stress) const
+  {
+    AssertThrow(cell->material_id() == this->get_material_ids()[0],
+                fdl::ExcFDLInternalError());
+    const double a = 1.0 + cell->material_id();
+    for (unsigned int qp_n = 0; qp_n < stress.size(); ++qp_n)
+      {
+        // det(FF_A) PP_E FF_A^-T scales the first column by 1 / a
+        stress[qp_n] = a * push_forward_stress[qp_n];
+        for (unsigned int i = 0; i < spacedim; ++i)
+          stress[qp_n][i][0] *= Number(1.0 / a);
+      }
+  }
+
+  const bool vectorize;
+};
+
+template <int dim, int spacedim = dim>
+void
+test(const unsigned int fe_degree,
+     const unsigned int n_q_points_1d,
+     const bool         vectorize)
+{
+  const MPI_Comm comm = MPI_COMM_WORLD;
+  std::ofstream  output;
+  if (Utilities::MPI::this_mpi_process(comm) == 0)
+    output.open("output", std::ios::app);
+
+  parallel::shared::Triangulation<dim, spacedim> tria(comm);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(3);
+  for (auto &cell : tria.active_cell_iterators())
+    {
+      if (cell->center()[0] > 0.5)
+        cell->set_material_id(1);
+      if (cell->center()[1] > 0.5)
+        cell->set_material_id(cell->material_id() + 2);
+    }
+
+  FESystem<dim, spacedim>   fe(FE_Q<dim, spacedim>(fe_degree), spacedim);
+  MappingQ<dim, spacedim>   mapping(1);
+  QGauss<dim>               quadrature(n_q_points_1d);
+  DoFHandler<dim, spacedim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  constraints.close();
+  MatrixFree<dim, double> matrix_free;
+  matrix_free.reinit(mapping, dof_handler, constraints, quadrature);
+  const auto partitioner = matrix_free.get_vector_partitioner();
+
+  // Use two stresses, one of which is only applied on some cells, so that we
+  // check that cells are correctly identified within each batch
+  fdl::ModifiedNeoHookeanStress<dim, spacedim>    s1(quadrature, 2.0);
+  fdl::JLogJVolumetricEnergyStress<dim, spacedim> s2(quadrature, 10.0, {1});
+  std::vector<fdl::ForceContribution<dim, spacedim> *> stress_ptrs{&s1, &s2};
+
+  // Leave material id 0 without an active strain
+  DiagonalStrain<dim, spacedim> as1(1, vectorize);
+  DiagonalStrain<dim, spacedim> as2(2, vectorize);
+  DiagonalStrain<dim, spacedim> as3(3, vectorize);
+  std::vector<fdl::ActiveStrain<dim, spacedim> *> as_ptrs{&as1, &as2, &as3};
+
+  LinearAlgebra::distributed::Vector<double> current_position(partitioner),
+    current_velocity(partitioner), fe_values_rhs(partitioner),
+    matrix_free_rhs(partitioner);
+  VectorTools::interpolate(mapping,
+                           dof_handler,
+                           Position<spacedim>(),
+                           current_position);
+  current_position.update_ghost_values();
+
+  fdl::compute_volumetric_pk1_load_vector(dof_handler,
+                                          mapping,
+                                          stress_ptrs,
+                                          as_ptrs,
+                                          0.0,
+                                          current_position,
+                                          current_velocity,
+                                          fe_values_rhs);
+  fe_values_rhs.compress(VectorOperation::add);
+  fdl::compute_volumetric_pk1_load_vector(dof_handler,
+                                          mapping,
+                                          stress_ptrs,
+                                          as_ptrs,
+                                          0.0,
+                                          current_position,
+                                          current_velocity,
+                                          matrix_free_rhs,
+                                          &matrix_free);
+  matrix_free_rhs.compress(VectorOperation::add);
+
+  const double norm = fe_values_rhs.l2_norm();
+  matrix_free_rhs -= fe_values_rhs;
+  const double relative_difference = matrix_free_rhs.l2_norm() / norm;
+
+  if (Utilities::MPI::this_mpi_process(comm) == 0)
+    output << "degree = " << fe_degree << " n_q_points_1d = " << n_q_points_1d
+           << " vectorize = " << vectorize << " relative difference < 1e-12: "
+           << (relative_difference < 1e-12 ? "true" : "false") << std::endl;
+}
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_init_finalize(argc, argv);
+  // Best way to empty the file
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    std::ofstream("output");
+  for (const bool vectorize : {false, true})
+    {
+      // precompiled kernels:
+      for (unsigned int degree = 1; degree < 3; ++degree)
+        test<2>(degree, degree + 1, vectorize);
+      // variable degree kernels:
+      test<2>(2, 4, vectorize);
+    }
+}
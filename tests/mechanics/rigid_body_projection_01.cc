@@ -0,0 +1,127 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/part.h>
+#include <fiddle/mechanics/rigid_body_projection.h>
+
+#include <deal.II/base/function_parser.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Test that RigidBodyProjection recovers rigid velocities
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto input_db = app_initializer->getInputDatabase();
+
+  // setup deal.II stuff:
+  const auto partitioner =
+    parallel::shared::Triangulation<dim, spacedim>::Settings::partition_zorder;
+  parallel::shared::Triangulation<dim, spacedim> native_tria(MPI_COMM_WORLD,
+                                                             {},
+                                                             false,
+                                                             partitioner);
+  GridGenerator::hyper_cube(native_tria);
+  native_tria.refine_global(3);
+  FESystem<dim, spacedim> fe(FE_Q<dim, spacedim>(1), spacedim);
+
+  FunctionParser<spacedim> position(
+    extract_fp_string(input_db->getDatabase("test")->getDatabase("position")),
+    "PI=" + std::to_string(numbers::PI),
+    "X_0,X_1");
+  FunctionParser<spacedim> velocity(
+    extract_fp_string(input_db->getDatabase("test")->getDatabase("velocity")),
+    "PI=" + std::to_string(numbers::PI),
+    "X_0,X_1");
+
+  // set up fiddle stuff for the test:
+  fdl::Part<dim, spacedim> part(native_tria, fe, {}, position);
+  fdl::RigidBodyProjection<dim> projection(part);
+
+  LinearAlgebra::distributed::Vector<double> rigid_velocity(
+    part.get_partitioner());
+  VectorTools::interpolate(part.get_dof_handler(), velocity, rigid_velocity);
+
+  // Lumped masses:
+  LinearAlgebra::distributed::Vector<double> ones(part.get_partitioner());
+  LinearAlgebra::distributed::Vector<double> masses(part.get_partitioner());
+  ones = 1.0;
+  part.get_mass_operator().vmult(masses, ones);
+
+  std::ofstream output;
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    {
+      output.open("output");
+      output << "mass: " << projection.get_mass() << std::endl;
+    }
+
+  // With the lumped right-hand side the rigid velocity is recovered exactly
+  // and the constraint force vanishes:
+  LinearAlgebra::distributed::Vector<double> rhs(part.get_partitioner());
+  LinearAlgebra::distributed::Vector<double> result(part.get_partitioner());
+  LinearAlgebra::distributed::Vector<double> force(part.get_partitioner());
+  rhs = masses;
+  rhs.scale(rigid_velocity);
+  projection.project(part.get_position(), rhs, result);
+  result -= rigid_velocity;
+  const double lumped_error = result.linfty_norm();
+  projection.compute_constraint_force(10.0, force);
+  const double lumped_force = force.linfty_norm();
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    {
+      output << "center: " << projection.get_center() << std::endl;
+      output << "translational velocity: "
+             << projection.get_translational_velocity() << std::endl;
+      output << "angular velocity: " << projection.get_angular_velocity()[2]
+             << std::endl;
+      output << "lumped velocity error < 1e-12: " << (lumped_error < 1e-12)
+             << std::endl;
+      output << "lumped constraint force < 1e-12: " << (lumped_force < 1e-12)
+             << std::endl;
+    }
+
+  // With the consistent right-hand side the momentum is still exact but the
+  // inertia is approximated by the lumped masses:
+  part.get_mass_operator().vmult(rhs, rigid_velocity);
+  projection.project(part.get_position(), rhs, result);
+  Tensor<1, dim> velocity_error = projection.get_translational_velocity();
+  velocity_error[0] -= 1.0;
+  velocity_error[1] -= 2.0;
+  const double angular_velocity = projection.get_angular_velocity()[2];
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    {
+      output << "consistent translational velocity error < 1e-12: "
+             << (velocity_error.norm() < 1e-12) << std::endl;
+      output << "consistent angular velocity within 5%: "
+             << (std::abs(angular_velocity - 3.0) < 0.15) << std::endl;
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "multilevel_fe_01.log");
+
+  test<2>(app_initializer);
+}
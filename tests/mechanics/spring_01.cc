@@ -167,6 +167,7 @@ main(int argc, char **argv)
     }
 
   VectorTools::interpolate(dof_handler, Shift<2>(), current);
+  spring_force->setup_force(0.0, current, current);
   output << "test 2: displace + x forward, spring constant = "
          << spring_constant << '\n';
   for (const auto &cell : dof_handler.active_cell_iterators())
@@ -0,0 +1,176 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/composite_stress.h>
+#include <fiddle/mechanics/fiber_network.h>
+#include <fiddle/mechanics/force_contribution_lib.h>
+#include <fiddle/mechanics/mechanics_values.h>
+
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <cmath>
+#include <fstream>
+#include <string>
+
+#include "../tests.h"
+
+// Verify that compute_vectorized_linearized_stress() agrees with a centered
+// finite difference of compute_vectorized_stress() for the library stresses.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+using VA = VectorizedArray<double>;
+
+template <int dim>
+std::vector<Tensor<2, dim, VA>>
+compute_stresses(
+  const fdl::ForceContribution<dim>                       &stress,
+  const std::vector<Tensor<2, dim, VA>>                   &FF,
+  const typename Triangulation<dim>::active_cell_iterator &cell)
+{
+  fdl::VectorizedMechanicsValues<dim> me_values(
+    stress.get_mechanics_update_flags());
+  me_values.reinit(FF);
+  std::vector<Tensor<2, dim, VA>> stresses(FF.size());
+  auto                            view = make_array_view(stresses);
+  stress.compute_vectorized_stress(0.0, me_values, cell, view);
+  return stresses;
+}
+
+template <int dim>
+double
+linearization_error(
+  const fdl::ForceContribution<dim>                       &stress,
+  const std::vector<Tensor<2, dim, VA>>                   &FF,
+  const std::vector<Tensor<2, dim, VA>>                   &dFF,
+  const typename Triangulation<dim>::active_cell_iterator &cell)
+{
+  AssertThrow(stress.supports_stress_linearization(),
+              fdl::ExcFDLInternalError());
+  fdl::VectorizedMechanicsValues<dim> me_values(
+    stress.get_mechanics_update_flags());
+  me_values.reinit(FF);
+  std::vector<Tensor<2, dim, VA>> dstresses(FF.size());
+  auto                            view = make_array_view(dstresses);
+  stress.compute_vectorized_linearized_stress(
+    0.0, me_values, cell, make_array_view(dFF), view);
+
+  const double                    h = 1e-6;
+  std::vector<Tensor<2, dim, VA>> FF_p(FF), FF_m(FF);
+  for (unsigned int q = 0; q < FF.size(); ++q)
+    {
+      FF_p[q] += h * dFF[q];
+      FF_m[q] -= h * dFF[q];
+    }
+  const auto stresses_p = compute_stresses(stress, FF_p, cell);
+  const auto stresses_m = compute_stresses(stress, FF_m, cell);
+
+  double max_difference = 0.0;
+  double max_norm       = 0.0;
+  for (unsigned int q = 0; q < FF.size(); ++q)
+    for (unsigned int i = 0; i < dim; ++i)
+      for (unsigned int j = 0; j < dim; ++j)
+        for (unsigned int v = 0; v < VA::size(); ++v)
+          {
+            const double fd =
+              (stresses_p[q][i][j][v] - stresses_m[q][i][j][v]) / (2.0 * h);
+            max_norm = std::max(max_norm, std::abs(fd));
+            max_difference =
+              std::max(max_difference, std::abs(fd - dstresses[q][i][j][v]));
+          }
+  return max_difference / std::max(1.0, max_norm);
+}
+
+int
+main()
+{
+  constexpr int dim = 2;
+
+  std::ofstream output("output");
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(1);
+  tria.begin_active()->set_material_id(1);
+
+  const QGauss<dim>               quadrature(3);
+  std::vector<Tensor<2, dim, VA>> FF(quadrature.size());
+  std::vector<Tensor<2, dim, VA>> dFF(quadrature.size());
+  for (unsigned int q = 0; q < FF.size(); ++q)
+    for (unsigned int v = 0; v < VA::size(); ++v)
+      {
+        const double x     = q + 0.3 * v;
+        const double scale = (q + v) % 2 == 0 ? 0.9 : 1.1;
+        FF[q][0][0][v]     = scale + 0.05 * std::sin(x);
+        FF[q][0][1][v]     = 0.1 * std::cos(x);
+        FF[q][1][0][v]     = -0.05 * std::sin(2.0 * x);
+        FF[q][1][1][v]     = scale + 0.02 * std::cos(3.0 * x);
+
+        dFF[q][0][0][v] = std::cos(5.0 * x);
+        dFF[q][0][1][v] = std::sin(7.0 * x);
+        dFF[q][1][0][v] = 0.5;
+        dFF[q][1][1][v] = -std::cos(x);
+      }
+
+  Tensor<1, dim> f1, f2;
+  f1[0] = 1;
+  f2[1] = 1;
+  std::vector<std::vector<Tensor<1, dim>>> fibers(2);
+  fibers[0].resize(tria.n_active_cells(), f1);
+  fibers[1].resize(tria.n_active_cells(), f2);
+  auto fiber_network = std::make_shared<fdl::FiberNetwork<dim>>(tria, fibers);
+
+  const std::vector<types::material_id>       materials{1u};
+  fdl::ModifiedNeoHookeanStress<dim>          s1(quadrature, 2.0, materials);
+  fdl::ModifiedMooneyRivlinStress<dim>        s2(quadrature, 2.0, 0.5);
+  fdl::JLogJVolumetricEnergyStress<dim>       s3(quadrature, 10.0);
+  fdl::LogarithmicVolumetricEnergyStress<dim> s4(quadrature, 10.0);
+  fdl::HolzapfelOgdenStress<dim>              s5(quadrature,
+                                                 1.0, // a
+                                                 1.0, // b
+                                                 1.0, // a_f
+                                                 1.0, // b_f
+                                                 0.0, // kappa_f
+                                                 0,   // index_f
+                                                 1.0, // a_s
+                                                 1.0, // b_s
+                                                 0.2, // kappa_s
+                                                 1,   // index_s
+                                                 1.0, // a_fs
+                                                 1.0, // b_fs
+                                                 fiber_network);
+
+  using namespace fdl::MaterialLaws;
+  fdl::CompositeStress<dim,
+                       dim,
+                       ModifiedNeoHookean<dim>,
+                       JLogJVolumetricEnergy<dim>>
+    s6(quadrature,
+       ModifiedNeoHookean<dim>(2.0),
+       JLogJVolumetricEnergy<dim>(10.0));
+
+  const std::vector<std::pair<std::string, const fdl::ForceContribution<dim> *>>
+    stresses{{"ModifiedNeoHookeanStress", &s1},
+             {"ModifiedMooneyRivlinStress", &s2},
+             {"JLogJVolumetricEnergyStress", &s3},
+             {"LogarithmicVolumetricEnergyStress", &s4},
+             {"HolzapfelOgdenStress", &s5},
+             {"CompositeStress", &s6}};
+
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      if (cell->active_cell_index() > 1)
+        break;
+      for (const auto &pair : stresses)
+        output << "material id = " << int(cell->material_id()) << " "
+               << pair.first << " linearization matches: "
+               << (linearization_error(*pair.second, FF, dFF, cell) < 1e-7 ?
+                     "true" :
+                     "false")
+               << std::endl;
+    }
+}
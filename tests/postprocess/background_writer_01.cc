@@ -0,0 +1,102 @@
+#include <fiddle/mechanics/part.h>
+
+#include <fiddle/postprocess/background_writer.h>
+
+#include <deal.II/base/function_lib.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Test that BackgroundWriter writes part and time series files and that the
+// part may be modified immediately after write_part() returns.
+
+using namespace dealii;
+
+template <int dim, int spacedim = dim>
+void
+test(std::ofstream &output)
+{
+  const MPI_Comm     mpi_comm = MPI_COMM_WORLD;
+  const unsigned int rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  parallel::shared::Triangulation<dim, spacedim> tria(mpi_comm);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(3);
+
+  FESystem<dim, spacedim>  fe(FE_Q<dim, spacedim>(1), spacedim);
+  fdl::Part<dim, spacedim> part(tria, fe);
+
+  LinearAlgebra::distributed::Vector<double> force(part.get_partitioner());
+  force = 1.0;
+
+  {
+    fdl::BackgroundWriter<dim, spacedim> writer(".", mpi_comm);
+    for (unsigned int counter = 0; counter < 3; ++counter)
+      {
+        writer.write_part(part, "part", counter, {{&force, "F"}});
+        // Change the part while the previous output may still be pending
+        auto position = part.get_position();
+        position *= 2.0;
+        part.set_position(std::move(position));
+
+        writer.write_time_series("series.txt",
+                                 counter,
+                                 {double(counter), 2.0 * counter});
+      }
+    writer.wait();
+
+    bool pieces_exist = true;
+    for (unsigned int counter = 0; counter < 3; ++counter)
+      pieces_exist =
+        pieces_exist &&
+        std::ifstream("part_" + Utilities::int_to_string(counter, 8) + "." +
+                      Utilities::int_to_string(rank, 4) + ".vtu")
+          .good();
+    pieces_exist = Utilities::MPI::min(int(pieces_exist), mpi_comm);
+
+    if (rank == 0)
+      {
+        bool records_exist = true;
+        for (unsigned int counter = 0; counter < 3; ++counter)
+          records_exist =
+            records_exist &&
+            std::ifstream("part_" + Utilities::int_to_string(counter, 8) +
+                          ".pvtu")
+              .good();
+        output << "pieces exist: " << pieces_exist << std::endl
+               << "records exist: " << records_exist << std::endl;
+      }
+  }
+
+  if (rank == 0)
+    {
+      std::ifstream series("series.txt");
+      std::string   line;
+      output << "series.txt:" << std::endl;
+      while (std::getline(series, line))
+        output << "  " << line << std::endl;
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+
+  std::ofstream output;
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    output.open("output");
+
+  test<2>(output);
+}
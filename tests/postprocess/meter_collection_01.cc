@@ -0,0 +1,102 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/postprocess/meter_collection.h>
+#include <fiddle/postprocess/surface_meter.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+using namespace dealii;
+using namespace SAMRAI;
+
+// Test that MeterCollection computes the same values as the individual meters
+
+template <int dim, int spacedim = dim>
+void
+test(
+  SAMRAI::tbox::Pointer<SAMRAI::hier::PatchHierarchy<spacedim>> patch_hierarchy,
+  const int                                                     f_idx,
+  const int                                                     g_idx)
+{
+  // Set up a few line segments and circles
+  std::vector<std::unique_ptr<fdl::SurfaceMeter<dim, spacedim>>> meters;
+  for (unsigned int meter_n = 0; meter_n < 4; ++meter_n)
+    {
+      const double                 radius   = 0.2 + 0.2 * meter_n;
+      const unsigned int           n_points = 16 * (meter_n + 1);
+      const bool                   closed   = meter_n % 2 == 0;
+      std::vector<Point<spacedim>> points;
+      for (unsigned int p = 0; p < n_points; ++p)
+        {
+          const double angle = (closed ? 2.0 : 1.0) * numbers::PI * p /
+                               double(closed ? n_points : n_points - 1);
+          points.emplace_back(radius * std::cos(angle),
+                              radius * std::sin(angle));
+        }
+      if (closed)
+        points.emplace_back(points.front());
+      std::vector<Tensor<1, spacedim>> velocities(points.size());
+
+      meters.emplace_back(
+        std::make_unique<fdl::SurfaceMeter<dim, spacedim>>(points,
+                                                           velocities,
+                                                           patch_hierarchy));
+    }
+
+  std::vector<const fdl::Meter<dim - 1, spacedim> *> meter_ptrs;
+  for (const auto &meter : meters)
+    meter_ptrs.push_back(meter.get());
+  fdl::MeterCollection<dim - 1, spacedim> collection(meter_ptrs);
+
+  const std::vector<double> mean_values =
+    collection.compute_mean_values(g_idx, "BSPLINE_3");
+  const std::vector<std::pair<double, Tensor<1, spacedim>>> fluxes =
+    collection.compute_fluxes(f_idx, "BSPLINE_3");
+  AssertThrow(mean_values.size() == meters.size(),
+              fdl::ExcFDLInternalError());
+  AssertThrow(fluxes.size() == meters.size(), fdl::ExcFDLInternalError());
+
+  bool means_match   = true;
+  bool fluxes_match  = true;
+  bool normals_match = true;
+  for (unsigned int i = 0; i < meters.size(); ++i)
+    {
+      const double mean_value =
+        meters[i]->compute_mean_value(g_idx, "BSPLINE_3");
+      const auto flux = meters[i]->compute_flux(f_idx, "BSPLINE_3");
+
+      means_match = means_match && std::abs(mean_value - mean_values[i]) <
+                                     1e-12 * (1.0 + std::abs(mean_value));
+      fluxes_match = fluxes_match && std::abs(flux.first - fluxes[i].first) <
+                                       1e-12 * (1.0 + std::abs(flux.first));
+      normals_match =
+        normals_match && (flux.second - fluxes[i].second).norm() < 1e-12;
+    }
+
+  tbox::plog << "number of meters: " << collection.size() << std::endl
+             << "means match: " << means_match << std::endl
+             << "fluxes match: " << fluxes_match << std::endl
+             << "normals match: " << normals_match << std::endl;
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "multilevel_fe_01.log");
+
+  // setup SAMRAI stuff (its always the same):
+  auto tuple           = setup_hierarchy<2>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+  auto f_idx           = std::get<5>(tuple);
+  auto g_idx           = std::get<6>(tuple);
+
+  test<2>(patch_hierarchy, f_idx, g_idx);
+}
@@ -0,0 +1,129 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/postprocess/meter_collection.h>
+#include <fiddle/postprocess/surface_meter.h>
+#include <fiddle/postprocess/volume_meter.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+using namespace dealii;
+using namespace SAMRAI;
+
+// Test that computing the mean values and fluxes of several fields at once
+// gives the same values as computing them separately with MeterCollection,
+// and that the nonblocking variants give the same values as the blocking ones.
+
+template <int dim, int spacedim = dim>
+void
+test(
+  SAMRAI::tbox::Pointer<SAMRAI::hier::PatchHierarchy<spacedim>> patch_hierarchy,
+  const int                                                     f_idx,
+  const int                                                     g_idx)
+{
+  const auto close = [](const double a, const double b)
+  { return std::abs(a - b) < 1e-12 * (1.0 + std::abs(a)); };
+
+  // surface meter
+  {
+    std::vector<Point<spacedim>> points;
+    for (unsigned int p = 0; p < 32; ++p)
+      {
+        const double angle = 2.0 * numbers::PI * p / 32.0;
+        points.emplace_back(0.5 * std::cos(angle), 0.5 * std::sin(angle));
+      }
+    points.emplace_back(points.front());
+    std::vector<Tensor<1, spacedim>> velocities(points.size());
+    fdl::SurfaceMeter<dim, spacedim> meter(points, velocities, patch_hierarchy);
+    fdl::MeterCollection<dim - 1, spacedim> collection({&meter});
+
+    const std::vector<double> mean_values =
+      meter.compute_mean_values({g_idx, g_idx}, "BSPLINE_3");
+    const std::vector<std::pair<double, Tensor<1, spacedim>>> fluxes =
+      meter.compute_fluxes({f_idx, f_idx}, "BSPLINE_3");
+    AssertThrow(mean_values.size() == 2, fdl::ExcFDLInternalError());
+    AssertThrow(fluxes.size() == 2, fdl::ExcFDLInternalError());
+    AssertThrow(meter.compute_mean_values({}, "BSPLINE_3").empty(),
+                fdl::ExcFDLInternalError());
+
+    const double mean_value =
+      collection.compute_mean_values(g_idx, "BSPLINE_3")[0];
+    const auto flux = collection.compute_fluxes(f_idx, "BSPLINE_3")[0];
+
+    bool means_match   = true;
+    bool fluxes_match  = true;
+    bool normals_match = true;
+    for (unsigned int i = 0; i < 2; ++i)
+      {
+        means_match  = means_match && close(mean_value, mean_values[i]);
+        fluxes_match = fluxes_match && close(flux.first, fluxes[i].first);
+        normals_match =
+          normals_match && (flux.second - fluxes[i].second).norm() < 1e-12;
+      }
+
+    // Start several reductions before finishing any of them
+    auto flux_handle = meter.compute_flux_async(f_idx, "BSPLINE_3");
+    auto mean_handle = meter.compute_mean_value_async(g_idx, "BSPLINE_3");
+    auto centroid_handle =
+      meter.compute_centroid_value_async(g_idx, "BSPLINE_3");
+    const double centroid_value =
+      meter.compute_centroid_value(g_idx, "BSPLINE_3");
+    const auto   async_flux     = flux_handle.get();
+    const double async_mean     = mean_handle.get();
+    const double async_centroid = centroid_handle.get();
+    const bool   async_match =
+      !flux_handle.valid() && close(flux.first, async_flux.first) &&
+      (flux.second - async_flux.second).norm() < 1e-12 &&
+      close(mean_value, async_mean) && close(centroid_value, async_centroid);
+
+    tbox::plog << "surface meter:" << std::endl
+               << "  means match: " << means_match << std::endl
+               << "  fluxes match: " << fluxes_match << std::endl
+               << "  normals match: " << normals_match << std::endl
+               << "  async values match: " << async_match << std::endl;
+  }
+
+  // volume meter
+  {
+    const Point<spacedim>                    center(0.1, 0.1);
+    fdl::VolumeMeter<spacedim>               meter(center,
+                                                   0.5,
+                                                   patch_hierarchy);
+    fdl::MeterCollection<spacedim, spacedim> collection({&meter});
+
+    const std::vector<double> mean_values =
+      meter.compute_mean_values({g_idx, g_idx, g_idx}, "BSPLINE_3");
+    AssertThrow(mean_values.size() == 3, fdl::ExcFDLInternalError());
+
+    const double mean_value =
+      collection.compute_mean_values(g_idx, "BSPLINE_3")[0];
+    bool means_match = true;
+    for (const double value : mean_values)
+      means_match = means_match && close(mean_value, value);
+
+    tbox::plog << "volume meter:" << std::endl
+               << "  means match: " << means_match << std::endl;
+  }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "multilevel_fe_01.log");
+
+  // setup SAMRAI stuff (its always the same):
+  auto tuple           = setup_hierarchy<2>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+  auto f_idx           = std::get<5>(tuple);
+  auto g_idx           = std::get<6>(tuple);
+
+  test<2>(patch_hierarchy, f_idx, g_idx);
+}
@@ -0,0 +1,95 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/postprocess/surface_meter.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+using namespace dealii;
+using namespace SAMRAI;
+
+// Test that moving a SurfaceMeter with reinit() gives the same results as
+// setting up a new meter at the new position, both when the topology of the
+// meter mesh is kept and when it changes
+
+template <int dim, int spacedim = dim>
+void
+test(
+  SAMRAI::tbox::Pointer<SAMRAI::hier::PatchHierarchy<spacedim>> patch_hierarchy,
+  const int                                                     f_idx,
+  const int                                                     g_idx)
+{
+  const auto make_points = [](const double shift, const double length)
+  {
+    std::vector<Point<spacedim>> points;
+    for (unsigned int p = 0; p < 4; ++p)
+      points.emplace_back(-0.5 * length + shift + length * p / 3.0,
+                          0.1 * p + shift);
+    return points;
+  };
+  const std::vector<Tensor<1, spacedim>> velocities(4);
+
+  fdl::SurfaceMeter<dim, spacedim> meter(make_points(0.0, 1.0),
+                                         velocities,
+                                         patch_hierarchy);
+
+  // The first reinit() only translates the meter, which keeps the topology,
+  // and the second one makes it longer, which adds vertices
+  for (const double length : {1.0, 1.5})
+    {
+      const auto points = make_points(0.01, length);
+      meter.reinit(points, velocities);
+      fdl::SurfaceMeter<dim, spacedim> new_meter(points,
+                                                 velocities,
+                                                 patch_hierarchy);
+
+      const double mean_value = meter.compute_mean_value(g_idx, "BSPLINE_3");
+      const double new_mean_value =
+        new_meter.compute_mean_value(g_idx, "BSPLINE_3");
+      const auto flux     = meter.compute_flux(f_idx, "BSPLINE_3");
+      const auto new_flux = new_meter.compute_flux(f_idx, "BSPLINE_3");
+
+      tbox::plog << "length = " << length << std::endl
+                 << "  number of active cells: "
+                 << meter.get_triangulation().n_active_cells() << std::endl
+                 << "  same number of active cells: "
+                 << (meter.get_triangulation().n_active_cells() ==
+                     new_meter.get_triangulation().n_active_cells())
+                 << std::endl
+                 << "  means match: "
+                 << (std::abs(mean_value - new_mean_value) < 1e-12)
+                 << std::endl
+                 << "  fluxes match: "
+                 << (std::abs(flux.first - new_flux.first) < 1e-12)
+                 << std::endl
+                 << "  normals match: "
+                 << ((flux.second - new_flux.second).norm() < 1e-12)
+                 << std::endl
+                 << "  centroids match: "
+                 << ((meter.get_centroid() - new_meter.get_centroid()).norm() <
+                     1e-12)
+                 << std::endl;
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "multilevel_fe_01.log");
+
+  // setup SAMRAI stuff (its always the same):
+  auto tuple           = setup_hierarchy<2>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+  auto f_idx           = std::get<5>(tuple);
+  auto g_idx           = std::get<6>(tuple);
+
+  test<2>(patch_hierarchy, f_idx, g_idx);
+}
@@ -0,0 +1,111 @@
+#include <fiddle/postprocess/point_values.h>
+
+#include <deal.II/base/function_lib.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include <ibtk/IBTKInit.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Test PointValues on a codimension one mesh, evaluation of several vectors
+// at once, and that PointValues still works after the Triangulation changes.
+
+using namespace dealii;
+
+template <int dim, int spacedim = dim>
+void
+test(std::ofstream &output)
+{
+  const MPI_Comm mpi_comm = MPI_COMM_WORLD;
+
+  parallel::shared::Triangulation<dim, spacedim> tria(mpi_comm);
+  GridGenerator::hyper_sphere(tria);
+  std::vector<Point<spacedim>> evaluation_points;
+  for (const auto &cell : tria.active_cell_iterators())
+    evaluation_points.push_back(cell->vertex(0));
+  tria.refine_global(2);
+
+  FESystem<dim, spacedim>   fe(FE_Q<dim, spacedim>(1), spacedim);
+  DoFHandler<dim, spacedim> dof_handler(tria);
+  MappingQ<dim, spacedim>   mapping(1);
+
+  const auto setup_vector = [&](const Function<spacedim> &function)
+  {
+    IndexSet locally_relevant_dofs;
+    DoFTools::extract_locally_relevant_dofs(dof_handler, locally_relevant_dofs);
+    auto partitioner = std::make_shared<Utilities::MPI::Partitioner>(
+      dof_handler.locally_owned_dofs(), locally_relevant_dofs, mpi_comm);
+    LinearAlgebra::distributed::Vector<double> vector(partitioner);
+    VectorTools::interpolate(mapping, dof_handler, function, vector);
+    vector.update_ghost_values();
+    return vector;
+  };
+
+  dof_handler.distribute_dofs(fe);
+  fdl::PointValues<spacedim, dim, spacedim> point_values(mapping,
+                                                         dof_handler,
+                                                         evaluation_points);
+  for (unsigned int cycle = 0; cycle < 2; ++cycle)
+    {
+      // Refining invalidates the internal data structures
+      if (cycle == 1)
+        {
+          tria.refine_global(1);
+          dof_handler.distribute_dofs(fe);
+        }
+
+      const auto identity =
+        setup_vector(Functions::IdentityFunction<spacedim>());
+      const auto cosine = setup_vector(Functions::CosineFunction<spacedim>(2));
+
+      const auto identity_values = point_values.evaluate(identity);
+      const auto cosine_values   = point_values.evaluate(cosine);
+      const auto batched_values  = point_values.evaluate({&identity, &cosine});
+
+      bool identity_exact = true;
+      for (std::size_t i = 0; i < evaluation_points.size(); ++i)
+        identity_exact =
+          identity_exact &&
+          (identity_values[i] - Tensor<1, spacedim>(evaluation_points[i]))
+              .norm() < 1e-12;
+      const bool batched_matches = batched_values.size() == 2 &&
+                                   batched_values[0] == identity_values &&
+                                   batched_values[1] == cosine_values;
+
+      if (Utilities::MPI::this_mpi_process(mpi_comm) == 0)
+        output << "cycle = " << cycle << std::endl
+               << "  number of points: " << identity_values.size()
+               << std::endl
+               << "  identity is exact: " << identity_exact << std::endl
+               << "  batched values match: " << batched_matches << std::endl;
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+
+  std::ofstream output;
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    output.open("output");
+
+  test<1, 2>(output);
+}
@@ -1,4 +1,5 @@
 #include <fiddle/base/exceptions.h>
+#include <fiddle/base/phase_timings.h>
 #include <fiddle/base/samrai_utilities.h>
 
 #include <fiddle/interaction/interaction_utilities.h>
@@ -23,6 +24,7 @@
 #include <mpi.h>
 
 #include <fstream>
+#include <regex>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -373,3 +375,50 @@ print_partitioning_on_0(
                      tbox::SAMRAI_MPI::getCommunicator(),
                      out);
 }
+
+/**
+ * In performance mode (see attest --perf) attest appends the key
+ *
+ *   phase_timings_file = "phase_timings.csv"
+ *
+ * to the input file of each test with a performance baseline. Return the
+ * value of that key, or the empty string if it is not present (i.e., the test
+ * is only being run for correctness).
+ */
+inline std::string
+get_phase_timings_file(int argc, char **argv)
+{
+  if (argc < 2)
+    return "";
+
+  // Some tests do not set up SAMRAI, so parse the file ourselves.
+  std::ifstream    input(argv[1]);
+  const std::regex key("^\\s*phase_timings_file\\s*=\\s*\"([^\"]*)\"");
+  std::string      line;
+  std::string      file_name;
+  while (std::getline(input, line))
+    {
+      std::smatch match;
+      if (std::regex_search(line, match, key))
+        file_name = match[1];
+    }
+  return file_name;
+}
+
+/**
+ * If a phase timings file was requested then write the times recorded by
+ * fdl::PhaseTimings to it. This function is collective over @p comm.
+ */
+inline void
+write_phase_timings(int argc, char **argv, MPI_Comm comm)
+{
+  using namespace dealii;
+  const std::string file_name = get_phase_timings_file(argc, argv);
+  if (file_name.empty())
+    return;
+
+  std::ofstream output;
+  if (Utilities::MPI::this_mpi_process(comm) == 0)
+    output.open(file_name);
+  fdl::PhaseTimings::get().write(output, comm, fdl::PhaseTimings::Format::CSV);
+}
@@ -61,9 +61,19 @@ main(int argc, char **argv)
     global.local_element(i) = rank * dofs_per_proc + i;
   Vector<double> overlap(n_overlap_dofs_per_proc);
 
+  // In performance mode repeat each scatter enough times to be measurable.
+  const unsigned int n_repetitions =
+    get_phase_timings_file(argc, argv).empty() ? 1 : 1000;
+
   fdl::Scatter<double> scatter(overlap_dofs, local_indices, comm);
-  scatter.global_to_overlap_start(global, 0, overlap);
-  scatter.global_to_overlap_finish(global, overlap);
+  double               start_time = MPI_Wtime();
+  for (unsigned int r = 0; r < n_repetitions; ++r)
+    {
+      scatter.global_to_overlap_start(global, 0, overlap);
+      scatter.global_to_overlap_finish(global, overlap);
+    }
+  fdl::PhaseTimings::get().add("scatter_01::global_to_overlap",
+                               MPI_Wtime() - start_time);
 
   std::ostringstream out;
   out << "rank = " << rank << '\n';
@@ -73,8 +83,19 @@ main(int argc, char **argv)
   out << "overlap vector is correct : " << overlap_equal << std::endl;
 
   LinearAlgebra::distributed::Vector<double> global2(local_indices, comm);
-  scatter.overlap_to_global_start(overlap, VectorOperation::insert, 0, global2);
-  scatter.overlap_to_global_finish(overlap, VectorOperation::insert, global2);
+  start_time = MPI_Wtime();
+  for (unsigned int r = 0; r < n_repetitions; ++r)
+    {
+      scatter.overlap_to_global_start(overlap,
+                                      VectorOperation::insert,
+                                      0,
+                                      global2);
+      scatter.overlap_to_global_finish(overlap,
+                                       VectorOperation::insert,
+                                       global2);
+    }
+  fdl::PhaseTimings::get().add("scatter_01::overlap_to_global",
+                               MPI_Wtime() - start_time);
 
   bool global_equal = true;
   for (unsigned int i = 0; i < dofs_per_proc; ++i)
@@ -86,4 +107,6 @@ main(int argc, char **argv)
   if (rank == 0)
     output.open("output");
   print_strings_on_0(out.str(), comm, output);
+
+  write_phase_timings(argc, argv, comm);
 }
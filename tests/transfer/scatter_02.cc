@@ -0,0 +1,93 @@
+#include <fiddle/transfer/scatter.h>
+
+#include <deal.II/base/mpi.h>
+
+#include "../tests.h"
+
+// Test repeated scatters with the same Scatter object (which reuses its
+// persistent requests) on several channels, including delegating the
+// requests to the caller.
+
+int
+main(int argc, char **argv)
+{
+  using namespace dealii;
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  MPI_Comm   comm    = MPI_COMM_WORLD;
+  const auto rank    = dealii::Utilities::MPI::this_mpi_process(comm);
+  const auto n_procs = dealii::Utilities::MPI::n_mpi_processes(comm);
+
+  const unsigned int dofs_per_proc = 50;
+  const unsigned int n_overlap_dofs_per_proc =
+    dofs_per_proc + 10 * (n_procs - 1);
+  const auto n_dofs = dofs_per_proc * n_procs;
+  IndexSet   local_indices(n_dofs);
+  local_indices.add_range(rank * dofs_per_proc, (rank + 1) * dofs_per_proc);
+  local_indices.compress();
+
+  // Every processor computes every overlap so that we can check additive
+  // scatters.
+  std::vector<std::vector<types::global_dof_index>> all_overlap_dofs(n_procs);
+  for (unsigned int r = 0; r < n_procs; ++r)
+    for (unsigned int i = 0; i < n_overlap_dofs_per_proc; ++i)
+      all_overlap_dofs[r].push_back(
+        ((n_overlap_dofs_per_proc * r + i) * 17) % n_dofs);
+  const std::vector<types::global_dof_index> &overlap_dofs =
+    all_overlap_dofs[rank];
+  std::vector<unsigned int> n_occurrences(n_dofs);
+  for (const auto &dofs : all_overlap_dofs)
+    for (const auto dof : dofs)
+      ++n_occurrences[dof];
+
+  fdl::Scatter<double> scatter(overlap_dofs, local_indices, comm);
+  LinearAlgebra::distributed::Vector<double> global(local_indices, comm);
+  LinearAlgebra::distributed::Vector<double> global2(local_indices, comm);
+  Vector<double>                             overlap(n_overlap_dofs_per_proc);
+
+  std::ostringstream out;
+  out << "rank = " << rank << '\n';
+  for (unsigned int step = 0; step < 4; ++step)
+    {
+      const unsigned int channel = step % 2;
+      for (unsigned int i = 0; i < global.locally_owned_size(); ++i)
+        global.local_element(i) = step * n_dofs + rank * dofs_per_proc + i;
+
+      scatter.global_to_overlap_start(global, channel, overlap);
+      if (step == 3)
+        {
+          auto requests = scatter.delegate_outstanding_requests();
+          const int ierr =
+            MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+          AssertThrowMPI(ierr);
+        }
+      scatter.global_to_overlap_finish(global, overlap);
+
+      bool overlap_equal = true;
+      for (unsigned int i = 0; i < n_overlap_dofs_per_proc; ++i)
+        overlap_equal =
+          overlap_equal && (step * n_dofs + overlap_dofs[i] == overlap[i]);
+      out << "step " << step << " overlap vector is correct : " << overlap_equal
+          << '\n';
+
+      scatter.overlap_to_global_start(overlap,
+                                      VectorOperation::add,
+                                      channel,
+                                      global2);
+      scatter.overlap_to_global_finish(overlap, VectorOperation::add, global2);
+
+      bool global_equal = true;
+      for (unsigned int i = 0; i < dofs_per_proc; ++i)
+        global_equal = global_equal &&
+                       (global2.local_element(i) ==
+                        global.local_element(i) *
+                          n_occurrences[rank * dofs_per_proc + i]);
+      out << "step " << step << " global vector is correct : " << global_equal
+          << '\n';
+    }
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+  print_strings_on_0(out.str(), comm, output);
+}
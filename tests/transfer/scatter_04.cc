@@ -0,0 +1,85 @@
+#include <fiddle/transfer/scatter.h>
+
+#include <deal.II/base/mpi.h>
+
+#include "../tests.h"
+
+// Test scattering several vectors at once with both backends.
+
+int
+main(int argc, char **argv)
+{
+  using namespace dealii;
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  MPI_Comm   comm    = MPI_COMM_WORLD;
+  const auto rank    = dealii::Utilities::MPI::this_mpi_process(comm);
+  const auto n_procs = dealii::Utilities::MPI::n_mpi_processes(comm);
+
+  const unsigned int dofs_per_proc = 50;
+  const unsigned int n_overlap_dofs_per_proc =
+    dofs_per_proc + 10 * (n_procs - 1);
+  const auto n_dofs = dofs_per_proc * n_procs;
+  IndexSet   local_indices(n_dofs);
+  local_indices.add_range(rank * dofs_per_proc, (rank + 1) * dofs_per_proc);
+  local_indices.compress();
+
+  std::vector<types::global_dof_index> overlap_dofs;
+  for (unsigned int i = 0; i < n_overlap_dofs_per_proc; ++i)
+    overlap_dofs.push_back(((n_overlap_dofs_per_proc * rank + i) * 17) %
+                           n_dofs);
+
+  const unsigned int n_vectors = 3;
+  std::vector<LinearAlgebra::distributed::Vector<double>> global(n_vectors);
+  std::vector<Vector<double>>                             overlap(n_vectors);
+  std::vector<const LinearAlgebra::distributed::Vector<double> *> inputs;
+  std::vector<Vector<double> *>                                   outputs;
+  for (unsigned int v = 0; v < n_vectors; ++v)
+    {
+      global[v].reinit(local_indices, comm);
+      for (unsigned int i = 0; i < global[v].locally_owned_size(); ++i)
+        global[v].local_element(i) = v * n_dofs + rank * dofs_per_proc + i;
+      overlap[v].reinit(n_overlap_dofs_per_proc);
+      inputs.push_back(&global[v]);
+      outputs.push_back(&overlap[v]);
+    }
+
+  std::ostringstream out;
+  out << "rank = " << rank << '\n';
+  for (const auto backend : {fdl::ScatterBackend::PointToPoint,
+                             fdl::ScatterBackend::NeighborCollective})
+    {
+      fdl::Scatter<double> scatter(overlap_dofs, local_indices, comm, backend);
+      // Do a single scatter in between two batched ones to check that the
+      // buffers are independent.
+      for (unsigned int step = 0; step < 3; ++step)
+        {
+          for (auto &vector : overlap)
+            vector = 0.0;
+          if (step == 1)
+            {
+              scatter.global_to_overlap_start(global[0], 0, overlap[0]);
+              scatter.global_to_overlap_finish(global[0], overlap[0]);
+            }
+          else
+            {
+              scatter.global_to_overlap_start(inputs, 0, outputs);
+              scatter.global_to_overlap_finish(inputs, outputs);
+            }
+
+          const unsigned int n_scattered = step == 1 ? 1 : n_vectors;
+          bool               overlap_equal = true;
+          for (unsigned int v = 0; v < n_scattered; ++v)
+            for (unsigned int i = 0; i < n_overlap_dofs_per_proc; ++i)
+              overlap_equal = overlap_equal &&
+                              (v * n_dofs + overlap_dofs[i] == overlap[v][i]);
+          out << "step " << step << " overlap vectors are correct : "
+              << overlap_equal << '\n';
+        }
+    }
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+  print_strings_on_0(out.str(), comm, output);
+}
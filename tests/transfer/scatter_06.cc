@@ -0,0 +1,82 @@
+#include <fiddle/transfer/scatter.h>
+
+#include <deal.II/base/mpi.h>
+
+#include "../tests.h"
+
+// Test Scatter::has_same_pattern().
+
+int
+main(int argc, char **argv)
+{
+  using namespace dealii;
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  MPI_Comm   comm    = MPI_COMM_WORLD;
+  const auto rank    = dealii::Utilities::MPI::this_mpi_process(comm);
+  const auto n_procs = dealii::Utilities::MPI::n_mpi_processes(comm);
+
+  const unsigned int dofs_per_proc = 50;
+  const unsigned int n_overlap_dofs_per_proc =
+    dofs_per_proc + 10 * (n_procs - 1);
+  const auto n_dofs = dofs_per_proc * n_procs;
+  IndexSet   local_indices(n_dofs);
+  local_indices.add_range(rank * dofs_per_proc, (rank + 1) * dofs_per_proc);
+  local_indices.compress();
+
+  std::vector<types::global_dof_index> overlap_dofs;
+  for (unsigned int i = 0; i < n_overlap_dofs_per_proc; ++i)
+    overlap_dofs.push_back(((n_overlap_dofs_per_proc * rank + i) * 17) %
+                           n_dofs);
+
+  fdl::Scatter<double> scatter(overlap_dofs, local_indices, comm);
+
+  std::ostringstream out;
+  out << "rank = " << rank << '\n';
+  out << "same arguments : "
+      << scatter.has_same_pattern(overlap_dofs,
+                                  local_indices,
+                                  comm,
+                                  fdl::ScatterBackend::PointToPoint)
+      << '\n';
+  out << "different backend : "
+      << scatter.has_same_pattern(overlap_dofs,
+                                  local_indices,
+                                  comm,
+                                  fdl::ScatterBackend::NeighborCollective)
+      << '\n';
+
+  // Swapping two overlap dofs changes the pattern even though the set of dofs
+  // is the same
+  std::vector<types::global_dof_index> swapped_dofs = overlap_dofs;
+  std::swap(swapped_dofs.front(), swapped_dofs.back());
+  out << "swapped dofs : "
+      << scatter.has_same_pattern(swapped_dofs,
+                                  local_indices,
+                                  comm,
+                                  fdl::ScatterBackend::PointToPoint)
+      << '\n';
+
+  std::vector<types::global_dof_index> fewer_dofs = overlap_dofs;
+  fewer_dofs.pop_back();
+  out << "fewer dofs : "
+      << scatter.has_same_pattern(fewer_dofs,
+                                  local_indices,
+                                  comm,
+                                  fdl::ScatterBackend::PointToPoint)
+      << '\n';
+
+  // A moved scatter should have the same pattern
+  fdl::Scatter<double> scatter2(std::move(scatter));
+  out << "moved scatter : "
+      << scatter2.has_same_pattern(overlap_dofs,
+                                   local_indices,
+                                   comm,
+                                   fdl::ScatterBackend::PointToPoint)
+      << '\n';
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+  print_strings_on_0(out.str(), comm, output);
+}
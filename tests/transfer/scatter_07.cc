@@ -0,0 +1,81 @@
+#include <fiddle/transfer/scatter.h>
+
+#include <deal.II/base/mpi.h>
+
+#include "../tests.h"
+
+// Test the neighborhood collective backend when some processors (here, the
+// odd ones) neither need nor provide any values and are therefore not part
+// of the graph communicator.
+
+int
+main(int argc, char **argv)
+{
+  using namespace dealii;
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  MPI_Comm   comm    = MPI_COMM_WORLD;
+  const auto rank    = dealii::Utilities::MPI::this_mpi_process(comm);
+  const auto n_procs = dealii::Utilities::MPI::n_mpi_processes(comm);
+
+  const unsigned int dofs_per_proc = 10;
+  const auto         n_dofs        = dofs_per_proc * n_procs;
+  IndexSet           local_indices(n_dofs);
+  local_indices.add_range(rank * dofs_per_proc, (rank + 1) * dofs_per_proc);
+  local_indices.compress();
+
+  // Even processors need their own dofs and the first three dofs of the next
+  // even processor
+  std::vector<types::global_dof_index> overlap_dofs;
+  if (rank % 2 == 0)
+    {
+      for (unsigned int i = 0; i < dofs_per_proc; ++i)
+        overlap_dofs.push_back(rank * dofs_per_proc + i);
+      const unsigned int next = (rank + 2) % n_procs;
+      if (next != rank && next % 2 == 0)
+        for (unsigned int i = 0; i < 3; ++i)
+          overlap_dofs.push_back(next * dofs_per_proc + i);
+    }
+
+  LinearAlgebra::distributed::Vector<double> global(local_indices, comm);
+  for (unsigned int i = 0; i < global.locally_owned_size(); ++i)
+    global.local_element(i) = rank * dofs_per_proc + i;
+  Vector<double> overlap(overlap_dofs.size());
+
+  fdl::Scatter<double> scatter(overlap_dofs,
+                               local_indices,
+                               comm,
+                               fdl::ScatterBackend::NeighborCollective);
+  std::ostringstream out;
+  out << "rank = " << rank << '\n';
+  out << "number of overlap dofs : " << overlap_dofs.size() << '\n';
+  for (unsigned int step = 0; step < 2; ++step)
+    {
+      overlap = 0.0;
+      scatter.global_to_overlap_start(global, 0, overlap);
+      scatter.global_to_overlap_finish(global, overlap);
+
+      bool overlap_equal = true;
+      for (unsigned int i = 0; i < overlap_dofs.size(); ++i)
+        overlap_equal = overlap_equal && (overlap_dofs[i] == overlap[i]);
+      out << "overlap vector is correct : " << overlap_equal << '\n';
+
+      // Count how many times each dof appears in an overlap vector
+      overlap = 1.0;
+      LinearAlgebra::distributed::Vector<double> counts(local_indices, comm);
+      scatter.overlap_to_global_start(overlap,
+                                      VectorOperation::add,
+                                      0,
+                                      counts);
+      scatter.overlap_to_global_finish(overlap, VectorOperation::add, counts);
+      double local_count = 0.0;
+      for (unsigned int i = 0; i < counts.locally_owned_size(); ++i)
+        local_count += counts.local_element(i);
+      out << "number of references to owned dofs : " << local_count << '\n';
+    }
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+  print_strings_on_0(out.str(), comm, output);
+}
@@ -0,0 +1,71 @@
+#include <fiddle/transfer/scatter.h>
+
+#include <deal.II/base/mpi.h>
+
+#include "../tests.h"
+
+// Test the communication counters of Scatter: each processor ghosts the
+// first few dofs owned by the next processor.
+
+int
+main(int argc, char **argv)
+{
+  using namespace dealii;
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  MPI_Comm   comm    = MPI_COMM_WORLD;
+  const auto rank    = dealii::Utilities::MPI::this_mpi_process(comm);
+  const auto n_procs = dealii::Utilities::MPI::n_mpi_processes(comm);
+
+  const unsigned int dofs_per_proc = 100;
+  const unsigned int n_ghosts      = n_procs > 1 ? 10 : 0;
+  const auto         n_dofs        = dofs_per_proc * n_procs;
+  IndexSet           local_indices(n_dofs);
+  local_indices.add_range(rank * dofs_per_proc, (rank + 1) * dofs_per_proc);
+  local_indices.compress();
+
+  std::vector<types::global_dof_index> overlap_dofs;
+  for (unsigned int i = 0; i < dofs_per_proc; ++i)
+    overlap_dofs.push_back(rank * dofs_per_proc + i);
+  const unsigned int next = (rank + 1) % n_procs;
+  for (unsigned int i = 0; i < n_ghosts; ++i)
+    overlap_dofs.push_back(next * dofs_per_proc + i);
+
+  LinearAlgebra::distributed::Vector<double> global(local_indices, comm);
+  LinearAlgebra::distributed::Vector<double> global2(local_indices, comm);
+  Vector<double>                             overlap(overlap_dofs.size());
+  Vector<double>                             overlap2(overlap_dofs.size());
+
+  fdl::Scatter<double> scatter(overlap_dofs, local_indices, comm);
+  scatter.global_to_overlap_start(global, 0, overlap);
+  scatter.global_to_overlap_finish(global, overlap);
+  scatter.overlap_to_global_start(overlap, VectorOperation::add, 0, global);
+  scatter.overlap_to_global_finish(overlap, VectorOperation::add, global);
+  // Batched scatters send one message containing both vectors:
+  std::vector<const LinearAlgebra::distributed::Vector<double> *> input = {
+    &global, &global2};
+  std::vector<Vector<double> *> output = {&overlap, &overlap2};
+  scatter.global_to_overlap_start(input, 0, output);
+  scatter.global_to_overlap_finish(input, output);
+
+  const fdl::ScatterStatistics &statistics = scatter.get_statistics();
+  std::ostringstream            out;
+  out << "rank = " << rank << '\n'
+      << "scatters = " << statistics.n_scatters << '\n'
+      << "messages sent = " << statistics.n_messages_sent << '\n'
+      << "messages received = " << statistics.n_messages_received << '\n'
+      << "bytes sent = " << statistics.bytes_sent << '\n'
+      << "bytes received = " << statistics.bytes_received << '\n'
+      << "neighbors = " << statistics.n_neighbors << '\n'
+      << "finish time is nonnegative : " << (statistics.finish_time >= 0.0)
+      << '\n';
+
+  scatter.reset_statistics();
+  out << "scatters after reset = " << scatter.get_statistics().n_scatters
+      << std::endl;
+
+  std::ofstream output_file;
+  if (rank == 0)
+    output_file.open("output");
+  print_strings_on_0(out.str(), comm, output_file);
+}
@@ -0,0 +1,107 @@
+#include <fiddle/transfer/scatter.h>
+
+#include <deal.II/base/mpi.h>
+
+#include "../tests.h"
+
+// Test reduced precision scatters: each processor ghosts the first few dofs
+// owned by the next processor. Communicated values should be rounded to
+// single precision but locally owned values (and values read from shared
+// memory) should not be.
+
+int
+main(int argc, char **argv)
+{
+  using namespace dealii;
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  MPI_Comm   comm    = MPI_COMM_WORLD;
+  const auto rank    = dealii::Utilities::MPI::this_mpi_process(comm);
+  const auto n_procs = dealii::Utilities::MPI::n_mpi_processes(comm);
+
+  const unsigned int dofs_per_proc = 100;
+  const unsigned int n_ghosts      = n_procs > 1 ? 10 : 0;
+  const auto         n_dofs        = dofs_per_proc * n_procs;
+  IndexSet           local_indices(n_dofs);
+  local_indices.add_range(rank * dofs_per_proc, (rank + 1) * dofs_per_proc);
+  local_indices.compress();
+
+  std::vector<types::global_dof_index> overlap_dofs;
+  for (unsigned int i = 0; i < dofs_per_proc; ++i)
+    overlap_dofs.push_back(rank * dofs_per_proc + i);
+  const unsigned int next = (rank + 1) % n_procs;
+  for (unsigned int i = 0; i < n_ghosts; ++i)
+    overlap_dofs.push_back(next * dofs_per_proc + i);
+
+  // Values which are not exactly representable as floats:
+  const double                               third = 1.0 / 3.0;
+  LinearAlgebra::distributed::Vector<double> global(local_indices, comm);
+  for (const auto dof : local_indices)
+    global[dof] = dof + third;
+  Vector<double> overlap(overlap_dofs.size());
+
+  std::ostringstream out;
+  out << "rank = " << rank << '\n';
+  for (const auto backend : {fdl::ScatterBackend::PointToPoint,
+                             fdl::ScatterBackend::NeighborCollective,
+                             fdl::ScatterBackend::SharedMemory})
+    {
+      fdl::Scatter<double> scatter(overlap_dofs, local_indices, comm, backend);
+      scatter.set_reduced_precision(true);
+      scatter.global_to_overlap_start(global, 0, overlap);
+      scatter.global_to_overlap_finish(global, overlap);
+
+      bool owned_exact   = true;
+      bool ghost_exact   = true;
+      bool ghost_rounded = true;
+      for (std::size_t i = 0; i < overlap_dofs.size(); ++i)
+        {
+          const double value = overlap_dofs[i] + third;
+          if (i < dofs_per_proc)
+            owned_exact = owned_exact && overlap[i] == value;
+          else
+            {
+              ghost_exact   = ghost_exact && overlap[i] == value;
+              ghost_rounded = ghost_rounded &&
+                              overlap[i] == double(static_cast<float>(value));
+            }
+        }
+
+      // Every processor adds 1/3 to all of its overlap dofs, so the first
+      // n_ghosts dofs also get a rounded 1/3 from the previous processor:
+      LinearAlgebra::distributed::Vector<double> sum(local_indices, comm);
+      overlap = third;
+      scatter.overlap_to_global_start(overlap, VectorOperation::add, 0, sum);
+      scatter.overlap_to_global_finish(overlap, VectorOperation::add, sum);
+      bool sum_correct = true;
+      for (unsigned int i = 0; i < dofs_per_proc; ++i)
+        {
+          const double expected =
+            i < n_ghosts ? third + double(static_cast<float>(third)) : third;
+          sum_correct = sum_correct && sum.local_element(i) == expected;
+        }
+
+      // Switching back to full precision should give exact values:
+      scatter.set_reduced_precision(false);
+      scatter.global_to_overlap_start(global, 0, overlap);
+      scatter.global_to_overlap_finish(global, overlap);
+      bool full_exact = true;
+      for (std::size_t i = 0; i < overlap_dofs.size(); ++i)
+        full_exact = full_exact && overlap[i] == overlap_dofs[i] + third;
+
+      const fdl::ScatterStatistics &statistics = scatter.get_statistics();
+      out << "backend = " << int(backend) << '\n'
+          << "owned values are exact: " << owned_exact << '\n'
+          << "ghost values are exact: " << ghost_exact << '\n'
+          << "ghost values are rounded: " << ghost_rounded << '\n'
+          << "overlap to global sum is correct: " << sum_correct << '\n'
+          << "full precision values are exact: " << full_exact << '\n'
+          << "bytes sent = " << statistics.bytes_sent << '\n'
+          << "bytes received = " << statistics.bytes_received << '\n';
+    }
+
+  std::ofstream output_file;
+  if (rank == 0)
+    output_file.open("output");
+  print_strings_on_0(out.str(), comm, output_file);
+}